@@ -0,0 +1,153 @@
+#include "testing/testing.hpp"
+
+#include "base/executor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
+
+using namespace base;
+using namespace std;
+
+namespace
+{
+Executor::Params MakeParams(size_t threadsCount, size_t maxBackgroundTasks = 0)
+{
+  Executor::Params params;
+  params.m_threadsCount = threadsCount;
+  params.m_maxBackgroundTasks = maxBackgroundTasks;
+  params.m_pinToCoreClusters = false;
+  return params;
+}
+
+UNIT_TEST(Executor_Submit)
+{
+  Executor executor(MakeParams(4));
+  TEST_EQUAL(executor.GetThreadsCount(), 4, ());
+
+  vector<future<size_t>> results;
+  for (size_t i = 0; i < 100; ++i)
+    results.push_back(executor.Submit(Executor::Priority::Search, [](size_t n) { return n * n; }, i));
+
+  for (size_t i = 0; i < results.size(); ++i)
+    TEST_EQUAL(results[i].get(), i * i, ());
+}
+
+UNIT_TEST(Executor_Priorities)
+{
+  Executor executor(MakeParams(1));
+
+  promise<void> unblock;
+  auto blocked = unblock.get_future().share();
+  promise<void> started;
+  executor.Push(Executor::Priority::Render, [&started, blocked]() {
+    started.set_value();
+    blocked.wait();
+  });
+  started.get_future().wait();
+
+  mutex mu;
+  vector<Executor::Priority> order;
+  for (auto const priority : {Executor::Priority::Background, Executor::Priority::Routing,
+                              Executor::Priority::Search, Executor::Priority::Render})
+  {
+    executor.Push(priority, [&mu, &order, priority]() {
+      lock_guard<mutex> lock(mu);
+      order.push_back(priority);
+    });
+  }
+
+  unblock.set_value();
+  executor.Submit(Executor::Priority::Background, []() {}).wait();
+
+  lock_guard<mutex> lock(mu);
+  vector<Executor::Priority> const expected = {
+      Executor::Priority::Render, Executor::Priority::Search, Executor::Priority::Routing,
+      Executor::Priority::Background};
+  TEST_EQUAL(order, expected, ());
+}
+
+UNIT_TEST(Executor_BackgroundLimit)
+{
+  Executor executor(MakeParams(4, 1 /* maxBackgroundTasks */));
+
+  atomic<size_t> running(0);
+  atomic<size_t> maxRunning(0);
+  vector<future<void>> results;
+  for (size_t i = 0; i < 20; ++i)
+  {
+    results.push_back(executor.Submit(Executor::Priority::Background, [&]() {
+      auto const current = ++running;
+      auto prev = maxRunning.load();
+      while (prev < current && !maxRunning.compare_exchange_weak(prev, current))
+        ;
+      this_thread::sleep_for(chrono::milliseconds(1));
+      --running;
+    }));
+  }
+  // Other priorities are not blocked by the background tasks.
+  TEST(executor.Submit(Executor::Priority::Routing, [&executor]() {
+    return executor.IsWorkerThread();
+  }).get(), ());
+
+  for (auto & result : results)
+    result.get();
+  TEST_EQUAL(maxRunning, 1, ());
+  TEST(!executor.IsWorkerThread(), ());
+}
+
+UNIT_TEST(Executor_NestedTasks)
+{
+  Executor executor(MakeParams(3));
+
+  atomic<size_t> done(0);
+  promise<void> finished;
+  size_t constexpr kTasks = 1000;
+  executor.Push(Executor::Priority::Search, [&]() {
+    for (size_t i = 0; i < kTasks; ++i)
+    {
+      executor.Push(Executor::Priority::Search, [&]() {
+        if (++done == kTasks)
+          finished.set_value();
+      });
+    }
+  });
+  finished.get_future().wait();
+  TEST_EQUAL(done, kTasks, ());
+}
+
+UNIT_TEST(Executor_Shutdown)
+{
+  Executor executor(MakeParams(2));
+  executor.ShutdownAndJoin();
+  TEST(!executor.Push(Executor::Priority::Render, []() {}), ());
+  TEST(!executor.Submit(Executor::Priority::Render, []() {}).valid(), ());
+}
+
+UNIT_TEST(ExecutorTaskLoop_Order)
+{
+  Executor executor(MakeParams(4));
+
+  size_t constexpr kTasks = 1000;
+  vector<size_t> order;
+  promise<void> finished;
+  {
+    ExecutorTaskLoop loop(executor, Executor::Priority::Background);
+    for (size_t i = 0; i < kTasks; ++i)
+    {
+      // The tasks are run one by one, so |order| needs no synchronization.
+      TEST(loop.Push([&order, &finished, i]() {
+        order.push_back(i);
+        if (order.size() == kTasks)
+          finished.set_value();
+      }).m_isSuccess, ());
+    }
+    finished.get_future().wait();
+  }
+
+  TEST_EQUAL(order.size(), kTasks, ());
+  TEST(is_sorted(order.begin(), order.end()), ());
+}
+}  // namespace
@@ -222,6 +222,22 @@ UNIT_TEST(LevenshteinDFA_ErrorsMade)
   }
 }
 
+UNIT_TEST(LevenshteinDFA_LongAlphabet)
+{
+  // Patterns with many distinct letters use the binary search over the alphabet.
+  string const kPattern = "abcdefghijklmnopqrstuvwxyz";
+  LevenshteinDFA const dfa(kPattern, 1 /* maxErrors */);
+  TEST_GREATER(dfa.GetAlphabetSize(), 16, ());
+
+  TEST_EQUAL(GetResult(dfa, kPattern), Result(Status::Accepts, 0 /* errorsMade */,
+                                              0 /* prefixErrorsMade */), ());
+  TEST_EQUAL(GetResult(dfa, "abcdefghijklmnopqrstuvwxy"), Result(Status::Accepts, 1, 0), ());
+  TEST_EQUAL(GetResult(dfa, "abcdefghijklmnopqrstuvwxy1"), Result(Status::Accepts, 1, 1), ());
+  TEST_EQUAL(GetResult(dfa, "zbcdefghijklmnopqrstuvwxyz"), Result(Status::Accepts, 1, 1), ());
+  TEST(Rejects(dfa, "zycdefghijklmnopqrstuvwxyz"), ());
+  TEST(Intermediate(dfa, "abcdefgh"), ());
+}
+
 UNIT_TEST(LevenshteinDFA_PrefixDFAModifier)
 {
   {
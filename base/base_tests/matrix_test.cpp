@@ -27,3 +27,16 @@ UNIT_TEST(Matrix_Inverse_AllElementsNonZero)
 
   TEST_EQUAL((m1 * m).Equal(math::Identity<double, 3>()), true, ());
 }
+
+UNIT_TEST(Matrix_TransposeAndSum)
+{
+  math::Matrix<double, 2, 3> const m = {1, 2, 3,
+                                        4, 5, 6};
+
+  math::Matrix<double, 3, 2> const t = math::Transpose(m);
+  TEST_EQUAL(t, (math::Matrix<double, 3, 2>{1, 4, 2, 5, 3, 6}), ());
+
+  TEST_EQUAL(m + m, (math::Matrix<double, 2, 3>{2, 4, 6, 8, 10, 12}), ());
+  TEST_EQUAL(m - m, (math::Matrix<double, 2, 3>{0, 0, 0, 0, 0, 0}), ());
+  TEST((m * t).Equal(math::Matrix<double, 2, 2>{14, 32, 32, 77}), ());
+}
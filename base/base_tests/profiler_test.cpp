@@ -0,0 +1,109 @@
+#include "testing/testing.hpp"
+
+#include "base/profiler.hpp"
+
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace base::profiler;
+using namespace std;
+
+namespace
+{
+void Inner() { PROFILER_SCOPE("Inner"); }
+
+void Outer()
+{
+  PROFILER_SCOPE("Outer");
+  Inner();
+}
+}  // namespace
+
+UNIT_TEST(Profiler_Disabled)
+{
+  Enable();
+  Disable();
+  Outer();
+  TEST(GetEvents().empty(), ());
+}
+
+UNIT_TEST(Profiler_NestedScopes)
+{
+  Enable();
+  Outer();
+  Disable();
+
+  auto events = GetEvents();
+  TEST_EQUAL(events.size(), 2, ());
+  // Scopes may take less than a microsecond, so the order of the events is not fixed.
+  if (strcmp(events[0].m_name, "Outer") != 0)
+    swap(events[0], events[1]);
+  auto const & outer = events[0];
+  auto const & inner = events[1];
+  TEST_EQUAL(strcmp(outer.m_name, "Outer"), 0, ());
+  TEST_EQUAL(strcmp(inner.m_name, "Inner"), 0, ());
+  TEST_EQUAL(outer.m_threadId, inner.m_threadId, ());
+  TEST_LESS_OR_EQUAL(outer.m_startUs, inner.m_startUs, ());
+  TEST_GREATER_OR_EQUAL(outer.m_startUs + outer.m_durationUs,
+                        inner.m_startUs + inner.m_durationUs, ());
+
+  // The events are dropped by the next Enable().
+  Enable();
+  Disable();
+  TEST(GetEvents().empty(), ());
+}
+
+UNIT_TEST(Profiler_RingBuffer)
+{
+  Enable(3 /* eventsPerThread */);
+  for (size_t i = 0; i < 10; ++i)
+    Inner();
+  Outer();
+  Disable();
+
+  // The last Inner(), the nested Inner() and Outer() are kept.
+  auto const events = GetEvents();
+  TEST_EQUAL(events.size(), 3, ());
+  multiset<string> names;
+  for (auto const & e : events)
+    names.insert(e.m_name);
+  TEST_EQUAL(names, multiset<string>({"Inner", "Inner", "Outer"}), ());
+}
+
+UNIT_TEST(Profiler_Threads)
+{
+  size_t constexpr kNumThreads = 4;
+  size_t constexpr kNumScopes = 100;
+
+  Enable();
+  vector<thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i)
+  {
+    threads.emplace_back([i]() {
+      SetThreadName("Worker " + to_string(i));
+      for (size_t j = 0; j < kNumScopes; ++j)
+        Outer();
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+  Disable();
+
+  auto const events = GetEvents();
+  TEST_EQUAL(events.size(), kNumThreads * kNumScopes * 2, ());
+  set<uint32_t> threadIds;
+  for (auto const & e : events)
+    threadIds.insert(e.m_threadId);
+  TEST_EQUAL(threadIds.size(), kNumThreads, ());
+
+  ostringstream os;
+  WriteChromeTrace(os);
+  auto const trace = os.str();
+  TEST(trace.find(R"({"name":"Outer","ph":"X")") != string::npos, (trace.substr(0, 200)));
+  TEST(trace.find(R"("args":{"name":"Worker 3"})") != string::npos, ());
+}
@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <deque>
+#include <map>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -129,6 +131,17 @@ UNIT_TEST(SortUnique_VectorTest)
   TestSortUnique<std::deque>();
 }
 
+UNIT_TEST(EraseKeysIf)
+{
+  std::map<int, std::string> m = {{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}};
+  base::EraseKeysIf(m, [](int key) { return key % 2 == 0; });
+  std::map<int, std::string> const expected = {{1, "a"}, {3, "c"}};
+  TEST_EQUAL(m, expected, ());
+
+  base::EraseKeysIf(m, [](int) { return true; });
+  TEST(m.empty(), ());
+}
+
 UNIT_TEST(IgnoreFirstArgument)
 {
   {
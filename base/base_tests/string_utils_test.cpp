@@ -140,6 +140,19 @@ UNIT_TEST(MakeLowerCase)
   strings::UniString const us(&arr[0], &arr[0] + ARRAY_SIZE(arr));
   strings::UniString const cus(&carr[0], &carr[0] + ARRAY_SIZE(carr));
   TEST_EQUAL(cus, strings::MakeLowerCase(us), ());
+
+  // The chars which are lowered to several ones are in the middle of the strings.
+  TEST_EQUAL(strings::MakeLowerCase(std::string("STRA\xc3\x9f" "E")), "strasse", ());
+  TEST_EQUAL(strings::MakeLowerCase(strings::MakeUniString("ABC\xc3\x9f" "DEF\xc3\x9f")),
+             strings::MakeUniString("abcssdefss"), ());
+
+  for (strings::UniChar c = 1; c < 0x80; ++c)
+  {
+    std::string ascii(1, static_cast<char>(c));
+    strings::AsciiToLower(ascii);
+    TEST_EQUAL(strings::MakeLowerCase(strings::UniString(1, c)), strings::MakeUniString(ascii),
+               (c));
+  }
 }
 
 UNIT_TEST(EqualNoCase) { TEST(strings::EqualNoCase("HaHaHa", "hahaha"), ()); }
@@ -829,6 +842,16 @@ UNIT_TEST(Normalize)
   strings::UniString result(&r[0], &r[0] + ARRAY_SIZE(r));
   strings::NormalizeInplace(us);
   TEST_EQUAL(us, result, ());
+
+  // ASCII prefix is kept as is.
+  strings::UniString prefixed = strings::MakeUniString("abc");
+  prefixed.append(&s[0], &s[0] + ARRAY_SIZE(s));
+  strings::UniString prefixedResult = strings::MakeUniString("abc");
+  prefixedResult.append(result.begin(), result.end());
+  strings::NormalizeInplace(prefixed);
+  TEST_EQUAL(prefixed, prefixedResult, ());
+
+  TEST_EQUAL(strings::Normalize(std::string("Hola! 99")), "Hola! 99", ());
 }
 
 UNIT_TEST(Normalize_Special)
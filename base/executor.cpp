@@ -0,0 +1,377 @@
+#include "base/executor.hpp"
+
+#include "base/assert.hpp"
+
+#include "std/target_os.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+#include <sched.h>
+#endif
+
+using namespace std;
+
+namespace base
+{
+namespace
+{
+thread_local Executor const * t_executor = nullptr;
+thread_local size_t t_workerIndex = 0;
+
+// Cores of the performance and of the efficiency clusters. Both are empty when all the cores
+// are the same or when it's not possible to find it out.
+struct CoreClusters
+{
+  vector<size_t> m_performance;
+  vector<size_t> m_efficiency;
+};
+
+CoreClusters GetCoreClusters(size_t coresCount)
+{
+  CoreClusters clusters;
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  // Cores of big.LITTLE clusters differ in their max frequencies.
+  vector<uint64_t> maxFreqs(coresCount, 0);
+  for (size_t i = 0; i < coresCount; ++i)
+  {
+    ifstream file("/sys/devices/system/cpu/cpu" + to_string(i) + "/cpufreq/cpuinfo_max_freq");
+    if (!(file >> maxFreqs[i]))
+      return {};
+  }
+
+  auto const maxFreq = *max_element(maxFreqs.begin(), maxFreqs.end());
+  for (size_t i = 0; i < coresCount; ++i)
+  {
+    if (maxFreqs[i] == maxFreq)
+      clusters.m_performance.push_back(i);
+    else
+      clusters.m_efficiency.push_back(i);
+  }
+  if (clusters.m_efficiency.empty())
+    return {};
+#else
+  UNUSED_VALUE(coresCount);
+#endif
+  return clusters;
+}
+
+void PinCurrentThread(vector<size_t> const & cores)
+{
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto const core : cores)
+    CPU_SET(core, &set);
+  // It's just a hint, the worker runs on any core when the affinity can't be set.
+  UNUSED_VALUE(sched_setaffinity(0 /* current thread */, sizeof(set), &set));
+#else
+  UNUSED_VALUE(cores);
+#endif
+}
+}  // namespace
+
+// Executor ----------------------------------------------------------------------------------------
+
+Executor::Executor() : Executor(Params()) {}
+
+Executor::Executor(Params const & params)
+{
+  size_t const cores = max<size_t>(thread::hardware_concurrency(), 1);
+  size_t const threadsCount = params.m_threadsCount != 0 ? params.m_threadsCount : cores;
+  m_maxBackgroundTasks = params.m_maxBackgroundTasks != 0 ? params.m_maxBackgroundTasks
+                                                          : max<size_t>(threadsCount / 2, 1);
+
+  CoreClusters clusters;
+  if (params.m_pinToCoreClusters && threadsCount == cores)
+    clusters = GetCoreClusters(cores);
+
+  m_workers.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; ++i)
+  {
+    m_workers.push_back(make_unique<Worker>());
+    m_workers.back()->m_efficiency =
+        !clusters.m_efficiency.empty() && i >= clusters.m_performance.size();
+  }
+
+  m_threads.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; ++i)
+  {
+    auto const & clusterCores =
+        m_workers[i]->m_efficiency ? clusters.m_efficiency : clusters.m_performance;
+    m_threads.emplace_back([this, i, clusterCores]() {
+      if (!clusterCores.empty())
+        PinCurrentThread(clusterCores);
+      WorkerLoop(i);
+    });
+  }
+}
+
+Executor::~Executor() { ShutdownAndJoin(); }
+
+// static
+Executor & Executor::Instance()
+{
+  static Executor executor;
+  return executor;
+}
+
+bool Executor::Push(Priority priority, Task && task)
+{
+  CHECK_LESS(priority, Priority::Count, ());
+  auto const p = static_cast<size_t>(priority);
+
+  // Tasks of a worker stay on its queues, the others steal them when they are idle.
+  size_t const worker = t_executor == this ? t_workerIndex : m_nextWorker++ % m_workers.size();
+
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_shutdown)
+      return false;
+    {
+      lock_guard<mutex> workerLock(m_workers[worker]->m_mutex);
+      m_workers[worker]->m_queues[p].push_back(move(task));
+    }
+    ++m_pending[p];
+  }
+  m_cv.notify_one();
+  return true;
+}
+
+void Executor::ShutdownAndJoin()
+{
+  {
+    lock_guard<mutex> lock(m_mutex);
+    if (m_shutdown)
+      return;
+    m_shutdown = true;
+  }
+  m_cv.notify_all();
+
+  for (auto & thread : m_threads)
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+
+  for (auto & worker : m_workers)
+  {
+    lock_guard<mutex> lock(worker->m_mutex);
+    for (auto & queue : worker->m_queues)
+      queue.clear();
+  }
+}
+
+bool Executor::IsWorkerThread() const { return t_executor == this; }
+
+void Executor::WorkerLoop(size_t index)
+{
+  t_executor = this;
+  t_workerIndex = index;
+
+  while (true)
+  {
+    Task task;
+    Priority priority;
+    if (TryPop(index, task, priority))
+    {
+      task();
+      if (priority == Priority::Background)
+      {
+        {
+          lock_guard<mutex> lock(m_mutex);
+          --m_runningBackground;
+        }
+        m_cv.notify_one();
+      }
+      continue;
+    }
+
+    unique_lock<mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_shutdown || HasRunnableTasks(); });
+    if (m_shutdown)
+      return;
+  }
+}
+
+bool Executor::TryPop(size_t worker, Priority priority, Task & task)
+{
+  auto const p = static_cast<size_t>(priority);
+  if (m_pending[p] <= 0)
+    return false;
+
+  if (priority == Priority::Background)
+  {
+    auto running = m_runningBackground.load();
+    do
+    {
+      if (running >= m_maxBackgroundTasks)
+        return false;
+    } while (!m_runningBackground.compare_exchange_weak(running, running + 1));
+  }
+
+  // Own tasks are taken first, then the oldest tasks of the other workers are stolen.
+  for (size_t i = 0; i < m_workers.size(); ++i)
+  {
+    auto & victim = *m_workers[(worker + i) % m_workers.size()];
+    lock_guard<mutex> lock(victim.m_mutex);
+    auto & queue = victim.m_queues[p];
+    if (queue.empty())
+      continue;
+
+    task = move(queue.front());
+    queue.pop_front();
+    --m_pending[p];
+    return true;
+  }
+
+  if (priority == Priority::Background)
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      --m_runningBackground;
+    }
+    m_cv.notify_one();
+  }
+  return false;
+}
+
+bool Executor::TryPop(size_t worker, Task & task, Priority & priority)
+{
+  if (m_workers[worker]->m_efficiency && TryPop(worker, Priority::Background, task))
+  {
+    priority = Priority::Background;
+    return true;
+  }
+
+  for (size_t p = 0; p < kPrioritiesCount; ++p)
+  {
+    if (TryPop(worker, static_cast<Priority>(p), task))
+    {
+      priority = static_cast<Priority>(p);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Executor::HasRunnableTasks() const
+{
+  for (size_t p = 0; p < kPrioritiesCount; ++p)
+  {
+    if (m_pending[p] <= 0)
+      continue;
+    if (static_cast<Priority>(p) != Priority::Background ||
+        m_runningBackground < m_maxBackgroundTasks)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ExecutorTaskLoop --------------------------------------------------------------------------------
+
+ExecutorTaskLoop::ExecutorTaskLoop(Executor & executor, Executor::Priority priority)
+  : m_executor(executor), m_priority(priority), m_state(make_shared<State>())
+{
+}
+
+ExecutorTaskLoop::~ExecutorTaskLoop()
+{
+  unique_lock<mutex> lock(m_state->m_mutex);
+  m_state->m_shutdown = true;
+  m_state->m_tasks.clear();
+  m_state->m_cv.wait(lock, [this]() { return !m_state->m_running; });
+}
+
+TaskLoop::PushResult ExecutorTaskLoop::Push(Task && task)
+{
+  {
+    lock_guard<mutex> lock(m_state->m_mutex);
+    if (m_state->m_shutdown)
+      return {};
+    m_state->m_tasks.push_back(move(task));
+    if (m_state->m_scheduled)
+      return {true, kNoId};
+    m_state->m_scheduled = true;
+  }
+
+  auto state = m_state;
+  auto & executor = m_executor;
+  auto const priority = m_priority;
+  if (!executor.Push(priority, [&executor, priority, state]() {
+        RunNext(executor, priority, state);
+      }))
+  {
+    lock_guard<mutex> lock(m_state->m_mutex);
+    m_state->m_scheduled = false;
+    m_state->m_tasks.clear();
+    return {};
+  }
+  return {true, kNoId};
+}
+
+TaskLoop::PushResult ExecutorTaskLoop::Push(Task const & task)
+{
+  Task copy = task;
+  return Push(move(copy));
+}
+
+// static
+void ExecutorTaskLoop::RunNext(Executor & executor, Executor::Priority priority,
+                               shared_ptr<State> const & state)
+{
+  Task task;
+  {
+    lock_guard<mutex> lock(state->m_mutex);
+    if (state->m_shutdown || state->m_tasks.empty())
+    {
+      state->m_scheduled = false;
+      return;
+    }
+    task = move(state->m_tasks.front());
+    state->m_tasks.pop_front();
+    state->m_running = true;
+  }
+
+  task();
+
+  bool reschedule = false;
+  {
+    lock_guard<mutex> lock(state->m_mutex);
+    state->m_running = false;
+    reschedule = !state->m_shutdown && !state->m_tasks.empty();
+    state->m_scheduled = reschedule;
+  }
+  state->m_cv.notify_all();
+
+  // The next task goes through the queues of the executor again, so the tasks of the loop
+  // don't hold a worker away from the tasks of higher priorities.
+  if (reschedule && !executor.Push(priority, [&executor, priority, state]() {
+        RunNext(executor, priority, state);
+      }))
+  {
+    lock_guard<mutex> lock(state->m_mutex);
+    state->m_scheduled = false;
+    state->m_tasks.clear();
+  }
+}
+
+string DebugPrint(Executor::Priority priority)
+{
+  switch (priority)
+  {
+  case Executor::Priority::Render: return "Render";
+  case Executor::Priority::Search: return "Search";
+  case Executor::Priority::Routing: return "Routing";
+  case Executor::Priority::Background: return "Background";
+  case Executor::Priority::Count: return "Count";
+  }
+  UNREACHABLE();
+}
+}  // namespace base
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/task_loop.hpp"
+#include "base/thread.hpp"
+#include "base/thread_utils.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace base
+{
+// Pool of workers which is shared by all subsystems. When every subsystem has its own pool
+// the threads oversubscribe the cores on phones, so the executor runs one worker per core
+// and orders the tasks by priority classes instead.
+//
+// Every worker has its own queues. A task pushed by a worker goes to the queues of that worker,
+// which keeps the data of fork-join style code in the caches of one core, and the tasks pushed
+// from other threads are distributed round-robin. A worker which has nothing to do steals
+// the oldest tasks of the other workers.
+//
+// On big.LITTLE devices the workers are pinned to the clusters of cores where it's possible.
+// The workers of the performance cores look for the tasks in the order of priorities, and the
+// workers of the efficiency cores look for the background tasks first.
+class Executor
+{
+public:
+  // In the order of decreasing priority.
+  enum class Priority
+  {
+    // Reading of the features for rendering, the user is waiting for them on the screen.
+    Render,
+    Search,
+    Routing,
+    // File and network I/O, prewarming, cache maintenance.
+    Background,
+
+    Count
+  };
+
+  using Task = threads::FunctionWrapper;
+
+  struct Params
+  {
+    // Zero means the number of hardware threads.
+    size_t m_threadsCount = 0;
+    // Max number of background tasks which run at the same time. Zero means a half of
+    // the workers, so background I/O never takes all the cores.
+    size_t m_maxBackgroundTasks = 0;
+    // Pin the workers to the clusters of cores on big.LITTLE devices.
+    bool m_pinToCoreClusters = true;
+  };
+
+  Executor();
+  explicit Executor(Params const & params);
+  ~Executor();
+
+  // The executor shared by all subsystems, created on the first call.
+  static Executor & Instance();
+
+  // Returns false when the executor is shut down.
+  bool Push(Priority priority, Task && task);
+
+  // Same as computational::ThreadPool::Submit() but with the priority class.
+  // Returns an invalid future when the executor is shut down.
+  template <typename F, typename... Args>
+  auto Submit(Priority priority, F && func, Args &&... args)
+      -> std::future<decltype(func(args...))>
+  {
+    using ResultType = decltype(func(args...));
+    std::packaged_task<ResultType()> task(
+        std::bind(std::forward<F>(func), std::forward<Args>(args)...));
+    std::future<ResultType> result(task.get_future());
+    if (!Push(priority, std::move(task)))
+      return {};
+    return result;
+  }
+
+  // Drops the pending tasks and waits for the running ones.
+  void ShutdownAndJoin();
+
+  size_t GetThreadsCount() const { return m_workers.size(); }
+
+  // Returns true when it's called from a worker of this executor. Code which runs on the
+  // executor must not wait for the tasks it pushes, see Submit().
+  bool IsWorkerThread() const;
+
+private:
+  static size_t constexpr kPrioritiesCount = static_cast<size_t>(Priority::Count);
+
+  struct Worker
+  {
+    std::mutex m_mutex;
+    std::array<std::deque<Task>, kPrioritiesCount> m_queues;
+    // True when the worker runs on an efficiency core.
+    bool m_efficiency = false;
+  };
+
+  void WorkerLoop(size_t index);
+  // Takes a task of |priority| from the queues of |worker| or from the queues of the others.
+  bool TryPop(size_t worker, Priority priority, Task & task);
+  bool TryPop(size_t worker, Task & task, Priority & priority);
+  bool HasRunnableTasks() const;
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::vector<::threads::SimpleThread> m_threads;
+  size_t m_maxBackgroundTasks = 0;
+
+  // Guards |m_shutdown| and the sleeping of the workers. Counters are changed under it when
+  // they may wake a worker up.
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_shutdown = false;
+  std::array<std::atomic<int64_t>, kPrioritiesCount> m_pending = {};
+  std::atomic<size_t> m_runningBackground{0};
+  std::atomic<size_t> m_nextWorker{0};
+
+  DISALLOW_COPY_AND_MOVE(Executor);
+};
+
+// TaskLoop which runs its tasks one by one in the order of pushing on an Executor. It allows
+// the subsystems with single-threaded pools to move onto the shared executor without
+// synchronizing their tasks anew.
+class ExecutorTaskLoop : public TaskLoop
+{
+public:
+  ExecutorTaskLoop(Executor & executor, Executor::Priority priority);
+  // Drops the pending tasks and waits for the running one.
+  ~ExecutorTaskLoop() override;
+
+  // TaskLoop overrides:
+  PushResult Push(Task && task) override;
+  PushResult Push(Task const & task) override;
+
+private:
+  struct State
+  {
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Task> m_tasks;
+    bool m_scheduled = false;
+    bool m_running = false;
+    bool m_shutdown = false;
+  };
+
+  static void RunNext(Executor & executor, Executor::Priority priority,
+                      std::shared_ptr<State> const & state);
+
+  Executor & m_executor;
+  Executor::Priority const m_priority;
+  std::shared_ptr<State> m_state;
+};
+
+std::string DebugPrint(Executor::Priority priority);
+}  // namespace base
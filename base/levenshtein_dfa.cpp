@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -198,6 +199,7 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
                                std::vector<UniString> const & prefixMisprints, size_t maxErrors)
   : m_size(s.size()), m_maxErrors(maxErrors)
 {
+  CHECK_LESS_OR_EQUAL(m_maxErrors, std::numeric_limits<uint8_t>::max(), ());
   m_alphabet.assign(s.begin(), s.end());
   CHECK_LESS_OR_EQUAL(prefixSize, s.size(), ());
 
@@ -226,18 +228,18 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
 
   auto pushState = [&states, &visited, this](State const & state, size_t id)
   {
-    ASSERT_EQUAL(id, m_transitions.size(), ());
+    ASSERT_EQUAL(id, m_accepting.size(), ());
     ASSERT_EQUAL(visited.count(state), 0, (state, id));
 
-    ASSERT_EQUAL(m_transitions.size(), m_accepting.size(), ());
-    ASSERT_EQUAL(m_transitions.size(), m_errorsMade.size(), ());
+    ASSERT_EQUAL(m_accepting.size(), m_errorsMade.size(), ());
+    CHECK_LESS(id, std::numeric_limits<uint32_t>::max(), ());
 
     states.emplace(state);
     visited[state] = id;
-    m_transitions.emplace_back(m_alphabet.size());
-    m_accepting.push_back(false);
-    m_errorsMade.push_back(ErrorsMade(state));
-    m_prefixErrorsMade.push_back(PrefixErrorsMade(state));
+    m_transitions.resize(m_transitions.size() + m_alphabet.size());
+    m_accepting.push_back(0);
+    m_errorsMade.push_back(static_cast<uint8_t>(ErrorsMade(state)));
+    m_prefixErrorsMade.push_back(static_cast<uint8_t>(PrefixErrorsMade(state)));
   };
 
   pushState(MakeStart(), kStartingState);
@@ -253,10 +255,10 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
 
     ASSERT_GREATER(visited.count(curr), 0, (curr));
     auto const id = visited[curr];
-    ASSERT_LESS(id, m_transitions.size(), ());
+    ASSERT_LESS(id, m_accepting.size(), ());
 
     if (IsAccepting(curr))
-      m_accepting[id] = true;
+      m_accepting[id] = 1;
 
     for (size_t i = 0; i < m_alphabet.size(); ++i)
     {
@@ -276,7 +278,7 @@ LevenshteinDFA::LevenshteinDFA(UniString const & s, size_t prefixSize,
         nid = it->second;
       }
 
-      m_transitions[id][i] = nid;
+      m_transitions[id * m_alphabet.size() + i] = static_cast<uint32_t>(nid);
     }
   }
 }
@@ -360,19 +362,28 @@ size_t LevenshteinDFA::PrefixErrorsMade(State const & s) const
   return errorsMade;
 }
 
-size_t LevenshteinDFA::Move(size_t s, UniChar c) const
+size_t LevenshteinDFA::GetLetterIndex(UniChar c) const
 {
   ASSERT_GREATER(m_alphabet.size(), 0, ());
   ASSERT(is_sorted(m_alphabet.begin(), m_alphabet.end() - 1), ());
 
-  size_t i;
+  size_t const n = m_alphabet.size() - 1;
+
+  // Alphabets of the search tokens are short, a branchless scan over them is faster than
+  // the binary search and the compilers vectorize it.
+  size_t constexpr kMaxScannedAlphabetSize = 16;
+  if (n <= kMaxScannedAlphabetSize)
+  {
+    size_t i = n;
+    for (size_t j = 0; j < n; ++j)
+      i = m_alphabet[j] == c ? j : i;
+    return i;
+  }
+
   auto const it = lower_bound(m_alphabet.begin(), m_alphabet.end() - 1, c);
   if (it == m_alphabet.end() - 1 || *it != c)
-    i = m_alphabet.size() - 1;
-  else
-    i = distance(m_alphabet.begin(), it);
-
-  return m_transitions[s][i];
+    return n;
+  return static_cast<size_t>(distance(m_alphabet.begin(), it));
 }
 
 std::string DebugPrint(LevenshteinDFA::Position const & p)
@@ -3,6 +3,7 @@
 #include "base/string_utils.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -104,7 +105,7 @@ public:
 
   inline Iterator Begin() const { return Iterator(*this); }
 
-  size_t GetNumStates() const { return m_transitions.size(); }
+  size_t GetNumStates() const { return m_accepting.size(); }
   size_t GetAlphabetSize() const { return m_alphabet.size(); }
 
 private:
@@ -118,7 +119,7 @@ private:
 
   bool IsAccepting(Position const & p) const;
   bool IsAccepting(State const & s) const;
-  inline bool IsAccepting(size_t s) const { return m_accepting[s]; }
+  inline bool IsAccepting(size_t s) const { return m_accepting[s] != 0; }
 
   inline bool IsRejecting(State const & s) const { return s.m_positions.empty(); }
   inline bool IsRejecting(size_t s) const { return s == kRejectingState; }
@@ -131,17 +132,26 @@ private:
   size_t PrefixErrorsMade(State const & s) const;
   size_t PrefixErrorsMade(size_t s) const { return m_prefixErrorsMade[s]; }
 
-  size_t Move(size_t s, UniChar c) const;
+  // Returns index of |c| in |m_alphabet|, all the letters which are not in the pattern
+  // share the last index.
+  size_t GetLetterIndex(UniChar c) const;
+
+  size_t Move(size_t s, UniChar c) const
+  {
+    return m_transitions[s * m_alphabet.size() + GetLetterIndex(c)];
+  }
 
   size_t const m_size;
   size_t const m_maxErrors;
 
   std::vector<UniChar> m_alphabet;
 
-  std::vector<std::vector<size_t>> m_transitions;
-  std::vector<bool> m_accepting;
-  std::vector<size_t> m_errorsMade;
-  std::vector<size_t> m_prefixErrorsMade;
+  // Transitions of all states in a single table, a row of |m_alphabet.size()| entries
+  // per state, so a move is a single lookup.
+  std::vector<uint32_t> m_transitions;
+  std::vector<uint8_t> m_accepting;
+  std::vector<uint8_t> m_errorsMade;
+  std::vector<uint8_t> m_prefixErrorsMade;
 };
 
 std::string DebugPrint(LevenshteinDFA::Position const & p);
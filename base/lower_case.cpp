@@ -178,9 +178,24 @@ void MakeLowerCaseInplace(UniString & s)
 {
   size_t const size = s.size();
 
+  // Chars which are lowered to a single char are replaced in place, so the string is copied
+  // only from the first char which is replaced with several ones.
+  size_t i = 0;
+  for (; i < size; ++i)
+  {
+    UniChar const c = LowerUniChar(s[i]);
+    if (c == 0)
+      break;
+    s[i] = c;
+  }
+
+  if (i == size)
+    return;
+
   UniString r;
-  r.reserve(size);
-  for (size_t i = 0; i < size; ++i)
+  r.reserve(size + 2);
+  r.append(s.begin(), s.begin() + i);
+  for (; i < size; ++i)
   {
     UniChar const c = LowerUniChar(s[i]);
     if (c != 0)
@@ -45,6 +45,13 @@ public:
     return value;
   }
 
+  /// \brief Removes all items from the cache.
+  void Clear()
+  {
+    m_cache.clear();
+    m_keyAge.Clear();
+  }
+
   /// \brief Checks for coherence class params.
   /// \note It's a time consumption method and should be called for tests only.
   bool IsValidForTesting() const
@@ -106,6 +113,12 @@ private:
       return m_ageToKey.cbegin()->second;
     }
 
+    void Clear()
+    {
+      m_ageToKey.clear();
+      m_keyToAge.clear();
+    }
+
     void RemoveLru()
     {
       Key const & lru = GetLruKey();
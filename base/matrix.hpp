@@ -195,6 +195,34 @@ namespace math
     return res;
   }
 
+  template <typename T, unsigned M, unsigned N>
+  Matrix<T, M, N> const operator+(Matrix<T, M, N> const & l, Matrix<T, M, N> const & r)
+  {
+    Matrix<T, M, N> res;
+    for (size_t i = 0; i < M * N; ++i)
+      res.m_data[i] = l.m_data[i] + r.m_data[i];
+    return res;
+  }
+
+  template <typename T, unsigned M, unsigned N>
+  Matrix<T, M, N> const operator-(Matrix<T, M, N> const & l, Matrix<T, M, N> const & r)
+  {
+    Matrix<T, M, N> res;
+    for (size_t i = 0; i < M * N; ++i)
+      res.m_data[i] = l.m_data[i] - r.m_data[i];
+    return res;
+  }
+
+  template <typename T, unsigned M, unsigned N>
+  Matrix<T, N, M> const Transpose(Matrix<T, M, N> const & m)
+  {
+    Matrix<T, N, M> res;
+    for (size_t i = 0; i < M; ++i)
+      for (size_t j = 0; j < N; ++j)
+        res(j, i) = m(i, j);
+    return res;
+  }
+
   template <typename T, unsigned M, unsigned N> std::string DebugPrint(Matrix<T, M, N> const & m)
   {
     std::ostringstream ss;
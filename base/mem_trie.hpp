@@ -281,9 +281,12 @@ public:
     curr->AddValue(std::forward<Args>(args)...);
   }
 
-  void Erase(String const & key, Value const & value)
+  // Erases values from the values holder of |key|. |args| are passed to the Erase() of the
+  // holder, usually it's a single value.
+  template <typename... Args>
+  void Erase(String const & key, Args &&... args)
   {
-    Erase(m_root, key.begin(), key.end(), value);
+    Erase(m_root, key.begin(), key.end(), std::forward<Args>(args)...);
   }
 
   // Traverses all key-value pairs in the trie and calls |toDo| on each of them.
@@ -448,9 +451,10 @@ private:
       m_values.Add(std::forward<Args>(args)...);
     }
 
-    void EraseValue(Value const & value)
+    template <typename... Args>
+    void EraseValue(Args &&... args)
     {
-      m_values.Erase(value);
+      m_values.Erase(std::forward<Args>(args)...);
     }
 
     bool Empty() const { return m_moves.Empty() && m_values.Empty(); }
@@ -526,12 +530,12 @@ private:
     }
   }
 
-  template <typename It>
-  void Erase(Node & root, It cur, It end, Value const & value)
+  template <typename It, typename... Args>
+  void Erase(Node & root, It cur, It end, Args &&... args)
   {
     if (cur == end)
     {
-      root.EraseValue(value);
+      root.EraseValue(std::forward<Args>(args)...);
       if (root.m_values.Empty() && root.m_moves.Size() == 1)
       {
         Node child;
@@ -559,7 +563,7 @@ private:
 
     if (i == edge.Size())
     {
-      Erase(*child, cur, end, value);
+      Erase(*child, cur, end, std::forward<Args>(args)...);
       if (child->Empty())
         root.EraseMove(symbol);
     }
@@ -0,0 +1,228 @@
+#include "base/profiler.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace base
+{
+namespace profiler
+{
+namespace internal
+{
+std::atomic<bool> g_enabled{false};
+}  // namespace internal
+
+namespace
+{
+struct ThreadBuffer
+{
+  // Guards all the fields below. It's taken by the owner thread on every event and by
+  // the collecting thread only, so it's almost never contended.
+  std::mutex m_mutex;
+  uint32_t m_id = 0;
+  std::string m_name;
+  // Ring buffer of the last events. The events of the previous generations are stale.
+  std::vector<Event> m_events;
+  size_t m_capacity = 0;
+  size_t m_next = 0;
+  uint64_t m_generation = 0;
+};
+
+class Registry
+{
+public:
+  static Registry & Instance()
+  {
+    static Registry registry;
+    return registry;
+  }
+
+  std::shared_ptr<ThreadBuffer> CreateBuffer()
+  {
+    auto buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    buffer->m_id = m_nextId++;
+    m_buffers.push_back(buffer);
+    return buffer;
+  }
+
+  void Reset(size_t eventsPerThread)
+  {
+    CHECK_GREATER(eventsPerThread, 0, ());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = eventsPerThread;
+    ++m_generation;
+    // Buffers which are referenced by the registry only belong to finished threads.
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                   [](auto const & b) { return b.use_count() == 1; }),
+                    m_buffers.end());
+  }
+
+  void Add(ThreadBuffer & buffer, Event const & e)
+  {
+    std::lock_guard<std::mutex> lock(buffer.m_mutex);
+    uint64_t const generation = m_generation.load(std::memory_order_acquire);
+    if (buffer.m_generation != generation)
+    {
+      buffer.m_generation = generation;
+      buffer.m_events.clear();
+      buffer.m_capacity = m_capacity;
+      buffer.m_next = 0;
+    }
+
+    if (buffer.m_events.size() < buffer.m_capacity)
+    {
+      buffer.m_events.push_back(e);
+      return;
+    }
+    buffer.m_events[buffer.m_next] = e;
+    buffer.m_next = (buffer.m_next + 1) % buffer.m_events.size();
+  }
+
+  template <typename Fn>
+  void ForEachBuffer(Fn && fn)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint64_t const generation = m_generation;
+    for (auto const & buffer : m_buffers)
+    {
+      std::lock_guard<std::mutex> bufferLock(buffer->m_mutex);
+      fn(*buffer, buffer->m_generation == generation);
+    }
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+  uint32_t m_nextId = 1;
+  std::atomic<size_t> m_capacity{kDefaultEventsPerThread};
+  std::atomic<uint64_t> m_generation{0};
+};
+
+ThreadBuffer & GetThreadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer = Registry::Instance().CreateBuffer();
+  return *buffer;
+}
+
+void WriteJsonString(std::ostream & os, std::string const & s)
+{
+  os << '"';
+  for (char const c : s)
+  {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      os << ' ';
+    else
+      os << c;
+  }
+  os << '"';
+}
+}  // namespace
+
+namespace internal
+{
+uint64_t NowUs()
+{
+  using namespace std::chrono;
+  static auto const start = steady_clock::now();
+  return duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+
+void AddEvent(char const * name, uint64_t startUs, uint64_t endUs)
+{
+  auto & buffer = GetThreadBuffer();
+  Event e;
+  e.m_name = name;
+  e.m_threadId = buffer.m_id;
+  e.m_startUs = startUs;
+  e.m_durationUs = endUs - startUs;
+  Registry::Instance().Add(buffer, e);
+}
+}  // namespace internal
+
+void Enable(size_t eventsPerThread)
+{
+  // Starts the clock before the first scope.
+  internal::NowUs();
+  Registry::Instance().Reset(eventsPerThread);
+  internal::g_enabled = true;
+}
+
+void Disable() { internal::g_enabled = false; }
+
+void SetThreadName(std::string const & name)
+{
+  auto & buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(buffer.m_mutex);
+  buffer.m_name = name;
+}
+
+std::vector<Event> GetEvents()
+{
+  std::vector<Event> events;
+  Registry::Instance().ForEachBuffer([&events](ThreadBuffer const & buffer, bool isActual) {
+    if (isActual)
+      events.insert(events.end(), buffer.m_events.begin(), buffer.m_events.end());
+  });
+  // Outer scopes finish later but start earlier, so they go first for the equal start times.
+  std::sort(events.begin(), events.end(), [](Event const & lhs, Event const & rhs) {
+    if (lhs.m_startUs != rhs.m_startUs)
+      return lhs.m_startUs < rhs.m_startUs;
+    return lhs.m_durationUs > rhs.m_durationUs;
+  });
+  return events;
+}
+
+void WriteChromeTrace(std::ostream & os)
+{
+  std::map<uint32_t, std::string> threadNames;
+  Registry::Instance().ForEachBuffer([&threadNames](ThreadBuffer const & buffer, bool) {
+    if (!buffer.m_name.empty())
+      threadNames[buffer.m_id] = buffer.m_name;
+  });
+
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  auto const nextEvent = [&]() {
+    os << (first ? "\n" : ",\n");
+    first = false;
+  };
+
+  for (auto const & [id, name] : threadNames)
+  {
+    nextEvent();
+    os << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << id << R"(,"args":{"name":)";
+    WriteJsonString(os, name);
+    os << "}}";
+  }
+
+  for (auto const & e : GetEvents())
+  {
+    nextEvent();
+    os << R"({"name":)";
+    WriteJsonString(os, e.m_name);
+    os << R"(,"ph":"X","pid":1,"tid":)" << e.m_threadId << R"(,"ts":)" << e.m_startUs
+       << R"(,"dur":)" << e.m_durationUs << "}";
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool SaveChromeTrace(std::string const & path)
+{
+  std::ofstream os(path);
+  if (!os)
+    return false;
+  WriteChromeTrace(os);
+  return static_cast<bool>(os);
+}
+}  // namespace profiler
+}  // namespace base
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Sampling of named scopes which may be switched on and off at runtime, e.g. for field captures.
+// When the profiler is disabled a scope costs a single relaxed atomic load. When it is enabled
+// every thread records its finished scopes into its own ring buffer, so the threads do not
+// contend with each other. Unlike base::PProf it needs no external libraries.
+//
+// Usage:
+//   void Geocoder::GoImpl(...)
+//   {
+//     PROFILER_SCOPE("Geocoder::GoImpl");
+//     ...
+//   }
+namespace base
+{
+namespace profiler
+{
+struct Event
+{
+  // Name of the scope. It's a pointer to a string literal, see Scope.
+  char const * m_name = nullptr;
+  // Small sequential id of the thread which executed the scope.
+  uint32_t m_threadId = 0;
+  // Microseconds since the start of the process.
+  uint64_t m_startUs = 0;
+  uint64_t m_durationUs = 0;
+};
+
+size_t constexpr kDefaultEventsPerThread = 16 * 1024;
+
+namespace internal
+{
+extern std::atomic<bool> g_enabled;
+
+uint64_t NowUs();
+void AddEvent(char const * name, uint64_t startUs, uint64_t endUs);
+}  // namespace internal
+
+// Starts collection of the scopes, the events collected before are dropped.
+// Every thread keeps at most |eventsPerThread| last events.
+void Enable(size_t eventsPerThread = kDefaultEventsPerThread);
+// Stops collection. The collected events are kept until the next Enable().
+void Disable();
+inline bool IsEnabled() { return internal::g_enabled.load(std::memory_order_relaxed); }
+
+// Names the current thread in the exported traces.
+void SetThreadName(std::string const & name);
+
+// Returns the collected events of all threads ordered by the start time.
+std::vector<Event> GetEvents();
+
+// Writes the collected events in the Chrome trace event format, which is understood by
+// chrome://tracing as well as by the Perfetto UI.
+void WriteChromeTrace(std::ostream & os);
+bool SaveChromeTrace(std::string const & path);
+
+// Records the time between its construction and destruction when the profiler is enabled.
+// |name| must outlive the profiler data, so only string literals should be used.
+class Scope
+{
+public:
+  explicit Scope(char const * name) : m_name(IsEnabled() ? name : nullptr)
+  {
+    if (m_name != nullptr)
+      m_startUs = internal::NowUs();
+  }
+
+  ~Scope()
+  {
+    if (m_name != nullptr)
+      internal::AddEvent(m_name, m_startUs, internal::NowUs());
+  }
+
+private:
+  char const * const m_name;
+  uint64_t m_startUs = 0;
+
+  DISALLOW_COPY_AND_MOVE(Scope);
+};
+}  // namespace profiler
+}  // namespace base
+
+#define PROFILER_SCOPE_CONCAT_IMPL(x, y) x##y
+#define PROFILER_SCOPE_CONCAT(x, y) PROFILER_SCOPE_CONCAT_IMPL(x, y)
+#define PROFILER_SCOPE(name) \
+  ::base::profiler::Scope const PROFILER_SCOPE_CONCAT(profilerScope, __LINE__)(name)
@@ -130,6 +130,19 @@ void EraseIf(Cont & c, Fn && fn)
   c.erase(std::remove_if(c.begin(), c.end(), std::forward<Fn>(fn)), c.end());
 }
 
+// Same as EraseIf() but for the associative containers, |fn| is called for the keys.
+template <typename Map, typename Fn>
+void EraseKeysIf(Map & m, Fn && fn)
+{
+  for (auto it = m.begin(); it != m.end();)
+  {
+    if (fn(it->first))
+      it = m.erase(it);
+    else
+      ++it;
+  }
+}
+
 template <typename Cont, typename Fn>
 bool AllOf(Cont && c, Fn && fn)
 {
@@ -110,6 +110,13 @@ UniString MakeLowerCase(UniString const & s)
 
 void MakeLowerCaseInplace(std::string & s)
 {
+  // Most of the names are ASCII ones which are lowered in place.
+  if (IsASCIIString(s))
+  {
+    AsciiToLower(s);
+    return;
+  }
+
   UniString uniStr;
   utf8::unchecked::utf8to32(s.begin(), s.end(), std::back_inserter(uniStr));
   MakeLowerCaseInplace(uniStr);
@@ -133,6 +140,10 @@ UniString Normalize(UniString const & s)
 
 std::string Normalize(std::string const & s)
 {
+  // ASCII chars are not changed by the normalization.
+  if (IsASCIIString(s))
+    return s;
+
   auto uniString = MakeUniString(s);
   NormalizeInplace(uniString);
   return ToUtf8(uniString);
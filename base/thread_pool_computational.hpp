@@ -115,6 +115,9 @@ public:
     m_condition.notify_all();
   }
 
+  // Returns the number of worker threads.
+  size_t Size() const { return m_threads.size(); }
+
   void WaitingStop()
   {
     {
@@ -0,0 +1,266 @@
+#include "coding/bit_group_ops.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+#include "base/macros.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CODING_BIT_GROUP_OPS_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define CODING_BIT_GROUP_OPS_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace std;
+
+namespace coding
+{
+namespace bit_group_ops
+{
+namespace
+{
+enum class Op
+{
+  And,
+  AndNot,
+  Or
+};
+
+template <Op op>
+uint64_t Apply(uint64_t a, uint64_t b)
+{
+  switch (op)
+  {
+  case Op::And: return a & b;
+  case Op::AndNot: return a & ~b;
+  case Op::Or: return a | b;
+  }
+  UNREACHABLE();
+}
+
+template <Op op>
+uint64_t ScalarOp(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t n)
+{
+  uint64_t popCount = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    res[i] = Apply<op>(a[i], b[i]);
+    popCount += bits::PopCount(res[i]);
+  }
+  return popCount;
+}
+
+uint64_t ScalarPopCount(uint64_t const * a, size_t n)
+{
+  uint64_t popCount = 0;
+  for (size_t i = 0; i < n; ++i)
+    popCount += bits::PopCount(a[i]);
+  return popCount;
+}
+
+#if defined(CODING_BIT_GROUP_OPS_AVX2)
+// There is no vector popcount in AVX2, but the hardware scalar one
+// is fast enough to keep up with the loads and stores.
+template <Op op>
+__attribute__((target("avx2,popcnt"))) uint64_t Avx2Op(uint64_t const * a, uint64_t const * b,
+                                                       uint64_t * res, size_t n)
+{
+  uint64_t popCount = 0;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+  {
+    __m256i const va = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + i));
+    __m256i const vb = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + i));
+    __m256i vr;
+    if (op == Op::And)
+      vr = _mm256_and_si256(va, vb);
+    else if (op == Op::AndNot)
+      vr = _mm256_andnot_si256(vb, va);
+    else
+      vr = _mm256_or_si256(va, vb);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(res + i), vr);
+
+    popCount += static_cast<uint64_t>(_mm_popcnt_u64(res[i])) + _mm_popcnt_u64(res[i + 1]) +
+                _mm_popcnt_u64(res[i + 2]) + _mm_popcnt_u64(res[i + 3]);
+  }
+  for (; i < n; ++i)
+  {
+    res[i] = Apply<op>(a[i], b[i]);
+    popCount += _mm_popcnt_u64(res[i]);
+  }
+  return popCount;
+}
+
+__attribute__((target("popcnt"))) uint64_t Avx2PopCount(uint64_t const * a, size_t n)
+{
+  uint64_t popCount = 0;
+  for (size_t i = 0; i < n; ++i)
+    popCount += _mm_popcnt_u64(a[i]);
+  return popCount;
+}
+#endif  // CODING_BIT_GROUP_OPS_AVX2
+
+#if defined(CODING_BIT_GROUP_OPS_NEON)
+uint64_t NeonPopCount(uint64x2_t v)
+{
+  // At most 16 * 8 = 128 bits are set, so the sum fits into uint8_t.
+  return vaddvq_u8(vcntq_u8(vreinterpretq_u8_u64(v)));
+}
+
+template <Op op>
+uint64_t NeonOp(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t n)
+{
+  uint64_t popCount = 0;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2)
+  {
+    uint64x2_t const va = vld1q_u64(a + i);
+    uint64x2_t const vb = vld1q_u64(b + i);
+    uint64x2_t vr;
+    if (op == Op::And)
+      vr = vandq_u64(va, vb);
+    else if (op == Op::AndNot)
+      vr = vbicq_u64(va, vb);
+    else
+      vr = vorrq_u64(va, vb);
+    vst1q_u64(res + i, vr);
+    popCount += NeonPopCount(vr);
+  }
+  for (; i < n; ++i)
+  {
+    res[i] = Apply<op>(a[i], b[i]);
+    popCount += bits::PopCount(res[i]);
+  }
+  return popCount;
+}
+
+uint64_t NeonPopCount(uint64_t const * a, size_t n)
+{
+  uint64_t popCount = 0;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2)
+    popCount += NeonPopCount(vld1q_u64(a + i));
+  for (; i < n; ++i)
+    popCount += bits::PopCount(a[i]);
+  return popCount;
+}
+#endif  // CODING_BIT_GROUP_OPS_NEON
+
+struct Kernels
+{
+  using BinaryFn = uint64_t (*)(uint64_t const *, uint64_t const *, uint64_t *, size_t);
+  using PopCountFn = uint64_t (*)(uint64_t const *, size_t);
+
+  Impl m_impl;
+  BinaryFn m_and;
+  BinaryFn m_andNot;
+  BinaryFn m_or;
+  PopCountFn m_popCount;
+};
+
+Kernels const kScalarKernels = {Impl::Scalar, &ScalarOp<Op::And>, &ScalarOp<Op::AndNot>,
+                                &ScalarOp<Op::Or>, &ScalarPopCount};
+
+#if defined(CODING_BIT_GROUP_OPS_AVX2)
+Kernels const kAvx2Kernels = {Impl::Avx2, &Avx2Op<Op::And>, &Avx2Op<Op::AndNot>,
+                              &Avx2Op<Op::Or>, &Avx2PopCount};
+#endif
+
+#if defined(CODING_BIT_GROUP_OPS_NEON)
+Kernels const kNeonKernels = {Impl::Neon, &NeonOp<Op::And>, &NeonOp<Op::AndNot>,
+                              &NeonOp<Op::Or>, &NeonPopCount};
+#endif
+
+Kernels const & GetKernels(Impl impl)
+{
+  switch (impl)
+  {
+  case Impl::Scalar: return kScalarKernels;
+#if defined(CODING_BIT_GROUP_OPS_AVX2)
+  case Impl::Avx2: return kAvx2Kernels;
+#endif
+#if defined(CODING_BIT_GROUP_OPS_NEON)
+  case Impl::Neon: return kNeonKernels;
+#endif
+  default: CHECK(false, ("Unsupported implementation:", DebugPrint(impl)));
+  }
+  UNREACHABLE();
+}
+
+Impl DetectImpl()
+{
+  if (IsSupported(Impl::Avx2))
+    return Impl::Avx2;
+  if (IsSupported(Impl::Neon))
+    return Impl::Neon;
+  return Impl::Scalar;
+}
+
+Kernels const *& CurrentKernels()
+{
+  static Kernels const * kernels = &GetKernels(DetectImpl());
+  return kernels;
+}
+}  // namespace
+
+string DebugPrint(Impl impl)
+{
+  switch (impl)
+  {
+  case Impl::Scalar: return "Scalar";
+  case Impl::Avx2: return "Avx2";
+  case Impl::Neon: return "Neon";
+  }
+  UNREACHABLE();
+}
+
+uint64_t And(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t n)
+{
+  return CurrentKernels()->m_and(a, b, res, n);
+}
+
+uint64_t AndNot(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t n)
+{
+  return CurrentKernels()->m_andNot(a, b, res, n);
+}
+
+uint64_t Or(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t n)
+{
+  return CurrentKernels()->m_or(a, b, res, n);
+}
+
+uint64_t PopCount(uint64_t const * a, size_t n) { return CurrentKernels()->m_popCount(a, n); }
+
+Impl GetImpl() { return CurrentKernels()->m_impl; }
+
+bool IsSupported(Impl impl)
+{
+  switch (impl)
+  {
+  case Impl::Scalar: return true;
+  case Impl::Avx2:
+#if defined(CODING_BIT_GROUP_OPS_AVX2)
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#else
+    return false;
+#endif
+  case Impl::Neon:
+#if defined(CODING_BIT_GROUP_OPS_NEON)
+    return true;
+#else
+    return false;
+#endif
+  }
+  UNREACHABLE();
+}
+
+void SetImplForTesting(Impl impl)
+{
+  CHECK(IsSupported(impl), (DebugPrint(impl)));
+  CurrentKernels() = &GetKernels(impl);
+}
+}  // namespace bit_group_ops
+}  // namespace coding
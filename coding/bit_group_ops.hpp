@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace coding
+{
+// Bulk bitwise operations on arrays of 64-bit bit groups, as used by
+// DenseCBV. Each operation writes |n| groups to |res| and returns the
+// number of set bits in |res|, so callers get both "is empty" and
+// "count" answers without an extra pass. |res| may be equal to |a| or
+// |b|, but must not partially overlap them.
+//
+// The implementation is chosen at runtime: AVX2 on x86-64 CPUs that
+// support it, NEON on AArch64, and a portable scalar loop otherwise.
+namespace bit_group_ops
+{
+enum class Impl
+{
+  Scalar,
+  Avx2,
+  Neon
+};
+
+std::string DebugPrint(Impl impl);
+
+// res[i] = a[i] & b[i].
+uint64_t And(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t n);
+
+// res[i] = a[i] & ~b[i].
+uint64_t AndNot(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t n);
+
+// res[i] = a[i] | b[i].
+uint64_t Or(uint64_t const * a, uint64_t const * b, uint64_t * res, size_t n);
+
+// Returns the number of set bits in |a|.
+uint64_t PopCount(uint64_t const * a, size_t n);
+
+// Returns the implementation used by the functions above.
+Impl GetImpl();
+
+// Returns true when |impl| can be used on the current CPU.
+bool IsSupported(Impl impl);
+
+// Makes the functions above use |impl|, which must be supported.
+// Not thread-safe, intended for tests and benchmarks only.
+void SetImplForTesting(Impl impl);
+}  // namespace bit_group_ops
+}  // namespace coding
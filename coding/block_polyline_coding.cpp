@@ -0,0 +1,77 @@
+#include "coding/block_polyline_coding.hpp"
+
+#include "coding/byte_stream.hpp"
+
+namespace coding
+{
+BlockPolylineDecoder::BlockPolylineDecoder(void const * data)
+  : m_beg(static_cast<uint8_t const *>(data))
+{
+  ArrayByteSource src(data);
+  m_pointsCount = static_cast<size_t>(ReadVarUint<uint64_t>(src));
+
+  size_t const blocksCount = (m_pointsCount + kPolylineBlockSize - 1) / kPolylineBlockSize;
+  m_blockOffsets.reserve(blocksCount + 1);
+  m_blockOffsets.push_back(0);
+  for (size_t i = 0; i < blocksCount; ++i)
+    m_blockOffsets.push_back(m_blockOffsets.back() + ReadVarUint<uint32_t>(src));
+
+  m_blocks = src.PtrUint8();
+}
+
+size_t BlockPolylineDecoder::GetSerializedSize() const
+{
+  if (m_beg == nullptr)
+    return 0;
+  return static_cast<size_t>(m_blocks - m_beg) + m_blockOffsets.back();
+}
+
+m2::PointU BlockPolylineDecoder::GetPoint(size_t index) const
+{
+  ASSERT_LESS(index, m_pointsCount, ());
+  std::vector<m2::PointU> points;
+  Decode(index, index + 1, points);
+  return points.front();
+}
+
+void BlockPolylineDecoder::Decode(size_t from, size_t to, std::vector<m2::PointU> & points) const
+{
+  ASSERT_LESS_OR_EQUAL(from, to, ());
+  ASSERT_LESS_OR_EQUAL(to, m_pointsCount, ());
+  if (from >= to)
+    return;
+
+  points.reserve(points.size() + to - from);
+  for (size_t block = from / kPolylineBlockSize; block * kPolylineBlockSize < to; ++block)
+  {
+    size_t const blockBeg = block * kPolylineBlockSize;
+    DecodeBlock(block, std::max(from, blockBeg) - blockBeg,
+                std::min(to, blockBeg + kPolylineBlockSize) - blockBeg, points);
+  }
+}
+
+void BlockPolylineDecoder::DecodeBlock(size_t block, size_t from, size_t to,
+                                       std::vector<m2::PointU> & points) const
+{
+  ArrayByteSource src(m_blocks + m_blockOffsets[block]);
+  m2::PointU point;
+  point.x = ReadVarUint<uint32_t>(src);
+  point.y = ReadVarUint<uint32_t>(src);
+  auto const widthX = src.ReadByte();
+  auto const widthY = src.ReadByte();
+
+  if (from == 0)
+    points.push_back(point);
+
+  BitReader<ArrayByteSource> bitReader(src);
+  for (size_t i = 1; i < to; ++i)
+  {
+    auto const dx = bits::ZigZagDecode(bitReader.ReadAtMost64Bits(widthX));
+    auto const dy = bits::ZigZagDecode(bitReader.ReadAtMost64Bits(widthY));
+    point.x = static_cast<uint32_t>(static_cast<int64_t>(point.x) + dx);
+    point.y = static_cast<uint32_t>(static_cast<int64_t>(point.y) + dy);
+    if (i >= from)
+      points.push_back(point);
+  }
+}
+}  // namespace coding
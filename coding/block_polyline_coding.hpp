@@ -0,0 +1,114 @@
+#pragma once
+
+#include "coding/bit_streams.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/bits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace coding
+{
+// Block based polyline encoding with random access to the points.
+// Points are split into blocks of kPolylineBlockSize points. A block stores its first point
+// as is and deltas of the other points packed with the bit widths chosen for the block.
+// Sizes of all blocks are stored before them, so any block is decoded without decoding
+// the previous ones.
+//
+// Format:
+//   varint    points count
+//   varint[]  sizes of the blocks in bytes
+//   blocks:
+//     varint  x and y of the first point
+//     uint8   bit widths of x and y deltas
+//     bits    zigzag encoded deltas of the rest points, padded to the byte border
+size_t constexpr kPolylineBlockSize = 64;
+
+namespace impl
+{
+template <typename Sink>
+void EncodePolylineBlock(m2::PointU const * points, size_t count, Sink & sink)
+{
+  ASSERT_GREATER(count, 0, ());
+  WriteVarUint(sink, points[0].x);
+  WriteVarUint(sink, points[0].y);
+
+  auto const delta = [](uint32_t prev, uint32_t next) {
+    return bits::ZigZagEncode(static_cast<int64_t>(next) - static_cast<int64_t>(prev));
+  };
+
+  uint8_t widthX = 0;
+  uint8_t widthY = 0;
+  for (size_t i = 1; i < count; ++i)
+  {
+    auto const dx = delta(points[i - 1].x, points[i].x);
+    auto const dy = delta(points[i - 1].y, points[i].y);
+    widthX = std::max(widthX, static_cast<uint8_t>(bits::NumUsedBits(dx)));
+    widthY = std::max(widthY, static_cast<uint8_t>(bits::NumUsedBits(dy)));
+  }
+  WriteToSink(sink, widthX);
+  WriteToSink(sink, widthY);
+
+  BitWriter<Sink> bitWriter(sink);
+  for (size_t i = 1; i < count; ++i)
+  {
+    bitWriter.WriteAtMost64Bits(delta(points[i - 1].x, points[i].x), widthX);
+    bitWriter.WriteAtMost64Bits(delta(points[i - 1].y, points[i].y), widthY);
+  }
+}
+}  // namespace impl
+
+template <typename Sink>
+void EncodeBlockPolyline(std::vector<m2::PointU> const & points, Sink & sink)
+{
+  std::vector<std::vector<uint8_t>> blocks;
+  for (size_t i = 0; i < points.size(); i += kPolylineBlockSize)
+  {
+    blocks.emplace_back();
+    MemWriter<std::vector<uint8_t>> writer(blocks.back());
+    impl::EncodePolylineBlock(points.data() + i, std::min(kPolylineBlockSize, points.size() - i),
+                              writer);
+  }
+
+  WriteVarUint(sink, static_cast<uint64_t>(points.size()));
+  for (auto const & block : blocks)
+    WriteVarUint(sink, static_cast<uint32_t>(block.size()));
+  for (auto const & block : blocks)
+    sink.Write(block.data(), block.size());
+}
+
+// Decodes points of a polyline saved by EncodeBlockPolyline right from the memory of
+// the serialized polyline. Only the blocks of the requested points are decoded.
+class BlockPolylineDecoder
+{
+public:
+  BlockPolylineDecoder() = default;
+  // |data| points to the beginning of the serialized polyline.
+  explicit BlockPolylineDecoder(void const * data);
+
+  size_t GetPointsCount() const { return m_pointsCount; }
+  // Returns size of the serialized polyline in bytes.
+  size_t GetSerializedSize() const;
+
+  m2::PointU GetPoint(size_t index) const;
+  // Appends points [from, to) to |points|.
+  void Decode(size_t from, size_t to, std::vector<m2::PointU> & points) const;
+
+private:
+  // Appends points [from, to) of the block to |points|, the indices are relative to the block.
+  void DecodeBlock(size_t block, size_t from, size_t to, std::vector<m2::PointU> & points) const;
+
+  uint8_t const * m_beg = nullptr;
+  uint8_t const * m_blocks = nullptr;
+  // Offsets of the blocks from |m_blocks| and the end offset.
+  std::vector<uint32_t> m_blockOffsets;
+  size_t m_pointsCount = 0;
+};
+}  // namespace coding
@@ -0,0 +1,185 @@
+#include "testing/benchmark.hpp"
+#include "testing/testing.hpp"
+
+#include "coding/bit_group_ops.hpp"
+#include "coding/compressed_bit_vector.hpp"
+
+#include "base/bits.hpp"
+#include "base/logging.hpp"
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+namespace
+{
+vector<bit_group_ops::Impl> const kImpls = {bit_group_ops::Impl::Scalar, bit_group_ops::Impl::Avx2,
+                                            bit_group_ops::Impl::Neon};
+
+class ScopedImpl
+{
+public:
+  explicit ScopedImpl(bit_group_ops::Impl impl) : m_prev(bit_group_ops::GetImpl())
+  {
+    bit_group_ops::SetImplForTesting(impl);
+  }
+
+  ~ScopedImpl() { bit_group_ops::SetImplForTesting(m_prev); }
+
+private:
+  bit_group_ops::Impl const m_prev;
+
+  DISALLOW_COPY_AND_MOVE(ScopedImpl);
+};
+
+vector<uint64_t> MakeGroups(size_t n, mt19937_64 & rng)
+{
+  vector<uint64_t> groups(n);
+  for (auto & group : groups)
+    group = rng();
+  return groups;
+}
+
+// Builds a dense bit vector of |numBits| bits with roughly every
+// |1 / density|-th bit set.
+unique_ptr<CompressedBitVector> MakeDenseCBV(uint64_t numBits, double density, uint64_t seed)
+{
+  mt19937_64 rng(seed);
+  bernoulli_distribution bit(density);
+  vector<uint64_t> setBits;
+  for (uint64_t i = 0; i < numBits; ++i)
+  {
+    if (bit(rng))
+      setBits.push_back(i);
+  }
+  return CompressedBitVectorBuilder::FromBitPositions(move(setBits));
+}
+
+UNIT_TEST(BitGroupOps_Smoke)
+{
+  mt19937_64 rng(0);
+
+  // Sizes cover empty arrays, arrays shorter than a vector register
+  // and arrays with a tail.
+  for (size_t const n : {0, 1, 2, 3, 4, 5, 7, 8, 9, 63, 64, 65, 1000})
+  {
+    auto const a = MakeGroups(n, rng);
+    auto const b = MakeGroups(n, rng);
+
+    vector<uint64_t> expectedAnd(n);
+    vector<uint64_t> expectedAndNot(n);
+    vector<uint64_t> expectedOr(n);
+    uint64_t popCountA = 0;
+    uint64_t popCountAnd = 0;
+    uint64_t popCountAndNot = 0;
+    uint64_t popCountOr = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      expectedAnd[i] = a[i] & b[i];
+      expectedAndNot[i] = a[i] & ~b[i];
+      expectedOr[i] = a[i] | b[i];
+      popCountA += bits::PopCount(a[i]);
+      popCountAnd += bits::PopCount(expectedAnd[i]);
+      popCountAndNot += bits::PopCount(expectedAndNot[i]);
+      popCountOr += bits::PopCount(expectedOr[i]);
+    }
+
+    for (auto const impl : kImpls)
+    {
+      if (!bit_group_ops::IsSupported(impl))
+        continue;
+
+      ScopedImpl scopedImpl(impl);
+      vector<uint64_t> res(n);
+
+      TEST_EQUAL(bit_group_ops::And(a.data(), b.data(), res.data(), n), popCountAnd, (impl, n));
+      TEST_EQUAL(res, expectedAnd, (impl, n));
+
+      TEST_EQUAL(bit_group_ops::AndNot(a.data(), b.data(), res.data(), n), popCountAndNot,
+                 (impl, n));
+      TEST_EQUAL(res, expectedAndNot, (impl, n));
+
+      TEST_EQUAL(bit_group_ops::Or(a.data(), b.data(), res.data(), n), popCountOr, (impl, n));
+      TEST_EQUAL(res, expectedOr, (impl, n));
+
+      TEST_EQUAL(bit_group_ops::PopCount(a.data(), n), popCountA, (impl, n));
+
+      // In-place operation.
+      res = a;
+      TEST_EQUAL(bit_group_ops::And(res.data(), b.data(), res.data(), n), popCountAnd, (impl, n));
+      TEST_EQUAL(res, expectedAnd, (impl, n));
+    }
+  }
+}
+
+UNIT_TEST(BitGroupOps_DenseCBV)
+{
+  auto const a = MakeDenseCBV(10000, 0.5 /* density */, 1 /* seed */);
+  auto const b = MakeDenseCBV(7000, 0.5 /* density */, 2 /* seed */);
+  TEST_EQUAL(a->GetStorageStrategy(), CompressedBitVector::StorageStrategy::Dense, ());
+  TEST_EQUAL(b->GetStorageStrategy(), CompressedBitVector::StorageStrategy::Dense, ());
+
+  unique_ptr<CompressedBitVector> expectedIntersection;
+  unique_ptr<CompressedBitVector> expectedUnion;
+  unique_ptr<CompressedBitVector> expectedSubtraction;
+  {
+    ScopedImpl scopedImpl(bit_group_ops::Impl::Scalar);
+    expectedIntersection = CompressedBitVector::Intersect(*a, *b);
+    expectedUnion = CompressedBitVector::Union(*a, *b);
+    expectedSubtraction = CompressedBitVector::Subtract(*a, *b);
+  }
+
+  for (auto const impl : kImpls)
+  {
+    if (!bit_group_ops::IsSupported(impl))
+      continue;
+
+    ScopedImpl scopedImpl(impl);
+    auto const intersection = CompressedBitVector::Intersect(*a, *b);
+    auto const unionCBV = CompressedBitVector::Union(*a, *b);
+    auto const subtraction = CompressedBitVector::Subtract(*a, *b);
+
+    TEST_EQUAL(CompressedBitVectorHasher::Hash(*intersection),
+               CompressedBitVectorHasher::Hash(*expectedIntersection), (impl));
+    TEST_EQUAL(intersection->PopCount(), expectedIntersection->PopCount(), (impl));
+    TEST_EQUAL(CompressedBitVectorHasher::Hash(*unionCBV),
+               CompressedBitVectorHasher::Hash(*expectedUnion), (impl));
+    TEST_EQUAL(unionCBV->PopCount(), expectedUnion->PopCount(), (impl));
+    TEST_EQUAL(CompressedBitVectorHasher::Hash(*subtraction),
+               CompressedBitVectorHasher::Hash(*expectedSubtraction), (impl));
+    TEST_EQUAL(subtraction->PopCount(), expectedSubtraction->PopCount(), (impl));
+  }
+
+  // Disjoint dense vectors give an empty intersection.
+  vector<uint64_t> const evenBits = {0, 2, 4, 6, 8};
+  vector<uint64_t> const oddBits = {1, 3, 5, 7, 9};
+  auto const even = CompressedBitVectorBuilder::FromBitPositions(evenBits);
+  auto const odd = CompressedBitVectorBuilder::FromBitPositions(oddBits);
+  TEST(CompressedBitVector::IsEmpty(CompressedBitVector::Intersect(*even, *odd)), ());
+}
+
+// Bit vectors of the size of posting lists in a big country mwm.
+BENCHMARK_TEST(BitGroupOps_DenseCBVIntersect)
+{
+  auto const a = MakeDenseCBV(4000000, 0.7 /* density */, 1 /* seed */);
+  auto const b = MakeDenseCBV(4000000, 0.8 /* density */, 2 /* seed */);
+
+  for (auto const impl : kImpls)
+  {
+    if (!bit_group_ops::IsSupported(impl))
+      continue;
+
+    ScopedImpl scopedImpl(impl);
+    LOG(LINFO, ("Implementation:", impl));
+    BENCHMARK_N_TIMES(IF_DEBUG_ELSE(20, 200), 10.0 /* maxTimeToSucceed */)
+    {
+      FORCE_USE_VALUE(CompressedBitVector::Intersect(*a, *b)->PopCount());
+    }
+  }
+}
+}  // namespace
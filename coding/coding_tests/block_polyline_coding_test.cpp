@@ -0,0 +1,83 @@
+#include "testing/testing.hpp"
+
+#include "coding/block_polyline_coding.hpp"
+#include "coding/point_coding.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/geometry_tests/large_polygon.hpp"
+
+#include "base/logging.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace coding;
+using namespace std;
+
+namespace
+{
+vector<uint8_t> Encode(vector<m2::PointU> const & points)
+{
+  vector<uint8_t> data;
+  MemWriter<vector<uint8_t>> writer(data);
+  EncodeBlockPolyline(points, writer);
+  return data;
+}
+
+void TestRoundTrip(vector<m2::PointU> const & points)
+{
+  auto const data = Encode(points);
+  BlockPolylineDecoder const decoder(data.data());
+  TEST_EQUAL(decoder.GetPointsCount(), points.size(), ());
+  TEST_EQUAL(decoder.GetSerializedSize(), data.size(), ());
+
+  vector<m2::PointU> decoded;
+  decoder.Decode(0, points.size(), decoded);
+  TEST_EQUAL(decoded, points, ());
+
+  for (size_t i = 0; i < points.size(); i += 7)
+    TEST_EQUAL(decoder.GetPoint(i), points[i], (i));
+}
+}  // namespace
+
+UNIT_TEST(BlockPolylineCoding_Sizes)
+{
+  mt19937 rng(0);
+  uniform_int_distribution<uint32_t> coord;
+  for (size_t const size : {0, 1, 2, 63, 64, 65, 128, 1000})
+  {
+    vector<m2::PointU> points;
+    for (size_t i = 0; i < size; ++i)
+      points.emplace_back(coord(rng), coord(rng));
+    TestRoundTrip(points);
+  }
+}
+
+UNIT_TEST(BlockPolylineCoding_Ranges)
+{
+  vector<m2::PointU> points;
+  for (auto const & p : LargePolygon::kLargePolygon)
+    points.push_back(PointDToPointU(p, kPointCoordBits));
+
+  auto const data = Encode(points);
+  BlockPolylineDecoder const decoder(data.data());
+  LOG(LINFO, ("Points:", points.size(), "encoded size:", data.size()));
+
+  mt19937 rng(0);
+  uniform_int_distribution<size_t> index(0, points.size());
+  for (size_t i = 0; i < 100; ++i)
+  {
+    auto from = index(rng);
+    auto to = index(rng);
+    if (from > to)
+      swap(from, to);
+
+    // Points are appended to the vector.
+    vector<m2::PointU> decoded = {m2::PointU(1, 2)};
+    decoder.Decode(from, to, decoded);
+    TEST_EQUAL(decoded.size(), to - from + 1, (from, to));
+    TEST_EQUAL(decoded.front(), m2::PointU(1, 2), ());
+    TEST(equal(decoded.begin() + 1, decoded.end(), points.begin() + from), (from, to));
+  }
+}
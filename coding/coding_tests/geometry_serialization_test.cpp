@@ -63,3 +63,32 @@ UNIT_TEST(SaveLoadPolyline_DataSet1)
 
   TEST(IsEqual(r1, r2), (r1, r2));
 }
+
+UNIT_TEST(OuterPathDecoder_DataSet1)
+{
+  using namespace geometry_coding_tests;
+
+  vector<m2::PointD> const data(arr1, arr1 + ARRAY_SIZE(arr1));
+
+  vector<char> buffer;
+  PushBackByteSink<vector<char>> w(buffer);
+
+  serial::GeometryCodingParams cp;
+  serial::SaveOuterPath(data, cp, w);
+  // Garbage after the path should not be read by the decoder.
+  buffer.push_back(0x7F);
+
+  vector<m2::PointD> loaded;
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  serial::LoadOuterPath(src, cp, loaded);
+  TEST_EQUAL(data.size(), loaded.size(), ());
+
+  serial::OuterPathDecoder decoder(buffer.data(), cp);
+  TEST_EQUAL(decoder.GetSerializedSize(), src.Pos(), ());
+
+  vector<m2::PointD> decoded;
+  while (decoder.HasNext())
+    decoded.push_back(decoder.Next());
+  TEST_EQUAL(loaded, decoded, ());
+}
@@ -7,10 +7,12 @@
 #include "coding/buffer_reader.hpp"
 #include "coding/reader_streambuf.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -91,6 +93,38 @@ UNIT_TEST(FileReaderReadAsText)
   FileWriter::DeleteFileX(fName);
 }
 
+UNIT_TEST(FileReaderReadahead)
+{
+  char const fName[] = "reader_readahead_test.dat";
+  vector<uint8_t> data(1024 * 1024 + 17);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i % 251);
+  {
+    FileWriter writer(fName);
+    writer.Write(data.data(), data.size());
+  }
+
+  for (auto const readahead : {FileReader::Readahead::Off, FileReader::Readahead::Sequential})
+  {
+    FileReader reader(fName, FileReader::kDefaultLogPageSize, FileReader::kDefaultLogPageCount,
+                      readahead);
+    vector<uint8_t> buffer(1000);
+    // Sequential reads with small gaps and backward reads.
+    uint64_t pos = 0;
+    for (size_t i = 1; pos < data.size(); ++i)
+    {
+      auto const size = min(buffer.size(), static_cast<size_t>(data.size() - pos));
+      reader.Read(pos, buffer.data(), size);
+      TEST(equal(buffer.begin(), buffer.begin() + size, data.begin() + pos), (pos));
+      pos += size + i % 3;
+      if (i % 100 == 0)
+        pos -= 5000;
+    }
+  }
+
+  FileWriter::DeleteFileX(fName);
+}
+
 UNIT_TEST(ReaderStreamBuf)
 {
   string const name = "test.txt";
@@ -0,0 +1,29 @@
+#include "testing/testing.hpp"
+
+#include "coding/sha1.hpp"
+
+#include <string>
+
+using namespace std;
+
+UNIT_TEST(SHA1_Streaming)
+{
+  string const str = "The quick brown fox jumps over the lazy dog";
+
+  coding::SHA1::Streaming sha1;
+  TEST_EQUAL(sha1.GetSize(), 0, ());
+  TEST_EQUAL(sha1.GetHash(), coding::SHA1::CalculateForString(string()), ());
+
+  for (size_t i = 0; i < str.size(); i += 5)
+  {
+    size_t const size = min(str.size() - i, static_cast<size_t>(5));
+    sha1.Update(str.data() + i, size);
+    TEST_EQUAL(sha1.GetSize(), i + size, ());
+    // Getting the hash doesn't break the subsequent updates.
+    TEST_EQUAL(sha1.GetHash(), coding::SHA1::CalculateForString(str.substr(0, i + size)), ());
+  }
+
+  TEST_EQUAL(coding::SHA1::ToBase64(sha1.GetHash()), "L9ThxnotKPzthJ7hu3bnORuT6xI=", ());
+  TEST_EQUAL(coding::SHA1::ToBase64(sha1.GetHash()),
+             coding::SHA1::CalculateBase64ForString(str), ());
+}
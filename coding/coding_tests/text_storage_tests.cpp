@@ -2,9 +2,11 @@
 
 #include "coding/reader.hpp"
 #include "coding/text_storage.hpp"
+#include "coding/text_storage_cache.hpp"
 #include "coding/writer.hpp"
 
 #include <cstdint>
+#include <memory>
 #include <random>
 #include <string>
 #include <vector>
@@ -31,10 +33,11 @@ string GenerateRandomString(Engine & engine)
   return s;
 }
 
-void DumpStrings(vector<string> const & strings, uint64_t blockSize, vector<uint8_t> & buffer)
+void DumpStrings(vector<string> const & strings, uint64_t blockSize, vector<uint8_t> & buffer,
+                 TextStorageCodec codec = TextStorageCodec::BWT)
 {
   MemWriter<vector<uint8_t>> writer(buffer);
-  BlockedTextStorageWriter<decltype(writer)> ts(writer, blockSize);
+  BlockedTextStorageWriter<decltype(writer)> ts(writer, blockSize, codec);
   for (auto const & s : strings)
     ts.Append(s);
 }
@@ -129,4 +132,105 @@ UNIT_TEST(TextStorage_Random)
   for (size_t i = ts.GetNumStrings() - 1; i < ts.GetNumStrings(); --i)
     TEST_EQUAL(ts.ExtractString(i), strings[i], ());
 }
+
+UNIT_TEST(TextStorage_Codecs)
+{
+  int const kSeed = 42;
+  int const kNumStrings = 300;
+  mt19937 engine(kSeed);
+
+  vector<string> strings = {"", "Hello", "Hello, World!", ""};
+  for (int i = 0; i < kNumStrings; ++i)
+    strings.push_back(GenerateRandomString(engine));
+  strings.emplace_back();
+
+  for (auto const codec : {TextStorageCodec::BWT, TextStorageCodec::ZLib, TextStorageCodec::None})
+  {
+    vector<uint8_t> buffer;
+    DumpStrings(strings, 1000 /* blockSize */, buffer, codec);
+
+    MemReader reader(buffer.data(), buffer.size());
+    BlockedTextStorageIndex index;
+    index.Read(reader);
+    TEST_EQUAL(index.GetCodec(), codec, ());
+    TEST_EQUAL(index.GetNumStrings(), strings.size(), ());
+
+    BlockedTextStorage<decltype(reader)> ts(reader);
+    TEST_EQUAL(ts.GetNumStrings(), strings.size(), ());
+    for (size_t i = 0; i < ts.GetNumStrings(); ++i)
+      TEST_EQUAL(ts.ExtractString(i), strings[i], (i));
+  }
+}
+
+UNIT_TEST(TextStorageCache_Eviction)
+{
+  auto const makeBlock = [](size_t size) {
+    auto block = make_shared<TextStorageBlock>();
+    block->m_value.assign(size, 'a');
+    return block;
+  };
+
+  TextStorageCache cache(100 /* maxSize */);
+  TEST(!cache.Find("storage", 0), ());
+
+  cache.Add("storage", 0, makeBlock(40));
+  cache.Add("storage", 1, makeBlock(40));
+  cache.Add("other", 0, makeBlock(10));
+  TEST(cache.Find("storage", 0), ());
+  TEST(cache.Find("other", 0), ());
+  TEST_EQUAL(cache.GetStats().m_size, 90, ());
+
+  // The least recently used block is evicted.
+  cache.Add("storage", 2, makeBlock(40));
+  TEST(!cache.Find("storage", 1), ());
+  TEST(cache.Find("storage", 0), ());
+  TEST(cache.Find("storage", 2), ());
+
+  // Too big blocks are not cached.
+  cache.Add("storage", 3, makeBlock(101));
+  TEST(!cache.Find("storage", 3), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 4, ());
+  TEST_EQUAL(stats.m_misses, 3, ());
+  TEST_EQUAL(stats.m_blocksCount, 3, ());
+  TEST_EQUAL(stats.m_size, 90, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetStats().m_blocksCount, 0, ());
+  TEST(!cache.Find("storage", 0), ());
+}
+
+UNIT_TEST(TextStorage_SharedCache)
+{
+  vector<string> const strings = {{"", "Hello", "Hello, World!", "Hola mundo", "Smoke test"}};
+
+  vector<uint8_t> buffer;
+  DumpStrings(strings, 10 /* blockSize */, buffer);
+
+  auto & cache = TextStorageCache::Instance();
+  cache.Clear();
+  auto const before = cache.GetStats();
+
+  MemReader reader(buffer.data(), buffer.size());
+  BlockedTextStorageReader first;
+  first.SetCacheId("text_storage_tests");
+  BlockedTextStorageReader second;
+  second.SetCacheId("text_storage_tests");
+
+  for (size_t i = 0; i < strings.size(); ++i)
+    TEST_EQUAL(first.ExtractString(reader, i), strings[i], (i));
+  auto const afterFirst = cache.GetStats();
+  TEST_EQUAL(afterFirst.m_blocksCount, 3, ());
+
+  // Blocks decompressed by the first reader are reused by the second one.
+  for (size_t i = 0; i < strings.size(); ++i)
+    TEST_EQUAL(second.ExtractString(reader, i), strings[i], (i));
+  auto const afterSecond = cache.GetStats();
+  TEST_EQUAL(afterSecond.m_blocksCount, 3, ());
+  TEST_EQUAL(afterSecond.m_misses, afterFirst.m_misses, ());
+  TEST_EQUAL(afterSecond.m_hits - before.m_hits, 2 * strings.size() - 3, ());
+
+  cache.Clear();
+}
 }  // namespace
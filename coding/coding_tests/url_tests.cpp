@@ -4,6 +4,7 @@
 
 #include <queue>
 #include <string>
+#include <string_view>
 #include <utility>
 
 using namespace std;
@@ -106,6 +107,11 @@ UNIT_TEST(UrlDecode)
   TEST_EQUAL(UrlDecode(enc2), orig2, ());
   TEST_EQUAL(UrlDecode(enc3), orig3, ());
   TEST_EQUAL(UrlDecode(enc4), orig4, ());
+
+  // Incomplete escape sequences are skipped.
+  TEST_EQUAL(UrlDecode("a%2"), "a", ());
+  TEST_EQUAL(UrlDecode("a%"), "a", ());
+  TEST_EQUAL(UrlDecode(std::string_view("a%20b").substr(1, 3)), " ", ());
 }
 
 UNIT_TEST(ProcessURL_Smoke)
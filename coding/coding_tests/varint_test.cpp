@@ -6,6 +6,7 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <limits>
 #include <vector>
 
 using namespace std;
@@ -181,3 +182,36 @@ UNIT_TEST(ReadVarInt64Array)
   }
 }
 
+
+UNIT_TEST(ReadVarUint64Array_AllSizes)
+{
+  // Values of all varint sizes from 1 to 10 bytes in different orders, so the word decoding
+  // meets each size at each position of the buffer.
+  vector<uint64_t> values;
+  for (uint32_t bits = 0; bits < 64; bits += 7)
+  {
+    values.push_back(1ULL << bits);
+    values.push_back((1ULL << bits) - 1);
+  }
+  values.push_back(numeric_limits<uint64_t>::max());
+
+  for (size_t shift = 0; shift < values.size(); ++shift)
+  {
+    vector<uint64_t> testValues;
+    for (size_t i = 0; i < 3 * values.size(); ++i)
+      testValues.push_back(values[(i * (shift + 1) + shift) % values.size()]);
+
+    vector<uint8_t> data;
+    {
+      PushBackByteSink<vector<uint8_t>> dst(data);
+      for (auto const v : testValues)
+        WriteVarUint(dst, v);
+    }
+
+    vector<uint64_t> result;
+    void const * pEnd = ReadVarUint64Array(data.data(), data.data() + data.size(),
+                                           base::MakeBackInsertFunctor(result));
+    TEST_EQUAL(pEnd, data.data() + data.size(), (shift));
+    TEST_EQUAL(result, testValues, (shift));
+  }
+}
@@ -1,5 +1,6 @@
 #include "coding/compressed_bit_vector.hpp"
 
+#include "coding/bit_group_ops.hpp"
 #include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
@@ -13,6 +14,8 @@ namespace coding
 {
 namespace
 {
+unique_ptr<CompressedBitVector> FromBitGroups(vector<uint64_t> && bitGroups, uint64_t popCount);
+
 struct IntersectOp
 {
   IntersectOp() {}
@@ -23,9 +26,9 @@ struct IntersectOp
     size_t const sizeA = a.NumBitGroups();
     size_t const sizeB = b.NumBitGroups();
     vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & b.GetBitGroup(i);
-    return coding::CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
+    uint64_t const popCount =
+        bit_group_ops::And(a.BitGroups(), b.BitGroups(), resGroups.data(), resGroups.size());
+    return FromBitGroups(move(resGroups), popCount);
   }
 
   // The intersection of dense and sparse is always sparse.
@@ -67,9 +70,9 @@ struct SubtractOp
     size_t const sizeA = a.NumBitGroups();
     size_t const sizeB = b.NumBitGroups();
     vector<uint64_t> resGroups(min(sizeA, sizeB));
-    for (size_t i = 0; i < resGroups.size(); ++i)
-      resGroups[i] = a.GetBitGroup(i) & ~b.GetBitGroup(i);
-    return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
+    uint64_t const popCount =
+        bit_group_ops::AndNot(a.BitGroups(), b.BitGroups(), resGroups.data(), resGroups.size());
+    return FromBitGroups(move(resGroups), popCount);
   }
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
@@ -133,19 +136,13 @@ struct UnionOp
     size_t commonSize = min(sizeA, sizeB);
     size_t resultSize = max(sizeA, sizeB);
     vector<uint64_t> resGroups(resultSize);
-    for (size_t i = 0; i < commonSize; ++i)
-      resGroups[i] = a.GetBitGroup(i) | b.GetBitGroup(i);
-    if (a.NumBitGroups() == resultSize)
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = a.GetBitGroup(i);
-    }
-    else
-    {
-      for (size_t i = commonSize; i < resultSize; ++i)
-        resGroups[i] = b.GetBitGroup(i);
-    }
-    return CompressedBitVectorBuilder::FromBitGroups(move(resGroups));
+    uint64_t popCount =
+        bit_group_ops::Or(a.BitGroups(), b.BitGroups(), resGroups.data(), commonSize);
+    auto const & longest = sizeA == resultSize ? a : b;
+    copy(longest.BitGroups() + commonSize, longest.BitGroups() + resultSize,
+         resGroups.begin() + commonSize);
+    popCount += bit_group_ops::PopCount(resGroups.data() + commonSize, resultSize - commonSize);
+    return FromBitGroups(move(resGroups), popCount);
   }
 
   unique_ptr<coding::CompressedBitVector> operator()(coding::DenseCBV const & a,
@@ -295,11 +292,17 @@ DenseCBV::DenseCBV(vector<uint64_t> const & setBits)
 
 // static
 unique_ptr<DenseCBV> DenseCBV::BuildFromBitGroups(vector<uint64_t> && bitGroups)
+{
+  uint64_t const popCount = bit_group_ops::PopCount(bitGroups.data(), bitGroups.size());
+  return BuildFromBitGroups(move(bitGroups), popCount);
+}
+
+// static
+unique_ptr<DenseCBV> DenseCBV::BuildFromBitGroups(vector<uint64_t> && bitGroups,
+                                                  uint64_t popCount)
 {
   unique_ptr<DenseCBV> cbv(new DenseCBV());
-  cbv->m_popCount = 0;
-  for (size_t i = 0; i < bitGroups.size(); ++i)
-    cbv->m_popCount += bits::PopCount(bitGroups[i]);
+  cbv->m_popCount = popCount;
   cbv->m_bitGroups = move(bitGroups);
   return cbv;
 }
@@ -434,21 +437,34 @@ unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitPositions(
 // static
 unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitGroups(
     vector<uint64_t> && bitGroups)
+{
+  uint64_t const popCount = bit_group_ops::PopCount(bitGroups.data(), bitGroups.size());
+  return coding::FromBitGroups(move(bitGroups), popCount);
+}
+
+namespace
+{
+// Same as CompressedBitVectorBuilder::FromBitGroups() but with a known
+// number of set bits.
+unique_ptr<CompressedBitVector> FromBitGroups(vector<uint64_t> && bitGroups, uint64_t popCount)
 {
   static uint64_t const kBlockSize = DenseCBV::kBlockSize;
 
+  ASSERT_EQUAL(popCount, bit_group_ops::PopCount(bitGroups.data(), bitGroups.size()), ());
+
+  // Empty results are frequent, e.g. when layers do not intersect,
+  // so there is no need to look at the groups at all.
+  if (popCount == 0)
+    return make_unique<SparseCBV>();
+
   while (!bitGroups.empty() && bitGroups.back() == 0)
     bitGroups.pop_back();
-  if (bitGroups.empty())
-    return make_unique<SparseCBV>(move(bitGroups));
+  ASSERT(!bitGroups.empty(), ());
 
   uint64_t const maxBit = kBlockSize * (bitGroups.size() - 1) + bits::FloorLog(bitGroups.back());
-  uint64_t popCount = 0;
-  for (size_t i = 0; i < bitGroups.size(); ++i)
-    popCount += bits::PopCount(bitGroups[i]);
 
   if (DenseEnough(popCount, maxBit))
-    return DenseCBV::BuildFromBitGroups(move(bitGroups));
+    return DenseCBV::BuildFromBitGroups(move(bitGroups), popCount);
 
   vector<uint64_t> setBits;
   for (size_t i = 0; i < bitGroups.size(); ++i)
@@ -461,6 +477,7 @@ unique_ptr<CompressedBitVector> CompressedBitVectorBuilder::FromBitGroups(
   }
   return make_unique<SparseCBV>(setBits);
 }
+}  // namespace
 
 string DebugPrint(CompressedBitVector::StorageStrategy strat)
 {
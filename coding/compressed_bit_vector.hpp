@@ -100,8 +100,12 @@ public:
   // Not to be confused with the constructor: the semantics
   // of the array of integers is completely different.
   static std::unique_ptr<DenseCBV> BuildFromBitGroups(std::vector<uint64_t> && bitGroups);
+  // Same as above, for a known number of set bits in |bitGroups|.
+  static std::unique_ptr<DenseCBV> BuildFromBitGroups(std::vector<uint64_t> && bitGroups,
+                                                      uint64_t popCount);
 
   size_t NumBitGroups() const { return m_bitGroups.size(); }
+  uint64_t const * BitGroups() const { return m_bitGroups.data(); }
 
   template <typename Fn>
   void ForEach(Fn && f) const
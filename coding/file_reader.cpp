@@ -5,6 +5,8 @@
 
 #include "base/logging.hpp"
 
+#include <algorithm>
+
 #ifndef LOG_FILE_READER_STATS
 #define LOG_FILE_READER_STATS 0
 #endif // LOG_FILE_READER_STATS
@@ -40,8 +42,12 @@ uint32_t const FileReader::kDefaultLogPageCount = 4;
 class FileReader::FileReaderData
 {
 public:
-  FileReaderData(string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
-    : m_fileData(fileName), m_readerCache(logPageSize, logPageCount)
+  FileReaderData(string const & fileName, uint32_t logPageSize, uint32_t logPageCount,
+                 Readahead readahead)
+    : m_fileData(fileName)
+    , m_readerCache(logPageSize, logPageCount)
+    , m_readahead(readahead)
+    , m_maxGap(uint64_t{1} << logPageSize)
   {
 #if LOG_FILE_READER_STATS
     m_readCallCount = 0;
@@ -66,13 +72,59 @@ public:
     }
 #endif
 
+    if (m_readahead == Readahead::Sequential)
+      UpdateReadahead(pos, size);
+
     return m_readerCache.Read(m_fileData, pos, p, size);
   }
 
 private:
+  // Sequential reads need to be this long to start the readahead.
+  static uint64_t constexpr kMinSequentialSize = 64 * 1024;
+  static uint64_t constexpr kMinWindowSize = 128 * 1024;
+  static uint64_t constexpr kMaxWindowSize = 2 * 1024 * 1024;
+
+  void UpdateReadahead(uint64_t pos, size_t size)
+  {
+    // Small gaps, e.g. skipped headers or re-read bytes, do not break the sequential access.
+    if (pos + m_maxGap < m_sequentialEnd || pos > m_sequentialEnd + m_maxGap)
+    {
+      m_sequentialSize = 0;
+      m_sequentialEnd = 0;
+      m_prefetchedEnd = 0;
+      m_windowSize = kMinWindowSize;
+    }
+    m_sequentialSize += size;
+    m_sequentialEnd = max(m_sequentialEnd, pos + size);
+
+    if (m_sequentialSize < kMinSequentialSize)
+      return;
+
+    // The next window is requested when a half of the current one is read, so the data is
+    // ready before it is needed.
+    if (m_prefetchedEnd > m_sequentialEnd + m_windowSize / 2)
+      return;
+
+    auto const fileSize = m_fileData.Size();
+    auto const from = max(m_prefetchedEnd, m_sequentialEnd);
+    if (from >= fileSize)
+      return;
+
+    m_prefetchedEnd = min(from + m_windowSize, fileSize);
+    m_fileData.Prefetch(from, m_prefetchedEnd - from);
+    m_windowSize = min(2 * m_windowSize, kMaxWindowSize);
+  }
+
   FileDataWithCachedSize m_fileData;
   ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS> m_readerCache;
 
+  Readahead const m_readahead;
+  uint64_t const m_maxGap;
+  uint64_t m_sequentialEnd = 0;
+  uint64_t m_sequentialSize = 0;
+  uint64_t m_prefetchedEnd = 0;
+  uint64_t m_windowSize = kMinWindowSize;
+
 #if LOG_FILE_READER_STATS
   uint32_t m_readCallCount;
 #endif
@@ -83,11 +135,12 @@ FileReader::FileReader(std::string const & fileName)
 {
 }
 
-FileReader::FileReader(string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
+FileReader::FileReader(string const & fileName, uint32_t logPageSize, uint32_t logPageCount,
+                       Readahead readahead)
   : ModelReader(fileName)
   , m_logPageSize(logPageSize)
   , m_logPageCount(logPageCount)
-  , m_fileData(make_shared<FileReaderData>(fileName, logPageSize, logPageCount))
+  , m_fileData(make_shared<FileReaderData>(fileName, logPageSize, logPageCount, readahead))
   , m_offset(0)
   , m_size(m_fileData->Size())
 {
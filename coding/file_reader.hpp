@@ -18,8 +18,17 @@ public:
   static uint32_t const kDefaultLogPageSize;
   static uint32_t const kDefaultLogPageCount;
 
+  enum class Readahead
+  {
+    Off,
+    // When long sequential reads are detected, the OS is asked to read the following part
+    // of the file in background. The readahead window grows while the reads stay sequential.
+    Sequential
+  };
+
   explicit FileReader(std::string const & fileName);
-  FileReader(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount);
+  FileReader(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount,
+             Readahead readahead = Readahead::Sequential);
 
   // Reader overrides:
   uint64_t Size() const override { return m_size; }
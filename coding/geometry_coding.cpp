@@ -381,6 +381,43 @@ void const * LoadInner(DecodeFunT fn, void const * pBeg, size_t count,
   return ret;
 }
 
+OuterPathDecoder::OuterPathDecoder(void const * data, GeometryCodingParams const & params)
+  : m_beg(static_cast<uint8_t const *>(data))
+  , m_basePoint(pts::GetBasePoint(params))
+  , m_maxPoint(pts::GetMaxPoint(params))
+  , m_coordBits(params.GetCoordBits())
+{
+  ArrayByteSource src(data);
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+  m_p = src.PtrUint8();
+  m_end = m_p + count;
+}
+
+m2::PointD OuterPathDecoder::Next()
+{
+  ASSERT(HasNext(), ());
+
+  ArrayByteSource src(m_p);
+  uint64_t const delta = ReadVarUint<uint64_t>(src);
+  m_p = src.PtrUint8();
+  ASSERT_LESS_OR_EQUAL(m_p, m_end, ());
+
+  // The same prediction as in coding::DecodePolylinePrev2().
+  m2::PointU pt;
+  if (m_decoded == 0)
+    pt = coding::DecodePointDeltaFromUint(delta, m_basePoint);
+  else if (m_decoded == 1)
+    pt = coding::DecodePointDeltaFromUint(delta, m_prev1);
+  else
+    pt = coding::DecodePointDeltaFromUint(
+        delta, coding::PredictPointInPolyline(m_maxPoint, m_prev1, m_prev2));
+
+  m_prev2 = m_prev1;
+  m_prev1 = pt;
+  ++m_decoded;
+  return pts::U2D(pt, m_coordBits);
+}
+
 TrianglesChainSaver::TrianglesChainSaver(GeometryCodingParams const & params)
 {
   m_base = pts::GetBasePoint(params);
@@ -2,6 +2,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include "coding/byte_stream.hpp"
 #include "coding/point_coding.hpp"
 #include "coding/tesselator_decl.hpp"
 #include "coding/varint.hpp"
@@ -256,6 +257,23 @@ void LoadOuter(DecodeFunT fn, TSource & src, GeometryCodingParams const & params
   Decode(fn, deltas, params, points, reserveF);
 }
 
+// Version of LoadOuter for memory sources (e.g. memory-mapped geometry sections):
+// deltas are read right from the source memory without copying them to a temporary buffer.
+template <class TPoints>
+void LoadOuter(DecodeFunT fn, ArrayByteSource & src, GeometryCodingParams const & params,
+               TPoints & points, size_t reserveF = 1)
+{
+  uint32_t const count = ReadVarUint<uint32_t>(src);
+  char const * p = static_cast<char const *>(src.Ptr());
+
+  DeltasT deltas;
+  deltas.reserve(count / 2);
+  ReadVarUint64Array(p, p + count, base::MakeBackInsertFunctor(deltas));
+  src.Advance(count);
+
+  Decode(fn, deltas, params, points, reserveF);
+}
+
 /// @name Paths.
 template <class TSink>
 void SaveInnerPath(std::vector<m2::PointD> const & points, GeometryCodingParams const & params,
@@ -283,6 +301,35 @@ void LoadOuterPath(TSource & src, GeometryCodingParams const & params, TPoints &
   LoadOuter(&coding::DecodePolyline, src, params, points);
 }
 
+/// Decodes points of a path saved by SaveOuterPath one by one on demand, right from the memory
+/// of the serialized path. Neither deltas nor points are materialized.
+class OuterPathDecoder
+{
+public:
+  OuterPathDecoder() = default;
+  /// |data| points to the beginning of the serialized path.
+  OuterPathDecoder(void const * data, GeometryCodingParams const & params);
+
+  bool HasNext() const { return m_p != m_end; }
+  m2::PointD Next();
+
+  /// Returns size of the serialized path in bytes.
+  size_t GetSerializedSize() const { return static_cast<size_t>(m_end - m_beg); }
+
+private:
+  uint8_t const * m_beg = nullptr;
+  uint8_t const * m_p = nullptr;
+  uint8_t const * m_end = nullptr;
+
+  m2::PointU m_basePoint;
+  m2::PointU m_maxPoint;
+  // Two last decoded points which are used for prediction, see coding::DecodePolyline().
+  m2::PointU m_prev1;
+  m2::PointU m_prev2;
+  size_t m_decoded = 0;
+  uint8_t m_coordBits = 0;
+};
+
 /// @name Triangles.
 template <class TSink>
 void SaveInnerTriangles(std::vector<m2::PointD> const & points, GeometryCodingParams const & params,
@@ -20,6 +20,9 @@
 
 #ifdef OMIM_OS_WINDOWS
 #include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
@@ -105,6 +108,22 @@ void FileData::Read(uint64_t pos, void * p, size_t size)
     MYTHROW(Reader::ReadException, (GetErrorProlog(), bytesRead, pos, size));
 }
 
+void FileData::Prefetch(uint64_t pos, uint64_t size) const
+{
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  UNUSED_VALUE(posix_fadvise(fileno(m_File), static_cast<off_t>(pos), static_cast<off_t>(size),
+                             POSIX_FADV_WILLNEED));
+#elif defined(OMIM_OS_MAC) || defined(OMIM_OS_IPHONE)
+  radvisory advice;
+  advice.ra_offset = static_cast<off_t>(pos);
+  advice.ra_count = static_cast<int>(size);
+  UNUSED_VALUE(fcntl(fileno(m_File), F_RDADVISE, &advice));
+#else
+  UNUSED_VALUE(pos);
+  UNUSED_VALUE(size);
+#endif
+}
+
 uint64_t FileData::Pos() const
 {
   int64_t const pos = ftell64(m_File);
@@ -264,6 +283,19 @@ bool CopyFileX(string const & fOld, string const & fNew)
   return false;
 }
 
+bool HardLinkFileX(string const & fOld, string const & fNew)
+{
+#ifdef OMIM_OS_WINDOWS
+  return false;
+#else
+  if (link(fOld.c_str(), fNew.c_str()) == 0)
+    return true;
+
+  LOG(LDEBUG, ("Can't link", fOld, "to", fNew, "error:", strerror(errno)));
+  return false;
+#endif
+}
+
 bool IsEqualFiles(string const & firstFile, string const & secondFile)
 {
   base::FileData first(firstFile, base::FileData::OP_READ);
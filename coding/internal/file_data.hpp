@@ -29,6 +29,9 @@ public:
   void Seek(uint64_t pos);
 
   void Read(uint64_t pos, void * p, size_t size);
+  // Asks the OS to read [pos, pos + size) into the page cache in background.
+  // It is only a hint, it does nothing on the systems which do not support it.
+  void Prefetch(uint64_t pos, uint64_t size) const;
   void Write(void const * p, size_t size);
 
   void Flush();
@@ -60,5 +63,8 @@ void AppendFileToFile(std::string const & fromFilename, std::string const & toFi
 
 /// @return false if copy fails. DO NOT THROWS exceptions
 bool CopyFileX(std::string const & fOld, std::string const & fNew);
+/// Creates a hard link |fNew| to |fOld|, so no data is copied.
+/// @return false if the file system or the platform doesn't support hard links.
+bool HardLinkFileX(std::string const & fOld, std::string const & fNew);
 bool IsEqualFiles(std::string const & firstFile, std::string const & secondFile);
 }  // namespace base
@@ -24,7 +24,7 @@ SHA1::Hash SHA1::Calculate(std::string const & filePath)
     base::FileData file(filePath, base::FileData::OP_READ);
     uint64_t const fileSize = file.Size();
 
-    CSHA1 sha1;
+    Streaming sha1;
     uint64_t currSize = 0;
     unsigned char buffer[kFileBufferSize];
     while (currSize < fileSize)
@@ -34,12 +34,7 @@ SHA1::Hash SHA1::Calculate(std::string const & filePath)
       sha1.Update(buffer, toRead);
       currSize += toRead;
     }
-    sha1.Final();
-
-    Hash result;
-    ASSERT_EQUAL(result.size(), ARRAY_SIZE(sha1.m_digest), ());
-    std::copy(std::begin(sha1.m_digest), std::end(sha1.m_digest), std::begin(result));
-    return result;
+    return sha1.GetHash();
   }
   catch (Reader::Exception const & ex)
   {
@@ -51,8 +46,7 @@ SHA1::Hash SHA1::Calculate(std::string const & filePath)
 // static
 std::string SHA1::CalculateBase64(std::string const & filePath)
 {
-  auto const sha1 = Calculate(filePath);
-  return base64_encode(sha1.data(), sha1.size());
+  return ToBase64(Calculate(filePath));
 }
 
 // static
@@ -84,7 +78,47 @@ std::string SHA1::CalculateForStringFormatted(std::string const & str)
 // static
 std::string SHA1::CalculateBase64ForString(std::string const & str)
 {
-  auto const sha1 = CalculateForString(str);
-  return base64_encode(sha1.data(), sha1.size());
+  return ToBase64(CalculateForString(str));
+}
+
+// static
+std::string SHA1::ToBase64(Hash const & hash)
+{
+  return base64_encode(hash.data(), hash.size());
+}
+
+// SHA1::Streaming ---------------------------------------------------------------------------------
+SHA1::Streaming::Streaming() : m_sha1(std::make_unique<CSHA1>()) {}
+
+SHA1::Streaming::~Streaming() = default;
+
+void SHA1::Streaming::Update(void const * data, size_t size)
+{
+  // CSHA1::Update() takes a non-const pointer but doesn't modify the data.
+  auto * p = const_cast<unsigned char *>(static_cast<unsigned char const *>(data));
+  while (size > 0)
+  {
+    auto const part = static_cast<uint32_t>(std::min<size_t>(size, 1 << 30));
+    m_sha1->Update(p, part);
+    p += part;
+    size -= part;
+    m_size += part;
+  }
+}
+
+SHA1::Hash SHA1::Streaming::GetHash() const
+{
+  // Finalization changes the state, so a copy is finalized to let the caller continue.
+  // CSHA1 is not copyable as is because it points to its own workspace.
+  CSHA1 sha1;
+  std::copy(std::begin(m_sha1->m_state), std::end(m_sha1->m_state), std::begin(sha1.m_state));
+  std::copy(std::begin(m_sha1->m_count), std::end(m_sha1->m_count), std::begin(sha1.m_count));
+  std::copy(std::begin(m_sha1->m_buffer), std::end(m_sha1->m_buffer), std::begin(sha1.m_buffer));
+  sha1.Final();
+
+  Hash result;
+  ASSERT_EQUAL(result.size(), ARRAY_SIZE(sha1.m_digest), ());
+  std::copy(std::begin(sha1.m_digest), std::end(sha1.m_digest), std::begin(result));
+  return result;
 }
 }  // coding
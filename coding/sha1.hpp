@@ -1,8 +1,13 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 
+class CSHA1;
+
 namespace coding
 {
 class SHA1
@@ -18,5 +23,24 @@ public:
   // String representation of 40-number hex digit.
   static std::string CalculateForStringFormatted(std::string const & str);
   static std::string CalculateBase64ForString(std::string const & str);
+
+  static std::string ToBase64(Hash const & hash);
+
+  // Calculates hash of the data passed by parts, e.g. while the data is being downloaded.
+  class Streaming
+  {
+  public:
+    Streaming();
+    ~Streaming();
+
+    void Update(void const * data, size_t size);
+    // Returns hash of all the data passed to Update() so far.
+    Hash GetHash() const;
+    uint64_t GetSize() const { return m_size; }
+
+  private:
+    std::unique_ptr<CSHA1> m_sha1;
+    uint64_t m_size = 0;
+  };
 };
 }  // coding
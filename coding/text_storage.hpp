@@ -2,20 +2,52 @@
 
 #include "coding/bwt_coder.hpp"
 #include "coding/reader.hpp"
+#include "coding/text_storage_cache.hpp"
 #include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
+#include "coding/zlib.hpp"
 
 #include "base/assert.hpp"
 #include "base/lru_cache.hpp"
 
 #include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace coding
 {
+enum class TextStorageCodec : uint8_t
+{
+  // BWT with move-to-front and Huffman coding, the best compression.
+  BWT = 0,
+  // Faster decompression for the sections which are read often.
+  ZLib = 1,
+  // The fastest access, for small sections.
+  None = 2,
+
+  Count
+};
+
+// The high bit of the index section offset is set if the codec is not BWT.
+uint64_t constexpr kTextStorageCodecFlag = 1ULL << 63;
+
+inline std::string DebugPrint(TextStorageCodec codec)
+{
+  switch (codec)
+  {
+  case TextStorageCodec::BWT: return "BWT";
+  case TextStorageCodec::ZLib: return "ZLib";
+  case TextStorageCodec::None: return "None";
+  case TextStorageCodec::Count: return "Count";
+  }
+  UNREACHABLE();
+}
+
 // Writes a set of strings in a format that allows to efficiently
 // access blocks of strings. This means that access of individual
 // strings may be inefficient, but access to a block of strings can be
@@ -24,9 +56,12 @@ namespace coding
 // because the whole number of strings is packed into a single block.
 //
 // Format description:
-// * first 8 bytes - little endian-encoded offset of the index section
-// * data section - represents a catenated sequence of BWT-compressed blocks with
-//   a sequence of individual string lengths in the block
+// * first 8 bytes - little endian-encoded offset of the index section, the high bit
+//   is set when the codec byte follows
+// * codec byte - TextStorageCodec, absent for BWT
+// * data section - represents a catenated sequence of compressed blocks with
+//   a sequence of individual string lengths in the block. BWT blocks are written
+//   by BWTCoder, blocks of the other codecs are prefixed with their size
 // * index section - represents a delta-encoded sequence of
 //   BWT-compressed blocks offsets intermixed with the number of
 //   strings inside each block.
@@ -36,11 +71,19 @@ template <typename Writer>
 class BlockedTextStorageWriter
 {
 public:
-  BlockedTextStorageWriter(Writer & writer, uint64_t blockSize)
-    : m_writer(writer), m_blockSize(blockSize), m_startOffset(writer.Pos()), m_blocks(1)
+  BlockedTextStorageWriter(Writer & writer, uint64_t blockSize,
+                           TextStorageCodec codec = TextStorageCodec::BWT)
+    : m_writer(writer)
+    , m_blockSize(blockSize)
+    , m_codec(codec)
+    , m_startOffset(writer.Pos())
+    , m_blocks(1)
   {
     CHECK(m_blockSize != 0, ());
+    CHECK_LESS(m_codec, TextStorageCodec::Count, ());
     WriteToSink(m_writer, static_cast<uint64_t>(0));
+    if (m_codec != TextStorageCodec::BWT)
+      WriteToSink(m_writer, static_cast<uint8_t>(m_codec));
     m_dataOffset = m_writer.Pos();
   }
 
@@ -56,7 +99,10 @@ public:
       auto const currentOffset = m_writer.Pos();
       ASSERT_GREATER_OR_EQUAL(currentOffset, m_startOffset, ());
       m_writer.Seek(m_startOffset);
-      WriteToSink(m_writer, static_cast<uint64_t>(currentOffset - m_startOffset));
+      auto indexOffset = static_cast<uint64_t>(currentOffset - m_startOffset);
+      if (m_codec != TextStorageCodec::BWT)
+        indexOffset |= kTextStorageCodecFlag;
+      WriteToSink(m_writer, indexOffset);
       m_writer.Seek(currentOffset);
     }
 
@@ -110,12 +156,34 @@ private:
   {
     for (auto const & length : lengths)
       WriteVarUint(m_writer, length);
-    BWTCoder::EncodeAndWriteBlock(m_writer, pool.size(),
-                                  reinterpret_cast<uint8_t const *>(pool.c_str()));
+
+    switch (m_codec)
+    {
+    case TextStorageCodec::BWT:
+      BWTCoder::EncodeAndWriteBlock(m_writer, pool.size(),
+                                    reinterpret_cast<uint8_t const *>(pool.c_str()));
+      break;
+    case TextStorageCodec::ZLib:
+    {
+      ZLib::Deflate const deflate(ZLib::Deflate::Format::ZLib,
+                                  ZLib::Deflate::Level::BestCompression);
+      std::string compressed;
+      CHECK(deflate(pool.data(), pool.size(), std::back_inserter(compressed)), ());
+      WriteVarUint(m_writer, static_cast<uint64_t>(compressed.size()));
+      m_writer.Write(compressed.data(), compressed.size());
+      break;
+    }
+    case TextStorageCodec::None:
+      WriteVarUint(m_writer, static_cast<uint64_t>(pool.size()));
+      m_writer.Write(pool.data(), pool.size());
+      break;
+    case TextStorageCodec::Count: UNREACHABLE();
+    }
   }
 
   Writer & m_writer;
   uint64_t const m_blockSize;
+  TextStorageCodec const m_codec;
   uint64_t m_startOffset = 0;
   uint64_t m_dataOffset = 0;
 
@@ -141,6 +209,7 @@ public:
     uint64_t m_subs = 0;    // number of strings in the block
   };
 
+  TextStorageCodec GetCodec() const { return m_codec; }
   size_t GetNumBlockInfos() const { return m_blocks.size(); }
   size_t GetNumStrings() const
   {
@@ -183,7 +252,17 @@ public:
   template <typename Reader>
   void Read(Reader & reader)
   {
-    auto const indexOffset = ReadPrimitiveFromPos<uint64_t, Reader>(reader, 0);
+    auto indexOffset = ReadPrimitiveFromPos<uint64_t, Reader>(reader, 0);
+
+    uint64_t prevOffset = 8;  // 8 bytes for the offset of the data section
+    m_codec = TextStorageCodec::BWT;
+    if (indexOffset & kTextStorageCodecFlag)
+    {
+      indexOffset &= ~kTextStorageCodecFlag;
+      m_codec = static_cast<TextStorageCodec>(ReadPrimitiveFromPos<uint8_t, Reader>(reader, 8));
+      CHECK_LESS(m_codec, TextStorageCodec::Count, ());
+      ++prevOffset;
+    }
 
     NonOwningReaderSource source(reader);
     source.Skip(indexOffset);
@@ -191,7 +270,6 @@ public:
     auto const numBlocks = ReadVarUint<uint64_t, NonOwningReaderSource>(source);
     m_blocks.assign(static_cast<size_t>(numBlocks), {});
 
-    uint64_t prevOffset = 8;  // 8 bytes for the offset of the data section
     for (uint64_t i = 0; i < numBlocks; ++i)
     {
       auto const delta = ReadVarUint<uint64_t, NonOwningReaderSource>(source);
@@ -208,6 +286,7 @@ public:
 
 private:
   std::vector<BlockInfo> m_blocks;
+  TextStorageCodec m_codec = TextStorageCodec::BWT;
 };
 
 class BlockedTextStorageReader
@@ -218,6 +297,11 @@ public:
   BlockedTextStorageReader() : m_cache(kDefaultCacheSize) {}
   explicit BlockedTextStorageReader(size_t cacheSize) : m_cache(cacheSize) {}
 
+  // When |cacheId| is not empty, decompressed blocks are kept in the process-wide
+  // TextStorageCache instead of the cache of this reader, so they are shared with the other
+  // readers of the same storage. |cacheId| must identify the storage data uniquely.
+  void SetCacheId(std::string const & cacheId) { m_cacheId = cacheId; }
+
   template <typename Reader>
   void InitializeIfNeeded(Reader & reader)
   {
@@ -235,6 +319,16 @@ public:
 
   template <typename Reader>
   std::string ExtractString(Reader & reader, size_t stringIx)
+  {
+    TextStorageCache::BlockPtr block;
+    return std::string(ExtractStringView(reader, stringIx, block));
+  }
+
+  // Returns a view into the decoded block which contains the string. The view is valid
+  // while |block| (or any other reference to the same block) is alive.
+  template <typename Reader>
+  std::string_view ExtractStringView(Reader & reader, size_t stringIx,
+                                     TextStorageCache::BlockPtr & block)
   {
     InitializeIfNeeded(reader);
 
@@ -243,58 +337,88 @@ public:
 
     auto const & bi = m_index.GetBlockInfo(blockIx);
 
-    bool found;
-    auto & entry = m_cache.Find(blockIx, found);
-    if (!found)
+    if (m_cacheId.empty())
     {
-      NonOwningReaderSource source(reader);
-      source.Skip(bi.m_offset);
-
-      entry.m_value.clear();
-      entry.m_subs.resize(static_cast<size_t>(bi.m_subs));
-
-      uint64_t offset = 0;
-      for (size_t i = 0; i < entry.m_subs.size(); ++i)
+      bool found;
+      auto & entry = m_cache.Find(blockIx, found);
+      if (!found)
+        entry = DecodeBlock(reader, bi);
+      block = entry;
+    }
+    else
+    {
+      auto & cache = TextStorageCache::Instance();
+      block = cache.Find(m_cacheId, blockIx);
+      if (!block)
       {
-        auto & sub = entry.m_subs[i];
-        sub.m_offset = offset;
-        sub.m_length = ReadVarUint<uint64_t>(source);
-        CHECK_GREATER_OR_EQUAL(sub.m_offset + sub.m_length, sub.m_offset, ());
-        offset += sub.m_length;
+        block = DecodeBlock(reader, bi);
+        cache.Add(m_cacheId, blockIx, block);
       }
-      BWTCoder::ReadAndDecodeBlock(source, std::back_inserter(entry.m_value));
     }
 
     ASSERT_GREATER_OR_EQUAL(stringIx, bi.From(), ());
     ASSERT_LESS(stringIx, bi.To(), ());
 
     stringIx -= bi.From();
-    ASSERT_LESS(stringIx, entry.m_subs.size(), ());
+    ASSERT_LESS(stringIx, block->m_subs.size(), ());
 
-    auto const & si = entry.m_subs[stringIx];
-    auto const & value = entry.m_value;
+    auto const & si = block->m_subs[stringIx];
+    auto const & value = block->m_value;
     ASSERT_LESS_OR_EQUAL(si.m_offset + si.m_length, value.size(), ());
-    return value.substr(static_cast<size_t>(si.m_offset), static_cast<size_t>(si.m_length));
+    return std::string_view(value).substr(static_cast<size_t>(si.m_offset),
+                                          static_cast<size_t>(si.m_length));
   }
 
 private:
-  struct StringInfo
+  template <typename Reader>
+  TextStorageCache::BlockPtr DecodeBlock(Reader & reader,
+                                         BlockedTextStorageIndex::BlockInfo const & bi) const
   {
-    StringInfo() = default;
-    StringInfo(uint64_t offset, uint64_t length): m_offset(offset), m_length(length) {}
+    NonOwningReaderSource source(reader);
+    source.Skip(bi.m_offset);
 
-    uint64_t m_offset = 0;  // offset of the string inside the decompressed block
-    uint64_t m_length = 0;  // length of the string
-  };
+    auto block = std::make_shared<TextStorageBlock>();
+    block->m_subs.resize(static_cast<size_t>(bi.m_subs));
 
-  struct CacheEntry
+    uint64_t offset = 0;
+    for (auto & sub : block->m_subs)
+    {
+      sub.m_offset = offset;
+      sub.m_length = ReadVarUint<uint64_t>(source);
+      CHECK_GREATER_OR_EQUAL(sub.m_offset + sub.m_length, sub.m_offset, ());
+      offset += sub.m_length;
+    }
+    ReadBlock(source, block->m_value);
+    return block;
+  }
+
+  template <typename Source>
+  void ReadBlock(Source & source, std::string & value) const
   {
-    std::string m_value;             // concatenation of the strings
-    std::vector<StringInfo> m_subs;  // indices of individual strings
-  };
+    switch (m_index.GetCodec())
+    {
+    case TextStorageCodec::BWT:
+      BWTCoder::ReadAndDecodeBlock(source, std::back_inserter(value));
+      break;
+    case TextStorageCodec::ZLib:
+    {
+      std::string compressed(static_cast<size_t>(ReadVarUint<uint64_t>(source)), '\0');
+      source.Read(&compressed[0], compressed.size());
+      ZLib::Inflate const inflate(ZLib::Inflate::Format::ZLib);
+      CHECK(inflate(compressed, std::back_inserter(value)), ());
+      break;
+    }
+    case TextStorageCodec::None:
+      value.resize(static_cast<size_t>(ReadVarUint<uint64_t>(source)));
+      source.Read(&value[0], value.size());
+      break;
+    case TextStorageCodec::Count: UNREACHABLE();
+    }
+  }
 
   BlockedTextStorageIndex m_index;
-  LruCache<size_t, CacheEntry> m_cache;
+  LruCache<size_t, TextStorageCache::BlockPtr> m_cache;
+  std::string m_cacheId;
   bool m_initialized = false;
 };
 
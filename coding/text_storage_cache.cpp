@@ -0,0 +1,76 @@
+#include "coding/text_storage_cache.hpp"
+
+#include "base/assert.hpp"
+
+namespace coding
+{
+// static
+TextStorageCache & TextStorageCache::Instance()
+{
+  static TextStorageCache instance(kDefaultMaxSize);
+  return instance;
+}
+
+TextStorageCache::BlockPtr TextStorageCache::Find(std::string const & storageId, uint64_t blockIx)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_blocks.find(Key(storageId, blockIx));
+  if (it == m_blocks.end())
+  {
+    ++m_misses;
+    return {};
+  }
+
+  ++m_hits;
+  m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+  return it->second.m_block;
+}
+
+void TextStorageCache::Add(std::string const & storageId, uint64_t blockIx, BlockPtr block)
+{
+  CHECK(block, ());
+  auto const blockSize = block->GetMemorySize();
+  if (blockSize > m_maxSize)
+    return;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const res = m_blocks.emplace(Key(storageId, blockIx), Entry());
+  if (!res.second)
+    return;
+
+  auto & entry = res.first->second;
+  entry.m_block = std::move(block);
+  m_lru.push_front(&res.first->first);
+  entry.m_lruIt = m_lru.begin();
+  m_size += blockSize;
+
+  while (m_size > m_maxSize)
+  {
+    ASSERT(!m_lru.empty(), ());
+    auto const it = m_blocks.find(*m_lru.back());
+    ASSERT(it != m_blocks.end(), ());
+    m_size -= it->second.m_block->GetMemorySize();
+    m_lru.pop_back();
+    m_blocks.erase(it);
+  }
+}
+
+void TextStorageCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_lru.clear();
+  m_blocks.clear();
+  m_size = 0;
+}
+
+TextStorageCache::Stats TextStorageCache::GetStats() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  stats.m_blocksCount = m_blocks.size();
+  stats.m_size = m_size;
+  return stats;
+}
+}  // namespace coding
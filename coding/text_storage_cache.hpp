@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace coding
+{
+// Decompressed block of a blocked text storage.
+struct TextStorageBlock
+{
+  struct StringInfo
+  {
+    StringInfo() = default;
+    StringInfo(uint64_t offset, uint64_t length): m_offset(offset), m_length(length) {}
+
+    uint64_t m_offset = 0;  // offset of the string inside the decompressed block
+    uint64_t m_length = 0;  // length of the string
+  };
+
+  size_t GetMemorySize() const { return m_value.size() + m_subs.size() * sizeof(StringInfo); }
+
+  std::string m_value;             // concatenation of the strings
+  std::vector<StringInfo> m_subs;  // indices of individual strings
+};
+
+// Process-wide cache of decompressed blocks of text storages. A storage is identified by
+// a string which is unique for its data, e.g. a file path with a section tag, so readers of
+// the same section share the blocks. The total size of the cached blocks is limited,
+// the least recently used blocks are evicted first.
+// All methods are thread-safe.
+class TextStorageCache
+{
+public:
+  using BlockPtr = std::shared_ptr<TextStorageBlock const>;
+
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    size_t m_blocksCount = 0;
+    // Total memory size of the cached blocks in bytes.
+    size_t m_size = 0;
+  };
+
+  inline static size_t const kDefaultMaxSize = 8 * 1024 * 1024;
+
+  static TextStorageCache & Instance();
+
+  explicit TextStorageCache(size_t maxSize) : m_maxSize(maxSize) {}
+
+  // Returns nullptr if the block is not cached.
+  BlockPtr Find(std::string const & storageId, uint64_t blockIx);
+  void Add(std::string const & storageId, uint64_t blockIx, BlockPtr block);
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  using Key = std::pair<std::string, uint64_t>;
+
+  struct Entry
+  {
+    BlockPtr m_block;
+    std::list<Key const *>::iterator m_lruIt;
+  };
+
+  size_t const m_maxSize;
+
+  mutable std::mutex m_mutex;
+  std::map<Key, Entry> m_blocks;
+  // Keys of |m_blocks|, the most recently used one is the first.
+  std::list<Key const *> m_lru;
+  size_t m_size = 0;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+};
+}  // namespace coding
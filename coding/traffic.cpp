@@ -5,6 +5,8 @@
 namespace coding
 {
 // static
+// Version 2 is used by the tracking protocol only. The files of track_analyzing and the server
+// logs are written in version 1 without a version tag, so kLatestVersion is left as is.
 uint32_t const TrafficGPSEncoder::kLatestVersion = 1;
 uint32_t const TrafficGPSEncoder::kCoordBits = 30;
 double const TrafficGPSEncoder::kMinDeltaLat = ms::LatLon::kMinLat - ms::LatLon::kMaxLat;
@@ -13,6 +13,12 @@
 
 #include <cstring>
 #include <mutex>
+#include <utility>
+
+namespace
+{
+size_t constexpr kMaxCachedResults = 10000;
+}  // namespace
 
 struct Transliteration::TransliteratorInfo
 {
@@ -27,6 +33,7 @@ struct Transliteration::TransliteratorInfo
 
 Transliteration::Transliteration()
   : m_mode(Mode::Enabled)
+  , m_cache(kMaxCachedResults)
 {}
 
 Transliteration::~Transliteration()
@@ -128,15 +135,50 @@ bool Transliteration::Transliterate(std::string transliteratorId, UnicodeString
   return true;
 }
 
+template <typename Fn>
+bool Transliteration::FindOrTransliterate(std::string const & key, Fn && transliterate,
+                                          std::string & out) const
+{
+  {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    bool found = false;
+    auto const & result = m_cache.Find(key, found);
+    if (found && result)
+    {
+      if (result->empty())
+        return false;
+      out = *result;
+      return true;
+    }
+  }
+
+  std::string result;
+  auto const res = transliterate(result);
+  if (!res)
+    result.clear();
+
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  bool found = false;
+  auto & cached = m_cache.Find(key, found);
+  if (!cached)
+    cached = result;
+
+  if (res)
+    out = std::move(result);
+  return res;
+}
+
 bool Transliteration::TransliterateForce(std::string const & str, std::string const & transliteratorId,
                                          std::string & out) const
 {
   CHECK(m_inited, ());
-  UnicodeString ustr(str.c_str());
-  auto const res = Transliterate(transliteratorId, ustr);
-  if (res)
-    ustr.toUTF8String(out);
-  return res;
+  return FindOrTransliterate(transliteratorId + '\n' + str, [&](std::string & result) {
+    UnicodeString ustr(str.c_str());
+    auto const res = Transliterate(transliteratorId, ustr);
+    if (res)
+      ustr.toUTF8String(result);
+    return res;
+  }, out);
 }
 
 bool Transliteration::Transliterate(std::string const & str, int8_t langCode,
@@ -153,13 +195,16 @@ bool Transliteration::Transliterate(std::string const & str, int8_t langCode,
   if (transliteratorsIds.empty())
     return false;
 
-  UnicodeString ustr(str.c_str());
-  for (auto transliteratorId : transliteratorsIds)
-    Transliterate(transliteratorId, ustr);
+  auto const key = std::to_string(static_cast<int>(langCode)) + '\n' + str;
+  return FindOrTransliterate(key, [&](std::string & result) {
+    UnicodeString ustr(str.c_str());
+    for (auto transliteratorId : transliteratorsIds)
+      Transliterate(transliteratorId, ustr);
 
-  if (ustr.isEmpty())
-    return false;
+    if (ustr.isEmpty())
+      return false;
 
-  ustr.toUTF8String(out);
-  return true;
+    ustr.toUTF8String(result);
+    return true;
+  }, out);
 }
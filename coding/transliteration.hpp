@@ -1,10 +1,13 @@
 #pragma once
 
+#include "base/lru_cache.hpp"
+
 #include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 
 namespace icu
@@ -43,8 +46,18 @@ private:
 
   bool Transliterate(std::string transliteratorId, icu::UnicodeString & ustr) const;
 
+  // Returns the cached result for |key| or calls |transliterate| and caches its result.
+  template <typename Fn>
+  bool FindOrTransliterate(std::string const & key, Fn && transliterate, std::string & out) const;
+
   std::mutex m_initializationMutex;
   std::atomic<bool> m_inited;
   std::atomic<Mode> m_mode;
   std::map<std::string, std::unique_ptr<TransliteratorInfo>> m_transliterators;
+
+  // Results of the transliterations by the transliterators and the source strings. ICU
+  // transliterators share a global lock, so the same names are not transliterated again.
+  // An empty result means that the transliteration failed.
+  mutable std::mutex m_cacheMutex;
+  mutable LruCache<std::string, std::optional<std::string>> m_cache;
 };
@@ -8,9 +8,11 @@
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <regex>
 #include <sstream>
+#include <string_view>
 #include <vector>
 
 using namespace std;
@@ -32,7 +34,6 @@ public:
   LatLonParser(url::Url const & url, url::GeoURLInfo & info)
     : m_info(info)
     , m_url(url)
-    , m_regexp("-?\\d+\\.{1}\\d*, *-?\\d+\\.{1}\\d*")
     , m_latPriority(-1)
     , m_lonPriority(-1)
   {
@@ -63,7 +64,9 @@ public:
 
     if (priority != kXYPriority && priority != kLatLonPriority)
     {
-      strings::ForEachMatched(param.m_value, m_regexp, AssignCoordinates(*this, priority));
+      // Compiling of the regexp is much more expensive than the matching.
+      static regex const kRegexp("-?\\d+\\.{1}\\d*, *-?\\d+\\.{1}\\d*");
+      strings::ForEachMatched(param.m_value, kRegexp, AssignCoordinates(*this, priority));
       return;
     }
 
@@ -120,8 +123,8 @@ private:
 
     void SwapIfNeeded(double & lat, double & lon) const
     {
-      vector<string> const kSwappingProviders = {"2gis", "yandex"};
-      for (auto const & s : kSwappingProviders)
+      static array<char const *, 2> const kSwappingProviders = {{"2gis", "yandex"}};
+      for (auto const s : kSwappingProviders)
       {
         if (m_parser.GetUrl().GetPath().find(s) != string::npos)
         {
@@ -171,7 +174,6 @@ private:
 
   url::GeoURLInfo & m_info;
   url::Url const & m_url;
-  regex m_regexp;
   int m_latPriority;
   int m_lonPriority;
 };
@@ -234,16 +236,17 @@ bool Url::Parse(std::string const & url)
     {
       size_t const eq = url.find('=', start);
 
+      string_view const query(url);
       string key;
       string value;
       if (eq != string::npos && eq < end)
       {
-        key = UrlDecode(url.substr(start, eq - start));
-        value = UrlDecode(url.substr(eq + 1, end - eq - 1));
+        key = UrlDecode(query.substr(start, eq - start));
+        value = UrlDecode(query.substr(eq + 1, end - eq - 1));
       }
       else
       {
-        key = UrlDecode(url.substr(start, end - start));
+        key = UrlDecode(query.substr(start, end - start));
       }
 
       m_params.emplace_back(key, value);
@@ -323,7 +326,7 @@ string UrlEncode(string const & rawUrl)
   return result;
 }
 
-string UrlDecode(string const & encodedUrl)
+string UrlDecode(string_view encodedUrl)
 {
   size_t const count = encodedUrl.size();
   string result;
@@ -333,7 +336,11 @@ string UrlDecode(string const & encodedUrl)
   {
     if (encodedUrl[i] == '%')
     {
-      result += FromHex(encodedUrl.substr(i + 1, 2));
+      // An incomplete escape sequence at the end is skipped.
+      if (i + 2 < count)
+      {
+        result += FromHex(encodedUrl.data() + i + 1, 2);
+      }
       i += 2;
     }
     else
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -56,7 +57,7 @@ std::string Join(std::string const & lhs, std::string const & rhs, Args &&... ar
 }
 
 std::string UrlEncode(std::string const & rawUrl);
-std::string UrlDecode(std::string const & encodedUrl);
+std::string UrlDecode(std::string_view encodedUrl);
 
 struct GeoURLInfo
 {
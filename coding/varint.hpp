@@ -1,5 +1,6 @@
 #pragma once
 
+#include "coding/endianness.hpp"
 #include "coding/write_to_sink.hpp"
 
 #include "base/assert.hpp"
@@ -10,6 +11,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <type_traits>
 
 /// This function writes, using optimal bytes count.
@@ -251,19 +254,83 @@ void const * ReadVarInt64Array(void const * pBeg, WhileConditionT whileCondition
   return p;
 }
 
+// Decodes a varint which is not longer than 8 bytes at once. 8 bytes from |p| must be readable.
+// Returns the size of the varint or 0 if it is longer.
+inline size_t DecodeShortVarUint(uint8_t const * p, uint64_t & value)
+{
+  if (IsBigEndianMacroBased())
+    return 0;
+
+  uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+
+  // Continuation bits which are not set, the lowest one marks the last byte of the varint.
+  uint64_t const stopBits = ~word & 0x8080808080808080ULL;
+  if (stopBits == 0)
+    return 0;
+
+  // Bytes of the varint, the shift overflows to the full mask for the 8 bytes varint.
+  uint64_t const mask = ((stopBits & (~stopBits + 1)) << 1) - 1;
+  word &= mask & 0x7F7F7F7F7F7F7F7FULL;
+
+  // Join 7 bit groups.
+  word = (word & 0x007F007F007F007FULL) | ((word & 0x7F007F007F007F00ULL) >> 1);
+  word = (word & 0x00003FFF00003FFFULL) | ((word & 0x3FFF00003FFF0000ULL) >> 2);
+  word = (word & 0x000000000FFFFFFFULL) | ((word & 0x0FFFFFFF00000000ULL) >> 4);
+
+  value = word;
+  return (bits::NumLoZeroBits64(stopBits) >> 3) + 1;
+}
+
+// Decodes the array word by word while at least 8 bytes are left, the tail is decoded by bytes.
+template <typename ConverterT, typename F>
+void const * ReadVarInt64ArrayBulk(void const * pBeg, void const * pEnd, F & f,
+                                   ConverterT converter)
+{
+  size_t constexpr kMaxVarUint64Size = 10;
+
+  uint8_t const * p = static_cast<uint8_t const *>(pBeg);
+  uint8_t const * const end = static_cast<uint8_t const *>(pEnd);
+  while (end - p >= 8)
+  {
+    // One byte varints are the most frequent ones.
+    if (!(*p & 128))
+    {
+      f(converter(static_cast<uint64_t>(*p)));
+      ++p;
+      continue;
+    }
+
+    uint64_t value;
+    size_t const size = DecodeShortVarUint(p, value);
+    if (size != 0)
+    {
+      f(converter(value));
+      p += size;
+      continue;
+    }
+
+    // Long varints are rare, they are decoded by bytes.
+    if (static_cast<size_t>(end - p) < kMaxVarUint64Size)
+      break;
+    p = static_cast<uint8_t const *>(
+        ReadVarInt64Array(p, ReadVarInt64ArrayGivenSize(1), std::ref(f), converter));
+  }
+
+  return ReadVarInt64Array(p, ReadVarInt64ArrayUntilBufferEnd(pEnd), std::ref(f), converter);
+}
 }
 
 template <typename F>
 void const * ReadVarInt64Array(void const * pBeg, void const * pEnd, F f)
 {
-  return impl::ReadVarInt64Array<int64_t (*)(uint64_t)>(
-        pBeg, impl::ReadVarInt64ArrayUntilBufferEnd(pEnd), f, &bits::ZigZagDecode);
+  return impl::ReadVarInt64ArrayBulk<int64_t (*)(uint64_t)>(pBeg, pEnd, f, &bits::ZigZagDecode);
 }
 
 template <typename F>
 void const * ReadVarUint64Array(void const * pBeg, void const * pEnd, F f)
 {
-  return impl::ReadVarInt64Array(pBeg, impl::ReadVarInt64ArrayUntilBufferEnd(pEnd), f, base::IdFunctor());
+  return impl::ReadVarInt64ArrayBulk(pBeg, pEnd, f, base::IdFunctor());
 }
 
 template <typename F>
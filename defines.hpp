@@ -24,14 +24,18 @@
 #define OFFSET_EXT ".offs"
 #define ID2REL_EXT ".id2rel"
 
+#define CATEGORY_CELLS_FILE_TAG "category_cells"
 #define CENTERS_FILE_TAG "centers"
+#define COMPLETIONS_FILE_TAG "completions"
 #define FEATURES_FILE_TAG_V1_V9 "dat"
 #define FEATURES_FILE_TAG "features"
+#define FEATURE_TYPES_FILE_TAG "feature_types"
 #define GEOMETRY_FILE_TAG "geom"
 #define TRIANGLE_FILE_TAG "trg"
 #define INDEX_FILE_TAG "idx"
 #define SEARCH_INDEX_FILE_TAG "sdx"
 #define SEARCH_ADDRESS_FILE_TAG "addr"
+#define STREET_HOUSES_FILE_TAG "street_houses"
 #define POSTCODE_POINTS_FILE_TAG "postcode_points"
 #define POSTCODES_FILE_TAG "postcodes"
 #define CITIES_BOUNDARIES_FILE_TAG "cities_boundaries"
@@ -61,6 +65,8 @@
 #define DESCRIPTIONS_FILE_TAG "descriptions"
 #define MAXSPEEDS_FILE_TAG "maxspeeds"
 #define ROUTING_WORLD_FILE_TAG "routing_world"
+#define CROSS_MWM_LANDMARKS_FILE_TAG "cross_mwm_landmarks"
+#define SPEED_PROFILES_FILE_TAG "speed_profiles"
 
 #define READY_FILE_EXTENSION ".ready"
 #define RESUME_FILE_EXTENSION ".resume"
@@ -87,6 +93,7 @@
 
 #define SETTINGS_FILE_NAME "settings.ini"
 #define MARKETING_SETTINGS_FILE_NAME "marketing_settings.ini"
+#define MWM_MANIFEST_FILE_NAME "mwm_manifest.bin"
 
 #define SEARCH_CATEGORIES_FILE_NAME "categories.txt"
 #define SEARCH_CUISINE_CATEGORIES_FILE_NAME "categories_cuisines.txt"
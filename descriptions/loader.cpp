@@ -30,6 +30,8 @@ bool Loader::GetDescription(FeatureID const & featureId, std::vector<int8_t> con
     {
       auto const result = m_deserializers.emplace(featureId.m_mwmId, std::make_shared<Entry>());
       it = result.first;
+      it->second->m_deserializer.SetCacheId(value.m_cont.GetFileName() + ":" +
+                                            DESCRIPTIONS_FILE_TAG);
     }
     entry = it->second;
   }
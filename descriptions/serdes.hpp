@@ -179,27 +179,18 @@ public:
   {
     InitializeIfNeeded(reader);
 
-    LangMetaOffset startOffset = 0;
-    LangMetaOffset endOffset = 0;
-    {
-      ReaderPtr<Reader> idsSubReader(CreateFeatureIndicesSubReader(reader));
-      DDVector<FeatureIndex, ReaderPtr<Reader>> ids(idsSubReader);
-      auto const it = std::lower_bound(ids.begin(), ids.end(), featureIndex);
-      if (it == ids.end() || *it != featureIndex)
-        return false;
-
-      auto const d = static_cast<uint32_t>(std::distance(ids.begin(), it));
-
-      ReaderPtr<Reader> ofsSubReader(CreateLangMetaOffsetsSubReader(reader));
-      DDVector<LangMetaOffset, ReaderPtr<Reader>> ofs(ofsSubReader);
-      CHECK_LESS(d, ofs.size(), ());
-      CHECK_LESS(d + 1, ofs.size(), ());
-
-      startOffset = ofs[d];
-      endOffset = ofs[d + 1];
-    }
-
-    LangMeta langMeta;
+    auto const it = std::lower_bound(m_featureIndices.begin(), m_featureIndices.end(), featureIndex);
+    if (it == m_featureIndices.end() || *it != featureIndex)
+      return false;
+
+    auto const d = static_cast<size_t>(std::distance(m_featureIndices.begin(), it));
+    CHECK_LESS(d + 1, m_langMetaOffsets.size(), ());
+    LangMetaOffset const startOffset = m_langMetaOffsets[d];
+    LangMetaOffset const endOffset = m_langMetaOffsets[d + 1];
+
+    // Only the string of the language with the highest priority is read.
+    auto bestPriority = langPriority.size();
+    StringIndex bestStringIndex = 0;
     {
       auto langMetaSubReader = CreateLangMetaSubReader(reader, startOffset, endOffset);
       NonOwningReaderSource source(*langMetaSubReader);
@@ -208,24 +199,27 @@ public:
       {
         auto const lang = ReadPrimitiveFromSource<LangCode>(source);
         auto const stringIndex = ReadVarUint<StringIndex>(source);
-        langMeta.insert(std::make_pair(lang, stringIndex));
+        auto const priority = static_cast<size_t>(std::distance(
+            langPriority.begin(), std::find(langPriority.begin(), langPriority.end(), lang)));
+        if (priority < bestPriority)
+        {
+          bestPriority = priority;
+          bestStringIndex = stringIndex;
+        }
       }
     }
 
-    auto stringsSubReader = CreateStringsSubReader(reader);
-    for (auto const lang : langPriority)
-    {
-      auto const it = langMeta.find(lang);
-      if (it != langMeta.end())
-      {
-        description = m_stringsReader.ExtractString(*stringsSubReader, it->second);
-        return true;
-      }
-    }
+    if (bestPriority == langPriority.size())
+      return false;
 
-    return false;
+    auto stringsSubReader = CreateStringsSubReader(reader);
+    description = m_stringsReader.ExtractString(*stringsSubReader, bestStringIndex);
+    return true;
   }
 
+  // See coding::BlockedTextStorageReader::SetCacheId().
+  void SetCacheId(std::string const & cacheId) { m_stringsReader.SetCacheId(cacheId); }
+
   template <typename Reader>
   std::unique_ptr<Reader> CreateFeatureIndicesSubReader(Reader & reader)
   {
@@ -284,10 +278,23 @@ private:
     }
 
     m_initialized = true;
+
+    // The index of the features is loaded once, so a lookup does not read the section.
+    ReaderPtr<Reader> idsSubReader(CreateFeatureIndicesSubReader(reader));
+    DDVector<FeatureIndex, ReaderPtr<Reader>> ids(idsSubReader);
+    m_featureIndices.assign(ids.begin(), ids.end());
+
+    ReaderPtr<Reader> ofsSubReader(CreateLangMetaOffsetsSubReader(reader));
+    DDVector<LangMetaOffset, ReaderPtr<Reader>> ofs(ofsSubReader);
+    m_langMetaOffsets.assign(ofs.begin(), ofs.end());
+    CHECK_EQUAL(m_featureIndices.size() + 1, m_langMetaOffsets.size(), ());
   }
 
   bool m_initialized = false;
   HeaderV0 m_header;
+  // Sorted indices of the features with descriptions and the offsets of their language metas.
+  std::vector<FeatureIndex> m_featureIndices;
+  std::vector<LangMetaOffset> m_langMetaOffsets;
   coding::BlockedTextStorageReader m_stringsReader;
 };
 }  // namespace descriptions
@@ -0,0 +1,165 @@
+#include "testing/testing.hpp"
+
+#include "drape/glyph_disk_cache.hpp"
+#include "drape/glyph_manager.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/scope_guard.hpp"
+#include "base/shared_buffer_manager.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace dp;
+
+namespace
+{
+uint64_t constexpr kFingerprint = 42;
+
+GlyphManager::Glyph MakeGlyph(int fontIndex, strings::UniChar code, uint32_t width,
+                              uint32_t height)
+{
+  GlyphManager::Glyph glyph;
+  glyph.m_metrics = GlyphManager::GlyphMetrics{10.0f, 0.0f, 1.0f, -2.0f, true};
+  glyph.m_fontIndex = fontIndex;
+  glyph.m_code = code;
+  glyph.m_fixedSize = GlyphManager::kDynamicGlyphSize;
+
+  auto const size = width * height;
+  auto data = SharedBufferManager::instance().reserveSharedBuffer(size);
+  for (uint32_t i = 0; i < size; ++i)
+    (*data)[i] = static_cast<uint8_t>(i + code);
+  glyph.m_image = GlyphManager::GlyphImage{width, height, 0 /* bitmapRows */,
+                                           0 /* bitmapPitch */, data};
+  return glyph;
+}
+
+void TestGlyphsEqual(GlyphManager::Glyph const & lhs, GlyphManager::Glyph const & rhs)
+{
+  TEST_EQUAL(lhs.m_fontIndex, rhs.m_fontIndex, ());
+  TEST_EQUAL(lhs.m_code, rhs.m_code, ());
+  TEST_EQUAL(lhs.m_fixedSize, rhs.m_fixedSize, ());
+  TEST_EQUAL(lhs.m_metrics.m_xAdvance, rhs.m_metrics.m_xAdvance, ());
+  TEST_EQUAL(lhs.m_metrics.m_yAdvance, rhs.m_metrics.m_yAdvance, ());
+  TEST_EQUAL(lhs.m_metrics.m_xOffset, rhs.m_metrics.m_xOffset, ());
+  TEST_EQUAL(lhs.m_metrics.m_yOffset, rhs.m_metrics.m_yOffset, ());
+  TEST_EQUAL(lhs.m_image.m_width, rhs.m_image.m_width, ());
+  TEST_EQUAL(lhs.m_image.m_height, rhs.m_image.m_height, ());
+  TEST_EQUAL(rhs.m_image.m_bitmapRows, 0, ());
+
+  auto const size = lhs.m_image.m_width * lhs.m_image.m_height;
+  for (uint32_t i = 0; i < size; ++i)
+    TEST_EQUAL((*lhs.m_image.m_data)[i], (*rhs.m_image.m_data)[i], (i));
+}
+}  // namespace
+
+UNIT_TEST(GlyphDiskCache_Smoke)
+{
+  auto const filePath = base::JoinPath(GetPlatform().TmpDir(), "glyph_disk_cache_test.bin");
+  FileWriter::DeleteFileX(filePath);
+  SCOPE_GUARD(deleteFile, [&filePath]() { FileWriter::DeleteFileX(filePath); });
+
+  auto glyph1 = MakeGlyph(0, 0x41, 5, 7);
+  auto glyph2 = MakeGlyph(2, 0x4E2D, 12, 10);
+  {
+    GlyphDiskCache cache(filePath, kFingerprint);
+    GlyphManager::Glyph found;
+    TEST(!cache.Find(0, 0x41, found), ());
+
+    cache.Add(glyph1);
+    cache.Add(glyph2);
+    TEST(cache.Find(0, 0x41, found), ());
+    TestGlyphsEqual(glyph1, found);
+    found.m_image.Destroy();
+    cache.Flush();
+  }
+
+  {
+    GlyphDiskCache cache(filePath, kFingerprint);
+    GlyphManager::Glyph found;
+    TEST(cache.Find(2, 0x4E2D, found), ());
+    TestGlyphsEqual(glyph2, found);
+    found.m_image.Destroy();
+    TEST(!cache.Find(0, 0x4E2D, found), ());
+
+    // Added glyphs are appended to the file.
+    auto glyph3 = MakeGlyph(1, 0x42, 3, 3);
+    cache.Add(glyph3);
+    cache.Flush();
+
+    GlyphDiskCache reloadedCache(filePath, kFingerprint);
+    TEST(reloadedCache.Find(1, 0x42, found), ());
+    TestGlyphsEqual(glyph3, found);
+    found.m_image.Destroy();
+    TEST(reloadedCache.Find(0, 0x41, found), ());
+    found.m_image.Destroy();
+    glyph3.m_image.Destroy();
+  }
+
+  {
+    // The cache is dropped on the fonts change.
+    GlyphDiskCache cache(filePath, kFingerprint + 1);
+    GlyphManager::Glyph found;
+    TEST(!cache.Find(0, 0x41, found), ());
+  }
+
+  glyph1.m_image.Destroy();
+  glyph2.m_image.Destroy();
+}
+
+UNIT_TEST(GlyphDiskCache_TruncatedFile)
+{
+  auto const filePath = base::JoinPath(GetPlatform().TmpDir(), "glyph_disk_cache_test.bin");
+  FileWriter::DeleteFileX(filePath);
+  SCOPE_GUARD(deleteFile, [&filePath]() { FileWriter::DeleteFileX(filePath); });
+
+  auto glyph1 = MakeGlyph(0, 0x41, 5, 7);
+  auto glyph2 = MakeGlyph(0, 0x42, 5, 7);
+  {
+    GlyphDiskCache cache(filePath, kFingerprint);
+    cache.Add(glyph1);
+    cache.Add(glyph2);
+    cache.Flush();
+  }
+
+  {
+    // Simulate an interrupted write.
+    std::vector<uint8_t> data;
+    {
+      FileReader r(filePath);
+      data.resize(static_cast<size_t>(r.Size()) - 1);
+      r.Read(0, data.data(), data.size());
+    }
+    FileWriter w(filePath);
+    w.Write(data.data(), data.size());
+  }
+
+  {
+    GlyphDiskCache cache(filePath, kFingerprint);
+    GlyphManager::Glyph found;
+    TEST(cache.Find(0, 0x41, found), ());
+    TestGlyphsEqual(glyph1, found);
+    found.m_image.Destroy();
+    TEST(!cache.Find(0, 0x42, found), ());
+
+    cache.Add(glyph2);
+    cache.Flush();
+  }
+
+  {
+    GlyphDiskCache cache(filePath, kFingerprint);
+    GlyphManager::Glyph found;
+    TEST(cache.Find(0, 0x42, found), ());
+    TestGlyphsEqual(glyph2, found);
+    found.m_image.Destroy();
+  }
+
+  glyph1.m_image.Destroy();
+  glyph2.m_image.Destroy();
+}
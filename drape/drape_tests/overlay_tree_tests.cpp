@@ -0,0 +1,154 @@
+#include "testing/testing.hpp"
+
+#include "drape/overlay_handle.hpp"
+#include "drape/overlay_tree.hpp"
+
+#include "indexer/feature_decl.hpp"
+
+#include "geometry/any_rect2d.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/screenbase.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace dp;
+
+namespace
+{
+int constexpr kZoomLevel = 10;
+double constexpr kHandleSize = 10.0;
+
+ScreenBase MakeScreen()
+{
+  ScreenBase screen;
+  screen.OnSize(0, 0, 1000, 1000);
+  screen.SetFromRect(m2::AnyRectD(m2::RectD(0.0, 0.0, 1.0, 1.0)));
+  return screen;
+}
+
+class HandlesHolder
+{
+public:
+  explicit HandlesHolder(ScreenBase const & screen) : m_screen(screen) {}
+
+  ref_ptr<OverlayHandle> Add(uint32_t featureIndex, uint32_t index, m2::PointD const & pxPivot,
+                             uint64_t priority, int rank, bool isBound)
+  {
+    OverlayID const id(FeatureID(MwmSet::MwmId(), featureIndex), 0 /* markId */,
+                       m2::PointI::Zero(), index);
+    auto handle = std::make_unique<SquareHandle>(
+      id, Center, m_screen.PtoG(pxPivot), m2::PointD(kHandleSize, kHandleSize),
+      m2::PointD::Zero(), priority, isBound, 0 /* minVisibleScale */, false /* isBillboard */);
+    handle->SetOverlayRank(rank);
+    m_handles.push_back(std::move(handle));
+    return make_ref(m_handles.back());
+  }
+
+  void Place(OverlayTree & tree) const
+  {
+    tree.InvalidateOnNextFrame();
+    TEST(tree.Frame(), ());
+    tree.StartOverlayPlacing(m_screen, kZoomLevel);
+    for (auto const & handle : m_handles)
+      tree.Add(make_ref(handle));
+    tree.EndOverlayPlacing();
+  }
+
+private:
+  ScreenBase const & m_screen;
+  std::vector<std::unique_ptr<OverlayHandle>> m_handles;
+};
+}  // namespace
+
+UNIT_TEST(OverlayTree_PriorityDisplacement)
+{
+  ScreenBase const screen = MakeScreen();
+  HandlesHolder handles(screen);
+  auto const low = handles.Add(1, 0, m2::PointD(500.0, 500.0), 1 /* priority */, OverlayRank0,
+                               false /* isBound */);
+  auto const high = handles.Add(2, 0, m2::PointD(505.0, 505.0), 2 /* priority */, OverlayRank0,
+                                false /* isBound */);
+  auto const separate = handles.Add(3, 0, m2::PointD(100.0, 100.0), 0 /* priority */,
+                                    OverlayRank0, false /* isBound */);
+
+  OverlayTree tree(1.0 /* visualScale */);
+  handles.Place(tree);
+
+  TEST(!low->IsVisible(), ());
+  TEST(high->IsVisible(), ());
+  TEST(separate->IsVisible(), ());
+}
+
+UNIT_TEST(OverlayTree_BoundHandlesDisplacement)
+{
+  ScreenBase const screen = MakeScreen();
+  HandlesHolder handles(screen);
+
+  // Handles of the feature 1 are bound to each other. The second one is placed before
+  // the displacer because of its priority.
+  auto const bound0 = handles.Add(1, 0, m2::PointD(500.0, 500.0), 5 /* priority */, OverlayRank0,
+                                  true /* isBound */);
+  auto const bound1 = handles.Add(1, 0, m2::PointD(800.0, 800.0), 20 /* priority */, OverlayRank1,
+                                  true /* isBound */);
+  // The handle has the other index so it's not bound to the handles above.
+  auto const other = handles.Add(1, 1, m2::PointD(200.0, 800.0), 5 /* priority */, OverlayRank0,
+                                 true /* isBound */);
+
+  auto const displacer0 = handles.Add(2, 0, m2::PointD(100.0, 100.0), 10 /* priority */,
+                                      OverlayRank0, false /* isBound */);
+  auto const displacer1 = handles.Add(2, 0, m2::PointD(505.0, 505.0), 10 /* priority */,
+                                      OverlayRank1, true /* isBound */);
+
+  OverlayTree tree(1.0 /* visualScale */);
+  handles.Place(tree);
+
+  TEST(!bound0->IsVisible(), ());
+  TEST(!bound1->IsVisible(), ());
+  TEST(other->IsVisible(), ());
+  TEST(displacer0->IsVisible(), ());
+  TEST(displacer1->IsVisible(), ());
+
+  // The rebuilt tree must be the same.
+  handles.Place(tree);
+  TEST(!bound0->IsVisible(), ());
+  TEST(!bound1->IsVisible(), ());
+  TEST(other->IsVisible(), ());
+  TEST(displacer0->IsVisible(), ());
+  TEST(displacer1->IsVisible(), ());
+}
+
+UNIT_TEST(OverlayTree_PlacingBenchmark)
+{
+  uint32_t constexpr kFeaturesCount = 5000;
+  int constexpr kRebuildsCount = 10;
+
+  ScreenBase const screen = MakeScreen();
+  HandlesHolder handles(screen);
+
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> coord(0.0, 1000.0);
+  std::uniform_int_distribution<uint64_t> priority(0, 1000);
+  for (uint32_t i = 0; i < kFeaturesCount; ++i)
+  {
+    // An icon with a bound caption as it's generated for POIs.
+    m2::PointD const pivot(coord(rng), coord(rng));
+    uint64_t const p = priority(rng);
+    handles.Add(i, 0, pivot, p, OverlayRank0, true /* isBound */);
+    handles.Add(i, 0, pivot + m2::PointD(0.0, kHandleSize), p, OverlayRank1, true /* isBound */);
+  }
+
+  OverlayTree tree(1.0 /* visualScale */);
+  base::Timer timer;
+  for (int i = 0; i < kRebuildsCount; ++i)
+    handles.Place(tree);
+
+  LOG(LINFO, ("Overlay tree of", 2 * kFeaturesCount, "handles is placed in",
+              timer.ElapsedSeconds() / kRebuildsCount, "seconds"));
+}
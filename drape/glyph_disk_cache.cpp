@@ -0,0 +1,213 @@
+#include "drape/glyph_disk_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/shared_buffer_manager.hpp"
+
+namespace dp
+{
+namespace
+{
+uint32_t constexpr kVersion = 1;
+size_t constexpr kHeaderSize = sizeof(uint32_t) + sizeof(uint64_t);
+// Font index, code, 4 metrics, width and height.
+size_t constexpr kRecordHeaderSize = 8 * sizeof(uint32_t);
+
+size_t constexpr kMaxRecordsSize = 4 * 1024 * 1024;
+size_t constexpr kFlushSize = 64 * 1024;
+
+template <typename Sink>
+void WriteFloat(Sink & sink, float value)
+{
+  sink.Write(&value, sizeof(value));
+}
+}  // namespace
+
+GlyphDiskCache::GlyphDiskCache(std::string const & filePath, uint64_t fingerprint)
+  : m_filePath(filePath)
+  , m_fingerprint(fingerprint)
+{
+  Load();
+}
+
+void GlyphDiskCache::Load()
+{
+  if (!GetPlatform().IsFileExistsByFullPath(m_filePath))
+    return;
+
+  std::vector<uint8_t> data;
+  try
+  {
+    FileReader r(m_filePath);
+    NonOwningReaderSource src(r);
+    if (r.Size() < kHeaderSize || ReadPrimitiveFromSource<uint32_t>(src) != kVersion ||
+        ReadPrimitiveFromSource<uint64_t>(src) != m_fingerprint)
+    {
+      // The cache is obsolete, it will be rewritten on the next flush.
+      return;
+    }
+
+    data.resize(static_cast<size_t>(r.Size()) - kHeaderSize);
+    src.Read(data.data(), data.size());
+  }
+  catch (FileReader::Exception const & exception)
+  {
+    LOG(LWARNING, ("Exception while reading file:", m_filePath, "reason:", exception.what()));
+    return;
+  }
+
+  size_t offset = 0;
+  while (offset + kRecordHeaderSize <= data.size())
+  {
+    MemReader reader(data.data() + offset, kRecordHeaderSize);
+    ReaderSource<MemReader> src(reader);
+    auto const fontIndex = static_cast<int>(ReadPrimitiveFromSource<uint32_t>(src));
+    auto const code = ReadPrimitiveFromSource<uint32_t>(src);
+    src.Skip(4 * sizeof(float));
+    auto const width = ReadPrimitiveFromSource<uint32_t>(src);
+    auto const height = ReadPrimitiveFromSource<uint32_t>(src);
+
+    size_t const recordSize = kRecordHeaderSize + static_cast<size_t>(width) * height;
+    if (offset + recordSize > data.size())
+      break;
+
+    m_index.emplace(Key(fontIndex, code), offset);
+    offset += recordSize;
+  }
+
+  // A truncated record is dropped, the file is rewritten on the next flush in this case.
+  m_flushedSize = (offset == data.size()) ? offset : 0;
+  data.resize(offset);
+  m_records = std::move(data);
+  m_flushRequestedSize = m_records.size();
+}
+
+bool GlyphDiskCache::Find(int fontIndex, strings::UniChar code, GlyphManager::Glyph & glyph) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_index.find(Key(fontIndex, code));
+  if (it == m_index.end())
+    return false;
+
+  MemReader reader(m_records.data() + it->second, m_records.size() - it->second);
+  ReaderSource<MemReader> src(reader);
+  src.Skip(2 * sizeof(uint32_t));
+
+  glyph.m_metrics.m_xAdvance = ReadPrimitiveFromSource<float>(src);
+  glyph.m_metrics.m_yAdvance = ReadPrimitiveFromSource<float>(src);
+  glyph.m_metrics.m_xOffset = ReadPrimitiveFromSource<float>(src);
+  glyph.m_metrics.m_yOffset = ReadPrimitiveFromSource<float>(src);
+  glyph.m_metrics.m_isValid = true;
+
+  glyph.m_image.m_width = ReadPrimitiveFromSource<uint32_t>(src);
+  glyph.m_image.m_height = ReadPrimitiveFromSource<uint32_t>(src);
+  // Zero rows and pitch mean that the image is generated already.
+  glyph.m_image.m_bitmapRows = 0;
+  glyph.m_image.m_bitmapPitch = 0;
+
+  size_t const imageSize = glyph.m_image.m_width * glyph.m_image.m_height;
+  glyph.m_image.m_data = nullptr;
+  if (imageSize != 0)
+  {
+    // Buffers are reserved the same way as for the generated glyphs.
+    auto const bufferSize = base::NextPowOf2(static_cast<uint32_t>(imageSize));
+    glyph.m_image.m_data = SharedBufferManager::instance().reserveSharedBuffer(bufferSize);
+    src.Read(glyph.m_image.m_data->data(), imageSize);
+  }
+
+  glyph.m_fontIndex = fontIndex;
+  glyph.m_code = code;
+  glyph.m_fixedSize = GlyphManager::kDynamicGlyphSize;
+  return true;
+}
+
+void GlyphDiskCache::Add(GlyphManager::Glyph const & glyph)
+{
+  ASSERT_LESS(glyph.m_fixedSize, 0, ());
+  ASSERT_EQUAL(glyph.m_image.m_bitmapRows, 0, ());
+
+  size_t const imageSize = glyph.m_image.m_width * glyph.m_image.m_height;
+  auto const & data = glyph.m_image.m_data;
+  if (imageSize != 0 && (data == nullptr || data->size() < imageSize))
+    return;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_records.size() + kRecordHeaderSize + imageSize > kMaxRecordsSize)
+    return;
+
+  auto const res = m_index.emplace(Key(glyph.m_fontIndex, glyph.m_code), m_records.size());
+  if (!res.second)
+    return;
+
+  MemWriter<std::vector<uint8_t>> w(m_records);
+  w.Seek(m_records.size());
+  WriteToSink(w, static_cast<uint32_t>(glyph.m_fontIndex));
+  WriteToSink(w, static_cast<uint32_t>(glyph.m_code));
+  WriteFloat(w, glyph.m_metrics.m_xAdvance);
+  WriteFloat(w, glyph.m_metrics.m_yAdvance);
+  WriteFloat(w, glyph.m_metrics.m_xOffset);
+  WriteFloat(w, glyph.m_metrics.m_yOffset);
+  WriteToSink(w, glyph.m_image.m_width);
+  WriteToSink(w, glyph.m_image.m_height);
+  if (imageSize != 0)
+    w.Write(data->data(), imageSize);
+}
+
+bool GlyphDiskCache::RequestFlush()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_records.size() < m_flushRequestedSize + kFlushSize)
+    return false;
+
+  m_flushRequestedSize = m_records.size();
+  return true;
+}
+
+void GlyphDiskCache::Flush()
+{
+  std::lock_guard<std::mutex> flushLock(m_flushMutex);
+
+  std::vector<uint8_t> records;
+  size_t flushedSize;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_records.size() == m_flushedSize)
+      return;
+
+    flushedSize = m_flushedSize;
+    records.assign(m_records.begin() + m_flushedSize, m_records.end());
+  }
+
+  try
+  {
+    if (flushedSize == 0)
+    {
+      FileWriter w(m_filePath);
+      WriteToSink(w, kVersion);
+      WriteToSink(w, m_fingerprint);
+      w.Write(records.data(), records.size());
+    }
+    else
+    {
+      FileWriter w(m_filePath, FileWriter::OP_APPEND);
+      w.Write(records.data(), records.size());
+    }
+  }
+  catch (FileWriter::Exception const & exception)
+  {
+    LOG(LWARNING, ("Exception while writing file:", m_filePath, "reason:", exception.what()));
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_flushedSize = flushedSize + records.size();
+}
+}  // namespace dp
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "drape/glyph_manager.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dp
+{
+// Persistent cache of generated SDF glyphs. Glyph metrics and images are stored in one file,
+// so on warm starts rasterisation and SDF generation are skipped for the glyphs which have
+// been shown before. |fingerprint| identifies fonts and glyph sizes, the file is discarded
+// if they change. The cache is loaded to memory, its size is limited.
+// All methods can be called from any thread.
+class GlyphDiskCache
+{
+public:
+  GlyphDiskCache(std::string const & filePath, uint64_t fingerprint);
+
+  // Returns a glyph with the generated SDF image. The image must be destroyed by the caller.
+  bool Find(int fontIndex, strings::UniChar code, GlyphManager::Glyph & glyph) const;
+  // |glyph| must contain the generated SDF image.
+  void Add(GlyphManager::Glyph const & glyph);
+
+  // Returns true once per a portion of the added glyphs, Flush() should be run then.
+  bool RequestFlush();
+  // Appends the added glyphs to the file.
+  void Flush();
+
+private:
+  using Key = std::pair<int, strings::UniChar>;
+
+  void Load();
+
+  std::string const m_filePath;
+  uint64_t const m_fingerprint;
+
+  mutable std::mutex m_mutex;
+  // Glyph records in the file format.
+  std::vector<uint8_t> m_records;
+  // Offsets of the records in |m_records|.
+  std::map<Key, size_t> m_index;
+  // Size of the records which are already in the file.
+  size_t m_flushedSize = 0;
+  // Size of the records at the moment of the last flush request.
+  size_t m_flushRequestedSize = 0;
+
+  // Flushes can be run from different threads, they must not be interleaved.
+  std::mutex m_flushMutex;
+};
+}  // namespace dp
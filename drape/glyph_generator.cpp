@@ -1,11 +1,19 @@
 #include "drape/glyph_generator.hpp"
 
+#include <algorithm>
 #include <iterator>
 
 using namespace std::placeholders;
 
 namespace dp
 {
+namespace
+{
+// Glyphs are generated by several tasks to be spread across the threads of DrapeRoutine.
+size_t constexpr kMaxTasksCount = 4;
+size_t constexpr kMinGlyphsPerTask = 16;
+}  // namespace
+
 GlyphGenerator::GlyphGenerator(uint32_t sdfScale)
   : m_sdfScale(sdfScale)
 {}
@@ -78,18 +86,33 @@ void GlyphGenerator::GenerateGlyphs(ref_ptr<Listener> listener,
   std::swap(m_queue, queue);
   m_glyphsCounter += queue.size();
 
-  // Generate glyphs on the separate thread.
-  auto generateTask = std::make_shared<GenerateGlyphTask>(std::move(queue));
-  auto result = DrapeRoutine::Run([this, listener, generateTask]() mutable
+  // Generate glyphs on the separate threads.
+  size_t const tasksCount = std::min(kMaxTasksCount,
+                                     std::max(queue.size() / kMinGlyphsPerTask, size_t{1}));
+  size_t const glyphsPerTask = (queue.size() + tasksCount - 1) / tasksCount;
+  for (size_t i = 0; i < queue.size(); i += glyphsPerTask)
   {
-    generateTask->Run(m_sdfScale);
-    OnTaskFinished(listener, generateTask);
-  });
-
-  if (result)
-    m_activeTasks.Add(generateTask, result);
-  else
-    generateTask->DestroyAllGlyphs();
+    size_t const last = std::min(i + glyphsPerTask, queue.size());
+    auto const begin = std::make_move_iterator(queue.begin() + i);
+    auto const end = std::make_move_iterator(queue.begin() + last);
+    auto generateTask = std::make_shared<GenerateGlyphTask>(GlyphGenerationDataArray(begin, end));
+    auto result = DrapeRoutine::Run([this, listener, generateTask]() mutable
+    {
+      generateTask->Run(m_sdfScale);
+      OnTaskFinished(listener, generateTask);
+    });
+
+    if (result)
+    {
+      m_activeTasks.Add(generateTask, result);
+    }
+    else
+    {
+      ASSERT_GREATER_OR_EQUAL(m_glyphsCounter, generateTask->GetGlyphsCount(), ());
+      m_glyphsCounter -= generateTask->GetGlyphsCount();
+      generateTask->DestroyAllGlyphs();
+    }
+  }
 }
 
 void GlyphGenerator::OnTaskFinished(ref_ptr<Listener> listener,
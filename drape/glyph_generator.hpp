@@ -55,6 +55,7 @@ public:
 
     GlyphGenerationDataArray && StealGeneratedGlyphs() { return std::move(m_generatedGlyphs); }
     bool IsCancelled() const { return m_isCancelled; }
+    size_t GetGlyphsCount() const { return m_glyphs.size(); }
     void DestroyAllGlyphs();
 
   private:
@@ -1,15 +1,19 @@
 #include "drape/glyph_manager.hpp"
+#include "drape/drape_routine.hpp"
+#include "drape/glyph_disk_cache.hpp"
 #include "3party/sdf_image/sdf_image.h"
 
 #include "platform/platform.hpp"
 
 #include "coding/reader.hpp"
+#include "coding/sha1.hpp"
 
 #include "base/string_utils.hpp"
 #include "base/logging.hpp"
 #include "base/math.hpp"
 #include "base/timer.hpp"
 
+#include <functional>
 #include <limits>
 #include <memory>
 #include <set>
@@ -282,6 +286,8 @@ public:
 
   static void Close(FT_Stream){}
 
+  uint64_t GetFileSize() const { return m_fontReader.Size(); }
+
   void MarkGlyphReady(strings::UniChar code, int fixedHeight)
   {
     m_readyGlyphs.insert(std::make_pair(code, fixedHeight));
@@ -300,6 +306,17 @@ private:
 
   std::set<std::pair<strings::UniChar, int>> m_readyGlyphs;
 };
+
+// The fingerprint is stored in the glyphs cache file, so it should not depend on the standard
+// library implementation.
+uint64_t CalculateFingerprint(std::string const & str)
+{
+  auto const hash = coding::SHA1::CalculateForString(str);
+  uint64_t result = 0;
+  for (size_t i = 0; i < sizeof(result); ++i)
+    result = (result << 8) | hash[i];
+  return result;
+}
 }  // namespace
 
 // Information about single unicode block.
@@ -362,6 +379,9 @@ struct GlyphManager::Impl
 
   uint32_t m_baseGlyphHeight;
   uint32_t m_sdfScale;
+
+  // It's shared with the flushing tasks.
+  std::shared_ptr<GlyphDiskCache> m_diskCache;
 };
 
 GlyphManager::GlyphManager(GlyphManager::Params const & params)
@@ -397,6 +417,9 @@ GlyphManager::GlyphManager(GlyphManager::Params const & params)
 
   FREETYPE_CHECK(FT_Init_FreeType(&m_impl->m_library));
 
+  // Fingerprint of the loaded fonts for the glyphs cache.
+  std::ostringstream fingerprint;
+
   for (auto const & fontName : params.m_fonts)
   {
     bool ignoreFont = false;
@@ -415,6 +438,7 @@ GlyphManager::GlyphManager(GlyphManager::Params const & params)
       m_impl->m_fonts.emplace_back(std::make_unique<Font>(params.m_sdfScale, GetPlatform().GetReader(fontName),
                                                           m_impl->m_library));
       m_impl->m_fonts.back()->GetCharcodes(charCodes);
+      fingerprint << fontName << ":" << m_impl->m_fonts.back()->GetFileSize() << ";";
     }
     catch(RootException const & e)
     {
@@ -498,10 +522,21 @@ GlyphManager::GlyphManager(GlyphManager::Params const & params)
   LOG(LINFO, ("Unsupported unicode blocks:", ss.str()));
 
   m_impl->m_lastUsedBlock = m_impl->m_blocks.end();
+
+  if (!params.m_glyphsCacheFile.empty())
+  {
+    // Glyphs of the cache are valid for the same fonts and sizes only.
+    fingerprint << params.m_baseGlyphHeight << ";" << params.m_sdfScale;
+    m_impl->m_diskCache = std::make_shared<GlyphDiskCache>(
+      params.m_glyphsCacheFile, CalculateFingerprint(fingerprint.str()));
+  }
 }
 
 GlyphManager::~GlyphManager()
 {
+  if (m_impl->m_diskCache != nullptr)
+    m_impl->m_diskCache->Flush();
+
   for (auto const & f : m_impl->m_fonts)
     f->DestroyFont();
 
@@ -582,9 +617,16 @@ GlyphManager::Glyph GlyphManager::GetGlyph(strings::UniChar unicodePoint, int fi
   if (fontIndex == kInvalidFont)
     return GetInvalidGlyph(fixedHeight);
 
-  auto const & f = m_impl->m_fonts[fontIndex];
   bool const isSdf = fixedHeight < 0;
-  Glyph glyph = f->GetGlyph(unicodePoint, isSdf ? m_impl->m_baseGlyphHeight : fixedHeight, isSdf);
+  Glyph glyph;
+  if (isSdf && m_impl->m_diskCache != nullptr &&
+      m_impl->m_diskCache->Find(fontIndex, unicodePoint, glyph))
+  {
+    return glyph;
+  }
+
+  auto const & f = m_impl->m_fonts[fontIndex];
+  glyph = f->GetGlyph(unicodePoint, isSdf ? m_impl->m_baseGlyphHeight : fixedHeight, isSdf);
   glyph.m_fontIndex = fontIndex;
   return glyph;
 }
@@ -600,7 +642,8 @@ GlyphManager::Glyph GlyphManager::GenerateGlyph(Glyph const & glyph, uint32_t sd
     resultGlyph.m_code = glyph.m_code;
     resultGlyph.m_fixedSize = glyph.m_fixedSize;
 
-    if (glyph.m_fixedSize < 0)
+    // Images of the cached glyphs are generated already, they have zero bitmap rows.
+    if (glyph.m_fixedSize < 0 && glyph.m_image.m_bitmapRows != 0)
     {
       sdf_image::SdfImage img(glyph.m_image.m_bitmapRows, glyph.m_image.m_bitmapPitch,
                               glyph.m_image.m_data->data(), sdfScale * kSdfBorder);
@@ -643,6 +686,14 @@ void GlyphManager::MarkGlyphReady(Glyph const & glyph)
   ASSERT_GREATER_OR_EQUAL(glyph.m_fontIndex, 0, ());
   ASSERT_LESS(glyph.m_fontIndex, static_cast<int>(m_impl->m_fonts.size()), ());
   m_impl->m_fonts[glyph.m_fontIndex]->MarkGlyphReady(glyph.m_code, glyph.m_fixedSize);
+
+  auto const & diskCache = m_impl->m_diskCache;
+  if (diskCache == nullptr || glyph.m_fixedSize >= 0 || glyph.m_image.m_bitmapRows != 0)
+    return;
+
+  diskCache->Add(glyph);
+  if (diskCache->RequestFlush())
+    DrapeRoutine::RunSequential([diskCache]() { diskCache->Flush(); });
 }
 
 bool GlyphManager::AreGlyphsReady(strings::UniString const & str, int fixedSize) const
@@ -28,6 +28,10 @@ public:
 
     uint32_t m_baseGlyphHeight = 22;
     uint32_t m_sdfScale = 4;
+
+    // Generated SDF glyphs are stored to the file to be reused on the next start.
+    // Empty path disables the cache.
+    std::string m_glyphsCacheFile;
   };
 
   struct GlyphMetrics
@@ -135,7 +135,7 @@ void OverlayHandle::AddDynamicAttribute(BindingInfo const & binding, uint32_t of
   ASSERT(binding.IsDynamic(), ());
   ASSERT(std::find_if(m_offsets.begin(), m_offsets.end(),
                       OffsetNodeFinder(binding.GetID())) == m_offsets.end(), ());
-  m_offsets.insert(std::make_pair(binding, MutateRegion(offset, count)));
+  m_offsets.emplace_back(binding, MutateRegion(offset, count));
 }
 
 OverlayID const & OverlayHandle::GetOverlayID() const
@@ -17,7 +17,6 @@
 
 #include "base/buffer_vector.hpp"
 
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -96,7 +95,9 @@ struct OverlayID
 class OverlayHandle
 {
 public:
-  using Rects = std::vector<m2::RectF>;
+  // Most of the handles have a single rect in their shape, it's kept inline to avoid
+  // a heap allocation per handle.
+  using Rects = buffer_vector<m2::RectF, 1>;
 
   OverlayHandle(OverlayID const & id, dp::Anchor anchor,
                 uint64_t priority, int minVisibleScale, bool isBillboard);
@@ -183,24 +184,19 @@ private:
   bool const m_isBillboard;
   bool m_isVisible;
 
+  bool m_enableCaching;
+  mutable bool m_extendedShapeDirty;
+  mutable bool m_extendedRectDirty;
+
   dp::IndexStorage m_indexes;
-  struct LessOffsetNode
-  {
-    bool operator()(TOffsetNode const & node1, TOffsetNode const & node2) const
-    {
-      return node1.first.GetID() < node2.first.GetID();
-    }
-  };
 
   struct OffsetNodeFinder;
 
-  std::set<TOffsetNode, LessOffsetNode> m_offsets;
+  // Handles have one dynamic attribute buffer at most, the nodes are looked up linearly.
+  buffer_vector<TOffsetNode, 1> m_offsets;
 
-  bool m_enableCaching;
   mutable Rects m_extendedShapeCache;
-  mutable bool m_extendedShapeDirty;
   mutable m2::RectD m_extendedRectCache;
-  mutable bool m_extendedRectDirty;
 
   bool m_isReady = false;
   bool m_isSpecialLayerOverlay = false;
@@ -104,8 +104,11 @@ void OverlayTree::Clear()
   InvalidateOnNextFrame();
   TBase::Clear();
   m_handlesCache.clear();
+  m_placedHandlesById.clear();
   for (auto & handles : m_handles)
     handles.clear();
+  for (auto & handles : m_rankHandlesById)
+    handles.clear();
   m_displacers.clear();
 }
 
@@ -148,6 +151,7 @@ void OverlayTree::StartOverlayPlacing(ScreenBase const & screen, int zoomLevel)
   ASSERT(IsNeedUpdate(), ());
   TBase::Clear();
   m_handlesCache.clear();
+  m_placedHandlesById.clear();
   m_traits.SetModelView(screen);
   m_displacementInfo.clear();
   m_zoomLevel = zoomLevel;
@@ -223,8 +227,7 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
   m2::RectD const pixelRect = handle->GetExtendedPixelRect(modelView);
   if (!m_isDisplacementEnabled)
   {
-    m_handlesCache.insert(handle);
-    TBase::Add(handle, pixelRect);
+    AddPlacedHandle(handle, pixelRect);
     return;
   }
 
@@ -301,18 +304,16 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
     if (rivalHandle->IsBound())
     {
       // Delete rival handle and all handles bound to it.
-      for (auto it = m_handlesCache.begin(); it != m_handlesCache.end();)
+      auto const it = m_placedHandlesById.find(rivalHandle->GetOverlayID());
+      if (it != m_placedHandlesById.end())
       {
-        if ((*it)->GetOverlayID() == rivalHandle->GetOverlayID())
-        {
-          Erase(*it);
-          StoreDisplacementInfo(2 /* case index */, handle, *it);
-          it = m_handlesCache.erase(it);
-        }
-        else
+        for (auto const & boundHandle : it->second)
         {
-          ++it;
+          Erase(boundHandle);
+          StoreDisplacementInfo(2 /* case index */, handle, boundHandle);
+          m_handlesCache.erase(boundHandle);
         }
+        m_placedHandlesById.erase(it);
       }
     }
     else
@@ -322,7 +323,13 @@ void OverlayTree::InsertHandle(ref_ptr<OverlayHandle> handle, int currentRank,
     }
   }
 
-  m_handlesCache.insert(handle);
+  AddPlacedHandle(handle, pixelRect);
+}
+
+void OverlayTree::AddPlacedHandle(ref_ptr<OverlayHandle> handle, m2::RectD const & pixelRect)
+{
+  if (m_handlesCache.insert(handle).second)
+    m_placedHandlesById[handle->GetOverlayID()].push_back(handle);
   TBase::Add(handle, pixelRect);
 }
 
@@ -341,6 +348,12 @@ void OverlayTree::EndOverlayPlacing()
   for (int rank = 0; rank < dp::OverlayRanksCount; rank++)
   {
     std::sort(m_handles[rank].begin(), m_handles[rank].end(), comparator);
+    if (rank + 1 < dp::OverlayRanksCount)
+    {
+      for (auto const & handle : m_handles[rank])
+        m_rankHandlesById[rank][handle->GetOverlayID()].push_back(handle);
+    }
+
     for (auto const & handle : m_handles[rank])
     {
       ref_ptr<OverlayHandle> parentOverlay;
@@ -356,6 +369,7 @@ void OverlayTree::EndOverlayPlacing()
     for (auto const & handle : m_handles[rank])
       handle->SetDisplayFlag(false);
     m_handles[rank].clear();
+    m_rankHandlesById[rank].clear();
   }
 
   for (auto const & handle : m_handlesCache)
@@ -386,9 +400,14 @@ ref_ptr<OverlayHandle> OverlayTree::FindParent(ref_ptr<OverlayHandle> handle, in
 {
   ASSERT_GREATER_OR_EQUAL(searchingRank, 0, ());
   ASSERT_LESS(searchingRank, static_cast<int>(m_handles.size()), ());
-  for (auto const & h : m_handles[searchingRank])
+  auto const & handles = m_rankHandlesById[searchingRank];
+  auto const it = handles.find(handle->GetOverlayID());
+  if (it == handles.cend())
+    return nullptr;
+
+  for (auto const & h : it->second)
   {
-    if (h->GetOverlayID() == handle->GetOverlayID() && m_handlesCache.find(h) != m_handlesCache.end())
+    if (m_handlesCache.find(h) != m_handlesCache.end())
       return h;
   }
   return nullptr;
@@ -397,8 +416,18 @@ ref_ptr<OverlayHandle> OverlayTree::FindParent(ref_ptr<OverlayHandle> handle, in
 void OverlayTree::DeleteHandle(ref_ptr<OverlayHandle> const & handle)
 {
   size_t const deletedCount = m_handlesCache.erase(handle);
-  if (deletedCount != 0)
-    Erase(handle);
+  if (deletedCount == 0)
+    return;
+
+  Erase(handle);
+  auto const it = m_placedHandlesById.find(handle->GetOverlayID());
+  if (it == m_placedHandlesById.end())
+    return;
+
+  auto & handles = it->second;
+  handles.erase(std::remove(handles.begin(), handles.end(), handle), handles.end());
+  if (handles.empty())
+    m_placedHandlesById.erase(it);
 }
 
 void OverlayTree::DeleteHandleWithParents(ref_ptr<OverlayHandle> handle, int currentRank)
@@ -9,6 +9,7 @@
 #include "base/buffer_vector.hpp"
 
 #include <array>
+#include <map>
 #include <memory>
 #include <unordered_set>
 #include <vector>
@@ -105,6 +106,7 @@ private:
                     ref_ptr<OverlayHandle> const & parentOverlay);
   bool CheckHandle(ref_ptr<OverlayHandle> handle, int currentRank,
                    ref_ptr<OverlayHandle> & parentOverlay) const;
+  void AddPlacedHandle(ref_ptr<OverlayHandle> handle, m2::RectD const & pixelRect);
   void DeleteHandle(ref_ptr<OverlayHandle> const & handle);
 
   ref_ptr<OverlayHandle> FindParent(ref_ptr<OverlayHandle> handle, int searchingRank) const;
@@ -116,6 +118,15 @@ private:
   std::array<std::vector<ref_ptr<OverlayHandle>>, dp::OverlayRanksCount> m_handles;
   HandlesCache m_handlesCache;
 
+  // Handles are indexed by their ids to find parents and bound handles without scanning
+  // all the handles. Every handle displaced by a bound one used to cost a pass over
+  // the placed handles.
+  using HandlesById = std::map<OverlayID, buffer_vector<ref_ptr<OverlayHandle>, 2>>;
+  // Handles of the ranks which have been sorted by priority, in priority order.
+  std::array<HandlesById, dp::OverlayRanksCount> m_rankHandlesById;
+  // Handles of |m_handlesCache|.
+  HandlesById m_placedHandlesById;
+
   bool m_isDisplacementEnabled;
 
   FeatureID m_selectedFeatureID;
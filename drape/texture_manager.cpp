@@ -400,19 +400,35 @@ size_t TextureManager::FindHybridGlyphsGroup(strings::UniString const & text, in
       return 0;
   }
 
-  // Looking for a hybrid texture which contains text entirely.
-  for (size_t i = 0; i < m_hybridGlyphGroups.size() - 1; i++)
+  // Looking for a hybrid texture which contains text entirely. Otherwise the text goes to
+  // the texture which already has the most of its glyphs and still has enough space for the rest.
+  // Earlier textures are filled up as well as the last one, so the glyphs are not duplicated and
+  // the glyph textures do not multiply while their free space is left unused.
+  size_t bestGroup = GetInvalidGlyphGroup();
+  uint32_t bestUnfoundChars = std::numeric_limits<uint32_t>::max();
+  for (size_t i = 0; i < m_hybridGlyphGroups.size(); i++)
   {
-    if (GetNumberOfUnfoundCharacters(text, fixedHeight, m_hybridGlyphGroups[i]) == 0)
+    auto const & g = m_hybridGlyphGroups[i];
+    uint32_t const unfoundChars = GetNumberOfUnfoundCharacters(text, fixedHeight, g);
+    if (unfoundChars == 0)
       return i;
+
+    if (unfoundChars >= bestUnfoundChars)
+      continue;
+
+    uint32_t const newCharsCount = static_cast<uint32_t>(g.m_glyphs.size()) + unfoundChars;
+    if (newCharsCount < m_maxGlypsCount &&
+        (g.m_texture == nullptr || g.m_texture->HasEnoughSpace(unfoundChars)))
+    {
+      bestGroup = i;
+      bestUnfoundChars = unfoundChars;
+    }
   }
 
-  // Check if we can contain text in the last hybrid texture.
-  uint32_t const unfoundChars = GetNumberOfUnfoundCharacters(text, fixedHeight, group);
-  uint32_t const newCharsCount = static_cast<uint32_t>(group.m_glyphs.size()) + unfoundChars;
-  if (newCharsCount >= m_maxGlypsCount || !group.m_texture->HasEnoughSpace(unfoundChars))
-    m_hybridGlyphGroups.push_back(HybridGlyphGroup());
+  if (bestGroup != GetInvalidGlyphGroup())
+    return bestGroup;
 
+  m_hybridGlyphGroups.push_back(HybridGlyphGroup());
   return m_hybridGlyphGroups.size() - 1;
 }
 
@@ -251,6 +251,7 @@ bool VulkanBaseContext::BeginRendering()
                                      &commandBufferBeginInfo));
   CHECK_VK_CALL(vkBeginCommandBuffer(m_renderingCommandBuffers[m_inflightFrameIndex],
                                      &commandBufferBeginInfo));
+  m_boundPipeline = VK_NULL_HANDLE;
 
   return true;
 }
@@ -471,6 +472,7 @@ void VulkanBaseContext::ApplyFramebuffer(std::string const & framebufferLabel)
   renderPassBeginInfo.framebuffer = fbData.m_framebuffers[m_currentFramebuffer == nullptr ? m_imageIndex : 0];
 
   m_isActiveRenderPass = true;
+  m_boundPipeline = VK_NULL_HANDLE;
   vkCmdBeginRenderPass(m_renderingCommandBuffers[m_inflightFrameIndex], &renderPassBeginInfo,
                        VK_SUBPASS_CONTENTS_INLINE);
 }
@@ -534,6 +536,7 @@ void VulkanBaseContext::ResetPipelineCache()
 {
   if (m_pipeline)
     m_pipeline->ResetCache(m_device);
+  ForgetLastPipeline();
 }
 
 void VulkanBaseContext::SetClearColor(Color const & color)
@@ -729,7 +732,32 @@ void VulkanBaseContext::ClearParamDescriptors()
 
 VkPipeline VulkanBaseContext::GetCurrentPipeline()
 {
-  return m_pipeline->GetPipeline(m_device, m_pipelineKey);
+  bool const isSameKey = !(m_pipelineKey < m_lastPipelineKey) &&
+                         !(m_lastPipelineKey < m_pipelineKey);
+  if (m_lastPipeline == VK_NULL_HANDLE || !isSameKey)
+  {
+    m_lastPipeline = m_pipeline->GetPipeline(m_device, m_pipelineKey);
+    m_lastPipelineKey = m_pipelineKey;
+  }
+  return m_lastPipeline;
+}
+
+void VulkanBaseContext::BindCurrentPipeline()
+{
+  VkPipeline const pipeline = GetCurrentPipeline();
+  if (pipeline == m_boundPipeline)
+    return;
+
+  m_boundPipeline = pipeline;
+  vkCmdBindPipeline(m_renderingCommandBuffers[m_inflightFrameIndex],
+                    VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+}
+
+void VulkanBaseContext::ForgetLastPipeline()
+{
+  // Handles of the destroyed pipelines and render passes can be reused by the driver.
+  m_lastPipeline = VK_NULL_HANDLE;
+  m_boundPipeline = VK_NULL_HANDLE;
 }
 
 std::vector<ParamDescriptor> const & VulkanBaseContext::GetCurrentParamDescriptors() const
@@ -874,7 +902,10 @@ void VulkanBaseContext::DestroyRenderPassAndFramebuffer(ref_ptr<BaseFramebuffer>
 {
   auto const & fbData = m_framebuffersData[framebuffer];
   if (m_pipeline && fbData.m_renderPass != VK_NULL_HANDLE)
+  {
     m_pipeline->ResetCache(m_device, fbData.m_renderPass);
+    ForgetLastPipeline();
+  }
 
   for (auto & fb : fbData.m_framebuffers)
     vkDestroyFramebuffer(m_device, fb, nullptr);
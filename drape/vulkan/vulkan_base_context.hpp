@@ -99,6 +99,8 @@ public:
   uint32_t GetCurrentInflightFrameIndex() const { return m_inflightFrameIndex; }
 
   VkPipeline GetCurrentPipeline();
+  // Binds the current pipeline to the rendering command buffer if it's not bound yet.
+  void BindCurrentPipeline();
   VkPipelineLayout GetCurrentPipelineLayout() const;
   uint32_t GetCurrentDynamicBufferOffset() const;
   std::vector<ParamDescriptor> const & GetCurrentParamDescriptors() const;
@@ -150,6 +152,7 @@ protected:
 
   void DestroyRenderPassAndFramebuffers();
   void DestroyRenderPassAndFramebuffer(ref_ptr<BaseFramebuffer> framebuffer);
+  void ForgetLastPipeline();
 
   void RecreateDepthTexture();
 
@@ -218,6 +221,12 @@ protected:
   VulkanPipeline::PipelineKey m_pipelineKey;
   std::vector<ParamDescriptor> m_paramDescriptors;
 
+  // Consecutive draw calls usually use the same pipeline, so the last used pipeline is kept
+  // to skip lookups in the pipeline cache and redundant bindings.
+  VulkanPipeline::PipelineKey m_lastPipelineKey;
+  VkPipeline m_lastPipeline = VK_NULL_HANDLE;
+  VkPipeline m_boundPipeline = VK_NULL_HANDLE;
+
   std::array<drape_ptr<VulkanStagingBuffer>, kMaxInflightFrames> m_defaultStagingBuffers = {};
   std::atomic<bool> m_presentAvailable;
   uint32_t m_frameCounter = 0;
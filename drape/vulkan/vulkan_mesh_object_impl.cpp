@@ -158,8 +158,7 @@ public:
                             vulkanContext->GetCurrentPipelineLayout(), 0, 1,
                             &descriptorSet, 1, &dynamicOffset);
 
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                      vulkanContext->GetCurrentPipeline());
+    vulkanContext->BindCurrentPipeline();
 
     VkDeviceSize offsets[1] = {0};
     for (uint32_t i = 0; i < static_cast<uint32_t>(m_geometryBuffers.size()); ++i)
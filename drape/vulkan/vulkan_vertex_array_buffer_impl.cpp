@@ -71,8 +71,7 @@ public:
                             vulkanContext->GetCurrentPipelineLayout(), 0, 1,
                             &descriptorSet, 1, &dynamicOffset);
 
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                      vulkanContext->GetCurrentPipeline());
+    vulkanContext->BindCurrentPipeline();
 
     size_t constexpr kMaxBuffersCount = 4;
     std::array<VkBuffer, kMaxBuffersCount> buffers = {};
@@ -20,6 +20,8 @@
 #include "indexer/road_shields_parser.hpp"
 
 #include "geometry/clipping.hpp"
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/simplification.hpp"
 #include "geometry/smoothing.hpp"
 
 #include "drape/color.hpp"
@@ -64,6 +66,8 @@ df::ColorConstant const kRoadShieldOrangeBackgroundColor = "RoadShieldOrangeBack
 
 int const kLineSimplifyLevelStart = 10;
 int const kLineSimplifyLevelEnd = 12;
+// Max deviation of the simplified lines from the original ones, in pixels.
+double const kLineSimplifyTolerance = 0.5;
 
 uint32_t const kPathTextBaseTextIndex = 128;
 uint32_t const kShieldBaseTextIndex = 0;
@@ -414,6 +418,24 @@ void CalculateRoadShieldPositions(std::vector<double> const & offsets,
     }
   }
 }
+
+// Drops the vertices which deviate from the line less than |tolerance|.
+m2::SharedSpline SimplifySpline(m2::SharedSpline const & spline, double tolerance)
+{
+  auto const & path = spline->GetPath();
+  if (path.size() <= 2)
+    return spline;
+
+  std::vector<m2::PointD> simplifiedPath;
+  simplifiedPath.reserve(path.size());
+  SimplifyDP(path.cbegin(), path.cend(), tolerance * tolerance,
+             m2::SquaredDistanceFromSegmentToPoint<m2::PointD>(),
+             base::MakeBackInsertFunctor(simplifiedPath));
+  if (simplifiedPath.size() == path.size())
+    return spline;
+
+  return m2::SharedSpline(std::move(simplifiedPath));
+}
 }  // namespace
 
 BaseApplyFeature::BaseApplyFeature(TileKey const & tileKey, TInsertShapeFn const & insertShape,
@@ -929,6 +951,14 @@ void ApplyLineFeatureGeometry::ProcessLineRule(Stylist::TRuleWrapper const & rul
 
   if (!m_smooth)
   {
+    // The same geometry is used for all line rules of the feature.
+    if (!m_isSplineSimplified)
+    {
+      double const tolerance =
+          kLineSimplifyTolerance * df::VisualParams::Instance().GetVisualScale();
+      m_spline = SimplifySpline(m_spline, tolerance / m_currentScaleGtoP);
+      m_isSplineSimplified = true;
+    }
     m_clippedSplines = m2::ClipSplineByRect(m_tileRect, m_spline);
   }
   else
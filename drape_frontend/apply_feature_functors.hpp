@@ -191,6 +191,7 @@ private:
   m2::PointD m_lastAddedPoint;
   bool m_simplify;
   bool m_smooth;
+  bool m_isSplineSimplified = false;
   size_t m_initialPointsCount;
 
 #ifdef LINES_GENERATION_CALC_FILTERED_POINTS
@@ -21,7 +21,9 @@
 
 #include "platform/platform.hpp"
 
+#include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
+#include "base/profiler.hpp"
 
 #include <algorithm>
 #include <utility>
@@ -235,7 +237,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(GENERATING_STATISTIC)
         DrapeMeasurer::Instance().StartShapesGeneration();
 #endif
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
+        for (auto const & shape : msg->GetShapes())
         {
           batcher->SetFeatureMinZoom(shape->GetFeatureMinZoom());
           shape->Draw(m_context, batcher, m_texMng);
@@ -260,7 +262,7 @@ void BackendRenderer::AcceptMessage(ref_ptr<Message> message)
         DrapeMeasurer::Instance().StartOverlayShapesGeneration();
 #endif
         OverlayBatcher batcher(tileKey);
-        for (drape_ptr<MapShape> const & shape : msg->GetShapes())
+        for (auto const & shape : msg->GetShapes())
           batcher.Batch(m_context, shape, m_texMng);
 
         TOverlaysRenderData renderData;
@@ -711,6 +713,7 @@ BackendRenderer::Routine::Routine(BackendRenderer & renderer) : m_renderer(rende
 void BackendRenderer::Routine::Do()
 {
   LOG(LINFO, ("Start routine."));
+  base::profiler::SetThreadName("BackendRenderer");
   m_renderer.CreateContext();
   while (!IsCancelled())
     m_renderer.IterateRenderLoop();
@@ -750,6 +753,8 @@ void BackendRenderer::InitContextDependentResources()
   params.m_glyphMngParams.m_blacklist = "fonts_blacklist.txt";
   params.m_glyphMngParams.m_sdfScale = VisualParams::Instance().GetGlyphSdfScale();
   params.m_glyphMngParams.m_baseGlyphHeight = VisualParams::Instance().GetGlyphBaseSize();
+  params.m_glyphMngParams.m_glyphsCacheFile = base::JoinPath(GetPlatform().TmpDir(),
+                                                             "glyphs_cache.bin");
   GetPlatform().GetFontNames(params.m_glyphMngParams.m_fonts);
 
   CHECK(m_context != nullptr, ());
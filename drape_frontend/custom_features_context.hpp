@@ -1,10 +1,12 @@
 #pragma once
 
 #include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
 
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace df
 {
@@ -16,15 +18,39 @@ struct CustomFeaturesContext
 
   explicit CustomFeaturesContext(CustomFeatures && features)
     : m_features(std::move(features))
-  {}
+  {
+    // Features are ordered by mwms, so the bits of every mwm are filled in one pass.
+    std::vector<bool> * bits = nullptr;
+    MwmSet::MwmId const * mwmId = nullptr;
+    for (auto const & f : m_features)
+    {
+      if (!f.second)
+        continue;
+      if (mwmId == nullptr || *mwmId != f.first.m_mwmId)
+      {
+        mwmId = &f.first.m_mwmId;
+        bits = &m_discardGeometry[*mwmId];
+      }
+      if (bits->size() <= f.first.m_index)
+        bits->resize(f.first.m_index + 1, false);
+      (*bits)[f.first.m_index] = true;
+    }
+  }
 
+  // It is called for every feature of every read tile, so it probes the bits of the feature
+  // mwm instead of looking the feature up in |m_features|.
   bool NeedDiscardGeometry(FeatureID const & id) const
   {
-    auto const it = m_features.find(id);
-    if (it == m_features.cend())
+    auto const it = m_discardGeometry.find(id.m_mwmId);
+    if (it == m_discardGeometry.cend())
       return false;
-    return it->second;
+    auto const & bits = it->second;
+    return id.m_index < bits.size() && bits[id.m_index];
   }
+
+private:
+  // Features with discarded geometry by mwms, indexed by feature indices.
+  std::map<MwmSet::MwmId, std::vector<bool>> m_discardGeometry;
 };
 
 using CustomFeaturesContextPtr = std::shared_ptr<CustomFeaturesContext>;
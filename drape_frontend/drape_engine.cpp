@@ -775,7 +775,7 @@ void DrapeEngine::UpdateTraffic(traffic::TrafficInfo const & info)
 #endif
 
   df::TrafficSegmentsColoring segmentsColoring;
-  segmentsColoring.emplace(info.GetMwmId(), info.GetColoring());
+  segmentsColoring.emplace(info.GetMwmId(), info.GetSharedColoring());
 
   m_threadCommutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                                   make_unique_dp<UpdateTrafficMessage>(std::move(segmentsColoring)),
@@ -0,0 +1,78 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/message.hpp"
+#include "drape_frontend/message_queue.hpp"
+
+#include "drape/pointers.hpp"
+
+#include <vector>
+
+using namespace df;
+
+namespace
+{
+class TestMessage : public Message
+{
+public:
+  TestMessage(int id, Type type) : m_id(id), m_type(type) {}
+
+  Type GetType() const override { return m_type; }
+  int GetId() const { return m_id; }
+
+private:
+  int const m_id;
+  Type const m_type;
+};
+
+void Push(MessageQueue & queue, int id, MessagePriority priority,
+          Message::Type type = Message::Type::Unknown)
+{
+  queue.PushMessage(make_unique_dp<TestMessage>(id, type), priority);
+}
+
+std::vector<int> PopAll(MessageQueue & queue)
+{
+  std::vector<int> ids;
+  while (auto message = queue.PopMessage(false /* waitForMessage */))
+    ids.push_back(static_cast<ref_ptr<TestMessage>>(make_ref(message))->GetId());
+  return ids;
+}
+}  // namespace
+
+UNIT_TEST(MessageQueue_Priorities)
+{
+  MessageQueue queue;
+  Push(queue, 1, MessagePriority::Low);
+  Push(queue, 2, MessagePriority::Normal);
+  Push(queue, 3, MessagePriority::High);
+  Push(queue, 4, MessagePriority::Normal);
+  Push(queue, 5, MessagePriority::UberHighSingleton, Message::Type::FlushTile);
+  Push(queue, 6, MessagePriority::High);
+  Push(queue, 7, MessagePriority::Low);
+  // The singleton of the same type is not added twice.
+  Push(queue, 8, MessagePriority::UberHighSingleton, Message::Type::FlushTile);
+  Push(queue, 9, MessagePriority::UberHighSingleton, Message::Type::FlushOverlays);
+
+  TEST_EQUAL(PopAll(queue), std::vector<int>({9, 5, 6, 3, 2, 4, 1, 7}), ());
+  TEST(queue.PopMessage(false /* waitForMessage */) == nullptr, ());
+}
+
+UNIT_TEST(MessageQueue_Filtering)
+{
+  MessageQueue queue;
+  Push(queue, 1, MessagePriority::Normal, Message::Type::FlushTile);
+  Push(queue, 2, MessagePriority::High, Message::Type::FlushOverlays);
+  Push(queue, 3, MessagePriority::Low, Message::Type::FlushTile);
+  Push(queue, 4, MessagePriority::UberHighSingleton, Message::Type::FlushTile);
+
+  queue.EnableMessageFiltering([](ref_ptr<Message> message)
+  {
+    return message->GetType() == Message::Type::FlushTile;
+  });
+  Push(queue, 5, MessagePriority::Normal, Message::Type::FlushTile);
+  Push(queue, 6, MessagePriority::Normal, Message::Type::FlushOverlays);
+  queue.DisableMessageFiltering();
+  Push(queue, 7, MessagePriority::Normal, Message::Type::FlushTile);
+
+  TEST_EQUAL(PopAll(queue), std::vector<int>({2, 6, 7}), ());
+}
@@ -0,0 +1,86 @@
+#include "testing/testing.hpp"
+
+#include "drape_frontend/tile_geometry_cache.hpp"
+
+#include <memory>
+
+using namespace df;
+
+namespace
+{
+TileGeometryCache::TileGeometryPtr MakeGeometry()
+{
+  return std::make_shared<TileGeometryCache::TileGeometry>();
+}
+}  // namespace
+
+UNIT_TEST(TileGeometryCache_FindIgnoresGenerations)
+{
+  TileGeometryCache cache(2 /* maxTilesCount */);
+  TEST(cache.IsEnabled(), ());
+
+  TileKey const key(1, 2, 10);
+  auto geometry = MakeGeometry();
+  auto const * ptr = geometry.get();
+  cache.Put(TileKey(key, 5 /* generation */, 7 /* userMarksGeneration */), cache.GetGeneration(),
+            std::move(geometry));
+
+  TEST_EQUAL(cache.Find(TileKey(key, 8 /* generation */, 0 /* userMarksGeneration */)).get(), ptr,
+             ());
+  TEST(cache.Find(TileKey(2, 1, 10)) == nullptr, ());
+  TEST(cache.Find(TileKey(1, 2, 11)) == nullptr, ());
+}
+
+UNIT_TEST(TileGeometryCache_Lru)
+{
+  TileGeometryCache cache(2 /* maxTilesCount */);
+  TileKey const key1(0, 0, 10);
+  TileKey const key2(0, 1, 10);
+  TileKey const key3(0, 2, 10);
+
+  cache.Put(key1, cache.GetGeneration(), MakeGeometry());
+  cache.Put(key2, cache.GetGeneration(), MakeGeometry());
+  // |key1| becomes the most recently used one.
+  TEST(cache.Find(key1) != nullptr, ());
+
+  cache.Put(key3, cache.GetGeneration(), MakeGeometry());
+  TEST_EQUAL(cache.GetTilesCount(), 2, ());
+  TEST(cache.Find(key1) != nullptr, ());
+  TEST(cache.Find(key2) == nullptr, ());
+  TEST(cache.Find(key3) != nullptr, ());
+}
+
+UNIT_TEST(TileGeometryCache_Invalidate)
+{
+  TileGeometryCache cache(8 /* maxTilesCount */);
+  TileKey const key(4, 4, 10);
+  TileKey const parentKey(2, 2, 9);
+  TileKey const farKey(100, 100, 10);
+
+  cache.Put(key, cache.GetGeneration(), MakeGeometry());
+  cache.Put(parentKey, cache.GetGeneration(), MakeGeometry());
+  cache.Put(farKey, cache.GetGeneration(), MakeGeometry());
+
+  // Geometry which reading has been started before invalidation is outdated.
+  uint64_t const generation = cache.GetGeneration();
+  cache.Invalidate({key});
+  cache.Put(TileKey(0, 0, 10), generation, MakeGeometry());
+
+  TEST(cache.Find(key) == nullptr, ());
+  TEST(cache.Find(parentKey) == nullptr, ());
+  TEST(cache.Find(farKey) != nullptr, ());
+  TEST(cache.Find(TileKey(0, 0, 10)) == nullptr, ());
+
+  cache.InvalidateAll();
+  TEST_EQUAL(cache.GetTilesCount(), 0, ());
+}
+
+UNIT_TEST(TileGeometryCache_Disabled)
+{
+  TileGeometryCache cache(0 /* maxTilesCount */);
+  TEST(!cache.IsEnabled(), ());
+
+  TileKey const key(0, 0, 10);
+  cache.Put(key, cache.GetGeneration(), MakeGeometry());
+  TEST(cache.Find(key) == nullptr, ());
+}
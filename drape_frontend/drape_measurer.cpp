@@ -6,6 +6,7 @@
 
 #include "3party/Alohalytics/src/alohalytics.h"
 
+#include <algorithm>
 #include <iomanip>
 
 namespace df
@@ -73,6 +74,9 @@ void DrapeMeasurer::Start()
     m_realtimeTotalFrameRenderTime = steady_clock::duration::zero();
     m_realtimeSlowFramesCount = 0;
     m_realtimeRenderingBox = {};
+
+    std::lock_guard<std::mutex> lock(m_tileReadLatencyMutex);
+    m_frameStatistic = {};
   }
 
 #ifdef TRACK_GPU_MEM
@@ -100,22 +104,44 @@ void DrapeMeasurer::Stop(bool forceProcessRealtimeStats /* = false */ )
                        m_realtimeTotalFramesCount;
 
     auto const latLonRect = mercator::ToLatLonRect(m_realtimeRenderingBox);
-    alohalytics::Stats::Instance().LogEvent(
-        "RenderingStats", {{"version", GetPlatform().GetAppUserAgent().GetAppVersion()},
-                           {"device", GetPlatform().DeviceModel()},
-                           {"gpu", m_gpuName},
-                           {"api", DebugPrint(m_apiVersion)},
-                           {"width", strings::to_string(m_resolution.x)},
-                           {"height", strings::to_string(m_resolution.y)},
-                           {"minFrameTime", strings::to_string(minMs)},
-                           {"maxFrameTime", strings::to_string(maxMs)},
-                           {"avgFrameTime", strings::to_string(avgMs)},
-                           {"slowFrames", strings::to_string(m_realtimeSlowFramesCount)},
-                           {"frames", strings::to_string(m_realtimeTotalFramesCount)},
-                           {"viewportMinLat", strings::to_string(latLonRect.minX())},
-                           {"viewportMinLon", strings::to_string(latLonRect.minY())},
-                           {"viewportMaxLat", strings::to_string(latLonRect.maxX())},
-                           {"viewportMaxLon", strings::to_string(latLonRect.maxY())}});
+    alohalytics::TStringMap params = {
+        {"version", GetPlatform().GetAppUserAgent().GetAppVersion()},
+        {"device", GetPlatform().DeviceModel()},
+        {"gpu", m_gpuName},
+        {"api", DebugPrint(m_apiVersion)},
+        {"width", strings::to_string(m_resolution.x)},
+        {"height", strings::to_string(m_resolution.y)},
+        {"minFrameTime", strings::to_string(minMs)},
+        {"maxFrameTime", strings::to_string(maxMs)},
+        {"avgFrameTime", strings::to_string(avgMs)},
+        {"slowFrames", strings::to_string(m_realtimeSlowFramesCount)},
+        {"frames", strings::to_string(m_realtimeTotalFramesCount)},
+        {"viewportMinLat", strings::to_string(latLonRect.minX())},
+        {"viewportMinLon", strings::to_string(latLonRect.minY())},
+        {"viewportMaxLat", strings::to_string(latLonRect.maxX())},
+        {"viewportMaxLon", strings::to_string(latLonRect.maxY())}};
+
+    // Average time of the render phases per frame and tile read latency histogram.
+    auto const frameStatistic = GetFrameStatistic();
+    if (frameStatistic.m_framesCount > 0)
+    {
+      for (size_t i = 0; i < FrameStatistic::kPhasesCount; ++i)
+      {
+        auto const & phase = frameStatistic.m_phases[i];
+        params.emplace("avgTimeUs" + DebugPrint(static_cast<RenderPhase>(i)),
+                       strings::to_string(phase.m_totalTimeInUs / frameStatistic.m_framesCount));
+      }
+    }
+    auto const & histogram = frameStatistic.m_tileReadLatencyHistogram;
+    for (size_t i = 0; i < histogram.size(); ++i)
+    {
+      auto const bound = i < FrameStatistic::kTileReadLatencyBoundsInMs.size()
+                             ? strings::to_string(FrameStatistic::kTileReadLatencyBoundsInMs[i])
+                             : std::string("Inf");
+      params.emplace("tileReadsUpTo" + bound + "Ms", strings::to_string(histogram[i]));
+    }
+
+    alohalytics::Stats::Instance().LogEvent("RenderingStats", params);
     m_realtimeTotalFramesCount = 0;
   }
 #endif
@@ -268,6 +294,95 @@ DrapeMeasurer::RenderStatistic DrapeMeasurer::GetRenderStatistic()
 }
 #endif
 
+void DrapeMeasurer::BeginRenderPhase(RenderPhase phase)
+{
+  if (!m_isEnabled)
+    return;
+
+  ASSERT(m_currentRenderPhase == RenderPhase::Count, ("Nested render phases:", phase,
+                                                      m_currentRenderPhase));
+  m_currentRenderPhase = phase;
+  m_startRenderPhaseTime = std::chrono::steady_clock::now();
+}
+
+void DrapeMeasurer::EndRenderPhase(RenderPhase phase)
+{
+  using namespace std::chrono;
+
+  if (!m_isEnabled || m_currentRenderPhase != phase)
+    return;
+
+  m_currentRenderPhase = RenderPhase::Count;
+  auto const phaseTimeUs = static_cast<uint64_t>(
+      duration_cast<microseconds>(steady_clock::now() - m_startRenderPhaseTime).count());
+
+  auto & statistic = m_frameStatistic.m_phases[static_cast<size_t>(phase)];
+  statistic.m_totalTimeInUs += phaseTimeUs;
+  statistic.m_maxTimeInUs = std::max(statistic.m_maxTimeInUs, phaseTimeUs);
+}
+
+void DrapeMeasurer::OnRenderGroup()
+{
+  if (!m_isEnabled || m_currentRenderPhase == RenderPhase::Count)
+    return;
+
+  ++m_frameStatistic.m_phases[static_cast<size_t>(m_currentRenderPhase)].m_renderGroupsCount;
+}
+
+void DrapeMeasurer::AddTileReadLatency(std::chrono::nanoseconds latency)
+{
+  if (!m_isEnabled)
+    return;
+
+  auto const latencyMs =
+      static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(latency).count());
+  auto const & bounds = FrameStatistic::kTileReadLatencyBoundsInMs;
+  auto const bucket = static_cast<size_t>(
+      std::upper_bound(bounds.cbegin(), bounds.cend(), latencyMs) - bounds.cbegin());
+
+  std::lock_guard<std::mutex> lock(m_tileReadLatencyMutex);
+  ++m_frameStatistic.m_tileReadLatencyHistogram[bucket];
+}
+
+DrapeMeasurer::FrameStatistic DrapeMeasurer::GetFrameStatistic()
+{
+  std::lock_guard<std::mutex> lock(m_tileReadLatencyMutex);
+  return m_frameStatistic;
+}
+
+std::string DrapeMeasurer::FrameStatistic::ToString() const
+{
+  std::ostringstream ss;
+  ss << " ----- Frame statistic report ----- \n";
+  ss << " Frames count = " << m_framesCount << "\n";
+  if (m_framesCount > 0)
+  {
+    for (size_t i = 0; i < kPhasesCount; ++i)
+    {
+      auto const & phase = m_phases[i];
+      ss << " " << DebugPrint(static_cast<RenderPhase>(i))
+         << ": avg time, us = " << phase.m_totalTimeInUs / m_framesCount
+         << ", max time, us = " << phase.m_maxTimeInUs
+         << ", avg render groups = " << phase.m_renderGroupsCount / m_framesCount << "\n";
+    }
+  }
+  ss << " Tile read latency distribution:\n";
+  uint32_t lowerBound = 0;
+  for (size_t i = 0; i < m_tileReadLatencyHistogram.size(); ++i)
+  {
+    ss << "   " << lowerBound << "-";
+    if (i < kTileReadLatencyBoundsInMs.size())
+    {
+      lowerBound = kTileReadLatencyBoundsInMs[i];
+      ss << lowerBound;
+    }
+    ss << " ms: " << m_tileReadLatencyHistogram[i] << "\n";
+  }
+  ss << " ----- Frame statistic report ----- \n";
+
+  return ss.str();
+}
+
 void DrapeMeasurer::BeforeRenderFrame()
 {
   if (!m_isEnabled)
@@ -284,6 +399,7 @@ void DrapeMeasurer::AfterRenderFrame(bool isActiveFrame, m2::PointD const & view
     return;
 
   auto const frameTime = steady_clock::now() - m_startFrameRenderTime;
+  ++m_frameStatistic.m_framesCount;
   if (isActiveFrame)
   {
     if (mercator::Bounds::FullRect().IsPointInside(viewportCenter))
@@ -520,6 +636,7 @@ std::string DrapeMeasurer::DrapeStatistic::ToString() const
 {
   std::ostringstream ss;
   ss << "\n ===== Drape statistic report ===== \n";
+  ss << "\n" << m_frameStatistic.ToString() << "\n";
 #ifdef RENDER_STATISTIC
   ss << "\n" << m_renderStatistic.ToString() << "\n";
 #endif
@@ -543,6 +660,7 @@ std::string DrapeMeasurer::DrapeStatistic::ToString() const
 DrapeMeasurer::DrapeStatistic DrapeMeasurer::GetDrapeStatistic()
 {
   DrapeStatistic statistic;
+  statistic.m_frameStatistic = GetFrameStatistic();
 #ifdef RENDER_STATISTIC
   statistic.m_renderStatistic = GetRenderStatistic();
 #endif
@@ -560,4 +678,22 @@ DrapeMeasurer::DrapeStatistic DrapeMeasurer::GetDrapeStatistic()
 #endif
   return statistic;
 }
+
+std::string DebugPrint(DrapeMeasurer::RenderPhase phase)
+{
+  switch (phase)
+  {
+  case DrapeMeasurer::RenderPhase::Geometry2d: return "Geometry2d";
+  case DrapeMeasurer::RenderPhase::Geometry3d: return "Geometry3d";
+  case DrapeMeasurer::RenderPhase::Traffic: return "Traffic";
+  case DrapeMeasurer::RenderPhase::Route: return "Route";
+  case DrapeMeasurer::RenderPhase::Overlays: return "Overlays";
+  case DrapeMeasurer::RenderPhase::UserMarks: return "UserMarks";
+  case DrapeMeasurer::RenderPhase::TransitScheme: return "TransitScheme";
+  case DrapeMeasurer::RenderPhase::Postprocess: return "Postprocess";
+  case DrapeMeasurer::RenderPhase::Gui: return "Gui";
+  case DrapeMeasurer::RenderPhase::Count: return "Count";
+  }
+  UNREACHABLE();
+}
 }  // namespace df
@@ -9,7 +9,9 @@
 #include "base/thread.hpp"
 #include "base/timer.hpp"
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -32,6 +34,10 @@ public:
   void SetApiVersion(dp::ApiVersion apiVersion);
   void SetResolution(m2::PointU const & resolution);
 
+  std::string const & GetGpuName() const { return m_gpuName; }
+  dp::ApiVersion GetApiVersion() const { return m_apiVersion; }
+  m2::PointU const & GetResolution() const { return m_resolution; }
+
 #ifdef RENDER_STATISTIC
   struct RenderStatistic
   {
@@ -101,6 +107,53 @@ public:
   GPUMemoryStatistic GetGPUMemoryStatistic();
 #endif
 
+  // Phases of the frame rendering, they are measured in all builds.
+  enum class RenderPhase : uint8_t
+  {
+    Geometry2d = 0,
+    Geometry3d,
+    Traffic,
+    Route,
+    Overlays,
+    UserMarks,
+    TransitScheme,
+    Postprocess,
+    Gui,
+
+    Count
+  };
+
+  struct RenderPhaseStatistic
+  {
+    uint64_t m_totalTimeInUs = 0;
+    uint64_t m_maxTimeInUs = 0;
+    uint64_t m_renderGroupsCount = 0;
+  };
+
+  struct FrameStatistic
+  {
+    std::string ToString() const;
+
+    static size_t constexpr kPhasesCount = static_cast<size_t>(RenderPhase::Count);
+    // Upper bounds of the tile read latency buckets, the last bucket is unbounded.
+    static std::array<uint32_t, 6> constexpr kTileReadLatencyBoundsInMs = {{10, 20, 50, 100, 200,
+                                                                           500}};
+
+    uint64_t m_framesCount = 0;
+    std::array<RenderPhaseStatistic, kPhasesCount> m_phases;
+    std::array<uint64_t, kTileReadLatencyBoundsInMs.size() + 1> m_tileReadLatencyHistogram = {};
+  };
+
+  // Phases must not be nested.
+  void BeginRenderPhase(RenderPhase phase);
+  void EndRenderPhase(RenderPhase phase);
+  void OnRenderGroup();
+
+  // Can be called from any thread.
+  void AddTileReadLatency(std::chrono::nanoseconds latency);
+
+  FrameStatistic GetFrameStatistic();
+
   void BeforeRenderFrame();
   void AfterRenderFrame(bool isActiveFrame, m2::PointD const & viewportCenter);
 
@@ -113,6 +166,7 @@ public:
   {
     std::string ToString() const;
 
+    FrameStatistic m_frameStatistic;
 #ifdef RENDER_STATISTIC
     RenderStatistic m_renderStatistic;
 #endif
@@ -166,6 +220,12 @@ private:
 
   std::chrono::time_point<std::chrono::steady_clock> m_startFrameRenderTime;
 
+  std::chrono::time_point<std::chrono::steady_clock> m_startRenderPhaseTime;
+  RenderPhase m_currentRenderPhase = RenderPhase::Count;
+  // The histogram is filled on the reading threads, the other data on the render thread.
+  FrameStatistic m_frameStatistic;
+  std::mutex m_tileReadLatencyMutex;
+
   std::chrono::nanoseconds m_realtimeMinFrameRenderTime;
   std::chrono::nanoseconds m_realtimeMaxFrameRenderTime;
   std::chrono::nanoseconds m_realtimeTotalFrameRenderTime;
@@ -199,4 +259,6 @@ private:
   uint32_t m_numberOfSnapshots = 0;
 #endif
 };
+
+std::string DebugPrint(DrapeMeasurer::RenderPhase phase);
 }  // namespace df
@@ -48,16 +48,39 @@ void EngineContext::BeginReadTile()
 
 void EngineContext::Flush(TMapShapes && shapes)
 {
+  // Recording is started and finished when no shapes are flushed.
+  if (m_recordedGeometry != nullptr)
+  {
+    std::lock_guard<std::mutex> lock(m_recordingMutex);
+    auto & recordedShapes = m_recordedGeometry->m_shapes;
+    recordedShapes.insert(recordedShapes.end(), shapes.cbegin(), shapes.cend());
+  }
   PostMessage(make_unique_dp<MapShapeReadedMessage>(m_tileKey, std::move(shapes)));
 }
 
 void EngineContext::FlushOverlays(TMapShapes && shapes)
 {
+  if (m_recordedGeometry != nullptr)
+  {
+    std::lock_guard<std::mutex> lock(m_recordingMutex);
+    auto & recordedShapes = m_recordedGeometry->m_overlayShapes;
+    recordedShapes.insert(recordedShapes.end(), shapes.cbegin(), shapes.cend());
+  }
   PostMessage(make_unique_dp<OverlayMapShapeReadedMessage>(m_tileKey, std::move(shapes)));
 }
 
 void EngineContext::FlushTrafficGeometry(TrafficSegmentsGeometry && geometry)
 {
+  if (m_recordedGeometry != nullptr)
+  {
+    std::lock_guard<std::mutex> lock(m_recordingMutex);
+    for (auto const & segments : geometry)
+    {
+      auto & recordedSegments = m_recordedGeometry->m_trafficGeometry[segments.first];
+      recordedSegments.insert(recordedSegments.end(), segments.second.cbegin(),
+                              segments.second.cend());
+    }
+  }
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread,
                             make_unique_dp<FlushTrafficGeometryMessage>(m_tileKey, std::move(geometry)),
                             MessagePriority::Low);
@@ -68,6 +91,25 @@ void EngineContext::EndReadTile()
   PostMessage(make_unique_dp<TileReadEndMessage>(m_tileKey));
 }
 
+void EngineContext::StartRecording()
+{
+  m_recordedGeometry = std::make_shared<TileGeometryCache::TileGeometry>();
+}
+
+std::shared_ptr<TileGeometryCache::TileGeometry> EngineContext::FinishRecording()
+{
+  return std::move(m_recordedGeometry);
+}
+
+void EngineContext::FlushCachedGeometry(TileGeometryCache::TileGeometry const & geometry)
+{
+  if (!geometry.m_shapes.empty())
+    Flush(TMapShapes(geometry.m_shapes));
+  if (!geometry.m_overlayShapes.empty())
+    FlushOverlays(TMapShapes(geometry.m_overlayShapes));
+  FlushTrafficGeometry(TrafficSegmentsGeometry(geometry.m_trafficGeometry));
+}
+
 void EngineContext::PostMessage(drape_ptr<Message> && message)
 {
   m_commutator->PostMessage(ThreadsCommutator::ResourceUploadThread, std::move(message),
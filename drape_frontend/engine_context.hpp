@@ -4,12 +4,15 @@
 #include "drape_frontend/map_shape.hpp"
 #include "drape_frontend/tile_utils.hpp"
 #include "drape_frontend/threads_commutator.hpp"
+#include "drape_frontend/tile_geometry_cache.hpp"
 #include "drape_frontend/traffic_generator.hpp"
 
 #include "drape/constants.hpp"
 #include "drape/pointers.hpp"
 
 #include <functional>
+#include <memory>
+#include <mutex>
 
 namespace dp
 {
@@ -54,6 +57,12 @@ public:
   void FlushTrafficGeometry(TrafficSegmentsGeometry && geometry);
   void EndReadTile();
 
+  // Flushed shapes and traffic geometry are collected to be put to TileGeometryCache
+  // between these calls. Shapes can be flushed from several threads.
+  void StartRecording();
+  std::shared_ptr<TileGeometryCache::TileGeometry> FinishRecording();
+  void FlushCachedGeometry(TileGeometryCache::TileGeometry const & geometry);
+
 private:
   void PostMessage(drape_ptr<Message> && message);
 
@@ -68,5 +77,7 @@ private:
   bool m_guidesEnabled;
   int m_displacementMode;
   TIsUGCFn m_isUGCFn;
+  std::mutex m_recordingMutex;
+  std::shared_ptr<TileGeometryCache::TileGeometry> m_recordedGeometry;
 };
 }  // namespace df
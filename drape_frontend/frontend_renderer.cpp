@@ -32,6 +32,8 @@
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/profiler.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/timer.hpp"
 
@@ -155,6 +157,24 @@ private:
   m2::PointD m_viewportCenter = m2::PointD::Zero();
 };
 
+class RenderPhaseGuard
+{
+public:
+  explicit RenderPhaseGuard(DrapeMeasurer::RenderPhase phase)
+    : m_phase(phase)
+  {
+    DrapeMeasurer::Instance().BeginRenderPhase(m_phase);
+  }
+
+  ~RenderPhaseGuard()
+  {
+    DrapeMeasurer::Instance().EndRenderPhase(m_phase);
+  }
+
+private:
+  DrapeMeasurer::RenderPhase const m_phase;
+};
+
 #if defined(DRAPE_MEASURER_BENCHMARK) && (defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM))
 class DrapeImmediateRenderingMeasurerGuard
 {
@@ -177,6 +197,34 @@ private:
   ref_ptr<dp::GraphicsContext> m_context;
 };
 #endif
+
+// Returns true if the visible area of |screen| differs from the one of |lastScreen| noticeably,
+// i.e. some corner of the viewport is shifted by more than a pixel. Smaller changes, which are
+// common while the map follows the position, don't change the tiles coverage.
+bool IsCoverageChanged(ScreenBase const & lastScreen, ScreenBase const & screen)
+{
+  double constexpr kMaxPixelShift = 1.0;
+  double constexpr kEps = 1e-5;
+
+  if (lastScreen.isPerspective() != screen.isPerspective() ||
+      !base::AlmostEqualAbs(lastScreen.GetRotationAngle(), screen.GetRotationAngle(), kEps) ||
+      !m2::IsEqualSize(lastScreen.PixelRectIn3d(), screen.PixelRectIn3d(), kEps, kEps))
+  {
+    return true;
+  }
+
+  m2::AnyRectD::Corners corners;
+  screen.GlobalRect().GetGlobalPoints(corners);
+  for (auto const & corner : corners)
+  {
+    if (lastScreen.GtoP(corner).SquaredLength(screen.GtoP(corner)) >
+        kMaxPixelShift * kMaxPixelShift)
+    {
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace
   
 FrontendRenderer::FrontendRenderer(Params && params)
@@ -1107,6 +1155,7 @@ void FrontendRenderer::UpdateContextDependentResources()
     // Request new tiles.
     ScreenBase screen = m_userEventStream.GetCurrentScreen();
     m_lastReadedModelView = screen;
+    m_lastRequestedModelView = screen;
     m_requestedTiles->Set(screen, m_isIsometry || screen.isPerspective(),
                           m_forceUpdateScene, m_forceUpdateUserMarks,
                           ResolveTileKeys(screen));
@@ -1177,6 +1226,7 @@ void FrontendRenderer::InvalidateRect(m2::RectD const & gRect)
 
     // Request new tiles.
     m_lastReadedModelView = screen;
+    m_lastRequestedModelView = screen;
     m_requestedTiles->Set(screen, m_isIsometry || screen.isPerspective(),
                           m_forceUpdateScene, m_forceUpdateUserMarks,
                           ResolveTileKeys(screen));
@@ -1431,6 +1481,7 @@ void FrontendRenderer::EndUpdateOverlayTree()
 
 void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFrame)
 {
+  PROFILER_SCOPE("FrontendRenderer::RenderScene");
   CHECK(m_context != nullptr, ());
 #if defined(DRAPE_MEASURER_BENCHMARK) && (defined(RENDER_STATISTIC) || defined(TRACK_GPU_MEM))
   DrapeImmediateRenderingMeasurerGuard drapeMeasurerGuard(m_context);
@@ -1532,9 +1583,13 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFram
       m_debugRectRenderer->DrawArrow(m_context, modelView, arrow);
   }
 
-  if (!m_postprocessRenderer->EndFrame(m_context, make_ref(m_gpuProgramManager), m_viewport))
-    return;
+  {
+    RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::Postprocess);
+    if (!m_postprocessRenderer->EndFrame(m_context, make_ref(m_gpuProgramManager), m_viewport))
+      return;
+  }
 
+  RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::Gui);
   m_myPositionController->Render(m_context, make_ref(m_gpuProgramManager), modelView, m_currentZoomLevel,
                                  m_frameValues);
 
@@ -1552,6 +1607,7 @@ void FrontendRenderer::RenderScene(ScreenBase const & modelView, bool activeFram
 
 void FrontendRenderer::Render2dLayer(ScreenBase const & modelView)
 {
+  RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::Geometry2d);
   RenderLayer & layer2d = m_layers[static_cast<size_t>(DepthLayer::GeometryLayer)];
   layer2d.Sort(make_ref(m_overlayTree));
 
@@ -1563,6 +1619,7 @@ void FrontendRenderer::Render2dLayer(ScreenBase const & modelView)
 
 void FrontendRenderer::PreRender3dLayer(ScreenBase const & modelView)
 {
+  RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::Geometry3d);
   if (!m_buildingsFramebuffer->IsSupported())
     return;
   
@@ -1583,6 +1640,7 @@ void FrontendRenderer::PreRender3dLayer(ScreenBase const & modelView)
   
 void FrontendRenderer::Render3dLayer(ScreenBase const & modelView)
 {
+  RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::Geometry3d);
   RenderLayer & layer = m_layers[static_cast<size_t>(DepthLayer::Geometry3dLayer)];
   if (layer.m_renderGroups.empty())
     return;
@@ -1609,6 +1667,7 @@ void FrontendRenderer::Render3dLayer(ScreenBase const & modelView)
 
 void FrontendRenderer::RenderOverlayLayer(ScreenBase const & modelView)
 {
+  RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::Overlays);
   CHECK(m_context != nullptr, ());
   DEBUG_LABEL(m_context, "Overlay Layer");
   RenderLayer & overlay = m_layers[static_cast<size_t>(DepthLayer::OverlayLayer)];
@@ -1644,6 +1703,7 @@ bool FrontendRenderer::HasRouteData() const
 
 void FrontendRenderer::RenderTransitSchemeLayer(ScreenBase const & modelView)
 {
+  RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::TransitScheme);
   CHECK(m_context != nullptr, ());
   if (m_transitSchemeEnabled && m_transitSchemeRenderer->IsSchemeVisible(m_currentZoomLevel))
   {
@@ -1658,6 +1718,7 @@ void FrontendRenderer::RenderTransitSchemeLayer(ScreenBase const & modelView)
 
 void FrontendRenderer::RenderTrafficLayer(ScreenBase const & modelView)
 {
+  RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::Traffic);
   CHECK(m_context != nullptr, ());
   if (m_trafficRenderer->HasRenderData())
   {
@@ -1688,6 +1749,7 @@ void FrontendRenderer::RenderTransitBackground()
 
 void FrontendRenderer::RenderRouteLayer(ScreenBase const & modelView)
 {
+  RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::Route);
   if (HasTransitRouteData())
     RenderTransitBackground();
   
@@ -1703,6 +1765,7 @@ void FrontendRenderer::RenderRouteLayer(ScreenBase const & modelView)
 
 void FrontendRenderer::RenderUserMarksLayer(ScreenBase const & modelView, DepthLayer layerId)
 {
+  RenderPhaseGuard phaseGuard(DrapeMeasurer::RenderPhase::UserMarks);
   auto & renderGroups = m_layers[static_cast<size_t>(layerId)].m_renderGroups;
   if (renderGroups.empty())
     return;
@@ -1750,6 +1813,7 @@ void FrontendRenderer::RenderEmptyFrame()
 
 void FrontendRenderer::RenderFrame()
 {
+  PROFILER_SCOPE("FrontendRenderer::RenderFrame");
   DrapeMeasurerGuard drapeMeasurerGuard;
   
   CHECK(m_context != nullptr, ());
@@ -1863,13 +1927,19 @@ void FrontendRenderer::RenderFrame()
   m_context->Present();
 #endif
 
-  // Limit fps in following mode.
-  double constexpr kFrameTime = 1.0 / 30.0;
-  auto const ft = m_frameData.m_timer.ElapsedSeconds();
-  if (!canSuspend && ft < kFrameTime && m_myPositionController->IsRouteFollowingActive())
-  {
-    auto const ms = static_cast<uint32_t>((kFrameTime - ft) * 1000);
-    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  // Limit fps in following mode. Frames are paced by deadlines which are a frame apart, so the
+  // frame rate does not drift because of the time spent out of RenderFrame and rounding.
+  auto constexpr kFollowingFrameDuration = std::chrono::microseconds(1000000 / 30);
+  if (!canSuspend && m_myPositionController->IsRouteFollowingActive())
+  {
+    auto & deadline = m_frameData.m_followingFrameDeadline;
+    deadline += kFollowingFrameDuration;
+    auto const now = std::chrono::steady_clock::now();
+    // After a long frame or a pause the pacing starts over instead of catching up.
+    if (deadline <= now)
+      deadline = now;
+    else
+      std::this_thread::sleep_until(deadline);
   }
 
   m_frameData.m_frameTime = m_frameData.m_timer.ElapsedSeconds();
@@ -1920,6 +1990,7 @@ void FrontendRenderer::RenderSingleGroup(ref_ptr<dp::GraphicsContext> context,
                                          ScreenBase const & modelView,
                                          ref_ptr<BaseRenderGroup> group)
 {
+  DrapeMeasurer::Instance().OnRenderGroup();
   group->UpdateAnimation();
   group->Render(context, make_ref(m_gpuProgramManager), modelView, m_frameValues,
                 make_ref(m_debugRectRenderer));
@@ -2430,6 +2501,7 @@ FrontendRenderer::Routine::Routine(FrontendRenderer & renderer) : m_renderer(ren
 void FrontendRenderer::Routine::Do()
 {
   LOG(LINFO, ("Start routine."));
+  base::profiler::SetThreadName("FrontendRenderer");
 
   gui::DrapeGui::Instance().ConnectOnCompassTappedHandler(std::bind(&FrontendRenderer::OnCompassTapped, &m_renderer));
   m_renderer.m_myPositionController->SetListener(ref_ptr<MyPositionController::Listener>(&m_renderer));
@@ -2448,7 +2520,8 @@ void FrontendRenderer::Routine::Do()
                                 true /* repeating */, [this](uint64_t)
   {
     LOG(LINFO, ("framesOverall =", m_renderer.m_frameData.m_framesOverall,
-                "framesFast =", m_renderer.m_frameData.m_framesFast));
+                "framesFast =", m_renderer.m_frameData.m_framesFast,
+                "coverageUpdatesSkipped =", m_renderer.m_frameData.m_coverageUpdatesSkipped));
 #ifdef TRACK_GPU_MEM
     LOG(LINFO, (dp::GPUMemTracker::Inst().GetMemorySnapshot().ToString()));
 #endif
@@ -2578,7 +2651,9 @@ void FrontendRenderer::UpdateScene(ScreenBase const & modelView)
 {
   ResolveZoomLevel(modelView);
 
-  m_gpsTrackRenderer->Update();
+  // GpsTrackRenderer updates the points itself when the screen moves far enough.
+  if (m_forceUpdateScene)
+    m_gpsTrackRenderer->Update();
 
   auto removePredicate = [this](drape_ptr<RenderGroup> const & group)
   {
@@ -2597,6 +2672,17 @@ void FrontendRenderer::UpdateScene(ScreenBase const & modelView)
   {
     EmitModelViewChanged(modelView);
     m_lastReadedModelView = modelView;
+
+    if (!m_forceUpdateScene && !m_forceUpdateUserMarks &&
+        !IsCoverageChanged(m_lastRequestedModelView, modelView))
+    {
+#ifdef SHOW_FRAMES_STATS
+      ++m_frameData.m_coverageUpdatesSkipped;
+#endif
+      return;
+    }
+
+    m_lastRequestedModelView = modelView;
     m_requestedTiles->Set(modelView, m_isIsometry || modelView.isPerspective(),
                           m_forceUpdateScene, m_forceUpdateUserMarks,
                           ResolveTileKeys(modelView));
@@ -37,6 +37,7 @@
 #include "geometry/triangle2d.hpp"
 
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -342,6 +343,8 @@ private:
   UserPositionPendingTimeoutHandler m_userPositionPendingTimeoutHandler;
 
   ScreenBase m_lastReadedModelView;
+  // Screen the tiles were requested for the last time.
+  ScreenBase m_lastRequestedModelView;
   TTilesCollection m_notFinishedTiles;
 
   int m_currentZoomLevel = -1;
@@ -424,9 +427,13 @@ private:
     bool m_viewportChanged = true;
     uint32_t m_inactiveFramesCounter = 0;
     bool m_forceFullRedrawNextFrame = false;
+    // Time by which the next frame must be started in the route following mode.
+    std::chrono::steady_clock::time_point m_followingFrameDeadline;
 #ifdef SHOW_FRAMES_STATS
     uint64_t m_framesOverall = 0;
     uint64_t m_framesFast = 0;
+    // Number of the model view changes which were too small to update the tiles coverage.
+    uint64_t m_coverageUpdatesSkipped = 0;
 #endif
     static uint32_t constexpr kMaxInactiveFrames = 2;
   };
@@ -49,6 +49,10 @@ double const kUnknownDistanceTime = 5 * 60; // seconds
 
 double const kDistanceScalar = 0.4;
 
+// Points are generated for the rect which is this times larger than the screen, so they are not
+// regenerated while the screen moves inside the rect.
+double const kCoveredRectScale = 2.0;
+
 float CalculateRadius(ScreenBase const & screen)
 {
   double zoom = 0.0;
@@ -72,6 +76,7 @@ GpsTrackRenderer::GpsTrackRenderer(TRenderDataRequestFn const & dataRequestFn)
   , m_needUpdate(false)
   , m_waitForRenderData(false)
   , m_radius(0.0f)
+  , m_scale(0.0)
 {
   ASSERT(m_dataRequestFn != nullptr, ());
   m_points.reserve(kAveragePointsCount);
@@ -101,7 +106,8 @@ void GpsTrackRenderer::ClearRenderData()
 void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
                                     std::vector<uint32_t> const & toRemove)
 {
-  bool wasChanged = false;
+  // New points are appended to the spline, it's rebuilt only when some points are removed.
+  bool const needRebuildSpline = !toRemove.empty();
   if (!toRemove.empty())
   {
     auto removePredicate = [&toRemove](GpsTrackPoint const & pt)
@@ -110,7 +116,6 @@ void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
     };
     m_points.erase(std::remove_if(m_points.begin(), m_points.end(), removePredicate),
                    m_points.end());
-    wasChanged = true;
   }
 
   if (!toAdd.empty())
@@ -119,12 +124,17 @@ void GpsTrackRenderer::UpdatePoints(std::vector<GpsTrackPoint> const & toAdd,
     if (!m_points.empty())
       ASSERT(GpsPointsSortPredicate(m_points.back(), toAdd.front()), ());
     m_points.insert(m_points.end(), toAdd.begin(), toAdd.end());
-    wasChanged = true;
+
+    if (!needRebuildSpline)
+    {
+      for (auto const & pt : toAdd)
+        m_pointsSpline.AddPoint(pt.m_point);
+    }
   }
 
-  if (wasChanged)
+  if (needRebuildSpline)
   {
-    m_pointsSpline = m2::Spline(m_points.size());
+    m_pointsSpline = m_points.empty() ? m2::Spline() : m2::Spline(m_points.size());
     for (size_t i = 0; i < m_points.size(); i++)
       m_pointsSpline.AddPoint(m_points[i].m_point);
   }
@@ -196,6 +206,9 @@ void GpsTrackRenderer::RenderTrack(ref_ptr<dp::GraphicsContext> context, ref_ptr
   if (zoomLevel < kMinVisibleZoomLevel)
     return;
 
+  if (screen.GetScale() != m_scale || !m_coveredRect.IsRectInside(screen.ClipRect()))
+    m_needUpdate = true;
+
   if (m_needUpdate)
   {
     // Skip rendering if there is no any point.
@@ -216,6 +229,9 @@ void GpsTrackRenderer::RenderTrack(ref_ptr<dp::GraphicsContext> context, ref_ptr
       return;
 
     m_radius = CalculateRadius(screen);
+    m_scale = screen.GetScale();
+    m_coveredRect = screen.ClipRect();
+    m_coveredRect.Scale(kCoveredRectScale);
     double const currentScaleGtoP = 1.0 / screen.GetScale();
     double const radiusMercator = m_radius / currentScaleGtoP;
     double const diameterMercator = 2.0 * radiusMercator;
@@ -251,7 +267,7 @@ void GpsTrackRenderer::RenderTrack(ref_ptr<dp::GraphicsContext> context, ref_ptr
         m2::PointD const pt = it.m_pos;
         m2::RectD pointRect(pt.x - radiusMercator, pt.y - radiusMercator,
                             pt.x + radiusMercator, pt.y + radiusMercator);
-        if (screen.ClipRect().IsIntersect(pointRect))
+        if (m_coveredRect.IsIntersect(pointRect))
         {
           dp::Color const color = CalculatePointColor(it.GetIndex(), pt,
                                                       it.GetLength(), it.GetFullLength());
@@ -9,6 +9,7 @@
 #include "drape/graphics_context.hpp"
 #include "drape/pointers.hpp"
 
+#include "geometry/rect2d.hpp"
 #include "geometry/screenbase.hpp"
 #include "geometry/spline.hpp"
 
@@ -51,6 +52,9 @@ private:
   bool m_waitForRenderData;
   std::vector<std::pair<CirclesPackHandle *, size_t>> m_handlesCache;
   float m_radius;
+  // Scale of the screen and the rect the points were generated for.
+  double m_scale;
+  m2::RectD m_coveredRect;
   m2::PointD m_pivot;
 };
 }  // namespace df
@@ -3,6 +3,8 @@
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+
 namespace df
 {
 MessageQueue::MessageQueue()
@@ -11,102 +13,108 @@ MessageQueue::MessageQueue()
 
 MessageQueue::~MessageQueue()
 {
-  CancelWaitImpl();
+  if (CancelWaitImpl())
+    m_condition.notify_all();
   ClearQuery();
 }
 
 drape_ptr<Message> MessageQueue::PopMessage(bool waitForMessage)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
-  if (waitForMessage && m_messages.empty() && m_lowPriorityMessages.empty())
+  if (waitForMessage && IsEmptyImpl())
   {
     m_isWaiting = true;
     m_condition.wait(lock, [this]() { return !m_isWaiting; });
     m_isWaiting = false;
   }
 
-  if (m_messages.empty() && m_lowPriorityMessages.empty())
-    return nullptr;
-
-  if (!m_messages.empty())
+  for (auto * messages : {&m_uberHighPriorityMessages, &m_highPriorityMessages, &m_messages,
+                          &m_lowPriorityMessages})
   {
-    drape_ptr<Message> msg = std::move(m_messages.front().first);
-    m_messages.pop_front();
-    return msg;
+    if (!messages->empty())
+    {
+      drape_ptr<Message> msg = std::move(messages->front());
+      messages->pop_front();
+      return msg;
+    }
   }
-
-  drape_ptr<Message> msg = std::move(m_lowPriorityMessages.front());
-  m_lowPriorityMessages.pop_front();
-  return msg;
+  return nullptr;
 }
 
 void MessageQueue::PushMessage(drape_ptr<Message> && message, MessagePriority priority)
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
+  bool needNotify = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
 
-  if (m_filter != nullptr && m_filter(make_ref(message)))
-    return;
+    if (m_filter != nullptr && m_filter(make_ref(message)))
+      return;
 
-  switch (priority)
-  {
-  case MessagePriority::Normal:
-    {
-      m_messages.emplace_back(std::move(message), priority);
-      break;
-    }
-  case MessagePriority::High:
+    switch (priority)
     {
-      auto iter = m_messages.begin();
-      while (iter != m_messages.end() && iter->second > MessagePriority::High) { iter++; }
-      m_messages.emplace(iter, std::move(message), priority);
-      break;
-    }
-  case MessagePriority::UberHighSingleton:
-    {
-      bool found = false;
-      auto iter = m_messages.begin();
-      while (iter != m_messages.end() && iter->second == MessagePriority::UberHighSingleton)
+    case MessagePriority::Normal:
       {
-        if (iter->first->GetType() == message->GetType())
-        {
-          found = true;
-          break;
-        }
-        iter++;
+        m_messages.emplace_back(std::move(message));
+        break;
       }
+    case MessagePriority::High:
+      {
+        m_highPriorityMessages.emplace_front(std::move(message));
+        break;
+      }
+    case MessagePriority::UberHighSingleton:
+      {
+        auto const type = message->GetType();
+        bool const found = std::any_of(m_uberHighPriorityMessages.cbegin(),
+                                       m_uberHighPriorityMessages.cend(),
+                                       [type](drape_ptr<Message> const & msg)
+        {
+          return msg->GetType() == type;
+        });
 
-      if (!found)
-        m_messages.emplace_front(std::move(message), priority);
-      break;
-    }
-  case MessagePriority::Low:
-    {
-      m_lowPriorityMessages.emplace_back(std::move(message));
-      break;
+        if (!found)
+          m_uberHighPriorityMessages.emplace_front(std::move(message));
+        break;
+      }
+    case MessagePriority::Low:
+      {
+        m_lowPriorityMessages.emplace_back(std::move(message));
+        break;
+      }
+    default:
+      ASSERT(false, ("Unknown message priority type"));
     }
-  default:
-    ASSERT(false, ("Unknown message priority type"));
+
+    needNotify = CancelWaitImpl();
   }
 
-  CancelWaitImpl();
+  // The waiting thread is woken up after the mutex is released, so it does not block on it.
+  if (needNotify)
+    m_condition.notify_all();
+}
+
+bool MessageQueue::IsEmptyImpl() const
+{
+  return m_uberHighPriorityMessages.empty() && m_highPriorityMessages.empty() &&
+         m_messages.empty() && m_lowPriorityMessages.empty();
 }
 
 void MessageQueue::FilterMessagesImpl()
 {
   CHECK(m_filter != nullptr, ());
 
-  for (auto it = m_messages.begin(); it != m_messages.end(); )
-  {
-    if (m_filter(make_ref(it->first)))
-      it = m_messages.erase(it);
-    else
-      ++it;
-  }
+  FilterMessagesImpl(m_uberHighPriorityMessages);
+  FilterMessagesImpl(m_highPriorityMessages);
+  FilterMessagesImpl(m_messages);
+  FilterMessagesImpl(m_lowPriorityMessages);
+}
 
-  for (auto it = m_lowPriorityMessages.begin(); it != m_lowPriorityMessages.end(); )
+void MessageQueue::FilterMessagesImpl(TMessages & messages)
+{
+  for (auto it = messages.begin(); it != messages.end(); )
   {
     if (m_filter(make_ref(*it)))
-      it = m_lowPriorityMessages.erase(it);
+      it = messages.erase(it);
     else
       ++it;
   }
@@ -138,33 +146,42 @@ void MessageQueue::InstantFilter(FilterMessageFn && filter)
 bool MessageQueue::IsEmpty() const
 {
   std::lock_guard<std::mutex> lock(m_mutex);
-  return m_messages.empty() && m_lowPriorityMessages.empty();
+  return IsEmptyImpl();
 }
 
 size_t MessageQueue::GetSize() const
 {
   std::lock_guard<std::mutex> lock(m_mutex);
-  return m_messages.size() + m_lowPriorityMessages.size();
+  return m_uberHighPriorityMessages.size() + m_highPriorityMessages.size() + m_messages.size() +
+         m_lowPriorityMessages.size();
 }
 #endif
 
 void MessageQueue::CancelWait()
 {
-  std::lock_guard<std::mutex> lock(m_mutex);
-  CancelWaitImpl();
+  bool needNotify;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    needNotify = CancelWaitImpl();
+  }
+
+  if (needNotify)
+    m_condition.notify_all();
 }
 
-void MessageQueue::CancelWaitImpl()
+bool MessageQueue::CancelWaitImpl()
 {
-  if (m_isWaiting)
-  {
-    m_isWaiting = false;
-    m_condition.notify_all();
-  }
+  if (!m_isWaiting)
+    return false;
+
+  m_isWaiting = false;
+  return true;
 }
 
 void MessageQueue::ClearQuery()
 {
+  m_uberHighPriorityMessages.clear();
+  m_highPriorityMessages.clear();
   m_messages.clear();
   m_lowPriorityMessages.clear();
 }
@@ -37,15 +37,23 @@ public:
 #endif
 
 private:
+  using TMessages = std::deque<drape_ptr<Message>>;
+
+  bool IsEmptyImpl() const;
   void FilterMessagesImpl();
-  void CancelWaitImpl();
+  void FilterMessagesImpl(TMessages & messages);
+  // Returns true if the waiting thread must be notified.
+  bool CancelWaitImpl();
 
   mutable std::mutex m_mutex;
   std::condition_variable m_condition;
   bool m_isWaiting;
-  using TMessageNode = std::pair<drape_ptr<Message>, MessagePriority>;
-  std::deque<TMessageNode> m_messages;
-  std::deque<drape_ptr<Message>> m_lowPriorityMessages;
+  // Messages of each priority are kept separately, so pushing a message takes constant time.
+  // They are popped in the order of declaration.
+  TMessages m_uberHighPriorityMessages;
+  TMessages m_highPriorityMessages;
+  TMessages m_messages;
+  TMessages m_lowPriorityMessages;
   FilterMessageFn m_filter;
 };
 }  // namespace df
@@ -10,11 +10,22 @@
 
 #include <algorithm>
 #include <functional>
+#include <thread>
+#include <utility>
 
 namespace df
 {
 namespace
 {
+size_t GetDrawingThreadsCount()
+{
+  size_t constexpr kMaxDrawingThreadsCount = 4;
+  size_t const hardwareThreadsCount = std::thread::hardware_concurrency();
+  if (hardwareThreadsCount <= kReadingThreadsCount)
+    return 0;
+  return std::min(hardwareThreadsCount - kReadingThreadsCount, kMaxDrawingThreadsCount);
+}
+
 struct LessCoverageCell
 {
   bool operator()(std::shared_ptr<TileInfo> const & l,
@@ -35,6 +46,34 @@ struct LessCoverageCell
     return l->GetTileKey() < r->GetTileKey();
   }
 };
+
+// Tiles closer to the viewport centre are read first. Tiles at the same distance are read
+// from the most detailed ones.
+template <typename TTiles>
+buffer_vector<TileKey, 8> SortByReadingPriority(ScreenBase const & screen, TTiles const & tiles)
+{
+  m2::PointD const center = screen.GlobalRect().GlobalCenter();
+  buffer_vector<std::pair<double, TileKey>, 8> priorities;
+  priorities.reserve(tiles.size());
+  for (auto const & tileKey : tiles)
+    priorities.emplace_back(tileKey.GetGlobalRect().Center().SquaredLength(center), tileKey);
+
+  std::sort(priorities.begin(), priorities.end(),
+            [](std::pair<double, TileKey> const & l, std::pair<double, TileKey> const & r)
+  {
+    if (l.first != r.first)
+      return l.first < r.first;
+    if (l.second.m_zoomLevel != r.second.m_zoomLevel)
+      return l.second.m_zoomLevel > r.second.m_zoomLevel;
+    return l.second < r.second;
+  });
+
+  buffer_vector<TileKey, 8> result;
+  result.reserve(priorities.size());
+  for (auto const & p : priorities)
+    result.push_back(p.second);
+  return result;
+}
 }  // namespace
 
 bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l,
@@ -45,7 +84,8 @@ bool ReadManager::LessByTileInfo::operator()(std::shared_ptr<TileInfo> const & l
 
 ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
                          bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled,
-                         bool guidesEnabled, EngineContext::TIsUGCFn && isUGCFn)
+                         bool guidesEnabled, EngineContext::TIsUGCFn && isUGCFn,
+                         uint32_t geometryCacheTilesCount)
   : m_commutator(commutator)
   , m_model(model)
   , m_have3dBuildings(false)
@@ -61,6 +101,7 @@ ReadManager::ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider
   , m_generationCounter(0)
   , m_userMarksGenerationCounter(0)
   , m_isUGCFn(std::move(isUGCFn))
+  , m_geometryCache(geometryCacheTilesCount)
 {
   Start();
 }
@@ -73,6 +114,13 @@ void ReadManager::Start()
   using namespace std::placeholders;
   m_pool = make_unique_dp<base::thread_pool::routine::ThreadPool>(kReadingThreadsCount,
                                                std::bind(&ReadManager::OnTaskFinished, this, _1));
+
+  size_t const drawingThreadsCount = GetDrawingThreadsCount();
+  if (drawingThreadsCount != 0)
+  {
+    m_drawingPool =
+        make_unique_dp<base::thread_pool::computational::ThreadPool>(drawingThreadsCount);
+  }
 }
 
 void ReadManager::Stop()
@@ -81,6 +129,9 @@ void ReadManager::Stop()
   if (m_pool != nullptr)
     m_pool->Stop();
   m_pool.reset();
+
+  // Reading threads wait for the drawing ones, so the drawing pool is destroyed after them.
+  m_drawingPool.reset();
 }
 
 void ReadManager::Restart()
@@ -140,6 +191,11 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
   m_modeChanged |= (m_have3dBuildings != have3dBuildings);
   m_have3dBuildings = have3dBuildings;
 
+  // Forced update means that the data or the rendering settings have been changed,
+  // so the cached geometry is outdated. On zooming and jumping it's still actual.
+  if (m_modeChanged || forceUpdate)
+    m_geometryCache.InvalidateAll();
+
   if (m_modeChanged || forceUpdate || MustDropAllTiles(screen))
   {
     m_modeChanged = false;
@@ -152,7 +208,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     ++m_generationCounter;
     ++m_userMarksGenerationCounter;
 
-    for (auto const & tileKey : tiles)
+    for (auto const & tileKey : SortByReadingPriority(screen, tiles))
       PushTaskBackForTileKey(tileKey, texMng, metalineMng);
   }
   else
@@ -182,7 +238,7 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
     if (forceUpdateUserMarks)
       ++m_userMarksGenerationCounter;
     CheckFinishedTiles(readyTiles, forceUpdateUserMarks);
-    for (auto const & tileKey : newTiles)
+    for (auto const & tileKey : SortByReadingPriority(screen, newTiles))
       PushTaskBackForTileKey(tileKey, texMng, metalineMng);
   }
 
@@ -191,6 +247,8 @@ void ReadManager::UpdateCoverage(ScreenBase const & screen, bool have3dBuildings
 
 void ReadManager::Invalidate(TTilesCollection const & keyStorage)
 {
+  m_geometryCache.Invalidate(keyStorage);
+
   TTileSet tilesToErase;
   for (auto const & info : m_tileInfos)
   {
@@ -210,6 +268,7 @@ void ReadManager::InvalidateAll()
   for (auto const & info : m_tileInfos)
     CancelTileInfo(info);
   m_tileInfos.clear();
+  m_geometryCache.InvalidateAll();
 
   m_modeChanged = true;
 }
@@ -244,7 +303,9 @@ void ReadManager::PushTaskBackForTileKey(TileKey const & tileKey,
                                                m_trafficEnabled, m_isolinesEnabled, m_guidesEnabled,
                                                m_displacementMode,
                                                m_ugcRenderingEnabled ? m_isUGCFn : nullptr);
-  std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context));
+  std::shared_ptr<TileInfo> tileInfo = std::make_shared<TileInfo>(std::move(context),
+                                                                  make_ref(&m_geometryCache),
+                                                                  make_ref(m_drawingPool));
   m_tileInfos.insert(tileInfo);
   ReadMWMTask * task = m_tasksPool.Get();
 
@@ -2,6 +2,7 @@
 
 #include "drape_frontend/engine_context.hpp"
 #include "drape_frontend/read_mwm_task.hpp"
+#include "drape_frontend/tile_geometry_cache.hpp"
 #include "drape_frontend/tile_info.hpp"
 #include "drape_frontend/tile_utils.hpp"
 
@@ -11,6 +12,7 @@
 #include "drape/pointers.hpp"
 
 #include "base/thread_pool.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <memory>
 #include <mutex>
@@ -28,13 +30,15 @@ class MapDataProvider;
 class MetalineManager;
 
 uint8_t constexpr kReadingThreadsCount = 2;
+uint32_t constexpr kDefaultGeometryCacheTilesCount = 32;
 
 class ReadManager
 {
 public:
   ReadManager(ref_ptr<ThreadsCommutator> commutator, MapDataProvider & model,
               bool allow3dBuildings, bool trafficEnabled, bool isolinesEnabled, bool guidesEnabled,
-              EngineContext::TIsUGCFn && isUGCFn);
+              EngineContext::TIsUGCFn && isUGCFn,
+              uint32_t geometryCacheTilesCount = kDefaultGeometryCacheTilesCount);
 
   void Start();
   void Stop();
@@ -79,6 +83,8 @@ private:
   MapDataProvider & m_model;
 
   drape_ptr<base::thread_pool::routine::ThreadPool> m_pool;
+  // Helps the reading threads to draw dense tiles.
+  drape_ptr<base::thread_pool::computational::ThreadPool> m_drawingPool;
 
   ScreenBase m_currentViewport;
   bool m_have3dBuildings;
@@ -113,6 +119,8 @@ private:
 
   EngineContext::TIsUGCFn m_isUGCFn;
 
+  TileGeometryCache m_geometryCache;
+
   void CancelTileInfo(std::shared_ptr<TileInfo> const & tileToCancel);
   void ClearTileInfo(std::shared_ptr<TileInfo> const & tileToClear);
   void IncreaseCounter(int value);
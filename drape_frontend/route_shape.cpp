@@ -199,11 +199,24 @@ void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::Point
   for (auto const & segment : segments)
     length += glsl::length(segment.m_points[EndPoint] - segment.m_points[StartPoint]);
 
-  geometryBufferData.emplace_back(GeometryBufferData<GeometryBuffer>());
-
   uint32_t constexpr kMinVertices = 5000;
+  size_t constexpr kVerticesPerSegment = 8;
   double constexpr kMinExtent = mercator::Bounds::kRangeX / (1 << 10);
 
+  // Geometry is split into buffers of about kMinVertices vertices, so a buffer is reserved
+  // for the segments which are left but not more than that.
+  auto const addBuffer = [&geometryBufferData](size_t segmentsLeft) {
+    geometryBufferData.emplace_back(GeometryBufferData<GeometryBuffer>());
+    geometryBufferData.back().m_geometry.reserve(
+        std::min(segmentsLeft, static_cast<size_t>(kMinVertices) / kVerticesPerSegment + 1) *
+        kVerticesPerSegment);
+  };
+  addBuffer(segments.size());
+
+  // Normals of joins and caps are generated into the same buffer for all the segments.
+  std::vector<glsl::vec2> normals;
+  normals.reserve(24);
+
   float depth = baseDepth;
   float const depthStep = kRouteDepth / (1 + segments.size());
   for (auto i = static_cast<int>(segments.size() - 1); i >= 0; i--)
@@ -270,8 +283,7 @@ void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::Point
       float widthScalar = segments[i].m_hasLeftJoin[EndPoint] ? segments[i].m_rightWidthScalar[EndPoint].x :
                                                                 segments[i].m_leftWidthScalar[EndPoint].x;
 
-      std::vector<glsl::vec2> normals;
-      normals.reserve(24);
+      normals.clear();
       GenerateJoinNormals(dp::RoundJoin, n1, n2, 1.0f, segments[i].m_hasLeftJoin[EndPoint],
                           widthScalar, normals);
 
@@ -282,8 +294,7 @@ void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::Point
     // Generate caps.
     if (i == 0)
     {
-      std::vector<glsl::vec2> normals;
-      normals.reserve(24);
+      normals.clear();
       GenerateCapNormals(dp::RoundCap, segments[i].m_leftNormals[StartPoint],
                          segments[i].m_rightNormals[StartPoint], -segments[i].m_tangent,
                          1.0f, true /* isStart */, normals);
@@ -294,8 +305,7 @@ void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::Point
 
     if (i == static_cast<int>(segments.size()) - 1)
     {
-      std::vector<glsl::vec2> normals;
-      normals.reserve(24);
+      normals.clear();
       GenerateCapNormals(dp::RoundCap, segments[i].m_leftNormals[EndPoint],
                          segments[i].m_rightNormals[EndPoint], segments[i].m_tangent,
                          1.0f, false /* isStart */, normals);
@@ -307,7 +317,7 @@ void RouteShape::PrepareGeometry(std::vector<m2::PointD> const & path, m2::Point
     auto const verticesCount = geomBufferData.m_geometry.size() + geomBufferData.m_joinsGeometry.size();
     auto const extent = std::max(geomBufferData.m_boundingBox.SizeX(), geomBufferData.m_boundingBox.SizeY());
     if (verticesCount > kMinVertices && extent > kMinExtent)
-      geometryBufferData.emplace_back(GeometryBufferData<GeometryBuffer>());
+      addBuffer(static_cast<size_t>(i));
 
     length = startLength;
   }
@@ -10,6 +10,7 @@
 
 #include "indexer/feature.hpp"
 #include "indexer/feature_algo.hpp"
+#include "indexer/feature_centers_cache.hpp"
 #include "indexer/feature_visibility.hpp"
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/ftypes_sponsored.hpp"
@@ -32,6 +33,7 @@
 #endif
 
 #include <functional>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -92,9 +94,9 @@ df::BaseApplyFeature::HotelData ExtractHotelData(FeatureType & f)
   {
     result.m_isHotel = true;
     result.m_rating = f.GetMetadata(feature::Metadata::FMD_RATING);
-    if (!strings::to_int(f.GetMetadata(feature::Metadata::FMD_STARS), result.m_stars))
+    if (!f.GetMetadata(feature::Metadata::FMD_STARS, result.m_stars))
       result.m_stars = 0;
-    if (!strings::to_int(f.GetMetadata(feature::Metadata::FMD_PRICE_RATE), result.m_priceCategory))
+    if (!f.GetMetadata(feature::Metadata::FMD_PRICE_RATE, result.m_priceCategory))
       result.m_priceCategory = 0;
   }
   return result;
@@ -175,18 +177,21 @@ RuleDrawer::RuleDrawer(TDrawerCallback const & drawerFn,
                        TCheckCancelledCallback const & checkCancelled,
                        TIsCountryLoadedByNameFn const & isLoadedFn,
                        TFilterFeatureFn const & filterFn,
-                       ref_ptr<EngineContext> engineContext)
+                       ref_ptr<EngineContext> engineContext,
+                       ref_ptr<TileState> tileState)
   : m_callback(drawerFn)
   , m_checkCancelled(checkCancelled)
   , m_isLoadedFn(isLoadedFn)
   , m_filter(filterFn)
   , m_context(engineContext)
+  , m_tileState(tileState)
   , m_customFeaturesContext(engineContext->GetCustomFeaturesContext().lock())
   , m_wasCancelled(false)
 {
   ASSERT(m_callback != nullptr, ());
   ASSERT(m_checkCancelled != nullptr, ());
   ASSERT(m_filter != nullptr, ());
+  ASSERT(m_tileState != nullptr, ());
 
   m_globalRect = m_context->GetTileKey().GetGlobalRect();
 
@@ -211,7 +216,8 @@ RuleDrawer::RuleDrawer(TDrawerCallback const & drawerFn,
 
 RuleDrawer::~RuleDrawer()
 {
-  if (m_wasCancelled)
+  // The tile can be cancelled after the last feature has been drawn.
+  if (m_wasCancelled || CheckCancelled())
     return;
 
   for (auto const & shape : m_mapShapes[df::OverlayType])
@@ -257,6 +263,12 @@ bool RuleDrawer::CheckCoastlines(FeatureType & f, Stylist const & s)
   return true;
 }
 
+bool RuleDrawer::MarkMetalineAsUsed(m2::Spline const * metaline)
+{
+  std::lock_guard<std::mutex> lock(m_tileState->m_mutex);
+  return m_tileState->m_usedMetalines.insert(metaline).second;
+}
+
 void RuleDrawer::ProcessAreaStyle(FeatureType & f, Stylist const & s,
                                   TInsertShapeFn const & insertShape, int & minVisibleScale)
 {
@@ -326,10 +338,7 @@ void RuleDrawer::ProcessAreaStyle(FeatureType & f, Stylist const & s,
   if (applyPointStyle)
   {
     if (UsePreciseFeatureCenter(f))
-    {
-      f.ResetGeometry();
-      featureCenter = feature::GetCenter(f, FeatureType::BEST_GEOMETRY);
-    }
+      featureCenter = FeatureCentersCache::Instance().GetCenter(f);
     bool const isUGC = m_context->IsUGC(f.GetID());
     apply(featureCenter, true /* hasArea */, isUGC);
   }
@@ -370,7 +379,7 @@ void RuleDrawer::ProcessLineStyle(FeatureType & f, Stylist const & s,
     needAdditional = true;
     clippedSplines = applyGeom.GetClippedSplines();
   }
-  else if (m_usedMetalines.find(metalineSpline.Get()) != m_usedMetalines.end())
+  else if (!MarkMetalineAsUsed(metalineSpline.Get()))
   {
     // Metaline has been used already, skip additional generation.
     needAdditional = false;
@@ -381,7 +390,6 @@ void RuleDrawer::ProcessLineStyle(FeatureType & f, Stylist const & s,
     needAdditional = true;
     clippedSplines = m2::ClipSplineByRect(m_context->GetTileKey().GetGlobalRect(),
                                           metalineSpline);
-    m_usedMetalines.insert(metalineSpline.Get());
   }
 
   if (needAdditional && !clippedSplines.empty())
@@ -390,8 +398,14 @@ void RuleDrawer::ProcessLineStyle(FeatureType & f, Stylist const & s,
                                                m_currentScaleGtoP, minVisibleScale, f.GetRank(),
                                                s.GetCaptionDescription(), clippedSplines);
     s.ForEachRule(std::bind(&ApplyLineFeatureAdditional::ProcessLineRule, &applyAdditional, _1));
-    applyAdditional.Finish(m_context->GetTextureManager(), ftypes::GetRoadShields(f),
-                           m_generatedRoadShields);
+
+    // Generated road shields are shared, so the lock is taken only for roads with shields.
+    auto roadShields = ftypes::GetRoadShields(f);
+    std::unique_lock<std::mutex> lock(m_tileState->m_mutex, std::defer_lock);
+    if (!roadShields.empty())
+      lock.lock();
+    applyAdditional.Finish(m_context->GetTextureManager(), std::move(roadShields),
+                           m_tileState->m_generatedRoadShields);
   }
 
   if (m_context->IsTrafficEnabled() && zoomLevel >= kRoadClass0ZoomLevel)
@@ -16,6 +16,7 @@
 #include <array>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 
@@ -35,11 +36,21 @@ public:
   using TInsertShapeFn = std::function<void(drape_ptr<MapShape> && shape)>;
   using TFilterFeatureFn = std::function<bool(FeatureType &)>;
 
+  // Features of a dense tile are drawn by several drawers in parallel. The drawers share
+  // the metalines and the road shields which have been generated for the tile.
+  struct TileState
+  {
+    std::mutex m_mutex;
+    std::unordered_set<m2::Spline const *> m_usedMetalines;
+    GeneratedRoadShields m_generatedRoadShields;
+  };
+
   RuleDrawer(TDrawerCallback const & drawerFn,
              TCheckCancelledCallback const & checkCancelled,
              TIsCountryLoadedByNameFn const & isLoadedFn,
              TFilterFeatureFn const & filterFn,
-             ref_ptr<EngineContext> engineContext);
+             ref_ptr<EngineContext> engineContext,
+             ref_ptr<TileState> tileState);
   ~RuleDrawer();
 
   void operator()(FeatureType & f);
@@ -57,6 +68,8 @@ private:
                          int & minVisibleScale);
 
   bool CheckCoastlines(FeatureType & f, Stylist const & s);
+  // Returns false if the metaline has been used by the tile already.
+  bool MarkMetalineAsUsed(m2::Spline const * metaline);
 
   bool CheckCancelled();
 
@@ -66,8 +79,8 @@ private:
   TFilterFeatureFn m_filter;
 
   ref_ptr<EngineContext> m_context;
+  ref_ptr<TileState> m_tileState;
   CustomFeaturesContextPtr m_customFeaturesContext;
-  std::unordered_set<m2::Spline const *> m_usedMetalines;
 
   m2::RectD m_globalRect;
   double m_currentScaleGtoP;
@@ -77,7 +90,5 @@ private:
 
   std::array<TMapShapes, df::MapShapeTypeCount> m_mapShapes;
   bool m_wasCancelled;
-
-  GeneratedRoadShields m_generatedRoadShields;
 };
 }  // namespace df
@@ -82,16 +82,17 @@ public:
     Init();
   }
 
-  void AggregateKeys(drule::KeysT const & keys)
+  void AggregateRules(drule::PreparedRulesT const & rules)
   {
-    for (auto const & key : keys)
-      ProcessKey(key);
+    for (auto const & rule : rules)
+      ProcessRule(rule);
   }
 
-  void AggregateStyleFlags(drule::KeysT const & keys, bool const nameExists)
+  void AggregateStyleFlags(drule::PreparedRulesT const & rules, bool const nameExists)
   {
-    for (auto const & key : keys)
+    for (auto const & rule : rules)
     {
+      drule::Key const & key = rule.m_key;
       bool const isNonEmptyCaption = IsTypeOf(key, Caption) && nameExists;
       m_pointStyleFound |= (IsTypeOf(key, Symbol | Circle) || isNonEmptyCaption);
       m_lineStyleFound  |= IsTypeOf(key, Line);
@@ -105,8 +106,9 @@ public:
   buffer_vector<Stylist::TRuleWrapper, 8> m_rules;
 
 private:
-  void ProcessKey(drule::Key const & key)
+  void ProcessRule(drule::PreparedRule const & rule)
   {
+    drule::Key const & key = rule.m_key;
     double depth = key.m_priority;
     if (IsMiddleTunnel(m_depthLayer, depth) && IsTypeOf(key, Line))
     {
@@ -115,10 +117,7 @@ private:
       depth = layerPart + depthPart;
     }
 
-    drule::BaseRule const * const dRule = drule::rules().Find(key);
-    if (dRule == nullptr)
-      return;
-
+    drule::BaseRule const * const dRule = rule.m_rule;
     if (dRule->GetCaption(0) != nullptr)
       m_mainTextType = dRule->GetCaptionTextType(0);
 
@@ -326,15 +325,13 @@ bool InitStylist(FeatureType & f, int8_t deviceLang, int const zoomLevel, bool b
       !ftypes::IsBuildingChecker::Instance()(types))
     return false;
 
-  drule::KeysT keys;
-  auto const geomType = feature::GetDrawRule(types, zoomLevel, keys);
+  drule::PreparedRulesT rules;
+  auto const geomType = feature::GetDrawRules(f, types, zoomLevel, rules);
 
-  feature::FilterRulesByRuntimeSelector(f, zoomLevel, keys);
-
-  if (keys.empty())
+  if (rules.empty())
     return false;
 
-  drule::MakeUnique(keys);
+  drule::MakeUnique(rules);
 
   if (geomType.second)
     s.RaiseCoastlineFlag();
@@ -357,13 +354,13 @@ bool InitStylist(FeatureType & f, int8_t deviceLang, int const zoomLevel, bool b
     return false;
   }
 
-  Aggregator aggregator(f, mainGeomType, zoomLevel, static_cast<int>(keys.size()));
-  aggregator.AggregateKeys(keys);
+  Aggregator aggregator(f, mainGeomType, zoomLevel, static_cast<int>(rules.size()));
+  aggregator.AggregateRules(rules);
 
   CaptionDescription & descr = s.GetCaptionDescriptionImpl();
   descr.Init(f, deviceLang, zoomLevel, mainGeomType, aggregator.m_mainTextType, aggregator.m_auxCaptionFound);
 
-  aggregator.AggregateStyleFlags(keys, descr.IsNameExists());
+  aggregator.AggregateStyleFlags(rules, descr.IsNameExists());
 
   if (aggregator.m_pointStyleFound)
     s.RaisePointStyleFlag();
@@ -377,16 +374,14 @@ bool InitStylist(FeatureType & f, int8_t deviceLang, int const zoomLevel, bool b
 
 double GetFeaturePriority(FeatureType & f, int const zoomLevel)
 {
-  drule::KeysT keys;
+  drule::PreparedRulesT rules;
   std::pair<int, bool> const geomType =
-      feature::GetDrawRule(feature::TypesHolder(f), zoomLevel, keys);
-
-  feature::FilterRulesByRuntimeSelector(f, zoomLevel, keys);
+      feature::GetDrawRules(f, feature::TypesHolder(f), zoomLevel, rules);
 
   auto const mainGeomType = feature::GeomType(geomType.first);
 
-  Aggregator aggregator(f, mainGeomType, zoomLevel, static_cast<int>(keys.size()));
-  aggregator.AggregateKeys(keys);
+  Aggregator aggregator(f, mainGeomType, zoomLevel, static_cast<int>(rules.size()));
+  aggregator.AggregateRules(rules);
 
   double maxPriority = kMinPriority;
   for (auto const & rule : aggregator.m_rules)
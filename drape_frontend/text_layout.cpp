@@ -6,9 +6,13 @@
 #include "drape/glsl_func.hpp"
 #include "drape/overlay_handle.hpp"
 
+#include "base/lru_cache.hpp"
+
 #include <algorithm>
 #include <iterator>
+#include <mutex>
 #include <numeric>
+#include <string>
 
 namespace df
 {
@@ -184,6 +188,48 @@ void SplitText(strings::UniString & visText, buffer_vector<size_t, 2> & delimInd
   delimIndexes.push_back(count);
 }
 
+struct ShapedText
+{
+  strings::UniString m_visibleText;
+  // Text is wrapped only if bidi reordering does not change it.
+  bool m_isWrappable = false;
+  strings::UniString m_wrappedText;
+  buffer_vector<size_t, 2> m_wrapDelimIndexes;
+};
+
+// The same names are laid out for every tile and zoom level they are visible at and by all
+// the backend threads, so the results of bidi reordering and line breaking are shared.
+// Glyph regions are not cached, they depend on the state of the textures.
+ShapedText GetShapedText(strings::UniString const & text)
+{
+  size_t constexpr kMaxCachedTexts = 4096;
+  static std::mutex cacheMutex;
+  static LruCache<std::string, ShapedText> cache(kMaxCachedTexts);
+
+  auto const key = strings::ToUtf8(text);
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    bool found = false;
+    auto const & cached = cache.Find(key, found);
+    if (found)
+      return cached;
+  }
+
+  ShapedText shaped;
+  shaped.m_visibleText = bidi::log2vis(text);
+  shaped.m_isWrappable = shaped.m_visibleText == text;
+  if (shaped.m_isWrappable)
+  {
+    shaped.m_wrappedText = shaped.m_visibleText;
+    SplitText(shaped.m_wrappedText, shaped.m_wrapDelimIndexes);
+  }
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  bool found = false;
+  cache.Find(key, found) = shaped;
+  return shaped;
+}
+
 class XLayouter
 {
 public:
@@ -350,14 +396,18 @@ StraightTextLayout::StraightTextLayout(strings::UniString const & text, float fo
                                        ref_ptr<dp::TextureManager> textures, dp::Anchor anchor,
                                        bool forceNoWrap)
 {
-  strings::UniString visibleText = bidi::log2vis(text);
+  auto const shaped = GetShapedText(text);
   buffer_vector<size_t, 2> delimIndexes;
-  if (visibleText == text && !forceNoWrap)
-    SplitText(visibleText, delimIndexes);
+  if (shaped.m_isWrappable && !forceNoWrap)
+  {
+    delimIndexes = shaped.m_wrapDelimIndexes;
+    TBase::Init(shaped.m_wrappedText, fontSize, isSdf, textures);
+  }
   else
-    delimIndexes.push_back(visibleText.size());
-
-  TBase::Init(visibleText, fontSize, isSdf, textures);
+  {
+    delimIndexes.push_back(shaped.m_visibleText.size());
+    TBase::Init(shaped.m_visibleText, fontSize, isSdf, textures);
+  }
   CalculateOffsets(anchor, m_textSizeRatio, m_metrics, delimIndexes, m_offsets, m_pixelSize, m_rowsCount);
 }
 
@@ -427,7 +477,7 @@ PathTextLayout::PathTextLayout(m2::PointD const & tileCenter, strings::UniString
                                float fontSize, bool isSdf, ref_ptr<dp::TextureManager> textures)
   : m_tileCenter(tileCenter)
 {
-  Init(bidi::log2vis(text), fontSize, isSdf, textures);
+  Init(GetShapedText(text).m_visibleText, fontSize, isSdf, textures);
 }
 
 void PathTextLayout::CacheStaticGeometry(dp::TextureManager::ColorRegion const & colorRegion,
@@ -0,0 +1,108 @@
+#include "drape_frontend/tile_geometry_cache.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace df
+{
+TileGeometryCache::TileGeometryCache(size_t maxTilesCount)
+  : m_maxTilesCount(maxTilesCount)
+{}
+
+uint64_t TileGeometryCache::GetGeneration() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_generation;
+}
+
+TileGeometryCache::TileGeometryPtr TileGeometryCache::Find(TileKey const & tileKey)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto const it = m_index.find(tileKey);
+  if (it == m_index.end())
+    return nullptr;
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->second;
+}
+
+void TileGeometryCache::Put(TileKey const & tileKey, uint64_t generation,
+                            TileGeometryPtr && geometry)
+{
+  ASSERT(geometry != nullptr, ());
+  if (!IsEnabled())
+    return;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (generation != m_generation)
+    return;
+
+  // Generations are not a part of the cache key.
+  TileKey const key(tileKey.m_x, tileKey.m_y, tileKey.m_zoomLevel);
+  auto const it = m_index.find(key);
+  if (it != m_index.end())
+  {
+    it->second->second = std::move(geometry);
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+
+  if (m_entries.size() >= m_maxTilesCount)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  m_entries.emplace_front(key, std::move(geometry));
+  m_index.emplace(key, m_entries.begin());
+}
+
+void TileGeometryCache::Invalidate(TTilesCollection const & tiles)
+{
+  std::vector<m2::RectD> rects;
+  rects.reserve(tiles.size());
+  for (auto const & tileKey : tiles)
+    rects.push_back(tileKey.GetGlobalRect(false /* clipByDataMaxZoom */));
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_generation;
+
+  // Tiles of the other zoom levels which cover the invalidated tiles are outdated as well.
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    m2::RectD const rect = it->first.GetGlobalRect(false /* clipByDataMaxZoom */);
+    bool const isOutdated = std::any_of(rects.cbegin(), rects.cend(), [&rect](m2::RectD const & r)
+    {
+      return r.IsIntersect(rect);
+    });
+
+    if (isOutdated)
+    {
+      m_index.erase(it->first);
+      it = m_entries.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void TileGeometryCache::InvalidateAll()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_generation;
+  m_entries.clear();
+  m_index.clear();
+}
+
+size_t TileGeometryCache::GetTilesCount() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+}  // namespace df
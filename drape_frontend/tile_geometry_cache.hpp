@@ -0,0 +1,68 @@
+#pragma once
+
+#include "drape_frontend/map_shape.hpp"
+#include "drape_frontend/tile_key.hpp"
+#include "drape_frontend/tile_utils.hpp"
+#include "drape_frontend/traffic_generator.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+
+namespace df
+{
+// Keeps style-resolved shapes of the recently read tiles. When a tile is requested again,
+// e.g. the map is panned back and forth, the shapes are sent to the batchers again and
+// reading of features and styling are skipped. Tiles are evicted in LRU order.
+// The cache is accessed from the reading threads.
+class TileGeometryCache
+{
+public:
+  struct TileGeometry
+  {
+    std::set<MwmSet::MwmId> m_mwms;
+    TMapShapes m_shapes;
+    TMapShapes m_overlayShapes;
+    TrafficSegmentsGeometry m_trafficGeometry;
+  };
+
+  using TileGeometryPtr = std::shared_ptr<TileGeometry const>;
+
+  // |maxTilesCount| equal to zero disables the cache.
+  explicit TileGeometryCache(size_t maxTilesCount);
+
+  bool IsEnabled() const { return m_maxTilesCount != 0; }
+
+  // Generation is increased on every invalidation. Geometry is put to the cache with
+  // the generation which was actual at the beginning of the tile reading, so the geometry
+  // which has been read with outdated data or style is dropped.
+  uint64_t GetGeneration() const;
+
+  // Returns nullptr if there's no geometry for |tileKey|. Generations of |tileKey| are ignored.
+  TileGeometryPtr Find(TileKey const & tileKey);
+  void Put(TileKey const & tileKey, uint64_t generation, TileGeometryPtr && geometry);
+
+  void Invalidate(TTilesCollection const & tiles);
+  void InvalidateAll();
+
+  size_t GetTilesCount() const;
+
+private:
+  using Entries = std::list<std::pair<TileKey, TileGeometryPtr>>;
+
+  size_t const m_maxTilesCount;
+
+  mutable std::mutex m_mutex;
+  // The most recently used tiles are at the front.
+  Entries m_entries;
+  std::map<TileKey, Entries::iterator> m_index;
+  uint64_t m_generation = 0;
+};
+}  // namespace df
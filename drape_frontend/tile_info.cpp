@@ -10,18 +10,29 @@
 
 #include "platform/preferred_languages.hpp"
 
+#include "base/profiler.hpp"
 #include "base/scope_guard.hpp"
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <exception>
 #include <functional>
+#include <future>
+#include <utility>
+#include <vector>
 
 using namespace std::placeholders;
 
 namespace df
 {
-TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext)
+TileInfo::TileInfo(drape_ptr<EngineContext> && engineContext,
+                   ref_ptr<TileGeometryCache> geometryCache,
+                   ref_ptr<base::thread_pool::computational::ThreadPool> drawingPool)
   : m_context(std::move(engineContext))
+  , m_geometryCache(geometryCache)
+  , m_drawingPool(drawingPool)
   , m_isCanceled(false)
 {}
 
@@ -55,34 +66,138 @@ void TileInfo::ReadFeatureIndex(MapDataProvider const & model)
 
 void TileInfo::ReadFeatures(MapDataProvider const & model)
 {
+  PROFILER_SCOPE("TileInfo::ReadFeatures");
 #if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
   DrapeMeasurer::Instance().StartTileReading();
 #endif
+  auto const startTime = std::chrono::steady_clock::now();
   m_context->BeginReadTile();
 
   // Reading can be interrupted by exception throwing
   SCOPE_GUARD(ReleaseReadTile, std::bind(&EngineContext::EndReadTile, m_context.get()));
 
+  if (m_geometryCache == nullptr || !m_geometryCache->IsEnabled())
+  {
+    ReadFeaturesImpl(model);
+  }
+  else if (auto const geometry = m_geometryCache->Find(GetTileKey()))
+  {
+    CheckCanceled();
+    m_context->GetMetalineManager()->Update(geometry->m_mwms);
+    m_context->FlushCachedGeometry(*geometry);
+  }
+  else
+  {
+    uint64_t const cacheGeneration = m_geometryCache->GetGeneration();
+    m_context->StartRecording();
+    ReadFeaturesImpl(model);
+
+    auto recordedGeometry = m_context->FinishRecording();
+    if (!IsCancelled())
+    {
+      recordedGeometry->m_mwms = m_mwms;
+      m_geometryCache->Put(GetTileKey(), cacheGeneration, std::move(recordedGeometry));
+    }
+  }
+  // Interrupted readings are not taken into account.
+  DrapeMeasurer::Instance().AddTileReadLatency(std::chrono::steady_clock::now() - startTime);
+#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
+  DrapeMeasurer::Instance().EndTileReading();
+#endif
+}
+
+void TileInfo::ReadFeaturesImpl(MapDataProvider const & model)
+{
   ReadFeatureIndex(model);
   CheckCanceled();
 
   m_context->GetMetalineManager()->Update(m_mwms);
 
-  if (!m_featureInfo.empty())
+  if (m_featureInfo.empty())
+    return;
+
+  std::sort(m_featureInfo.begin(), m_featureInfo.end());
+  auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
+  RuleDrawer::TileState tileState;
+
+  // Features of a dense tile are split into contiguous chunks which are drawn in parallel.
+  // The current thread draws the first chunk.
+  size_t constexpr kMinDrawingChunkSize = 512;
+  size_t chunksCount = 1;
+  if (m_drawingPool != nullptr)
+  {
+    chunksCount = std::min(m_featureInfo.size() / kMinDrawingChunkSize,
+                           m_drawingPool->Size() + 1);
+    chunksCount = std::max(chunksCount, static_cast<size_t>(1));
+  }
+  size_t const chunkSize = (m_featureInfo.size() + chunksCount - 1) / chunksCount;
+
+  std::vector<std::future<void>> results;
+  results.reserve(chunksCount - 1);
+  std::vector<std::pair<size_t, size_t>> localChunks = {{0, chunkSize}};
+  for (size_t begin = chunkSize; begin < m_featureInfo.size(); begin += chunkSize)
+  {
+    size_t const end = std::min(begin + chunkSize, m_featureInfo.size());
+    auto result = m_drawingPool->Submit([this, &model, deviceLang, &tileState, begin, end]()
+    {
+      DrawFeatures(model, deviceLang, make_ref(&tileState), begin, end);
+    });
+
+    // The pool is stopped.
+    if (!result.valid())
+      localChunks.emplace_back(begin, end);
+    else
+      results.push_back(std::move(result));
+  }
+
+  std::exception_ptr exception;
+  try
+  {
+    for (auto const & chunk : localChunks)
+      DrawFeatures(model, deviceLang, make_ref(&tileState), chunk.first, chunk.second);
+  }
+  catch (...)
   {
-    std::sort(m_featureInfo.begin(), m_featureInfo.end());
-    auto const deviceLang = StringUtf8Multilang::GetLangIndex(languages::GetCurrentNorm());
-    RuleDrawer drawer(std::bind(&TileInfo::InitStylist, this, deviceLang, _1, _2),
-                      std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
-                      model.GetFilter(), make_ref(m_context));
-    model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), m_featureInfo);
+    exception = std::current_exception();
+  }
+
+  // Chunks refer to the local tile state, so all of them are waited for before rethrowing.
+  for (auto & result : results)
+    result.wait();
+  if (exception)
+    std::rethrow_exception(exception);
+  for (auto & result : results)
+    result.get();
+
 #ifdef DRAW_TILE_NET
-    drawer.DrawTileNet();
+  RuleDrawer drawer(std::bind(&TileInfo::InitStylist, this, deviceLang, _1, _2),
+                    std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
+                    model.GetFilter(), make_ref(m_context), make_ref(&tileState));
+  drawer.DrawTileNet();
 #endif
+}
+
+void TileInfo::DrawFeatures(MapDataProvider const & model, int8_t deviceLang,
+                            ref_ptr<RuleDrawer::TileState> tileState, size_t begin, size_t end)
+{
+  RuleDrawer drawer(std::bind(&TileInfo::InitStylist, this, deviceLang, _1, _2),
+                    std::bind(&TileInfo::IsCancelled, this), model.m_isCountryLoadedByName,
+                    model.GetFilter(), make_ref(m_context), tileState);
+
+  // Features are read by chunks to stop reading of a cancelled tile without loading
+  // the rest of its features.
+  size_t constexpr kReadingChunkSize = 64;
+  std::vector<FeatureID> chunk;
+  chunk.reserve(kReadingChunkSize);
+  for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += kReadingChunkSize)
+  {
+    if (IsCancelled())
+      break;
+
+    size_t const chunkEnd = std::min(chunkBegin + kReadingChunkSize, end);
+    chunk.assign(m_featureInfo.begin() + chunkBegin, m_featureInfo.begin() + chunkEnd);
+    model.ReadFeatures(std::bind<void>(std::ref(drawer), _1), chunk);
   }
-#if defined(DRAPE_MEASURER_BENCHMARK) && defined(TILES_STATISTIC)
-  DrapeMeasurer::Instance().EndTileReading();
-#endif
 }
 
 void TileInfo::Cancel()
@@ -2,6 +2,8 @@
 
 #include "drape_frontend/custom_features_context.hpp"
 #include "drape_frontend/engine_context.hpp"
+#include "drape_frontend/rule_drawer.hpp"
+#include "drape_frontend/tile_geometry_cache.hpp"
 #include "drape_frontend/tile_key.hpp"
 
 #include "indexer/feature_decl.hpp"
@@ -15,6 +17,17 @@
 
 class FeatureType;
 
+namespace base
+{
+namespace thread_pool
+{
+namespace computational
+{
+class ThreadPool;
+}  // namespace computational
+}  // namespace thread_pool
+}  // namespace base
+
 namespace df
 {
 class MapDataProvider;
@@ -25,7 +38,8 @@ class TileInfo
 public:
   DECLARE_EXCEPTION(ReadCanceledException, RootException);
 
-  TileInfo(drape_ptr<EngineContext> && engineContext);
+  TileInfo(drape_ptr<EngineContext> && engineContext, ref_ptr<TileGeometryCache> geometryCache,
+           ref_ptr<base::thread_pool::computational::ThreadPool> drawingPool);
 
   void ReadFeatures(MapDataProvider const & model);
   void Cancel();
@@ -37,6 +51,9 @@ public:
 
 private:
   void ReadFeatureIndex(MapDataProvider const & model);
+  void ReadFeaturesImpl(MapDataProvider const & model);
+  void DrawFeatures(MapDataProvider const & model, int8_t deviceLang,
+                    ref_ptr<RuleDrawer::TileState> tileState, size_t begin, size_t end);
   void InitStylist(int8_t deviceLang, FeatureType & f, Stylist & s);
   void CheckCanceled() const;
   bool DoNeedReadIndex() const;
@@ -45,6 +62,8 @@ private:
 
 private:
   drape_ptr<EngineContext> m_context;
+  ref_ptr<TileGeometryCache> m_geometryCache;
+  ref_ptr<base::thread_pool::computational::ThreadPool> m_drawingPool;
   std::vector<FeatureID> m_featureInfo;
   std::atomic<bool> m_isCanceled;
   std::set<MwmSet::MwmId> m_mwms;
@@ -256,7 +256,7 @@ void TrafficGenerator::FlushSegmentsGeometry(ref_ptr<dp::GraphicsContext> contex
                     std::move(renderBucket));
     });
 
-    GenerateSegmentsGeometry(context, mwmId, tileKey, g.second, coloringIt->second, textures);
+    GenerateSegmentsGeometry(context, mwmId, tileKey, g.second, *coloringIt->second, textures);
 
     for (auto const & roadClass : kRoadClasses)
       m_batchersPool->ReleaseBatcher(context, TrafficBatcherKey(mwmId, tileKey, roadClass));
@@ -8,7 +8,11 @@
 
 #include "indexer/scales.hpp"
 
+#include "base/stl_helpers.hpp"
+
 #include <algorithm>
+#include <unordered_set>
+#include <utility>
 
 namespace df
 {
@@ -20,23 +24,122 @@ UserMarkGenerator::UserMarkGenerator(TFlushFn const & flushFn)
   ASSERT(m_flushFn, ());
 }
 
+namespace
+{
+template <typename Fn>
+void ForEachMarkTile(UserMarkRenderParams const & params, Fn && fn)
+{
+  for (int zoomLevel = params.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
+    fn(GetTileKeyByPoint(params.m_pivot, zoomLevel));
+}
+
+template <typename Fn>
+void ForEachLineTile(UserLineRenderParams const & params, int startZoom, Fn && fn)
+{
+  for (int zoomLevel : kLineIndexingLevels)
+  {
+    if (zoomLevel < startZoom)
+      continue;
+    // Process spline by segments that are no longer than tile size.
+    double const maxLength = mercator::Bounds::kRangeX / (1 << (zoomLevel - 1));
+
+    df::ProcessSplineSegmentRects(params.m_spline, maxLength,
+                                  [&](m2::RectD const & segmentRect)
+    {
+      CalcTilesCoverage(segmentRect, zoomLevel, [&](int tileX, int tileY)
+      {
+        fn(TileKey(tileX, tileY, zoomLevel));
+      });
+      return true;
+    });
+  }
+}
+}  // namespace
+
 void UserMarkGenerator::RemoveGroup(kml::MarkGroupId groupId)
 {
   m_groupsVisibility.erase(groupId);
-  m_groups.erase(groupId);
-  UpdateIndex(groupId);
+
+  auto const it = m_groups.find(groupId);
+  if (it == m_groups.end())
+    return;
+
+  RemovedIds removedIds;
+  for (auto const markId : it->second->m_markIds)
+    UnindexMark(markId, groupId, removedIds);
+  for (auto const lineId : it->second->m_lineIds)
+    UnindexLine(lineId, groupId, removedIds);
+  RemoveFromIndex(removedIds);
+
+  m_groups.erase(it);
 }
 
 void UserMarkGenerator::SetGroup(kml::MarkGroupId groupId, drape_ptr<IDCollections> && ids)
 {
+  // Only the marks and lines which left the group or came into it change the index, the tiles of
+  // the other ones stay as they are.
+  RemovedIds removedIds;
+  auto const it = m_groups.find(groupId);
+  if (it != m_groups.end())
+  {
+    std::unordered_set<kml::MarkId> const markIds(ids->m_markIds.cbegin(), ids->m_markIds.cend());
+    for (auto const markId : it->second->m_markIds)
+    {
+      if (markIds.count(markId) == 0)
+        UnindexMark(markId, groupId, removedIds);
+    }
+
+    std::unordered_set<kml::TrackId> const lineIds(ids->m_lineIds.cbegin(), ids->m_lineIds.cend());
+    for (auto const lineId : it->second->m_lineIds)
+    {
+      if (lineIds.count(lineId) == 0)
+        UnindexLine(lineId, groupId, removedIds);
+    }
+  }
+
+  // Marks and lines which moved from the other groups are removed from their old groups.
+  for (auto const markId : ids->m_markIds)
+  {
+    auto const indexedIt = m_indexedMarks.find(markId);
+    if (indexedIt != m_indexedMarks.end() && indexedIt->second != groupId)
+      UnindexMark(markId, indexedIt->second, removedIds);
+  }
+  for (auto const lineId : ids->m_lineIds)
+  {
+    auto const indexedIt = m_indexedLines.find(lineId);
+    if (indexedIt != m_indexedLines.end() && indexedIt->second != groupId)
+      UnindexLine(lineId, indexedIt->second, removedIds);
+  }
+  RemoveFromIndex(removedIds);
+
+  for (auto const markId : ids->m_markIds)
+    IndexMark(markId, groupId);
+  for (auto const lineId : ids->m_lineIds)
+    IndexLine(lineId, groupId);
+
   m_groups[groupId] = std::move(ids);
-  UpdateIndex(groupId);
 }
 
 void UserMarkGenerator::SetRemovedUserMarks(drape_ptr<IDCollections> && ids)
 {
   if (ids == nullptr)
     return;
+
+  RemovedIds removedIds;
+  for (auto const & id : ids->m_markIds)
+  {
+    auto const indexedIt = m_indexedMarks.find(id);
+    if (indexedIt != m_indexedMarks.end())
+      UnindexMark(id, indexedIt->second, removedIds);
+  }
+  for (auto const & id : ids->m_lineIds)
+  {
+    auto const indexedIt = m_indexedLines.find(id);
+    if (indexedIt != m_indexedLines.end())
+      UnindexLine(id, indexedIt->second, removedIds);
+  }
+  RemoveFromIndex(removedIds);
+
   for (auto const & id : ids->m_markIds)
     m_marks.erase(id);
   for (auto const & id : ids->m_lineIds)
@@ -53,6 +156,20 @@ void UserMarkGenerator::SetJustCreatedUserMarks(drape_ptr<IDCollections> && ids)
 
 void UserMarkGenerator::SetUserMarks(drape_ptr<UserMarksRenderCollection> && marks)
 {
+  // Updated marks may have moved or changed their min zoom, so they are reindexed by their new
+  // params in the same groups.
+  RemovedIds removedIds;
+  std::vector<std::pair<kml::MarkId, kml::MarkGroupId>> reindexed;
+  for (auto const & pair : *marks)
+  {
+    auto const indexedIt = m_indexedMarks.find(pair.first);
+    if (indexedIt == m_indexedMarks.end())
+      continue;
+    reindexed.emplace_back(pair.first, indexedIt->second);
+    UnindexMark(pair.first, indexedIt->second, removedIds);
+  }
+  RemoveFromIndex(removedIds);
+
   for (auto & pair : *marks)
   {
     auto it = m_marks.find(pair.first);
@@ -61,10 +178,25 @@ void UserMarkGenerator::SetUserMarks(drape_ptr<UserMarksRenderCollection> && mar
     else
       m_marks.emplace(pair.first, std::move(pair.second));
   }
+
+  for (auto const & [markId, groupId] : reindexed)
+    IndexMark(markId, groupId);
 }
 
 void UserMarkGenerator::SetUserLines(drape_ptr<UserLinesRenderCollection> && lines)
 {
+  RemovedIds removedIds;
+  std::vector<std::pair<kml::TrackId, kml::MarkGroupId>> reindexed;
+  for (auto const & pair : *lines)
+  {
+    auto const indexedIt = m_indexedLines.find(pair.first);
+    if (indexedIt == m_indexedLines.end())
+      continue;
+    reindexed.emplace_back(pair.first, indexedIt->second);
+    UnindexLine(pair.first, indexedIt->second, removedIds);
+  }
+  RemoveFromIndex(removedIds);
+
   for (auto & pair : *lines)
   {
     auto it = m_lines.find(pair.first);
@@ -73,64 +205,113 @@ void UserMarkGenerator::SetUserLines(drape_ptr<UserLinesRenderCollection> && lin
     else
       m_lines.emplace(pair.first, std::move(pair.second));
   }
+
+  for (auto const & [lineId, groupId] : reindexed)
+    IndexLine(lineId, groupId);
 }
 
-void UserMarkGenerator::UpdateIndex(kml::MarkGroupId groupId)
+void UserMarkGenerator::IndexMark(kml::MarkId markId, kml::MarkGroupId groupId)
 {
-  for (auto & tileGroups : m_index)
+  if (m_indexedMarks.count(markId) != 0)
+    return;
+
+  auto const it = m_marks.find(markId);
+  if (it == m_marks.end())
+    return;
+
+  ForEachMarkTile(*it->second, [&](TileKey const & tileKey)
   {
-    auto itGroupIndexes = tileGroups.second->find(groupId);
-    if (itGroupIndexes != tileGroups.second->end())
-    {
-      itGroupIndexes->second->m_markIds.clear();
-      itGroupIndexes->second->m_lineIds.clear();
-    }
-  }
+    GetIdCollection(tileKey, groupId)->m_markIds.push_back(markId);
+  });
+  m_indexedMarks.emplace(markId, groupId);
+}
 
-  auto const groupIt = m_groups.find(groupId);
-  if (groupIt == m_groups.end())
+void UserMarkGenerator::IndexLine(kml::TrackId lineId, kml::MarkGroupId groupId)
+{
+  if (m_indexedLines.count(lineId) != 0)
     return;
 
-  IDCollections & idCollection = *groupIt->second;
+  auto const it = m_lines.find(lineId);
+  if (it == m_lines.end())
+    return;
 
-  for (auto markId : idCollection.m_markIds)
+  UserLineRenderParams const & params = *it->second;
+  ForEachLineTile(params, GetNearestLineIndexZoom(params.m_minZoom), [&](TileKey const & tileKey)
   {
-    UserMarkRenderParams const & params = *m_marks[markId];
-    for (int zoomLevel = params.m_minZoom; zoomLevel <= scales::GetUpperScale(); ++zoomLevel)
-    {
-      TileKey const tileKey = GetTileKeyByPoint(params.m_pivot, zoomLevel);
-      auto groupIDs = GetIdCollection(tileKey, groupId);
-      groupIDs->m_markIds.push_back(markId);
-    }
-  }
+    // Neighbouring segments of a line cover the same tiles.
+    auto & lineIds = GetIdCollection(tileKey, groupId)->m_lineIds;
+    if (lineIds.empty() || lineIds.back() != lineId)
+      lineIds.push_back(lineId);
+  });
+  m_indexedLines.emplace(lineId, groupId);
+}
 
-  for (auto lineId : idCollection.m_lineIds)
+void UserMarkGenerator::UnindexMark(kml::MarkId markId, kml::MarkGroupId groupId,
+                                    RemovedIds & removedIds)
+{
+  auto const indexedIt = m_indexedMarks.find(markId);
+  if (indexedIt == m_indexedMarks.end() || indexedIt->second != groupId)
+    return;
+  m_indexedMarks.erase(indexedIt);
+
+  auto const it = m_marks.find(markId);
+  CHECK(it != m_marks.end(), (markId));
+  ForEachMarkTile(*it->second, [&](TileKey const & tileKey)
   {
-    UserLineRenderParams const & params = *m_lines[lineId];
+    removedIds[std::make_pair(tileKey, groupId)].first.insert(markId);
+  });
+}
 
-    int const startZoom = GetNearestLineIndexZoom(params.m_minZoom);
-    for (int zoomLevel : kLineIndexingLevels)
-    {
-      if (zoomLevel < startZoom)
-        continue;
-      // Process spline by segments that are no longer than tile size.
-      double const maxLength = mercator::Bounds::kRangeX / (1 << (zoomLevel - 1));
+void UserMarkGenerator::UnindexLine(kml::TrackId lineId, kml::MarkGroupId groupId,
+                                    RemovedIds & removedIds)
+{
+  auto const indexedIt = m_indexedLines.find(lineId);
+  if (indexedIt == m_indexedLines.end() || indexedIt->second != groupId)
+    return;
+  m_indexedLines.erase(indexedIt);
 
-      df::ProcessSplineSegmentRects(params.m_spline, maxLength,
-                                    [&](m2::RectD const & segmentRect)
-      {
-        CalcTilesCoverage(segmentRect, zoomLevel, [&](int tileX, int tileY)
-        {
-          TileKey const tileKey(tileX, tileY, zoomLevel);
-          auto groupIDs = GetIdCollection(tileKey, groupId);
-          groupIDs->m_lineIds.push_back(lineId);
-        });
-        return true;
-      });
+  auto const it = m_lines.find(lineId);
+  CHECK(it != m_lines.end(), (lineId));
+  UserLineRenderParams const & params = *it->second;
+  ForEachLineTile(params, GetNearestLineIndexZoom(params.m_minZoom), [&](TileKey const & tileKey)
+  {
+    removedIds[std::make_pair(tileKey, groupId)].second.insert(lineId);
+  });
+}
+
+void UserMarkGenerator::RemoveFromIndex(RemovedIds const & removedIds)
+{
+  for (auto const & [key, ids] : removedIds)
+  {
+    auto const tileIt = m_index.find(key.first);
+    if (tileIt == m_index.end())
+      continue;
+
+    auto & tileGroups = *tileIt->second;
+    auto const groupIt = tileGroups.find(key.second);
+    if (groupIt == tileGroups.end())
+      continue;
+
+    auto & groupIds = *groupIt->second;
+    auto const & markIds = ids.first;
+    auto const & lineIds = ids.second;
+    if (!markIds.empty())
+    {
+      base::EraseIf(groupIds.m_markIds,
+                    [&markIds](kml::MarkId id) { return markIds.count(id) != 0; });
+    }
+    if (!lineIds.empty())
+    {
+      base::EraseIf(groupIds.m_lineIds,
+                    [&lineIds](kml::TrackId id) { return lineIds.count(id) != 0; });
     }
-  }
 
-  CleanIndex();
+    if (!groupIds.IsEmpty())
+      continue;
+    tileGroups.erase(groupIt);
+    if (tileGroups.empty())
+      m_index.erase(tileIt);
+  }
 }
 
 ref_ptr<IDCollections> UserMarkGenerator::GetIdCollection(TileKey const & tileKey, kml::MarkGroupId groupId)
@@ -164,28 +345,6 @@ ref_ptr<IDCollections> UserMarkGenerator::GetIdCollection(TileKey const & tileKe
   return groupIDs;
 }
 
-void UserMarkGenerator::CleanIndex()
-{
-  for (auto tileIt = m_index.begin(); tileIt != m_index.end();)
-  {
-    if (tileIt->second->empty())
-      tileIt = m_index.erase(tileIt);
-    else
-      ++tileIt;
-  }
-
-  for (auto & tileGroups : m_index)
-  {
-    for (auto groupIt = tileGroups.second->begin(); groupIt != tileGroups.second->end();)
-    {
-      if (groupIt->second->IsEmpty())
-        groupIt = tileGroups.second->erase(groupIt);
-      else
-        ++groupIt;
-    }
-  }
-}
-
 void UserMarkGenerator::SetGroupVisibility(kml::MarkGroupId groupId, bool isVisible)
 {
   if (isVisible)
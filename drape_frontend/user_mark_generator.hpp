@@ -9,6 +9,9 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace df
@@ -36,10 +39,19 @@ public:
                                  ref_ptr<dp::TextureManager> textures);
 
 private:
-  void UpdateIndex(kml::MarkGroupId groupId);
+  // Ids of the marks and lines to be removed from the tiles of the groups. They are collected
+  // first, so that every collection of a tile is filtered once.
+  using RemovedIds = std::map<std::pair<TileKey, kml::MarkGroupId>,
+                              std::pair<std::unordered_set<kml::MarkId>,
+                                        std::unordered_set<kml::TrackId>>>;
+
+  void IndexMark(kml::MarkId markId, kml::MarkGroupId groupId);
+  void IndexLine(kml::TrackId lineId, kml::MarkGroupId groupId);
+  void UnindexMark(kml::MarkId markId, kml::MarkGroupId groupId, RemovedIds & removedIds);
+  void UnindexLine(kml::TrackId lineId, kml::MarkGroupId groupId, RemovedIds & removedIds);
+  void RemoveFromIndex(RemovedIds const & removedIds);
 
   ref_ptr<IDCollections> GetIdCollection(TileKey const & tileKey, kml::MarkGroupId groupId);
-  void CleanIndex();
 
   int GetNearestLineIndexZoom(int zoom) const;
 
@@ -60,6 +72,9 @@ private:
   UserLinesRenderCollection m_lines;
 
   MarksIndex m_index;
+  // Groups of the marks and lines which are in |m_index|.
+  std::unordered_map<kml::MarkId, kml::MarkGroupId> m_indexedMarks;
+  std::unordered_map<kml::TrackId, kml::MarkGroupId> m_indexedLines;
 
   TFlushFn m_flushFn;
 };
@@ -1,27 +1,42 @@
 #include "editor/editable_feature_source.hpp"
 
-#include "editor/osm_editor.hpp"
-
 using namespace std;
 
+EditableFeatureSource::EditableFeatureSource(MwmSet::MwmHandle const & handle)
+  : FeatureSource(handle)
+{
+  osm::Editor const & editor = osm::Editor::Instance();
+  m_editsVersion = editor.GetEditsVersion();
+  m_edits = editor.GetMwmEdits(m_handle.GetId());
+}
+
 FeatureStatus EditableFeatureSource::GetFeatureStatus(uint32_t index) const
 {
-  osm::Editor & editor = osm::Editor::Instance();
-  return editor.GetFeatureStatus(m_handle.GetId(), index);
+  return GetEdits().GetFeatureStatus(index);
 }
 
 unique_ptr<FeatureType> EditableFeatureSource::GetModifiedFeature(uint32_t index) const
 {
-  osm::Editor & editor = osm::Editor::Instance();
-  auto const emo = editor.GetEditedFeature(FeatureID(m_handle.GetId(), index));
+  auto const * emo = GetEdits().GetEditedFeature(index);
   if (emo)
     return make_unique<FeatureType>(*emo);
   return {};
 }
 
-void EditableFeatureSource::ForEachAdditionalFeature(m2::RectD const & rect, int scale,
+void EditableFeatureSource::ForEachAdditionalFeature(m2::RectD const & rect, int /* scale */,
                                                      function<void(uint32_t)> const & fn) const
 {
-  osm::Editor & editor = osm::Editor::Instance();
-  editor.ForEachCreatedFeature(m_handle.GetId(), fn, rect, scale);
+  GetEdits().ForEachCreatedFeature(fn, rect);
+}
+
+osm::Editor::MwmEdits const & EditableFeatureSource::GetEdits() const
+{
+  osm::Editor const & editor = osm::Editor::Instance();
+  auto const editsVersion = editor.GetEditsVersion();
+  if (editsVersion != m_editsVersion)
+  {
+    m_editsVersion = editsVersion;
+    m_edits = editor.GetMwmEdits(m_handle.GetId());
+  }
+  return m_edits;
 }
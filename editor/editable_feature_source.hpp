@@ -1,5 +1,7 @@
 #pragma once
 
+#include "editor/osm_editor.hpp"
+
 #include "indexer/feature.hpp"
 #include "indexer/feature_source.hpp"
 #include "indexer/mwm_set.hpp"
@@ -10,16 +12,24 @@
 #include <functional>
 #include <memory>
 
+// Note: this class is NOT thread-safe.
 class EditableFeatureSource final : public FeatureSource
 {
 public:
-  explicit EditableFeatureSource(MwmSet::MwmHandle const & handle) : FeatureSource(handle) {}
+  explicit EditableFeatureSource(MwmSet::MwmHandle const & handle);
 
   // FeatureSource overrides:
   FeatureStatus GetFeatureStatus(uint32_t index) const override;
   std::unique_ptr<FeatureType> GetModifiedFeature(uint32_t index) const override;
   void ForEachAdditionalFeature(m2::RectD const & rect, int scale,
                                 std::function<void(uint32_t)> const & fn) const override;
+
+private:
+  // Takes the edits of the mwm again if the editor has changed them.
+  osm::Editor::MwmEdits const & GetEdits() const;
+
+  mutable osm::Editor::MwmEdits m_edits;
+  mutable uint64_t m_editsVersion = 0;
 };
 
 class EditableFeatureSourceFactory : public FeatureSourceFactory
@@ -424,6 +424,69 @@ void EditorTest::GetFeatureStatusTest()
   TEST_EQUAL(editor.GetFeatureStatus(emo.GetID()), FeatureStatus::Created, ());
 }
 
+void EditorTest::GetMwmEditsTest()
+{
+  auto & editor = osm::Editor::Instance();
+
+  auto const mwmId = ConstructTestMwm([](TestMwmBuilder & builder)
+  {
+    TestCafe cafe(m2::PointD(1.0, 1.0), "London Cafe", "en");
+    TestCafe unnamedCafe(m2::PointD(2.0, 2.0), "", "en");
+
+    builder.Add(cafe);
+    builder.Add(unnamedCafe);
+  });
+
+  auto const initialVersion = editor.GetEditsVersion();
+  auto const initialEdits = editor.GetMwmEdits(mwmId);
+
+  uint32_t modifiedIndex = 0;
+  ForEachCafeAtPoint(m_dataSource, m2::PointD(1.0, 1.0), [&](FeatureType & ft)
+  {
+    modifiedIndex = ft.GetID().m_index;
+
+    osm::EditableMapObject emo;
+    FillEditableMapObject(editor, ft, emo);
+    emo.SetBuildingLevels("1");
+    TEST_EQUAL(editor.SaveEditedFeature(emo), osm::Editor::SaveResult::SavedSuccessfully, ());
+  });
+
+  uint32_t deletedIndex = 0;
+  ForEachCafeAtPoint(m_dataSource, m2::PointD(2.0, 2.0), [&](FeatureType & ft)
+  {
+    deletedIndex = ft.GetID().m_index;
+    editor.DeleteFeature(ft.GetID());
+  });
+
+  osm::EditableMapObject created;
+  CreateCafeAtPoint({1.5, 1.5}, mwmId, created);
+
+  TEST_NOT_EQUAL(editor.GetEditsVersion(), initialVersion, ());
+
+  // Edits which were taken earlier are not changed.
+  TEST_EQUAL(initialEdits.GetFeatureStatus(modifiedIndex), FeatureStatus::Untouched, ());
+  TEST(!initialEdits.GetEditedFeature(modifiedIndex), ());
+
+  auto const edits = editor.GetMwmEdits(mwmId);
+  TEST_EQUAL(edits.GetFeatureStatus(modifiedIndex), FeatureStatus::Modified, ());
+  TEST_EQUAL(edits.GetFeatureStatus(deletedIndex), FeatureStatus::Deleted, ());
+  TEST_EQUAL(edits.GetFeatureStatus(created.GetID().m_index), FeatureStatus::Created, ());
+
+  auto const * modified = edits.GetEditedFeature(modifiedIndex);
+  TEST(modified, ());
+  TEST_EQUAL(modified->GetBuildingLevels(), "1", ());
+
+  std::vector<uint32_t> createdIndices;
+  edits.ForEachCreatedFeature([&](uint32_t index) { createdIndices.push_back(index); },
+                              m2::RectD(1.0, 1.0, 2.0, 2.0));
+  TEST_EQUAL(createdIndices, std::vector<uint32_t>{created.GetID().m_index}, ());
+
+  createdIndices.clear();
+  edits.ForEachCreatedFeature([&](uint32_t index) { createdIndices.push_back(index); },
+                              m2::RectD(3.0, 3.0, 4.0, 4.0));
+  TEST(createdIndices.empty(), ());
+}
+
 void EditorTest::IsFeatureUploadedTest()
 {
   auto & editor = osm::Editor::Instance();
@@ -1340,6 +1403,11 @@ UNIT_CLASS_TEST(EditorTest, GetFeatureStatusTest)
   EditorTest::GetFeatureStatusTest();
 }
 
+UNIT_CLASS_TEST(EditorTest, GetMwmEditsTest)
+{
+  EditorTest::GetMwmEditsTest();
+}
+
 UNIT_CLASS_TEST(EditorTest, IsFeatureUploadedTest)
 {
   EditorTest::IsFeatureUploadedTest();
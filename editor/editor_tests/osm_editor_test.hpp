@@ -34,6 +34,7 @@ public:
   void SetIndexTest();
   void GetEditedFeatureStreetTest();
   void GetFeatureStatusTest();
+  void GetMwmEditsTest();
   void IsFeatureUploadedTest();
   void DeleteFeatureTest();
   void ClearAllLocalEditsTest();
@@ -206,7 +206,7 @@ void Editor::LoadEdits()
   if (!m_storage->Load(doc))
     return;
 
-  m_features.Set(make_shared<FeaturesContainer>());
+  SetFeatures(make_shared<FeaturesContainer>());
   auto loadedFeatures = make_shared<FeaturesContainer>();
 
   for (auto const & mwm : doc.child(kXmlRootNode).children(kXmlMwmNode))
@@ -233,7 +233,7 @@ void Editor::LoadEdits()
   if (needRewriteEdits)
     SaveTransaction(loadedFeatures);
   else
-    m_features.Set(loadedFeatures);
+    SetFeatures(loadedFeatures);
 }
 
 bool Editor::Save(FeaturesContainer const & features) const
@@ -296,10 +296,16 @@ bool Editor::SaveTransaction(shared_ptr<FeaturesContainer> const & features)
   if (!Save(*features))
     return false;
 
-  m_features.Set(features);
+  SetFeatures(features);
   return true;
 }
 
+void Editor::SetFeatures(shared_ptr<FeaturesContainer> const & features)
+{
+  m_features.Set(features);
+  ++m_editsVersion;
+}
+
 void Editor::ClearAllLocalEdits()
 {
   CHECK_THREAD_CHECKER(MainThreadChecker, (""));
@@ -326,6 +332,21 @@ FeatureStatus Editor::GetFeatureStatus(FeatureID const & fid) const
   return GetFeatureStatusImpl(*features, fid.m_mwmId, fid.m_index);
 }
 
+Editor::MwmEdits Editor::GetMwmEdits(MwmSet::MwmId const & mwmId) const
+{
+  MwmEdits edits;
+  edits.m_features = m_features.Get();
+
+  auto const matchedMwm = edits.m_features->find(mwmId);
+  if (matchedMwm == edits.m_features->cend())
+    return edits;
+
+  edits.m_mwmFeatures = &matchedMwm->second;
+  for (auto const & index : matchedMwm->second)
+    edits.m_bitmap.set(index.first % MwmEdits::kBitmapSize);
+  return edits;
+}
+
 bool Editor::IsFeatureUploaded(MwmSet::MwmId const & mwmId, uint32_t index) const
 {
   auto const features = m_features.Get();
@@ -1276,6 +1297,47 @@ bool Editor::IsFeatureUploadedImpl(FeaturesContainer const & features, MwmSet::M
   return info && info->m_uploadStatus == kUploaded;
 }
 
+// Editor::MwmEdits --------------------------------------------------------------------------------
+FeatureStatus Editor::MwmEdits::GetFeatureStatus(uint32_t index) const
+{
+  auto const * featureInfo = GetFeatureTypeInfo(index);
+  return featureInfo != nullptr ? featureInfo->m_status : FeatureStatus::Untouched;
+}
+
+EditableMapObject const * Editor::MwmEdits::GetEditedFeature(uint32_t index) const
+{
+  auto const * featureInfo = GetFeatureTypeInfo(index);
+  return featureInfo != nullptr ? &featureInfo->m_object : nullptr;
+}
+
+void Editor::MwmEdits::ForEachCreatedFeature(FeatureIndexFunctor const & f,
+                                             m2::RectD const & rect) const
+{
+  if (m_mwmFeatures == nullptr)
+    return;
+
+  for (auto const & index : *m_mwmFeatures)
+  {
+    FeatureTypeInfo const & ftInfo = index.second;
+    if (ftInfo.m_status == FeatureStatus::Created &&
+        rect.IsPointInside(ftInfo.m_object.GetMercator()))
+    {
+      f(index.first);
+    }
+  }
+}
+
+Editor::FeatureTypeInfo const * Editor::MwmEdits::GetFeatureTypeInfo(uint32_t index) const
+{
+  if (m_mwmFeatures == nullptr || !m_bitmap[index % kBitmapSize])
+    return nullptr;
+
+  auto const matchedIndex = m_mwmFeatures->find(index);
+  if (matchedIndex == m_mwmFeatures->cend())
+    return nullptr;
+  return &matchedIndex->second;
+}
+
 const char * const Editor::kPlaceDoesNotExistMessage =
     "The place has gone or never existed. This is an auto-generated note from MAPS.ME application: "
     "a user reports a POI that is visible on a map (which can be outdated), but cannot be found on "
@@ -19,6 +19,8 @@
 #include "base/timer.hpp"
 
 #include <atomic>
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <ctime>
 #include <functional>
@@ -132,6 +134,12 @@ public:
   FeatureStatus GetFeatureStatus(MwmSet::MwmId const & mwmId, uint32_t index) const;
   FeatureStatus GetFeatureStatus(FeatureID const & fid) const;
 
+  class MwmEdits;
+  /// @returns the current edits of |mwmId|.
+  MwmEdits GetMwmEdits(MwmSet::MwmId const & mwmId) const;
+  /// @returns the number which is changed every time the edits are changed.
+  uint64_t GetEditsVersion() const { return m_editsVersion.load(); }
+
   /// @returns true if a feature was uploaded to osm.
   bool IsFeatureUploaded(MwmSet::MwmId const & mwmId, uint32_t index) const;
 
@@ -211,6 +219,7 @@ private:
 
   /// @returns false if fails.
   bool Save(FeaturesContainer const & features) const;
+  void SetFeatures(std::shared_ptr<FeaturesContainer> const & features);
   bool SaveTransaction(std::shared_ptr<FeaturesContainer> const & features);
   bool RemoveFeatureIfExists(FeatureID const & fid);
   /// Notify framework that something has changed and should be redisplayed.
@@ -255,6 +264,7 @@ private:
 
   /// Deleted, edited and created features.
   base::AtomicSharedPtr<FeaturesContainer> m_features;
+  std::atomic<uint64_t> m_editsVersion{0};
 
   std::unique_ptr<Delegate> m_delegate;
 
@@ -275,5 +285,30 @@ private:
   DECLARE_THREAD_CHECKER(MainThreadChecker);
 };  // class Editor
 
+/// Edits of an mwm at the moment they are taken. Unlike the Editor methods it doesn't load the
+/// edits on every call and most of unedited features are rejected by a bitmap without a lookup,
+/// so it's used when many features of an mwm are read.
+class Editor::MwmEdits
+{
+public:
+  FeatureStatus GetFeatureStatus(uint32_t index) const;
+  /// @returns nullptr if feature wasn't edited.
+  EditableMapObject const * GetEditedFeature(uint32_t index) const;
+  void ForEachCreatedFeature(FeatureIndexFunctor const & f, m2::RectD const & rect) const;
+
+private:
+  friend class Editor;
+
+  static size_t constexpr kBitmapSize = 1024;
+
+  FeatureTypeInfo const * GetFeatureTypeInfo(uint32_t index) const;
+
+  std::shared_ptr<FeaturesContainer const> m_features;
+  // Edits of the mwm in |m_features|, nullptr if the mwm isn't edited.
+  std::map<uint32_t, FeatureTypeInfo> const * m_mwmFeatures = nullptr;
+  // Bit |index % kBitmapSize| is set for every edited feature.
+  std::bitset<kBitmapSize> m_bitmap;
+};
+
 std::string DebugPrint(Editor::SaveResult const saveResult);
 }  // namespace osm
@@ -31,13 +31,16 @@
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
@@ -173,7 +176,7 @@ void PrintAsCSV(vector<string> const & columns, char const delimiter, ostream &
       out << '"' << value << '"';
     }
   }
-  out << endl;
+  out << '\n';
 }
 
 class Processor
@@ -196,12 +199,12 @@ public:
 
   void ClearCache() { m_villagesCache.Clear(); }
 
-  void operator()(FeatureType & f, map<uint32_t, base::GeoObjectId> const & ft2osm)
+  void operator()(FeatureType & f, map<uint32_t, base::GeoObjectId> const & ft2osm, ostream & out)
   {
-    Process(f, ft2osm);
+    Process(f, ft2osm, out);
   }
 
-  void Process(FeatureType & f, map<uint32_t, base::GeoObjectId> const & ft2osm)
+  void Process(FeatureType & f, map<uint32_t, base::GeoObjectId> const & ft2osm, ostream & out)
   {
     f.ParseBeforeStatistic();
     string const & category = GetReadableType(f);
@@ -281,7 +284,7 @@ public:
         addrStreet,   addrHouse,  phone,         website,   cuisine, stars,    operatr, internet,
         denomination, wheelchair, opening_hours, wikipedia, floor,   fee,      atm};
     AppendNames(f, columns);
-    PrintAsCSV(columns, ';', cout);
+    PrintAsCSV(columns, ';', out);
   }
 };
 
@@ -296,6 +299,7 @@ void PrintHeader()
   for (uint8_t idx = 1; idx < kLangCount; idx++)
     columns.push_back("name_" + string(StringUtf8Multilang::GetLangByCode(idx)));
   PrintAsCSV(columns, ';', cout);
+  cout.flush();
 }
 
 bool ParseFeatureIdToOsmIdMapping(string const & path, map<uint32_t, base::GeoObjectId> & mapping)
@@ -358,29 +362,51 @@ int main(int argc, char ** argv)
     CHECK(id.IsAlive(), ("Mwm is not alive?", mwm));
   }
 
-  Processor doProcess(dataSource);
   PrintHeader();
   vector<shared_ptr<MwmInfo>> mwmInfos;
   dataSource.GetMwmsInfo(mwmInfos);
-  for (auto const & mwmInfo : mwmInfos)
+  base::EraseIf(mwmInfos, [&](shared_ptr<MwmInfo> const & mwmInfo) {
+    return mwmInfo->GetType() != MwmInfo::COUNTRY ||
+           (argc > 3 &&
+            !strings::StartsWith(mwmInfo->GetCountryName() + DATA_FILE_EXTENSION, argv[3]));
+  });
+
+  // Mwms are processed in parallel, each thread has its own processor because the geocoder and
+  // the locality finder are not thread-safe. Rows of one mwm are printed together, the order of
+  // mwms in the output may differ from run to run.
+  atomic<size_t> nextMwm{0};
+  mutex outMutex;
+  auto const numThreads = max(GetPlatform().CpuCores(), 1u);
   {
-    if (mwmInfo->GetType() != MwmInfo::COUNTRY)
-      continue;
-    if (argc > 3 && !strings::StartsWith(mwmInfo->GetCountryName() + DATA_FILE_EXTENSION, argv[3]))
-      continue;
-    LOG(LINFO, ("Processing", mwmInfo->GetCountryName()));
-    string osmToFeatureFile = base::JoinPath(
-        argv[1], mwmInfo->GetCountryName() + DATA_FILE_EXTENSION + OSM2FEATURE_FILE_EXTENSION);
-    map<uint32_t, base::GeoObjectId> featureIdToOsmId;
-    ParseFeatureIdToOsmIdMapping(osmToFeatureFile, featureIdToOsmId);
-    MwmSet::MwmId mwmId(mwmInfo);
-    FeaturesLoaderGuard loader(dataSource, mwmId);
-    for (uint32_t ftIndex = 0; ftIndex < loader.GetNumFeatures(); ftIndex++)
+    base::thread_pool::computational::ThreadPool pool(numThreads);
+    for (size_t i = 0; i < numThreads; ++i)
     {
-      if (auto ft = loader.GetFeatureByIndex(static_cast<uint32_t>(ftIndex)))
-        doProcess.Process(*ft, featureIdToOsmId);
+      pool.SubmitWork([&]() {
+        Processor doProcess(dataSource);
+        for (size_t mwm = nextMwm++; mwm < mwmInfos.size(); mwm = nextMwm++)
+        {
+          auto const & mwmInfo = mwmInfos[mwm];
+          LOG(LINFO, ("Processing", mwmInfo->GetCountryName()));
+          string osmToFeatureFile = base::JoinPath(
+              argv[1], mwmInfo->GetCountryName() + DATA_FILE_EXTENSION + OSM2FEATURE_FILE_EXTENSION);
+          map<uint32_t, base::GeoObjectId> featureIdToOsmId;
+          ParseFeatureIdToOsmIdMapping(osmToFeatureFile, featureIdToOsmId);
+          MwmSet::MwmId mwmId(mwmInfo);
+          FeaturesLoaderGuard loader(dataSource, mwmId);
+          ostringstream out;
+          for (uint32_t ftIndex = 0; ftIndex < loader.GetNumFeatures(); ftIndex++)
+          {
+            if (auto ft = loader.GetFeatureByIndex(static_cast<uint32_t>(ftIndex)))
+              doProcess.Process(*ft, featureIdToOsmId, out);
+          }
+          doProcess.ClearCache();
+
+          lock_guard<mutex> lock(outMutex);
+          cout << out.str();
+          cout.flush();
+        }
+      });
     }
-    doProcess.ClearCache();
   }
 
   return 0;
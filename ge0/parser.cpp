@@ -11,6 +11,7 @@
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <array>
 #include <sstream>
 
 using namespace std;
@@ -41,7 +42,8 @@ bool Ge0Parser::Parse(string const & url, Result & result)
   // Alternative format (differs only in the prefix):
   // http://ge0.me/ZCoordba64/Name
 
-  for (string const & prefix : {"ge0://", "http://ge0.me/", "https://ge0.me/"})
+  static array<string, 3> const kPrefixes = {{"ge0://", "http://ge0.me/", "https://ge0.me/"}};
+  for (auto const & prefix : kPrefixes)
   {
     if (strings::StartsWith(url, prefix))
       return ParseAfterPrefix(url, prefix.size(), result);
@@ -3,11 +3,15 @@
 #include "platform/platform.hpp"
 
 #include "geometry/mercator.hpp"
+#include "geometry/rect_intersect.hpp"
 
+#include "base/bits.hpp"
+#include "base/checked_cast.hpp"
 #include "base/thread_pool_computational.hpp"
 
 #include <cmath>
 #include <functional>
+#include <limits>
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/register/ring.hpp>
@@ -100,6 +104,11 @@ std::vector<std::string> GetAffiliations(T && t,
 }
 
 // An implementation for CountriesFilesIndexAffiliation class.
+// Cells of the index are 0.2 wide, so subcells of the deepest level are about 1 km wide.
+size_t constexpr kMaxCellDepth = 4;
+// Quadtree nodes keep countries of a cell in 64 bit masks.
+size_t constexpr kMaxCellCountries = 64;
+
 using IndexSharedPtr = std::shared_ptr<CountriesFilesIndexAffiliation::Tree>;
 
 CountriesFilesIndexAffiliation::Box MakeBox(m2::RectD const & rect)
@@ -117,13 +126,14 @@ std::optional<std::string> IsOneCountryForLimitRect(m2::RectD const & limitRect,
                                 std::back_inserter(values));
   for (auto const & v : values)
   {
-    for (borders::CountryPolygons const & c : v.second)
-    {
-      if (!country)
-        country = &c;
-      else if (country != &c)
-        return {};
-    }
+    auto const * c = v.second->GetCountry();
+    if (!c)
+      return {};
+
+    if (!country)
+      country = c;
+    else if (country != c)
+      return {};
   }
   return country ? country->GetName() : std::optional<std::string>{};
 }
@@ -139,20 +149,10 @@ std::vector<std::string> GetHonestAffiliations(T && t, IndexSharedPtr const & in
                                   std::back_inserter(values));
     for (auto const & v : values)
     {
-      if (v.second.size() == 1)
-      {
-        borders::CountryPolygons const & cp = v.second.front();
-        if (countires.insert(&cp).second)
+      v.second->ForEachCountry(point, [&](borders::CountryPolygons const & cp, bool needTest) {
+        if ((!needTest || cp.Contains(point)) && countires.insert(&cp).second)
           affiliations.emplace_back(cp.GetName());
-      }
-      else
-      {
-        for (borders::CountryPolygons const & cp : v.second)
-        {
-          if (cp.Contains(point) && countires.insert(&cp).second)
-            affiliations.emplace_back(cp.GetName());
-        }
-      }
+      });
     }
   });
 
@@ -216,6 +216,105 @@ CountriesFilesIndexAffiliation::CountriesFilesIndexAffiliation(std::string const
   cache.emplace(key, index);
 }
 
+CountriesFilesIndexAffiliation::Cell::Cell(borders::CountryPolygons const & country)
+  : m_countries({country}), m_nodes(1)
+{
+  m_nodes.front().m_inside = 1;
+}
+
+CountriesFilesIndexAffiliation::Cell::Cell(m2::RectD const & rect, Countries && countries)
+  : m_rect(rect), m_countries(std::move(countries))
+{
+  if (m_countries.size() > kMaxCellCountries)
+    return;
+
+  std::vector<Segments> segments(m_countries.size());
+  for (size_t i = 0; i < m_countries.size(); ++i)
+  {
+    m_countries[i].get().ForEachPolygon([&](auto const & polygon) {
+      if (!polygon.GetRect().IsIntersect(m_rect))
+        return;
+
+      auto const & points = polygon.Data();
+      for (size_t j = 0; j < points.size(); ++j)
+        segments[i].emplace_back(points[j == 0 ? points.size() - 1 : j - 1], points[j]);
+    });
+  }
+
+  m_nodes.resize(1);
+  uint64_t const all = m_countries.size() == kMaxCellCountries
+                           ? std::numeric_limits<uint64_t>::max()
+                           : (uint64_t{1} << m_countries.size()) - 1;
+  Build(0 /* nodeIdx */, m_rect, all /* candidates */, 0 /* inside */, segments, 0 /* depth */);
+}
+
+borders::CountryPolygons const * CountriesFilesIndexAffiliation::Cell::GetCountry() const
+{
+  if (m_nodes.empty())
+    return nullptr;
+
+  auto const & root = m_nodes.front();
+  if (root.m_boundary != 0 || root.m_inside == 0 || (root.m_inside & (root.m_inside - 1)) != 0)
+    return nullptr;
+
+  return &m_countries[bits::FloorLog(root.m_inside)].get();
+}
+
+// static
+m2::RectD CountriesFilesIndexAffiliation::Cell::GetQuadrantRect(m2::RectD const & rect,
+                                                              size_t quadrant)
+{
+  auto const center = rect.Center();
+  auto const minX = (quadrant & 1) ? center.x : rect.minX();
+  auto const maxX = (quadrant & 1) ? rect.maxX() : center.x;
+  auto const minY = (quadrant & 2) ? center.y : rect.minY();
+  auto const maxY = (quadrant & 2) ? rect.maxY() : center.y;
+  return {minX, minY, maxX, maxY};
+}
+
+void CountriesFilesIndexAffiliation::Cell::Build(size_t nodeIdx, m2::RectD const & rect,
+                                                 uint64_t candidates, uint64_t inside,
+                                                 std::vector<Segments> const & segments,
+                                                 size_t depth)
+{
+  // Segments of the borders which cross |rect|.
+  std::vector<Segments> crossing(segments.size());
+  uint64_t boundary = 0;
+  for (size_t i = 0; i < m_countries.size(); ++i)
+  {
+    uint64_t const bit = uint64_t{1} << i;
+    if ((candidates & bit) == 0)
+      continue;
+
+    for (auto const & segment : segments[i])
+    {
+      auto p1 = segment.first;
+      auto p2 = segment.second;
+      if (m2::Intersect(rect, p1, p2))
+        crossing[i].emplace_back(segment);
+    }
+
+    if (!crossing[i].empty())
+      boundary |= bit;
+    else if (m_countries[i].get().Contains(rect.Center()))
+      inside |= bit;
+  }
+
+  m_nodes[nodeIdx].m_inside = inside;
+  m_nodes[nodeIdx].m_boundary = boundary;
+  if (boundary == 0 || depth == kMaxCellDepth)
+    return;
+
+  auto const children = m_nodes.size();
+  m_nodes.resize(children + 4);
+  m_nodes[nodeIdx].m_children = base::asserted_cast<uint32_t>(children);
+  for (size_t quadrant = 0; quadrant < 4; ++quadrant)
+  {
+    Build(children + quadrant, GetQuadrantRect(rect, quadrant), boundary, inside, crossing,
+          depth + 1);
+  }
+}
+
 std::vector<std::string> CountriesFilesIndexAffiliation::GetAffiliations(FeatureBuilder const & fb) const
 {
   return ::GetAffiliations(fb, m_index);
@@ -239,7 +338,7 @@ CountriesFilesIndexAffiliation::BuildIndex(const std::vector<m2::RectD> & net)
     for (auto const & rect : net)
     {
       pool.SubmitWork([&, rect]() {
-        std::vector<std::reference_wrapper<borders::CountryPolygons const>> countries;
+        Countries countries;
         m_countryPolygonsTree.ForEachCountryInRect(rect, [&](auto const & country) {
           countries.emplace_back(country);
         });
@@ -252,7 +351,7 @@ CountriesFilesIndexAffiliation::BuildIndex(const std::vector<m2::RectD> & net)
         else
         {
           auto const box = MakeBox(rect);
-          std::vector<std::reference_wrapper<borders::CountryPolygons const>> interCountries;
+          Countries interCountries;
           for (borders::CountryPolygons const & cp : countries)
           {
             cp.ForAnyPolygon([&](auto const & polygon) {
@@ -272,8 +371,9 @@ CountriesFilesIndexAffiliation::BuildIndex(const std::vector<m2::RectD> & net)
           }
           else
           {
+            auto cell = std::make_shared<Cell const>(rect, std::move(interCountries));
             std::lock_guard<std::mutex> lock(treeCellsMutex);
-            treeCells.emplace_back(box, std::move(interCountries));
+            treeCells.emplace_back(box, std::move(cell));
           }
         }
       });
@@ -286,11 +386,11 @@ CountriesFilesIndexAffiliation::BuildIndex(const std::vector<m2::RectD> & net)
       pool.SubmitWork([&, countryPtr{pair.first}, rects{std::move(pair.second)}]() mutable {
         generator::cells_merger::CellsMerger merger(std::move(rects));
         auto const merged = merger.Merge();
+        auto const cell = std::make_shared<Cell const>(*countryPtr);
         for (auto const & rect : merged)
         {
-          std::vector<std::reference_wrapper<borders::CountryPolygons const>> interCountries{*countryPtr};
           std::lock_guard<std::mutex> lock(treeCellsMutex);
-          treeCells.emplace_back(MakeBox(rect), std::move(interCountries));
+          treeCells.emplace_back(MakeBox(rect), cell);
         }
       });
     }
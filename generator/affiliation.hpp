@@ -4,8 +4,13 @@
 #include "generator/cells_merger.hpp"
 #include "generator/feature_builder.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <boost/geometry/index/rtree.hpp>
@@ -45,7 +50,85 @@ class CountriesFilesIndexAffiliation : public CountriesFilesAffiliation
 {
 public:
   using Box = boost::geometry::model::box<m2::PointD>;
-  using Value = std::pair<Box, std::vector<std::reference_wrapper<borders::CountryPolygons const>>>;
+  using Countries = std::vector<std::reference_wrapper<borders::CountryPolygons const>>;
+
+  // Countries of an index cell. Points of a cell of one country belong to it without exact
+  // tests. A cell crossed by borders of several countries is prepared: it is split by a quadtree
+  // until subcells are fully inside or fully outside of every country of the cell, so exact
+  // tests are needed only for points of subcells crossed by borders. Cells are immutable and
+  // shared by all threads.
+  class Cell
+  {
+  public:
+    explicit Cell(borders::CountryPolygons const & country);
+    Cell(m2::RectD const & rect, Countries && countries);
+
+    // Returns the country if all points of the cell belong to it.
+    borders::CountryPolygons const * GetCountry() const;
+
+    // Calls |fn(country, needTest)| for countries of the cell which may contain |point|.
+    // |point| belongs to |country| if |needTest| is false, otherwise it should be checked by
+    // CountryPolygons::Contains().
+    template <typename Fn>
+    void ForEachCountry(m2::PointD const & point, Fn && fn) const
+    {
+      if (m_nodes.empty())
+      {
+        for (borders::CountryPolygons const & country : m_countries)
+          fn(country, true /* needTest */);
+        return;
+      }
+
+      auto rect = m_rect;
+      auto const * node = &m_nodes.front();
+      while (node->m_children != 0)
+      {
+        auto const quadrant = GetQuadrant(rect, point);
+        rect = GetQuadrantRect(rect, quadrant);
+        node = &m_nodes[node->m_children + quadrant];
+      }
+
+      for (size_t i = 0; i < m_countries.size(); ++i)
+      {
+        uint64_t const bit = uint64_t{1} << i;
+        if (node->m_inside & bit)
+          fn(m_countries[i].get(), false /* needTest */);
+        else if (node->m_boundary & bit)
+          fn(m_countries[i].get(), true /* needTest */);
+      }
+    }
+
+  private:
+    using Segments = std::vector<std::pair<m2::PointD, m2::PointD>>;
+
+    struct Node
+    {
+      // Index of the first of four children in |m_nodes| or 0 for leaves.
+      uint32_t m_children = 0;
+      // Bit masks of |m_countries| which cover the node or cross it by borders.
+      uint64_t m_inside = 0;
+      uint64_t m_boundary = 0;
+    };
+
+    static size_t GetQuadrant(m2::RectD const & rect, m2::PointD const & point)
+    {
+      auto const center = rect.Center();
+      return (point.x >= center.x ? 1 : 0) + (point.y >= center.y ? 2 : 0);
+    }
+
+    static m2::RectD GetQuadrantRect(m2::RectD const & rect, size_t quadrant);
+
+    void Build(size_t nodeIdx, m2::RectD const & rect, uint64_t candidates, uint64_t inside,
+               std::vector<Segments> const & segments, size_t depth);
+
+    m2::RectD m_rect;
+    Countries m_countries;
+    // Quadtree of the cell, |m_nodes[0]| is the root. It is empty for cells of too many
+    // countries, points of such cells are tested against all the countries.
+    std::vector<Node> m_nodes;
+  };
+
+  using Value = std::pair<Box, std::shared_ptr<Cell const>>;
   using Tree = boost::geometry::index::rtree<Value, boost::geometry::index::quadratic<16>>;
 
   CountriesFilesIndexAffiliation(std::string const & borderPath, bool haveBordersForWholeWorld);
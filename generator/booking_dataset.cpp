@@ -31,6 +31,7 @@ BookingHotel::BookingHotel(std::string const & src)
   CLOG(LDEBUG, strings::to_double(rec[FieldIndex(Fields::Longtitude)], m_latLon.m_lon), ());
 
   m_name = rec[FieldIndex(Fields::Name)];
+  m_nameWords = impl::MakeWeightedBagOfWords(m_name);
   m_address = rec[FieldIndex(Fields::Address)];
 
   CLOG(LDEBUG, strings::to_uint(rec[FieldIndex(Fields::Stars)], m_stars), ());
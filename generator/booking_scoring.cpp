@@ -40,8 +40,9 @@ MatchStats<BookingHotel> Match(BookingHotel const & h, FeatureBuilder const & fb
       impl::GetLinearNormDistanceScore(distance, BookingDataset::kDistanceLimitInMeters);
 
   // TODO(mgsergio): Check all translations and use the best one.
+  auto const fbName = fb.GetName(StringUtf8Multilang::kDefaultCode);
   score.m_nameSimilarityScore =
-      impl::GetNameSimilarityScore(h.m_name, fb.GetName(StringUtf8Multilang::kDefaultCode));
+      impl::GetNameSimilarityScore(h.m_nameWords, impl::MakeWeightedBagOfWords(fbName));
 
   return score;
 }
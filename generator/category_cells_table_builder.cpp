@@ -0,0 +1,68 @@
+#include "generator/category_cells_table_builder.hpp"
+
+#include "generator/search_index_builder.hpp"
+
+#include "search/category_cells_table.hpp"
+#include "search/types_skipper.hpp"
+
+#include "indexer/categories_holder.hpp"
+#include "indexer/data_header.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+#include "indexer/feature_data.hpp"
+#include "indexer/feature_processor.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace search
+{
+bool BuildCategoryCellsTable(std::string const & filename)
+{
+  try
+  {
+    auto const scaleRange = feature::DataHeader(filename).GetScaleRange();
+    auto const & categories = GetDefaultCategories();
+    TypesSkipper const skipper;
+
+    CategoryCellsTableBuilder builder;
+    feature::ForEachFeature(filename, [&](FeatureType & ft, uint32_t featureId) {
+      // The same types as the ones which get the category tokens in the search index.
+      feature::TypesHolder types(ft);
+      if (skipper.SkipAlways(types))
+        return;
+      if (!ft.HasName())
+        skipper.SkipEmptyNameTypes(types);
+      if (types.Empty())
+        return;
+
+      std::vector<uint32_t> categoryTypes;
+      indexer::GetCategoryTypes(categories, scaleRange, types, categoryTypes);
+      if (categoryTypes.empty())
+        return;
+
+      auto const center = feature::GetCenter(ft);
+      for (auto const type : categoryTypes)
+        builder.Put(type, center, featureId);
+    });
+
+    FilesContainerW writeContainer(filename, FileWriter::OP_WRITE_EXISTING);
+    auto writer = writeContainer.GetWriter(CATEGORY_CELLS_FILE_TAG);
+    builder.Freeze(*writer);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to build category cells table:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace search
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+namespace search
+{
+// Builds the category cells section for the viewport category search and writes it to
+// the mwm file.
+bool BuildCategoryCellsTable(std::string const & filename);
+}  // namespace search
@@ -25,37 +25,45 @@ public:
                  IsSameFunc const & isSameFunc)
     : m_container(std::move(container)), m_radiusFunc(radiusFunc), m_isSameFunc(isSameFunc)
   {
-    for (auto const & e : m_container)
+    for (auto & e : m_container)
       m_tree.Add(&e);
   }
 
-  std::vector<std::vector<T>> Find() const
+  // Elements are moved to the clusters, so the finder must not be used after the call.
+  std::vector<std::vector<T>> Find()
   {
     std::vector<std::vector<T>> clusters;
-    std::set<ConstIterator> unviewed;
-    for (auto const & e : m_container)
+    std::set<Iterator> unviewed;
+    for (auto & e : m_container)
       unviewed.insert(&e);
 
     while (!unviewed.empty())
     {
       auto const it = *std::cbegin(unviewed);
-      clusters.emplace_back(FindOneCluster(it, unviewed));
+      auto const elements = FindOneCluster(it, unviewed);
+      std::vector<T> cluster;
+      cluster.reserve(elements.size());
+      for (auto const e : elements)
+        cluster.emplace_back(std::move(*e));
+      clusters.emplace_back(std::move(cluster));
     }
     return clusters;
   }
 
 private:
-  using ConstIterator = T const *;
+  using Iterator = T *;
 
   struct TraitsDef
   {
-    m2::RectD const LimitRect(ConstIterator const & it) const { return GetLimitRect(*it); }
+    m2::RectD const LimitRect(Iterator const & it) const { return GetLimitRect(*it); }
   };
 
-  std::vector<T> FindOneCluster(ConstIterator const & it, std::set<ConstIterator> & unviewed) const
+  // Returns pointers to the elements of the cluster with |it|. The elements are not moved here
+  // because their limit rects are needed for the queries while the cluster is growing.
+  std::vector<Iterator> FindOneCluster(Iterator const & it, std::set<Iterator> & unviewed) const
   {
-    std::vector<T> cluster{*it};
-    std::queue<ConstIterator> queue;
+    std::vector<Iterator> cluster{it};
+    std::queue<Iterator> queue;
     queue.emplace(it);
     unviewed.erase(it);
     while (!queue.empty())
@@ -69,14 +77,14 @@ private:
 
         unviewed.erase(candidate);
         queue.emplace(candidate);
-        cluster.emplace_back(*candidate);
+        cluster.emplace_back(candidate);
       });
     }
 
     return cluster;
   }
 
-  m2::RectD GetBboxFor(ConstIterator const & it) const
+  m2::RectD GetBboxFor(Iterator const & it) const
   {
     m2::RectD bbox;
     auto const dist = m_radiusFunc(*it);
@@ -90,7 +98,7 @@ private:
   Container<T, Alloc> m_container;
   RadiusFunc m_radiusFunc;
   IsSameFunc m_isSameFunc;
-  m4::Tree<ConstIterator, TraitsDef> m_tree;
+  m4::Tree<Iterator, TraitsDef> m_tree;
 };
 
 template <typename T, template<typename, typename> class Container, typename Alloc = std::allocator<T>>
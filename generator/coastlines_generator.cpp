@@ -11,6 +11,7 @@
 #include "base/string_utils.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
 #include <condition_variable>
 #include <functional>
 #include <thread>
@@ -289,18 +290,22 @@ public:
   }
 };
 
-void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder> & features)
+void CoastlineFeaturesGenerator::GetFeatures(size_t threadsCount, vector<FeatureBuilder> & features)
 {
-  size_t const maxThreads = thread::hardware_concurrency();
-  CHECK_GREATER(maxThreads, 0, ("Not supported platform"));
+  CHECK_GREATER(threadsCount, 0, ());
 
+  // Cells are processed in arbitrary order, so features are sorted by cells to make
+  // the result independent of threads scheduling.
+  vector<pair<int64_t, FeatureBuilder>> cellsFeatures;
   mutex featuresMutex;
   RegionInCellSplitter::Process(
-      maxThreads, RegionInCellSplitter::kStartLevel, m_tree,
-      [&features, &featuresMutex](RegionInCellSplitter::TCell const & cell, DoDifference & cellData)
+      threadsCount, RegionInCellSplitter::kStartLevel, m_tree,
+      [&cellsFeatures, &featuresMutex](RegionInCellSplitter::TCell const & cell,
+                                       DoDifference & cellData)
       {
         FeatureBuilder fb;
-        fb.SetCoastCell(cell.ToInt64(RegionInCellSplitter::kHighLevel + 1));
+        auto const cellId = cell.ToInt64(RegionInCellSplitter::kHighLevel + 1);
+        fb.SetCoastCell(cellId);
 
         cellData.AssignGeometry(fb);
         fb.SetArea();
@@ -313,6 +318,13 @@ void CoastlineFeaturesGenerator::GetFeatures(vector<FeatureBuilder> & features)
 
         // save result
         lock_guard<mutex> lock(featuresMutex);
-        features.emplace_back(move(fb));
+        cellsFeatures.emplace_back(cellId, move(fb));
       });
+
+  sort(cellsFeatures.begin(), cellsFeatures.end(),
+       [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+
+  features.reserve(features.size() + cellsFeatures.size());
+  for (auto & cellFeature : cellsFeatures)
+    features.emplace_back(move(cellFeature.second));
 }
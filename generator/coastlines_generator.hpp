@@ -7,6 +7,7 @@
 #include "geometry/tree4d.hpp"
 #include "geometry/region2d.hpp"
 
+#include <cstddef>
 #include <vector>
 
 namespace feature
@@ -30,5 +31,7 @@ public:
   /// @return false if coasts are not merged and FLAG_fail_on_coasts is set
   bool Finish();
 
-  void GetFeatures(std::vector<feature::FeatureBuilder> & vecFb);
+  /// Splits coasts by cells on |threadsCount| threads. Features are appended to |vecFb|
+  /// in order of their cells.
+  void GetFeatures(size_t threadsCount, std::vector<feature::FeatureBuilder> & vecFb);
 };
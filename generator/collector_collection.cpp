@@ -3,11 +3,28 @@
 #include "generator/feature_builder.hpp"
 #include "generator/intermediate_elements.hpp"
 #include "generator/osm_element.hpp"
+#include "generator/stages_profiler.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/thread_pool_computational.hpp"
+
+#include <algorithm>
 
 using namespace feature;
 
 namespace generator
 {
+namespace
+{
+std::string GetStageName(CollectorInterface const & collector, std::string const & action)
+{
+  auto const name = base::GetNameFromFullPath(collector.GetFilename());
+  return "collector/" + action + "/" + (name.empty() ? "unnamed" : name);
+}
+}  // namespace
+
 std::shared_ptr<CollectorInterface> CollectorCollection::Clone(
     std::shared_ptr<cache::IntermediateDataReaderInterface> const & cache) const
 {
@@ -41,16 +58,43 @@ void CollectorCollection::Finish()
     c->Finish();
 }
 
+void CollectorCollection::Finalize(bool isStable)
+{
+  auto const threadsCount =
+      std::min(m_collection.size(), static_cast<size_t>(GetPlatform().CpuCores()));
+  base::thread_pool::computational::ThreadPool pool(std::max(threadsCount, size_t{1}));
+  for (auto & c : m_collection)
+  {
+    pool.SubmitWork([&c, isStable]() {
+      {
+        StagesProfiler::Scope scope(GetStageName(*c, "save"));
+        c->Save();
+      }
+      if (isStable)
+      {
+        StagesProfiler::Scope scope(GetStageName(*c, "order"));
+        c->OrderCollectedData();
+      }
+    });
+  }
+}
+
 void CollectorCollection::Save()
 {
   for (auto & c : m_collection)
+  {
+    StagesProfiler::Scope scope(GetStageName(*c, "save"));
     c->Save();
+  }
 }
 
 void CollectorCollection::OrderCollectedData()
 {
   for (auto & c : m_collection)
+  {
+    StagesProfiler::Scope scope(GetStageName(*c, "order"));
     c->OrderCollectedData();
+  }
 }
 
 void CollectorCollection::Merge(CollectorInterface const & collector)
@@ -63,6 +107,9 @@ void CollectorCollection::MergeInto(CollectorCollection & collector) const
   auto & otherCollection = collector.m_collection;
   CHECK_EQUAL(m_collection.size(), otherCollection.size(), ());
   for (size_t i = 0; i < m_collection.size(); ++i)
+  {
+    StagesProfiler::Scope scope(GetStageName(*m_collection[i], "merge"));
     otherCollection[i]->Merge(*m_collection[i]);
+  }
 }
 }  // namespace generator
@@ -32,6 +32,8 @@ public:
   void CollectRelation(RelationElement const & element) override;
   void CollectFeature(feature::FeatureBuilder const & feature, OsmElement const & element) override;
   void Finish() override;
+  // Collectors write their own files, so they are saved and ordered in parallel.
+  void Finalize(bool isStable = false) override;
 
   void Merge(CollectorInterface const & collector) override;
   void MergeInto(CollectorCollection & collector) const override;
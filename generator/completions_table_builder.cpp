@@ -0,0 +1,57 @@
+#include "generator/completions_table_builder.hpp"
+
+#include "search/completions_table.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_processor.hpp"
+#include "indexer/search_string_utils.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/string_utf8_multilang.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace search
+{
+bool BuildCompletionsTable(std::string const & filename)
+{
+  try
+  {
+    CompletionsTableBuilder builder;
+    feature::ForEachFeature(filename, [&builder](FeatureType & ft, uint32_t /* featureId */) {
+      // Popular features make their words heavier, so the completions of a prefix are the words
+      // the users are most likely looking for.
+      uint32_t const weight = 1 + ft.GetRank();
+      ft.GetNames().ForEach([&](int8_t /* langCode */, std::string const & name) {
+        ForEachNormalizedToken(name, [&](strings::UniString const & token) {
+          // Single letters and numbers are not worth completing.
+          if (token.size() < 2 ||
+              std::all_of(token.begin(), token.end(), [](auto c) { return strings::IsASCIIDigit(c); }))
+          {
+            return;
+          }
+          builder.Put(token, weight);
+        });
+      });
+    });
+
+    FilesContainerW writeContainer(filename, FileWriter::OP_WRITE_EXISTING);
+    auto writer = writeContainer.GetWriter(COMPLETIONS_FILE_TAG);
+    builder.Freeze(*writer);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to build completions table:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace search
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+
+namespace search
+{
+// Builds the completions section for the instant suggestions and writes it to the mwm file.
+bool BuildCompletionsTable(std::string const & filename);
+}  // namespace search
@@ -0,0 +1,121 @@
+#include "generator/countries_shards.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+#include "3party/jansson/myjansson.hpp"
+
+namespace generator
+{
+std::vector<std::string> GetShardCountries(
+    std::vector<std::pair<std::string, uint64_t>> const & countriesWithSizes, size_t shardsCount,
+    size_t shardIndex)
+{
+  CHECK_GREATER(shardsCount, 0, ());
+  CHECK_LESS(shardIndex, shardsCount, ());
+
+  std::vector<size_t> order(countriesWithSizes.size());
+  std::iota(order.begin(), order.end(), 0);
+  // Countries are ordered by names among the equal sizes, so the split doesn't depend on the
+  // order of the files in a directory.
+  std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    auto const & l = countriesWithSizes[lhs];
+    auto const & r = countriesWithSizes[rhs];
+    if (l.second != r.second)
+      return l.second > r.second;
+    return l.first < r.first;
+  });
+
+  std::vector<uint64_t> shardSizes(shardsCount, 0);
+  std::vector<bool> isInShard(countriesWithSizes.size(), false);
+  for (auto const i : order)
+  {
+    auto const shard = static_cast<size_t>(
+        std::distance(shardSizes.begin(), std::min_element(shardSizes.begin(), shardSizes.end())));
+    // Empty countries are counted as one byte to be spread between the shards.
+    shardSizes[shard] += std::max<uint64_t>(countriesWithSizes[i].second, 1);
+    isInShard[i] = shard == shardIndex;
+  }
+
+  std::vector<std::string> countries;
+  for (size_t i = 0; i < countriesWithSizes.size(); ++i)
+  {
+    if (isInShard[i])
+      countries.push_back(countriesWithSizes[i].first);
+  }
+  return countries;
+}
+
+std::vector<std::string> GetShardCountries(
+    std::vector<std::string> const & countries,
+    std::function<uint64_t(std::string const & country)> const & getSize, size_t shardsCount,
+    size_t shardIndex)
+{
+  std::vector<std::pair<std::string, uint64_t>> countriesWithSizes;
+  countriesWithSizes.reserve(countries.size());
+  for (auto const & country : countries)
+    countriesWithSizes.emplace_back(country, getSize(country));
+  return GetShardCountries(countriesWithSizes, shardsCount, shardIndex);
+}
+
+ShardManifest::ShardManifest(size_t shardsCount, size_t shardIndex)
+  : m_shardsCount(shardsCount), m_shardIndex(shardIndex)
+{
+  CHECK_LESS(m_shardIndex, m_shardsCount, ());
+}
+
+void ShardManifest::AddCountry(std::string const & country, std::vector<std::string> const & files)
+{
+  std::vector<File> existing;
+  for (auto const & path : files)
+  {
+    File file;
+    file.m_path = path;
+    if (Platform::GetFileSizeByFullPath(path, file.m_size))
+      existing.push_back(std::move(file));
+  }
+  m_countries.emplace_back(country, std::move(existing));
+}
+
+std::string ShardManifest::GetJson() const
+{
+  auto countries = base::NewJSONObject();
+  for (auto const & country : m_countries)
+  {
+    auto files = base::NewJSONArray();
+    for (auto const & file : country.second)
+    {
+      auto obj = base::NewJSONObject();
+      ToJSONObject(*obj, "path", file.m_path);
+      ToJSONObject(*obj, "size", file.m_size);
+      json_array_append_new(files.get(), obj.release());
+    }
+    ToJSONObject(*countries, country.first.c_str(), files);
+  }
+
+  auto root = base::NewJSONObject();
+  ToJSONObject(*root, "shards_count", m_shardsCount);
+  ToJSONObject(*root, "shard_index", m_shardIndex);
+  ToJSONObject(*root, "countries", countries);
+  return base::DumpToString(root, JSON_INDENT(2) | JSON_SORT_KEYS);
+}
+
+bool ShardManifest::Save(std::string const & filename) const
+{
+  std::ofstream stream(filename);
+  if (!stream.is_open())
+  {
+    LOG(LERROR, ("Can't open file", filename));
+    return false;
+  }
+
+  stream << GetJson() << std::endl;
+  return stream.good();
+}
+}  // namespace generator
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace generator
+{
+// A planet build may be split between several machines, every machine runs the per-country
+// stages of generator_tool (geometry, indices, routing and cross-mwm sections) for the countries
+// of its shard only. The split depends on the countries and their sizes only, so the machines
+// which have the same intermediate data agree on it without coordination. The countries are
+// assigned greedily, the biggest first, to the shard with the least total size.
+// Returns the countries of |shardIndex| in the order of |countriesWithSizes|.
+std::vector<std::string> GetShardCountries(
+    std::vector<std::pair<std::string, uint64_t>> const & countriesWithSizes, size_t shardsCount,
+    size_t shardIndex);
+// The same with the sizes of the countries got by |getSize|.
+std::vector<std::string> GetShardCountries(
+    std::vector<std::string> const & countries,
+    std::function<uint64_t(std::string const & country)> const & getSize, size_t shardsCount,
+    size_t shardIndex);
+
+// Files built by a shard. The manifests of all the shards are used to collect the outputs of
+// the per-country stages and to check that every country has been built.
+class ShardManifest
+{
+public:
+  ShardManifest(size_t shardsCount, size_t shardIndex);
+
+  // Adds |country| with |files| built for it. Files which don't exist are skipped.
+  void AddCountry(std::string const & country, std::vector<std::string> const & files);
+
+  std::string GetJson() const;
+  bool Save(std::string const & filename) const;
+
+private:
+  struct File
+  {
+    std::string m_path;
+    uint64_t m_size = 0;
+  };
+
+  size_t m_shardsCount;
+  size_t m_shardIndex;
+  std::vector<std::pair<std::string, std::vector<File>>> m_countries;
+};
+}  // namespace generator
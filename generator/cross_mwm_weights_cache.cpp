@@ -0,0 +1,176 @@
+#include "generator/cross_mwm_weights_cache.hpp"
+
+#include "platform/platform.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/files_container.hpp"
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+
+namespace generator
+{
+namespace
+{
+// Should be incremented when the weights are calculated another way which the key doesn't catch:
+// the formulas of the edge estimator or the vehicle model, the road graph loading, the waves,
+// the rounding of the weights and so on. The parameters of the model and the estimator are in
+// the key, see GetWeightsParams().
+uint32_t constexpr kVersion = 1;
+
+// Sections which the road graph and the edge weights of a car are loaded from.
+std::array<char const *, 10> const kSectionsTags = {
+    {FEATURES_FILE_TAG, FEATURE_TYPES_FILE_TAG, GEOMETRY_FILE_TAG, METADATA_FILE_TAG,
+     METADATA_INDEX_FILE_TAG, ROUTING_FILE_TAG, RESTRICTIONS_FILE_TAG, ROAD_ACCESS_FILE_TAG,
+     MAXSPEEDS_FILE_TAG, CITY_ROADS_FILE_TAG}};
+
+template <typename T>
+void Update(coding::SHA1::Streaming & sha1, T const & value)
+{
+  sha1.Update(&value, sizeof(value));
+}
+
+void Update(coding::SHA1::Streaming & sha1, std::string const & str)
+{
+  Update(sha1, static_cast<uint64_t>(str.size()));
+  sha1.Update(str.data(), str.size());
+}
+
+void Update(coding::SHA1::Streaming & sha1, std::vector<routing::Segment> const & segments)
+{
+  Update(sha1, static_cast<uint64_t>(segments.size()));
+  for (auto const & segment : segments)
+  {
+    Update(sha1, segment.GetFeatureId());
+    Update(sha1, segment.GetSegmentIdx());
+    Update(sha1, static_cast<uint8_t>(segment.IsForward()));
+  }
+}
+}  // namespace
+
+CrossMwmWeightsCache::CrossMwmWeightsCache(std::string const & dir) : m_dir(dir) {}
+
+// static
+std::string CrossMwmWeightsCache::GetWeightsParams(routing::VehicleModel const & vehicleModel,
+                                                   routing::EdgeEstimator const & estimator)
+{
+  using Purpose = routing::EdgeEstimator::Purpose;
+
+  std::ostringstream oss;
+  oss.precision(std::numeric_limits<double>::max_digits10);
+  oss << vehicleModel.GetParamsDescription();
+  oss << " Estimator: " << estimator.GetMaxWeightSpeedMpS() << " "
+      << estimator.GetUTurnPenalty(Purpose::Weight) << " "
+      << estimator.GetFerryLandingPenalty(Purpose::Weight);
+  return oss.str();
+}
+
+// static
+CrossMwmWeightsCache::Key CrossMwmWeightsCache::CalcKey(
+    std::string const & mwmFile, std::string const & country,
+    std::vector<routing::Segment> const & enters, std::vector<routing::Segment> const & exits,
+    std::string const & weightsParams)
+{
+  coding::SHA1::Streaming sha1;
+  Update(sha1, kVersion);
+  Update(sha1, country);
+  Update(sha1, weightsParams);
+
+  FilesContainerR cont(mwmFile);
+  std::vector<uint8_t> buffer;
+  for (auto const tag : kSectionsTags)
+  {
+    Update(sha1, std::string(tag));
+    if (!cont.IsExist(tag))
+    {
+      Update(sha1, std::numeric_limits<uint64_t>::max());
+      continue;
+    }
+
+    auto const reader = cont.GetReader(tag);
+    Update(sha1, reader.Size());
+    uint64_t constexpr kChunkSize = 1024 * 1024;
+    for (uint64_t pos = 0; pos < reader.Size(); pos += kChunkSize)
+    {
+      auto const size = static_cast<size_t>(std::min(kChunkSize, reader.Size() - pos));
+      buffer.resize(size);
+      reader.Read(pos, buffer.data(), size);
+      sha1.Update(buffer.data(), size);
+    }
+  }
+
+  Update(sha1, enters);
+  Update(sha1, exits);
+  return sha1.GetHash();
+}
+
+bool CrossMwmWeightsCache::Load(std::string const & country, Key const & key, size_t weightsCount,
+                                std::vector<Weight> & weights) const
+{
+  auto const path = GetFilePath(country);
+  if (!Platform::IsFileExistsByFullPath(path))
+    return false;
+
+  try
+  {
+    FileReader reader(path);
+    ReaderSource<FileReader> src(reader);
+    if (ReadPrimitiveFromSource<uint32_t>(src) != kVersion)
+      return false;
+
+    Key cachedKey;
+    src.Read(cachedKey.data(), cachedKey.size());
+    if (cachedKey != key)
+      return false;
+
+    if (ReadPrimitiveFromSource<uint64_t>(src) != weightsCount)
+      return false;
+
+    weights.resize(weightsCount);
+    for (auto & weight : weights)
+      weight = ReadPrimitiveFromSource<Weight>(src);
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read cross mwm weights from", path, e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+
+void CrossMwmWeightsCache::Save(std::string const & country, Key const & key,
+                                std::vector<Weight> const & weights) const
+{
+  auto const path = GetFilePath(country);
+  try
+  {
+    FileWriter writer(path);
+    WriteToSink(writer, kVersion);
+    writer.Write(key.data(), key.size());
+    WriteToSink(writer, static_cast<uint64_t>(weights.size()));
+    for (auto const weight : weights)
+      WriteToSink(writer, weight);
+  }
+  catch (Writer::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't write cross mwm weights to", path, e.Msg()));
+  }
+}
+
+std::string CrossMwmWeightsCache::GetFilePath(std::string const & country) const
+{
+  return base::JoinPath(m_dir, country + ".cross_mwm_weights");
+}
+}  // namespace generator
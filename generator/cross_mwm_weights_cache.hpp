@@ -0,0 +1,54 @@
+#pragma once
+
+#include "routing/cross_mwm_connector.hpp"
+#include "routing/edge_estimator.hpp"
+#include "routing/segment.hpp"
+
+#include "routing_common/vehicle_model.hpp"
+
+#include "coding/sha1.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace generator
+{
+// Weights of the cross-mwm connectors of the countries built before. Computing the weights runs
+// a wave from every enter of a country while the roads of most of the countries are the same
+// from build to build. The weights of a country are reused if the mwm sections which the graph
+// is built from, the transitions of the connector and the parameters of the vehicle model and
+// the edge estimator are the same as when they were computed.
+class CrossMwmWeightsCache
+{
+public:
+  using Key = coding::SHA1::Hash;
+  using Weight = routing::connector::Weight;
+
+  explicit CrossMwmWeightsCache(std::string const & dir);
+
+  // Returns a text with the parameters of |vehicleModel| and |estimator| the weights depend on.
+  static std::string GetWeightsParams(routing::VehicleModel const & vehicleModel,
+                                      routing::EdgeEstimator const & estimator);
+
+  // Returns the hash of the data the weights of |country| depend on: the routing section and
+  // the sections with the roads geometry, types, speeds and access of |mwmFile|, |enters|
+  // and |exits| of the connector and |weightsParams| made by GetWeightsParams().
+  static Key CalcKey(std::string const & mwmFile, std::string const & country,
+                     std::vector<routing::Segment> const & enters,
+                     std::vector<routing::Segment> const & exits,
+                     std::string const & weightsParams);
+
+  // Reads the weights of |country| computed for |key| to |weights|. Returns false if there are no
+  // such weights or their number differs from |weightsCount|.
+  bool Load(std::string const & country, Key const & key, size_t weightsCount,
+            std::vector<Weight> & weights) const;
+  void Save(std::string const & country, Key const & key,
+            std::vector<Weight> const & weights) const;
+
+private:
+  std::string GetFilePath(std::string const & country) const;
+
+  std::string m_dir;
+};
+}  // namespace generator
@@ -786,6 +786,27 @@ string DebugPrint(FeatureBuilder const & fb)
   return out.str();
 }
 
+vector<uint64_t> SplitRawFormatIntoBatches(uint8_t const * data, uint64_t size,
+                                           uint64_t batchSize)
+{
+  vector<uint64_t> batches;
+  ArrayByteSource src(data);
+  uint64_t pos = 0;
+  while (pos < size)
+  {
+    if (batches.empty() || pos - batches.back() >= batchSize)
+      batches.push_back(pos);
+
+    auto const sz = ReadVarUint<uint32_t>(src);
+    src.Advance(sz);
+    pos = static_cast<uint64_t>(src.PtrUint8() - data);
+    CHECK_LESS_OR_EQUAL(pos, size, ("Truncated features file."));
+  }
+
+  batches.push_back(size);
+  return batches;
+}
+
 namespace serialization_policy
 {
 // static
@@ -4,14 +4,19 @@
 
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/byte_stream.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/read_write_utils.hpp"
 
 #include "base/geo_object_id.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 #include "base/thread_pool_delayed.hpp"
 
 #include <functional>
+#include <future>
+#include <iterator>
 #include <list>
 #include <mutex>
 #include <string>
@@ -315,6 +320,107 @@ std::vector<FeatureBuilder> ReadAllDatRawFormat(std::string const & fileName)
   return fbs;
 }
 
+// Size of a batch of features file records which are deserialized by one task.
+uint64_t constexpr kRawFormatBatchSize = 4 * 1024 * 1024;
+
+// Splits |size| bytes of features file records starting at |data| into batches of whole records
+// of about |batchSize| bytes. Returns offsets of the batches beginnings followed by |size|.
+std::vector<uint64_t> SplitRawFormatIntoBatches(uint8_t const * data, uint64_t size,
+                                                uint64_t batchSize);
+
+// Calls |toDo(batchIndex, fb, pos)| for features of the memory-mapped features file. Batches of
+// records are deserialized on |threadsCount| threads, so |toDo| is called concurrently for
+// features of different batches and in the file order for features of the same batch.
+template <class SerializationPolicy = serialization_policy::MinSize, class ToDo>
+size_t ForEachBatchRawFormat(size_t threadsCount, std::string const & filename, ToDo && toDo)
+{
+  uint64_t fileSize = 0;
+  CHECK(base::GetFileSize(filename, fileSize), (filename));
+  // It is not possible to map an empty file.
+  if (fileSize == 0)
+    return 0;
+
+  MmapReader reader(filename, MmapReader::Advice::Sequential);
+  uint8_t const * data = reader.Data();
+  auto const batches = SplitRawFormatIntoBatches(data, fileSize, kRawFormatBatchSize);
+  size_t const batchesCount = batches.size() - 1;
+
+  base::thread_pool::computational::ThreadPool pool(threadsCount);
+  std::vector<std::future<void>> results;
+  results.reserve(batchesCount);
+  for (size_t i = 0; i < batchesCount; ++i)
+  {
+    results.emplace_back(pool.Submit([&, i]() {
+      ArrayByteSource src(data + batches[i]);
+      typename FeatureBuilder::Buffer buffer;
+      while (src.PtrUint8() < data + batches[i + 1])
+      {
+        uint64_t const pos = static_cast<uint64_t>(src.PtrUint8() - data);
+        uint32_t const sz = ReadVarUint<uint32_t>(src);
+        buffer.assign(src.PtrUint8(), src.PtrUint8() + sz);
+        src.Advance(sz);
+
+        FeatureBuilder fb;
+        SerializationPolicy::Deserialize(fb, buffer);
+        toDo(i, fb, pos);
+      }
+    }));
+  }
+
+  // Rethrows exceptions of the tasks.
+  for (auto & result : results)
+    result.get();
+
+  return batchesCount;
+}
+
+// Process features in features file on |threadsCount| threads. |toDo(fb, pos)| is called
+// concurrently and in an unspecified order, so it must be thread-safe.
+template <class SerializationPolicy = serialization_policy::MinSize, class ToDo>
+void ForEachParallelFeatureRawFormat(size_t threadsCount, std::string const & filename,
+                                     ToDo && toDo)
+{
+  if (threadsCount <= 1)
+  {
+    ForEachFeatureRawFormat<SerializationPolicy>(filename, std::forward<ToDo>(toDo));
+    return;
+  }
+
+  ForEachBatchRawFormat<SerializationPolicy>(
+      threadsCount, filename,
+      [&](size_t /* batchIndex */, auto && fb, uint64_t pos) { toDo(fb, pos); });
+}
+
+// Reads features of features file deserializing them on |threadsCount| threads. The features
+// are returned in the file order.
+template <class SerializationPolicy = serialization_policy::MinSize>
+std::vector<FeatureBuilder> ReadAllDatRawFormat(std::string const & fileName, size_t threadsCount)
+{
+  if (threadsCount <= 1)
+    return ReadAllDatRawFormat<SerializationPolicy>(fileName);
+
+  uint64_t fileSize = 0;
+  CHECK(base::GetFileSize(fileName, fileSize), (fileName));
+  // Every batch has its own vector, so no synchronization is needed. All batches but the last
+  // one are not smaller than kRawFormatBatchSize.
+  std::vector<std::vector<FeatureBuilder>> batches(fileSize / kRawFormatBatchSize + 1);
+  auto const batchesCount = ForEachBatchRawFormat<SerializationPolicy>(
+      threadsCount, fileName, [&](size_t batchIndex, auto && fb, uint64_t /* pos */) {
+        batches[batchIndex].emplace_back(std::move(fb));
+      });
+  CHECK_LESS_OR_EQUAL(batchesCount, batches.size(), ());
+
+  size_t total = 0;
+  for (auto const & batch : batches)
+    total += batch.size();
+
+  std::vector<FeatureBuilder> fbs;
+  fbs.reserve(total);
+  for (auto & batch : batches)
+    std::move(batch.begin(), batch.end(), std::back_inserter(fbs));
+  return fbs;
+}
+
 template <class SerializationPolicy = serialization_policy::MinSize, class Writer = FileWriter>
 class FeatureBuilderWriter
 {
@@ -7,9 +7,38 @@
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <utility>
 
 using namespace std;
 
+namespace
+{
+// Position of (x, y) on the Hilbert curve which fills the square of 2^|bits| side.
+uint64_t HilbertIndex(uint32_t x, uint32_t y, uint8_t bits)
+{
+  uint32_t const mask = static_cast<uint32_t>((uint64_t{1} << bits) - 1);
+  uint64_t index = 0;
+  for (uint32_t s = uint32_t{1} << (bits - 1); s > 0; s >>= 1)
+  {
+    uint32_t const rx = (x & s) != 0 ? 1 : 0;
+    uint32_t const ry = (y & s) != 0 ? 1 : 0;
+    index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+    // Rotates the quadrant so that the curve in it starts from the origin.
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = mask - x;
+        y = mask - y;
+      }
+      swap(x, y);
+    }
+  }
+  return index;
+}
+}  // namespace
+
 namespace feature
 {
 CalculateMidPoints::CalculateMidPoints()
@@ -30,7 +59,16 @@ void CalculateMidPoints::operator()(FeatureBuilder const & ft, uint64_t pos)
   ASSERT_NOT_EQUAL(m_locCount, 0, ());
   m_midLoc = m_midLoc / m_locCount;
 
-  uint64_t const pointAsInt64 = PointToInt64Obsolete(m_midLoc, m_coordBits);
+  uint64_t pointAsInt64 = 0;
+  if (m_order == Order::Hilbert)
+  {
+    auto const p = PointDToPointU(m_midLoc, m_coordBits);
+    pointAsInt64 = HilbertIndex(p.x, p.y, m_coordBits);
+  }
+  else
+  {
+    pointAsInt64 = PointToInt64Obsolete(m_midLoc, m_coordBits);
+  }
   int const minScale = m_minDrawableScalePolicy(ft.GetTypesHolder(), ft.GetLimitRect());
 
   /// May be invisible if it's small area object with [0-9] scales.
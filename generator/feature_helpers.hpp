@@ -30,6 +30,16 @@ public:
   using CellAndOffset = std::pair<uint64_t, uint64_t>;
   using MinDrawableScalePolicy = std::function<int(TypesHolder const & types, m2::RectD limitRect)>;
 
+  // Order of the features with the same min drawable scale.
+  enum class Order
+  {
+    // By the cells of the middle points (Z-order curve).
+    Cells,
+    // By the Hilbert curve of the middle points. Unlike the Z-order curve it has no long jumps,
+    // so the features which are read for a viewport are closer to each other in the file.
+    Hilbert
+  };
+
   CalculateMidPoints();
   CalculateMidPoints(MinDrawableScalePolicy const & minDrawableScalePolicy);
 
@@ -39,6 +49,7 @@ public:
   m2::PointD GetCenter() const;
   std::vector<CellAndOffset> const & GetVector() const { return m_vec; }
 
+  void SetOrder(Order order) { m_order = order; }
   void Sort();
 
 private:
@@ -47,6 +58,7 @@ private:
   size_t m_locCount = 0;
   size_t m_allCount = 0;
   uint8_t m_coordBits = serial::GeometryCodingParams().GetCoordBits();
+  Order m_order = Order::Cells;
   MinDrawableScalePolicy m_minDrawableScalePolicy;
   std::vector<CellAndOffset> m_vec;
 };
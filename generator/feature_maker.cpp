@@ -41,6 +41,8 @@ bool FeatureMakerSimple::BuildFromWay(OsmElement & p, FeatureBuilderParams const
   if (nodes.size() < 2)
     return false;
 
+  m_cache->PrefetchNodes(nodes);
+
   FeatureBuilder fb;
   m2::PointD pt;
   for (uint64_t ref : nodes)
@@ -36,11 +36,16 @@
 #include "base/assert.hpp"
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
+#include "base/profiler.hpp"
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include "defines.hpp"
 
+#include <algorithm>
+#include <array>
+#include <future>
 #include <limits>
 #include <list>
 #include <memory>
@@ -151,19 +156,55 @@ public:
       FileWriter osm2ftWriter(m_filename + OSM2FEATURE_FILE_EXTENSION);
       m_osm2ft.Write(osm2ftWriter);
     }
+
+    LOG(LINFO, ("Tesselated areas of", m_filename, "convex:", m_tesselatorStats.m_convex.load(),
+                "libtess:", m_tesselatorStats.m_generic.load()));
   }
 
   void SetBounds(m2::RectD bounds) { m_bounds = bounds; }
 
+  // Outer geometry and triangles of a feature encoded for all the scales. Encoding does not depend
+  // on the other features, so features may be encoded in parallel and written in order later.
+  struct EncodedFeature
+  {
+    FeatureBuilder::SupportingData m_data;
+    // Encoded outer geometry and triangles by scale index.
+    vector<FeatureBuilder::Buffer> m_geometry;
+    vector<FeatureBuilder::Buffer> m_triangles;
+  };
+
   uint32_t operator()(FeatureBuilder & fb)
   {
-    GeometryHolder holder([this](int i) -> FileWriter & { return *m_geoFile[i]; },
-                          [this](int i) -> FileWriter & { return *m_trgFile[i]; }, fb, m_header);
+    EncodedFeature encoded;
+    Encode(fb, encoded);
+    return Write(fb, encoded);
+  }
+
+  // Simplifies and encodes geometry of |fb|. Thread-safe.
+  void Encode(FeatureBuilder & fb, EncodedFeature & encoded) const
+  {
+    size_t const scalesCount = m_header.GetScalesCount();
+    encoded.m_geometry.assign(scalesCount, {});
+    encoded.m_triangles.assign(scalesCount, {});
+
+    vector<MemWriter<FeatureBuilder::Buffer>> geoWriters;
+    vector<MemWriter<FeatureBuilder::Buffer>> trgWriters;
+    geoWriters.reserve(scalesCount);
+    trgWriters.reserve(scalesCount);
+    for (size_t i = 0; i < scalesCount; ++i)
+    {
+      geoWriters.emplace_back(encoded.m_geometry[i]);
+      trgWriters.emplace_back(encoded.m_triangles[i]);
+    }
+
+    GeometryHolder holder([&geoWriters](int i) -> Writer & { return geoWriters[i]; },
+                          [&trgWriters](int i) -> Writer & { return trgWriters[i]; }, fb, m_header);
+    holder.SetTesselatorStats(&m_tesselatorStats);
 
     bool const isLine = fb.IsLine();
     bool const isArea = fb.IsArea();
 
-    int const scalesStart = static_cast<int>(m_header.GetScalesCount()) - 1;
+    int const scalesStart = static_cast<int>(scalesCount) - 1;
     for (int i = scalesStart; i >= 0; --i)
     {
       int const level = m_header.GetScale(i);
@@ -232,8 +273,17 @@ public:
       }
     }
 
+    encoded.m_data = move(holder.GetBuffer());
+  }
+
+  // Writes |fb| with geometry encoded by Encode(). Features must be written in the sorted order.
+  uint32_t Write(FeatureBuilder & fb, EncodedFeature & encoded)
+  {
+    auto & buffer = encoded.m_data;
+    WriteOuter(encoded.m_geometry, buffer.m_ptsMask, m_geoFile, buffer.m_ptsOffset);
+    WriteOuter(encoded.m_triangles, buffer.m_trgMask, m_trgFile, buffer.m_trgOffset);
+
     uint32_t featureId = kInvalidFeatureId;
-    auto & buffer = holder.GetBuffer();
     if (fb.PreSerializeAndRemoveUselessNamesForMwm(buffer))
     {
       fb.SerializeForMwm(buffer, m_header.GetDefGeometryCodingParams());
@@ -267,6 +317,24 @@ private:
 
   using TmpFiles = vector<unique_ptr<TmpFile>>;
 
+  // Appends encoded outer geometry of the scales from |mask| to |files| and fills |offsets| with
+  // positions of the geometry in the files. Offsets go from the upper scale to the lower one.
+  static void WriteOuter(vector<FeatureBuilder::Buffer> const & encoded, uint8_t mask,
+                         TmpFiles & files, FeatureBuilder::Offsets & offsets)
+  {
+    size_t offsetIdx = 0;
+    for (int i = static_cast<int>(files.size()) - 1; i >= 0; --i)
+    {
+      if ((mask & (1 << i)) == 0)
+        continue;
+
+      CHECK_LESS(offsetIdx, offsets.size(), ());
+      offsets[offsetIdx++] = CheckedFilePosCast(*files[i]);
+      files[i]->Write(encoded[i].data(), encoded[i].size());
+    }
+    CHECK_EQUAL(offsetIdx, offsets.size(), ());
+  }
+
   static bool IsGoodArea(Points const & poly, int level)
   {
     // Area has the same first and last points. That's why minimal number of points for
@@ -282,8 +350,8 @@ private:
 
   bool IsCountry() const { return m_header.GetType() == feature::DataHeader::MapType::Country; }
 
-  void SimplifyPoints(int level, bool isCoast, m2::RectD const & rect, Points const & in,
-                      Points & out)
+  static void SimplifyPoints(int level, bool isCoast, m2::RectD const & rect, Points const & in,
+                             Points & out)
   {
     if (isCoast)
     {
@@ -313,22 +381,109 @@ private:
 
   generator::OsmID2FeatureID m_osm2ft;
 
+  // Encode() is called from several threads.
+  mutable tesselator::Stats m_tesselatorStats;
+
   DISALLOW_COPY_AND_MOVE(FeaturesCollector2);
 };
 
+namespace
+{
+// Number of features which are encoded in parallel while the previous ones are being written.
+size_t constexpr kEncodingBatchSize = 4096;
+
+// Reads features at |points| offsets of |reader| and passes them to |collector| in the same order.
+void CollectFeatures(FileReader const & reader,
+                     vector<CalculateMidPoints::CellAndOffset> const & points, size_t threadsCount,
+                     FeaturesCollector2 & collector)
+{
+  auto const readFeature = [&reader](uint64_t offset, FeatureBuilder & fb) {
+    ReaderSource<FileReader> src(reader);
+    src.Skip(offset);
+    ReadFromSourceRawFormat(src, fb);
+  };
+
+  if (threadsCount <= 1)
+  {
+    for (auto const & point : points)
+    {
+      FeatureBuilder fb;
+      readFeature(point.second, fb);
+      collector(fb);
+    }
+    return;
+  }
+
+  struct Batch
+  {
+    vector<FeatureBuilder> m_features;
+    vector<FeaturesCollector2::EncodedFeature> m_encoded;
+    vector<future<void>> m_tasks;
+  };
+
+  // Batches are declared before the pool to outlive the tasks.
+  array<Batch, 2> batches;
+  base::thread_pool::computational::ThreadPool pool(threadsCount);
+
+  auto const encode = [&](size_t beg, Batch & batch) {
+    size_t const count = min(kEncodingBatchSize, points.size() - beg);
+    batch.m_features.clear();
+    batch.m_features.resize(count);
+    batch.m_encoded.clear();
+    batch.m_encoded.resize(count);
+    for (size_t i = 0; i < count; ++i)
+      readFeature(points[beg + i].second, batch.m_features[i]);
+
+    batch.m_tasks.clear();
+    size_t const chunkSize = (count + threadsCount - 1) / threadsCount;
+    for (size_t chunkBeg = 0; chunkBeg < count; chunkBeg += chunkSize)
+    {
+      size_t const chunkEnd = min(chunkBeg + chunkSize, count);
+      batch.m_tasks.push_back(pool.Submit([&collector, &batch, chunkBeg, chunkEnd]() {
+        for (size_t i = chunkBeg; i < chunkEnd; ++i)
+          collector.Encode(batch.m_features[i], batch.m_encoded[i]);
+      }));
+    }
+  };
+
+  auto const write = [&](Batch & batch) {
+    for (auto & task : batch.m_tasks)
+      task.get();
+    for (size_t i = 0; i < batch.m_features.size(); ++i)
+      collector.Write(batch.m_features[i], batch.m_encoded[i]);
+  };
+
+  if (points.empty())
+    return;
+
+  size_t current = 0;
+  encode(0 /* beg */, batches[current]);
+  for (size_t beg = kEncodingBatchSize; beg < points.size(); beg += kEncodingBatchSize)
+  {
+    encode(beg, batches[current ^ 1]);
+    write(batches[current]);
+    current ^= 1;
+  }
+  write(batches[current]);
+}
+}  // namespace
+
 bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & name,
-                           feature::DataHeader::MapType mapType)
+                           feature::DataHeader::MapType mapType, size_t threadsCount)
 {
+  PROFILER_SCOPE("GenerateFinalFeatures");
   string const srcFilePath = info.GetTmpFileName(name);
   string const dataFilePath = info.GetTargetFileName(name);
 
   // Store cellIds for middle points.
   CalculateMidPoints midPoints;
+  if (info.m_hilbertFeaturesOrder)
+    midPoints.SetOrder(CalculateMidPoints::Order::Hilbert);
   ForEachFeatureRawFormat(srcFilePath, [&midPoints](FeatureBuilder const & fb, uint64_t pos) {
     midPoints(fb, pos);
   });
 
-  // Sort features by their middle point.
+  // Sort features by their min drawable scale and middle point.
   midPoints.Sort();
 
   // Store sorted features.
@@ -360,15 +515,7 @@ bool GenerateFinalFeatures(feature::GenerateInfo const & info, string const & na
       // We cannot remove it in ~FeaturesCollector2(), we need to remove it in SCOPE_GUARD.
       SCOPE_GUARD(_, [&]() { Platform::RemoveFileIfExists(info.GetTargetFileName(name, FEATURES_FILE_TAG)); });
       FeaturesCollector2 collector(name, info, header, regionData, info.m_versionDate);
-      for (auto const & point : midPoints.GetVector())
-      {
-        ReaderSource<FileReader> src(reader);
-        src.Skip(point.second);
-
-        FeatureBuilder fb;
-        ReadFromSourceRawFormat(src, fb);
-        collector(fb);
-      }
+      CollectFeatures(reader, midPoints.GetVector(), threadsCount, collector);
 
       // Update bounds with the limit rect corresponding to region borders.
       // Bounds before update can be too big because of big invisible features like a
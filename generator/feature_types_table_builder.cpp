@@ -0,0 +1,42 @@
+#include "generator/feature_types_table_builder.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_processor.hpp"
+#include "indexer/feature_types_table.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace indexer
+{
+bool BuildFeatureTypesTable(std::string const & filename)
+{
+  try
+  {
+    FeatureTypesTableBuilder builder;
+    feature::ForEachFeature(filename, [&builder](FeatureType & ft, uint32_t featureId) {
+      std::vector<uint32_t> types;
+      ft.ForEachType([&types](uint32_t type) { types.push_back(type); });
+      builder.Put(featureId, types);
+    });
+
+    FilesContainerW writeContainer(filename, FileWriter::OP_WRITE_EXISTING);
+    auto writer = writeContainer.GetWriter(FEATURE_TYPES_FILE_TAG);
+    builder.Freeze(*writer);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to build feature types table:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace indexer
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+
+namespace indexer
+{
+// Builds the feature types section and writes it to the mwm file.
+bool BuildFeatureTypesTable(std::string const & filename);
+}  // namespace indexer
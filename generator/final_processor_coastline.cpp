@@ -3,6 +3,7 @@
 #include "generator/feature_builder.hpp"
 #include "generator/feature_generator.hpp"
 #include "generator/final_processor_utils.hpp"
+#include "generator/stages_profiler.hpp"
 
 #include <vector>
 
@@ -10,9 +11,11 @@ using namespace feature;
 
 namespace generator
 {
-CoastlineFinalProcessor::CoastlineFinalProcessor(std::string const & filename)
+CoastlineFinalProcessor::CoastlineFinalProcessor(std::string const & filename,
+                                                 size_t threadsCount)
   : FinalProcessorIntermediateMwmInterface(FinalProcessorPriority::WorldCoasts)
   , m_filename(filename)
+  , m_threadsCount(threadsCount)
 {
 }
 
@@ -25,7 +28,8 @@ void CoastlineFinalProcessor::SetCoastlinesFilenames(std::string const & geomFil
 
 void CoastlineFinalProcessor::Process()
 {
-  auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(m_filename);
+  StagesProfiler::Scope scope("final_processor/coastline");
+  auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(m_filename, m_threadsCount);
   Order(fbs);
   for (auto && fb : fbs)
     m_generator.Process(std::move(fb));
@@ -38,7 +42,7 @@ void CoastlineFinalProcessor::Process()
   size_t totalPoints = 0;
   size_t totalPolygons = 0;
   std::vector<FeatureBuilder> outputFbs;
-  m_generator.GetFeatures(outputFbs);
+  m_generator.GetFeatures(m_threadsCount, outputFbs);
   for (auto & fb : outputFbs)
   {
     collector.Collect(fb);
@@ -3,6 +3,7 @@
 #include "generator/coastlines_generator.hpp"
 #include "generator/final_processor_interface.hpp"
 
+#include <cstddef>
 #include <string>
 
 namespace generator
@@ -10,7 +11,7 @@ namespace generator
 class CoastlineFinalProcessor : public FinalProcessorIntermediateMwmInterface
 {
 public:
-  explicit CoastlineFinalProcessor(std::string const & filename);
+  CoastlineFinalProcessor(std::string const & filename, size_t threadsCount);
 
   void SetCoastlinesFilenames(std::string const & geomFilename,
                               std::string const & rawGeomFilename);
@@ -22,6 +23,7 @@ private:
   std::string m_filename;
   std::string m_coastlineGeomFilename;
   std::string m_coastlineRawGeomFilename;
+  size_t m_threadsCount;
   CoastlineFeaturesGenerator m_generator;
 };
 }  // namespace generator
@@ -12,6 +12,7 @@
 #include "generator/promo_catalog_cities.hpp"
 #include "generator/region_meta.hpp"
 #include "generator/routing_city_boundaries_processor.hpp"
+#include "generator/stages_profiler.hpp"
 
 #include "routing/routing_helpers.hpp"
 #include "routing/speed_camera_prohibition.hpp"
@@ -101,28 +102,35 @@ void CountryFinalProcessor::SetMiniRoundabouts(std::string const & filename)
 
 void CountryFinalProcessor::SetIsolinesDir(std::string const & dir) { m_isolinesPath = dir; }
 
+void CountryFinalProcessor::SetMemoryBudget(uint64_t bytes) { m_memoryBudgetBytes = bytes; }
+
 void CountryFinalProcessor::Process()
 {
-  Order();
+  auto const runStage = [this](std::string const & name, void (CountryFinalProcessor::*stage)()) {
+    StagesProfiler::Scope scope("final_processor/country/" + name);
+    (this->*stage)();
+  };
+
+  runStage("order", &CountryFinalProcessor::Order);
 
   if (!m_hotelsFilename.empty())
-    ProcessBooking();
+    runStage("booking", &CountryFinalProcessor::ProcessBooking);
   if (!m_routingCityBoundariesCollectorFilename.empty())
-    ProcessRoutingCityBoundaries();
+    runStage("routing_city_boundaries", &CountryFinalProcessor::ProcessRoutingCityBoundaries);
   if (!m_citiesAreasTmpFilename.empty() || !m_citiesFilename.empty())
-    ProcessCities();
+    runStage("cities", &CountryFinalProcessor::ProcessCities);
   if (!m_coastlineGeomFilename.empty())
-    ProcessCoastline();
+    runStage("coastline", &CountryFinalProcessor::ProcessCoastline);
   if (!m_miniRoundaboutsFilename.empty())
-    ProcessRoundabouts();
+    runStage("roundabouts", &CountryFinalProcessor::ProcessRoundabouts);
   if (!m_fakeNodesFilename.empty())
-    AddFakeNodes();
+    runStage("fake_nodes", &CountryFinalProcessor::AddFakeNodes);
   if (!m_isolinesPath.empty())
-    AddIsolines();
+    runStage("isolines", &CountryFinalProcessor::AddIsolines);
 
-  DropProhibitedSpeedCameras();
-  ProcessBuildingParts();
-  Finish();
+  runStage("speed_cameras", &CountryFinalProcessor::DropProhibitedSpeedCameras);
+  runStage("building_parts", &CountryFinalProcessor::ProcessBuildingParts);
+  runStage("finish", &CountryFinalProcessor::Finish);
 }
 
 void CountryFinalProcessor::Order()
@@ -133,6 +141,7 @@ void CountryFinalProcessor::Order()
         if (!IsCountry(country))
           return;
 
+        StagesProfiler::Scope scope("final_processor/country/order/" + country);
         auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(path);
         generator::Order(fbs);
 
@@ -140,7 +149,7 @@ void CountryFinalProcessor::Order()
         for (auto const & fb : fbs)
           writer.Write(fb);
       },
-      m_threadsCount);
+      m_threadsCount, m_memoryBudgetBytes);
 }
 
 void CountryFinalProcessor::ProcessBooking()
@@ -188,7 +197,7 @@ void CountryFinalProcessor::ProcessBooking()
 
     std::lock_guard _(m);
     matchingLogStream << sstream.str();
-  }, m_threadsCount);
+  }, m_threadsCount, m_memoryBudgetBytes);
 
   std::vector<FeatureBuilder> fbs;
   dataset.BuildOsmObjects([&](auto && fb) { fbs.emplace_back(std::move(fb)); });
@@ -221,7 +230,7 @@ void CountryFinalProcessor::ProcessRoundabouts()
     // Transforms points on roads to connect them with these new roundabout junctions.
     for (auto const & fb : transformer.ProcessRoundabouts())
       writer.Write(fb);
-  }, m_threadsCount);
+  }, m_threadsCount, m_memoryBudgetBytes);
 }
 
 bool DoesBuildingConsistOfParts(FeatureBuilder const & fbBuilding,
@@ -290,7 +299,7 @@ void CountryFinalProcessor::ProcessBuildingParts()
 
       writer.Write(fb);
     });
-  }, m_threadsCount);
+  }, m_threadsCount, m_memoryBudgetBytes);
 }
 
 void CountryFinalProcessor::AddIsolines()
@@ -304,7 +313,7 @@ void CountryFinalProcessor::AddIsolines()
 
     FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(path, FileWriter::Op::OP_APPEND);
     isolineFeaturesGenerator.GenerateIsolines(name, [&](auto const & fb) { writer.Write(fb); });
-  }, m_threadsCount);
+  }, m_threadsCount, m_memoryBudgetBytes);
 }
 
 void CountryFinalProcessor::ProcessRoutingCityBoundaries()
@@ -337,7 +346,7 @@ void CountryFinalProcessor::ProcessCities()
 
 void CountryFinalProcessor::ProcessCoastline()
 {
-  auto fbs = ReadAllDatRawFormat(m_coastlineGeomFilename);
+  auto fbs = ReadAllDatRawFormat(m_coastlineGeomFilename, m_threadsCount);
   auto const affiliations = AppendToMwmTmp(fbs, *m_affiliations, m_temporaryMwmPath, m_threadsCount);
   FeatureBuilderWriter<> collector(m_worldCoastsFilename);
   for (size_t i = 0; i < fbs.size(); ++i)
@@ -378,7 +387,7 @@ void CountryFinalProcessor::DropProhibitedSpeedCameras()
 
       writer.Write(fb);
     });
-  }, m_threadsCount);
+  }, m_threadsCount, m_memoryBudgetBytes);
 }
 
 void CountryFinalProcessor::Finish()
@@ -387,6 +396,7 @@ void CountryFinalProcessor::Finish()
     if (!IsCountry(country))
       return;
 
+    StagesProfiler::Scope scope("final_processor/country/finish/" + country);
     auto fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(path);
     generator::Order(fbs);
 
@@ -394,6 +404,6 @@ void CountryFinalProcessor::Finish()
     for (auto const & fb : fbs)
       writer.Write(fb);
 
-  }, m_threadsCount);
+  }, m_threadsCount, m_memoryBudgetBytes);
 }
 }  // namespace generator
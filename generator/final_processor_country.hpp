@@ -4,6 +4,7 @@
 #include "generator/place_processor.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -30,6 +31,9 @@ public:
   void SetFakeNodes(std::string const & filename);
   void SetMiniRoundabouts(std::string const & filename);
   void SetIsolinesDir(std::string const & dir);
+  // Countries are processed in parallel so that their estimated working sets fit into |bytes|.
+  // Zero means the memory is not limited.
+  void SetMemoryBudget(uint64_t bytes);
 
   void DumpCitiesBoundaries(std::string const & filename);
   void DumpRoutingCitiesBoundaries(std::string const & collectorFilename,
@@ -73,5 +77,6 @@ private:
   std::unique_ptr<feature::AffiliationInterface> m_affiliations;
 
   size_t m_threadsCount;
+  uint64_t m_memoryBudgetBytes = 0;
 };
 }  // namespace generator
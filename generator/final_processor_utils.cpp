@@ -4,11 +4,15 @@
 
 #include "indexer/feature_data.hpp"
 
+#include "base/assert.hpp"
+#include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <condition_variable>
 #include <fstream>
 #include <iterator>
+#include <list>
 #include <mutex>
 #include <tuple>
 #include <utility>
@@ -18,6 +22,68 @@ using namespace feature;
 
 namespace generator
 {
+MemoryBudgetScheduler::MemoryBudgetScheduler(size_t threadsCount, uint64_t memoryBudgetBytes)
+  : m_threadsCount(threadsCount), m_memoryBudgetBytes(memoryBudgetBytes)
+{
+  CHECK_GREATER(m_threadsCount, 0, ());
+}
+
+void MemoryBudgetScheduler::Run(std::vector<Job> && jobs)
+{
+  std::stable_sort(jobs.begin(), jobs.end(), [](Job const & lhs, Job const & rhs) {
+    return lhs.m_memoryBytes > rhs.m_memoryBytes;
+  });
+  std::list<Job> pending(std::make_move_iterator(jobs.begin()),
+                         std::make_move_iterator(jobs.end()));
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t inProgress = 0;
+  uint64_t memoryInUse = 0;
+
+  ThreadPool pool(m_threadsCount);
+  std::unique_lock<std::mutex> lock(mutex);
+  while (!pending.empty())
+  {
+    // A job is started when a thread is free for it, so the choice of the job is made with
+    // the most recent memory usage.
+    auto job = pending.end();
+    cv.wait(lock, [&]() {
+      if (inProgress == m_threadsCount)
+        return false;
+
+      if (inProgress == 0 || m_memoryBudgetBytes == 0)
+      {
+        job = pending.begin();
+        return true;
+      }
+
+      job = std::find_if(pending.begin(), pending.end(), [&](Job const & j) {
+        return memoryInUse + j.m_memoryBytes <= m_memoryBudgetBytes;
+      });
+      return job != pending.end();
+    });
+
+    ++inProgress;
+    memoryInUse += job->m_memoryBytes;
+    pool.SubmitWork([&, memoryBytes = job->m_memoryBytes, fn = std::move(job->m_fn)]() {
+      SCOPE_GUARD(release, [&]() {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          --inProgress;
+          memoryInUse -= memoryBytes;
+        }
+        cv.notify_one();
+      });
+      fn();
+    });
+    pending.erase(job);
+  }
+
+  // The pool waits for the jobs in its destructor.
+  lock.unlock();
+}
+
 ProcessorCities::ProcessorCities(std::string const & temporaryMwmPath,
                                  AffiliationInterface const & affiliation,
                                  PlaceHelper & citiesHelper, size_t threadsCount)
@@ -55,7 +121,7 @@ void ProcessorCities::Process()
   for (auto const & city : allCities)
     m_citiesHelper.Process(city);
 
-  auto fbsWithIds = m_citiesHelper.GetFeatures();
+  auto fbsWithIds = m_citiesHelper.GetFeatures(m_threadsCount);
   if (!m_citiesFilename.empty())
     ProcessForPromoCatalog(fbsWithIds);
 
@@ -109,9 +175,9 @@ bool PlaceHelper::Process(feature::FeatureBuilder const & fb)
   return true;
 }
 
-std::vector<PlaceProcessor::PlaceWithIds> PlaceHelper::GetFeatures()
+std::vector<PlaceProcessor::PlaceWithIds> PlaceHelper::GetFeatures(size_t threadsCount)
 {
-  return m_processor.ProcessPlaces();
+  return m_processor.ProcessPlaces(threadsCount);
 }
 
 std::shared_ptr<OsmIdToBoundariesTable> PlaceHelper::GetTable() const { return m_table; }
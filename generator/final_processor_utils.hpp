@@ -11,12 +11,15 @@
 #include "platform/platform.hpp"
 
 #include "base/file_name_utils.hpp"
+#include "base/macros.hpp"
 #include "base/string_utils.hpp"
 #include "base/thread_pool_computational.hpp"
 
 #include "defines.hpp"
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -33,7 +36,7 @@ public:
   static bool IsPlace(feature::FeatureBuilder const & fb);
 
   bool Process(feature::FeatureBuilder const & fb);
-  std::vector<PlaceProcessor::PlaceWithIds> GetFeatures();
+  std::vector<PlaceProcessor::PlaceWithIds> GetFeatures(size_t threadsCount = 1);
   std::shared_ptr<OsmIdToBoundariesTable> GetTable() const;
 
 private:
@@ -62,18 +65,64 @@ private:
   size_t m_threadsCount;
 };
 
+// Runs jobs on a thread pool so that the sum of the estimated memory of the jobs in progress
+// doesn't exceed the budget. The biggest jobs are started first, so they don't finish last. When
+// the biggest pending job doesn't fit into the rest of the budget a smaller one is started.
+// A job which doesn't fit into the budget alone is started when no other job is in progress.
+class MemoryBudgetScheduler
+{
+public:
+  struct Job
+  {
+    Job(uint64_t memoryBytes, std::function<void()> && fn)
+      : m_memoryBytes(memoryBytes), m_fn(std::move(fn))
+    {
+    }
+
+    uint64_t m_memoryBytes = 0;
+    std::function<void()> m_fn;
+  };
+
+  // |memoryBudgetBytes| equal to zero means the memory is not limited.
+  MemoryBudgetScheduler(size_t threadsCount, uint64_t memoryBudgetBytes);
+
+  // Runs |jobs| and waits for all of them.
+  void Run(std::vector<Job> && jobs);
+
+private:
+  size_t m_threadsCount;
+  uint64_t m_memoryBudgetBytes;
+};
+
+// The working set of a country processing is estimated as the size of its mwm.tmp file
+// multiplied by this factor: the features are read from the file and processed in memory.
+uint64_t constexpr kMwmTmpWorkingSetFactor = 4;
+
+// Calls |toDo| for every mwm.tmp file in |temporaryMwmPath| on |threadsCount| threads, the
+// biggest files first. If |memoryBudgetBytes| isn't zero the estimated working sets of the
+// countries processed at the same time fit into it, see MemoryBudgetScheduler.
 template <typename ToDo>
-void ForEachMwmTmp(std::string const & temporaryMwmPath, ToDo && toDo, size_t threadsCount = 1)
+void ForEachMwmTmp(std::string const & temporaryMwmPath, ToDo && toDo, size_t threadsCount = 1,
+                   uint64_t memoryBudgetBytes = 0)
 {
   Platform::FilesList fileList;
   Platform::GetFilesByExt(temporaryMwmPath, DATA_FILE_EXTENSION_TMP, fileList);
-  base::thread_pool::computational::ThreadPool pool(threadsCount);
+  std::vector<MemoryBudgetScheduler::Job> jobs;
+  jobs.reserve(fileList.size());
   for (auto const & filename : fileList)
   {
     auto countryName = filename;
     strings::ReplaceLast(countryName, DATA_FILE_EXTENSION_TMP, "");
-    pool.SubmitWork(std::forward<ToDo>(toDo), countryName, base::JoinPath(temporaryMwmPath, filename));
+    auto path = base::JoinPath(temporaryMwmPath, filename);
+    uint64_t size = 0;
+    UNUSED_VALUE(Platform::GetFileSizeByFullPath(path, size));
+    jobs.emplace_back(size * kMwmTmpWorkingSetFactor,
+                      [&toDo, countryName = std::move(countryName), path = std::move(path)]() {
+                        toDo(countryName, path);
+                      });
   }
+
+  MemoryBudgetScheduler(threadsCount, memoryBudgetBytes).Run(std::move(jobs));
 }
 
 std::vector<std::vector<std::string>> GetAffiliations(
@@ -3,6 +3,7 @@
 #include "generator/affiliation.hpp"
 #include "generator/feature_builder.hpp"
 #include "generator/final_processor_utils.hpp"
+#include "generator/stages_profiler.hpp"
 
 #include "defines.hpp"
 
@@ -37,6 +38,7 @@ void WorldFinalProcessor::SetPromoCatalog(std::string const & filename)
 
 void WorldFinalProcessor::Process()
 {
+  StagesProfiler::Scope scope("final_processor/world");
   if (!m_citiesAreasTmpFilename.empty() || !m_citiesFilename.empty())
     ProcessCities();
 
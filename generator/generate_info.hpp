@@ -19,13 +19,15 @@ struct GenerateInfo
   {
     Memory,
     Index,
-    File
+    File,
+    Packed
   };
 
   enum class OsmSourceType
   {
     XML,
-    O5M
+    O5M,
+    PBF
   };
 
   // Directory for .mwm.tmp files.
@@ -66,6 +68,10 @@ struct GenerateInfo
 
   uint32_t m_versionDate = 0;
 
+  // Memory budget of the parallel processing of the countries by the final processor,
+  // zero means unlimited.
+  uint64_t m_finalProcessingMemoryBytes = 0;
+
   std::vector<std::string> m_bucketNames;
 
   bool m_createWorld = false;
@@ -75,6 +81,8 @@ struct GenerateInfo
   bool m_failOnCoasts = false;
   bool m_preloadCache = false;
   bool m_verbose = false;
+  // Order the features with the same min drawable scale by the Hilbert curve.
+  bool m_hilbertFeaturesOrder = false;
 
   GenerateInfo() = default;
 
@@ -84,6 +92,8 @@ struct GenerateInfo
       m_osmFileType = OsmSourceType::XML;
     else if (type == "o5m")
       m_osmFileType = OsmSourceType::O5M;
+    else if (type == "pbf")
+      m_osmFileType = OsmSourceType::PBF;
     else
       LOG(LCRITICAL, ("Unknown source type:", type));
   }
@@ -96,6 +106,8 @@ struct GenerateInfo
       m_nodeStorageType = NodeStorageType::Index;
     else if (type == "mem")
       m_nodeStorageType = NodeStorageType::Memory;
+    else if (type == "packed")
+      m_nodeStorageType = NodeStorageType::Packed;
     else
       LOG(LCRITICAL, ("Incorrect node_storage type:", type));
   }
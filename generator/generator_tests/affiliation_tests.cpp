@@ -1,6 +1,7 @@
 #include "testing/testing.hpp"
 
 #include "generator/affiliation.hpp"
+#include "generator/borders.hpp"
 #include "generator/feature_builder.hpp"
 
 #include "indexer/classificator.hpp"
@@ -9,11 +10,14 @@
 #include "platform/platform.hpp"
 
 #include "geometry/point2d.hpp"
+#include "geometry/region2d.hpp"
 
 #include "base/assert.hpp"
 #include "base/file_name_utils.hpp"
 
 #include <fstream>
+#include <functional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -197,4 +201,52 @@ UNIT_CLASS_TEST(AffiliationTests, CountriesFilesIndexAffiliationTests)
   TestCountriesFilesAffiliation<feature::CountriesFilesIndexAffiliation>(
       AffiliationTests::GetBorderPath());
 }
+
+UNIT_TEST(CountriesFilesIndexAffiliationCellTests)
+{
+  auto const makeCountry = [](std::string const & name, std::vector<m2::PointD> const & points) {
+    borders::PolygonsTree polygons;
+    m2::RegionD region(points);
+    polygons.Add(region, region.GetRect());
+    return borders::CountryPolygons(name, polygons);
+  };
+
+  auto const one =
+      makeCountry(AffiliationTests::kOne, {{0.1, 0.0}, {0.0, 0.1}, {0.1, 0.2}, {0.2, 0.1}});
+  auto const two =
+      makeCountry(AffiliationTests::kTwo, {{0.2, 0.0}, {0.1, 0.1}, {0.2, 0.2}, {0.3, 0.1}});
+
+  feature::CountriesFilesIndexAffiliation::Cell const cell(
+      {0.0, 0.0, 0.2, 0.2}, {std::cref(one), std::cref(two)});
+  TEST(!cell.GetCountry(), ());
+
+  size_t testsCount = 0;
+  size_t constexpr kSteps = 100;
+  for (size_t i = 0; i <= kSteps; ++i)
+  {
+    for (size_t j = 0; j <= kSteps; ++j)
+    {
+      m2::PointD const point(0.2 * i / kSteps, 0.2 * j / kSteps);
+      std::set<std::string> countries;
+      cell.ForEachCountry(point, [&](borders::CountryPolygons const & country, bool needTest) {
+        testsCount += needTest ? 1 : 0;
+        if (!needTest || country.Contains(point))
+          countries.emplace(country.GetName());
+      });
+
+      std::set<std::string> expected;
+      for (auto const & country : {std::cref(one), std::cref(two)})
+      {
+        if (country.get().Contains(point))
+          expected.emplace(country.get().GetName());
+      }
+      TEST_EQUAL(countries, expected, (point));
+    }
+  }
+  // Exact tests are needed only near the borders.
+  TEST_LESS(testsCount, (kSteps + 1) * (kSteps + 1), ());
+
+  feature::CountriesFilesIndexAffiliation::Cell const oneCell(one);
+  TEST_EQUAL(oneCell.GetCountry(), &one, ());
+}
 }  // namespace
@@ -73,3 +73,24 @@ UNIT_TEST(BookingDataset_ParseTest2)
   generator::BookingDataset data(file.GetFullPath());
   TEST_EQUAL(data.GetStorage().Size(), 10, ());
 }
+
+UNIT_TEST(BookingDataset_NameWords)
+{
+  generator::BookingHotel const hotel(
+      "1485988\t36.75818960879561\t3.053177244180233\tAppartement Alger Centre\t50 Avenue Ahmed "
+      "Ghermoul\t0\t0\tNone\tNone\thttp://www.booking.com/hotel/dz/"
+      "appartement-alger-centre-alger.html\t201\t");
+
+  using generator::impl::GetNameSimilarityScore;
+  using generator::impl::MakeWeightedBagOfWords;
+  TEST_EQUAL(hotel.m_nameWords.size(), 3, ());
+  for (std::string const osmName : {"Alger Centre", "appartement ALGER centre", "Hotel", ""})
+  {
+    auto const osmNameWords = MakeWeightedBagOfWords(osmName);
+    TEST_ALMOST_EQUAL_ABS(GetNameSimilarityScore(hotel.m_nameWords, osmNameWords),
+                          GetNameSimilarityScore(hotel.m_name, osmName), 1e-9, (osmName));
+  }
+  TEST_ALMOST_EQUAL_ABS(GetNameSimilarityScore(hotel.m_nameWords,
+                                               MakeWeightedBagOfWords("Centre Alger Appartement")),
+                        1.0, 1e-9, ());
+}
@@ -0,0 +1,52 @@
+#include "testing/testing.hpp"
+
+#include "generator/countries_shards.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace generator;
+
+namespace
+{
+std::vector<std::pair<std::string, uint64_t>> const kCountries = {
+    {"Belarus", 30}, {"Russia", 100}, {"Andorra", 1}, {"Germany", 70}, {"Monaco", 1}, {"Spain", 40}};
+
+UNIT_TEST(GetShardCountries_Balance)
+{
+  // Russia goes to shard 0, Germany and Spain go to shard 1. Then Belarus goes to shard 0 as
+  // the least loaded one and the small countries go to shard 1.
+  TEST_EQUAL(GetShardCountries(kCountries, 2 /* shardsCount */, 0 /* shardIndex */),
+             std::vector<std::string>({"Belarus", "Russia"}), ());
+  TEST_EQUAL(GetShardCountries(kCountries, 2 /* shardsCount */, 1 /* shardIndex */),
+             std::vector<std::string>({"Andorra", "Germany", "Monaco", "Spain"}), ());
+}
+
+UNIT_TEST(GetShardCountries_Order)
+{
+  // The split doesn't depend on the order of the countries.
+  auto reversed = kCountries;
+  std::reverse(reversed.begin(), reversed.end());
+  for (size_t shard = 0; shard < 3; ++shard)
+  {
+    auto expected = GetShardCountries(kCountries, 3 /* shardsCount */, shard);
+    auto actual = GetShardCountries(reversed, 3 /* shardsCount */, shard);
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    TEST_EQUAL(expected, actual, (shard));
+  }
+}
+
+UNIT_TEST(GetShardCountries_AllCountries)
+{
+  size_t total = 0;
+  for (size_t shard = 0; shard < 4; ++shard)
+    total += GetShardCountries(kCountries, 4 /* shardsCount */, shard).size();
+  TEST_EQUAL(total, kCountries.size(), ());
+  TEST_EQUAL(GetShardCountries(kCountries, 1 /* shardsCount */, 0 /* shardIndex */).size(),
+             kCountries.size(), ());
+}
+}  // namespace
@@ -0,0 +1,93 @@
+#include "testing/testing.hpp"
+
+#include "generator/cross_mwm_weights_cache.hpp"
+
+#include "routing/edge_estimator.hpp"
+
+#include "routing_common/car_model.hpp"
+
+#include "indexer/classificator_loader.hpp"
+
+#include "platform/platform_tests_support/scoped_dir.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/scope_guard.hpp"
+
+#include <vector>
+
+using namespace generator;
+using namespace routing;
+using namespace platform::tests_support;
+
+namespace
+{
+UNIT_TEST(CrossMwmWeightsCache_SaveLoad)
+{
+  ScopedDir const dir("cross_mwm_weights_cache_test");
+  CrossMwmWeightsCache const cache(dir.GetFullPath());
+
+  CrossMwmWeightsCache::Key key = {};
+  key[0] = 1;
+  std::vector<CrossMwmWeightsCache::Weight> const weights = {0, 10, 20, 0, 5, 7};
+
+  std::vector<CrossMwmWeightsCache::Weight> loaded;
+  TEST(!cache.Load("Country", key, weights.size(), loaded), ());
+
+  cache.Save("Country", key, weights);
+  SCOPE_GUARD(removeFile, [&]() {
+    Platform::RemoveFileIfExists(base::JoinPath(dir.GetFullPath(), "Country.cross_mwm_weights"));
+  });
+
+  TEST(cache.Load("Country", key, weights.size(), loaded), ());
+  TEST_EQUAL(loaded, weights, ());
+
+  // The roads or the transitions are changed.
+  auto otherKey = key;
+  otherKey[0] = 2;
+  TEST(!cache.Load("Country", otherKey, weights.size(), loaded), ());
+  TEST(!cache.Load("Country", key, weights.size() + 1, loaded), ());
+  TEST(!cache.Load("OtherCountry", key, weights.size(), loaded), ());
+}
+
+UNIT_TEST(CrossMwmWeightsCache_WeightsParams)
+{
+  classificator::Load();
+
+  auto const getParams = [](VehicleModel const & model, VehicleType vehicleType) {
+    auto const estimator = EdgeEstimator::Create(vehicleType, model, nullptr /* trafficStash */,
+                                                 nullptr /* dataSource */, nullptr /* numMwmIds */);
+    return CrossMwmWeightsCache::GetWeightsParams(model, *estimator);
+  };
+
+  HighwayBasedFactors const factors = {
+      {HighwayType::HighwayMotorway, InOutCityFactor(1.0)},
+      {HighwayType::HighwayPrimary, InOutCityFactor(1.0)}};
+  auto const makeSpeeds = [](double motorwaySpeed) {
+    return HighwayBasedSpeeds{
+        {HighwayType::HighwayMotorway, InOutCitySpeedKMpH(SpeedKMpH(motorwaySpeed))},
+        {HighwayType::HighwayPrimary, InOutCitySpeedKMpH(SpeedKMpH(60.0))}};
+  };
+  HighwayBasedSpeeds const speeds = makeSpeeds(100.0);
+  HighwayBasedSpeeds const sameSpeeds = makeSpeeds(100.0);
+  HighwayBasedSpeeds const otherSpeeds = makeSpeeds(110.0);
+  auto const makeCarModel = [&factors](HighwayBasedSpeeds const & speeds) {
+    return CarModel({{{"highway", "motorway"}, true}, {{"highway", "primary"}, true}},
+                    HighwayBasedInfo(speeds, factors));
+  };
+
+  auto const car = makeCarModel(speeds);
+  auto const params = getParams(car, VehicleType::Car);
+  TEST_EQUAL(params, getParams(makeCarModel(sameSpeeds), VehicleType::Car), ());
+
+  // The speeds of the model are changed.
+  TEST_NOT_EQUAL(params, getParams(makeCarModel(otherSpeeds), VehicleType::Car), ());
+  // The penalties of the estimator are changed.
+  TEST_NOT_EQUAL(params, getParams(car, VehicleType::Bicycle), ());
+
+  auto const defaultCar = getParams(CarModel::AllLimitsInstance(), VehicleType::Car);
+  TEST_EQUAL(defaultCar, getParams(CarModel::AllLimitsInstance(), VehicleType::Car), ());
+  TEST_NOT_EQUAL(params, defaultCar, ());
+}
+}  // namespace
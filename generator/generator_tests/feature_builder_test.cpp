@@ -3,6 +3,7 @@
 #include "types_helper.hpp"
 
 #include "generator/feature_builder.hpp"
+#include "generator/feature_helpers.hpp"
 #include "generator/generator_tests_support/test_with_classificator.hpp"
 #include "generator/geometry_holder.hpp"
 #include "generator/osm2type.hpp"
@@ -11,13 +12,20 @@
 #include "indexer/classificator_loader.hpp"
 #include "indexer/feature_visibility.hpp"
 
+#include "platform/platform_tests_support/scoped_file.hpp"
+
 #include "base/geo_object_id.hpp"
 
+#include <algorithm>
 #include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 using namespace feature;
 
 using namespace generator::tests_support;
+using namespace platform::tests_support;
 using namespace tests;
 
 UNIT_CLASS_TEST(TestWithClassificator, FBuilder_ManyTypes)
@@ -343,3 +351,88 @@ UNIT_CLASS_TEST(TestWithClassificator, FBuilder_RemoveUselessAltName)
     TEST(fb.IsValid(), (fb));
   }
 }
+
+UNIT_CLASS_TEST(TestWithClassificator, FBuilder_ParallelRawFormat)
+{
+  ScopedFile file("fbuilder_parallel_raw_format.tmp", ScopedFile::Mode::DoNotCreate);
+  size_t constexpr kFeaturesCount = 1000;
+  {
+    FeatureBuilderWriter<serialization_policy::MaxAccuracy> writer(file.GetFullPath());
+    for (size_t i = 0; i < kFeaturesCount; ++i)
+    {
+      FeatureBuilderParams params;
+      char const * arr[][1] = {{"shop"}};
+      AddTypes(params, arr);
+      params.FinishAddingTypes();
+
+      FeatureBuilder fb;
+      fb.SetParams(params);
+      fb.SetCenter(m2::PointD(i, i));
+      fb.SetOsmId(base::MakeOsmNode(i));
+      writer.Write(fb);
+    }
+  }
+
+  std::vector<uint64_t> positions;
+  ForEachFeatureRawFormat<serialization_policy::MaxAccuracy>(
+      file.GetFullPath(), [&](auto const &, uint64_t pos) { positions.push_back(pos); });
+  TEST_EQUAL(positions.size(), kFeaturesCount, ());
+
+  {
+    // Every batch starts with a record.
+    MmapReader reader(file.GetFullPath());
+    auto const batches = SplitRawFormatIntoBatches(reader.Data(), reader.Size(), 100);
+    TEST_GREATER(batches.size(), 2, ());
+    TEST_EQUAL(batches.front(), 0, ());
+    TEST_EQUAL(batches.back(), reader.Size(), ());
+    for (size_t i = 0; i + 1 < batches.size(); ++i)
+    {
+      TEST_LESS(batches[i], batches[i + 1], ());
+      TEST(std::binary_search(positions.begin(), positions.end(), batches[i]), (batches[i]));
+    }
+  }
+
+  auto const fbs = ReadAllDatRawFormat<serialization_policy::MaxAccuracy>(file.GetFullPath(),
+                                                                          4 /* threadsCount */);
+  TEST_EQUAL(fbs.size(), kFeaturesCount, ());
+  for (size_t i = 0; i < fbs.size(); ++i)
+    TEST_EQUAL(fbs[i].GetMostGenericOsmId(), base::MakeOsmNode(i), ());
+
+  std::mutex mutex;
+  std::vector<std::pair<uint64_t, base::GeoObjectId>> parallel;
+  ForEachParallelFeatureRawFormat<serialization_policy::MaxAccuracy>(
+      4 /* threadsCount */, file.GetFullPath(), [&](auto const & fb, uint64_t pos) {
+        std::lock_guard<std::mutex> lock(mutex);
+        parallel.emplace_back(pos, fb.GetMostGenericOsmId());
+      });
+  std::sort(parallel.begin(), parallel.end());
+  TEST_EQUAL(parallel.size(), kFeaturesCount, ());
+  for (size_t i = 0; i < parallel.size(); ++i)
+  {
+    TEST_EQUAL(parallel[i].first, positions[i], ());
+    TEST_EQUAL(parallel[i].second, base::MakeOsmNode(i), ());
+  }
+}
+
+UNIT_TEST(CalculateMidPoints_HilbertOrder)
+{
+  CalculateMidPoints midPoints([](TypesHolder const &, m2::RectD) { return 0; });
+  midPoints.SetOrder(CalculateMidPoints::Order::Hilbert);
+
+  // The Hilbert curve goes through the quadrants in the order: bottom left, top left, top right,
+  // bottom right. Positions of the features are their expected places.
+  std::vector<std::pair<m2::PointD, uint64_t>> const points = {
+      {{90.0, 90.0}, 2}, {{90.0, -90.0}, 3}, {{-90.0, -90.0}, 0}, {{-90.0, 90.0}, 1}};
+  for (auto const & point : points)
+  {
+    FeatureBuilder fb;
+    fb.SetCenter(point.first);
+    midPoints(fb, point.second);
+  }
+  midPoints.Sort();
+
+  auto const & sorted = midPoints.GetVector();
+  TEST_EQUAL(sorted.size(), points.size(), ());
+  for (size_t i = 0; i < sorted.size(); ++i)
+    TEST_EQUAL(sorted[i].second, i, ());
+}
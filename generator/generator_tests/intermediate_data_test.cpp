@@ -12,11 +12,20 @@
 #include "generator/intermediate_data.hpp"
 #include "generator/intermediate_elements.hpp"
 
+#include "platform/platform.hpp"
+
+#include "geometry/latlon.hpp"
+
+#include "coding/internal/file_data.hpp"
 #include "coding/reader.hpp"
 #include "coding/writer.hpp"
 
+#include "base/file_name_utils.hpp"
+#include "base/scope_guard.hpp"
+
 #include "defines.hpp"
 
+#include <cmath>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -115,3 +124,47 @@ UNIT_TEST(Intermediate_Data_relation_element_save_load_test)
   TEST_NOT_EQUAL(e2.m_tags["key1old"], "value1old", ());
   TEST_NOT_EQUAL(e2.m_tags["key2old"], "value2old", ());
 }
+
+UNIT_TEST(Intermediate_Data_packed_point_storage_test)
+{
+  string const name = base::JoinPath(GetPlatform().TmpDir(), "packed_" NODES_FILE);
+  SCOPE_GUARD(removeData, [&name]() {
+    base::DeleteFileX(name);
+    base::DeleteFileX(name + ".idx");
+  });
+
+  // Points of sparse ids: several dense blocks, a gap of empty blocks, a single point block and
+  // a block with far away points.
+  vector<pair<uint64_t, ms::LatLon>> points;
+  for (uint64_t id = 1; id < 1000; id += 3)
+    points.emplace_back(id, ms::LatLon(55.75 + id * 1e-5, 37.6 - id * 1e-5));
+  points.emplace_back(100000, ms::LatLon(-33.8688197, 151.2092955));
+  points.emplace_back(1ULL << 32, ms::LatLon(89.9999999, -179.9999999));
+  points.emplace_back((1ULL << 32) + 1, ms::LatLon(-89.9999999, 179.9999999));
+  points.emplace_back((1ULL << 32) + 255, ms::LatLon(0.0000001, 0.0));
+
+  {
+    auto writer = cache::CreatePointStorageWriter(feature::GenerateInfo::NodeStorageType::Packed,
+                                                  name);
+    for (auto const & p : points)
+      writer->AddPoint(p.first, p.second.m_lat, p.second.m_lon);
+  }
+
+  auto reader =
+      cache::CreatePointStorageReader(feature::GenerateInfo::NodeStorageType::Packed, name);
+  for (auto const & p : points)
+  {
+    double lat = 0.0;
+    double lon = 0.0;
+    TEST(reader->GetPoint(p.first, lat, lon), (p.first));
+    TEST_LESS(fabs(lat - p.second.m_lat), 1e-7, (p.first));
+    TEST_LESS(fabs(lon - p.second.m_lon), 1e-7, (p.first));
+  }
+
+  double lat = 0.0;
+  double lon = 0.0;
+  TEST(!reader->GetPoint(0, lat, lon), ());
+  TEST(!reader->GetPoint(2, lat, lon), ());
+  TEST(!reader->GetPoint(50000, lat, lon), ());
+  TEST(!reader->GetPoint(1ULL << 40, lat, lon), ());
+}
@@ -0,0 +1,91 @@
+#include "testing/testing.hpp"
+
+#include "generator/final_processor_utils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace generator;
+
+namespace
+{
+class MemoryTracker
+{
+public:
+  void Start(uint64_t memoryBytes)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_inUse += memoryBytes;
+    ++m_inProgress;
+    m_maxInUse = std::max(m_maxInUse, m_inUse);
+    m_maxInProgress = std::max(m_maxInProgress, m_inProgress);
+  }
+
+  void Finish(uint64_t memoryBytes, size_t jobId)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_inUse -= memoryBytes;
+    --m_inProgress;
+    m_finished.push_back(jobId);
+  }
+
+  uint64_t m_inUse = 0;
+  uint64_t m_maxInUse = 0;
+  size_t m_inProgress = 0;
+  size_t m_maxInProgress = 0;
+  std::vector<size_t> m_finished;
+  std::mutex m_mutex;
+};
+
+std::vector<MemoryBudgetScheduler::Job> MakeJobs(std::vector<uint64_t> const & memory,
+                                                 MemoryTracker & tracker)
+{
+  std::vector<MemoryBudgetScheduler::Job> jobs;
+  for (size_t i = 0; i < memory.size(); ++i)
+  {
+    jobs.emplace_back(memory[i], [&tracker, i, memoryBytes = memory[i]]() {
+      tracker.Start(memoryBytes);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      tracker.Finish(memoryBytes, i);
+    });
+  }
+  return jobs;
+}
+}  // namespace
+
+UNIT_TEST(MemoryBudgetScheduler_Budget)
+{
+  MemoryTracker tracker;
+  MemoryBudgetScheduler(4 /* threadsCount */, 100 /* memoryBudgetBytes */)
+      .Run(MakeJobs({10, 60, 30, 50, 20, 40, 10}, tracker));
+
+  TEST_EQUAL(tracker.m_finished.size(), 7, ());
+  TEST_LESS_OR_EQUAL(tracker.m_maxInUse, 100, ());
+  TEST_LESS_OR_EQUAL(tracker.m_maxInProgress, 4, ());
+}
+
+UNIT_TEST(MemoryBudgetScheduler_BigJobRunsAlone)
+{
+  MemoryTracker tracker;
+  MemoryBudgetScheduler(4 /* threadsCount */, 100 /* memoryBudgetBytes */)
+      .Run(MakeJobs({10, 500, 20}, tracker));
+
+  TEST_EQUAL(tracker.m_finished.size(), 3, ());
+  // The biggest job is started first and nothing else fits while it is in progress.
+  TEST_EQUAL(tracker.m_finished.front(), 1, ());
+  TEST_EQUAL(tracker.m_maxInProgress, 2, ());
+}
+
+UNIT_TEST(MemoryBudgetScheduler_Unlimited)
+{
+  MemoryTracker tracker;
+  MemoryBudgetScheduler(2 /* threadsCount */, 0 /* memoryBudgetBytes */)
+      .Run(MakeJobs({500, 500, 500}, tracker));
+
+  TEST_EQUAL(tracker.m_finished.size(), 3, ());
+  TEST_EQUAL(tracker.m_maxInProgress, 2, ());
+}
@@ -0,0 +1,202 @@
+#include "testing/testing.hpp"
+
+#include "generator/affiliation.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/intermediate_elements.hpp"
+#include "generator/osm_change.hpp"
+#include "generator/osm_source.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace generator;
+using namespace std;
+
+namespace
+{
+// Countries are quadrants of the world.
+class QuadrantsAffiliation : public feature::AffiliationInterface
+{
+public:
+  // AffiliationInterface overrides:
+  vector<string> GetAffiliations(feature::FeatureBuilder const &) const override { return {}; }
+
+  vector<string> GetAffiliations(m2::PointD const & point) const override
+  {
+    return {string(point.y >= 0 ? "North" : "South") + (point.x >= 0 ? "East" : "West")};
+  }
+
+  bool HasCountryByName(string const &) const override { return true; }
+};
+
+class IntermediateDataReaderTest : public cache::IntermediateDataReaderInterface
+{
+public:
+  void AddNode(cache::Key id, double lat, double lon)
+  {
+    m_nodes[id] = mercator::FromLatLon(lat, lon);
+  }
+
+  void AddWay(cache::Key id, vector<uint64_t> const & nodes) { m_ways[id] = nodes; }
+
+  void AddRelation(cache::Key id, RelationElement const & relation)
+  {
+    m_relations[id] = relation;
+  }
+
+  // IntermediateDataReaderInterface overrides:
+  bool GetNode(cache::Key id, double & y, double & x) const override
+  {
+    auto const it = m_nodes.find(id);
+    if (it == m_nodes.cend())
+      return false;
+
+    y = it->second.y;
+    x = it->second.x;
+    return true;
+  }
+
+  bool GetWay(cache::Key id, WayElement & e) override
+  {
+    auto const it = m_ways.find(id);
+    if (it == m_ways.cend())
+      return false;
+
+    e = WayElement(id, it->second);
+    return true;
+  }
+
+  bool GetRelation(cache::Key id, RelationElement & e) override
+  {
+    auto const it = m_relations.find(id);
+    if (it == m_relations.cend())
+      return false;
+
+    e = it->second;
+    return true;
+  }
+
+private:
+  unordered_map<cache::Key, m2::PointD> m_nodes;
+  unordered_map<cache::Key, vector<uint64_t>> m_ways;
+  unordered_map<cache::Key, RelationElement> m_relations;
+};
+
+OsmChange ParseOsmChange(string const & xml)
+{
+  istringstream stream(xml);
+  SourceReader reader(stream);
+  return generator::ReadOsmChange(reader);
+}
+}  // namespace
+
+UNIT_TEST(OsmChange_Read)
+{
+  auto const change = ParseOsmChange(R"(<?xml version="1.0" encoding="UTF-8"?>
+<osmChange version="0.6" generator="test">
+  <create>
+    <node id="10" version="1" lat="10.0" lon="20.0">
+      <tag k="amenity" v="cafe"/>
+    </node>
+  </create>
+  <modify>
+    <way id="20" version="2">
+      <nd ref="1"/>
+      <nd ref="2"/>
+      <tag k="highway" v="primary"/>
+    </way>
+    <relation id="30" version="3">
+      <member type="way" ref="20" role="outer"/>
+      <tag k="type" v="multipolygon"/>
+    </relation>
+  </modify>
+  <delete>
+    <node id="40" version="4"/>
+  </delete>
+</osmChange>
+)");
+
+  TEST_EQUAL(change.m_entries.size(), 4, ());
+
+  auto const & node = change.m_entries[0];
+  TEST_EQUAL(node.m_action, OsmChange::Action::Create, ());
+  TEST(node.m_element.IsNode(), ());
+  TEST_EQUAL(node.m_element.m_id, 10, ());
+  TEST_ALMOST_EQUAL_ABS(node.m_element.m_lat, 10.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(node.m_element.m_lon, 20.0, 1e-9, ());
+  TEST_EQUAL(node.m_element.GetTag("amenity"), "cafe", ());
+
+  auto const & way = change.m_entries[1];
+  TEST_EQUAL(way.m_action, OsmChange::Action::Modify, ());
+  TEST(way.m_element.IsWay(), ());
+  TEST_EQUAL(way.m_element.m_id, 20, ());
+  TEST_EQUAL(way.m_element.Nodes(), vector<uint64_t>({1, 2}), ());
+
+  auto const & relation = change.m_entries[2];
+  TEST_EQUAL(relation.m_action, OsmChange::Action::Modify, ());
+  TEST(relation.m_element.IsRelation(), ());
+  TEST_EQUAL(relation.m_element.Members().size(), 1, ());
+  TEST_EQUAL(relation.m_element.Members()[0].m_ref, 20, ());
+  TEST_EQUAL(relation.m_element.GetTag("type"), "multipolygon", ());
+
+  auto const & deleted = change.m_entries[3];
+  TEST_EQUAL(deleted.m_action, OsmChange::Action::Delete, ());
+  TEST(deleted.m_element.IsNode(), ());
+  TEST_EQUAL(deleted.m_element.m_id, 40, ());
+}
+
+UNIT_TEST(OsmChange_AffectedCountries)
+{
+  IntermediateDataReaderTest cache;
+  QuadrantsAffiliation const affiliation;
+
+  // Node 1 is moved from NorthEast to SouthEast.
+  cache.AddNode(1, 10.0, 10.0);
+  // Way 2 of NorthWest nodes gets a new node in NorthEast.
+  cache.AddNode(2, 10.0, -10.0);
+  cache.AddNode(3, 20.0, -10.0);
+  cache.AddWay(2, {2, 3});
+  // Relation 3 with a SouthWest way has its tags changed.
+  cache.AddNode(4, -10.0, -10.0);
+  cache.AddNode(5, -20.0, -10.0);
+  cache.AddWay(4, {4, 5});
+  RelationElement relation;
+  relation.m_ways = {{4, "outer"}};
+  cache.AddRelation(3, relation);
+
+  auto const change = ParseOsmChange(R"(<osmChange version="0.6">
+  <modify>
+    <node id="1" lat="-10.0" lon="10.0"/>
+    <way id="2">
+      <nd ref="2"/>
+      <nd ref="3"/>
+      <nd ref="6"/>
+    </way>
+    <relation id="3">
+      <member type="way" ref="4" role="outer"/>
+      <tag k="type" v="multipolygon"/>
+    </relation>
+  </modify>
+  <create>
+    <node id="6" lat="30.0" lon="10.0"/>
+  </create>
+</osmChange>
+)");
+
+  TEST_EQUAL(GetAffectedCountries(change, cache, affiliation),
+             vector<string>({"NorthEast", "NorthWest", "SouthEast", "SouthWest"}), ());
+
+  auto const deletion = ParseOsmChange(R"(<osmChange version="0.6">
+  <delete>
+    <way id="2"/>
+  </delete>
+</osmChange>
+)");
+
+  TEST_EQUAL(GetAffectedCountries(deletion, cache, affiliation), vector<string>({"NorthWest"}),
+             ());
+}
@@ -0,0 +1,254 @@
+#include "testing/testing.hpp"
+
+#include "generator/osm_element.hpp"
+#include "generator/osm_pbf_source.hpp"
+#include "generator/osm_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/bits.hpp"
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+// Protobuf encoding helpers.
+void WriteVarint(string & s, uint64_t v)
+{
+  while (v >= 0x80)
+  {
+    s.push_back(static_cast<char>((v & 0x7F) | 0x80));
+    v >>= 7;
+  }
+  s.push_back(static_cast<char>(v));
+}
+
+void WriteUint(string & s, uint32_t field, uint64_t v)
+{
+  WriteVarint(s, field << 3);
+  WriteVarint(s, v);
+}
+
+void WriteSint(string & s, uint32_t field, int64_t v)
+{
+  WriteUint(s, field, bits::ZigZagEncode(v));
+}
+
+void WriteBytes(string & s, uint32_t field, string const & bytes)
+{
+  WriteVarint(s, (field << 3) | 2);
+  WriteVarint(s, bytes.size());
+  s += bytes;
+}
+
+string Packed(vector<uint64_t> const & values)
+{
+  string s;
+  for (auto const v : values)
+    WriteVarint(s, v);
+  return s;
+}
+
+string PackedSint(vector<int64_t> const & values)
+{
+  string s;
+  for (auto const v : values)
+    WriteVarint(s, bits::ZigZagEncode(v));
+  return s;
+}
+
+string MakePbfBlock(string const & type, string const & data, bool compress)
+{
+  string blob;
+  if (compress)
+  {
+    string zlibData;
+    coding::ZLib::Deflate deflate(coding::ZLib::Deflate::Format::ZLib,
+                                  coding::ZLib::Deflate::Level::BestCompression);
+    TEST(deflate(data, back_inserter(zlibData)), ());
+    WriteUint(blob, 2 /* raw_size */, data.size());
+    WriteBytes(blob, 3 /* zlib_data */, zlibData);
+  }
+  else
+  {
+    WriteBytes(blob, 1 /* raw */, data);
+  }
+
+  string header;
+  WriteBytes(header, 1 /* type */, type);
+  WriteUint(header, 3 /* datasize */, blob.size());
+
+  string block;
+  for (int shift = 24; shift >= 0; shift -= 8)
+    block.push_back(static_cast<char>((header.size() >> shift) & 0xFF));
+  return block + header + blob;
+}
+
+string MakeStringTable(vector<string> const & strings)
+{
+  string table;
+  for (auto const & s : strings)
+    WriteBytes(table, 1, s);
+  return table;
+}
+
+// Header, then dense nodes 1, 2, 3, way 10 and relation 20 in a raw block, then node 4 in
+// a compressed block with custom coordinates parameters.
+string MakePbf()
+{
+  string header;
+  WriteBytes(header, 4 /* required_features */, "OsmSchema-V0.6");
+  WriteBytes(header, 4 /* required_features */, "DenseNodes");
+
+  string dense;
+  WriteBytes(dense, 1 /* id */, PackedSint({1, 1, 1}));
+  WriteBytes(dense, 8 /* lat */, PackedSint({557500000, 10, -20}));
+  WriteBytes(dense, 9 /* lon */, PackedSint({376000000, -10, 20}));
+  WriteBytes(dense, 10 /* keys_vals */, Packed({3, 4, 0, 0, 1, 2, 0}));
+
+  string way;
+  WriteUint(way, 1 /* id */, 10);
+  WriteBytes(way, 2 /* keys */, Packed({1}));
+  WriteBytes(way, 3 /* vals */, Packed({2}));
+  WriteBytes(way, 8 /* refs */, PackedSint({1, 1, 1}));
+
+  string relation;
+  WriteUint(relation, 1 /* id */, 20);
+  WriteBytes(relation, 2 /* keys */, Packed({6}));
+  WriteBytes(relation, 3 /* vals */, Packed({7}));
+  WriteBytes(relation, 8 /* roles_sid */, Packed({5, 0}));
+  WriteBytes(relation, 9 /* memids */, PackedSint({10, -9}));
+  WriteBytes(relation, 10 /* types */, Packed({1, 0}));
+
+  string nodesGroup;
+  WriteBytes(nodesGroup, 2 /* dense */, dense);
+  string waysGroup;
+  WriteBytes(waysGroup, 3 /* ways */, way);
+  WriteBytes(waysGroup, 4 /* relations */, relation);
+
+  vector<string> const strings = {"",    "highway", "residential", "name",
+                                  "Main", "outer",   "type",        "multipolygon"};
+  string data;
+  WriteBytes(data, 1 /* stringtable */, MakeStringTable(strings));
+  WriteBytes(data, 2 /* primitivegroup */, nodesGroup);
+  WriteBytes(data, 2 /* primitivegroup */, waysGroup);
+
+  string node;
+  WriteSint(node, 1 /* id */, 4);
+  WriteBytes(node, 2 /* keys */, Packed({1}));
+  WriteBytes(node, 3 /* vals */, Packed({2}));
+  WriteSint(node, 8 /* lat */, -33868820);
+  WriteSint(node, 9 /* lon */, 151209296);
+
+  string group;
+  WriteBytes(group, 1 /* nodes */, node);
+  string compressedData;
+  WriteBytes(compressedData, 2 /* primitivegroup */, group);
+  WriteUint(compressedData, 17 /* granularity */, 1000);
+  WriteUint(compressedData, 19 /* lat_offset */, 500);
+  WriteUint(compressedData, 20 /* lon_offset */, 700);
+  WriteBytes(compressedData, 1 /* stringtable */, MakeStringTable(strings));
+
+  return MakePbfBlock("OSMHeader", header, false /* compress */) +
+         MakePbfBlock("OSMData", data, false /* compress */) +
+         MakePbfBlock("OSMData", compressedData, true /* compress */);
+}
+
+void TestElements(vector<OsmElement> const & elements)
+{
+  TEST_EQUAL(elements.size(), 6, ());
+
+  TEST(elements[0].IsNode(), ());
+  TEST_EQUAL(elements[0].m_id, 1, ());
+  TEST(base::AlmostEqualAbs(elements[0].m_lat, 55.75, 1e-9), ());
+  TEST(base::AlmostEqualAbs(elements[0].m_lon, 37.6, 1e-9), ());
+  TEST_EQUAL(elements[0].GetTag("name"), "Main", ());
+  TEST_EQUAL(elements[1].m_id, 2, ());
+  TEST(base::AlmostEqualAbs(elements[1].m_lat, 55.750001, 1e-9), ());
+  TEST(elements[1].Tags().empty(), ());
+  TEST_EQUAL(elements[2].m_id, 3, ());
+  TEST(base::AlmostEqualAbs(elements[2].m_lon, 37.600001, 1e-9), ());
+  TEST_EQUAL(elements[2].GetTag("highway"), "residential", ());
+
+  TEST(elements[3].IsWay(), ());
+  TEST_EQUAL(elements[3].m_id, 10, ());
+  TEST_EQUAL(elements[3].Nodes(), vector<uint64_t>({1, 2, 3}), ());
+  TEST_EQUAL(elements[3].GetTag("highway"), "residential", ());
+
+  TEST(elements[4].IsRelation(), ());
+  TEST_EQUAL(elements[4].m_id, 20, ());
+  TEST_EQUAL(elements[4].GetTag("type"), "multipolygon", ());
+  vector<OsmElement::Member> const members = {{10, OsmElement::EntityType::Way, "outer"},
+                                              {1, OsmElement::EntityType::Node, ""}};
+  TEST(elements[4].Members() == members, ());
+
+  TEST(elements[5].IsNode(), ());
+  TEST_EQUAL(elements[5].m_id, 4, ());
+  TEST(base::AlmostEqualAbs(elements[5].m_lat, 1e-9 * (500 - 1000 * 33868820LL), 1e-9), ());
+  TEST(base::AlmostEqualAbs(elements[5].m_lon, 1e-9 * (700 + 1000 * 151209296LL), 1e-9), ());
+  TEST_EQUAL(elements[5].GetTag("highway"), "residential", ());
+}
+}  // namespace
+
+UNIT_TEST(OSM_PBF_Source_Decode_test)
+{
+  stringstream ss(MakePbf());
+  osm::PbfBlockReader reader([&ss](uint8_t * buffer, size_t size) {
+    return ss.read(reinterpret_cast<char *>(buffer), size).gcount();
+  });
+
+  vector<OsmElement> elements;
+  osm::PbfBlockReader::Block block;
+  TEST(reader.Read(block), ());
+  TEST_EQUAL(block.m_type, "OSMHeader", ());
+  osm::CheckPbfHeader(block.m_blob);
+
+  while (reader.Read(block))
+  {
+    TEST_EQUAL(block.m_type, "OSMData", ());
+    osm::DecodePbfData(block.m_blob, elements);
+  }
+
+  TestElements(elements);
+}
+
+UNIT_TEST(OSM_PBF_Source_Truncated_test)
+{
+  auto const pbf = MakePbf();
+  stringstream ss(pbf.substr(0, pbf.size() - 1));
+  osm::PbfBlockReader reader([&ss](uint8_t * buffer, size_t size) {
+    return ss.read(reinterpret_cast<char *>(buffer), size).gcount();
+  });
+
+  osm::PbfBlockReader::Block block;
+  TEST(reader.Read(block), ());
+  TEST(reader.Read(block), ());
+  TEST_ANY_THROW(reader.Read(block), ());
+}
+
+UNIT_TEST(OSM_PBF_Source_Processor_test)
+{
+  // Many blocks to test the order of elements decoded in parallel.
+  size_t constexpr kCopies = 20;
+  auto const pbf = MakePbf();
+  string data;
+  for (size_t i = 0; i < kCopies; ++i)
+    data += pbf;
+
+  istringstream ss(data);
+  generator::SourceReader reader(ss);
+  vector<OsmElement> elements;
+  generator::ProcessOsmElementsFromPbf(reader, 4 /* threadsCount */,
+                                       [&elements](OsmElement * e) { elements.push_back(*e); });
+
+  TEST_EQUAL(elements.size(), 6 * kCopies, ());
+  for (size_t i = 0; i < kCopies; ++i)
+    TestElements(vector<OsmElement>(elements.begin() + 6 * i, elements.begin() + 6 * (i + 1)));
+}
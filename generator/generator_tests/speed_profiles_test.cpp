@@ -0,0 +1,112 @@
+#include "testing/testing.hpp"
+
+#include "generator/routing_helpers.hpp"
+#include "generator/speed_profiles_builder.hpp"
+
+#include "routing/speed_profiles.hpp"
+
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include "base/geo_object_id.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace platform::tests_support;
+using namespace routing;
+using namespace std;
+
+namespace
+{
+string const kCsv = "speed_profiles_test.csv";
+
+// Returns a csv line of a way direction with |speed| km/h and |slowSpeed| km/h at |slowHour|.
+string MakeLine(uint64_t osmId, bool forward, uint32_t speed, size_t slowHour, uint32_t slowSpeed)
+{
+  ostringstream ss;
+  ss << osmId << ", " << (forward ? 1 : 0);
+  for (size_t i = 0; i < SpeedProfiles::kHoursInWeek; ++i)
+    ss << ", " << (i == slowHour ? slowSpeed : speed);
+  ss << '\n';
+  return ss.str();
+}
+
+bool Parse(string const & content, OsmIdToSpeedProfile & osmIdToProfile)
+{
+  ScopedFile const file(kCsv, content);
+  return ParseSpeedProfiles(file.GetFullPath(), osmIdToProfile);
+}
+}  // namespace
+
+UNIT_TEST(SpeedProfiles_Parse)
+{
+  OsmIdToSpeedProfile osmIdToProfile;
+  TEST(Parse(MakeLine(10 /* osmId */, true /* forward */, 60 /* speed */, 8 /* slowHour */,
+                      30 /* slowSpeed */) +
+                 MakeLine(10 /* osmId */, false /* forward */, 60 /* speed */, 8 /* slowHour */,
+                          59 /* slowSpeed */) +
+                 MakeLine(20 /* osmId */, true /* forward */, 40 /* speed */, 17 /* slowHour */,
+                          0 /* slowSpeed */),
+             osmIdToProfile),
+       ());
+
+  // The backward direction of way 10 is not slowed down after rounding.
+  TEST_EQUAL(osmIdToProfile.size(), 2, ());
+
+  auto const & profile10 = osmIdToProfile.at({base::MakeOsmWay(10), true});
+  TEST_EQUAL(profile10[7], 100, ());
+  TEST_EQUAL(profile10[8], 50, ());
+
+  // Percents are not less than 5 to keep weights finite.
+  auto const & profile20 = osmIdToProfile.at({base::MakeOsmWay(20), true});
+  TEST_EQUAL(profile20[17], 5, ());
+  TEST_EQUAL(profile20[18], 100, ());
+
+  // Wrong direction, missing speed and duplicate lines.
+  TEST(!Parse("10, 2" + MakeLine(10, true, 60, 8, 30).substr(5), osmIdToProfile), ());
+  auto line = MakeLine(10, true, 60, 8, 30);
+  TEST(!Parse(line.substr(0, line.rfind(',')) + '\n', osmIdToProfile), ());
+  TEST(!Parse(line + line, osmIdToProfile), ());
+}
+
+UNIT_TEST(SpeedProfiles_MakeSpeedProfiles)
+{
+  OsmIdToSpeedProfile osmIdToProfile;
+  TEST(Parse(MakeLine(10 /* osmId */, true /* forward */, 60 /* speed */, 8 /* slowHour */,
+                      30 /* slowSpeed */) +
+                 MakeLine(20 /* osmId */, false /* forward */, 90 /* speed */, 8 /* slowHour */,
+                          45 /* slowSpeed */) +
+                 MakeLine(30 /* osmId */, true /* forward */, 90 /* speed */, 9 /* slowHour */,
+                          45 /* slowSpeed */),
+             osmIdToProfile),
+       ());
+
+  OsmIdToFeatureIds osmIdToFeatureIds;
+  AddFeatureId(base::MakeOsmWay(10), 1 /* featureId */, osmIdToFeatureIds);
+  AddFeatureId(base::MakeOsmWay(10), 2 /* featureId */, osmIdToFeatureIds);
+  AddFeatureId(base::MakeOsmWay(20), 3 /* featureId */, osmIdToFeatureIds);
+
+  auto const speedProfiles = MakeSpeedProfiles(osmIdToProfile, osmIdToFeatureIds);
+  // Way 30 is not in the mwm and ways 10 and 20 have the same profile.
+  TEST_EQUAL(speedProfiles.GetProfiles().size(), 1, ());
+  TEST_EQUAL(speedProfiles.GetEntriesNumber(), 3, ());
+
+  time_t const now = time(nullptr);
+  time_t const slowTime =
+      now + (8 - static_cast<time_t>(SpeedProfiles::GetHourOfWeek(now))) * 60 * 60;
+  for (uint32_t featureId : {1, 2})
+  {
+    auto const factor = speedProfiles.GetSpeedFactor(featureId, true /* forward */, slowTime);
+    TEST(factor, (featureId));
+    TEST_ALMOST_EQUAL_ABS(*factor, 0.5, 1e-9, (featureId));
+    TEST(!speedProfiles.GetSpeedFactor(featureId, false /* forward */, slowTime), (featureId));
+  }
+
+  auto const factor =
+      speedProfiles.GetSpeedFactor(3 /* featureId */, false /* forward */, slowTime);
+  TEST(factor, ());
+  TEST_ALMOST_EQUAL_ABS(*factor, 0.5, 1e-9, ());
+}
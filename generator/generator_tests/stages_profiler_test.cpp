@@ -0,0 +1,42 @@
+#include "testing/testing.hpp"
+
+#include "generator/stages_profiler.hpp"
+
+#include "3party/jansson/myjansson.hpp"
+
+#include <string>
+
+using namespace generator;
+
+UNIT_TEST(StagesProfiler_Smoke)
+{
+  auto & profiler = StagesProfiler::Instance();
+  profiler.Clear();
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    StagesProfiler::Scope scope("test/stage");
+    std::string s;
+    for (size_t j = 0; j < 100000; ++j)
+      s += std::to_string(j);
+  }
+  {
+    StagesProfiler::Scope scope("test/another_stage");
+  }
+
+  auto const stages = profiler.GetStages();
+  TEST_EQUAL(stages.size(), 2, ());
+  auto const & usage = stages.at("test/stage");
+  TEST_EQUAL(usage.m_runsCount, 2, ());
+  TEST_GREATER(usage.m_wallSeconds, 0.0, ());
+  TEST_GREATER_OR_EQUAL(usage.m_cpuSeconds, 0.0, ());
+  TEST_GREATER(usage.m_peakRssBytes, 0, ());
+
+  base::Json const report(profiler.GetJsonReport());
+  auto const * json = base::GetJSONObligatoryField(report.get(), "stages");
+  auto const * stage = base::GetJSONObligatoryField(json, "test/stage");
+  TEST_EQUAL(FromJSONObject<json_int_t>(stage, "runs"), 2, ());
+  TEST(base::GetJSONOptionalField(json, "test/another_stage"), ());
+
+  profiler.Clear();
+}
@@ -73,3 +73,29 @@ UNIT_TEST(Tesselator_Odd)
 
   TEST_EQUAL(2, RunTest(l), ());
 }
+
+UNIT_TEST(Tesselator_Convex)
+{
+  tesselator::Stats stats;
+  auto const tesselate = [&stats](vector<P> const & contour) {
+    tesselator::TrianglesInfo info;
+    return tesselator::TesselateInterior({contour}, info, &stats);
+  };
+
+  // Rectangle, closed and not closed.
+  TEST_EQUAL(2, tesselate({P(0, 0), P(4, 0), P(4, 2), P(0, 2)}), ());
+  TEST_EQUAL(2, tesselate({P(0, 0), P(0, 2), P(4, 2), P(4, 0), P(0, 0)}), ());
+  // Hexagon.
+  TEST_EQUAL(4, tesselate({P(0, 0), P(2, -1), P(4, 0), P(4, 2), P(2, 3), P(0, 2)}), ());
+  TEST_EQUAL(stats.m_convex, 3, ());
+  TEST_EQUAL(stats.m_generic, 0, ());
+
+  // Concave polygon.
+  TEST_EQUAL(3, tesselate({P(0, 0), P(4, 0), P(4, 4), P(2, 1), P(0, 4)}), ());
+  // Pentagram turns in the same direction all the time.
+  TEST_GREATER(tesselate({P(0, 0), P(4, 10), P(8, 0), P(-2, 6), P(10, 6)}), 3, ());
+  // Collinear points.
+  TEST_EQUAL(3, tesselate({P(0, 0), P(2, 0), P(4, 0), P(4, 2), P(0, 2)}), ());
+  TEST_EQUAL(stats.m_convex, 3, ());
+  TEST_EQUAL(stats.m_generic, 3, ());
+}
@@ -1,5 +1,6 @@
 #include "generator/generator_tests_support/test_mwm_builder.hpp"
 
+#include "generator/category_cells_table_builder.hpp"
 #include "generator/centers_table_builder.hpp"
 #include "generator/cities_ids_builder.hpp"
 #include "generator/feature_builder.hpp"
@@ -8,6 +9,7 @@
 #include "generator/generator_tests_support/test_feature.hpp"
 #include "generator/postcode_points_builder.hpp"
 #include "generator/search_index_builder.hpp"
+#include "generator/street_to_houses_table_builder.hpp"
 
 #include "indexer/city_boundary.hpp"
 #include "indexer/data_header.hpp"
@@ -173,6 +175,10 @@ void TestMwmBuilder::Finish()
   CHECK(indexer::BuildCentersTableFromDataFile(path, true /* forceRebuild */),
         ("Can't build centers table."));
 
+  CHECK(search::BuildStreetToHousesTable(path), ("Can't build street to houses table."));
+
+  CHECK(search::BuildCategoryCellsTable(path), ("Can't build category cells table."));
+
   CHECK(search::SearchRankTableBuilder::CreateIfNotExists(path), ());
 
   if (!m_languages.empty())
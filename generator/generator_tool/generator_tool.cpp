@@ -1,20 +1,25 @@
 #include "generator/altitude_generator.hpp"
 #include "generator/borders.hpp"
 #include "generator/camera_info_collector.hpp"
+#include "generator/category_cells_table_builder.hpp"
 #include "generator/centers_table_builder.hpp"
 #include "generator/check_model.hpp"
 #include "generator/cities_boundaries_builder.hpp"
 #include "generator/cities_ids_builder.hpp"
 #include "generator/city_roads_generator.hpp"
+#include "generator/completions_table_builder.hpp"
+#include "generator/countries_shards.hpp"
 #include "generator/descriptions_section_builder.hpp"
 #include "generator/dumper.hpp"
 #include "generator/feature_builder.hpp"
 #include "generator/feature_generator.hpp"
 #include "generator/feature_sorter.hpp"
+#include "generator/feature_types_table_builder.hpp"
 #include "generator/generate_info.hpp"
 #include "generator/isolines_section_builder.cpp"
 #include "generator/maxspeeds_builder.hpp"
 #include "generator/metalines_builder.hpp"
+#include "generator/osm_change.hpp"
 #include "generator/osm_source.hpp"
 #include "generator/platform_helpers.hpp"
 #include "generator/popular_places_section_builder.hpp"
@@ -24,10 +29,14 @@
 #include "generator/raw_generator.hpp"
 #include "generator/restriction_generator.hpp"
 #include "generator/road_access_generator.hpp"
+#include "generator/routing_cross_mwm_landmarks_generator.hpp"
 #include "generator/routing_index_generator.hpp"
 #include "generator/routing_world_roads_generator.hpp"
 #include "generator/search_index_builder.hpp"
+#include "generator/speed_profiles_builder.hpp"
+#include "generator/stages_profiler.hpp"
 #include "generator/statistics.hpp"
+#include "generator/street_to_houses_table_builder.hpp"
 #include "generator/traffic_generator.hpp"
 #include "generator/transit_generator.hpp"
 #include "generator/transit_generator_experimental.hpp"
@@ -59,6 +68,7 @@
 #include "coding/transliteration.hpp"
 
 #include "base/file_name_utils.hpp"
+#include "base/scope_guard.hpp"
 #include "base/timer.hpp"
 
 #include "defines.hpp"
@@ -98,7 +108,7 @@ DEFINE_bool(emit_coasts, false,
 
 // Generator settings and paths.
 DEFINE_string(osm_file_name, "", "Input osm area file.");
-DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m].");
+DEFINE_string(osm_file_type, "xml", "Input osm area file type [xml, o5m, pbf].");
 DEFINE_string(data_path, "", GetDataPathHelp());
 DEFINE_string(user_resource_path, "", "User defined resource path for classificator.txt and etc.");
 DEFINE_string(intermediate_data_path, "", "Path to stored intermediate data.");
@@ -108,16 +118,25 @@ DEFINE_string(cache_path, "",
 DEFINE_string(output, "", "File name for process (without 'mwm' ext).");
 DEFINE_bool(preload_cache, false, "Preload all ways and relations cache.");
 DEFINE_string(node_storage, "map",
-              "Type of storage for intermediate points representation. Available: raw, map, mem.");
+              "Type of storage for intermediate points representation. Available: raw, map, mem, packed.");
 DEFINE_uint64(planet_version, base::SecondsSinceEpoch(),
               "Version as seconds since epoch, by default - now.");
 
+// Incremental update.
+DEFINE_string(osm_change, "",
+              "osmChange file. Countries touched by it are found with the intermediate data of "
+              "the previous build and are written to 'affected_countries'.");
+DEFINE_string(affected_countries, "",
+              "Output file with the countries touched by 'osm_change', one per line.");
+
 // Preprocessing and feature generator.
 DEFINE_bool(preprocess, false, "1st pass - create nodes/ways/relations data.");
 DEFINE_bool(generate_features, false, "2nd pass - generate intermediate features.");
 DEFINE_bool(add_ads, false, "generation with ads.");
 DEFINE_bool(generate_geometry, false,
             "3rd pass - split and simplify geometry and triangles for features.");
+DEFINE_bool(hilbert_features_order, false,
+            "Order the features of every scale by the Hilbert curve in the 3rd pass.");
 DEFINE_bool(generate_index, false, "4rd pass - generate index.");
 DEFINE_bool(generate_search_index, false, "5th pass - generate search index.");
 DEFINE_bool(dump_cities_boundaries, false, "Dump cities boundaries to a file");
@@ -125,6 +144,10 @@ DEFINE_bool(generate_cities_boundaries, false, "Generate the cities boundaries s
 DEFINE_string(cities_boundaries_data, "", "File with cities boundaries");
 
 DEFINE_bool(generate_cities_ids, false, "Generate the cities ids section");
+DEFINE_bool(generate_feature_types, false,
+            "Generate the feature types section for the search filters.");
+DEFINE_bool(generate_search_completions, false,
+            "Generate the completions section for the instant search suggestions.");
 
 DEFINE_bool(generate_world, false, "Generate separate world file.");
 DEFINE_bool(have_borders_for_whole_world, false,
@@ -143,9 +166,16 @@ DEFINE_bool(make_routing_index, false, "Make sections with the routing informati
 DEFINE_bool(make_cross_mwm, false,
             "Make section for cross mwm routing (for dynamic indexed routing).");
 DEFINE_bool(make_transit_cross_mwm, false, "Make section for cross mwm transit routing.");
+DEFINE_bool(make_cross_mwm_landmarks, false,
+            "Make section with cross mwm landmarks for World. Cross mwm sections with car weights "
+            "should be built for all the mwms in data_path.");
+DEFINE_uint64(cross_mwm_landmarks_count, 16, "Count of landmarks for make_cross_mwm_landmarks.");
 DEFINE_bool(make_transit_cross_mwm_experimental, false,
             "Experimental parameter. If set the new version of transit cross-mwm section will be "
             "generated. Makes section for cross mwm transit routing.");
+DEFINE_string(cross_mwm_weights_cache, "",
+              "Directory where the weights of the cross mwm sections are saved to and reused from "
+              "if the roads of a country are not changed.");
 DEFINE_bool(disable_cross_mwm_progress, false,
             "Disable log of cross mwm section building progress.");
 DEFINE_string(srtm_path, "",
@@ -164,6 +194,9 @@ DEFINE_bool(
     make_city_roads, false,
     "Calculates which roads lie inside cities and makes a section with ids of these roads.");
 DEFINE_bool(generate_maxspeed, false, "Generate section with maxspeed of road features.");
+DEFINE_string(speed_profiles_path, "",
+              "Path to csv file with typical speeds of roads by the hour of the week. If set, "
+              "section with speed profiles for time-dependent car routing is generated.");
 
 // Sponsored-related.
 DEFINE_string(booking_data, "", "Path to booking data in tsv format.");
@@ -192,6 +225,9 @@ DEFINE_string(us_postcodes_dataset, "", "Path to dataset with US postcodes.");
 // Printing stuff.
 DEFINE_bool(calc_statistics, false, "Calculate feature statistics for specified mwm bucket files.");
 DEFINE_bool(type_statistics, false, "Calculate statistics by type for specified mwm bucket files.");
+DEFINE_uint64(pages_statistics_zoom, 0,
+              "Calculate count of the features section pages read by the tiles of the zoom "
+              "for specified mwm bucket files.");
 DEFINE_bool(dump_types, false, "Prints all types combinations and their total count.");
 DEFINE_bool(dump_prefixes, false, "Prints statistics on feature's' name prefixes.");
 DEFINE_bool(dump_search_tokens, false, "Print statistics on search tokens.");
@@ -215,6 +251,17 @@ DEFINE_bool(dump_mwm_tmp, false, "Prints feature builder objects from .mwm.tmp")
 DEFINE_uint64(threads_count, 0, "Desired count of threads. If count equals zero, count of "
                                 "threads is set automatically.");
 DEFINE_bool(verbose, false, "Provide more detailed output.");
+DEFINE_uint64(final_processing_memory_mb, 0, "Memory budget in megabytes for the countries which "
+                                             "are processed in parallel at the final stage. "
+                                             "Zero means the memory is not limited.");
+DEFINE_uint64(shards_count, 1, "Count of the machines a planet build is split between. The "
+                               "per-country stages are run for the countries of --shard_index "
+                               "only.");
+DEFINE_uint64(shard_index, 0, "Index of the shard of the countries to build, see --shards_count.");
+DEFINE_string(shard_manifest, "", "Path to the JSON manifest of the files built for the countries "
+                                  "of the shard.");
+DEFINE_string(stages_profile, "", "Path to the JSON report of the generator stages: wall time, "
+                                  "CPU time, peak RSS and I/O of every stage.");
 
 using namespace generator;
 
@@ -246,6 +293,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
   feature::GenerateInfo genInfo;
   genInfo.m_verbose = FLAGS_verbose;
+  genInfo.m_hilbertFeaturesOrder = FLAGS_hilbert_features_order;
   genInfo.m_intermediateDir = FLAGS_intermediate_data_path.empty()
                                   ? path
                                   : base::AddSlashIfNeeded(FLAGS_intermediate_data_path);
@@ -276,6 +324,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   genInfo.m_brandsTranslationsFilename = FLAGS_brands_translations_data;
   genInfo.m_citiesBoundariesFilename = FLAGS_cities_boundaries_data;
   genInfo.m_versionDate = static_cast<uint32_t>(FLAGS_planet_version);
+  genInfo.m_finalProcessingMemoryBytes = FLAGS_final_processing_memory_mb * 1024 * 1024;
   genInfo.m_haveBordersForWholeWorld = FLAGS_have_borders_for_whole_world;
   genInfo.m_createWorld = FLAGS_generate_world;
   genInfo.m_makeCoasts = FLAGS_make_coasts;
@@ -290,17 +339,34 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
   classificator::Load();
 
+  SCOPE_GUARD(saveStagesProfile, []() {
+    if (!FLAGS_stages_profile.empty())
+      StagesProfiler::Instance().SaveJsonReport(FLAGS_stages_profile);
+  });
+
+  // Find countries to regenerate. It should be done before the intermediate data of the previous
+  // build is overwritten by the preprocessing.
+  if (!FLAGS_osm_change.empty())
+  {
+    LOG(LINFO, ("Finding countries touched by", FLAGS_osm_change));
+    CHECK(!FLAGS_affected_countries.empty(), ("Output file for affected countries is not set."));
+    if (!GenerateAffectedCountries(genInfo, FLAGS_osm_change, FLAGS_affected_countries))
+      return EXIT_FAILURE;
+  }
+
   // Generate intermediate files.
   if (FLAGS_preprocess)
   {
     LOG(LINFO, ("Generating intermediate data ...."));
-    if (!GenerateIntermediateData(genInfo))
+    StagesProfiler::Scope scope("preprocess");
+    if (!GenerateIntermediateData(genInfo, threadsCount))
       return EXIT_FAILURE;
   }
 
   // Generate .mwm.tmp files.
   if (FLAGS_generate_features || FLAGS_generate_world || FLAGS_make_coasts)
   {
+    StagesProfiler::Scope scope("features");
     RawGenerator rawGenerator(genInfo, threadsCount);
     if (FLAGS_generate_features)
       rawGenerator.GenerateCountries(FLAGS_add_ads);
@@ -318,17 +384,34 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
   if (genInfo.m_bucketNames.empty() && !FLAGS_output.empty())
     genInfo.m_bucketNames.push_back(FLAGS_output);
 
+  if (FLAGS_shards_count > 1)
+  {
+    // The sizes of the features files are known on every machine after the features stage.
+    auto const getSize = [&genInfo](string const & country) {
+      uint64_t size = 0;
+      UNUSED_VALUE(Platform::GetFileSizeByFullPath(genInfo.GetTmpFileName(country), size));
+      return size;
+    };
+
+    auto const countriesCount = genInfo.m_bucketNames.size();
+    genInfo.m_bucketNames = GetShardCountries(genInfo.m_bucketNames, getSize, FLAGS_shards_count,
+                                              FLAGS_shard_index);
+    LOG(LINFO, ("Shard", FLAGS_shard_index, "of", FLAGS_shards_count, "builds",
+                genInfo.m_bucketNames.size(), "of", countriesCount, "countries"));
+  }
+
   if (FLAGS_dump_mwm_tmp)
   {
-    for (auto const & fb : feature::ReadAllDatRawFormat(genInfo.GetTmpFileName(FLAGS_output)))
+    for (auto const & fb :
+         feature::ReadAllDatRawFormat(genInfo.GetTmpFileName(FLAGS_output), threadsCount))
       std::cout << DebugPrint(fb) << std::endl;
   }
 
   // Load mwm tree only if we need it
   unique_ptr<storage::CountryParentGetter> countryParentGetter;
   if (FLAGS_make_routing_index || FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
-      FLAGS_make_transit_cross_mwm_experimental || !FLAGS_uk_postcodes_dataset.empty() ||
-      !FLAGS_us_postcodes_dataset.empty())
+      FLAGS_make_transit_cross_mwm_experimental || FLAGS_make_cross_mwm_landmarks ||
+      !FLAGS_uk_postcodes_dataset.empty() || !FLAGS_us_postcodes_dataset.empty())
   {
     countryParentGetter = make_unique<storage::CountryParentGetter>();
   }
@@ -359,6 +442,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
     if (FLAGS_generate_geometry)
     {
+      StagesProfiler::Scope scope("mwm/geometry/" + country);
       using MapType = feature::DataHeader::MapType;
 
       MapType mapType = MapType::Country;
@@ -370,7 +454,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       // On error move to the next bucket without index generation.
 
       LOG(LINFO, ("Generating result features for", country));
-      if (!feature::GenerateFinalFeatures(genInfo, country, mapType))
+      if (!feature::GenerateFinalFeatures(genInfo, country, mapType, threadsCount))
         continue;
 
       LOG(LINFO, ("Generating offsets table for", dataFile));
@@ -390,6 +474,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     if (FLAGS_generate_index)
     {
       LOG(LINFO, ("Generating index for", dataFile));
+      StagesProfiler::Scope scope("mwm/index/" + country);
 
       if (!indexer::BuildIndexFromDataFile(dataFile, FLAGS_intermediate_data_path + country))
         LOG(LCRITICAL, ("Error generating index."));
@@ -398,6 +483,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     if (FLAGS_generate_search_index)
     {
       LOG(LINFO, ("Generating search index for", dataFile));
+      StagesProfiler::Scope scope("mwm/search_index/" + country);
 
       /// @todo Make threads count according to environment (single mwm build or planet build).
       if (!indexer::BuildSearchIndexFromDataFile(country, genInfo, true /* forceRebuild */,
@@ -441,6 +527,28 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       LOG(LINFO, ("Generating centers table for", dataFile));
       if (!indexer::BuildCentersTableFromDataFile(dataFile, true /* forceRebuild */))
         LOG(LCRITICAL, ("Error generating centers table."));
+
+      LOG(LINFO, ("Generating street to houses table for", dataFile));
+      if (!search::BuildStreetToHousesTable(dataFile))
+        LOG(LCRITICAL, ("Error generating street to houses table."));
+
+      LOG(LINFO, ("Generating category cells table for", dataFile));
+      if (!search::BuildCategoryCellsTable(dataFile))
+        LOG(LCRITICAL, ("Error generating category cells table."));
+    }
+
+    if (FLAGS_generate_feature_types)
+    {
+      LOG(LINFO, ("Generating feature types table for", dataFile));
+      if (!indexer::BuildFeatureTypesTable(dataFile))
+        LOG(LCRITICAL, ("Error generating feature types table."));
+    }
+
+    if (FLAGS_generate_search_completions)
+    {
+      LOG(LINFO, ("Generating completions table for", dataFile));
+      if (!search::BuildCompletionsTable(dataFile))
+        LOG(LCRITICAL, ("Error generating completions table."));
     }
 
     if (FLAGS_generate_cities_boundaries)
@@ -501,6 +609,36 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       }
     }
 
+    if (country == WORLD_FILE_NAME && FLAGS_make_cross_mwm_landmarks)
+    {
+      if (!countryParentGetter)
+      {
+        LOG(LCRITICAL,
+            ("Countries file is needed. Please set countries file name (countries.txt). "
+             "File must be located in data directory."));
+        return EXIT_FAILURE;
+      }
+
+      Platform::FilesList files;
+      Platform::GetFilesByExt(path, DATA_FILE_EXTENSION, files);
+
+      vector<string> countries;
+      for (auto & file : files)
+      {
+        base::GetNameWithoutExt(file);
+        if (file != WORLD_FILE_NAME && file != WORLD_COASTS_FILE_NAME)
+          countries.push_back(file);
+      }
+
+      LOG(LINFO, ("Generating cross mwm landmarks section for World."));
+      if (!routing::BuildCrossMwmLandmarks(path, countries, dataFile, *countryParentGetter,
+                                           static_cast<uint32_t>(FLAGS_cross_mwm_landmarks_count)))
+      {
+        LOG(LCRITICAL, ("Generating cross mwm landmarks section for World has failed."));
+        return EXIT_FAILURE;
+      }
+    }
+
     if (FLAGS_make_routing_index)
     {
       if (!countryParentGetter)
@@ -515,6 +653,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       string const restrictionsFilename = genInfo.GetIntermediateFileName(RESTRICTIONS_FILENAME);
       string const roadAccessFilename = genInfo.GetIntermediateFileName(ROAD_ACCESS_FILENAME);
 
+      StagesProfiler::Scope scope("mwm/routing_index/" + country);
       routing::BuildRoutingIndex(dataFile, country, *countryParentGetter);
       routing::BuildRoadRestrictions(path, dataFile, country, restrictionsFilename,
                                      osmToFeatureFilename, *countryParentGetter);
@@ -525,6 +664,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     {
       CHECK(!FLAGS_cities_boundaries_data.empty(), ());
       LOG(LINFO, ("Generating cities boundaries roads for", dataFile));
+      StagesProfiler::Scope scope("mwm/city_roads/" + country);
       auto const boundariesPath =
           genInfo.GetIntermediateFileName(ROUTING_CITY_BOUNDARIES_DUMP_FILENAME);
       if (!routing::BuildCityRoads(dataFile, boundariesPath))
@@ -534,10 +674,19 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     if (FLAGS_generate_maxspeed)
     {
       LOG(LINFO, ("Generating maxspeeds section for", dataFile));
+      StagesProfiler::Scope scope("mwm/maxspeeds/" + country);
       string const maxspeedsFilename = genInfo.GetIntermediateFileName(MAXSPEEDS_FILENAME);
       routing::BuildMaxspeedsSection(dataFile, osmToFeatureFilename, maxspeedsFilename);
     }
 
+    if (!FLAGS_speed_profiles_path.empty())
+    {
+      LOG(LINFO, ("Generating speed profiles section for", dataFile));
+      StagesProfiler::Scope scope("mwm/speed_profiles/" + country);
+      routing::BuildSpeedProfilesSection(dataFile, osmToFeatureFilename,
+                                         FLAGS_speed_profiles_path);
+    }
+
     if (FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm ||
         FLAGS_make_transit_cross_mwm_experimental)
     {
@@ -552,9 +701,11 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
 
       if (FLAGS_make_cross_mwm)
       {
+        StagesProfiler::Scope scope("mwm/cross_mwm/" + country);
         routing::BuildRoutingCrossMwmSection(path, dataFile, country, genInfo.m_intermediateDir,
                                              *countryParentGetter, osmToFeatureFilename,
-                                             FLAGS_disable_cross_mwm_progress);
+                                             FLAGS_disable_cross_mwm_progress, threadsCount,
+                                             FLAGS_cross_mwm_weights_cache);
       }
 
       if (FLAGS_make_transit_cross_mwm_experimental)
@@ -611,6 +762,16 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     }
   }
 
+  if (!FLAGS_shard_manifest.empty())
+  {
+    ShardManifest manifest(FLAGS_shards_count, FLAGS_shard_index);
+    for (auto const & country : genInfo.m_bucketNames)
+      manifest.AddCountry(country, {genInfo.GetTargetFileName(country, DATA_FILE_EXTENSION)});
+
+    if (!manifest.Save(FLAGS_shard_manifest))
+      return EXIT_FAILURE;
+  }
+
   string const dataFile = base::JoinPath(path, FLAGS_output + DATA_FILE_EXTENSION);
 
   if (FLAGS_calc_statistics)
@@ -636,6 +797,14 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
     stats::PrintTypeStatistic(file, info);
   }
 
+  if (FLAGS_pages_statistics_zoom != 0)
+  {
+    LOG(LINFO, ("Calculating pages statistics for", dataFile));
+
+    auto file = OfstreamWithExceptions(genInfo.GetIntermediateFileName(FLAGS_output, STATS_EXTENSION));
+    stats::PrintPagesStatistic(file, dataFile, static_cast<int>(FLAGS_pages_statistics_zoom));
+  }
+
   if (FLAGS_dump_types)
     feature::DumpTypes(dataFile);
 
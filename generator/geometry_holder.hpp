@@ -23,7 +23,7 @@ namespace feature
 class GeometryHolder
 {
 public:
-  using FileGetter = std::function<FileWriter &(int i)>;
+  using FileGetter = std::function<Writer &(int i)>;
   using Points = std::vector<m2::PointD>;
   using Polygons = std::list<Points>;
 
@@ -52,6 +52,7 @@ public:
   }
 
   void SetInner() { m_trgInner = true; }
+  void SetTesselatorStats(tesselator::Stats * stats) { m_tesselatorStats = stats; }
 
   FeatureBuilder::SupportingData & GetBuffer() { return m_buffer; }
 
@@ -176,7 +177,7 @@ private:
 
     // tesselation
     tesselator::TrianglesInfo info;
-    if (0 == tesselator::TesselateInterior(polys, info))
+    if (0 == tesselator::TesselateInterior(polys, info, m_tesselatorStats))
     {
       LOG(LINFO, ("NO TRIANGLES in", polys));
       return;
@@ -248,5 +249,6 @@ private:
   feature::DataHeader const & m_header;
   // max triangles number to store in innerTriangles
   size_t m_maxNumTriangles;
+  tesselator::Stats * m_tesselatorStats = nullptr;
 };
 }  //  namespace feature
@@ -72,5 +72,10 @@ void HolesRelation::Build(OsmElement const * p)
     else if (e.m_role == "inner")
       m_holes(e.m_ref);
   }
+
+  // All the member ways are read, so the nodes of both outer and inner rings are requested
+  // before any of them is merged.
+  m_outer.PrefetchNodes();
+  m_holes.PrefetchNodes();
 }
 }  // namespace generator
@@ -22,6 +22,7 @@ public:
   explicit HolesAccumulator(std::shared_ptr<cache::IntermediateDataReaderInterface> const & cache);
 
   void operator() (uint64_t id) { m_merger.AddWay(id); }
+  void PrefetchNodes() { m_merger.PrefetchNodes(); }
   feature::FeatureBuilder::Geometry & GetHoles();
 
 private:
@@ -1,15 +1,23 @@
 #include "generator/intermediate_data.hpp"
 
+#include <climits>
+#include <cstring>
 #include <new>
 #include <set>
 #include <string>
 
+#include "coding/bit_streams.hpp"
+#include "coding/write_to_sink.hpp"
+
 #include "base/assert.hpp"
+#include "base/bits.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
 #include "defines.hpp"
 
+#include "3party/skarupke/flat_hash_map.hpp"
+
 using namespace std;
 
 namespace generator
@@ -27,6 +35,18 @@ string const kShortExtension = ".short";
 // see https://wiki.openstreetmap.org/wiki/Stats
 size_t const kMaxNodesInOSM = size_t{1} << 33;
 
+// Packed storage parameters, see PackedPointStorageWriter.
+uint32_t constexpr kPackedBlockBits = 8;
+uint64_t constexpr kPackedBlockSize = uint64_t{1} << kPackedBlockBits;
+size_t constexpr kPackedMaskWords = kPackedBlockSize / 64;
+size_t constexpr kPackedHeaderSize =
+    kPackedMaskWords * sizeof(uint64_t) + 2 * sizeof(int32_t) + 2 * sizeof(uint8_t);
+uint64_t constexpr kPackedGroupSize = 16;
+string const kPackedIndexExtension = ".idx";
+static_assert(kPackedGroupSize * (kPackedHeaderSize + kPackedBlockSize * sizeof(LatLon)) <=
+                  numeric_limits<uint16_t>::max(),
+              "Offsets of blocks inside a group must fit into uint16_t.");
+
 void ToLatLon(double lat, double lon, LatLon & ll)
 {
   int64_t const lat64 = lat * kValueOrder;
@@ -190,6 +210,7 @@ public:
     LOG(LINFO, ("Nodes reading is started"));
 
     uint64_t const count = m_fileReader.Size();
+    m_map.reserve(count / sizeof(LatLonPos));
 
     uint64_t pos = 0;
     LatLonPos llp;
@@ -224,7 +245,7 @@ public:
 
 private:
   FileReader m_fileReader;
-  unordered_map<uint64_t, LatLon> m_map;
+  ska::flat_hash_map<uint64_t, LatLon> m_map;
 };
 
 // MapFilePointStorageWriter -----------------------------------------------------------------------
@@ -256,6 +277,240 @@ private:
   FileWriter m_fileWriter;
   uint64_t m_numProcessedPoints = 0;
 };
+
+// PackedPointStorageWriter ------------------------------------------------------------------------
+// Nodes are grouped into blocks of kPackedBlockSize consecutive ids. Every block is stored as
+// a presence bitmask, minimal coordinates of the block nodes, numbers of bits of the coordinate
+// differences and bit-packed differences of the node coordinates from the minimal ones. So a point
+// is read without decoding of the other points of the block. Empty blocks take no space.
+// Offsets of blocks are stored in |name + kPackedIndexExtension| as 64-bit offsets of groups of
+// kPackedGroupSize blocks and 16-bit offsets of the blocks inside the groups.
+// Nodes should be added in ascending order of ids, as they go in osm files.
+class PackedPointStorageWriter : public PointStorageWriterBase
+{
+public:
+  explicit PackedPointStorageWriter(string const & name)
+    : m_dataWriter(name), m_indexWriter(name + kPackedIndexExtension)
+  {
+  }
+
+  ~PackedPointStorageWriter()
+  {
+    if (!m_points.empty())
+      FlushBlock();
+
+    // The last offset is the end of the last block.
+    AddBlockOffset(m_dataWriter.Pos());
+
+    WriteToSink(m_indexWriter, static_cast<uint64_t>(m_blockOffsets.size() - 1));
+    WriteToSink(m_indexWriter, static_cast<uint64_t>(m_groupOffsets.size()));
+    m_indexWriter.Write(m_groupOffsets.data(), m_groupOffsets.size() * sizeof(uint64_t));
+    m_indexWriter.Write(m_blockOffsets.data(), m_blockOffsets.size() * sizeof(uint16_t));
+  }
+
+  // PointStorageWriterInterface overrides:
+  void AddPoint(uint64_t id, double lat, double lon) override
+  {
+    uint64_t const block = id >> kPackedBlockBits;
+    if (!m_points.empty() && block != m_currentBlock)
+      FlushBlock();
+
+    CHECK_GREATER_OR_EQUAL(block, m_blockOffsets.size(),
+                           ("Nodes must be sorted by id for the packed storage. Node id:", id));
+    m_currentBlock = block;
+
+    LatLon ll;
+    ToLatLon(lat, lon, ll);
+    m_points.emplace_back(id & (kPackedBlockSize - 1), ll);
+
+    ++m_numProcessedPoints;
+  }
+
+private:
+  void AddBlockOffset(uint64_t offset)
+  {
+    if (m_blockOffsets.size() % kPackedGroupSize == 0)
+      m_groupOffsets.push_back(offset);
+
+    CHECK_LESS_OR_EQUAL(offset - m_groupOffsets.back(), numeric_limits<uint16_t>::max(), ());
+    m_blockOffsets.push_back(static_cast<uint16_t>(offset - m_groupOffsets.back()));
+  }
+
+  void FlushBlock()
+  {
+    // Empty blocks before the current one and the current block start at the same offset.
+    uint64_t const offset = m_dataWriter.Pos();
+    while (m_blockOffsets.size() <= m_currentBlock)
+      AddBlockOffset(offset);
+
+    sort(m_points.begin(), m_points.end(),
+         [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+
+    uint64_t mask[kPackedMaskWords] = {};
+    LatLon minLL = m_points.front().second;
+    LatLon maxLL = minLL;
+    for (size_t i = 0; i < m_points.size(); ++i)
+    {
+      auto const idx = m_points[i].first;
+      CHECK(i == 0 || m_points[i - 1].first != idx,
+            ("Duplicate node id:", (m_currentBlock << kPackedBlockBits) + idx));
+      mask[idx / 64] |= uint64_t{1} << (idx % 64);
+
+      auto const & ll = m_points[i].second;
+      minLL.m_lat = min(minLL.m_lat, ll.m_lat);
+      minLL.m_lon = min(minLL.m_lon, ll.m_lon);
+      maxLL.m_lat = max(maxLL.m_lat, ll.m_lat);
+      maxLL.m_lon = max(maxLL.m_lon, ll.m_lon);
+    }
+
+    auto const latBits = static_cast<uint8_t>(bits::NumUsedBits(
+        static_cast<uint64_t>(static_cast<int64_t>(maxLL.m_lat) - minLL.m_lat)));
+    auto const lonBits = static_cast<uint8_t>(bits::NumUsedBits(
+        static_cast<uint64_t>(static_cast<int64_t>(maxLL.m_lon) - minLL.m_lon)));
+
+    for (auto const word : mask)
+      WriteToSink(m_dataWriter, word);
+    WriteToSink(m_dataWriter, minLL.m_lat);
+    WriteToSink(m_dataWriter, minLL.m_lon);
+    WriteToSink(m_dataWriter, latBits);
+    WriteToSink(m_dataWriter, lonBits);
+
+    {
+      BitWriter<FileWriter> bitWriter(m_dataWriter);
+      for (auto const & p : m_points)
+      {
+        auto const & ll = p.second;
+        bitWriter.WriteAtMost32Bits(
+            static_cast<uint32_t>(static_cast<int64_t>(ll.m_lat) - minLL.m_lat), latBits);
+        bitWriter.WriteAtMost32Bits(
+            static_cast<uint32_t>(static_cast<int64_t>(ll.m_lon) - minLL.m_lon), lonBits);
+      }
+    }
+
+    m_points.clear();
+  }
+
+  FileWriter m_dataWriter;
+  FileWriter m_indexWriter;
+  vector<uint64_t> m_groupOffsets;
+  vector<uint16_t> m_blockOffsets;
+  uint64_t m_currentBlock = 0;
+  // Index of a node inside the current block and its coordinates.
+  vector<pair<uint32_t, LatLon>> m_points;
+  uint64_t m_numProcessedPoints = 0;
+};
+
+// PackedPointStorageReader ------------------------------------------------------------------------
+class PackedPointStorageReader : public PointStorageReaderInterface
+{
+public:
+  explicit PackedPointStorageReader(string const & name)
+    : m_dataReader(name, MmapReader::Advice::Random)
+  {
+    FileReader indexReader(name + kPackedIndexExtension);
+    ReaderSource<FileReader> src(indexReader);
+    m_numBlocks = ReadPrimitiveFromSource<uint64_t>(src);
+    m_groupOffsets.resize(ReadPrimitiveFromSource<uint64_t>(src));
+    CHECK_EQUAL(m_groupOffsets.size(), m_numBlocks / kPackedGroupSize + 1, ());
+    src.Read(m_groupOffsets.data(), m_groupOffsets.size() * sizeof(uint64_t));
+    m_blockOffsets.resize(m_numBlocks + 1);
+    src.Read(m_blockOffsets.data(), m_blockOffsets.size() * sizeof(uint16_t));
+    CHECK_EQUAL(GetBlockOffset(m_numBlocks), m_dataReader.Size(), ());
+  }
+
+  // PointStorageReaderInterface overrides:
+  bool GetPoint(uint64_t id, double & lat, double & lon) const override
+  {
+    LatLon ll;
+    if (!GetLatLon(id, ll))
+      return false;
+
+    bool const ret = FromLatLon(ll, lat, lon);
+    if (!ret)
+    {
+      LOG(LERROR, ("Inconsistent PackedPointStorageReader. Node with id =", id,
+                   "must exist but was not found"));
+    }
+    return ret;
+  }
+
+  void Prefetch(vector<uint64_t> const & ids) const override
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    uint8_t const * data = m_dataReader.Data();
+    for (auto const id : ids)
+    {
+      uint64_t const block = id >> kPackedBlockBits;
+      if (block < m_numBlocks)
+        __builtin_prefetch(data + GetBlockOffset(block));
+    }
+#endif
+  }
+
+private:
+  uint64_t GetBlockOffset(uint64_t block) const
+  {
+    return m_groupOffsets[block / kPackedGroupSize] + m_blockOffsets[block];
+  }
+
+  // Reads |numBits| <= 32 bits from |bitPos| of |data|. Bits are written by BitWriter.
+  static uint32_t ReadBits(uint8_t const * data, uint64_t bitPos, uint8_t numBits)
+  {
+    if (numBits == 0)
+      return 0;
+
+    uint64_t const first = bitPos / CHAR_BIT;
+    uint64_t const last = (bitPos + numBits + CHAR_BIT - 1) / CHAR_BIT;
+    uint64_t value = 0;
+    for (uint64_t i = first; i < last; ++i)
+      value |= static_cast<uint64_t>(data[i]) << (CHAR_BIT * (i - first));
+    return static_cast<uint32_t>((value >> (bitPos % CHAR_BIT)) & bits::GetFullMask(numBits));
+  }
+
+  bool GetLatLon(uint64_t id, LatLon & ll) const
+  {
+    uint64_t const block = id >> kPackedBlockBits;
+    if (block >= m_numBlocks)
+      return false;
+
+    uint64_t const offset = GetBlockOffset(block);
+    if (offset == GetBlockOffset(block + 1))
+      return false;
+
+    uint8_t const * data = m_dataReader.Data() + offset;
+    uint64_t mask[kPackedMaskWords];
+    memcpy(mask, data, sizeof(mask));
+
+    auto const idx = id & (kPackedBlockSize - 1);
+    auto const word = idx / 64;
+    auto const bit = idx % 64;
+    if ((mask[word] & (uint64_t{1} << bit)) == 0)
+      return false;
+
+    uint64_t rank = bits::PopCount(mask[word] & bits::GetFullMask(static_cast<uint8_t>(bit)));
+    for (size_t i = 0; i < word; ++i)
+      rank += bits::PopCount(mask[i]);
+
+    LatLon minLL;
+    memcpy(&minLL.m_lat, data + sizeof(mask), sizeof(minLL.m_lat));
+    memcpy(&minLL.m_lon, data + sizeof(mask) + sizeof(int32_t), sizeof(minLL.m_lon));
+    uint8_t const latBits = data[sizeof(mask) + 2 * sizeof(int32_t)];
+    uint8_t const lonBits = data[sizeof(mask) + 2 * sizeof(int32_t) + 1];
+
+    uint8_t const * packed = data + kPackedHeaderSize;
+    uint64_t const bitPos = rank * (latBits + lonBits);
+    ll.m_lat = static_cast<int32_t>(
+        minLL.m_lat + static_cast<int64_t>(ReadBits(packed, bitPos, latBits)));
+    ll.m_lon = static_cast<int32_t>(
+        minLL.m_lon + static_cast<int64_t>(ReadBits(packed, bitPos + latBits, lonBits)));
+    return true;
+  }
+
+  MmapReader m_dataReader;
+  uint64_t m_numBlocks = 0;
+  vector<uint64_t> m_groupOffsets;
+  vector<uint16_t> m_blockOffsets;
+};
 }  // namespace
 
 // IndexFileReader ---------------------------------------------------------------------------------
@@ -433,6 +688,8 @@ CreatePointStorageReader(feature::GenerateInfo::NodeStorageType type, string con
     return make_unique<MapFilePointStorageReader>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return make_unique<RawMemPointStorageReader>(name);
+  case feature::GenerateInfo::NodeStorageType::Packed:
+    return make_unique<PackedPointStorageReader>(name);
   }
   UNREACHABLE();
 }
@@ -448,6 +705,8 @@ CreatePointStorageWriter(feature::GenerateInfo::NodeStorageType type, string con
     return make_unique<MapFilePointStorageWriter>(name);
   case feature::GenerateInfo::NodeStorageType::Memory:
     return make_unique<RawMemPointStorageWriter>(name);
+  case feature::GenerateInfo::NodeStorageType::Packed:
+    return make_unique<PackedPointStorageWriter>(name);
   }
   UNREACHABLE();
 }
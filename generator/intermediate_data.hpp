@@ -68,6 +68,8 @@ class PointStorageReaderInterface
 public:
   virtual ~PointStorageReaderInterface() {}
   virtual bool GetPoint(uint64_t id, double & lat, double & lon) const = 0;
+  // Hints that points with |ids| are going to be read soon.
+  virtual void Prefetch(std::vector<uint64_t> const & /* ids */) const {}
 };
 
 class IndexFileReader
@@ -247,6 +249,7 @@ public:
   virtual ~IntermediateDataReaderInterface() = default;
 
   virtual bool GetNode(Key id, double & lat, double & lon) const = 0;
+  virtual void PrefetchNodes(std::vector<Key> const & /* ids */) const {}
   virtual bool GetWay(Key id, WayElement & e) = 0;
   virtual bool GetRelation(Key id, RelationElement & e) = 0;
 
@@ -270,6 +273,8 @@ public:
   {
     return m_nodes.GetPoint(id, lat, lon);
   }
+
+  void PrefetchNodes(std::vector<Key> const & ids) const override { m_nodes.Prefetch(ids); }
   
   bool GetWay(Key id, WayElement & e) override { return m_ways.Read(id, e); }
   bool GetRelation(Key id, RelationElement & e) override { return m_relations.Read(id, e); }
@@ -3,7 +3,10 @@
 #include "coding/buffered_file_writer.hpp"
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/files_container.hpp"
+#include "coding/internal/file_data.hpp"
 #include "coding/reader.hpp"
+#include "coding/varint.hpp"
 #include "coding/write_to_sink.hpp"
 #include "coding/writer.hpp"
 #include "coding/zlib.hpp"
@@ -13,8 +16,11 @@
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <memory>
 #include <vector>
 
 #include "3party/bsdiff-courgette/bsdiff/bsdiff.h"
@@ -27,9 +33,121 @@ enum Version
 {
   // Format Version 0: bsdiff+gzip.
   VERSION_V0 = 0,
-  VERSION_LATEST = VERSION_V0
+  // Format Version 1: a sequence of operations writing the new file from the beginning
+  // to the end. Unchanged sections are copied from the old file, changed ones are patched
+  // with bsdiff+gzip, the rest is stored as is with gzip.
+  VERSION_V1 = 1,
 };
 
+static_assert(VERSION_V0 == static_cast<uint32_t>(generator::mwm_diff::DiffVersion::V0), "");
+static_assert(VERSION_V1 == static_cast<uint32_t>(generator::mwm_diff::DiffVersion::V1), "");
+
+// Operations of the format version 1.
+enum Operation
+{
+  // Old file offset and size: the range of the old file is copied.
+  OPERATION_COPY = 0,
+  // Old file offset and size, new size, deflated patch size and the patch:
+  // the patch is applied to the range of the old file.
+  OPERATION_PATCH = 1,
+  // Size, deflated size and the deflated bytes.
+  OPERATION_RAW = 2,
+};
+
+size_t constexpr kCopyBufferSize = 1 << 20;
+
+using Deflate = coding::ZLib::Deflate;
+using Inflate = coding::ZLib::Inflate;
+using TagInfo = FilesContainerBase::TagInfo;
+
+void WriteDeflated(vector<uint8_t> const & data, FileWriter & writer)
+{
+  vector<uint8_t> deflated;
+  if (!data.empty())
+  {
+    Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+    deflate(data.data(), data.size(), back_inserter(deflated));
+  }
+  WriteVarUint(writer, static_cast<uint64_t>(data.size()));
+  WriteVarUint(writer, static_cast<uint64_t>(deflated.size()));
+  writer.Write(deflated.data(), deflated.size());
+}
+
+bool ReadInflated(ReaderSource<FileReader> & src, vector<uint8_t> & data)
+{
+  auto const size = ReadVarUint<uint64_t>(src);
+  auto const deflatedSize = ReadVarUint<uint64_t>(src);
+  if (deflatedSize > src.Size())
+    return false;
+
+  vector<uint8_t> deflated(base::checked_cast<size_t>(deflatedSize));
+  src.Read(deflated.data(), deflated.size());
+
+  data.clear();
+  if (size == 0)
+    return deflated.empty();
+
+  Inflate inflate(Inflate::Format::ZLib);
+  return inflate(deflated.data(), deflated.size(), back_inserter(data)) && data.size() == size;
+}
+
+// Returns false if the file is not a files container.
+bool ReadSections(FileReader const & reader, vector<TagInfo> & sections)
+{
+  sections.clear();
+  try
+  {
+    FilesContainerR const container(make_unique<FileReader>(reader));
+    container.ForEachTagInfo([&sections](TagInfo const & info) {
+      if (info.m_size != 0)
+        sections.push_back(info);
+    });
+  }
+  catch (Reader::Exception const &)
+  {
+    return false;
+  }
+
+  sort(sections.begin(), sections.end(),
+       [](TagInfo const & lhs, TagInfo const & rhs) { return lhs.m_offset < rhs.m_offset; });
+
+  uint64_t end = 0;
+  for (auto const & section : sections)
+  {
+    if (section.m_offset < end || section.m_offset + section.m_size > reader.Size())
+      return false;
+    end = section.m_offset + section.m_size;
+  }
+  return true;
+}
+
+bool IsEqualRanges(FileReader const & reader1, uint64_t offset1, FileReader const & reader2,
+                   uint64_t offset2, uint64_t size)
+{
+  vector<uint8_t> buf1(static_cast<size_t>(min<uint64_t>(size, kCopyBufferSize)));
+  vector<uint8_t> buf2(buf1.size());
+  for (uint64_t pos = 0; pos < size; pos += buf1.size())
+  {
+    auto const n = static_cast<size_t>(min<uint64_t>(size - pos, buf1.size()));
+    reader1.Read(offset1 + pos, buf1.data(), n);
+    reader2.Read(offset2 + pos, buf2.data(), n);
+    if (memcmp(buf1.data(), buf2.data(), n) != 0)
+      return false;
+  }
+  return true;
+}
+
+void WriteRaw(FileReader const & newReader, uint64_t offset, uint64_t size, FileWriter & writer)
+{
+  if (size == 0)
+    return;
+
+  vector<uint8_t> data(base::checked_cast<size_t>(size));
+  newReader.Read(offset, data.data(), data.size());
+  WriteToSink(writer, static_cast<uint8_t>(OPERATION_RAW));
+  WriteDeflated(data, writer);
+}
+
 bool MakeDiffVersion0(FileReader & oldReader, FileReader & newReader, FileWriter & diffFileWriter)
 {
   vector<uint8_t> diffBuf;
@@ -93,13 +211,171 @@ generator::mwm_diff::DiffApplicationResult ApplyDiffVersion0(
   LOG(LERROR, ("Could not apply patch with bsdiff:", status));
   return DiffApplicationResult::Failed;
 }
+
+bool MakeDiffVersion1(FileReader & oldReader, FileReader & newReader,
+                      vector<TagInfo> const & oldSections, vector<TagInfo> const & newSections,
+                      FileWriter & diffFileWriter)
+{
+  WriteToSink(diffFileWriter, static_cast<uint32_t>(VERSION_V1));
+  WriteVarUint(diffFileWriter, newReader.Size());
+
+  // A single copy of the whole file lets the new file be linked to the old one.
+  if (oldReader.Size() == newReader.Size() &&
+      IsEqualRanges(oldReader, 0, newReader, 0, newReader.Size()))
+  {
+    WriteToSink(diffFileWriter, static_cast<uint8_t>(OPERATION_COPY));
+    WriteVarUint(diffFileWriter, uint64_t{0});
+    WriteVarUint(diffFileWriter, newReader.Size());
+    return true;
+  }
+
+  uint64_t pos = 0;
+  for (auto const & section : newSections)
+  {
+    // The header, the alignment and anything else between the sections.
+    WriteRaw(newReader, pos, section.m_offset - pos, diffFileWriter);
+    pos = section.m_offset + section.m_size;
+
+    auto const it = find_if(oldSections.begin(), oldSections.end(),
+                            [&section](TagInfo const & info) { return info.m_tag == section.m_tag; });
+    if (it == oldSections.end())
+    {
+      WriteRaw(newReader, section.m_offset, section.m_size, diffFileWriter);
+      continue;
+    }
+
+    if (it->m_size == section.m_size &&
+        IsEqualRanges(oldReader, it->m_offset, newReader, section.m_offset, section.m_size))
+    {
+      WriteToSink(diffFileWriter, static_cast<uint8_t>(OPERATION_COPY));
+      WriteVarUint(diffFileWriter, it->m_offset);
+      WriteVarUint(diffFileWriter, it->m_size);
+      continue;
+    }
+
+    FileReader oldSectionReader = oldReader.SubReader(it->m_offset, it->m_size);
+    FileReader newSectionReader = newReader.SubReader(section.m_offset, section.m_size);
+    vector<uint8_t> patch;
+    MemWriter<vector<uint8_t>> patchWriter(patch);
+    auto const status = bsdiff::CreateBinaryPatch(oldSectionReader, newSectionReader, patchWriter);
+    if (status != bsdiff::BSDiffStatus::OK)
+    {
+      LOG(LERROR, ("Could not create patch with bsdiff for section", section.m_tag, ":", status));
+      return false;
+    }
+
+    WriteToSink(diffFileWriter, static_cast<uint8_t>(OPERATION_PATCH));
+    WriteVarUint(diffFileWriter, it->m_offset);
+    WriteVarUint(diffFileWriter, it->m_size);
+    WriteDeflated(patch, diffFileWriter);
+  }
+  WriteRaw(newReader, pos, newReader.Size() - pos, diffFileWriter);
+
+  return true;
+}
+
+// Writes the new file operation by operation, so only one changed section is kept in memory.
+// When the new file is the same as the old one, it's hard linked instead of written.
+generator::mwm_diff::DiffApplicationResult ApplyDiffVersion1(
+    string const & oldMwmPath, string const & newMwmPath,
+    ReaderSource<FileReader> & diffFileSource, base::Cancellable const & cancellable)
+{
+  using generator::mwm_diff::DiffApplicationResult;
+
+  FileReader oldReader(oldMwmPath);
+  auto const newSize = ReadVarUint<uint64_t>(diffFileSource);
+
+  if (diffFileSource.Size() > 0 && newSize == oldReader.Size())
+  {
+    ReaderSource<FileReader> src = diffFileSource;
+    if (ReadPrimitiveFromSource<uint8_t>(src) == OPERATION_COPY &&
+        ReadVarUint<uint64_t>(src) == 0 && ReadVarUint<uint64_t>(src) == newSize &&
+        src.Size() == 0 && base::HardLinkFileX(oldMwmPath, newMwmPath))
+    {
+      return DiffApplicationResult::Ok;
+    }
+  }
+
+  BufferedFileWriter newWriter(newMwmPath);
+  vector<uint8_t> buffer;
+  while (diffFileSource.Size() > 0)
+  {
+    if (cancellable.IsCancelled())
+      return DiffApplicationResult::Cancelled;
+
+    auto const operation = ReadPrimitiveFromSource<uint8_t>(diffFileSource);
+    switch (operation)
+    {
+    case OPERATION_COPY:
+    {
+      auto const offset = ReadVarUint<uint64_t>(diffFileSource);
+      auto const size = ReadVarUint<uint64_t>(diffFileSource);
+      // Throws on the out of bounds ranges.
+      FileReader const oldSectionReader = oldReader.SubReader(offset, size);
+      buffer.resize(kCopyBufferSize);
+      for (uint64_t pos = 0; pos < size; pos += buffer.size())
+      {
+        auto const n = static_cast<size_t>(min<uint64_t>(size - pos, buffer.size()));
+        oldSectionReader.Read(pos, buffer.data(), n);
+        newWriter.Write(buffer.data(), n);
+      }
+      break;
+    }
+    case OPERATION_PATCH:
+    {
+      auto const offset = ReadVarUint<uint64_t>(diffFileSource);
+      auto const size = ReadVarUint<uint64_t>(diffFileSource);
+      FileReader oldSectionReader = oldReader.SubReader(offset, size);
+      if (!ReadInflated(diffFileSource, buffer))
+      {
+        LOG(LERROR, ("Could not inflate a section patch"));
+        return DiffApplicationResult::Failed;
+      }
+
+      // See the comment in ApplyDiffVersion0 about the readers.
+      MemReaderWithExceptions patchReader(buffer.data(), buffer.size());
+      auto const status =
+          bsdiff::ApplyBinaryPatch(oldSectionReader, newWriter, patchReader, cancellable);
+      if (status == bsdiff::BSDiffStatus::CANCELLED)
+        return DiffApplicationResult::Cancelled;
+      if (status != bsdiff::BSDiffStatus::OK)
+      {
+        LOG(LERROR, ("Could not apply patch with bsdiff:", status));
+        return DiffApplicationResult::Failed;
+      }
+      break;
+    }
+    case OPERATION_RAW:
+    {
+      if (!ReadInflated(diffFileSource, buffer))
+      {
+        LOG(LERROR, ("Could not inflate raw bytes"));
+        return DiffApplicationResult::Failed;
+      }
+      newWriter.Write(buffer.data(), buffer.size());
+      break;
+    }
+    default:
+      LOG(LERROR, ("Unknown diff operation:", operation));
+      return DiffApplicationResult::Failed;
+    }
+  }
+
+  if (newWriter.Size() != newSize)
+  {
+    LOG(LERROR, ("Wrong size of the patched file:", newWriter.Size(), "expected:", newSize));
+    return DiffApplicationResult::Failed;
+  }
+  return DiffApplicationResult::Ok;
+}
 }  // namespace
 
 namespace generator
 {
 namespace mwm_diff
 {
-bool MakeDiff(string const & oldMwmPath, string const & newMwmPath, string const & diffPath)
+bool MakeDiff(string const & oldMwmPath, string const & newMwmPath, string const & diffPath,
+              DiffVersion version)
 {
   try
   {
@@ -107,13 +383,22 @@ bool MakeDiff(string const & oldMwmPath, string const & newMwmPath, string const
     FileReader newReader(newMwmPath);
     FileWriter diffFileWriter(diffPath);
 
-    switch (VERSION_LATEST)
+    switch (version)
     {
-    case VERSION_V0: return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
-    default:
-      LOG(LERROR,
-          ("Making mwm diffs with diff format version", VERSION_LATEST, "is not implemented"));
+    case DiffVersion::V0: return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+    case DiffVersion::V1:
+    {
+      vector<FilesContainerBase::TagInfo> oldSections;
+      vector<FilesContainerBase::TagInfo> newSections;
+      if (ReadSections(oldReader, oldSections) && ReadSections(newReader, newSections))
+        return MakeDiffVersion1(oldReader, newReader, oldSections, newSections, diffFileWriter);
+
+      LOG(LINFO, ("Not a files container, making a whole file diff"));
+      return MakeDiffVersion0(oldReader, newReader, diffFileWriter);
+    }
     }
+    LOG(LERROR, ("Making mwm diffs with diff format version", static_cast<uint32_t>(version),
+                 "is not implemented"));
   }
   catch (Reader::Exception const & e)
   {
@@ -134,8 +419,6 @@ DiffApplicationResult ApplyDiff(string const & oldMwmPath, string const & newMwm
 {
   try
   {
-    FileReader oldReader(oldMwmPath);
-    BufferedFileWriter newWriter(newMwmPath);
     FileReader diffFileReader(diffPath);
 
     ReaderSource<FileReader> diffFileSource(diffFileReader);
@@ -144,7 +427,13 @@ DiffApplicationResult ApplyDiff(string const & oldMwmPath, string const & newMwm
     switch (version)
     {
     case VERSION_V0:
+    {
+      FileReader oldReader(oldMwmPath);
+      BufferedFileWriter newWriter(newMwmPath);
       return ApplyDiffVersion0(oldReader, newWriter, diffFileSource, cancellable);
+    }
+    case VERSION_V1:
+      return ApplyDiffVersion1(oldMwmPath, newMwmPath, diffFileSource, cancellable);
     default:
       LOG(LERROR, ("Unknown version format of mwm diff:", version));
       return DiffApplicationResult::Failed;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace base
@@ -18,12 +19,21 @@ enum class DiffApplicationResult
   Cancelled,
 };
 
+enum class DiffVersion : uint32_t
+{
+  // bsdiff+gzip of the whole file.
+  V0 = 0,
+  // Patches of the changed sections only. It can't be applied by the clients released
+  // before it, so it's made on request only.
+  V1 = 1,
+};
+
 // Makes a diff that, when applied to the mwm at |oldMwmPath|, will
 // result in the mwm at |newMwmPath|. The diff is stored at |diffPath|.
 // It is assumed that the files at |oldMwmPath| and |newMwmPath| are valid mwms.
 // Returns true on success and false on failure.
 bool MakeDiff(std::string const & oldMwmPath, std::string const & newMwmPath,
-              std::string const & diffPath);
+              std::string const & diffPath, DiffVersion version = DiffVersion::V0);
 
 // Applies the diff at |diffPath| to the mwm at |oldMwmPath|. The resulting
 // mwm is stored at |newMwmPath|.
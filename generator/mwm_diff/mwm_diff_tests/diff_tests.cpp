@@ -6,6 +6,7 @@
 
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/files_container.hpp"
 #include "coding/internal/file_data.hpp"
 
 #include "base/file_name_utils.hpp"
@@ -92,5 +93,73 @@ UNIT_TEST(IncrementalUpdates_Smoke)
   TEST_EQUAL(ApplyDiff(oldMwmPath, newMwmPath2, diffPath, cancellable),
              DiffApplicationResult::Failed, ());
 }
+
+UNIT_TEST(IncrementalUpdates_Sections)
+{
+  string const oldPath = base::JoinPath(GetPlatform().WritableDir(), "sections-old.mwm");
+  string const newPath1 = base::JoinPath(GetPlatform().WritableDir(), "sections-new1.mwm");
+  string const newPath2 = base::JoinPath(GetPlatform().WritableDir(), "sections-new2.mwm");
+  string const diffPath = base::JoinPath(GetPlatform().WritableDir(), "sections.mwmdiff");
+
+  SCOPE_GUARD(cleanup, [&] {
+    FileWriter::DeleteFileX(oldPath);
+    FileWriter::DeleteFileX(newPath1);
+    FileWriter::DeleteFileX(newPath2);
+    FileWriter::DeleteFileX(diffPath);
+  });
+
+  auto const makeSection = [](size_t size, uint8_t seed) {
+    vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i)
+      data[i] = static_cast<uint8_t>(i * seed + i / 7);
+    return data;
+  };
+
+  vector<uint8_t> const same = makeSection(100000, 3);
+  vector<uint8_t> changed = makeSection(50000, 5);
+  {
+    FilesContainerW writer(oldPath);
+    writer.Write(makeSection(1000, 11), "removed");
+    writer.Write(same, "same");
+    writer.Write(changed, "changed");
+  }
+
+  for (size_t i = 1000; i < 2000; ++i)
+    changed[i] = static_cast<uint8_t>(i % 13);
+  {
+    FilesContainerW writer(newPath1);
+    writer.Write(changed, "changed");
+    writer.Write(makeSection(777, 17), "added");
+    writer.Write(same, "same");
+  }
+
+  base::Cancellable cancellable;
+  // Version 0 is made by default for the released clients.
+  TEST(MakeDiff(oldPath, newPath1, diffPath), ());
+  TEST_EQUAL(ReadPrimitiveFromPos<uint32_t>(FileReader(diffPath), 0),
+             static_cast<uint32_t>(DiffVersion::V0), ());
+  TEST_EQUAL(ApplyDiff(oldPath, newPath2, diffPath, cancellable), DiffApplicationResult::Ok, ());
+  TEST(base::IsEqualFiles(newPath1, newPath2), ());
+
+  FileWriter::DeleteFileX(newPath2);
+  TEST(MakeDiff(oldPath, newPath1, diffPath, DiffVersion::V1), ());
+  TEST_EQUAL(ReadPrimitiveFromPos<uint32_t>(FileReader(diffPath), 0),
+             static_cast<uint32_t>(DiffVersion::V1), ());
+  TEST_LESS(FileReader(diffPath).Size(), 20000, ());
+  TEST_EQUAL(ApplyDiff(oldPath, newPath2, diffPath, cancellable), DiffApplicationResult::Ok, ());
+  TEST(base::IsEqualFiles(newPath1, newPath2), ());
+
+  // The same file is linked or copied.
+  FileWriter::DeleteFileX(newPath2);
+  TEST(MakeDiff(newPath1, newPath1, diffPath, DiffVersion::V1), ());
+  TEST_EQUAL(ApplyDiff(newPath1, newPath2, diffPath, cancellable), DiffApplicationResult::Ok, ());
+  TEST(base::IsEqualFiles(newPath1, newPath2), ());
+
+  cancellable.Cancel();
+  FileWriter::DeleteFileX(newPath2);
+  TEST(MakeDiff(oldPath, newPath1, diffPath, DiffVersion::V1), ());
+  TEST_EQUAL(ApplyDiff(oldPath, newPath2, diffPath, cancellable),
+             DiffApplicationResult::Cancelled, ());
+}
 }  // namespace mwm_diff
 }  // namespace generator
@@ -24,6 +24,14 @@ using namespace std;
 
 namespace
 {
+// Makes a diff of the format |version|, see generator::mwm_diff::DiffVersion.
+bool MakeDiff(string const & oldMwmPath, string const & newMwmPath, string const & diffPath,
+              uint32_t version)
+{
+  return generator::mwm_diff::MakeDiff(oldMwmPath, newMwmPath, diffPath,
+                                       static_cast<generator::mwm_diff::DiffVersion>(version));
+}
+
 // Applies the diff at |diffPath| to the mwm at |oldMwmPath|. The resulting
 // mwm is stored at |newMwmPath|.
 // It is assumed that the file at |oldMwmPath| is a valid mwm and the file
@@ -54,6 +62,7 @@ BOOST_PYTHON_MODULE(pymwm_diff)
   using namespace boost::python;
   scope().attr("__version__") = PYBINDINGS_VERSION;
 
-  def("make_diff", generator::mwm_diff::MakeDiff);
+  def("make_diff", MakeDiff,
+      (arg("old_mwm_path"), arg("new_mwm_path"), arg("diff_path"), arg("version") = 0));
   def("apply_diff", ApplyDiff);
 }
@@ -34,6 +34,7 @@ OpentableRestaurant::OpentableRestaurant(std::string const & src)
   CLOG(LDEBUG, strings::to_double(rec[FieldIndex(Fields::Longtitude)], m_latLon.m_lon), ());
 
   m_name = rec[FieldIndex(Fields::Name)];
+  m_nameWords = impl::MakeWeightedBagOfWords(m_name);
   m_address = rec[FieldIndex(Fields::Address)];
   m_descUrl = rec[FieldIndex(Fields::DescUrl)];
 }
@@ -38,8 +38,9 @@ MatchStats<OpentableRestaurant> Match(OpentableRestaurant const & r, FeatureBuil
   score.m_linearNormDistanceScore =
       impl::GetLinearNormDistanceScore(distance, OpentableDataset::kDistanceLimitInMeters);
 
+  auto const fbName = fb.GetName(StringUtf8Multilang::kDefaultCode);
   score.m_nameSimilarityScore =
-      impl::GetNameSimilarityScore(r.m_name, fb.GetName(StringUtf8Multilang::kDefaultCode));
+      impl::GetNameSimilarityScore(r.m_nameWords, impl::MakeWeightedBagOfWords(fbName));
 
   return score;
 }
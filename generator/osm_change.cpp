@@ -0,0 +1,259 @@
+#include "generator/osm_change.hpp"
+
+#include "generator/intermediate_elements.hpp"
+#include "generator/osm_xml_source.hpp"
+
+#include "coding/parse_xml.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+namespace generator
+{
+namespace
+{
+// Parses osmChange XML. Actions are the children of the root tag and OSM objects are grandchildren,
+// so everything below an action is parsed by XMLSource as a usual OSM XML.
+class OsmChangeXMLSource
+{
+public:
+  using Emitter = function<void(OsmChange::Action, OsmElement *)>;
+
+  explicit OsmChangeXMLSource(Emitter const & fn)
+    : m_emitter(fn)
+    , m_elementSource([this](OsmElement * element) {
+      if (m_action)
+        m_emitter(*m_action, element);
+    })
+  {
+  }
+
+  void CharData(string const &) {}
+
+  void AddAttr(string const & key, string const & value)
+  {
+    if (m_depth > 1)
+      m_elementSource.AddAttr(key, value);
+  }
+
+  bool Push(string const & tagName)
+  {
+    if (++m_depth == 1)
+      return true;
+
+    if (m_depth == 2)
+    {
+      m_action = GetAction(tagName);
+      if (!m_action)
+        LOG(LWARNING, ("Unknown osmChange action:", tagName));
+    }
+    return m_elementSource.Push(tagName);
+  }
+
+  void Pop(string const & v)
+  {
+    if (m_depth-- > 1)
+      m_elementSource.Pop(v);
+  }
+
+private:
+  static optional<OsmChange::Action> GetAction(string const & tagName)
+  {
+    if (tagName == "create")
+      return OsmChange::Action::Create;
+    if (tagName == "modify")
+      return OsmChange::Action::Modify;
+    if (tagName == "delete")
+      return OsmChange::Action::Delete;
+    return {};
+  }
+
+  Emitter m_emitter;
+  XMLSource m_elementSource;
+  optional<OsmChange::Action> m_action;
+  size_t m_depth = 0;
+};
+
+class AffectedCountriesFinder
+{
+public:
+  AffectedCountriesFinder(cache::IntermediateDataReaderInterface & cache,
+                          feature::AffiliationInterface const & affiliation)
+    : m_cache(cache), m_affiliation(affiliation)
+  {
+  }
+
+  vector<string> Find(OsmChange const & change)
+  {
+    for (auto const & entry : change.m_entries)
+    {
+      auto const & element = entry.m_element;
+      if (element.IsNode() && entry.m_action != OsmChange::Action::Delete)
+        m_newNodes[element.m_id] = mercator::FromLatLon(element.m_lat, element.m_lon);
+    }
+
+    for (auto const & entry : change.m_entries)
+    {
+      auto const & element = entry.m_element;
+      bool const deleted = entry.m_action == OsmChange::Action::Delete;
+      switch (element.m_type)
+      {
+      case OsmElement::EntityType::Node: AddNode(element.m_id); break;
+      case OsmElement::EntityType::Way:
+        if (!deleted)
+        {
+          for (auto const id : element.Nodes())
+            AddNode(id);
+        }
+        AddCachedWay(element.m_id);
+        break;
+      case OsmElement::EntityType::Relation:
+        if (!deleted)
+        {
+          for (auto const & member : element.Members())
+          {
+            if (member.m_type == OsmElement::EntityType::Node)
+              AddNode(member.m_ref);
+            else if (member.m_type == OsmElement::EntityType::Way)
+              AddCachedWay(member.m_ref);
+          }
+        }
+        AddCachedRelation(element.m_id);
+        break;
+      default: break;
+      }
+    }
+
+    return {m_countries.cbegin(), m_countries.cend()};
+  }
+
+private:
+  void AddPoint(m2::PointD const & point)
+  {
+    for (auto & country : m_affiliation.GetAffiliations(point))
+      m_countries.emplace(move(country));
+  }
+
+  // Adds both the new and the old positions of the node.
+  void AddNode(uint64_t id)
+  {
+    if (!m_nodes.emplace(id).second)
+      return;
+
+    auto const it = m_newNodes.find(id);
+    if (it != m_newNodes.cend())
+      AddPoint(it->second);
+
+    // Nodes are stored in the cache as (y, x).
+    double y = 0.0;
+    double x = 0.0;
+    if (m_cache.GetNode(id, y, x))
+      AddPoint({x, y});
+  }
+
+  void AddCachedWay(uint64_t id)
+  {
+    if (!m_ways.emplace(id).second)
+      return;
+
+    WayElement way(id);
+    if (!m_cache.GetWay(id, way))
+      return;
+
+    for (auto const nodeId : way.m_nodes)
+      AddNode(nodeId);
+  }
+
+  // Relation members which are relations are not taken: changes of super-relations such as
+  // routes networks do not change geometry of their features.
+  void AddCachedRelation(uint64_t id)
+  {
+    RelationElement relation;
+    if (!m_cache.GetRelation(id, relation))
+      return;
+
+    for (auto const & member : relation.m_nodes)
+      AddNode(member.first);
+    for (auto const & member : relation.m_ways)
+      AddCachedWay(member.first);
+  }
+
+  cache::IntermediateDataReaderInterface & m_cache;
+  feature::AffiliationInterface const & m_affiliation;
+  unordered_map<uint64_t, m2::PointD> m_newNodes;
+  unordered_set<uint64_t> m_nodes;
+  unordered_set<uint64_t> m_ways;
+  set<string> m_countries;
+};
+}  // namespace
+
+string DebugPrint(OsmChange::Action action)
+{
+  switch (action)
+  {
+  case OsmChange::Action::Create: return "Create";
+  case OsmChange::Action::Modify: return "Modify";
+  case OsmChange::Action::Delete: return "Delete";
+  }
+  UNREACHABLE();
+}
+
+OsmChange ReadOsmChange(SourceReader & stream)
+{
+  OsmChange change;
+  OsmChangeXMLSource source([&change](OsmChange::Action action, OsmElement * element) {
+    change.m_entries.push_back({action, *element});
+  });
+
+  XMLSequenceParser<SourceReader, OsmChangeXMLSource> parser(stream, source);
+  while (parser.Read())
+    ;
+
+  return change;
+}
+
+vector<string> GetAffectedCountries(OsmChange const & change,
+                                    cache::IntermediateDataReaderInterface & cache,
+                                    feature::AffiliationInterface const & affiliation)
+{
+  return AffectedCountriesFinder(cache, affiliation).Find(change);
+}
+
+bool GenerateAffectedCountries(feature::GenerateInfo const & info, string const & changeFilename,
+                               string const & outFilename)
+{
+  SourceReader reader(changeFilename);
+  auto const change = ReadOsmChange(reader);
+
+  cache::IntermediateDataObjectsCache objectsCache;
+  cache::IntermediateData intermediateData(objectsCache, info);
+  feature::CountriesFilesIndexAffiliation affiliation(info.m_targetDir,
+                                                      info.m_haveBordersForWholeWorld);
+  auto const countries = GetAffectedCountries(change, *intermediateData.GetCache(), affiliation);
+
+  ofstream out(outFilename);
+  if (!out.is_open())
+  {
+    LOG(LERROR, ("Can't open file", outFilename));
+    return false;
+  }
+
+  for (auto const & country : countries)
+    out << country << '\n';
+
+  LOG(LINFO, (countries.size(), "countries are touched by", change.m_entries.size(), "changes."));
+  return true;
+}
+}  // namespace generator
@@ -0,0 +1,51 @@
+// See osmChange format definition at https://wiki.openstreetmap.org/wiki/OsmChange
+#pragma once
+
+#include "generator/affiliation.hpp"
+#include "generator/generate_info.hpp"
+#include "generator/intermediate_data.hpp"
+#include "generator/osm_element.hpp"
+#include "generator/osm_source.hpp"
+
+#include <string>
+#include <vector>
+
+namespace generator
+{
+// Changes of OSM objects of an osmChange file in the file order.
+struct OsmChange
+{
+  enum class Action
+  {
+    Create,
+    Modify,
+    Delete
+  };
+
+  struct Entry
+  {
+    Action m_action;
+    OsmElement m_element;
+  };
+
+  std::vector<Entry> m_entries;
+};
+
+std::string DebugPrint(OsmChange::Action action);
+
+OsmChange ReadOsmChange(SourceReader & stream);
+
+// Returns sorted names of countries whose features may be changed by |change|. Both new and old
+// geometry of the changed objects is taken into account: the old geometry and the geometry of
+// unchanged members of changed ways and relations are taken from |cache| of the previous build.
+std::vector<std::string> GetAffectedCountries(OsmChange const & change,
+                                              cache::IntermediateDataReaderInterface & cache,
+                                              feature::AffiliationInterface const & affiliation);
+
+// Writes countries touched by the osmChange file |changeFilename| to |outFilename|, one per line.
+// Only these countries need to be regenerated from the updated planet, so the intermediate data
+// of the previous build should be kept until this function is called.
+bool GenerateAffectedCountries(feature::GenerateInfo const & info,
+                               std::string const & changeFilename,
+                               std::string const & outFilename);
+}  // namespace generator
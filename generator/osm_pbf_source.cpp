@@ -0,0 +1,507 @@
+#include "generator/osm_pbf_source.hpp"
+
+#include "coding/zlib.hpp"
+
+#include "base/bits.hpp"
+#include "base/checked_cast.hpp"
+
+#include <iterator>
+#include <utility>
+
+using namespace std;
+
+namespace osm
+{
+namespace
+{
+// Maximal sizes of BlobHeader and Blob by the format specification.
+uint32_t constexpr kMaxBlobHeaderSize = 64 * 1024;
+uint32_t constexpr kMaxBlobSize = 32 * 1024 * 1024;
+
+// Wire types of protobuf.
+uint8_t constexpr kVarint = 0;
+uint8_t constexpr kFixed64 = 1;
+uint8_t constexpr kLengthDelimited = 2;
+uint8_t constexpr kFixed32 = 5;
+
+// Reader of serialized protobuf messages. Only the messages of the pbf format are read,
+// so fields are processed in a loop over Next() without any generated code.
+class ProtoReader
+{
+public:
+  ProtoReader(uint8_t const * data, size_t size) : m_pos(data), m_end(data + size) {}
+  explicit ProtoReader(vector<uint8_t> const & data) : ProtoReader(data.data(), data.size()) {}
+
+  // Reads the key of the next field. Returns false at the end of the message.
+  bool Next()
+  {
+    if (m_pos == m_end)
+      return false;
+
+    auto const key = ReadVarint();
+    m_field = static_cast<uint32_t>(key >> 3);
+    m_wireType = static_cast<uint8_t>(key & 0x7);
+    return true;
+  }
+
+  uint32_t Field() const { return m_field; }
+
+  uint64_t ReadUint() { return ReadVarint(); }
+  int64_t ReadInt() { return static_cast<int64_t>(ReadVarint()); }
+  int64_t ReadSint() { return bits::ZigZagDecode(ReadVarint()); }
+
+  ProtoReader ReadMessage()
+  {
+    auto const size = ReadLength();
+    ProtoReader reader(m_pos, size);
+    m_pos += size;
+    return reader;
+  }
+
+  string ReadString()
+  {
+    auto const size = ReadLength();
+    string s(reinterpret_cast<char const *>(m_pos), size);
+    m_pos += size;
+    return s;
+  }
+
+  pair<uint8_t const *, size_t> ReadBytes()
+  {
+    auto const size = ReadLength();
+    auto const data = m_pos;
+    m_pos += size;
+    return {data, size};
+  }
+
+  // Calls |fn| for every varint of a packed repeated field. Not packed values are supported too.
+  template <typename Fn>
+  void ForEachPacked(Fn && fn)
+  {
+    if (m_wireType == kVarint)
+    {
+      fn(ReadVarint());
+      return;
+    }
+
+    auto packed = ReadMessage();
+    while (packed.m_pos != packed.m_end)
+      fn(packed.ReadVarint());
+  }
+
+  void Skip()
+  {
+    switch (m_wireType)
+    {
+    case kVarint: ReadVarint(); return;
+    case kFixed64: Advance(sizeof(uint64_t)); return;
+    case kLengthDelimited: Advance(ReadLength()); return;
+    case kFixed32: Advance(sizeof(uint32_t)); return;
+    }
+    MYTHROW(PbfException, ("Unsupported wire type", m_wireType, "of field", m_field));
+  }
+
+private:
+  uint64_t ReadVarint()
+  {
+    uint64_t value = 0;
+    for (uint8_t shift = 0; shift < 64; shift += 7)
+    {
+      if (m_pos == m_end)
+        MYTHROW(PbfException, ("Truncated varint."));
+
+      uint8_t const byte = *m_pos++;
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return value;
+    }
+    MYTHROW(PbfException, ("Too long varint."));
+  }
+
+  size_t ReadLength()
+  {
+    if (m_wireType != kLengthDelimited)
+      MYTHROW(PbfException, ("Field", m_field, "is not length delimited."));
+    auto const size = ReadVarint();
+    if (size > static_cast<uint64_t>(m_end - m_pos))
+      MYTHROW(PbfException, ("Truncated field", m_field));
+    return static_cast<size_t>(size);
+  }
+
+  void Advance(size_t size)
+  {
+    if (size > static_cast<size_t>(m_end - m_pos))
+      MYTHROW(PbfException, ("Truncated field", m_field));
+    m_pos += size;
+  }
+
+  uint8_t const * m_pos;
+  uint8_t const * m_end;
+  uint32_t m_field = 0;
+  uint8_t m_wireType = kVarint;
+};
+
+// Unpacks Blob message.
+vector<uint8_t> ReadBlobData(vector<uint8_t> const & blob)
+{
+  vector<uint8_t> data;
+  uint64_t rawSize = 0;
+  pair<uint8_t const *, size_t> zlibData = {nullptr, 0};
+
+  ProtoReader reader(blob);
+  while (reader.Next())
+  {
+    switch (reader.Field())
+    {
+    case 1:
+    {
+      auto const raw = reader.ReadBytes();
+      data.assign(raw.first, raw.first + raw.second);
+      return data;
+    }
+    case 2: rawSize = reader.ReadUint(); break;
+    case 3: zlibData = reader.ReadBytes(); break;
+    case 4:
+    case 5:
+    case 6:
+    case 7: MYTHROW(PbfException, ("Unsupported blob compression, field", reader.Field()));
+    default: reader.Skip(); break;
+    }
+  }
+
+  if (zlibData.first == nullptr)
+    MYTHROW(PbfException, ("Blob has no data."));
+  if (rawSize > kMaxBlobSize)
+    MYTHROW(PbfException, ("Too big blob:", rawSize));
+
+  data.reserve(static_cast<size_t>(rawSize));
+  coding::ZLib::Inflate inflate(coding::ZLib::Inflate::Format::ZLib);
+  if (!inflate(zlibData.first, zlibData.second, back_inserter(data)))
+    MYTHROW(PbfException, ("Can't inflate blob."));
+  if (data.size() != rawSize)
+    MYTHROW(PbfException, ("Wrong size of inflated blob:", data.size(), "expected:", rawSize));
+  return data;
+}
+
+OsmElement::EntityType GetMemberType(uint64_t type)
+{
+  switch (type)
+  {
+  case 0: return OsmElement::EntityType::Node;
+  case 1: return OsmElement::EntityType::Way;
+  case 2: return OsmElement::EntityType::Relation;
+  }
+  return OsmElement::EntityType::Unknown;
+}
+
+class PrimitiveBlockDecoder
+{
+public:
+  explicit PrimitiveBlockDecoder(vector<OsmElement> & elements) : m_elements(elements) {}
+
+  void Decode(vector<uint8_t> const & data)
+  {
+    vector<pair<uint8_t const *, size_t>> groups;
+
+    ProtoReader reader(data);
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: ReadStringTable(reader.ReadMessage()); break;
+      case 2: groups.push_back(reader.ReadBytes()); break;
+      case 17: m_granularity = reader.ReadInt(); break;
+      case 19: m_latOffset = reader.ReadInt(); break;
+      case 20: m_lonOffset = reader.ReadInt(); break;
+      default: reader.Skip(); break;
+      }
+    }
+
+    // Groups are decoded after the whole block is read because the string table and coordinates
+    // parameters may follow them.
+    for (auto const & group : groups)
+      DecodeGroup(ProtoReader(group.first, group.second));
+  }
+
+private:
+  void ReadStringTable(ProtoReader reader)
+  {
+    while (reader.Next())
+    {
+      if (reader.Field() == 1)
+        m_strings.push_back(reader.ReadString());
+      else
+        reader.Skip();
+    }
+  }
+
+  string const & GetString(uint64_t index) const
+  {
+    if (index >= m_strings.size())
+      MYTHROW(PbfException, ("String index", index, "is out of the table of", m_strings.size()));
+    return m_strings[static_cast<size_t>(index)];
+  }
+
+  double GetLat(int64_t lat) const { return 1e-9 * (m_latOffset + m_granularity * lat); }
+  double GetLon(int64_t lon) const { return 1e-9 * (m_lonOffset + m_granularity * lon); }
+
+  void AddTags(vector<uint64_t> const & keys, vector<uint64_t> const & values,
+               OsmElement & element) const
+  {
+    if (keys.size() != values.size())
+      MYTHROW(PbfException, ("Different numbers of keys and values of", element.m_id));
+    for (size_t i = 0; i < keys.size(); ++i)
+      element.AddTag(GetString(keys[i]), GetString(values[i]));
+  }
+
+  void DecodeGroup(ProtoReader reader)
+  {
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: DecodeNode(reader.ReadMessage()); break;
+      case 2: DecodeDenseNodes(reader.ReadMessage()); break;
+      case 3: DecodeWay(reader.ReadMessage()); break;
+      case 4: DecodeRelation(reader.ReadMessage()); break;
+      default: reader.Skip(); break;
+      }
+    }
+  }
+
+  void DecodeNode(ProtoReader reader)
+  {
+    OsmElement element;
+    element.m_type = OsmElement::EntityType::Node;
+    vector<uint64_t> keys;
+    vector<uint64_t> values;
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: element.m_id = static_cast<uint64_t>(reader.ReadSint()); break;
+      case 2: reader.ForEachPacked([&](uint64_t v) { keys.push_back(v); }); break;
+      case 3: reader.ForEachPacked([&](uint64_t v) { values.push_back(v); }); break;
+      case 8: element.m_lat = GetLat(reader.ReadSint()); break;
+      case 9: element.m_lon = GetLon(reader.ReadSint()); break;
+      default: reader.Skip(); break;
+      }
+    }
+    AddTags(keys, values, element);
+    m_elements.push_back(move(element));
+  }
+
+  void DecodeDenseNodes(ProtoReader reader)
+  {
+    vector<int64_t> ids;
+    vector<int64_t> lats;
+    vector<int64_t> lons;
+    vector<uint64_t> keysValues;
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1:
+        reader.ForEachPacked([&](uint64_t v) { ids.push_back(bits::ZigZagDecode(v)); });
+        break;
+      case 8:
+        reader.ForEachPacked([&](uint64_t v) { lats.push_back(bits::ZigZagDecode(v)); });
+        break;
+      case 9:
+        reader.ForEachPacked([&](uint64_t v) { lons.push_back(bits::ZigZagDecode(v)); });
+        break;
+      case 10: reader.ForEachPacked([&](uint64_t v) { keysValues.push_back(v); }); break;
+      default: reader.Skip(); break;
+      }
+    }
+
+    if (ids.size() != lats.size() || ids.size() != lons.size())
+      MYTHROW(PbfException, ("Inconsistent dense nodes."));
+
+    // Ids and coordinates are delta coded. Tags of every node are key and value string indices
+    // terminated by zero.
+    int64_t id = 0;
+    int64_t lat = 0;
+    int64_t lon = 0;
+    size_t kv = 0;
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      id += ids[i];
+      lat += lats[i];
+      lon += lons[i];
+
+      OsmElement element;
+      element.m_type = OsmElement::EntityType::Node;
+      element.m_id = static_cast<uint64_t>(id);
+      element.m_lat = GetLat(lat);
+      element.m_lon = GetLon(lon);
+
+      while (kv < keysValues.size() && keysValues[kv] != 0)
+      {
+        if (kv + 1 == keysValues.size())
+          MYTHROW(PbfException, ("Key without a value of node", element.m_id));
+        element.AddTag(GetString(keysValues[kv]), GetString(keysValues[kv + 1]));
+        kv += 2;
+      }
+      // Skip the delimiter.
+      ++kv;
+
+      m_elements.push_back(move(element));
+    }
+  }
+
+  void DecodeWay(ProtoReader reader)
+  {
+    OsmElement element;
+    element.m_type = OsmElement::EntityType::Way;
+    vector<uint64_t> keys;
+    vector<uint64_t> values;
+    int64_t ref = 0;
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: element.m_id = reader.ReadUint(); break;
+      case 2: reader.ForEachPacked([&](uint64_t v) { keys.push_back(v); }); break;
+      case 3: reader.ForEachPacked([&](uint64_t v) { values.push_back(v); }); break;
+      case 8:
+        reader.ForEachPacked([&](uint64_t v) {
+          ref += bits::ZigZagDecode(v);
+          element.AddNd(static_cast<uint64_t>(ref));
+        });
+        break;
+      default: reader.Skip(); break;
+      }
+    }
+    AddTags(keys, values, element);
+    m_elements.push_back(move(element));
+  }
+
+  void DecodeRelation(ProtoReader reader)
+  {
+    OsmElement element;
+    element.m_type = OsmElement::EntityType::Relation;
+    vector<uint64_t> keys;
+    vector<uint64_t> values;
+    vector<uint64_t> roles;
+    vector<int64_t> refs;
+    vector<uint64_t> types;
+    while (reader.Next())
+    {
+      switch (reader.Field())
+      {
+      case 1: element.m_id = reader.ReadUint(); break;
+      case 2: reader.ForEachPacked([&](uint64_t v) { keys.push_back(v); }); break;
+      case 3: reader.ForEachPacked([&](uint64_t v) { values.push_back(v); }); break;
+      case 8: reader.ForEachPacked([&](uint64_t v) { roles.push_back(v); }); break;
+      case 9:
+        reader.ForEachPacked([&](uint64_t v) { refs.push_back(bits::ZigZagDecode(v)); });
+        break;
+      case 10: reader.ForEachPacked([&](uint64_t v) { types.push_back(v); }); break;
+      default: reader.Skip(); break;
+      }
+    }
+
+    if (roles.size() != refs.size() || roles.size() != types.size())
+      MYTHROW(PbfException, ("Inconsistent members of relation", element.m_id));
+
+    int64_t ref = 0;
+    for (size_t i = 0; i < refs.size(); ++i)
+    {
+      ref += refs[i];
+      element.AddMember(static_cast<uint64_t>(ref), GetMemberType(types[i]), GetString(roles[i]));
+    }
+    AddTags(keys, values, element);
+    m_elements.push_back(move(element));
+  }
+
+  vector<OsmElement> & m_elements;
+  vector<string> m_strings;
+  int64_t m_granularity = 100;
+  int64_t m_latOffset = 0;
+  int64_t m_lonOffset = 0;
+};
+}  // namespace
+
+// PbfBlockReader ----------------------------------------------------------------------------------
+bool PbfBlockReader::Read(Block & block)
+{
+  uint8_t sizeBytes[4];
+  auto const read = ReadBytes(sizeBytes, sizeof(sizeBytes));
+  if (read == 0)
+    return false;
+  if (read != sizeof(sizeBytes))
+    MYTHROW(PbfException, ("Truncated size of blob header."));
+
+  // Size of BlobHeader is stored in network byte order.
+  uint32_t const headerSize = (static_cast<uint32_t>(sizeBytes[0]) << 24) |
+                              (static_cast<uint32_t>(sizeBytes[1]) << 16) |
+                              (static_cast<uint32_t>(sizeBytes[2]) << 8) | sizeBytes[3];
+  if (headerSize > kMaxBlobHeaderSize)
+    MYTHROW(PbfException, ("Too big blob header:", headerSize));
+
+  vector<uint8_t> header(headerSize);
+  if (ReadBytes(header.data(), header.size()) != header.size())
+    MYTHROW(PbfException, ("Truncated blob header."));
+
+  block.m_type.clear();
+  uint64_t blobSize = 0;
+  ProtoReader reader(header);
+  while (reader.Next())
+  {
+    switch (reader.Field())
+    {
+    case 1: block.m_type = reader.ReadString(); break;
+    case 3: blobSize = reader.ReadUint(); break;
+    default: reader.Skip(); break;
+    }
+  }
+
+  if (blobSize > kMaxBlobSize)
+    MYTHROW(PbfException, ("Too big blob:", blobSize));
+
+  block.m_blob.resize(static_cast<size_t>(blobSize));
+  if (ReadBytes(block.m_blob.data(), block.m_blob.size()) != block.m_blob.size())
+    MYTHROW(PbfException, ("Truncated blob."));
+  return true;
+}
+
+size_t PbfBlockReader::ReadBytes(uint8_t * data, size_t size)
+{
+  size_t read = 0;
+  while (read < size)
+  {
+    auto const n = m_reader(data + read, size - read);
+    if (n == 0)
+      break;
+    read += n;
+  }
+  return read;
+}
+
+// Functions ---------------------------------------------------------------------------------------
+void CheckPbfHeader(vector<uint8_t> const & blob)
+{
+  auto const data = ReadBlobData(blob);
+  ProtoReader reader(data);
+  while (reader.Next())
+  {
+    // required_features
+    if (reader.Field() != 4)
+    {
+      reader.Skip();
+      continue;
+    }
+
+    auto const feature = reader.ReadString();
+    if (feature != "OsmSchema-V0.6" && feature != "DenseNodes")
+      MYTHROW(PbfException, ("Unsupported required feature:", feature));
+  }
+}
+
+void DecodePbfData(vector<uint8_t> const & blob, vector<OsmElement> & elements)
+{
+  PrimitiveBlockDecoder decoder(elements);
+  decoder.Decode(ReadBlobData(blob));
+}
+}  // namespace osm
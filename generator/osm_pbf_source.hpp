@@ -0,0 +1,51 @@
+// See PBF Format definition at https://wiki.openstreetmap.org/wiki/PBF_Format
+#pragma once
+
+#include "generator/osm_element.hpp"
+
+#include "base/exception.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace osm
+{
+DECLARE_EXCEPTION(PbfException, RootException);
+
+// Reads file blocks of a pbf stream. Blocks do not depend on each other, so they may be decoded
+// in parallel.
+class PbfBlockReader
+{
+public:
+  using ReadFn = std::function<size_t(uint8_t *, size_t)>;
+
+  struct Block
+  {
+    // Type of the block: "OSMHeader", "OSMData" or an unknown one which should be skipped.
+    std::string m_type;
+    // Serialized Blob message.
+    std::vector<uint8_t> m_blob;
+  };
+
+  explicit PbfBlockReader(ReadFn const & reader) : m_reader(reader) {}
+
+  // Returns false at the end of the stream. Throws PbfException on a truncated block.
+  bool Read(Block & block);
+
+private:
+  // Returns the number of read bytes which is less than |size| only at the end of the stream.
+  size_t ReadBytes(uint8_t * data, size_t size);
+
+  ReadFn m_reader;
+};
+
+// Throws PbfException if the OSMHeader |blob| requires unsupported features.
+void CheckPbfHeader(std::vector<uint8_t> const & blob);
+
+// Decodes the OSMData |blob| and appends its entities to |elements| in the block order.
+// Throws PbfException on malformed data.
+void DecodePbfData(std::vector<uint8_t> const & blob, std::vector<OsmElement> & elements);
+}  // namespace osm
@@ -155,6 +155,27 @@ void ProcessOsmElementsFromO5M(SourceReader & stream, function<void(OsmElement *
   }
 }
 
+void BuildIntermediateDataFromPbf(SourceReader & stream, size_t threadsCount,
+                                  cache::IntermediateDataWriter & cache, TownsDumper & towns)
+{
+  ProcessOsmElementsFromPbf(stream, threadsCount, [&](OsmElement * element) {
+    towns.CheckElement(*element);
+    AddElementToCache(cache, *element);
+  });
+}
+
+void ProcessOsmElementsFromPbf(SourceReader & stream, size_t threadsCount,
+                               function<void(OsmElement *)> processor)
+{
+  ProcessorOsmElementsFromPbf processorOsmElementsFromPbf(stream, threadsCount);
+  OsmElement element;
+  while (processorOsmElementsFromPbf.TryRead(element))
+  {
+    processor(&element);
+    element.Clear();
+  }
+}
+
 ProcessorOsmElementsFromO5M::ProcessorOsmElementsFromO5M(SourceReader & stream)
   : m_stream(stream)
   , m_dataset([&](uint8_t * buffer, size_t size) {
@@ -220,6 +241,64 @@ bool ProcessorOsmElementsFromO5M::TryRead(OsmElement & element)
   return true;
 }
 
+ProcessorOsmElementsFromPbf::ProcessorOsmElementsFromPbf(SourceReader & stream,
+                                                         size_t threadsCount)
+  : m_reader([&stream](uint8_t * buffer, size_t size) {
+      return stream.Read(reinterpret_cast<char *>(buffer), size);
+    })
+  , m_maxBatchesCount(2 * max(threadsCount, size_t{1}))
+  , m_threadPool(max(threadsCount, size_t{1}))
+{
+  SubmitBlocks();
+}
+
+void ProcessorOsmElementsFromPbf::SubmitBlocks()
+{
+  osm::PbfBlockReader::Block block;
+  while (!m_finished && m_batches.size() < m_maxBatchesCount)
+  {
+    if (!m_reader.Read(block))
+    {
+      m_finished = true;
+      break;
+    }
+
+    if (block.m_type == "OSMHeader")
+    {
+      osm::CheckPbfHeader(block.m_blob);
+    }
+    else if (block.m_type == "OSMData")
+    {
+      m_batches.push_back(m_threadPool.Submit([blob{move(block.m_blob)}]() {
+        vector<OsmElement> elements;
+        osm::DecodePbfData(blob, elements);
+        return elements;
+      }));
+    }
+    else
+    {
+      LOG(LWARNING, ("Unknown pbf block type", block.m_type, "is skipped."));
+    }
+  }
+}
+
+bool ProcessorOsmElementsFromPbf::TryRead(OsmElement & element)
+{
+  while (m_currentPos == m_current.size())
+  {
+    if (m_batches.empty())
+      return false;
+
+    m_current = m_batches.front().get();
+    m_batches.pop_front();
+    m_currentPos = 0;
+    SubmitBlocks();
+  }
+
+  element = move(m_current[m_currentPos++]);
+  return true;
+}
+
 ProcessorOsmElementsFromXml::ProcessorOsmElementsFromXml(SourceReader & stream)
   : m_xmlSource([&, this](auto * element) { m_queue.emplace(*element); })
   , m_parser(stream, m_xmlSource)
@@ -250,7 +329,7 @@ bool ProcessorOsmElementsFromXml::TryRead(OsmElement & element)
 // Generate functions implementations.
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool GenerateIntermediateData(feature::GenerateInfo & info)
+bool GenerateIntermediateData(feature::GenerateInfo & info, size_t threadsCount)
 {
   auto nodes =
       cache::CreatePointStorageWriter(info.m_nodeStorageType, info.GetCacheFileName(NODES_FILE));
@@ -268,6 +347,9 @@ bool GenerateIntermediateData(feature::GenerateInfo & info)
   case feature::GenerateInfo::OsmSourceType::O5M:
     BuildIntermediateDataFromO5M(reader, cache, towns);
     break;
+  case feature::GenerateInfo::OsmSourceType::PBF:
+    BuildIntermediateDataFromPbf(reader, threadsCount, cache, towns);
+    break;
   }
 
   cache.SaveIndex();
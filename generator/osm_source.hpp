@@ -3,17 +3,23 @@
 #include "generator/generate_info.hpp"
 #include "generator/intermediate_data.hpp"
 #include "generator/osm_o5m_source.hpp"
+#include "generator/osm_pbf_source.hpp"
 #include "generator/osm_xml_source.hpp"
 #include "generator/translator_interface.hpp"
 
 #include "coding/parse_xml.hpp"
 
+#include "base/thread_pool_computational.hpp"
+
+#include <deque>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <queue>
 #include <sstream>
 #include <string>
+#include <vector>
 
 struct OsmElement;
 class FeatureParams;
@@ -45,9 +51,11 @@ public:
   uint64_t Pos() const { return m_pos; }
 };
 
-bool GenerateIntermediateData(feature::GenerateInfo & info);
+bool GenerateIntermediateData(feature::GenerateInfo & info, size_t threadsCount = 1);
 
 void ProcessOsmElementsFromO5M(SourceReader & stream, std::function<void(OsmElement *)> processor);
+void ProcessOsmElementsFromPbf(SourceReader & stream, size_t threadsCount,
+                               std::function<void(OsmElement *)> processor);
 void ProcessOsmElementsFromXML(SourceReader & stream, std::function<void(OsmElement *)> processor);
 
 class ProcessorOsmElementsInterface
@@ -72,6 +80,30 @@ private:
   osm::O5MSource::Iterator m_pos;
 };
 
+// Reads pbf blocks from |stream| and decodes them on |threadsCount| threads. At most
+// |2 * threadsCount| blocks are decoded or kept in memory at once. Elements are returned
+// in the order of the stream.
+class ProcessorOsmElementsFromPbf : public ProcessorOsmElementsInterface
+{
+public:
+  ProcessorOsmElementsFromPbf(SourceReader & stream, size_t threadsCount);
+
+  // ProcessorOsmElementsInterface overrides:
+  bool TryRead(OsmElement & element) override;
+
+private:
+  void SubmitBlocks();
+
+  osm::PbfBlockReader m_reader;
+  size_t const m_maxBatchesCount;
+  bool m_finished = false;
+  base::thread_pool::computational::ThreadPool m_threadPool;
+  // Decoded elements of the submitted blocks in the order of the stream.
+  std::deque<std::future<std::vector<OsmElement>>> m_batches;
+  std::vector<OsmElement> m_current;
+  size_t m_currentPos = 0;
+};
+
 class ProcessorOsmElementsFromXml : public ProcessorOsmElementsInterface
 {
 public:
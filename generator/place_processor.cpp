@@ -9,6 +9,7 @@
 
 #include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
 #include <iterator>
@@ -94,7 +95,7 @@ bool IsWorsePlace(T const & left, T const & right)
   static_assert(kIsCapitalCoeff >= 0, "");
   static_assert(kIsAreaTooBigCoeff <= 0, "");
 
-  auto const getScore = [&](auto const place) {
+  auto const getScore = [&](auto const & place) {
     auto const rank = place.GetRank();
     auto const langsCount = place.GetMultilangName().CountLangs();
     auto const area = mercator::AreaOnEarth(place.GetLimitRect());
@@ -236,17 +237,41 @@ void PlaceProcessor::FillTable(FeaturePlaces::const_iterator start, FeaturePlace
     m_boundariesTable->Union(lastId, best->GetFb().GetMostGenericOsmId());
 }
 
-std::vector<PlaceProcessor::PlaceWithIds> PlaceProcessor::ProcessPlaces()
+std::vector<PlaceProcessor::PlaceWithIds> PlaceProcessor::ProcessPlaces(size_t threadsCount)
 {
-  std::vector<PlaceWithIds> finalPlaces;
+  std::vector<FeaturePlaces> groups;
+  groups.reserve(m_nameToPlaces.size());
   for (auto & nameToGeoObjectIdToFeaturePlaces : m_nameToPlaces)
   {
-    std::vector<FeaturePlace> places;
+    FeaturePlaces places;
     places.reserve(nameToGeoObjectIdToFeaturePlaces.second.size());
-    for (auto const & geoObjectIdToFeaturePlaces : nameToGeoObjectIdToFeaturePlaces.second)
-      places.emplace_back(geoObjectIdToFeaturePlaces.second);
+    for (auto & geoObjectIdToFeaturePlaces : nameToGeoObjectIdToFeaturePlaces.second)
+      places.emplace_back(std::move(geoObjectIdToFeaturePlaces.second));
+
+    groups.emplace_back(std::move(places));
+  }
+  m_nameToPlaces.clear();
+
+  // Places with different names or types never get into one cluster, so the groups are
+  // clustered in parallel. The results are processed in the order of the groups.
+  std::vector<std::vector<FeaturePlaces>> groupClusters(groups.size());
+  if (threadsCount <= 1)
+  {
+    for (size_t i = 0; i < groups.size(); ++i)
+      groupClusters[i] = FindClusters(std::move(groups[i]));
+  }
+  else
+  {
+    base::thread_pool::computational::ThreadPool pool(threadsCount);
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+      pool.SubmitWork([&, i]() { groupClusters[i] = FindClusters(std::move(groups[i])); });
+    }
+  }
 
-    auto const clusters = FindClusters(std::move(places));
+  std::vector<PlaceWithIds> finalPlaces;
+  for (auto const & clusters : groupClusters)
+  {
     for (auto const & cluster : clusters)
     {
       auto best = std::max_element(std::cbegin(cluster), std::cend(cluster), IsWorsePlace<FeaturePlace>);
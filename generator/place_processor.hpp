@@ -7,6 +7,7 @@
 
 #include "base/geo_object_id.hpp"
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -57,7 +58,9 @@ public:
   PlaceProcessor(std::shared_ptr<OsmIdToBoundariesTable> boundariesTable = {});
 
   void Add(feature::FeatureBuilder const & fb);
-  std::vector<PlaceWithIds> ProcessPlaces();
+  // Unites the added places into clusters and returns the best place of each cluster.
+  // The places are moved out, so the processor is empty after the call.
+  std::vector<PlaceWithIds> ProcessPlaces(size_t threadsCount = 1);
 
 private:
   using FeaturePlaces = std::vector<FeaturePlace>;
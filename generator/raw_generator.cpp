@@ -8,9 +8,11 @@
 #include "generator/osm_source.hpp"
 #include "generator/processor_factory.hpp"
 #include "generator/raw_generator_writer.hpp"
+#include "generator/stages_profiler.hpp"
 #include "generator/translator_factory.hpp"
 #include "generator/translators_pool.hpp"
 
+#include "base/profiler.hpp"
 #include "base/thread_pool_computational.hpp"
 #include "base/timer.hpp"
 
@@ -99,6 +101,7 @@ std::shared_ptr<FeatureProcessorQueue> RawGenerator::GetQueue() { return m_queue
 
 void RawGenerator::GenerateCountries(bool addAds)
 {
+  PROFILER_SCOPE("RawGenerator::GenerateCountries");
   if (!m_genInfo.m_complexHierarchyFilename.empty())
     m_hierarchyNodesSet = GetOrCreateComplexLoader(m_genInfo.m_complexHierarchyFilename).GetIdsSet();
 
@@ -172,7 +175,7 @@ std::vector<std::string> const & RawGenerator::GetNames() const { return m_names
 RawGenerator::FinalProcessorPtr RawGenerator::CreateCoslineFinalProcessor()
 {
   auto finalProcessor = make_shared<CoastlineFinalProcessor>(
-      m_genInfo.GetTmpFileName(WORLD_COASTS_FILE_NAME, DATA_FILE_EXTENSION_TMP));
+      m_genInfo.GetTmpFileName(WORLD_COASTS_FILE_NAME, DATA_FILE_EXTENSION_TMP), m_threadsCount);
   finalProcessor->SetCoastlinesFilenames(
       m_genInfo.GetIntermediateFileName(WORLD_COASTS_FILE_NAME, ".geom"),
       m_genInfo.GetIntermediateFileName(WORLD_COASTS_FILE_NAME, RAW_GEOM_FILE_EXTENSION));
@@ -184,6 +187,7 @@ RawGenerator::FinalProcessorPtr RawGenerator::CreateCountryFinalProcessor(bool a
   auto finalProcessor = make_shared<CountryFinalProcessor>(
       m_genInfo.m_targetDir, m_genInfo.m_tmpDir, m_genInfo.m_intermediateDir,
       m_genInfo.m_haveBordersForWholeWorld, m_threadsCount);
+  finalProcessor->SetMemoryBudget(m_genInfo.m_finalProcessingMemoryBytes);
   finalProcessor->SetIsolinesDir(m_genInfo.m_isolinesDir);
   finalProcessor->SetBooking(m_genInfo.m_bookingDataFilename);
   finalProcessor->SetCitiesAreas(m_genInfo.GetIntermediateFileName(CITIES_AREAS_TMP_FILENAME));
@@ -228,6 +232,9 @@ bool RawGenerator::GenerateFilteredFeatures()
   case feature::GenerateInfo::OsmSourceType::O5M:
     sourceProcessor = std::make_unique<ProcessorOsmElementsFromO5M>(reader);
     break;
+  case feature::GenerateInfo::OsmSourceType::PBF:
+    sourceProcessor = std::make_unique<ProcessorOsmElementsFromPbf>(reader, m_threadsCount);
+    break;
   case feature::GenerateInfo::OsmSourceType::XML:
     sourceProcessor = std::make_unique<ProcessorOsmElementsFromXml>(reader);
     break;
@@ -240,26 +247,30 @@ bool RawGenerator::GenerateFilteredFeatures()
 
   Stats stats(100 * m_threadsCount /* logCallCountThreshold */);
 
-  size_t element_pos = 0;
-  std::vector<OsmElement> elements(m_chunkSize);
-  while (sourceProcessor->TryRead(elements[element_pos]))
   {
-    if (++element_pos != m_chunkSize)
-      continue;
+    StagesProfiler::Scope scope("features/translate");
+    size_t element_pos = 0;
+    std::vector<OsmElement> elements(m_chunkSize);
+    while (sourceProcessor->TryRead(elements[element_pos]))
+    {
+      if (++element_pos != m_chunkSize)
+        continue;
 
-    stats.Log(elements, reader.Pos());
-    translators.Emit(elements);
-    
-    for (auto & e : elements)
-      e.Clear();
+      stats.Log(elements, reader.Pos());
+      translators.Emit(elements);
 
-    element_pos = 0;
+      for (auto & e : elements)
+        e.Clear();
+
+      element_pos = 0;
+    }
+    elements.resize(element_pos);
+    stats.Log(elements, reader.Pos(), true /* forcePrint */);
+    translators.Emit(std::move(elements));
   }
-  elements.resize(element_pos);
-  stats.Log(elements, reader.Pos(), true /* forcePrint */);
-  translators.Emit(std::move(elements));
 
   LOG(LINFO, ("Input was processed."));
+  StagesProfiler::Scope finishScope("features/finish_translators");
   if (!translators.Finish())
     return false;
 
@@ -0,0 +1,241 @@
+#include "generator/routing_cross_mwm_landmarks_generator.hpp"
+
+#include "routing/cross_mwm_connector.hpp"
+#include "routing/cross_mwm_connector_serialization.hpp"
+#include "routing/cross_mwm_landmarks.hpp"
+#include "routing/cross_mwm_transitions.hpp"
+#include "routing/mwm_hierarchy_handler.hpp"
+#include "routing/route_weight.hpp"
+#include "routing/segment.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+#include "routing_common/vehicle_model.hpp"
+
+#include "platform/country_file.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/reader.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/exception.hpp"
+#include "base/file_name_utils.hpp"
+#include "base/geo_object_id.hpp"
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include "defines.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+namespace
+{
+using Connector = CrossMwmConnector<base::GeoObjectId>;
+
+// Fills |connector| with car transitions and weights of |mwmFile|. |hasWeights| is set to false
+// if there are no car weights in the section.
+bool LoadConnector(string const & mwmFile, Connector & connector, bool & hasWeights)
+{
+  hasWeights = false;
+  try
+  {
+    FilesContainerR cont(mwmFile);
+    if (!cont.IsExist(CROSS_MWM_FILE_TAG))
+    {
+      LOG(LWARNING, ("No", CROSS_MWM_FILE_TAG, "section in", mwmFile));
+      return true;
+    }
+
+    {
+      ReaderSource<FilesContainerR::TReader> src(cont.GetReader(CROSS_MWM_FILE_TAG));
+      CrossMwmConnectorSerializer::DeserializeTransitions(VehicleType::Car, connector, src);
+    }
+
+    // Weights are ready to load right after transitions iff they exist.
+    if (!connector.WeightsWereLoaded())
+    {
+      ReaderSource<FilesContainerR::TReader> src(cont.GetReader(CROSS_MWM_FILE_TAG));
+      CrossMwmConnectorSerializer::DeserializeWeights(VehicleType::Car, connector, src);
+      hasWeights = true;
+    }
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error while reading", CROSS_MWM_FILE_TAG, "section of", mwmFile, ":", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+
+// Car transition graph of the mwms. See CrossMwmTransitions for details.
+struct TransitionGraph
+{
+  struct Edge
+  {
+    CrossMwmTransitions::Vertex m_from = 0;
+    CrossMwmTransitions::Vertex m_to = 0;
+    RouteWeight m_weight;
+  };
+
+  vector<CrossMwmTransitions::Transition> m_transitions;
+  vector<Edge> m_edges;
+  // False if there are no car weights in some mwms. Enters of these mwms are not connected
+  // with their exits.
+  bool m_hasAllWeights = true;
+};
+
+bool BuildTransitionGraph(string const & dataDir, vector<string> const & countries,
+                          CountryParentNameGetterFn const & countryParentNameGetterFn,
+                          TransitionGraph & graph)
+{
+  // Transitions refer to the mwms by the index in |countries|, which may differ from NumMwmId.
+  auto numMwmIds = make_shared<NumMwmIds>();
+  unordered_map<NumMwmId, uint32_t> mwmIdToCountryIdx;
+  for (size_t i = 0; i < countries.size(); ++i)
+  {
+    platform::CountryFile const file(countries[i]);
+    numMwmIds->RegisterFile(file);
+    mwmIdToCountryIdx[numMwmIds->GetId(file)] = base::asserted_cast<uint32_t>(i);
+  }
+
+  vector<Connector> connectors;
+  vector<bool> hasWeights(countries.size(), false);
+  connectors.reserve(countries.size());
+  for (size_t i = 0; i < countries.size(); ++i)
+  {
+    connectors.emplace_back(numMwmIds->GetId(platform::CountryFile(countries[i])),
+                            0 /* featureNumerationOffset */);
+    bool weights = false;
+    if (!LoadConnector(base::JoinPath(dataDir, countries[i] + DATA_FILE_EXTENSION),
+                       connectors.back(), weights))
+    {
+      return false;
+    }
+    hasWeights[i] = weights;
+    if (!weights)
+      graph.m_hasAllWeights = false;
+  }
+
+  auto & transitions = graph.m_transitions;
+  unordered_map<Segment, CrossMwmTransitions::Vertex> segmentToVertex;
+  // Mwms which have transitions with the osm id.
+  unordered_map<base::GeoObjectId, vector<NumMwmId>> osmIdToMwms;
+  auto const addVertices = [&](vector<Segment> const & segments, bool isEnter) {
+    for (auto const & segment : segments)
+    {
+      auto const v = base::asserted_cast<CrossMwmTransitions::Vertex>(transitions.size());
+      CHECK(segmentToVertex.emplace(segment, v).second, (segment));
+      transitions.emplace_back(mwmIdToCountryIdx.at(segment.GetMwmId()), segment.GetFeatureId(),
+                               segment.GetSegmentIdx(), segment.IsForward(), isEnter);
+    }
+  };
+
+  for (auto const & connector : connectors)
+  {
+    addVertices(connector.GetEnters(), true /* isEnter */);
+    addVertices(connector.GetExits(), false /* isEnter */);
+
+    for (auto const & exit : connector.GetExits())
+    {
+      auto & mwms = osmIdToMwms[connector.GetCrossMwmId(exit)];
+      if (mwms.empty() || mwms.back() != exit.GetMwmId())
+        mwms.push_back(exit.GetMwmId());
+    }
+    for (auto const & enter : connector.GetEnters())
+    {
+      auto & mwms = osmIdToMwms[connector.GetCrossMwmId(enter)];
+      if (mwms.empty() || mwms.back() != enter.GetMwmId())
+        mwms.push_back(enter.GetMwmId());
+    }
+  }
+
+  MwmHierarchyHandler hierarchyHandler(numMwmIds, countryParentNameGetterFn);
+
+  auto & edges = graph.m_edges;
+  vector<SegmentEdge> leaps;
+  for (size_t i = 0; i < connectors.size(); ++i)
+  {
+    auto const & connector = connectors[i];
+    for (auto const & enter : connector.GetEnters())
+    {
+      if (!hasWeights[i])
+        break;
+
+      auto const from = segmentToVertex.at(enter);
+      leaps.clear();
+      connector.GetOutgoingEdgeList(enter, leaps);
+      for (auto const & leap : leaps)
+        edges.push_back({from, segmentToVertex.at(leap.GetTarget()), leap.GetWeight()});
+    }
+
+    for (auto const & exit : connector.GetExits())
+    {
+      auto const from = segmentToVertex.at(exit);
+      auto const & crossMwmId = connector.GetCrossMwmId(exit);
+      for (auto const mwmId : osmIdToMwms[crossMwmId])
+      {
+        if (mwmId == exit.GetMwmId())
+          continue;
+
+        // See CrossMwmIndexGraph::GetTwinsByCrossMwmId() for details.
+        auto const & twinConnector = connectors[mwmIdToCountryIdx.at(mwmId)];
+        Segment const * twin =
+            twinConnector.GetTransition(crossMwmId, exit.GetSegmentIdx(), true /* isEnter */);
+        if (twin == nullptr || twin->IsForward() != exit.IsForward())
+          continue;
+
+        auto const penalty =
+            hierarchyHandler.GetCrossBorderPenalty(exit.GetMwmId(), twin->GetMwmId());
+        edges.push_back({from, segmentToVertex.at(*twin), penalty});
+      }
+    }
+  }
+
+  LOG(LINFO, ("Transition graph for", countries.size(), "mwms:", transitions.size(), "vertices,",
+              edges.size(), "edges."));
+  return true;
+}
+}  // namespace
+
+bool BuildCrossMwmLandmarks(string const & dataDir, vector<string> const & countries,
+                            string const & worldMwmFile,
+                            CountryParentNameGetterFn const & countryParentNameGetterFn,
+                            uint32_t landmarksCount)
+{
+  base::Timer timer;
+
+  TransitionGraph graph;
+  if (!BuildTransitionGraph(dataDir, countries, countryParentNameGetterFn, graph))
+    return false;
+
+  // Bounds of an mwm without weights are not lower bounds of the routes through it.
+  if (!graph.m_hasAllWeights)
+  {
+    LOG(LERROR, ("Cross mwm weights should be built for all the mwms to build landmarks."));
+    return false;
+  }
+
+  vector<CrossMwmLandmarks::Edge> edges;
+  edges.reserve(graph.m_edges.size());
+  for (auto const & edge : graph.m_edges)
+    edges.emplace_back(edge.m_from, edge.m_to, edge.m_weight.GetWeight());
+
+  auto const landmarks = CrossMwmLandmarks::Build(
+      CrossMwmTransitions(vector<string>(countries), move(graph.m_transitions)), edges,
+      landmarksCount);
+  LOG(LINFO, ("Cross mwm landmarks:", landmarks.GetLandmarks().size(), "Elapsed:",
+              timer.ElapsedSeconds(), "seconds."));
+
+  FilesContainerW cont(worldMwmFile, FileWriter::OP_WRITE_EXISTING);
+  auto writer = cont.GetWriter(CROSS_MWM_LANDMARKS_FILE_TAG);
+  landmarks.Serialize(*writer);
+  return true;
+}
+}  // namespace routing
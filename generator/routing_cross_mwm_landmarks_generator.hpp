@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace routing
+{
+using CountryParentNameGetterFn = std::function<std::string(std::string const &)>;
+
+/// \brief Builds CROSS_MWM_LANDMARKS_FILE_TAG section of |worldMwmFile|: |landmarksCount|
+/// landmarks of the car transition graph of |countries| mwms for the ALT heuristic of leaps.
+/// \note Car weights of CROSS_MWM_FILE_TAG section should be built for all |countries| mwms
+/// located in |dataDir|.
+/// \note There are no landmarks for pedestrians and bicycles: their routes are not built with
+/// leaps and their cross mwm sections have no weights to build the transition graph from.
+bool BuildCrossMwmLandmarks(std::string const & dataDir, std::vector<std::string> const & countries,
+                            std::string const & worldMwmFile,
+                            CountryParentNameGetterFn const & countryParentNameGetterFn,
+                            uint32_t landmarksCount);
+}  // namespace routing
@@ -2,6 +2,7 @@
 
 #include "generator/borders.hpp"
 #include "generator/cross_mwm_osm_ways_collector.hpp"
+#include "generator/cross_mwm_weights_cache.hpp"
 #include "generator/routing_helpers.hpp"
 
 #include "routing/base/astar_algorithm.hpp"
@@ -39,17 +40,24 @@
 #include "base/file_name_utils.hpp"
 #include "base/geo_object_id.hpp"
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
+#include "3party/skarupke/flat_hash_map.hpp"
+
 using namespace feature;
 using namespace platform;
 using namespace std;
@@ -155,7 +163,7 @@ private:
   }
 
   VehicleMaskBuilder const m_maskBuilder;
-  unordered_map<uint64_t, routing::Joint> m_posToJoint;
+  ska::flat_hash_map<uint64_t, routing::Joint> m_posToJoint;
   unordered_map<uint32_t, routing::VehicleMask> m_masks;
 };
 
@@ -519,135 +527,227 @@ void CalcCrossMwmConnectors(
   }
 }
 
+unique_ptr<routing::IndexGraph> LoadIndexGraph(
+    string const & path, string const & mwmFile, string const & country,
+    shared_ptr<routing::VehicleModelInterface> const & vehicleModel)
+{
+  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
+  uint32_t mwmNumRoads = DeserializeIndexGraphNumRoads(mwmValue, routing::VehicleType::Car);
+  auto graph = make_unique<routing::IndexGraph>(
+      make_shared<routing::Geometry>(
+          routing::GeometryLoader::CreateFromFile(mwmFile, vehicleModel), mwmNumRoads),
+      routing::EdgeEstimator::Create(routing::VehicleType::Car, *vehicleModel,
+                                     nullptr /* trafficStash */, nullptr /* dataSource */,
+                                     nullptr /* numMvmIds */));
+  DeserializeIndexGraph(mwmValue, routing::VehicleType::Car, *graph);
+  return graph;
+}
+
+/// \brief Runs a wave from |enter| over |graph| and returns weights of routes to the reachable
+/// exits of |connector|.
 template <typename CrossMwmId>
-void FillWeights(string const & path, string const & mwmFile, string const & country,
-                 routing::CountryParentNameGetterFn const & countryParentNameGetterFn,
-                 bool disableCrossMwmProgress, routing::CrossMwmConnector<CrossMwmId> & connector)
+map<routing::Segment, routing::RouteWeight> CalcEnterWeights(
+    routing::IndexGraph & graph, routing::CrossMwmConnector<CrossMwmId> const & connector,
+    routing::Segment const & enter, size_t & foundCount, size_t & notFoundCount)
 {
-  base::Timer timer;
+  using Algorithm =
+      routing::AStarAlgorithm<routing::JointSegment, routing::JointEdge, routing::RouteWeight>;
+
+  Algorithm astar;
+  IndexGraphWrapper indexGraphWrapper(graph, enter);
+  DijkstraWrapperJoints wrapper(indexGraphWrapper, enter);
+  Algorithm::Context context(wrapper);
+  unordered_map<uint32_t, vector<routing::JointSegment>> visitedVertexes;
+  astar.PropagateWave(
+      wrapper, wrapper.GetStartJoint(),
+      [&](routing::JointSegment const & vertex) {
+        if (vertex.IsFake())
+        {
+          routing::Segment start = wrapper.GetSegmentOfFakeJoint(vertex, true /* start */);
+          routing::Segment end = wrapper.GetSegmentOfFakeJoint(vertex, false /* start */);
+          if (start.IsForward() != end.IsForward())
+            return true;
 
-  shared_ptr<routing::VehicleModelInterface> vehicleModel =
-      routing::CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+          visitedVertexes[end.GetFeatureId()].emplace_back(start, end);
+        }
+        else
+        {
+          visitedVertexes[vertex.GetFeatureId()].emplace_back(vertex);
+        }
 
-  MwmValue mwmValue(LocalCountryFile(path, platform::CountryFile(country), 0 /* version */));
-  uint32_t mwmNumRoads = DeserializeIndexGraphNumRoads(mwmValue, routing::VehicleType::Car);
-  routing::IndexGraph graph(make_shared<routing::Geometry>(
-                                routing::GeometryLoader::CreateFromFile(mwmFile, vehicleModel), mwmNumRoads),
-                            routing::EdgeEstimator::Create(routing::VehicleType::Car, *vehicleModel,
-                                                           nullptr /* trafficStash */,
-                                                           nullptr /* dataSource */,
-                                                           nullptr /* numMvmIds */));
-  DeserializeIndexGraph(mwmValue, routing::VehicleType::Car, graph);
+        return true;
+      } /* visitVertex */,
+      context);
 
-  map<routing::Segment, map<routing::Segment, routing::RouteWeight>> weights;
-  auto const numEnters = connector.GetEnters().size();
-  size_t foundCount = 0;
-  size_t notFoundCount = 0;
-  for (size_t i = 0; i < numEnters; ++i)
+  map<routing::Segment, routing::RouteWeight> weights;
+  for (routing::Segment const & exit : connector.GetExits())
   {
-    if (i % 10 == 0)
-      LOG(LINFO, ("Building leaps:", i, "/", numEnters, "waves passed"));
-
-    routing::Segment const & enter = connector.GetEnter(i);
-
-    using Algorithm =
-        routing::AStarAlgorithm<routing::JointSegment, routing::JointEdge, routing::RouteWeight>;
-
-    Algorithm astar;
-    IndexGraphWrapper indexGraphWrapper(graph, enter);
-    DijkstraWrapperJoints wrapper(indexGraphWrapper, enter);
-    routing::AStarAlgorithm<routing::JointSegment, routing::JointEdge,
-                            routing::RouteWeight>::Context context(wrapper);
-    unordered_map<uint32_t, vector<routing::JointSegment>> visitedVertexes;
-    astar.PropagateWave(
-        wrapper, wrapper.GetStartJoint(),
-        [&](routing::JointSegment const & vertex) {
-          if (vertex.IsFake())
-          {
-            routing::Segment start = wrapper.GetSegmentOfFakeJoint(vertex, true /* start */);
-            routing::Segment end = wrapper.GetSegmentOfFakeJoint(vertex, false /* start */);
-            if (start.IsForward() != end.IsForward())
-              return true;
-
-            visitedVertexes[end.GetFeatureId()].emplace_back(start, end);
-          }
-          else
-          {
-            visitedVertexes[vertex.GetFeatureId()].emplace_back(vertex);
-          }
-
-          return true;
-        } /* visitVertex */,
-        context);
-
-    for (routing::Segment const & exit : connector.GetExits())
+    auto const it = visitedVertexes.find(exit.GetFeatureId());
+    if (it == visitedVertexes.cend())
     {
-      auto const it = visitedVertexes.find(exit.GetFeatureId());
-      if (it == visitedVertexes.cend())
-      {
-        ++notFoundCount;
+      ++notFoundCount;
+      continue;
+    }
+
+    uint32_t const id = exit.GetSegmentIdx();
+    bool const forward = exit.IsForward();
+    for (auto const & jointSegment : it->second)
+    {
+      if (jointSegment.IsForward() != forward)
         continue;
-      }
 
-      uint32_t const id = exit.GetSegmentIdx();
-      bool const forward = exit.IsForward();
-      for (auto const & jointSegment : it->second)
+      if ((jointSegment.GetStartSegmentId() <= id && id <= jointSegment.GetEndSegmentId()) ||
+          (jointSegment.GetEndSegmentId() <= id && id <= jointSegment.GetStartSegmentId()))
       {
-        if (jointSegment.IsForward() != forward)
-          continue;
+        routing::RouteWeight weight;
+        routing::Segment parentSegment;
+        if (context.HasParent(jointSegment))
+        {
+          routing::JointSegment const & parent = context.GetParent(jointSegment);
+          parentSegment = parent.IsFake() ? wrapper.GetSegmentOfFakeJoint(parent, false /* start */)
+                                          : parent.GetSegment(false /* start */);
 
-        if ((jointSegment.GetStartSegmentId() <= id && id <= jointSegment.GetEndSegmentId()) ||
-            (jointSegment.GetEndSegmentId() <= id && id <= jointSegment.GetStartSegmentId()))
+          weight = context.GetDistance(parent);
+        }
+        else
         {
-          routing::RouteWeight weight;
-          routing::Segment parentSegment;
-          if (context.HasParent(jointSegment))
-          {
-            routing::JointSegment const & parent = context.GetParent(jointSegment);
-            parentSegment = parent.IsFake() ? wrapper.GetSegmentOfFakeJoint(parent, false /* start */)
-                                            : parent.GetSegment(false /* start */);
-
-            weight = context.GetDistance(parent);
-          }
-          else
-          {
-            parentSegment = enter;
-          }
-
-          routing::Segment const & firstChild = jointSegment.GetSegment(true /* start */);
-          uint32_t const lastPoint = exit.GetPointId(true /* front */);
-
-          static map<routing::JointSegment, routing::JointSegment> kEmptyParents;
-          auto optionalEdge =  graph.GetJointEdgeByLastPoint(parentSegment, firstChild,
-                                                             true /* isOutgoing */, lastPoint);
-
-          if (!optionalEdge)
-            continue;
-
-          weight += (*optionalEdge).GetWeight();
-          weights[enter][exit] = weight;
-
-          ++foundCount;
-          break;
+          parentSegment = enter;
         }
+
+        routing::Segment const & firstChild = jointSegment.GetSegment(true /* start */);
+        uint32_t const lastPoint = exit.GetPointId(true /* front */);
+
+        auto optionalEdge = graph.GetJointEdgeByLastPoint(parentSegment, firstChild,
+                                                          true /* isOutgoing */, lastPoint);
+
+        if (!optionalEdge)
+          continue;
+
+        weight += (*optionalEdge).GetWeight();
+        weights[exit] = weight;
+
+        ++foundCount;
+        break;
       }
     }
   }
 
+  return weights;
+}
+
+/// \brief Fills weights of |connector| with the waves from all the enters. The waves are
+/// independent and are run on |threadsCount| threads. Geometry of IndexGraph is cached lazily
+/// and can't be shared between threads, so every thread loads its own graph.
+template <typename CrossMwmId>
+void FillWeights(string const & path, string const & mwmFile, string const & country,
+                 routing::CountryParentNameGetterFn const & countryParentNameGetterFn,
+                 bool disableCrossMwmProgress, size_t threadsCount,
+                 string const & weightsCacheDir,
+                 routing::CrossMwmConnector<CrossMwmId> & connector)
+{
+  shared_ptr<routing::VehicleModelInterface> vehicleModel =
+      routing::CarModelFactory(countryParentNameGetterFn).GetVehicleModelForCountry(country);
+
+  optional<generator::CrossMwmWeightsCache> cache;
+  generator::CrossMwmWeightsCache::Key key;
+  if (!weightsCacheDir.empty())
+  {
+    auto const * model = dynamic_cast<routing::VehicleModel const *>(vehicleModel.get());
+    CHECK(model, (country));
+    auto const estimator =
+        routing::EdgeEstimator::Create(routing::VehicleType::Car, *vehicleModel,
+                                       nullptr /* trafficStash */, nullptr /* dataSource */,
+                                       nullptr /* numMvmIds */);
+
+    cache.emplace(weightsCacheDir);
+    key = generator::CrossMwmWeightsCache::CalcKey(
+        mwmFile, country, connector.GetEnters(), connector.GetExits(),
+        generator::CrossMwmWeightsCache::GetWeightsParams(*model, *estimator));
+    vector<generator::CrossMwmWeightsCache::Weight> cached;
+    if (cache->Load(country, key, connector.GetEnters().size() * connector.GetExits().size(),
+                    cached))
+    {
+      // The weights are filled in the same order as they were saved.
+      size_t i = 0;
+      connector.FillWeights([&](routing::Segment const & /* enter */,
+                                routing::Segment const & /* exit */) { return cached[i++]; });
+      LOG(LINFO, ("Leaps are taken from", weightsCacheDir, "for", country));
+      return;
+    }
+  }
+
+  base::Timer timer;
+
+  auto const numEnters = connector.GetEnters().size();
+  threadsCount = max(size_t{1}, min(threadsCount, numEnters));
+  vector<map<routing::Segment, routing::RouteWeight>> enterWeights(numEnters);
+  atomic<size_t> foundCount(0);
+  atomic<size_t> notFoundCount(0);
+  atomic<size_t> wavesCount(0);
+  {
+    base::thread_pool::computational::ThreadPool pool(threadsCount);
+    vector<future<void>> results;
+    results.reserve(threadsCount);
+    for (size_t threadIdx = 0; threadIdx < threadsCount; ++threadIdx)
+    {
+      results.emplace_back(pool.Submit([&, threadIdx]() {
+        auto graph = LoadIndexGraph(path, mwmFile, country, vehicleModel);
+        size_t found = 0;
+        size_t notFound = 0;
+        for (size_t i = threadIdx; i < numEnters; i += threadsCount)
+        {
+          auto const passed = wavesCount++;
+          if (passed % 10 == 0)
+            LOG(LINFO, ("Building leaps:", passed, "/", numEnters, "waves passed"));
+
+          enterWeights[i] =
+              CalcEnterWeights(*graph, connector, connector.GetEnter(i), found, notFound);
+        }
+
+        foundCount += found;
+        notFoundCount += notFound;
+      }));
+    }
+
+    for (auto & result : results)
+      result.get();
+  }
+
+  map<routing::Segment, map<routing::Segment, routing::RouteWeight>> weights;
+  for (size_t i = 0; i < numEnters; ++i)
+  {
+    if (!enterWeights[i].empty())
+      weights[connector.GetEnter(i)] = move(enterWeights[i]);
+  }
+
+  vector<generator::CrossMwmWeightsCache::Weight> filled;
+  if (cache)
+    filled.reserve(connector.GetEnters().size() * connector.GetExits().size());
+
   connector.FillWeights([&](routing::Segment const & enter, routing::Segment const & exit) {
+    auto weight = routing::connector::kNoRoute;
     auto it0 = weights.find(enter);
-    if (it0 == weights.end())
-      return routing::connector::kNoRoute;
-
-    auto it1 = it0->second.find(exit);
-    if (it1 == it0->second.end())
-      return routing::connector::kNoRoute;
+    if (it0 != weights.end())
+    {
+      auto it1 = it0->second.find(exit);
+      if (it1 != it0->second.end())
+        weight = it1->second.ToCrossMwmWeight();
+    }
 
-    return it1->second.ToCrossMwmWeight();
+    if (cache)
+    {
+      // The connector stores weights rounded up.
+      filled.push_back(static_cast<generator::CrossMwmWeightsCache::Weight>(ceil(weight)));
+    }
+    return weight;
   });
 
+  if (cache)
+    cache->Save(country, key, filled);
+
   LOG(LINFO, ("Leaps finished, elapsed:", timer.ElapsedSeconds(), "seconds, routes found:",
-              foundCount, ", not found:", notFoundCount));
+              foundCount.load(), ", not found:", notFoundCount.load(), ", threads:",
+              threadsCount));
 }
 }  // namespace
 
@@ -704,7 +804,8 @@ void SerializeCrossMwm(string const & mwmFile, string const & sectionName,
 void BuildRoutingCrossMwmSection(string const & path, string const & mwmFile,
                                  string const & country, string const & intermediateDir,
                                  CountryParentNameGetterFn const & countryParentNameGetterFn,
-                                 string const & osmToFeatureFile, bool disableCrossMwmProgress)
+                                 string const & osmToFeatureFile, bool disableCrossMwmProgress,
+                                 size_t threadsCount, string const & weightsCacheDir)
 {
   LOG(LINFO, ("Building cross mwm section for", country));
   using CrossMwmId = base::GeoObjectId;
@@ -717,7 +818,7 @@ void BuildRoutingCrossMwmSection(string const & path, string const & mwmFile,
   // We use leaps for cars only. To use leaps for other vehicle types add weights generation
   // here and change WorldGraph mode selection rule in IndexRouter::CalculateSubroute.
   FillWeights(path, mwmFile, country, countryParentNameGetterFn, disableCrossMwmProgress,
-              connectors[static_cast<size_t>(VehicleType::Car)]);
+              threadsCount, weightsCacheDir, connectors[static_cast<size_t>(VehicleType::Car)]);
 
   CHECK(connectors[static_cast<size_t>(VehicleType::Transit)].IsEmpty(), ());
   SerializeCrossMwm(mwmFile, CROSS_MWM_FILE_TAG, connectors, transitions);
@@ -2,6 +2,7 @@
 
 #include "transit/experimental/transit_data.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
@@ -17,11 +18,15 @@ bool BuildRoutingIndex(std::string const & filename, std::string const & country
 /// \note Before call of this method
 /// * all features and feature geometry should be generated
 /// * city_roads section should be generated
+/// \note Waves from the enters are run on |threadsCount| threads.
+/// \note If |weightsCacheDir| is not empty the weights are taken from it when the roads of the
+/// country are the same as in the build they were saved by, see CrossMwmWeightsCache.
 void BuildRoutingCrossMwmSection(std::string const & path, std::string const & mwmFile,
                                  std::string const & country, std::string const & intermediateDir,
                                  CountryParentNameGetterFn const & countryParentNameGetterFn,
                                  std::string const & osmToFeatureFile,
-                                 bool disableCrossMwmProgress);
+                                 bool disableCrossMwmProgress, size_t threadsCount = 1,
+                                 std::string const & weightsCacheDir = "");
 /// \brief Builds TRANSIT_CROSS_MWM_FILE_TAG section.
 /// \note Before a call of this method TRANSIT_FILE_TAG should be built.
 void BuildTransitCrossMwmSection(
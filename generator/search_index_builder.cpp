@@ -26,9 +26,12 @@
 
 #include "platform/platform.hpp"
 
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
 #include "coding/map_uint32_to_val.hpp"
 #include "coding/reader_writer_ops.hpp"
 #include "coding/succinct_mapper.hpp"
+#include "coding/varint.hpp"
 #include "coding/writer.hpp"
 
 #include "geometry/mercator.hpp"
@@ -37,17 +40,22 @@
 #include "base/checked_cast.hpp"
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
+#include "base/profiler.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
+#include "base/thread_pool_computational.hpp"
 #include "base/timer.hpp"
 
 #include "defines.hpp"
 
 #include <algorithm>
 #include <fstream>
+#include <future>
+#include <iterator>
 #include <map>
 #include <mutex>
+#include <queue>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -108,38 +116,6 @@ private:
   unordered_multimap<string, string> m_map;
 };
 
-void GetCategoryTypes(CategoriesHolder const & categories, pair<int, int> const & scaleRange,
-                      feature::TypesHolder const & types, vector<uint32_t> & result)
-{
-  for (uint32_t t : types)
-  {
-    // Truncate |t| up to 2 levels and choose the best category match to find explicit category if
-    // any and not distinguish types like highway-primary-bridge and highway-primary-tunnel or
-    // amenity-parking-fee and amenity-parking-underground-fee if we do not have such explicit
-    // categories.
-
-    for (uint8_t level = ftype::GetLevel(t); level >= 2; --level)
-    {
-      ftype::TruncValue(t, level);
-      if (categories.IsTypeExist(t))
-        break;
-    }
-
-    // Only categorized types will be added to index.
-    if (!categories.IsTypeExist(t))
-      continue;
-
-    // Drawable scale must be normalized to indexer scales.
-    auto indexedRange = scaleRange;
-    if (scaleRange.second == scales::GetUpperScale())
-      indexedRange.second = scales::GetUpperStyleScale();
-
-    // Index only those types that are visible.
-    if (feature::IsVisibleInRange(t, indexedRange))
-      result.push_back(t);
-  }
-}
-
 template <typename Key, typename Value>
 struct FeatureNameInserter
 {
@@ -354,7 +330,7 @@ public:
     Classificator const & c = classif();
 
     vector<uint32_t> categoryTypes;
-    GetCategoryTypes(m_categories, m_scales, types, categoryTypes);
+    indexer::GetCategoryTypes(m_categories, m_scales, types, categoryTypes);
 
     // add names of categories of the feature
     for (uint32_t t : categoryTypes)
@@ -370,19 +346,138 @@ private:
   pair<int, int> m_scales;
 };
 
+// Maximum number of key-value pairs of the search index which are kept in memory by all threads.
+// Sorted pairs are flushed to temporary files which are merged while the trie is built.
+size_t constexpr kMaxKeyValuePairsInMemory = 1 << 22;
+
+template <typename Key, typename Value>
+void WriteSortedKeyValuePairs(string const & filename, vector<pair<Key, Value>> & pairs)
+{
+  sort(pairs.begin(), pairs.end());
+  pairs.erase(unique(pairs.begin(), pairs.end()), pairs.end());
+
+  FileWriter writer(filename);
+  for (auto const & p : pairs)
+  {
+    WriteVarUint(writer, base::asserted_cast<uint32_t>(p.first.size()));
+    for (auto const c : p.first)
+      WriteVarUint(writer, static_cast<uint32_t>(c));
+    WriteVarUint(writer, p.second.m_featureId);
+  }
+  pairs.clear();
+}
+
+template <typename Key, typename Value>
+class SortedKeyValuePairsReader
+{
+public:
+  explicit SortedKeyValuePairsReader(string const & filename) : m_source(FileReader(filename)) {}
+
+  bool Read(pair<Key, Value> & p)
+  {
+    if (m_source.Size() == 0)
+      return false;
+
+    p.first.resize(ReadVarUint<uint32_t>(m_source));
+    for (auto & c : p.first)
+      c = ReadVarUint<uint32_t>(m_source);
+    p.second.m_featureId = ReadVarUint<uint64_t>(m_source);
+    return true;
+  }
+
+private:
+  ReaderSource<FileReader> m_source;
+};
+
+// Calls |toDo(key, value)| for pairs of the sorted files in the sorted order.
+template <typename Key, typename Value, typename ToDo>
+void MergeSortedKeyValuePairs(vector<string> const & filenames, ToDo && toDo)
+{
+  using Item = pair<pair<Key, Value>, size_t>;
+  auto const greater = [](Item const & lhs, Item const & rhs) { return rhs.first < lhs.first; };
+  priority_queue<Item, vector<Item>, decltype(greater)> queue(greater);
+
+  vector<SortedKeyValuePairsReader<Key, Value>> readers;
+  readers.reserve(filenames.size());
+  for (size_t i = 0; i < filenames.size(); ++i)
+  {
+    readers.emplace_back(filenames[i]);
+    Item item;
+    item.second = i;
+    if (readers.back().Read(item.first))
+      queue.push(move(item));
+  }
+
+  while (!queue.empty())
+  {
+    auto item = queue.top();
+    queue.pop();
+    toDo(item.first.first, item.first.second);
+    if (readers[item.second].Read(item.first))
+      queue.push(move(item));
+  }
+}
+
+// Collects key-value pairs of the features names and categories on |threadsCount| threads into
+// sorted files named with |tmpFilePrefix|. Returns names of the files.
 template <typename Key, typename Value>
-void AddFeatureNameIndexPairs(FeaturesVectorTest const & features,
-                              CategoriesHolder const & categoriesHolder,
-                              vector<pair<Key, Value>> & keyValuePairs)
+vector<string> AddFeatureNameIndexPairs(FilesContainerR const & container,
+                                        CategoriesHolder const & categoriesHolder,
+                                        string const & tmpFilePrefix, uint32_t threadsCount)
 {
+  FeaturesVectorTest features(container);
   feature::DataHeader const & header = features.GetHeader();
+  uint64_t const featuresCount = features.GetVector().GetNumFeatures();
 
   unique_ptr<SynonymsHolder> synonyms;
   if (header.GetType() == feature::DataHeader::MapType::World)
     synonyms.reset(new SynonymsHolder(base::JoinPath(GetPlatform().ResourcesDir(), SYNONYMS_FILE)));
 
-  features.GetVector().ForEach(FeatureInserter<Key, Value>(
-      synonyms.get(), keyValuePairs, categoriesHolder, header.GetScaleRange()));
+  size_t const maxPairsCount = max(size_t{1}, kMaxKeyValuePairsInMemory / threadsCount);
+  vector<vector<string>> threadsFilenames(threadsCount);
+  {
+    base::thread_pool::computational::ThreadPool pool(threadsCount);
+    vector<future<void>> results;
+    for (uint32_t threadIdx = 0; threadIdx < threadsCount; ++threadIdx)
+    {
+      results.emplace_back(pool.Submit([&, threadIdx]() {
+        auto const beg = static_cast<uint32_t>(featuresCount * threadIdx / threadsCount);
+        auto const end = static_cast<uint32_t>(featuresCount * (threadIdx + 1) / threadsCount);
+
+        // Every thread reads the features with its own file reader.
+        FeaturesVectorTest threadFeatures(container.GetFileName());
+        vector<pair<Key, Value>> keyValuePairs;
+        FeatureInserter<Key, Value> inserter(synonyms.get(), keyValuePairs, categoriesHolder,
+                                             header.GetScaleRange());
+        auto & filenames = threadsFilenames[threadIdx];
+        auto const flush = [&]() {
+          filenames.push_back(tmpFilePrefix + "." + strings::to_string(threadIdx) + "." +
+                              strings::to_string(filenames.size()));
+          WriteSortedKeyValuePairs(filenames.back(), keyValuePairs);
+        };
+
+        for (uint32_t i = beg; i < end; ++i)
+        {
+          auto ft = threadFeatures.GetVector().GetByIndex(i);
+          inserter(*ft, i);
+          if (keyValuePairs.size() >= maxPairsCount)
+            flush();
+        }
+
+        if (!keyValuePairs.empty())
+          flush();
+      }));
+    }
+
+    // Rethrows exceptions of the threads.
+    for (auto & result : results)
+      result.get();
+  }
+
+  vector<string> filenames;
+  for (auto & threadFilenames : threadsFilenames)
+    move(threadFilenames.begin(), threadFilenames.end(), back_inserter(filenames));
+  return filenames;
 }
 
 void ReadAddressData(string const & filename, vector<feature::AddressData> & addrs)
@@ -517,11 +612,45 @@ void BuildAddressTable(FilesContainerR & container, string const & addressDataFi
 
 namespace indexer
 {
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter);
+void GetCategoryTypes(CategoriesHolder const & categories, pair<int, int> const & scaleRange,
+                      feature::TypesHolder const & types, vector<uint32_t> & result)
+{
+  for (uint32_t t : types)
+  {
+    // Truncate |t| up to 2 levels and choose the best category match to find explicit category if
+    // any and not distinguish types like highway-primary-bridge and highway-primary-tunnel or
+    // amenity-parking-fee and amenity-parking-underground-fee if we do not have such explicit
+    // categories.
+
+    for (uint8_t level = ftype::GetLevel(t); level >= 2; --level)
+    {
+      ftype::TruncValue(t, level);
+      if (categories.IsTypeExist(t))
+        break;
+    }
+
+    // Only categorized types will be added to index.
+    if (!categories.IsTypeExist(t))
+      continue;
+
+    // Drawable scale must be normalized to indexer scales.
+    auto indexedRange = scaleRange;
+    if (scaleRange.second == scales::GetUpperScale())
+      indexedRange.second = scales::GetUpperStyleScale();
+
+    // Index only those types that are visible.
+    if (feature::IsVisibleInRange(t, indexedRange))
+      result.push_back(t);
+  }
+}
+
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter,
+                      string const & tmpFilePrefix, uint32_t threadsCount);
 
 bool BuildSearchIndexFromDataFile(string const & country, feature::GenerateInfo const & info,
                                   bool forceRebuild, uint32_t threadsCount)
 {
+  PROFILER_SCOPE("BuildSearchIndexFromDataFile");
   Platform & platform = GetPlatform();
 
   auto const filename = info.GetTargetFileName(country, DATA_FILE_EXTENSION);
@@ -538,7 +667,7 @@ bool BuildSearchIndexFromDataFile(string const & country, feature::GenerateInfo
   {
     {
       FileWriter writer(indexFilePath);
-      BuildSearchIndex(readContainer, writer);
+      BuildSearchIndex(readContainer, writer, indexFilePath, threadsCount);
       LOG(LINFO, ("Search index size =", writer.Size()));
     }
     if (filename != WORLD_FILE_NAME && filename != WORLD_COASTS_FILE_NAME)
@@ -593,7 +722,8 @@ bool BuildSearchIndexFromDataFile(string const & country, feature::GenerateInfo
   return true;
 }
 
-void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
+void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter,
+                      string const & tmpFilePrefix, uint32_t threadsCount)
 {
   using Key = strings::UniString;
   using Value = Uint64IndexValue;
@@ -603,17 +733,21 @@ void BuildSearchIndex(FilesContainerR & container, Writer & indexWriter)
 
   auto const & categoriesHolder = GetDefaultCategories();
 
-  FeaturesVectorTest features(container);
-  SingleValueSerializer<Value> serializer;
-
-  vector<pair<Key, Value>> searchIndexKeyValuePairs;
-  AddFeatureNameIndexPairs(features, categoriesHolder, searchIndexKeyValuePairs);
-
-  sort(searchIndexKeyValuePairs.begin(), searchIndexKeyValuePairs.end());
+  vector<string> filenames;
+  SCOPE_GUARD(filesGuard, [&filenames]() {
+    for (auto const & filename : filenames)
+      FileWriter::DeleteFileX(filename);
+  });
+  filenames = AddFeatureNameIndexPairs<Key, Value>(container, categoriesHolder, tmpFilePrefix,
+                                                   max(threadsCount, uint32_t{1}));
   LOG(LINFO, ("End sorting strings:", timer.ElapsedSeconds()));
 
-  trie::Build<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>>(
-      indexWriter, serializer, searchIndexKeyValuePairs);
+  SingleValueSerializer<Value> serializer;
+  trie::Builder<Writer, Key, ValueList<Value>, SingleValueSerializer<Value>> builder(indexWriter,
+                                                                                     serializer);
+  MergeSortedKeyValuePairs<Key, Value>(
+      filenames, [&builder](Key const & key, Value const & value) { builder.Add(key, value); });
+  builder.Finish();
 
   LOG(LINFO, ("End building search index, elapsed seconds:", timer.ElapsedSeconds()));
 }
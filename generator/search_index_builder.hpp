@@ -2,10 +2,25 @@
 
 #include "generator/generate_info.hpp"
 
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
+
+class CategoriesHolder;
+
+namespace feature
+{
+class TypesHolder;
+}  // namespace feature
 
 namespace indexer
 {
+// Appends to |result| the types of |types| which get the category tokens in the search index:
+// the types truncated to the ones which have categories and which are visible in |scaleRange|.
+void GetCategoryTypes(CategoriesHolder const & categories, std::pair<int, int> const & scaleRange,
+                      feature::TypesHolder const & types, std::vector<uint32_t> & result);
+
 // Builds the latest version of the search index section and writes it to the mwm file.
 // An attempt to rewrite the search index of an old mwm may result in a future crash
 // when using search because this function does not update mwm's version. This results
@@ -0,0 +1,162 @@
+#include "generator/speed_profiles_builder.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "defines.hpp"
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+char const kDelim[] = ", \t\r\n";
+// Percents are rounded to |kPercentStep| to make more profiles equal.
+uint8_t constexpr kPercentStep = 5;
+
+optional<SpeedProfiles::Profile> MakeProfile(
+    array<double, SpeedProfiles::kHoursInWeek> const & speeds)
+{
+  auto const maxSpeed = *max_element(speeds.cbegin(), speeds.cend());
+  if (maxSpeed <= 0.0)
+    return {};
+
+  SpeedProfiles::Profile profile;
+  bool hasSlowdowns = false;
+  for (size_t i = 0; i < speeds.size(); ++i)
+  {
+    auto const steps = round(speeds[i] / maxSpeed * SpeedProfiles::kMaxPercent / kPercentStep);
+    auto const percent = clamp(static_cast<int>(steps) * kPercentStep,
+                               static_cast<int>(kPercentStep),
+                               static_cast<int>(SpeedProfiles::kMaxPercent));
+    profile[i] = static_cast<uint8_t>(percent);
+    hasSlowdowns = hasSlowdowns || profile[i] != SpeedProfiles::kMaxPercent;
+  }
+
+  if (!hasSlowdowns)
+    return {};
+  return profile;
+}
+}  // namespace
+
+namespace routing
+{
+bool ParseSpeedProfiles(string const & speedsFilename, OsmIdToSpeedProfile & osmIdToProfile)
+{
+  osmIdToProfile.clear();
+
+  ifstream stream(speedsFilename);
+  if (!stream)
+    return false;
+
+  string line;
+  while (getline(stream, line))
+  {
+    strings::SimpleTokenizer iter(line, kDelim);
+
+    uint64_t osmId = 0;
+    if (!iter || !strings::to_uint64(*iter, osmId))
+      return false;
+    ++iter;
+
+    uint64_t forward = 0;
+    if (!iter || !strings::to_uint64(*iter, forward) || forward > 1)
+      return false;
+    ++iter;
+
+    array<double, SpeedProfiles::kHoursInWeek> speeds;
+    for (auto & speed : speeds)
+    {
+      if (!iter || !strings::to_double(*iter, speed) || speed < 0.0)
+        return false;
+      ++iter;
+    }
+
+    if (iter)
+      return false;
+
+    auto const profile = MakeProfile(speeds);
+    if (!profile)
+      continue;
+
+    auto const res =
+        osmIdToProfile.emplace(make_pair(base::MakeOsmWay(osmId), forward == 1), *profile);
+    if (!res.second)
+      return false;
+  }
+  return true;
+}
+
+SpeedProfiles MakeSpeedProfiles(OsmIdToSpeedProfile const & osmIdToProfile,
+                                OsmIdToFeatureIds const & osmIdToFeatureIds)
+{
+  vector<SpeedProfiles::Profile> profiles;
+  map<SpeedProfiles::Profile, uint32_t> profileToIdx;
+  vector<SpeedProfiles::Entry> entries;
+  for (auto const & [key, profile] : osmIdToProfile)
+  {
+    auto const featureIdsIt = osmIdToFeatureIds.find(key.first);
+    if (featureIdsIt == osmIdToFeatureIds.cend())
+      continue;
+
+    auto const [it, inserted] =
+        profileToIdx.emplace(profile, static_cast<uint32_t>(profiles.size()));
+    if (inserted)
+      profiles.push_back(profile);
+
+    for (auto const featureId : featureIdsIt->second)
+      entries.emplace_back(featureId, key.second, it->second);
+  }
+
+  // A feature may be made of several ways in exceptional cases. The first profile is taken.
+  sort(entries.begin(), entries.end(), [](auto const & lhs, auto const & rhs) {
+    return make_pair(lhs.m_featureId, lhs.m_forward) < make_pair(rhs.m_featureId, rhs.m_forward);
+  });
+  entries.erase(unique(entries.begin(), entries.end(),
+                       [](auto const & lhs, auto const & rhs) {
+                         return lhs.m_featureId == rhs.m_featureId &&
+                                lhs.m_forward == rhs.m_forward;
+                       }),
+                entries.end());
+
+  return SpeedProfiles(move(profiles), move(entries));
+}
+
+void BuildSpeedProfilesSection(string const & dataPath, string const & osmToFeaturePath,
+                               string const & speedsFilename)
+{
+  LOG(LINFO, ("BuildSpeedProfilesSection(", dataPath, ",", osmToFeaturePath, ",", speedsFilename,
+              ")"));
+
+  OsmIdToSpeedProfile osmIdToProfile;
+  CHECK(ParseSpeedProfiles(speedsFilename, osmIdToProfile), (speedsFilename));
+
+  OsmIdToFeatureIds osmIdToFeatureIds;
+  CHECK(ParseWaysOsmIdToFeatureIdMapping(osmToFeaturePath, osmIdToFeatureIds), ());
+
+  auto const speedProfiles = MakeSpeedProfiles(osmIdToProfile, osmIdToFeatureIds);
+  if (speedProfiles.IsEmpty())
+    return;
+
+  FilesContainerW cont(dataPath, FileWriter::OP_WRITE_EXISTING);
+  auto writer = cont.GetWriter(SPEED_PROFILES_FILE_TAG);
+  speedProfiles.Serialize(*writer);
+
+  LOG(LINFO, (SPEED_PROFILES_FILE_TAG, "section is built for", dataPath, ":",
+              speedProfiles.GetEntriesNumber(), "feature directions,",
+              speedProfiles.GetProfiles().size(), "profiles."));
+}
+}  // namespace routing
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "generator/routing_helpers.hpp"
+
+#include "routing/speed_profiles.hpp"
+
+#include "base/geo_object_id.hpp"
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace routing
+{
+// Profiles of the way directions. The key is the osm way id and true for the way direction.
+using OsmIdToSpeedProfile = std::map<std::pair<base::GeoObjectId, bool>, SpeedProfiles::Profile>;
+
+/// \brief Parses csv file |speedsFilename| with typical speeds of the way directions and stores
+/// their profiles in |osmIdToProfile|. Every line of the file has the following format:
+/// <osm way id>, <1 for the way direction, 0 for the opposite one>, <168 speeds in km/h>
+/// Speeds are taken by the hour of the week of the local time of the region starting from
+/// Sunday 00:00.
+/// The maximum speed of the week is considered as the free-flow speed. Profiles without slowdowns
+/// are not stored.
+bool ParseSpeedProfiles(std::string const & speedsFilename, OsmIdToSpeedProfile & osmIdToProfile);
+
+/// \brief Makes profiles of the features of |osmIdToFeatureIds|. Equal profiles are shared.
+SpeedProfiles MakeSpeedProfiles(OsmIdToSpeedProfile const & osmIdToProfile,
+                                OsmIdToFeatureIds const & osmIdToFeatureIds);
+
+/// \brief Builds SPEED_PROFILES_FILE_TAG section in mwm with |dataPath| with typical speeds
+/// of file |speedsFilename|. The section is used by car routing for time-dependent weights.
+void BuildSpeedProfilesSection(std::string const & dataPath, std::string const & osmToFeaturePath,
+                               std::string const & speedsFilename);
+}  // namespace routing
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "generator/sponsored_scoring.hpp"
+
 #include "geometry/latlon.hpp"
 
 #include "base/newtype.hpp"
@@ -32,6 +34,8 @@ struct SponsoredObjectBase
   ObjectId m_id{InvalidObjectId()};
   ms::LatLon m_latLon = ms::LatLon::Zero();
   std::string m_name;
+  // Words of |m_name| prepared for scoring.
+  impl::WeightedBagOfWords m_nameWords;
   std::string m_street;
   std::string m_houseNumber;
 
@@ -14,6 +14,7 @@
 #include <map>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "boost/geometry.hpp"
@@ -117,7 +118,7 @@ public:
       if (object.m_id != Object::InvalidObjectId() &&
           excludedIds.find(object.m_id) == excludedIds.cend())
       {
-        m_objects.emplace(object.m_id, object);
+        m_objects.emplace(object.m_id, std::move(object));
       }
     }
 
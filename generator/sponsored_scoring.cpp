@@ -10,7 +10,7 @@
 
 namespace
 {
-using WeightedBagOfWords = std::vector<std::pair<strings::UniString, double>>;
+using generator::impl::WeightedBagOfWords;
 
 std::vector<strings::UniString> StringToWords(std::string const & str)
 {
@@ -20,7 +20,7 @@ std::vector<strings::UniString> StringToWords(std::string const & str)
   return result;
 }
 
-WeightedBagOfWords MakeWeightedBagOfWords(std::vector<strings::UniString> const & words)
+WeightedBagOfWords MakeWeightedBagOfWordsImpl(std::vector<strings::UniString> const & words)
 {
   // TODO(mgsergio): Calculate tf-idsf score for every word.
   auto constexpr kTfIdfScorePlaceholder = 1;
@@ -92,17 +92,25 @@ double GetLinearNormDistanceScore(double distance, double const maxDistance)
   return 1.0 - distance / maxDistance;
 }
 
+WeightedBagOfWords MakeWeightedBagOfWords(std::string const & name)
+{
+  return MakeWeightedBagOfWordsImpl(StringToWords(name));
+}
+
 double GetNameSimilarityScore(std::string const & booking_name, std::string const & osm_name)
 {
-  auto const aws = MakeWeightedBagOfWords(StringToWords(booking_name));
-  auto const bws = MakeWeightedBagOfWords(StringToWords(osm_name));
+  return GetNameSimilarityScore(MakeWeightedBagOfWords(booking_name),
+                                MakeWeightedBagOfWords(osm_name));
+}
 
-  if (aws.empty() && bws.empty())
+double GetNameSimilarityScore(WeightedBagOfWords const & lhs, WeightedBagOfWords const & rhs)
+{
+  if (lhs.empty() && rhs.empty())
     return 1.0;
-  if (aws.empty() || bws.empty())
+  if (lhs.empty() || rhs.empty())
     return 0.0;
 
-  return WeightedBagOfWordsCos(aws, bws);
+  return WeightedBagOfWordsCos(lhs, rhs);
 }
 }  // namespace impl
 }  // namespace generator
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "base/string_utils.hpp"
+
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace feature
 {
@@ -11,8 +15,16 @@ namespace generator
 {
 namespace impl
 {
+// Normalized words of a name with their weights sorted by the words.
+using WeightedBagOfWords = std::vector<std::pair<strings::UniString, double>>;
+
+WeightedBagOfWords MakeWeightedBagOfWords(std::string const & name);
+
 double GetLinearNormDistanceScore(double distance, double maxDistance);
 double GetNameSimilarityScore(std::string const & booking_name, std::string const & osm_name);
+// The same as above for the names prepared with MakeWeightedBagOfWords(). Sponsored objects
+// keep the words of their names, so the names are not normalized for every candidate.
+double GetNameSimilarityScore(WeightedBagOfWords const & lhs, WeightedBagOfWords const & rhs);
 }  // namespace impl
 
 namespace sponsored_scoring
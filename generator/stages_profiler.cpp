@@ -0,0 +1,165 @@
+#include "generator/stages_profiler.hpp"
+
+#include "base/logging.hpp"
+
+#include "std/target_os.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include "3party/jansson/myjansson.hpp"
+
+namespace generator
+{
+namespace
+{
+double ToSeconds(timeval const & t) { return t.tv_sec + t.tv_usec / 1e6; }
+
+double GetCpuSeconds(rusage const & usage)
+{
+  return ToSeconds(usage.ru_utime) + ToSeconds(usage.ru_stime);
+}
+
+// Returns bytes passed through read and write syscalls by the process. Data of the mapped files
+// is not taken into account.
+void GetIoBytes(uint64_t & readBytes, uint64_t & writtenBytes)
+{
+  readBytes = 0;
+  writtenBytes = 0;
+#if defined(OMIM_OS_LINUX)
+  std::ifstream stream("/proc/self/io");
+  std::string key;
+  uint64_t value = 0;
+  while (stream >> key >> value)
+  {
+    if (key == "rchar:")
+      readBytes = value;
+    else if (key == "wchar:")
+      writtenBytes = value;
+  }
+#endif
+}
+
+template <typename T>
+T GetDelta(T begin, T end)
+{
+  return end > begin ? end - begin : T{0};
+}
+}  // namespace
+
+// static
+ResourceUsage ResourceUsage::GetCurrent()
+{
+  ResourceUsage result;
+  result.m_wallTime = std::chrono::steady_clock::now();
+
+  rusage usage = {};
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+    result.m_cpuSeconds = GetCpuSeconds(usage);
+#if defined(OMIM_OS_LINUX)
+    // ru_maxrss is in kilobytes on Linux and in bytes on macOS.
+    result.m_peakRssBytes = static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#else
+    result.m_peakRssBytes = static_cast<uint64_t>(usage.ru_maxrss);
+#endif
+  }
+
+#if defined(OMIM_OS_LINUX)
+  rusage threadUsage = {};
+  if (getrusage(RUSAGE_THREAD, &threadUsage) == 0)
+    result.m_threadCpuSeconds = GetCpuSeconds(threadUsage);
+#else
+  result.m_threadCpuSeconds = result.m_cpuSeconds;
+#endif
+
+  GetIoBytes(result.m_readBytes, result.m_writtenBytes);
+  return result;
+}
+
+void StageUsage::Add(ResourceUsage const & begin, ResourceUsage const & end)
+{
+  ++m_runsCount;
+  m_wallSeconds += std::chrono::duration<double>(end.m_wallTime - begin.m_wallTime).count();
+  m_cpuSeconds += GetDelta(begin.m_cpuSeconds, end.m_cpuSeconds);
+  m_threadCpuSeconds += GetDelta(begin.m_threadCpuSeconds, end.m_threadCpuSeconds);
+  m_peakRssBytes = std::max(m_peakRssBytes, end.m_peakRssBytes);
+  m_readBytes += GetDelta(begin.m_readBytes, end.m_readBytes);
+  m_writtenBytes += GetDelta(begin.m_writtenBytes, end.m_writtenBytes);
+}
+
+StagesProfiler::Scope::Scope(std::string const & stage)
+  : m_stage(stage), m_begin(ResourceUsage::GetCurrent())
+{
+}
+
+StagesProfiler::Scope::~Scope()
+{
+  StagesProfiler::Instance().Add(m_stage, m_begin, ResourceUsage::GetCurrent());
+}
+
+// static
+StagesProfiler & StagesProfiler::Instance()
+{
+  static StagesProfiler instance;
+  return instance;
+}
+
+void StagesProfiler::Add(std::string const & stage, ResourceUsage const & begin,
+                         ResourceUsage const & end)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stages[stage].Add(begin, end);
+}
+
+std::map<std::string, StageUsage> StagesProfiler::GetStages() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stages;
+}
+
+void StagesProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stages.clear();
+}
+
+std::string StagesProfiler::GetJsonReport() const
+{
+  auto stages = base::NewJSONObject();
+  for (auto const & stage : GetStages())
+  {
+    auto const & usage = stage.second;
+    auto obj = base::NewJSONObject();
+    ToJSONObject(*obj, "runs", usage.m_runsCount);
+    ToJSONObject(*obj, "wall_seconds", usage.m_wallSeconds);
+    ToJSONObject(*obj, "cpu_seconds", usage.m_cpuSeconds);
+    ToJSONObject(*obj, "thread_cpu_seconds", usage.m_threadCpuSeconds);
+    ToJSONObject(*obj, "peak_rss_bytes", usage.m_peakRssBytes);
+    ToJSONObject(*obj, "read_bytes", usage.m_readBytes);
+    ToJSONObject(*obj, "written_bytes", usage.m_writtenBytes);
+    ToJSONObject(*stages, stage.first.c_str(), obj);
+  }
+
+  auto root = base::NewJSONObject();
+  ToJSONObject(*root, "stages", stages);
+  return base::DumpToString(root, JSON_INDENT(2) | JSON_SORT_KEYS);
+}
+
+bool StagesProfiler::SaveJsonReport(std::string const & filename) const
+{
+  std::ofstream stream(filename);
+  if (!stream.is_open())
+  {
+    LOG(LERROR, ("Can't open file", filename));
+    return false;
+  }
+
+  stream << GetJsonReport() << std::endl;
+  return stream.good();
+}
+}  // namespace generator
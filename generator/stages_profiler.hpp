@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace generator
+{
+// Resources used by the process and the current thread since their start.
+struct ResourceUsage
+{
+  static ResourceUsage GetCurrent();
+
+  std::chrono::steady_clock::time_point m_wallTime;
+  double m_cpuSeconds = 0.0;
+  double m_threadCpuSeconds = 0.0;
+  uint64_t m_peakRssBytes = 0;
+  uint64_t m_readBytes = 0;
+  uint64_t m_writtenBytes = 0;
+};
+
+// Resources used by all the runs of a stage.
+struct StageUsage
+{
+  void Add(ResourceUsage const & begin, ResourceUsage const & end);
+
+  uint64_t m_runsCount = 0;
+  double m_wallSeconds = 0.0;
+  // Process CPU time. It includes CPU time of the stages run concurrently.
+  double m_cpuSeconds = 0.0;
+  // CPU time of the thread which has run the stage. It doesn't include CPU time of the helper
+  // threads of the stage.
+  double m_threadCpuSeconds = 0.0;
+  // Peak RSS of the process at the end of the stage.
+  uint64_t m_peakRssBytes = 0;
+  // Bytes read and written by the process during the stage.
+  uint64_t m_readBytes = 0;
+  uint64_t m_writtenBytes = 0;
+};
+
+// Collects resource usage of the generator stages. Stage names are paths like
+// "final_processor/country/Order/Germany_Berlin". The JSON report is sorted by the names to be
+// diffed between builds.
+class StagesProfiler
+{
+public:
+  // Records the resources used between its construction and destruction as a run of |stage|.
+  class Scope
+  {
+  public:
+    explicit Scope(std::string const & stage);
+    ~Scope();
+
+  private:
+    std::string m_stage;
+    ResourceUsage m_begin;
+  };
+
+  static StagesProfiler & Instance();
+
+  void Add(std::string const & stage, ResourceUsage const & begin, ResourceUsage const & end);
+  std::map<std::string, StageUsage> GetStages() const;
+  void Clear();
+
+  std::string GetJsonReport() const;
+  bool SaveJsonReport(std::string const & filename) const;
+
+private:
+  StagesProfiler() = default;
+
+  mutable std::mutex m_mutex;
+  std::map<std::string, StageUsage> m_stages;
+};
+}  // namespace generator
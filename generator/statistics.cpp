@@ -2,15 +2,25 @@
 
 #include "indexer/classificator.hpp"
 #include "indexer/data_factory.hpp"
+#include "indexer/feature_covering.hpp"
 #include "indexer/feature_impl.hpp"
 #include "indexer/feature_processor.hpp"
+#include "indexer/features_offsets_table.hpp"
+#include "indexer/scale_index.hpp"
 
+#include "geometry/mercator.hpp"
 #include "geometry/triangle2d.hpp"
 
 #include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
+#include "defines.hpp"
+
+#include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <vector>
 
 using namespace feature;
 using namespace std;
@@ -206,4 +216,106 @@ namespace stats
       PrintInfo(os, GetKey(it->first).c_str(), it->second, true);
     }
   }
+
+  void PrintPagesStatistic(std::ostream & os, std::string const & fPath, int zoom)
+  {
+    uint32_t constexpr kPageSize = 4096;
+
+    FilesContainerR cont(fPath);
+    IndexFactory factory;
+    factory.Load(cont);
+    auto const table = FeaturesOffsetsTable::Load(cont);
+    if (!table)
+    {
+      LOG(LWARNING, ("No features offsets table in", fPath));
+      return;
+    }
+
+    ScaleIndex<ModelReaderPtr> index(cont.GetReader(INDEX_FILE_TAG), factory);
+    DataHeader const & header = factory.GetHeader();
+    int const scale = min(zoom, header.GetLastScale());
+
+    m2::RectD const bounds = header.GetBounds();
+    double const tileSize = mercator::Bounds::kRangeX / (1 << zoom);
+    auto const toTile = [tileSize](double coord, double min) {
+      return static_cast<int64_t>(floor((coord - min) / tileSize));
+    };
+
+    vector<size_t> tilesPages;
+    uint64_t featuresCount = 0;
+    vector<uint32_t> features;
+    vector<uint32_t> indices;
+    vector<uint32_t> offsets;
+    for (auto x = toTile(bounds.minX(), mercator::Bounds::kMinX);
+         x <= toTile(bounds.maxX(), mercator::Bounds::kMinX); ++x)
+    {
+      for (auto y = toTile(bounds.minY(), mercator::Bounds::kMinY);
+           y <= toTile(bounds.maxY(), mercator::Bounds::kMinY); ++y)
+      {
+        m2::RectD const tile(mercator::Bounds::kMinX + x * tileSize,
+                             mercator::Bounds::kMinY + y * tileSize,
+                             mercator::Bounds::kMinX + (x + 1) * tileSize,
+                             mercator::Bounds::kMinY + (y + 1) * tileSize);
+        covering::CoveringGetter cov(tile, covering::ViewportWithLowLevels);
+        features.clear();
+        index.ForEachInIntervalsAndScale(cov.Get<RectId::DEPTH_LEVELS>(header.GetLastScale()),
+                                         scale, [&features](uint64_t /* key */, uint32_t value) {
+                                           features.push_back(value);
+                                         });
+        base::SortUnique(features);
+        if (features.empty())
+          continue;
+
+        // A feature record ends where the next one begins, the last record is counted by its
+        // first page.
+        indices.clear();
+        for (auto const f : features)
+        {
+          if (indices.empty() || indices.back() != f)
+            indices.push_back(f);
+          if (f + 1 < table->size())
+            indices.push_back(f + 1);
+        }
+        offsets.clear();
+        table->GetFeatureOffsets(indices, offsets);
+
+        vector<uint32_t> pages;
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+          if (!binary_search(features.cbegin(), features.cend(), indices[i]))
+            continue;
+
+          uint32_t const beg = offsets[i] / kPageSize;
+          uint32_t const end =
+              i + 1 < indices.size() && indices[i + 1] == indices[i] + 1
+                  ? (offsets[i + 1] - 1) / kPageSize
+                  : beg;
+          for (uint32_t page = beg; page <= end; ++page)
+            pages.push_back(page);
+        }
+        base::SortUnique(pages);
+
+        tilesPages.push_back(pages.size());
+        featuresCount += features.size();
+      }
+    }
+
+    if (tilesPages.empty())
+    {
+      os << "No features at zoom " << zoom << '\n';
+      return;
+    }
+
+    sort(tilesPages.begin(), tilesPages.end());
+    uint64_t pagesCount = 0;
+    for (auto const pages : tilesPages)
+      pagesCount += pages;
+
+    os << "Zoom: " << zoom << "; tiles = " << tilesPages.size()
+       << "; features per tile = " << static_cast<double>(featuresCount) / tilesPages.size()
+       << "; pages per tile: mean = " << static_cast<double>(pagesCount) / tilesPages.size()
+       << ", median = " << tilesPages[tilesPages.size() / 2]
+       << ", max = " << tilesPages.back()
+       << "; features per page = " << static_cast<double>(featuresCount) / pagesCount << '\n';
+  }
 }
@@ -60,4 +60,8 @@ namespace stats
   void CalcStatistic(std::string const & fPath, MapInfo & info);
   void PrintStatistic(std::ostream & os, MapInfo & info);
   void PrintTypeStatistic(std::ostream & os, MapInfo & info);
+
+  /// Prints how many pages of the features section are touched by reading the features of
+  /// every tile of |zoom| which intersects the mwm bounds. Used to compare the features orders.
+  void PrintPagesStatistic(std::ostream & os, std::string const & fPath, int zoom);
 }
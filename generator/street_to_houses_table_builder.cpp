@@ -0,0 +1,86 @@
+#include "generator/street_to_houses_table_builder.hpp"
+
+#include "search/features_layer_matcher.hpp"
+#include "search/mwm_context.hpp"
+#include "search/street_to_houses_table.hpp"
+
+#include "indexer/data_source.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_processor.hpp"
+
+#include "platform/local_country_file.hpp"
+
+#include "coding/files_container.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include "defines.hpp"
+
+#include <cstdint>
+
+namespace search
+{
+bool BuildStreetToHousesTable(std::string const & filename)
+{
+  try
+  {
+    {
+      FilesContainerR const readContainer(filename);
+      if (!readContainer.IsExist(SEARCH_ADDRESS_FILE_TAG))
+      {
+        LOG(LINFO, ("No address section in", filename, ", street to houses table is skipped."));
+        return true;
+      }
+    }
+
+    StreetToHousesTableBuilder builder;
+    uint32_t houses = 0;
+    {
+      // The mwm is released before the writing of the section.
+      FrozenDataSource dataSource;
+      auto const regResult =
+          dataSource.RegisterMap(platform::LocalCountryFile::MakeTemporary(filename));
+      if (regResult.second != MwmSet::RegResult::Success)
+      {
+        LOG(LERROR, ("Can't register", filename));
+        return false;
+      }
+
+      MwmContext context(dataSource.GetMwmHandleById(regResult.first));
+      base::Cancellable const cancellable;
+      // The houses are assigned to the streets in the same way as they are matched at the
+      // search time.
+      FeaturesLayerMatcher matcher(dataSource, cancellable);
+      matcher.SetContext(&context);
+
+      feature::ForEachFeature(filename, [&](FeatureType & ft, uint32_t featureId) {
+        auto const houseNumber = ft.GetHouseNumber();
+        if (houseNumber.empty())
+          return;
+
+        auto const streetId = matcher.GetMatchingStreet(featureId);
+        if (streetId == FeaturesLayerMatcher::kInvalidId)
+          return;
+
+        builder.Put(streetId, featureId, strings::MakeUniString(houseNumber));
+        ++houses;
+      });
+    }
+
+    FilesContainerW writeContainer(filename, FileWriter::OP_WRITE_EXISTING);
+    auto writer = writeContainer.GetWriter(STREET_HOUSES_FILE_TAG);
+    builder.Freeze(*writer);
+    LOG(LINFO, ("Street to houses table: houses count:", houses));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Failed to build street to houses table:", e.Msg()));
+    return false;
+  }
+
+  return true;
+}
+}  // namespace search
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+namespace search
+{
+// Builds the section with the houses of the streets and writes it to the mwm file. The search
+// index and the address sections must be built already.
+bool BuildStreetToHousesTable(std::string const & filename);
+}  // namespace search
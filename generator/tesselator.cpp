@@ -16,8 +16,83 @@
 
 namespace tesselator
 {
-int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info)
+namespace
 {
+int Sign(double v) { return v > 0.0 ? 1 : (v < 0.0 ? -1 : 0); }
+
+// Returns true if |contour| without the closing point is a strictly convex polygon, i.e. all
+// its turns are made in the same direction and it goes around only once.
+bool IsStrictlyConvex(PointsT const & contour, size_t count)
+{
+  int orientation = 0;
+  int prevDx = 0;
+  int firstDx = 0;
+  size_t dxChanges = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto const & p1 = contour[i];
+    auto const & p2 = contour[(i + 1) % count];
+    auto const & p3 = contour[(i + 2) % count];
+
+    int const turn = Sign(m2::robust::OrientedS(p1, p2, p3));
+    if (turn == 0 || (orientation != 0 && turn != orientation))
+      return false;
+    orientation = turn;
+
+    // A convex polygon changes its direction along x axis at most twice. This check rejects
+    // star-shaped polygons which turn in the same direction all the time.
+    int const dx = Sign(p2.x - p1.x);
+    if (dx == 0)
+      continue;
+    if (firstDx == 0)
+      firstDx = dx;
+    else if (dx != prevDx)
+      ++dxChanges;
+    prevDx = dx;
+  }
+
+  if (prevDx != firstDx)
+    ++dxChanges;
+  return dxChanges <= 2;
+}
+
+// Fast path for the single contour strictly convex polygons, most of the buildings are such.
+// The polygon is triangulated as a fan in the orientation of the contour, the same way as
+// libtess orients its triangles. Returns 0 if the polygon is not such.
+int TesselateConvex(PolygonsT const & polys, TrianglesInfo & info)
+{
+  if (polys.size() != 1)
+    return 0;
+
+  auto const & contour = polys.front();
+  size_t count = contour.size();
+  if (count > 1 && contour.front() == contour.back())
+    --count;
+  if (count < 3 || !IsStrictlyConvex(contour, count))
+    return 0;
+
+  info.AssignPoints(contour.begin(), contour.begin() + count);
+  int const trianglesCount = static_cast<int>(count) - 2;
+  info.Reserve(trianglesCount);
+  for (int i = 1; i <= trianglesCount; ++i)
+    info.Add(0, i, i + 1);
+  return trianglesCount;
+}
+}  // namespace
+
+int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info, Stats * stats)
+{
+  int const convexCount = TesselateConvex(polys, info);
+  if (convexCount != 0)
+  {
+    if (stats)
+      ++stats->m_convex;
+    return convexCount;
+  }
+
+  if (stats)
+    ++stats->m_generic;
+
   int constexpr kCoordinatesPerVertex = 2;
   int constexpr kVerticesInPolygon = 3;
 
@@ -4,6 +4,8 @@
 
 #include "geometry/point2d.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <list>
@@ -181,7 +183,16 @@ namespace tesselator
     }
   };
 
+  /// Numbers of the polygons triangulated by the convex fast path and by libtess.
+  struct Stats
+  {
+    std::atomic<uint64_t> m_convex{0};
+    std::atomic<uint64_t> m_generic{0};
+  };
+
   /// Main tesselate function.
+  /// Strictly convex polygons without holes are triangulated as fans without libtess.
+  /// @param stats is updated if it's not null, it may be shared by several threads.
   /// @returns number of resulting triangles after triangulation.
-  int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info);
+  int TesselateInterior(PolygonsT const & polys, TrianglesInfo & info, Stats * stats = nullptr);
 }
@@ -14,6 +14,16 @@ void AreaWayMerger::AddWay(uint64_t id)
   {
     m_map.emplace(e->m_nodes.front(), e);
     m_map.emplace(e->m_nodes.back(), e);
+    m_nodesToPrefetch.insert(m_nodesToPrefetch.end(), e->m_nodes.begin(), e->m_nodes.end());
   }
 }
+
+void AreaWayMerger::PrefetchNodes()
+{
+  if (m_nodesToPrefetch.empty())
+    return;
+
+  m_cache->PrefetchNodes(m_nodesToPrefetch);
+  m_nodesToPrefetch.clear();
+}
 }  // namespace generator
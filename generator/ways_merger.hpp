@@ -23,10 +23,15 @@ public:
   explicit AreaWayMerger(std::shared_ptr<cache::IntermediateDataReaderInterface> const & cache);
 
   void AddWay(uint64_t id);
+  /// Prefetches the nodes of the ways added since the previous call. Ways of a relation are
+  /// scattered over the node storage, so the prefetch is issued for all of them at once
+  /// before the areas are assembled.
+  void PrefetchNodes();
 
   template <class ToDo>
   void ForEachArea(bool collectID, ToDo && toDo)
   {
+    PrefetchNodes();
     while (!m_map.empty())
     {
       // start
@@ -78,5 +83,6 @@ public:
 private:
   std::shared_ptr<cache::IntermediateDataReaderInterface> m_cache;
   WayMap m_map;
+  std::vector<uint64_t> m_nodesToPrefetch;
 };
 }  // namespace generator
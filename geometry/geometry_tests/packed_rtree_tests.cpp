@@ -0,0 +1,145 @@
+#include "testing/testing.hpp"
+
+#include "geometry/packed_rtree.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+struct RectTraits
+{
+  m2::RectD LimitRect(m2::RectD const & r) const { return r; }
+};
+
+vector<m2::RectD> MakeRects(size_t count, mt19937 & rng)
+{
+  uniform_real_distribution<double> coord(-100.0, 100.0);
+  uniform_real_distribution<double> size(0.0, 5.0);
+  vector<m2::RectD> rects;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double const x = coord(rng);
+    double const y = coord(rng);
+    rects.emplace_back(x, y, x + size(rng), y + size(rng));
+  }
+  return rects;
+}
+
+vector<uint32_t> QueryTree(m4::Tree<uint32_t, m4::TraitsDef<uint32_t>> const & tree,
+                           m2::RectD const & rect)
+{
+  vector<uint32_t> res;
+  tree.ForEachInRect(rect, [&res](uint32_t index) { res.push_back(index); });
+  sort(res.begin(), res.end());
+  return res;
+}
+
+vector<uint32_t> QueryPacked(m4::PackedRTree const & tree, m2::RectD const & rect)
+{
+  vector<uint32_t> res;
+  tree.ForEachInRect(rect, [&res](uint32_t index) { res.push_back(index); });
+  sort(res.begin(), res.end());
+  return res;
+}
+}  // namespace
+
+UNIT_TEST(PackedRTree_Empty)
+{
+  m4::PackedRTree tree;
+  tree.Build({});
+  TEST(tree.IsEmpty(), ());
+  TEST(QueryPacked(tree, m2::RectD(0, 0, 1, 1)).empty(), ());
+}
+
+UNIT_TEST(PackedRTree_Smoke)
+{
+  vector<m2::RectD> const rects = {m2::RectD(0, 0, 1, 1), m2::RectD(1, 1, 2, 2),
+                                   m2::RectD(2, 2, 3, 3)};
+  m4::PackedRTree tree;
+  tree.Build(rects);
+  TEST_EQUAL(tree.GetSize(), 3, ());
+
+  TEST_EQUAL(QueryPacked(tree, m2::RectD(0.5, 0.5, 1.5, 1.5)), vector<uint32_t>({0, 1}), ());
+  // Touching rects do not intersect, as in m4::Tree.
+  TEST_EQUAL(QueryPacked(tree, m2::RectD(3, 3, 4, 4)), vector<uint32_t>(), ());
+  TEST_EQUAL(QueryPacked(tree, m2::RectD(-1, -1, 4, 4)), vector<uint32_t>({0, 1, 2}), ());
+}
+
+UNIT_TEST(PackedRTree_CompareWithTree4D)
+{
+  mt19937 rng(0);
+  for (size_t const count : {1, 15, 16, 17, 300, 5000})
+  {
+    auto const rects = MakeRects(count, rng);
+    m4::Tree<uint32_t, m4::TraitsDef<uint32_t>> tree;
+    for (uint32_t i = 0; i < rects.size(); ++i)
+      tree.Add(i, rects[i]);
+
+    m4::PackedRTree packed;
+    packed.Build(rects);
+
+    for (auto const & query : MakeRects(100, rng))
+    {
+      auto rect = query;
+      rect.Inflate(query.SizeX() * 2, query.SizeY() * 2);
+      TEST_EQUAL(QueryTree(tree, rect), QueryPacked(packed, rect), (count, rect));
+    }
+  }
+}
+
+UNIT_TEST(PackedRTree_Serialization)
+{
+  mt19937 rng(1);
+  auto const rects = MakeRects(1000, rng);
+  m4::PackedRTree tree;
+  tree.Build(rects);
+
+  struct VectorSink
+  {
+    void Write(void const * p, size_t size)
+    {
+      auto const * bytes = static_cast<uint8_t const *>(p);
+      m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+    vector<uint8_t> m_data;
+  } sink;
+  tree.Serialize(sink);
+  TEST_EQUAL(sink.m_data.size(), tree.GetSerializedSize(), ());
+
+  // Deserialized tree needs the aligned memory.
+  vector<double> buffer((sink.m_data.size() + sizeof(double) - 1) / sizeof(double));
+  copy(sink.m_data.begin(), sink.m_data.end(), reinterpret_cast<uint8_t *>(buffer.data()));
+
+  m4::PackedRTree deserialized;
+  deserialized.Deserialize(buffer.data());
+  TEST_EQUAL(deserialized.GetSize(), tree.GetSize(), ());
+  for (auto const & rect : MakeRects(100, rng))
+    TEST_EQUAL(QueryPacked(tree, rect), QueryPacked(deserialized, rect), (rect));
+}
+
+UNIT_TEST(PackedTree_Smoke)
+{
+  m4::PackedTree<m2::RectD, RectTraits> tree;
+  tree.Add(m2::RectD(0, 0, 1, 1));
+  tree.Add(m2::RectD(5, 5, 6, 6));
+  tree.Build();
+  TEST_EQUAL(tree.GetSize(), 2, ());
+
+  vector<m2::RectD> found;
+  tree.ForEachInRect(m2::RectD(0.5, 0.5, 2, 2),
+                     [&found](m2::RectD const & r) { found.push_back(r); });
+  TEST_EQUAL(found, vector<m2::RectD>({m2::RectD(0, 0, 1, 1)}), ());
+
+  vector<size_t> queries;
+  tree.ForEachInRects(
+      {m2::RectD(-1, -1, 0.5, 0.5), m2::RectD(10, 10, 11, 11), m2::RectD(4, 4, 7, 7)},
+      [&queries](size_t i, m2::RectD const &) { queries.push_back(i); });
+  TEST_EQUAL(queries, vector<size_t>({0, 2}), ());
+}
@@ -0,0 +1,95 @@
+#include "testing/testing.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/points_batch.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/math.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+m2::PointsBatch MakeBatch(vector<m2::PointD> const & points)
+{
+  m2::PointsBatch batch;
+  for (auto const & p : points)
+    batch.Add(p);
+  return batch;
+}
+
+vector<m2::PointD> MakeRandomPoints(size_t count)
+{
+  mt19937 rng(42);
+  uniform_real_distribution<double> coord(-80.0, 80.0);
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < count; ++i)
+    points.emplace_back(coord(rng), coord(rng));
+  // Degenerate segment.
+  points.push_back(points.back());
+  return points;
+}
+
+UNIT_TEST(PointsBatch_IsPointsInside)
+{
+  m2::RectD const rect(-1.0, -2.0, 3.0, 4.0);
+  vector<m2::PointD> const points = {{0.0, 0.0}, {-1.0, -2.0}, {3.0, 4.0}, {3.1, 0.0},
+                                     {0.0, -2.1}, {-5.0, 10.0}};
+  vector<uint8_t> inside;
+  m2::IsPointsInside(rect, MakeBatch(points), inside);
+  TEST_EQUAL(inside.size(), points.size(), ());
+  for (size_t i = 0; i < points.size(); ++i)
+    TEST_EQUAL(inside[i] != 0, rect.IsPointInside(points[i]), (i));
+
+  m2::IsPointsInside(rect, m2::PointsBatch(), inside);
+  TEST(inside.empty(), ());
+}
+
+UNIT_TEST(PointsBatch_SquaredDistances)
+{
+  auto const points = MakeRandomPoints(100);
+  m2::PointD const p(1.0, 2.0);
+
+  vector<double> distances;
+  m2::SquaredDistances(p, MakeBatch(points), distances);
+  TEST_EQUAL(distances.size(), points.size(), ());
+  for (size_t i = 0; i < points.size(); ++i)
+    TEST_ALMOST_EQUAL_ABS(distances[i], p.SquaredLength(points[i]), 1e-9, (i));
+}
+
+UNIT_TEST(PointsBatch_SquaredDistancesToSegments)
+{
+  auto const points = MakeRandomPoints(100);
+  m2::PointD const p(1.0, 2.0);
+
+  vector<double> distances;
+  m2::SquaredDistancesToSegments(p, MakeBatch(points), distances);
+  TEST_EQUAL(distances.size(), points.size() - 1, ());
+  for (size_t i = 0; i + 1 < points.size(); ++i)
+  {
+    m2::ParametrizedSegment<m2::PointD> const segment(points[i], points[i + 1]);
+    TEST_ALMOST_EQUAL_ABS(distances[i], segment.SquaredDistanceToPoint(p), 1e-6, (i));
+  }
+
+  m2::SquaredDistancesToSegments(p, MakeBatch({p}), distances);
+  TEST(distances.empty(), ());
+}
+
+UNIT_TEST(PointsBatch_DistancesOnEarth)
+{
+  auto const points = MakeRandomPoints(100);
+  m2::PointD const p(37.6, 67.4);
+
+  vector<double> distances;
+  mercator::DistancesOnEarth(p, MakeBatch(points), distances);
+  TEST_EQUAL(distances.size(), points.size(), ());
+  for (size_t i = 0; i < points.size(); ++i)
+    TEST_ALMOST_EQUAL_ABS(distances[i], mercator::DistanceOnEarth(p, points[i]), 1e-3, (i));
+}
+}  // namespace
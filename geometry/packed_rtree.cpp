@@ -0,0 +1,139 @@
+#include "geometry/packed_rtree.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+using namespace std;
+
+namespace m4
+{
+namespace
+{
+// Position of (x, y) on the Hilbert curve of order 16.
+uint32_t HilbertIndex(uint32_t x, uint32_t y)
+{
+  uint32_t d = 0;
+  for (uint32_t s = 1 << 15; s > 0; s >>= 1)
+  {
+    uint32_t const rx = (x & s) > 0 ? 1 : 0;
+    uint32_t const ry = (y & s) > 0 ? 1 : 0;
+    d += s * s * ((3 * rx) ^ ry);
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = s - 1 - x;
+        y = s - 1 - y;
+      }
+      swap(x, y);
+    }
+  }
+  return d;
+}
+}  // namespace
+
+void PackedRTree::Build(vector<m2::RectD> const & rects)
+{
+  CHECK_LESS(rects.size(), numeric_limits<uint32_t>::max() / 2, ());
+  m_itemsCount = static_cast<uint32_t>(rects.size());
+  InitLevelBounds();
+
+  size_t const boxesCount = GetBoxesCount();
+  m_boxesStorage.assign(4 * boxesCount, 0.0);
+  m_indicesStorage.assign(boxesCount, 0);
+  m_boxes = m_boxesStorage.data();
+  m_indices = m_indicesStorage.data();
+  if (m_itemsCount == 0)
+    return;
+
+  m2::RectD bounds;
+  for (auto const & r : rects)
+    bounds.Add(r);
+
+  double const maxCoord = numeric_limits<uint16_t>::max();
+  double const scaleX = bounds.SizeX() > 0 ? maxCoord / bounds.SizeX() : 0.0;
+  double const scaleY = bounds.SizeY() > 0 ? maxCoord / bounds.SizeY() : 0.0;
+  vector<uint32_t> hilbert(rects.size());
+  for (size_t i = 0; i < rects.size(); ++i)
+  {
+    auto const center = rects[i].Center();
+    hilbert[i] = HilbertIndex(static_cast<uint32_t>((center.x - bounds.minX()) * scaleX),
+                              static_cast<uint32_t>((center.y - bounds.minY()) * scaleY));
+  }
+
+  vector<uint32_t> order(rects.size());
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(),
+       [&hilbert](uint32_t lhs, uint32_t rhs) { return hilbert[lhs] < hilbert[rhs]; });
+
+  auto const setBox = [this](size_t pos, m2::RectD const & r) {
+    m_boxesStorage[4 * pos] = r.minX();
+    m_boxesStorage[4 * pos + 1] = r.minY();
+    m_boxesStorage[4 * pos + 2] = r.maxX();
+    m_boxesStorage[4 * pos + 3] = r.maxY();
+  };
+
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    setBox(i, rects[order[i]]);
+    m_indicesStorage[i] = order[i];
+  }
+
+  uint32_t pos = 0;
+  uint32_t writePos = m_levelBounds[0];
+  for (size_t level = 0; level + 1 < m_levelBounds.size(); ++level)
+  {
+    for (; pos < m_levelBounds[level]; pos += kNodeSize)
+    {
+      auto const end = min(pos + kNodeSize, m_levelBounds[level]);
+      m2::RectD box;
+      for (uint32_t child = pos; child < end; ++child)
+      {
+        box.Add(m2::RectD(m_boxes[4 * child], m_boxes[4 * child + 1], m_boxes[4 * child + 2],
+                          m_boxes[4 * child + 3]));
+      }
+      setBox(writePos, box);
+      m_indicesStorage[writePos] = pos;
+      ++writePos;
+    }
+    pos = m_levelBounds[level];
+  }
+  ASSERT_EQUAL(writePos, boxesCount, ());
+}
+
+void PackedRTree::Deserialize(void const * data)
+{
+  auto const * header = static_cast<uint32_t const *>(data);
+  ASSERT_EQUAL(reinterpret_cast<uintptr_t>(data) % sizeof(double), 0, ());
+  m_itemsCount = header[0];
+  InitLevelBounds();
+
+  m_boxesStorage.clear();
+  m_indicesStorage.clear();
+  m_boxes = reinterpret_cast<double const *>(header + 2);
+  m_indices = reinterpret_cast<uint32_t const *>(m_boxes + 4 * GetBoxesCount());
+}
+
+size_t PackedRTree::GetSerializedSize() const
+{
+  return 2 * sizeof(uint32_t) + GetBoxesCount() * (4 * sizeof(double) + sizeof(uint32_t));
+}
+
+void PackedRTree::InitLevelBounds()
+{
+  m_levelBounds.clear();
+  if (m_itemsCount == 0)
+    return;
+
+  uint32_t count = m_itemsCount;
+  uint32_t boxesCount = count;
+  m_levelBounds.push_back(boxesCount);
+  do
+  {
+    count = (count + kNodeSize - 1) / kNodeSize;
+    boxesCount += count;
+    m_levelBounds.push_back(boxesCount);
+  } while (count != 1);
+}
+}  // namespace m4
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace m4
+{
+// Static R-tree packed in the Hilbert order of the rect centers. It is built once from all
+// the rects and is not modified after that. Nodes are stored level by level in flat arrays,
+// so queries do not chase pointers and the tree takes much less memory than m4::Tree.
+// The serialized tree can be used right from the mapped memory.
+// Items are identified by their indices in the rects vector passed to Build().
+class PackedRTree
+{
+public:
+  static uint32_t constexpr kNodeSize = 16;
+
+  void Build(std::vector<m2::RectD> const & rects);
+
+  // Uses the tree serialized by Serialize() from |data| without copying.
+  // |data| must be 8 bytes aligned and must outlive the tree.
+  void Deserialize(void const * data);
+
+  // Format: uint32 items count, uint32 padding, boxes as 4 doubles (min x, min y, max x, max y),
+  // uint32 indices. Boxes and indices are in the native endianness.
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    uint32_t const header[2] = {m_itemsCount, 0};
+    sink.Write(header, sizeof(header));
+    sink.Write(m_boxes, GetBoxesCount() * 4 * sizeof(double));
+    sink.Write(m_indices, GetBoxesCount() * sizeof(uint32_t));
+  }
+
+  // Returns the size of the serialized tree in bytes.
+  size_t GetSerializedSize() const;
+
+  // Calls |fn(index)| for the items whose rects intersect |rect|,
+  // with the same intersection rule as m4::Tree.
+  template <typename Fn>
+  void ForEachInRect(m2::RectD const & rect, Fn && fn) const
+  {
+    if (m_itemsCount == 0)
+      return;
+
+    // Pairs of a node start and its level.
+    std::vector<std::pair<uint32_t, uint32_t>> & queue = m_queue;
+    queue.clear();
+    queue.emplace_back(static_cast<uint32_t>(GetBoxesCount() - 1),
+                       static_cast<uint32_t>(m_levelBounds.size() - 1));
+    while (!queue.empty())
+    {
+      auto const node = queue.back();
+      queue.pop_back();
+
+      auto const end = std::min(node.first + kNodeSize, m_levelBounds[node.second]);
+      for (uint32_t pos = node.first; pos < end; ++pos)
+      {
+        double const * box = m_boxes + 4 * pos;
+        if (box[2] <= rect.minX() || box[0] >= rect.maxX() || box[3] <= rect.minY() ||
+            box[1] >= rect.maxY())
+        {
+          continue;
+        }
+
+        if (node.second == 0)
+          fn(m_indices[pos]);
+        else
+          queue.emplace_back(m_indices[pos], node.second - 1);
+      }
+    }
+  }
+
+  uint32_t GetSize() const { return m_itemsCount; }
+  bool IsEmpty() const { return m_itemsCount == 0; }
+
+private:
+  size_t GetBoxesCount() const { return m_levelBounds.empty() ? 0 : m_levelBounds.back(); }
+  void InitLevelBounds();
+
+  uint32_t m_itemsCount = 0;
+  // Ends of the levels in |m_boxes|, the leaves go first and the root is the last box.
+  std::vector<uint32_t> m_levelBounds;
+  double const * m_boxes = nullptr;
+  // Indices of the items for the leaves and positions of the first children for the nodes.
+  uint32_t const * m_indices = nullptr;
+
+  std::vector<double> m_boxesStorage;
+  std::vector<uint32_t> m_indicesStorage;
+
+  // Queries are not thread-safe because of this buffer.
+  mutable std::vector<std::pair<uint32_t, uint32_t>> m_queue;
+};
+
+// Static replacement of m4::Tree for the data which is built once and then only queried:
+// values are added first and Build() must be called before the queries.
+template <typename T, typename Traits = TraitsDef<T>>
+class PackedTree
+{
+public:
+  explicit PackedTree(Traits const & traits = Traits()) : m_traits(traits) {}
+
+  template <typename U>
+  void Add(U && obj)
+  {
+    Add(std::forward<U>(obj), m_traits.LimitRect(obj));
+  }
+
+  template <typename U>
+  void Add(U && obj, m2::RectD const & rect)
+  {
+    m_values.emplace_back(std::forward<U>(obj));
+    m_rects.push_back(rect);
+  }
+
+  void Build()
+  {
+    m_tree.Build(m_rects);
+    m_rects.clear();
+    m_rects.shrink_to_fit();
+  }
+
+  template <typename ToDo>
+  void ForEachInRect(m2::RectD const & rect, ToDo && toDo) const
+  {
+    ASSERT(m_rects.empty(), ("Build() must be called after Add()."));
+    m_tree.ForEachInRect(rect, [&](uint32_t index) { toDo(m_values[index]); });
+  }
+
+  // Calls |toDo(i, value)| for the values intersecting |rects[i]|.
+  template <typename ToDo>
+  void ForEachInRects(std::vector<m2::RectD> const & rects, ToDo && toDo) const
+  {
+    for (size_t i = 0; i < rects.size(); ++i)
+      ForEachInRect(rects[i], [&](T const & value) { toDo(i, value); });
+  }
+
+  template <typename ToDo>
+  void ForEach(ToDo && toDo) const
+  {
+    for (auto const & value : m_values)
+      toDo(value);
+  }
+
+  bool IsEmpty() const { return m_values.empty(); }
+  size_t GetSize() const { return m_values.size(); }
+
+private:
+  Traits m_traits;
+  std::vector<T> m_values;
+  // Rects of the values added after the last Build().
+  std::vector<m2::RectD> m_rects;
+  PackedRTree m_tree;
+};
+}  // namespace m4
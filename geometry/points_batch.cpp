@@ -0,0 +1,101 @@
+#include "geometry/points_batch.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+#include "geometry/mercator.hpp"
+
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace m2
+{
+void IsPointsInside(RectD const & rect, PointsBatch const & points, vector<uint8_t> & inside)
+{
+  size_t const count = points.Size();
+  inside.resize(count);
+
+  double const minX = rect.minX();
+  double const minY = rect.minY();
+  double const maxX = rect.maxX();
+  double const maxY = rect.maxY();
+  double const * xs = points.Xs();
+  double const * ys = points.Ys();
+  uint8_t * res = inside.data();
+  for (size_t i = 0; i < count; ++i)
+  {
+    res[i] = static_cast<uint8_t>((xs[i] >= minX) & (xs[i] <= maxX) & (ys[i] >= minY) &
+                                  (ys[i] <= maxY));
+  }
+}
+
+void SquaredDistances(PointD const & p, PointsBatch const & points, vector<double> & distances)
+{
+  size_t const count = points.Size();
+  distances.resize(count);
+
+  double const * xs = points.Xs();
+  double const * ys = points.Ys();
+  double * res = distances.data();
+  for (size_t i = 0; i < count; ++i)
+  {
+    double const dx = xs[i] - p.x;
+    double const dy = ys[i] - p.y;
+    res[i] = dx * dx + dy * dy;
+  }
+}
+
+void SquaredDistancesToSegments(PointD const & p, PointsBatch const & polyline,
+                                vector<double> & distances)
+{
+  size_t const count = polyline.Size() < 2 ? 0 : polyline.Size() - 1;
+  distances.resize(count);
+
+  double const * xs = polyline.Xs();
+  double const * ys = polyline.Ys();
+  double * res = distances.data();
+  for (size_t i = 0; i < count; ++i)
+  {
+    double const dx = xs[i + 1] - xs[i];
+    double const dy = ys[i + 1] - ys[i];
+    double const px = p.x - xs[i];
+    double const py = p.y - ys[i];
+    double const squaredLength = dx * dx + dy * dy;
+    // Projection of |p| to the segment line in the segment lengths, clamped to the segment.
+    double t = squaredLength > 0.0 ? (px * dx + py * dy) / squaredLength : 0.0;
+    t = min(max(t, 0.0), 1.0);
+    double const cx = px - t * dx;
+    double const cy = py - t * dy;
+    res[i] = cx * cx + cy * cy;
+  }
+}
+}  // namespace m2
+
+namespace mercator
+{
+void DistancesOnEarth(m2::PointD const & p, m2::PointsBatch const & points,
+                      vector<double> & distances)
+{
+  size_t const count = points.Size();
+  distances.resize(count);
+
+  double const lat1 = base::DegToRad(YToLat(p.y));
+  double const lon1 = base::DegToRad(XToLon(p.x));
+  double const cosLat1 = cos(lat1);
+
+  double const * xs = points.Xs();
+  double const * ys = points.Ys();
+  double * res = distances.data();
+  // The haversine formula of ms::DistanceOnSphere with the terms of |p| computed once.
+  for (size_t i = 0; i < count; ++i)
+  {
+    double const lat2 = 2.0 * atan(tanh(0.5 * base::DegToRad(ys[i])));
+    double const dlat = sin((lat2 - lat1) * 0.5);
+    double const dlon = sin((base::DegToRad(XToLon(xs[i])) - lon1) * 0.5);
+    double const y = dlat * dlat + dlon * dlon * cosLat1 * cos(lat2);
+    res[i] = ms::kEarthRadiusMeters * 2.0 * asin(sqrt(min(1.0, y)));
+  }
+}
+}  // namespace mercator
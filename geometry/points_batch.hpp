@@ -0,0 +1,75 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace m2
+{
+// Points in the structure of arrays layout. Loops of the batch operations below over
+// such points are vectorized by compilers, so the operations are faster than the same
+// scalar calls for every point.
+class PointsBatch
+{
+public:
+  void Clear()
+  {
+    m_xs.clear();
+    m_ys.clear();
+  }
+
+  void Reserve(size_t count)
+  {
+    m_xs.reserve(count);
+    m_ys.reserve(count);
+  }
+
+  void Add(PointD const & p)
+  {
+    m_xs.push_back(p.x);
+    m_ys.push_back(p.y);
+  }
+
+  PointD Get(size_t i) const
+  {
+    ASSERT_LESS(i, Size(), ());
+    return {m_xs[i], m_ys[i]};
+  }
+
+  size_t Size() const { return m_xs.size(); }
+  bool IsEmpty() const { return m_xs.empty(); }
+
+  double const * Xs() const { return m_xs.data(); }
+  double const * Ys() const { return m_ys.data(); }
+
+private:
+  std::vector<double> m_xs;
+  std::vector<double> m_ys;
+};
+
+// Sets |inside[i]| to 1 if |rect| contains i-th point and to 0 otherwise,
+// the same as RectD::IsPointInside.
+void IsPointsInside(RectD const & rect, PointsBatch const & points, std::vector<uint8_t> & inside);
+
+// Squared distances from |p| to |points|.
+void SquaredDistances(PointD const & p, PointsBatch const & points,
+                      std::vector<double> & distances);
+
+// Squared distances from |p| to the segments [polyline[i], polyline[i + 1]], the same as
+// ParametrizedSegment::SquaredDistanceToPoint.
+void SquaredDistancesToSegments(PointD const & p, PointsBatch const & polyline,
+                                std::vector<double> & distances);
+}  // namespace m2
+
+namespace mercator
+{
+// Distances in meters on the Earth from |p| to |points|, the same as DistanceOnEarth.
+// Points are in the mercator coordinates.
+void DistancesOnEarth(m2::PointD const & p, m2::PointsBatch const & points,
+                      std::vector<double> & distances);
+}  // namespace mercator
@@ -72,64 +72,74 @@ bool AltitudeLoader::HasAltitudes() const
 }
 
 geometry::Altitudes const & AltitudeLoader::GetAltitudes(uint32_t featureId, size_t pointCount)
+{
+  auto const it = m_cache.find(featureId);
+  if (it != m_cache.end())
+    return it->second;
+
+  auto & altitudes = m_cache[featureId];
+  GetAltitudes(featureId, pointCount, altitudes);
+  return altitudes;
+}
+
+void AltitudeLoader::GetAltitudes(uint32_t featureId, size_t pointCount,
+                                  geometry::Altitudes & altitudes)
 {
   if (!HasAltitudes())
   {
     // There's no altitude section in mwm.
-    return m_cache
-        .insert(
-            make_pair(featureId, geometry::Altitudes(pointCount, geometry::kDefaultAltitudeMeters)))
-        .first->second;
+    altitudes.assign(pointCount, geometry::kDefaultAltitudeMeters);
+    return;
   }
 
-  auto const it = m_cache.find(featureId);
-  if (it != m_cache.end())
-    return it->second;
-
   if (!m_altitudeAvailability[featureId])
   {
-    return m_cache
-        .insert(make_pair(featureId, geometry::Altitudes(pointCount, m_header.m_minAltitude)))
-        .first->second;
+    altitudes.assign(pointCount, m_header.m_minAltitude);
+    return;
   }
 
   uint64_t const r = m_altitudeAvailability.rank(featureId);
   CHECK_LESS(r, m_altitudeAvailability.size(), ("Feature Id", featureId, "of", m_countryFileName));
   uint64_t const offset = m_featureTable.select(r);
   CHECK_LESS_OR_EQUAL(offset, m_featureTable.size(), ("Feature Id", featureId, "of", m_countryFileName));
+  // The altitudes of the feature end where the altitudes of the next feature start.
+  uint64_t const endOffset = r + 1 < m_featureTable.num_ones() ? m_featureTable.select(r + 1)
+                                                                : m_header.GetAltitudeInfoSize();
+  CHECK_LESS(offset, endOffset, ("Feature Id", featureId, "of", m_countryFileName));
 
   uint64_t const altitudeInfoOffsetInSection = m_header.m_altitudesOffset + offset;
   CHECK_LESS(altitudeInfoOffsetInSection, m_reader->Size(), ("Feature Id", featureId, "of", m_countryFileName));
 
   try
   {
-    Altitudes altitudes;
-    ReaderSource<FilesContainerR::TReader> src(*m_reader);
-    src.Skip(altitudeInfoOffsetInSection);
-    bool const isDeserialized = altitudes.Deserialize(m_header.m_minAltitude, pointCount,
-                                                      m_countryFileName, featureId,  src);
+    // The bit reader reads the altitudes byte by byte, so they are read from the section at once
+    // and decoded from memory.
+    m_buffer.resize(static_cast<size_t>(endOffset - offset));
+    m_reader->Read(altitudeInfoOffsetInSection, m_buffer.data(), m_buffer.size());
+    MemReader reader(m_buffer.data(), m_buffer.size());
+    ReaderSource<MemReader> src(reader);
+
+    Altitudes featureAltitudes;
+    featureAltitudes.m_altitudes = move(altitudes);
+    bool const isDeserialized = featureAltitudes.Deserialize(m_header.m_minAltitude, pointCount,
+                                                             m_countryFileName, featureId, src);
+    altitudes = move(featureAltitudes.m_altitudes);
 
     bool const allValid =
         isDeserialized &&
-        none_of(altitudes.m_altitudes.begin(), altitudes.m_altitudes.end(),
+        none_of(altitudes.begin(), altitudes.end(),
                 [](geometry::Altitude a) { return a == geometry::kInvalidAltitude; });
     if (!allValid)
     {
-      LOG(LERROR, ("Only a part point of a feature has a valid altitdue. Altitudes: ", altitudes.m_altitudes,
+      LOG(LERROR, ("Only a part point of a feature has a valid altitdue. Altitudes: ", altitudes,
                    ". Feature Id", featureId, "of", m_countryFileName));
-      return m_cache
-          .insert(make_pair(featureId, geometry::Altitudes(pointCount, m_header.m_minAltitude)))
-          .first->second;
+      altitudes.assign(pointCount, m_header.m_minAltitude);
     }
-
-    return m_cache.insert(make_pair(featureId, move(altitudes.m_altitudes))).first->second;
   }
-  catch (Reader::OpenException const & e)
+  catch (Reader::Exception const & e)
   {
     LOG(LERROR, ("Feature Id", featureId, "of", m_countryFileName, ". Error while getting altitude data:", e.Msg()));
-    return m_cache
-        .insert(make_pair(featureId, geometry::Altitudes(pointCount, m_header.m_minAltitude)))
-        .first->second;
+    altitudes.assign(pointCount, m_header.m_minAltitude);
   }
 }
 }  // namespace feature
@@ -30,6 +30,9 @@ public:
   /// \returns altitude of feature with |featureId|. All items of the returned vector are valid
   /// or the returned vector is empty.
   geometry::Altitudes const & GetAltitudes(uint32_t featureId, size_t pointCount);
+  /// \brief Same as above but fills |altitudes| and does not cache them. The altitudes of a
+  /// feature are read from the section with one read call.
+  void GetAltitudes(uint32_t featureId, size_t pointCount, geometry::Altitudes & altitudes);
 
   bool HasAltitudes() const;
 
@@ -43,6 +46,8 @@ private:
   succinct::elias_fano m_featureTable;
 
   std::unique_ptr<FilesContainerR::TReader> m_reader;
+  // Encoded altitudes of the feature being decoded.
+  std::vector<uint8_t> m_buffer;
   std::map<uint32_t, geometry::Altitudes> m_cache;
   AltitudeHeader m_header;
   std::string m_countryFileName;
@@ -429,6 +429,13 @@ void Classificator::Clear()
   m_mapping.Clear();
 }
 
+void Classificator::CopyFrom(Classificator const & c)
+{
+  m_root = c.m_root;
+  m_mapping = c.m_mapping;
+  m_coastType = c.m_coastType;
+}
+
 string Classificator::GetReadableObjectName(uint32_t type) const
 {
   string s = GetFullObjectName(type);
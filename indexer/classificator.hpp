@@ -169,6 +169,9 @@ public:
   //@}
 
   void Clear();
+  /// Replaces the tree and the types mapping with the ones of |c|. It is much faster than
+  /// reading them again, but it is valid only before the drawing rules are loaded.
+  void CopyFrom(Classificator const & c);
 
   bool HasTypesMapping() const { return m_mapping.IsLoaded(); }
 
@@ -17,9 +17,8 @@
 namespace
 {
 void ReadCommon(std::unique_ptr<Reader> classificator,
-                std::unique_ptr<Reader> types)
+                std::unique_ptr<Reader> types, Classificator & c)
 {
-  Classificator & c = classif();
   c.Clear();
 
   {
@@ -50,6 +49,11 @@ void Load()
 
   MapStyle const originMapStyle = GetStyleReader().GetCurrentStyle();
 
+  // Classificator and types mapping are the same for all the styles, so they are parsed once
+  // and copied to the classificators of the styles. Only drawing rules differ.
+  Classificator common;
+  ReadCommon(p.GetReader("classificator.txt"), p.GetReader("types.txt"), common);
+
   for (size_t i = 0; i < MapStyleCount; ++i)
   {
     auto const mapStyle = static_cast<MapStyle>(i);
@@ -57,8 +61,7 @@ void Load()
     if (mapStyle != MapStyleMerged || originMapStyle == MapStyleMerged)
     {
       GetStyleReader().SetCurrentStyle(mapStyle);
-      ReadCommon(p.GetReader("classificator.txt"),
-                 p.GetReader("types.txt"));
+      classif().CopyFrom(common);
 
       drule::LoadRules();
     }
@@ -75,6 +78,7 @@ void LoadTypes(std::string const & classificatorFileStr,
   ReadCommon(std::make_unique<MemReaderWithExceptions>(classificatorFileStr.data(),
                                                        classificatorFileStr.size()),
              std::make_unique<MemReaderWithExceptions>(typesFileStr.data(),
-                                                       typesFileStr.size()));
+                                                       typesFileStr.size()),
+             classif());
 }
 }  // namespace classificator
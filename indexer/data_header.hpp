@@ -47,6 +47,8 @@ namespace feature
       return m_codingParams;
     }
 
+    // Geometry of the less detailed scales is stored with less precision: every two scales
+    // below the most detailed one take one bit off the coordinates.
     serial::GeometryCodingParams GetGeometryCodingParams(int scaleIndex) const;
 
     m2::RectD const GetBounds() const;
@@ -1,6 +1,7 @@
 #include "indexer/data_source.hpp"
 
 #include "platform/mwm_version.hpp"
+#include "platform/platform.hpp"
 
 #include "base/logging.hpp"
 
@@ -20,7 +21,6 @@ public:
 
   ReadMWMFunctor(FeatureSourceFactory const & factory, Fn const & fn) : m_factory(factory), m_fn(fn)
   {
-    m_stop = []() { return false; };
   }
 
   ReadMWMFunctor(FeatureSourceFactory const & factory, Fn const & fn,
@@ -56,16 +56,26 @@ public:
       covering::Intervals const & intervals = cov.Get<RectId::DEPTH_LEVELS>(lastScale);
       ScaleIndex<ModelReaderPtr> index(mwmValue->m_cont.GetReader(INDEX_FILE_TAG), mwmValue->m_factory);
 
-      // iterate through intervals
-      for (auto const & i : intervals)
+      auto const processValue = [&](uint64_t /* key */, uint32_t value) {
+        if (!checkUnique(value))
+          return;
+        m_fn(value, *src);
+      };
+
+      if (m_stop)
+      {
+        // The order of the intervals matters for the stoppable reading (e.g. of a spiral
+        // covering), so they are read one by one.
+        for (auto const & i : intervals)
+        {
+          index.ForEachInIntervalAndScale(i.first, i.second, scale, processValue);
+          if (m_stop())
+            break;
+        }
+      }
+      else
       {
-        index.ForEachInIntervalAndScale(i.first, i.second, scale, [&](uint64_t /* key */, uint32_t value) {
-          if (!checkUnique(value))
-            return;
-          m_fn(value, *src);
-        });
-        if (m_stop())
-          break;
+        index.ForEachInIntervalsAndScale(intervals, scale, processValue);
       }
     }
     // Check created features container.
@@ -81,13 +91,14 @@ private:
   DataSource::StopSearchCallback m_stop;
 };
 
-void ReadFeatureType(function<void(FeatureType &)> const & fn, FeatureSource & src, uint32_t index)
+// Loads the feature into |ft| reusing its memory if |ft| is not null.
+// Returns false for the deleted and obsolete features.
+bool LoadFeatureType(FeatureSource & src, uint32_t index, unique_ptr<FeatureType> & ft)
 {
-  unique_ptr<FeatureType> ft;
   switch (src.GetFeatureStatus(index))
   {
   case FeatureStatus::Deleted:
-  case FeatureStatus::Obsolete: return;
+  case FeatureStatus::Obsolete: return false;
   case FeatureStatus::Created:
   case FeatureStatus::Modified:
   {
@@ -96,12 +107,19 @@ void ReadFeatureType(function<void(FeatureType &)> const & fn, FeatureSource & s
   }
   case FeatureStatus::Untouched:
   {
-    ft = src.GetOriginalFeature(index);
+    src.GetOriginalFeature(index, ft);
     break;
   }
   }
   CHECK(ft, ());
-  fn(*ft);
+  return true;
+}
+
+void ReadFeatureType(function<void(FeatureType &)> const & fn, FeatureSource & src, uint32_t index,
+                     unique_ptr<FeatureType> & ft)
+{
+  if (LoadFeatureType(src, index, ft))
+    fn(*ft);
 }
 }  //  namespace
 
@@ -147,14 +165,67 @@ unique_ptr<FeatureType> FeaturesLoaderGuard::GetFeatureByIndex(uint32_t index) c
   return GetOriginalFeatureByIndex(index);
 }
 
+bool FeaturesLoaderGuard::GetFeatureByIndex(uint32_t index, unique_ptr<FeatureType> & ft) const
+{
+  if (!m_handle.IsAlive())
+  {
+    ft.reset();
+    return false;
+  }
+
+  ASSERT_NOT_EQUAL(FeatureStatus::Deleted, m_source->GetFeatureStatus(index),
+                   ("Deleted feature was cached. It should not be here. Please review your code."));
+
+  auto modified = m_source->GetModifiedFeature(index);
+  if (modified)
+    ft = move(modified);
+  else
+    m_source->GetOriginalFeature(index, ft);
+  return true;
+}
+
 unique_ptr<FeatureType> FeaturesLoaderGuard::GetOriginalFeatureByIndex(uint32_t index) const
 {
   return m_handle.IsAlive() ? m_source->GetOriginalFeature(index) : nullptr;
 }
 
 // DataSource ----------------------------------------------------------------------------------
+void DataSource::EnableInfoManifest(string const & path)
+{
+  m_manifest = make_unique<MwmInfoManifest>(path);
+  m_manifest->Load();
+}
+
+void DataSource::SaveInfoManifest()
+{
+  if (m_manifest && !m_manifest->Save())
+    LOG(LWARNING, ("Can't save mwm manifest."));
+}
+
 unique_ptr<MwmInfo> DataSource::CreateInfo(platform::LocalCountryFile const & localFile) const
 {
+  string const path = localFile.GetPath(MapFileType::Map);
+  uint64_t size = 0;
+  int64_t modificationTime = 0;
+  // Maps from the resources have no directory and can't be checked on disk.
+  bool const useManifest =
+      m_manifest && !localFile.GetDirectory().empty() &&
+      Platform::GetFileSizeAndModificationTime(path, size, modificationTime);
+
+  if (useManifest)
+  {
+    if (auto const entry = m_manifest->Find(path, size, modificationTime))
+    {
+      auto info = make_unique<MwmInfoEx>();
+      info->m_bordersRect = entry->m_bordersRect;
+      info->m_minScale = entry->m_minScale;
+      info->m_maxScale = entry->m_maxScale;
+      info->m_version = entry->m_version;
+      info->m_data = entry->m_data;
+      return unique_ptr<MwmInfo>(move(info));
+    }
+  }
+
   MwmValue value(localFile);
 
   if (version::GetMwmType(value.GetMwmVersion()) != version::MwmType::SingleMwm)
@@ -175,6 +246,19 @@ unique_ptr<MwmInfo> DataSource::CreateInfo(platform::LocalCountryFile const & lo
   feature::RegionData regionData(value.GetRegionData());
   info->m_data = regionData;
 
+  if (useManifest)
+  {
+    MwmInfoManifest::Entry entry;
+    entry.m_size = size;
+    entry.m_modificationTime = modificationTime;
+    entry.m_bordersRect = info->m_bordersRect;
+    entry.m_minScale = info->m_minScale;
+    entry.m_maxScale = info->m_maxScale;
+    entry.m_version = info->m_version;
+    entry.m_data = info->m_data;
+    m_manifest->Update(path, entry);
+  }
+
   return unique_ptr<MwmInfo>(move(info));
 }
 
@@ -186,6 +270,15 @@ unique_ptr<MwmValue> DataSource::CreateValue(MwmInfo & info) const
   if (!p || version::GetMwmType(p->GetMwmVersion()) != version::MwmType::SingleMwm)
     return nullptr;
 
+  // The info may come from the manifest, this is the first time the header is read then.
+  if (m_manifest && (p->GetMwmVersion().GetSecondsSinceEpoch() !=
+                         info.m_version.GetSecondsSinceEpoch() ||
+                     p->GetHeader().GetBounds() != info.m_bordersRect))
+  {
+    LOG(LWARNING, ("Mwm manifest is out of date for", localFile));
+    m_manifest->Erase(localFile.GetPath(MapFileType::Map));
+  }
+
   p->SetTable(dynamic_cast<MwmInfoEx &>(info));
   ASSERT(p->GetHeader().IsMWMSuitable(), ());
   return unique_ptr<MwmValue>(move(p));
@@ -244,8 +337,9 @@ void DataSource::ForEachFeatureIDInRect(FeatureIdCallback const & f, m2::RectD c
 
 void DataSource::ForEachInRect(FeatureCallback const & f, m2::RectD const & rect, int scale) const
 {
-  auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-    ReadFeatureType(f, src, index);
+  unique_ptr<FeatureType> ft;
+  auto readFeatureType = [&f, &ft](uint32_t index, FeatureSource & src) {
+    ReadFeatureType(f, src, index, ft);
   };
 
   ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
@@ -257,8 +351,9 @@ void DataSource::ForClosestToPoint(FeatureCallback const & f, StopSearchCallback
 {
   auto const rect = mercator::RectByCenterXYAndSizeInMeters(center, sizeM);
 
-  auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-    ReadFeatureType(f, src, index);
+  unique_ptr<FeatureType> ft;
+  auto readFeatureType = [&f, &ft](uint32_t index, FeatureSource & src) {
+    ReadFeatureType(f, src, index, ft);
   };
   ReadMWMFunctor readFunctor(*m_factory, readFeatureType, stop);
   ForEachInIntervals(readFunctor, covering::CoveringMode::Spiral, rect, scale);
@@ -266,8 +361,9 @@ void DataSource::ForClosestToPoint(FeatureCallback const & f, StopSearchCallback
 
 void DataSource::ForEachInScale(FeatureCallback const & f, int scale) const
 {
-  auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-    ReadFeatureType(f, src, index);
+  unique_ptr<FeatureType> ft;
+  auto readFeatureType = [&f, &ft](uint32_t index, FeatureSource & src) {
+    ReadFeatureType(f, src, index, ft);
   };
 
   ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
@@ -281,8 +377,9 @@ void DataSource::ForEachInRectForMWM(FeatureCallback const & f, m2::RectD const
   if (handle.IsAlive())
   {
     covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
-    auto readFeatureType = [&f](uint32_t index, FeatureSource & src) {
-      ReadFeatureType(f, src, index);
+    unique_ptr<FeatureType> ft;
+    auto readFeatureType = [&f, &ft](uint32_t index, FeatureSource & src) {
+      ReadFeatureType(f, src, index, ft);
     };
 
     ReadMWMFunctor readFunctor(*m_factory, readFeatureType);
@@ -304,17 +401,17 @@ void DataSource::ReadFeatures(FeatureCallback const & fn, vector<FeatureID> cons
     {
       // Prepare features reading.
       auto src = (*m_factory)(handle);
+      unique_ptr<FeatureType> ft;
       do
       {
         auto const fts = src->GetFeatureStatus(fidIter->m_index);
         ASSERT_NOT_EQUAL(
             FeatureStatus::Deleted, fts,
             ("Deleted feature was cached. It should not be here. Please review your code."));
-        unique_ptr<FeatureType> ft;
         if (fts == FeatureStatus::Modified || fts == FeatureStatus::Created)
           ft = src->GetModifiedFeature(fidIter->m_index);
         else
-          ft = src->GetOriginalFeature(fidIter->m_index);
+          src->GetOriginalFeature(fidIter->m_index, ft);
         CHECK(ft, ());
         fn(*ft);
       } while (++fidIter != endIter && id == fidIter->m_mwmId);
@@ -6,6 +6,7 @@
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/feature_source.hpp"
 #include "indexer/features_vector.hpp"
+#include "indexer/mwm_info_manifest.hpp"
 #include "indexer/mwm_set.hpp"
 #include "indexer/scale_index.hpp"
 #include "indexer/unique_index.hpp"
@@ -17,6 +18,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -41,6 +43,14 @@ public:
   ///         now, returns false.
   bool DeregisterMap(platform::CountryFile const & countryFile);
 
+  /// Makes registration use the manifest of mwm headers stored at |path|. The mwms which
+  /// weren't changed since the manifest was saved are registered without opening them,
+  /// their headers are read when the features are requested for the first time.
+  /// Must be called before any map is registered.
+  void EnableInfoManifest(std::string const & path);
+  /// Saves the manifest after the maps have been registered.
+  void SaveInfoManifest();
+
   void ForEachFeatureIDInRect(FeatureIdCallback const & f, m2::RectD const & rect, int scale) const;
   void ForEachInRect(FeatureCallback const & f, m2::RectD const & rect, int scale) const;
   // Calls |f| for features closest to |center| until |stopCallback| returns true or distance
@@ -77,6 +87,7 @@ private:
   friend class FeaturesLoaderGuard;
 
   std::unique_ptr<FeatureSourceFactory> m_factory;
+  std::unique_ptr<MwmInfoManifest> m_manifest;
 };
 
 // DataSource which operates with features from mwm file and does not support features creation
@@ -109,6 +120,10 @@ public:
   std::unique_ptr<FeatureType> GetOriginalOrEditedFeatureByIndex(uint32_t index) const;
   /// Everyone, except Editor core, should use this method.
   std::unique_ptr<FeatureType> GetFeatureByIndex(uint32_t index) const;
+  /// The same as above but loads the feature into |ft| reusing its memory, so loops over many
+  /// features don't allocate a feature for every one.
+  /// @returns false and resets |ft| if the feature can't be loaded.
+  bool GetFeatureByIndex(uint32_t index, std::unique_ptr<FeatureType> & ft) const;
   size_t GetNumFeatures() const { return m_source->GetNumFeatures(); }
 
 private:
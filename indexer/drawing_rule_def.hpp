@@ -2,9 +2,13 @@
 
 #include "base/buffer_vector.hpp"
 
+#include <algorithm>
+#include <iterator>
 
 namespace drule
 {
+  class BaseRule;
+
   class Key
   {
   public:
@@ -37,4 +41,42 @@ namespace drule
 
   typedef buffer_vector<Key, 16> KeysT;
   void MakeUnique(KeysT & keys);
+
+  /// Drawing rule key with the rule it refers to.
+  struct PreparedRule
+  {
+    Key m_key;
+    BaseRule const * m_rule = nullptr;
+  };
+
+  using PreparedRulesT = buffer_vector<PreparedRule, 16>;
+  void MakeUnique(PreparedRulesT & rules);
+
+  /// Leaves the rule with the max priority of every rule type except lines, |getKey| returns
+  /// the drule::Key of an element of |rules|.
+  template <typename Rules, typename GetKey>
+  void MakeUnique(Rules & rules, GetKey const & getKey)
+  {
+    std::sort(rules.begin(), rules.end(), [&getKey](auto const & lhs, auto const & rhs) {
+      Key const & r1 = getKey(lhs);
+      Key const & r2 = getKey(rhs);
+      // assume that unique algo leaves the first element (with max priority), others - go away
+      if (r1.m_type == r2.m_type)
+        return (r1.m_priority > r2.m_priority);
+      else
+        return (r1.m_type < r2.m_type);
+    });
+
+    auto const last = std::unique(rules.begin(), rules.end(),
+                                  [&getKey](auto const & lhs, auto const & rhs) {
+      Key const & r1 = getKey(lhs);
+      Key const & r2 = getKey(rhs);
+      // many line rules - is ok, other rules - one is enough
+      if (r1.m_type == line)
+        return (r1 == r2);
+      else
+        return (r1.m_type == r2.m_type);
+    });
+    rules.resize(std::distance(rules.begin(), last));
+  }
 }
@@ -35,6 +35,11 @@ namespace
 
 namespace drule
 {
+namespace
+{
+// Point, line and area, see feature::GeomType.
+int constexpr kPreparedGeomTypesCount = 3;
+}  // namespace
 
 BaseRule::BaseRule() : m_type(node | way)
 {}
@@ -135,6 +140,10 @@ void RulesHolder::Clean()
 
   m_rules.clear();
   m_colors.clear();
+
+  m_preparedRows.clear();
+  m_preparedOffsets.clear();
+  m_prepared.clear();
 }
 
 Key RulesHolder::AddRule(int scale, rule_type_t type, BaseRule * p)
@@ -167,6 +176,22 @@ BaseRule const * RulesHolder::Find(Key const & k) const
     return 0;
 }
 
+pair<PreparedRule const *, PreparedRule const *> RulesHolder::GetPreparedRules(
+    uint32_t type, int scale, int geomType) const
+{
+  ASSERT(0 <= scale && scale <= scales::GetUpperStyleScale(), (scale));
+  if (geomType < 0 || geomType >= kPreparedGeomTypesCount)
+    return {};
+
+  auto const it = m_preparedRows.find(type);
+  if (it == m_preparedRows.end())
+    return {};
+
+  auto const row = it->second + scale * kPreparedGeomTypesCount + geomType;
+  return {m_prepared.data() + m_preparedOffsets[row],
+          m_prepared.data() + m_preparedOffsets[row + 1]};
+}
+
 uint32_t RulesHolder::GetBgColor(int scale) const
 {
   ASSERT_LESS(scale, static_cast<int>(m_bgColors.size()), ());
@@ -528,6 +553,35 @@ void RulesHolder::LoadFromBinaryProto(string const & s)
 
   InitBackgroundColors(doSet.m_cont);
   InitColors(doSet.m_cont);
+  InitPreparedRules();
+}
+
+void RulesHolder::InitPreparedRules()
+{
+  m_preparedOffsets.assign(1, 0);
+  classif().ForEachTree([this](ClassifObject const * p, uint32_t type) {
+    if (p->GetDrawingRules().empty())
+      return;
+
+    m_preparedRows[type] = static_cast<uint32_t>(m_preparedOffsets.size() - 1);
+    for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+    {
+      for (int geomType = 0; geomType < kPreparedGeomTypesCount; ++geomType)
+      {
+        KeysT keys;
+        p->GetSuitable(scale, static_cast<feature::GeomType>(geomType), keys);
+        for (auto const & key : keys)
+        {
+          PreparedRule rule;
+          rule.m_key = key;
+          rule.m_rule = Find(key);
+          if (rule.m_rule != nullptr)
+            m_prepared.push_back(rule);
+        }
+        m_preparedOffsets.push_back(static_cast<uint32_t>(m_prepared.size()));
+      }
+    }
+  });
 }
 
 void LoadRules()
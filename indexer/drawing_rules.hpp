@@ -15,6 +15,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 class LineDefProto;
@@ -65,6 +66,7 @@ namespace drule
 
     // Set runtime feature style selector
     void SetSelector(std::unique_ptr<ISelector> && selector);
+    bool HasSelector() const { return m_selector != nullptr; }
   };
 
   class RulesHolder
@@ -82,6 +84,14 @@ namespace drule
 
     std::unordered_map<std::string, uint32_t> m_colors;
 
+    /// Rules of the classificator types which are prepared when the style is loaded:
+    /// type -> index of the first row of the type, the type has a row for every scale and
+    /// geometry type.
+    std::unordered_map<uint32_t, uint32_t> m_preparedRows;
+    /// Row -> begin of the rules of the row in |m_prepared|, the last element is the end.
+    std::vector<uint32_t> m_preparedOffsets;
+    std::vector<PreparedRule> m_prepared;
+
   public:
     RulesHolder();
     ~RulesHolder();
@@ -95,6 +105,11 @@ namespace drule
 
     BaseRule const * Find(Key const & k) const;
 
+    /// @return The same rules as ClassifObject::GetSuitable() returns for |type| but without
+    /// traversal of the classificator tree. |geomType| is feature::GeomType.
+    std::pair<PreparedRule const *, PreparedRule const *> GetPreparedRules(uint32_t type, int scale,
+                                                                           int geomType) const;
+
     uint32_t GetBgColor(int scale) const;
     uint32_t GetColor(std::string const & name) const;
 
@@ -123,6 +138,7 @@ namespace drule
 
   private:
     void InitBackgroundColors(ContainerProto const & cp);
+    void InitPreparedRules();
     void InitColors(ContainerProto const & cp);
   };
 
@@ -22,6 +22,7 @@
 #include "base/logging.hpp"
 #include "base/range_iterator.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/string_utils.hpp"
 
 #include <algorithm>
 #include <exception>
@@ -36,6 +37,19 @@ namespace
 {
 uint32_t constexpr kInvalidOffset = numeric_limits<uint32_t>::max();
 
+// Copies |value| to |buffer| as a null-terminated string. Returns false if |value| is empty
+// or does not fit.
+template <size_t N>
+bool CopyToBuffer(string_view value, char (&buffer)[N])
+{
+  if (value.empty() || value.size() >= N)
+    return false;
+
+  copy(value.begin(), value.end(), buffer);
+  buffer[value.size()] = '\0';
+  return true;
+}
+
 // Get the index for geometry serialization.
 // @param[in]  scale:
 // -1 : index for the best geometry
@@ -189,7 +203,7 @@ FeatureType::FeatureType(SharedLoadInfo const * loadInfo, vector<uint8_t> && buf
                          MetadataIndex const * metadataIndex,
                          indexer::MetadataDeserializer * metadataDeserializer)
   : m_loadInfo(loadInfo)
-  , m_data(buffer)
+  , m_data(move(buffer))
   , m_metadataIndex(metadataIndex)
   , m_metadataDeserializer(metadataDeserializer)
 {
@@ -203,6 +217,34 @@ FeatureType::FeatureType(SharedLoadInfo const * loadInfo, vector<uint8_t> && buf
   m_header = Header(m_data);
 }
 
+void FeatureType::Reset(SharedLoadInfo const * loadInfo, vector<uint8_t> & buffer,
+                        MetadataIndex const * metadataIndex,
+                        indexer::MetadataDeserializer * metadataDeserializer)
+{
+  CHECK(loadInfo, ());
+
+  m_loadInfo = loadInfo;
+  m_data.swap(buffer);
+  m_metadataIndex = metadataIndex;
+  m_metadataDeserializer = metadataDeserializer;
+  m_header = Header(m_data);
+
+  m_id = FeatureID();
+  m_params.MakeZero();
+  m_center = m2::PointD();
+  m_limitRect = m2::RectD();
+  m_points.clear();
+  m_triangles.clear();
+  m_metadata = Metadata();
+  m_metaIds.clear();
+  m_metaBlocks.clear();
+
+  m_parsed.Reset();
+  m_offsets.Reset();
+  m_ptsSimpMask = 0;
+  m_innerStats.MakeZero();
+}
+
 FeatureType::FeatureType(osm::MapObject const & emo)
 {
   HeaderGeomType headerGeomType = HeaderGeomType::Point;
@@ -448,14 +490,23 @@ uint32_t FeatureType::ParseGeometry(int scale)
         int const ind = GetScaleIndex(*m_loadInfo, scale, m_offsets.m_pts);
         if (ind != -1)
         {
-          ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetGeometryReader(ind));
-          src.Skip(m_offsets.m_pts[ind]);
-
           serial::GeometryCodingParams cp = m_loadInfo->GetGeometryCodingParams(ind);
           cp.SetBasePoint(m_points[0]);
-          serial::LoadOuterPath(src, cp, m_points);
 
-          sz = static_cast<uint32_t>(src.Pos() - m_offsets.m_pts[ind]);
+          if (auto const * region = m_loadInfo->GetGeometryRegion(ind))
+          {
+            uint8_t const * start = region->ImmutableData() + m_offsets.m_pts[ind];
+            ArrayByteSource src(start);
+            serial::LoadOuterPath(src, cp, m_points);
+            sz = static_cast<uint32_t>(src.PtrUint8() - start);
+          }
+          else
+          {
+            ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetGeometryReader(ind));
+            src.Skip(m_offsets.m_pts[ind]);
+            serial::LoadOuterPath(src, cp, m_points);
+            sz = static_cast<uint32_t>(src.Pos() - m_offsets.m_pts[ind]);
+          }
         }
       }
       else
@@ -503,11 +554,21 @@ uint32_t FeatureType::ParseTriangles(int scale)
         auto const ind = GetScaleIndex(*m_loadInfo, scale, m_offsets.m_trg);
         if (ind != -1)
         {
-          ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetTrianglesReader(ind));
-          src.Skip(m_offsets.m_trg[ind]);
-          serial::LoadOuterTriangles(src, m_loadInfo->GetGeometryCodingParams(ind), m_triangles);
-
-          sz = static_cast<uint32_t>(src.Pos() - m_offsets.m_trg[ind]);
+          auto const cp = m_loadInfo->GetGeometryCodingParams(ind);
+          if (auto const * region = m_loadInfo->GetTrianglesRegion(ind))
+          {
+            uint8_t const * start = region->ImmutableData() + m_offsets.m_trg[ind];
+            ArrayByteSource src(start);
+            serial::LoadOuterTriangles(src, cp, m_triangles);
+            sz = static_cast<uint32_t>(src.PtrUint8() - start);
+          }
+          else
+          {
+            ReaderSource<FilesContainerR::TReader> src(m_loadInfo->GetTrianglesReader(ind));
+            src.Skip(m_offsets.m_trg[ind]);
+            serial::LoadOuterTriangles(src, cp, m_triangles);
+            sz = static_cast<uint32_t>(src.Pos() - m_offsets.m_trg[ind]);
+          }
         }
       }
 
@@ -707,6 +768,32 @@ vector<m2::PointD> FeatureType::GetTrianglesAsPoints(int scale)
   return {m_triangles.begin(), m_triangles.end()};
 }
 
+bool FeatureType::GetOuterPathDecoder(int scale, serial::OuterPathDecoder & decoder)
+{
+  if (m_parsed.m_points)
+    return false;
+
+  CHECK(m_loadInfo, ());
+  ParseHeader2();
+
+  auto const headerGeomType = static_cast<HeaderGeomType>(Header(m_data) & HEADER_MASK_GEOMTYPE);
+  if (headerGeomType != HeaderGeomType::Line || m_points.size() != 1)
+    return false;
+
+  int const ind = GetScaleIndex(*m_loadInfo, scale, m_offsets.m_pts);
+  if (ind == -1)
+    return false;
+
+  auto const * region = m_loadInfo->GetGeometryRegion(ind);
+  if (!region)
+    return false;
+
+  serial::GeometryCodingParams cp = m_loadInfo->GetGeometryCodingParams(ind);
+  cp.SetBasePoint(m_points[0]);
+  decoder = serial::OuterPathDecoder(region->ImmutableData() + m_offsets.m_pts[ind], cp);
+  return true;
+}
+
 void FeatureType::ParseGeometryAndTriangles(int scale)
 {
   ParseGeometry(scale);
@@ -833,20 +920,39 @@ feature::Metadata const & FeatureType::GetMetadata()
 }
 
 std::string FeatureType::GetMetadata(feature::Metadata::EType type)
+{
+  return std::string(GetMetadataView(type));
+}
+
+std::string_view FeatureType::GetMetadataView(feature::Metadata::EType type)
 {
   ParseMetaIds();
   if (m_metadata.Has(type))
-    return m_metadata.Get(type);
+    return m_metadata.GetView(type);
 
   auto const it = base::FindIf(m_metaIds, [&type](auto const & v) { return v.first == type; });
   if (it == m_metaIds.end())
     return {};
 
-  auto const value = m_metadataDeserializer->GetMetaById(it->second);
-  m_metadata.Set(type, value);
+  coding::TextStorageCache::BlockPtr block;
+  auto const value = m_metadataDeserializer->GetMetaViewById(it->second, block);
+  if (find(m_metaBlocks.begin(), m_metaBlocks.end(), block) == m_metaBlocks.end())
+    m_metaBlocks.push_back(move(block));
   return value;
 }
 
+bool FeatureType::GetMetadata(feature::Metadata::EType type, int & value)
+{
+  char buffer[32];
+  return CopyToBuffer(GetMetadataView(type), buffer) && strings::to_int(buffer, value);
+}
+
+bool FeatureType::GetMetadata(feature::Metadata::EType type, float & value)
+{
+  char buffer[32];
+  return CopyToBuffer(GetMetadataView(type), buffer) && strings::to_float(buffer, value);
+}
+
 bool FeatureType::HasMetadata(feature::Metadata::EType type)
 {
   ParseMetaIds();
@@ -4,6 +4,8 @@
 #include "indexer/feature_data.hpp"
 #include "indexer/meta_idx.hpp"
 
+#include "coding/geometry_coding.hpp"
+
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
 
@@ -15,6 +17,7 @@
 #include <functional>
 #include <iterator>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -39,6 +42,13 @@ public:
               indexer::MetadataDeserializer * metadataDeserializer);
   FeatureType(osm::MapObject const & emo);
 
+  /// Reinitializes the feature with the record in |buffer| keeping the memory of the parsed
+  /// geometry and names, so a feature reused for many records doesn't allocate in the steady
+  /// state. The previous record is swapped into |buffer| to be reused for the next reading.
+  void Reset(feature::SharedLoadInfo const * loadInfo, std::vector<uint8_t> & buffer,
+             feature::MetadataIndex const * metadataIndex,
+             indexer::MetadataDeserializer * metadataDeserializer);
+
   feature::GeomType GetGeomType() const;
   FeatureParamsBase & GetParams() { return m_params; }
 
@@ -109,6 +119,24 @@ public:
     }
   }
 
+  /// The same as ForEachPoint() but if outer geometry is memory-mapped its points are decoded
+  /// on demand right from the mapped section and are not stored in the feature.
+  /// Note. Limit rect is not calculated in this case.
+  template <typename Functor>
+  void ForEachPointLazy(Functor && f, int scale)
+  {
+    serial::OuterPathDecoder decoder;
+    if (!GetOuterPathDecoder(scale, decoder))
+    {
+      ForEachPoint(std::forward<Functor>(f), scale);
+      return;
+    }
+
+    f(m_points.front());
+    while (decoder.HasNext())
+      f(decoder.Next());
+  }
+
   size_t GetPointsCount() const;
 
   m2::PointD const & GetPoint(size_t i) const;
@@ -161,6 +189,14 @@ public:
 
   // Gets single metadata string. Does not parse all metadata.
   std::string GetMetadata(feature::Metadata::EType type);
+  // Same as GetMetadata(type) but does not allocate: the result is a view into the shared
+  // decompressed block of the metadata section which is kept alive by this feature.
+  // The view is valid until the feature is destroyed or reset.
+  std::string_view GetMetadataView(feature::Metadata::EType type);
+  // Parse single numeric metadata value without allocations. Return false if the value
+  // is absent or is not a number.
+  bool GetMetadata(feature::Metadata::EType type, int & value);
+  bool GetMetadata(feature::Metadata::EType type, float & value);
   bool HasMetadata(feature::Metadata::EType type);
 
   /// @name Statistic functions.
@@ -228,6 +264,9 @@ private:
   void ParseMetadata();
   void ParseMetaIds();
   void ParseGeometryAndTriangles(int scale);
+  // Returns false if outer geometry for |scale| is already parsed or can't be decoded right from
+  // the mapped geometry section.
+  bool GetOuterPathDecoder(int scale, serial::OuterPathDecoder & decoder);
 
   uint8_t m_header = 0;
   std::array<uint32_t, feature::kMaxTypesCount> m_types = {};
@@ -245,6 +284,8 @@ private:
   Points m_points, m_triangles;
   feature::Metadata m_metadata;
   indexer::MetadataDeserializer::MetaIds m_metaIds;
+  // Decompressed text storage blocks referenced by the views of GetMetadataView().
+  buffer_vector<coding::TextStorageCache::BlockPtr, 2> m_metaBlocks;
 
   // Non-owning pointer to shared load info. SharedLoadInfo created once per FeaturesVector.
   feature::SharedLoadInfo const * m_loadInfo = nullptr;
@@ -0,0 +1,125 @@
+#include "indexer/feature_centers_cache.hpp"
+
+#include "indexer/fake_feature_ids.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+
+using namespace std;
+
+size_t const FeatureCentersCache::kEntrySizeInBytes =
+    // List node.
+    sizeof(pair<FeatureID, m2::PointD>) + 2 * sizeof(void *) +
+    // Map node.
+    sizeof(pair<FeatureID const, list<pair<FeatureID, m2::PointD>>::iterator>) +
+    4 * sizeof(void *);
+
+// static
+FeatureCentersCache & FeatureCentersCache::Instance()
+{
+  static FeatureCentersCache instance;
+  return instance;
+}
+
+void FeatureCentersCache::SetMaxSize(size_t maxSizeInBytes)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_maxEntries = maxSizeInBytes / kEntrySizeInBytes;
+  while (m_entries.size() > m_maxEntries)
+    Erase(m_index.find(m_entries.back().first));
+}
+
+bool FeatureCentersCache::IsEnabled() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_maxEntries != 0;
+}
+
+m2::PointD FeatureCentersCache::GetCenter(FeatureType & ft)
+{
+  auto const & id = ft.GetID();
+  // Editor created features are points and may reuse the ids of the deleted ones.
+  bool const cacheable = ft.GetGeomType() != feature::GeomType::Point && id.IsValid() &&
+                         !feature::FakeFeatureIds::IsEditorCreatedFeature(id.m_index);
+
+  m2::PointD center;
+  if (cacheable && Find(id, center))
+    return center;
+
+  ft.ResetGeometry();
+  center = feature::GetCenter(ft, FeatureType::BEST_GEOMETRY);
+  if (cacheable)
+    Add(id, center);
+  return center;
+}
+
+bool FeatureCentersCache::Find(FeatureID const & id, m2::PointD & center)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if (m_maxEntries == 0)
+    return false;
+
+  auto const it = m_index.find(id);
+  if (it == m_index.end())
+  {
+    ++m_stats.m_misses;
+    return false;
+  }
+
+  if (!it->first.IsValid())
+  {
+    Erase(it);
+    ++m_stats.m_misses;
+    return false;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  center = it->second->second;
+  ++m_stats.m_hits;
+  return true;
+}
+
+void FeatureCentersCache::Add(FeatureID const & id, m2::PointD const & center)
+{
+  lock_guard<mutex> lock(m_mutex);
+  if (m_maxEntries == 0)
+    return;
+
+  auto const it = m_index.find(id);
+  if (it != m_index.end())
+  {
+    it->second->second = center;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+
+  if (m_entries.size() == m_maxEntries)
+    Erase(m_index.find(m_entries.back().first));
+
+  m_entries.emplace_front(id, center);
+  m_index.emplace(id, m_entries.begin());
+}
+
+void FeatureCentersCache::Clear()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+}
+
+size_t FeatureCentersCache::GetSize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+FeatureCentersCache::Stats FeatureCentersCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_stats;
+}
+
+void FeatureCentersCache::Erase(map<FeatureID, Entries::iterator>::iterator it)
+{
+  m_entries.erase(it->second);
+  m_index.erase(it);
+}
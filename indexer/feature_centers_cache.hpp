@@ -0,0 +1,67 @@
+#pragma once
+
+#include "indexer/feature_decl.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+class FeatureType;
+
+// Process-wide cache of the precise centers of the line and area features. The center is
+// calculated from the best geometry which is the most expensive part of the feature decoding.
+// Both the tile reader (for the captions of the areas) and the search ranker need it for the same
+// features when the user searches in the viewport. Point features are not cached, their centers
+// are stored in the header. Geometry of the lines and areas can't be changed by the editor, so
+// the cache doesn't depend on the edits. Entries of the deregistered mwms are dropped on access.
+// The cache is disabled until SetMaxSize() is called with a nonzero size.
+// The class is thread-safe.
+class FeatureCentersCache
+{
+public:
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  // Approximate memory used by an entry.
+  static size_t const kEntrySizeInBytes;
+
+  // Separate instances are used in tests only.
+  FeatureCentersCache() = default;
+
+  static FeatureCentersCache & Instance();
+
+  // Sets the max size of the cache in bytes. Zero disables the cache and drops all the entries.
+  void SetMaxSize(size_t maxSizeInBytes);
+  bool IsEnabled() const;
+
+  // Returns the center of |ft| at the best geometry. The geometry of |ft| is reset and parsed
+  // at the best scale if the center is not cached.
+  m2::PointD GetCenter(FeatureType & ft);
+
+  bool Find(FeatureID const & id, m2::PointD & center);
+  void Add(FeatureID const & id, m2::PointD const & center);
+  void Clear();
+
+  size_t GetSize() const;
+  Stats GetStats() const;
+
+private:
+  using Entries = std::list<std::pair<FeatureID, m2::PointD>>;
+
+  void Erase(std::map<FeatureID, Entries::iterator>::iterator it);
+
+  mutable std::mutex m_mutex;
+  size_t m_maxEntries = 0;
+  // The most recently used entries go first.
+  Entries m_entries;
+  std::map<FeatureID, Entries::iterator> m_index;
+  Stats m_stats;
+};
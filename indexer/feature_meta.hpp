@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace feature
@@ -35,6 +36,13 @@ public:
     return !value.empty();
   }
 
+  // Returns a view into the stored value. The view is valid until the value is changed.
+  std::string_view GetView(uint8_t type) const
+  {
+    auto const it = m_metadata.find(type);
+    return (it == m_metadata.end()) ? std::string_view() : std::string_view(it->second);
+  }
+
   std::vector<uint8_t> GetPresentTypes() const
   {
     std::vector<uint8_t> types;
@@ -160,6 +168,8 @@ public:
   bool Has(EType type) const { return MetadataBase::Has(static_cast<uint8_t>(type)); }
   std::string Get(EType type) const { return MetadataBase::Get(static_cast<uint8_t>(type)); }
   bool Get(EType type, std::string & value) const { return MetadataBase::Get(static_cast<uint8_t>(type), value);  }
+  using MetadataBase::GetView;
+  std::string_view GetView(EType type) const { return MetadataBase::GetView(static_cast<uint8_t>(type)); }
 
   using MetadataBase::Set;
   void Set(EType type, std::string const & value) { MetadataBase::Set(static_cast<uint8_t>(type), value); }
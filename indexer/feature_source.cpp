@@ -21,7 +21,8 @@ FeatureSource::FeatureSource(MwmSet::MwmHandle const & handle) : m_handle(handle
     return;
 
   auto const & value = *m_handle.GetValue();
-  m_vector = make_unique<FeaturesVector>(value.m_cont, value.GetHeader(), value.m_table.get());
+  m_vector = make_unique<FeaturesVector>(value.m_cont, value.GetHeader(), value.m_table.get(),
+                                         value.m_features.get());
 }
 
 size_t FeatureSource::GetNumFeatures() const
@@ -42,6 +43,20 @@ unique_ptr<FeatureType> FeatureSource::GetOriginalFeature(uint32_t index) const
   return ft;
 }
 
+void FeatureSource::GetOriginalFeature(uint32_t index, unique_ptr<FeatureType> & ft) const
+{
+  if (!ft)
+  {
+    ft = GetOriginalFeature(index);
+    return;
+  }
+
+  ASSERT(m_handle.IsAlive(), ());
+  ASSERT(m_vector != nullptr, ());
+  m_vector->GetByIndex(index, *ft);
+  ft->SetID(FeatureID(m_handle.GetId(), index));
+}
+
 FeatureStatus FeatureSource::GetFeatureStatus(uint32_t index) const
 {
   return FeatureStatus::Untouched;
@@ -34,6 +34,8 @@ public:
   size_t GetNumFeatures() const;
 
   std::unique_ptr<FeatureType> GetOriginalFeature(uint32_t index) const;
+  /// Loads the feature into |ft| reusing its memory if |ft| is not null.
+  void GetOriginalFeature(uint32_t index, std::unique_ptr<FeatureType> & ft) const;
 
   FeatureID GetFeatureId(uint32_t index) const { return FeatureID(m_handle.GetId(), index); }
 
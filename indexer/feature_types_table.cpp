@@ -0,0 +1,98 @@
+#include "indexer/feature_types_table.hpp"
+
+#include "indexer/classificator.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace indexer
+{
+// FeatureTypesTable -------------------------------------------------------------------------------
+// static
+unique_ptr<FeatureTypesTable> FeatureTypesTable::Load(FilesContainerR const & cont)
+{
+  if (!cont.IsExist(FEATURE_TYPES_FILE_TAG))
+    return {};
+
+  try
+  {
+    auto reader = cont.GetReader(FEATURE_TYPES_FILE_TAG);
+    return Load(reader.GetPtr()->CreateSubReader(0, reader.Size()));
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read", FEATURE_TYPES_FILE_TAG, "section of", cont.GetFileName(), ":",
+                   e.Msg()));
+  }
+  return {};
+}
+
+// static
+unique_ptr<FeatureTypesTable> FeatureTypesTable::Load(unique_ptr<Reader> reader)
+{
+  CHECK(reader, ());
+  auto table = make_unique<FeatureTypesTable>();
+  table->m_reader = move(reader);
+
+  // Decodes block encoded by writeBlockCallback from FeatureTypesTableBuilder::Freeze.
+  auto const readBlockCallback = [](NonOwningReaderSource & source, uint32_t blockSize,
+                                    vector<Types> & values) {
+    values.resize(blockSize);
+    for (size_t i = 0; i < blockSize && source.Size() > 0; ++i)
+    {
+      values[i].resize(ReadVarUint<uint32_t>(source));
+      for (auto & type : values[i])
+        type = ReadVarUint<uint32_t>(source);
+    }
+  };
+
+  table->m_map = Map::Load(*table->m_reader, readBlockCallback);
+  if (!table->m_map)
+    return {};
+  return table;
+}
+
+bool FeatureTypesTable::Get(uint32_t featureId, Types & types)
+{
+  if (!m_map->Get(featureId, types))
+    return false;
+
+  auto const & c = classif();
+  for (auto & type : types)
+    type = c.GetTypeForIndex(type);
+  return true;
+}
+
+// FeatureTypesTableBuilder ------------------------------------------------------------------------
+void FeatureTypesTableBuilder::Put(uint32_t featureId, FeatureTypesTable::Types const & types)
+{
+  auto const & c = classif();
+  FeatureTypesTable::Types indices;
+  indices.reserve(types.size());
+  for (auto const type : types)
+    indices.push_back(c.GetIndexForType(type));
+  m_builder.Put(featureId, indices);
+}
+
+void FeatureTypesTableBuilder::Freeze(Writer & writer) const
+{
+  auto const writeBlockCallback = [](auto & w, auto begin, auto end) {
+    for (auto it = begin; it != end; ++it)
+    {
+      WriteVarUint(w, static_cast<uint32_t>(it->size()));
+      for (auto const index : *it)
+        WriteVarUint(w, index);
+    }
+  };
+  m_builder.Freeze(writer, writeBlockCallback);
+}
+}  // namespace indexer
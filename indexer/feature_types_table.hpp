@@ -0,0 +1,53 @@
+#pragma once
+
+#include "coding/map_uint32_to_val.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class FilesContainerR;
+class Reader;
+class Writer;
+
+namespace indexer
+{
+// Types of the features stored apart from the features. It allows to check types
+// of many features, e.g. in search filters, without decoding the features.
+// Types are stored as classificator indices, the classificator must be loaded.
+class FeatureTypesTable
+{
+public:
+  using Types = std::vector<uint32_t>;
+
+  // Returns nullptr if the mwm does not have the section.
+  static std::unique_ptr<FeatureTypesTable> Load(FilesContainerR const & cont);
+  static std::unique_ptr<FeatureTypesTable> Load(std::unique_ptr<Reader> reader);
+
+  // Stores types of the feature |featureId| in the classificator format to |types|.
+  // Returns false if the table does not have the feature.
+  // Consecutive requests of close features are faster. This method is not thread-safe.
+  WARN_UNUSED_RESULT bool Get(uint32_t featureId, Types & types);
+
+  uint64_t Count() const { return m_map->Count(); }
+
+private:
+  using Map = MapUint32ToValue<Types>;
+
+  std::unique_ptr<Reader> m_reader;
+  std::unique_ptr<Map> m_map;
+};
+
+class FeatureTypesTableBuilder
+{
+public:
+  // |types| are in the classificator format.
+  void Put(uint32_t featureId, FeatureTypesTable::Types const & types);
+  void Freeze(Writer & writer) const;
+
+private:
+  MapUint32ToValueBuilder<FeatureTypesTable::Types> m_builder;
+};
+}  // namespace indexer
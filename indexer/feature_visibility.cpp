@@ -147,6 +147,27 @@ void FilterRulesByRuntimeSelector(FeatureType & f, int zoomLevel, drule::KeysT &
   });
 }
 
+pair<int, bool> GetDrawRules(FeatureType & f, TypesHolder const & types, int level,
+                             drule::PreparedRulesT & rules)
+{
+  ASSERT(rules.empty(), ());
+  drule::RulesHolder const & holder = drule::rules();
+  int const scale = min(level, scales::GetUpperStyleScale());
+  auto const geomType = static_cast<int>(types.GetGeomType());
+
+  for (uint32_t t : types)
+  {
+    auto const range = holder.GetPreparedRules(t, scale, geomType);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (!it->m_rule->HasSelector() || it->m_rule->TestFeature(f, level))
+        rules.push_back(*it);
+    }
+  }
+
+  return make_pair(geomType, types.Has(classif().GetCoastType()));
+}
+
 namespace
 {
   class IsDrawableChecker
@@ -69,6 +69,12 @@ namespace feature
   void GetDrawRule(std::vector<uint32_t> const & types, int level, GeomType geomType,
                    drule::KeysT & keys);
   void FilterRulesByRuntimeSelector(FeatureType & f, int zoomLevel, drule::KeysT & keys);
+  /// The same as GetDrawRule() and FilterRulesByRuntimeSelector() but the rules are taken from
+  /// the tables which are prepared when the style is loaded and only the rules with runtime
+  /// selectors are tested.
+  /// @return (geometry type, is coastline)
+  std::pair<int, bool> GetDrawRules(FeatureType & f, TypesHolder const & types, int level,
+                                    drule::PreparedRulesT & rules);
 
   /// Used to check whether user types belong to particular classificator set.
   class TypeSetChecker
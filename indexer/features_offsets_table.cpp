@@ -14,6 +14,8 @@
 #include "base/logging.hpp"
 #include "base/scope_guard.hpp"
 
+#include <optional>
+
 using namespace platform;
 using namespace std;
 
@@ -102,6 +104,56 @@ namespace feature
     return static_cast<uint32_t>(m_table.select(index));
   }
 
+  void FeaturesOffsetsTable::GetFeatureOffsets(vector<uint32_t> const & indices,
+                                               vector<uint32_t> & offsets) const
+  {
+    // Skipping a value of the enumerator is several times cheaper than select, but creation
+    // of the enumerator costs more than select. So the enumerator is created for runs of
+    // consecutive indices only and it is kept while the gaps are small.
+    uint64_t const kMaxEnumeratedGap = 4;
+
+    offsets.reserve(offsets.size() + indices.size());
+    optional<succinct::elias_fano::select_enumerator> it;
+    // Index of the value which will be returned by the next call of |it|.
+    uint64_t next = 0;
+    uint64_t prevIndex = 0;
+    uint32_t offset = 0;
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      uint64_t const index = indices[i];
+      ASSERT_LESS(index, size(), ("Index out of bounds", index, size()));
+      ASSERT(i == 0 || index >= prevIndex, ("Indices must be sorted", prevIndex, index));
+
+      if (i != 0 && index == prevIndex)
+      {
+        offsets.push_back(offset);
+        continue;
+      }
+
+      if (it && index >= next && index < next + kMaxEnumeratedGap)
+      {
+        for (; next < index; ++next)
+          it->next();
+        offset = static_cast<uint32_t>(it->next());
+        ++next;
+      }
+      else if (i != 0 && index == prevIndex + 1)
+      {
+        it.emplace(m_table, index);
+        offset = static_cast<uint32_t>(it->next());
+        next = index + 1;
+      }
+      else
+      {
+        it.reset();
+        offset = static_cast<uint32_t>(m_table.select(index));
+      }
+
+      prevIndex = index;
+      offsets.push_back(offset);
+    }
+  }
+
   size_t FeaturesOffsetsTable::GetFeatureIndexbyOffset(uint32_t offset) const
   {
     ASSERT_GREATER(size(), 0, ("We must not ask empty table"));
@@ -81,6 +81,13 @@ namespace feature
     /// \return offset a feature
     uint32_t GetFeatureOffset(size_t index) const;
 
+    /// Bulk version of GetFeatureOffset(). Close indices are decoded with one pass over
+    /// the table instead of a select per index.
+    /// \param indices sorted indices of features
+    /// \param offsets offsets of the features are appended here
+    void GetFeatureOffsets(std::vector<uint32_t> const & indices,
+                           std::vector<uint32_t> & offsets) const;
+
     /// \param offset offset of a feature
     /// \return index of a feature
     size_t GetFeatureIndexbyOffset(uint32_t offset) const;
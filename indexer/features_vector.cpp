@@ -8,8 +8,19 @@
 std::unique_ptr<FeatureType> FeaturesVector::GetByIndex(uint32_t index) const
 {
   auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
-  return std::make_unique<FeatureType>(&m_loadInfo, m_recordReader->ReadRecord(ftOffset),
-                                       m_metaidx.get(), m_metaDeserializer.get());
+  auto record = m_shared ? m_shared->ReadRecord(ftOffset) : m_recordReader->ReadRecord(ftOffset);
+  return std::make_unique<FeatureType>(&m_loadInfo, std::move(record), m_metaidx.get(),
+                                       GetMetaDeserializer());
+}
+
+void FeaturesVector::GetByIndex(uint32_t index, FeatureType & ft) const
+{
+  auto const ftOffset = m_table ? m_table->GetFeatureOffset(index) : index;
+  if (m_shared)
+    m_shared->ReadRecord(ftOffset, m_buffer);
+  else
+    m_recordReader->ReadRecord(ftOffset, m_buffer);
+  ft.Reset(&m_loadInfo, m_buffer, m_metaidx.get(), GetMetaDeserializer());
 }
 
 size_t FeaturesVector::GetNumFeatures() const
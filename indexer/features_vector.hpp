@@ -4,56 +4,56 @@
 #include "indexer/feature.hpp"
 #include "indexer/meta_idx.hpp"
 #include "indexer/metadata_serdes.hpp"
+#include "indexer/shared_features_vector.hpp"
 #include "indexer/shared_load_info.hpp"
 
 #include "coding/var_record_reader.hpp"
 
+#include "defines.hpp"
+
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace feature { class FeaturesOffsetsTable; }
 
 /// Note! This class is NOT Thread-Safe.
 /// You should have separate instance of Vector for every thread.
+/// If |shared| is set, the instances keep only the per-thread decoding state and read features
+/// records, geometry and metadata from the memory-mapped sections of |shared|.
 class FeaturesVector
 {
   DISALLOW_COPY(FeaturesVector);
 
 public:
   FeaturesVector(FilesContainerR const & cont, feature::DataHeader const & header,
-                 feature::FeaturesOffsetsTable const * table)
-    : m_loadInfo(cont, header), m_table(table)
+                 feature::FeaturesOffsetsTable const * table,
+                 feature::SharedFeaturesVector const * shared = nullptr)
+    : m_loadInfo(cont, header, shared ? &shared->GetGeometry() : nullptr)
+    , m_table(table)
+    , m_shared(shared)
   {
-    if (m_loadInfo.GetMWMFormat() >= version::Format::v11)
+    if (m_shared)
     {
-      FilesContainerR::TReader reader = m_loadInfo.GetDataReader();
+      if (m_loadInfo.GetMWMFormat() == version::Format::v10)
+        LoadMetadataIndex();
+      return;
+    }
 
-      feature::DatSectionHeader header;
-      header.Read(*reader.GetPtr());
-      CHECK(header.m_version == feature::DatSectionHeader::Version::V0,
-            (base::Underlying(header.m_version)));
-      m_recordReader = std::make_unique<RecordReader>(
-          reader.SubReader(header.m_featuresOffset, header.m_featuresSize));
+    if (m_loadInfo.GetMWMFormat() >= version::Format::v11)
+    {
+      InitRecordReader();
 
       auto metaReader = m_loadInfo.GetMetadataReader();
-      m_metaDeserializer = indexer::MetadataDeserializer::Load(*metaReader.GetPtr());
+      m_metaDeserializer = indexer::MetadataDeserializer::Load(
+          *metaReader.GetPtr(), metaReader.GetName() + ":" + METADATA_FILE_TAG);
       CHECK(m_metaDeserializer, ());
     }
     else if (m_loadInfo.GetMWMFormat() == version::Format::v10)
     {
-      FilesContainerR::TReader reader = m_loadInfo.GetDataReader();
-
-      feature::DatSectionHeader header;
-      header.Read(*reader.GetPtr());
-      CHECK(header.m_version == feature::DatSectionHeader::Version::V0,
-            (base::Underlying(header.m_version)));
-      m_recordReader = std::make_unique<RecordReader>(
-          reader.SubReader(header.m_featuresOffset, header.m_featuresSize));
-
-      auto metaIdxReader = m_loadInfo.GetMetadataIndexReader();
-      m_metaidx = feature::MetadataIndex::Load(*metaIdxReader.GetPtr());
-      CHECK(m_metaidx, ());
+      InitRecordReader();
+      LoadMetadataIndex();
     }
     else
     {
@@ -63,14 +63,16 @@ public:
   }
 
   std::unique_ptr<FeatureType> GetByIndex(uint32_t index) const;
+  /// Loads the feature into |ft| reusing its memory, see FeatureType::Reset().
+  void GetByIndex(uint32_t index, FeatureType & ft) const;
 
   size_t GetNumFeatures() const;
 
   template <class ToDo> void ForEach(ToDo && toDo) const
   {
     uint32_t index = 0;
-    m_recordReader->ForEachRecord([&](uint32_t pos, std::vector<uint8_t> && data) {
-      FeatureType ft(&m_loadInfo, std::move(data), m_metaidx.get(), m_metaDeserializer.get());
+    auto const fn = [&](uint32_t pos, std::vector<uint8_t> && data) {
+      FeatureType ft(&m_loadInfo, std::move(data), m_metaidx.get(), GetMetaDeserializer());
 
       // We can't properly set MwmId here, because FeaturesVector
       // works with FileContainerR, not with MwmId/MwmHandle/MwmValue.
@@ -78,7 +80,12 @@ public:
       // be used later for Metadata loading.
       ft.SetID(FeatureID(MwmSet::MwmId(), index));
       toDo(ft, m_table ? index++ : pos);
-    });
+    };
+
+    if (m_shared)
+      m_shared->ForEachRecord(fn);
+    else
+      m_recordReader->ForEachRecord(fn);
   }
 
   template <class ToDo> static void ForEachOffset(ModelReaderPtr reader, ToDo && toDo)
@@ -92,11 +99,38 @@ private:
   friend class FeaturesVectorTest;
   using RecordReader = VarRecordReader<FilesContainerR::TReader>;
 
+  void InitRecordReader()
+  {
+    FilesContainerR::TReader reader = m_loadInfo.GetDataReader();
+
+    feature::DatSectionHeader header;
+    header.Read(*reader.GetPtr());
+    CHECK(header.m_version == feature::DatSectionHeader::Version::V0,
+          (base::Underlying(header.m_version)));
+    m_recordReader = std::make_unique<RecordReader>(
+        reader.SubReader(header.m_featuresOffset, header.m_featuresSize));
+  }
+
+  void LoadMetadataIndex()
+  {
+    auto metaIdxReader = m_loadInfo.GetMetadataIndexReader();
+    m_metaidx = feature::MetadataIndex::Load(*metaIdxReader.GetPtr());
+    CHECK(m_metaidx, ());
+  }
+
+  indexer::MetadataDeserializer * GetMetaDeserializer() const
+  {
+    return m_shared ? m_shared->GetMetaDeserializer() : m_metaDeserializer.get();
+  }
+
   feature::SharedLoadInfo m_loadInfo;
   std::unique_ptr<RecordReader> m_recordReader;
   feature::FeaturesOffsetsTable const * m_table;
+  feature::SharedFeaturesVector const * m_shared;
   std::unique_ptr<feature::MetadataIndex> m_metaidx;
   std::unique_ptr<indexer::MetadataDeserializer> m_metaDeserializer;
+  // Buffer of the records which are read into the reused features.
+  mutable std::vector<uint8_t> m_buffer;
 };
 
 /// Test features vector (reader) that combines all the needed data for stand-alone work.
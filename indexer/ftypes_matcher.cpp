@@ -21,6 +21,9 @@ using namespace std;
 
 namespace
 {
+// See ftype::PushValue().
+uint8_t constexpr kTypeBitsPerLevel = 7;
+
 class HighwayClasses
 {
   map<uint32_t, ftypes::HighwayClass> m_map;
@@ -135,15 +138,45 @@ HighwayClass GetHighwayClass(feature::TypesHolder const & types)
   return HighwayClass::Error;
 }
 
+// static
 uint32_t BaseChecker::PrepareToMatch(uint32_t type, uint8_t level)
 {
-  ftype::TruncValue(type, level);
-  return type;
+  ASSERT_GREATER(level, 0, ());
+  // The same as ftype::TruncValue() but without loops: values of a type take kTypeBitsPerLevel
+  // bits per level and are followed by the control bit.
+  uint32_t const controlBit = uint32_t{1} << (level * kTypeBitsPerLevel);
+  if (type <= (controlBit | (controlBit - 1)))
+    return type;
+  return (type & (controlBit - 1)) | controlBit;
 }
 
 bool BaseChecker::IsMatched(uint32_t type) const
 {
-  return (find(m_types.begin(), m_types.end(), PrepareToMatch(type, m_level)) != m_types.end());
+  type = PrepareToMatch(type, m_level);
+  if (!m_bitmap.empty())
+  {
+    size_t const word = type / 64;
+    return word < m_bitmap.size() && ((m_bitmap[word] >> (type % 64)) & 1) != 0;
+  }
+  return (find(m_types.begin(), m_types.end(), type) != m_types.end());
+}
+
+bool BaseChecker::InitBitmap()
+{
+  if (m_level > kMaxBitmapLevel || m_types.empty())
+    return false;
+
+  uint32_t const typesEnd = uint32_t{1} << (kMaxBitmapLevel * kTypeBitsPerLevel + 1);
+  for (auto const type : m_types)
+  {
+    // Types of more levels than |m_level| are never matched.
+    if (type >= typesEnd)
+      continue;
+    if (type / 64 >= m_bitmap.size())
+      m_bitmap.resize(type / 64 + 1, 0);
+    m_bitmap[type / 64] |= uint64_t{1} << (type % 64);
+  }
+  return !m_bitmap.empty();
 }
 
 void BaseChecker::ForEachType(function<void(uint32_t)> && fn) const
@@ -3,6 +3,7 @@
 #include "indexer/feature_data.hpp"
 
 #include "base/base.hpp"
+#include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
@@ -21,7 +22,10 @@ namespace feature { class TypesHolder; }
 class FeatureType;
 
 #define DECLARE_CHECKER_INSTANCE(CheckerType) static CheckerType const & Instance() { \
-                                              static CheckerType const inst; return inst; }
+                                              static CheckerType inst; \
+                                              static bool const bitmapInited = inst.InitBitmap(); \
+                                              UNUSED_VALUE(bitmapInited); \
+                                              return inst; }
 
 namespace ftypes
 {
@@ -40,12 +44,25 @@ public:
 
   std::vector<uint32_t> const & GetTypes() const { return m_types; }
 
+  /// Builds the bitmap of |m_types| which BaseChecker::IsMatched() uses instead of the search.
+  /// It's called by Instance() once the checker is constructed and only checkers of at most
+  /// kMaxBitmapLevel levels get the bitmap.
+  /// @return true if the bitmap is built.
+  bool InitBitmap();
+
   bool operator()(feature::TypesHolder const & types) const;
   bool operator()(FeatureType & ft) const;
   bool operator()(std::vector<uint32_t> const & types) const;
   bool operator()(uint32_t type) const { return IsMatched(type); }
 
   static uint32_t PrepareToMatch(uint32_t type, uint8_t level);
+
+private:
+  static uint8_t constexpr kMaxBitmapLevel = 2;
+
+  // Bit |t| is set if |t| is in |m_types|. Types of at most kMaxBitmapLevel levels are less
+  // than 2^15, so the bitmap is 4 Kb at most.
+  std::vector<uint64_t> m_bitmap;
 };
 
 class IsPeakChecker : public BaseChecker
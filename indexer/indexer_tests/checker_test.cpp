@@ -252,3 +252,16 @@ UNIT_TEST(IsMotorwayJunctionChecker)
   TEST(ftypes::IsMotorwayJunctionChecker::Instance()(GetMotorwayJunctionType()), ());
   TEST(!ftypes::IsMotorwayJunctionChecker::Instance()(GetPoiTypes()), ());
 }
+
+UNIT_TEST(BaseChecker_PrepareToMatch)
+{
+  classificator::Load();
+  classif().ForEachTree([](ClassifObject const *, uint32_t type) {
+    for (uint8_t level = 1; level <= 4; ++level)
+    {
+      uint32_t expected = type;
+      ftype::TruncValue(expected, level);
+      TEST_EQUAL(ftypes::BaseChecker::PrepareToMatch(type, level), expected, (type, level));
+    }
+  });
+}
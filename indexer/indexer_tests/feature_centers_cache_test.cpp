@@ -0,0 +1,79 @@
+#include "testing/testing.hpp"
+
+#include "indexer/feature_centers_cache.hpp"
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <memory>
+
+using namespace std;
+
+namespace
+{
+class MwmInfoForTesting : public MwmInfo
+{
+public:
+  MwmInfoForTesting() { SetStatus(STATUS_REGISTERED); }
+
+  using MwmInfo::SetStatus;
+};
+
+UNIT_TEST(FeatureCentersCache_Smoke)
+{
+  MwmSet::MwmId const mwmId(make_shared<MwmInfoForTesting>());
+  FeatureID const a(mwmId, 1);
+  FeatureID const b(mwmId, 2);
+  FeatureID const c(mwmId, 3);
+
+  FeatureCentersCache cache;
+  m2::PointD center;
+
+  // The cache is disabled by default.
+  TEST(!cache.IsEnabled(), ());
+  cache.Add(a, {1.0, 1.0});
+  TEST(!cache.Find(a, center), ());
+
+  cache.SetMaxSize(2 * FeatureCentersCache::kEntrySizeInBytes);
+  TEST(cache.IsEnabled(), ());
+  cache.Add(a, {1.0, 1.0});
+  cache.Add(b, {2.0, 2.0});
+  TEST(cache.Find(a, center), ());
+  TEST_EQUAL(center, m2::PointD(1.0, 1.0), ());
+
+  // |b| is the least recently used one.
+  cache.Add(c, {3.0, 3.0});
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(!cache.Find(b, center), ());
+  TEST(cache.Find(c, center), ());
+  TEST_EQUAL(center, m2::PointD(3.0, 3.0), ());
+
+  TEST_EQUAL(cache.GetStats().m_hits, 2, ());
+  TEST_EQUAL(cache.GetStats().m_misses, 1, ());
+
+  cache.SetMaxSize(FeatureCentersCache::kEntrySizeInBytes);
+  TEST_EQUAL(cache.GetSize(), 1, ());
+  TEST(cache.Find(c, center), ());
+
+  cache.SetMaxSize(0);
+  TEST_EQUAL(cache.GetSize(), 0, ());
+}
+
+UNIT_TEST(FeatureCentersCache_DeregisteredMwm)
+{
+  auto info = make_shared<MwmInfoForTesting>();
+  FeatureID const id(MwmSet::MwmId(info), 1);
+
+  FeatureCentersCache cache;
+  cache.SetMaxSize(10 * FeatureCentersCache::kEntrySizeInBytes);
+  cache.Add(id, {1.0, 1.0});
+
+  m2::PointD center;
+  TEST(cache.Find(id, center), ());
+
+  info->SetStatus(MwmInfo::STATUS_DEREGISTERED);
+  TEST(!cache.Find(id, center), ());
+  TEST_EQUAL(cache.GetSize(), 0, ());
+}
+}  // namespace
@@ -0,0 +1,64 @@
+#include "testing/testing.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/classificator_loader.hpp"
+#include "indexer/feature_types_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace indexer;
+using namespace std;
+
+namespace
+{
+struct FeatureTypesTableTest
+{
+  FeatureTypesTableTest() { classificator::Load(); }
+};
+
+UNIT_CLASS_TEST(FeatureTypesTableTest, Smoke)
+{
+  auto const & c = classif();
+  auto const cafe = c.GetTypeByPath({"amenity", "cafe"});
+  auto const restaurant = c.GetTypeByPath({"amenity", "restaurant"});
+  auto const pizza = c.GetTypeByPath({"cuisine", "pizza"});
+  auto const building = c.GetTypeByPath({"building"});
+
+  map<uint32_t, FeatureTypesTable::Types> const expected = {
+      {0, {building}},
+      {1, {cafe, pizza}},
+      {5, {restaurant, pizza, building}},
+      {100, {cafe}},
+      {101, {}}};
+
+  vector<uint8_t> buffer;
+  {
+    FeatureTypesTableBuilder builder;
+    for (auto const & kv : expected)
+      builder.Put(kv.first, kv.second);
+
+    MemWriter<decltype(buffer)> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  auto table = FeatureTypesTable::Load(make_unique<MemReader>(buffer.data(), buffer.size()));
+  TEST(table, ());
+  TEST_EQUAL(table->Count(), expected.size(), ());
+
+  FeatureTypesTable::Types types;
+  for (auto const & kv : expected)
+  {
+    TEST(table->Get(kv.first, types), (kv.first));
+    TEST_EQUAL(types, kv.second, (kv.first));
+  }
+
+  TEST(!table->Get(2, types), ());
+  TEST(!table->Get(1000, types), ());
+}
+}  // namespace
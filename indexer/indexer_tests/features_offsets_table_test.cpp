@@ -15,7 +15,9 @@
 
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <vector>
 
 using namespace platform;
 using namespace std;
@@ -65,6 +67,38 @@ namespace feature
     TEST_EQUAL(static_cast<size_t>(7), table->GetFeatureIndexbyOffset(1024), ());
   }
 
+  UNIT_TEST(FeaturesOffsetsTable_GetFeatureOffsets)
+  {
+    FeaturesOffsetsTable::Builder builder;
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+      offset += 1 + (i * 7919) % 300;
+      builder.PushOffset(offset);
+    }
+    unique_ptr<FeaturesOffsetsTable> table(FeaturesOffsetsTable::Build(builder));
+
+    // Repeated, close and distant indices.
+    vector<uint32_t> const indices = {0, 0, 1, 2, 5, 63, 64, 65, 200, 500, 500, 9998, 9999};
+    vector<uint32_t> offsets = {42};
+    table->GetFeatureOffsets(indices, offsets);
+    TEST_EQUAL(offsets.size(), indices.size() + 1, ());
+    TEST_EQUAL(offsets[0], 42, ());
+    for (size_t i = 0; i < indices.size(); ++i)
+      TEST_EQUAL(offsets[i + 1], table->GetFeatureOffset(indices[i]), (i));
+
+    vector<uint32_t> all(table->size());
+    iota(all.begin(), all.end(), 0);
+    offsets.clear();
+    table->GetFeatureOffsets(all, offsets);
+    for (size_t i = 0; i < all.size(); ++i)
+      TEST_EQUAL(offsets[i], table->GetFeatureOffset(i), (i));
+
+    offsets.clear();
+    table->GetFeatureOffsets({}, offsets);
+    TEST(offsets.empty(), ());
+  }
+
   UNIT_TEST(FeaturesOffsetsTable_ReadWrite)
   {
     string const testFileName = "test_file";
@@ -6,8 +6,11 @@
 
 #include "platform/local_country_file.hpp"
 
+#include "geometry/point2d.hpp"
+
 #include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace platform;
@@ -71,4 +74,88 @@ UNIT_TEST(FeaturesVectorTest_ParseMetadata)
              });
   TEST_EQUAL(expected, actual, ());
 }
+
+UNIT_TEST(FeaturesVectorTest_SharedFeatures)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto result = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  MwmSet::MwmHandle handle = dataSource.GetMwmHandleById(result.first);
+  TEST(handle.IsAlive(), ());
+
+  auto const * value = handle.GetValue();
+  TEST(value->m_features, ());
+
+  auto const readFeatures = [&](feature::SharedFeaturesVector const * shared) {
+    FeaturesVector fv(value->m_cont, value->GetHeader(), value->m_table.get(), shared);
+    vector<vector<m2::PointD>> points(fv.GetNumFeatures());
+    vector<string> postcodes(fv.GetNumFeatures());
+    for (uint32_t i = 0; i < fv.GetNumFeatures(); ++i)
+    {
+      auto ft = fv.GetByIndex(i);
+      ft->ForEachPointLazy([&](m2::PointD const & pt) { points[i].push_back(pt); },
+                           FeatureType::BEST_GEOMETRY);
+      postcodes[i] = ft->GetMetadata(feature::Metadata::FMD_POSTCODE);
+    }
+    return make_pair(points, postcodes);
+  };
+
+  auto const expected = readFeatures(nullptr /* shared */);
+
+  size_t constexpr kNumThreads = 4;
+  vector<decltype(readFeatures(nullptr))> actual(kNumThreads);
+  vector<thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i)
+    threads.emplace_back([&, i]() { actual[i] = readFeatures(value->m_features.get()); });
+  for (auto & t : threads)
+    t.join();
+
+  for (auto const & a : actual)
+    TEST(expected == a, ());
+}
+
+UNIT_TEST(FeaturesVectorTest_ReuseFeature)
+{
+  LocalCountryFile localFile = LocalCountryFile::MakeForTesting("minsk-pass");
+
+  FrozenDataSource dataSource;
+  auto result = dataSource.RegisterMap(localFile);
+  TEST_EQUAL(result.second, MwmSet::RegResult::Success, ());
+
+  MwmSet::MwmHandle handle = dataSource.GetMwmHandleById(result.first);
+  TEST(handle.IsAlive(), ());
+
+  auto const * value = handle.GetValue();
+  FeaturesVector fv(value->m_cont, value->GetHeader(), value->m_table.get());
+
+  auto const getPoints = [](FeatureType & ft) {
+    vector<m2::PointD> points;
+    ft.ForEachPoint([&](m2::PointD const & pt) { points.push_back(pt); },
+                    FeatureType::BEST_GEOMETRY);
+    auto const triangles = ft.GetTrianglesAsPoints(FeatureType::BEST_GEOMETRY);
+    points.insert(points.end(), triangles.begin(), triangles.end());
+    return points;
+  };
+
+  auto reused = fv.GetByIndex(0);
+  for (uint32_t i = 0; i < fv.GetNumFeatures(); ++i)
+  {
+    auto ft = fv.GetByIndex(i);
+    fv.GetByIndex(i, *reused);
+
+    TEST_EQUAL(ft->GetGeomType(), reused->GetGeomType(), (i));
+    TEST_EQUAL(feature::TypesHolder(*ft).ToObjectNames(),
+               feature::TypesHolder(*reused).ToObjectNames(), (i));
+    TEST_EQUAL(ft->GetNames(), reused->GetNames(), (i));
+    TEST_EQUAL(ft->GetHouseNumber(), reused->GetHouseNumber(), (i));
+    TEST_EQUAL(ft->GetLimitRect(FeatureType::BEST_GEOMETRY),
+               reused->GetLimitRect(FeatureType::BEST_GEOMETRY), (i));
+    TEST_EQUAL(getPoints(*ft), getPoints(*reused), (i));
+    TEST_EQUAL(ft->GetMetadata(feature::Metadata::FMD_POSTCODE),
+               reused->GetMetadata(feature::Metadata::FMD_POSTCODE), (i));
+  }
+}
 }  // namespace
@@ -9,6 +9,9 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -291,3 +294,53 @@ UNIT_TEST(IntervalIndex_Simple5)
     TEST_EQUAL(values, vector<uint32_t>(expected, expected + ARRAY_SIZE(expected)), ());
   }
 }
+
+UNIT_TEST(IntervalIndex_Intervals)
+{
+  mt19937 rng(0);
+  for (uint32_t const bitsPerLevel : {4, 8})
+  {
+    vector<CellIdFeaturePairForTest> data;
+    for (uint32_t i = 0; i < 2000; ++i)
+      data.emplace_back(rng() % 0x100000, i);
+    sort(data.begin(), data.end(), [](auto const & lhs, auto const & rhs) {
+      return make_pair(lhs.GetCell(), lhs.GetValue()) < make_pair(rhs.GetCell(), rhs.GetValue());
+    });
+
+    vector<char> serialIndex;
+    MemWriter<vector<char>> writer(serialIndex);
+    IntervalIndexBuilder(20, 1, bitsPerLevel).BuildIndex(writer, data.begin(), data.end());
+    MemReader reader(&serialIndex[0], serialIndex.size());
+    IntervalIndex<MemReader, uint32_t> index(reader);
+
+    for (size_t test = 0; test < 50; ++test)
+    {
+      // Overlapping, adjacent, empty and out of the keys intervals.
+      vector<pair<int64_t, int64_t>> intervals;
+      for (size_t i = 0; i < 20; ++i)
+      {
+        int64_t const beg = rng() % 0x110000;
+        intervals.emplace_back(beg, beg + rng() % 0x4000);
+      }
+      intervals.emplace_back(intervals.back().second, intervals.back().second + 0x100);
+
+      vector<pair<uint64_t, uint32_t>> expected;
+      for (auto const & d : data)
+      {
+        auto const cell = static_cast<int64_t>(d.GetCell());
+        if (any_of(intervals.begin(), intervals.end(), [cell](auto const & interval) {
+              return interval.first <= cell && cell < interval.second;
+            }))
+        {
+          expected.emplace_back(d.GetCell(), d.GetValue());
+        }
+      }
+
+      vector<pair<uint64_t, uint32_t>> actual;
+      index.ForEach([&actual](uint64_t key, uint32_t value) { actual.emplace_back(key, value); },
+                    intervals);
+      TEST(is_sorted(actual.begin(), actual.end()), ());
+      TEST_EQUAL(actual, expected, ());
+    }
+  }
+}
@@ -11,6 +11,8 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 using namespace feature;
@@ -78,4 +80,56 @@ UNIT_TEST(MetadataSerDesTest_Smoke)
     }
   }
 }
+
+UNIT_TEST(MetadataSerDesTest_Views)
+{
+  Buffer buffer;
+
+  uint32_t constexpr kMetaNumber = 1000;
+  map<uint32_t, Metadata> values;
+  for (uint32_t i = 0; i < kMetaNumber; ++i)
+  {
+    Metadata meta;
+    meta.Set(Metadata::FMD_TEST_ID, strings::to_string(i));
+    meta.Set(Metadata::FMD_STARS, strings::to_string(i % 5));
+    values.emplace(i, meta);
+  }
+
+  {
+    MetadataBuilder builder;
+    for (auto const & kv : values)
+      builder.Put(kv.first, kv.second);
+
+    MemWriter<Buffer> writer(buffer);
+    builder.Freeze(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto deserializer = MetadataDeserializer::Load(reader);
+  TEST(deserializer.get(), ());
+
+  // Views stay valid while their blocks are alive even if the blocks are evicted from the
+  // cache of the deserializer.
+  vector<coding::TextStorageCache::BlockPtr> blocks;
+  vector<pair<uint32_t, string_view>> views;
+  for (uint32_t i = 0; i < kMetaNumber; ++i)
+  {
+    MetadataDeserializer::MetaIds ids;
+    TEST(deserializer->GetIds(i, ids), ());
+    for (auto const & id : ids)
+    {
+      if (id.first != Metadata::FMD_TEST_ID)
+        continue;
+
+      coding::TextStorageCache::BlockPtr block;
+      views.emplace_back(i, deserializer->GetMetaViewById(id.second, block));
+      TEST(block, ());
+      blocks.push_back(move(block));
+    }
+  }
+
+  TEST_EQUAL(views.size(), kMetaNumber, ());
+  for (auto const & v : views)
+    TEST_EQUAL(string(v.second), values[v.first].Get(Metadata::FMD_TEST_ID), (v.first));
+}
 }  // namespace
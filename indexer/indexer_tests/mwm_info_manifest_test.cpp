@@ -0,0 +1,80 @@
+#include "testing/testing.hpp"
+
+#include "indexer/mwm_info_manifest.hpp"
+
+#include "platform/platform_tests_support/scoped_file.hpp"
+
+#include <string>
+
+using namespace platform::tests_support;
+using namespace std;
+
+namespace
+{
+MwmInfoManifest::Entry MakeEntry(uint64_t size, int64_t modificationTime)
+{
+  MwmInfoManifest::Entry entry;
+  entry.m_size = size;
+  entry.m_modificationTime = modificationTime;
+  entry.m_bordersRect = m2::RectD(-10.5, 1.0 / 3.0, 20.25, 45.0);
+  entry.m_minScale = 0;
+  entry.m_maxScale = 17;
+  entry.m_version.SetFormat(version::Format::lastFormat);
+  entry.m_version.SetSecondsSinceEpoch(1600000000);
+  entry.m_data.Set(feature::RegionData::RD_DRIVING, "l");
+  return entry;
+}
+
+UNIT_TEST(MwmInfoManifest_Smoke)
+{
+  ScopedFile const file("mwm_info_manifest_test.bin", ScopedFile::Mode::DoNotCreate);
+  string const mwm1 = "/maps/201020/Belarus.mwm";
+  string const mwm2 = "/maps/201020/Russia_Moscow.mwm";
+
+  {
+    MwmInfoManifest manifest(file.GetFullPath());
+    manifest.Load();
+    TEST_EQUAL(manifest.GetSize(), 0, ());
+
+    manifest.Update(mwm1, MakeEntry(100, 1000));
+    manifest.Update(mwm2, MakeEntry(200, -1));
+    TEST(manifest.Save(), ());
+  }
+
+  {
+    MwmInfoManifest manifest(file.GetFullPath());
+    manifest.Load();
+    TEST_EQUAL(manifest.GetSize(), 2, ());
+
+    auto const entry = manifest.Find(mwm1, 100, 1000);
+    TEST(entry, ());
+    TEST(*entry == MakeEntry(100, 1000), ());
+    TEST(manifest.Find(mwm2, 200, -1), ());
+
+    // The file was changed.
+    TEST(!manifest.Find(mwm1, 101, 1000), ());
+    TEST(!manifest.Find(mwm1, 100, 1001), ());
+    TEST(!manifest.Find("/maps/201020/Japan.mwm", 100, 1000), ());
+
+    manifest.Erase(mwm2);
+    TEST(manifest.Save(), ());
+  }
+
+  {
+    MwmInfoManifest manifest(file.GetFullPath());
+    manifest.Load();
+    TEST_EQUAL(manifest.GetSize(), 1, ());
+    TEST(!manifest.Find(mwm2, 200, -1), ());
+  }
+}
+
+UNIT_TEST(MwmInfoManifest_Broken)
+{
+  // The version is right but the number of entries is cut off.
+  ScopedFile const file("mwm_info_manifest_test.bin", string("\0\0\0\0\xff\xff", 6));
+
+  MwmInfoManifest manifest(file.GetFullPath());
+  manifest.Load();
+  TEST_EQUAL(manifest.GetSize(), 0, ());
+}
+}  // namespace
@@ -0,0 +1,77 @@
+#include "testing/testing.hpp"
+
+#include "generator/generator_tests_support/test_feature.hpp"
+#include "generator/generator_tests_support/test_mwm_builder.hpp"
+#include "generator/generator_tests_support/test_with_custom_mwms.hpp"
+
+#include "indexer/mwm_prewarmer.hpp"
+
+#include "coding/files_container.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include "defines.hpp"
+
+using namespace generator::tests_support;
+using namespace std;
+
+namespace
+{
+class MwmPrewarmerTest : public TestWithCustomMwms
+{
+public:
+  MwmSet::MwmId BuildWonderland()
+  {
+    TestPOI a(m2::PointD{0, 0}, "A", "en");
+    TestPOI b(m2::PointD{1, 1}, "B", "en");
+    return BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+      builder.Add(a);
+      builder.Add(b);
+    });
+  }
+};
+
+UNIT_CLASS_TEST(MwmPrewarmerTest, ReadHotSections)
+{
+  auto const id = BuildWonderland();
+  TEST(id.IsAlive(), ());
+
+  auto const handle = m_dataSource.GetMwmHandleById(id);
+  TEST(handle.IsAlive(), ());
+  auto const & value = *handle.GetValue();
+  auto const never = [] { return false; };
+
+  uint64_t const indexSize = value.m_cont.GetReader(INDEX_FILE_TAG).Size();
+  TEST_GREATER(indexSize, 0, ());
+
+  uint64_t const all = MwmPrewarmer::ReadHotSections(value, 1024 * 1024 * 1024, never);
+  TEST_GREATER_OR_EQUAL(all, indexSize, ());
+
+  // The scale index gets at most half of the budget.
+  uint64_t const budget = 2 * max<uint64_t>(indexSize / 2, 1);
+  uint64_t const limited = MwmPrewarmer::ReadHotSections(value, budget, never);
+  TEST_LESS_OR_EQUAL(limited, budget, ());
+  TEST_GREATER(limited, 0, ());
+
+  TEST_EQUAL(MwmPrewarmer::ReadHotSections(value, 0, never), 0, ());
+  TEST_EQUAL(MwmPrewarmer::ReadHotSections(value, all, [] { return true; }), 0, ());
+}
+
+UNIT_CLASS_TEST(MwmPrewarmerTest, Smoke)
+{
+  auto const id = BuildWonderland();
+  TEST(id.IsAlive(), ());
+
+  MwmPrewarmer::Params params;
+  params.m_delay = chrono::milliseconds(0);
+  params.m_maxMwmsPerRequest = 1;
+
+  // Both the processed and the pending requests are finished by the destructor.
+  MwmPrewarmer prewarmer(m_dataSource, params);
+  prewarmer.Prewarm({id});
+  prewarmer.Prewarm({id, id});
+  prewarmer.Prewarm({MwmSet::MwmId()});
+}
+}  // namespace
@@ -9,7 +9,9 @@
 #include "base/macros.hpp"
 
 #include <initializer_list>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 using namespace std;
 using platform::CountryFile;
@@ -171,3 +173,122 @@ UNIT_TEST(MwmSetLockAndIdTest)
   TEST(!handle.GetId().IsAlive(), ());
   TEST(!handle.GetId().GetInfo().get(), ());
 }
+
+UNIT_TEST(MwmSetConcurrentHandlesTest)
+{
+  ScopedMwm mwm0("0.mwm");
+  ScopedMwm mwm1("1.mwm");
+  ScopedMwm mwm2("2.mwm");
+
+  TestMwmSet mwmSet;
+  vector<MwmSet::MwmId> ids;
+  for (auto const & name : {"0", "1", "2"})
+  {
+    auto const p = mwmSet.Register(LocalCountryFile::MakeForTesting(name));
+    TEST_EQUAL(MwmSet::RegResult::Success, p.second, (name));
+    ids.push_back(p.first);
+  }
+
+  size_t constexpr kNumThreads = 8;
+  size_t constexpr kNumIterations = 1000;
+  vector<thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i)
+  {
+    threads.emplace_back([&, i]() {
+      for (size_t j = 0; j < kNumIterations; ++j)
+      {
+        auto const & id = ids[(i + j) % ids.size()];
+        MwmSet::MwmHandle const handle = mwmSet.GetMwmHandleById(id);
+        TEST(handle.IsAlive(), (id));
+        TEST(handle.GetValue(), (id));
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  for (auto const & id : ids)
+    TEST_EQUAL(id.GetInfo()->GetNumRefs(), 0, (id));
+
+  {
+    MwmSet::MwmHandle const handle = mwmSet.GetMwmHandleById(ids[1]);
+    TEST(!mwmSet.Deregister(CountryFile("1")), ());
+    TEST_EQUAL(MwmInfo::STATUS_MARKED_TO_DEREGISTER, ids[1].GetInfo()->GetStatus(), ());
+  }
+  TEST_EQUAL(MwmInfo::STATUS_DEREGISTERED, ids[1].GetInfo()->GetStatus(), ());
+  TEST(!mwmSet.GetMwmHandleById(ids[1]).IsAlive(), ());
+  TEST(mwmSet.GetMwmHandleById(ids[0]).IsAlive(), ());
+}
+
+UNIT_TEST(MwmSetCacheSizeTest)
+{
+  ScopedMwm mwm0("0.mwm");
+  ScopedMwm mwm1("1.mwm");
+  ScopedMwm mwm2("2.mwm");
+  ScopedMwm mwm3("3.mwm");
+
+  // The mwms are registered in different shards, but the cache size is still the total one.
+  TestMwmSet mwmSet(2 /* cacheSize */);
+  vector<MwmSet::MwmId> ids;
+  vector<uint64_t> costs;
+  for (auto const & name : {"0", "1", "2", "3"})
+  {
+    auto const p = mwmSet.Register(LocalCountryFile::MakeForTesting(name));
+    TEST_EQUAL(MwmSet::RegResult::Success, p.second, ());
+    ids.push_back(p.first);
+
+    MwmSet::MwmHandle const handle = mwmSet.GetMwmHandleById(p.first);
+    TEST(handle.GetValue(), ());
+    costs.push_back(handle.GetValue()->GetMemoryCost());
+  }
+
+  // Only the values of the two most recently used mwms are kept.
+  TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), costs[2] + costs[3], ());
+
+  {
+    MwmSet::MwmHandle const handle = mwmSet.GetMwmHandleById(ids[0]);
+    TEST(handle.GetValue(), ());
+    TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), costs[2] + costs[3], ());
+  }
+  TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), costs[3] + costs[0], ());
+}
+
+UNIT_TEST(MwmSetCacheMemoryLimitTest)
+{
+  ScopedMwm mwm0("0.mwm");
+
+  TestMwmSet mwmSet;
+  auto const p = mwmSet.Register(LocalCountryFile::MakeForTesting("0"));
+  TEST_EQUAL(MwmSet::RegResult::Success, p.second, ());
+  auto const & id = p.first;
+
+  uint64_t cost = 0;
+  // Two values of the same mwm are created and returned to the cache.
+  auto const lockTwice = [&]() {
+    MwmSet::MwmHandle const handle1 = mwmSet.GetMwmHandleById(id);
+    MwmSet::MwmHandle const handle2 = mwmSet.GetMwmHandleById(id);
+    TEST(handle1.GetValue(), ());
+    TEST(handle2.GetValue(), ());
+    cost = handle1.GetValue()->GetMemoryCost();
+  };
+
+  TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), 0, ());
+  lockTwice();
+  TEST_GREATER(cost, 0, ());
+  TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), 2 * cost, ());
+
+  // The least recently used value is evicted, but the last one is always kept.
+  mwmSet.SetCacheMemoryLimit(1);
+  TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), cost, ());
+  mwmSet.ClearCache();
+  TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), 0, ());
+  lockTwice();
+  TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), cost, ());
+
+  mwmSet.SetCacheMemoryLimit(0);
+  lockTwice();
+  TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), 2 * cost, ());
+
+  TEST(mwmSet.Deregister(CountryFile("0")), ());
+  TEST_EQUAL(mwmSet.GetCacheMemoryUsage(), 0, ());
+}
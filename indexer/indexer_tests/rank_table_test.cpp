@@ -34,6 +34,17 @@ void TestTable(vector<uint8_t> const & ranks, search::RankTable const & table)
   TEST_EQUAL(table.GetVersion(), search::RankTable::V0, ());
   for (size_t i = 0; i < ranks.size(); ++i)
     TEST_EQUAL(ranks[i], table.Get(i), ());
+
+  // Out of range ids (features created in the editor) have zero ranks.
+  vector<uint32_t> ids = {static_cast<uint32_t>(ranks.size())};
+  for (uint32_t i = 0; i < ranks.size(); i += 3)
+    ids.push_back(i);
+  vector<uint8_t> batch;
+  table.GetBatch(ids, batch);
+  TEST_EQUAL(batch.size(), ids.size(), ());
+  TEST_EQUAL(batch[0], 0, ());
+  for (size_t i = 1; i < ids.size(); ++i)
+    TEST_EQUAL(batch[i], ranks[ids[i]], (i));
 }
 
 void TestTable(vector<uint8_t> const & ranks, string const & path)
@@ -160,3 +171,15 @@ UNIT_TEST(RankTableBuilder_WrongEndianness)
   // Try to load and map rank table - both methods should work now.
   TestTable(ranks, kTestFile);
 }
+
+UNIT_TEST(RankTable_TopRankThreshold)
+{
+  vector<uint8_t> const ranks = {3, 0, 255, 7, 7, 3, 1, 7};
+  TEST_EQUAL(search::GetTopRankThreshold(ranks, 1), 255, ());
+  TEST_EQUAL(search::GetTopRankThreshold(ranks, 2), 7, ());
+  TEST_EQUAL(search::GetTopRankThreshold(ranks, 4), 7, ());
+  TEST_EQUAL(search::GetTopRankThreshold(ranks, 5), 3, ());
+  TEST_EQUAL(search::GetTopRankThreshold(ranks, 6), 3, ());
+  TEST_EQUAL(search::GetTopRankThreshold(ranks, 7), 1, ());
+  TEST_EQUAL(search::GetTopRankThreshold(ranks, ranks.size()), 0, ());
+}
@@ -18,6 +18,9 @@ namespace tests
 
 class TestMwmSet : public MwmSet
 {
+public:
+  explicit TestMwmSet(size_t cacheSize = 64) : MwmSet(cacheSize) {}
+
 protected:
   /// @name MwmSet overrides
   //@{
@@ -7,7 +7,9 @@
 #include "base/assert.hpp"
 #include "base/buffer_vector.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <utility>
 
 class IntervalIndexBase
 {
@@ -71,7 +73,173 @@ public:
     }
   }
 
+  /// Calls |f| for the keys in every interval [first, second) of |intervals|. Overlapping and
+  /// adjacent intervals are merged and all of them are looked up in a single walk of the tree,
+  /// so every node is read once. Children of a node which are close to each other are read
+  /// by a single read. Keys are passed in ascending order.
+  template <typename F, typename Intervals>
+  void ForEach(F const & f, Intervals const & intervals) const
+  {
+    if (m_Header.m_Levels == 0)
+      return;
+
+    KeyRanges ranges;
+    uint64_t const keyEnd = KeyEnd();
+    for (auto const & interval : intervals)
+    {
+      uint64_t const beg = std::min(static_cast<uint64_t>(interval.first), keyEnd);
+      uint64_t const end = std::min(static_cast<uint64_t>(interval.second), keyEnd);
+      if (beg < end)
+        ranges.push_back(KeyRange(beg, end - 1));
+    }
+    if (ranges.empty())
+      return;
+
+    std::sort(ranges.begin(), ranges.end());
+    size_t count = 1;
+    for (size_t i = 1; i < ranges.size(); ++i)
+    {
+      KeyRange & last = ranges[count - 1];
+      if (ranges[i].first <= last.second + 1)
+        last.second = std::max(last.second, ranges[i].second);
+      else
+        ranges[count++] = ranges[i];
+    }
+    ranges.resize(count);
+
+    uint32_t const rootOffset = m_LevelOffsets[m_Header.m_Levels];
+    uint32_t const rootSize = m_LevelOffsets[m_Header.m_Levels + 1] - rootOffset;
+    buffer_vector<uint8_t, 576> data;
+    data.resize_no_init(rootSize);
+    m_Reader.Read(rootOffset, data.data(), rootSize);
+    ForEachNodeInRanges(f, ranges.data(), ranges.data() + ranges.size(), m_Header.m_Levels,
+                        data.data(), rootSize, 0 /* keyBase */);
+  }
+
 private:
+  // Inclusive range of full keys.
+  using KeyRange = std::pair<uint64_t, uint64_t>;
+  using KeyRanges = buffer_vector<KeyRange, 32>;
+
+  // Children of a node which are read by a single read if the gap between them is not greater.
+  static uint32_t constexpr kMaxReadGap = 256;
+
+  // |first| and |last| are the sorted disjoint ranges which intersect the keys of the node,
+  // |data| is the node which is already read.
+  template <typename F>
+  void ForEachNodeInRanges(F const & f, KeyRange const * first, KeyRange const * last, int level,
+                           uint8_t const * data, uint32_t size, uint64_t keyBase) const
+  {
+    ArrayByteSource src(data);
+    void const * pEnd = data + size;
+
+    if (level == 0)
+    {
+      Value value = 0;
+      while (src.Ptr() < pEnd)
+      {
+        uint32_t key = 0;
+        src.Read(&key, m_Header.m_LeafBytes);
+        uint64_t const fullKey = keyBase + SwapIfBigEndianMacroBased(key);
+        while (first != last && first->second < fullKey)
+          ++first;
+        if (first == last)
+          break;
+        value += ReadVarInt<int64_t>(src);
+        if (fullKey >= first->first)
+          f(fullKey, value);
+      }
+      return;
+    }
+
+    struct Child
+    {
+      uint64_t m_keyBase;
+      uint32_t m_offset;
+      uint32_t m_size;
+      KeyRange const * m_first;
+      KeyRange const * m_last;
+    };
+    buffer_vector<Child, 64> children;
+
+    uint8_t const skipBits = (m_Header.m_LeafBytes << 3) + (level - 1) * m_Header.m_BitsPerLevel;
+    uint64_t const levelBytesFF = (1ULL << skipBits) - 1;
+
+    // Returns false when the rest of the children are out of the ranges.
+    auto const addChild = [&](uint32_t i, uint32_t childOffset, uint32_t childSize) {
+      uint64_t const childBeg = keyBase + (uint64_t{i} << skipBits);
+      uint64_t const childEnd = childBeg + levelBytesFF;
+      while (first != last && first->second < childBeg)
+        ++first;
+      if (first == last)
+        return false;
+      if (first->first > childEnd)
+        return true;
+
+      KeyRange const * childLast = first;
+      while (childLast != last && childLast->first <= childEnd)
+        ++childLast;
+      children.push_back({childBeg, childOffset, childSize, first, childLast});
+      return true;
+    };
+
+    uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
+    uint32_t childOffset = offsetAndFlag >> 1;
+    if (offsetAndFlag & 1)
+    {
+      // Reading bitmap.
+      uint8_t const * pBitmap = static_cast<uint8_t const *>(src.Ptr());
+      src.Advance(BitmapSize(m_Header.m_BitsPerLevel));
+      for (uint32_t i = 0; i < (1U << m_Header.m_BitsPerLevel); ++i)
+      {
+        if (bits::GetBit(pBitmap, i))
+        {
+          uint32_t const childSize = ReadVarUint<uint32_t>(src);
+          if (!addChild(i, childOffset, childSize))
+            break;
+          childOffset += childSize;
+        }
+      }
+    }
+    else
+    {
+      while (src.Ptr() < pEnd)
+      {
+        uint8_t const i = src.ReadByte();
+        uint32_t const childSize = ReadVarUint<uint32_t>(src);
+        if (!addChild(i, childOffset, childSize))
+          break;
+        childOffset += childSize;
+      }
+    }
+
+    buffer_vector<uint8_t, 1024> childrenData;
+    for (size_t runBeg = 0; runBeg < children.size();)
+    {
+      size_t runEnd = runBeg + 1;
+      while (runEnd < children.size() &&
+             children[runEnd].m_offset - (children[runEnd - 1].m_offset +
+                                          children[runEnd - 1].m_size) <= kMaxReadGap)
+      {
+        ++runEnd;
+      }
+
+      uint32_t const runOffset = children[runBeg].m_offset;
+      uint32_t const runSize =
+          children[runEnd - 1].m_offset + children[runEnd - 1].m_size - runOffset;
+      childrenData.resize_no_init(runSize);
+      m_Reader.Read(m_LevelOffsets[level - 1] + runOffset, childrenData.data(), runSize);
+      for (size_t i = runBeg; i < runEnd; ++i)
+      {
+        Child const & child = children[i];
+        ForEachNodeInRanges(f, child.m_first, child.m_last, level - 1,
+                            childrenData.data() + (child.m_offset - runOffset), child.m_size,
+                            child.m_keyBase);
+      }
+      runBeg = runEnd;
+    }
+  }
+
   template <typename F>
   void ForEachLeaf(F const & f, uint64_t const beg, uint64_t const end,
       uint32_t const offset, uint32_t const size,
@@ -0,0 +1,60 @@
+#include "indexer/mapped_geometry.hpp"
+
+#include "indexer/feature_impl.hpp"
+
+#include "base/assert.hpp"
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace feature
+{
+// static
+unique_ptr<MappedGeometry> MappedGeometry::Load(detail::MappedFile const & file,
+                                                FilesContainerR const & cont,
+                                                DataHeader const & header)
+{
+  unique_ptr<MappedGeometry> geometry(new MappedGeometry());
+
+  auto const scalesCount = header.GetScalesCount();
+  geometry->m_geometry.resize(scalesCount);
+  geometry->m_triangles.resize(scalesCount);
+  for (size_t ind = 0; ind < scalesCount; ++ind)
+  {
+    geometry->m_geometry[ind] = MapSection(file, cont, GetTagForIndex(GEOMETRY_FILE_TAG, ind));
+    geometry->m_triangles[ind] = MapSection(file, cont, GetTagForIndex(TRIANGLE_FILE_TAG, ind));
+  }
+
+  return geometry;
+}
+
+MemoryRegion const * MappedGeometry::GetGeometryRegion(int scaleIndex) const
+{
+  ASSERT_GREATER_OR_EQUAL(scaleIndex, 0, ());
+  ASSERT_LESS(static_cast<size_t>(scaleIndex), m_geometry.size(), ());
+  return m_geometry[scaleIndex].get();
+}
+
+MemoryRegion const * MappedGeometry::GetTrianglesRegion(int scaleIndex) const
+{
+  ASSERT_GREATER_OR_EQUAL(scaleIndex, 0, ());
+  ASSERT_LESS(static_cast<size_t>(scaleIndex), m_triangles.size(), ());
+  return m_triangles[scaleIndex].get();
+}
+
+// static
+unique_ptr<MemoryRegion> MappedGeometry::MapSection(detail::MappedFile const & file,
+                                                    FilesContainerR const & cont,
+                                                    string const & tag)
+{
+  if (!cont.IsExist(tag))
+    return {};
+
+  auto const offsetAndSize = cont.GetAbsoluteOffsetAndSize(tag);
+  if (offsetAndSize.second == 0)
+    return {};
+
+  return make_unique<MappedMemoryRegion>(file.Map(offsetAndSize.first, offsetAndSize.second, tag));
+}
+}  // namespace feature
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "indexer/data_header.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/memory_region.hpp"
+
+#include "base/macros.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace feature
+{
+// Memory-mapped outer geometry and triangles sections of an mwm. Outer geometry is decoded
+// right from the mapped memory instead of copying it through readers.
+class MappedGeometry
+{
+public:
+  // |file| should be opened on the file of |cont|. It is not needed after the call.
+  // Throws Reader::Exception if the sections can't be mapped.
+  static std::unique_ptr<MappedGeometry> Load(detail::MappedFile const & file,
+                                              FilesContainerR const & cont,
+                                              DataHeader const & header);
+
+  // Returns nullptr if there is no section for |scaleIndex|.
+  MemoryRegion const * GetGeometryRegion(int scaleIndex) const;
+  MemoryRegion const * GetTrianglesRegion(int scaleIndex) const;
+
+  // Returns nullptr if there is no |tag| section or it is empty.
+  static std::unique_ptr<MemoryRegion> MapSection(detail::MappedFile const & file,
+                                                  FilesContainerR const & cont,
+                                                  std::string const & tag);
+
+private:
+  MappedGeometry() = default;
+
+  std::vector<std::unique_ptr<MemoryRegion>> m_geometry;
+  std::vector<std::unique_ptr<MemoryRegion>> m_triangles;
+
+  DISALLOW_COPY_AND_MOVE(MappedGeometry);
+};
+}  // namespace feature
@@ -51,8 +51,16 @@ std::string MetadataDeserializer::GetMetaById(uint32_t id)
   return m_strings.ExtractString(*m_stringsSubreader, id);
 }
 
+std::string_view MetadataDeserializer::GetMetaViewById(uint32_t id,
+                                                      coding::TextStorageCache::BlockPtr & block)
+{
+  lock_guard<mutex> guard(m_stringsMutex);
+  return m_strings.ExtractStringView(*m_stringsSubreader, id, block);
+}
+
 // static
-unique_ptr<MetadataDeserializer> MetadataDeserializer::Load(Reader & reader)
+unique_ptr<MetadataDeserializer> MetadataDeserializer::Load(Reader & reader,
+                                                           string const & cacheId)
 {
   auto deserializer = make_unique<MetadataDeserializer>();
   deserializer->m_version = Version::V0;
@@ -64,6 +72,7 @@ unique_ptr<MetadataDeserializer> MetadataDeserializer::Load(Reader & reader)
       reader.CreateSubReader(header.m_stringsOffset, header.m_stringsSize);
   if (!deserializer->m_stringsSubreader)
     return {};
+  deserializer->m_strings.SetCacheId(cacheId);
   deserializer->m_strings.InitializeIfNeeded(*deserializer->m_stringsSubreader);
 
   deserializer->m_mapSubreader =
@@ -12,6 +12,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -59,7 +60,10 @@ public:
   // string storage.
   using MetaIds = std::vector<std::pair<uint8_t, uint32_t>>;
 
-  static std::unique_ptr<MetadataDeserializer> Load(Reader & reader);
+  // Decompressed strings are shared with the other deserializers of the same section
+  // through coding::TextStorageCache when |cacheId| is not empty.
+  static std::unique_ptr<MetadataDeserializer> Load(Reader & reader,
+                                                    std::string const & cacheId = {});
 
   // Tries to get metadata of the feature with id |featureId|. Returns false if table
   // does not have entry for the feature.
@@ -74,6 +78,11 @@ public:
   // Gets single metadata string from text storage. This method is threadsafe.
   std::string GetMetaById(uint32_t id);
 
+  // Same as GetMetaById() but does not copy the string. The result is a view into the
+  // decompressed block of text storage, it is valid while |block| is alive.
+  // This method is threadsafe.
+  std::string_view GetMetaViewById(uint32_t id, coding::TextStorageCache::BlockPtr & block);
+
 private:
   using Map = MapUint32ToValue<MetaIds>;
 
@@ -0,0 +1,175 @@
+#include "indexer/mwm_info_manifest.hpp"
+
+#include "coding/file_reader.hpp"
+#include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/exception.hpp"
+#include "base/logging.hpp"
+
+using namespace std;
+
+namespace
+{
+uint32_t constexpr kManifestVersion = 0;
+
+// The manifest never leaves the device, so doubles are stored as is.
+template <typename Sink>
+void WriteDouble(Sink & sink, double d)
+{
+  sink.Write(&d, sizeof(d));
+}
+
+template <typename Source>
+double ReadDouble(Source & src)
+{
+  double d;
+  src.Read(&d, sizeof(d));
+  return d;
+}
+}  // namespace
+
+bool MwmInfoManifest::Entry::operator==(Entry const & rhs) const
+{
+  return m_size == rhs.m_size && m_modificationTime == rhs.m_modificationTime &&
+         m_bordersRect == rhs.m_bordersRect && m_minScale == rhs.m_minScale &&
+         m_maxScale == rhs.m_maxScale && m_version.GetFormat() == rhs.m_version.GetFormat() &&
+         m_version.GetSecondsSinceEpoch() == rhs.m_version.GetSecondsSinceEpoch() &&
+         m_data.Equals(rhs.m_data);
+}
+
+MwmInfoManifest::MwmInfoManifest(string const & path) : m_path(path) {}
+
+void MwmInfoManifest::Load()
+{
+  map<string, Entry> entries;
+  try
+  {
+    FileReader reader(m_path);
+    ReaderSource<FileReader> src(reader);
+
+    if (ReadPrimitiveFromSource<uint32_t>(src) != kManifestVersion)
+    {
+      LOG(LINFO, ("Mwm manifest of an unknown version is ignored:", m_path));
+      return;
+    }
+
+    auto const count = ReadVarUint<uint64_t>(src);
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      string path;
+      rw::Read(src, path);
+
+      Entry entry;
+      entry.m_size = ReadVarUint<uint64_t>(src);
+      entry.m_modificationTime = ReadVarInt<int64_t>(src);
+
+      double const minX = ReadDouble(src);
+      double const minY = ReadDouble(src);
+      double const maxX = ReadDouble(src);
+      double const maxY = ReadDouble(src);
+      entry.m_bordersRect = m2::RectD(minX, minY, maxX, maxY);
+      entry.m_minScale = ReadPrimitiveFromSource<uint8_t>(src);
+      entry.m_maxScale = ReadPrimitiveFromSource<uint8_t>(src);
+      entry.m_version.SetFormat(static_cast<version::Format>(ReadVarInt<int32_t>(src)));
+      entry.m_version.SetSecondsSinceEpoch(ReadVarUint<uint64_t>(src));
+      entry.m_data.Deserialize(src);
+
+      entries.emplace(move(path), move(entry));
+    }
+  }
+  catch (Reader::OpenException const &)
+  {
+    return;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Broken mwm manifest", m_path, "is ignored:", e.Msg()));
+    return;
+  }
+
+  lock_guard<mutex> lock(m_mutex);
+  m_entries = move(entries);
+  m_changed = false;
+}
+
+bool MwmInfoManifest::Save()
+{
+  lock_guard<mutex> lock(m_mutex);
+  if (!m_changed)
+    return true;
+
+  bool const saved = base::WriteToTempAndRenameToFile(m_path, [this](string const & path) {
+    try
+    {
+      FileWriter writer(path);
+      WriteToSink(writer, kManifestVersion);
+      WriteVarUint(writer, static_cast<uint64_t>(m_entries.size()));
+      for (auto const & item : m_entries)
+      {
+        auto const & entry = item.second;
+        rw::Write(writer, item.first);
+        WriteVarUint(writer, entry.m_size);
+        WriteVarInt(writer, entry.m_modificationTime);
+        WriteDouble(writer, entry.m_bordersRect.minX());
+        WriteDouble(writer, entry.m_bordersRect.minY());
+        WriteDouble(writer, entry.m_bordersRect.maxX());
+        WriteDouble(writer, entry.m_bordersRect.maxY());
+        WriteToSink(writer, entry.m_minScale);
+        WriteToSink(writer, entry.m_maxScale);
+        WriteVarInt(writer, static_cast<int32_t>(entry.m_version.GetFormat()));
+        WriteVarUint(writer, entry.m_version.GetSecondsSinceEpoch());
+        entry.m_data.Serialize(writer);
+      }
+    }
+    catch (Writer::Exception const & e)
+    {
+      LOG(LWARNING, ("Can't write mwm manifest", path, e.Msg()));
+      return false;
+    }
+    return true;
+  });
+
+  if (saved)
+    m_changed = false;
+  return saved;
+}
+
+optional<MwmInfoManifest::Entry> MwmInfoManifest::Find(string const & filePath, uint64_t size,
+                                                      int64_t modificationTime) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_entries.find(filePath);
+  if (it == m_entries.cend() || it->second.m_size != size ||
+      it->second.m_modificationTime != modificationTime)
+  {
+    return {};
+  }
+  return it->second;
+}
+
+void MwmInfoManifest::Update(string const & filePath, Entry const & entry)
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto & stored = m_entries[filePath];
+  if (stored == entry)
+    return;
+  stored = entry;
+  m_changed = true;
+}
+
+void MwmInfoManifest::Erase(string const & filePath)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_changed |= m_entries.erase(filePath) != 0;
+}
+
+size_t MwmInfoManifest::GetSize() const
+{
+  lock_guard<mutex> lock(m_mutex);
+  return m_entries.size();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "indexer/feature_meta.hpp"
+
+#include "platform/mwm_version.hpp"
+
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+// Persistent registry of the mwm header summaries which are needed to register an mwm.
+// An entry is valid while the size and the modification time of the mwm file are unchanged,
+// so a map which wasn't touched since the previous run is registered without opening it.
+class MwmInfoManifest
+{
+public:
+  struct Entry
+  {
+    bool operator==(Entry const & rhs) const;
+
+    uint64_t m_size = 0;
+    int64_t m_modificationTime = 0;
+
+    m2::RectD m_bordersRect;
+    uint8_t m_minScale = 0;
+    uint8_t m_maxScale = 0;
+    version::MwmVersion m_version;
+    feature::RegionData m_data;
+  };
+
+  explicit MwmInfoManifest(std::string const & path);
+
+  // Loads the manifest from disk. A missing or broken file leaves the manifest empty.
+  void Load();
+  // Saves the manifest when it has been changed since the last Load() or Save() call.
+  bool Save();
+
+  // Returns the entry for |filePath| when the file still has |size| and |modificationTime|.
+  std::optional<Entry> Find(std::string const & filePath, uint64_t size,
+                            int64_t modificationTime) const;
+  void Update(std::string const & filePath, Entry const & entry);
+  void Erase(std::string const & filePath);
+
+  size_t GetSize() const;
+
+private:
+  std::string const m_path;
+
+  mutable std::mutex m_mutex;
+  std::map<std::string, Entry> m_entries;
+  bool m_changed = false;
+};
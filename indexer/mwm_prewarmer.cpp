@@ -0,0 +1,141 @@
+#include "indexer/mwm_prewarmer.hpp"
+
+#include "indexer/data_source.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/reader.hpp"
+
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace
+{
+// The sections which are read on the first render, search or routing in an mwm, in the order
+// of importance. The roots of the scale index and of the search trie are at the beginnings
+// of their sections.
+array<char const *, 5> const kHotSections = {{INDEX_FILE_TAG, SEARCH_INDEX_FILE_TAG,
+                                              SEARCH_RANKS_FILE_TAG, CENTERS_FILE_TAG,
+                                              ROUTING_FILE_TAG}};
+
+// No section gets more than this share of the budget, so a huge scale index doesn't starve
+// the rest of the sections.
+uint64_t constexpr kMaxSectionShare = 2;
+
+size_t constexpr kReadChunkSize = 64 * 1024;
+
+// Half of the default MwmSet cache size.
+size_t constexpr kMaxPrewarmedMwms = 32;
+}  // namespace
+
+MwmPrewarmer::MwmPrewarmer(DataSource const & dataSource) : MwmPrewarmer(dataSource, Params()) {}
+
+MwmPrewarmer::MwmPrewarmer(DataSource const & dataSource, Params const & params)
+  : m_dataSource(dataSource), m_params(params)
+{
+}
+
+MwmPrewarmer::~MwmPrewarmer()
+{
+  m_exit = true;
+  m_thread.ShutdownAndJoin();
+}
+
+void MwmPrewarmer::Prewarm(vector<MwmSet::MwmId> const & ids)
+{
+  if (ids.size() > m_params.m_maxMwmsPerRequest)
+    return;
+
+  lock_guard<mutex> lock(m_mutex);
+  m_queue.clear();
+  for (auto const & id : ids)
+  {
+    if (id.IsAlive() && m_prewarmed.count(id) == 0)
+      m_queue.push_back(id);
+  }
+
+  if (m_queue.empty() || m_isProcessing)
+    return;
+
+  m_isProcessing = true;
+  m_thread.PushDelayed(m_params.m_delay, [this] { ProcessQueue(); });
+}
+
+void MwmPrewarmer::ProcessQueue()
+{
+  while (!m_exit)
+  {
+    MwmSet::MwmId id;
+    {
+      lock_guard<mutex> lock(m_mutex);
+      if (m_queue.empty())
+      {
+        m_isProcessing = false;
+        return;
+      }
+      id = m_queue.front();
+      m_queue.pop_front();
+
+      if (m_prewarmed.size() >= kMaxPrewarmedMwms)
+        m_prewarmed.clear();
+      m_prewarmed.insert(id);
+    }
+
+    PrewarmMwm(id);
+  }
+}
+
+void MwmPrewarmer::PrewarmMwm(MwmSet::MwmId const & id)
+{
+  try
+  {
+    // Opening of the handle reads the header and the features offsets table. The value goes
+    // to the MwmSet cache when the handle is destroyed.
+    auto const handle = m_dataSource.GetMwmHandleById(id);
+    if (!handle.IsAlive())
+      return;
+
+    auto const bytes =
+        ReadHotSections(*handle.GetValue(), m_params.m_ioBudget, [this] { return m_exit.load(); });
+    LOG(LDEBUG, ("Prewarmed", id, "bytes read:", bytes));
+  }
+  catch (RootException const & e)
+  {
+    LOG(LWARNING, ("Can't prewarm", id, e.Msg()));
+  }
+}
+
+// static
+uint64_t MwmPrewarmer::ReadHotSections(MwmValue const & value, uint64_t budget,
+                                       function<bool()> const & stop)
+{
+  uint64_t const maxSectionSize = budget / kMaxSectionShare;
+  vector<char> buffer(kReadChunkSize);
+  uint64_t total = 0;
+  for (auto const * tag : kHotSections)
+  {
+    if (!value.m_cont.IsExist(tag))
+      continue;
+
+    auto const reader = value.m_cont.GetReader(tag);
+    uint64_t const size = min({reader.Size(), maxSectionSize, budget - total});
+    for (uint64_t pos = 0; pos < size; pos += kReadChunkSize)
+    {
+      if (stop())
+        return total;
+      auto const chunk = static_cast<size_t>(min<uint64_t>(kReadChunkSize, size - pos));
+      reader.Read(pos, buffer.data(), chunk);
+      total += chunk;
+    }
+
+    if (total == budget)
+      break;
+  }
+  return total;
+}
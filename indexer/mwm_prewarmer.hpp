@@ -0,0 +1,69 @@
+#pragma once
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/thread_pool_delayed.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+class DataSource;
+
+// Opens mwms and reads their hot sections on a background thread, so the first search or
+// render in a map doesn't wait for the disk. Prewarming an mwm leaves an opened MwmValue
+// (header, features offsets table) in the MwmSet cache and pages in the beginnings of the
+// scale index, the search trie, the ranks, the centers table and the routing section.
+// Prewarming is best-effort: the mwms are processed one by one after a delay, every mwm
+// reads at most |m_ioBudget| bytes, and the pending requests are dropped by the newer ones.
+class MwmPrewarmer
+{
+public:
+  struct Params
+  {
+    // Max number of bytes read from a single mwm.
+    uint64_t m_ioBudget = 4 * 1024 * 1024;
+    // Time between a request and the start of prewarming, so the foreground work
+    // triggered by the same event goes first.
+    std::chrono::milliseconds m_delay = std::chrono::milliseconds(500);
+    // Requests with more mwms are ignored, they come from a zoomed out viewport
+    // where only the World mwm is used.
+    size_t m_maxMwmsPerRequest = 8;
+  };
+
+  explicit MwmPrewarmer(DataSource const & dataSource);
+  MwmPrewarmer(DataSource const & dataSource, Params const & params);
+  ~MwmPrewarmer();
+
+  // Replaces the pending requests with |ids|. The mwms which were prewarmed already are skipped.
+  void Prewarm(std::vector<MwmSet::MwmId> const & ids);
+
+  // Reads the beginnings of the hot sections of |value|, not more than |budget| bytes in total.
+  // |stop| is checked between reads. Returns the number of bytes read.
+  static uint64_t ReadHotSections(MwmValue const & value, uint64_t budget,
+                                  std::function<bool()> const & stop);
+
+private:
+  void ProcessQueue();
+  void PrewarmMwm(MwmSet::MwmId const & id);
+
+  DataSource const & m_dataSource;
+  Params const m_params;
+
+  std::atomic<bool> m_exit{false};
+
+  std::mutex m_mutex;
+  std::deque<MwmSet::MwmId> m_queue;
+  // Mwms which were prewarmed recently. The set is cleared when it outgrows the MwmSet cache,
+  // because older mwms are likely to be evicted from the cache by then.
+  std::set<MwmSet::MwmId> m_prewarmed;
+  bool m_isProcessing = false;
+
+  base::thread_pool::delayed::ThreadPool m_thread;
+};
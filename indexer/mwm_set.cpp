@@ -9,6 +9,7 @@
 #include "base/exception.hpp"
 #include "base/logging.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/string_utils.hpp"
 
 #include <algorithm>
 #include <exception>
@@ -20,7 +21,24 @@ using namespace std;
 using platform::CountryFile;
 using platform::LocalCountryFile;
 
-MwmInfo::MwmInfo() : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0) {}
+namespace
+{
+// Memory of the container, the index factory and the headers held by every value.
+uint64_t constexpr kValueOverhead = 16 * 1024;
+
+// Sections which are mapped while the value is alive, see MwmValue::SetTable().
+bool IsMappedSection(string const & tag)
+{
+  return tag == FEATURES_FILE_TAG || tag == FEATURES_FILE_TAG_V1_V9 ||
+         tag == FEATURE_OFFSETS_FILE_TAG || tag == METADATA_FILE_TAG ||
+         strings::StartsWith(tag, GEOMETRY_FILE_TAG) || strings::StartsWith(tag, TRIANGLE_FILE_TAG);
+}
+}  // namespace
+
+MwmInfo::MwmInfo()
+  : m_minScale(0), m_maxScale(0), m_status(STATUS_DEREGISTERED), m_numRefs(0), m_shardIdx(0)
+{
+}
 
 MwmInfo::MwmTypeT MwmInfo::GetType() const
 {
@@ -122,6 +140,7 @@ pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::Register(LocalCountryFile const &
     if (info->GetVersion() == localFile.GetVersion())
     {
       LOG(LINFO, ("Updating already registered mwm:", name));
+      lock_guard<mutex> lock(GetShard(*info).m_lock);
       SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
       info->m_file = localFile;
       result = make_pair(id, RegResult::VersionAlreadyExists);
@@ -147,6 +166,8 @@ pair<MwmSet::MwmId, MwmSet::RegResult> MwmSet::RegisterImpl(LocalCountryFile con
     return make_pair(MwmId(), RegResult::UnsupportedFileFormat);
 
   info->m_file = localFile;
+  info->m_shardIdx = m_nextShardIdx;
+  m_nextShardIdx = (m_nextShardIdx + 1) % kNumShards;
   SetStatus(*info, MwmInfo::STATUS_REGISTERED, events);
   m_info[localFile.GetCountryName()].push_back(info);
 
@@ -159,24 +180,22 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
     return false;
 
   shared_ptr<MwmInfo> const & info = id.GetInfo();
-  if (info->m_numRefs == 0)
   {
-    SetStatus(*info, MwmInfo::STATUS_DEREGISTERED, events);
-    vector<shared_ptr<MwmInfo>> & infos = m_info[info->GetCountryName()];
-    infos.erase(remove(infos.begin(), infos.end(), info), infos.end());
-    for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+    auto & shard = GetShard(*info);
+    lock_guard<mutex> lock(shard.m_lock);
+    if (info->m_numRefs != 0)
     {
-      if (it->first == id)
-      {
-        m_cache.erase(it);
-        break;
-      }
+      SetStatus(*info, MwmInfo::STATUS_MARKED_TO_DEREGISTER, events);
+      return false;
     }
-    return true;
+
+    SetStatus(*info, MwmInfo::STATUS_DEREGISTERED, events);
+    m_cache.Erase(id);
   }
 
-  SetStatus(*info, MwmInfo::STATUS_MARKED_TO_DEREGISTER, events);
-  return false;
+  vector<shared_ptr<MwmInfo>> & infos = m_info[info->GetCountryName()];
+  infos.erase(remove(infos.begin(), infos.end(), info), infos.end());
+  return true;
 }
 
 bool MwmSet::Deregister(CountryFile const & countryFile)
@@ -256,16 +275,24 @@ void MwmSet::ProcessEventList(EventList & events)
 
 unique_ptr<MwmValue> MwmSet::LockValue(MwmId const & id)
 {
+  if (!id.IsAlive())
+    return nullptr;
+
   unique_ptr<MwmValue> result;
-  WithEventLog([&](EventList & events)
-               {
-                 result = LockValueImpl(id, events);
-               });
+  bool deregister = false;
+  {
+    lock_guard<mutex> lock(GetShard(*id.GetInfo()).m_lock);
+    result = LockValueImpl(id, deregister);
+  }
+
+  if (deregister)
+    WithEventLog([&](EventList & events) { DeregisterImpl(id, events); });
   return result;
 }
 
-unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
+unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, bool & deregister)
 {
+  deregister = false;
   if (!id.IsAlive())
     return nullptr;
   shared_ptr<MwmInfo> info = id.GetInfo();
@@ -278,15 +305,8 @@ unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
   ++info->m_numRefs;
 
   // Search in cache.
-  for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
-  {
-    if (it->first == id)
-    {
-      unique_ptr<MwmValue> result = move(it->second);
-      m_cache.erase(it);
-      return result;
-    }
-  }
+  if (auto result = m_cache.Pop(id))
+    return result;
 
   try
   {
@@ -303,58 +323,58 @@ unique_ptr<MwmValue> MwmSet::LockValueImpl(MwmId const & id, EventList & events)
     LOG(LERROR, ("Can't create MWMValue for", info->GetCountryName(), "Reason", ex.what()));
 
     --info->m_numRefs;
-    DeregisterImpl(id, events);
+    deregister = true;
     return nullptr;
   }
 }
 
 void MwmSet::UnlockValue(MwmId const & id, unique_ptr<MwmValue> p)
-{
-  WithEventLog([&](EventList & events)
-               {
-                 UnlockValueImpl(id, move(p), events);
-               });
-}
-
-void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValue> p, EventList & events)
 {
   ASSERT(id.IsAlive(), (id));
   ASSERT(p.get() != nullptr, ());
   if (!id.IsAlive() || !p)
     return;
 
+  bool deregister = false;
+  {
+    lock_guard<mutex> lock(GetShard(*id.GetInfo()).m_lock);
+    UnlockValueImpl(id, move(p), deregister);
+  }
+
+  // The mwm may be locked again before |m_lock| is taken, DeregisterImpl() checks it.
+  if (deregister)
+    WithEventLog([&](EventList & events) { DeregisterImpl(id, events); });
+}
+
+void MwmSet::UnlockValueImpl(MwmId const & id, unique_ptr<MwmValue> p, bool & deregister)
+{
   shared_ptr<MwmInfo> const & info = id.GetInfo();
   ASSERT_GREATER(info->m_numRefs, 0, ());
   --info->m_numRefs;
-  if (info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER)
-    VERIFY(DeregisterImpl(id, events), ());
+  deregister =
+      info->m_numRefs == 0 && info->GetStatus() == MwmInfo::STATUS_MARKED_TO_DEREGISTER;
 
   if (info->IsUpToDate())
   {
     /// @todo Probably, it's better to store only "unique by id" free caches here.
     /// But it's no obvious if we have many threads working with the single mwm.
 
-    m_cache.push_back(make_pair(id, move(p)));
-    if (m_cache.size() > m_cacheSize)
-    {
-      ASSERT_EQUAL(m_cache.size(), m_cacheSize + 1, ());
-      m_cache.pop_front();
-    }
+    m_cache.Push(id, move(p));
   }
 }
 
 void MwmSet::Clear()
 {
   lock_guard<mutex> lock(m_lock);
-  ClearCacheImpl(m_cache.begin(), m_cache.end());
+  m_cache.Clear();
   m_info.clear();
 }
 
-void MwmSet::ClearCache()
-{
-  lock_guard<mutex> lock(m_lock);
-  ClearCacheImpl(m_cache.begin(), m_cache.end());
-}
+void MwmSet::ClearCache() { m_cache.Clear(); }
+
+void MwmSet::SetCacheMemoryLimit(uint64_t bytes) { m_cache.SetMemoryLimit(bytes); }
+
+uint64_t MwmSet::GetCacheMemoryUsage() const { return m_cache.GetMemoryUsage(); }
 
 MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) const
 {
@@ -364,41 +384,99 @@ MwmSet::MwmId MwmSet::GetMwmIdByCountryFile(CountryFile const & countryFile) con
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleByCountryFile(CountryFile const & countryFile)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-               {
-                 handle = GetMwmHandleByIdImpl(GetMwmIdByCountryFileImpl(countryFile), events);
-               });
-  return handle;
+  return GetMwmHandleById(GetMwmIdByCountryFile(countryFile));
 }
 
 MwmSet::MwmHandle MwmSet::GetMwmHandleById(MwmId const & id)
 {
-  MwmSet::MwmHandle handle;
-  WithEventLog([&](EventList & events)
-               {
-                 handle = GetMwmHandleByIdImpl(id, events);
-               });
-  return handle;
+  return MwmHandle(*this, id, LockValue(id));
 }
 
-MwmSet::MwmHandle MwmSet::GetMwmHandleByIdImpl(MwmId const & id, EventList & events)
+void MwmSet::ClearCache(MwmId const & id)
 {
-  unique_ptr<MwmValue> value;
-  if (id.IsAlive())
-    value = LockValueImpl(id, events);
-  return MwmHandle(*this, id, move(value));
+  if (!id.GetInfo())
+    return;
+
+  m_cache.Erase(id);
 }
 
-void MwmSet::ClearCacheImpl(Cache::iterator beg, Cache::iterator end) { m_cache.erase(beg, end); }
+// MwmSet::Cache -----------------------------------------------------------------------------------
 
-void MwmSet::ClearCache(MwmId const & id)
+void MwmSet::Cache::Push(MwmId const & id, unique_ptr<MwmValue> p)
+{
+  lock_guard<mutex> lock(m_lock);
+  m_cost += p->GetMemoryCost();
+  m_values.emplace_back(id, move(p));
+  Shrink();
+}
+
+unique_ptr<MwmValue> MwmSet::Cache::Pop(MwmId const & id)
+{
+  lock_guard<mutex> lock(m_lock);
+  // Searches from the most recently used value.
+  for (auto it = m_values.rbegin(); it != m_values.rend(); ++it)
+  {
+    if (it->first == id)
+    {
+      unique_ptr<MwmValue> result = move(it->second);
+      m_values.erase(next(it).base());
+      ASSERT_GREATER_OR_EQUAL(m_cost, result->GetMemoryCost(), ());
+      m_cost -= result->GetMemoryCost();
+      return result;
+    }
+  }
+  return nullptr;
+}
+
+void MwmSet::Cache::Erase(MwmId const & id)
 {
+  lock_guard<mutex> lock(m_lock);
   auto sameId = [&id](pair<MwmSet::MwmId, unique_ptr<MwmValue>> const & p)
   {
     return (p.first == id);
   };
-  ClearCacheImpl(base::RemoveIfKeepValid(m_cache.begin(), m_cache.end(), sameId), m_cache.end());
+  m_values.erase(base::RemoveIfKeepValid(m_values.begin(), m_values.end(), sameId),
+                 m_values.end());
+
+  m_cost = 0;
+  for (auto const & p : m_values)
+    m_cost += p.second->GetMemoryCost();
+}
+
+void MwmSet::Cache::Clear()
+{
+  lock_guard<mutex> lock(m_lock);
+  m_values.clear();
+  m_cost = 0;
+}
+
+void MwmSet::Cache::SetMemoryLimit(uint64_t bytes)
+{
+  lock_guard<mutex> lock(m_lock);
+  m_memoryLimit = bytes;
+  Shrink();
+}
+
+uint64_t MwmSet::Cache::GetMemoryUsage() const
+{
+  lock_guard<mutex> lock(m_lock);
+  return m_cost;
+}
+
+void MwmSet::Cache::Shrink()
+{
+  auto const overLimit = [&]() {
+    if (m_values.size() > m_maxSize)
+      return true;
+    return m_memoryLimit != 0 && m_cost > m_memoryLimit && m_values.size() > 1;
+  };
+
+  while (overLimit())
+  {
+    ASSERT_GREATER_OR_EQUAL(m_cost, m_values.front().second->GetMemoryCost(), ());
+    m_cost -= m_values.front().second->GetMemoryCost();
+    m_values.pop_front();
+  }
 }
 
 // MwmValue ----------------------------------------------------------------------------------------
@@ -407,6 +485,12 @@ MwmValue::MwmValue(LocalCountryFile const & localFile)
   : m_cont(platform::GetCountryReader(localFile, MapFileType::Map)), m_file(localFile)
 {
   m_factory.Load(m_cont);
+
+  m_memoryCost = kValueOverhead;
+  m_cont.ForEachTagInfo([this](FilesContainerBase::TagInfo const & info) {
+    if (IsMappedSection(info.m_tag))
+      m_memoryCost += info.m_size;
+  });
 }
 
 void MwmValue::SetTable(MwmInfoEx & info)
@@ -415,11 +499,18 @@ void MwmValue::SetTable(MwmInfoEx & info)
   CHECK_GREATER(version, version::Format::v5, ("Old maps should not be registered."));
 
   m_table = info.m_table.lock();
-  if (m_table)
-    return;
+  if (!m_table)
+  {
+    m_table = feature::FeaturesOffsetsTable::Load(m_cont);
+    info.m_table = m_table;
+  }
 
-  m_table = feature::FeaturesOffsetsTable::Load(m_cont);
-  info.m_table = m_table;
+  m_features = info.m_features.lock();
+  if (!m_features)
+  {
+    m_features = feature::SharedFeaturesVector::Load(m_cont, GetHeader());
+    info.m_features = m_features;
+  }
 }
 
 string DebugPrint(MwmSet::RegResult result)
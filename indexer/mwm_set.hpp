@@ -11,8 +11,11 @@
 #include "indexer/data_factory.hpp"
 #include "indexer/feature_meta.hpp"
 #include "indexer/features_offsets_table.hpp"
+#include "indexer/shared_features_vector.hpp"
 
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <deque>
 #include <map>
 #include <memory>
@@ -85,6 +88,7 @@ protected:
   platform::LocalCountryFile m_file;  ///< Path to the mwm file.
   std::atomic<Status> m_status;       ///< Current country status.
   uint32_t m_numRefs;                 ///< Number of active handles.
+  size_t m_shardIdx;                  ///< Index of MwmSet shard which guards handles of the mwm.
 };
 
 class MwmInfoEx : public MwmInfo
@@ -99,9 +103,11 @@ private:
   // must be removed as soon as the last corresponding MwmValue is
   // destroyed. Also, note that this value must be used and modified
   // only in MwmValue::SetTable() method, which, in turn, is called
-  // only in the MwmSet critical section, protected by a lock.  So,
-  // there's an implicit synchronization on this field.
+  // only in the MwmSet critical section, protected by the lock of
+  // the mwm's shard.  So, there's an implicit synchronization on this field.
   std::weak_ptr<feature::FeaturesOffsetsTable> m_table;
+  // Shared in the same way as |m_table|.
+  std::weak_ptr<feature::SharedFeaturesVector> m_features;
 };
 
 class MwmValue;
@@ -135,7 +141,7 @@ public:
   };
 
 public:
-  explicit MwmSet(size_t cacheSize = 64) : m_cacheSize(cacheSize) {}
+  explicit MwmSet(size_t cacheSize = 64) : m_cache(cacheSize) {}
   virtual ~MwmSet() = default;
 
   // Mwm handle, which is used to refer to mwm and prevent it from
@@ -294,6 +300,15 @@ public:
 
   void ClearCache();
 
+  // Limits the memory held by the cached free values, see MwmValue::GetMemoryCost(). The least
+  // recently used values are evicted when the limit is exceeded, but the last one is always
+  // kept. Zero means that the cache is limited only by the number of values.
+  // Note. The cost is the size of the mapped sections, not the resident memory, and the routing
+  // data of the mwms is not counted, so the limit isn't set by default.
+  void SetCacheMemoryLimit(uint64_t bytes);
+  // Returns the memory cost of all cached free values.
+  uint64_t GetCacheMemoryUsage() const;
+
   MwmId GetMwmIdByCountryFile(platform::CountryFile const & countryFile) const;
 
   MwmHandle GetMwmHandleByCountryFile(platform::CountryFile const & countryFile);
@@ -313,7 +328,48 @@ protected:
   virtual std::unique_ptr<MwmValue> CreateValue(MwmInfo & info) const = 0;
 
 private:
-  using Cache = std::deque<std::pair<MwmId, std::unique_ptr<MwmValue>>>;
+  // Handles of the mwms are locked and unlocked under the lock of the mwm's shard only, so
+  // threads which work with different mwms do not contend for |m_lock|. The shard lock guards
+  // MwmInfo::m_numRefs and status transitions of the mwm.
+  // Locks order: |m_lock| is always taken before a shard lock, a shard lock is always
+  // taken before the lock of |m_cache|.
+  struct Shard
+  {
+    mutable std::mutex m_lock;
+  };
+
+  // LRU cache of the free values of all mwms. The limits are global, so the cache never holds
+  // more than |maxSize| values whatever the shards of the mwms are.
+  class Cache
+  {
+  public:
+    explicit Cache(size_t maxSize) : m_maxSize(maxSize) {}
+
+    // Adds |p| as the most recently used value and evicts the least recently used ones
+    // while the limits are exceeded.
+    void Push(MwmId const & id, std::unique_ptr<MwmValue> p);
+    std::unique_ptr<MwmValue> Pop(MwmId const & id);
+    void Erase(MwmId const & id);
+    void Clear();
+
+    void SetMemoryLimit(uint64_t bytes);
+    uint64_t GetMemoryUsage() const;
+
+  private:
+    // Evicts the least recently used values while there are more than |m_maxSize| of them
+    // or, when |m_memoryLimit| is not zero, while their total cost exceeds |m_memoryLimit|.
+    /// @precondition This function is always called under |m_lock|.
+    void Shrink();
+
+    mutable std::mutex m_lock;
+    std::deque<std::pair<MwmId, std::unique_ptr<MwmValue>>> m_values;
+    size_t const m_maxSize;
+    uint64_t m_memoryLimit = 0;
+    // Sum of the memory costs of the values in |m_values|.
+    uint64_t m_cost = 0;
+  };
+
+  static size_t constexpr kNumShards = 16;
 
   // This is the only valid way to take |m_lock| and use *Impl()
   // functions. The reason is that event processing requires
@@ -339,20 +395,21 @@ private:
   // Triggers observers on each event in |events|.
   void ProcessEventList(EventList & events);
 
-  /// @precondition This function is always called under mutex m_lock.
-  MwmHandle GetMwmHandleByIdImpl(MwmId const & id, EventList & events);
+  Shard & GetShard(MwmInfo const & info) { return m_shards[info.m_shardIdx]; }
 
   std::unique_ptr<MwmValue> LockValue(MwmId const & id);
-  std::unique_ptr<MwmValue> LockValueImpl(MwmId const & id, EventList & events);
+  // Sets |deregister| to true if the mwm should be deregistered because of a bad file.
+  /// @precondition This function is always called under the shard lock of |id|.
+  std::unique_ptr<MwmValue> LockValueImpl(MwmId const & id, bool & deregister);
   void UnlockValue(MwmId const & id, std::unique_ptr<MwmValue> p);
-  void UnlockValueImpl(MwmId const & id, std::unique_ptr<MwmValue> p, EventList & events);
-
-  /// Do the cleaning for [beg, end) without acquiring the mutex.
-  /// @precondition This function is always called under mutex m_lock.
-  void ClearCacheImpl(Cache::iterator beg, Cache::iterator end);
+  // Sets |deregister| to true if the last handle of the mwm marked to deregister is unlocked.
+  /// @precondition This function is always called under the shard lock of |id|.
+  void UnlockValueImpl(MwmId const & id, std::unique_ptr<MwmValue> p, bool & deregister);
 
+  std::array<Shard, kNumShards> m_shards;
   Cache m_cache;
-  size_t const m_cacheSize;
+  // Shard of the next registered mwm.
+  size_t m_nextShardIdx = 0;
 
 protected:
   /// @precondition This function is always called under mutex m_lock.
@@ -378,10 +435,17 @@ public:
   platform::LocalCountryFile const m_file;
 
   std::shared_ptr<feature::FeaturesOffsetsTable> m_table;
+  // May be nullptr if the mwm can't be memory-mapped.
+  std::shared_ptr<feature::SharedFeaturesVector> m_features;
 
   explicit MwmValue(platform::LocalCountryFile const & localFile);
   void SetTable(MwmInfoEx & info);
 
+  // Estimation of the memory which is held while the value is alive: the sections which
+  // are mapped by the value or by |m_table| and |m_features| plus fixed bookkeeping overhead.
+  // Mapped pages are shared between the values of the same mwm, so it's an upper bound.
+  uint64_t GetMemoryCost() const { return m_memoryCost; }
+
   feature::DataHeader const & GetHeader() const  { return m_factory.GetHeader(); }
   feature::RegionData const & GetRegionData() const { return m_factory.GetRegionData(); }
   version::MwmVersion const & GetMwmVersion() const { return m_factory.GetMwmVersion(); }
@@ -389,6 +453,9 @@ public:
 
   bool HasSearchIndex() const { return m_cont.IsExist(SEARCH_INDEX_FILE_TAG); }
   bool HasGeometryIndex() const { return m_cont.IsExist(INDEX_FILE_TAG); }
+
+private:
+  uint64_t m_memoryCost = 0;
 }; // class MwmValue
 
 
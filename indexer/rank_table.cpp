@@ -26,6 +26,7 @@
 #include "base/math.hpp"
 
 #include <algorithm>
+#include <array>
 #include <exception>
 #include <limits>
 #include <utility>
@@ -103,6 +104,14 @@ public:
 
     return m_coding.Get(i);
   }
+
+  void GetBatch(vector<uint32_t> const & ids, vector<uint8_t> & ranks) const override
+  {
+    auto const size = Size();
+    ranks.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+      ranks[i] = ids[i] < size ? m_coding.Get(ids[i]) : 0;
+  }
   uint64_t Size() const override { return m_coding.Size(); }
   RankTable::Version GetVersion() const override { return V0; }
   void Serialize(Writer & writer, bool preserveHostEndianness) override
@@ -296,6 +305,13 @@ unique_ptr<RankTable> CreateSearchRankTableIfNotExists(FilesContainerR & rcont)
 }
 }  // namespace
 
+void RankTable::GetBatch(vector<uint32_t> const & ids, vector<uint8_t> & ranks) const
+{
+  ranks.resize(ids.size());
+  for (size_t i = 0; i < ids.size(); ++i)
+    ranks[i] = Get(ids[i]);
+}
+
 // static
 unique_ptr<RankTable> RankTable::Load(FilesContainerR const & rcont, string const & sectionName)
 {
@@ -372,6 +388,25 @@ bool SearchRankTableBuilder::CreateIfNotExists(string const & mapPath) noexcept
   }
 }
 
+uint8_t GetTopRankThreshold(vector<uint8_t> const & ranks, size_t k)
+{
+  CHECK_GREATER(k, 0, ());
+  CHECK_LESS_OR_EQUAL(k, ranks.size(), ());
+
+  array<size_t, numeric_limits<uint8_t>::max() + 1> histogram = {};
+  for (auto const rank : ranks)
+    ++histogram[rank];
+
+  size_t count = 0;
+  for (size_t rank = histogram.size(); rank > 0; --rank)
+  {
+    count += histogram[rank - 1];
+    if (count >= k)
+      return static_cast<uint8_t>(rank - 1);
+  }
+  UNREACHABLE();
+}
+
 // static
 void RankTableBuilder::Create(vector<uint8_t> const & ranks, FilesContainerW & wcont,
                               string const & sectionName)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -51,6 +52,10 @@ public:
   // Returns rank of the i-th feature.
   virtual uint8_t Get(uint64_t i) const = 0;
 
+  // Fills |ranks| with the ranks of the features |ids|. Reads the whole batch in one call
+  // instead of a virtual call per feature.
+  virtual void GetBatch(std::vector<uint32_t> const & ids, std::vector<uint8_t> & ranks) const;
+
   // Returns total number of ranks (or features, as there is a 1-1 correspondence).
   virtual uint64_t Size() const = 0;
 
@@ -86,6 +91,13 @@ public:
                                          std::string const & sectionName);
 };
 
+// Returns the highest rank |threshold| such that at least |k| of |ranks| are not less than
+// |threshold|, i.e. the rank of the k-th best value. All the top |k| values are not less than
+// |threshold| and all the values greater than |threshold| are among the top |k|. Ranks are
+// counted in a histogram, so the selection takes linear time without comparisons.
+// |k| must be positive and not greater than the size of |ranks|.
+uint8_t GetTopRankThreshold(std::vector<uint8_t> const & ranks, size_t k);
+
 // A builder class for rank tables.
 class RankTableBuilder
 {
@@ -9,11 +9,14 @@
 
 #include "base/assert.hpp"
 #include "base/dfa_helpers.hpp"
+#include "base/lru_cache.hpp"
 #include "base/macros.hpp"
 #include "base/mem_trie.hpp"
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <queue>
 #include <vector>
 
@@ -94,10 +97,33 @@ size_t GetMaxErrorsForToken(strings::UniString const & token)
 
 strings::LevenshteinDFA BuildLevenshteinDFA(strings::UniString const & s)
 {
+  // The same tokens are matched over and over while a query is typed and ranked, and by
+  // all the search engine threads, so the built automata are shared by them. The errors
+  // and the misprints are defined by |s|, so |s| is the key.
+  size_t constexpr kMaxCachedDFAs = 1024;
+  static mutex cacheMutex;
+  static LruCache<string, optional<LevenshteinDFA>> cache(kMaxCachedDFAs);
+
+  auto const key = ToUtf8(s);
+  {
+    lock_guard<mutex> lock(cacheMutex);
+    bool found = false;
+    auto const & dfa = cache.Find(key, found);
+    if (found && dfa)
+      return *dfa;
+  }
+
   // In search we use LevenshteinDFAs for fuzzy matching. But due to
   // performance reasons, we limit prefix misprints to fixed set of substitutions defined in
   // kAllowedMisprints and skipped letters.
-  return strings::LevenshteinDFA(s, 1 /* prefixSize */, kAllowedMisprints, GetMaxErrorsForToken(s));
+  LevenshteinDFA dfa(s, 1 /* prefixSize */, kAllowedMisprints, GetMaxErrorsForToken(s));
+
+  lock_guard<mutex> lock(cacheMutex);
+  bool found = false;
+  auto & cached = cache.Find(key, found);
+  if (!cached)
+    cached.emplace(dfa);
+  return dfa;
 }
 
 UniString NormalizeAndSimplifyString(string const & s)
@@ -0,0 +1,90 @@
+#include "indexer/shared_features_vector.hpp"
+
+#include "indexer/dat_section_header.hpp"
+
+#include "platform/mwm_version.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+using namespace std;
+
+namespace feature
+{
+// static
+unique_ptr<SharedFeaturesVector> SharedFeaturesVector::Load(FilesContainerR const & cont,
+                                                            DataHeader const & header)
+{
+  // Sections of all the opened mwms do not fit into 32-bit address space.
+  if (sizeof(void *) < 8)
+    return {};
+
+  auto const format = header.GetFormat();
+  string const dataTag = format < version::Format::v10 ? FEATURES_FILE_TAG_V1_V9 : FEATURES_FILE_TAG;
+
+  unique_ptr<SharedFeaturesVector> shared(new SharedFeaturesVector());
+  try
+  {
+    shared->m_file.Open(cont.GetFileName());
+
+    auto const dataOffsetAndSize = cont.GetAbsoluteOffsetAndSize(dataTag);
+    uint64_t recordsOffset = dataOffsetAndSize.first;
+    uint64_t recordsSize = dataOffsetAndSize.second;
+    if (format >= version::Format::v10)
+    {
+      auto reader = cont.GetReader(dataTag);
+      DatSectionHeader datHeader;
+      datHeader.Read(*reader.GetPtr());
+      CHECK(datHeader.m_version == DatSectionHeader::Version::V0,
+            (base::Underlying(datHeader.m_version)));
+      recordsOffset += datHeader.m_featuresOffset;
+      recordsSize = datHeader.m_featuresSize;
+    }
+    if (recordsSize == 0)
+      return {};
+
+    shared->m_records =
+        make_unique<MappedMemoryRegion>(shared->m_file.Map(recordsOffset, recordsSize, dataTag));
+    shared->m_geometry = MappedGeometry::Load(shared->m_file, cont, header);
+
+    if (format >= version::Format::v11)
+    {
+      shared->m_metadata = MappedGeometry::MapSection(shared->m_file, cont, METADATA_FILE_TAG);
+      if (!shared->m_metadata)
+        return {};
+
+      shared->m_metadataReader = make_unique<MemReader>(
+          shared->m_metadata->ImmutableData(), static_cast<size_t>(shared->m_metadata->Size()));
+      shared->m_metaDeserializer = indexer::MetadataDeserializer::Load(
+          *shared->m_metadataReader, cont.GetFileName() + ":" + METADATA_FILE_TAG);
+      if (!shared->m_metaDeserializer)
+        return {};
+    }
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't map features of", cont.GetFileName(), ":", e.Msg()));
+    return {};
+  }
+
+  return shared;
+}
+
+vector<uint8_t> SharedFeaturesVector::ReadRecord(uint32_t pos) const
+{
+  vector<uint8_t> buffer;
+  ReadRecord(pos, buffer);
+  return buffer;
+}
+
+void SharedFeaturesVector::ReadRecord(uint32_t pos, vector<uint8_t> & buffer) const
+{
+  ASSERT_LESS(pos, m_records->Size(), ());
+  ArrayByteSource src(m_records->ImmutableData() + pos);
+  uint32_t const recordSize = ReadVarUint<uint32_t>(src);
+  auto const * data = src.PtrUint8();
+  buffer.assign(data, data + recordSize);
+}
+}  // namespace feature
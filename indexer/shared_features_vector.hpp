@@ -0,0 +1,72 @@
+#pragma once
+
+#include "indexer/data_header.hpp"
+#include "indexer/mapped_geometry.hpp"
+#include "indexer/metadata_serdes.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/files_container.hpp"
+#include "coding/memory_region.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace feature
+{
+// Immutable part of FeaturesVector: memory-mapped features records, geometry and metadata
+// of an mwm. It is created once per mwm and is shared by all FeaturesVectors of the mwm,
+// which in turn keep only the per-thread decoding state.
+// This class is thread-safe.
+class SharedFeaturesVector
+{
+public:
+  // Returns nullptr if the mwm can't be memory-mapped.
+  static std::unique_ptr<SharedFeaturesVector> Load(FilesContainerR const & cont,
+                                                    DataHeader const & header);
+
+  // |pos| is an offset of the record in the features section, see FeaturesOffsetsTable.
+  std::vector<uint8_t> ReadRecord(uint32_t pos) const;
+  // Reads the record into |buffer| reusing its memory.
+  void ReadRecord(uint32_t pos, std::vector<uint8_t> & buffer) const;
+
+  template <class ToDo>
+  void ForEachRecord(ToDo && toDo) const
+  {
+    uint8_t const * const beg = m_records->ImmutableData();
+    uint8_t const * const end = beg + m_records->Size();
+    ArrayByteSource src(beg);
+    while (src.PtrUint8() < end)
+    {
+      auto const pos = static_cast<uint32_t>(src.PtrUint8() - beg);
+      uint32_t const recordSize = ReadVarUint<uint32_t>(src);
+      auto const * data = src.PtrUint8();
+      src.Advance(recordSize);
+      toDo(pos, std::vector<uint8_t>(data, data + recordSize));
+    }
+  }
+
+  MappedGeometry const & GetGeometry() const { return *m_geometry; }
+
+  // Metadata deserializer for mwms of version::Format::v11 and later, nullptr otherwise.
+  // MetadataDeserializer::Get* methods are thread-safe.
+  indexer::MetadataDeserializer * GetMetaDeserializer() const { return m_metaDeserializer.get(); }
+
+private:
+  SharedFeaturesVector() = default;
+
+  detail::MappedFile m_file;
+  std::unique_ptr<MemoryRegion> m_records;
+  std::unique_ptr<MappedGeometry> m_geometry;
+  // Metadata deserializer reads strings right from |m_metadata|.
+  std::unique_ptr<MemoryRegion> m_metadata;
+  std::unique_ptr<MemReader> m_metadataReader;
+  std::unique_ptr<indexer::MetadataDeserializer> m_metaDeserializer;
+
+  DISALLOW_COPY_AND_MOVE(SharedFeaturesVector);
+};
+}  // namespace feature
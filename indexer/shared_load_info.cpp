@@ -6,8 +6,9 @@
 
 namespace feature
 {
-SharedLoadInfo::SharedLoadInfo(FilesContainerR const & cont, DataHeader const & header)
-  : m_cont(cont), m_header(header)
+SharedLoadInfo::SharedLoadInfo(FilesContainerR const & cont, DataHeader const & header,
+                               MappedGeometry const * geometry)
+  : m_cont(cont), m_header(header), m_geometry(geometry)
 {
   CHECK_NOT_EQUAL(m_header.GetFormat(), version::Format::v1, ("Old maps format is not supported"));
 }
@@ -44,6 +45,16 @@ SharedLoadInfo::Reader SharedLoadInfo::GetTrianglesReader(int ind) const
   return m_cont.GetReader(GetTagForIndex(TRIANGLE_FILE_TAG, ind));
 }
 
+MemoryRegion const * SharedLoadInfo::GetGeometryRegion(int ind) const
+{
+  return m_geometry ? m_geometry->GetGeometryRegion(ind) : nullptr;
+}
+
+MemoryRegion const * SharedLoadInfo::GetTrianglesRegion(int ind) const
+{
+  return m_geometry ? m_geometry->GetTrianglesRegion(ind) : nullptr;
+}
+
 std::optional<SharedLoadInfo::Reader> SharedLoadInfo::GetPostcodesReader() const
 {
   if (!m_cont.IsExist(POSTCODES_FILE_TAG))
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "indexer/data_header.hpp"
+#include "indexer/mapped_geometry.hpp"
 
 #include "coding/files_container.hpp"
 #include "coding/geometry_coding.hpp"
+#include "coding/memory_region.hpp"
 
 #include "base/macros.hpp"
 
@@ -17,7 +19,9 @@ class SharedLoadInfo
 public:
   using Reader = FilesContainerR::TReader;
 
-  SharedLoadInfo(FilesContainerR const & cont, DataHeader const & header);
+  // |geometry| is optional, if it is set outer geometry is read from the mapped memory.
+  SharedLoadInfo(FilesContainerR const & cont, DataHeader const & header,
+                 MappedGeometry const * geometry = nullptr);
   ~SharedLoadInfo() = default;
 
   Reader GetDataReader() const;
@@ -28,6 +32,10 @@ public:
   Reader GetTrianglesReader(int ind) const;
   std::optional<Reader> GetPostcodesReader() const;
 
+  // Return nullptr if geometry is not mapped.
+  MemoryRegion const * GetGeometryRegion(int ind) const;
+  MemoryRegion const * GetTrianglesRegion(int ind) const;
+
   version::Format GetMWMFormat() const { return m_header.GetFormat(); }
 
   serial::GeometryCodingParams const & GetDefGeometryCodingParams() const
@@ -47,6 +55,7 @@ public:
 private:
   FilesContainerR const & m_cont;
   DataHeader const & m_header;
+  MappedGeometry const * m_geometry;
 
   DISALLOW_COPY_AND_MOVE(SharedLoadInfo);
 };
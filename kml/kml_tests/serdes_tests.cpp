@@ -10,6 +10,7 @@
 #include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
 #include "coding/hex.hpp"
+#include "coding/mmap_reader.hpp"
 #include "coding/reader.hpp"
 #include "coding/string_utf8_multilang.hpp"
 #include "coding/writer.hpp"
@@ -791,3 +792,51 @@ UNIT_TEST(Kml_Deserialization_From_Bin_V6_And_V7)
 
   TEST_EQUAL(dataFromBinV6, dataFromBinV7, ());
 }
+
+UNIT_TEST(Kml_Lazy_Deserialization_Bin_File)
+{
+  auto data = GenerateKmlFileData();
+
+  std::string const kmbFile = base::JoinPath(GetPlatform().TmpDir(), "tmp_lazy.kmb");
+  SCOPE_GUARD(fileGuard, std::bind(&FileWriter::DeleteFileX, kmbFile));
+  {
+    kml::binary::SerializerKml ser(data);
+    FileWriter writer(kmbFile);
+    ser.Serialize(writer);
+  }
+
+  auto des = kml::binary::LazyDeserializerKml::Load(std::make_unique<MmapReader>(kmbFile));
+  TEST(des, ());
+  TEST_EQUAL(des->GetCategoryData(), data.m_categoryData, ());
+  TEST_EQUAL(des->GetCompilationsData(), data.m_compilationsData, ());
+  TEST_EQUAL(des->GetBookmarksCount(), data.m_bookmarksData.size(), ());
+  TEST_EQUAL(des->GetTracksCount(), data.m_tracksData.size(), ());
+
+  // Items are read in any order.
+  for (size_t i = des->GetBookmarksCount(); i > 0; --i)
+    TEST_EQUAL(des->GetBookmark(i - 1), data.m_bookmarksData[i - 1], ());
+  for (size_t i = des->GetTracksCount(); i > 0; --i)
+    TEST_EQUAL(des->GetTrack(i - 1), data.m_tracksData[i - 1], ());
+
+  TEST_EQUAL(des->GetFileData(), data, ());
+}
+
+UNIT_TEST(Kml_Lazy_Deserialization_Old_Version)
+{
+  // Older versions are converted by DeserializerKml only.
+  TEST(!kml::binary::LazyDeserializerKml::Load(
+           std::make_unique<MemReader>(kBinKmlV7.data(), kBinKmlV7.size())),
+       ());
+
+  kml::FileData dataFromBin;
+  {
+    MemReader reader(kBinKml.data(), kBinKml.size());
+    kml::binary::DeserializerKml des(dataFromBin);
+    des.Deserialize(reader);
+  }
+
+  auto lazyDes = kml::binary::LazyDeserializerKml::Load(
+      std::make_unique<MemReader>(kBinKml.data(), kBinKml.size()));
+  TEST(lazyDes, ());
+  TEST_EQUAL(lazyDes->GetFileData(), dataFromBin, ());
+}
@@ -1,5 +1,7 @@
 #include "kml/serdes_binary.hpp"
 
+#include "base/assert.hpp"
+
 namespace kml
 {
 namespace binary
@@ -34,5 +36,131 @@ DeserializerKml::DeserializerKml(FileData & data)
 {
   m_data = {};
 }
+
+// static
+std::unique_ptr<LazyDeserializerKml> LazyDeserializerKml::Load(std::unique_ptr<Reader> reader)
+{
+  CHECK(reader, ());
+  NonOwningReaderSource source(*reader);
+
+  Header header;
+  header.m_version = ReadPrimitiveFromSource<Version>(source);
+  if (header.m_version != Version::Latest)
+    return {};
+
+  std::unique_ptr<LazyDeserializerKml> des(new LazyDeserializerKml());
+  rw::Read(source, des->m_deviceId);
+  rw::Read(source, des->m_serverId);
+  des->m_doubleBits = ReadPrimitiveFromSource<uint8_t>(source);
+  if (des->m_doubleBits == 0 || des->m_doubleBits > 32)
+  {
+    MYTHROW(DeserializeException,
+            ("Incorrect double bits count: ", static_cast<int>(des->m_doubleBits)));
+  }
+
+  des->m_reader = reader->CreateSubReader(source.Pos(), source.Size());
+  {
+    NonOwningReaderSource headerSource(*des->m_reader);
+    header.Deserialize(headerSource);
+  }
+  if (header.m_categoryOffset > header.m_bookmarksOffset ||
+      header.m_bookmarksOffset > header.m_tracksOffset ||
+      header.m_tracksOffset > header.m_compilationsOffset ||
+      header.m_compilationsOffset > header.m_stringsOffset ||
+      header.m_stringsOffset > header.m_eosOffset ||
+      header.m_eosOffset > des->m_reader->Size())
+  {
+    MYTHROW(DeserializeException, ("Incorrect header."));
+  }
+
+  {
+    auto categoryReader = des->m_reader->CreateSubReader(
+        header.m_categoryOffset, header.m_bookmarksOffset - header.m_categoryOffset);
+    NonOwningReaderSource src(*categoryReader);
+    CategoryDeserializerVisitor<decltype(src)> visitor(src, des->m_doubleBits);
+    visitor(des->m_categoryData);
+  }
+  {
+    auto compilationsReader = des->m_reader->CreateSubReader(
+        header.m_compilationsOffset, header.m_stringsOffset - header.m_compilationsOffset);
+    NonOwningReaderSource src(*compilationsReader);
+    CategoryDeserializerVisitor<decltype(src)> visitor(src, des->m_doubleBits);
+    visitor(des->m_compilationsData);
+  }
+
+  des->m_bookmarksOffsets =
+      des->ReadOffsets<BookmarkData>(header.m_bookmarksOffset, header.m_tracksOffset);
+  des->m_tracksOffsets =
+      des->ReadOffsets<TrackData>(header.m_tracksOffset, header.m_compilationsOffset);
+
+  des->m_stringsReader = des->m_reader->CreateSubReader(
+      header.m_stringsOffset, header.m_eosOffset - header.m_stringsOffset);
+  des->m_strings = std::make_unique<coding::BlockedTextStorage<Reader>>(*des->m_stringsReader);
+
+  des->ExtractStrings(des->m_categoryData);
+  for (auto & compilation : des->m_compilationsData)
+    des->ExtractStrings(compilation);
+  return des;
+}
+
+BookmarkData LazyDeserializerKml::GetBookmark(size_t index) const
+{
+  CHECK_LESS(index, m_bookmarksOffsets.size(), ());
+  return ReadItem<BookmarkData>(m_bookmarksOffsets[index]);
+}
+
+TrackData LazyDeserializerKml::GetTrack(size_t index) const
+{
+  CHECK_LESS(index, m_tracksOffsets.size(), ());
+  return ReadItem<TrackData>(m_tracksOffsets[index]);
+}
+
+FileData LazyDeserializerKml::GetFileData() const
+{
+  FileData data;
+  data.m_deviceId = m_deviceId;
+  data.m_serverId = m_serverId;
+  data.m_categoryData = m_categoryData;
+  data.m_compilationsData = m_compilationsData;
+  data.m_bookmarksData.reserve(m_bookmarksOffsets.size());
+  for (auto const offset : m_bookmarksOffsets)
+    data.m_bookmarksData.push_back(ReadItem<BookmarkData>(offset));
+  data.m_tracksData.reserve(m_tracksOffsets.size());
+  for (auto const offset : m_tracksOffsets)
+    data.m_tracksData.push_back(ReadItem<TrackData>(offset));
+  return data;
+}
+
+template <typename T>
+std::vector<uint64_t> LazyDeserializerKml::ReadOffsets(uint64_t startPos, uint64_t endPos)
+{
+  // Records are of variable size, so the non-string members of every record are decoded
+  // once to find where the next one starts.
+  auto subReader = m_reader->CreateSubReader(startPos, endPos - startPos);
+  NonOwningReaderSource src(*subReader);
+  BookmarkDeserializerVisitor<decltype(src)> visitor(src, m_doubleBits);
+  auto const count = ReadVarUint<uint32_t>(src);
+  std::vector<uint64_t> offsets;
+  offsets.reserve(count);
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    offsets.push_back(startPos + src.Pos());
+    T item;
+    visitor(item);
+  }
+  return offsets;
+}
+
+template <typename T>
+T LazyDeserializerKml::ReadItem(uint64_t offset) const
+{
+  auto subReader = m_reader->CreateSubReader(offset, m_reader->Size() - offset);
+  NonOwningReaderSource src(*subReader);
+  BookmarkDeserializerVisitor<decltype(src)> visitor(src, m_doubleBits);
+  T item;
+  visitor(item);
+  ExtractStrings(item);
+  return item;
+}
 }  // namespace binary
 }  // namespace kml
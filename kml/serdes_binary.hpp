@@ -14,6 +14,7 @@
 #include "coding/sha1.hpp"
 #include "coding/text_storage.hpp"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -376,5 +377,68 @@ private:
   uint8_t m_doubleBits = 0;
   bool m_initialized = false;
 };
+
+// Reads kmb files of the latest version without materialising the whole FileData. Only the
+// header, the category, the compilations and the offsets of the bookmarks and tracks are read
+// on loading. Bookmarks and tracks are decoded on access and their strings are extracted from
+// the text storage, which keeps a single decompressed block. Over an MmapReader the pages of
+// the file which are not accessed are not even read from the disk.
+//
+// *NOTE* This class is not thread-safe.
+class LazyDeserializerKml
+{
+public:
+  using DeserializeException = DeserializerKml::DeserializeException;
+
+  // Returns nullptr if the file is of an older version, such files must be read by
+  // DeserializerKml which converts them. Throws DeserializeException or Reader::Exception
+  // if the file is broken.
+  static std::unique_ptr<LazyDeserializerKml> Load(std::unique_ptr<Reader> reader);
+
+  std::string const & GetDeviceId() const { return m_deviceId; }
+  std::string const & GetServerId() const { return m_serverId; }
+  CategoryData const & GetCategoryData() const { return m_categoryData; }
+  std::vector<CategoryData> const & GetCompilationsData() const { return m_compilationsData; }
+
+  size_t GetBookmarksCount() const { return m_bookmarksOffsets.size(); }
+  size_t GetTracksCount() const { return m_tracksOffsets.size(); }
+
+  BookmarkData GetBookmark(size_t index) const;
+  TrackData GetTrack(size_t index) const;
+
+  // Materialises the whole file, the result is the same as the one of DeserializerKml.
+  FileData GetFileData() const;
+
+private:
+  LazyDeserializerKml() = default;
+
+  template <typename T>
+  std::vector<uint64_t> ReadOffsets(uint64_t startPos, uint64_t endPos);
+
+  template <typename T>
+  T ReadItem(uint64_t offset) const;
+
+  template <typename T>
+  void ExtractStrings(T & data) const
+  {
+    DeserializedStringCollector<Reader> collector(*m_strings);
+    CollectorVisitor<decltype(collector)> visitor(collector);
+    visitor(data);
+    CollectorVisitor<decltype(collector)> clearVisitor(collector, true /* clear index */);
+    clearVisitor(data);
+  }
+
+  std::unique_ptr<Reader> m_reader;
+  uint8_t m_doubleBits = 0;
+  std::string m_deviceId;
+  std::string m_serverId;
+  CategoryData m_categoryData;
+  std::vector<CategoryData> m_compilationsData;
+  // Offsets of the bookmarks and tracks in |m_reader|.
+  std::vector<uint64_t> m_bookmarksOffsets;
+  std::vector<uint64_t> m_tracksOffsets;
+  std::unique_ptr<Reader> m_stringsReader;
+  std::unique_ptr<coding::BlockedTextStorage<Reader>> m_strings;
+};
 }  // namespace binary
 }  // namespace kml
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <utility>
 #include <vector>
@@ -45,4 +46,9 @@ namespace bench
 
   /// @param[in] count number of times to run benchmark
   void RunFeaturesLoadingBenchmark(std::string const & file, std::pair<int, int> scaleR, AllResult & res);
+
+  /// Measures the decoding paths one by one (features parsing, varints, geometry codec, compressed
+  /// bit vectors, search trie and scale index) and prints time, bytes and allocations per operation.
+  /// @param[in] maxFeatures number of the first features of the mwm which are parsed
+  void RunDecodingBenchmarks(std::string const & file, size_t maxFeatures);
 }  // namespace bench
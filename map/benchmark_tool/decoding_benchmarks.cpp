@@ -0,0 +1,372 @@
+#include "map/benchmark_tool/api.hpp"
+
+#include "map/features_fetcher.hpp"
+
+#include "search/search_index_header.hpp"
+#include "search/search_index_values.hpp"
+
+#include "indexer/feature_covering.hpp"
+#include "indexer/scale_index.hpp"
+#include "indexer/trie_reader.hpp"
+
+#include "platform/mwm_traits.hpp"
+
+#include "coding/compressed_bit_vector.hpp"
+#include "coding/geometry_coding.hpp"
+#include "coding/reader_wrapper.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/file_name_utils.hpp"
+#include "base/timer.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+atomic<uint64_t> g_allocationsCount{0};
+}  // namespace
+
+// Allocations of the whole tool are counted to report them per benchmarked operation.
+void * operator new(size_t size)
+{
+  g_allocationsCount.fetch_add(1, memory_order_relaxed);
+  if (void * p = malloc(size == 0 ? 1 : size))
+    return p;
+  throw bad_alloc();
+}
+
+void operator delete(void * p) noexcept { free(p); }
+
+void operator delete(void * p, size_t /* size */) noexcept { free(p); }
+
+namespace bench
+{
+namespace
+{
+size_t constexpr kVarintsCount = 1 << 20;
+size_t constexpr kCbvRepeatsCount = 100;
+size_t constexpr kLookupsCount = 1000;
+// Viewports of the scale index lookups are about a tile of this zoom.
+int constexpr kLookupZoom = 15;
+
+struct Stats
+{
+  uint64_t m_ops = 0;
+  uint64_t m_bytes = 0;
+};
+
+// Runs |fn| which does a number of operations and prints the time, the decoded bytes and
+// the allocations per operation.
+template <typename Fn>
+void Measure(string const & name, Fn && fn)
+{
+  auto const allocationsCount = g_allocationsCount.load(memory_order_relaxed);
+  base::HighResTimer timer;
+  Stats const stats = fn();
+  auto const ns = timer.ElapsedNano();
+  auto const allocations = g_allocationsCount.load(memory_order_relaxed) - allocationsCount;
+
+  cout << left << setw(24) << name << right << setw(10) << stats.m_ops << " ops";
+  if (stats.m_ops == 0)
+  {
+    cout << endl;
+    return;
+  }
+
+  double const ops = static_cast<double>(stats.m_ops);
+  cout << fixed << setprecision(1) << setw(12) << ns / ops << " ns/op" << setw(10)
+       << stats.m_bytes / ops << " B/op" << setw(8) << allocations / ops << " allocs/op" << endl;
+}
+
+void RunFeaturesBenchmarks(FeaturesLoaderGuard const & guard, size_t maxFeatures,
+                           vector<vector<m2::PointD>> & paths)
+{
+  size_t const count = min(maxFeatures, guard.GetNumFeatures());
+  vector<unique_ptr<FeatureType>> features(count);
+
+  // Every feature is parsed by each of the stages once, so the stages are measured one after
+  // another and a stage doesn't include the work of the previous ones.
+  Measure("LoadFeature", [&]() {
+    Stats stats;
+    for (uint32_t i = 0; i < count; ++i, ++stats.m_ops)
+      features[i] = guard.GetOriginalFeatureByIndex(i);
+    return stats;
+  });
+
+  Measure("ParseHeader2", [&]() {
+    Stats stats;
+    for (auto & ft : features)
+    {
+      ft->ParseBeforeStatistic();
+      stats.m_bytes += ft->GetInnerStatistic().m_size;
+      ++stats.m_ops;
+    }
+    return stats;
+  });
+
+  Measure("ParseGeometry", [&]() {
+    Stats stats;
+    for (auto & ft : features)
+    {
+      stats.m_bytes += ft->ParseGeometry(FeatureType::BEST_GEOMETRY);
+      ++stats.m_ops;
+    }
+    return stats;
+  });
+
+  Measure("ParseTriangles", [&]() {
+    Stats stats;
+    for (auto & ft : features)
+    {
+      stats.m_bytes += ft->ParseTriangles(FeatureType::BEST_GEOMETRY);
+      ++stats.m_ops;
+    }
+    return stats;
+  });
+
+  Measure("ParseMetadata", [&]() {
+    Stats stats;
+    for (auto & ft : features)
+    {
+      stats.m_bytes += ft->GetMetadata().Size();
+      ++stats.m_ops;
+    }
+    return stats;
+  });
+
+  // The same stages for the features loaded into a single reused feature. Allocations per
+  // feature should be close to zero in the steady state.
+  Measure("ReloadFeature", [&]() {
+    Stats stats;
+    unique_ptr<FeatureType> ft;
+    for (uint32_t i = 0; i < count; ++i, ++stats.m_ops)
+    {
+      CHECK(guard.GetFeatureByIndex(i, ft), ());
+      ft->ParseBeforeStatistic();
+      stats.m_bytes += ft->ParseGeometry(FeatureType::BEST_GEOMETRY);
+      stats.m_bytes += ft->ParseTriangles(FeatureType::BEST_GEOMETRY);
+    }
+    return stats;
+  });
+
+  for (auto & ft : features)
+  {
+    if (ft->GetGeomType() != feature::GeomType::Line)
+      continue;
+
+    vector<m2::PointD> path(ft->GetPointsCount());
+    for (size_t i = 0; i < path.size(); ++i)
+      path[i] = ft->GetPoint(i);
+    paths.push_back(move(path));
+  }
+}
+
+void RunVarintBenchmarks()
+{
+  // Small values are much more frequent in mwms, so the values are skewed to them.
+  minstd_rand rng(0);
+  vector<uint32_t> values(kVarintsCount);
+  for (auto & value : values)
+    value = static_cast<uint32_t>(rng() >> (rng() % 31));
+
+  vector<uint8_t> buffer;
+  Measure("WriteVarUint", [&]() {
+    Stats stats;
+    MemWriter<vector<uint8_t>> writer(buffer);
+    for (auto const value : values)
+      WriteVarUint(writer, value);
+    stats.m_ops = values.size();
+    stats.m_bytes = buffer.size();
+    return stats;
+  });
+
+  uint64_t sum = 0;
+  Measure("ReadVarUint", [&]() {
+    Stats stats;
+    ArrayByteSource src(buffer.data());
+    for (size_t i = 0; i < values.size(); ++i)
+      sum += ReadVarUint<uint32_t>(src);
+    stats.m_ops = values.size();
+    stats.m_bytes = buffer.size();
+    return stats;
+  });
+  CHECK_EQUAL(sum, accumulate(values.cbegin(), values.cend(), uint64_t{0}), ());
+}
+
+void RunGeometryCodingBenchmarks(vector<vector<m2::PointD>> const & paths)
+{
+  serial::GeometryCodingParams params;
+  vector<uint8_t> buffer;
+  Measure("SaveOuterPath", [&]() {
+    Stats stats;
+    MemWriter<vector<uint8_t>> writer(buffer);
+    for (auto const & path : paths)
+    {
+      params.SetBasePoint(path.front());
+      serial::SaveOuterPath(path, params, writer);
+    }
+    stats.m_ops = paths.size();
+    stats.m_bytes = buffer.size();
+    return stats;
+  });
+
+  vector<m2::PointD> points;
+  Measure("LoadOuterPath", [&]() {
+    Stats stats;
+    ArrayByteSource src(buffer.data());
+    for (auto const & path : paths)
+    {
+      params.SetBasePoint(path.front());
+      points.clear();
+      serial::LoadOuterPath(src, params, points);
+    }
+    stats.m_ops = paths.size();
+    stats.m_bytes = buffer.size();
+    return stats;
+  });
+}
+
+void RunCbvBenchmarks(size_t featuresCount)
+{
+  // A dense set as for the features of a category and a sparse one as for a rare token.
+  vector<uint64_t> dense;
+  vector<uint64_t> sparse;
+  for (uint64_t i = 0; i < featuresCount; ++i)
+  {
+    if (i % 2 == 0)
+      dense.push_back(i);
+    if (i % 64 == 0)
+      sparse.push_back(i);
+  }
+  auto const lhs = coding::CompressedBitVectorBuilder::FromBitPositions(move(dense));
+  auto const rhs = coding::CompressedBitVectorBuilder::FromBitPositions(move(sparse));
+
+  auto const measure = [&](string const & name, auto && op) {
+    Measure(name, [&]() {
+      Stats stats;
+      for (size_t i = 0; i < kCbvRepeatsCount; ++i, ++stats.m_ops)
+        stats.m_bytes += op(*lhs, *rhs)->PopCount() / 8;
+      return stats;
+    });
+  };
+
+  measure("CBV::Intersect", &coding::CompressedBitVector::Intersect);
+  measure("CBV::Union", &coding::CompressedBitVector::Union);
+  measure("CBV::Subtract", &coding::CompressedBitVector::Subtract);
+}
+
+void RunTrieBenchmark(MwmValue const & value)
+{
+  if (!value.HasSearchIndex())
+    return;
+
+  version::MwmTraits const traits(value.GetMwmVersion());
+  if (traits.GetSearchIndexFormat() !=
+      version::MwmTraits::SearchIndexFormat::CompressedBitVectorWithHeader)
+  {
+    return;
+  }
+
+  auto reader = value.m_cont.GetReader(SEARCH_INDEX_FILE_TAG);
+  search::SearchIndexHeader header;
+  header.Read(*reader.GetPtr());
+  auto const indexReader = reader.SubReader(header.m_indexOffset, header.m_indexSize);
+
+  using Root = trie::Iterator<ValueList<Uint64IndexValue>>;
+  Measure("TrieTraversal", [&]() {
+    Stats stats;
+    vector<unique_ptr<Root>> nodes;
+    nodes.push_back(trie::ReadTrie<SubReaderWrapper<Reader>, ValueList<Uint64IndexValue>>(
+        SubReaderWrapper<Reader>(indexReader.GetPtr()),
+        SingleValueSerializer<Uint64IndexValue>()));
+    while (!nodes.empty())
+    {
+      auto const node = move(nodes.back());
+      nodes.pop_back();
+      ++stats.m_ops;
+      for (size_t i = 0; i < node->m_edges.size(); ++i)
+        nodes.push_back(node->GoToEdge(i));
+    }
+    stats.m_bytes = header.m_indexSize;
+    return stats;
+  });
+}
+
+void RunScaleIndexBenchmark(MwmValue const & value)
+{
+  auto const & header = value.GetHeader();
+  ScaleIndex<ModelReaderPtr> index(value.m_cont.GetReader(INDEX_FILE_TAG), value.m_factory);
+
+  minstd_rand rng(0);
+  m2::RectD const bounds = header.GetBounds();
+  double const size = mercator::Bounds::kRangeX / (1 << kLookupZoom);
+  uniform_real_distribution<double> x(bounds.minX(), bounds.maxX());
+  uniform_real_distribution<double> y(bounds.minY(), bounds.maxY());
+  vector<m2::RectD> rects(kLookupsCount);
+  for (auto & rect : rects)
+  {
+    auto const minX = x(rng);
+    auto const minY = y(rng);
+    rect = m2::RectD(minX, minY, minX + size, minY + size);
+  }
+
+  int const scale = min(kLookupZoom, header.GetLastScale());
+  Measure("ScaleIndexLookup", [&]() {
+    Stats stats;
+    uint64_t featuresCount = 0;
+    for (auto const & rect : rects)
+    {
+      covering::CoveringGetter cov(rect, covering::ViewportWithLowLevels);
+      index.ForEachInIntervalsAndScale(
+          cov.Get<RectId::DEPTH_LEVELS>(header.GetLastScale()), scale,
+          [&featuresCount](uint64_t /* key */, uint32_t /* value */) { ++featuresCount; });
+      ++stats.m_ops;
+    }
+    stats.m_bytes = featuresCount * sizeof(uint32_t);
+    return stats;
+  });
+}
+}  // namespace
+
+void RunDecodingBenchmarks(string const & file, size_t maxFeatures)
+{
+  string fileName = file;
+  base::GetNameFromFullPath(fileName);
+  base::GetNameWithoutExt(fileName);
+
+  FeaturesFetcher src;
+  auto const r = src.RegisterMap(platform::LocalCountryFile::MakeForTesting(fileName));
+  if (r.second != MwmSet::RegResult::Success)
+    return;
+
+  auto const handle = src.GetDataSource().GetMwmHandleById(r.first);
+  auto const * value = handle.GetValue();
+  CHECK(value, ());
+
+  FeaturesLoaderGuard guard(src.GetDataSource(), r.first);
+  vector<vector<m2::PointD>> paths;
+  RunFeaturesBenchmarks(guard, maxFeatures, paths);
+  RunVarintBenchmarks();
+  RunGeometryCodingBenchmarks(paths);
+  RunCbvBenchmarks(guard.GetNumFeatures());
+  RunTrieBenchmark(*value);
+  RunScaleIndexBenchmark(*value);
+}
+}  // namespace bench
@@ -13,6 +13,8 @@ DEFINE_string(input, "", "MWM file name in the data directory");
 DEFINE_int32(lowS, 10, "Low processing scale");
 DEFINE_int32(highS, 17, "High processing scale");
 DEFINE_bool(print_scales, false, "Print geometry scales for MWM and exit");
+DEFINE_bool(decoding, false, "Run decoding micro-benchmarks for MWM and exit");
+DEFINE_uint64(max_features, 100000, "Number of features parsed by decoding micro-benchmarks");
 
 int main(int argc, char ** argv)
 {
@@ -37,6 +39,12 @@ int main(int argc, char ** argv)
     return 0;
   }
 
+  if (FLAGS_decoding)
+  {
+    bench::RunDecodingBenchmarks(FLAGS_input, static_cast<size_t>(FLAGS_max_features));
+    return 0;
+  }
+
   if (!FLAGS_input.empty())
   {
     using namespace bench;
@@ -10,6 +10,7 @@
 #include "platform/http_client.hpp"
 #include "platform/platform.hpp"
 
+#include "coding/file_writer.hpp"
 #include "coding/reader.hpp"
 
 #include "geometry/mercator.hpp"
@@ -27,9 +28,12 @@
 
 namespace
 {
+std::string const kDefaultReportFile = "graphics_benchmark_report.json";
+
 struct BenchmarkHandle
 {
   std::vector<df::ScenarioManager::ScenarioData> m_scenariosToRun;
+  std::string m_reportFile = kDefaultReportFile;
   size_t m_currentScenario = 0;
   std::vector<storage::CountryId> m_regionsToDownload;
   size_t m_regionsToDownloadCounter = 0;
@@ -39,6 +43,100 @@ struct BenchmarkHandle
 #endif
 };
 
+#ifdef DRAPE_MEASURER_BENCHMARK
+base::JSONPtr ToJSON(df::DrapeMeasurer::DrapeStatistic const & statistic)
+{
+  using FrameStatistic = df::DrapeMeasurer::FrameStatistic;
+  auto const & frameStatistic = statistic.m_frameStatistic;
+  auto const framesCount = frameStatistic.m_framesCount;
+
+  auto result = base::NewJSONObject();
+  ToJSONObject(*result, "frames", framesCount);
+
+  auto phases = base::NewJSONObject();
+  for (size_t i = 0; i < FrameStatistic::kPhasesCount; ++i)
+  {
+    auto const & phase = frameStatistic.m_phases[i];
+    auto phaseNode = base::NewJSONObject();
+    ToJSONObject(*phaseNode, "avgTimeUs", framesCount == 0 ? 0 : phase.m_totalTimeInUs / framesCount);
+    ToJSONObject(*phaseNode, "maxTimeUs", phase.m_maxTimeInUs);
+    ToJSONObject(*phases, DebugPrint(static_cast<df::DrapeMeasurer::RenderPhase>(i)), phaseNode);
+  }
+  ToJSONObject(*result, "phases", phases);
+
+  // Bucket i contains the tile reads which took less than the i-th bound, -1 stands
+  // for the unbounded bucket.
+  auto tileReads = base::NewJSONArray();
+  auto const & histogram = frameStatistic.m_tileReadLatencyHistogram;
+  for (size_t i = 0; i < histogram.size(); ++i)
+  {
+    auto bucket = base::NewJSONObject();
+    int64_t const bound = i < FrameStatistic::kTileReadLatencyBoundsInMs.size()
+                              ? FrameStatistic::kTileReadLatencyBoundsInMs[i]
+                              : -1;
+    ToJSONObject(*bucket, "upToMs", bound);
+    ToJSONObject(*bucket, "count", histogram[i]);
+    ToJSONArray(*tileReads, bucket);
+  }
+  ToJSONObject(*result, "tileReadLatency", tileReads);
+
+#ifdef RENDER_STATISTIC
+  auto const & renderStatistic = statistic.m_renderStatistic;
+  ToJSONObject(*result, "fps", renderStatistic.m_FPS);
+  ToJSONObject(*result, "minFps", renderStatistic.m_minFPS);
+  ToJSONObject(*result, "frameRenderTimeMs", renderStatistic.m_frameRenderTimeInMs);
+#endif
+#ifdef TILES_STATISTIC
+  ToJSONObject(*result, "tilesCount", statistic.m_tileStatistic.m_totalTilesCount);
+  ToJSONObject(*result, "tileReadTimeMs", statistic.m_tileStatistic.m_tileReadTimeInMs);
+#endif
+#ifdef TRACK_GPU_MEM
+  auto const & memStatistic = statistic.m_gpuMemStatistic;
+  ToJSONObject(*result, "avgGpuAllocatedMb", memStatistic.m_averageMemoryValues.m_summaryAllocatedInMb);
+  ToJSONObject(*result, "avgGpuUsedMb", memStatistic.m_averageMemoryValues.m_summaryUsedInMb);
+  ToJSONObject(*result, "maxGpuAllocatedMb", memStatistic.m_maxMemoryValues.m_summaryAllocatedInMb);
+  ToJSONObject(*result, "maxGpuUsedMb", memStatistic.m_maxMemoryValues.m_summaryUsedInMb);
+#endif
+  return result;
+}
+
+// Saves the statistic of all the scenarios in a json file, so the runs on different builds,
+// devices and graphics APIs can be compared by a script.
+void SaveReport(BenchmarkHandle const & handle)
+{
+  auto const & measurer = df::DrapeMeasurer::Instance();
+  auto root = base::NewJSONObject();
+  ToJSONObject(*root, "version", GetPlatform().GetAppUserAgent().GetAppVersion());
+  ToJSONObject(*root, "device", GetPlatform().DeviceModel());
+  ToJSONObject(*root, "gpu", measurer.GetGpuName());
+  ToJSONObject(*root, "api", DebugPrint(measurer.GetApiVersion()));
+  ToJSONObject(*root, "width", measurer.GetResolution().x);
+  ToJSONObject(*root, "height", measurer.GetResolution().y);
+
+  auto scenarios = base::NewJSONObject();
+  for (auto const & it : handle.m_drapeStatistic)
+  {
+    auto statistic = ToJSON(it.second);
+    ToJSONObject(*scenarios, it.first, statistic);
+  }
+  ToJSONObject(*root, "scenarios", scenarios);
+
+  auto const fn = base::JoinPath(GetPlatform().SettingsDir(), handle.m_reportFile);
+  try
+  {
+    auto const report = base::DumpToString(root, JSON_INDENT(2) | JSON_SORT_KEYS);
+    FileWriter writer(fn);
+    writer.Write(report.data(), report.size());
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Error writing benchmark report", fn, e.what()));
+    return;
+  }
+  LOG(LINFO, ("Benchmark report is saved to", fn));
+}
+#endif
+
 void RunScenario(Framework * framework, std::shared_ptr<BenchmarkHandle> handle)
 {
   if (handle->m_currentScenario >= handle->m_scenariosToRun.size())
@@ -51,6 +149,7 @@ void RunScenario(Framework * framework, std::shared_ptr<BenchmarkHandle> handle)
                   "\n ***** Report for scenario", it.first, "*****\n"));
 
     }
+    SaveReport(*handle);
 #endif
     return;
   }
@@ -110,6 +209,10 @@ void RunGraphicsBenchmark(Framework * framework)
   try
   {
     base::Json root(benchmarkData.c_str());
+    FromJSONObjectOptionalField(root.get(), "reportFile", handle->m_reportFile);
+    if (handle->m_reportFile.empty())
+      handle->m_reportFile = kDefaultReportFile;
+
     json_t * scenariosNode = json_object_get(root.get(), "scenarios");
     if (scenariosNode == nullptr || !json_is_array(scenariosNode))
       return;
@@ -156,6 +259,43 @@ void RunGraphicsBenchmark(Framework * framework)
             scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
                                  new ScenarioManager::CenterViewportAction(pt, static_cast<int>(zoomLevel))));
           }
+          else if (actionType == "flyThrough")
+          {
+            // Visits all the |points| with every zoom level from |zoomLevels| and stays
+            // |time| seconds at every point.
+            json_t * pointsNode = json_object_get(stepElem, "points");
+            json_t * zoomLevelsNode = json_object_get(stepElem, "zoomLevels");
+            if (pointsNode == nullptr || !json_is_array(pointsNode) ||
+                zoomLevelsNode == nullptr || !json_is_array(zoomLevelsNode))
+            {
+              return;
+            }
+            json_int_t timeInSeconds = 0;
+            FromJSONObject(stepElem, "time", timeInSeconds);
+
+            std::vector<m2::PointD> path;
+            for (size_t k = 0; k < json_array_size(pointsNode); ++k)
+            {
+              double lat = 0.0, lon = 0.0;
+              FromJSONObject(json_array_get(pointsNode, k), "lat", lat);
+              FromJSONObject(json_array_get(pointsNode, k), "lon", lon);
+              path.push_back(mercator::FromLatLon(lat, lon));
+            }
+            points.insert(points.end(), path.cbegin(), path.cend());
+
+            for (size_t k = 0; k < json_array_size(zoomLevelsNode); ++k)
+            {
+              json_int_t zoomLevel = -1;
+              FromJSON(json_array_get(zoomLevelsNode, k), zoomLevel);
+              for (auto const & pt : path)
+              {
+                scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
+                    new ScenarioManager::CenterViewportAction(pt, static_cast<int>(zoomLevel))));
+                scenario.push_back(std::unique_ptr<ScenarioManager::Action>(
+                    new ScenarioManager::WaitForTimeAction(std::chrono::seconds(timeInSeconds))));
+              }
+            }
+          }
         }
       }
     }
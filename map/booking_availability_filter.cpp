@@ -66,23 +66,18 @@ bool IsConformToFilter(search::Result const & r)
   return r.m_details.m_isSponsoredHotel && r.GetResultType() == search::Result::Type::Feature;
 }
 
-template <typename T>
-void UpdateCache(HotelsMapping<T> const & hotelsMapping, booking::HotelsWithExtras const & hotels,
-                 availability::Cache & cache)
+void UpdateCache(std::vector<std::string> const & hotelIds,
+                 booking::HotelsWithExtras const & hotels, availability::Cache & cache)
 {
-  using availability::Cache;
+  cache.ReserveAdditional(hotelIds.size());
 
-  cache.ReserveAdditional(hotelsMapping.size());
-
-  for (auto & hotel : hotelsMapping)
+  for (auto const & hotelId : hotelIds)
   {
-    if (hotel.GetStatus() != Cache::HotelStatus::Absent)
-      continue;
-    auto const it = hotels.find(hotel.GetHotelId());
+    auto const it = hotels.find(hotelId);
     if (it != hotels.cend())
-      cache.InsertAvailable(hotel.GetHotelId(), {it->second.m_price, it->second.m_currency});
+      cache.InsertAvailable(hotelId, {it->second.m_price, it->second.m_currency});
     else
-      cache.InsertUnavailable(hotel.GetHotelId());
+      cache.InsertUnavailable(hotelId);
   }
 }
 
@@ -166,6 +161,20 @@ void FillResults(HotelToFeatureIds && hotelToFeatureIds, booking::HotelsWithExtr
   FillResults(std::move(hotelToFeatureIds), std::move(hotels), cache, passedInserter, filteredOutInserter);
 }
 
+// Returns true if some of the hotels of |hotelsMapping| are still requested by other requests.
+template <typename T>
+bool HasNotReady(HotelsMapping<T> const & hotelsMapping, availability::Cache & cache)
+{
+  using availability::Cache;
+
+  return std::any_of(hotelsMapping.cbegin(), hotelsMapping.cend(),
+                     [&cache](HotelInfo<T> const & hotel) {
+                       return hotel.GetStatus() == Cache::HotelStatus::NotReady &&
+                              cache.Get(hotel.GetHotelId()).m_status ==
+                                  Cache::HotelStatus::NotReady;
+                     });
+}
+
 void PrepareData(DataSource const & dataSource, search::Results const & results,
                  HotelToResults & hotelToResults, availability::Cache & cache,
                  booking::AvailabilityParams & p)
@@ -313,27 +322,49 @@ void AvailabilityFilter::ApplyFilterInternal(Source const & source, Parameters c
   UNUSED_VALUE(kMaxCountInRequest);
   ASSERT_LESS_OR_EQUAL(m_apiParams.m_hotelIds.size(), kMaxCountInRequest, ());
 
-  if (m_apiParams.m_hotelIds.empty())
-  {
+  // Hotels which are requested by other requests are not requested again. The results are
+  // returned when all of them are received.
+  auto fillResults = [cb, cache = m_cache, hotelToValue = std::move(hotelsToSourceValue)](
+                         booking::HotelsWithExtras & hotels) mutable {
+    if (HasNotReady(hotelToValue, *cache))
+      return false;
+
     booking::filter::ResultInternal<Source> result;
-    FillResults(std::move(hotelsToSourceValue), {} /* hotelIds */, *m_cache, result);
+    FillResults(std::move(hotelToValue), std::move(hotels), *cache, result);
     cb(std::move(result));
+    return true;
+  };
 
-    return;
-  }
-
-  auto const apiCallback =
-    [cb, cache = m_cache, hotelToValue = std::move(hotelsToSourceValue)] (booking::HotelsWithExtras hotels) mutable
+  if (m_apiParams.m_hotelIds.empty())
   {
-    GetPlatform().RunTask(
-      Platform::Thread::File,
-      [cb, cache, hotelToValue = std::move(hotelToValue), hotels = std::move(hotels)]() mutable
+    booking::HotelsWithExtras noHotels;
+    if (!fillResults(noHotels))
     {
-      UpdateCache(hotelToValue, hotels, *cache);
+      m_waitingRequests.emplace_back(
+          [fillResults = std::move(fillResults), noHotels]() mutable {
+            return fillResults(noHotels);
+          });
+    }
+    return;
+  }
 
-      booking::filter::ResultInternal<Source> updatedResult;
-      FillResults(std::move(hotelToValue), std::move(hotels), *cache, updatedResult);
-      cb(std::move(updatedResult));
+  auto const apiCallback = [this, cache = m_cache, hotelIds = m_apiParams.m_hotelIds,
+                            fillResults = std::move(fillResults)](
+                               booking::HotelsWithExtras hotels) mutable {
+    GetPlatform().RunTask(Platform::Thread::File, [this, cache, hotelIds = std::move(hotelIds),
+                                                   fillResults = std::move(fillResults),
+                                                   hotels = std::move(hotels)]() mutable {
+      UpdateCache(hotelIds, hotels, *cache);
+
+      if (!fillResults(hotels))
+      {
+        m_waitingRequests.emplace_back(
+            [fillResults = std::move(fillResults), hotels = std::move(hotels)]() mutable {
+              return fillResults(hotels);
+            });
+      }
+
+      ProcessWaitingRequests();
     });
   };
 
@@ -341,6 +372,11 @@ void AvailabilityFilter::ApplyFilterInternal(Source const & source, Parameters c
   m_cache->RemoveOutdated();
 }
 
+void AvailabilityFilter::ProcessWaitingRequests()
+{
+  m_waitingRequests.remove_if([](auto & fillResults) { return fillResults(); });
+}
+
 void AvailabilityFilter::GetFeaturesFromCache(search::Results const & results,
                                               std::vector<FeatureID> & sortedResults,
                                               std::vector<Extras> & extras,
@@ -6,6 +6,8 @@
 #include "map/booking_filter_cache.hpp"
 #include "map/booking_filter_params.hpp"
 
+#include <functional>
+#include <list>
 #include <memory>
 
 namespace search
@@ -33,11 +35,18 @@ public:
 private:
   template <typename SourceValue, typename Source, typename Parameters>
   void ApplyFilterInternal(Source const & results, Parameters const & filterParams);
+  // Completes the waiting requests whose hotels are received.
+  void ProcessWaitingRequests();
 
   using CachePtr = std::shared_ptr<availability::Cache>;
   CachePtr m_cache = std::make_shared<availability::Cache>();
 
   AvailabilityParams m_apiParams;
+
+  // Requests which wait for the hotels requested by other (concurrent) requests. Every item
+  // returns true and is removed when the results are returned. They are accessed from the file
+  // thread only.
+  std::list<std::function<bool()>> m_waitingRequests;
 };
 }  // namespace filter
 }  // namespace booking
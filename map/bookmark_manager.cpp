@@ -30,6 +30,7 @@
 #include "geometry/rect_intersect.hpp"
 #include "geometry/transformations.hpp"
 
+#include "base/executor.hpp"
 #include "base/file_name_utils.hpp"
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
@@ -38,10 +39,12 @@
 #include "std/target_os.hpp"
 
 #include <algorithm>
+#include <condition_variable>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <mutex>
 #include <sstream>
 #include <unordered_map>
 #include <utility>
@@ -435,17 +438,24 @@ bool MigrateIfNeeded()
 }
 
 // Here we read backup and try to restore old-style #placemark-hotel bookmarks.
+std::string const kHotelPlacemarksExtractedKey = "HotelPlacemarksExtracted";
+
+bool AreHotelPlacemarksFixedUp()
+{
+  bool isHotelPlacemarksExtracted;
+  return settings::Get(kHotelPlacemarksExtractedKey, isHotelPlacemarksExtracted) &&
+         isHotelPlacemarksExtracted;
+}
+
 void FixUpHotelPlacemarks(BookmarkManager::KMLDataCollectionPtr & collection,
                           bool isMigrationCompleted)
 {
-  static std::string const kSettingsKey = "HotelPlacemarksExtracted";
-  bool isHotelPlacemarksExtracted;
-  if (settings::Get(kSettingsKey, isHotelPlacemarksExtracted) && isHotelPlacemarksExtracted)
+  if (AreHotelPlacemarksFixedUp())
     return;
   
   if (!isMigrationCompleted)
   {
-    settings::Set(kSettingsKey, true);
+    settings::Set(kHotelPlacemarksExtractedKey, true);
     return;
   }
   
@@ -471,7 +481,7 @@ void FixUpHotelPlacemarks(BookmarkManager::KMLDataCollectionPtr & collection,
   }
   if (hotelBookmarks.empty())
   {
-    settings::Set(kSettingsKey, true);
+    settings::Set(kHotelPlacemarksExtractedKey, true);
     return;
   }
   
@@ -484,7 +494,7 @@ void FixUpHotelPlacemarks(BookmarkManager::KMLDataCollectionPtr & collection,
     kml::SetDefaultStr(fileData->m_categoryData.m_name, kHotelsBookmarks);
     fileData->m_bookmarksData.assign(hotelBookmarks.begin(), hotelBookmarks.end());
     collection->emplace_back("", std::move(fileData));
-    settings::Set(kSettingsKey, true);
+    settings::Set(kHotelPlacemarksExtractedKey, true);
     return;
   }
   
@@ -522,7 +532,7 @@ void FixUpHotelPlacemarks(BookmarkManager::KMLDataCollectionPtr & collection,
   if (!fileData->m_bookmarksData.empty())
     collection->emplace_back("", std::move(fileData));
 
-  settings::Set(kSettingsKey, true);
+  settings::Set(kHotelPlacemarksExtractedKey, true);
 }
 }  // namespace migration
 
@@ -2281,29 +2291,79 @@ void BookmarkManager::ClearCategories()
 
 BookmarkManager::KMLDataCollectionPtr BookmarkManager::LoadBookmarks(
     std::string const & dir, std::string const & ext, KmlFileType fileType,
-    BookmarksChecker const & checker, std::vector<std::string> & cloudFilePaths)
+    BookmarksChecker const & checker, std::vector<std::string> & cloudFilePaths,
+    OnVisibleLoaded const & onVisibleLoaded)
 {
   Platform::FilesList files;
   Platform::GetFilesByExt(dir, ext, files);
 
-  auto collection = std::make_shared<KMLDataCollection>();
-  collection->reserve(files.size());
+  // The parsed files in the order of completion. The tasks don't touch the manager, so the
+  // loading may stop on teardown without waiting for them.
+  struct Parsed
+  {
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<std::pair<size_t, std::unique_ptr<kml::FileData>>> m_files;
+  };
+  auto parsed = std::make_shared<Parsed>();
+
+  for (size_t i = 0; i < files.size(); ++i)
+  {
+    auto const parse = [parsed, i, filePath = base::JoinPath(dir, files[i]), fileType]() {
+      auto kmlData = LoadKmlFile(filePath, fileType);
+      {
+        std::lock_guard<std::mutex> lock(parsed->m_mutex);
+        parsed->m_files.emplace_back(i, std::move(kmlData));
+      }
+      parsed->m_cv.notify_one();
+    };
+    if (!base::Executor::Instance().Submit(base::Executor::Priority::Background, parse).valid())
+      parse();
+  }
+
+  // The parsed files are passed on in the order of the files, the unique names of
+  // the categories depend on it.
+  using IndexedFile = std::pair<size_t, KMLDataCollection::value_type>;
+  auto const makeCollection = [](std::vector<IndexedFile> & files) {
+    std::sort(files.begin(), files.end(), base::LessBy(&IndexedFile::first));
+    auto collection = std::make_shared<KMLDataCollection>();
+    collection->reserve(files.size());
+    for (auto & file : files)
+      collection->push_back(std::move(file.second));
+    return collection;
+  };
+
+  std::vector<IndexedFile> loaded;
+  loaded.reserve(files.size());
   cloudFilePaths.reserve(files.size());
-  for (auto const & file : files)
+  for (size_t received = 0; received < files.size() && !m_needTeardown;)
   {
-    auto const filePath = base::JoinPath(dir, file);
-    auto kmlData = LoadKmlFile(filePath, fileType);
-    if (kmlData == nullptr)
-      continue;
-    if (checker && !checker(*kmlData))
-      continue;
-    if (m_needTeardown)
-      break;
-    if (!kmlData->m_bookmarksData.empty() || !kmlData->m_tracksData.empty())
-      cloudFilePaths.push_back(filePath);
-    collection->emplace_back(filePath, std::move(kmlData));
+    std::vector<std::pair<size_t, std::unique_ptr<kml::FileData>>> ready;
+    {
+      std::unique_lock<std::mutex> lock(parsed->m_mutex);
+      parsed->m_cv.wait(lock, [&parsed]() { return !parsed->m_files.empty(); });
+      ready.swap(parsed->m_files);
+    }
+    received += ready.size();
+
+    std::vector<IndexedFile> visible;
+    for (auto & [index, kmlData] : ready)
+    {
+      if (kmlData == nullptr)
+        continue;
+      if (checker && !checker(*kmlData))
+        continue;
+      auto filePath = base::JoinPath(dir, files[index]);
+      if (!kmlData->m_bookmarksData.empty() || !kmlData->m_tracksData.empty())
+        cloudFilePaths.push_back(filePath);
+      auto & part = onVisibleLoaded && kmlData->m_categoryData.m_visible ? visible : loaded;
+      part.emplace_back(index, std::make_pair(std::move(filePath), std::move(kmlData)));
+    }
+
+    if (!visible.empty() && !m_needTeardown)
+      onVisibleLoaded(makeCollection(visible));
   }
-  return collection;
+  return makeCollection(loaded);
 }
 
 void BookmarkManager::LoadBookmarks()
@@ -2322,13 +2382,24 @@ void BookmarkManager::LoadBookmarks()
     bool const migrated = migration::MigrateIfNeeded();
     std::string const dir = migrated ? GetBookmarksDirectory() : GetPlatform().SettingsDir();
     std::string const filesExt = migrated ? kKmbExtension : kKmlExtension;
-    
+
+    // Visible categories are created as soon as their files are parsed, so they appear on
+    // the map before all the files are loaded. The migration and the hotel placemarks fix-up
+    // need all the files at once.
+    OnVisibleLoaded onVisibleLoaded;
+    if (isMigrationCompleted && migration::AreHotelPlacemarksFixedUp())
+    {
+      onVisibleLoaded = [this](KMLDataCollectionPtr && collection) {
+        NotifyAboutLoadedPart(std::move(collection));
+      };
+    }
+
     std::vector<std::string> cloudFilePaths;
     auto collection = LoadBookmarks(dir, filesExt, migrated ? KmlFileType::Binary : KmlFileType::Text,
       [](kml::FileData const & kmlData)
     {
       return true;  // Allow to load any files from the bookmarks directory.
-    }, cloudFilePaths);
+    }, cloudFilePaths, onVisibleLoaded);
     
     migration::FixUpHotelPlacemarks(collection, isMigrationCompleted);
 
@@ -2338,7 +2409,7 @@ void BookmarkManager::LoadBookmarks()
                                            KmlFileType::Binary, [](kml::FileData const & kmlData)
     {
       return FromCatalog(kmlData);
-    }, unusedFilePaths);
+    }, unusedFilePaths, onVisibleLoaded);
     
     collection->reserve(collection->size() + catalogCollection->size());
     for (auto & p : *catalogCollection)
@@ -2451,7 +2522,7 @@ void BookmarkManager::NotifyAboutFinishAsyncLoading(KMLDataCollectionPtr && coll
     {
       CreateCategories(std::move(*collection));
     }
-    else if (!m_loadBookmarksFinished)
+    else if (!m_loadBookmarksFinished && m_categories.empty())
     {
       CheckAndResetLastIds();
       CheckAndCreateDefaultCategory();
@@ -2475,6 +2546,17 @@ void BookmarkManager::NotifyAboutFinishAsyncLoading(KMLDataCollectionPtr && coll
   });
 }
 
+void BookmarkManager::NotifyAboutLoadedPart(KMLDataCollectionPtr && collection)
+{
+  if (m_needTeardown)
+    return;
+
+  GetPlatform().RunTask(Platform::Thread::Gui, [this, collection]()
+  {
+    CreateCategories(std::move(*collection));
+  });
+}
+
 void BookmarkManager::NotifyAboutFile(bool success, std::string const & filePath,
                                       bool isTemporaryFile)
 {
@@ -697,14 +697,20 @@ private:
 
   void NotifyAboutStartAsyncLoading();
   void NotifyAboutFinishAsyncLoading(KMLDataCollectionPtr && collection);
+  // Creates the categories of |collection| before the end of the asynchronous loading.
+  void NotifyAboutLoadedPart(KMLDataCollectionPtr && collection);
   std::optional<std::string> GetKMLPath(std::string const & filePath);
   void NotifyAboutFile(bool success, std::string const & filePath, bool isTemporaryFile);
   void LoadBookmarkRoutine(std::string const & filePath, bool isTemporaryFile);
   
   using BookmarksChecker = std::function<bool(kml::FileData const &)>;
+  using OnVisibleLoaded = std::function<void(KMLDataCollectionPtr &&)>;
+  // Parses the files in parallel on the shared executor. When |onVisibleLoaded| is set, the files
+  // of the visible categories are passed to it as soon as they are parsed and are not returned.
   KMLDataCollectionPtr LoadBookmarks(std::string const & dir, std::string const & ext,
                                      KmlFileType fileType, BookmarksChecker const & checker,
-                                     std::vector<std::string> & cloudFilePaths);
+                                     std::vector<std::string> & cloudFilePaths,
+                                     OnVisibleLoaded const & onVisibleLoaded = {});
 
   void GetDirtyGroups(kml::GroupIdSet & dirtyGroups) const;
   void UpdateBmGroupIdList();
@@ -130,14 +130,18 @@ bool NormalizeChartData(vector<double> const & distanceDataM,
     return true;
   }
 
+  // The uniform points go in the order of distance, so the segment of the curve which contains the
+  // next point is searched from the segment of the previous one and all the points are calculated
+  // in one pass over the curve.
+  size_t nextPointIdx = 0;
   auto const calculateAltitude = [&](double distFormStartM) {
     if (distFormStartM <= distanceDataM.front())
       return static_cast<double>(altitudeDataM.front());
     if (distFormStartM >= distanceDataM.back())
       return static_cast<double>(altitudeDataM.back());
 
-    auto const lowerIt = lower_bound(distanceDataM.cbegin(), distanceDataM.cend(), distFormStartM);
-    size_t const nextPointIdx = distance(distanceDataM.cbegin(), lowerIt);
+    while (distanceDataM[nextPointIdx] < distFormStartM)
+      ++nextPointIdx;
     ASSERT_LESS(0, nextPointIdx, ("distFormStartM is greater than 0 but nextPointIdx == 0."));
     size_t const prevPointIdx = nextPointIdx - 1;
 
@@ -199,10 +203,12 @@ bool GenerateYAxisChartData(uint32_t height, double minMetersPerPxl,
   }
 
   double const maxAltPxl = maxAltM / metersPerPxl;
-  yAxisDataPxl.assign(altitudeDataM.cbegin(), altitudeDataM.cend());
-  ScaleChartData(yAxisDataPxl, 1.0 / metersPerPxl);
-  ReflectChartData(yAxisDataPxl);
-  ShiftChartData(yAxisDataPxl, maxAltPxl + heightIndentPxl + freeHeightSpacePxl / 2.0);
+  // Scaling, reflection and shift of the data in one pass.
+  double const scale = 1.0 / metersPerPxl;
+  double const shift = maxAltPxl + heightIndentPxl + freeHeightSpacePxl / 2.0;
+  yAxisDataPxl.resize(altitudeDataM.size());
+  for (size_t i = 0; i < altitudeDataM.size(); ++i)
+    yAxisDataPxl[i] = shift - altitudeDataM[i] * scale;
 
   return true;
 }
@@ -650,6 +650,7 @@ void Cloud::ScheduleUploadingTask(EntryPtr const & entry, uint32_t timeout)
   {
     std::string entryName;
     std::string entryHash;
+    std::string entrySourceHash;
     bool isInvalidToken;
     {
       std::lock_guard<std::mutex> lock(m_mutex);
@@ -660,6 +661,7 @@ void Cloud::ScheduleUploadingTask(EntryPtr const & entry, uint32_t timeout)
       ASSERT(entry->m_isOutdated, ());
       entryName = entry->m_name;
       entryHash = entry->m_hash;
+      entrySourceHash = entry->m_sourceHash;
       isInvalidToken = m_accessToken.empty();
     }
     
@@ -682,29 +684,42 @@ void Cloud::ScheduleUploadingTask(EntryPtr const & entry, uint32_t timeout)
       return;
     }
 
-    // Prepare file to uploading.
-    bool needSkip;
-    std::string hash;
-    auto const uploadedName = PrepareFileToUploading(entryName, hash, needSkip);
-    auto deleteAfterUploading = [uploadedName]() {
-      if (!uploadedName.empty())
-        base::DeleteFileX(uploadedName);
-    };
-    SCOPE_GUARD(deleteAfterUploadingGuard, deleteAfterUploading);
-
-    // This file must be skipped by some reason.
-    if (needSkip)
-      return;
-
-    if (uploadedName.empty())
+    auto const filePath = GetUploadingFilePath(entryName);
+    auto const sourceHash =
+        filePath.empty() ? std::string() : coding::SHA1::CalculateBase64(filePath);
+    if (sourceHash.empty())
     {
       FinishUploading(SynchronizationResult::DiskError, "File preparation error");
       return;
     }
 
-    // Upload only if calculated hash is not equal to previous one.
-    if (entryHash != hash && !UploadFile(uploadedName))
-      return;
+    // The file is converted and uploaded only if it's changed since the last uploading.
+    std::string hash = entryHash;
+    if (sourceHash != entrySourceHash)
+    {
+      // Prepare file to uploading.
+      bool needSkip;
+      auto const uploadedName = PrepareFileToUploading(filePath, sourceHash, hash, needSkip);
+      auto deleteAfterUploading = [uploadedName]() {
+        if (!uploadedName.empty())
+          base::DeleteFileX(uploadedName);
+      };
+      SCOPE_GUARD(deleteAfterUploadingGuard, deleteAfterUploading);
+
+      // This file must be skipped by some reason.
+      if (needSkip)
+        return;
+
+      if (uploadedName.empty())
+      {
+        FinishUploading(SynchronizationResult::DiskError, "File preparation error");
+        return;
+      }
+
+      // Upload only if calculated hash is not equal to previous one.
+      if (entryHash != hash && !UploadFile(uploadedName))
+        return;
+    }
 
     // Mark entry as not outdated.
     bool isSnapshotCreated;
@@ -712,6 +727,7 @@ void Cloud::ScheduleUploadingTask(EntryPtr const & entry, uint32_t timeout)
       std::lock_guard<std::mutex> lock(m_mutex);
       entry->m_isOutdated = false;
       entry->m_hash = hash;
+      entry->m_sourceHash = sourceHash;
       SaveIndexImpl();
       isSnapshotCreated = m_isSnapshotCreated;
     }
@@ -816,10 +832,8 @@ void Cloud::FinishUploadingOnRequestError(Cloud::RequestResult const & result)
   }
 }
 
-std::string Cloud::PrepareFileToUploading(std::string const & fileName, std::string & hash,
-                                          bool & needSkip)
+std::string Cloud::GetUploadingFilePath(std::string const & fileName) const
 {
-  // 1. Get path to the original uploading file.
   std::string filePath;
   {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -830,13 +844,16 @@ std::string Cloud::PrepareFileToUploading(std::string const & fileName, std::str
   }
   if (!GetPlatform().IsFileExistsByFullPath(filePath))
     return {};
+  return filePath;
+}
 
-  // 2. Calculate SHA1 of the original uploading file.
-  auto const originalSha1 = coding::SHA1::CalculateBase64(filePath);
-  if (originalSha1.empty())
-    return {};
+std::string Cloud::PrepareFileToUploading(std::string const & filePath,
+                                          std::string const & sourceHash, std::string & hash,
+                                          bool & needSkip)
+{
+  ASSERT(!sourceHash.empty(), ());
 
-  // 3. Create a temporary file from the original uploading file.
+  // 1. Create a temporary file from the original uploading file.
   auto name = ExtractFileNameWithoutExtension(filePath);
   auto const tmpPath = base::JoinPath(GetPlatform().TmpDir(), name + ".tmp");
   if (!base::CopyFileX(filePath, tmpPath))
@@ -844,16 +861,16 @@ std::string Cloud::PrepareFileToUploading(std::string const & fileName, std::str
 
   SCOPE_GUARD(tmpFileGuard, std::bind(&base::DeleteFileX, std::cref(tmpPath)));
 
-  // 4. Calculate SHA1 of the temporary file and compare with original one.
+  // 2. Calculate SHA1 of the temporary file and compare with original one.
   // Original file can be modified during copying process, so we have to
   // compare original file with the temporary file after copying.
   auto const tmpSha1 = coding::SHA1::CalculateBase64(tmpPath);
-  if (originalSha1 != tmpSha1)
+  if (sourceHash != tmpSha1)
     return {};
 
   auto const outputPath = base::JoinPath(GetPlatform().TmpDir(), name + ".uploaded");
 
-  // 5. Convert temporary file and save to output path.
+  // 3. Convert temporary file and save to output path.
   CHECK(m_params.m_backupConverter, ());
   auto const convertionResult = m_params.m_backupConverter(tmpPath, outputPath);
   needSkip = convertionResult.m_needSkip;
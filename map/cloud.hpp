@@ -44,11 +44,15 @@ public:
     std::string m_name;
     uint64_t m_sizeInBytes = 0;
     std::string m_hash;
+    // SHA1 of the original file when it was uploaded last time. If the file is not changed
+    // since then, it's not converted and uploaded again.
+    std::string m_sourceHash;
     bool m_isOutdated = false;
 
     DECLARE_VISITOR_AND_DEBUG_PRINT(Entry, visitor(m_name, "name"),
                                     visitor(m_sizeInBytes, "sizeInBytes"),
                                     visitor(m_hash, "hash"),
+                                    visitor(m_sourceHash, std::string(), "sourceHash"),
                                     visitor(m_isOutdated, "isOutdated"))
   };
 
@@ -324,10 +328,14 @@ private:
   void SetAccessToken(std::string const & token);
   std::string GetAccessToken() const;
 
+  // Returns the full path to the original uploading file or the empty string if there is
+  // no such file.
+  std::string GetUploadingFilePath(std::string const & fileName) const;
+
   // This function always returns path to a temporary file or the empty string
-  // in case of a disk error.
-  std::string PrepareFileToUploading(std::string const & fileName, std::string & hash,
-                                     bool & needSkip);
+  // in case of a disk error. |sourceHash| is SHA1 of the original file |filePath|.
+  std::string PrepareFileToUploading(std::string const & filePath, std::string const & sourceHash,
+                                     std::string & hash, bool & needSkip);
 
   RequestResult CreateSnapshot(std::vector<std::string> const & files) const;
   RequestResult FinishSnapshot() const;
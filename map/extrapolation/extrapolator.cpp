@@ -141,6 +141,12 @@ void Extrapolator::OnLocationUpdate(location::GpsInfo const & gpsInfo)
     lock_guard<mutex> guard(m_mutex);
     m_beforeLastGpsInfo = m_lastGpsInfo;
     m_lastGpsInfo = gpsInfo;
+    if (!m_kalmanFilter.Update(gpsInfo))
+    {
+      // |gpsInfo| is older than the previous location. See the comment on GpsInfo::m_timestamp.
+      m_kalmanFilter.Reset();
+      m_kalmanFilter.Update(gpsInfo);
+    }
     m_consecutiveRuns = 0;
     // Canceling all background tasks which are put to the queue before the task run in this method.
     ++m_locationUpdateCounter;
@@ -168,9 +174,14 @@ void Extrapolator::ExtrapolatedLocationUpdate(uint64_t locationUpdateCounter)
     if (extrapolationTimeMs < kMaxExtrapolationTimeMs && m_lastGpsInfo.IsValid())
     {
       if (DoesExtrapolationWork())
-        gpsInfo = LinearExtrapolation(m_beforeLastGpsInfo, m_lastGpsInfo, extrapolationTimeMs);
+      {
+        gpsInfo = m_kalmanFilter.Predict(m_lastGpsInfo.m_timestamp +
+                                         static_cast<double>(extrapolationTimeMs) / 1000.0);
+      }
       else
+      {
         gpsInfo = m_lastGpsInfo;
+      }
     }
   }
 
@@ -215,7 +226,8 @@ void Extrapolator::RunTaskOnBackgroundThread(bool delayed)
 
 bool Extrapolator::DoesExtrapolationWork() const
 {
-  if (!m_isEnabled || m_consecutiveRuns == kExtrapolationCounterUndefined)
+  if (!m_isEnabled || m_consecutiveRuns == kExtrapolationCounterUndefined ||
+      !m_kalmanFilter.IsInitialized())
     return false;
 
   return AreCoordsGoodForExtrapolation(m_beforeLastGpsInfo, m_lastGpsInfo);
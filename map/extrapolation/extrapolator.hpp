@@ -1,5 +1,7 @@
 #pragma once
 
+#include "map/extrapolation/kalman_filter.hpp"
+
 #include "platform/location.hpp"
 
 #include <cstdint>
@@ -21,11 +23,12 @@ location::GpsInfo LinearExtrapolation(location::GpsInfo const & gpsInfo1,
 bool AreCoordsGoodForExtrapolation(location::GpsInfo const & info1,
                                    location::GpsInfo const & info2);
 
-/// \brief This class implements linear extrapolation based on methods LinearExtrapolation()
-/// and AreCoordsGoodForExtrapolation(). The idea implemented in this class is
+/// \brief This class implements extrapolation based on KalmanFilter and
+/// AreCoordsGoodForExtrapolation(). The idea implemented in this class is
 /// - OnLocationUpdate() should be called from gui thread when new data from gps is available.
+///   Every location is passed to the Kalman filter.
 /// - When OnLocationUpdate() was called twice so that AreCoordsGoodForExtrapolation()
-///   returns true, extrapolation for this two location will be launched.
+///   returns true, extrapolation with the filter state will be launched.
 /// - That means all obsolete extrapolation calls in background thread will be canceled by
 ///   incrementing |m_locationUpdateMinValid|.
 /// - Several new extrapolations based on two previous locations will be generated.
@@ -68,6 +71,7 @@ private:
   ExtrapolatedLocationUpdateFn m_extrapolatedLocationUpdate;
   location::GpsInfo m_lastGpsInfo;
   location::GpsInfo m_beforeLastGpsInfo;
+  KalmanFilter m_kalmanFilter;
   uint64_t m_consecutiveRuns = kExtrapolationCounterUndefined;
   // Number of calls Extrapolator::OnLocationUpdate() method. This way |m_locationUpdateCounter|
   // reflects generation of extrapolations. That mean the next gps location is
@@ -0,0 +1,166 @@
+#include "map/extrapolation/kalman_filter.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Standard deviation of the acceleration which is modeled as white noise.
+double constexpr kAccelerationSigmaMPS2 = 2.0;
+// Standard deviation of the speed measurement.
+double constexpr kSpeedSigmaMPS = 1.0;
+// Minimum standard deviation of the position measurement. GpsInfo::m_horizontalAccuracy
+// is used if it's greater.
+double constexpr kMinPositionSigmaMeters = 3.0;
+// Initial standard deviation of the velocity if it's not measured.
+double constexpr kInitialSpeedSigmaMPS = 30.0;
+// The filter is started again if the next location is later or further than the values below.
+double constexpr kMaxTimeGapSeconds = 10.0;
+double constexpr kMaxDistFromOriginMeters = 20000.0;
+// Bearing is calculated from the velocity if the speed is greater than the value below.
+double constexpr kMinSpeedForBearingMPS = 1.0;
+
+double constexpr kMetersPerDegreeLat = mercator::Bounds::kMetersInDegree;
+}  // namespace
+
+namespace extrapolation
+{
+bool KalmanFilter::Update(location::GpsInfo const & info)
+{
+  if (!info.IsValid())
+    return false;
+
+  if (!m_isInitialized)
+  {
+    Init(info);
+    return true;
+  }
+
+  double const dt = info.m_timestamp - m_lastInfo.m_timestamp;
+  if (dt < 0.0)
+    return false;
+
+  double x = 0.0;
+  double y = 0.0;
+  ToLocal(info.m_latitude, info.m_longitude, x, y);
+  if (dt > kMaxTimeGapSeconds || std::abs(x) > kMaxDistFromOriginMeters ||
+      std::abs(y) > kMaxDistFromOriginMeters)
+  {
+    Init(info);
+    return true;
+  }
+
+  Propagate(dt);
+
+  double const positionVariance = std::pow(std::max(info.m_horizontalAccuracy,
+                                                    kMinPositionSigmaMeters), 2.0);
+  if (info.HasSpeed() && info.HasBearing())
+  {
+    double const bearingRad = base::DegToRad(info.m_bearing);
+    math::Matrix<double, 4, 1> const z = {x, y, info.m_speedMpS * std::sin(bearingRad),
+                                          info.m_speedMpS * std::cos(bearingRad)};
+    double const speedVariance = kSpeedSigmaMPS * kSpeedSigmaMPS;
+    math::Matrix<double, 4, 4> r = math::Zero<double, 4>();
+    r(0, 0) = r(1, 1) = positionVariance;
+    r(2, 2) = r(3, 3) = speedVariance;
+    Correct(z, math::Identity<double, 4>(), r);
+  }
+  else
+  {
+    math::Matrix<double, 2, 1> const z = {x, y};
+    math::Matrix<double, 2, 4> const h = {1.0, 0.0, 0.0, 0.0,
+                                          0.0, 1.0, 0.0, 0.0};
+    math::Matrix<double, 2, 2> const r = {positionVariance, 0.0,
+                                          0.0, positionVariance};
+    Correct(z, h, r);
+  }
+
+  m_lastInfo = info;
+  return true;
+}
+
+location::GpsInfo KalmanFilter::Predict(double timestampS) const
+{
+  CHECK(m_isInitialized, ());
+
+  double const dt = std::max(timestampS - m_lastInfo.m_timestamp, 0.0);
+  double const vx = m_state(2, 0);
+  double const vy = m_state(3, 0);
+
+  location::GpsInfo result = m_lastInfo;
+  result.m_timestamp = m_lastInfo.m_timestamp + dt;
+  ToLatLon(m_state(0, 0) + vx * dt, m_state(1, 0) + vy * dt, result.m_latitude,
+           result.m_longitude);
+
+  double const speed = std::sqrt(vx * vx + vy * vy);
+  if (m_lastInfo.HasSpeed())
+    result.m_speedMpS = speed;
+  if (speed > kMinSpeedForBearingMPS)
+  {
+    double const bearing = base::RadToDeg(std::atan2(vx, vy));
+    result.m_bearing = bearing < 0.0 ? bearing + 360.0 : bearing;
+  }
+  return result;
+}
+
+void KalmanFilter::Init(location::GpsInfo const & info)
+{
+  m_isInitialized = true;
+  m_originLat = info.m_latitude;
+  m_originLon = info.m_longitude;
+  m_metersPerDegreeLon = kMetersPerDegreeLat * std::cos(base::DegToRad(m_originLat));
+  m_lastInfo = info;
+
+  double const positionVariance = std::pow(std::max(info.m_horizontalAccuracy,
+                                                    kMinPositionSigmaMeters), 2.0);
+  double speedVariance = kInitialSpeedSigmaMPS * kInitialSpeedSigmaMPS;
+  m_state = {0.0, 0.0, 0.0, 0.0};
+  if (info.HasSpeed() && info.HasBearing())
+  {
+    double const bearingRad = base::DegToRad(info.m_bearing);
+    m_state(2, 0) = info.m_speedMpS * std::sin(bearingRad);
+    m_state(3, 0) = info.m_speedMpS * std::cos(bearingRad);
+    speedVariance = kSpeedSigmaMPS * kSpeedSigmaMPS;
+  }
+
+  m_covariance = math::Zero<double, 4>();
+  m_covariance(0, 0) = m_covariance(1, 1) = positionVariance;
+  m_covariance(2, 2) = m_covariance(3, 3) = speedVariance;
+}
+
+void KalmanFilter::ToLocal(double lat, double lon, double & x, double & y) const
+{
+  x = (lon - m_originLon) * m_metersPerDegreeLon;
+  y = (lat - m_originLat) * kMetersPerDegreeLat;
+}
+
+void KalmanFilter::ToLatLon(double x, double y, double & lat, double & lon) const
+{
+  lat = base::Clamp(m_originLat + y / kMetersPerDegreeLat, -90.0, 90.0);
+  lon = m_metersPerDegreeLon == 0.0
+            ? m_originLon
+            : base::Clamp(m_originLon + x / m_metersPerDegreeLon, -180.0, 180.0);
+}
+
+void KalmanFilter::Propagate(double dt)
+{
+  Covariance f = math::Identity<double, 4>();
+  f(0, 2) = f(1, 3) = dt;
+
+  // Discrete white noise acceleration model.
+  double const q = kAccelerationSigmaMPS2 * kAccelerationSigmaMPS2;
+  double const dt2 = dt * dt;
+  Covariance noise = math::Zero<double, 4>();
+  noise(0, 0) = noise(1, 1) = q * dt2 * dt2 / 4.0;
+  noise(0, 2) = noise(2, 0) = noise(1, 3) = noise(3, 1) = q * dt2 * dt / 2.0;
+  noise(2, 2) = noise(3, 3) = q * dt2;
+
+  m_state = f * m_state;
+  m_covariance = f * m_covariance * math::Transpose(f) + noise;
+}
+}  // namespace extrapolation
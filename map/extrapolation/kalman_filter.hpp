@@ -0,0 +1,63 @@
+#pragma once
+
+#include "platform/location.hpp"
+
+#include "base/matrix.hpp"
+
+namespace extrapolation
+{
+/// \brief Kalman filter of the position with the constant velocity model. The state is
+/// the position and the velocity in meters in the local plane which is tangent to the Earth
+/// at the first location of the track. Locations are used as the measurements of the position
+/// and, if they have speed and bearing, of the velocity.
+/// \note All the matrices are of fixed size, so neither Update() nor Predict() allocates memory.
+/// \note This class is not thread-safe.
+class KalmanFilter
+{
+public:
+  /// \brief Filters |info|. If |info| is too far in time or space from the previous location
+  /// the filter is started again from |info|.
+  /// \returns false if |info| is not valid or is older than the previous location.
+  bool Update(location::GpsInfo const & info);
+  void Reset() { m_isInitialized = false; }
+
+  bool IsInitialized() const { return m_isInitialized; }
+
+  /// \returns the location predicted for |timestampS| which should not be earlier than
+  /// the last location passed to Update(). The filter should be initialized.
+  location::GpsInfo Predict(double timestampS) const;
+
+private:
+  using State = math::Matrix<double, 4, 1>;
+  using Covariance = math::Matrix<double, 4, 4>;
+
+  void Init(location::GpsInfo const & info);
+  void ToLocal(double lat, double lon, double & x, double & y) const;
+  void ToLatLon(double x, double y, double & lat, double & lon) const;
+  // Propagates the state and the covariance |dt| seconds forward.
+  void Propagate(double dt);
+
+  template <unsigned N>
+  void Correct(math::Matrix<double, N, 1> const & z, math::Matrix<double, N, 4> const & h,
+               math::Matrix<double, N, N> const & r)
+  {
+    auto const ht = math::Transpose(h);
+    auto const innovation = z - h * m_state;
+    auto const gain = m_covariance * ht * math::Inverse(h * m_covariance * ht + r);
+    m_state = m_state + gain * innovation;
+    m_covariance = (math::Identity<double, 4>() - gain * h) * m_covariance;
+  }
+
+  bool m_isInitialized = false;
+  // Origin of the local plane.
+  double m_originLat = 0.0;
+  double m_originLon = 0.0;
+  double m_metersPerDegreeLon = 0.0;
+
+  // x, y, vx and vy in meters and meters per second. x is directed to the East and y is
+  // directed to the North.
+  State m_state;
+  Covariance m_covariance;
+  location::GpsInfo m_lastInfo;
+};
+}  // namespace extrapolation
@@ -1,4 +1,5 @@
 #include "map/extrapolation/extrapolator.hpp"
+#include "map/extrapolation/kalman_filter.hpp"
 
 #include "routing/base/followed_polyline.hpp"
 
@@ -34,6 +35,7 @@ DEFINE_string(csv_path, "",
               "Path to csv file with user in following format: mwm id (string), aloha id (string), "
               "latitude of the first coord (double), longitude of the first coord (double), "
               "timestamp in seconds (int), latitude of the second coord (double) and so on.");
+DEFINE_bool(kalman, false, "Extrapolate with KalmanFilter instead of LinearExtrapolation().");
 
 using namespace extrapolation;
 using namespace location;
@@ -174,8 +176,8 @@ void GpsPointToGpsInfo(GpsPoint const gpsPoint, GpsInfo & gpsInfo)
 }
 }  // namespace
 
-/// \brief This benchmark is written to estimate how LinearExtrapolation() extrapolates real users
-/// tracks. The idea behind the test is to measure the distance between extrapolated location and
+/// \brief This benchmark is written to estimate how LinearExtrapolation() or KalmanFilter
+/// extrapolate real users tracks. The idea behind the test is to measure the distance between extrapolated location and
 /// real track.
 int main(int argc, char * argv[])
 {
@@ -244,6 +246,11 @@ int main(int argc, char * argv[])
     FollowedPolyline followedPoly(poly.Begin(), poly.End());
     CHECK(followedPoly.IsValid(), ());
 
+    KalmanFilter kalmanFilter;
+    GpsInfo firstInfo;
+    GpsPointToGpsInfo(t[0], firstInfo);
+    kalmanFilter.Update(firstInfo);
+
     // For each track point except for the first one some extrapolations will be calculated.
     for (size_t i = 1; i < t.size(); ++i)
     {
@@ -254,6 +261,7 @@ int main(int argc, char * argv[])
 
       if (!AreCoordsGoodForExtrapolation(info1, info2))
         break;
+      kalmanFilter.Update(info2);
 
       vector<double> onePointDeviations;
       vector<double> onePointDeviationsSquared;
@@ -262,7 +270,9 @@ int main(int argc, char * argv[])
            timeMs <= Extrapolator::kMaxExtrapolationTimeMs;
            timeMs += Extrapolator::kExtrapolationPeriodMs)
       {
-        GpsInfo const extrapolated = LinearExtrapolation(info1, info2, timeMs);
+        GpsInfo const extrapolated =
+            FLAGS_kalman ? kalmanFilter.Predict(info2.m_timestamp + timeMs / 1000.0)
+                         : LinearExtrapolation(info1, info2, timeMs);
         m2::PointD const extrapolatedMerc =
             mercator::FromLatLon(extrapolated.m_latitude, extrapolated.m_longitude);
 
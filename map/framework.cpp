@@ -61,6 +61,7 @@
 #include "indexer/editable_map_object.hpp"
 #include "indexer/feature.hpp"
 #include "indexer/feature_algo.hpp"
+#include "indexer/feature_centers_cache.hpp"
 #include "indexer/feature_source.hpp"
 #include "indexer/feature_utils.hpp"
 #include "indexer/feature_visibility.hpp"
@@ -106,12 +107,14 @@
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
 #include "base/math.hpp"
+#include "base/profiler.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <future>
 #include <sstream>
 
 #include "defines.hpp"
@@ -157,6 +160,9 @@ char const kShowDebugInfo[] = "DebugInfo";
 auto constexpr kLargeFontsScaleFactor = 1.6;
 auto constexpr kGuidesEnabledInBackgroundMaxHours = 8;
 size_t constexpr kMaxTrafficCacheSizeBytes = 64 /* Mb */ * 1024 * 1024;
+size_t constexpr kMaxFeatureCentersCacheSizeBytes = 2 /* Mb */ * 1024 * 1024;
+// Traffic is requested less often in the economy power scheme.
+auto constexpr kEconomyTrafficUpdateInterval = seconds(180);
 
 // TODO!
 // To adjust GpsTrackFilter was added secret command "?gpstrackaccuracy:xxx;"
@@ -181,6 +187,28 @@ bool ParseSetGpsTrackMinAccuracyCommand(string const & query)
   return true;
 }
 
+// "?profiler" starts collection of the profiler scopes, "?no-profiler" stops it and saves
+// the trace in the Chrome trace format to the writable directory.
+bool ParseProfilerCommand(string const & query)
+{
+  if (query == "?profiler")
+  {
+    base::profiler::Enable();
+    return true;
+  }
+  if (query == "?no-profiler")
+  {
+    base::profiler::Disable();
+    auto const path = base::JoinPath(GetPlatform().WritableDir(), "profiler_trace.json");
+    if (base::profiler::SaveChromeTrace(path))
+      LOG(LINFO, ("Profiler trace is saved to", path));
+    else
+      LOG(LWARNING, ("Can't save profiler trace to", path));
+    return true;
+  }
+  return false;
+}
+
 string MakeSearchBookingUrl(booking::Api const & bookingApi, search::CityFinder & cityFinder,
                             FeatureType & ft)
 {
@@ -363,6 +391,11 @@ void Framework::OnViewportChanged(ScreenBase const & screen)
   m_isolinesManager.UpdateViewport(m_currentModelView);
   m_guidesManager.UpdateViewport(m_currentModelView);
 
+  // Prewarms the mwms in and around the viewport before they are needed.
+  auto rect = m_currentModelView.ClipRect();
+  rect.Inflate(rect.SizeX() / 2, rect.SizeY() / 2);
+  m_mwmPrewarmer.Prewarm(GetMwmsByRect(rect, true /* rough */));
+
   if (m_viewportChangedFn != nullptr)
     m_viewportChangedFn(screen);
 }
@@ -410,11 +443,33 @@ Framework::Framework(FrameworkParams const & params)
 {
   CHECK(IsLittleEndian(), ("Only little-endian architectures are supported."));
 
+  base::Timer initTimer;
+  auto const logInitialized = [&initTimer](std::string const & name) {
+    LOG(LDEBUG, (name, "initialized in", initTimer.ElapsedSeconds(), "seconds"));
+    initTimer.Reset();
+  };
+
+  // Country info getter and transliterators depend on nothing but platform resources, so they
+  // are loaded in the background while classificator and categories are loaded here.
+  auto countryInfoGetterInit = async(launch::async, [this] {
+    base::Timer timer;
+    InitCountryInfoGetter();
+    LOG(LDEBUG, ("Country info getter loaded in", timer.ElapsedSeconds(), "seconds"));
+  });
+  auto transliterationInit = async(launch::async, [this] {
+    base::Timer timer;
+    InitTransliteration();
+    LOG(LDEBUG, ("Transliterators loaded in", timer.ElapsedSeconds(), "seconds"));
+  });
+
   // Editor should be initialized from the main thread to set its ThreadChecker.
   // However, search calls editor upon initialization thus setting the lazy editor's ThreadChecker
   // to a wrong thread. So editor should be initialiazed before serach.
   osm::Editor & editor = osm::Editor::Instance();
 
+  // Centers of the areas are shared by the rendering and the search.
+  FeatureCentersCache::Instance().SetMaxSize(kMaxFeatureCentersCacheSizeBytes);
+
   // Restore map style before classificator loading
   MapStyle mapStyle = kDefaultMapStyle;
   string mapStyleStr;
@@ -439,19 +494,20 @@ Framework::Framework(FrameworkParams const & params)
 
   m_featuresFetcher.InitClassificator();
   m_featuresFetcher.SetOnMapDeregisteredCallback(bind(&Framework::OnMapDeregistered, this, _1));
-  LOG(LDEBUG, ("Classificator initialized"));
+  logInitialized("Classificator");
 
   m_displayedCategories = make_unique<search::DisplayedCategories>(GetDefaultCategories());
-
-  // To avoid possible races - init country info getter in constructor.
-  InitCountryInfoGetter();
-  LOG(LDEBUG, ("Country info getter initialized"));
+  logInitialized("Categories");
 
   InitUGC();
-  LOG(LDEBUG, ("UGC initialized"));
+  logInitialized("UGC");
+
+  // To avoid possible races - init country info getter in constructor.
+  countryInfoGetterInit.get();
+  logInitialized("Country info getter");
 
   InitSearchAPI(params.m_numSearchAPIThreads);
-  LOG(LDEBUG, ("Search API initialized"));
+  logInitialized("Search API");
 
   auto const catalogHeadersProvider = make_shared<CatalogHeadersProvider>(*this, m_storage);
 
@@ -493,10 +549,12 @@ Framework::Framework(FrameworkParams const & params)
                  bind(&Framework::OnCountryFileDelete, this, _1, _2));
   m_storage.SetDownloadingPolicy(&m_storageDownloadingPolicy);
   m_storage.SetStartDownloadingCallback([this]() { UpdatePlacePageInfoForCurrentSelection(); });
-  LOG(LDEBUG, ("Storage initialized"));
-  
+  logInitialized("Storage");
+
+  m_featuresFetcher.GetDataSource().EnableInfoManifest(
+      base::JoinPath(GetPlatform().WritableDir(), MWM_MANIFEST_FILE_NAME));
   RegisterAllMaps();
-  LOG(LDEBUG, ("Maps initialized"));
+  logInitialized("Maps");
 
   // Need to reload cities boundaries because maps in indexer were updated.
   GetSearchAPI().LoadCitiesBoundaries();
@@ -514,17 +572,21 @@ Framework::Framework(FrameworkParams const & params)
 
   UpdateMinBuildingsTapZoom();
 
-  LOG(LDEBUG, ("Routing engine initialized"));
+  logInitialized("Routing engine");
 
   LOG(LINFO, ("System languages:", languages::GetPreferred()));
 
   editor.SetDelegate(make_unique<search::EditorDelegate>(m_featuresFetcher.GetDataSource()));
-  editor.SetInvalidateFn([this](){ InvalidateRect(GetCurrentViewport()); });
+  editor.SetInvalidateFn([this]() {
+    InvalidateRect(GetCurrentViewport());
+    // Cached search features of the edited mwms are stale.
+    GetSearchAPI().ClearCaches();
+  });
   editor.LoadEdits();
 
   m_featuresFetcher.GetDataSource().AddObserver(editor);
 
-  LOG(LINFO, ("Editor initialized"));
+  logInitialized("Editor");
 
   m_trafficManager.SetCurrentDataVersion(m_storage.GetCurrentDataVersion());
   m_trafficManager.SetSimplifiedColorScheme(LoadTrafficSimplifiedColors());
@@ -538,8 +600,8 @@ Framework::Framework(FrameworkParams const & params)
   m_adsEngine = make_unique<ads::Engine>(make_unique<ads::AdsEngineDelegate>(
       *m_infoGetter, m_storage, *m_promoApi, *m_purchase, *m_taxiEngine));
 
-  InitTransliteration();
-  LOG(LDEBUG, ("Transliterators initialized"));
+  transliterationInit.get();
+  logInitialized("Transliterators");
 
   m_notificationManager.SetDelegate(
     std::make_unique<NotificationManagerDelegate>(m_featuresFetcher.GetDataSource(), *m_cityFinder,
@@ -660,14 +722,18 @@ void Framework::OnCountryFileDownloaded(storage::CountryId const & countryId,
     auto p = m_featuresFetcher.RegisterMap(*localFile);
     MwmSet::MwmId const & id = p.first;
     if (id.IsAlive())
+    {
       rect = id.GetInfo()->m_bordersRect;
+      m_mwmPrewarmer.Prewarm({id});
+    }
+    m_featuresFetcher.GetDataSource().SaveInfoManifest();
   }
   m_trafficManager.Invalidate();
   m_transitManager.Invalidate();
   m_isolinesManager.Invalidate();
   m_localAdsManager.OnDownloadCountry(countryId);
   InvalidateRect(rect);
-  GetSearchAPI().ClearCaches();
+  GetSearchAPI().OnMwmsChanged();
 }
 
 bool Framework::OnCountryFileDelete(storage::CountryId const & countryId,
@@ -692,7 +758,7 @@ bool Framework::OnCountryFileDelete(storage::CountryId const & countryId,
   }
   InvalidateRect(rect);
 
-  GetSearchAPI().ClearCaches();
+  GetSearchAPI().OnMwmsChanged();
   return deferredDelete;
 }
 
@@ -766,6 +832,8 @@ void Framework::RegisterAllMaps()
     }
   }
 
+  m_featuresFetcher.GetDataSource().SaveInfoManifest();
+
   if (needStatisticsUpdate)
   {
     alohalytics::Stats::Instance().LogEvent("Downloader_Map_list",
@@ -1483,6 +1551,7 @@ void Framework::MemoryWarning()
 {
   LOG(LINFO, ("MemoryWarning"));
   ClearAllCaches();
+  m_routingManager.RoutingSession().ClearCaches();
   SharedBufferManager::instance().clearReserved();
 }
 
@@ -1508,8 +1577,10 @@ void Framework::EnterBackground()
   // Do not clear caches for Android. This function is called when main activity is paused,
   // but at the same time search activity (for example) is enabled.
   // TODO(AlexZ): Use onStart/onStop on Android to correctly detect app background and remove #ifndef.
+  // Search caches are kept, they are limited in size and are invalidated by the changes of maps.
 #ifndef OMIM_OS_ANDROID
-  ClearAllCaches();
+  m_featuresFetcher.ClearCaches();
+  m_infoGetter->ClearCaches();
 #endif
 }
 
@@ -1959,8 +2030,8 @@ void Framework::CreateDrapeEngine(ref_ptr<dp::GraphicsContextFactory> contextFac
 
   auto isUGCFn = [this](FeatureID const & id)
   {
-    auto const ugc = m_ugcApi->GetLoader().GetUGC(id);
-    return !ugc.IsEmpty();
+    // Only non-empty UGC is written to the ugc section.
+    return m_ugcApi->GetLoader().HasUGC(id);
   };
   auto isCountryLoadedByNameFn = bind(&Framework::IsCountryLoadedByName, this, _1);
   auto updateCurrentCountryFn = bind(&Framework::OnUpdateCurrentCountry, this, _1, _2);
@@ -4018,6 +4089,8 @@ bool Framework::ParseSearchQueryCommand(search::SearchParams const & params)
     return true;
   if (ParseSetGpsTrackMinAccuracyCommand(params.m_query))
     return true;
+  if (ParseProfilerCommand(params.m_query))
+    return true;
   if (ParseEditorDebugCommand(params))
     return true;
   if (ParseRoutingDebugCommand(params))
@@ -4344,8 +4417,17 @@ void Framework::OnPowerFacilityChanged(power_management::Facility const facility
 
 void Framework::OnPowerSchemeChanged(power_management::Scheme const actualScheme)
 {
-  if (actualScheme == power_management::Scheme::EconomyMaximum && GetTrafficManager().IsEnabled())
-    GetTrafficManager().SetEnabled(false);
+  if (actualScheme == power_management::Scheme::EconomyMaximum)
+  {
+    if (GetTrafficManager().IsEnabled())
+      GetTrafficManager().SetEnabled(false);
+    if (GetIsolinesManager().IsEnabled())
+      GetIsolinesManager().SetEnabled(false);
+  }
+
+  GetTrafficManager().SetUpdateInterval(actualScheme == power_management::Scheme::EconomyMedium
+                                            ? kEconomyTrafficUpdateInterval
+                                            : TrafficManager::kDefaultUpdateInterval);
 }
 
 notifications::NotificationManager & Framework::GetNotificationManager()
@@ -50,6 +50,7 @@
 #include "indexer/data_source_helpers.hpp"
 #include "indexer/map_object.hpp"
 #include "indexer/map_style.hpp"
+#include "indexer/mwm_prewarmer.hpp"
 
 #include "search/city_finder.hpp"
 #include "search/displayed_categories.hpp"
@@ -189,6 +190,8 @@ protected:
   StringsBundle m_stringsBundle;
 
   FeaturesFetcher m_featuresFetcher;
+  // Must be destroyed before |m_featuresFetcher|.
+  MwmPrewarmer m_mwmPrewarmer{m_featuresFetcher.GetDataSource()};
 
   // The order matters here: DisplayedCategories may be used only
   // after classificator is loaded by |m_featuresFetcher|.
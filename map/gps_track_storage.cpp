@@ -2,12 +2,18 @@
 
 #include "coding/endianness.hpp"
 #include "coding/internal/file_data.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/writer.hpp"
 
 #include "base/assert.hpp"
 #include "base/logging.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstring>
+#include <limits>
 
 using namespace std;
 
@@ -15,27 +21,42 @@ namespace
 {
 
 // Current file format version
-uint32_t constexpr kCurrentVersion = 1;
+// 1 - plain GpsInfo values.
+// 2 - blocks of quantized values stored by columns as varint deltas.
+uint32_t constexpr kCurrentVersion = 2;
 
 // Header size in bytes, header consists of uint32_t 'version' only
 uint32_t constexpr kHeaderSize = sizeof(uint32_t);
 
-// Number of items for batch processing
+// Number of items for batch processing and max number of items in a block
 size_t constexpr kItemBlockSize = 1000;
 
-// TODO
-// Now GpsInfo written as plain values, but values can be compressed.
+// Small blocks are merged when there are more than kMinBlockCountToCompact blocks
+// and a block has less than kMinAvgBlockSize items on average.
+size_t constexpr kMinBlockCountToCompact = 256;
+size_t constexpr kMinAvgBlockSize = 8;
 
-// Size of point in bytes to write in file of read from file
-size_t constexpr kPointSize = 8 * sizeof(double) + sizeof(uint8_t);
+// Quantization factors of the values.
+double constexpr kTimestampFactor = 1e3;   // milliseconds
+double constexpr kCoordinateFactor = 1e7;  // about a centimetre
+double constexpr kValueFactor = 1e2;       // centimetres, cm/s and hundredths of a degree
 
-// Writes value in memory in LittleEndian
-template <typename T>
-void MemWrite(void * ptr, T value)
-{
-  value = SwapIfBigEndianMacroBased(value);
-  memcpy(ptr, &value, sizeof(T));
-}
+// Size of point in bytes in files of version 1
+size_t constexpr kPointSizeV1 = 8 * sizeof(double) + sizeof(uint8_t);
+
+// Columns of a block besides timestamps and sources.
+size_t constexpr kColumnsCount = 7;
+
+array<double location::GpsInfo::*, kColumnsCount> const kColumns = {
+    &location::GpsInfo::m_latitude,  &location::GpsInfo::m_longitude,
+    &location::GpsInfo::m_altitude,  &location::GpsInfo::m_speedMpS,
+    &location::GpsInfo::m_bearing,   &location::GpsInfo::m_horizontalAccuracy,
+    &location::GpsInfo::m_verticalAccuracy};
+
+array<double, kColumnsCount> const kColumnFactors = {kCoordinateFactor, kCoordinateFactor,
+                                                     kValueFactor,      kValueFactor,
+                                                     kValueFactor,      kValueFactor,
+                                                     kValueFactor};
 
 // Read value from memory, which is LittleEndian in memory
 template <typename T>
@@ -46,22 +67,7 @@ T MemRead(void const * ptr)
   return SwapIfBigEndianMacroBased(value);
 }
 
-void Pack(char * p, location::GpsInfo const & info)
-{  
-  MemWrite<double>(p + 0 * sizeof(double), info.m_timestamp);
-  MemWrite<double>(p + 1 * sizeof(double), info.m_latitude);
-  MemWrite<double>(p + 2 * sizeof(double), info.m_longitude);
-  MemWrite<double>(p + 3 * sizeof(double), info.m_altitude);
-  MemWrite<double>(p + 4 * sizeof(double), info.m_speedMpS);
-  MemWrite<double>(p + 5 * sizeof(double), info.m_bearing);
-  MemWrite<double>(p + 6 * sizeof(double), info.m_horizontalAccuracy);
-  MemWrite<double>(p + 7 * sizeof(double), info.m_verticalAccuracy);
-  ASSERT_LESS_OR_EQUAL(static_cast<int>(info.m_source), 255, ());
-  uint8_t const source = static_cast<uint8_t>(info.m_source);
-  MemWrite<uint8_t>(p + 8 * sizeof(double), source);
-}
-
-void Unpack(char const * p, location::GpsInfo & info)
+void UnpackV1(char const * p, location::GpsInfo & info)
 {
   info.m_timestamp = MemRead<double>(p + 0 * sizeof(double));
   info.m_latitude = MemRead<double>(p + 1 * sizeof(double));
@@ -75,15 +81,203 @@ void Unpack(char const * p, location::GpsInfo & info)
   info.m_source = static_cast<location::TLocationSource>(source);
 }
 
-inline size_t GetItemOffset(size_t itemIndex)
+int64_t Quantize(double value, double factor)
+{
+  return static_cast<int64_t>(llround(value * factor));
+}
+
+double Dequantize(int64_t value, double factor) { return static_cast<double>(value) / factor; }
+
+// Deltas of quantized values must not overflow.
+bool IsQuantizable(double value, double factor)
+{
+  double constexpr kMaxQuantizedValue = static_cast<double>(1LL << 52);
+  return isfinite(value) && fabs(value * factor) < kMaxQuantizedValue;
+}
+
+uint64_t ToBits(double value)
 {
-  return kHeaderSize + itemIndex * kPointSize;
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
 }
 
-inline size_t GetItemCount(size_t fileSize)
+double FromBits(uint64_t bits)
 {
-  ASSERT_GREATER_OR_EQUAL(fileSize, kHeaderSize, ());
-  return (fileSize - kHeaderSize) / kPointSize;
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// Values of a column are stored as plain doubles if any of them is not quantizable.
+enum class ColumnEncoding : uint8_t
+{
+  Deltas = 0,
+  Plain = 1
+};
+
+// Reads varints right from the file stream.
+class StreamSource
+{
+public:
+  StreamSource(fstream & stream, string const & filePath)
+    : m_stream(stream), m_filePath(filePath)
+  {
+  }
+
+  void Read(void * p, size_t size)
+  {
+    m_stream.read(static_cast<char *>(p), size);
+    if (!m_stream.good())
+      MYTHROW(GpsTrackStorage::ReadException, ("File:", m_filePath));
+  }
+
+private:
+  fstream & m_stream;
+  string const & m_filePath;
+};
+
+// Block of items:
+//   varuint number of items
+//   varint min timestamp
+//   varuint max timestamp - min timestamp
+//   varuint size of the columns
+//   columns
+// Columns are the deltas of the timestamps starting from the min timestamp, the encoding and the
+// deltas of every other value starting from zero and the sources. Values are quantized by their
+// factors.
+struct BlockHeader
+{
+  template <typename Source>
+  void Read(Source & src)
+  {
+    m_count = ReadVarUint<uint32_t>(src);
+    m_minTimestamp = ReadVarInt<int64_t>(src);
+    m_maxTimestamp = m_minTimestamp + static_cast<int64_t>(ReadVarUint<uint64_t>(src));
+    m_columnsSize = ReadVarUint<uint32_t>(src);
+  }
+
+  template <typename Sink>
+  void Write(Sink & sink) const
+  {
+    WriteVarUint(sink, m_count);
+    WriteVarInt(sink, m_minTimestamp);
+    WriteVarUint(sink, static_cast<uint64_t>(m_maxTimestamp - m_minTimestamp));
+    WriteVarUint(sink, m_columnsSize);
+  }
+
+  bool IsInTimeRange(double fromTimestamp, double toTimestamp) const
+  {
+    return Dequantize(m_maxTimestamp, kTimestampFactor) >= fromTimestamp &&
+           Dequantize(m_minTimestamp, kTimestampFactor) <= toTimestamp;
+  }
+
+  uint32_t m_count = 0;
+  int64_t m_minTimestamp = 0;
+  int64_t m_maxTimestamp = 0;
+  uint32_t m_columnsSize = 0;
+};
+
+void EncodeBlock(location::GpsInfo const * items, size_t count, vector<char> & buffer)
+{
+  ASSERT_GREATER(count, 0, ());
+
+  BlockHeader header;
+  header.m_count = static_cast<uint32_t>(count);
+  header.m_minTimestamp = numeric_limits<int64_t>::max();
+  header.m_maxTimestamp = numeric_limits<int64_t>::min();
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto const timestamp = Quantize(items[i].m_timestamp, kTimestampFactor);
+    header.m_minTimestamp = min(header.m_minTimestamp, timestamp);
+    header.m_maxTimestamp = max(header.m_maxTimestamp, timestamp);
+  }
+
+  vector<char> columns;
+  {
+    MemWriter<vector<char>> sink(columns);
+
+    int64_t prev = header.m_minTimestamp;
+    for (size_t i = 0; i < count; ++i)
+    {
+      auto const timestamp = Quantize(items[i].m_timestamp, kTimestampFactor);
+      WriteVarInt(sink, timestamp - prev);
+      prev = timestamp;
+    }
+
+    for (size_t c = 0; c < kColumnsCount; ++c)
+    {
+      bool const quantized = all_of(items, items + count, [c](location::GpsInfo const & item)
+      {
+        return IsQuantizable(item.*kColumns[c], kColumnFactors[c]);
+      });
+      WriteToSink(sink, static_cast<uint8_t>(quantized ? ColumnEncoding::Deltas
+                                                       : ColumnEncoding::Plain));
+      if (!quantized)
+      {
+        for (size_t i = 0; i < count; ++i)
+          WriteToSink(sink, ToBits(items[i].*kColumns[c]));
+        continue;
+      }
+
+      prev = 0;
+      for (size_t i = 0; i < count; ++i)
+      {
+        auto const value = Quantize(items[i].*kColumns[c], kColumnFactors[c]);
+        WriteVarInt(sink, value - prev);
+        prev = value;
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      ASSERT_LESS_OR_EQUAL(static_cast<int>(items[i].m_source), 255, ());
+      WriteToSink(sink, static_cast<uint8_t>(items[i].m_source));
+    }
+  }
+  header.m_columnsSize = static_cast<uint32_t>(columns.size());
+
+  buffer.clear();
+  MemWriter<vector<char>> sink(buffer);
+  header.Write(sink);
+  sink.Write(columns.data(), columns.size());
+}
+
+void DecodeColumns(BlockHeader const & header, vector<char> const & columns,
+                   vector<location::GpsInfo> & items)
+{
+  items.assign(header.m_count, location::GpsInfo());
+
+  MemReader reader(columns.data(), columns.size());
+  ReaderSource<MemReader> src(reader);
+
+  int64_t prev = header.m_minTimestamp;
+  for (auto & item : items)
+  {
+    prev += ReadVarInt<int64_t>(src);
+    item.m_timestamp = Dequantize(prev, kTimestampFactor);
+  }
+
+  for (size_t c = 0; c < kColumnsCount; ++c)
+  {
+    auto const encoding = static_cast<ColumnEncoding>(ReadPrimitiveFromSource<uint8_t>(src));
+    if (encoding == ColumnEncoding::Plain)
+    {
+      for (auto & item : items)
+        item.*kColumns[c] = FromBits(ReadPrimitiveFromSource<uint64_t>(src));
+      continue;
+    }
+
+    prev = 0;
+    for (auto & item : items)
+    {
+      prev += ReadVarInt<int64_t>(src);
+      item.*kColumns[c] = Dequantize(prev, kColumnFactors[c]);
+    }
+  }
+
+  for (auto & item : items)
+    item.m_source = static_cast<location::TLocationSource>(ReadPrimitiveFromSource<uint8_t>(src));
 }
 
 inline bool WriteVersion(fstream & f, uint32_t version)
@@ -108,6 +302,8 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
   : m_filePath(filePath)
   , m_maxItemCount(maxItemCount)
   , m_itemCount(0)
+  , m_blockCount(0)
+  , m_dataSize(kHeaderSize)
 {
   ASSERT_GREATER(m_maxItemCount, 0, ());
 
@@ -122,42 +318,21 @@ GpsTrackStorage::GpsTrackStorage(string const & filePath, size_t maxItemCount)
 
     if (version == kCurrentVersion)
     {
-      // Seek to end to get file size
-      m_stream.seekp(0, ios::end);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
-
-      auto const fileSize = static_cast<size_t>(m_stream.tellp());
-
-      m_itemCount = GetItemCount(fileSize);
-
-      // Set write position after last item position
-      size_t const offset = GetItemOffset(m_itemCount);
-      m_stream.seekp(offset, ios::beg);
-      if (!m_stream.good())
-        MYTHROW(OpenException, ("Seek to the offset error:", offset, m_filePath));
+      ReadBlocksInfo();
+    }
+    else if (version == 1)
+    {
+      MigrateFromV1();
     }
     else
     {
       m_stream.close();
-      // TODO: migration for file m_filePath from version 'version' to version 'kCurrentVersion'
-      // TODO: For now we support only one version, but in future migration may be needed.
+      LOG(LWARNING, ("Unknown version of gps track file:", version, m_filePath));
     }
   }
 
   if (!m_stream)
-  {
-    // Create new file
-    m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
-
-    if (!m_stream)
-      MYTHROW(OpenException, ("Open file error.", m_filePath));
-
-    if (!WriteVersion(m_stream, kCurrentVersion))
-      MYTHROW(OpenException, ("Write version error.", m_filePath));
-
-    m_itemCount = 0;
-  }
+    Create();
 }
 
 void GpsTrackStorage::Append(vector<TItem> const & items)
@@ -167,91 +342,223 @@ void GpsTrackStorage::Append(vector<TItem> const & items)
   if (items.empty())
     return;
 
-  bool const needTrunc = (m_itemCount + items.size()) > (m_maxItemCount * 2); // see NOTE in declaration
-
-  if (needTrunc)
-    TruncFile();
+  if (NeedCompaction(items.size()))
+    Compact();
 
-  // Write position must be after last item position
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(m_itemCount)), ());
-
-  vector<char> buff(min(kItemBlockSize, items.size()) * kPointSize);
-  for (size_t i = 0; i < items.size();)
-  {
-    size_t const n = min(items.size() - i, kItemBlockSize);
-
-    for (size_t j = 0; j < n; ++j)
-      Pack(&buff[0] + j * kPointSize, items[i + j]);
+  m_stream.seekp(m_dataSize, ios::beg);
+  if (!m_stream.good())
+    MYTHROW(WriteException, ("File:", m_filePath));
 
-    m_stream.write(&buff[0], n * kPointSize);
-    if (!m_stream.good())
-      MYTHROW(WriteException, ("File:", m_filePath));
-
-    i += n;
-  }
+  m_blockCount += WriteBlocks(m_stream, items);
 
   m_stream.flush();
   if (!m_stream.good())
     MYTHROW(WriteException, ("File:", m_filePath));
 
   m_itemCount += items.size();
+  m_dataSize = static_cast<uint64_t>(m_stream.tellp());
 }
 
 void GpsTrackStorage::Clear()
 {
   ASSERT(m_stream.is_open(), ());
 
-  m_itemCount = 0;
-
   m_stream.close();
 
+  try
+  {
+    Create();
+  }
+  catch (OpenException const & e)
+  {
+    MYTHROW(WriteException, (e.Msg()));
+  }
+}
+
+void GpsTrackStorage::ForEach(std::function<bool(TItem const & item)> const & fn)
+{
+  ForEachInTimeRange(numeric_limits<double>::lowest(), numeric_limits<double>::max(), fn);
+}
+
+void GpsTrackStorage::ForEachInTimeRange(double fromTimestamp, double toTimestamp,
+                                         std::function<bool(TItem const & item)> const & fn)
+{
+  ASSERT(m_stream.is_open(), ());
+
+  size_t const firstItemIndex = GetFirstItemIndex();
+
+  // Set read position to the first block
+  m_stream.seekg(kHeaderSize, ios::beg);
+  if (!m_stream.good())
+    MYTHROW(ReadException, ("File:", m_filePath));
+
+  StreamSource src(m_stream, m_filePath);
+  vector<char> columns;
+  vector<TItem> items;
+  size_t itemIndex = 0;
+  for (size_t i = 0; i < m_blockCount; ++i)
+  {
+    BlockHeader header;
+    header.Read(src);
+
+    size_t const blockBegin = itemIndex;
+    itemIndex += header.m_count;
+    if (itemIndex <= firstItemIndex || !header.IsInTimeRange(fromTimestamp, toTimestamp))
+    {
+      m_stream.seekg(header.m_columnsSize, ios::cur);
+      if (!m_stream.good())
+        MYTHROW(ReadException, ("File:", m_filePath));
+      continue;
+    }
+
+    columns.resize(header.m_columnsSize);
+    src.Read(columns.data(), columns.size());
+    DecodeColumns(header, columns, items);
+
+    for (size_t j = firstItemIndex > blockBegin ? firstItemIndex - blockBegin : 0; j < items.size();
+         ++j)
+    {
+      auto const & item = items[j];
+      if (item.m_timestamp < fromTimestamp || item.m_timestamp > toTimestamp)
+        continue;
+      if (!fn(item))
+        return;
+    }
+  }
+}
+
+void GpsTrackStorage::Create()
+{
   m_stream.open(m_filePath, ios::in | ios::out | ios::binary | ios::trunc);
 
   if (!m_stream)
-    MYTHROW(WriteException, ("File:", m_filePath));
+    MYTHROW(OpenException, ("Open file error.", m_filePath));
 
   if (!WriteVersion(m_stream, kCurrentVersion))
-    MYTHROW(WriteException, ("File:", m_filePath));
+    MYTHROW(OpenException, ("Write version error.", m_filePath));
 
-  // Write position is set to the first item in the file
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(0)), ());
+  m_itemCount = 0;
+  m_blockCount = 0;
+  m_dataSize = kHeaderSize;
 }
 
-void GpsTrackStorage::ForEach(std::function<bool(TItem const & item)> const & fn)
+void GpsTrackStorage::ReadBlocksInfo()
 {
-  ASSERT(m_stream.is_open(), ());
+  m_stream.seekg(0, ios::end);
+  if (!m_stream.good())
+    MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
+  auto const fileSize = static_cast<uint64_t>(m_stream.tellg());
+
+  m_stream.seekg(kHeaderSize, ios::beg);
+  m_itemCount = 0;
+  m_blockCount = 0;
+  m_dataSize = kHeaderSize;
+
+  // Only the headers of the blocks are read. The last block may be incomplete if the app was
+  // killed while it was written, such blocks are dropped.
+  StreamSource src(m_stream, m_filePath);
+  try
+  {
+    while (m_dataSize < fileSize)
+    {
+      BlockHeader header;
+      header.Read(src);
+      auto const blockEnd = static_cast<uint64_t>(m_stream.tellg()) + header.m_columnsSize;
+      if (blockEnd > fileSize)
+        break;
+
+      m_stream.seekg(header.m_columnsSize, ios::cur);
+      m_itemCount += header.m_count;
+      ++m_blockCount;
+      m_dataSize = blockEnd;
+    }
+  }
+  catch (ReadException const &)
+  {
+  }
+  m_stream.clear();
+
+  if (m_dataSize != fileSize)
+  {
+    LOG(LWARNING, ("Incomplete block at the end of gps track file:", m_filePath));
+    Compact();
+  }
+}
 
-  size_t i = GetFirstItemIndex();
+void GpsTrackStorage::MigrateFromV1()
+{
+  m_stream.seekg(0, ios::end);
+  if (!m_stream.good())
+    MYTHROW(OpenException, ("Seek to the end error.", m_filePath));
+  auto const fileSize = static_cast<size_t>(m_stream.tellg());
+  size_t const itemCount = (fileSize - kHeaderSize) / kPointSizeV1;
+  size_t const firstItemIndex = itemCount > m_maxItemCount ? itemCount - m_maxItemCount : 0;
 
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
+  m_stream.seekg(kHeaderSize + firstItemIndex * kPointSizeV1, ios::beg);
   if (!m_stream.good())
-    MYTHROW(ReadException, ("File:", m_filePath));
+    MYTHROW(OpenException, ("Seek to the offset error.", m_filePath));
 
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  vector<TItem> items;
+  items.reserve(itemCount - firstItemIndex);
+  vector<char> buff(kItemBlockSize * kPointSizeV1);
+  for (size_t i = firstItemIndex; i < itemCount;)
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
+    size_t const n = min(itemCount - i, kItemBlockSize);
 
-    m_stream.read(&buff[0], n * kPointSize);
+    m_stream.read(&buff[0], n * kPointSizeV1);
     if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
+      MYTHROW(OpenException, ("Read error.", m_filePath));
 
     for (size_t j = 0; j < n; ++j)
-    {      
-      TItem item;
-      Unpack(&buff[0] + j * kPointSize, item);
-      if (!fn(item))
-        return;
+    {
+      items.emplace_back();
+      UnpackV1(&buff[0] + j * kPointSizeV1, items.back());
     }
 
     i += n;
   }
+  m_stream.close();
+
+  try
+  {
+    Create();
+    Append(items);
+  }
+  catch (WriteException const & e)
+  {
+    MYTHROW(OpenException, (e.Msg()));
+  }
 }
 
-void GpsTrackStorage::TruncFile()
+size_t GpsTrackStorage::WriteBlocks(fstream & stream, vector<TItem> const & items)
+{
+  size_t blockCount = 0;
+  vector<char> buffer;
+  for (size_t i = 0; i < items.size();)
+  {
+    size_t const n = min(items.size() - i, kItemBlockSize);
+
+    EncodeBlock(&items[i], n, buffer);
+    stream.write(buffer.data(), buffer.size());
+    if (!stream.good())
+      MYTHROW(WriteException, ("File:", m_filePath));
+
+    i += n;
+    ++blockCount;
+  }
+  return blockCount;
+}
+
+bool GpsTrackStorage::NeedCompaction(size_t newItemCount) const
+{
+  // see NOTE in declaration
+  if (m_itemCount + newItemCount > m_maxItemCount * 2)
+    return true;
+
+  return m_blockCount > kMinBlockCountToCompact && m_blockCount * kMinAvgBlockSize > m_itemCount;
+}
+
+void GpsTrackStorage::Compact()
 {
   string const tmpFilePath = m_filePath + ".tmp";
 
@@ -264,34 +571,27 @@ void GpsTrackStorage::TruncFile()
   if (!WriteVersion(tmp, kCurrentVersion))
     MYTHROW(WriteException, ("File:", tmpFilePath));
 
-  size_t i = GetFirstItemIndex();
-
-  // Set read position to the first item
-  m_stream.seekg(GetItemOffset(i), ios::beg);
-  if (!m_stream.good())
-    MYTHROW(ReadException, ("File:", m_filePath));
-
+  // Copy the items of the window to the big blocks.
   size_t newItemCount = 0;
-
-  // Copy items
-  vector<char> buff(min(kItemBlockSize, m_itemCount) * kPointSize);
-  for (; i < m_itemCount;)
+  size_t newBlockCount = 0;
+  vector<TItem> items;
+  items.reserve(kItemBlockSize);
+  auto const flush = [&]()
   {
-    size_t const n = min(m_itemCount - i, kItemBlockSize);
-
-    m_stream.read(&buff[0], n * kPointSize);
-    if (!m_stream.good())
-      MYTHROW(ReadException, ("File:", m_filePath));
+    newBlockCount += WriteBlocks(tmp, items);
+    newItemCount += items.size();
+    items.clear();
+  };
 
-    tmp.write(&buff[0], n * kPointSize);
-    if (!tmp.good())
-      MYTHROW(WriteException, ("File:", tmpFilePath));
-
-    i += n;
-    newItemCount += n;
-  }
-  buff.clear();
-  buff.shrink_to_fit();
+  ForEach([&](TItem const & item)
+  {
+    items.push_back(item);
+    if (items.size() == kItemBlockSize)
+      flush();
+    return true;
+  });
+  if (!items.empty())
+    flush();
 
   tmp.close();
   m_stream.close();
@@ -310,10 +610,8 @@ void GpsTrackStorage::TruncFile()
     MYTHROW(WriteException, ("File:", m_filePath));
 
   m_itemCount = newItemCount;
-
-  // Write position must be after last item position (end of file)
-  ASSERT_EQUAL(m_stream.tellp(), static_cast<typename fstream::pos_type>(
-                   GetItemOffset(m_itemCount)), ());
+  m_blockCount = newBlockCount;
+  m_dataSize = static_cast<uint64_t>(m_stream.tellp());
 }
 
 size_t GpsTrackStorage::GetFirstItemIndex() const
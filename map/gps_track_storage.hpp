@@ -5,6 +5,7 @@
 #include "base/exception.hpp"
 #include "base/macros.hpp"
 
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <string>
@@ -39,18 +40,38 @@ public:
   /// @exceptions ReadException if read fails.
   void ForEach(std::function<bool(TItem const & item)> const & fn);
 
+  /// Same as ForEach but only for the items with timestamps in [fromTimestamp, toTimestamp].
+  /// Blocks of items out of the range are skipped without decoding.
+  /// @exceptions ReadException if read fails.
+  void ForEachInTimeRange(double fromTimestamp, double toTimestamp,
+                          std::function<bool(TItem const & item)> const & fn);
+
 private:
   DISALLOW_COPY_AND_MOVE(GpsTrackStorage);
 
-  void TruncFile();
+  void Create();
+  void ReadBlocksInfo();
+  void MigrateFromV1();
+  // Returns the number of written blocks.
+  size_t WriteBlocks(std::fstream & stream, std::vector<TItem> const & items);
+  void Compact();
+  bool NeedCompaction(size_t newItemCount) const;
   size_t GetFirstItemIndex() const;
 
   std::string const m_filePath;
   size_t const m_maxItemCount;
   std::fstream m_stream;
   size_t m_itemCount; // current number of items in file, read note
+  size_t m_blockCount;
+  uint64_t m_dataSize; // size of the header and the blocks
 
   // NOTE
+  // Items are stored in blocks. Every Append writes new blocks to the end of file. Values of a
+  // block are quantized and stored by columns as varint deltas, so a point of a track takes
+  // about a dozen bytes instead of 65 bytes of the plain values. Appends of a few items make
+  // small blocks which compress worse, they are merged into big blocks by compaction when
+  // they become too many.
+  //
   // New items append to the end of file, when file become too big, it is truncated.
   // Here 'silly window sindrome' is possible: for example max file size is 100k items,
   // and 99k items are filled, when 2k items is coming, then 98k items is copying to the tmp file
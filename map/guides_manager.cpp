@@ -31,6 +31,9 @@ auto constexpr kScaleEps = 0.1115;
 auto constexpr kMinViewportsIntersectionScore = 0.9;
 auto constexpr kRequestingRectIncrease = 0.6;
 
+size_t constexpr kMaxCachedResponses = 8;
+auto constexpr kCachedResponseLifetime = std::chrono::minutes(5);
+
 using GalleryItem = GuidesManager::GuidesGallery::Item;
 using SortedGuides = std::vector<std::pair<m2::PointD, size_t>>;
 
@@ -177,6 +180,20 @@ void GuidesManager::RequestGuides(bool suggestZoom)
   if (!IsRequestParamsInitialized())
     return;
 
+  if (auto const * cached = FindCachedResponse())
+  {
+    // The requests in flight are outdated now.
+    if (m_previousRequestsId != base::TaskLoop::kNoId)
+    {
+      GetPlatform().CancelTask(Platform::Thread::Network, m_previousRequestsId);
+      m_previousRequestsId = base::TaskLoop::kNoId;
+    }
+    // Copy the response, the cache may be changed while the guides are shown.
+    auto const guides = cached->m_guides;
+    OnRequestSucceed(guides, suggestZoom, ++m_requestCounter);
+    return;
+  }
+
   auto screenRect = m_screen.GlobalRect();
 
   auto rect = screenRect.GetGlobalRect();
@@ -192,7 +209,11 @@ void GuidesManager::RequestGuides(bool suggestZoom)
   auto const requestNumber = ++m_requestCounter;
   auto const pushResult = m_api.GetGuidesOnMap(
       corners, m_zoom, suggestZoom, kRequestingRectIncrease * 100,
-      std::bind(&GuidesManager::OnRequestSucceed, this, _1, suggestZoom, requestNumber),
+      [this, screenRect, zoom = m_zoom, suggestZoom,
+       requestNumber](guides_on_map::GuidesOnMap const & guides) {
+        CacheResponse(screenRect, zoom, guides);
+        OnRequestSucceed(guides, suggestZoom, requestNumber);
+      },
       std::bind(&GuidesManager::OnRequestError, this));
 
   if (pushResult.m_id != base::TaskLoop::kNoId)
@@ -256,6 +277,33 @@ void GuidesManager::OnRequestSucceed(guides_on_map::GuidesOnMap const & guides,
   }
 }
 
+void GuidesManager::CacheResponse(m2::AnyRectD const & rect, int zoom,
+                                  guides_on_map::GuidesOnMap const & guides)
+{
+  if (m_responsesCache.size() >= kMaxCachedResponses)
+    m_responsesCache.pop_front();
+
+  m_responsesCache.push_back({rect, zoom, std::chrono::steady_clock::now(), guides});
+}
+
+GuidesManager::CachedResponse const * GuidesManager::FindCachedResponse()
+{
+  auto const now = std::chrono::steady_clock::now();
+  while (!m_responsesCache.empty() &&
+         now - m_responsesCache.front().m_time > kCachedResponseLifetime)
+  {
+    m_responsesCache.pop_front();
+  }
+
+  auto const & screenRect = m_screen.GlobalRect();
+  for (auto it = m_responsesCache.crbegin(); it != m_responsesCache.crend(); ++it)
+  {
+    if (it->m_zoom == m_zoom && it->m_rect.IsRectInside(screenRect))
+      return &*it;
+  }
+  return nullptr;
+}
+
 void GuidesManager::OnRequestError()
 {
   if (m_state == GuidesState::Disabled || m_state == GuidesState::FatalNetworkError ||
@@ -10,11 +10,13 @@
 
 #include "drape_frontend/drape_engine_safe_ptr.hpp"
 
+#include "geometry/any_rect2d.hpp"
 #include "geometry/rect2d.hpp"
 #include "geometry/screenbase.hpp"
 
 #include "base/task_loop.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <deque>
 #include <functional>
@@ -135,6 +137,20 @@ private:
                         uint64_t requestNumber);
   void OnRequestError();
 
+  // Responses are cached for the requested rects, so a request for a viewport inside
+  // one of them is answered without the network.
+  struct CachedResponse
+  {
+    m2::AnyRectD m_rect;
+    int m_zoom = 0;
+    std::chrono::steady_clock::time_point m_time;
+    guides_on_map::GuidesOnMap m_guides;
+  };
+
+  void CacheResponse(m2::AnyRectD const & rect, int zoom,
+                     guides_on_map::GuidesOnMap const & guides);
+  CachedResponse const * FindCachedResponse();
+
   CloseGalleryFn m_closeGallery;
 
   GuidesState m_state = GuidesState::Disabled;
@@ -152,6 +168,8 @@ private:
 
   guides_on_map::Api m_api;
   guides_on_map::GuidesOnMap m_guides;
+  // The most recent responses are at the end.
+  std::deque<CachedResponse> m_responsesCache;
   std::string m_activeGuide;
 
   BookmarkManager * m_bmManager = nullptr;
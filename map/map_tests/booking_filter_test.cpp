@@ -353,6 +353,58 @@ UNIT_CLASS_TEST(TestMwmEnvironment, BookingFilter_ApplyFilterOntoWithFeatureIds)
   TEST_EQUAL(availabilityExtras.size(), filteredResults.size(), ());
 }
 
+UNIT_CLASS_TEST(TestMwmEnvironment, BookingFilter_ConcurrentRequests)
+{
+  std::vector<std::string> const kHotelIds = {"10623", "10624", "10625"};
+
+  BuildCountry("TestMwm", [&kHotelIds](TestMwmBuilder & builder)
+  {
+    for (size_t i = 0; i < kHotelIds.size(); ++i)
+    {
+      TestBookingHotel hotel(m2::PointD(1.0 + 0.1 * i, 1.0), "hotel " + kHotelIds[i]);
+      hotel.GetMetadata().Set(feature::Metadata::FMD_SPONSORED_ID, kHotelIds[i]);
+      builder.Add(hotel);
+    }
+  });
+
+  m2::RectD const rect(m2::PointD(0.5, 0.5), m2::PointD(1.5, 1.5));
+  std::vector<FeatureID> featureIds;
+  m_dataSource.ForEachInRect([&featureIds](FeatureType & ft) { featureIds.push_back(ft.GetID()); },
+                             rect, scales::GetUpperScale());
+  std::sort(featureIds.begin(), featureIds.end());
+
+  auto const makeTasks = [](std::vector<FeatureID> & filteredResults) {
+    ParamsRawInternal params;
+    params.m_apiParams = std::make_shared<booking::AvailabilityParams>(
+        booking::AvailabilityParams::MakeDefault());
+    params.m_callback = [&filteredResults](auto && result) {
+      filteredResults = result.m_passedFilter;
+      testing::Notify();
+    };
+    TasksRawInternal tasks;
+    tasks.emplace_back(Type::Availability, std::move(params));
+    return tasks;
+  };
+
+  // The second request is applied while the hotels are requested by the first one, so it waits
+  // for the first request instead of requesting the hotels again.
+  std::vector<FeatureID> firstResults;
+  std::vector<FeatureID> secondResults;
+  FilterProcessor processor(GetDataSource(), GetApi());
+  auto featureIdsCopy = featureIds;
+  processor.ApplyFilters(std::move(featureIdsCopy), makeTasks(firstResults),
+                         ApplicationMode::Independent);
+  featureIdsCopy = featureIds;
+  processor.ApplyFilters(std::move(featureIdsCopy), makeTasks(secondResults),
+                         ApplicationMode::Independent);
+
+  testing::Wait();
+  testing::Wait();
+
+  TEST_EQUAL(firstResults, featureIds, ());
+  TEST_EQUAL(secondResults, featureIds, ());
+}
+
 UNIT_TEST(Booking_PriceFormatter)
 {
   booking::PriceFormatter formatter;
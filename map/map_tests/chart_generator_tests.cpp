@@ -126,6 +126,22 @@ UNIT_TEST(NormalizeChartData_Test)
   TEST(AlmostEqualAbs(uniformAltitudeDataM, expectedUniformAltitudeDataM), ());
 }
 
+UNIT_TEST(NormalizeChartData_UnevenPointsTest)
+{
+  // Several uniform points fall into one segment and several segments are between two uniform
+  // points. There are points with the same distance too.
+  vector<double> const distanceDataM = {0.0, 1.0, 1.0, 1.5, 2.0, 8.0, 9.0};
+  geometry::Altitudes const altitudeDataM = {0, 10, 20, 10, 30, 0, 9};
+
+  vector<double> uniformAltitudeDataM;
+  TEST(maps::NormalizeChartData(distanceDataM, altitudeDataM, 7 /* resultPointCount */,
+                                uniformAltitudeDataM),
+       ());
+
+  vector<double> const expectedUniformAltitudeDataM = {0.0, 10.0, 25.0, 17.5, 10.0, 2.5, 9.0};
+  TEST(AlmostEqualAbs(uniformAltitudeDataM, expectedUniformAltitudeDataM), ());
+}
+
 UNIT_TEST(GenerateYAxisChartData_SmokeTest)
 {
   vector<double> const altitudeDataM = {0.0, 0.0};
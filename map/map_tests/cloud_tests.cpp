@@ -57,3 +57,42 @@ UNIT_TEST(Cloud_SerDes)
   TEST_EQUAL(index.m_lastUpdateInHours, indexDes.m_lastUpdateInHours, ());
   TEST(AreEqualEntries(index.m_entries, indexDes.m_entries), ());
 }
+
+UNIT_TEST(Cloud_SourceHash)
+{
+  Cloud::Index index;
+  index.m_entries.emplace_back(std::make_shared<Cloud::Entry>("bm1.kml", 100, false, "hash"));
+  index.m_entries.back()->m_sourceHash = "sourceHash";
+
+  std::string data;
+  {
+    using Sink = MemWriter<std::string>;
+    Sink sink(data);
+    coding::SerializerJson<Sink> ser(sink);
+    ser(index);
+  }
+
+  Cloud::Index indexDes;
+  {
+    coding::DeserializerJson des(data);
+    des(indexDes);
+  }
+
+  TEST_EQUAL(indexDes.m_entries.size(), 1, ());
+  TEST_EQUAL(indexDes.m_entries[0]->m_hash, "hash", ());
+  TEST_EQUAL(indexDes.m_entries[0]->m_sourceHash, "sourceHash", ());
+
+  // The index which is saved without source hashes.
+  std::string const kOldIndex =
+      R"({"entries": [{"name": "bm1.kml", "sizeInBytes": 100, "hash": "hash", "isOutdated": false}],
+          "lastUpdateInHours": 0, "isOutdated": false, "lastSyncTimestamp": 0})";
+  Cloud::Index oldIndexDes;
+  {
+    coding::DeserializerJson des(kOldIndex);
+    des(oldIndexDes);
+  }
+
+  TEST_EQUAL(oldIndexDes.m_entries.size(), 1, ());
+  TEST_EQUAL(oldIndexDes.m_entries[0]->m_hash, "hash", ());
+  TEST(oldIndexDes.m_entries[0]->m_sourceHash.empty(), ());
+}
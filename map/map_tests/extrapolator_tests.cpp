@@ -1,6 +1,10 @@
 #include "testing/testing.hpp"
 
 #include "map/extrapolation/extrapolator.hpp"
+#include "map/extrapolation/kalman_filter.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+#include "geometry/mercator.hpp"
 
 #include "platform/location.hpp"
 
@@ -145,4 +149,34 @@ UNIT_TEST(AreCoordsGoodForExtrapolation)
     TEST(!AreCoordsGoodForExtrapolation(loc1, loc2), ("Too rare locations."));
   }
 }
+
+UNIT_TEST(KalmanFilter_ConstantVelocity)
+{
+  // Moving to the North with 10 meters per second.
+  double constexpr kSpeed = 10.0;
+  double constexpr kLatPerSecond = kSpeed / mercator::Bounds::kMetersInDegree;
+  KalmanFilter filter;
+  TEST(!filter.IsInitialized(), ());
+  for (size_t i = 0; i < 10; ++i)
+  {
+    TEST(filter.Update(GetGpsInfo(static_cast<double>(i) /* timestampS */,
+                                  10.0 + kLatPerSecond * i /* lat */, 20.0 /* lon */,
+                                  1.0 /* altitude */, kSpeed)),
+         ());
+  }
+  TEST(filter.IsInitialized(), ());
+
+  // Location older than the last one.
+  TEST(!filter.Update(GetGpsInfo(5.0 /* timestampS */, 10.0 /* lat */, 20.0 /* lon */,
+                                 1.0 /* altitude */, kSpeed)),
+       ());
+
+  GpsInfo const predicted = filter.Predict(10.5 /* timestampS */);
+  TEST_ALMOST_EQUAL_ABS(predicted.m_timestamp, 10.5, 1e-9, ());
+  double const distM = ms::DistanceOnEarth(predicted.m_latitude, predicted.m_longitude,
+                                           10.0 + kLatPerSecond * 10.5, 20.0);
+  TEST_LESS(distM, 1.0, ());
+  TEST_ALMOST_EQUAL_ABS(predicted.m_speedMpS, kSpeed, 0.1, ());
+  TEST(predicted.m_bearing < 1.0 || predicted.m_bearing > 359.0, (predicted.m_bearing));
+}
 }  // namespace
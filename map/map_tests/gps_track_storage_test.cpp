@@ -5,6 +5,7 @@
 #include "platform/platform.hpp"
 
 #include "coding/file_writer.hpp"
+#include "coding/internal/file_data.hpp"
 
 #include "geometry/latlon.hpp"
 
@@ -189,3 +190,59 @@ UNIT_TEST(GpsTrackStorage_WriteReadWithTrunc)
     TEST_EQUAL(i, 0, ());
   }
 }
+
+UNIT_TEST(GpsTrackStorage_SmallAppendsAndTimeRange)
+{
+  double const timestamp = 1600000000.0;
+
+  string const filePath = GetGpsTrackFilePath();
+  SCOPE_GUARD(gpsTestFileDeleter, bind(FileWriter::DeleteFileX, filePath));
+  FileWriter::DeleteFileX(filePath);
+
+  size_t const fileMaxItemCount = 10000;
+  size_t const pointsCount = 5000;
+
+  vector<location::GpsInfo> points;
+  points.reserve(pointsCount);
+  for (size_t i = 0; i < pointsCount; ++i)
+  {
+    points.emplace_back(Make(timestamp + i, ms::LatLon(55.75 + i * 1e-5, 37.61 - i * 1e-5),
+                             i % 20));
+  }
+
+  // Points are appended one by one as they come from the location service, small blocks
+  // are merged on the way.
+  {
+    GpsTrackStorage stg(filePath, fileMaxItemCount);
+    for (auto const & point : points)
+      stg.Append({point});
+  }
+
+  uint64_t fileSize = 0;
+  TEST(base::GetFileSize(filePath, fileSize), ());
+  TEST_LESS(fileSize, pointsCount * 24, ());
+
+  GpsTrackStorage stg(filePath, fileMaxItemCount);
+
+  size_t i = 0;
+  stg.ForEach([&](location::GpsInfo const & point)
+  {
+    TEST_EQUAL(point.m_timestamp, points[i].m_timestamp, ());
+    TEST_ALMOST_EQUAL_ABS(point.m_latitude, points[i].m_latitude, 1e-7, ());
+    TEST_ALMOST_EQUAL_ABS(point.m_longitude, points[i].m_longitude, 1e-7, ());
+    TEST_EQUAL(point.m_speedMpS, points[i].m_speedMpS, ());
+    TEST_EQUAL(static_cast<int>(point.m_source), static_cast<int>(points[i].m_source), ());
+    ++i;
+    return true;
+  });
+  TEST_EQUAL(i, pointsCount, ());
+
+  i = 1000;
+  stg.ForEachInTimeRange(timestamp + 1000, timestamp + 1999, [&](location::GpsInfo const & point)
+  {
+    TEST_EQUAL(point.m_timestamp, points[i].m_timestamp, ());
+    ++i;
+    return true;
+  });
+  TEST_EQUAL(i, 2000, ());
+}
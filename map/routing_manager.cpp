@@ -6,6 +6,7 @@
 
 #include "routing/absent_regions_finder.hpp"
 #include "routing/checkpoint_predictor.hpp"
+#include "routing/index_graph_loader.hpp"
 #include "routing/index_router.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_callbacks.hpp"
@@ -869,8 +870,30 @@ void RoutingManager::AddRoutePoint(RouteMarkData && markData)
   }
 
   markData.m_isVisible = !markData.m_isMyPosition;
+  auto const point = markData.m_position;
   routePoints.AddRoutePoint(move(markData));
   ReorderIntermediatePoints();
+  WarmUpRoutingGraph(point);
+}
+
+void RoutingManager::WarmUpRoutingGraph(m2::PointD const & point)
+{
+  // Transit routes are built with a graph which isn't loaded by the index graph loader.
+  if (m_currentRouterType == RouterType::Count || m_currentRouterType == RouterType::Transit)
+    return;
+
+  auto const countryId = m_callbacks.m_countryInfoGetter().GetRegionCountryId(point);
+  if (countryId.empty())
+    return;
+
+  GetPlatform().RunTask(Platform::Thread::Background,
+                        [this, countryId, vehicleType = GetVehicleType(m_currentRouterType)]() {
+                          auto const handle =
+                              m_callbacks.m_dataSourceGetter().GetMwmHandleByCountryFile(
+                                  platform::CountryFile(countryId));
+                          if (handle.IsAlive())
+                            WarmUpIndexGraph(handle, vehicleType);
+                        });
 }
 
 void RoutingManager::RemoveRoutePoint(RouteMarkType type, size_t intermediateIndex)
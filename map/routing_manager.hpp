@@ -363,6 +363,9 @@ private:
   void SetPointsFollowingMode(bool enabled);
 
   void ReorderIntermediatePoints();
+  // Decodes the routing graph of the mwm of |point| in the background, so the route through
+  // the point is built without waiting for it.
+  void WarmUpRoutingGraph(m2::PointD const & point);
 
   m2::RectD ShowPreviewSegments(std::vector<RouteMarkData> const & routePoints);
   void HidePreviewSegments();
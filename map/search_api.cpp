@@ -13,6 +13,7 @@
 #include "search/utils.hpp"
 
 #include "storage/downloader_search_params.hpp"
+#include "storage/storage.hpp"
 
 #include "platform/preferred_languages.hpp"
 #include "platform/safe_callback.hpp"
@@ -44,6 +45,8 @@ double const kMaxAreaToLoadAllHotelsInViewport = 2e8;
 
 size_t const kMaximumPossibleNumberOfBookmarksToIndex = 5000;
 
+size_t const kMaxNumDownloaderNamesResults = 10;
+
 // Cancels search query by |handle|.
 void CancelQuery(weak_ptr<ProcessorHandle> & handle)
 {
@@ -259,8 +262,37 @@ bool SearchAPI::SearchInDownloader(storage::DownloaderSearchParams const & param
   p.m_needAddress = false;
   p.m_needHighlighting = false;
 
-  p.m_onResults = DownloaderSearchCallback(static_cast<DownloaderSearchCallback::Delegate &>(*this),
-                                           m_dataSource, m_infoGetter, m_storage, params);
+  auto const locale = m_storage.GetLocale();
+  if (m_downloaderNameIndex.IsEmpty() || m_downloaderNameIndexLocale != locale)
+  {
+    auto const rootId = m_storage.GetRootId();
+    m_downloaderNameIndex.Clear();
+    m_storage.ForEachInSubtree(rootId, [&](storage::CountryId const & countryId,
+                                           bool /* groupNode */) {
+      if (countryId != rootId)
+        m_downloaderNameIndex.Add(countryId, m_storage.GetNodeLocalName(countryId));
+    });
+    m_downloaderNameIndex.Build();
+    m_downloaderNameIndexLocale = locale;
+  }
+
+  // Countries and regions are found by their names instantly, the search over the map features
+  // adds the nodes found by the names of cities and other places later.
+  vector<storage::DownloaderSearchResult> namesResults;
+  m_downloaderNameIndex.Search(params.m_query, kMaxNumDownloaderNamesResults, namesResults);
+  if (!namesResults.empty() && params.m_onResults)
+  {
+    storage::DownloaderSearchResults results;
+    results.m_results = namesResults;
+    results.m_query = params.m_query;
+    results.m_endMarker = false;
+    RunUITask([onResults = params.m_onResults, results]() { onResults(results); });
+  }
+
+  DownloaderSearchCallback callback(static_cast<DownloaderSearchCallback::Delegate &>(*this),
+                                    m_dataSource, m_infoGetter, m_storage, params);
+  callback.SetNamesResults(namesResults);
+  p.m_onResults = move(callback);
 
   return Search(p, true /* forceSearch */);
 }
@@ -8,6 +8,7 @@
 #include "map/viewport_search_callback.hpp"
 #include "map/viewport_search_params.hpp"
 
+#include "search/downloader_name_index.hpp"
 #include "search/downloader_search_callback.hpp"
 #include "search/engine.hpp"
 #include "search/mode.hpp"
@@ -129,6 +130,7 @@ public:
   void CancelSearch(search::Mode mode);
   void CancelAllSearches();
   void ClearCaches() { return m_engine.ClearCaches(); }
+  void OnMwmsChanged() { return m_engine.OnMwmsChanged(); }
 
   // *SearchCallback::Delegate overrides:
   void RunUITask(std::function<void()> fn) override;
@@ -219,4 +221,9 @@ private:
   // it is easier than obtaining the information about a group asynchronously
   // from |m_engine|.
   std::unordered_set<kml::MarkGroupId> m_indexableGroups;
+
+  // Index of the localized names of the downloader nodes and the locale it's built for. These
+  // fields are not guarded because they must be used from the UI thread only.
+  search::DownloaderNameIndex m_downloaderNameIndex;
+  std::string m_downloaderNameIndexLocale;
 };
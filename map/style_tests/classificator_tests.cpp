@@ -3,8 +3,10 @@
 
 #include "indexer/classificator.hpp"
 #include "indexer/classificator_loader.hpp"
+#include "indexer/drawing_rules.hpp"
 #include "indexer/feature_visibility.hpp"
 #include "indexer/feature_data.hpp"
+#include "indexer/scales.hpp"
 
 #include "platform/platform.hpp"
 
@@ -53,6 +55,36 @@ UNIT_TEST(Classificator_CheckConsistency)
   });
 }
 
+UNIT_TEST(Classificator_PreparedRules)
+{
+  UnitTestInitPlatform();
+  styles::RunForEveryMapStyle([](MapStyle)
+  {
+    Classificator const & c = classif();
+    drule::RulesHolder const & holder = drule::rules();
+    c.ForEachTree([&](ClassifObject const * p, uint32_t type)
+    {
+      for (int scale = 0; scale <= scales::GetUpperStyleScale(); ++scale)
+      {
+        for (auto const geomType :
+             {feature::GeomType::Point, feature::GeomType::Line, feature::GeomType::Area})
+        {
+          drule::KeysT keys;
+          p->GetSuitable(scale, geomType, keys);
+          auto const range = holder.GetPreparedRules(type, scale, static_cast<int>(geomType));
+          TEST_EQUAL(keys.size(), static_cast<size_t>(range.second - range.first),
+                     (c.GetFullObjectName(type), scale));
+          for (size_t i = 0; i < keys.size(); ++i)
+          {
+            TEST(keys[i] == range.first[i].m_key, (c.GetFullObjectName(type), scale));
+            TEST_EQUAL(holder.Find(keys[i]), range.first[i].m_rule, ());
+          }
+        }
+      }
+    });
+  });
+}
+
 using namespace feature;
 
 namespace
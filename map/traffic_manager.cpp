@@ -16,8 +16,7 @@ using namespace std::chrono;
 
 namespace
 {
-auto constexpr kUpdateInterval = minutes(1);
-auto constexpr kOutdatedDataTimeout = minutes(5) + kUpdateInterval;
+auto constexpr kOutdatedDataTimeout = minutes(5);
 auto constexpr kNetworkErrorTimeout = minutes(20);
 
 auto constexpr kMaxRetriesCount = 5;
@@ -50,6 +49,7 @@ TrafficManager::TrafficManager(GetMwmsByRectFn const & getMwmsByRectFn, size_t m
   , m_maxCacheSizeBytes(maxCacheSizeBytes)
   , m_isRunning(true)
   , m_isPaused(false)
+  , m_updateInterval(kDefaultUpdateInterval)
   , m_thread(&TrafficManager::ThreadRoutine, this)
   , m_statistics("traffic")
 {
@@ -123,6 +123,7 @@ void TrafficManager::Clear()
   m_activeRoutingMwms.clear();
   m_requestedMwms.clear();
   m_trafficETags.clear();
+  m_lastColorings.clear();
 }
 
 void TrafficManager::SetDrapeEngine(ref_ptr<df::DrapeEngine> engine)
@@ -250,9 +251,33 @@ void TrafficManager::ThreadRoutine()
       {
         std::lock_guard<std::mutex> lock(m_mutex);
         tag = m_trafficETags[mwm];
+        auto const it = m_lastColorings.find(mwm);
+        if (it != m_lastColorings.cend())
+          info.SetLastColoring(it->second);
       }
 
-      if (info.ReceiveTrafficData(tag))
+      std::string const lastTag = tag;
+      bool const received = info.ReceiveTrafficData(tag);
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (tag != lastTag)
+        {
+          // The server sends the next deltas to the coloring of the new tag. If the data of the
+          // tag can't be used the full data is requested next time.
+          if (received)
+          {
+            m_lastColorings[mwm] = info.GetSharedColoring();
+          }
+          else
+          {
+            tag.clear();
+            m_lastColorings.erase(mwm);
+          }
+        }
+        m_trafficETags[mwm] = tag;
+      }
+
+      if (received)
       {
         OnTrafficDataResponse(std::move(info));
       }
@@ -261,11 +286,6 @@ void TrafficManager::ThreadRoutine()
         LOG(LWARNING, ("Traffic request failed. Mwm =", mwm));
         OnTrafficRequestFailed(std::move(info));
       }
-
-      {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_trafficETags[mwm] = tag;
-      }
     }
     mwms.clear();
   }
@@ -275,7 +295,7 @@ bool TrafficManager::WaitForRequest(std::vector<MwmSet::MwmId> & mwms)
 {
   std::unique_lock<std::mutex> lock(m_mutex);
 
-  bool const timeout = !m_condition.wait_for(lock, kUpdateInterval, [this]
+  bool const timeout = !m_condition.wait_for(lock, m_updateInterval.load(), [this]
   {
     return !m_isRunning || !m_requestedMwms.empty();
   });
@@ -305,7 +325,7 @@ void TrafficManager::RequestTrafficData(MwmSet::MwmId const & mwmId, bool force)
   else
   {
     auto const passedSeconds = currentTime - it->second.m_lastRequestTime;
-    if (passedSeconds >= kUpdateInterval || force)
+    if (passedSeconds >= m_updateInterval.load() || force)
     {
       needRequesting = true;
       it->second.m_isWaitingForResponse = true;
@@ -384,7 +404,7 @@ void TrafficManager::OnTrafficDataResponse(traffic::TrafficInfo && info)
     if (!info.GetColoring().empty())
     {
       // Update cache.
-      size_t constexpr kElementSize = sizeof(traffic::TrafficInfo::RoadSegmentId) + sizeof(traffic::SpeedGroup);
+      size_t constexpr kElementSize = sizeof(traffic::TrafficInfo::Coloring::value_type);
       size_t const dataSize = info.GetColoring().size() * kElementSize;
       m_currentCacheSizeBytes += (dataSize - it->second.m_dataSize);
       it->second.m_dataSize = dataSize;
@@ -452,6 +472,7 @@ void TrafficManager::ClearCache(MwmSet::MwmId const & mwmId)
   }
   m_mwmCache.erase(it);
   m_trafficETags.erase(mwmId);
+  m_lastColorings.erase(mwmId);
   m_activeDrapeMwms.erase(mwmId);
   m_activeRoutingMwms.erase(mwmId);
   m_lastDrapeMwmsByRect.clear();
@@ -463,6 +484,11 @@ bool TrafficManager::IsEnabled() const
   return m_state != TrafficState::Disabled;
 }
 
+void TrafficManager::SetUpdateInterval(std::chrono::seconds interval)
+{
+  m_updateInterval = interval;
+}
+
 bool TrafficManager::IsInvalidState() const
 {
   return m_state == TrafficState::NetworkError;
@@ -524,7 +550,7 @@ void TrafficManager::UpdateState()
     ChangeState(TrafficState::ExpiredData);
   else if (noData)
     ChangeState(TrafficState::NoData);
-  else if (maxPassedTime >= kOutdatedDataTimeout)
+  else if (maxPassedTime >= kOutdatedDataTimeout + m_updateInterval.load())
     ChangeState(TrafficState::Outdated);
   else
     ChangeState(TrafficState::Enabled);
@@ -23,6 +23,7 @@
 #include <condition_variable>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <set>
@@ -75,6 +76,11 @@ public:
   void SetEnabled(bool enabled);
   bool IsEnabled() const;
 
+  static auto constexpr kDefaultUpdateInterval = std::chrono::seconds(60);
+  /// \brief Sets how often traffic data of the visible mwms is requested. Data is considered
+  /// outdated after a timeout which grows with the interval.
+  void SetUpdateInterval(std::chrono::seconds interval);
+
   void UpdateViewport(ScreenBase const & screen);
   void UpdateMyPosition(MyPosition const & myPosition);
 
@@ -183,8 +189,11 @@ private:
   // It is one of several mechanisms that HTTP provides for web cache validation,
   // which allows a client to make conditional requests.
   std::map<MwmSet::MwmId, std::string> m_trafficETags;
+  // The colorings of |m_trafficETags| the traffic deltas are applied to.
+  std::map<MwmSet::MwmId, std::shared_ptr<traffic::TrafficInfo::Coloring const>> m_lastColorings;
 
   std::atomic<bool> m_isPaused;
+  std::atomic<std::chrono::seconds> m_updateInterval;
 
   std::vector<MwmSet::MwmId> m_requestedMwms;
   std::mutex m_mutex;
@@ -27,6 +27,10 @@ namespace
 {
 int constexpr kMinSchemeZoomLevel = 10;
 size_t constexpr kMaxTransitCacheSizeBytes = 5 /* Mb */ * 1024 * 1024;
+// Transit of the mwms in the viewport rect scaled by this factor is read in background.
+double constexpr kPrefetchRectScale = 3.0;
+// Groups of the synchronous reading tasks are numbered from 1.
+uint64_t constexpr kPrefetchTasksGroupId = 0;
 
 size_t CalculateCacheSize(TransitDisplayInfo const & transitInfo)
 {
@@ -284,6 +288,7 @@ void TransitReadManager::EnableTransitSchemeMode(bool enable)
     m_lastActiveMwms.clear();
     m_mwmCache.clear();
     m_cacheSize = 0;
+    ClearPrefetched();
   }
   else
   {
@@ -308,6 +313,7 @@ void TransitReadManager::BlockTransitSchemeMode(bool isBlocked)
     m_lastActiveMwms.clear();
     m_mwmCache.clear();
     m_cacheSize = 0;
+    ClearPrefetched();
   }
   else
   {
@@ -358,7 +364,13 @@ void TransitReadManager::UpdateViewport(ScreenBase const & screen)
 
   if (!newTransitData.empty())
   {
-    GetTransitDisplayInfo(newTransitData);
+    auto notPrefetched = TakePrefetched(newTransitData);
+    if (!notPrefetched.empty())
+    {
+      GetTransitDisplayInfo(notPrefetched);
+      for (auto & [mwmId, transitInfo] : notPrefetched)
+        newTransitData[mwmId] = std::move(transitInfo);
+    }
 
     TransitDisplayInfos validTransitData;
     for (auto & [mwmId, transitInfo] : newTransitData)
@@ -392,6 +404,8 @@ void TransitReadManager::UpdateViewport(ScreenBase const & screen)
     }
   }
 
+  PrefetchNeighbours(screen);
+
   bool hasData = m_lastActiveMwms.empty();
   for (auto const & mwmId : m_lastActiveMwms)
   {
@@ -429,6 +443,84 @@ void TransitReadManager::OnMwmDeregistered(platform::LocalCountryFile const & co
     }
   }
   ClearCache(mwmId);
+
+  lock_guard<mutex> lock(m_mutex);
+  for (auto it = m_prefetchedData.begin(); it != m_prefetchedData.end();)
+  {
+    if (it->first.IsDeregistered(countryFile))
+      it = m_prefetchedData.erase(it);
+    else
+      ++it;
+  }
+}
+
+TransitDisplayInfos TransitReadManager::TakePrefetched(TransitDisplayInfos & transitDisplayInfos)
+{
+  TransitDisplayInfos notPrefetched;
+
+  lock_guard<mutex> lock(m_mutex);
+  for (auto & [mwmId, transitInfo] : transitDisplayInfos)
+  {
+    auto it = m_prefetchedData.find(mwmId);
+    if (it == m_prefetchedData.end())
+    {
+      notPrefetched[mwmId] = move(transitInfo);
+      continue;
+    }
+    transitInfo = move(it->second);
+    m_prefetchedData.erase(it);
+  }
+  return notPrefetched;
+}
+
+void TransitReadManager::PrefetchNeighbours(ScreenBase const & screen)
+{
+  auto rect = screen.ClipRect();
+  rect.Scale(kPrefetchRectScale);
+
+  set<MwmSet::MwmId> prefetchMwms;
+  for (auto const & mwmId : m_getMwmsByRectFn(rect))
+  {
+    if (mwmId.IsAlive() && m_mwmCache.count(mwmId) == 0)
+      prefetchMwms.insert(mwmId);
+  }
+
+  vector<ReadTransitTask *> newTasks;
+  {
+    lock_guard<mutex> lock(m_mutex);
+    m_prefetchMwms = move(prefetchMwms);
+
+    // Data of the mwms which are far from the viewport now is dropped to keep the memory bounded.
+    // Tasks which are in progress are not cancelled, their results are dropped on completion.
+    for (auto it = m_prefetchedData.begin(); it != m_prefetchedData.end();)
+    {
+      if (m_prefetchMwms.count(it->first) == 0)
+        it = m_prefetchedData.erase(it);
+      else
+        ++it;
+    }
+
+    for (auto const & mwmId : m_prefetchMwms)
+    {
+      if (m_prefetchedData.count(mwmId) != 0 || m_prefetchTasks.count(mwmId) != 0)
+        continue;
+
+      auto task = make_unique<ReadTransitTask>(m_dataSource, m_readFeaturesFn);
+      task->Init(kPrefetchTasksGroupId, mwmId);
+      newTasks.push_back(task.get());
+      m_prefetchTasks.emplace(mwmId, move(task));
+    }
+  }
+
+  for (auto * task : newTasks)
+    m_threadsPool->PushBack(task);
+}
+
+void TransitReadManager::ClearPrefetched()
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_prefetchMwms.clear();
+  m_prefetchedData.clear();
 }
 
 void TransitReadManager::Invalidate()
@@ -479,8 +571,9 @@ bool TransitReadManager::GetTransitDisplayInfo(TransitDisplayInfos & transitDisp
   m_tasksGroups[groupId] = transitTasks.size();
   lock.unlock();
 
+  // The caller waits for these tasks, so they go before the prefetching ones.
   for (auto const & task : transitTasks)
-    m_threadsPool->PushBack(task.second.get());
+    m_threadsPool->PushFront(task.second.get());
 
   lock.lock();
   m_event.wait(lock, [&]() { return m_tasksGroups[groupId] == 0; });
@@ -507,6 +600,18 @@ void TransitReadManager::OnTaskCompleted(threads::IRoutine * task)
 
   lock_guard<mutex> lock(m_mutex);
 
+  if (t->GetId() == kPrefetchTasksGroupId)
+  {
+    auto const mwmId = t->GetMwmId();
+    auto it = m_prefetchTasks.find(mwmId);
+    CHECK(it != m_prefetchTasks.end() && it->second.get() == t, (mwmId));
+    if (t->GetSuccess() && m_prefetchMwms.count(mwmId) != 0)
+      m_prefetchedData[mwmId] = t->GetTransitInfo();
+    // The thread pool does not own the tasks, so the prefetching task is destroyed here.
+    m_prefetchTasks.erase(it);
+    return;
+  }
+
   if (--m_tasksGroups[t->GetId()] == 0)
     m_event.notify_all();
 }
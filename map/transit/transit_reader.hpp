@@ -43,6 +43,7 @@ public:
   void Init(uint64_t id, MwmSet::MwmId const & mwmId,
             std::unique_ptr<TransitDisplayInfo> transitInfo = nullptr);
   uint64_t GetId() const { return m_id; }
+  MwmSet::MwmId const & GetMwmId() const { return m_mwmId; }
   bool GetSuccess() const { return m_success; }
 
   void Do() override;
@@ -123,6 +124,13 @@ private:
   void ShrinkCacheToAllowableSize();
   void ClearCache(MwmSet::MwmId const & mwmId);
 
+  // Moves the prefetched data of the mwms from |transitDisplayInfos| to it. Returns the infos
+  // of the mwms which are not prefetched.
+  TransitDisplayInfos TakePrefetched(TransitDisplayInfos & transitDisplayInfos);
+  // Starts background reading of the mwms around |screen| which are not in the cache yet.
+  void PrefetchNeighbours(ScreenBase const & screen);
+  void ClearPrefetched();
+
   void TrackStatistics(std::set<int64_t> const & mwmVersions);
 
   std::unique_ptr<base::thread_pool::routine::ThreadPool> m_threadsPool;
@@ -133,6 +141,12 @@ private:
   uint64_t m_nextTasksGroupId = 0;
   std::map<uint64_t, size_t> m_tasksGroups;
 
+  // Transit of the mwms around the viewport is read in background, so it is shown without
+  // waiting for the disk when the viewport moves there. Guarded by |m_mutex|.
+  std::set<MwmSet::MwmId> m_prefetchMwms;
+  std::map<MwmSet::MwmId, std::unique_ptr<ReadTransitTask>> m_prefetchTasks;
+  TransitDisplayInfos m_prefetchedData;
+
   DataSource & m_dataSource;
   TReadFeaturesFn m_readFeaturesFn;
 
@@ -8,13 +8,27 @@
 
 #include "geometry/mercator.hpp"
 
+#include "platform/platform.hpp"
+
+#include "base/exception.hpp"
+#include "base/file_name_utils.hpp"
+#include "base/math.hpp"
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <exception>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "3party/gflags/src/gflags/gflags.h"
 
@@ -29,6 +43,13 @@ DEFINE_int32(width, 480, "Resulting image width");
 DEFINE_int32(height, 640, "Resulting image height");
 DEFINE_double(vs, 2.0, "Visual scale (mdpi = 1.0, hdpi = 1.5, xhdpiScale = 2.0, "
                        "6plus = 2.4, xxhdpi = 3.0, xxxhdpi = 3.5)");
+DEFINE_string(tiles_rect, "", "Export XYZ tiles of the rect \"minLat;minLon;maxLat;maxLon\" "
+                              "into <outpath>/<zoom>/<x>/<y>.png instead of places");
+DEFINE_int32(min_zoom, 10, "Minimal zoom of the exported tiles");
+DEFINE_int32(max_zoom, 14, "Maximal zoom of the exported tiles");
+DEFINE_int32(tile_size, 256, "Size of the exported tiles in pixels");
+DEFINE_uint64(threads, 1, "Number of threads rendering the places, every thread has its own "
+                          "renderer. 0 means the number of hardware threads.");
 
 //----------------------------------------------------------------------------------------
 
@@ -63,6 +84,99 @@ Place ParsePlace(string const & src)
   return p;
 }
 
+struct Tile
+{
+  int zoom;
+  uint32_t x;
+  uint32_t y;
+};
+
+// Position of (x, y) on the Hilbert curve which fills the square of 2^|bits| side.
+uint64_t HilbertIndex(uint32_t x, uint32_t y, uint8_t bits)
+{
+  uint32_t const mask = static_cast<uint32_t>((uint64_t{1} << bits) - 1);
+  uint64_t index = 0;
+  for (uint32_t s = uint32_t{1} << (bits - 1); s > 0; s >>= 1)
+  {
+    uint32_t const rx = (x & s) != 0 ? 1 : 0;
+    uint32_t const ry = (y & s) != 0 ? 1 : 0;
+    index += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+    // Rotates the quadrant so that the curve in it starts from the origin.
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = mask - x;
+        y = mask - y;
+      }
+      swap(x, y);
+    }
+  }
+  return index;
+}
+
+m2::RectD ParseTilesRect(string const & src)
+{
+  vector<double> coords;
+  try
+  {
+    for (strings::SimpleTokenizer token(src, ";"); token; ++token)
+      coords.push_back(stod(*token));
+  }
+  catch (exception & e)
+  {
+    cerr << "Error in [" << src << "]: " << e.what() << endl;
+    exit(1);
+  }
+  if (coords.size() != 4)
+  {
+    cerr << "Error in [" << src << "]: four coordinates are expected" << endl;
+    exit(1);
+  }
+  return m2::RectD(mercator::FromLatLon(coords[0], coords[1]),
+                   mercator::FromLatLon(coords[2], coords[3]));
+}
+
+// Mercator rect of the XYZ tile, y of the tiles grows to the south.
+m2::RectD GetTileRect(Tile const & tile)
+{
+  double const size = mercator::Bounds::kRangeX / (uint64_t{1} << tile.zoom);
+  double const minX = mercator::Bounds::kMinX + tile.x * size;
+  double const maxY = mercator::Bounds::kMaxY - tile.y * size;
+  return m2::RectD(minX, maxY - size, minX + size, maxY);
+}
+
+// Tiles of |rect| for all the zooms. The tiles of a zoom are ordered by the Hilbert curve, so
+// the consecutive tiles are neighbours and read the same map data.
+vector<Tile> GetTiles(m2::RectD const & rect, int minZoom, int maxZoom)
+{
+  vector<Tile> tiles;
+  for (int zoom = minZoom; zoom <= maxZoom; ++zoom)
+  {
+    auto const count = static_cast<double>(uint64_t{1} << zoom);
+    auto const toTile = [count](double v) {
+      return static_cast<uint32_t>(base::Clamp(v * count, 0.0, count - 1));
+    };
+    auto const minX = toTile((rect.minX() - mercator::Bounds::kMinX) / mercator::Bounds::kRangeX);
+    auto const maxX = toTile((rect.maxX() - mercator::Bounds::kMinX) / mercator::Bounds::kRangeX);
+    auto const minY = toTile((mercator::Bounds::kMaxY - rect.maxY()) / mercator::Bounds::kRangeY);
+    auto const maxY = toTile((mercator::Bounds::kMaxY - rect.minY()) / mercator::Bounds::kRangeY);
+
+    vector<pair<uint64_t, Tile>> zoomTiles;
+    for (uint32_t x = minX; x <= maxX; ++x)
+    {
+      for (uint32_t y = minY; y <= maxY; ++y)
+        zoomTiles.emplace_back(HilbertIndex(x, y, static_cast<uint8_t>(max(zoom, 1))), Tile{zoom, x, y});
+    }
+    sort(zoomTiles.begin(), zoomTiles.end(),
+         [](auto const & l, auto const & r) { return l.first < r.first; });
+    for (auto const & t : zoomTiles)
+      tiles.push_back(t.second);
+  }
+  return tiles;
+}
+
 string FilenameSeq(string const & path)
 {
   static size_t counter = 0;
@@ -71,29 +185,41 @@ string FilenameSeq(string const & path)
   return filename.str();
 }
 
-unique_ptr<software_renderer::CPUDrawer> cpuDrawer;
-
-bool IsFrameRendererInitialized()
-{
-  return cpuDrawer != nullptr;
-}
-
-void InitFrameRenderer(float visualScale)
+// Every rendering thread has its own renderer with its own glyph cache, the renderers share
+// the map data and the drawing rules only, which are read-only while rendering.
+unique_ptr<software_renderer::CPUDrawer> CreateFrameRenderer(float visualScale)
 {
   using namespace software_renderer;
 
-  if (cpuDrawer == nullptr)
-  {
-    df::VisualParams::Init(visualScale, 1024 /* dummy tile size */);
-    string resPostfix = df::VisualParams::GetResourcePostfix(visualScale);
-    cpuDrawer = make_unique_dp<CPUDrawer>(CPUDrawer::Params(resPostfix, visualScale));
-  }
+  string resPostfix = df::VisualParams::GetResourcePostfix(visualScale);
+  return make_unique<CPUDrawer>(CPUDrawer::Params(resPostfix, visualScale));
 }
 
-void ReleaseFrameRenderer()
+// Draws the features of |screen| with the background of |bgZoom|, the frame must be ended
+// by the caller.
+void DrawFeatures(Framework & framework, software_renderer::CPUDrawer & drawer,
+                  ScreenBase const & screen, int bgZoom, uint32_t pxWidth, uint32_t pxHeight)
 {
-  if (IsFrameRendererInitialized())
-    cpuDrawer.reset();
+  uint32_t const bgColor = drule::rules().GetBgColor(bgZoom);
+  drawer.BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
+
+  m2::RectD renderRect = m2::RectD(0, 0, pxWidth, pxHeight);
+  m2::RectD selectRect;
+  m2::RectD clipRect;
+  double const inflationSize = 24 * drawer.GetVisualScale();
+  screen.PtoG(m2::Inflate(renderRect, inflationSize, inflationSize), clipRect);
+  screen.PtoG(renderRect, selectRect);
+
+  uint32_t const tileSize = static_cast<uint32_t>(df::CalculateTileSize(pxWidth, pxHeight));
+  int const drawScale = df::GetDrawTileScale(screen, tileSize, drawer.GetVisualScale());
+  software_renderer::FeatureProcessor doDraw(make_ref(&drawer), clipRect, screen, drawScale);
+
+  int const upperScale = scales::GetUpperScale();
+
+  framework.GetDataSource().ForEachInRect([&doDraw](FeatureType & ft) { doDraw(ft); },
+                                          selectRect, min(upperScale, drawScale));
+
+  drawer.Flush();
 }
 
 /// @param center - map center in Mercator
@@ -107,52 +233,32 @@ void ReleaseFrameRenderer()
 ///                   It must be equal render buffer height. For retina it's equal 2.0 * displayHeight
 /// @param symbols - configuration for symbols on the frame
 /// @param image [out] - result image
-void DrawFrame(Framework & framework,
+void DrawFrame(Framework & framework, software_renderer::CPUDrawer & drawer,
                m2::PointD const & center, int zoomModifier,
                uint32_t pxWidth, uint32_t pxHeight,
                software_renderer::FrameSymbols const & symbols,
                software_renderer::FrameImage & image)
 {
-  ASSERT(IsFrameRendererInitialized(), ());
-
   int resultZoom = -1;
-  ScreenBase screen = cpuDrawer->CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
+  ScreenBase screen = drawer.CalculateScreen(center, zoomModifier, pxWidth, pxHeight, symbols, resultZoom);
   ASSERT_GREATER(resultZoom, 0, ());
 
-  uint32_t const bgColor = drule::rules().GetBgColor(resultZoom);
-  cpuDrawer->BeginFrame(pxWidth, pxHeight, dp::Extract(bgColor, 255 - (bgColor >> 24)));
-
-  m2::RectD renderRect = m2::RectD(0, 0, pxWidth, pxHeight);
-  m2::RectD selectRect;
-  m2::RectD clipRect;
-  double const inflationSize = 24 * cpuDrawer->GetVisualScale();
-  screen.PtoG(m2::Inflate(renderRect, inflationSize, inflationSize), clipRect);
-  screen.PtoG(renderRect, selectRect);
-
-  uint32_t const tileSize = static_cast<uint32_t>(df::CalculateTileSize(pxWidth, pxHeight));
-  int const drawScale = df::GetDrawTileScale(screen, tileSize, cpuDrawer->GetVisualScale());
-  software_renderer::FeatureProcessor doDraw(make_ref(cpuDrawer), clipRect, screen, drawScale);
-
-  int const upperScale = scales::GetUpperScale();
-
-  framework.GetDataSource().ForEachInRect([&doDraw](FeatureType & ft) { doDraw(ft); },
-                                          selectRect, min(upperScale, drawScale));
-
-  cpuDrawer->Flush();
-  //cpuDrawer->DrawMyPosition(screen.GtoP(center));
+  DrawFeatures(framework, drawer, screen, resultZoom, pxWidth, pxHeight);
+  //drawer.DrawMyPosition(screen.GtoP(center));
 
   if (symbols.m_showSearchResult)
   {
     if (!screen.PixelRect().IsPointInside(screen.GtoP(symbols.m_searchResult)))
-      cpuDrawer->DrawSearchArrow(ang::AngleTo(center, symbols.m_searchResult));
+      drawer.DrawSearchArrow(ang::AngleTo(center, symbols.m_searchResult));
     else
-      cpuDrawer->DrawSearchResult(screen.GtoP(symbols.m_searchResult));
+      drawer.DrawSearchResult(screen.GtoP(symbols.m_searchResult));
   }
 
-  cpuDrawer->EndFrame(image);
+  drawer.EndFrame(image);
 }
 
-void RenderPlace(Framework & framework, Place const & place, string const & filename)
+void RenderPlace(Framework & framework, software_renderer::CPUDrawer & drawer,
+                 Place const & place, string const & filename)
 {
   software_renderer::FrameImage frame;
   software_renderer::FrameSymbols sym;
@@ -162,24 +268,118 @@ void RenderPlace(Framework & framework, Place const & place, string const & file
   // It is almost UpperComfortScale but there is some magic involved.
   int constexpr kMagicBaseScale = 17;
 
-  DrawFrame(framework, mercator::FromLatLon(place.lat, place.lon),
+  DrawFrame(framework, drawer, mercator::FromLatLon(place.lat, place.lon),
             place.zoom - kMagicBaseScale, place.width, place.height, sym, frame);
 
   ofstream file(filename.c_str());
   file.write(reinterpret_cast<char const *>(frame.m_data.data()), frame.m_data.size());
   file.close();
 }
+void RenderTile(Framework & framework, software_renderer::CPUDrawer & drawer, Tile const & tile,
+                uint32_t pxSize, string const & filename)
+{
+  ScreenBase const screen(m2::RectI(0, 0, pxSize, pxSize), m2::AnyRectD(GetTileRect(tile)));
+  uint32_t const tileSize = static_cast<uint32_t>(df::CalculateTileSize(pxSize, pxSize));
+  int const drawScale = df::GetDrawTileScale(screen, tileSize, drawer.GetVisualScale());
+
+  software_renderer::FrameImage frame;
+  DrawFeatures(framework, drawer, screen, drawScale, pxSize, pxSize);
+  drawer.EndFrame(frame);
+
+  ofstream file(filename.c_str(), ios::binary);
+  file.write(reinterpret_cast<char const *>(frame.m_data.data()), frame.m_data.size());
+}
+
+// Calls |fn| for all the items from |count| on |threadsCount| threads, every thread has its own
+// renderer. The first exception stops all the threads and is rethrown.
+void RenderInParallel(size_t count, size_t threadsCount,
+                      function<void(software_renderer::CPUDrawer &, size_t)> const & fn)
+{
+  if (threadsCount == 0)
+    threadsCount = max(thread::hardware_concurrency(), 1U);
+  threadsCount = min(threadsCount, max(count, size_t(1)));
+
+  atomic<size_t> next(0);
+  mutex errorMutex;
+  exception_ptr error;
+  auto const render = [&]()
+  {
+    try
+    {
+      auto const drawer = CreateFrameRenderer(FLAGS_vs);
+      for (size_t i = next++; i < count; i = next++)
+        fn(*drawer, i);
+    }
+    catch (...)
+    {
+      lock_guard<mutex> lock(errorMutex);
+      if (!error)
+        error = current_exception();
+      // Stops the other threads.
+      next = count;
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t i = 1; i < threadsCount; ++i)
+    threads.emplace_back(render);
+  render();
+  for (auto & t : threads)
+    t.join();
+
+  if (error)
+    rethrow_exception(error);
+}
+
+void ExportTiles(Framework & framework)
+{
+  auto const tiles = GetTiles(ParseTilesRect(FLAGS_tiles_rect), FLAGS_min_zoom, FLAGS_max_zoom);
+
+  vector<string> filenames;
+  filenames.reserve(tiles.size());
+  for (auto const & tile : tiles)
+  {
+    auto const dir = base::JoinPath(FLAGS_outpath, strings::to_string(tile.zoom),
+                                    strings::to_string(tile.x));
+    if (!Platform::IsFileExistsByFullPath(dir) && !Platform::MkDirRecursively(dir))
+      MYTHROW(FileSystemException, ("Can't create directory", dir));
+    filenames.push_back(base::JoinPath(dir, strings::to_string(tile.y) + ".png"));
+  }
+
+  cout << "Exporting " << tiles.size() << " tiles." << endl;
+
+  vector<double> times(tiles.size());
+  base::Timer timer;
+  RenderInParallel(tiles.size(), FLAGS_threads,
+                   [&](software_renderer::CPUDrawer & drawer, size_t i) {
+                     base::Timer tileTimer;
+                     RenderTile(framework, drawer, tiles[i], static_cast<uint32_t>(FLAGS_tile_size),
+                                filenames[i]);
+                     times[i] = tileTimer.ElapsedSeconds();
+                   });
+  auto const elapsed = timer.ElapsedSeconds();
+
+  if (tiles.empty())
+    return;
+
+  auto const slowest = static_cast<size_t>(distance(times.begin(), max_element(times.begin(), times.end())));
+  cout << "Exported " << tiles.size() << " tiles in " << elapsed << " seconds, "
+       << tiles.size() / max(elapsed, 1e-6) << " tiles per second." << endl;
+  cout << "Tile rendering time: mean " << accumulate(times.begin(), times.end(), 0.0) / times.size()
+       << " seconds, max " << times[slowest] << " seconds (" << filenames[slowest] << ")." << endl;
+}
 }  // namespace
 
 int main(int argc, char * argv[])
 {
   google::SetUsageMessage(
-      "Generate screenshots of MAPS.ME maps in chosen places, specified by coordinates and zoom.");
+      "Generate screenshots of MAPS.ME maps in chosen places, specified by coordinates and zoom, "
+      "or export map tiles of a rect.");
   google::ParseCommandLineFlags(&argc, &argv, true);
 
-  if (!FLAGS_c && FLAGS_place.empty())
+  if (!FLAGS_c && FLAGS_place.empty() && FLAGS_tiles_rect.empty())
   {
-    cerr << "Either -c or -place must be set" << endl;
+    cerr << "Either -c, -place or -tiles_rect must be set" << endl;
     return 1;
   }
 
@@ -189,37 +389,51 @@ int main(int argc, char * argv[])
   if (!FLAGS_mwmpath.empty())
     GetPlatform().SetWritableDirForTests(FLAGS_mwmpath);
 
+  vector<string> places;
+  if (!FLAGS_place.empty())
+    places.push_back(FLAGS_place);
+
+  if (FLAGS_c)
+  {
+    for (string line; getline(cin, line);)
+      places.push_back(line);
+  }
+
   try
   {
     Framework f(FrameworkParams(false /* m_enableLocalAds */, false /* m_enableDiffs */));
 
-    auto processPlace = [&](string const & place)
-    {
-      Place p = ParsePlace(place);
-      p.width = FLAGS_width;
-      p.height = FLAGS_height;
-      string const & filename = FilenameSeq(FLAGS_outpath);
-      RenderPlace(f, p, filename);
-      cout << "Rendering " << place << " into " << filename << " is finished." << endl;
-    };
-
-    InitFrameRenderer(FLAGS_vs);
+    df::VisualParams::Init(FLAGS_vs, 1024 /* dummy tile size */);
 
-    if (!FLAGS_place.empty())
-      processPlace(FLAGS_place);
+    // File names are given in the order of the places.
+    vector<string> filenames;
+    filenames.reserve(places.size());
+    for (size_t i = 0; i < places.size(); ++i)
+      filenames.push_back(FilenameSeq(FLAGS_outpath));
 
-    if (FLAGS_c)
+    mutex outputMutex;
+    if (!places.empty())
     {
-      for (string line; getline(cin, line);)
-        processPlace(line);
+      RenderInParallel(places.size(), FLAGS_threads,
+                       [&](software_renderer::CPUDrawer & drawer, size_t i) {
+                         Place p = ParsePlace(places[i]);
+                         p.width = FLAGS_width;
+                         p.height = FLAGS_height;
+                         RenderPlace(f, drawer, p, filenames[i]);
+
+                         lock_guard<mutex> lock(outputMutex);
+                         cout << "Rendering " << places[i] << " into " << filenames[i]
+                              << " is finished." << endl;
+                       });
     }
 
-    ReleaseFrameRenderer();
+    if (!FLAGS_tiles_rect.empty())
+      ExportTiles(f);
+
     return 0;
   }
   catch (exception & e)
   {
-    ReleaseFrameRenderer();
     cerr << e.what() << endl;
   }
   return 1;
@@ -22,6 +22,7 @@ namespace
 // Three months.
 auto constexpr kMapObjectEventsExpirePeriod = std::chrono::hours(24 * 30 * 3);
 auto constexpr kEventCooldown = std::chrono::seconds(2);
+auto constexpr kSaveDelay = std::chrono::seconds(1);
 
 std::array<std::string, 7> const kMapEventSupportedTypes = {{"amenity-bar", "amenity-cafe",
                                                              "amenity-pub", "amenity-restaurant",
@@ -133,13 +134,21 @@ void Eye::TrimExpired()
   });
 }
 
-bool Eye::Save(InfoType const & info)
+void Eye::Save(InfoType const & info)
 {
-  if (!::Save(*info))
-    return false;
-
   m_info.Set(info);
-  return true;
+
+  // Events often come in series, so the info is written once for all the events which come
+  // during |kSaveDelay|.
+  if (m_isSaveScheduled.exchange(true))
+    return;
+
+  GetPlatform().RunDelayedTask(Platform::Thread::File, kSaveDelay, [this]
+  {
+    m_isSaveScheduled = false;
+    if (!::Save(*m_info.Get()))
+      LOG(LWARNING, ("Cannot save eye info."));
+  });
 }
 
 void Eye::TrimExpiredMapObjectEvents()
@@ -205,8 +214,7 @@ void Eye::RegisterTipClick(Tip::Type type, Tip::Event event)
     editableTips.push_back(tip);
   }
 
-  if (!Save(editableInfo))
-    return;
+  Save(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, tip]
   {
@@ -225,8 +233,7 @@ void Eye::UpdateBookingFilterUsedTime()
 
   editableInfo->m_booking.m_lastFilterUsedTime = now;
 
-  if (!Save(editableInfo))
-    return;
+  Save(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, now]
   {
@@ -245,8 +252,7 @@ void Eye::UpdateBoomarksCatalogShownTime()
 
   editableInfo->m_bookmarks.m_lastOpenedTime = now;
 
-  if (!Save(editableInfo))
-    return;
+  Save(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, now]
   {
@@ -265,8 +271,7 @@ void Eye::UpdateDiscoveryShownTime()
 
   editableInfo->m_discovery.m_lastOpenedTime = now;
 
-  if (!Save(editableInfo))
-    return;
+  Save(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, now]
   {
@@ -285,8 +290,7 @@ void Eye::IncrementDiscoveryItem(Discovery::Event event)
   editableInfo->m_discovery.m_lastClickedTime = Clock::now();
   editableInfo->m_discovery.m_eventCounters.Increment(event);
 
-  if (!Save(editableInfo))
-    return;
+  Save(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, event]
   {
@@ -324,8 +328,7 @@ void Eye::RegisterLayerShown(Layer::Type type)
     editableLayers.emplace_back(layer);
   }
 
-  if (!Save(editableInfo))
-    return;
+  Save(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, layer]
   {
@@ -398,8 +401,7 @@ void Eye::RegisterTransitionToBooking(m2::PointD const & hotelPos)
   auto editableInfo = std::make_shared<Info>(*info);
 
   editableInfo->m_promo.m_transitionToBookingTime = Clock::now();
-  if (!Save(editableInfo))
-    return;
+  Save(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, hotelPos]
   {
@@ -419,8 +421,7 @@ void Eye::RegisterPromoAfterBookingShown(std::string const & cityId)
   editableInfo->m_promo.m_lastTimeShownAfterBooking = now;
   editableInfo->m_promo.m_lastTimeShownAfterBookingCityId = cityId;
 
-  if (!Save(editableInfo))
-    return;
+  Save(editableInfo);
 
   GetPlatform().RunTask(Platform::Thread::Gui, [this, now, cityId]
   {
@@ -7,6 +7,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <vector>
@@ -70,7 +71,8 @@ public:
 private:
   Eye();
 
-  bool Save(InfoType const & info);
+  // Sets |info| and writes it to the file on the file thread a bit later.
+  void Save(InfoType const & info);
   void TrimExpiredMapObjectEvents();
 
   // Event processing:
@@ -86,6 +88,7 @@ private:
   void RegisterPromoAfterBookingShown(std::string const & cityId);
 
   base::AtomicSharedPtr<Info> m_info;
+  std::atomic<bool> m_isSaveScheduled{false};
   // |m_subscribers| must be used on main thread only.
   std::vector<Subscriber *> m_subscribers;
 
@@ -14,6 +14,7 @@
 #include "openlr/score_candidate_points_getter.hpp"
 #include "openlr/score_paths_connector.hpp"
 #include "openlr/score_types.hpp"
+#include "openlr/shared_caches.hpp"
 #include "openlr/way_point.hpp"
 
 #include "routing/features_road_graph.hpp"
@@ -23,6 +24,7 @@
 
 #include "storage/country_info_getter.hpp"
 
+#include "indexer/cell_id.hpp"
 #include "indexer/classificator.hpp"
 #include "indexer/data_source.hpp"
 
@@ -39,6 +41,7 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <functional>
@@ -219,9 +222,10 @@ void CopyWithoutOffsets(InputIterator start, InputIterator stop, OutputIterator
 class SegmentsDecoderV1
 {
 public:
-  SegmentsDecoderV1(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf)
+  SegmentsDecoderV1(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf,
+                    SharedCaches & caches)
     : m_roadGraph(dataSource, IRoadGraph::Mode::ObeyOnewayTag, move(cmf))
-    , m_infoGetter(dataSource)
+    , m_infoGetter(dataSource, &caches.m_roadInfos)
     , m_router(m_roadGraph, m_infoGetter)
   {
   }
@@ -288,8 +292,11 @@ private:
 class SegmentsDecoderV2
 {
 public:
-  SegmentsDecoderV2(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf)
-    : m_dataSource(dataSource), m_graph(dataSource, move(cmf)), m_infoGetter(dataSource)
+  SegmentsDecoderV2(DataSource const & dataSource, unique_ptr<CarModelFactory> cmf,
+                    SharedCaches & caches)
+    : m_dataSource(dataSource)
+    , m_graph(dataSource, move(cmf))
+    , m_infoGetter(dataSource, &caches.m_roadInfos)
   {
   }
 
@@ -377,8 +384,12 @@ private:
 class SegmentsDecoderV3
 {
 public:
-  SegmentsDecoderV3(DataSource const & dataSource, unique_ptr<CarModelFactory> carModelFactory)
-      : m_dataSource(dataSource), m_graph(dataSource, move(carModelFactory)), m_infoGetter(dataSource)
+  SegmentsDecoderV3(DataSource const & dataSource, unique_ptr<CarModelFactory> carModelFactory,
+                    SharedCaches & caches)
+    : m_dataSource(dataSource)
+    , m_graph(dataSource, move(carModelFactory))
+    , m_infoGetter(dataSource, &caches.m_roadInfos)
+    , m_junctionsCache(caches.m_junctions)
   {
   }
 
@@ -398,7 +409,7 @@ public:
     LOG(LINFO, ("Decoding segment:", segment.m_segmentId, "with", points.size(), "points"));
 
     ScoreCandidatePointsGetter pointsGetter(kMaxJunctionCandidates, kMaxProjectionCandidates,
-                                            m_dataSource, m_graph);
+                                            m_dataSource, m_graph, &m_junctionsCache);
     ScoreCandidatePathsGetter pathsGetter(pointsGetter, m_graph, m_infoGetter, stat);
 
     if (!pathsGetter.GetLineCandidatesForPoints(points, segment.m_source, lineCandidates))
@@ -464,6 +475,7 @@ private:
   DataSource const & m_dataSource;
   Graph m_graph;
   RoadInfoGetter m_infoGetter;
+  SharedJunctionsCache & m_junctionsCache;
 };
 
 size_t constexpr GetOptimalBatchSize()
@@ -475,6 +487,34 @@ size_t constexpr GetOptimalBatchSize()
       base::LCM(sizeof(IRoadGraph::EdgeVector), kCacheLineSize) / sizeof(IRoadGraph::EdgeVector);
   return base::LCM(a, b);
 }
+
+// Returns the indices of |segments| ordered by the quadtree cells of their first points, so
+// the segments which are close to each other go one after another.
+vector<size_t> GetSpatialOrder(vector<LinearSegment> const & segments)
+{
+  using Converter = CellIdConverter<mercator::Bounds, RectId>;
+
+  vector<pair<int64_t, size_t>> cells;
+  cells.reserve(segments.size());
+  for (size_t i = 0; i < segments.size(); ++i)
+  {
+    auto const & points = segments[i].GetLRPs();
+    int64_t cell = 0;
+    if (!points.empty())
+    {
+      auto const point = mercator::FromLatLon(points.front().m_latLon);
+      cell = Converter::ToCellId(point.x, point.y).ToInt64(RectId::DEPTH_LEVELS);
+    }
+    cells.emplace_back(cell, i);
+  }
+  sort(cells.begin(), cells.end());
+
+  vector<size_t> order;
+  order.reserve(cells.size());
+  for (auto const & cell : cells)
+    order.push_back(cell.second);
+  return order;
+}
 }  // namespace
 
 // OpenLRDecoder::SegmentsFilter -------------------------------------------------------------
@@ -531,27 +571,38 @@ template <typename Decoder, typename Stats>
 void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
                            uint32_t const numThreads, vector<DecodedPath> & paths)
 {
-  auto const worker = [&segments, &paths, numThreads, this](size_t threadNum, DataSource const & dataSource,
-                                                            Stats & stat) {
+  // Batches of close segments are taken by the threads in turn. The threads share the caches of
+  // road infos and candidates, so the data source is read once for the same features and points.
+  vector<size_t> const order = GetSpatialOrder(segments);
+  atomic<size_t> nextBatch(0);
+  SharedCaches caches;
+
+  auto const worker = [&segments, &paths, &order, &nextBatch, &caches, this](
+                          size_t threadNum, DataSource const & dataSource, Stats & stat) {
     size_t constexpr kBatchSize = GetOptimalBatchSize();
     size_t constexpr kProgressFrequency = 100;
 
     size_t const numSegments = segments.size();
 
-    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter));
+    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter), caches);
     base::Timer timer;
-    for (size_t i = threadNum * kBatchSize; i < numSegments; i += numThreads * kBatchSize)
+    size_t handledSinceReport = 0;
+    for (size_t i = nextBatch++ * kBatchSize; i < numSegments; i = nextBatch++ * kBatchSize)
     {
       for (size_t j = i; j < numSegments && j < i + kBatchSize; ++j)
       {
-        if (!decoder.DecodeSegment(segments[j], paths[j], stat))
+        size_t const segmentIdx = order[j];
+        if (!decoder.DecodeSegment(segments[segmentIdx], paths[segmentIdx], stat))
           ++stat.m_routesFailed;
         ++stat.m_routesHandled;
+        ++handledSinceReport;
 
-        if (stat.m_routesHandled % kProgressFrequency == 0 || i == segments.size() - 1)
+        if (stat.m_routesHandled % kProgressFrequency == 0 || j == segments.size() - 1)
         {
           LOG(LINFO, ("Thread", threadNum, "processed", stat.m_routesHandled,
-                      "failed:", stat.m_routesFailed));
+                      "failed:", stat.m_routesFailed,
+                      "segments per second:", handledSinceReport / timer.ElapsedSeconds()));
+          handledSinceReport = 0;
           timer.Reset();
         }
       }
@@ -573,6 +624,9 @@ void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
     allStats.Add(s);
 
   allStats.Report();
-  LOG(LINFO, ("Matching tool:", timer.ElapsedSeconds(), "seconds."));
+  caches.Report();
+  double const seconds = timer.ElapsedSeconds();
+  LOG(LINFO, ("Matching tool:", seconds, "seconds,", segments.size() / seconds,
+              "segments per second."));
 }
 }  // namespace openlr
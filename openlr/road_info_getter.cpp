@@ -1,5 +1,7 @@
 #include "openlr/road_info_getter.hpp"
 
+#include "openlr/shared_caches.hpp"
+
 #include "indexer/classificator.hpp"
 #include "indexer/feature.hpp"
 #include "indexer/data_source.hpp"
@@ -19,7 +21,12 @@ RoadInfoGetter::RoadInfo::RoadInfo(FeatureType & ft)
 
 // RoadInfoGetter ----------------------------------------------------------------------------------
 RoadInfoGetter::RoadInfoGetter(DataSource const & dataSource)
-  : m_dataSource(dataSource)
+  : RoadInfoGetter(dataSource, nullptr /* sharedCache */)
+{
+}
+
+RoadInfoGetter::RoadInfoGetter(DataSource const & dataSource, SharedRoadInfoCache * sharedCache)
+  : m_dataSource(dataSource), m_sharedCache(sharedCache)
 {
 }
 
@@ -29,12 +36,20 @@ RoadInfoGetter::RoadInfo RoadInfoGetter::Get(FeatureID const & fid)
   if (it != end(m_cache))
     return it->second;
 
+  if (m_sharedCache)
+  {
+    if (auto const info = m_sharedCache->Find(fid))
+      return m_cache.emplace(fid, *info).first->second;
+  }
+
   FeaturesLoaderGuard g(m_dataSource, fid.m_mwmId);
   auto ft = g.GetOriginalFeatureByIndex(fid.m_index);
   CHECK(ft, ());
 
   RoadInfo info(*ft);
   it = m_cache.emplace(fid, info).first;
+  if (m_sharedCache)
+    m_sharedCache->Add(fid, info);
 
   return it->second;
 }
@@ -17,6 +17,8 @@ class TypesHolder;
 
 namespace openlr
 {
+class SharedRoadInfoCache;
+
 class RoadInfoGetter final
 {
 public:
@@ -31,12 +33,15 @@ public:
   };
 
   explicit RoadInfoGetter(DataSource const & dataSource);
+  // |sharedCache| may be nullptr, otherwise it must outlive the getter.
+  RoadInfoGetter(DataSource const & dataSource, SharedRoadInfoCache * sharedCache);
 
   RoadInfo Get(FeatureID const & fid);
 
  private:
 
   DataSource const & m_dataSource;
+  SharedRoadInfoCache * m_sharedCache = nullptr;
   std::map<FeatureID, RoadInfo> m_cache;
 };
 }  // namespace openlr
@@ -1,6 +1,7 @@
 #include "openlr/score_candidate_points_getter.hpp"
 
 #include "openlr/helpers.hpp"
+#include "openlr/shared_caches.hpp"
 
 #include "routing/road_graph.hpp"
 #include "routing/routing_helpers.hpp"
@@ -36,6 +37,33 @@ void ScoreCandidatePointsGetter::GetJunctionPointCandidates(m2::PointD const & p
                                                             ScoreEdgeVec & edgeCandidates)
 {
   ScorePointVec pointCandidates;
+  GetJunctionPoints(p, pointCandidates);
+
+  for (auto const & pc : pointCandidates)
+  {
+    Graph::EdgeVector edges;
+    if (!isLastPoint)
+      m_graph.GetOutgoingEdges(geometry::PointWithAltitude(pc.m_point, 0 /* altitude */), edges);
+    else
+      m_graph.GetIngoingEdges(geometry::PointWithAltitude(pc.m_point, 0 /* altitude */), edges);
+
+    for (auto const & e : edges)
+      edgeCandidates.emplace_back(pc.m_score, e);
+  }
+}
+
+void ScoreCandidatePointsGetter::GetJunctionPoints(m2::PointD const & p,
+                                                   ScorePointVec & pointCandidates)
+{
+  if (m_junctionsCache)
+  {
+    if (auto cached = m_junctionsCache->Find(p))
+    {
+      pointCandidates = std::move(*cached);
+      return;
+    }
+  }
+
   auto const selectCandidates = [&p, &pointCandidates, this](FeatureType & ft) {
     ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
     if (ft.GetGeomType() != feature::GeomType::Line || !routing::IsRoad(feature::TypesHolder(ft)))
@@ -57,17 +85,8 @@ void ScoreCandidatePointsGetter::GetJunctionPointCandidates(m2::PointD const & p
 
   pointCandidates.resize(std::min(m_maxJunctionCandidates, pointCandidates.size()));
 
-  for (auto const & pc : pointCandidates)
-  {
-    Graph::EdgeVector edges;
-    if (!isLastPoint)
-      m_graph.GetOutgoingEdges(geometry::PointWithAltitude(pc.m_point, 0 /* altitude */), edges);
-    else
-      m_graph.GetIngoingEdges(geometry::PointWithAltitude(pc.m_point, 0 /* altitude */), edges);
-
-    for (auto const & e : edges)
-      edgeCandidates.emplace_back(pc.m_score, e);
-  }
+  if (m_junctionsCache)
+    m_junctionsCache->Add(p, pointCandidates);
 }
 
 void ScoreCandidatePointsGetter::EnrichWithProjectionPoints(m2::PointD const & p,
@@ -14,15 +14,28 @@
 
 namespace openlr
 {
+class SharedJunctionsCache;
+
 class ScoreCandidatePointsGetter
 {
 public:
   ScoreCandidatePointsGetter(size_t maxJunctionCandidates, size_t maxProjectionCandidates,
                              DataSource const & dataSource, Graph & graph)
+    : ScoreCandidatePointsGetter(maxJunctionCandidates, maxProjectionCandidates, dataSource, graph,
+                                 nullptr /* junctionsCache */)
+  {
+  }
+
+  // |junctionsCache| may be nullptr, otherwise it must outlive the getter and be used with the
+  // same |maxJunctionCandidates| only.
+  ScoreCandidatePointsGetter(size_t maxJunctionCandidates, size_t maxProjectionCandidates,
+                             DataSource const & dataSource, Graph & graph,
+                             SharedJunctionsCache * junctionsCache)
     : m_maxJunctionCandidates(maxJunctionCandidates)
     , m_maxProjectionCandidates(maxProjectionCandidates)
     , m_dataSource(dataSource)
     , m_graph(graph)
+    , m_junctionsCache(junctionsCache)
   {
   }
 
@@ -35,6 +48,7 @@ public:
 private:
   void GetJunctionPointCandidates(m2::PointD const & p, bool isLastPoint,
                                   ScoreEdgeVec & edgeCandidates);
+  void GetJunctionPoints(m2::PointD const & p, ScorePointVec & pointCandidates);
   void EnrichWithProjectionPoints(m2::PointD const & p, ScoreEdgeVec & edgeCandidates);
 
   /// \returns true if |p| is a junction and false otherwise.
@@ -46,5 +60,6 @@ private:
 
   DataSource const & m_dataSource;
   Graph & m_graph;
+  SharedJunctionsCache * m_junctionsCache = nullptr;
 };
 }  // namespace openlr
@@ -0,0 +1,80 @@
+#include "openlr/shared_caches.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+
+using namespace std;
+
+namespace
+{
+double GetHitsRatio(uint64_t hits, uint64_t misses)
+{
+  return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+}
+}  // namespace
+
+namespace openlr
+{
+// SharedRoadInfoCache -----------------------------------------------------------------------------
+optional<RoadInfoGetter::RoadInfo> SharedRoadInfoCache::Find(FeatureID const & fid) const
+{
+  auto const key = MakeKey(fid);
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_infos.find(key);
+  if (it == m_infos.cend())
+  {
+    ++m_misses;
+    return {};
+  }
+
+  ++m_hits;
+  return it->second;
+}
+
+void SharedRoadInfoCache::Add(FeatureID const & fid, RoadInfoGetter::RoadInfo const & info)
+{
+  auto key = MakeKey(fid);
+  lock_guard<mutex> lock(m_mutex);
+  m_infos.emplace(move(key), info);
+}
+
+// static
+SharedRoadInfoCache::Key SharedRoadInfoCache::MakeKey(FeatureID const & fid)
+{
+  auto const & info = fid.m_mwmId.GetInfo();
+  CHECK(info, (fid));
+  return {info->GetCountryName(), fid.m_index};
+}
+
+// SharedJunctionsCache ----------------------------------------------------------------------------
+optional<ScorePointVec> SharedJunctionsCache::Find(m2::PointD const & point) const
+{
+  lock_guard<mutex> lock(m_mutex);
+  auto const it = m_candidates.find(point);
+  if (it == m_candidates.cend())
+  {
+    ++m_misses;
+    return {};
+  }
+
+  ++m_hits;
+  return it->second;
+}
+
+void SharedJunctionsCache::Add(m2::PointD const & point, ScorePointVec const & candidates)
+{
+  lock_guard<mutex> lock(m_mutex);
+  m_candidates.emplace(point, candidates);
+}
+
+// SharedCaches ------------------------------------------------------------------------------------
+void SharedCaches::Report() const
+{
+  LOG(LINFO, ("Road infos cache hits ratio:",
+              GetHitsRatio(m_roadInfos.GetHitsCount(), m_roadInfos.GetMissesCount())));
+  LOG(LINFO, ("Junctions cache hits ratio:",
+              GetHitsRatio(m_junctions.GetHitsCount(), m_junctions.GetMissesCount())));
+}
+}  // namespace openlr
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "openlr/road_info_getter.hpp"
+#include "openlr/score_types.hpp"
+
+#include "indexer/feature_decl.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace openlr
+{
+// Caches which are shared by the decoding threads. Every thread has its own data source, so
+// features are identified by the names of their mwms instead of FeatureIDs. The mwms don't
+// change during decoding, so the cached values are the same for all the threads.
+class SharedRoadInfoCache
+{
+public:
+  std::optional<RoadInfoGetter::RoadInfo> Find(FeatureID const & fid) const;
+  void Add(FeatureID const & fid, RoadInfoGetter::RoadInfo const & info);
+
+  uint64_t GetHitsCount() const { return m_hits; }
+  uint64_t GetMissesCount() const { return m_misses; }
+
+private:
+  using Key = std::pair<std::string, uint32_t>;
+
+  static Key MakeKey(FeatureID const & fid);
+
+  mutable std::mutex m_mutex;
+  std::map<Key, RoadInfoGetter::RoadInfo> m_infos;
+  mutable std::atomic<uint64_t> m_hits = 0;
+  mutable std::atomic<uint64_t> m_misses = 0;
+};
+
+// Junction candidates of points. Consecutive segments of a traffic feed mostly share their end
+// points, so the candidates of a point are looked up in the data source once.
+class SharedJunctionsCache
+{
+public:
+  std::optional<ScorePointVec> Find(m2::PointD const & point) const;
+  void Add(m2::PointD const & point, ScorePointVec const & candidates);
+
+  uint64_t GetHitsCount() const { return m_hits; }
+  uint64_t GetMissesCount() const { return m_misses; }
+
+private:
+  mutable std::mutex m_mutex;
+  std::map<m2::PointD, ScorePointVec> m_candidates;
+  mutable std::atomic<uint64_t> m_hits = 0;
+  mutable std::atomic<uint64_t> m_misses = 0;
+};
+
+struct SharedCaches
+{
+  void Report() const;
+
+  SharedRoadInfoCache m_roadInfos;
+  SharedJunctionsCache m_junctions;
+};
+}  // namespace openlr
@@ -10,6 +10,8 @@
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace downloader
@@ -38,8 +40,65 @@ ChunksDownloadStrategy::GetChunk(RangeT const & range)
   }
 }
 
+void ChunksDownloadStrategy::ResetChunkSizes(int64_t chunkSize)
+{
+  m_minChunkSize = chunkSize;
+  for (auto & server : m_servers)
+    server.m_chunkSize = chunkSize;
+}
+
+void ChunksDownloadStrategy::UpdateServerStats(ServerT & server, int64_t bytes, double seconds)
+{
+  double const speed = bytes / max(seconds, 1e-3);
+  if (server.m_chunksDownloaded == 0)
+    server.m_speed = speed;
+  else
+    server.m_speed = 0.7 * server.m_speed + 0.3 * speed;
+  ++server.m_chunksDownloaded;
+
+  if (m_minChunkSize == 0)
+    return;
+
+  // Grow chunks while they are downloaded quickly and shrink them when they take too long.
+  if (seconds < kTargetChunkSeconds / 2 && bytes >= server.m_chunkSize)
+    server.m_chunkSize = min(2 * server.m_chunkSize, max(kMaxChunkSize, m_minChunkSize));
+  else if (seconds > kTargetChunkSeconds * 2)
+    server.m_chunkSize = max(server.m_chunkSize / 2, m_minChunkSize);
+}
+
+bool ChunksDownloadStrategy::IsSlowServer(ServerT const & server) const
+{
+  if (m_minChunkSize == 0 || server.m_chunksDownloaded < kMinChunksForSpeed)
+    return false;
+
+  double bestSpeed = 0.0;
+  for (auto const & s : m_servers)
+  {
+    if (s.m_chunksDownloaded >= kMinChunksForSpeed)
+      bestSpeed = max(bestSpeed, s.m_speed);
+  }
+  return server.m_speed < bestSpeed * kSlowServerRatio;
+}
+
+void ChunksDownloadStrategy::FitChunk(size_t index, int64_t size)
+{
+  ASSERT_LESS(index + 1, m_chunks.size(), ());
+
+  // Merge with the following free chunks while the size allows.
+  while (index + 2 < m_chunks.size() && m_chunks[index + 1].m_status == CHUNK_FREE &&
+         m_chunks[index + 2].m_pos - m_chunks[index].m_pos <= size)
+  {
+    m_chunks.erase(m_chunks.begin() + index + 1);
+  }
+
+  // Split a chunk which was merged for a faster server before.
+  if (m_chunks[index + 1].m_pos - m_chunks[index].m_pos > 2 * size)
+    m_chunks.insert(m_chunks.begin() + index + 1, ChunkT(m_chunks[index].m_pos + size, CHUNK_FREE));
+}
+
 void ChunksDownloadStrategy::InitChunks(int64_t fileSize, int64_t chunkSize, ChunkStatusT status)
 {
+  ResetChunkSizes(chunkSize);
   m_chunks.reserve(static_cast<size_t>(fileSize / chunkSize + 2));
   for (int64_t i = 0; i < fileSize; i += chunkSize)
     m_chunks.push_back(ChunkT(i, status));
@@ -91,6 +150,8 @@ int64_t ChunksDownloadStrategy::LoadOrInitChunks(string const & fName, int64_t f
   ASSERT ( fileSize > 0, () );
   ASSERT ( chunkSize > 0, () );
 
+  ResetChunkSizes(chunkSize);
+
   if (Platform::IsFileExistsByFullPath(fName))
   {
     try
@@ -134,6 +195,20 @@ int64_t ChunksDownloadStrategy::LoadOrInitChunks(string const & fName, int64_t f
 }
 
 string ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range)
+{
+  double seconds = 0.0;
+  for (auto const & server : m_servers)
+  {
+    if (server.m_chunkPos == range.first)
+    {
+      seconds = chrono::duration<double>(ClockT::now() - server.m_chunkStart).count();
+      break;
+    }
+  }
+  return ChunkFinished(success, range, seconds);
+}
+
+string ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range, double seconds)
 {
   pair<ChunkT *, int> res = GetChunk(range);
   string url;
@@ -142,19 +217,28 @@ string ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range)
   {
     for (size_t s = 0; s < m_servers.size(); ++s)
     {
-      if (m_servers[s].m_chunkIndex == res.second)
+      if (m_servers[s].m_chunkPos == res.first->m_pos)
       {
         url = m_servers[s].m_url;
         if (success)
         {
           // mark server as free and chunk as ready
-          m_servers[s].m_chunkIndex = SERVER_READY;
           res.first->m_status = CHUNK_COMPLETE;
+          UpdateServerStats(m_servers[s], range.second - range.first + 1, seconds);
+          if (IsSlowServer(m_servers[s]))
+          {
+            LOG(LINFO, ("Server", url, "is too slow:", m_servers[s].m_speed, "bytes/s, dropping it"));
+            m_servers.erase(m_servers.begin() + s);
+          }
+          else
+          {
+            m_servers[s].m_chunkPos = SERVER_READY;
+          }
         }
         else
         {
           LOG(LINFO, ("Thread for url", m_servers[s].m_url,
-                      "failed to download chunk number", m_servers[s].m_chunkIndex));
+                      "failed to download chunk at", m_servers[s].m_chunkPos));
           // remove failed server and mark chunk as free
           m_servers.erase(m_servers.begin() + s);
           res.first->m_status = CHUNK_FREE;
@@ -166,6 +250,16 @@ string ChunksDownloadStrategy::ChunkFinished(bool success, RangeT const & range)
   return url;
 }
 
+int64_t ChunksDownloadStrategy::GetDownloadedPrefixSize() const
+{
+  for (auto const & chunk : m_chunks)
+  {
+    if (chunk.m_status != CHUNK_COMPLETE)
+      return chunk.m_pos;
+  }
+  return 0;
+}
+
 ChunksDownloadStrategy::ResultT
 ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
 {
@@ -173,14 +267,14 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
   if (m_servers.empty())
     return EDownloadFailed;
 
-  // Find first free server.
+  // Find the fastest free server.
   ServerT * server = 0;
   for (size_t i = 0; i < m_servers.size(); ++i)
   {
-    if (m_servers[i].m_chunkIndex == SERVER_READY)
+    if (m_servers[i].m_chunkPos == SERVER_READY &&
+        (server == 0 || m_servers[i].m_speed > server->m_speed))
     {
       server = &m_servers[i];
-      break;
     }
   }
   if (server == 0)
@@ -194,7 +288,11 @@ ChunksDownloadStrategy::NextChunk(string & outUrl, RangeT & range)
     switch (m_chunks[i].m_status)
     {
     case CHUNK_FREE:
-      server->m_chunkIndex = static_cast<int>(i);
+      if (m_minChunkSize != 0)
+        FitChunk(i, server->m_chunkSize);
+
+      server->m_chunkPos = m_chunks[i].m_pos;
+      server->m_chunkStart = ClockT::now();
       outUrl = server->m_url;
 
       range.first = m_chunks[i].m_pos;
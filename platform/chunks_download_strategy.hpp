@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <utility>
@@ -39,23 +40,52 @@ private:
 
   using RangeT = std::pair<int64_t, int64_t>;
 
-  static const int SERVER_READY = -1;
+  using ClockT = std::chrono::steady_clock;
+
+  static const int64_t SERVER_READY = -1;
   struct ServerT
   {
     std::string m_url;
-    int m_chunkIndex;
+    /// Position of the chunk being downloaded or SERVER_READY.
+    int64_t m_chunkPos;
+    ClockT::time_point m_chunkStart;
+
+    /// Size of the next chunk for this server, adapted to the measured speed.
+    int64_t m_chunkSize = 0;
+    /// Averaged download speed in bytes per second.
+    double m_speed = 0.0;
+    size_t m_chunksDownloaded = 0;
 
-    ServerT(std::string const & url, int ind) : m_url(url), m_chunkIndex(ind) {}
+    ServerT(std::string const & url, int64_t pos) : m_url(url), m_chunkPos(pos) {}
   };
 
   std::vector<ChunkT> m_chunks;
 
   std::vector<ServerT> m_servers;
 
+  /// Size of the chunks the file was split to, the lower bound for the adaptive chunk size.
+  /// Zero disables adaptation.
+  int64_t m_minChunkSize = 0;
+
   /// @return Chunk pointer and it's index for given file offsets range.
   std::pair<ChunkT *, int> GetChunk(RangeT const & range);
 
+  void ResetChunkSizes(int64_t chunkSize);
+  void UpdateServerStats(ServerT & server, int64_t bytes, double seconds);
+  bool IsSlowServer(ServerT const & server) const;
+  /// Merges free chunks following |index| or splits chunk |index| to fit |size|.
+  void FitChunk(size_t index, int64_t size);
+
 public:
+  /// Chunk sizes are adapted to make downloading of one chunk take about this time.
+  /// Longer chunks amortize request latency better, shorter ones spread work between servers.
+  static double constexpr kTargetChunkSeconds = 4.0;
+  static int64_t constexpr kMaxChunkSize = 32 * 1024 * 1024;
+  /// Server is dropped when its speed is less than this part of the fastest server speed.
+  static double constexpr kSlowServerRatio = 0.2;
+  /// Servers speeds are compared only after this number of chunks downloaded by each of them.
+  static size_t constexpr kMinChunksForSpeed = 3;
+
   ChunksDownloadStrategy(std::vector<std::string> const & urls);
 
   /// Init chunks vector for fileSize.
@@ -71,9 +101,14 @@ public:
   /// Should be called for every completed chunk (no matter successful or not).
   /// @returns url of the chunk
   std::string ChunkFinished(bool success, RangeT const & range);
+  /// The same as above with the chunk download time given explicitly.
+  std::string ChunkFinished(bool success, RangeT const & range, double seconds);
 
   size_t ActiveServersCount() const { return m_servers.size(); }
 
+  /// @return Size of the downloaded part at the beginning of the file.
+  int64_t GetDownloadedPrefixSize() const;
+
   enum ResultT
   {
     ENextChunk,
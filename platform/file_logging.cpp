@@ -4,9 +4,13 @@
 
 #include "coding/file_writer.hpp"
 
+#include "base/thread.hpp"
+
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <string>
 
 using namespace std;
 
@@ -20,41 +24,144 @@ namespace
     assert(localTime);
     return localTime;
   }
-}
 
-void LogMessageFile(base::LogLevel level, base::SrcPoint const & srcPoint, string const & msg)
+// Writes the log lines to the file on the background thread, so the threads which log
+// only append the lines to the pending buffer. When the writer does not keep up, the lines
+// above |kMaxPendingSize| are dropped and the number of the dropped lines is logged instead.
+class FileLogWriter
 {
-  static mutex mtx;
-  static unique_ptr<FileWriter> file;
+public:
+  static FileLogWriter & Instance()
+  {
+    static FileLogWriter writer;
+    return writer;
+  }
 
-  string recordType;
-  switch (level)
+  ~FileLogWriter()
   {
-  case LINFO: recordType.assign("INFO "); break;
-  case LDEBUG: recordType.assign("DEBUG "); break;
-  case LWARNING: recordType.assign("WARN "); break;
-  case LERROR: recordType.assign("ERROR "); break;
-  case LCRITICAL: recordType.assign("FATAL "); break;
-  case NUM_LOG_LEVELS: CHECK(false, ()); break;
+    {
+      lock_guard<mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
   }
 
-  lock_guard<mutex> lock(mtx);
+  // Writes |line| and all the pending lines on the calling thread if |flush| is true.
+  void Push(string && line, bool flush)
+  {
+    {
+      lock_guard<mutex> lock(m_mutex);
+      if (m_pending.size() + line.size() > kMaxPendingSize)
+      {
+        ++m_droppedCount;
+      }
+      else
+      {
+        AppendDroppedCount();
+        m_pending.append(line);
+      }
+    }
+
+    if (flush)
+      WritePending();
+    else
+      m_cv.notify_one();
+  }
 
-  if (file == nullptr)
+private:
+  static size_t constexpr kMaxPendingSize = 1 << 20;
+
+  FileLogWriter() : m_thread(&FileLogWriter::Run, this) {}
+
+  void Run()
   {
-    if (GetPlatform().WritableDir().empty())
+    while (true)
+    {
+      {
+        unique_lock<mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+        if (m_stop && m_pending.empty())
+          return;
+      }
+      WritePending();
+    }
+  }
+
+  void WritePending()
+  {
+    // |m_fileMutex| is held while the lines are taken, so the batches are written in order.
+    lock_guard<mutex> fileLock(m_fileMutex);
+    string lines;
+    {
+      lock_guard<mutex> lock(m_mutex);
+      AppendDroppedCount();
+      lines.swap(m_pending);
+    }
+
+    if (lines.empty() || !OpenFile())
+      return;
+
+    m_file->Write(lines.data(), lines.size());
+    m_file->Flush();
+  }
+
+  // Must be called under |m_mutex|.
+  void AppendDroppedCount()
+  {
+    if (m_droppedCount == 0)
       return;
+
+    m_pending.append("WARN " + to_string(m_droppedCount) + " log lines were dropped\n");
+    m_droppedCount = 0;
+  }
+
+  // Must be called under |m_fileMutex|.
+  bool OpenFile()
+  {
+    if (m_file)
+      return true;
+
+    if (GetPlatform().WritableDir().empty())
+      return false;
+
     tm * curTimeTM = GetLocalTime();
     stringstream fileName;
     fileName << "logging_" << curTimeTM->tm_year + 1900 << "_" << curTimeTM->tm_mon + 1 << "_" << curTimeTM->tm_mday << "_"
       << curTimeTM->tm_hour << "_" << curTimeTM->tm_min << "_" << curTimeTM->tm_sec << ".log";
-    file.reset(new FileWriter(GetPlatform().WritablePathForFile(fileName.str())));
+    m_file = make_unique<FileWriter>(GetPlatform().WritablePathForFile(fileName.str()));
+    return true;
   }
 
-  string srcString = recordType + DebugPrint(srcPoint) + " " + msg + "\n";
+  mutex m_mutex;
+  condition_variable m_cv;
+  string m_pending;
+  size_t m_droppedCount = 0;
+  bool m_stop = false;
+
+  mutex m_fileMutex;
+  unique_ptr<FileWriter> m_file;
+
+  threads::SimpleThread m_thread;
+};
+}  // namespace
+
+void LogMessageFile(base::LogLevel level, base::SrcPoint const & srcPoint, string const & msg)
+{
+  string recordType;
+  switch (level)
+  {
+  case LINFO: recordType.assign("INFO "); break;
+  case LDEBUG: recordType.assign("DEBUG "); break;
+  case LWARNING: recordType.assign("WARN "); break;
+  case LERROR: recordType.assign("ERROR "); break;
+  case LCRITICAL: recordType.assign("FATAL "); break;
+  case NUM_LOG_LEVELS: CHECK(false, ()); break;
+  }
 
-  file->Write(srcString.c_str(), srcString.size());
-  file->Flush();
+  // Errors are written right away because the application may be terminated after them.
+  FileLogWriter::Instance().Push(recordType + DebugPrint(srcPoint) + " " + msg + "\n",
+                                 level >= LERROR /* flush */);
 }
 
 void LogMemoryInfo()
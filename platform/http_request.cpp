@@ -9,11 +9,14 @@
 #endif
 
 #include "coding/internal/file_data.hpp"
+#include "coding/file_reader.hpp"
 #include "coding/file_writer.hpp"
+#include "coding/sha1.hpp"
 
 #include "base/logging.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
 #include <list>
 #include <memory>
 
@@ -142,6 +145,11 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
   size_t m_goodChunksCount;
   bool m_doCleanProgressFiles;
 
+  // Hash of the downloaded prefix of the file. The bytes following the prefix are hashed
+  // as they arrive, the rest is read back from the file when the preceding chunks complete.
+  coding::SHA1::Streaming m_sha1;
+  bool m_isSha1Valid = true;
+
   ChunksDownloadStrategy::ResultT StartThreads()
   {
     string url;
@@ -192,6 +200,8 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     {
       m_writer->Seek(offset);
       m_writer->Write(buffer, size);
+      if (m_isSha1Valid && static_cast<uint64_t>(offset) == m_sha1.GetSize())
+        m_sha1.Update(buffer, size);
       return true;
     }
     catch (Writer::Exception const & e)
@@ -201,6 +211,34 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     }
   }
 
+  void UpdateSha1()
+  {
+    uint32_t constexpr kBufferSize = 1 << 20;
+
+    auto const prefixSize = static_cast<uint64_t>(m_strategy.GetDownloadedPrefixSize());
+    if (!m_isSha1Valid || m_sha1.GetSize() >= prefixSize)
+      return;
+
+    try
+    {
+      m_writer->Flush();
+      FileReader reader(m_filePath + DOWNLOADING_FILE_EXTENSION);
+      vector<uint8_t> buffer(kBufferSize);
+      while (m_sha1.GetSize() < prefixSize)
+      {
+        auto const size =
+            static_cast<size_t>(min<uint64_t>(prefixSize - m_sha1.GetSize(), kBufferSize));
+        reader.Read(m_sha1.GetSize(), buffer.data(), size);
+        m_sha1.Update(buffer.data(), size);
+      }
+    }
+    catch (RootException const & e)
+    {
+      LOG(LWARNING, ("Can't hash downloaded data", e.Msg()));
+      m_isSha1Valid = false;
+    }
+  }
+
   void SaveResumeChunks()
   {
     try
@@ -233,12 +271,17 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     // report progress
     if (isChunkOk)
     {
+      UpdateSha1();
       m_progress.m_bytesDownloaded += (endRange - begRange) + 1;
       if (m_onProgress)
         m_onProgress(*this);
     }
     else
     {
+      // Bytes of the failed chunk could be hashed already and will be downloaded again.
+      if (m_sha1.GetSize() > static_cast<uint64_t>(begRange))
+        m_isSha1Valid = false;
+
       auto const message = non_http_error_code::DebugPrint(httpOrErrorCode);
       LOG(LWARNING, (m_filePath, "HttpRequest error:", message));
       alohalytics::LogEvent("$httpRequestError",
@@ -253,6 +296,12 @@ class FileHttpRequest : public HttpRequest, public IHttpThreadCallback
     else if (result == ChunksDownloadStrategy::EDownloadSucceeded)
       m_status = DownloadStatus::Completed;
 
+    if (m_status == DownloadStatus::Completed && m_isSha1Valid &&
+        m_sha1.GetSize() == static_cast<uint64_t>(m_progress.m_bytesTotal))
+    {
+      m_sha1Base64 = coding::SHA1::ToBase64(m_sha1.GetHash());
+    }
+
     if (isChunkOk)
     {
       // save information for download resume
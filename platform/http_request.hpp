@@ -31,6 +31,7 @@ protected:
   Progress m_progress;
   Callback m_onFinish;
   Callback m_onProgress;
+  std::string m_sha1Base64;
 
   HttpRequest(Callback const & onFinish, Callback const & onProgress);
 
@@ -41,6 +42,9 @@ public:
   Progress const & GetProgress() const { return m_progress; }
   /// Either file path (for chunks) or downloaded data
   virtual std::string const & GetData() const = 0;
+  /// SHA1 of the downloaded file in base64, calculated while the file was being downloaded.
+  /// Empty for not file requests and when the hash couldn't be calculated on the fly.
+  std::string const & GetSha1Base64() const { return m_sha1Base64; }
 
   /// Response saved to memory buffer and retrieved with Data()
   static HttpRequest * Get(std::string const & url,
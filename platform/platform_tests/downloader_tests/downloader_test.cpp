@@ -336,6 +336,67 @@ UNIT_TEST(ChunksDownloadStrategyFAIL)
   TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::EDownloadFailed, ());
 }
 
+UNIT_TEST(ChunksDownloadStrategyAdaptive)
+{
+  string const S1 = "UrlOfFastServer";
+  string const S2 = "UrlOfSlowServer";
+
+  typedef pair<int64_t, int64_t> RangeT;
+
+  vector<string> servers;
+  servers.push_back(S1);
+  servers.push_back(S2);
+
+  int64_t const FILE_SIZE = 10000;
+  int64_t const CHUNK_SIZE = 100;
+  ChunksDownloadStrategy strategy(servers);
+  strategy.InitChunks(FILE_SIZE, CHUNK_SIZE);
+
+  double const FAST = 0.1;
+  double const SLOW = 10.0;
+
+  string s1, s2;
+  RangeT r1, r2;
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(s1, S1, ());
+  TEST_EQUAL(r1, RangeT(0, 99), ());
+  TEST_EQUAL(s2, S2, ());
+  TEST_EQUAL(r2, RangeT(100, 199), ());
+
+  // Chunks grow for the fast server.
+  TEST_EQUAL(strategy.ChunkFinished(true, r1, FAST), S1, ());
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r1, RangeT(200, 399), ());
+
+  // And stay minimal for the slow one.
+  TEST_EQUAL(strategy.ChunkFinished(true, r2, SLOW), S2, ());
+  TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r2, RangeT(400, 499), ());
+
+  TEST_EQUAL(strategy.ChunkFinished(true, r1, FAST), S1, ());
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r1, RangeT(500, 899), ());
+
+  TEST_EQUAL(strategy.ChunkFinished(true, r2, SLOW), S2, ());
+  TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r2, RangeT(900, 999), ());
+
+  TEST_EQUAL(strategy.ChunkFinished(true, r1, FAST), S1, ());
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r1, RangeT(1000, 1799), ());
+
+  // The slow server is dropped after its third chunk.
+  TEST_EQUAL(strategy.ActiveServersCount(), 2, ());
+  TEST_EQUAL(strategy.ChunkFinished(true, r2, SLOW), S2, ());
+  TEST_EQUAL(strategy.ActiveServersCount(), 1, ());
+  TEST_EQUAL(strategy.NextChunk(s2, r2), ChunksDownloadStrategy::ENoFreeServers, ());
+
+  TEST_EQUAL(strategy.ChunkFinished(true, r1, FAST), S1, ());
+  TEST_EQUAL(strategy.NextChunk(s1, r1), ChunksDownloadStrategy::ENextChunk, ());
+  TEST_EQUAL(r1, RangeT(1800, 3399), ());
+}
+
 namespace
 {
   string ReadFileAsString(string const & file)
@@ -195,6 +195,18 @@ bool Platform::GetFileSizeByFullPath(string const & filePath, uint64_t & size)
   else return false;
 }
 
+bool Platform::GetFileSizeAndModificationTime(string const & filePath, uint64_t & size,
+                                              int64_t & modificationTime)
+{
+  struct stat s;
+  if (stat(filePath.c_str(), &s) != 0)
+    return false;
+
+  size = s.st_size;
+  modificationTime = s.st_mtime;
+  return true;
+}
+
 Platform::TStorageStatus Platform::GetWritableStorageStatus(uint64_t neededSize) const
 {
   struct statfs st;
@@ -207,3 +207,19 @@ bool Platform::GetFileSizeByFullPath(string const & filePath, uint64_t & size)
   }
   return false;
 }
+
+bool Platform::GetFileSizeAndModificationTime(string const & filePath, uint64_t & size,
+                                              int64_t & modificationTime)
+{
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if (0 == GetFileAttributesExA(filePath.c_str(), GetFileExInfoStandard, &data))
+    return false;
+
+  size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+  // FILETIME is the number of 100-nanosecond intervals since January 1, 1601.
+  uint64_t const time = (static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                        data.ftLastWriteTime.dwLowDateTime;
+  uint64_t constexpr kEpochDelta = 11644473600ULL;
+  modificationTime = static_cast<int64_t>(time / 10000000ULL - kEpochDelta);
+  return true;
+}
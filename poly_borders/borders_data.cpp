@@ -134,6 +134,9 @@ void SwapIfNeeded(size_t & a, size_t & b)
   if (a > b)
     std::swap(a, b);
 }
+
+// Makes -0.0 and 0.0 coordinates the same for hashing.
+m2::PointD NormalizeZeros(m2::PointD const & point) { return {point.x + 0.0, point.y + 0.0}; }
 }  // namespace
 
 namespace poly_borders
@@ -195,6 +198,8 @@ void BordersData::MarkPoints()
   size_t const threadsNumber = std::thread::hardware_concurrency();
   LOG(LINFO, ("Start marking points, threads number:", threadsNumber));
 
+  BuildPointsIndex();
+
   base::thread_pool::computational::ThreadPool threadPool(threadsNumber);
 
   std::vector<std::future<void>> tasks;
@@ -206,6 +211,24 @@ void BordersData::MarkPoints()
 
   for (auto & task : tasks)
     task.wait();
+
+  m_pointsIndex.clear();
+}
+
+void BordersData::BuildPointsIndex()
+{
+  size_t pointsCount = 0;
+  for (auto const & polygon : m_bordersPolygons)
+    pointsCount += polygon.m_points.size();
+
+  m_pointsIndex.clear();
+  m_pointsIndex.reserve(pointsCount);
+  for (size_t borderId = 0; borderId < m_bordersPolygons.size(); ++borderId)
+  {
+    auto const & points = m_bordersPolygons[borderId].m_points;
+    for (size_t pointId = 0; pointId < points.size(); ++pointId)
+      m_pointsIndex[NormalizeZeros(points[pointId].m_point)].emplace_back(borderId, pointId);
+  }
 }
 
 void BordersData::DumpPolyFiles(std::string const & targetDir)
@@ -271,37 +294,30 @@ void BordersData::MarkPoint(size_t curBorderId, size_t curPointId)
 {
   MarkedPoint & curMarkedPoint = m_bordersPolygons[curBorderId].m_points[curPointId];
 
-  for (size_t anotherBorderId = 0; anotherBorderId < m_bordersPolygons.size(); ++anotherBorderId)
+  auto const it = m_pointsIndex.find(NormalizeZeros(curMarkedPoint.m_point));
+  CHECK(it != m_pointsIndex.cend(), (curBorderId, curPointId));
+
+  // The first position of the point in every other border is checked, like the points of the
+  // borders are scanned in order.
+  for (auto const & link : it->second)
   {
-    if (curBorderId == anotherBorderId)
+    if (curBorderId == link.m_borderId)
       continue;
 
     if (curMarkedPoint.m_marked)
       return;
 
-    Polygon & anotherPolygon = m_bordersPolygons[anotherBorderId];
-
-    if (!anotherPolygon.m_rect.IsPointInside(curMarkedPoint.m_point))
-      continue;
-
-    for (size_t anotherPointId = 0; anotherPointId < anotherPolygon.m_points.size(); ++anotherPointId)
-    {
-      auto & anotherMarkedPoint = anotherPolygon.m_points[anotherPointId];
-
-      if (base::AlmostEqualAbs(anotherMarkedPoint.m_point, curMarkedPoint.m_point, kEqualityEpsilon))
-      {
-        anotherMarkedPoint.m_marked = true;
-        curMarkedPoint.m_marked = true;
+    auto & anotherMarkedPoint = m_bordersPolygons[link.m_borderId].m_points[link.m_pointId];
+    anotherMarkedPoint.m_marked = true;
+    curMarkedPoint.m_marked = true;
 
-        // Save info that border with id: |anotherBorderId| has the same point with id:
-        // |anotherPointId|.
-        curMarkedPoint.AddLink(anotherBorderId, anotherPointId);
-        // And vice versa.
-        anotherMarkedPoint.AddLink(curBorderId, curPointId);
+    // Save info that border with id: |link.m_borderId| has the same point with id:
+    // |link.m_pointId|.
+    curMarkedPoint.AddLink(link.m_borderId, link.m_pointId);
+    // And vice versa.
+    anotherMarkedPoint.AddLink(curBorderId, curPointId);
 
-        return;
-      }
-    }
+    return;
   }
 }
 
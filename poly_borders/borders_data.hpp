@@ -2,10 +2,13 @@
 
 #include "poly_borders/help_structures.hpp"
 
+#include "geometry/point2d.hpp"
+
 #include "base/control_flow.hpp"
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace poly_borders
@@ -47,6 +50,9 @@ private:
   //  If point belongs to more than 2 polygons, the link will be created for an arbitrary pair.
   void MarkPoint(size_t curBorderId, size_t curPointId);
 
+  /// \brief Fills |m_pointsIndex| with the points of all the polygons.
+  void BuildPointsIndex();
+
   /// \brief Checks whether we can replace points from segment: [curLeftPointId, curRightPointId]
   /// of |curBorderId| to points from another border in order to get rid of empty space
   /// between curBorder and anotherBorder.
@@ -67,5 +73,10 @@ private:
   std::map<size_t, std::string> m_indexToPolyFileName;
   std::vector<Polygon> m_bordersPolygons;
   std::vector<Polygon> m_prevCopy;
+
+  // Positions of the points of all the polygons by the points, ordered by border ids and point
+  // ids. Points are equal if they are closer than |kEqualityEpsilon| which is much less than
+  // the precision of the coordinates, so the equal points have the same coordinates.
+  std::unordered_map<m2::PointD, std::vector<Link>, m2::PointD::Hash> m_pointsIndex;
 };
 }  // namespace poly_borders
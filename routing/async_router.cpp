@@ -4,6 +4,7 @@
 
 #include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/profiler.hpp"
 #include "base/string_utils.hpp"
 #include "base/timer.hpp"
 
@@ -253,6 +254,14 @@ void AsyncRouter::ClearState()
   ResetDelegate();
 }
 
+void AsyncRouter::ClearCaches()
+{
+  unique_lock<mutex> ul(m_guard);
+
+  m_clearState = true;
+  m_threadCondVar.notify_one();
+}
+
 void AsyncRouter::LogCode(RouterResultCode code, double const elapsedSec)
 {
   switch (code)
@@ -324,6 +333,7 @@ void AsyncRouter::ResetDelegate()
 
 void AsyncRouter::ThreadFunc()
 {
+  base::profiler::SetThreadName("AsyncRouter");
   while (true)
   {
     {
@@ -398,6 +408,7 @@ void AsyncRouter::CalculateRoute()
     if (absentRegionsFinder)
       absentRegionsFinder->GenerateAbsentRegions(checkpoints, delegateProxy->GetDelegate());
 
+    auto const profileBefore = delegateProxy->GetDelegate().GetProfile();
     // Run basic request.
     code = router->CalculateRoute(checkpoints, startDirection, adjustToPrevRoute,
                                   delegateProxy->GetDelegate(), *route);
@@ -405,6 +416,8 @@ void AsyncRouter::CalculateRoute()
     elapsedSec = timer.ElapsedSeconds(); // routing time
     LogCode(code, elapsedSec);
     LOG(LINFO, ("ETA:", route->GetTotalTimeSec(), "sec."));
+    LOG(LINFO, ("Route profile:",
+                (delegateProxy->GetDelegate().GetProfile() - profileBefore).ToJson()));
   }
   catch (RootException const & e)
   {
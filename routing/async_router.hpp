@@ -59,6 +59,8 @@ public:
   void SetGuidesTracks(GuidesTracks && guides);
   /// Interrupt routing and clear buffers
   void ClearState();
+  /// Clear buffers of the router when it is idle without interrupting the route being built.
+  void ClearCaches();
 
   bool FindClosestProjectionToRoad(m2::PointD const & point, m2::PointD const & direction,
                                    double radius, EdgeProj & proj);
@@ -15,6 +15,7 @@
 #include <map>
 #include <optional>
 #include <queue>
+#include <set>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -36,8 +37,44 @@ struct DefaultLengthChecker
 {
   bool operator()(Weight const & /* weight */) const { return true; }
 };
+
+// Limits of alternatives to the best path. Lengths are in parts of the best path length.
+struct AlternativesParams
+{
+  // Maximal number of alternatives. Alternatives are not looked for if it's zero.
+  size_t m_maxCount = 0;
+  // An alternative is not longer than the best path by more than |m_maxStretch|.
+  double m_maxStretch = 0.25;
+  // An alternative shares not more than |m_maxSharing| of its length with the best path and
+  // the previous alternatives.
+  double m_maxSharing = 0.8;
+  // The plateau of an alternative is not shorter than |m_minPlateau|. The plateau is the part of
+  // the path which belongs to both the forward and the backward shortest paths trees, so the path
+  // is locally optimal around its meeting point.
+  double m_minPlateau = 0.1;
+};
+
+// Vertices reached by the backward wave of a search with their real distances to the finish.
+// The parent of a vertex is the next vertex on its way to the finish. Distances of the vertices
+// which were not settled by the wave are upper bounds of the shortest ones.
+template <typename Vertex, typename Weight>
+struct BackwardTree
+{
+  void Clear()
+  {
+    m_distances.clear();
+    m_parents.clear();
+  }
+
+  bool IsEmpty() const { return m_distances.empty(); }
+
+  ska::bytell_hash_map<Vertex, Weight> m_distances;
+  ska::bytell_hash_map<Vertex, Vertex> m_parents;
+};
 }  // namespace astar
 
+// \note The algorithm keeps the memory of its bidirectional searches until ReleaseMemory()
+// is called, so the searches of one instance must not run concurrently.
 template <typename Vertex, typename Edge, typename Weight>
 class AStarAlgorithm
 {
@@ -212,12 +249,42 @@ public:
   template <typename P>
   Result FindPathBidirectional(P & params, RoutingResult<Vertex, Weight> & result) const;
 
+  // The same as FindPathBidirectional() above but also fills |alternatives| with paths which are
+  // found in the same search by the plateau method: the waves are propagated further by the
+  // stretch limit and every vertex where they meet gives a candidate path through it.
+  // The candidates are filtered according to |alternativesParams| and sorted by length.
+  template <typename P>
+  Result FindPathBidirectional(P & params, astar::AlternativesParams const & alternativesParams,
+                               RoutingResult<Vertex, Weight> & result,
+                               std::vector<RoutingResult<Vertex, Weight>> & alternatives) const;
+
+  // The same as FindPathBidirectional() above but also fills |backwardTree| with the vertices
+  // reached by the backward wave, so the route to the same finish may be rebuilt by
+  // AdjustRoute() without a new search from it.
+  template <typename P>
+  Result FindPathBidirectional(P & params, RoutingResult<Vertex, Weight> & result,
+                               astar::BackwardTree<Vertex, Weight> & backwardTree) const;
+
   // Adjust route to the previous one.
   // Expects |params.m_checkLengthCallback| to check wave propagation limit.
   template <typename P>
   typename AStarAlgorithm<Vertex, Edge, Weight>::Result AdjustRoute(P & params,
                                                                     RoutingResult<Vertex, Weight> & result) const;
 
+  // The same as AdjustRoute() above but the route is adjusted to any vertex of |backwardTree|
+  // instead of the previous route, so the new route may join the previous one far from the start
+  // or not join it at all.
+  template <typename P>
+  Result AdjustRoute(P & params, astar::BackwardTree<Vertex, Weight> const & backwardTree,
+                     RoutingResult<Vertex, Weight> & result) const;
+
+  /// \brief Frees the memory which is kept between the bidirectional searches.
+  void ReleaseMemory()
+  {
+    m_forwardBuffers = {};
+    m_backwardBuffers = {};
+  }
+
 private:
   // Periodicity of switching a wave of bidirectional algorithm.
   static uint32_t constexpr kQueueSwitchPeriod = 128;
@@ -260,6 +327,40 @@ private:
     Weight heuristic;
   };
 
+  // Memory of one wave of the bidirectional search. It's kept between the searches, so the
+  // algorithm which finds many paths in a row (e.g. for the leaps of a route) does not allocate
+  // the queue and the distances again and again.
+  struct WaveBuffers
+  {
+    std::vector<State> m_queue;
+    ska::bytell_hash_map<Vertex, Weight> m_bestDistance;
+  };
+
+  // Min-priority queue of the states over a vector which keeps its capacity.
+  class StateQueue
+  {
+  public:
+    explicit StateQueue(std::vector<State> & states) : m_states(states) { m_states.clear(); }
+
+    bool empty() const { return m_states.empty(); }
+    State const & top() const { return m_states.front(); }
+
+    void push(State const & state)
+    {
+      m_states.push_back(state);
+      std::push_heap(m_states.begin(), m_states.end(), std::greater<State>());
+    }
+
+    void pop()
+    {
+      std::pop_heap(m_states.begin(), m_states.end(), std::greater<State>());
+      m_states.pop_back();
+    }
+
+  private:
+    std::vector<State> & m_states;
+  };
+
   // BidirectionalStepContext keeps all the information that is needed to
   // search starting from one of the two directions. Its main
   // purpose is to make the code that changes directions more readable.
@@ -268,12 +369,15 @@ private:
     using Parents = typename Graph::Parents;
 
     BidirectionalStepContext(bool forward, Vertex const & startVertex, Vertex const & finalVertex,
-                             Graph & graph)
+                             Graph & graph, WaveBuffers & buffers)
         : forward(forward)
         , startVertex(startVertex)
         , finalVertex(finalVertex)
         , graph(graph)
+        , queue(buffers.m_queue)
+        , bestDistance(buffers.m_bestDistance)
     {
+      bestDistance.clear();
       bestVertex = forward ? startVertex : finalVertex;
       pS = ConsistentHeuristic(bestVertex);
       graph.SetAStarParents(forward, parent);
@@ -358,14 +462,36 @@ private:
     Vertex const & finalVertex;
     Graph & graph;
 
-    std::priority_queue<State, std::vector<State>, std::greater<State>> queue;
-    ska::bytell_hash_map<Vertex, Weight> bestDistance;
+    StateQueue queue;
+    ska::bytell_hash_map<Vertex, Weight> & bestDistance;
     Parents parent;
     Vertex bestVertex;
 
     Weight pS;
   };
 
+  template <typename P>
+  Result FindPathBidirectionalImpl(P & params, astar::AlternativesParams const & alternativesParams,
+                                   RoutingResult<Vertex, Weight> & result,
+                                   std::vector<RoutingResult<Vertex, Weight>> & alternatives,
+                                   astar::BackwardTree<Vertex, Weight> * backwardTree) const;
+
+  // Propagates a wave from the start until the found route to a target can't be improved.
+  // |getRemainingDistance| returns the distance from a target to the finish or nothing if
+  // the vertex is not a target. |appendRemainingPath| appends the path from a target to the finish.
+  template <typename P, typename GetRemainingDistance, typename AppendRemainingPath>
+  Result AdjustRouteToTargets(P & params, GetRemainingDistance && getRemainingDistance,
+                              AppendRemainingPath && appendRemainingPath,
+                              RoutingResult<Vertex, Weight> & result) const;
+
+  template <typename P>
+  void FindAlternatives(P & params, astar::AlternativesParams const & alternativesParams,
+                        BidirectionalStepContext const & forward,
+                        BidirectionalStepContext const & backward,
+                        std::vector<Vertex> const & meetingVertices,
+                        RoutingResult<Vertex, Weight> const & best,
+                        std::vector<RoutingResult<Vertex, Weight>> & alternatives) const;
+
   static void ReconstructPath(Vertex const & v,
                               typename BidirectionalStepContext::Parents const & parent,
                               std::vector<Vertex> & path);
@@ -373,6 +499,9 @@ private:
       Vertex const & v, Vertex const & w,
       typename BidirectionalStepContext::Parents const & parentV,
       typename BidirectionalStepContext::Parents const & parentW, std::vector<Vertex> & path);
+
+  mutable WaveBuffers m_forwardBuffers;
+  mutable WaveBuffers m_backwardBuffers;
 };
 
 template <typename Vertex, typename Edge, typename Weight>
@@ -557,13 +686,60 @@ typename AStarAlgorithm<Vertex, Edge, Weight>::Result
 AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectional(P & params,
                                                             RoutingResult<Vertex, Weight> & result) const
 {
+  std::vector<RoutingResult<Vertex, Weight>> alternatives;
+  return FindPathBidirectionalImpl(params, astar::AlternativesParams(), result, alternatives,
+                                   nullptr /* backwardTree */);
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <typename P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectional(
+    P & params, astar::AlternativesParams const & alternativesParams,
+    RoutingResult<Vertex, Weight> & result,
+    std::vector<RoutingResult<Vertex, Weight>> & alternatives) const
+{
+  return FindPathBidirectionalImpl(params, alternativesParams, result, alternatives,
+                                   nullptr /* backwardTree */);
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <typename P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectional(
+    P & params, RoutingResult<Vertex, Weight> & result,
+    astar::BackwardTree<Vertex, Weight> & backwardTree) const
+{
+  std::vector<RoutingResult<Vertex, Weight>> alternatives;
+  return FindPathBidirectionalImpl(params, astar::AlternativesParams(), result, alternatives,
+                                   &backwardTree);
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <typename P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectionalImpl(
+    P & params, astar::AlternativesParams const & alternativesParams,
+    RoutingResult<Vertex, Weight> & result,
+    std::vector<RoutingResult<Vertex, Weight>> & alternatives,
+    astar::BackwardTree<Vertex, Weight> * backwardTree) const
+{
+  if (backwardTree)
+    backwardTree->Clear();
+
+  alternatives.clear();
+  bool const findAlternatives = alternativesParams.m_maxCount != 0;
+  std::vector<Vertex> meetingVertices;
+
   auto const epsilon = params.m_weightEpsilon;
   auto & graph = params.m_graph;
   auto const & finalVertex = params.m_finalVertex;
   auto const & startVertex = params.m_startVertex;
 
-  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph);
-  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph);
+  BidirectionalStepContext forward(true /* forward */, startVertex, finalVertex, graph,
+                                   m_forwardBuffers);
+  BidirectionalStepContext backward(false /* forward */, startVertex, finalVertex, graph,
+                                    m_backwardBuffers);
 
   auto & forwardParents = forward.GetParents();
   auto & backwardParents = backward.GetParents();
@@ -596,6 +772,23 @@ AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectional(P & params,
     if (!cur->forward)
       reverse(result.m_path.begin(), result.m_path.end());
 
+    if (findAlternatives)
+    {
+      FindAlternatives(params, alternativesParams, forward, backward, meetingVertices, result,
+                       alternatives);
+    }
+
+    if (backwardTree)
+    {
+      backwardTree->m_distances.reserve(backward.bestDistance.size());
+      for (auto const & item : backward.bestDistance)
+      {
+        backwardTree->m_distances.emplace(
+            item.first, item.second + backward.pS - backward.ConsistentHeuristic(item.first));
+      }
+      backwardTree->m_parents = backwardParents;
+    }
+
     return Result::OK;
   };
 
@@ -606,6 +799,9 @@ AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectional(P & params,
   // queues is exhausted, we never will.
   uint32_t steps = 0;
   PeriodicPollCancellable periodicCancellable(params.m_cancellable);
+  // Plateaus are the parts of the paths where the waves overlap, so to find alternatives
+  // the waves are switched on every step to grow evenly.
+  uint32_t const switchPeriod = findAlternatives ? 1 : kQueueSwitchPeriod;
 
   while (!cur->queue.empty() && !nxt->queue.empty())
   {
@@ -614,7 +810,7 @@ AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectional(P & params,
     if (periodicCancellable.IsCancelled())
       return Result::Cancelled;
 
-    if (steps % kQueueSwitchPeriod == 0)
+    if (steps % switchPeriod == 0)
       std::swap(cur, nxt);
 
     if (foundAnyPath)
@@ -633,7 +829,13 @@ AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectional(P & params,
       // several top states in a priority queue may have equal reduced path lengths and
       // different real path lengths.
 
-      if (curTop + nxtTop >= bestPathReducedLength - epsilon)
+      // Alternatives are not longer than the best path by the stretch, so the waves are
+      // propagated further by it. Reduced and real lengths of the paths from the start to the
+      // finish differ by the same constant, so the stretch may be added to the reduced length.
+      auto const stretch = findAlternatives
+                               ? alternativesParams.m_maxStretch * bestPathRealLength
+                               : kZeroDistance;
+      if (curTop + nxtTop >= bestPathReducedLength + stretch - epsilon)
         return getResult();
     }
 
@@ -695,6 +897,12 @@ AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectional(P & params,
           cur->bestVertex = stateV.vertex;
           nxt->bestVertex = stateW.vertex;
         }
+
+        if (findAlternatives &&
+            graph.AreWavesConnectible(forwardParents, stateW.vertex, backwardParents))
+        {
+          meetingVertices.push_back(stateW.vertex);
+        }
       }
 
       if (stateW.vertex != (cur->forward ? cur->finalVertex : cur->startVertex))
@@ -708,6 +916,116 @@ AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectional(P & params,
   return Result::NoPath;
 }
 
+template <typename Vertex, typename Edge, typename Weight>
+template <typename P>
+void AStarAlgorithm<Vertex, Edge, Weight>::FindAlternatives(
+    P & params, astar::AlternativesParams const & alternativesParams,
+    BidirectionalStepContext const & forward, BidirectionalStepContext const & backward,
+    std::vector<Vertex> const & meetingVertices, RoutingResult<Vertex, Weight> const & best,
+    std::vector<RoutingResult<Vertex, Weight>> & alternatives) const
+{
+  auto const getRealDistance = [](BidirectionalStepContext const & context, Vertex const & v) {
+    auto const distance = context.GetDistance(v);
+    CHECK(distance, (v));
+    return *distance + context.pS - context.ConsistentHeuristic(v);
+  };
+
+  auto const maxLength = best.m_distance + alternativesParams.m_maxStretch * best.m_distance;
+  auto const minPlateau = alternativesParams.m_minPlateau * best.m_distance;
+
+  std::vector<std::pair<Weight, Vertex>> candidates;
+  for (auto const & v : meetingVertices)
+  {
+    auto const length = getRealDistance(forward, v) + getRealDistance(backward, v);
+    if (length <= maxLength && params.m_checkLengthCallback(length))
+      candidates.emplace_back(length, v);
+  }
+
+  // Lengths are calculated by the final distances, so a vertex met several times gives equal
+  // candidates.
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  std::set<std::pair<Vertex, Vertex>> takenEdges;
+  auto const takeEdges = [&takenEdges](std::vector<Vertex> const & path) {
+    for (size_t i = 1; i < path.size(); ++i)
+      takenEdges.emplace(path[i - 1], path[i]);
+  };
+  takeEdges(best.m_path);
+
+  auto const isParent = [](typename BidirectionalStepContext::Parents const & parents,
+                           Vertex const & child, Vertex const & parent) {
+    auto const it = parents.find(child);
+    return it != parents.cend() && it->second == parent;
+  };
+
+  std::vector<Vertex> path;
+  std::vector<Vertex> tail;
+  std::vector<Weight> lengths;
+  ska::bytell_hash_map<Vertex, bool> visited;
+  for (auto const & [length, v] : candidates)
+  {
+    if (alternatives.size() >= alternativesParams.m_maxCount)
+      break;
+
+    ReconstructPath(v, forward.parent, path);
+    ReconstructPath(v, backward.parent, tail);
+    size_t const meetingIdx = path.size() - 1;
+    path.insert(path.end(), std::next(tail.rbegin()), tail.rend());
+
+    // The forward and the backward parts of the path may cross each other.
+    visited.clear();
+    bool hasLoop = false;
+    for (auto const & vertex : path)
+    {
+      if (!visited.emplace(vertex, true).second)
+      {
+        hasLoop = true;
+        break;
+      }
+    }
+    if (hasLoop)
+      continue;
+
+    lengths.resize(path.size());
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+      lengths[i] = i <= meetingIdx ? getRealDistance(forward, path[i])
+                                   : length - getRealDistance(backward, path[i]);
+    }
+
+    size_t plateauBegin = meetingIdx;
+    while (plateauBegin > 0 &&
+           isParent(backward.parent, path[plateauBegin - 1], path[plateauBegin]))
+    {
+      --plateauBegin;
+    }
+    size_t plateauEnd = meetingIdx;
+    while (plateauEnd + 1 < path.size() &&
+           isParent(forward.parent, path[plateauEnd + 1], path[plateauEnd]))
+    {
+      ++plateauEnd;
+    }
+    if (lengths[plateauEnd] - lengths[plateauBegin] < minPlateau)
+      continue;
+
+    auto sharedLength = kZeroDistance;
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+      if (takenEdges.count({path[i - 1], path[i]}) != 0)
+        sharedLength += lengths[i] - lengths[i - 1];
+    }
+    if (sharedLength > alternativesParams.m_maxSharing * length)
+      continue;
+
+    takeEdges(path);
+    RoutingResult<Vertex, Weight> alternative;
+    alternative.m_path = path;
+    alternative.m_distance = length;
+    alternatives.push_back(std::move(alternative));
+  }
+}
+
 template <typename Vertex, typename Edge, typename Weight>
 template <typename P>
 typename AStarAlgorithm<Vertex, Edge, Weight>::Result
@@ -715,12 +1033,84 @@ AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params,
                                                   RoutingResult<Vertex, Weight> & result) const
 {
   CHECK(params.m_prevRoute, ());
-  auto & graph = params.m_graph;
-  auto const & startVertex = params.m_startVertex;
   auto const & prevRoute = *params.m_prevRoute;
 
   CHECK(!prevRoute.empty(), ());
 
+  std::map<Vertex, Weight> remainingDistances;
+  auto remainingDistance = kZeroDistance;
+
+  for (auto it = prevRoute.crbegin(); it != prevRoute.crend(); ++it)
+  {
+    remainingDistances[it->GetTarget()] = remainingDistance;
+    remainingDistance += it->GetWeight();
+  }
+
+  auto const getRemainingDistance = [&](Vertex const & vertex) -> std::optional<Weight> {
+    auto const it = remainingDistances.find(vertex);
+    if (it == remainingDistances.cend())
+      return {};
+    return it->second;
+  };
+
+  auto const appendRemainingPath = [&](Vertex const & returnVertex, std::vector<Vertex> & path) {
+    auto const adjustSize = path.size();
+    for (size_t i = 0; i < prevRoute.size(); ++i)
+    {
+      if (prevRoute[i].GetTarget() == returnVertex)
+      {
+        for (size_t j = i + 1; j < prevRoute.size(); ++j)
+          path.push_back(prevRoute[j].GetTarget());
+
+        return;
+      }
+    }
+
+    CHECK(false, ("Can't find", returnVertex, ", prev:", prevRoute.size(), ", adjust:", adjustSize));
+  };
+
+  return AdjustRouteToTargets(params, getRemainingDistance, appendRemainingPath, result);
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <typename P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(
+    P & params, astar::BackwardTree<Vertex, Weight> const & backwardTree,
+    RoutingResult<Vertex, Weight> & result) const
+{
+  CHECK(!backwardTree.IsEmpty(), ());
+
+  auto const getRemainingDistance = [&](Vertex const & vertex) -> std::optional<Weight> {
+    auto const it = backwardTree.m_distances.find(vertex);
+    if (it == backwardTree.m_distances.cend())
+      return {};
+    return it->second;
+  };
+
+  auto const appendRemainingPath = [&](Vertex const & returnVertex, std::vector<Vertex> & path) {
+    auto const & parents = backwardTree.m_parents;
+    size_t steps = 0;
+    for (auto it = parents.find(returnVertex); it != parents.cend(); it = parents.find(it->second))
+    {
+      CHECK_LESS_OR_EQUAL(++steps, parents.size(), ("Loop in the backward tree from", returnVertex));
+      path.push_back(it->second);
+    }
+  };
+
+  return AdjustRouteToTargets(params, getRemainingDistance, appendRemainingPath, result);
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <typename P, typename GetRemainingDistance, typename AppendRemainingPath>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::AdjustRouteToTargets(
+    P & params, GetRemainingDistance && getRemainingDistance,
+    AppendRemainingPath && appendRemainingPath, RoutingResult<Vertex, Weight> & result) const
+{
+  auto & graph = params.m_graph;
+  auto const & startVertex = params.m_startVertex;
+
   static_assert(!std::is_same<decltype(params.m_checkLengthCallback),
                               astar::DefaultLengthChecker<Weight>>::value,
                 "CheckLengthCallback expected to be set to limit wave propagation.");
@@ -729,17 +1119,9 @@ AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params,
 
   bool wasCancelled = false;
   auto minDistance = kInfiniteDistance;
+  auto minRemainingDistance = kZeroDistance;
   Vertex returnVertex;
 
-  std::map<Vertex, Weight> remainingDistances;
-  auto remainingDistance = kZeroDistance;
-
-  for (auto it = prevRoute.crbegin(); it != prevRoute.crend(); ++it)
-  {
-    remainingDistances[it->GetTarget()] = remainingDistance;
-    remainingDistance += it->GetWeight();
-  }
-
   Context context(graph);
   PeriodicPollCancellable periodicCancellable(params.m_cancellable);
 
@@ -751,15 +1133,22 @@ AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params,
       return false;
     }
 
+    // Remaining distances are not negative, so the vertices which are farther than the found
+    // route can't give a shorter one.
+    auto const distance = context.GetDistance(vertex);
+    if (distance >= minDistance)
+      return false;
+
     params.m_onVisitedVertexCallback(startVertex, vertex);
 
-    auto it = remainingDistances.find(vertex);
-    if (it != remainingDistances.cend())
+    auto const remainingDistance = getRemainingDistance(vertex);
+    if (remainingDistance)
     {
-      auto const fullDistance = context.GetDistance(vertex) + it->second;
+      auto const fullDistance = distance + *remainingDistance;
       if (fullDistance < minDistance)
       {
         minDistance = fullDistance;
+        minRemainingDistance = *remainingDistance;
         returnVertex = vertex;
       }
     }
@@ -788,25 +1177,9 @@ AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params,
   context.ReconstructPath(returnVertex, result.m_path);
 
   // Append remaining route.
-  bool found = false;
-  for (size_t i = 0; i < prevRoute.size(); ++i)
-  {
-    if (prevRoute[i].GetTarget() == returnVertex)
-    {
-      for (size_t j = i + 1; j < prevRoute.size(); ++j)
-        result.m_path.push_back(prevRoute[j].GetTarget());
-
-      found = true;
-      break;
-    }
-  }
-
-  CHECK(found, ("Can't find", returnVertex, ", prev:", prevRoute.size(),
-                ", adjust:", result.m_path.size()));
+  appendRemainingPath(returnVertex, result.m_path);
 
-  auto const & it = remainingDistances.find(returnVertex);
-  CHECK(it != remainingDistances.end(), ());
-  result.m_distance = context.GetDistance(returnVertex) + it->second;
+  result.m_distance = context.GetDistance(returnVertex) + minRemainingDistance;
   return Result::OK;
 }
 
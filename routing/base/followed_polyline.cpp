@@ -79,6 +79,7 @@ void FollowedPolyline::Swap(FollowedPolyline & rhs)
   m_poly.Swap(rhs.m_poly);
   m_segDistance.swap(rhs.m_segDistance);
   m_segProj.swap(rhs.m_segProj);
+  swap(m_segTree, rhs.m_segTree);
   swap(m_current, rhs.m_current);
   swap(m_nextCheckpointIndex, rhs.m_nextCheckpointIndex);
 }
@@ -93,6 +94,7 @@ void FollowedPolyline::Update()
   m_segDistance.reserve(n);
   m_segProj.clear();
   m_segProj.reserve(n);
+  m_segTree.Clear();
 
   double dist = 0.0;
   for (size_t i = 0; i < n; ++i)
@@ -104,6 +106,7 @@ void FollowedPolyline::Update()
 
     m_segDistance.emplace_back(dist);
     m_segProj.emplace_back(p1, p2);
+    m_segTree.Add(i, m2::RectD(p1, p2));
   }
 
   m_current = Iter(m_poly.Front(), 0);
@@ -229,20 +232,19 @@ Iter FollowedPolyline::GetClosestMatchingProjectionInInterval(m2::RectD const &
 
   m2::PointD const currPos = posRect.Center();
 
-  for (size_t i = startIdx; i < endIdx; ++i)
-  {
+  ForEachSegmentInRect(posRect, startIdx, endIdx, [&](size_t i) {
     m2::PointD const pt = m_segProj[i].ClosestPointTo(currPos);
 
     if (!posRect.IsPointInside(pt))
-      continue;
+      return;
 
     double const dp = mercator::DistanceOnEarth(pt, currPos);
     if (dp >= minDist)
-      continue;
+      return;
 
     nearestIter = Iter(pt, i);
     minDist = dp;
-  }
+  });
 
   return nearestIter;
 }
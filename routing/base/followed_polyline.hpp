@@ -5,7 +5,9 @@
 #include "geometry/point2d.hpp"
 #include "geometry/polyline2d.hpp"
 #include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 #include <vector>
@@ -102,12 +104,11 @@ public:
     Iter res;
     double minDist = std::numeric_limits<double>::max();
 
-    for (size_t i = startIdx; i < endIdx; ++i)
-    {
+    ForEachSegmentInRect(posRect, startIdx, endIdx, [&](size_t i) {
       m2::PointD const & pt = m_segProj[i].ClosestPointTo(posRect.Center());
 
       if (!posRect.IsPointInside(pt))
-        continue;
+        return;
 
       Iter it(pt, i);
       double const dp = distFn(it);
@@ -116,7 +117,7 @@ public:
         res = it;
         minDist = dp;
       }
-    }
+    });
 
     return res;
   }
@@ -136,6 +137,35 @@ private:
 
   Iter GetBestMatchingProjection(m2::RectD const & posRect) const;
 
+  /// \brief Calls |fn| in ascending order for indexes of segments from [|startIdx|, |endIdx|)
+  /// which may have points inside |rect|. Long intervals are looked up in |m_segTree|.
+  template <typename Fn>
+  void ForEachSegmentInRect(m2::RectD const & rect, size_t startIdx, size_t endIdx,
+                            Fn && fn) const
+  {
+    size_t constexpr kMinSegmentsCountToUseTree = 64;
+    if (endIdx - startIdx < kMinSegmentsCountToUseTree)
+    {
+      for (size_t i = startIdx; i < endIdx; ++i)
+        fn(i);
+      return;
+    }
+
+    // The tree doesn't report the segments which only touch the rect.
+    double constexpr kEps = 1e-7;
+    m2::RectD queryRect = rect;
+    queryRect.Inflate(kEps, kEps);
+
+    std::vector<size_t> indexes;
+    m_segTree.ForEachInRect(queryRect, [&](size_t i) {
+      if (startIdx <= i && i < endIdx)
+        indexes.push_back(i);
+    });
+    std::sort(indexes.begin(), indexes.end());
+    for (auto const i : indexes)
+      fn(i);
+  }
+
   void Update();
 
   m2::PolylineD m_poly;
@@ -147,6 +177,8 @@ private:
   size_t m_nextCheckpointIndex;
   /// Precalculated info for fast projection finding.
   std::vector<m2::ParametrizedSegment<m2::PointD>> m_segProj;
+  /// Indexes of |m_segProj| by the segments' rects.
+  m4::Tree<size_t> m_segTree;
   /// Accumulated cache of segments length in meters.
   std::vector<double> m_segDistance;
 };
@@ -150,14 +150,12 @@ public:
   {
     auto const & transition = GetTransition(segment);
     CHECK_NOT_EQUAL(transition.m_enterIdx, connector::kFakeIndex, ());
-    auto const enterIdx = transition.m_enterIdx;
+    connector::Weight const * row = GetWeightsRow(transition.m_enterIdx);
     for (size_t exitIdx = 0; exitIdx < m_exits.size(); ++exitIdx)
-    {
-      auto const weight = GetWeight(enterIdx, exitIdx);
-      AddEdge(m_exits[exitIdx], weight, edges);
-    }
+      AddEdge(m_exits[exitIdx], row[exitIdx], edges);
   }
 
+  // All the weights should be loaded, see WeightsWereLoaded().
   void GetIngoingEdgeList(Segment const & segment, std::vector<SegmentEdge> & edges) const
   {
     auto const & transition = GetTransition(segment);
@@ -165,7 +163,7 @@ public:
     auto const exitIdx = transition.m_exitIdx;
     for (size_t enterIdx = 0; enterIdx < m_enters.size(); ++enterIdx)
     {
-      auto const weight = GetWeight(enterIdx, exitIdx);
+      auto const weight = GetWeightsRow(enterIdx)[exitIdx];
       AddEdge(m_enters[enterIdx], weight, edges);
     }
   }
@@ -200,6 +198,22 @@ public:
     UNREACHABLE();
   }
 
+  // Weights are stored by rows of the enters in the newer sections, so the weights of the edges
+  // outgoing from an enter may be loaded without the other ones.
+  bool WeightsCanBeLoadedByRows() const
+  {
+    return m_weightsLoadState == connector::WeightsLoadState::ReadyToLoad && m_weightsAreInRows;
+  }
+
+  bool OutgoingWeightsWereLoaded(Segment const & enter) const
+  {
+    if (WeightsWereLoaded())
+      return true;
+
+    auto const enterIdx = GetTransition(enter).m_enterIdx;
+    return m_weightsRows.find(enterIdx) != m_weightsRows.cend();
+  }
+
   template <typename CalcWeight>
   void FillWeights(CalcWeight && calcWeight)
   {
@@ -288,14 +302,20 @@ private:
     return it->second;
   }
 
-  connector::Weight GetWeight(size_t enterIdx, size_t exitIdx) const
+  // Returns the weights of the edges from the enter with |enterIdx| to all the exits.
+  connector::Weight const * GetWeightsRow(size_t enterIdx) const
   {
     ASSERT_LESS(enterIdx, m_enters.size(), ());
-    ASSERT_LESS(exitIdx, m_exits.size(), ());
 
-    size_t const i = enterIdx * m_exits.size() + exitIdx;
-    ASSERT_LESS(i, m_weights.size(), ());
-    return m_weights[i];
+    if (m_weightsLoadState != connector::WeightsLoadState::ReadyToLoad)
+    {
+      ASSERT_LESS_OR_EQUAL((enterIdx + 1) * m_exits.size(), m_weights.size(), ());
+      return m_weights.data() + enterIdx * m_exits.size();
+    }
+
+    auto const it = m_weightsRows.find(base::asserted_cast<uint32_t>(enterIdx));
+    CHECK(it != m_weightsRows.cend(), ("Weights of the enter", enterIdx, "were not loaded."));
+    return it->second.data();
   }
 
   NumMwmId const m_mwmId;
@@ -311,9 +331,13 @@ private:
   uint32_t const m_featureNumerationOffset = 0;
   uint64_t m_weightsOffset = 0;
   connector::Weight m_granularity = 0;
+  // True if the weights section consists of the rows of the enters which can be read separately.
+  bool m_weightsAreInRows = false;
   // |m_weights| stores edge weights.
   // Weight is the time required for the route to pass edges.
   // Weight is measured in seconds rounded upwards.
   std::vector<connector::Weight> m_weights;
+  // Rows of |m_weights| which were loaded before all the weights, by indexes of the enters.
+  std::unordered_map<uint32_t, std::vector<connector::Weight>> m_weightsRows;
 };
 }  // namespace routing
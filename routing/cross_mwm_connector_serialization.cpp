@@ -9,18 +9,44 @@ namespace routing
 // static
 uint32_t constexpr CrossMwmConnectorSerializer::kVersion0;
 uint32_t constexpr CrossMwmConnectorSerializer::kVersion1;
+uint32_t constexpr CrossMwmConnectorSerializer::kVersion2;
 uint32_t constexpr CrossMwmConnectorSerializer::kLastVersion;
 
 // static
-void CrossMwmConnectorSerializer::WriteWeights(vector<Weight> const & weights,
-                                               vector<uint8_t> & buffer)
+void CrossMwmConnectorSerializer::WriteWeights(vector<Weight> const & weights, size_t numEnters,
+                                               size_t numExits, vector<uint8_t> & buffer)
 {
+  CHECK_EQUAL(weights.size(), numEnters * numExits, ());
+
+  vector<uint8_t> rows;
+  vector<uint32_t> rowOffsets;
+  rowOffsets.reserve(numEnters);
+  {
+    MemWriter<vector<uint8_t>> rowsWriter(rows);
+    for (size_t i = 0; i < numEnters; ++i)
+    {
+      rowOffsets.push_back(base::checked_cast<uint32_t>(rows.size()));
+      WriteWeightsRow(weights.data() + i * numExits, numExits, rowsWriter);
+    }
+  }
+
   MemWriter<vector<uint8_t>> memWriter(buffer);
+  for (auto const offset : rowOffsets)
+    WriteToSink(memWriter, offset);
+  memWriter.Write(rows.data(), rows.size());
+}
+
+// static
+void CrossMwmConnectorSerializer::WriteWeightsRow(Weight const * weights, size_t count,
+                                                  MemWriter<vector<uint8_t>> & memWriter)
+{
+  // The row is padded to a whole byte when |writer| is destroyed.
   BitWriter<MemWriter<vector<uint8_t>>> writer(memWriter);
 
   connector::Weight prevWeight = 1;
-  for (auto const weight : weights)
+  for (size_t i = 0; i < count; ++i)
   {
+    auto const weight = weights[i];
     if (weight == connector::kNoRoute)
     {
       writer.Write(kNoRouteBit, 1);
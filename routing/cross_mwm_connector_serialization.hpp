@@ -183,9 +183,9 @@ public:
         continue;
 
       std::vector<uint8_t> & buffer = weightBuffers[i];
-      WriteWeights(connector.m_weights, buffer);
       auto const numEnters = base::checked_cast<uint32_t>(connector.GetEnters().size());
       auto const numExits = base::checked_cast<uint32_t>(connector.GetExits().size());
+      WriteWeights(connector.m_weights, numEnters, numExits, buffer);
       auto const vehicleType = static_cast<VehicleType>(i);
       header.AddSection(Section(buffer.size(), numEnters, numExits, vehicleType));
     }
@@ -250,6 +250,7 @@ public:
 
       connector.m_weightsOffset = weightsOffset;
       connector.m_granularity = header.GetGranularity();
+      connector.m_weightsAreInRows = header.GetVersion() >= kVersion2;
       connector.m_weightsLoadState = connector::WeightsLoadState::ReadyToLoad;
       return;
     }
@@ -266,29 +267,51 @@ public:
 
     src.Skip(connector.m_weightsOffset);
 
-    size_t const amount = connector.GetEnters().size() * connector.GetExits().size();
-    connector.m_weights.reserve(amount);
+    size_t const numEnters = connector.GetEnters().size();
+    size_t const numExits = connector.GetExits().size();
+    connector.m_weights.reserve(numEnters * numExits);
 
-    BitReader<Source> reader(src);
-
-    Weight prev = 1;
-    for (size_t i = 0; i < amount; ++i)
+    if (connector.m_weightsAreInRows)
     {
-      if (reader.Read(1) == kNoRouteBit)
-      {
-        connector.m_weights.push_back(connector::kNoRoute);
-        continue;
-      }
-
-      Weight const delta = ReadDelta<Weight>(reader) - 1;
-      Weight const current = DecodeZigZagDelta(prev, delta);
-      connector.m_weights.push_back(current * connector.m_granularity);
-      prev = current;
+      // Skips the offsets of the rows.
+      src.Skip(numEnters * sizeof(uint32_t));
+      for (size_t i = 0; i < numEnters; ++i)
+        ReadWeights(numExits, connector.m_granularity, src, connector.m_weights);
+    }
+    else
+    {
+      ReadWeights(numEnters * numExits, connector.m_granularity, src, connector.m_weights);
     }
 
+    connector.m_weightsRows.clear();
     connector.m_weightsLoadState = connector::WeightsLoadState::Loaded;
   }
 
+  // Reads only the weights of the edges outgoing from |enter|.
+  // Weights should be stored by rows, see CrossMwmConnector::WeightsCanBeLoadedByRows().
+  template <class Source, class CrossMwmId>
+  static void DeserializeWeightsRow(VehicleType /* vehicle */, Segment const & enter,
+                                    CrossMwmConnector<CrossMwmId> & connector, Source & src)
+  {
+    CHECK(connector.WeightsCanBeLoadedByRows(), ());
+    CHECK_GREATER(connector.m_granularity, 0, ());
+
+    auto const enterIdx = connector.GetTransition(enter).m_enterIdx;
+    CHECK_NOT_EQUAL(enterIdx, connector::kFakeIndex, (enter));
+
+    size_t const numEnters = connector.GetEnters().size();
+    size_t const numExits = connector.GetExits().size();
+    src.Skip(connector.m_weightsOffset + enterIdx * sizeof(uint32_t));
+    auto const rowOffset = ReadPrimitiveFromSource<uint32_t>(src);
+    uint64_t const rowPos = connector.m_weightsOffset + numEnters * sizeof(uint32_t) + rowOffset;
+    src.Skip(rowPos - src.Pos());
+
+    std::vector<Weight> row;
+    row.reserve(numExits);
+    ReadWeights(numExits, connector.m_granularity, src, row);
+    connector.m_weightsRows[enterIdx] = std::move(row);
+  }
+
   template <class CrossMwmId>
   static void AddTransition(Transition<CrossMwmId> const & transition, VehicleMask requiredMask,
                             CrossMwmConnector<CrossMwmId> & connector)
@@ -307,7 +330,10 @@ private:
 
   static uint32_t constexpr kVersion0 = 0;
   static uint32_t constexpr kVersion1 = 1;
-  static uint32_t constexpr kLastVersion = kVersion1;
+  // Weights are stored by rows of the enters. Each row is preceded by its offset in the table
+  // of offsets and is encoded independently from the others.
+  static uint32_t constexpr kVersion2 = 2;
+  static uint32_t constexpr kLastVersion = kVersion2;
   static uint8_t constexpr kNoRouteBit = 0;
   static uint8_t constexpr kRouteBit = 1;
 
@@ -390,7 +416,7 @@ private:
     void Deserialize(Source & src)
     {
       m_version = ReadPrimitiveFromSource<decltype(m_version)>(src);
-      if (m_version != kVersion0 && m_version != kVersion1)
+      if (m_version != kVersion0 && m_version != kVersion1 && m_version != kVersion2)
       {
         MYTHROW(CorruptedDataException, ("Unknown cross mwm section version ", m_version,
                                          ", current version ", kLastVersion));
@@ -412,6 +438,7 @@ private:
 
     void AddSection(Section const & section) { m_sections.push_back(section); }
 
+    uint32_t GetVersion() const { return m_version; }
     uint32_t GetNumTransitions() const { return m_numTransitions; }
     uint64_t GetSizeTransitions() const { return m_sizeTransitions; }
     Weight GetGranularity() const { return m_granularity; }
@@ -474,7 +501,33 @@ private:
       transition.Serialize(bitsPerOsmId, bitsPerMask, memWriter);
   }
 
-  static void WriteWeights(std::vector<Weight> const & weights, std::vector<uint8_t> & buffer);
+  // Reads |count| weights encoded by WriteWeightsRow() and appends them to |weights|.
+  template <class Source>
+  static void ReadWeights(size_t count, Weight granularity, Source & src,
+                          std::vector<Weight> & weights)
+  {
+    BitReader<Source> reader(src);
+
+    Weight prev = 1;
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (reader.Read(1) == kNoRouteBit)
+      {
+        weights.push_back(connector::kNoRoute);
+        continue;
+      }
+
+      Weight const delta = ReadDelta<Weight>(reader) - 1;
+      Weight const current = DecodeZigZagDelta(prev, delta);
+      weights.push_back(current * granularity);
+      prev = current;
+    }
+  }
+
+  static void WriteWeights(std::vector<Weight> const & weights, size_t numEnters, size_t numExits,
+                           std::vector<uint8_t> & buffer);
+  static void WriteWeightsRow(Weight const * weights, size_t count,
+                              MemWriter<std::vector<uint8_t>> & writer);
 };
 
 static_assert(connector::kOsmIdBits == 64, "Wrong kOsmIdBits.");
@@ -158,7 +158,7 @@ public:
 
   void GetOutgoingEdgeList(Segment const & s, std::vector<SegmentEdge> & edges)
   {
-    CrossMwmConnector<CrossMwmId> const & c = GetCrossMwmConnectorWithWeights(s.GetMwmId());
+    CrossMwmConnector<CrossMwmId> const & c = GetCrossMwmConnectorWithWeights(s);
     c.GetOutgoingEdgeList(s, edges);
   }
 
@@ -256,6 +256,26 @@ private:
         numMwmId, CrossMwmConnectorSerializer::DeserializeWeights<ReaderSourceFile, CrossMwmId>);
   }
 
+  /// \returns connector with the weights of the edges outgoing from |enter| loaded.
+  /// \note Only the row of the weights of |enter| is read if the section allows it. A search
+  /// visits a small part of the enters of the mwms on the way, so the whole matrix is not needed.
+  CrossMwmConnector<CrossMwmId> const & GetCrossMwmConnectorWithWeights(Segment const & enter)
+  {
+    auto const & c = GetCrossMwmConnectorWithTransitions(enter.GetMwmId());
+    if (!c.WeightsCanBeLoadedByRows())
+      return GetCrossMwmConnectorWithWeights(enter.GetMwmId());
+
+    if (c.OutgoingWeightsWereLoaded(enter))
+      return c;
+
+    return Deserialize(enter.GetMwmId(),
+                       [&enter](VehicleType vehicleType, CrossMwmConnector<CrossMwmId> & connector,
+                                ReaderSourceFile & src) {
+                         CrossMwmConnectorSerializer::DeserializeWeightsRow(vehicleType, enter,
+                                                                            connector, src);
+                       });
+  }
+
   /// \brief Deserializes connectors for an mwm with |numMwmId|.
   /// \param fn is a function implementing deserialization.
   /// \note Each CrossMwmConnector contained in |m_connectors| may be deserialized in two stages.
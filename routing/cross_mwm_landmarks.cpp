@@ -0,0 +1,260 @@
+#include "routing/cross_mwm_landmarks.hpp"
+
+#include "platform/country_file.hpp"
+
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+namespace
+{
+using Vertex = CrossMwmLandmarks::Vertex;
+using Weight = CrossMwmLandmarks::Weight;
+
+// Weights of the routes are summed without overflow and are clamped by kInfiniteWeight after.
+using Distance = uint64_t;
+
+// Adjacency lists of the transition graph with the edges weights in milliseconds.
+class AdjacencyGraph final
+{
+public:
+  struct Arc
+  {
+    Vertex m_target = 0;
+    Weight m_weight = 0;
+  };
+
+  // Keeps the outgoing edges if |forward| and the ingoing ones otherwise.
+  AdjacencyGraph(uint32_t numVertices, vector<CrossMwmLandmarks::Edge> const & edges, bool forward)
+    : m_offsets(numVertices + 1, 0)
+  {
+    for (auto const & edge : edges)
+    {
+      CHECK_LESS(edge.m_from, numVertices, ());
+      CHECK_LESS(edge.m_to, numVertices, ());
+      CHECK_GREATER_OR_EQUAL(edge.m_weightSec, 0.0, ());
+      ++m_offsets[(forward ? edge.m_from : edge.m_to) + 1];
+    }
+
+    for (size_t i = 1; i < m_offsets.size(); ++i)
+      m_offsets[i] += m_offsets[i - 1];
+
+    m_arcs.resize(edges.size());
+    vector<uint32_t> filled(m_offsets.begin(), m_offsets.end() - 1);
+    for (auto const & edge : edges)
+    {
+      auto const from = forward ? edge.m_from : edge.m_to;
+      auto const to = forward ? edge.m_to : edge.m_from;
+      // Rounding down keeps the bounds not greater than the weights in seconds.
+      auto const weight = min(floor(edge.m_weightSec * 1000.0),
+                              static_cast<double>(CrossMwmLandmarks::kInfiniteWeight));
+      m_arcs[filled[from]++] = {to, static_cast<Weight>(weight)};
+    }
+  }
+
+  uint32_t GetNumVertices() const { return static_cast<uint32_t>(m_offsets.size() - 1); }
+
+  template <typename Fn>
+  void ForEachArc(Vertex v, Fn && fn) const
+  {
+    for (auto i = m_offsets[v]; i < m_offsets[v + 1]; ++i)
+      fn(m_arcs[i]);
+  }
+
+private:
+  vector<uint32_t> m_offsets;
+  vector<Arc> m_arcs;
+};
+
+// Fills |weights| with the weights of the lightest routes from |source| in |graph|.
+void FindWeights(AdjacencyGraph const & graph, Vertex source, vector<Weight> & weights)
+{
+  auto const numVertices = graph.GetNumVertices();
+  vector<Distance> distances(numVertices, numeric_limits<Distance>::max());
+
+  using State = pair<Distance, Vertex>;
+  priority_queue<State, vector<State>, greater<State>> queue;
+  distances[source] = 0;
+  queue.emplace(0, source);
+
+  while (!queue.empty())
+  {
+    auto const [distance, v] = queue.top();
+    queue.pop();
+    if (distance > distances[v])
+      continue;
+
+    graph.ForEachArc(v, [&](AdjacencyGraph::Arc const & arc) {
+      auto const newDistance = distance + arc.m_weight;
+      if (newDistance < distances[arc.m_target])
+      {
+        distances[arc.m_target] = newDistance;
+        queue.emplace(newDistance, arc.m_target);
+      }
+    });
+  }
+
+  weights.resize(numVertices);
+  for (Vertex v = 0; v < numVertices; ++v)
+  {
+    weights[v] = static_cast<Weight>(
+        min(distances[v], static_cast<Distance>(CrossMwmLandmarks::kInfiniteWeight)));
+  }
+}
+
+double ToSeconds(int64_t weight) { return static_cast<double>(weight) / 1000.0; }
+}  // namespace
+
+// static
+CrossMwmLandmarks CrossMwmLandmarks::Build(CrossMwmTransitions && transitions,
+                                           vector<Edge> const & edges, uint32_t landmarksCount)
+{
+  CrossMwmLandmarks result;
+  result.m_transitions = move(transitions);
+
+  auto const numVertices = result.m_transitions.GetNumVertices();
+  if (numVertices == 0)
+    return result;
+
+  AdjacencyGraph const forwardGraph(numVertices, edges, true /* forward */);
+  AdjacencyGraph const backwardGraph(numVertices, edges, false /* forward */);
+
+  vector<Weight> fromWeights;
+  vector<Weight> toWeights;
+
+  // The first landmark is the farthest reachable vertex from vertex 0.
+  FindWeights(forwardGraph, 0 /* source */, fromWeights);
+  Vertex next = 0;
+  for (Vertex v = 0; v < numVertices; ++v)
+  {
+    if (fromWeights[v] != kInfiniteWeight && fromWeights[v] > fromWeights[next])
+      next = v;
+  }
+
+  // |nearest[v]| is the least sum of the weights of the routes from a chosen landmark to |v| and
+  // back. Unreachable vertices are the farthest ones, so every component gets its landmark.
+  vector<Distance> nearest(numVertices, numeric_limits<Distance>::max());
+  landmarksCount = min(landmarksCount, numVertices);
+  for (uint32_t i = 0; i < landmarksCount; ++i)
+  {
+    result.m_landmarks.push_back(next);
+    FindWeights(forwardGraph, next, fromWeights);
+    FindWeights(backwardGraph, next, toWeights);
+    result.m_fromLandmarks.insert(result.m_fromLandmarks.end(), fromWeights.cbegin(),
+                                  fromWeights.cend());
+    result.m_toLandmarks.insert(result.m_toLandmarks.end(), toWeights.cbegin(), toWeights.cend());
+
+    for (Vertex v = 0; v < numVertices; ++v)
+    {
+      auto const distance =
+          static_cast<Distance>(fromWeights[v]) + static_cast<Distance>(toWeights[v]);
+      nearest[v] = min(nearest[v], distance);
+    }
+
+    next = static_cast<Vertex>(max_element(nearest.cbegin(), nearest.cend()) - nearest.cbegin());
+    // All the vertices are landmarks already.
+    if (nearest[next] == 0)
+      break;
+  }
+
+  return result;
+}
+
+CrossMwmLandmarks::Bounds CrossMwmLandmarks::GetBounds(vector<Vertex> const & vertices) const
+{
+  CHECK(!vertices.empty(), ());
+
+  auto const numLandmarks = m_landmarks.size();
+  Bounds bounds;
+  bounds.m_minFrom.assign(numLandmarks, kInfiniteWeight);
+  bounds.m_maxFrom.assign(numLandmarks, 0);
+  bounds.m_minTo.assign(numLandmarks, kInfiniteWeight);
+  bounds.m_maxTo.assign(numLandmarks, 0);
+
+  for (size_t l = 0; l < numLandmarks; ++l)
+  {
+    for (auto const v : vertices)
+    {
+      auto const from = GetWeightFromLandmark(l, v);
+      auto const to = GetWeightToLandmark(l, v);
+      bounds.m_minFrom[l] = min(bounds.m_minFrom[l], from);
+      bounds.m_maxFrom[l] = max(bounds.m_maxFrom[l], from);
+      bounds.m_minTo[l] = min(bounds.m_minTo[l], to);
+      bounds.m_maxTo[l] = max(bounds.m_maxTo[l], to);
+    }
+  }
+
+  return bounds;
+}
+
+double CrossMwmLandmarks::GetLowerBoundToTargets(Vertex v, Bounds const & targets) const
+{
+  ASSERT_EQUAL(targets.m_minFrom.size(), m_landmarks.size(), ());
+
+  // For target |t| and landmark |l|: w(v, t) >= w(l, t) - w(l, v) and w(v, t) >= w(v, l) - w(t, l).
+  int64_t bound = 0;
+  for (size_t l = 0; l < m_landmarks.size(); ++l)
+  {
+    int64_t const from = GetWeightFromLandmark(l, v);
+    int64_t const to = GetWeightToLandmark(l, v);
+    bound = max(bound, static_cast<int64_t>(targets.m_minFrom[l]) - from);
+    bound = max(bound, to - static_cast<int64_t>(targets.m_maxTo[l]));
+  }
+
+  return ToSeconds(bound);
+}
+
+double CrossMwmLandmarks::GetLowerBoundFromSources(Bounds const & sources, Vertex v) const
+{
+  ASSERT_EQUAL(sources.m_minFrom.size(), m_landmarks.size(), ());
+
+  // For source |s| and landmark |l|: w(s, v) >= w(l, v) - w(l, s) and w(s, v) >= w(s, l) - w(v, l).
+  int64_t bound = 0;
+  for (size_t l = 0; l < m_landmarks.size(); ++l)
+  {
+    int64_t const from = GetWeightFromLandmark(l, v);
+    int64_t const to = GetWeightToLandmark(l, v);
+    bound = max(bound, from - static_cast<int64_t>(sources.m_maxFrom[l]));
+    bound = max(bound, static_cast<int64_t>(sources.m_minTo[l]) - to);
+  }
+
+  return ToSeconds(bound);
+}
+
+void CrossMwmLandmarks::BindNumMwmIds(NumMwmIds const & numMwmIds)
+{
+  auto const & countries = m_transitions.GetCountries();
+  auto const & transitions = m_transitions.GetTransitions();
+
+  m_segmentToVertex.clear();
+  m_segmentToVertex.reserve(transitions.size());
+  for (size_t v = 0; v < transitions.size(); ++v)
+  {
+    auto const & transition = transitions[v];
+    platform::CountryFile const file(countries[transition.m_countryIdx]);
+    if (!numMwmIds.ContainsFile(file))
+      continue;
+
+    Segment const segment(numMwmIds.GetId(file), transition.m_featureId, transition.m_segmentIdx,
+                          transition.m_forward);
+    m_segmentToVertex.emplace(segment, base::asserted_cast<Vertex>(v));
+  }
+}
+
+optional<CrossMwmLandmarks::Vertex> CrossMwmLandmarks::GetVertex(Segment const & segment) const
+{
+  auto const it = m_segmentToVertex.find(segment);
+  if (it == m_segmentToVertex.cend())
+    return {};
+
+  return it->second;
+}
+}  // namespace routing
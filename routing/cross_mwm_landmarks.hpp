@@ -0,0 +1,166 @@
+#pragma once
+
+#include "routing/cross_mwm_transitions.hpp"
+#include "routing/segment.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "3party/skarupke/bytell_hash_map.hpp"
+
+namespace routing
+{
+uint32_t constexpr kLatestVersionCrossMwmLandmarks = 0;
+
+// Landmarks of the transition graph (see CrossMwmTransitions) for the ALT heuristic of leaps.
+// For every landmark the weights of the lightest routes from it to all the vertices and from all
+// the vertices to it are kept, so the weight of a route between two vertices is bounded below
+// by the triangle inequality. For details see "Computing the Shortest Path: A* Search Meets Graph
+// Theory" by A. V. Goldberg and C. Harrelson.
+// Weights are in milliseconds. Weights of the edges are rounded down, so the bounds are not
+// greater than the weights of the routes and the heuristic made of them is consistent.
+// It is stored in CROSS_MWM_LANDMARKS_FILE_TAG section of World.mwm.
+class CrossMwmLandmarks final
+{
+public:
+  using Vertex = CrossMwmTransitions::Vertex;
+  using Weight = uint32_t;
+
+  // Weight of the routes which don't exist. Heavier routes are kept with this weight too,
+  // it doesn't break the bounds.
+  static Weight constexpr kInfiniteWeight = std::numeric_limits<Weight>::max();
+
+  struct Edge
+  {
+    Edge() = default;
+    Edge(Vertex from, Vertex to, double weightSec) : m_from(from), m_to(to), m_weightSec(weightSec)
+    {
+    }
+
+    Vertex m_from = 0;
+    Vertex m_to = 0;
+    double m_weightSec = 0.0;
+  };
+
+  // Bounds of the weights between every landmark and a set of vertices.
+  struct Bounds
+  {
+    bool IsEmpty() const { return m_minFrom.empty(); }
+
+    // |m_minFrom[l]| is the least weight of the routes from landmark |l| to the vertices.
+    std::vector<Weight> m_minFrom;
+    std::vector<Weight> m_maxFrom;
+    // |m_minTo[l]| is the least weight of the routes from the vertices to landmark |l|.
+    std::vector<Weight> m_minTo;
+    std::vector<Weight> m_maxTo;
+  };
+
+  CrossMwmLandmarks() = default;
+
+  // Chooses up to |landmarksCount| landmarks of the graph with |transitions| vertices and |edges|
+  // one by one. The first landmark is the farthest vertex from vertex 0, the next one is
+  // the farthest vertex from the chosen landmarks.
+  static CrossMwmLandmarks Build(CrossMwmTransitions && transitions,
+                                 std::vector<Edge> const & edges, uint32_t landmarksCount);
+
+  CrossMwmTransitions const & GetTransitions() const { return m_transitions; }
+  std::vector<Vertex> const & GetLandmarks() const { return m_landmarks; }
+
+  Weight GetWeightFromLandmark(size_t landmarkIdx, Vertex v) const
+  {
+    return m_fromLandmarks[GetIdx(landmarkIdx, v)];
+  }
+
+  Weight GetWeightToLandmark(size_t landmarkIdx, Vertex v) const
+  {
+    return m_toLandmarks[GetIdx(landmarkIdx, v)];
+  }
+
+  // |vertices| should not be empty.
+  Bounds GetBounds(std::vector<Vertex> const & vertices) const;
+
+  // Returns a lower bound of the weight in seconds of the lightest route from |v| to any of
+  // the vertices of |targets|.
+  double GetLowerBoundToTargets(Vertex v, Bounds const & targets) const;
+  // Returns a lower bound of the weight in seconds of the lightest route from any of the vertices
+  // of |sources| to |v|.
+  double GetLowerBoundFromSources(Bounds const & sources, Vertex v) const;
+
+  // Binds the transitions to the segments of |numMwmIds|. Transitions of the countries which are
+  // not registered in |numMwmIds| are skipped.
+  void BindNumMwmIds(NumMwmIds const & numMwmIds);
+  std::optional<Vertex> GetVertex(Segment const & segment) const;
+
+  template <class Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, kLatestVersionCrossMwmLandmarks);
+
+    m_transitions.Serialize(sink);
+
+    WriteVarUint(sink, static_cast<uint32_t>(m_landmarks.size()));
+    for (auto const landmark : m_landmarks)
+      WriteVarUint(sink, landmark);
+
+    for (auto const weight : m_fromLandmarks)
+      WriteVarUint(sink, weight);
+    for (auto const weight : m_toLandmarks)
+      WriteVarUint(sink, weight);
+  }
+
+  template <class Source>
+  void Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint32_t>(src);
+    CHECK_EQUAL(version, kLatestVersionCrossMwmLandmarks, ("Unknown cross mwm landmarks version."));
+
+    m_transitions.Deserialize(src);
+    auto const numVertices = m_transitions.GetNumVertices();
+
+    m_landmarks.resize(ReadVarUint<uint32_t>(src));
+    for (auto & landmark : m_landmarks)
+    {
+      landmark = ReadVarUint<uint32_t>(src);
+      CHECK_LESS(landmark, numVertices, ());
+    }
+
+    m_fromLandmarks.resize(m_landmarks.size() * numVertices);
+    for (auto & weight : m_fromLandmarks)
+      weight = ReadVarUint<uint32_t>(src);
+    m_toLandmarks.resize(m_landmarks.size() * numVertices);
+    for (auto & weight : m_toLandmarks)
+      weight = ReadVarUint<uint32_t>(src);
+
+    m_segmentToVertex.clear();
+  }
+
+private:
+  size_t GetIdx(size_t landmarkIdx, Vertex v) const
+  {
+    ASSERT_LESS(landmarkIdx, m_landmarks.size(), ());
+    ASSERT_LESS(v, m_transitions.GetNumVertices(), ());
+    return landmarkIdx * m_transitions.GetNumVertices() + v;
+  }
+
+  CrossMwmTransitions m_transitions;
+  std::vector<Vertex> m_landmarks;
+  // |m_fromLandmarks[l * n + v]| is the weight of the lightest route from landmark |l| to vertex
+  // |v| where |n| is the number of vertices. |m_toLandmarks[l * n + v]| is the weight of
+  // the lightest route from |v| to landmark |l|.
+  std::vector<Weight> m_fromLandmarks;
+  std::vector<Weight> m_toLandmarks;
+
+  ska::bytell_hash_map<Segment, Vertex> m_segmentToVertex;
+};
+}  // namespace routing
@@ -0,0 +1,74 @@
+#include "routing/cross_mwm_transitions.hpp"
+
+#include "base/checked_cast.hpp"
+
+#include <functional>
+#include <sstream>
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+CrossMwmTransitions::CrossMwmTransitions(vector<string> && countries,
+                                         vector<Transition> && transitions)
+  : m_countries(move(countries)), m_transitions(move(transitions))
+{
+  BuildIndex();
+}
+
+optional<CrossMwmTransitions::Vertex> CrossMwmTransitions::GetVertex(string const & country,
+                                                                     uint32_t featureId,
+                                                                     uint32_t segmentIdx,
+                                                                     bool forward) const
+{
+  auto const countryIt = m_countryToIdx.find(country);
+  if (countryIt == m_countryToIdx.cend())
+    return {};
+
+  auto const it = m_keyToVertex.find({countryIt->second, featureId, segmentIdx, forward});
+  if (it == m_keyToVertex.cend())
+    return {};
+
+  return it->second;
+}
+
+size_t CrossMwmTransitions::HashKey::operator()(Key const & key) const
+{
+  auto const featureKey = (static_cast<uint64_t>(key.m_featureId) << 32) +
+                          (static_cast<uint64_t>(key.m_segmentIdx) << 1) + (key.m_forward ? 1 : 0);
+  return hash<uint64_t>()(featureKey) ^ (hash<uint32_t>()(key.m_countryIdx) << 1);
+}
+
+void CrossMwmTransitions::BuildIndex()
+{
+  m_countryToIdx.clear();
+  for (size_t i = 0; i < m_countries.size(); ++i)
+    m_countryToIdx.emplace(m_countries[i], base::asserted_cast<uint32_t>(i));
+
+  m_keyToVertex.clear();
+  m_keyToVertex.reserve(m_transitions.size());
+  for (size_t v = 0; v < m_transitions.size(); ++v)
+  {
+    auto const & t = m_transitions[v];
+    CHECK_LESS(t.m_countryIdx, m_countries.size(), ());
+    bool const inserted =
+        m_keyToVertex
+            .emplace(Key{t.m_countryIdx, t.m_featureId, t.m_segmentIdx, t.m_forward},
+                     base::asserted_cast<Vertex>(v))
+            .second;
+    CHECK(inserted, ("Duplicate transition", m_countries[t.m_countryIdx], t.m_featureId,
+                     t.m_segmentIdx, t.m_forward));
+  }
+}
+
+string DebugPrint(CrossMwmTransitions::Transition const & transition)
+{
+  ostringstream out;
+  out << "Transition [ country index: " << transition.m_countryIdx
+      << ", feature id: " << transition.m_featureId
+      << ", segment index: " << transition.m_segmentIdx << ", forward: " << transition.m_forward
+      << ", is enter: " << transition.m_isEnter << " ]";
+  return out.str();
+}
+}  // namespace routing
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace routing
+{
+// Car transition segments of all the mwms. Transition |v| is vertex |v| of the transition graph:
+// every enter of an mwm is connected with exits of the same mwm by the cross-mwm weights and
+// every exit is connected with its twin enter of the neighbouring mwm by a cross-border penalty.
+class CrossMwmTransitions final
+{
+public:
+  using Vertex = uint32_t;
+
+  struct Transition
+  {
+    Transition() = default;
+    Transition(uint32_t countryIdx, uint32_t featureId, uint32_t segmentIdx, bool forward,
+               bool isEnter)
+      : m_countryIdx(countryIdx)
+      , m_featureId(featureId)
+      , m_segmentIdx(segmentIdx)
+      , m_forward(forward)
+      , m_isEnter(isEnter)
+    {
+    }
+
+    bool operator==(Transition const & rhs) const
+    {
+      return m_countryIdx == rhs.m_countryIdx && m_featureId == rhs.m_featureId &&
+             m_segmentIdx == rhs.m_segmentIdx && m_forward == rhs.m_forward &&
+             m_isEnter == rhs.m_isEnter;
+    }
+
+    // Index in GetCountries().
+    uint32_t m_countryIdx = 0;
+    uint32_t m_featureId = 0;
+    uint32_t m_segmentIdx = 0;
+    bool m_forward = true;
+    bool m_isEnter = true;
+  };
+
+  CrossMwmTransitions() = default;
+  CrossMwmTransitions(std::vector<std::string> && countries,
+                      std::vector<Transition> && transitions);
+
+  std::vector<std::string> const & GetCountries() const { return m_countries; }
+  std::vector<Transition> const & GetTransitions() const { return m_transitions; }
+  uint32_t GetNumVertices() const { return static_cast<uint32_t>(m_transitions.size()); }
+  bool HasCountry(std::string const & country) const { return m_countryToIdx.count(country) != 0; }
+
+  // Returns the vertex of the transition segment of |country|.
+  std::optional<Vertex> GetVertex(std::string const & country, uint32_t featureId,
+                                  uint32_t segmentIdx, bool forward) const;
+
+  template <class Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteVarUint(sink, static_cast<uint32_t>(m_countries.size()));
+    for (auto const & country : m_countries)
+      rw::Write(sink, country);
+
+    WriteVarUint(sink, static_cast<uint32_t>(m_transitions.size()));
+    for (auto const & transition : m_transitions)
+    {
+      WriteVarUint(sink, transition.m_countryIdx);
+      WriteVarUint(sink, transition.m_featureId);
+      WriteVarUint(sink, transition.m_segmentIdx);
+      uint8_t const flags = (transition.m_forward ? 1 : 0) | (transition.m_isEnter ? 2 : 0);
+      WriteToSink(sink, flags);
+    }
+  }
+
+  template <class Source>
+  void Deserialize(Source & src)
+  {
+    m_countries.resize(ReadVarUint<uint32_t>(src));
+    for (auto & country : m_countries)
+      rw::Read(src, country);
+
+    m_transitions.resize(ReadVarUint<uint32_t>(src));
+    for (auto & transition : m_transitions)
+    {
+      transition.m_countryIdx = ReadVarUint<uint32_t>(src);
+      CHECK_LESS(transition.m_countryIdx, m_countries.size(), ());
+      transition.m_featureId = ReadVarUint<uint32_t>(src);
+      transition.m_segmentIdx = ReadVarUint<uint32_t>(src);
+      auto const flags = ReadPrimitiveFromSource<uint8_t>(src);
+      transition.m_forward = (flags & 1) != 0;
+      transition.m_isEnter = (flags & 2) != 0;
+    }
+
+    BuildIndex();
+  }
+
+private:
+  struct Key
+  {
+    bool operator==(Key const & rhs) const
+    {
+      return m_countryIdx == rhs.m_countryIdx && m_featureId == rhs.m_featureId &&
+             m_segmentIdx == rhs.m_segmentIdx && m_forward == rhs.m_forward;
+    }
+
+    uint32_t m_countryIdx = 0;
+    uint32_t m_featureId = 0;
+    uint32_t m_segmentIdx = 0;
+    bool m_forward = true;
+  };
+
+  struct HashKey
+  {
+    size_t operator()(Key const & key) const;
+  };
+
+  void BuildIndex();
+
+  std::vector<std::string> m_countries;
+  std::vector<Transition> m_transitions;
+
+  std::unordered_map<std::string, uint32_t> m_countryToIdx;
+  // Transition segment is either enter or exit, so |m_isEnter| is not a part of the key.
+  std::unordered_map<Key, Vertex, HashKey> m_keyToVertex;
+};
+
+std::string DebugPrint(CrossMwmTransitions::Transition const & transition);
+}  // namespace routing
@@ -13,16 +13,37 @@
 #include "geometry/mercator.hpp"
 #include "geometry/point2d.hpp"
 
+#include "base/executor.hpp"
+
+#include <algorithm>
 #include <cstdlib>
+#include <future>
+#include <thread>
 #include <utility>
 
 namespace
 {
+// Thread pool is not worth it for short routes.
+size_t constexpr kMinFeaturesPerThread = 512;
+size_t constexpr kMaxThreadsNumber = 4;
+
 bool IsFakeFeature(uint32_t featureId)
 {
   return routing::FakeFeatureIds::IsGuidesFeature(featureId) ||
          routing::FakeFeatureIds::IsTransitFeature(featureId);
 }
+
+// Edges of a joint of the route which are needed to make a LoadedPathSegment and turn
+// candidates of the joint.
+struct JointEdges
+{
+  routing::IRoadGraph::EdgeVector m_outgoingEdges;
+  size_t m_ingoingEdgesNumber = 0;
+  size_t m_inEdgeIdx = 0;
+  uint32_t m_startSegId = 0;
+  std::vector<geometry::PointWithAltitude> m_junctions;
+  std::vector<routing::Segment> m_segments;
+};
 }  // namespace
 
 namespace routing
@@ -35,37 +56,99 @@ void DirectionsEngine::Clear()
 {
   m_adjacentEdges.clear();
   m_pathSegments.clear();
-  m_loader.reset();
+  m_loadedFeatureIds.clear();
+  m_featuresAttributes.clear();
 }
 
-FeaturesLoaderGuard & DirectionsEngine::GetLoader(MwmSet::MwmId const & id)
+void DirectionsEngine::LoadFeaturesAttributes(vector<FeatureID> && featureIds,
+                                              base::Cancellable const & cancellable)
 {
-  if (!m_loader || id != m_loader->GetId())
-    m_loader = make_unique<FeaturesLoaderGuard>(m_dataSource, id);
-  return *m_loader;
+  featureIds.erase(remove_if(featureIds.begin(), featureIds.end(),
+                             [](FeatureID const & featureId) {
+                               return !featureId.IsValid() || IsFakeFeature(featureId.m_index);
+                             }),
+                   featureIds.end());
+  sort(featureIds.begin(), featureIds.end());
+  featureIds.erase(unique(featureIds.begin(), featureIds.end()), featureIds.end());
+
+  m_loadedFeatureIds = move(featureIds);
+  m_featuresAttributes.assign(m_loadedFeatureIds.size(), {});
+
+  // Features are sorted by mwm so a thread takes a few loaders for its range of features.
+  auto const loadRange = [this, &cancellable](size_t begin, size_t end) {
+    unique_ptr<FeaturesLoaderGuard> loader;
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (cancellable.IsCancelled())
+        return;
+
+      auto const & featureId = m_loadedFeatureIds[i];
+      if (!loader || loader->GetId() != featureId.m_mwmId)
+        loader = make_unique<FeaturesLoaderGuard>(m_dataSource, featureId.m_mwmId);
+
+      auto ft = loader->GetFeatureByIndex(featureId.m_index);
+      if (!ft)
+        continue;
+
+      auto & attributes = m_featuresAttributes[i].emplace();
+      attributes.m_highwayClass = ftypes::GetHighwayClass(feature::TypesHolder(*ft));
+      attributes.m_isLink = ftypes::IsLinkChecker::Instance()(*ft);
+      attributes.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(*ft);
+      ft->GetName(StringUtf8Multilang::kDefaultCode, attributes.m_name);
+    }
+  };
+
+  size_t const featuresNumber = m_loadedFeatureIds.size();
+  size_t const threadsNumber =
+      min({featuresNumber / kMinFeaturesPerThread,
+           static_cast<size_t>(max(thread::hardware_concurrency(), 1U)), kMaxThreadsNumber});
+  if (threadsNumber <= 1)
+  {
+    loadRange(0, featuresNumber);
+    return;
+  }
+
+  vector<future<void>> results;
+  auto & executor = base::Executor::Instance();
+  size_t const rangeSize = (featuresNumber + threadsNumber - 1) / threadsNumber;
+  for (size_t begin = 0; begin < featuresNumber; begin += rangeSize)
+  {
+    results.emplace_back(executor.Submit(base::Executor::Priority::Routing, loadRange, begin,
+                                         min(begin + rangeSize, featuresNumber)));
+  }
+
+  // All the tasks must finish before an exception leaves the frame they reference.
+  for (auto & result : results)
+    result.wait();
+  for (auto & result : results)
+    result.get();
 }
 
-void DirectionsEngine::LoadPathAttributes(FeatureID const & featureId,
-                                          LoadedPathSegment & pathSegment)
+DirectionsEngine::FeatureAttributes const * DirectionsEngine::GetFeatureAttributes(
+    FeatureID const & featureId) const
 {
-  if (!featureId.IsValid())
-    return;
+  auto const it = lower_bound(m_loadedFeatureIds.cbegin(), m_loadedFeatureIds.cend(), featureId);
+  if (it == m_loadedFeatureIds.cend() || *it != featureId)
+    return nullptr;
 
-  if (IsFakeFeature(featureId.m_index))
-    return;
+  auto const & attributes = m_featuresAttributes[distance(m_loadedFeatureIds.cbegin(), it)];
+  return attributes ? &*attributes : nullptr;
+}
 
-  auto ft = GetLoader(featureId.m_mwmId).GetFeatureByIndex(featureId.m_index);
-  if (!ft)
+void DirectionsEngine::LoadPathAttributes(FeatureID const & featureId,
+                                          LoadedPathSegment & pathSegment)
+{
+  auto const * attributes = GetFeatureAttributes(featureId);
+  if (!attributes)
     return;
 
-  auto const highwayClass = ftypes::GetHighwayClass(feature::TypesHolder(*ft));
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Error, ());
-  ASSERT_NOT_EQUAL(highwayClass, ftypes::HighwayClass::Undefined, ());
+  ASSERT_NOT_EQUAL(attributes->m_highwayClass, ftypes::HighwayClass::Error, ());
+  ASSERT_NOT_EQUAL(attributes->m_highwayClass, ftypes::HighwayClass::Undefined, ());
 
-  pathSegment.m_highwayClass = highwayClass;
-  pathSegment.m_isLink = ftypes::IsLinkChecker::Instance()(*ft);
-  ft->GetName(StringUtf8Multilang::kDefaultCode, pathSegment.m_name);
-  pathSegment.m_onRoundabout = ftypes::IsRoundAboutChecker::Instance()(*ft);
+  pathSegment.m_highwayClass = attributes->m_highwayClass;
+  pathSegment.m_isLink = attributes->m_isLink;
+  pathSegment.m_name = attributes->m_name;
+  pathSegment.m_onRoundabout = attributes->m_onRoundabout;
 }
 
 void DirectionsEngine::GetSegmentRangeAndAdjacentEdges(IRoadGraph::EdgeVector const & outgoingEdges,
@@ -87,15 +170,11 @@ void DirectionsEngine::GetSegmentRangeAndAdjacentEdges(IRoadGraph::EdgeVector co
     if (edge.IsFake())
       continue;
 
-    auto const & outFeatureId = edge.GetFeatureId();
-    if (IsFakeFeature(outFeatureId.m_index))
-      continue;
-
-    auto ft = GetLoader(outFeatureId.m_mwmId).GetFeatureByIndex(outFeatureId.m_index);
-    if (!ft)
+    auto const * attributes = GetFeatureAttributes(edge.GetFeatureId());
+    if (!attributes)
       continue;
 
-    auto const highwayClass = ftypes::GetHighwayClass(feature::TypesHolder(*ft));
+    auto const highwayClass = attributes->m_highwayClass;
     ASSERT_NOT_EQUAL(
         highwayClass, ftypes::HighwayClass::Error,
         (mercator::ToLatLon(edge.GetStartPoint()), mercator::ToLatLon(edge.GetEndPoint())));
@@ -103,7 +182,7 @@ void DirectionsEngine::GetSegmentRangeAndAdjacentEdges(IRoadGraph::EdgeVector co
         highwayClass, ftypes::HighwayClass::Undefined,
         (mercator::ToLatLon(edge.GetStartPoint()), mercator::ToLatLon(edge.GetEndPoint())));
 
-    bool const isLink = ftypes::IsLinkChecker::Instance()(*ft);
+    bool const isLink = attributes->m_isLink;
 
     double angle = 0;
 
@@ -161,6 +240,8 @@ void DirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
   uint32_t startSegId = kInvalidSegId;
   vector<geometry::PointWithAltitude> prevJunctions;
   vector<Segment> prevSegments;
+  vector<JointEdges> joints;
+  vector<FeatureID> featureIds;
   for (size_t i = 1; i < pathSize; ++i)
   {
     if (cancellable.IsCancelled())
@@ -197,22 +278,52 @@ void DirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
 
     prevJunctions.push_back(currJunction);
 
-    AdjacentEdges adjacentEdges(ingoingEdges.size());
+    featureIds.push_back(inFeatureId);
+    for (auto const & edge : outgoingEdges)
+    {
+      if (!edge.IsFake())
+        featureIds.push_back(edge.GetFeatureId());
+    }
+
+    JointEdges joint;
+    joint.m_outgoingEdges = move(outgoingEdges);
+    joint.m_ingoingEdgesNumber = ingoingEdges.size();
+    joint.m_inEdgeIdx = i - 1;
+    joint.m_startSegId = startSegId;
+    joint.m_junctions = move(prevJunctions);
+    joint.m_segments = move(prevSegments);
+    joints.push_back(move(joint));
+
+    prevJunctions.clear();
+    prevSegments.clear();
+    startSegId = kInvalidSegId;
+  }
+
+  LoadFeaturesAttributes(move(featureIds), cancellable);
+
+  for (auto & joint : joints)
+  {
+    if (cancellable.IsCancelled())
+      return;
+
+    Edge const & inEdge = routeEdges[joint.m_inEdgeIdx];
+    AdjacentEdges adjacentEdges(joint.m_ingoingEdgesNumber);
     SegmentRange segmentRange;
-    GetSegmentRangeAndAdjacentEdges(outgoingEdges, inEdge, startSegId, inSegId, segmentRange,
+    GetSegmentRangeAndAdjacentEdges(joint.m_outgoingEdges, inEdge, joint.m_startSegId,
+                                    inEdge.GetSegId(), segmentRange,
                                     adjacentEdges.m_outgoingTurns);
 
-    size_t const prevJunctionSize = prevJunctions.size();
+    size_t const prevJunctionSize = joint.m_junctions.size();
     LoadedPathSegment pathSegment;
     LoadPathAttributes(segmentRange.GetFeature(), pathSegment);
     pathSegment.m_segmentRange = segmentRange;
-    pathSegment.m_path = move(prevJunctions);
+    pathSegment.m_path = move(joint.m_junctions);
     // @TODO(bykoianko) |pathSegment.m_weight| should be filled here.
 
-    // |prevSegments| contains segments which corresponds to road edges between joints. In case of a
-    // fake edge a fake segment is created.
-    CHECK_EQUAL(prevSegments.size() + 1, prevJunctionSize, ());
-    pathSegment.m_segments = move(prevSegments);
+    // |joint.m_segments| contains segments which corresponds to road edges between joints. In case
+    // of a fake edge a fake segment is created.
+    CHECK_EQUAL(joint.m_segments.size() + 1, prevJunctionSize, ());
+    pathSegment.m_segments = move(joint.m_segments);
 
     if (!segmentRange.IsEmpty())
     {
@@ -221,10 +332,6 @@ void DirectionsEngine::FillPathSegmentsAndAdjacentEdgesMap(
     }
 
     m_pathSegments.push_back(move(pathSegment));
-
-    prevJunctions.clear();
-    prevSegments.clear();
-    startSegId = kInvalidSegId;
   }
 }
 }  // namespace routing
@@ -10,6 +10,8 @@
 #include "traffic/traffic_info.hpp"
 
 #include "indexer/data_source.hpp"
+#include "indexer/feature_decl.hpp"
+#include "indexer/ftypes_matcher.hpp"
 
 #include "geometry/point_with_altitude.hpp"
 
@@ -17,6 +19,8 @@
 #include "base/cancellable.hpp"
 
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 namespace routing
@@ -48,7 +52,23 @@ public:
   void SetVehicleType(VehicleType const & vehicleType) { m_vehicleType = vehicleType; }
 
 protected:
-  FeaturesLoaderGuard & GetLoader(MwmSet::MwmId const & id);
+  // Attributes of a road feature which are used for turns generation.
+  struct FeatureAttributes
+  {
+    ftypes::HighwayClass m_highwayClass = ftypes::HighwayClass::Undefined;
+    bool m_isLink = false;
+    bool m_onRoundabout = false;
+    std::string m_name;
+  };
+
+  /// \brief Loads attributes of |featureIds|. Features of long routes are loaded in parallel,
+  /// every thread with its own FeaturesLoaderGuard.
+  void LoadFeaturesAttributes(std::vector<FeatureID> && featureIds,
+                              base::Cancellable const & cancellable);
+  /// \returns attributes loaded by LoadFeaturesAttributes() or nullptr if |featureId| is fake or
+  /// can't be loaded.
+  FeatureAttributes const * GetFeatureAttributes(FeatureID const & featureId) const;
+
   void LoadPathAttributes(FeatureID const & featureId, LoadedPathSegment & pathSegment);
   void GetSegmentRangeAndAdjacentEdges(IRoadGraph::EdgeVector const & outgoingEdges,
                                        Edge const & inEdge, uint32_t startSegId, uint32_t endSegId,
@@ -56,6 +76,8 @@ protected:
                                        turns::TurnCandidates & outgoingTurns);
   /// \brief The method gathers sequence of segments according to IsJoint() method
   /// and fills |m_adjacentEdges| and |m_pathSegments|.
+  /// \note Road graph is not thread safe so the edges are taken on the calling thread. Then
+  /// features of the route and of the turn candidates are loaded in parallel.
   void FillPathSegmentsAndAdjacentEdgesMap(IndexRoadGraph const & graph,
                                            std::vector<geometry::PointWithAltitude> const & path,
                                            IRoadGraph::EdgeVector const & routeEdges,
@@ -70,7 +92,9 @@ protected:
 
   DataSource const & m_dataSource;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
-  std::unique_ptr<FeaturesLoaderGuard> m_loader;
+  // Sorted ids of the loaded features and their attributes.
+  std::vector<FeatureID> m_loadedFeatureIds;
+  std::vector<std::optional<FeatureAttributes>> m_featuresAttributes;
   VehicleType m_vehicleType = VehicleType::Count;
 };
 }  // namespace routing
@@ -91,7 +91,7 @@ public:
     return RouteWeight(ms::DistanceOnEarth(from, to));
   }
 
-  double CalculateETA(Segment const & from, Segment const & to) override
+  double CalculateETA(Segment const & from, Segment const & to, double secondsToFrom) override
   {
     UNREACHABLE();
   }
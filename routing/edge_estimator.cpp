@@ -198,6 +198,14 @@ double EdgeEstimator::CalcOffroad(ms::LatLon const & from, ms::LatLon const & to
   return TimeBetweenSec(from, to, KMPH2MPS(offroadSpeedKMpH));
 }
 
+double EdgeEstimator::CalcSegmentWeightAtTime(Segment const & segment, RoadGeometry const & road,
+                                              Purpose purpose,
+                                              SpeedProfiles const & /* speedProfiles */,
+                                              time_t /* time */) const
+{
+  return CalcSegmentWeight(segment, road, purpose);
+}
+
 // PedestrianEstimator -----------------------------------------------------------------------------
 class PedestrianEstimator final : public EdgeEstimator
 {
@@ -267,6 +275,9 @@ public:
   // EdgeEstimator overrides:
   double CalcSegmentWeight(Segment const & segment, RoadGeometry const & road,
                            Purpose purpose) const override;
+  double CalcSegmentWeightAtTime(Segment const & segment, RoadGeometry const & road,
+                                 Purpose purpose, SpeedProfiles const & speedProfiles,
+                                 time_t time) const override;
   double GetUTurnPenalty(Purpose /* purpose */) const override;
   double GetFerryLandingPenalty(Purpose purpose) const override;
 
@@ -289,6 +300,24 @@ double CarEstimator::CalcSegmentWeight(Segment const & segment, RoadGeometry con
   return CalcSegment(purpose, segment, road);
 }
 
+double CarEstimator::CalcSegmentWeightAtTime(Segment const & segment, RoadGeometry const & road,
+                                             Purpose purpose, SpeedProfiles const & speedProfiles,
+                                             time_t time) const
+{
+  // Live traffic is more accurate than the typical speeds.
+  if (m_trafficStash && m_trafficStash->GetSpeedGroup(segment) != SpeedGroup::Unknown)
+    return CalcSegment(purpose, segment, road);
+
+  double const result = CalcClimbSegment(purpose, segment, road, GetCarClimbPenalty);
+  auto const speedFactor =
+      speedProfiles.GetSpeedFactor(segment.GetFeatureId(), segment.IsForward(), time);
+  if (!speedFactor)
+    return result;
+
+  CHECK_GREATER(*speedFactor, 0.0, (segment));
+  return result / *speedFactor;
+}
+
 double CarEstimator::GetUTurnPenalty(Purpose /* purpose */) const
 {
   // Adds 2 minutes penalty for U-turn. The value is quite arbitrary
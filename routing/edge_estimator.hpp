@@ -2,6 +2,7 @@
 
 #include "routing/geometry.hpp"
 #include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
 #include "routing/traffic_stash.hpp"
 #include "routing/vehicle_mask.hpp"
 
@@ -14,6 +15,7 @@
 
 #include "geometry/point2d.hpp"
 
+#include <ctime>
 #include <memory>
 #include <unordered_map>
 
@@ -48,6 +50,11 @@ public:
 
   virtual double CalcSegmentWeight(Segment const & segment, RoadGeometry const & road,
                                    Purpose purpose) const = 0;
+  // Estimates the segment weight when the segment is entered at the local |time|. Typical speeds
+  // of |speedProfiles| are used by the estimators which take them into account.
+  virtual double CalcSegmentWeightAtTime(Segment const & segment, RoadGeometry const & road,
+                                         Purpose purpose, SpeedProfiles const & speedProfiles,
+                                         time_t time) const;
   virtual double GetUTurnPenalty(Purpose purpose) const = 0;
   virtual double GetFerryLandingPenalty(Purpose purpose) const = 0;
 
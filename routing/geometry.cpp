@@ -2,6 +2,7 @@
 
 #include "routing/city_roads.hpp"
 #include "routing/maxspeeds.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/routing_exceptions.hpp"
 #include "routing/routing_options.hpp"
 
@@ -68,8 +69,12 @@ private:
   shared_ptr<VehicleModelInterface> m_vehicleModel;
   AttrLoader m_attrLoader;
   FeaturesLoaderGuard m_guard;
+  // Reused for all the loaded features.
+  unique_ptr<FeatureType> m_feature;
   string const m_country;
   feature::AltitudeLoader m_altitudeLoader;
+  // Reused for all the loaded features.
+  geometry::Altitudes m_altitudes;
   bool const m_loadAltitudes;
 };
 
@@ -92,19 +97,20 @@ GeometryLoaderImpl::GeometryLoaderImpl(DataSource const & dataSource,
 
 void GeometryLoaderImpl::Load(uint32_t featureId, RoadGeometry & road)
 {
-  auto feature = m_guard.GetFeatureByIndex(featureId);
-  if (!feature)
+  if (!m_guard.GetFeatureByIndex(featureId, m_feature))
     MYTHROW(RoutingException, ("Feature", featureId, "not found in ", m_country));
 
-  feature->ParseGeometry(FeatureType::BEST_GEOMETRY);
+  m_feature->ParseGeometry(FeatureType::BEST_GEOMETRY);
 
   geometry::Altitudes const * altitudes = nullptr;
   if (m_loadAltitudes)
-    altitudes = &(m_altitudeLoader.GetAltitudes(featureId, feature->GetPointsCount()));
+  {
+    m_altitudeLoader.GetAltitudes(featureId, m_feature->GetPointsCount(), m_altitudes);
+    altitudes = &m_altitudes;
+  }
 
-  road.Load(*m_vehicleModel, *feature, altitudes, m_attrLoader.m_cityRoads->IsCityRoad(featureId),
+  road.Load(*m_vehicleModel, *m_feature, altitudes, m_attrLoader.m_cityRoads->IsCityRoad(featureId),
             m_attrLoader.m_maxspeeds->GetMaxspeed(featureId));
-  m_altitudeLoader.ClearCache();
 }
 
 // FileGeometryLoader ------------------------------------------------------------------------------
@@ -260,11 +266,29 @@ Geometry::Geometry(unique_ptr<GeometryLoader> loader, size_t roadsCacheSize)
   CHECK(m_loader, ());
 }
 
+Geometry::Geometry(unique_ptr<GeometryLoader> loader, RoadGeometryCache & sharedCache,
+                   RoadGeometryKey const & roadsKey, size_t roadsCacheSize)
+  : m_loader(move(loader))
+  , m_featureIdToSharedRoad(make_unique<SharedRoadsFifoCache>(
+        roadsCacheSize,
+        [this, &sharedCache, roadsKey](uint32_t featureId, shared_ptr<RoadGeometry const> & road) {
+          auto key = roadsKey;
+          key.m_featureId = featureId;
+          road = sharedCache.GetRoad(
+              key, [this, featureId](RoadGeometry & loaded) { m_loader->Load(featureId, loaded); });
+        }))
+{
+  CHECK(m_loader, ());
+}
+
 RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
 {
-  ASSERT(m_featureIdToRoad, ());
   ASSERT(m_loader, ());
 
+  if (m_featureIdToSharedRoad)
+    return *m_featureIdToSharedRoad->GetValue(featureId);
+
+  ASSERT(m_featureIdToRoad, ());
   return m_featureIdToRoad->GetValue(featureId);
 }
 
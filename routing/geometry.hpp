@@ -32,10 +32,15 @@ namespace routing
 // Maximum road geometry cache size in items.
 size_t constexpr kRoadsCacheSize = 5000;
 
+class RoadGeometryCache;
+struct RoadGeometryKey;
+
 class RoadGeometry final
 {
 public:
-  using Points = buffer_vector<m2::PointD, 32>;
+  static size_t constexpr kStaticPointsCount = 32;
+
+  using Points = buffer_vector<m2::PointD, kStaticPointsCount>;
 
   RoadGeometry() = default;
   RoadGeometry(bool oneWay, double weightSpeedKMpH, double etaSpeedKMpH, Points const & points);
@@ -86,7 +91,7 @@ private:
 
   double GetRoadLengthM() const;
 
-  buffer_vector<LatLonWithAltitude, 32> m_junctions;
+  buffer_vector<LatLonWithAltitude, kStaticPointsCount> m_junctions;
   SpeedKMpH m_forwardSpeed;
   SpeedKMpH m_backwardSpeed;
   std::optional<HighwayType> m_highwayType;
@@ -128,7 +133,8 @@ public:
 };
 
 /// \brief This class supports loading geometry of roads for routing.
-/// \note Loaded information about road geometry is kept in a fixed-size cache |m_featureIdToRoad|.
+/// \note Loaded information about road geometry is kept in a fixed-size cache |m_featureIdToRoad|
+/// or, if roads are shared between instances, in RoadGeometryCache.
 /// On the other hand methods GetRoad() and GetPoint() return geometry information by reference.
 /// The reference may be invalid after the next call of GetRoad() or GetPoint() because the cache
 /// item which is referred by returned reference may be evicted. It's done for performance reasons.
@@ -143,6 +149,13 @@ public:
   /// \param roadsCacheSize in-memory geometry elements count limit
   Geometry(std::unique_ptr<GeometryLoader> loader, size_t roadsCacheSize = kRoadsCacheSize);
 
+  /// \brief Geometry constructor with roads shared with other Geometry instances.
+  /// \param sharedCache cache to look for roads before loading them by |loader|.
+  /// \param roadsKey key of the roads loaded by |loader| in |sharedCache|. Feature id is ignored.
+  /// \param roadsCacheSize in-memory count limit of roads pointers kept by the instance.
+  Geometry(std::unique_ptr<GeometryLoader> loader, RoadGeometryCache & sharedCache,
+           RoadGeometryKey const & roadsKey, size_t roadsCacheSize = kRoadsCacheSize);
+
   /// \note The reference returned by the method is valid until the next call of GetRoad()
   /// of GetPoint() methods.
   RoadGeometry const & GetRoad(uint32_t featureId);
@@ -158,7 +171,14 @@ private:
   using RoutingFifoCache =
       FifoCache<uint32_t, RoadGeometry, ska::bytell_hash_map<uint32_t, RoadGeometry>>;
 
+  using SharedRoadsFifoCache =
+      FifoCache<uint32_t, std::shared_ptr<RoadGeometry const>,
+                ska::bytell_hash_map<uint32_t, std::shared_ptr<RoadGeometry const>>>;
+
   std::unique_ptr<GeometryLoader> m_loader;
   std::unique_ptr<RoutingFifoCache> m_featureIdToRoad;
+  // Used instead of |m_featureIdToRoad| if roads are shared. Pointers keep roads valid after
+  // eviction from the shared cache.
+  std::unique_ptr<SharedRoadsFifoCache> m_featureIdToSharedRoad;
 };
 }  // namespace routing
@@ -0,0 +1,300 @@
+#include "routing/hmm_map_matcher.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+using namespace std;
+
+namespace
+{
+double constexpr kImpossible = -numeric_limits<double>::infinity();
+double constexpr kEpsM = 0.01;
+}  // namespace
+
+namespace routing
+{
+HmmMapMatcher::HmmMapMatcher(Graph & graph) : HmmMapMatcher(graph, Params()) {}
+
+HmmMapMatcher::HmmMapMatcher(Graph & graph, Params const & params)
+  : m_graph(graph), m_params(params), m_searches(params.m_maxCachedSearches)
+{
+  CHECK_GREATER(m_params.m_sigmaM, 0.0, ());
+  CHECK_GREATER(m_params.m_betaM, 0.0, ());
+  CHECK_GREATER(m_params.m_windowSize, 1, ());
+}
+
+void HmmMapMatcher::Match(vector<m2::PointD> const & points, vector<MatchedPiece> & pieces)
+{
+  m_layers.clear();
+  MatchedPiece piece;
+
+  auto const finishPiece = [&]() {
+    if (m_layers.empty())
+      return;
+
+    CommitWindow(piece);
+    Layer const & last = m_layers.back();
+    piece.emplace_back(last.m_pointIdx, last.m_candidates.front().m_segment);
+    m_layers.clear();
+    pieces.push_back(move(piece));
+    piece.clear();
+  };
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    Layer layer;
+    layer.m_pointIdx = i;
+    m_graph.GetCandidates(points[i], m_params.m_candidatesRadiusM, layer.m_candidates);
+    RemoveEndpointDuplicates(layer.m_candidates);
+    if (layer.m_candidates.empty())
+      continue;
+
+    if (!m_layers.empty())
+    {
+      Layer const & prevLayer = m_layers.back();
+      if (FillScores(prevLayer, points[prevLayer.m_pointIdx], layer, points[i]))
+      {
+        m_layers.push_back(move(layer));
+        if (m_layers.size() >= m_params.m_windowSize)
+          CommitWindow(piece);
+        continue;
+      }
+      finishPiece();
+    }
+
+    layer.m_scores.clear();
+    for (auto const & candidate : layer.m_candidates)
+      layer.m_scores.push_back(GetEmissionScore(candidate));
+    layer.m_parents.assign(layer.m_candidates.size(), -1);
+    layer.m_routesM.assign(layer.m_candidates.size(), 0.0);
+    m_layers.push_back(move(layer));
+  }
+
+  finishPiece();
+}
+
+void HmmMapMatcher::RemoveEndpointDuplicates(vector<Candidate> & candidates)
+{
+  auto const isInner = [this](Candidate const & candidate) {
+    return candidate.m_offsetM > kEpsM &&
+           candidate.m_offsetM < m_graph.GetLengthM(candidate.m_segment) - kEpsM;
+  };
+
+  vector<bool> inner(candidates.size());
+  for (size_t i = 0; i < candidates.size(); ++i)
+    inner[i] = isInner(candidates[i]);
+
+  auto const isDuplicate = [&](size_t i) {
+    if (inner[i])
+      return false;
+
+    Segment const & segment = candidates[i].m_segment;
+    for (size_t j = 0; j < candidates.size(); ++j)
+    {
+      Segment const & other = candidates[j].m_segment;
+      if (inner[j] && other.GetMwmId() == segment.GetMwmId() &&
+          other.GetFeatureId() == segment.GetFeatureId() &&
+          other.IsForward() == segment.IsForward() &&
+          (other.GetSegmentIdx() + 1 == segment.GetSegmentIdx() ||
+           segment.GetSegmentIdx() + 1 == other.GetSegmentIdx()))
+      {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  size_t kept = 0;
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    if (!isDuplicate(i))
+      candidates[kept++] = candidates[i];
+  }
+  candidates.resize(kept);
+}
+
+double HmmMapMatcher::GetEmissionScore(Candidate const & candidate) const
+{
+  double const normalized = candidate.m_distanceM / m_params.m_sigmaM;
+  return -0.5 * normalized * normalized;
+}
+
+double HmmMapMatcher::GetRoadDistanceM(Candidate const & from, Candidate const & to,
+                                       double maxDistanceM)
+{
+  if (from.m_segment == to.m_segment && to.m_offsetM >= from.m_offsetM)
+    return to.m_offsetM - from.m_offsetM;
+
+  double const restM = max(m_graph.GetLengthM(from.m_segment) - from.m_offsetM, 0.0);
+  auto const & search = GetSearch(from.m_segment, maxDistanceM);
+  auto const it = search.m_distances.find(to.m_segment);
+  if (it == search.m_distances.cend())
+    return -1.0;
+
+  double const distanceM = restM + it->second + to.m_offsetM;
+  return distanceM <= maxDistanceM ? distanceM : -1.0;
+}
+
+HmmMapMatcher::Search const & HmmMapMatcher::GetSearch(Segment const & from, double maxDistanceM)
+{
+  ++m_searchesCount;
+  bool found = false;
+  Search & search = m_searches.Find(from, found);
+  if (found && search.m_maxDistanceM >= maxDistanceM)
+  {
+    ++m_cachedSearchesCount;
+    return search;
+  }
+
+  search.m_maxDistanceM = maxDistanceM;
+  search.m_distances.clear();
+  search.m_parents.clear();
+
+  // Dijkstra from the end of |from|, the distances are to the beginnings of the segments.
+  // States are the distance, the segment and its parent.
+  using State = tuple<double, Segment, Segment>;
+  priority_queue<State, vector<State>, greater<State>> queue;
+  vector<Segment> outgoing;
+  m_graph.GetOutgoingSegments(from, outgoing);
+  for (auto const & segment : outgoing)
+    queue.emplace(0.0, segment, from);
+
+  while (!queue.empty())
+  {
+    auto const [distanceM, segment, parent] = queue.top();
+    queue.pop();
+    if (!search.m_distances.emplace(segment, distanceM).second)
+      continue;
+
+    search.m_parents[segment] = parent;
+
+    double const nextDistanceM = distanceM + m_graph.GetLengthM(segment);
+    if (nextDistanceM > maxDistanceM)
+      continue;
+
+    outgoing.clear();
+    m_graph.GetOutgoingSegments(segment, outgoing);
+    for (auto const & next : outgoing)
+    {
+      if (search.m_distances.count(next) == 0)
+        queue.emplace(nextDistanceM, next, segment);
+    }
+  }
+
+  return search;
+}
+
+void HmmMapMatcher::GetConnectingSegments(Candidate const & from, Candidate const & to,
+                                          double routeM, vector<Segment> & segments)
+{
+  if (from.m_segment == to.m_segment && to.m_offsetM >= from.m_offsetM)
+    return;
+
+  auto const & parents = GetSearch(from.m_segment, routeM).m_parents;
+  // The path may return to |from.m_segment| itself, so it's walked from the parent of |to|.
+  auto it = parents.find(to.m_segment);
+  CHECK(it != parents.cend(), (from.m_segment, to.m_segment));
+
+  size_t const begin = segments.size();
+  while (it->second != from.m_segment)
+  {
+    segments.push_back(it->second);
+    it = parents.find(it->second);
+    CHECK(it != parents.cend(), (from.m_segment, to.m_segment));
+  }
+  reverse(segments.begin() + begin, segments.end());
+}
+
+bool HmmMapMatcher::FillScores(Layer const & prevLayer, m2::PointD const & prevPoint,
+                               Layer & layer, m2::PointD const & point)
+{
+  double const straightM = mercator::DistanceOnEarth(prevPoint, point);
+  double const maxRouteM = m_params.m_maxRouteFactor * straightM + m_params.m_maxRouteExtraM;
+
+  size_t const count = layer.m_candidates.size();
+  layer.m_scores.assign(count, kImpossible);
+  layer.m_parents.assign(count, -1);
+  layer.m_routesM.assign(count, 0.0);
+
+  for (size_t from = 0; from < prevLayer.m_candidates.size(); ++from)
+  {
+    for (size_t to = 0; to < count; ++to)
+    {
+      double const routeM =
+          GetRoadDistanceM(prevLayer.m_candidates[from], layer.m_candidates[to], maxRouteM);
+      if (routeM < 0.0)
+        continue;
+
+      double const score = prevLayer.m_scores[from] - fabs(straightM - routeM) / m_params.m_betaM;
+      if (score > layer.m_scores[to])
+      {
+        layer.m_scores[to] = score;
+        layer.m_parents[to] = static_cast<int32_t>(from);
+        layer.m_routesM[to] = routeM;
+      }
+    }
+  }
+
+  bool reachable = false;
+  for (size_t to = 0; to < count; ++to)
+  {
+    if (layer.m_parents[to] < 0)
+      continue;
+
+    layer.m_scores[to] += GetEmissionScore(layer.m_candidates[to]);
+    reachable = true;
+  }
+  return reachable;
+}
+
+void HmmMapMatcher::CommitWindow(MatchedPiece & piece)
+{
+  CHECK(!m_layers.empty(), ());
+
+  Layer const & last = m_layers.back();
+  auto const best = static_cast<int32_t>(
+      distance(last.m_scores.cbegin(), max_element(last.m_scores.cbegin(), last.m_scores.cend())));
+
+  vector<int32_t> states(m_layers.size());
+  int32_t state = best;
+  for (size_t i = m_layers.size(); i > 0; --i)
+  {
+    CHECK_GREATER_OR_EQUAL(state, 0, ());
+    states[i - 1] = state;
+    state = m_layers[i - 1].m_parents[state];
+  }
+
+  vector<Segment> connecting;
+  for (size_t i = 0; i + 1 < m_layers.size(); ++i)
+  {
+    Layer const & layer = m_layers[i];
+    Layer const & next = m_layers[i + 1];
+    Candidate const & candidate = layer.m_candidates[states[i]];
+    piece.emplace_back(layer.m_pointIdx, candidate.m_segment);
+
+    connecting.clear();
+    GetConnectingSegments(candidate, next.m_candidates[states[i + 1]],
+                          next.m_routesM[states[i + 1]], connecting);
+    for (auto const & segment : connecting)
+      piece.emplace_back(layer.m_pointIdx, segment);
+  }
+
+  // The next window starts from the chosen state of the last point.
+  Layer kept;
+  kept.m_pointIdx = last.m_pointIdx;
+  kept.m_candidates = {last.m_candidates[best]};
+  kept.m_scores = {0.0};
+  kept.m_parents = {-1};
+  kept.m_routesM = {0.0};
+  m_layers.clear();
+  m_layers.push_back(move(kept));
+}
+}  // namespace routing
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "routing/segment.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/lru_cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+/// \brief Map matching of noisy gps tracks with a hidden Markov model
+/// (P. Newson, J. Krumm, "Hidden Markov Map Matching Through Noise and Sparseness", 2009).
+/// The states of a point are the road segments near it. The emission probability of a state
+/// depends on the distance from the point to the segment, the transition probability depends
+/// on how much the road distance between the states of consecutive points differs from the
+/// distance between the points. The most probable states are chosen by the Viterbi algorithm
+/// in windows of points, so long tracks are matched in bounded memory.
+/// \note The road distances from a segment are searched once for all the states of the next
+/// point and are cached, consecutive points of a track mostly have the same states.
+/// \note This class is not thread-safe.
+class HmmMapMatcher
+{
+public:
+  struct Candidate
+  {
+    Candidate() = default;
+    Candidate(Segment const & segment, double distanceM, double offsetM)
+      : m_segment(segment), m_distanceM(distanceM), m_offsetM(offsetM)
+    {
+    }
+
+    Segment m_segment;
+    // Distance from the point to the segment.
+    double m_distanceM = 0.0;
+    // Distance from the beginning of the segment to the projection of the point.
+    double m_offsetM = 0.0;
+  };
+
+  /// \brief The roads the tracks are matched to.
+  class Graph
+  {
+  public:
+    virtual ~Graph() = default;
+
+    /// \brief Appends to |candidates| the segments which are closer to |point| than |radiusM|.
+    /// |point| is in mercator.
+    virtual void GetCandidates(m2::PointD const & point, double radiusM,
+                               std::vector<Candidate> & candidates) = 0;
+    /// \brief Appends to |segments| the segments a vehicle may go to from the end of |segment|
+    /// except for the u-turn to the same feature.
+    virtual void GetOutgoingSegments(Segment const & segment, std::vector<Segment> & segments) = 0;
+    virtual double GetLengthM(Segment const & segment) = 0;
+  };
+
+  struct Params
+  {
+    double m_candidatesRadiusM = 20.0;
+    // Standard deviation of gps errors.
+    double m_sigmaM = 10.0;
+    // Mean difference between the road distance and the distance between points of transitions.
+    double m_betaM = 10.0;
+    // Transitions with longer road distances than |m_maxRouteFactor| * distance between points
+    // + |m_maxRouteExtraM| are impossible.
+    double m_maxRouteFactor = 2.0;
+    double m_maxRouteExtraM = 200.0;
+    // Number of points after which the states of the previous points are fixed.
+    size_t m_windowSize = 64;
+    size_t m_maxCachedSearches = 4096;
+  };
+
+  // Indices of points and their segments. The segments of a piece make a contiguous path: the
+  // segments which connect the states of consecutive points follow the state of the former
+  // point with its index.
+  using MatchedPiece = std::vector<std::pair<size_t, Segment>>;
+
+  explicit HmmMapMatcher(Graph & graph);
+  HmmMapMatcher(Graph & graph, Params const & params);
+
+  /// \brief Matches |points| (in mercator) and appends to |pieces| their matched parts. A track
+  /// is split into pieces where consecutive points can't be connected by roads, points which
+  /// don't have roads nearby are skipped.
+  void Match(std::vector<m2::PointD> const & points, std::vector<MatchedPiece> & pieces);
+
+  uint64_t GetSearchesCount() const { return m_searchesCount; }
+  uint64_t GetCachedSearchesCount() const { return m_cachedSearchesCount; }
+
+private:
+  struct Layer
+  {
+    size_t m_pointIdx = 0;
+    std::vector<Candidate> m_candidates;
+    std::vector<double> m_scores;
+    // Index of the best previous state, -1 for the first layer of a window.
+    std::vector<int32_t> m_parents;
+    // Road distances from the best previous states.
+    std::vector<double> m_routesM;
+  };
+
+  struct Search
+  {
+    double m_maxDistanceM = -1.0;
+    // Road distances from the end of the source segment to the beginning of segments.
+    std::unordered_map<Segment, double> m_distances;
+    // Previous segments of the shortest paths from the source segment.
+    std::unordered_map<Segment, Segment> m_parents;
+  };
+
+  // Removes the candidates whose projections are the endpoints of their segments if the point
+  // projects inside the adjacent segment of the same road. Otherwise both of them would be the
+  // states of the same position and a noisy point could shift the next states of a track to the
+  // following segments.
+  void RemoveEndpointDuplicates(std::vector<Candidate> & candidates);
+  double GetEmissionScore(Candidate const & candidate) const;
+  // Returns a negative value if |to| can't be reached from |from| within |maxDistanceM|.
+  double GetRoadDistanceM(Candidate const & from, Candidate const & to, double maxDistanceM);
+  Search const & GetSearch(Segment const & from, double maxDistanceM);
+  // Appends to |segments| the segments between |from| and |to| on the road path of |routeM|
+  // length, which is found by GetRoadDistanceM().
+  void GetConnectingSegments(Candidate const & from, Candidate const & to, double routeM,
+                             std::vector<Segment> & segments);
+
+  // Returns false if no state of |layer| is reachable from the states of |prevLayer|.
+  bool FillScores(Layer const & prevLayer, m2::PointD const & prevPoint, Layer & layer,
+                  m2::PointD const & point);
+  // Appends the best path of |m_layers| to |piece| and keeps the state of the last layer.
+  void CommitWindow(MatchedPiece & piece);
+
+  Graph & m_graph;
+  Params const m_params;
+  std::vector<Layer> m_layers;
+  LruCache<Segment, Search> m_searches;
+  uint64_t m_searchesCount = 0;
+  uint64_t m_cachedSearchesCount = 0;
+};
+}  // namespace routing
@@ -45,7 +45,7 @@ IndexGraph::IndexGraph(shared_ptr<Geometry> geometry, shared_ptr<EdgeEstimator>
 
 bool IndexGraph::IsJoint(RoadPoint const & roadPoint) const
 {
-  return m_roadIndex.GetJointId(roadPoint) != Joint::kInvalidId;
+  return m_indices->m_roadIndex.GetJointId(roadPoint) != Joint::kInvalidId;
 }
 
 bool IndexGraph::IsJointOrEnd(Segment const & segment, bool fromStart)
@@ -86,11 +86,11 @@ void IndexGraph::GetEdgeListImpl(astar::VertexData<Segment, RouteWeight> const &
   auto const & segment = vertexData.m_vertex;
 
   RoadPoint const roadPoint = segment.GetRoadPoint(isOutgoing);
-  Joint::Id const jointId = m_roadIndex.GetJointId(roadPoint);
+  Joint::Id const jointId = m_indices->m_roadIndex.GetJointId(roadPoint);
 
   if (jointId != Joint::kInvalidId)
   {
-    m_jointIndex.ForEachPoint(jointId, [&](RoadPoint const & rp) {
+    m_indices->m_jointIndex.ForEachPoint(jointId, [&](RoadPoint const & rp) {
       GetNeighboringEdges(vertexData, rp, isOutgoing, useRoutingOptions, edges, parents,
                           useAccessConditional);
     });
@@ -199,16 +199,23 @@ optional<JointEdge> IndexGraph::GetJointEdgeByLastPoint(Segment const & parent,
 
 void IndexGraph::Build(uint32_t numJoints)
 {
-  m_jointIndex.Build(m_roadIndex, numJoints);
+  m_indices->m_roadIndex.Build();
+  m_indices->m_jointIndex.Build(m_indices->m_roadIndex, numJoints);
 }
 
 void IndexGraph::Import(vector<Joint> const & joints)
 {
-  m_roadIndex.Import(joints);
+  m_indices->m_roadIndex.Import(joints);
   CHECK_LESS_OR_EQUAL(joints.size(), numeric_limits<uint32_t>::max(), ());
   Build(checked_cast<uint32_t>(joints.size()));
 }
 
+void IndexGraph::SetIndices(shared_ptr<Indices> indices)
+{
+  CHECK(indices, ());
+  m_indices = move(indices);
+}
+
 void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
 {
   m_restrictionsForward.clear();
@@ -226,6 +233,19 @@ void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
     m_restrictionsBackward[restriction.front()].emplace_back(next(restriction.begin()), restriction.end());
   }
 
+  auto const fillHasRestrictions = [](Restrictions const & restrictions, vector<bool> & bits) {
+    bits.clear();
+    for (auto const & featureToRestrictions : restrictions)
+    {
+      auto const featureId = featureToRestrictions.first;
+      if (featureId >= bits.size())
+        bits.resize(featureId + 1, false);
+      bits[featureId] = true;
+    }
+  };
+  fillHasRestrictions(m_restrictionsForward, m_hasRestrictionsForward);
+  fillHasRestrictions(m_restrictionsBackward, m_hasRestrictionsBackward);
+
   LOG(LDEBUG, ("Restrictions are loaded in:", timer.ElapsedNano() / 1e6, "ms"));
 }
 
@@ -246,6 +266,11 @@ void IndexGraph::SetRoadAccess(RoadAccess && roadAccess)
   m_roadAccess.SetCurrentTimeGetter(m_currentTimeGetter);
 }
 
+void IndexGraph::SetSpeedProfiles(SpeedProfiles && speedProfiles)
+{
+  m_speedProfiles = move(speedProfiles);
+}
+
 void IndexGraph::GetNeighboringEdges(astar::VertexData<Segment, RouteWeight> const & fromVertexData,
                                      RoadPoint const & rp, bool isOutgoing, bool useRoutingOptions,
                                      vector<SegmentEdge> & edges, Parents<Segment> const & parents,
@@ -301,12 +326,12 @@ void IndexGraph::GetSegmentCandidateForJoint(Segment const & parent, bool isOutg
                                              vector<Segment> & children)
 {
   RoadPoint const roadPoint = parent.GetRoadPoint(isOutgoing);
-  Joint::Id const jointId = m_roadIndex.GetJointId(roadPoint);
+  Joint::Id const jointId = m_indices->m_roadIndex.GetJointId(roadPoint);
 
   if (jointId == Joint::kInvalidId)
     return;
 
-  m_jointIndex.ForEachPoint(jointId, [&](RoadPoint const & rp) {
+  m_indices->m_jointIndex.ForEachPoint(jointId, [&](RoadPoint const & rp) {
     GetSegmentCandidateForRoadPoint(rp, parent.GetMwmId(), isOutgoing, children);
   });
 }
@@ -539,7 +564,7 @@ bool IndexGraph::IsUTurnAndRestricted(Segment const & parent, Segment const & ch
   auto const & roadGeometry = m_geometry->GetRoad(featureId);
 
   RoadPoint const rp = parent.GetRoadPoint(isOutgoing);
-  if (m_roadIndex.GetJointId(rp) == Joint::kInvalidId && !roadGeometry.IsEndPointId(turnPoint))
+  if (m_indices->m_roadIndex.GetJointId(rp) == Joint::kInvalidId && !roadGeometry.IsEndPointId(turnPoint))
     return true;
 
   auto const it = m_noUTurnRestrictions.find(featureId);
@@ -562,7 +587,14 @@ RouteWeight IndexGraph::CalculateEdgeWeight(EdgeEstimator::Purpose purpose, bool
   auto const & segment = isOutgoing ? to : from;
   auto const & road = m_geometry->GetRoad(segment.GetFeatureId());
 
-  auto const weight = RouteWeight(m_estimator->CalcSegmentWeight(segment, road, purpose));
+  // Arrival time to the segment is known only for the segments reached with |prevWeight|. The same
+  // as for access:conditional, the time of the backward wave is an approximation.
+  auto const weight = RouteWeight(
+      prevWeight && !m_speedProfiles.IsEmpty()
+          ? m_estimator->CalcSegmentWeightAtTime(
+                segment, road, purpose, m_speedProfiles,
+                m_currentTimeGetter() + static_cast<time_t>(prevWeight->GetWeight()))
+          : m_estimator->CalcSegmentWeight(segment, road, purpose));
   auto const & penalties =
       GetPenalties(purpose, isOutgoing ? from : to, isOutgoing ? to : from, prevWeight);
 
@@ -14,6 +14,7 @@
 #include "routing/road_point.hpp"
 #include "routing/routing_options.hpp"
 #include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
 
 #include "geometry/point2d.hpp"
 
@@ -43,6 +44,15 @@ public:
   
   using Restrictions = std::unordered_map<uint32_t, std::vector<std::vector<uint32_t>>>;
 
+  // Roads and joints of the graph which are decoded from the routing section. They don't depend
+  // on the estimator and the routing options, so the graphs of an mwm for the same vehicle type
+  // share them.
+  struct Indices
+  {
+    RoadIndex m_roadIndex;
+    JointIndex m_jointIndex;
+  };
+
   IndexGraph() = default;
   IndexGraph(std::shared_ptr<Geometry> geometry, std::shared_ptr<EdgeEstimator> estimator,
              RoutingOptions routingOptions = RoutingOptions());
@@ -67,11 +77,11 @@ public:
                                                    Segment const & firstChild, bool isOutgoing,
                                                    uint32_t lastPoint);
 
-  Joint::Id GetJointId(RoadPoint const & rp) const { return m_roadIndex.GetJointId(rp); }
+  Joint::Id GetJointId(RoadPoint const & rp) const { return m_indices->m_roadIndex.GetJointId(rp); }
 
   Geometry & GetGeometry() { return *m_geometry; }
-  bool IsRoad(uint32_t featureId) const { return m_roadIndex.IsRoad(featureId); }
-  RoadJointIds const & GetRoad(uint32_t featureId) const { return m_roadIndex.GetRoad(featureId); }
+  bool IsRoad(uint32_t featureId) const { return m_indices->m_roadIndex.IsRoad(featureId); }
+  RoadJointIds GetRoad(uint32_t featureId) const { return m_indices->m_roadIndex.GetRoad(featureId); }
 
   RoadAccess::Type GetAccessType(Segment const & segment) const
   {
@@ -79,32 +89,37 @@ public:
     return type;
   }
 
-  uint32_t GetNumRoads() const { return m_roadIndex.GetSize(); }
-  uint32_t GetNumJoints() const { return m_jointIndex.GetNumJoints(); }
-  uint32_t GetNumPoints() const { return m_jointIndex.GetNumPoints(); }
+  uint32_t GetNumRoads() const { return m_indices->m_roadIndex.GetSize(); }
+  uint32_t GetNumJoints() const { return m_indices->m_jointIndex.GetNumJoints(); }
+  uint32_t GetNumPoints() const { return m_indices->m_jointIndex.GetNumPoints(); }
 
   void Build(uint32_t numJoints);
   void Import(std::vector<Joint> const & joints);
 
+  /// \brief The indices must not be changed (built, imported or pushed to) after they are shared.
+  std::shared_ptr<Indices> const & GetIndices() const { return m_indices; }
+  void SetIndices(std::shared_ptr<Indices> indices);
+
   void SetRestrictions(RestrictionVec && restrictions);
   void SetUTurnRestrictions(std::vector<RestrictionUTurn> && noUTurnRestrictions);
   void SetRoadAccess(RoadAccess && roadAccess);
+  void SetSpeedProfiles(SpeedProfiles && speedProfiles);
 
   void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
   {
-    m_roadIndex.PushFromSerializer(jointId, rp);
+    m_indices->m_roadIndex.PushFromSerializer(jointId, rp);
   }
 
   template <typename F>
   void ForEachRoad(F && f) const
   {
-    m_roadIndex.ForEachRoad(std::forward<F>(f));
+    m_indices->m_roadIndex.ForEachRoad(std::forward<F>(f));
   }
 
   template <typename F>
   void ForEachPoint(Joint::Id jointId, F && f) const
   {
-    m_jointIndex.ForEachPoint(jointId, std::forward<F>(f));
+    m_indices->m_jointIndex.ForEachPoint(jointId, std::forward<F>(f));
   }
 
   bool IsJoint(RoadPoint const & roadPoint) const;
@@ -191,11 +206,15 @@ private:
 
   std::shared_ptr<Geometry> m_geometry;
   std::shared_ptr<EdgeEstimator> m_estimator;
-  RoadIndex m_roadIndex;
-  JointIndex m_jointIndex;
+  std::shared_ptr<Indices> m_indices = std::make_shared<Indices>();
 
   Restrictions m_restrictionsForward;
   Restrictions m_restrictionsBackward;
+  // |m_hasRestrictionsForward[featureId]| is true if |m_restrictionsForward| has |featureId|, the
+  // same for the backward ones. Restrictions are checked for every relaxed edge while most of
+  // the features have none, so a bit is tested before the hash table lookup.
+  std::vector<bool> m_hasRestrictionsForward;
+  std::vector<bool> m_hasRestrictionsBackward;
 
   // u_turn can be in both sides of feature.
   struct UTurnEnding
@@ -211,6 +230,7 @@ private:
   std::unordered_map<uint32_t, UTurnEnding> m_noUTurnRestrictions;
 
   RoadAccess m_roadAccess;
+  SpeedProfiles m_speedProfiles;
   RoutingOptions m_avoidRoutingOptions;
 
   std::function<time_t()> m_currentTimeGetter = []() {
@@ -238,6 +258,10 @@ bool IndexGraph::IsRestricted(ParentVertex const & parent,
   if (parentFeatureId == currentFeatureId)
     return false;
 
+  auto const & hasRestrictions = isOutgoing ? m_hasRestrictionsForward : m_hasRestrictionsBackward;
+  if (currentFeatureId >= hasRestrictions.size() || !hasRestrictions[currentFeatureId])
+    return false;
+
   auto const & restrictions = isOutgoing ? m_restrictionsForward : m_restrictionsBackward;
   auto const it = restrictions.find(currentFeatureId);
   if (it == restrictions.cend())
@@ -3,11 +3,13 @@
 #include "routing/city_roads.hpp"
 #include "routing/index_graph_serialization.hpp"
 #include "routing/restriction_loader.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/road_access.hpp"
 #include "routing/road_access_serialization.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_exceptions.hpp"
 #include "routing/speed_camera_ser_des.hpp"
+#include "routing/speed_profiles.hpp"
 
 #include "indexer/data_source.hpp"
 
@@ -16,10 +18,15 @@
 #include "coding/files_container.hpp"
 
 #include "base/assert.hpp"
+#include "base/string_utils.hpp"
 #include "base/timer.hpp"
 
 #include <algorithm>
-#include <map>
+#include <cmath>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 
@@ -28,13 +35,78 @@ namespace
 using namespace routing;
 using namespace std;
 
+// Road and joint indices of the recently loaded mwms. Decoding of the routing section takes
+// most of the time of an mwm loading, so the indices are decoded once and shared by all the
+// graph loaders of the process.
+class IndicesCache final
+{
+public:
+  static IndicesCache & Instance()
+  {
+    static IndicesCache instance;
+    return instance;
+  }
+
+  shared_ptr<IndexGraph::Indices> Get(MwmSet::MwmId const & mwmId, MwmValue const & mwmValue,
+                                      VehicleType vehicleType)
+  {
+    Key const key(mwmId, vehicleType);
+    {
+      lock_guard<mutex> lock(m_mutex);
+      auto const it = find_if(m_entries.begin(), m_entries.end(),
+                              [&key](Entry const & entry) { return entry.first == key; });
+      if (it != m_entries.end())
+      {
+        m_entries.splice(m_entries.begin(), m_entries, it);
+        return it->second;
+      }
+    }
+
+    // The section is decoded without the lock, so a concurrent request for the same mwm may
+    // decode it once more. The last decoded indices stay in the cache then.
+    auto indices = DecodeIndices(mwmValue, vehicleType);
+
+    lock_guard<mutex> lock(m_mutex);
+    m_entries.remove_if([&key](Entry const & entry) { return entry.first == key; });
+    m_entries.emplace_front(key, indices);
+    if (m_entries.size() > kMaxSize)
+      m_entries.pop_back();
+    return indices;
+  }
+
+private:
+  using Key = pair<MwmSet::MwmId, VehicleType>;
+  using Entry = pair<Key, shared_ptr<IndexGraph::Indices>>;
+
+  // A route rarely goes through more mwms.
+  static size_t constexpr kMaxSize = 16;
+
+  static shared_ptr<IndexGraph::Indices> DecodeIndices(MwmValue const & mwmValue,
+                                                       VehicleType vehicleType)
+  {
+    base::Timer timer;
+    FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
+    ReaderSource<FilesContainerR::TReader> src(reader);
+    IndexGraph graph;
+    IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
+    LOG(LINFO, (ROUTING_FILE_TAG, "section for", mwmValue.GetCountryFileName(), "decoded in",
+                timer.ElapsedSeconds(), "seconds"));
+    return graph.GetIndices();
+  }
+
+  mutex m_mutex;
+  // The most recently used indices are at the beginning.
+  list<Entry> m_entries;
+};
+
 class IndexGraphLoaderImpl final : public IndexGraphLoader
 {
 public:
   IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
                        shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                        shared_ptr<EdgeEstimator> estimator, DataSource & dataSource,
-                       RoutingOptions routingOptions = RoutingOptions());
+                       RoutingOptions routingOptions = RoutingOptions(),
+                       RouterDelegate const * delegate = nullptr);
 
   // IndexGraphLoader overrides:
   Geometry & GetGeometry(NumMwmId numMwmId) override;
@@ -61,10 +133,13 @@ private:
 
   unordered_map<NumMwmId, GraphAttrs> m_graphs;
 
-  unordered_map<NumMwmId, map<SegmentCoord, vector<RouteSegment::SpeedCamera>>> m_cachedCameras;
-  decltype(m_cachedCameras)::iterator ReceiveSpeedCamsFromMwm(NumMwmId numMwmId);
+  SegmentSpeedCameras const & GetSpeedCameras(NumMwmId numMwmId);
+
+  unordered_map<NumMwmId, SegmentSpeedCameras> m_cachedCameras;
 
   RoutingOptions m_avoidRoutingOptions = RoutingOptions();
+  // Takes the time of the mwms loading if it's set.
+  RouterDelegate const * m_delegate = nullptr;
   std::function<time_t()> m_currentTimeGetter = [time = GetCurrentTimestamp()]() {
     return time;
   };
@@ -74,7 +149,7 @@ IndexGraphLoaderImpl::IndexGraphLoaderImpl(
     VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
     shared_ptr<EdgeEstimator> estimator, DataSource & dataSource,
-    RoutingOptions routingOptions)
+    RoutingOptions routingOptions, RouterDelegate const * delegate)
   : m_vehicleType(vehicleType)
   , m_loadAltitudes(loadAltitudes)
   , m_dataSource(dataSource)
@@ -82,6 +157,7 @@ IndexGraphLoaderImpl::IndexGraphLoaderImpl(
   , m_vehicleModelFactory(move(vehicleModelFactory))
   , m_estimator(move(estimator))
   , m_avoidRoutingOptions(routingOptions)
+  , m_delegate(delegate)
 {
   CHECK(m_numMwmIds, ());
   CHECK(m_vehicleModelFactory, ());
@@ -109,11 +185,15 @@ IndexGraph & IndexGraphLoaderImpl::GetIndexGraph(NumMwmId numMwmId)
   return *CreateIndexGraph(numMwmId, CreateGeometry(numMwmId)).m_indexGraph;
 }
 
-auto IndexGraphLoaderImpl::ReceiveSpeedCamsFromMwm(NumMwmId numMwmId) -> decltype(m_cachedCameras)::iterator
+SegmentSpeedCameras const & IndexGraphLoaderImpl::GetSpeedCameras(NumMwmId numMwmId)
 {
-  m_cachedCameras.emplace(numMwmId,
-                          map<SegmentCoord, vector<RouteSegment::SpeedCamera>>{});
-  auto & mapReference = m_cachedCameras.find(numMwmId)->second;
+  auto const it = m_cachedCameras.find(numMwmId);
+  if (it != m_cachedCameras.end())
+    return it->second;
+
+  // Empty cameras are cached for the mwms without the section too, so the section is looked
+  // for once per mwm.
+  auto & cameras = m_cachedCameras[numMwmId];
 
   auto const & file = m_numMwmIds->GetFile(numMwmId);
   auto handle = m_dataSource.GetMwmHandleByCountryFile(file);
@@ -124,68 +204,38 @@ auto IndexGraphLoaderImpl::ReceiveSpeedCamsFromMwm(NumMwmId numMwmId) -> decltyp
   if (!mwmValue.m_cont.IsExist(CAMERAS_INFO_FILE_TAG))
   {
     LOG(LINFO, ("No section about speed cameras"));
-    return m_cachedCameras.end();
+    return cameras;
   }
 
   try
   {
     FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(CAMERAS_INFO_FILE_TAG));
     ReaderSource<FilesContainerR::TReader> src(reader);
-    DeserializeSpeedCamsFromMwm(src, mapReference);
+    cameras = SegmentSpeedCameras::Deserialize(src);
   }
   catch (Reader::OpenException & ex)
   {
     LOG(LINFO, ("No section about speed cameras"));
-    return m_cachedCameras.end();
   }
 
-  decltype(m_cachedCameras)::iterator it;
-  it = m_cachedCameras.find(numMwmId);
-  CHECK(it != m_cachedCameras.end(), ());
-
-  return it;
+  return cameras;
 }
 
 vector<RouteSegment::SpeedCamera> IndexGraphLoaderImpl::GetSpeedCameraInfo(Segment const & segment)
 {
-  auto const numMwmId = segment.GetMwmId();
-
-  auto it = m_cachedCameras.find(numMwmId);
-  if (it == m_cachedCameras.end())
-    it = ReceiveSpeedCamsFromMwm(numMwmId);
-
-  if (it == m_cachedCameras.end())
-    return {};
-
-  auto result = it->second.find({segment.GetFeatureId(), segment.GetSegmentIdx()});
-  if (result == it->second.end())
-    return {};
-
-  auto camerasTmp = result->second;
-  std::sort(camerasTmp.begin(), camerasTmp.end());
-
-  // TODO (@gmoryes) do this in generator.
-  // This code matches cameras with equal coefficients and among them
-  // only the camera with minimal maxSpeed is left.
-  static constexpr auto kInvalidCoef = 2.0;
-  camerasTmp.emplace_back(kInvalidCoef, 0.0 /* maxSpeedKmPH */);
-  vector<RouteSegment::SpeedCamera> cameras;
-  for (size_t i = 1; i < camerasTmp.size(); ++i)
-  {
-    static constexpr auto kEps = 1e-5;
-    if (!base::AlmostEqualAbs(camerasTmp[i - 1].m_coef, camerasTmp[i].m_coef, kEps))
-      cameras.emplace_back(camerasTmp[i - 1]);
-  }
-  // Cameras stored from beginning to ending of segment. So if we go at segment in backward direction,
-  // we should read cameras in reverse sequence too.
-  if (!segment.IsForward())
-    std::reverse(cameras.begin(), cameras.end());
-
-  return cameras;
+  return GetSpeedCameras(segment.GetMwmId())
+      .GetCameras({segment.GetFeatureId(), segment.GetSegmentIdx()}, segment.IsForward());
 }
 
 IndexGraphLoaderImpl::GraphAttrs & IndexGraphLoaderImpl::CreateGeometry(NumMwmId numMwmId)
 {
+  optional<RouterDelegate::ScopedPhaseTimer> phaseTimer;
+  if (m_delegate)
+  {
+    phaseTimer.emplace(*m_delegate, RoutingPhase::MwmLoading);
+    m_delegate->OnMwmOpened();
+  }
+
   platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
   MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleByCountryFile(file);
   if (!handle.IsAlive())
@@ -195,8 +245,14 @@ IndexGraphLoaderImpl::GraphAttrs & IndexGraphLoaderImpl::CreateGeometry(NumMwmId
       m_vehicleModelFactory->GetVehicleModelForCountry(file.GetName());
 
   auto & graph = m_graphs[numMwmId];
-  graph.m_geometry = make_shared<Geometry>(GeometryLoader::Create(
-      m_dataSource, handle, vehicleModel, AttrLoader(m_dataSource, handle), m_loadAltitudes));
+  RoadGeometryKey roadsKey;
+  roadsKey.m_mwmId = handle.GetId();
+  roadsKey.m_vehicleType = m_vehicleType;
+  roadsKey.m_loadAltitudes = m_loadAltitudes;
+  graph.m_geometry = make_shared<Geometry>(
+      GeometryLoader::Create(m_dataSource, handle, vehicleModel, AttrLoader(m_dataSource, handle),
+                             m_loadAltitudes),
+      RoadGeometryCache::Instance(), roadsKey);
   return graph;
 }
 
@@ -204,6 +260,10 @@ IndexGraphLoaderImpl::GraphAttrs & IndexGraphLoaderImpl::CreateIndexGraph(
     NumMwmId numMwmId, GraphAttrs & graph)
 {
   CHECK(graph.m_geometry, ());
+  optional<RouterDelegate::ScopedPhaseTimer> phaseTimer;
+  if (m_delegate)
+    phaseTimer.emplace(*m_delegate, RoutingPhase::MwmLoading);
+
   platform::CountryFile const & file = m_numMwmIds->GetFile(numMwmId);
   MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleByCountryFile(file);
   if (!handle.IsAlive())
@@ -213,7 +273,9 @@ IndexGraphLoaderImpl::GraphAttrs & IndexGraphLoaderImpl::CreateIndexGraph(
   graph.m_indexGraph->SetCurrentTimeGetter(m_currentTimeGetter);
   base::Timer timer;
   MwmValue const & mwmValue = *handle.GetValue();
-  DeserializeIndexGraph(mwmValue, m_vehicleType, *graph.m_indexGraph);
+  graph.m_indexGraph->SetIndices(
+      IndicesCache::Instance().Get(handle.GetId(), mwmValue, m_vehicleType));
+  LoadIndexGraphAttributes(mwmValue, m_vehicleType, *graph.m_indexGraph);
   LOG(LINFO, (ROUTING_FILE_TAG, "section for", file.GetName(), "loaded in", timer.ElapsedSeconds(),
       "seconds"));
   return graph;
@@ -242,6 +304,35 @@ bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, VehicleType vehicleType,
   }
   return true;
 }
+
+bool ReadSpeedProfilesFromMwm(MwmValue const & mwmValue, SpeedProfiles & speedProfiles)
+{
+  if (!mwmValue.m_cont.IsExist(SPEED_PROFILES_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(SPEED_PROFILES_FILE_TAG);
+    ReaderSource<FilesContainerR::TReader> src(reader);
+
+    speedProfiles.Deserialize(src);
+  }
+  catch (Reader::OpenException const & e)
+  {
+    LOG(LERROR, ("Error while reading", SPEED_PROFILES_FILE_TAG, "section.", e.Msg()));
+    return false;
+  }
+
+  // Profiles are kept by the hours of the local time of the region.
+  auto const & regionData = mwmValue.GetRegionData();
+  double utcOffsetHours = 0.0;
+  if (regionData.Has(feature::RegionData::RD_TIMEZONE) &&
+      strings::to_double(regionData.Get(feature::RegionData::RD_TIMEZONE), utcOffsetHours))
+  {
+    speedProfiles.SetRegionUtcOffset(static_cast<int32_t>(lround(utcOffsetHours * 60 * 60)));
+  }
+  return true;
+}
 }  // namespace
 
 namespace routing
@@ -251,17 +342,15 @@ unique_ptr<IndexGraphLoader> IndexGraphLoader::Create(
     VehicleType vehicleType, bool loadAltitudes, shared_ptr<NumMwmIds> numMwmIds,
     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
     shared_ptr<EdgeEstimator> estimator, DataSource & dataSource,
-    RoutingOptions routingOptions)
+    RoutingOptions routingOptions, RouterDelegate const * delegate)
 {
   return make_unique<IndexGraphLoaderImpl>(vehicleType, loadAltitudes, numMwmIds, vehicleModelFactory,
-                                           estimator, dataSource, routingOptions);
+                                           estimator, dataSource, routingOptions, delegate);
 }
 
-void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
+void LoadIndexGraphAttributes(MwmValue const & mwmValue, VehicleType vehicleType,
+                              IndexGraph & graph)
 {
-  FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
-  ReaderSource<FilesContainerR::TReader> src(reader);
-  IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
   RestrictionLoader restrictionLoader(mwmValue, graph);
   if (restrictionLoader.HasRestrictions())
   {
@@ -272,6 +361,29 @@ void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, I
   RoadAccess roadAccess;
   if (ReadRoadAccessFromMwm(mwmValue, vehicleType, roadAccess))
     graph.SetRoadAccess(move(roadAccess));
+
+  // Typical speeds are collected for cars only.
+  SpeedProfiles speedProfiles;
+  if (vehicleType == VehicleType::Car && ReadSpeedProfilesFromMwm(mwmValue, speedProfiles))
+    graph.SetSpeedProfiles(move(speedProfiles));
+}
+
+void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
+{
+  FilesContainerR::TReader reader(mwmValue.m_cont.GetReader(ROUTING_FILE_TAG));
+  ReaderSource<FilesContainerR::TReader> src(reader);
+  IndexGraphSerializer::Deserialize(graph, src, GetVehicleMask(vehicleType));
+  LoadIndexGraphAttributes(mwmValue, vehicleType, graph);
+}
+
+void WarmUpIndexGraph(MwmSet::MwmHandle const & handle, VehicleType vehicleType)
+{
+  CHECK(handle.IsAlive(), ());
+  MwmValue const & mwmValue = *handle.GetValue();
+  if (!mwmValue.m_cont.IsExist(ROUTING_FILE_TAG))
+    return;
+
+  IndicesCache::Instance().Get(handle.GetId(), mwmValue, vehicleType);
 }
 
 uint32_t DeserializeIndexGraphNumRoads(MwmValue const & mwmValue, VehicleType vehicleType)
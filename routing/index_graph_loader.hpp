@@ -3,15 +3,17 @@
 #include "routing/edge_estimator.hpp"
 #include "routing/index_graph.hpp"
 #include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
 #include "routing/vehicle_mask.hpp"
 
 #include "routing_common/num_mwm_id.hpp"
 #include "routing_common/vehicle_model.hpp"
 
+#include "indexer/mwm_set.hpp"
+
 #include <memory>
 #include <vector>
 
-class MwmValue;
 class DataSource;
 
 namespace routing
@@ -32,10 +34,18 @@ public:
       VehicleType vehicleType, bool loadAltitudes, std::shared_ptr<NumMwmIds> numMwmIds,
       std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
       std::shared_ptr<EdgeEstimator> estimator, DataSource & dataSource,
-      RoutingOptions routingOptions = RoutingOptions());
+      RoutingOptions routingOptions = RoutingOptions(), RouterDelegate const * delegate = nullptr);
 };
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph);
+/// \brief Loads restrictions, road access and speed profiles of |graph| from |mwmValue|.
+void LoadIndexGraphAttributes(MwmValue const & mwmValue, VehicleType vehicleType,
+                              IndexGraph & graph);
+
+/// \brief Decodes the road and joint indices of the mwm for |vehicleType| to the process-wide
+/// cache which is used by all the graph loaders, so the first route through the mwm doesn't
+/// wait for the decoding. It may be called from any thread.
+void WarmUpIndexGraph(MwmSet::MwmHandle const & handle, VehicleType vehicleType);
 
 uint32_t DeserializeIndexGraphNumRoads(MwmValue const & mwmValue, VehicleType vehicleType);
 }  // namespace routing
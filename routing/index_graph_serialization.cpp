@@ -23,7 +23,7 @@ void IndexGraphSerializer::SectionSerializer::PreSerialize(
 
   for (uint32_t const featureId : m_featureIds)
   {
-    RoadJointIds const & road = graph.GetRoad(featureId);
+    RoadJointIds const road = graph.GetRoad(featureId);
     WriteGamma(writer, featureId - prevFeatureId);
     WriteGamma(writer, ConvertJointsNumber(road.GetJointsNumber()));
 
@@ -315,7 +315,8 @@ RouteWeight IndexGraphStarter::CalcSegmentWeight(Segment const & segment,
   return m_graph.CalcOffroadWeight(vertex.GetPointFrom(), vertex.GetPointTo(), purpose);
 }
 
-double IndexGraphStarter::CalculateETA(Segment const & from, Segment const & to) const
+double IndexGraphStarter::CalculateETA(Segment const & from, Segment const & to,
+                                       double secondsToFrom) const
 {
   // We don't distinguish fake segment weight and fake segment transit time.
   if (IsFakeSegment(to))
@@ -346,7 +347,7 @@ double IndexGraphStarter::CalculateETA(Segment const & from, Segment const & to)
            m_regionsGraph->CalcSegmentWeight(to).GetWeight();
   }
 
-  return m_graph.CalculateETA(from, to);
+  return m_graph.CalculateETA(from, to, secondsToFrom);
 }
 
 double IndexGraphStarter::CalculateETAWithoutPenalty(Segment const & segment) const
@@ -162,7 +162,7 @@ public:
   RouteWeight CalcSegmentWeight(Segment const & segment, EdgeEstimator::Purpose purpose) const;
   RouteWeight CalcGuidesSegmentWeight(Segment const & segment,
                                       EdgeEstimator::Purpose purpose) const;
-  double CalculateETA(Segment const & from, Segment const & to) const;
+  double CalculateETA(Segment const & from, Segment const & to, double secondsToFrom) const;
   double CalculateETAWithoutPenalty(Segment const & segment) const;
 
   // For compatibility with IndexGraphStarterJoints
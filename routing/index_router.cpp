@@ -13,6 +13,7 @@
 #include "routing/leaps_postprocessor.hpp"
 #include "routing/mwm_hierarchy_handler.hpp"
 #include "routing/pedestrian_directions.hpp"
+#include "routing/road_geometry_cache.hpp"
 #include "routing/route.hpp"
 #include "routing/routing_exceptions.hpp"
 #include "routing/routing_helpers.hpp"
@@ -30,9 +31,11 @@
 
 #include "indexer/data_source.hpp"
 #include "indexer/scales.hpp"
+#include "indexer/utils.hpp"
 
 #include "platform/mwm_traits.hpp"
 
+#include "geometry/convex_hull.hpp"
 #include "geometry/mercator.hpp"
 #include "geometry/parametrized_segment.hpp"
 #include "geometry/polyline2d.hpp"
@@ -40,20 +43,26 @@
 
 #include "base/assert.hpp"
 #include "base/exception.hpp"
+#include "base/executor.hpp"
 #include "base/logging.hpp"
+#include "base/profiler.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 
 #include "defines.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <deque>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <map>
 #include <optional>
 
+#include "3party/skarupke/bytell_hash_map.hpp"
+
 using namespace routing;
 using namespace std;
 
@@ -203,11 +212,14 @@ bool IsDeadEnd(Segment const & segment, bool isOutgoing, bool useRoutingOptions,
 }
 
 bool IsDeadEndCached(Segment const & segment, bool isOutgoing, bool useRoutingOptions,
-                     WorldGraph & worldGraph, set<Segment> & deadEnds)
+                     WorldGraph & worldGraph, set<Segment> & deadEnds, set<Segment> & notDeadEnds)
 {
   if (deadEnds.count(segment) != 0)
     return true;
 
+  if (notDeadEnds.count(segment) != 0)
+    return false;
+
   set<Segment> visitedSegments;
   if (IsDeadEnd(segment, isOutgoing, useRoutingOptions, worldGraph, visitedSegments))
   {
@@ -217,8 +229,46 @@ bool IsDeadEndCached(Segment const & segment, bool isOutgoing, bool useRoutingOp
     return true;
   }
 
+  notDeadEnds.insert(segment);
   return false;
 }
+
+// Calls |processTask| for the tasks from 0 to |tasksCount| on |graphs.size()| threads. Every
+// thread uses its own graph. Returns the first error code or NoError.
+template <typename ProcessTask>
+RouterResultCode ProcessOnGraphs(size_t tasksCount, vector<unique_ptr<WorldGraph>> & graphs,
+                                 ProcessTask const & processTask)
+{
+  atomic<size_t> nextTask(0);
+  auto const processTasks = [&](WorldGraph & graph) {
+    for (size_t i = nextTask++; i < tasksCount; i = nextTask++)
+    {
+      auto const code = processTask(i, graph);
+      if (code != RouterResultCode::NoError)
+        return code;
+    }
+    return RouterResultCode::NoError;
+  };
+
+  vector<future<RouterResultCode>> results;
+  auto & executor = base::Executor::Instance();
+  for (auto & graph : graphs)
+  {
+    results.emplace_back(
+        executor.Submit(base::Executor::Priority::Routing, processTasks, ref(*graph)));
+  }
+  // All the tasks must finish before an exception leaves the frame they reference.
+  for (auto & result : results)
+    result.wait();
+
+  for (auto & result : results)
+  {
+    auto const code = result.get();
+    if (code != RouterResultCode::NoError)
+      return code;
+  }
+  return RouterResultCode::NoError;
+}
 }  // namespace
 
 namespace routing
@@ -282,6 +332,7 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
   , m_countryRectFn(countryRectFn)
   , m_numMwmIds(move(numMwmIds))
   , m_numMwmTree(move(numMwmTree))
+  , m_trafficCache(trafficCache)
   , m_trafficStash(CreateTrafficStash(m_vehicleType, m_numMwmIds, trafficCache))
   , m_roadGraph(m_dataSource,
                 vehicleType == VehicleType::Pedestrian || vehicleType == VehicleType::Transit
@@ -323,6 +374,10 @@ void IndexRouter::ClearState()
 {
   m_roadGraph.ClearState();
   m_directionsEngine->Clear();
+  get<0>(m_algorithms).ReleaseMemory();
+  get<1>(m_algorithms).ReleaseMemory();
+
+  LOG(LINFO, (RoadGeometryCache::Instance().GetStats()));
 }
 
 bool IndexRouter::FindClosestProjectionToRoad(m2::PointD const & point,
@@ -407,7 +462,20 @@ RouterResultCode IndexRouter::CalculateRoute(Checkpoints const & checkpoints,
       }
     }
 
-    return DoCalculateRoute(checkpoints, startDirection, delegate, route);
+    if (!m_routeCache || m_guides.IsActive())
+      return DoCalculateRoute(checkpoints, startDirection, delegate, route);
+
+    auto const key = MakeRouteCacheKey(checkpoints, startDirection);
+    if (auto const * entry = m_routeCache->Find(key))
+    {
+      UseCachedRoute(*entry, route);
+      return RouterResultCode::NoError;
+    }
+
+    auto const code = DoCalculateRoute(checkpoints, startDirection, delegate, route);
+    if (code == RouterResultCode::NoError)
+      m_routeCache->Add(key, route, m_lastAlternatives);
+    return code;
   }
   catch (RootException const & e)
   {
@@ -550,11 +618,450 @@ void IndexRouter::AddGuidesOsmConnectionsToGraphStarter(size_t checkpointIdxFrom
   }
 }
 
+RouterResultCode IndexRouter::CalculateMatrix(vector<m2::PointD> const & sources,
+                                              vector<m2::PointD> const & targets,
+                                              size_t threadsCount, RouterDelegate const & delegate,
+                                              Matrix & matrix)
+{
+  CHECK_GREATER(threadsCount, 0, ());
+  matrix.assign(sources.size(), vector<MatrixCell>(targets.size()));
+  if (sources.empty() || targets.empty())
+    return RouterResultCode::NoError;
+
+  vector<string> outdatedMwms;
+  GetOutdatedMwms(m_dataSource, outdatedMwms);
+  if (!outdatedMwms.empty())
+    return RouterResultCode::FileTooOld;
+
+  for (auto const * points : {&sources, &targets})
+  {
+    auto const code = CheckCountries(*points);
+    if (code != RouterResultCode::NoError)
+      return code;
+  }
+
+  try
+  {
+    SCOPE_GUARD(featureRoadGraphClear, [this]{
+      this->ClearState();
+    });
+
+    TrafficStash::Guard guard(m_trafficStash);
+
+    // Graphs are not thread safe, so every thread gets its own one. Points are snapped once on
+    // the first of them.
+    threadsCount = min(threadsCount, sources.size());
+    vector<unique_ptr<WorldGraph>> graphs;
+    for (size_t i = 0; i < threadsCount; ++i)
+      graphs.push_back(MakeWorldGraph(&delegate));
+
+    auto const findSegments = [&](vector<m2::PointD> const & points, bool isOutgoing) {
+      vector<vector<Segment>> result(points.size());
+      for (size_t i = 0; i < points.size(); ++i)
+      {
+        if (!FindBestSegments(points[i], m2::PointD::Zero() /* direction */, isOutgoing,
+                              *graphs.front(), result[i]))
+        {
+          LOG(LDEBUG, ("Matrix point", mercator::ToLatLon(points[i]), "is not snapped."));
+        }
+      }
+      return result;
+    };
+
+    auto const sourcesSegments = findSegments(sources, true /* isOutgoing */);
+    auto const targetsSegments = findSegments(targets, false /* isOutgoing */);
+
+    return ProcessOnGraphs(sources.size(), graphs, [&](size_t i, WorldGraph & graph) {
+      return CalculateMatrixRow(sources[i], sourcesSegments[i], targets, targetsSegments,
+                                delegate, graph, matrix[i]);
+    });
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate routes matrix:", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
+RouterResultCode IndexRouter::CalculateIsochrones(vector<m2::PointD> const & sources,
+                                                  double maxTimeSec, size_t threadsCount,
+                                                  RouterDelegate const & delegate,
+                                                  vector<Isochrone> & isochrones)
+{
+  CHECK_GREATER(threadsCount, 0, ());
+  CHECK_GREATER_OR_EQUAL(maxTimeSec, 0.0, ());
+  isochrones.assign(sources.size(), Isochrone());
+  if (sources.empty())
+    return RouterResultCode::NoError;
+
+  vector<string> outdatedMwms;
+  GetOutdatedMwms(m_dataSource, outdatedMwms);
+  if (!outdatedMwms.empty())
+    return RouterResultCode::FileTooOld;
+
+  auto const code = CheckCountries(sources);
+  if (code != RouterResultCode::NoError)
+    return code;
+
+  try
+  {
+    SCOPE_GUARD(featureRoadGraphClear, [this]{
+      this->ClearState();
+    });
+
+    TrafficStash::Guard guard(m_trafficStash);
+
+    threadsCount = min(threadsCount, sources.size());
+    vector<unique_ptr<WorldGraph>> graphs;
+    for (size_t i = 0; i < threadsCount; ++i)
+      graphs.push_back(MakeWorldGraph(&delegate));
+
+    vector<vector<Segment>> sourcesSegments(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+      if (!FindBestSegments(sources[i], m2::PointD::Zero() /* direction */, true /* isOutgoing */,
+                            *graphs.front(), sourcesSegments[i]))
+      {
+        LOG(LDEBUG, ("Isochrone source", mercator::ToLatLon(sources[i]), "is not snapped."));
+      }
+    }
+
+    return ProcessOnGraphs(sources.size(), graphs, [&](size_t i, WorldGraph & graph) {
+      return CalculateIsochrone(sources[i], sourcesSegments[i], maxTimeSec, delegate, graph,
+                                isochrones[i]);
+    });
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't calculate isochrones:", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
+RouterResultCode IndexRouter::CheckCountries(vector<m2::PointD> const & points) const
+{
+  for (auto const & point : points)
+  {
+    string const countryName = m_countryFileFn(point);
+    if (countryName.empty())
+      return RouterResultCode::InternalError;
+    if (!m_dataSource.IsLoaded(platform::CountryFile(countryName)))
+      return RouterResultCode::NeedMoreMaps;
+  }
+  return RouterResultCode::NoError;
+}
+
+RouterResultCode IndexRouter::CalculateIsochrone(m2::PointD const & source,
+                                                 vector<Segment> const & sourceSegments,
+                                                 double maxTimeSec, RouterDelegate const & delegate,
+                                                 WorldGraph & graph, Isochrone & isochrone) const
+{
+  if (sourceSegments.empty())
+    return RouterResultCode::NoError;
+
+  // The wave has no finish, so the source ending is used for the finish of the starter as well.
+  graph.SetMode(WorldGraphMode::NoLeaps);
+  auto const sourceEnding = MakeFakeEnding(sourceSegments, source, graph);
+  IndexGraphStarter starter(sourceEnding, sourceEnding, 0 /* fakeNumerationStart */,
+                            false /* strictForward */, graph);
+
+  using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+  Algorithm algorithm;
+  Algorithm::Context context(starter);
+  bool cancelled = false;
+
+  auto const visitVertex = [&](Segment const & vertex) {
+    if (delegate.IsCancelled())
+    {
+      cancelled = true;
+      return false;
+    }
+
+    isochrone.m_reachablePoints.push_back(
+        mercator::FromLatLon(starter.GetPoint(vertex, true /* front */)));
+    return true;
+  };
+  auto const adjustEdgeWeight = [](Segment const & /* vertex */, SegmentEdge const & edge) {
+    return edge.GetWeight();
+  };
+  // The wave is bounded by the time, so the mwms which are too far from the source are never
+  // loaded. A route may leave the non-pass-through zone of the source and enter another one
+  // with a reachable point.
+  int8_t constexpr kMaxPassThroughChanges = 2;
+  auto const filterStates = [maxTimeSec](auto const & state) {
+    return state.distance.GetWeight() <= maxTimeSec &&
+           state.distance.GetNumPassThroughChanges() <= kMaxPassThroughChanges;
+  };
+  auto const reducedToRealLength = [](auto const & state) { return state.distance; };
+
+  algorithm.PropagateWave(starter, starter.GetStartSegment(), visitVertex, adjustEdgeWeight,
+                          filterStates, reducedToRealLength, context);
+  if (cancelled)
+    return RouterResultCode::Cancelled;
+
+  // Points which make a turn of the hull less than of about a square meter are skipped.
+  double constexpr kHullEps = 1e-10;
+  base::SortUnique(isochrone.m_reachablePoints);
+  isochrone.m_polygon = m2::ConvexHull(isochrone.m_reachablePoints, kHullEps).Points();
+  return RouterResultCode::NoError;
+}
+
+RouterResultCode IndexRouter::CalculateMatrixRow(m2::PointD const & source,
+                                                 vector<Segment> const & sourceSegments,
+                                                 vector<m2::PointD> const & targets,
+                                                 vector<vector<Segment>> const & targetsSegments,
+                                                 RouterDelegate const & delegate,
+                                                 WorldGraph & graph, vector<MatrixCell> & row) const
+{
+  if (sourceSegments.empty())
+    return RouterResultCode::NoError;
+
+  // The wave is limited by the farthest target only to meet non-pass-through restrictions
+  // of IndexGraphStarter.
+  optional<size_t> farthest;
+  for (size_t i = 0; i < targets.size(); ++i)
+  {
+    if (targetsSegments[i].empty())
+      continue;
+
+    if (!farthest || mercator::DistanceOnEarth(source, targets[i]) >
+                         mercator::DistanceOnEarth(source, targets[*farthest]))
+    {
+      farthest = i;
+    }
+  }
+
+  if (!farthest)
+    return RouterResultCode::NoError;
+
+  graph.SetMode(WorldGraphMode::NoLeaps);
+  auto const sourceEnding = MakeFakeEnding(sourceSegments, source, graph);
+  IndexGraphStarter starter(sourceEnding,
+                            MakeFakeEnding(targetsSegments[*farthest], targets[*farthest], graph),
+                            0 /* fakeNumerationStart */, false /* strictForward */, graph);
+
+  // A target is reached when a real segment of its projection is settled. The route to the
+  // target goes through the parent of the segment and a part of the segment to the projection.
+  struct TargetPart
+  {
+    size_t m_targetIdx = 0;
+    Segment m_segment;
+    LatLonWithAltitude m_from;
+    LatLonWithAltitude m_to;
+    LatLonWithAltitude m_projection;
+    LatLonWithAltitude m_origin;
+    double m_fraction = 0.0;
+  };
+
+  auto const getFraction = [](LatLonWithAltitude const & from, LatLonWithAltitude const & to,
+                              LatLonWithAltitude const & projection) {
+    double const length = ms::DistanceOnEarth(from.GetLatLon(), to.GetLatLon());
+    if (length == 0.0)
+      return 0.0;
+    return min(1.0, ms::DistanceOnEarth(from.GetLatLon(), projection.GetLatLon()) / length);
+  };
+
+  vector<TargetPart> parts;
+  for (size_t i = 0; i < targets.size(); ++i)
+  {
+    if (targetsSegments[i].empty())
+      continue;
+
+    auto const ending = MakeFakeEnding(targetsSegments[i], targets[i], graph);
+    for (auto const & projection : ending.m_projections)
+    {
+      auto const & back = projection.m_segmentBack;
+      auto const & front = projection.m_segmentFront;
+      auto const & junction = projection.m_junction;
+      parts.push_back({i, projection.m_segment, back, front, junction, ending.m_originJunction,
+                       getFraction(back, front, junction)});
+      if (!projection.m_isOneWay)
+      {
+        auto reversed = projection.m_segment;
+        reversed.Inverse();
+        parts.push_back({i, reversed, front, back, junction, ending.m_originJunction,
+                         getFraction(front, back, junction)});
+      }
+    }
+  }
+
+  set<Segment> notSettled;
+  for (auto const & part : parts)
+    notSettled.insert(part.m_segment);
+
+  using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+  Algorithm algorithm;
+  Algorithm::Context context(starter);
+  bool cancelled = false;
+
+  auto const visitVertex = [&](Segment const & vertex) {
+    if (delegate.IsCancelled())
+    {
+      cancelled = true;
+      return false;
+    }
+
+    notSettled.erase(vertex);
+    return !notSettled.empty();
+  };
+  auto const adjustEdgeWeight = [](Segment const & /* vertex */, SegmentEdge const & edge) {
+    return edge.GetWeight();
+  };
+  auto const filterStates = [&starter](auto const & state) {
+    return starter.CheckLength(state.distance);
+  };
+  auto const reducedToRealLength = [](auto const & state) { return state.distance; };
+
+  algorithm.PropagateWave(starter, starter.GetStartSegment(), visitVertex, adjustEdgeWeight,
+                          filterStates, reducedToRealLength, context);
+  if (cancelled)
+    return RouterResultCode::Cancelled;
+
+  auto const calcOffroad = [&graph](LatLonWithAltitude const & from, LatLonWithAltitude const & to,
+                                    EdgeEstimator::Purpose purpose) {
+    return graph.CalcOffroadWeight(from.GetLatLon(), to.GetLatLon(), purpose);
+  };
+  auto const calcDistance = [](LatLonWithAltitude const & from, LatLonWithAltitude const & to) {
+    return ms::DistanceOnEarth(from.GetLatLon(), to.GetLatLon());
+  };
+
+  vector<RouteWeight> bestWeights(targets.size(), GetAStarWeightMax<RouteWeight>());
+  vector<Segment> path;
+  for (auto const & part : parts)
+  {
+    auto & cell = row[part.m_targetIdx];
+    auto & bestWeight = bestWeights[part.m_targetIdx];
+    auto const tail = calcOffroad(part.m_projection, part.m_origin, EdgeEstimator::Purpose::Weight);
+
+    // The target is ahead of the source on the same segment.
+    for (auto const & sourceProjection : sourceEnding.m_projections)
+    {
+      auto sourceSegment = sourceProjection.m_segment;
+      if (sourceSegment != part.m_segment)
+      {
+        if (sourceProjection.m_isOneWay)
+          continue;
+        sourceSegment.Inverse();
+        if (sourceSegment != part.m_segment)
+          continue;
+      }
+
+      auto const & sourceJunction = sourceProjection.m_junction;
+      double const fraction =
+          part.m_fraction - getFraction(part.m_from, part.m_to, sourceJunction);
+      if (fraction < 0.0)
+        continue;
+
+      auto const head = calcOffroad(sourceEnding.m_originJunction, sourceJunction,
+                                    EdgeEstimator::Purpose::Weight);
+      auto const weight =
+          head + fraction * starter.CalcSegmentWeight(part.m_segment, EdgeEstimator::Purpose::Weight) +
+          tail;
+      if (weight >= bestWeight)
+        continue;
+
+      bestWeight = weight;
+      cell.m_etaSec =
+          calcOffroad(sourceEnding.m_originJunction, sourceJunction, EdgeEstimator::Purpose::ETA)
+              .GetWeight() +
+          fraction * starter.CalculateETAWithoutPenalty(part.m_segment) +
+          calcOffroad(part.m_projection, part.m_origin, EdgeEstimator::Purpose::ETA).GetWeight();
+      cell.m_distanceMeters = calcDistance(sourceEnding.m_originJunction, sourceJunction) +
+                              calcDistance(sourceJunction, part.m_projection) +
+                              calcDistance(part.m_projection, part.m_origin);
+    }
+
+    if (!context.HasParent(part.m_segment))
+      continue;
+
+    auto const & parent = context.GetParent(part.m_segment);
+    auto const weight =
+        context.GetDistance(parent) +
+        part.m_fraction * starter.CalcSegmentWeight(part.m_segment, EdgeEstimator::Purpose::Weight) +
+        tail;
+    if (weight >= bestWeight)
+      continue;
+
+    bestWeight = weight;
+    context.ReconstructPath(parent, path);
+    CHECK(!path.empty(), ());
+
+    double eta = starter.CalculateETAWithoutPenalty(path.front());
+    double distance = 0.0;
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+      if (i != 0)
+        eta += starter.CalculateETA(path[i - 1], path[i], eta);
+      distance += ms::DistanceOnEarth(starter.GetPoint(path[i], false /* front */),
+                                      starter.GetPoint(path[i], true /* front */));
+    }
+
+    eta += part.m_fraction * starter.CalculateETAWithoutPenalty(part.m_segment) +
+           calcOffroad(part.m_projection, part.m_origin, EdgeEstimator::Purpose::ETA).GetWeight();
+    distance += calcDistance(part.m_from, part.m_projection) +
+                calcDistance(part.m_projection, part.m_origin);
+
+    cell.m_etaSec = eta;
+    cell.m_distanceMeters = distance;
+  }
+
+  return RouterResultCode::NoError;
+}
+
+void IndexRouter::SetRouteCacheSize(size_t maxSize)
+{
+  if (maxSize == 0)
+    m_routeCache.reset();
+  else
+    m_routeCache = make_unique<RouteCache>(maxSize);
+}
+
+void IndexRouter::ClearRouteCache()
+{
+  if (m_routeCache)
+    m_routeCache->Clear();
+}
+
+RouteCache::Stats IndexRouter::GetRouteCacheStats() const
+{
+  return m_routeCache ? m_routeCache->GetStats() : RouteCache::Stats();
+}
+
+RouteCache::Key IndexRouter::MakeRouteCacheKey(Checkpoints const & checkpoints,
+                                               m2::PointD const & startDirection) const
+{
+  // Only car routes depend on the routing options and the traffic, see MakeWorldGraph().
+  bool const isCar = m_vehicleType == VehicleType::Car;
+  return RouteCache::Key(checkpoints.GetPoints(), checkpoints.GetPassedIdx(), startDirection,
+                         m_vehicleType,
+                         isCar ? RoutingOptions::LoadCarOptionsFromSettings() : RoutingOptions(),
+                         isCar ? m_trafficCache.GetVersion() : 0);
+}
+
+void IndexRouter::UseCachedRoute(RouteCache::Entry const & entry, Route & route)
+{
+  auto const routeId = route.GetRouteId();
+  route = entry.m_route;
+  route.SetRouteId(routeId);
+
+  // The search state of the cached route is not kept, so it can't be adjusted.
+  m_lastRoute.reset();
+  m_lastFakeEdges.reset();
+  m_lastBackwardTree.Clear();
+
+  m_lastAlternatives.clear();
+  for (auto const & alternative : entry.m_alternatives)
+    m_lastAlternatives.push_back(make_shared<Route>(alternative));
+}
+
 RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
                                                m2::PointD const & startDirection,
                                                RouterDelegate const & delegate, Route & route)
 {
+  PROFILER_SCOPE("IndexRouter::DoCalculateRoute");
   m_lastRoute.reset();
+  m_lastAlternatives.clear();
+  m_lastBackwardTree.Clear();
   // MwmId used for guides segments in RedressRoute().
   NumMwmId guidesMwmId = kFakeNumMwmId;
 
@@ -585,15 +1092,19 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
     return RouterResultCode::NeedMoreMaps;
 
   TrafficStash::Guard guard(m_trafficStash);
-  unique_ptr<WorldGraph> graph = MakeWorldGraph();
+  unique_ptr<WorldGraph> graph = MakeWorldGraph(&delegate);
 
   vector<Segment> segments;
 
   vector<Segment> startSegments;
   bool startSegmentIsAlmostCodirectionalDirection = false;
-  bool const foundStart =
-      FindBestSegments(checkpoints.GetPointFrom(), startDirection, true /* isOutgoing */, *graph,
-                       startSegments, startSegmentIsAlmostCodirectionalDirection);
+  bool foundStart = false;
+  {
+    RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::Snapping);
+    foundStart =
+        FindBestSegments(checkpoints.GetPointFrom(), startDirection, true /* isOutgoing */, *graph,
+                         startSegments, startSegmentIsAlmostCodirectionalDirection);
+  }
 
   m_guides.SetGuidesGraphParams(guidesMwmId, m_estimator->GetMaxWeightSpeedMpS());
   m_guides.ConnectToGuidesGraph(checkpoints.GetPoints());
@@ -612,6 +1123,14 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
 
   unique_ptr<IndexGraphStarter> starter;
 
+  bool const findAlternatives = m_alternativesParams.m_maxCount != 0 &&
+                                checkpoints.GetPassedIdx() == 0 &&
+                                checkpoints.GetNumSubroutes() == 1 && !m_guides.IsAttached();
+  vector<vector<Segment>> alternatives;
+  // The route to the same finish is adjusted to the backward tree on reroute, see AdjustRoute().
+  bool const keepBackwardTree =
+      !findAlternatives && checkpoints.GetNumSubroutes() == 1 && !m_guides.IsAttached();
+
   auto progress = make_shared<AStarProgress>();
   double const checkpointsLength = checkpoints.GetSummaryLengthBetweenPointsMeters();
 
@@ -626,13 +1145,17 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
 
     vector<Segment> finishSegments;
     bool dummy = false;
+    bool foundFinish = false;
+    {
+      RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::Snapping);
+      foundFinish = FindBestSegments(finishCheckpoint, m2::PointD::Zero() /* direction */,
+                                     false /* isOutgoing */, *graph, finishSegments,
+                                     dummy /* bestSegmentIsAlmostCodirectional */);
+    }
 
     // Stop building route if |finishCheckpoint| is not connected to OSM and is not connected to
     // the guides graph.
-    if (!FindBestSegments(finishCheckpoint, m2::PointD::Zero() /* direction */,
-                          false /* isOutgoing */, *graph, finishSegments,
-                          dummy /* bestSegmentIsAlmostCodirectional */) &&
-        finishFakeEnding.m_projections.empty())
+    if (!foundFinish && finishFakeEnding.m_projections.empty())
     {
       return isLastSubroute ? RouterResultCode::EndPointNotFound
                             : RouterResultCode::IntermediatePointNotFound;
@@ -674,8 +1197,10 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
     progress->AppendSubProgress(subProgress);
     SCOPE_GUARD(eraseProgress, [&progress]() { progress->PushAndDropLastSubProgress(); });
 
-    auto const result = CalculateSubroute(checkpoints, i, delegate, progress, subrouteStarter,
-                                          subroute, m_guides.IsAttached());
+    auto const result =
+        CalculateSubroute(checkpoints, i, delegate, progress, subrouteStarter, subroute,
+                          m_guides.IsAttached(), findAlternatives ? &alternatives : nullptr,
+                          keepBackwardTree ? &m_lastBackwardTree : nullptr);
 
     if (result != RouterResultCode::NoError)
       return result;
@@ -706,6 +1231,7 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
 
   IndexGraphStarter::CheckValidRoute(segments);
 
+  RouterDelegate::ScopedPhaseTimer directionsTimer(delegate, RoutingPhase::Directions);
   // TODO (@gmoryes) https://jira.mail.ru/browse/MAPSME-10694
   //  We should do RedressRoute for each subroute separately.
   auto redressResult = RedressRoute(segments, delegate.GetCancellable(), *starter, route);
@@ -715,6 +1241,28 @@ RouterResultCode IndexRouter::DoCalculateRoute(Checkpoints const & checkpoints,
   LOG(LINFO, ("Route length:", route.GetTotalDistanceMeters(), "meters. ETA:",
       route.GetTotalTimeSec(), "seconds."));
 
+  for (auto const & alternative : alternatives)
+  {
+    IndexGraphStarter::CheckValidRoute(alternative);
+
+    auto const & attrs = route.GetSubrouteAttrs(0 /* subrouteIdx */);
+    auto alternativeRoute = make_shared<Route>(route.GetRouterId(), route.GetRouteId());
+    alternativeRoute->SetCurrentSubrouteIdx(0 /* currentSubrouteIdx */);
+    vector<Route::SubrouteAttrs> alternativeSubroutes;
+    alternativeSubroutes.emplace_back(attrs.GetStart(), attrs.GetFinish(), 0 /* beginSegmentIdx */,
+                                      alternative.size() /* endSegmentIdx */);
+    alternativeRoute->SetSubroteAttrs(move(alternativeSubroutes));
+    redressResult = RedressRoute(alternative, delegate.GetCancellable(), *starter, *alternativeRoute);
+    if (redressResult == RouterResultCode::Cancelled)
+      return redressResult;
+    if (redressResult != RouterResultCode::NoError)
+      continue;
+
+    LOG(LINFO, ("Alternative route length:", alternativeRoute->GetTotalDistanceMeters(),
+                "meters. ETA:", alternativeRoute->GetTotalTimeSec(), "seconds."));
+    m_lastAlternatives.push_back(move(alternativeRoute));
+  }
+
   m_lastRoute = make_unique<SegmentedRoute>(checkpoints.GetStart(), checkpoints.GetFinish(),
                                             route.GetSubroutes());
   for (Segment const & segment : segments)
@@ -751,13 +1299,97 @@ vector<Segment> ProcessJoints(vector<JointSegment> const & jointsPath,
   return path;
 }
 
+// Converts the backward tree of joints to the tree of their segments. Distances to the finish are
+// summed up along the segments tree, so they are the weights of the paths which are restored by
+// the parents of the segments.
+void ConvertJointsBackwardTree(astar::BackwardTree<JointSegment, RouteWeight> const & jointsTree,
+                               IndexGraphStarterJoints<IndexGraphStarter> & jointStarter,
+                               IndexGraphStarter & starter,
+                               astar::BackwardTree<Segment, RouteWeight> & tree)
+{
+  tree.Clear();
+
+  // The first segment of the path from a joint to the finish.
+  ska::bytell_hash_map<JointSegment, Segment> heads;
+  set<JointSegment> processed;
+
+  auto const convertJoint = [&](JointSegment const & joint) {
+    optional<Segment> next;
+    auto const parentIt = jointsTree.m_parents.find(joint);
+    if (parentIt != jointsTree.m_parents.cend())
+    {
+      auto const headIt = heads.find(parentIt->second);
+      if (headIt != heads.cend())
+        next = headIt->second;
+    }
+
+    vector<Segment> const path = jointStarter.ReconstructJoint(joint);
+    if (path.empty())
+    {
+      if (next)
+        heads.emplace(joint, *next);
+      return;
+    }
+
+    for (auto it = path.crbegin(); it != path.crend(); ++it)
+    {
+      auto const & segment = *it;
+      // Consequent joints may share a segment.
+      if (next && *next == segment)
+        continue;
+
+      // A segment which is already in the tree belongs to a joint which is not farther from
+      // the finish, so its parent is kept.
+      if (tree.m_distances.count(segment) == 0)
+      {
+        if (next)
+        {
+          tree.m_distances.emplace(
+              segment, tree.m_distances.at(*next) +
+                           starter.CalcSegmentWeight(*next, EdgeEstimator::Purpose::Weight));
+          tree.m_parents.emplace(segment, *next);
+        }
+        else
+        {
+          tree.m_distances.emplace(segment, GetAStarWeightZero<RouteWeight>());
+        }
+      }
+
+      next = segment;
+    }
+
+    heads.emplace(joint, path.front());
+  };
+
+  vector<JointSegment> chain;
+  for (auto const & item : jointsTree.m_distances)
+  {
+    // Joints are converted after their parents to know the paths from the parents to the finish.
+    chain.clear();
+    for (auto joint = item.first; processed.insert(joint).second;)
+    {
+      chain.push_back(joint);
+      auto const it = jointsTree.m_parents.find(joint);
+      if (it == jointsTree.m_parents.cend())
+        break;
+      joint = it->second;
+    }
+
+    for (auto it = chain.crbegin(); it != chain.crend(); ++it)
+      convertJoint(*it);
+  }
+}
+
 RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints, size_t subrouteIdx,
                                                 RouterDelegate const & delegate,
                                                 shared_ptr<AStarProgress> const & progress,
                                                 IndexGraphStarter & starter,
                                                 vector<Segment> & subroute,
-                                                bool guidesActive /* = false */)
+                                                bool guidesActive /* = false */,
+                                                vector<vector<Segment>> * alternatives /* = nullptr */,
+                                                BackwardTree * backwardTree /* = nullptr */)
 {
+  PROFILER_SCOPE("IndexRouter::CalculateSubroute");
   CHECK(progress, (checkpoints));
   subroute.clear();
 
@@ -769,9 +1401,11 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
   switch (mode)
   {
   case WorldGraphMode::Joints:
-    return CalculateSubrouteJointsMode(starter, delegate, progress, subroute);
+    return CalculateSubrouteJointsMode(starter, delegate, progress, subroute, alternatives,
+                                       backwardTree);
   case WorldGraphMode::NoLeaps:
-    return CalculateSubrouteNoLeapsMode(starter, delegate, progress, subroute);
+    return CalculateSubrouteNoLeapsMode(starter, delegate, progress, subroute, alternatives,
+                                        backwardTree);
   case WorldGraphMode::LeapsOnly:
     return CalculateSubrouteLeapsOnlyMode(checkpoints, subrouteIdx, starter, delegate, progress,
                                           subroute);
@@ -782,8 +1416,10 @@ RouterResultCode IndexRouter::CalculateSubroute(Checkpoints const & checkpoints,
 
 RouterResultCode IndexRouter::CalculateSubrouteJointsMode(
     IndexGraphStarter & starter, RouterDelegate const & delegate,
-    shared_ptr<AStarProgress> const & progress, vector<Segment> & subroute)
+    shared_ptr<AStarProgress> const & progress, vector<Segment> & subroute,
+    vector<vector<Segment>> * alternatives, BackwardTree * backwardTree)
 {
+  RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::Refinement);
   using JointsStarter = IndexGraphStarterJoints<IndexGraphStarter>;
   JointsStarter jointStarter(starter, starter.GetStartSegment(), starter.GetFinishSegment());
 
@@ -800,20 +1436,42 @@ RouterResultCode IndexRouter::CalculateSubrouteJointsMode(
       AStarLengthChecker(starter));
 
   RoutingResult<Vertex, Weight> routingResult;
-  RouterResultCode const result =
-      FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult);
+  vector<RoutingResult<Vertex, Weight>> alternativeResults;
+  astar::BackwardTree<Vertex, Weight> jointsTree;
+  RouterResultCode result = RouterResultCode::NoError;
+  if (alternatives)
+  {
+    result = FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult,
+                                            alternativeResults);
+  }
+  else if (backwardTree)
+  {
+    result = FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult, jointsTree);
+  }
+  else
+  {
+    result = FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult);
+  }
 
   if (result != RouterResultCode::NoError)
     return result;
 
   subroute = ProcessJoints(routingResult.m_path, jointStarter);
+  for (auto const & alternative : alternativeResults)
+    alternatives->push_back(ProcessJoints(alternative.m_path, jointStarter));
+
+  if (backwardTree && !jointsTree.IsEmpty())
+    ConvertJointsBackwardTree(jointsTree, jointStarter, starter, *backwardTree);
+
   return result;
 }
 
 RouterResultCode IndexRouter::CalculateSubrouteNoLeapsMode(
     IndexGraphStarter & starter, RouterDelegate const & delegate,
-    shared_ptr<AStarProgress> const & progress, vector<Segment> & subroute)
+    shared_ptr<AStarProgress> const & progress, vector<Segment> & subroute,
+    vector<vector<Segment>> * alternatives, BackwardTree * backwardTree)
 {
+  RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::Refinement);
   using Vertex = IndexGraphStarter::Vertex;
   using Edge = IndexGraphStarter::Edge;
   using Weight = IndexGraphStarter::Weight;
@@ -826,13 +1484,22 @@ RouterResultCode IndexRouter::CalculateSubrouteNoLeapsMode(
       delegate.GetCancellable(), move(visitor), AStarLengthChecker(starter));
 
   RoutingResult<Vertex, Weight> routingResult;
+  vector<RoutingResult<Vertex, Weight>> alternativeResults;
   set<NumMwmId> const mwmIds = starter.GetMwms();
-  RouterResultCode const result = FindPath<Vertex, Edge, Weight>(params, mwmIds, routingResult);
+  RouterResultCode result = RouterResultCode::NoError;
+  if (alternatives)
+    result = FindPath<Vertex, Edge, Weight>(params, mwmIds, routingResult, alternativeResults);
+  else if (backwardTree)
+    result = FindPath<Vertex, Edge, Weight>(params, mwmIds, routingResult, *backwardTree);
+  else
+    result = FindPath<Vertex, Edge, Weight>(params, mwmIds, routingResult);
 
   if (result != RouterResultCode::NoError)
     return result;
 
   subroute = move(routingResult.m_path);
+  for (auto & alternative : alternativeResults)
+    alternatives->push_back(move(alternative.m_path));
   return RouterResultCode::NoError;
 }
 
@@ -842,6 +1509,8 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(
     vector<Segment> & subroute)
 {
   LeapsGraph leapsGraph(starter, MwmHierarchyHandler(m_numMwmIds, m_countryParentNameGetterFn));
+  if (auto const * landmarks = GetCrossMwmLandmarks())
+    leapsGraph.SetLandmarks(*landmarks);
 
   using Vertex = LeapsGraph::Vertex;
   using Edge = LeapsGraph::Edge;
@@ -861,8 +1530,11 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(
       AStarLengthChecker(starter));
 
   RoutingResult<Vertex, Weight> routingResult;
-  RouterResultCode const result =
-      FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult);
+  RouterResultCode result = RouterResultCode::NoError;
+  {
+    RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::Leaps);
+    result = FindPath<Vertex, Edge, Weight>(params, {} /* mwmIds */, routingResult);
+  }
 
   progress->PushAndDropLastSubProgress();
 
@@ -870,13 +1542,16 @@ RouterResultCode IndexRouter::CalculateSubrouteLeapsOnlyMode(
     return result;
 
   vector<Segment> subrouteWithoutPostprocessing;
-  RouterResultCode const leapsResult =
-      ProcessLeapsJoints(routingResult.m_path, delegate, starter.GetGraph().GetMode(), starter,
-                         progress, subrouteWithoutPostprocessing);
+  {
+    RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::Refinement);
+    result = ProcessLeapsJoints(routingResult.m_path, delegate, starter.GetGraph().GetMode(),
+                                starter, progress, subrouteWithoutPostprocessing);
+  }
 
-  if (leapsResult != RouterResultCode::NoError)
-    return leapsResult;
+  if (result != RouterResultCode::NoError)
+    return result;
 
+  RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::LeapsPostProcessing);
   LeapsPostProcessor leapsPostProcessor(subrouteWithoutPostprocessing, starter);
   subroute = leapsPostProcessor.GetProcessedPath();
 
@@ -889,18 +1564,22 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
 {
   base::Timer timer;
   TrafficStash::Guard guard(m_trafficStash);
-  auto graph = MakeWorldGraph();
+  auto graph = MakeWorldGraph(&delegate);
   graph->SetMode(WorldGraphMode::NoLeaps);
 
   vector<Segment> startSegments;
   m2::PointD const & pointFrom = checkpoints.GetPointFrom();
   bool bestSegmentIsAlmostCodirectional = false;
-  if (!FindBestSegments(pointFrom, startDirection, true /* isOutgoing */, *graph, startSegments,
-                        bestSegmentIsAlmostCodirectional))
+  bool foundStart = false;
   {
-    return RouterResultCode::StartPointNotFound;
+    RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::Snapping);
+    foundStart = FindBestSegments(pointFrom, startDirection, true /* isOutgoing */, *graph,
+                                  startSegments, bestSegmentIsAlmostCodirectional);
   }
 
+  if (!foundStart)
+    return RouterResultCode::StartPointNotFound;
+
   auto const & lastSubroutes = m_lastRoute->GetSubroutes();
   CHECK(!lastSubroutes.empty(), ());
   auto const & lastSubroute = m_lastRoute->GetSubroute(checkpoints.GetPassedIdx());
@@ -915,13 +1594,21 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
 
   starter.Append(*m_lastFakeEdges);
 
+  // Fake segments of the backward tree are kept by |m_lastFakeEdges|, so the tree may be used
+  // with |starter|. The tree contains the previous route, so the route is adjusted to any vertex
+  // reached by the previous search.
+  bool const useBackwardTree = !m_lastBackwardTree.IsEmpty() && lastSubroutes.size() == 1;
+
   vector<SegmentEdge> prevEdges;
   CHECK_LESS_OR_EQUAL(lastSubroute.GetEndSegmentIdx(), steps.size(), ());
-  for (size_t i = lastSubroute.GetBeginSegmentIdx(); i < lastSubroute.GetEndSegmentIdx(); ++i)
+  if (!useBackwardTree)
   {
-    auto const & step = steps[i];
-    prevEdges.emplace_back(step.GetSegment(), starter.CalcSegmentWeight(step.GetSegment(),
-                           EdgeEstimator::Purpose::Weight));
+    for (size_t i = lastSubroute.GetBeginSegmentIdx(); i < lastSubroute.GetEndSegmentIdx(); ++i)
+    {
+      auto const & step = steps[i];
+      prevEdges.emplace_back(step.GetSegment(), starter.CalcSegmentWeight(step.GetSegment(),
+                             EdgeEstimator::Purpose::Weight));
+    }
   }
 
   using Visitor = JunctionVisitor<IndexGraphStarter>;
@@ -937,8 +1624,13 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
       delegate.GetCancellable(), move(visitor), AdjustLengthChecker(starter));
 
   RoutingResult<Segment, RouteWeight> result;
-  auto const resultCode =
-      ConvertResult<Vertex, Edge, Weight>(algorithm.AdjustRoute(params, result));
+  RouterResultCode resultCode = RouterResultCode::NoError;
+  {
+    RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::Refinement);
+    resultCode = ConvertResult<Vertex, Edge, Weight>(
+        useBackwardTree ? algorithm.AdjustRoute(params, m_lastBackwardTree, result)
+                        : algorithm.AdjustRoute(params, result));
+  }
   if (resultCode != RouterResultCode::NoError)
     return resultCode;
 
@@ -970,17 +1662,23 @@ RouterResultCode IndexRouter::AdjustRoute(Checkpoints const & checkpoints,
   route.SetCurrentSubrouteIdx(checkpoints.GetPassedIdx());
   route.SetSubroteAttrs(move(subroutes));
 
-  auto const redressResult = RedressRoute(result.m_path, delegate.GetCancellable(), starter, route);
+  RouterResultCode redressResult = RouterResultCode::NoError;
+  {
+    RouterDelegate::ScopedPhaseTimer phaseTimer(delegate, RoutingPhase::Directions);
+    redressResult = RedressRoute(result.m_path, delegate.GetCancellable(), starter, route);
+  }
   if (redressResult != RouterResultCode::NoError)
     return redressResult;
 
   LOG(LINFO, ("Adjust route, elapsed:", timer.ElapsedSeconds(), ", prev start:", checkpoints,
-              ", prev route:", steps.size(), ", new route:", result.m_path.size()));
+              ", prev route:", steps.size(), ", new route:", result.m_path.size(),
+              ", backward tree:", useBackwardTree ? m_lastBackwardTree.m_distances.size() : 0));
 
   return RouterResultCode::NoError;
 }
 
-unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
+unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph(
+    RouterDelegate const * delegate /* = nullptr */)
 {
   RoutingOptions routingOptions;
   if (m_vehicleType == VehicleType::Car)
@@ -997,7 +1695,7 @@ unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
   auto indexGraphLoader = IndexGraphLoader::Create(
       m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType,
       m_loadAltitudes, m_numMwmIds, m_vehicleModelFactory, m_estimator, m_dataSource,
-      routingOptions);
+      routingOptions, delegate);
 
   if (m_vehicleType != VehicleType::Transit)
   {
@@ -1014,11 +1712,11 @@ unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
 }
 
 void IndexRouter::EraseIfDeadEnd(WorldGraph & worldGraph, m2::PointD const & checkpoint,
-                                 vector<IRoadGraph::FullRoadInfo> & roads) const
+                                 vector<IRoadGraph::FullRoadInfo> & roads,
+                                 DeadEndsCache & cache) const
 {
-  // |deadEnds| cache is necessary to minimize number of calls a time consumption IsDeadEnd() method.
-  set<Segment> deadEnds;
-  base::EraseIf(roads, [&deadEnds, &worldGraph, &checkpoint, this](auto const & fullRoadInfo) {
+  // |cache| is necessary to minimize number of calls a time consumption IsDeadEnd() method.
+  base::EraseIf(roads, [&cache, &worldGraph, &checkpoint, this](auto const & fullRoadInfo) {
     CHECK_GREATER_OR_EQUAL(fullRoadInfo.m_roadInfo.m_junctions.size(), 2, ());
     auto const squaredDistAndIndex = m2::CalcMinSquaredDistance(fullRoadInfo.m_roadInfo.m_junctions.begin(),
                                                                 fullRoadInfo.m_roadInfo.m_junctions.end(),
@@ -1034,7 +1732,7 @@ void IndexRouter::EraseIfDeadEnd(WorldGraph & worldGraph, m2::PointD const & che
                                                          fullRoadInfo.m_roadInfo.m_junctions[0],
                                                          fullRoadInfo.m_roadInfo.m_junctions[1]));
     return IsDeadEndCached(segment, true /* isOutgoing */, false /* useRoutingOptions */, worldGraph,
-                           deadEnds);
+                           cache.m_deadEnds, cache.m_notDeadEnds);
   });
 }
 
@@ -1131,16 +1829,22 @@ bool IndexRouter::FindBestSegments(m2::PointD const & checkpoint, m2::PointD con
 {
   auto const file = platform::CountryFile(m_countryFileFn(checkpoint));
 
+  // Roads of the smaller radii are checked for dead ends again with the greater ones.
+  DeadEndsCache roadsCache;
+  DeadEndsCache candidatesCache;
   vector<Edge> bestEdges;
   if (!FindBestEdges(checkpoint, file, direction, isOutgoing, 40.0 /* closestEdgesRadiusM */,
-                     worldGraph, bestEdges, bestSegmentIsAlmostCodirectional))
+                     worldGraph, bestEdges, bestSegmentIsAlmostCodirectional, roadsCache,
+                     candidatesCache))
   {
     if (!FindBestEdges(checkpoint, file, direction, isOutgoing, 500.0 /* closestEdgesRadiusM */,
-                       worldGraph, bestEdges, bestSegmentIsAlmostCodirectional) &&
+                       worldGraph, bestEdges, bestSegmentIsAlmostCodirectional, roadsCache,
+                       candidatesCache) &&
                        bestEdges.size() < kMaxRoadCandidates)
     {
       if (!FindBestEdges(checkpoint, file, direction, isOutgoing, 2000.0 /* closestEdgesRadiusM */,
-                         worldGraph, bestEdges, bestSegmentIsAlmostCodirectional))
+                         worldGraph, bestEdges, bestSegmentIsAlmostCodirectional, roadsCache,
+                         candidatesCache))
       {
         return false;
       }
@@ -1160,6 +1864,20 @@ bool IndexRouter::FindBestEdges(m2::PointD const & checkpoint,
                                 double closestEdgesRadiusM, WorldGraph & worldGraph,
                                 vector<Edge> & bestEdges,
                                 bool & bestSegmentIsAlmostCodirectional) const
+{
+  DeadEndsCache roadsCache;
+  DeadEndsCache candidatesCache;
+  return FindBestEdges(checkpoint, pointCountryFile, direction, isOutgoing, closestEdgesRadiusM,
+                       worldGraph, bestEdges, bestSegmentIsAlmostCodirectional, roadsCache,
+                       candidatesCache);
+}
+
+bool IndexRouter::FindBestEdges(m2::PointD const & checkpoint,
+                                platform::CountryFile const & pointCountryFile,
+                                m2::PointD const & direction, bool isOutgoing,
+                                double closestEdgesRadiusM, WorldGraph & worldGraph,
+                                vector<Edge> & bestEdges, bool & bestSegmentIsAlmostCodirectional,
+                                DeadEndsCache & roadsCache, DeadEndsCache & candidatesCache) const
 {
   CHECK(m_vehicleModelFactory, ());
   MwmSet::MwmHandle handle = m_dataSource.GetMwmHandleByCountryFile(pointCountryFile);
@@ -1178,7 +1896,7 @@ bool IndexRouter::FindBestEdges(m2::PointD const & checkpoint,
   // If to remove all fenced off by other features from |checkpoint| candidates at first,
   // only dead ends candidates may be left. And then the dead end candidates will be removed
   // as well as dead ends. It often happens near airports.
-  EraseIfDeadEnd(worldGraph, checkpoint, closestRoads);
+  EraseIfDeadEnd(worldGraph, checkpoint, closestRoads, roadsCache);
 
   // Sorting from the closest features to the further ones. The idea is the closer
   // a feature to a |checkpoint| the more chances that it crosses the segment
@@ -1200,10 +1918,10 @@ bool IndexRouter::FindBestEdges(m2::PointD const & checkpoint,
   // Then in |IsDeadEndCached(..., true /* useRoutingOptions */, ...)| below we ignore
   // candidates if it's a dead end taking into acount routing options. We ignore candidates as well
   // if they don't match RoutingOptions.
-  set<Segment> deadEnds;
   auto const isGood = [&](pair<Edge, geometry::PointWithAltitude> const & edgeProj) {
     auto const segment = GetSegmentByEdge(edgeProj.first);
-    if (IsDeadEndCached(segment, isOutgoing, true /* useRoutingOptions */,  worldGraph, deadEnds))
+    if (IsDeadEndCached(segment, isOutgoing, true /* useRoutingOptions */, worldGraph,
+                        candidatesCache.m_deadEnds, candidatesCache.m_notDeadEnds))
       return false;
 
     // Removing all candidates which are fenced off by the road graph (|closestRoads|) from |checkpoint|.
@@ -1368,9 +2086,9 @@ RouterResultCode IndexRouter::ProcessLeapsJoints(vector<Segment> const & input,
       if (start == prevStart && !paths.empty())
         paths.pop_back();
 
-      ASSERT(!subroute.empty(), ());
-      paths.emplace_back(vector<Segment>(dropFirstSegment ? subroute.cbegin() + 1
-                                                          : subroute.cbegin(), subroute.cend()));
+      if (dropFirstSegment)
+        subroute.erase(subroute.begin());
+      paths.emplace_back(move(subroute));
 
       dropFirstSegment = true;
       prevStart = start;
@@ -1451,6 +2169,11 @@ RouterResultCode IndexRouter::ProcessLeapsJoints(vector<Segment> const & input,
     i = next;
   }
 
+  size_t outputSize = output.size();
+  for (auto const & path : paths)
+    outputSize += path.size();
+  output.reserve(outputSize);
+
   while (!paths.empty())
   {
     using Iterator = vector<Segment>::iterator;
@@ -1467,6 +2190,7 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
                                            base::Cancellable const & cancellable,
                                            IndexGraphStarter & starter, Route & route) const
 {
+  PROFILER_SCOPE("IndexRouter::RedressRoute");
   CHECK(!segments.empty(), ());
   vector<geometry::PointWithAltitude> junctions;
   size_t const numPoints = IndexGraphStarter::GetRouteNumPoints(segments);
@@ -1490,7 +2214,7 @@ RouterResultCode IndexRouter::RedressRoute(vector<Segment> const & segments,
 
   for (size_t i = 1; i < segments.size(); ++i)
   {
-    time += starter.CalculateETA(segments[i - 1], segments[i]);
+    time += starter.CalculateETA(segments[i - 1], segments[i], time);
     times.emplace_back(static_cast<uint32_t>(i + 1), time);
   }
 
@@ -1573,6 +2297,67 @@ bool IndexRouter::DoesTransitSectionExist(NumMwmId numMwmId) const
   return mwmValue.m_cont.IsExist(TRANSIT_FILE_TAG);
 }
 
+CrossMwmLandmarks const * IndexRouter::GetCrossMwmLandmarks()
+{
+  // Landmarks are used by LeapsGraph only and only car routes are built with leaps,
+  // see SetupAlgorithmMode().
+  if (m_vehicleType != VehicleType::Car)
+    return nullptr;
+
+  CHECK(m_numMwmIds, ());
+  if (!m_crossMwmLandmarksLoaded)
+  {
+    m_crossMwmLandmarksLoaded = true;
+
+    MwmSet::MwmHandle handle = indexer::FindWorld(m_dataSource);
+    if (!handle.IsAlive() || !handle.GetValue()->m_cont.IsExist(CROSS_MWM_LANDMARKS_FILE_TAG))
+      return nullptr;
+
+    try
+    {
+      auto landmarks = make_unique<CrossMwmLandmarks>();
+      ReaderSource<FilesContainerR::TReader> src(
+          handle.GetValue()->m_cont.GetReader(CROSS_MWM_LANDMARKS_FILE_TAG));
+      landmarks->Deserialize(src);
+      landmarks->BindNumMwmIds(*m_numMwmIds);
+      m_crossMwmLandmarks = move(landmarks);
+      m_crossMwmLandmarksVersion = handle.GetInfo()->GetVersion();
+    }
+    catch (Reader::Exception const & e)
+    {
+      LOG(LERROR, ("Error while reading", CROSS_MWM_LANDMARKS_FILE_TAG, "section:", e.Msg()));
+      return nullptr;
+    }
+  }
+
+  if (!m_crossMwmLandmarks)
+    return nullptr;
+
+  // Bounds are valid only for the cross mwm weights the landmarks are built with. Transitions of
+  // the mwms which are not taken into account by the landmarks break consistency of the heuristic.
+  bool compatible = true;
+  m_numMwmIds->ForEachId([&](NumMwmId numMwmId) {
+    auto const & file = m_numMwmIds->GetFile(numMwmId);
+    if (!compatible || file.GetName() == WORLD_FILE_NAME ||
+        file.GetName() == WORLD_COASTS_FILE_NAME)
+    {
+      return;
+    }
+
+    auto const mwmId = m_dataSource.GetMwmIdByCountryFile(file);
+    if (!mwmId.IsAlive())
+      return;
+
+    if (mwmId.GetInfo()->GetVersion() != m_crossMwmLandmarksVersion ||
+        !m_crossMwmLandmarks->GetTransitions().HasCountry(file.GetName()))
+    {
+      compatible = false;
+    }
+  });
+
+  return compatible ? m_crossMwmLandmarks.get() : nullptr;
+}
+
 RouterResultCode IndexRouter::ConvertTransitResult(set<NumMwmId> const & mwmIds,
                                                    RouterResultCode resultCode) const
 {
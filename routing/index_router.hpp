@@ -4,6 +4,7 @@
 #include "routing/base/astar_progress.hpp"
 #include "routing/base/routing_result.hpp"
 #include "routing/cross_mwm_graph.hpp"
+#include "routing/cross_mwm_landmarks.hpp"
 #include "routing/directions_engine.hpp"
 #include "routing/edge_estimator.hpp"
 #include "routing/fake_edges_container.hpp"
@@ -12,6 +13,7 @@
 #include "routing/index_graph_starter_joints.hpp"
 #include "routing/joint.hpp"
 #include "routing/nearest_edge_finder.hpp"
+#include "routing/route_cache.hpp"
 #include "routing/router.hpp"
 #include "routing/routing_callbacks.hpp"
 #include "routing/segment.hpp"
@@ -20,6 +22,8 @@
 #include "routing_common/num_mwm_id.hpp"
 #include "routing_common/vehicle_model.hpp"
 
+#include "traffic/traffic_cache.hpp"
+
 #include "indexer/mwm_set.hpp"
 
 #include "platform/country_file.hpp"
@@ -30,9 +34,11 @@
 #include "geometry/tree4d.hpp"
 
 #include <functional>
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -100,21 +106,99 @@ public:
 
   VehicleType GetVehicleType() const { return m_vehicleType; }
 
+  /// \brief Alternatives are looked for in the same search as a route if |params.m_maxCount|
+  /// isn't zero. It's done only for routes without intermediate points and guides which are
+  /// built in Joints or NoLeaps mode.
+  void SetAlternativesParams(astar::AlternativesParams const & params)
+  {
+    m_alternativesParams = params;
+  }
+
+  /// \brief Enables the cache of up to |maxSize| built routes, see RouteCache. Zero |maxSize|
+  /// disables the cache. The cache is disabled by default. Routes with guides are not cached.
+  void SetRouteCacheSize(size_t maxSize);
+  /// \brief Removes all the cached routes. It should be called when the maps are updated.
+  void ClearRouteCache();
+  /// \returns hits and misses of the route cache since it was enabled.
+  RouteCache::Stats GetRouteCacheStats() const;
+
+  /// \returns alternatives to the route calculated by the last CalculateRoute() call.
+  std::vector<std::shared_ptr<Route>> const & GetLastAlternatives() const
+  {
+    return m_lastAlternatives;
+  }
+
+  struct MatrixCell
+  {
+    bool IsFound() const { return m_etaSec != std::numeric_limits<double>::infinity(); }
+
+    double m_etaSec = std::numeric_limits<double>::infinity();
+    double m_distanceMeters = std::numeric_limits<double>::infinity();
+  };
+  // |matrix[i][j]| is a route from the i-th source to the j-th target.
+  using Matrix = std::vector<std::vector<MatrixCell>>;
+
+  /// \brief Fills |matrix| with ETA and length of the fastest routes from every point of |sources|
+  /// to every point of |targets|. Every point is snapped to roads only once and one wave is
+  /// propagated from every source until all the targets are reached. Sources are processed on
+  /// |threadsCount| threads. Cells of the points which can't be snapped or connected are not found.
+  /// \note Neither route geometry nor turns are built. Leaps are not used, so the method is
+  /// intended for points of a city or a region.
+  RouterResultCode CalculateMatrix(std::vector<m2::PointD> const & sources,
+                                   std::vector<m2::PointD> const & targets, size_t threadsCount,
+                                   RouterDelegate const & delegate, Matrix & matrix);
+
+  struct Isochrone
+  {
+    // Ends of the road segments which are reachable from the source.
+    std::vector<m2::PointD> m_reachablePoints;
+    // Convex hull of |m_reachablePoints| in counterclockwise order.
+    std::vector<m2::PointD> m_polygon;
+  };
+
+  /// \brief Fills |isochrones| with the areas reachable from every point of |sources| within
+  /// |maxTimeSec|. One wave bounded by the time is propagated from every source. Sources are
+  /// processed on |threadsCount| threads. Isochrones of the points which can't be snapped are
+  /// empty.
+  /// \note The time is measured by the route weight, i.e. with the penalties. Leaps are not used.
+  RouterResultCode CalculateIsochrones(std::vector<m2::PointD> const & sources, double maxTimeSec,
+                                       size_t threadsCount, RouterDelegate const & delegate,
+                                       std::vector<Isochrone> & isochrones);
+
 private:
+  using BackwardTree = astar::BackwardTree<Segment, RouteWeight>;
+
+  // Results of the dead end checks near a checkpoint. They don't depend on the search radius, so
+  // they are shared between FindBestEdges() calls for the same checkpoint.
+  struct DeadEndsCache
+  {
+    std::set<Segment> m_deadEnds;
+    std::set<Segment> m_notDeadEnds;
+  };
+
   RouterResultCode CalculateSubrouteJointsMode(IndexGraphStarter & starter,
                                                RouterDelegate const & delegate,
                                                std::shared_ptr<AStarProgress> const & progress,
-                                               std::vector<Segment> & subroute);
+                                               std::vector<Segment> & subroute,
+                                               std::vector<std::vector<Segment>> * alternatives,
+                                               BackwardTree * backwardTree);
   RouterResultCode CalculateSubrouteNoLeapsMode(IndexGraphStarter & starter,
                                                 RouterDelegate const & delegate,
                                                 std::shared_ptr<AStarProgress> const & progress,
-                                                std::vector<Segment> & subroute);
+                                                std::vector<Segment> & subroute,
+                                                std::vector<std::vector<Segment>> * alternatives,
+                                                BackwardTree * backwardTree);
   RouterResultCode CalculateSubrouteLeapsOnlyMode(Checkpoints const & checkpoints,
                                                   size_t subrouteIdx, IndexGraphStarter & starter,
                                                   RouterDelegate const & delegate,
                                                   std::shared_ptr<AStarProgress> const & progress,
                                                   std::vector<Segment> & subroute);
 
+  RouteCache::Key MakeRouteCacheKey(Checkpoints const & checkpoints,
+                                    m2::PointD const & startDirection) const;
+  // Fills |route| and the last alternatives with the routes of |entry|.
+  void UseCachedRoute(RouteCache::Entry const & entry, Route & route);
+
   RouterResultCode DoCalculateRoute(Checkpoints const & checkpoints,
                                     m2::PointD const & startDirection,
                                     RouterDelegate const & delegate, Route & route);
@@ -122,20 +206,39 @@ private:
                                      RouterDelegate const & delegate,
                                      std::shared_ptr<AStarProgress> const & progress,
                                      IndexGraphStarter & graph, std::vector<Segment> & subroute,
-                                     bool guidesActive = false);
+                                     bool guidesActive = false,
+                                     std::vector<std::vector<Segment>> * alternatives = nullptr,
+                                     BackwardTree * backwardTree = nullptr);
 
   RouterResultCode AdjustRoute(Checkpoints const & checkpoints,
                                m2::PointD const & startDirection,
                                RouterDelegate const & delegate, Route & route);
 
-  std::unique_ptr<WorldGraph> MakeWorldGraph();
+  // Loading of the mwms of the graph is taken into account by the profile of |delegate| if it's set.
+  std::unique_ptr<WorldGraph> MakeWorldGraph(RouterDelegate const * delegate = nullptr);
+
+  // Returns NeedMoreMaps if the map of any of |points| isn't loaded.
+  RouterResultCode CheckCountries(std::vector<m2::PointD> const & points) const;
+  // Fills |isochrone| of |source|. Empty |sourceSegments| mean the source is not snapped.
+  RouterResultCode CalculateIsochrone(m2::PointD const & source,
+                                      std::vector<Segment> const & sourceSegments,
+                                      double maxTimeSec, RouterDelegate const & delegate,
+                                      WorldGraph & graph, Isochrone & isochrone) const;
+  // Fills |row| of the routes matrix from |source| to |targets|. Empty |sourceSegments| or
+  // |targetsSegments[i]| mean the point is not snapped.
+  RouterResultCode CalculateMatrixRow(m2::PointD const & source,
+                                      std::vector<Segment> const & sourceSegments,
+                                      std::vector<m2::PointD> const & targets,
+                                      std::vector<std::vector<Segment>> const & targetsSegments,
+                                      RouterDelegate const & delegate, WorldGraph & graph,
+                                      std::vector<MatrixCell> & row) const;
 
   /// \brief Removes all roads from |roads| which goes to dead ends and all road which
   /// is not good according to |worldGraph|. For car routing there are roads with hwtag nocar as well.
   /// \param checkpoint which is used to look for the closest segment in a road. The closest segment
   /// is used then to check if it's a dead end.
   void EraseIfDeadEnd(WorldGraph & worldGraph, m2::PointD const & checkpoint,
-                      std::vector<IRoadGraph::FullRoadInfo> & roads) const;
+                      std::vector<IRoadGraph::FullRoadInfo> & roads, DeadEndsCache & cache) const;
 
   /// \returns true if a segment (|point|, |edgeProjection.second|) crosses one of segments
   /// in |fences| except for a one which has the same geometry with |edgeProjection.first|.
@@ -171,6 +274,14 @@ private:
   bool FindBestSegments(m2::PointD const & checkpoint, m2::PointD const & direction, bool isOutgoing,
                         WorldGraph & worldGraph, std::vector<Segment> & bestSegments,
                         bool & bestSegmentIsAlmostCodirectional) const;
+  /// \brief Same as the public FindBestEdges() but reuses the dead end checks of the roads
+  /// (|roadsCache|) and of the candidates (|candidatesCache|) made by previous calls.
+  bool FindBestEdges(m2::PointD const & checkpoint,
+                     platform::CountryFile const & pointCountryFile,
+                     m2::PointD const & direction, bool isOutgoing,
+                     double closestEdgesRadiusM, WorldGraph & worldGraph,
+                     std::vector<Edge> & bestEdges, bool & bestSegmentIsAlmostCodirectional,
+                     DeadEndsCache & roadsCache, DeadEndsCache & candidatesCache) const;
 
   // Input route may contains 'leaps': shortcut edges from mwm border enter to exit.
   // ProcessLeaps replaces each leap with calculated route through mwm.
@@ -186,6 +297,10 @@ private:
   bool AreMwmsNear(IndexGraphStarter const & starter) const;
   bool DoesTransitSectionExist(NumMwmId numMwmId) const;
 
+  // Returns landmarks of the car transition graph of World.mwm or nullptr if they don't exist or
+  // are built for other versions of the loaded mwms.
+  CrossMwmLandmarks const * GetCrossMwmLandmarks();
+
   RouterResultCode ConvertTransitResult(std::set<NumMwmId> const & mwmIds,
                                         RouterResultCode resultCode) const;
 
@@ -206,15 +321,43 @@ private:
     UNREACHABLE();
   }
 
+  template <typename Vertex, typename Edge, typename Weight>
+  AStarAlgorithm<Vertex, Edge, Weight> const & GetAStarAlgorithm() const
+  {
+    return std::get<AStarAlgorithm<Vertex, Edge, Weight>>(m_algorithms);
+  }
+
   template <typename Vertex, typename Edge, typename Weight, typename AStarParams>
   RouterResultCode FindPath(AStarParams & params, std::set<NumMwmId> const & mwmIds,
                             RoutingResult<Vertex, Weight> & routingResult) const
   {
-    AStarAlgorithm<Vertex, Edge, Weight> algorithm;
+    auto const & algorithm = GetAStarAlgorithm<Vertex, Edge, Weight>();
     return ConvertTransitResult(
         mwmIds, ConvertResult<Vertex, Edge, Weight>(algorithm.FindPathBidirectional(params, routingResult)));
   }
 
+  template <typename Vertex, typename Edge, typename Weight, typename AStarParams>
+  RouterResultCode FindPath(AStarParams & params, std::set<NumMwmId> const & mwmIds,
+                            RoutingResult<Vertex, Weight> & routingResult,
+                            std::vector<RoutingResult<Vertex, Weight>> & alternatives) const
+  {
+    auto const & algorithm = GetAStarAlgorithm<Vertex, Edge, Weight>();
+    return ConvertTransitResult(
+        mwmIds, ConvertResult<Vertex, Edge, Weight>(algorithm.FindPathBidirectional(
+                    params, m_alternativesParams, routingResult, alternatives)));
+  }
+
+  template <typename Vertex, typename Edge, typename Weight, typename AStarParams>
+  RouterResultCode FindPath(AStarParams & params, std::set<NumMwmId> const & mwmIds,
+                            RoutingResult<Vertex, Weight> & routingResult,
+                            astar::BackwardTree<Vertex, Weight> & backwardTree) const
+  {
+    auto const & algorithm = GetAStarAlgorithm<Vertex, Edge, Weight>();
+    return ConvertTransitResult(
+        mwmIds, ConvertResult<Vertex, Edge, Weight>(
+                    algorithm.FindPathBidirectional(params, routingResult, backwardTree)));
+  }
+
   void SetupAlgorithmMode(IndexGraphStarter & starter, bool guidesActive = false) const;
   uint32_t ConnectTracksOnGuidesToOsm(std::vector<m2::PointD> const & checkpoints,
                                       WorldGraph & graph);
@@ -240,6 +383,7 @@ private:
   CourntryRectFn const m_countryRectFn;
   std::shared_ptr<NumMwmIds> m_numMwmIds;
   std::shared_ptr<m4::Tree<NumMwmId>> m_numMwmTree;
+  traffic::TrafficCache const & m_trafficCache;
   std::shared_ptr<TrafficStash> m_trafficStash;
   FeaturesRoadGraph m_roadGraph;
 
@@ -247,6 +391,24 @@ private:
   std::unique_ptr<DirectionsEngine> m_directionsEngine;
   std::unique_ptr<SegmentedRoute> m_lastRoute;
   std::unique_ptr<FakeEdgesContainer> m_lastFakeEdges;
+  // Backward search tree of the last route with a single subroute. The route is adjusted to it
+  // instead of the last route when the user leaves the route.
+  BackwardTree m_lastBackwardTree;
+
+  // Loaded on the first use of GetCrossMwmLandmarks().
+  std::unique_ptr<CrossMwmLandmarks> m_crossMwmLandmarks;
+  int64_t m_crossMwmLandmarksVersion = 0;
+  bool m_crossMwmLandmarksLoaded = false;
+
+  // Algorithms of the subroutes and the leaps. They keep their memory between the searches
+  // of a route and release it in ClearState().
+  std::tuple<AStarAlgorithm<Segment, SegmentEdge, RouteWeight>,
+             AStarAlgorithm<JointSegment, JointEdge, RouteWeight>>
+      m_algorithms;
+
+  astar::AlternativesParams m_alternativesParams;
+  std::vector<std::shared_ptr<Route>> m_lastAlternatives;
+  std::unique_ptr<RouteCache> m_routeCache;
 
   // If a ckeckpoint is near to the guide track we need to build route through this track.
   GuidesConnections m_guides;
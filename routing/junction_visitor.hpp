@@ -29,6 +29,8 @@ public:
 
   void operator()(Vertex const & from, Vertex const & to)
   {
+    m_delegate.OnVertexSettled();
+
     ++m_visitCounter;
     if (m_visitCounter % m_visitPeriod != 0)
       return;
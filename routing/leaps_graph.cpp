@@ -2,6 +2,7 @@
 
 #include "base/assert.hpp"
 
+#include <algorithm>
 #include <set>
 #include <utility>
 
@@ -33,7 +34,38 @@ RouteWeight LeapsGraph::HeuristicCostEstimate(Segment const & from, Segment cons
   ASSERT(to == m_startSegment || to == m_finishSegment, ());
   bool const toFinish = to == m_finishSegment;
   auto const & toPoint = toFinish ? m_finishPoint : m_startPoint;
-  return m_starter.HeuristicCostEstimate(from, toPoint);
+  auto const estimate = m_starter.HeuristicCostEstimate(from, toPoint);
+  if (m_landmarks == nullptr)
+    return estimate;
+
+  auto const v = m_landmarks->GetVertex(from);
+  if (!v)
+    return estimate;
+
+  auto const bound = toFinish ? m_landmarks->GetLowerBoundToTargets(*v, m_finishBounds)
+                              : m_landmarks->GetLowerBoundFromSources(m_startBounds, *v);
+  return RouteWeight(std::max(estimate.GetWeight(), bound));
+}
+
+void LeapsGraph::SetLandmarks(CrossMwmLandmarks const & landmarks)
+{
+  m_landmarks = nullptr;
+  if (landmarks.GetLandmarks().empty())
+    return;
+
+  std::vector<CrossMwmLandmarks::Vertex> exits;
+  std::vector<CrossMwmLandmarks::Vertex> enters;
+  m_landmarks = &landmarks;
+  if (!GetLandmarksVertices(m_starter.GetStartEnding().m_mwmIds, false /* isEnter */, exits) ||
+      !GetLandmarksVertices(m_starter.GetFinishEnding().m_mwmIds, true /* isEnter */, enters) ||
+      exits.empty() || enters.empty())
+  {
+    m_landmarks = nullptr;
+    return;
+  }
+
+  m_startBounds = landmarks.GetBounds(exits);
+  m_finishBounds = landmarks.GetBounds(enters);
 }
 
 void LeapsGraph::GetEdgesList(Segment const & segment, bool isOutgoing,
@@ -110,6 +142,24 @@ void LeapsGraph::GetEdgesListToFinish(Segment const & segment, std::vector<Segme
   }
 }
 
+bool LeapsGraph::GetLandmarksVertices(std::set<NumMwmId> const & mwmIds, bool isEnter,
+                                      std::vector<CrossMwmLandmarks::Vertex> & vertices) const
+{
+  CHECK(m_landmarks, ());
+  for (auto const mwmId : mwmIds)
+  {
+    for (auto const & transition : m_starter.GetGraph().GetTransitions(mwmId, isEnter))
+    {
+      auto const v = m_landmarks->GetVertex(transition);
+      if (!v)
+        return false;
+
+      vertices.push_back(*v);
+    }
+  }
+  return true;
+}
+
 ms::LatLon const & LeapsGraph::GetPoint(Segment const & segment, bool front) const
 {
   return m_starter.GetPoint(segment, front);
@@ -2,6 +2,7 @@
 
 #include "routing/base/astar_graph.hpp"
 #include "routing/base/astar_vertex_data.hpp"
+#include "routing/cross_mwm_landmarks.hpp"
 #include "routing/index_graph_starter.hpp"
 #include "routing/mwm_hierarchy_handler.hpp"
 #include "routing/route_weight.hpp"
@@ -9,6 +10,7 @@
 
 #include "geometry/latlon.hpp"
 
+#include <set>
 #include <vector>
 
 namespace routing
@@ -28,6 +30,11 @@ public:
   RouteWeight GetAStarWeightEpsilon() override;
   // @}
 
+  // Makes the heuristic not less than the landmarks bounds of the weights between the transitions
+  // and the transitions of the start and the finish mwms. |landmarks| should be bound to the mwm
+  // ids of the graph and should outlive it.
+  void SetLandmarks(CrossMwmLandmarks const & landmarks);
+
   Segment const & GetStartSegment() const;
   Segment const & GetFinishSegment() const;
   ms::LatLon const & GetPoint(Segment const & segment, bool front) const;
@@ -38,6 +45,11 @@ private:
   void GetEdgesListFromStart(Segment const & segment, std::vector<SegmentEdge> & edges);
   void GetEdgesListToFinish(Segment const & segment, std::vector<SegmentEdge> & edges);
 
+  // Fills |vertices| with the landmarks vertices of the transitions of |mwmIds|. Returns false if
+  // some of the transitions are not found.
+  bool GetLandmarksVertices(std::set<NumMwmId> const & mwmIds, bool isEnter,
+                            std::vector<CrossMwmLandmarks::Vertex> & vertices) const;
+
   ms::LatLon m_startPoint;
   ms::LatLon m_finishPoint;
 
@@ -47,5 +59,10 @@ private:
   IndexGraphStarter & m_starter;
 
   MwmHierarchyHandler m_hierarchyHandler;
+
+  CrossMwmLandmarks const * m_landmarks = nullptr;
+  // Bounds of the exits of the start mwms and the enters of the finish mwms.
+  CrossMwmLandmarks::Bounds m_startBounds;
+  CrossMwmLandmarks::Bounds m_finishBounds;
 };
 }  // namespace routing
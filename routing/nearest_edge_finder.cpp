@@ -25,18 +25,19 @@ void NearestEdgeFinder::AddInformationSource(IRoadGraph::FullRoadInfo const & ro
   auto const & junctions = roadInfo.m_roadInfo.m_junctions;
   size_t const count = junctions.size();
   ASSERT_GREATER(count, 1, ());
-  for (size_t i = 1; i < count; ++i)
-  {
-    m2::ParametrizedSegment<m2::PointD> segment(junctions[i - 1].GetPoint(),
-                                                junctions[i].GetPoint());
 
-    m2::PointD const closestPoint = segment.ClosestPointTo(m_point);
-    double const squaredDist = m_point.SquaredLength(closestPoint);
+  m_polyline.Clear();
+  m_polyline.Reserve(count);
+  for (auto const & junction : junctions)
+    m_polyline.Add(junction.GetPoint());
+  m2::SquaredDistancesToSegments(m_point, m_polyline, m_squaredDists);
 
-    if (squaredDist < res.m_squaredDist)
+  for (size_t i = 0; i < m_squaredDists.size(); ++i)
+  {
+    if (m_squaredDists[i] < res.m_squaredDist)
     {
-      res.m_segId = static_cast<uint32_t>(i - 1);
-      res.m_squaredDist = squaredDist;
+      res.m_segId = static_cast<uint32_t>(i);
+      res.m_squaredDist = m_squaredDists[i];
     }
   }
 
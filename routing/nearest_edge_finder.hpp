@@ -10,6 +10,7 @@
 
 #include "geometry/point2d.hpp"
 #include "geometry/point_with_altitude.hpp"
+#include "geometry/points_batch.hpp"
 
 #include <functional>
 #include <cstdint>
@@ -58,5 +59,9 @@ private:
   m2::PointD const m_point;
   std::vector<Candidate> m_candidates;
   IsEdgeProjGood m_isEdgeProjGood;
+
+  // Buffers of AddInformationSource() kept to avoid allocations for every road.
+  m2::PointsBatch m_polyline;
+  std::vector<double> m_squaredDists;
 };
 }  // namespace routing
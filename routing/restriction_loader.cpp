@@ -163,7 +163,7 @@ void ConvertRestrictionsOnlyUTurnToNo(IndexGraph & graph,
       continue;
 
     uint32_t const n = graph.GetGeometry().GetRoad(featureId).GetPointsCount();
-    RoadJointIds const & joints = graph.GetRoad(uTurnRestriction.m_featureId);
+    RoadJointIds const joints = graph.GetRoad(uTurnRestriction.m_featureId);
     Joint::Id const joint = uTurnRestriction.m_viaIsFirstPoint ? joints.GetJointId(0)
                                                                : joints.GetJointId(n - 1);
 
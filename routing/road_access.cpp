@@ -42,12 +42,19 @@ RoadAccess::RoadAccess() : m_currentTimeGetter([time = GetCurrentTimestamp()]()
 pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccess(
     uint32_t featureId, RouteWeight const & weightToFeature) const
 {
+  // Getting the current time is not free and it's not needed for most of the features.
+  if (m_wayToAccessConditional.empty())
+    return GetAccessWithoutConditional(featureId);
+
   return GetAccess(featureId, m_currentTimeGetter() + weightToFeature.GetWeight());
 }
 
 pair<RoadAccess::Type, RoadAccess::Confidence> RoadAccess::GetAccess(
     RoadPoint const & point, RouteWeight const & weightToPoint) const
 {
+  if (m_pointToAccessConditional.empty())
+    return GetAccessWithoutConditional(point);
+
   return GetAccess(point, m_currentTimeGetter() + weightToPoint.GetWeight());
 }
 
@@ -0,0 +1,128 @@
+#include "routing/road_geometry_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+// static
+RoadGeometryCache & RoadGeometryCache::Instance()
+{
+  static RoadGeometryCache instance(kDefaultMaxSizeBytes);
+  return instance;
+}
+
+RoadGeometryCache::RoadGeometryCache(size_t maxSizeBytes)
+  : m_maxShardSizeBytes(max(maxSizeBytes / kShardsCount, size_t{1}))
+{
+}
+
+RoadGeometryCache::RoadPtr RoadGeometryCache::GetRoad(RoadGeometryKey const & key,
+                                                     Loader const & loader)
+{
+  auto & shard = GetShard(key);
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    auto const it = shard.m_roads.find(key);
+    if (it != shard.m_roads.cend())
+    {
+      ++m_hits;
+      return it->second;
+    }
+  }
+
+  ++m_misses;
+  auto road = make_shared<RoadGeometry>();
+  loader(*road);
+  size_t const sizeBytes = GetSizeBytes(*road);
+
+  lock_guard<mutex> lock(shard.m_mutex);
+  // The road could be loaded by another thread meanwhile.
+  auto const it = shard.m_roads.find(key);
+  if (it != shard.m_roads.cend())
+    return it->second;
+
+  shard.m_fifo.push_front(key);
+  shard.m_roads.emplace(key, road);
+  shard.m_sizeBytes += sizeBytes;
+
+  // The new road is never evicted: it's returned by reference to be used.
+  while (shard.m_sizeBytes > m_maxShardSizeBytes && shard.m_fifo.size() > 1)
+  {
+    auto const oldest = shard.m_roads.find(shard.m_fifo.back());
+    CHECK(oldest != shard.m_roads.cend(), ());
+    shard.m_sizeBytes -= GetSizeBytes(*oldest->second);
+    shard.m_roads.erase(oldest);
+    shard.m_fifo.pop_back();
+    ++m_evictions;
+  }
+
+  return road;
+}
+
+RoadGeometryCache::Stats RoadGeometryCache::GetStats() const
+{
+  Stats stats;
+  stats.m_hits = m_hits;
+  stats.m_misses = m_misses;
+  stats.m_evictions = m_evictions;
+  for (auto const & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    stats.m_roadsCount += shard.m_roads.size();
+    stats.m_sizeBytes += shard.m_sizeBytes;
+  }
+  return stats;
+}
+
+void RoadGeometryCache::Clear()
+{
+  for (auto & shard : m_shards)
+  {
+    lock_guard<mutex> lock(shard.m_mutex);
+    shard.m_roads.clear();
+    shard.m_fifo.clear();
+    shard.m_sizeBytes = 0;
+  }
+  m_hits = 0;
+  m_misses = 0;
+  m_evictions = 0;
+}
+
+// static
+size_t RoadGeometryCache::GetSizeBytes(RoadGeometry const & road)
+{
+  // Junctions are stored in RoadGeometry up to the static size of its buffer_vector.
+  size_t const pointsCount = road.GetPointsCount();
+  size_t size = sizeof(RoadGeometry);
+  if (pointsCount > RoadGeometry::kStaticPointsCount)
+    size += pointsCount * sizeof(LatLonWithAltitude);
+  return size;
+}
+
+size_t RoadGeometryCache::KeyHash::operator()(RoadGeometryKey const & key) const
+{
+  size_t seed = hash<MwmInfo const *>()(key.m_mwmId.GetInfo().get());
+  auto const combine = [&seed](size_t value) {
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  };
+  combine(hash<uint32_t>()(key.m_featureId));
+  combine(static_cast<size_t>(key.m_vehicleType));
+  combine(static_cast<size_t>(key.m_loadAltitudes));
+  return seed;
+}
+
+string DebugPrint(RoadGeometryCache::Stats const & stats)
+{
+  ostringstream out;
+  out << "RoadGeometryCache::Stats [ hits: " << stats.m_hits << ", misses: " << stats.m_misses
+      << ", evictions: " << stats.m_evictions << ", roads: " << stats.m_roadsCount
+      << ", bytes: " << stats.m_sizeBytes << " ]";
+  return out.str();
+}
+}  // namespace routing
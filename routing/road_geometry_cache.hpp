@@ -0,0 +1,109 @@
+#pragma once
+
+#include "routing/geometry.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "std/target_os.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace routing
+{
+// Geometry of a road depends on vehicle model and altitudes as well as on the feature.
+struct RoadGeometryKey
+{
+  bool operator==(RoadGeometryKey const & rhs) const
+  {
+    return m_featureId == rhs.m_featureId && m_mwmId == rhs.m_mwmId &&
+           m_vehicleType == rhs.m_vehicleType && m_loadAltitudes == rhs.m_loadAltitudes;
+  }
+
+  MwmSet::MwmId m_mwmId;
+  VehicleType m_vehicleType = VehicleType::Count;
+  bool m_loadAltitudes = false;
+  uint32_t m_featureId = 0;
+};
+
+/// \brief Road geometry cache shared by all the routers and graph loaders of the process.
+/// \note Roads are kept by shared pointers, so a road which is used by a Geometry stays valid
+/// after eviction. The cache is split into shards with their own locks and loading of a road is
+/// done outside of the locks. The oldest roads of a shard are evicted when the shard exceeds
+/// its part of the memory limit. The roads are released by RoutingSession::ClearCaches() on
+/// memory warnings.
+class RoadGeometryCache final
+{
+public:
+  struct Stats
+  {
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    size_t m_roadsCount = 0;
+    size_t m_sizeBytes = 0;
+  };
+
+  using RoadPtr = std::shared_ptr<RoadGeometry const>;
+  using Loader = std::function<void(RoadGeometry & road)>;
+
+#if defined(OMIM_OS_MOBILE)
+  static size_t constexpr kDefaultMaxSizeBytes = 16 * 1024 * 1024;
+#else
+  static size_t constexpr kDefaultMaxSizeBytes = 256 * 1024 * 1024;
+#endif
+  static size_t constexpr kShardsCount = 64;
+
+  static RoadGeometryCache & Instance();
+
+  explicit RoadGeometryCache(size_t maxSizeBytes);
+
+  /// \returns the road by |key|. If the road is not cached it's loaded by |loader| on the
+  /// calling thread.
+  RoadPtr GetRoad(RoadGeometryKey const & key, Loader const & loader);
+
+  Stats GetStats() const;
+  void Clear();
+
+  static size_t GetSizeBytes(RoadGeometry const & road);
+
+private:
+  struct KeyHash
+  {
+    size_t operator()(RoadGeometryKey const & key) const;
+  };
+
+  struct Shard
+  {
+    mutable std::mutex m_mutex;
+    std::unordered_map<RoadGeometryKey, RoadPtr, KeyHash> m_roads;
+    // The newest roads are at the front.
+    std::list<RoadGeometryKey> m_fifo;
+    size_t m_sizeBytes = 0;
+  };
+
+  Shard & GetShard(RoadGeometryKey const & key)
+  {
+    return m_shards[KeyHash()(key) % m_shards.size()];
+  }
+
+  size_t const m_maxShardSizeBytes;
+  std::array<Shard, kShardsCount> m_shards;
+
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+  std::atomic<uint64_t> m_evictions{0};
+};
+
+std::string DebugPrint(RoadGeometryCache::Stats const & stats);
+}  // namespace routing
@@ -2,6 +2,9 @@
 
 #include "routing/routing_exceptions.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace routing
 {
 void RoadIndex::Import(std::vector<Joint> const & joints)
@@ -10,11 +13,56 @@ void RoadIndex::Import(std::vector<Joint> const & joints)
   {
     Joint const & joint = joints[jointId];
     for (uint32_t i = 0; i < joint.GetSize(); ++i)
-    {
-      RoadPoint const & entry = joint.GetEntry(i);
-      RoadJointIds & roadJoints = m_roads[entry.GetFeatureId()];
-      roadJoints.AddJoint(entry.GetPointId(), jointId);
-    }
+      AddJoint(joint.GetEntry(i), jointId);
   }
 }
+
+void RoadIndex::Build()
+{
+  if (m_pushedRoads.empty())
+    return;
+
+  CHECK(m_featureIds.empty(), ("RoadIndex is already built."));
+
+  m_featureIds.reserve(m_pushedRoads.size());
+  size_t jointIdsCount = 0;
+  for (auto const & road : m_pushedRoads)
+  {
+    m_featureIds.push_back(road.first);
+    jointIdsCount += road.second.size();
+  }
+  std::sort(m_featureIds.begin(), m_featureIds.end());
+
+  CHECK_LESS_OR_EQUAL(jointIdsCount, std::numeric_limits<uint32_t>::max(), ());
+  m_offsets.reserve(m_featureIds.size() + 1);
+  m_jointIds.reserve(jointIdsCount);
+  m_roadIds.reserve(m_featureIds.size());
+  for (uint32_t featureId : m_featureIds)
+  {
+    auto const it = m_pushedRoads.find(featureId);
+    CHECK(it != m_pushedRoads.cend(), ());
+    m_roadIds.emplace(featureId, static_cast<uint32_t>(m_offsets.size() - 1));
+    m_jointIds.insert(m_jointIds.end(), it->second.cbegin(), it->second.cend());
+    m_offsets.push_back(static_cast<uint32_t>(m_jointIds.size()));
+    // Joint ids are released as soon as they are moved to keep the peak memory low.
+    m_pushedRoads.erase(it);
+  }
+
+  CHECK(m_pushedRoads.empty(), ());
+  // Release the buckets of the map.
+  std::unordered_map<uint32_t, std::vector<Joint::Id>>().swap(m_pushedRoads);
+}
+
+void RoadIndex::AddJoint(RoadPoint const & rp, Joint::Id jointId)
+{
+  ASSERT_NOT_EQUAL(jointId, Joint::kInvalidId, ());
+
+  auto & jointIds = m_pushedRoads[rp.GetFeatureId()];
+  uint32_t const pointId = rp.GetPointId();
+  if (pointId >= jointIds.size())
+    jointIds.insert(jointIds.end(), pointId + 1 - jointIds.size(), Joint::kInvalidId);
+
+  ASSERT_EQUAL(jointIds[pointId], Joint::kInvalidId, ());
+  jointIds[pointId] = jointId;
+}
 }  // namespace routing
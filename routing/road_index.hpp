@@ -11,20 +11,21 @@
 #include <utility>
 #include <vector>
 
+#include "3party/skarupke/bytell_hash_map.hpp"
+
 namespace routing
 {
+// Joint ids of a road indexed by point id. It's a view of the joint ids stored by RoadIndex.
+// If some point id doesn't match any joint id, it contains Joint::kInvalidId.
 class RoadJointIds final
 {
 public:
-  void Init(uint32_t maxPointId)
-  {
-    m_jointIds.clear();
-    m_jointIds.reserve(maxPointId + 1);
-  }
+  RoadJointIds() = default;
+  RoadJointIds(Joint::Id const * jointIds, uint32_t size) : m_jointIds(jointIds), m_size(size) {}
 
   Joint::Id GetJointId(uint32_t pointId) const
   {
-    if (pointId < m_jointIds.size())
+    if (pointId < m_size)
       return m_jointIds[pointId];
 
     return Joint::kInvalidId;
@@ -32,41 +33,24 @@ public:
 
   Joint::Id GetEndingJointId() const
   {
-    if (m_jointIds.empty())
+    if (m_size == 0)
       return Joint::kInvalidId;
 
-    ASSERT_NOT_EQUAL(m_jointIds.back(), Joint::kInvalidId, ());
-    return m_jointIds.back();
-  }
-
-  void AddJoint(uint32_t pointId, Joint::Id jointId)
-  {
-    ASSERT_NOT_EQUAL(jointId, Joint::kInvalidId, ());
-
-    if (pointId >= m_jointIds.size())
-      m_jointIds.insert(m_jointIds.end(), pointId + 1 - m_jointIds.size(), Joint::kInvalidId);
-
-    ASSERT_EQUAL(m_jointIds[pointId], Joint::kInvalidId, ());
-    m_jointIds[pointId] = jointId;
+    ASSERT_NOT_EQUAL(m_jointIds[m_size - 1], Joint::kInvalidId, ());
+    return m_jointIds[m_size - 1];
   }
 
   uint32_t GetJointsNumber() const
   {
-    uint32_t count = 0;
-
-    for (Joint::Id const jointId : m_jointIds)
-    {
-      if (jointId != Joint::kInvalidId)
-        ++count;
-    }
-
-    return count;
+    return static_cast<uint32_t>(
+        std::count_if(m_jointIds, m_jointIds + m_size,
+                      [](Joint::Id jointId) { return jointId != Joint::kInvalidId; }));
   }
 
   template <typename F>
   void ForEachJoint(F && f) const
   {
-    for (uint32_t pointId = 0; pointId < m_jointIds.size(); ++pointId)
+    for (uint32_t pointId = 0; pointId < m_size; ++pointId)
     {
       Joint::Id const jointId = m_jointIds[pointId];
       if (jointId != Joint::kInvalidId)
@@ -104,33 +88,35 @@ public:
   }
 
 private:
-  // Joint ids indexed by point id.
-  // If some point id doesn't match any joint id, this vector contains Joint::kInvalidId.
-  std::vector<Joint::Id> m_jointIds;
+  Joint::Id const * m_jointIds = nullptr;
+  uint32_t m_size = 0;
 };
 
+// RoadIndex contains mapping from feature id to joint ids of the road points.
+//
+// Joint ids of a road are pushed to a temporary per road vector and Build() moves them to
+// a single vector where the roads are sorted by feature id. So a road costs just its offset and
+// the hash map entry besides its joint ids, and no allocations are made to iterate the road.
 class RoadIndex final
 {
 public:
   void Import(std::vector<Joint> const & joints);
 
-  void AddJoint(RoadPoint const & rp, Joint::Id jointId)
+  void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
   {
-    m_roads[rp.GetFeatureId()].AddJoint(rp.GetPointId(), jointId);
+    AddJoint(rp, jointId);
   }
 
-  bool IsRoad(uint32_t featureId) const { return m_roads.count(featureId) != 0; }
+  // Moves the pushed joint ids to the flat layout. It's called when all the joints are pushed.
+  void Build();
 
-  RoadJointIds const & GetRoad(uint32_t featureId) const
-  {
-    auto const & it = m_roads.find(featureId);
-    CHECK(it != m_roads.cend(), ("Feature id:", featureId));
-    return it->second;
-  }
+  bool IsRoad(uint32_t featureId) const { return m_roadIds.count(featureId) != 0; }
 
-  void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
+  RoadJointIds GetRoad(uint32_t featureId) const
   {
-    m_roads[rp.GetFeatureId()].AddJoint(rp.GetPointId(), jointId);
+    auto const it = m_roadIds.find(featureId);
+    CHECK(it != m_roadIds.cend(), ("Feature id:", featureId));
+    return GetRoadByIdx(it->second);
   }
 
   // Find nearest point with normal joint id.
@@ -140,26 +126,45 @@ public:
   // If there is no nearest point, return {Joint::kInvalidId, 0}
   std::pair<Joint::Id, uint32_t> FindNeighbor(RoadPoint const & rp, bool forward) const;
 
-  uint32_t GetSize() const { return base::asserted_cast<uint32_t>(m_roads.size()); }
+  uint32_t GetSize() const { return base::asserted_cast<uint32_t>(m_featureIds.size()); }
 
   Joint::Id GetJointId(RoadPoint const & rp) const
   {
-    auto const it = m_roads.find(rp.GetFeatureId());
-    if (it == m_roads.end())
+    ASSERT(m_pushedRoads.empty(), ("Build() is not called."));
+    auto const it = m_roadIds.find(rp.GetFeatureId());
+    if (it == m_roadIds.end())
       return Joint::kInvalidId;
 
-    return it->second.GetJointId(rp.GetPointId());
+    return GetRoadByIdx(it->second).GetJointId(rp.GetPointId());
   }
 
   template <typename F>
   void ForEachRoad(F && f) const
   {
-    for (auto const & it : m_roads)
-      f(it.first, it.second);
+    ASSERT(m_pushedRoads.empty(), ("Build() is not called."));
+    for (uint32_t roadIdx = 0; roadIdx < m_featureIds.size(); ++roadIdx)
+      f(m_featureIds[roadIdx], GetRoadByIdx(roadIdx));
   }
 
 private:
-  // Map from feature id to RoadJointIds.
-  std::unordered_map<uint32_t, RoadJointIds> m_roads;
+  void AddJoint(RoadPoint const & rp, Joint::Id jointId);
+
+  RoadJointIds GetRoadByIdx(uint32_t roadIdx) const
+  {
+    ASSERT_LESS(roadIdx + 1, m_offsets.size(), ());
+    uint32_t const begin = m_offsets[roadIdx];
+    return RoadJointIds(m_jointIds.data() + begin, m_offsets[roadIdx + 1] - begin);
+  }
+
+  // Joint ids pushed before Build() by feature id.
+  std::unordered_map<uint32_t, std::vector<Joint::Id>> m_pushedRoads;
+
+  // Sorted feature ids of the roads.
+  std::vector<uint32_t> m_featureIds;
+  // Map from feature id to the index of the road in |m_featureIds|.
+  ska::bytell_hash_map<uint32_t, uint32_t> m_roadIds;
+  // Joint ids of the road with index i are in [m_offsets[i], m_offsets[i + 1]) of |m_jointIds|.
+  std::vector<uint32_t> m_offsets = {0};
+  std::vector<Joint::Id> m_jointIds;
 };
 }  // namespace routing
@@ -0,0 +1,96 @@
+#include "routing/route_cache.hpp"
+
+#include "base/assert.hpp"
+
+#include <tuple>
+#include <utility>
+
+namespace routing
+{
+using namespace std;
+
+// RouteCache::Key ---------------------------------------------------------------------------------
+RouteCache::Key::Key(vector<m2::PointD> const & checkpoints, size_t passedIdx,
+                     m2::PointD const & startDirection, VehicleType vehicleType,
+                     RoutingOptions options, uint64_t trafficVersion)
+  : m_checkpoints(checkpoints)
+  , m_passedIdx(passedIdx)
+  , m_startDirection(startDirection)
+  , m_vehicleType(vehicleType)
+  , m_options(options.GetOptions())
+  , m_trafficVersion(trafficVersion)
+{
+}
+
+bool RouteCache::Key::operator<(Key const & rhs) const
+{
+  return tie(m_checkpoints, m_passedIdx, m_startDirection, m_vehicleType, m_options,
+             m_trafficVersion) < tie(rhs.m_checkpoints, rhs.m_passedIdx, rhs.m_startDirection,
+                                     rhs.m_vehicleType, rhs.m_options, rhs.m_trafficVersion);
+}
+
+// RouteCache::Entry -------------------------------------------------------------------------------
+RouteCache::Entry::Entry(Route const & route, vector<shared_ptr<Route>> const & alternatives)
+  : m_route(route)
+{
+  m_alternatives.reserve(alternatives.size());
+  for (auto const & alternative : alternatives)
+  {
+    CHECK(alternative, ());
+    m_alternatives.push_back(*alternative);
+  }
+}
+
+// RouteCache::Stats -------------------------------------------------------------------------------
+double RouteCache::Stats::GetHitRate() const
+{
+  auto const total = m_hits + m_misses;
+  return total == 0 ? 0.0 : static_cast<double>(m_hits) / total;
+}
+
+// RouteCache --------------------------------------------------------------------------------------
+RouteCache::RouteCache(size_t maxSize) : m_maxSize(maxSize)
+{
+  CHECK_GREATER(m_maxSize, 0, ());
+}
+
+RouteCache::Entry const * RouteCache::Find(Key const & key)
+{
+  auto const it = m_index.find(key);
+  if (it == m_index.cend())
+  {
+    ++m_stats.m_misses;
+    return nullptr;
+  }
+
+  ++m_stats.m_hits;
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return &it->second->second;
+}
+
+void RouteCache::Add(Key const & key, Route const & route,
+                     vector<shared_ptr<Route>> const & alternatives)
+{
+  auto const it = m_index.find(key);
+  if (it != m_index.cend())
+  {
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+
+  if (m_index.size() >= m_maxSize)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  m_entries.emplace_front(key, Entry(route, alternatives));
+  m_index.emplace(key, m_entries.begin());
+}
+
+void RouteCache::Clear()
+{
+  m_entries.clear();
+  m_index.clear();
+}
+}  // namespace routing
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "routing/route.hpp"
+#include "routing/routing_options.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace routing
+{
+/// \brief Cache of the built routes with least recently used replacement policy.
+/// A route is taken from the cache only if it's requested for exactly the same checkpoints
+/// and start direction with the same vehicle type, routing options and traffic.
+/// \note The class is not thread-safe.
+class RouteCache
+{
+public:
+  struct Key
+  {
+    Key(std::vector<m2::PointD> const & checkpoints, size_t passedIdx,
+        m2::PointD const & startDirection, VehicleType vehicleType, RoutingOptions options,
+        uint64_t trafficVersion);
+
+    bool operator<(Key const & rhs) const;
+
+    std::vector<m2::PointD> m_checkpoints;
+    size_t m_passedIdx = 0;
+    m2::PointD m_startDirection;
+    VehicleType m_vehicleType = VehicleType::Car;
+    RoutingOptions::RoadType m_options = 0;
+    // Version of the traffic the route was built with, see traffic::TrafficCache::GetVersion().
+    uint64_t m_trafficVersion = 0;
+  };
+
+  struct Entry
+  {
+    Entry(Route const & route, std::vector<std::shared_ptr<Route>> const & alternatives);
+
+    Route m_route;
+    std::vector<Route> m_alternatives;
+  };
+
+  struct Stats
+  {
+    double GetHitRate() const;
+
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+
+  /// \param maxSize Maximum number of the routes in the cache. It should be one or greater.
+  explicit RouteCache(size_t maxSize);
+
+  /// \returns the entry for |key| or nullptr if there's no such entry. The pointer is valid
+  /// until the next Add() or Clear() call.
+  Entry const * Find(Key const & key);
+  void Add(Key const & key, Route const & route,
+           std::vector<std::shared_ptr<Route>> const & alternatives);
+  /// \brief Removes all the routes. It should be called when the maps are changed.
+  void Clear();
+
+  size_t GetSize() const { return m_index.size(); }
+  Stats const & GetStats() const { return m_stats; }
+
+private:
+  using Entries = std::list<std::pair<Key, Entry>>;
+
+  size_t const m_maxSize;
+  // The most recently used entries are at the beginning.
+  Entries m_entries;
+  std::map<Key, Entries::iterator> m_index;
+  Stats m_stats;
+};
+}  // namespace routing
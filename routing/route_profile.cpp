@@ -0,0 +1,48 @@
+#include "routing/route_profile.hpp"
+
+#include "base/assert.hpp"
+
+#include "3party/jansson/myjansson.hpp"
+
+using namespace std;
+
+namespace routing
+{
+string DebugPrint(RoutingPhase phase)
+{
+  switch (phase)
+  {
+  case RoutingPhase::Snapping: return "snapping";
+  case RoutingPhase::Leaps: return "leaps";
+  case RoutingPhase::Refinement: return "refinement";
+  case RoutingPhase::LeapsPostProcessing: return "leaps_post_processing";
+  case RoutingPhase::Directions: return "directions";
+  case RoutingPhase::MwmLoading: return "mwm_loading";
+  case RoutingPhase::Count: return "count";
+  }
+  UNREACHABLE();
+}
+
+RouteProfile RouteProfile::operator-(RouteProfile const & rhs) const
+{
+  RouteProfile result;
+  for (size_t i = 0; i < kPhasesCount; ++i)
+    result.m_phaseSeconds[i] = m_phaseSeconds[i] - rhs.m_phaseSeconds[i];
+  result.m_settledVerticesCount = m_settledVerticesCount - rhs.m_settledVerticesCount;
+  result.m_openedMwmsCount = m_openedMwmsCount - rhs.m_openedMwmsCount;
+  return result;
+}
+
+string RouteProfile::ToJson() const
+{
+  auto phases = base::NewJSONObject();
+  for (size_t i = 0; i < kPhasesCount; ++i)
+    ToJSONObject(*phases, DebugPrint(static_cast<RoutingPhase>(i)), m_phaseSeconds[i]);
+
+  auto root = base::NewJSONObject();
+  ToJSONObject(*root, "phases_seconds", phases);
+  ToJSONObject(*root, "settled_vertices", m_settledVerticesCount);
+  ToJSONObject(*root, "opened_mwms", m_openedMwmsCount);
+  return base::DumpToString(root, JSON_COMPACT | JSON_SORT_KEYS);
+}
+}  // namespace routing
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace routing
+{
+// Phases of a route building by IndexRouter.
+enum class RoutingPhase : uint8_t
+{
+  // Snapping of the checkpoints to the roads.
+  Snapping,
+  // A* over the cross mwm leaps.
+  Leaps,
+  // A* over the index graphs of mwms. It's the only search phase if leaps are not used.
+  Refinement,
+  LeapsPostProcessing,
+  // Route geometry, times, turns and street names.
+  Directions,
+  // Loading of the routing sections of the mwms. This time is included into the other phases.
+  MwmLoading,
+
+  Count
+};
+
+std::string DebugPrint(RoutingPhase phase);
+
+// Time of the phases and counters of one or several route buildings.
+struct RouteProfile
+{
+  static size_t constexpr kPhasesCount = static_cast<size_t>(RoutingPhase::Count);
+
+  double GetPhaseSeconds(RoutingPhase phase) const
+  {
+    return m_phaseSeconds[static_cast<size_t>(phase)];
+  }
+
+  // Returns the profile of the route buildings which are not taken by |rhs|.
+  RouteProfile operator-(RouteProfile const & rhs) const;
+
+  // Returns the profile as a one line JSON object.
+  std::string ToJson() const;
+
+  std::array<double, kPhasesCount> m_phaseSeconds = {};
+  uint64_t m_settledVerticesCount = 0;
+  uint64_t m_openedMwmsCount = 0;
+};
+}  // namespace routing
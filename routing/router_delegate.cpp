@@ -46,4 +46,33 @@ void RouterDelegate::SetTimeout(uint32_t timeoutSec)
   std::chrono::steady_clock::duration const timeout = std::chrono::seconds(timeoutSec);
   m_cancellable.SetDeadline(std::chrono::steady_clock::now() + timeout);
 }
+
+void RouterDelegate::AddPhaseTime(RoutingPhase phase,
+                                  std::chrono::steady_clock::duration time) const
+{
+  auto const nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+  m_phaseNanoseconds[static_cast<size_t>(phase)].fetch_add(nanoseconds,
+                                                           std::memory_order_relaxed);
+}
+
+RouteProfile RouterDelegate::GetProfile() const
+{
+  RouteProfile profile;
+  for (size_t i = 0; i < RouteProfile::kPhasesCount; ++i)
+    profile.m_phaseSeconds[i] = static_cast<double>(m_phaseNanoseconds[i].load()) / 1e9;
+  profile.m_settledVerticesCount = m_settledVerticesCount.load();
+  profile.m_openedMwmsCount = m_openedMwmsCount.load();
+  return profile;
+}
+
+RouterDelegate::ScopedPhaseTimer::ScopedPhaseTimer(RouterDelegate const & delegate,
+                                                   RoutingPhase phase)
+  : m_delegate(delegate), m_phase(phase), m_start(std::chrono::steady_clock::now())
+{
+}
+
+RouterDelegate::ScopedPhaseTimer::~ScopedPhaseTimer()
+{
+  m_delegate.AddPhaseTime(m_phase, std::chrono::steady_clock::now() - m_start);
+}
 }  //  namespace routing
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "routing/route_profile.hpp"
 #include "routing/routing_callbacks.hpp"
 
 #include "geometry/latlon.hpp"
@@ -7,6 +8,10 @@
 #include "base/cancellable.hpp"
 #include "base/timer.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <mutex>
 
 namespace routing
@@ -14,6 +19,19 @@ namespace routing
 class RouterDelegate
 {
 public:
+  // Adds the time of its life to |phase| of the route building profile of |delegate|.
+  class ScopedPhaseTimer
+  {
+  public:
+    ScopedPhaseTimer(RouterDelegate const & delegate, RoutingPhase phase);
+    ~ScopedPhaseTimer();
+
+  private:
+    RouterDelegate const & m_delegate;
+    RoutingPhase m_phase;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
   static auto constexpr kNoTimeout = std::numeric_limits<uint32_t>::max();
 
   RouterDelegate();
@@ -21,6 +39,15 @@ public:
   /// Set routing progress. Waits current progress status from 0 to 100.
   void OnProgress(float progress) const;
   void OnPointCheck(ms::LatLon const & point) const;
+  /// Counts vertices settled by the searches. The counter is never reset, so the number of
+  /// vertices settled by a route building is the difference of the counters.
+  void OnVertexSettled() const { m_settledVerticesCount.fetch_add(1, std::memory_order_relaxed); }
+  uint64_t GetSettledVerticesCount() const { return m_settledVerticesCount.load(); }
+  /// Counts the phases time and the mwms opened by the route buildings. The same as the settled
+  /// vertices, the profile of a route building is the difference of the profiles.
+  void AddPhaseTime(RoutingPhase phase, std::chrono::steady_clock::duration time) const;
+  void OnMwmOpened() const { m_openedMwmsCount.fetch_add(1, std::memory_order_relaxed); }
+  RouteProfile GetProfile() const;
 
   void SetProgressCallback(ProgressCallback const & progressCallback);
   void SetPointCheckCallback(PointCheckCallback const & pointCallback);
@@ -37,5 +64,10 @@ private:
   PointCheckCallback m_pointCallback;
 
   base::Cancellable m_cancellable;
+
+  mutable std::atomic<uint64_t> m_settledVerticesCount{0};
+  mutable std::atomic<uint64_t> m_openedMwmsCount{0};
+  // Phases time in nanoseconds. Phases of the routes matrix are taken by several threads.
+  mutable std::array<std::atomic<int64_t>, RouteProfile::kPhasesCount> m_phaseNanoseconds = {};
 };
 } //  namespace routing
@@ -17,6 +17,7 @@
 #include "base/scope_guard.hpp"
 
 #include <limits>
+#include <mutex>
 
 namespace
 {
@@ -90,7 +91,8 @@ RoutesBuilder & RoutesBuilder::GetSimpleRoutesBuilder()
   static RoutesBuilder routesBuilder(1 /* threadsNumber */);
   return routesBuilder;
 }
-RoutesBuilder::RoutesBuilder(size_t threadsNumber) : m_threadPool(threadsNumber)
+RoutesBuilder::RoutesBuilder(size_t threadsNumber)
+  : m_threadsNumber(threadsNumber), m_threadPool(threadsNumber)
 {
   CHECK_GREATER(threadsNumber, 0, ());
   LOG(LINFO, ("Threads number:", threadsNumber));
@@ -141,6 +143,34 @@ std::future<RoutesBuilder::Result> RoutesBuilder::ProcessTaskAsync(Params const
   return m_threadPool.Submit(std::move(processor), params);
 }
 
+void RoutesBuilder::ProcessTasks(GetNextTaskFn const & getNextTask, OnResultFn const & onResult)
+{
+  std::mutex mutex;
+  auto const getNext = [&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return getNextTask();
+  };
+  auto const push = [&](Result && result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    onResult(std::move(result));
+  };
+
+  std::vector<std::future<void>> workers;
+  workers.reserve(m_threadsNumber);
+  for (size_t i = 0; i < m_threadsNumber; ++i)
+  {
+    workers.emplace_back(m_threadPool.Submit([&]() {
+      Processor processor(m_numMwmIds, m_dataSourcesStorage, m_cpg, m_cig);
+      SCOPE_GUARD(returnDataSource, [&]() { processor.ReturnDataSource(); });
+      while (auto const params = getNext())
+        push(processor.Process(*params));
+    }));
+  }
+
+  for (auto & worker : workers)
+    worker.get();
+}
+
 // RoutesBuilder::Result ---------------------------------------------------------------------------
 
 // static
@@ -284,10 +314,19 @@ void RoutesBuilder::Processor::InitRouter(VehicleType type)
 RoutesBuilder::Result
 RoutesBuilder::Processor::operator()(Params const & params)
 {
-  InitRouter(params.m_type);
-  SCOPE_GUARD(returnDataSource, [&]() {
+  SCOPE_GUARD(returnDataSource, [&]() { ReturnDataSource(); });
+  return Process(params);
+}
+
+void RoutesBuilder::Processor::ReturnDataSource()
+{
+  if (m_dataSource)
     m_dataSourceStorage.PushDataSource(std::move(m_dataSource));
-  });
+}
+
+RoutesBuilder::Result RoutesBuilder::Processor::Process(Params const & params)
+{
+  InitRouter(params.m_type);
 
   LOG(LINFO, ("Start building route, checkpoints:", params.m_checkpoints));
 
@@ -296,6 +335,7 @@ RoutesBuilder::Processor::operator()(Params const & params)
 
   CHECK(m_dataSource, ());
 
+  auto const settledVerticesCount = m_delegate->GetSettledVerticesCount();
   double timeSum = 0.0;
   for (size_t i = 0; i < params.m_launchesNumber; ++i)
   {
@@ -314,6 +354,7 @@ RoutesBuilder::Processor::operator()(Params const & params)
   result.m_params.m_checkpoints = params.m_checkpoints;
   result.m_code = resultCode;
   result.m_buildTimeSeconds = timeSum / static_cast<double>(params.m_launchesNumber);
+  result.m_settledVerticesCount = m_delegate->GetSettledVerticesCount() - settledVerticesCount;
 
   RoutesBuilder::Route routeResult;
   routeResult.m_distance = route.GetTotalDistanceMeters();
@@ -31,8 +31,11 @@
 #include "base/thread_pool_computational.hpp"
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -94,11 +97,21 @@ public:
     Params m_params;
     std::vector<Route> m_routes;
     double m_buildTimeSeconds = 0.0;
+    // Vertices settled by all the launches. It is not dumped.
+    uint64_t m_settledVerticesCount = 0;
   };
 
+  using GetNextTaskFn = std::function<std::optional<Params>()>;
+  using OnResultFn = std::function<void(Result &&)>;
+
   Result ProcessTask(Params const & params);
   std::future<Result> ProcessTaskAsync(Params const & params);
 
+  // Builds routes of the tasks got by |getNextTask| until it returns std::nullopt. Unlike
+  // ProcessTaskAsync() every thread keeps its router and data source between the tasks, so
+  // the caches of the routers are warm. |getNextTask| and |onResult| calls are serialized.
+  void ProcessTasks(GetNextTaskFn const & getNextTask, OnResultFn const & onResult);
+
 private:
 
   class Processor
@@ -111,7 +124,11 @@ private:
 
     Processor(Processor && rhs) noexcept;
 
+    // Builds the route and returns the data source to the storage.
     Result operator()(Params const & params);
+    // Builds the route and keeps the data source for the next routes.
+    Result Process(Params const & params);
+    void ReturnDataSource();
 
   private:
     void InitRouter(VehicleType type);
@@ -130,6 +147,7 @@ private:
     std::unique_ptr<FrozenDataSource> m_dataSource;
   };
 
+  size_t m_threadsNumber;
   base::thread_pool::computational::ThreadPool m_threadPool;
 
   std::shared_ptr<storage::CountryParentGetter> m_cpg =
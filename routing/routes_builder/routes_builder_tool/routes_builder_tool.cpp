@@ -40,6 +40,9 @@ DEFINE_int32(timeout, 10 * 60, "Timeout in seconds for each route building. "
 DEFINE_bool(verbose, false, "Verbose logging (default: false)");
 
 DEFINE_int32(launches_number, 1, "Number of launches of routes buildings. Needs for benchmarking (default: 1)");
+DEFINE_bool(benchmark, false,
+            "Benchmark mode: routers are kept between the routes and capacity metrics are logged "
+            "instead of dumping the routes. --dump_path is not needed (default: false).");
 DEFINE_string(vehicle_type, "car", "Vehicle type: car|pedestrian|bicycle|transit. (Only for mapsme).");
 
 using namespace routing;
@@ -87,12 +90,21 @@ int Main(int argc, char ** argv)
          "\n\t--api_token empty is:", FLAGS_api_token.empty(),
          "\n\nType --help for usage."));
 
+  CHECK_GREATER_OR_EQUAL(FLAGS_launches_number, 1, ());
+
+  if (FLAGS_benchmark)
+  {
+    CHECK(IsLocalBuild(), ("Only local routes building can be benchmarked."));
+    BenchmarkRoutes(FLAGS_routes_file, FLAGS_start_from, FLAGS_threads, FLAGS_timeout,
+                    FLAGS_vehicle_type, FLAGS_verbose,
+                    static_cast<uint32_t>(FLAGS_launches_number));
+    return 0;
+  }
+
   CHECK(!FLAGS_dump_path.empty(),
         ("\n\n\t--dump_path is empty. It makes no sense to run this tool. No result will be saved.",
          "\n\nType --help for usage."));
 
-  CHECK_GREATER_OR_EQUAL(FLAGS_launches_number, 1, ());
-
   if (Platform::IsFileExistsByFullPath(FLAGS_dump_path))
     CheckDirExistence(FLAGS_dump_path);
   else
@@ -16,14 +16,20 @@
 #include "base/logging.hpp"
 #include "base/timer.hpp"
 
+#include "std/target_os.hpp"
+
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cmath>
 #include <future>
 #include <iostream>
 #include <optional>
 #include <thread>
 #include <tuple>
+#include <vector>
+
+#include <sys/resource.h>
 
 using namespace routing_quality;
 
@@ -56,6 +62,39 @@ routing::VehicleType ConvertVehicleTypeFromString(std::string const & str)
   CHECK(false, ("Unknown vehicle type:", str));
   UNREACHABLE();
 }
+
+uint64_t GetThreadsNumber(uint64_t threadsNumber)
+{
+  if (threadsNumber)
+    return threadsNumber;
+
+  auto const hardwareConcurrency = std::thread::hardware_concurrency();
+  return hardwareConcurrency > 0 ? hardwareConcurrency : 2;
+}
+
+// Returns peak RSS of the process in bytes.
+uint64_t GetPeakRssBytes()
+{
+  rusage usage = {};
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+#if defined(OMIM_OS_MAC)
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  // ru_maxrss is in kilobytes on Linux.
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+// Returns the nearest-rank |percent| percentile of sorted |values|.
+template <typename T>
+T GetPercentile(std::vector<T> const & values, double percent)
+{
+  CHECK(!values.empty(), ());
+  auto const rank = static_cast<size_t>(std::ceil(percent / 100.0 * values.size()));
+  return values[std::clamp(rank, size_t{1}, values.size()) - 1];
+}
 }  // namespace
 
 namespace routing
@@ -77,13 +116,7 @@ void BuildRoutes(std::string const & routesPath,
   std::ifstream input(routesPath);
   CHECK(input.good(), ("Error during opening:", routesPath));
 
-  if (!threadsNumber)
-  {
-    auto const hardwareConcurrency = std::thread::hardware_concurrency();
-    threadsNumber = hardwareConcurrency > 0 ? hardwareConcurrency : 2;
-  }
-
-  RoutesBuilder routesBuilder(threadsNumber);
+  RoutesBuilder routesBuilder(GetThreadsNumber(threadsNumber));
 
   std::vector<std::future<RoutesBuilder::Result>> tasks;
   double lastPercent = 0.0;
@@ -144,6 +177,85 @@ void BuildRoutes(std::string const & routesPath,
   }
 }
 
+void BenchmarkRoutes(std::string const & routesPath,
+                     uint64_t startFrom,
+                     uint64_t threadsNumber,
+                     uint32_t timeoutPerRouteSeconds,
+                     std::string const & vehicleTypeStr,
+                     bool verbose,
+                     uint32_t launchesNumber)
+{
+  CHECK(Platform::IsFileExistsByFullPath(routesPath), ("Can not find file:", routesPath));
+
+  std::ifstream input(routesPath);
+  CHECK(input.good(), ("Error during opening:", routesPath));
+
+  threadsNumber = GetThreadsNumber(threadsNumber);
+  RoutesBuilder routesBuilder(threadsNumber);
+
+  RoutesBuilder::Params params;
+  params.m_type = ConvertVehicleTypeFromString(vehicleTypeStr);
+  params.m_timeoutSeconds = timeoutPerRouteSeconds;
+  params.m_launchesNumber = launchesNumber;
+
+  auto const getNextTask = [&]() -> std::optional<RoutesBuilder::Params> {
+    ms::LatLon start;
+    ms::LatLon finish;
+    while (input >> start.m_lat >> start.m_lon >> finish.m_lat >> finish.m_lon)
+    {
+      if (startFrom > 0)
+      {
+        --startFrom;
+        continue;
+      }
+
+      params.m_checkpoints = Checkpoints(mercator::FromLatLon(start), mercator::FromLatLon(finish));
+      return params;
+    }
+    return {};
+  };
+
+  std::vector<double> buildTimes;
+  std::vector<uint64_t> settledVertices;
+  size_t failedNumber = 0;
+  auto const onResult = [&](RoutesBuilder::Result && result) {
+    if (!result.IsCodeOK())
+    {
+      ++failedNumber;
+      return;
+    }
+
+    buildTimes.push_back(result.m_buildTimeSeconds);
+    settledVertices.push_back(result.m_settledVerticesCount / launchesNumber);
+  };
+
+  LOG_FORCE(LINFO, ("Benchmark of", vehicleTypeStr, "routes in", threadsNumber, "threads."));
+  base::Timer timer;
+  {
+    base::ScopedLogLevelChanger changer(verbose ? base::LogLevel::LINFO : base::LogLevel::LERROR);
+    routesBuilder.ProcessTasks(getNextTask, onResult);
+  }
+  double const elapsedSeconds = timer.ElapsedSeconds();
+
+  size_t const routesNumber = buildTimes.size() + failedNumber;
+  LOG_FORCE(LINFO, ("Routes:", routesNumber, "failed:", failedNumber, "elapsed:", elapsedSeconds,
+                    "seconds."));
+  if (buildTimes.empty())
+    return;
+
+  std::sort(buildTimes.begin(), buildTimes.end());
+  std::sort(settledVertices.begin(), settledVertices.end());
+  double const routesPerSecond = routesNumber * launchesNumber / elapsedSeconds;
+  LOG_FORCE(LINFO, ("Routes per second:", routesPerSecond));
+  LOG_FORCE(LINFO, ("Build time, ms: p50", GetPercentile(buildTimes, 50.0) * 1000.0, "p95",
+                    GetPercentile(buildTimes, 95.0) * 1000.0, "p99",
+                    GetPercentile(buildTimes, 99.0) * 1000.0, "max", buildTimes.back() * 1000.0));
+  LOG_FORCE(LINFO, ("Settled vertices: p50", GetPercentile(settledVertices, 50.0), "p95",
+                    GetPercentile(settledVertices, 95.0), "p99",
+                    GetPercentile(settledVertices, 99.0), "max", settledVertices.back()));
+  LOG_FORCE(LINFO, ("Peak RSS:", GetPeakRssBytes() / (1024 * 1024), "MB"));
+}
+
 std::optional<std::tuple<ms::LatLon, ms::LatLon, int32_t>> ParseApiLine(std::ifstream & input)
 {
   std::string line;
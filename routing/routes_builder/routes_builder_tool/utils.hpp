@@ -22,6 +22,17 @@ void BuildRoutes(std::string const & routesPath,
                  bool verbose,
                  uint32_t launchesNumber);
 
+// Builds routes of |routesPath| by routers which are kept between the routes and logs the capacity
+// metrics: routes per second, percentiles of a route building time, settled vertices and peak RSS.
+// Routes are read from the file while they are built, so the file may be large.
+void BenchmarkRoutes(std::string const & routesPath,
+                     uint64_t startFrom,
+                     uint64_t threadsNumber,
+                     uint32_t timeoutPerRouteSeconds,
+                     std::string const & vehicleType,
+                     bool verbose,
+                     uint32_t launchesNumber);
+
 void BuildRoutesWithApi(std::unique_ptr<routing_quality::api::RoutingApi> routingApi,
                         std::string const & routesPath,
                         std::string const & dumpPath,
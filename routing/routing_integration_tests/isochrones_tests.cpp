@@ -0,0 +1,119 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_integration_tests/routing_test_tools.hpp"
+
+#include "routing/index_router.hpp"
+#include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_callbacks.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+// Isochrones are bounded by the route weight, which is not less than ETA of the route, but
+// routes of CalculateRoute() may slightly differ from the routes of the wave.
+double constexpr kRelativeError = 0.05;
+// No car is faster on the roads, so no point farther than |maxTimeSec| * |kMaxSpeedMPS| from
+// the source is reachable.
+double constexpr kMaxSpeedMPS = 150.0 / 3.6;
+// Number of the reachable points of an isochrone which are checked by CalculateRoute().
+size_t constexpr kCheckedPointsCount = 8;
+
+vector<IndexRouter::Isochrone> CalculateIsochrones(vector<ms::LatLon> const & sources,
+                                                   double maxTimeSec, size_t threadsCount)
+{
+  auto & router =
+      dynamic_cast<IndexRouter &>(integration::GetVehicleComponents(VehicleType::Car).GetRouter());
+
+  vector<m2::PointD> points;
+  for (auto const & source : sources)
+    points.push_back(mercator::FromLatLon(source));
+
+  RouterDelegate delegate;
+  vector<IndexRouter::Isochrone> isochrones;
+  TEST_EQUAL(router.CalculateIsochrones(points, maxTimeSec, threadsCount, delegate, isochrones),
+             RouterResultCode::NoError, ());
+  TEST_EQUAL(isochrones.size(), sources.size(), ());
+  return isochrones;
+}
+
+void TestIsochrone(ms::LatLon const & source, double maxTimeSec,
+                   IndexRouter::Isochrone const & isochrone)
+{
+  auto const sourcePoint = mercator::FromLatLon(source);
+  auto const & reachable = isochrone.m_reachablePoints;
+  TEST(!reachable.empty(), (source));
+  TEST_GREATER_OR_EQUAL(isochrone.m_polygon.size(), 3, (source));
+
+  for (auto const & point : reachable)
+  {
+    TEST_LESS_OR_EQUAL(mercator::DistanceOnEarth(sourcePoint, point), maxTimeSec * kMaxSpeedMPS,
+                       (source, mercator::ToLatLon(point)));
+  }
+
+  // The points of the hull are the reachable points.
+  for (auto const & point : isochrone.m_polygon)
+    TEST(binary_search(reachable.begin(), reachable.end(), point), (mercator::ToLatLon(point)));
+
+  auto & components = integration::GetVehicleComponents(VehicleType::Car);
+  size_t const step = max(reachable.size() / kCheckedPointsCount, size_t(1));
+  for (size_t i = 0; i < reachable.size(); i += step)
+  {
+    TRouteResult const routeResult = integration::CalculateRoute(
+        components, sourcePoint, m2::PointD::Zero() /* startDirection */, reachable[i]);
+    TEST_EQUAL(routeResult.second, RouterResultCode::NoError,
+               (source, mercator::ToLatLon(reachable[i])));
+    CHECK(routeResult.first, ());
+    TEST_LESS_OR_EQUAL(routeResult.first->GetTotalTimeSec(), maxTimeSec * (1.0 + kRelativeError),
+                       (source, mercator::ToLatLon(reachable[i])));
+  }
+}
+
+UNIT_TEST(Isochrones_Moscow)
+{
+  ms::LatLon const source(55.75302, 37.62037);
+  double constexpr kMaxTimeSec = 10 * 60;
+  auto const isochrones = CalculateIsochrones({source}, kMaxTimeSec, 1 /* threadsCount */);
+  TestIsochrone(source, kMaxTimeSec, isochrones.front());
+}
+
+// An isochrone of a longer time contains all the reachable points of a shorter one.
+UNIT_TEST(Isochrones_TimeMonotonicity)
+{
+  ms::LatLon const source(54.78251, 32.04524);
+  auto const shorter = CalculateIsochrones({source}, 5 * 60 /* maxTimeSec */, 1 /* threadsCount */);
+  auto const longer = CalculateIsochrones({source}, 15 * 60 /* maxTimeSec */, 1 /* threadsCount */);
+
+  auto const & shorterPoints = shorter.front().m_reachablePoints;
+  auto const & longerPoints = longer.front().m_reachablePoints;
+  TEST(!shorterPoints.empty(), ());
+  TEST_GREATER(longerPoints.size(), shorterPoints.size(), ());
+  TEST(includes(longerPoints.begin(), longerPoints.end(), shorterPoints.begin(),
+                shorterPoints.end()),
+       ());
+}
+
+// The sources are in Russia, Smolensk Oblast and in Belarus, Vitebsk Region. The isochrones
+// are processed on different threads and don't depend on each other.
+UNIT_TEST(Isochrones_MultipleSources)
+{
+  vector<ms::LatLon> const sources = {{54.78251, 32.04524}, {54.50845, 30.41741}};
+  double constexpr kMaxTimeSec = 10 * 60;
+  auto const isochrones = CalculateIsochrones(sources, kMaxTimeSec, 2 /* threadsCount */);
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    TestIsochrone(sources[i], kMaxTimeSec, isochrones[i]);
+
+    auto const single = CalculateIsochrones({sources[i]}, kMaxTimeSec, 1 /* threadsCount */);
+    TEST_EQUAL(single.front().m_reachablePoints, isochrones[i].m_reachablePoints, (sources[i]));
+  }
+}
+}  // namespace
@@ -0,0 +1,84 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_integration_tests/routing_test_tools.hpp"
+
+#include "routing/index_router.hpp"
+#include "routing/route.hpp"
+#include "routing/router_delegate.hpp"
+#include "routing/routing_callbacks.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include <cstddef>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+// Routes of the matrix are calculated without leaps, so they may slightly differ from
+// the routes of CalculateRoute().
+double constexpr kRelativeError = 0.05;
+
+// Checks every cell of the routes matrix against the route from the source to the target.
+void TestMatrix(vector<ms::LatLon> const & sources, vector<ms::LatLon> const & targets,
+                size_t threadsCount)
+{
+  auto & components = integration::GetVehicleComponents(VehicleType::Car);
+  auto & router = dynamic_cast<IndexRouter &>(components.GetRouter());
+
+  vector<m2::PointD> sourcePoints;
+  for (auto const & source : sources)
+    sourcePoints.push_back(mercator::FromLatLon(source));
+  vector<m2::PointD> targetPoints;
+  for (auto const & target : targets)
+    targetPoints.push_back(mercator::FromLatLon(target));
+
+  RouterDelegate delegate;
+  IndexRouter::Matrix matrix;
+  TEST_EQUAL(router.CalculateMatrix(sourcePoints, targetPoints, threadsCount, delegate, matrix),
+             RouterResultCode::NoError, ());
+  TEST_EQUAL(matrix.size(), sources.size(), ());
+
+  for (size_t i = 0; i < sources.size(); ++i)
+  {
+    TEST_EQUAL(matrix[i].size(), targets.size(), ());
+    for (size_t j = 0; j < targets.size(); ++j)
+    {
+      auto const & cell = matrix[i][j];
+      TEST(cell.IsFound(), (sources[i], targets[j]));
+
+      TRouteResult const routeResult = integration::CalculateRoute(
+          components, sourcePoints[i], m2::PointD::Zero() /* startDirection */, targetPoints[j]);
+      TEST_EQUAL(routeResult.second, RouterResultCode::NoError, (sources[i], targets[j]));
+      CHECK(routeResult.first, ());
+
+      integration::TestRouteTime(*routeResult.first, cell.m_etaSec, kRelativeError);
+      integration::TestRouteLength(*routeResult.first, cell.m_distanceMeters, kRelativeError);
+    }
+  }
+}
+
+UNIT_TEST(RoutesMatrix_Moscow)
+{
+  TestMatrix({{55.75302, 37.62037}, {55.79162, 37.53296}, {55.70886, 37.73078}} /* sources */,
+             {{55.73420, 37.58805}, {55.80913, 37.63884}, {55.75302, 37.62037}} /* targets */,
+             2 /* threadsCount */);
+}
+
+// The sources are in Russia, Smolensk Oblast and in Belarus, Vitebsk Region.
+UNIT_TEST(RoutesMatrix_RussiaBelarusBorder)
+{
+  TestMatrix({{54.78251, 32.04524}, {54.50845, 30.41741}} /* sources */,
+             {{54.55927, 31.43271}, {54.78251, 32.04524}, {54.50845, 30.41741}} /* targets */,
+             2 /* threadsCount */);
+}
+
+// One thread processes all the sources on the same graph.
+UNIT_TEST(RoutesMatrix_OneThread)
+{
+  TestMatrix({{54.78251, 32.04524}, {54.50845, 30.41741}} /* sources */,
+             {{54.55927, 31.43271}} /* targets */, 1 /* threadsCount */);
+}
+}  // namespace
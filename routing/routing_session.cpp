@@ -1,5 +1,6 @@
 #include "routing/routing_session.hpp"
 
+#include "routing/road_geometry_cache.hpp"
 #include "routing/routing_helpers.hpp"
 #include "routing/speed_camera.hpp"
 
@@ -260,6 +261,20 @@ void RoutingSession::Reset()
   m_lastCompletionPercent = 0;
 }
 
+void RoutingSession::ClearCaches()
+{
+  CHECK_THREAD_CHECKER(m_threadChecker, ());
+  ASSERT(m_router != nullptr, ());
+
+  m_router->ClearCaches();
+
+  // The roads are shared by the shared pointers, so the ones used by a route being built are kept
+  // by its graph.
+  auto & roadGeometryCache = RoadGeometryCache::Instance();
+  LOG(LINFO, ("Releasing road geometry cache.", roadGeometryCache.GetStats()));
+  roadGeometryCache.Clear();
+}
+
 void RoutingSession::SetState(SessionState state)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
@@ -804,15 +819,13 @@ void RoutingSession::OnTrafficInfoClear()
 
 void RoutingSession::OnTrafficInfoAdded(TrafficInfo && info)
 {
-  TrafficInfo::Coloring const & fullColoring = info.GetColoring();
-  auto coloring = make_shared<TrafficInfo::Coloring>();
-  for (auto const & kv : fullColoring)
-  {
+  // The coloring is immutable and is shared with the renderer.
+  auto coloring = info.GetSharedColoring();
+#ifdef DEBUG
+  for (auto const & kv : *coloring)
     ASSERT_NOT_EQUAL(kv.second, SpeedGroup::Unknown, ());
-    coloring->insert(kv);
-  }
+#endif
 
-  // Note. |coloring| should not be used after this call on gui thread.
   auto const mwmId = info.GetMwmId();
   GetPlatform().RunTask(Platform::Thread::Gui, [this, mwmId, coloring]() {
     Set(mwmId, coloring);
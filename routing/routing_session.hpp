@@ -80,6 +80,8 @@ public:
   bool IsOnRoute() const;
   bool IsFollowing() const;
   void Reset();
+  /// Drops the caches of the router, the current route and the route being built are kept.
+  void ClearCaches();
 
   void SetState(SessionState state);
 
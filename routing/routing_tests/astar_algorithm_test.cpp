@@ -80,6 +80,98 @@ UNIT_TEST(AStarAlgorithm_CheckLength)
   TEST_EQUAL(result, Algorithm::Result::NoPath, ());
 }
 
+UNIT_TEST(AStarAlgorithm_ReuseMemory)
+{
+  UndirectedGraph graph;
+  graph.AddEdge(0, 1, 10);
+  graph.AddEdge(1, 2, 5);
+  graph.AddEdge(2, 3, 5);
+  graph.AddEdge(2, 4, 10);
+  graph.AddEdge(3, 4, 3);
+
+  // The same algorithm finds several paths in a row with the memory of the previous searches.
+  Algorithm algo;
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> routingResult;
+  Algorithm::ParamsForTests<> first(graph, 0u /* startVertex */, 4u /* finishVertex */,
+                                    nullptr /* prevRoute */);
+  TEST_EQUAL(algo.FindPathBidirectional(first, routingResult), Algorithm::Result::OK, ());
+  TEST_EQUAL(routingResult.m_path, vector<unsigned>({0, 1, 2, 3, 4}), ());
+
+  routingResult = {};
+  Algorithm::ParamsForTests<> second(graph, 4u /* startVertex */, 1u /* finishVertex */,
+                                     nullptr /* prevRoute */);
+  TEST_EQUAL(algo.FindPathBidirectional(second, routingResult), Algorithm::Result::OK, ());
+  TEST_EQUAL(routingResult.m_path, vector<unsigned>({4, 3, 2, 1}), ());
+  TEST_ALMOST_EQUAL_ULPS(routingResult.m_distance, 13.0, ());
+
+  algo.ReleaseMemory();
+  routingResult = {};
+  TEST_EQUAL(algo.FindPathBidirectional(first, routingResult), Algorithm::Result::OK, ());
+  TEST_ALMOST_EQUAL_ULPS(routingResult.m_distance, 23.0, ());
+}
+
+UNIT_TEST(AStarAlgorithm_Alternatives)
+{
+  UndirectedGraph graph;
+
+  // The best route 0-1-2-3-9 of length 8.
+  graph.AddEdge(0, 1, 2);
+  graph.AddEdge(1, 2, 2);
+  graph.AddEdge(2, 3, 2);
+  graph.AddEdge(3, 9, 2);
+  // 0-4-5-6-9 of length 9.5 which doesn't share edges with the best route.
+  graph.AddEdge(0, 4, 1);
+  graph.AddEdge(4, 5, 3);
+  graph.AddEdge(5, 6, 3);
+  graph.AddEdge(6, 9, 2.5);
+  // 0-7-8-9 of length 12.
+  graph.AddEdge(0, 7, 4);
+  graph.AddEdge(7, 8, 4);
+  graph.AddEdge(8, 9, 4);
+  // 0-1-10-11-9 of length 8.6 which shares 0-1 with the best route.
+  graph.AddEdge(1, 10, 2.2);
+  graph.AddEdge(10, 11, 2.2);
+  graph.AddEdge(11, 9, 2.2);
+
+  Algorithm algo;
+  Algorithm::ParamsForTests<> params(graph, 0u /* startVertex */, 9u /* finishVertex */,
+                                     nullptr /* prevRoute */);
+
+  auto const findAlternatives = [&](astar::AlternativesParams const & alternativesParams) {
+    RoutingResult<uint32_t /* Vertex */, double /* Weight */> result;
+    vector<RoutingResult<uint32_t /* Vertex */, double /* Weight */>> alternatives;
+    TEST_EQUAL(algo.FindPathBidirectional(params, alternativesParams, result, alternatives),
+               Algorithm::Result::OK, ());
+    TEST_EQUAL(result.m_path, vector<uint32_t>({0, 1, 2, 3, 9}), ());
+    TEST_ALMOST_EQUAL_ULPS(result.m_distance, 8.0, ());
+
+    vector<vector<uint32_t>> paths;
+    for (auto const & alternative : alternatives)
+      paths.push_back(alternative.m_path);
+    return paths;
+  };
+
+  astar::AlternativesParams alternativesParams;
+  alternativesParams.m_maxCount = 3;
+  TEST_EQUAL(findAlternatives(alternativesParams),
+             vector<vector<uint32_t>>({{0, 1, 10, 11, 9}, {0, 4, 5, 6, 9}}), ());
+
+  alternativesParams.m_maxSharing = 0.2;
+  TEST_EQUAL(findAlternatives(alternativesParams), vector<vector<uint32_t>>({{0, 4, 5, 6, 9}}),
+             ());
+
+  alternativesParams.m_maxStretch = 0.6;
+  TEST_EQUAL(findAlternatives(alternativesParams),
+             vector<vector<uint32_t>>({{0, 4, 5, 6, 9}, {0, 7, 8, 9}}), ());
+
+  alternativesParams.m_maxCount = 1;
+  TEST_EQUAL(findAlternatives(alternativesParams), vector<vector<uint32_t>>({{0, 4, 5, 6, 9}}),
+             ());
+
+  // No alternatives are looked for by default.
+  TEST(findAlternatives(astar::AlternativesParams()).empty(), ());
+}
+
 UNIT_TEST(AdjustRoute)
 {
   UndirectedGraph graph;
@@ -152,4 +244,44 @@ UNIT_TEST(AdjustRouteOutOfLimit)
   TEST_EQUAL(code, Algorithm::Result::NoPath, ());
   TEST(result.m_path.empty(), ());
 }
+UNIT_TEST(AdjustRouteToBackwardTree)
+{
+  UndirectedGraph graph;
+
+  // The previous route 0-1-...-299 is long enough for the backward wave to reach the side
+  // branch 280-500-501 which doesn't belong to the route.
+  uint32_t constexpr kFinish = 299;
+  for (uint32_t i = 0; i < kFinish; ++i)
+    graph.AddEdge(i /* from */, i + 1 /* to */, 1 /* weight */);
+
+  graph.AddEdge(280, 500, 1);
+  graph.AddEdge(500, 501, 1);
+  graph.AddEdge(502, 501, 1);
+
+  Algorithm algo;
+  Algorithm::ParamsForTests<> params(graph, 0u /* startVertex */, kFinish /* finishVertex */,
+                                     nullptr /* prevRoute */);
+
+  astar::BackwardTree<uint32_t, double> backwardTree;
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> result;
+  TEST_EQUAL(algo.FindPathBidirectional(params, result, backwardTree), Algorithm::Result::OK, ());
+  TEST_EQUAL(result.m_path.size(), kFinish + 1, ());
+  TEST_ALMOST_EQUAL_ULPS(backwardTree.m_distances.at(kFinish), 0.0, ());
+  TEST_ALMOST_EQUAL_ULPS(backwardTree.m_distances.at(500), 20.0, ());
+  TEST_EQUAL(backwardTree.m_parents.at(501), 500, ());
+
+  auto checkLength = [](double weight) { return weight <= 1.0; };
+  Algorithm::ParamsForTests<decltype(checkLength)> adjustParams(
+      graph, 502 /* startVertex */, {} /* finishVertex */, nullptr /* prevRoute */,
+      move(checkLength));
+
+  TEST_EQUAL(algo.AdjustRoute(adjustParams, backwardTree, result), Algorithm::Result::OK, ());
+
+  vector<unsigned> expectedRoute = {502, 501, 500};
+  for (unsigned i = 280; i <= kFinish; ++i)
+    expectedRoute.push_back(i);
+
+  TEST_EQUAL(result.m_path, expectedRoute, ());
+  TEST_ALMOST_EQUAL_ULPS(result.m_distance, 22.0, ());
+}
 }  // namespace routing_test
@@ -281,6 +281,34 @@ void TestWeightsSerialization()
 
   TEST(!connector.WeightsWereLoaded(), ());
   TEST(!connector.HasWeights(), ());
+  TEST(connector.WeightsCanBeLoadedByRows(), ());
+
+  auto const getExpectedEdges = [&](uint32_t enterId) {
+    vector<SegmentEdge> expectedEdges;
+    for (uint32_t exitId = 0; exitId < kNumTransitions; ++exitId)
+    {
+      auto const weight = weights[enterId * kNumTransitions + exitId];
+      if (weight != connector::kNoRoute)
+      {
+        expectedEdges.emplace_back(Segment(mwmId, exitId, 1 /* segmentIdx */, false /* forward */),
+                                   RouteWeight::FromCrossMwmWeight(weight));
+      }
+    }
+    return expectedEdges;
+  };
+
+  Segment const middleEnter(mwmId, 1, 1, true /* forward */);
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> source(reader);
+    CrossMwmConnectorSerializer::DeserializeWeightsRow(VehicleType::Car, middleEnter, connector,
+                                                      source);
+  }
+  TEST(!connector.WeightsWereLoaded(), ());
+  TEST(connector.OutgoingWeightsWereLoaded(middleEnter), ());
+  TEST(!connector.OutgoingWeightsWereLoaded(Segment(mwmId, 0, 1, true /* forward */)), ());
+  TEST(!connector.OutgoingWeightsWereLoaded(Segment(mwmId, 2, 1, true /* forward */)), ());
+  TestOutgoingEdges(connector, middleEnter, getExpectedEdges(1));
 
   {
     MemReader reader(buffer.data(), buffer.size());
@@ -289,25 +317,13 @@ void TestWeightsSerialization()
   }
   TEST(connector.WeightsWereLoaded(), ());
   TEST(connector.HasWeights(), ());
-
-  int weightIdx = 0;
+  TEST(!connector.WeightsCanBeLoadedByRows(), ());
 
   for (uint32_t enterId = 0; enterId < kNumTransitions; ++enterId)
   {
     Segment const enter(mwmId, enterId, 1, true /* forward */);
-    vector<SegmentEdge> expectedEdges;
-    for (uint32_t exitId = 0; exitId < kNumTransitions; ++exitId)
-    {
-      auto const weight = weights[weightIdx];
-      if (weight != connector::kNoRoute)
-      {
-        expectedEdges.emplace_back(Segment(mwmId, exitId, 1 /* segmentIdx */, false /* forward */),
-                                   RouteWeight::FromCrossMwmWeight(weight));
-      }
-      ++weightIdx;
-    }
-
-    TestOutgoingEdges(connector, enter, expectedEdges);
+    TEST(connector.OutgoingWeightsWereLoaded(enter), ());
+    TestOutgoingEdges(connector, enter, getExpectedEdges(enterId));
   }
 }
 }  // namespace
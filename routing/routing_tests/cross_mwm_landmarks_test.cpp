@@ -0,0 +1,206 @@
+#include "testing/testing.hpp"
+
+#include "routing/cross_mwm_landmarks.hpp"
+#include "routing/cross_mwm_transitions.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+using Vertex = CrossMwmLandmarks::Vertex;
+using Weight = CrossMwmLandmarks::Weight;
+using Edge = CrossMwmLandmarks::Edge;
+using Transition = CrossMwmTransitions::Transition;
+
+double constexpr kEps = 1e-6;
+
+CrossMwmTransitions MakeTransitions(uint32_t numVertices)
+{
+  vector<Transition> transitions;
+  for (uint32_t v = 0; v < numVertices; ++v)
+  {
+    transitions.emplace_back(0 /* countryIdx */, v /* featureId */, 0 /* segmentIdx */,
+                             true /* forward */, v % 2 == 0 /* isEnter */);
+  }
+  return CrossMwmTransitions({"A"}, move(transitions));
+}
+
+vector<Edge> MakeRandomGraph(uint32_t numVertices, uint32_t numEdges, uint32_t seed)
+{
+  mt19937 rng(seed);
+  uniform_int_distribution<uint32_t> vertices(0, numVertices - 1);
+  uniform_real_distribution<double> weights(0.5, 100.0);
+
+  vector<Edge> edges;
+  for (uint32_t i = 0; i < numEdges; ++i)
+    edges.emplace_back(vertices(rng), vertices(rng), weights(rng));
+  return edges;
+}
+
+// Weights in seconds of the lightest routes from |source|. Unreachable vertices get infinity.
+vector<double> Dijkstra(uint32_t numVertices, vector<Edge> const & edges, Vertex source)
+{
+  vector<vector<pair<Vertex, double>>> adj(numVertices);
+  for (auto const & edge : edges)
+    adj[edge.m_from].emplace_back(edge.m_to, edge.m_weightSec);
+
+  vector<double> distances(numVertices, INFINITY);
+  using Item = pair<double, Vertex>;
+  priority_queue<Item, vector<Item>, greater<Item>> queue;
+  distances[source] = 0.0;
+  queue.emplace(0.0, source);
+  while (!queue.empty())
+  {
+    auto const [distance, v] = queue.top();
+    queue.pop();
+    if (distance > distances[v])
+      continue;
+
+    for (auto const & [to, weight] : adj[v])
+    {
+      if (distance + weight < distances[to])
+      {
+        distances[to] = distance + weight;
+        queue.emplace(distances[to], to);
+      }
+    }
+  }
+  return distances;
+}
+
+void TestBounds(CrossMwmLandmarks const & landmarks, vector<Edge> const & edges,
+                vector<Vertex> const & sources, vector<Vertex> const & targets)
+{
+  auto const numVertices = landmarks.GetTransitions().GetNumVertices();
+  auto const sourceBounds = landmarks.GetBounds(sources);
+  auto const targetBounds = landmarks.GetBounds(targets);
+
+  vector<double> toTargets(numVertices, INFINITY);
+  vector<double> fromSources(numVertices, INFINITY);
+  for (Vertex v = 0; v < numVertices; ++v)
+  {
+    auto const distances = Dijkstra(numVertices, edges, v);
+    for (auto const t : targets)
+      toTargets[v] = min(toTargets[v], distances[t]);
+
+    for (auto const s : sources)
+    {
+      if (s == v)
+      {
+        for (Vertex u = 0; u < numVertices; ++u)
+          fromSources[u] = min(fromSources[u], distances[u]);
+      }
+    }
+  }
+
+  for (Vertex v = 0; v < numVertices; ++v)
+  {
+    TEST_LESS_OR_EQUAL(landmarks.GetLowerBoundToTargets(v, targetBounds), toTargets[v] + kEps,
+                       (v));
+    TEST_LESS_OR_EQUAL(landmarks.GetLowerBoundFromSources(sourceBounds, v),
+                       fromSources[v] + kEps, (v));
+  }
+
+  // Both heuristics are consistent.
+  for (auto const & edge : edges)
+  {
+    TEST_LESS_OR_EQUAL(landmarks.GetLowerBoundToTargets(edge.m_from, targetBounds),
+                       edge.m_weightSec +
+                           landmarks.GetLowerBoundToTargets(edge.m_to, targetBounds) + kEps,
+                       (edge.m_from, edge.m_to));
+    TEST_LESS_OR_EQUAL(landmarks.GetLowerBoundFromSources(sourceBounds, edge.m_to),
+                       edge.m_weightSec +
+                           landmarks.GetLowerBoundFromSources(sourceBounds, edge.m_from) + kEps,
+                       (edge.m_from, edge.m_to));
+  }
+}
+}  // namespace
+
+UNIT_TEST(CrossMwmLandmarks_Smoke)
+{
+  // 0 -> 1 -> 2 -> 3 and 3 is unreachable from 4.
+  vector<Edge> const edges = {{0, 1, 1.5}, {1, 2, 2.0}, {2, 3, 3.25}, {3, 4, 1.0}};
+  auto const landmarks =
+      CrossMwmLandmarks::Build(MakeTransitions(5), edges, 2 /* landmarksCount */);
+
+  TEST_EQUAL(landmarks.GetLandmarks().size(), 2, ());
+  // Vertex 4 is the farthest one from vertex 0.
+  TEST_EQUAL(landmarks.GetLandmarks()[0], 4, ());
+  TEST_EQUAL(landmarks.GetWeightToLandmark(0, 0), 7750, ());
+  TEST_EQUAL(landmarks.GetWeightFromLandmark(0, 0), CrossMwmLandmarks::kInfiniteWeight, ());
+
+  auto const targets = landmarks.GetBounds({3});
+  TEST_ALMOST_EQUAL_ABS(landmarks.GetLowerBoundToTargets(0, targets), 6.75, kEps, ());
+  TEST_ALMOST_EQUAL_ABS(landmarks.GetLowerBoundToTargets(3, targets), 0.0, kEps, ());
+  // Routes from 4 to 3 don't exist.
+  TEST_GREATER(landmarks.GetLowerBoundToTargets(4, targets), 1e6, ());
+}
+
+UNIT_TEST(CrossMwmLandmarks_RandomGraphs)
+{
+  for (uint32_t seed = 0; seed < 5; ++seed)
+  {
+    uint32_t const numVertices = 60;
+    auto const edges = MakeRandomGraph(numVertices, 2 * numVertices /* numEdges */, seed);
+    auto const landmarks =
+        CrossMwmLandmarks::Build(MakeTransitions(numVertices), edges, 4 /* landmarksCount */);
+    TEST_EQUAL(landmarks.GetLandmarks().size(), 4, ());
+
+    TestBounds(landmarks, edges, {1, 7} /* sources */, {10, 20, 30} /* targets */);
+    TestBounds(landmarks, edges, {landmarks.GetLandmarks()[0]} /* sources */,
+               {landmarks.GetLandmarks()[1]} /* targets */);
+  }
+}
+
+UNIT_TEST(CrossMwmLandmarks_SerDes)
+{
+  uint32_t const numVertices = 40;
+  auto const edges = MakeRandomGraph(numVertices, 3 * numVertices /* numEdges */, 11 /* seed */);
+  auto const landmarks =
+      CrossMwmLandmarks::Build(MakeTransitions(numVertices), edges, 3 /* landmarksCount */);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    landmarks.Serialize(writer);
+  }
+
+  CrossMwmLandmarks deserialized;
+  {
+    MemReader reader(buffer.data(), buffer.size());
+    ReaderSource<MemReader> src(reader);
+    deserialized.Deserialize(src);
+    TEST_EQUAL(src.Size(), 0, ());
+  }
+
+  TEST_EQUAL(deserialized.GetTransitions().GetTransitions(),
+             landmarks.GetTransitions().GetTransitions(), ());
+  TEST_EQUAL(deserialized.GetLandmarks(), landmarks.GetLandmarks(), ());
+  for (size_t l = 0; l < landmarks.GetLandmarks().size(); ++l)
+  {
+    for (Vertex v = 0; v < numVertices; ++v)
+    {
+      TEST_EQUAL(deserialized.GetWeightFromLandmark(l, v), landmarks.GetWeightFromLandmark(l, v),
+                 ());
+      TEST_EQUAL(deserialized.GetWeightToLandmark(l, v), landmarks.GetWeightToLandmark(l, v), ());
+    }
+  }
+
+  auto const vertex = deserialized.GetTransitions().GetVertex("A", 5 /* featureId */,
+                                                              0 /* segmentIdx */, true /* forward */);
+  TEST(vertex, ());
+  TEST_EQUAL(*vertex, 5, ());
+}
@@ -125,4 +125,43 @@ UNIT_TEST(FollowedPolylineGetDistanceFromBeginM)
       mercator::DistanceOnEarth(kTestDirectedPolyline1.Front(), point);
   TEST_ALMOST_EQUAL_ULPS(distance, masterDistance, ());
 }
+
+UNIT_TEST(FollowedPolylineLongJump)
+{
+  // The route goes to the east and comes back slightly to the north, so both the legs are
+  // inside the position rect.
+  std::vector<m2::PointD> points;
+  for (size_t i = 0; i <= 100; ++i)
+    points.emplace_back(i * 0.01, 0.0);
+  for (size_t i = 0; i <= 100; ++i)
+    points.emplace_back((100 - i) * 0.01, 0.00001);
+
+  FollowedPolyline polyline(points.cbegin(), points.cend());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 0, ());
+
+  polyline.UpdateProjection(mercator::RectByCenterXYAndSizeInMeters({0.505, 0.000005}, 10));
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 50, ());
+
+  polyline.UpdateProjection(mercator::RectByCenterXYAndSizeInMeters({0.255, 0.00001}, 10));
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 175, ());
+
+  // Projection is not found far from the route.
+  TEST(!polyline.UpdateProjection(mercator::RectByCenterXYAndSizeInMeters({0.5, 1.0}, 10)).IsValid(),
+       ());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 175, ());
+}
+
+UNIT_TEST(FollowedPolylineLongJumpMatching)
+{
+  std::vector<m2::PointD> points;
+  for (size_t i = 0; i <= 200; ++i)
+    points.emplace_back(i * 0.01, 0.0);
+
+  FollowedPolyline polyline(points.cbegin(), points.cend());
+  TEST(polyline.UpdateMatchingProjection(
+           mercator::RectByCenterXYAndSizeInMeters({1.505, 0.0}, 10)),
+       ());
+  TEST_EQUAL(polyline.GetCurrentIter().m_ind, 150, ());
+  TEST(polyline.GetCurrentIter().m_pt.EqualDxDy({1.505, 0.0}, 1e-9), ());
+}
 }  // namespace routing_test
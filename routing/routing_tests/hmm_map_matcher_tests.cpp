@@ -0,0 +1,215 @@
+#include "testing/testing.hpp"
+
+#include "routing/hmm_map_matcher.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/point2d.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+using namespace routing;
+using namespace std;
+
+double constexpr kStep = 0.0001;
+
+// One-way roads, every road is a polyline of points in mercator.
+class TestGraph : public HmmMapMatcher::Graph
+{
+public:
+  void AddRoad(vector<m2::PointD> const & points) { m_roads.push_back(points); }
+
+  // HmmMapMatcher::Graph overrides:
+  void GetCandidates(m2::PointD const & point, double radiusM,
+                     vector<HmmMapMatcher::Candidate> & candidates) override
+  {
+    for (uint32_t featureId = 0; featureId < m_roads.size(); ++featureId)
+    {
+      auto const & road = m_roads[featureId];
+      for (uint32_t segmentIdx = 0; segmentIdx + 1 < road.size(); ++segmentIdx)
+      {
+        m2::ParametrizedSegment<m2::PointD> const segment(road[segmentIdx], road[segmentIdx + 1]);
+        auto const projection = segment.ClosestPointTo(point);
+        double const distanceM = mercator::DistanceOnEarth(point, projection);
+        if (distanceM < radiusM)
+        {
+          double const offsetM = mercator::DistanceOnEarth(road[segmentIdx], projection);
+          candidates.emplace_back(Segment(kMwmId, featureId, segmentIdx, true /* forward */),
+                                  distanceM, offsetM);
+        }
+      }
+    }
+  }
+
+  void GetOutgoingSegments(Segment const & segment, vector<Segment> & segments) override
+  {
+    if (segment.GetSegmentIdx() + 2 < m_roads[segment.GetFeatureId()].size())
+    {
+      segments.emplace_back(kMwmId, segment.GetFeatureId(), segment.GetSegmentIdx() + 1,
+                            true /* forward */);
+    }
+  }
+
+  double GetLengthM(Segment const & segment) override
+  {
+    auto const & road = m_roads[segment.GetFeatureId()];
+    return mercator::DistanceOnEarth(road[segment.GetSegmentIdx()],
+                                     road[segment.GetSegmentIdx() + 1]);
+  }
+
+private:
+  static NumMwmId constexpr kMwmId = 0;
+  vector<vector<m2::PointD>> m_roads;
+};
+
+// Road 0 goes east along y = 0, road 1 goes west along y = 3 * kStep (about 33 meters to the
+// north), both have 20 segments of about 11 meters.
+TestGraph MakeParallelRoads()
+{
+  TestGraph graph;
+  vector<m2::PointD> east;
+  vector<m2::PointD> west;
+  for (size_t i = 0; i <= 20; ++i)
+  {
+    east.emplace_back(kStep * i, 0.0);
+    west.emplace_back(kStep * (20 - i), 3 * kStep);
+  }
+  graph.AddRoad(east);
+  graph.AddRoad(west);
+  return graph;
+}
+
+// Points in the middles of the segments of road 0.
+vector<m2::PointD> MakeEastTrack(size_t count)
+{
+  vector<m2::PointD> points;
+  for (size_t i = 0; i < count; ++i)
+    points.emplace_back(kStep * (i + 0.5), 0.0);
+  return points;
+}
+
+// Checks that |piece| goes along road 0 and its i-th segment is |segmentIds[i]| of |pointIds[i]|.
+void TestEastPiece(HmmMapMatcher::MatchedPiece const & piece, vector<size_t> const & pointIds,
+                   vector<uint32_t> const & segmentIds)
+{
+  TEST_EQUAL(piece.size(), pointIds.size(), ());
+  TEST_EQUAL(piece.size(), segmentIds.size(), ());
+  for (size_t i = 0; i < piece.size(); ++i)
+  {
+    TEST_EQUAL(piece[i].first, pointIds[i], (i));
+    TEST_EQUAL(piece[i].second.GetFeatureId(), 0, (i));
+    TEST_EQUAL(piece[i].second.GetSegmentIdx(), segmentIds[i], (i));
+  }
+}
+
+void TestEastPiece(HmmMapMatcher::MatchedPiece const & piece, vector<size_t> const & pointIds)
+{
+  vector<uint32_t> segmentIds;
+  for (auto const pointIdx : pointIds)
+    segmentIds.push_back(static_cast<uint32_t>(pointIdx));
+  TestEastPiece(piece, pointIds, segmentIds);
+}
+
+UNIT_TEST(HmmMapMatcher_NoisyPoint)
+{
+  auto graph = MakeParallelRoads();
+  auto points = MakeEastTrack(10);
+  // The point is closer to road 1, but road 1 can't be reached from road 0.
+  points[5].y = 1.6 * kStep;
+
+  HmmMapMatcher matcher(graph);
+  vector<HmmMapMatcher::MatchedPiece> pieces;
+  matcher.Match(points, pieces);
+
+  TEST_EQUAL(pieces.size(), 1, ());
+  TestEastPiece(pieces[0], {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+UNIT_TEST(HmmMapMatcher_PointFarFromRoads)
+{
+  auto graph = MakeParallelRoads();
+  auto points = MakeEastTrack(10);
+  points[5].y = 10 * kStep;
+
+  HmmMapMatcher matcher(graph);
+  vector<HmmMapMatcher::MatchedPiece> pieces;
+  matcher.Match(points, pieces);
+
+  // Segment 5 between points 4 and 6 is passed with point 4.
+  TEST_EQUAL(pieces.size(), 1, ());
+  TestEastPiece(pieces[0], {0, 1, 2, 3, 4, 4, 6, 7, 8, 9}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+UNIT_TEST(HmmMapMatcher_SparsePoints)
+{
+  auto graph = MakeParallelRoads();
+  // Points on segments 0, 3, 4 and 8 of road 0.
+  vector<m2::PointD> const points = {{kStep * 0.5, 0.0},
+                                     {kStep * 3.5, 0.0},
+                                     {kStep * 4.5, 0.0},
+                                     {kStep * 8.5, 0.0}};
+
+  HmmMapMatcher::Params params;
+  // The last window has the last point only.
+  params.m_windowSize = 3;
+  HmmMapMatcher matcher(graph, params);
+  vector<HmmMapMatcher::MatchedPiece> pieces;
+  matcher.Match(points, pieces);
+
+  TEST_EQUAL(pieces.size(), 1, ());
+  TestEastPiece(pieces[0], {0, 0, 0, 1, 2, 2, 2, 2, 3}, {0, 1, 2, 3, 4, 5, 6, 7, 8});
+}
+
+UNIT_TEST(HmmMapMatcher_Split)
+{
+  auto graph = MakeParallelRoads();
+  auto points = MakeEastTrack(4);
+  // Points on road 1 which is not connected to road 0.
+  points.emplace_back(kStep * 10.5, 3 * kStep);
+  points.emplace_back(kStep * 9.5, 3 * kStep);
+
+  HmmMapMatcher matcher(graph);
+  vector<HmmMapMatcher::MatchedPiece> pieces;
+  matcher.Match(points, pieces);
+
+  TEST_EQUAL(pieces.size(), 2, ());
+  TestEastPiece(pieces[0], {0, 1, 2, 3});
+  TEST_EQUAL(pieces[1].size(), 2, ());
+  TEST_EQUAL(pieces[1][0].first, 4, ());
+  TEST_EQUAL(pieces[1][0].second.GetFeatureId(), 1, ());
+  TEST_EQUAL(pieces[1][0].second.GetSegmentIdx(), 9, ());
+  TEST_EQUAL(pieces[1][1].second.GetSegmentIdx(), 10, ());
+}
+
+UNIT_TEST(HmmMapMatcher_WindowsAndCache)
+{
+  auto graph = MakeParallelRoads();
+  auto points = MakeEastTrack(20);
+  points[7].y = 1.6 * kStep;
+
+  HmmMapMatcher::Params params;
+  params.m_windowSize = 4;
+  HmmMapMatcher matcher(graph, params);
+  vector<HmmMapMatcher::MatchedPiece> pieces;
+  matcher.Match(points, pieces);
+
+  TEST_EQUAL(pieces.size(), 1, ());
+  vector<size_t> pointIds;
+  for (size_t i = 0; i < points.size(); ++i)
+    pointIds.push_back(i);
+  TestEastPiece(pieces[0], pointIds);
+
+  // The same track again is matched with the cached searches only.
+  auto const searchesCount = matcher.GetSearchesCount();
+  auto const cachedSearchesCount = matcher.GetCachedSearchesCount();
+  pieces.clear();
+  matcher.Match(points, pieces);
+  TEST_EQUAL(pieces.size(), 1, ());
+  TestEastPiece(pieces[0], pointIds);
+  TEST_EQUAL(matcher.GetCachedSearchesCount() - cachedSearchesCount,
+             matcher.GetSearchesCount() - searchesCount, ());
+}
+}  // namespace
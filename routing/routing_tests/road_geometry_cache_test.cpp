@@ -0,0 +1,78 @@
+#include "testing/testing.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/road_geometry_cache.hpp"
+
+#include <cstdint>
+#include <memory>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+RoadGeometryKey MakeKey(uint32_t featureId, VehicleType vehicleType = VehicleType::Car)
+{
+  RoadGeometryKey key;
+  key.m_vehicleType = vehicleType;
+  key.m_featureId = featureId;
+  return key;
+}
+
+RoadGeometryCache::Loader MakeLoader(double speedKMpH, size_t & loadsCount)
+{
+  return [speedKMpH, &loadsCount](RoadGeometry & road) {
+    ++loadsCount;
+    road = RoadGeometry(false /* oneWay */, speedKMpH, speedKMpH,
+                        RoadGeometry::Points({{0.0, 0.0}, {1.0, 1.0}}));
+  };
+}
+}  // namespace
+
+UNIT_TEST(RoadGeometryCache_HitsAndMisses)
+{
+  RoadGeometryCache cache(RoadGeometryCache::kDefaultMaxSizeBytes);
+  size_t loadsCount = 0;
+
+  auto const road = cache.GetRoad(MakeKey(1), MakeLoader(10.0, loadsCount));
+  TEST_EQUAL(road->GetPointsCount(), 2, ());
+  TEST_EQUAL(cache.GetRoad(MakeKey(1), MakeLoader(20.0, loadsCount)), road, ());
+  TEST_EQUAL(loadsCount, 1, ());
+
+  // The same feature for another vehicle is another road.
+  auto const pedestrianRoad =
+      cache.GetRoad(MakeKey(1, VehicleType::Pedestrian), MakeLoader(5.0, loadsCount));
+  TEST_NOT_EQUAL(pedestrianRoad, road, ());
+  TEST_ALMOST_EQUAL_ABS(pedestrianRoad->GetSpeed(true /* forward */).m_weight, 5.0, 1e-9, ());
+  TEST_EQUAL(loadsCount, 2, ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 1, ());
+  TEST_EQUAL(stats.m_misses, 2, ());
+  TEST_EQUAL(stats.m_evictions, 0, ());
+  TEST_EQUAL(stats.m_roadsCount, 2, ());
+  TEST_EQUAL(stats.m_sizeBytes, 2 * sizeof(RoadGeometry), ());
+}
+
+UNIT_TEST(RoadGeometryCache_Eviction)
+{
+  // Every shard can keep only one road.
+  RoadGeometryCache cache(RoadGeometryCache::kShardsCount * sizeof(RoadGeometry));
+  size_t loadsCount = 0;
+
+  auto const road = cache.GetRoad(MakeKey(1), MakeLoader(10.0, loadsCount));
+  uint32_t featureId = 2;
+  while (cache.GetStats().m_evictions == 0)
+    cache.GetRoad(MakeKey(featureId++), MakeLoader(10.0, loadsCount));
+
+  // Evicted roads stay valid for their owners.
+  TEST_EQUAL(road->GetPointsCount(), 2, ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_misses, featureId - 1, ());
+  TEST_EQUAL(stats.m_roadsCount + stats.m_evictions, stats.m_misses, ());
+  TEST_LESS_OR_EQUAL(stats.m_sizeBytes, RoadGeometryCache::kShardsCount * sizeof(RoadGeometry), ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetStats().m_roadsCount, 0, ());
+}
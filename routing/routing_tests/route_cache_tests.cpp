@@ -0,0 +1,75 @@
+#include "testing/testing.hpp"
+
+#include "routing/route.hpp"
+#include "routing/route_cache.hpp"
+#include "routing/routing_options.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+using namespace routing;
+using namespace std;
+
+RouteCache::Key MakeKey(m2::PointD const & finish, uint64_t trafficVersion = 0)
+{
+  return RouteCache::Key({{0.0, 0.0}, finish}, 0 /* passedIdx */, m2::PointD::Zero(),
+                         VehicleType::Car, RoutingOptions(), trafficVersion);
+}
+
+Route MakeRoute(m2::PointD const & finish, uint64_t routeId)
+{
+  vector<m2::PointD> const points = {{0.0, 0.0}, finish};
+  return Route("router", points.begin(), points.end(), routeId);
+}
+
+UNIT_TEST(RouteCache_FindAndAdd)
+{
+  RouteCache cache(2 /* maxSize */);
+  TEST(!cache.Find(MakeKey({1.0, 1.0})), ());
+
+  auto const alternative = make_shared<Route>(MakeRoute({1.0, 1.0}, 2 /* routeId */));
+  cache.Add(MakeKey({1.0, 1.0}), MakeRoute({1.0, 1.0}, 1 /* routeId */), {alternative});
+
+  auto const * entry = cache.Find(MakeKey({1.0, 1.0}));
+  TEST(entry, ());
+  TEST(entry->m_route.IsRouteId(1), ());
+  TEST_EQUAL(entry->m_alternatives.size(), 1, ());
+  TEST(entry->m_alternatives[0].IsRouteId(2), ());
+
+  // The route was built with other traffic.
+  TEST(!cache.Find(MakeKey({1.0, 1.0}, 1 /* trafficVersion */)), ());
+
+  TEST_EQUAL(cache.GetStats().m_hits, 1, ());
+  TEST_EQUAL(cache.GetStats().m_misses, 2, ());
+  TEST_ALMOST_EQUAL_ABS(cache.GetStats().GetHitRate(), 1.0 / 3.0, 1e-9, ());
+
+  cache.Clear();
+  TEST_EQUAL(cache.GetSize(), 0, ());
+  TEST(!cache.Find(MakeKey({1.0, 1.0})), ());
+}
+
+UNIT_TEST(RouteCache_LeastRecentlyUsed)
+{
+  RouteCache cache(2 /* maxSize */);
+  cache.Add(MakeKey({1.0, 1.0}), MakeRoute({1.0, 1.0}, 1 /* routeId */), {});
+  cache.Add(MakeKey({2.0, 2.0}), MakeRoute({2.0, 2.0}, 2 /* routeId */), {});
+
+  // The first route becomes the most recently used one, so the second one is removed.
+  TEST(cache.Find(MakeKey({1.0, 1.0})), ());
+  cache.Add(MakeKey({3.0, 3.0}), MakeRoute({3.0, 3.0}, 3 /* routeId */), {});
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(cache.Find(MakeKey({1.0, 1.0})), ());
+  TEST(!cache.Find(MakeKey({2.0, 2.0})), ());
+  TEST(cache.Find(MakeKey({3.0, 3.0})), ());
+
+  // The route for the same key is replaced.
+  cache.Add(MakeKey({3.0, 3.0}), MakeRoute({3.0, 3.0}, 4 /* routeId */), {});
+  TEST_EQUAL(cache.GetSize(), 2, ());
+  TEST(cache.Find(MakeKey({3.0, 3.0}))->m_route.IsRouteId(4), ());
+}
+}  // namespace
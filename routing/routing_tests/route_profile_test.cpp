@@ -0,0 +1,54 @@
+#include "testing/testing.hpp"
+
+#include "routing/route_profile.hpp"
+#include "routing/router_delegate.hpp"
+
+#include <chrono>
+#include <string>
+
+using namespace routing;
+using namespace std;
+
+UNIT_TEST(RouteProfile_Delegate)
+{
+  RouterDelegate delegate;
+  auto const before = delegate.GetProfile();
+
+  delegate.AddPhaseTime(RoutingPhase::Leaps, chrono::milliseconds(1500));
+  delegate.AddPhaseTime(RoutingPhase::Leaps, chrono::milliseconds(500));
+  delegate.AddPhaseTime(RoutingPhase::Directions, chrono::milliseconds(250));
+  {
+    RouterDelegate::ScopedPhaseTimer timer(delegate, RoutingPhase::Snapping);
+  }
+  delegate.OnMwmOpened();
+  delegate.OnMwmOpened();
+  delegate.OnVertexSettled();
+
+  auto const profile = delegate.GetProfile() - before;
+  TEST_ALMOST_EQUAL_ABS(profile.GetPhaseSeconds(RoutingPhase::Leaps), 2.0, 1e-9, ());
+  TEST_ALMOST_EQUAL_ABS(profile.GetPhaseSeconds(RoutingPhase::Directions), 0.25, 1e-9, ());
+  TEST_GREATER_OR_EQUAL(profile.GetPhaseSeconds(RoutingPhase::Snapping), 0.0, ());
+  TEST_EQUAL(profile.GetPhaseSeconds(RoutingPhase::Refinement), 0.0, ());
+  TEST_EQUAL(profile.m_openedMwmsCount, 2, ());
+  TEST_EQUAL(profile.m_settledVerticesCount, 1, ());
+
+  // The profile of the next route building doesn't take the previous one.
+  auto const next = delegate.GetProfile();
+  delegate.OnMwmOpened();
+  TEST_EQUAL((delegate.GetProfile() - next).m_openedMwmsCount, 1, ());
+  TEST_EQUAL((delegate.GetProfile() - next).GetPhaseSeconds(RoutingPhase::Leaps), 0.0, ());
+}
+
+UNIT_TEST(RouteProfile_ToJson)
+{
+  RouteProfile profile;
+  profile.m_phaseSeconds[static_cast<size_t>(RoutingPhase::Refinement)] = 0.5;
+  profile.m_settledVerticesCount = 100;
+  profile.m_openedMwmsCount = 3;
+
+  TEST_EQUAL(profile.ToJson(),
+             "{\"opened_mwms\":3,\"phases_seconds\":{\"directions\":0.0,\"leaps\":0.0,"
+             "\"leaps_post_processing\":0.0,\"mwm_loading\":0.0,\"refinement\":0.5,"
+             "\"snapping\":0.0},\"settled_vertices\":100}",
+             ());
+}
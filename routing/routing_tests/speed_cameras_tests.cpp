@@ -172,4 +172,28 @@ UNIT_TEST(SpeedCamera_SerDes_3)
 
   TEST(TestSerDesSpeedCamera(speedCamerasMetadata), ());
 }
+
+UNIT_TEST(SegmentSpeedCameras_GetCameras)
+{
+  SegmentSpeedCameras::CamerasMap camerasMap;
+  camerasMap[{1 /* featureId */, 1 /* segmentId */}] = {{0.5, 90}, {0.2, 60}, {0.5, 40}};
+  camerasMap[{1 /* featureId */, 2 /* segmentId */}] = {{0.3, 60}};
+  SegmentSpeedCameras const cameras(camerasMap);
+
+  // Cameras with equal positions are merged into the one with the minimal max speed.
+  auto forward = cameras.GetCameras({1 /* featureId */, 1 /* segmentId */}, true /* isForward */);
+  TEST_EQUAL(forward.size(), 2, ());
+  TEST(base::AlmostEqualAbs(forward[0].m_coef, 0.2, 1e-5), ());
+  TEST_EQUAL(forward[0].m_maxSpeedKmPH, 60, ());
+  TEST(base::AlmostEqualAbs(forward[1].m_coef, 0.5, 1e-5), ());
+  TEST_EQUAL(forward[1].m_maxSpeedKmPH, 40, ());
+
+  auto backward = cameras.GetCameras({1 /* featureId */, 1 /* segmentId */}, false /* isForward */);
+  TEST_EQUAL(backward.size(), 2, ());
+  TEST_EQUAL(backward[0].m_maxSpeedKmPH, 40, ());
+  TEST_EQUAL(backward[1].m_maxSpeedKmPH, 60, ());
+
+  TEST_EQUAL(cameras.GetCameras({1 /* featureId */, 2 /* segmentId */}, true).size(), 1, ());
+  TEST(cameras.GetCameras({2 /* featureId */, 1 /* segmentId */}, true).empty(), ());
+}
 }  // namespace
@@ -0,0 +1,159 @@
+#include "testing/testing.hpp"
+
+#include "routing/speed_profiles.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+using namespace routing;
+using namespace std;
+
+namespace
+{
+time_t constexpr kSecondsInHour = 60 * 60;
+
+SpeedProfiles::Profile MakeProfile(uint8_t percent, size_t hour, uint8_t hourPercent)
+{
+  SpeedProfiles::Profile profile;
+  profile.fill(percent);
+  profile[hour] = hourPercent;
+  return profile;
+}
+
+// Returns time of hour |hour| of the week which contains the current time.
+time_t GetTimeOfHour(size_t hour)
+{
+  time_t const now = time(nullptr);
+  auto const currentHour = static_cast<time_t>(SpeedProfiles::GetHourOfWeek(now));
+  return now + (static_cast<time_t>(hour) - currentHour) * kSecondsInHour;
+}
+
+SpeedProfiles MakeSample()
+{
+  vector<SpeedProfiles::Profile> profiles = {MakeProfile(100 /* percent */, 8 /* hour */, 50),
+                                             MakeProfile(90 /* percent */, 17 /* hour */, 25)};
+  vector<SpeedProfiles::Entry> entries = {
+      {10 /* featureId */, true /* forward */, 1 /* profileIdx */},
+      {3 /* featureId */, false /* forward */, 0 /* profileIdx */},
+      {3 /* featureId */, true /* forward */, 1 /* profileIdx */},
+      {100000 /* featureId */, true /* forward */, 0 /* profileIdx */},
+  };
+  return SpeedProfiles(move(profiles), move(entries));
+}
+
+void TestSample(SpeedProfiles const & speedProfiles)
+{
+  TEST(!speedProfiles.IsEmpty(), ());
+  TEST_EQUAL(speedProfiles.GetEntriesNumber(), 4, ());
+
+  TEST(!speedProfiles.GetSpeedFactor(1 /* featureId */, true /* forward */, GetTimeOfHour(8)), ());
+  TEST(!speedProfiles.GetSpeedFactor(10 /* featureId */, false /* forward */, GetTimeOfHour(8)),
+       ());
+
+  auto factor = speedProfiles.GetSpeedFactor(3 /* featureId */, false /* forward */,
+                                             GetTimeOfHour(8));
+  TEST(factor, ());
+  TEST_ALMOST_EQUAL_ABS(*factor, 0.5, 1e-9, ());
+
+  factor = speedProfiles.GetSpeedFactor(3 /* featureId */, false /* forward */, GetTimeOfHour(9));
+  TEST(factor, ());
+  TEST_ALMOST_EQUAL_ABS(*factor, 1.0, 1e-9, ());
+
+  factor = speedProfiles.GetSpeedFactor(3 /* featureId */, true /* forward */, GetTimeOfHour(17));
+  TEST(factor, ());
+  TEST_ALMOST_EQUAL_ABS(*factor, 0.25, 1e-9, ());
+
+  factor = speedProfiles.GetSpeedFactor(10 /* featureId */, true /* forward */, GetTimeOfHour(0));
+  TEST(factor, ());
+  TEST_ALMOST_EQUAL_ABS(*factor, 0.9, 1e-9, ());
+
+  factor = speedProfiles.GetSpeedFactor(100000 /* featureId */, true /* forward */,
+                                        GetTimeOfHour(8));
+  TEST(factor, ());
+  TEST_ALMOST_EQUAL_ABS(*factor, 0.5, 1e-9, ());
+}
+}  // namespace
+
+UNIT_TEST(SpeedProfiles_GetSpeedFactor)
+{
+  SpeedProfiles const empty;
+  TEST(empty.IsEmpty(), ());
+  TEST(!empty.GetSpeedFactor(3 /* featureId */, true /* forward */, time(nullptr)), ());
+
+  TestSample(MakeSample());
+}
+
+UNIT_TEST(SpeedProfiles_SerDes)
+{
+  auto const speedProfiles = MakeSample();
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<decltype(buffer)> writer(buffer);
+    speedProfiles.Serialize(writer);
+  }
+
+  SpeedProfiles deserialized;
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  deserialized.Deserialize(src);
+
+  TEST_EQUAL(src.Size(), 0, ());
+  TEST(deserialized.GetProfiles() == speedProfiles.GetProfiles(), ());
+  TestSample(deserialized);
+}
+
+UNIT_TEST(SpeedProfiles_GetHourOfWeek)
+{
+  time_t const now = time(nullptr);
+  tm local = {};
+  localtime_r(&now, &local);
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(now),
+             static_cast<size_t>(local.tm_wday * 24 + local.tm_hour), ());
+
+  // 1 January 1970 00:00 UTC is Thursday.
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(0 /* time */, 0 /* utcOffsetSeconds */), 4 * 24, ());
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(0 /* time */, -kSecondsInHour), 4 * 24 - 1, ());
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(0 /* time */, 5 * kSecondsInHour + 30 * 60),
+             4 * 24 + 5, ());
+
+  auto const hour = SpeedProfiles::GetHourOfWeek(now, local.tm_gmtoff);
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(now + kSecondsInHour, local.tm_gmtoff),
+             (hour + 1) % SpeedProfiles::kHoursInWeek, ());
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(now + 7 * 24 * kSecondsInHour, local.tm_gmtoff), hour,
+             ());
+  TEST_EQUAL(SpeedProfiles::GetHourOfWeek(now - 7 * 24 * kSecondsInHour, local.tm_gmtoff), hour,
+             ());
+}
+
+UNIT_TEST(SpeedProfiles_RegionUtcOffset)
+{
+  time_t const now = time(nullptr);
+  tm local = {};
+  localtime_r(&now, &local);
+  auto const deviceStandardOffset =
+      static_cast<int32_t>(local.tm_isdst > 0 ? local.tm_gmtoff - kSecondsInHour : local.tm_gmtoff);
+
+  auto speedProfiles = MakeSample();
+  TEST_EQUAL(speedProfiles.GetRegionHourOfWeek(now), SpeedProfiles::GetHourOfWeek(now), ());
+
+  // The local time of the device is taken in the same time zone, it has the daylight saving time.
+  speedProfiles.SetRegionUtcOffset(deviceStandardOffset);
+  TEST_EQUAL(speedProfiles.GetRegionHourOfWeek(now), SpeedProfiles::GetHourOfWeek(now), ());
+
+  int32_t const regionOffset = deviceStandardOffset + 5 * kSecondsInHour;
+  speedProfiles.SetRegionUtcOffset(regionOffset);
+  TEST_EQUAL(speedProfiles.GetRegionHourOfWeek(now),
+             SpeedProfiles::GetHourOfWeek(now, regionOffset), ());
+
+  // Hour 8 of the region is slow for feature 3 in the backward direction.
+  auto const currentHour = static_cast<time_t>(speedProfiles.GetRegionHourOfWeek(now));
+  auto const factor = speedProfiles.GetSpeedFactor(
+      3 /* featureId */, false /* forward */, now + (8 - currentHour) * kSecondsInHour);
+  TEST(factor, ());
+  TEST_ALMOST_EQUAL_ABS(*factor, 0.5, 1e-9, ());
+}
@@ -4,6 +4,9 @@
 #include "coding/varint.hpp"
 
 #include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
 
 namespace routing
 {
@@ -45,6 +48,53 @@ void SerializeSpeedCamera(FileWriter & writer, routing::SpeedCameraMetadata cons
   WriteVarInt(writer, 0 /* number of time conditions */);
 }
 
+SegmentSpeedCameras::SegmentSpeedCameras(CamerasMap const & cameras)
+{
+  size_t count = 0;
+  for (auto const & segmentCameras : cameras)
+    count += segmentCameras.second.size();
+  m_cameras.reserve(count);
+
+  std::vector<RouteSegment::SpeedCamera> sorted;
+  for (auto const & [segment, segmentCameras] : cameras)
+  {
+    // TODO (@gmoryes) do this in generator.
+    // Cameras with equal positions are sorted in speed decrease order, so the last of them
+    // is the one with the minimal max speed.
+    sorted = segmentCameras;
+    std::sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+      static auto constexpr kEps = 1e-5;
+      if (i + 1 == sorted.size() ||
+          !base::AlmostEqualAbs(sorted[i].m_coef, sorted[i + 1].m_coef, kEps))
+      {
+        m_cameras.emplace_back(segment, sorted[i]);
+      }
+    }
+  }
+}
+
+std::vector<RouteSegment::SpeedCamera> SegmentSpeedCameras::GetCameras(
+    SegmentCoord const & segment, bool isForward) const
+{
+  auto const less = [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; };
+  auto const range = std::equal_range(m_cameras.cbegin(), m_cameras.cend(),
+                                      std::make_pair(segment, RouteSegment::SpeedCamera()), less);
+
+  std::vector<RouteSegment::SpeedCamera> cameras;
+  cameras.reserve(std::distance(range.first, range.second));
+  for (auto it = range.first; it != range.second; ++it)
+    cameras.push_back(it->second);
+
+  // Cameras are stored from the beginning to the ending of the segment. So if we go along the
+  // segment in backward direction, we should read them in reverse sequence too.
+  if (!isForward)
+    std::reverse(cameras.begin(), cameras.end());
+
+  return cameras;
+}
+
 std::string DebugPrint(SegmentCoord const & segment)
 {
   std::stringstream ss;
@@ -167,5 +167,34 @@ void DeserializeSpeedCamsFromMwm(
   }
 }
 
+/// \brief Speed cameras of an mwm in a flat array sorted by segments. The cameras of a segment
+/// are sorted by their positions on the segment and the cameras with equal positions are merged
+/// into the one with the minimal max speed, so the cameras of a segment are got by a binary search.
+class SegmentSpeedCameras
+{
+public:
+  using CamerasMap = std::map<SegmentCoord, std::vector<RouteSegment::SpeedCamera>>;
+
+  SegmentSpeedCameras() = default;
+  explicit SegmentSpeedCameras(CamerasMap const & cameras);
+
+  template <typename Reader>
+  static SegmentSpeedCameras Deserialize(ReaderSource<Reader> & src)
+  {
+    CamerasMap cameras;
+    DeserializeSpeedCamsFromMwm(src, cameras);
+    return SegmentSpeedCameras(cameras);
+  }
+
+  /// \returns the cameras of |segment| in the order of moving along it.
+  std::vector<RouteSegment::SpeedCamera> GetCameras(SegmentCoord const & segment,
+                                                    bool isForward) const;
+
+  bool IsEmpty() const { return m_cameras.empty(); }
+
+private:
+  std::vector<std::pair<SegmentCoord, RouteSegment::SpeedCamera>> m_cameras;
+};
+
 std::string DebugPrint(SegmentCoord const & segment);
 }  // namespace routing
@@ -0,0 +1,95 @@
+#include "routing/speed_profiles.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+using namespace std;
+
+namespace routing
+{
+namespace
+{
+struct DeviceUtcOffset
+{
+  int64_t m_hour = numeric_limits<int64_t>::min();
+  int64_t m_offset = 0;
+  int64_t m_standardOffset = 0;
+};
+
+// Returns the UTC offset of the device at |time|. Local time conversion is too slow for every edge
+// of a route building, and the offset changes at the beginning of an hour, so it's cached by
+// the hour.
+DeviceUtcOffset const & GetDeviceUtcOffset(time_t time)
+{
+  int64_t constexpr kSecondsInHour = 60 * 60;
+  thread_local DeviceUtcOffset cached;
+
+  auto const hour = static_cast<int64_t>(time) / kSecondsInHour;
+  if (cached.m_hour == hour)
+    return cached;
+
+  tm local = {};
+  localtime_r(&time, &local);
+  cached.m_hour = hour;
+  cached.m_offset = local.tm_gmtoff;
+  cached.m_standardOffset = local.tm_isdst > 0 ? local.tm_gmtoff - kSecondsInHour : local.tm_gmtoff;
+  return cached;
+}
+}  // namespace
+
+SpeedProfiles::SpeedProfiles(vector<Profile> && profiles, vector<Entry> entries)
+  : m_profiles(move(profiles))
+{
+  sort(entries.begin(), entries.end(), [](Entry const & lhs, Entry const & rhs) {
+    return GetKey(lhs.m_featureId, lhs.m_forward) < GetKey(rhs.m_featureId, rhs.m_forward);
+  });
+
+  m_keys.reserve(entries.size());
+  m_profileIndices.reserve(entries.size());
+  for (auto const & entry : entries)
+  {
+    auto const key = GetKey(entry.m_featureId, entry.m_forward);
+    CHECK(m_keys.empty() || m_keys.back() != key, ("Duplicate profile of", entry.m_featureId));
+    CHECK_LESS(entry.m_profileIdx, m_profiles.size(), ());
+    m_keys.push_back(key);
+    m_profileIndices.push_back(entry.m_profileIdx);
+  }
+}
+
+optional<double> SpeedProfiles::GetSpeedFactor(uint32_t featureId, bool forward, time_t time) const
+{
+  auto const key = GetKey(featureId, forward);
+  auto const it = lower_bound(m_keys.cbegin(), m_keys.cend(), key);
+  if (it == m_keys.cend() || *it != key)
+    return {};
+
+  auto const & profile = m_profiles[m_profileIndices[distance(m_keys.cbegin(), it)]];
+  return static_cast<double>(profile[GetRegionHourOfWeek(time)]) / kMaxPercent;
+}
+
+size_t SpeedProfiles::GetRegionHourOfWeek(time_t time) const
+{
+  auto const & device = GetDeviceUtcOffset(time);
+  if (!m_regionUtcOffset || *m_regionUtcOffset == device.m_standardOffset)
+    return GetHourOfWeek(time, device.m_offset);
+  return GetHourOfWeek(time, *m_regionUtcOffset);
+}
+
+// static
+size_t SpeedProfiles::GetHourOfWeek(time_t time)
+{
+  return GetHourOfWeek(time, GetDeviceUtcOffset(time).m_offset);
+}
+
+// static
+size_t SpeedProfiles::GetHourOfWeek(time_t time, int64_t utcOffset)
+{
+  // 1 January 1970 is Thursday.
+  int64_t constexpr kEpochHourOfWeek = 4 * 24;
+  auto const hours = (static_cast<int64_t>(time) + utcOffset) / (60 * 60) + kEpochHourOfWeek;
+  auto const hourOfWeek = hours % static_cast<int64_t>(kHoursInWeek);
+  return static_cast<size_t>(hourOfWeek < 0 ? hourOfWeek + kHoursInWeek : hourOfWeek);
+}
+}  // namespace routing
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <optional>
+#include <vector>
+
+namespace routing
+{
+// Typical speeds of the feature directions of an mwm by the hour of the week. Speeds are kept as
+// percents of the maximum typical speed of the week of the feature direction, which is taken as
+// its free-flow speed. Feature directions with the same percents share a profile, so a feature
+// direction takes a few bytes of SPEED_PROFILES_FILE_TAG section.
+class SpeedProfiles final
+{
+public:
+  static uint16_t constexpr kLatestVersion = 0;
+  static size_t constexpr kHoursInWeek = 7 * 24;
+  // Typical speeds are not greater than the free-flow ones, so time-dependent weights are not less
+  // than the weights of the free-flow speeds and the routing heuristics are not broken.
+  static uint8_t constexpr kMaxPercent = 100;
+
+  // |Profile[h]| is the percent of the maximum speed of the week in hour |h| of the week. Hour 0 is
+  // the first hour of Sunday of the local time of the region.
+  using Profile = std::array<uint8_t, kHoursInWeek>;
+
+  struct Entry
+  {
+    Entry() = default;
+    Entry(uint32_t featureId, bool forward, uint32_t profileIdx)
+      : m_featureId(featureId), m_forward(forward), m_profileIdx(profileIdx)
+    {
+    }
+
+    uint32_t m_featureId = 0;
+    bool m_forward = true;
+    uint32_t m_profileIdx = 0;
+  };
+
+  SpeedProfiles() = default;
+  // Feature directions of |entries| should be different.
+  SpeedProfiles(std::vector<Profile> && profiles, std::vector<Entry> entries);
+
+  bool IsEmpty() const { return m_keys.empty(); }
+  std::vector<Profile> const & GetProfiles() const { return m_profiles; }
+  size_t GetEntriesNumber() const { return m_keys.size(); }
+
+  // Sets the standard (not daylight saving) UTC offset of the region of the mwm. Mwms have no
+  // daylight saving time rules, so the local time of the device is used when its standard offset
+  // is the same or when the offset of the region is not set.
+  void SetRegionUtcOffset(int32_t utcOffsetSeconds) { m_regionUtcOffset = utcOffsetSeconds; }
+
+  // Returns the ratio of the typical speed of the feature direction at |time| to its free-flow
+  // speed in (0, 1] or std::nullopt if there's no profile of the feature direction.
+  std::optional<double> GetSpeedFactor(uint32_t featureId, bool forward, time_t time) const;
+
+  // Returns the hour of the week of the local time of the region at |time|.
+  size_t GetRegionHourOfWeek(time_t time) const;
+
+  // Returns the hour of the week of |time| with |utcOffsetSeconds|.
+  static size_t GetHourOfWeek(time_t time, int64_t utcOffsetSeconds);
+  // Returns the hour of the week of the local time of the device at |time| with regard to
+  // the daylight saving time.
+  static size_t GetHourOfWeek(time_t time);
+
+  template <class Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, kLatestVersion);
+
+    WriteVarUint(sink, static_cast<uint32_t>(m_profiles.size()));
+    for (auto const & profile : m_profiles)
+      sink.Write(profile.data(), profile.size());
+
+    WriteVarUint(sink, static_cast<uint32_t>(m_keys.size()));
+    uint64_t prevKey = 0;
+    for (size_t i = 0; i < m_keys.size(); ++i)
+    {
+      WriteVarUint(sink, m_keys[i] - prevKey);
+      WriteVarUint(sink, m_profileIndices[i]);
+      prevKey = m_keys[i];
+    }
+  }
+
+  template <class Source>
+  void Deserialize(Source & src)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    CHECK_EQUAL(version, kLatestVersion, ("Unknown speed profiles version."));
+
+    m_profiles.resize(ReadVarUint<uint32_t>(src));
+    for (auto & profile : m_profiles)
+    {
+      src.Read(profile.data(), profile.size());
+      for (auto const percent : profile)
+      {
+        CHECK_GREATER(percent, 0, ());
+        CHECK_LESS_OR_EQUAL(percent, kMaxPercent, ());
+      }
+    }
+
+    auto const entriesNumber = ReadVarUint<uint32_t>(src);
+    m_keys.resize(entriesNumber);
+    m_profileIndices.resize(entriesNumber);
+    uint64_t key = 0;
+    for (size_t i = 0; i < entriesNumber; ++i)
+    {
+      key += ReadVarUint<uint64_t>(src);
+      m_keys[i] = key;
+      m_profileIndices[i] = ReadVarUint<uint32_t>(src);
+      CHECK_LESS(m_profileIndices[i], m_profiles.size(), ());
+    }
+  }
+
+private:
+  static uint64_t GetKey(uint32_t featureId, bool forward)
+  {
+    return (static_cast<uint64_t>(featureId) << 1) | (forward ? 0 : 1);
+  }
+
+  std::optional<int32_t> m_regionUtcOffset;
+  std::vector<Profile> m_profiles;
+  // Sorted keys of the feature directions and indices of their profiles in |m_profiles|.
+  std::vector<uint64_t> m_keys;
+  std::vector<uint32_t> m_profileIndices;
+};
+}  // namespace routing
@@ -141,7 +141,8 @@ RouteWeight TransitWorldGraph::CalcOffroadWeight(ms::LatLon const & from,
   return RouteWeight(m_estimator->CalcOffroad(from, to, purpose));
 }
 
-double TransitWorldGraph::CalculateETA(Segment const & from, Segment const & to)
+double TransitWorldGraph::CalculateETA(Segment const & from, Segment const & to,
+                                       double /* secondsToFrom */)
 {
   if (TransitGraph::IsTransitSegment(from))
     return CalcSegmentWeight(to, EdgeEstimator::Purpose::ETA).GetWeight();
@@ -67,6 +67,7 @@ NotificationManager NotificationManager::CreateNotificationManagerForTesting(
   notificationManager.m_settings.ForTestingSetNotificationTimeSecond(notificationTimeSecond);
   notificationManager.Reset();
   notificationManager.SetSpeedMetersPerSecond(speedMeterPerSecond);
+  notificationManager.UpdateTriggerDistances();
 
   return notificationManager;
 }
@@ -143,15 +144,14 @@ string NotificationManager::GenerateFirstTurnSound(TurnItem const & turn,
   bool const pedestrian = turn.m_pedestrianTurn != PedestrianDirection::None;
 
   uint32_t const distanceToPronounceNotificationM =
-      m_settings.ComputeDistToPronounceDistM(m_speedMetersPerSecond, pedestrian);
+      pedestrian ? m_distToPronouncePedestrianM : m_distToPronounceVehicleM;
 
   if (m_nextTurnNotificationProgress == PronouncedNotification::Nothing)
   {
     if (!m_settings.TooCloseForFisrtNotification(distanceToTurnMeters))
     {
       uint32_t const startPronounceDistMeters =
-          m_settings.ComputeTurnDistanceM(m_speedMetersPerSecond) +
-          distanceToPronounceNotificationM;
+          m_turnDistanceM + distanceToPronounceNotificationM;
       if (distanceToTurnMeters < startPronounceDistMeters)
       {
         if (m_turnNotificationWithThen)
@@ -219,14 +219,15 @@ void NotificationManager::SetLengthUnits(measurement_utils::Units units)
                         2000 /* maxNotificationDistanceUnits */,
                         GetSoundedDistMeters() /* soundedDistancesUnits */,
                         measurement_utils::Units::Metric /* lengthUnits */);
-    return;
+    break;
   case measurement_utils::Units::Imperial:
     m_settings.SetState(30 /* notificationTimeSeconds */, 500 /* minNotificationDistanceUnits */,
                         5000 /* maxNotificationDistanceUnits */,
                         GetSoundedDistFeet() /* soundedDistancesUnits */,
                         measurement_utils::Units::Imperial /* lengthUnits */);
-    return;
+    break;
   }
+  UpdateTriggerDistances();
 }
 
 void NotificationManager::SetSpeedMetersPerSecond(double speed)
@@ -234,7 +235,12 @@ void NotificationManager::SetSpeedMetersPerSecond(double speed)
   // When the quality of GPS data is bad the current speed may be less then zero.
   // It's easy to reproduce at an office with Nexus 5.
   // In that case zero meters per second is used.
-  m_speedMetersPerSecond = max(0., speed);
+  speed = max(0., speed);
+  if (speed == m_speedMetersPerSecond)
+    return;
+
+  m_speedMetersPerSecond = speed;
+  UpdateTriggerDistances();
 }
 
 void NotificationManager::Reset()
@@ -246,6 +252,19 @@ void NotificationManager::Reset()
   m_secondTurnNotificationIndex = 0;
 }
 
+void NotificationManager::UpdateTriggerDistances()
+{
+  // The settings are not valid until the length units are set.
+  if (!m_settings.IsValid())
+    return;
+
+  m_turnDistanceM = m_settings.ComputeTurnDistanceM(m_speedMetersPerSecond);
+  m_distToPronounceVehicleM =
+      m_settings.ComputeDistToPronounceDistM(m_speedMetersPerSecond, false /* pedestrian */);
+  m_distToPronouncePedestrianM =
+      m_settings.ComputeDistToPronounceDistM(m_speedMetersPerSecond, true /* pedestrian */);
+}
+
 void NotificationManager::FastForwardFirstTurnNotification()
 {
   m_turnNotificationWithThen = false;
@@ -275,9 +294,7 @@ CarDirection NotificationManager::GenerateSecondTurnNotification(vector<TurnItem
   if (distBetweenTurnsMeters > kMaxTurnDistM)
     return CarDirection::None;
 
-  uint32_t const startPronounceDistMeters =
-      m_settings.ComputeTurnDistanceM(m_speedMetersPerSecond) +
-      m_settings.ComputeDistToPronounceDistM(m_speedMetersPerSecond);
+  uint32_t const startPronounceDistMeters = m_turnDistanceM + m_distToPronounceVehicleM;
 
   if (firstTurn.m_distMeters <= startPronounceDistMeters)
   {
@@ -95,6 +95,9 @@ private:
   /// Generates turn sound notification for the nearest to the current position turn.
   std::string GenerateFirstTurnSound(TurnItem const & turn, double distanceToTurnMeters);
 
+  /// Recomputes the trigger distances which depend on the speed and the settings only.
+  void UpdateTriggerDistances();
+
   /// Changes the state of the class to emulate that first turn notification is pronounced
   /// without pronunciation.
   void FastForwardFirstTurnNotification();
@@ -121,6 +124,13 @@ private:
 
   Settings m_settings;
 
+  /// Distances to the turn in meters which trigger the notifications for the current speed.
+  /// They are updated when the speed or the length units are changed, so every location update
+  /// only compares the distance to the turn with them.
+  uint32_t m_turnDistanceM = 0;
+  uint32_t m_distToPronounceVehicleM = 0;
+  uint32_t m_distToPronouncePedestrianM = 0;
+
   /// m_nextTurnNotificationProgress keeps a status which is being changing while
   /// an end user is coming to the closest (the next) turn along the route.
   /// When an end user is far from the next turn
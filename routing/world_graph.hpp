@@ -91,7 +91,9 @@ public:
   virtual RouteWeight CalcOffroadWeight(ms::LatLon const & from, ms::LatLon const & to,
                                         EdgeEstimator::Purpose purpose) const = 0;
 
-  virtual double CalculateETA(Segment const & from, Segment const & to) = 0;
+  // Returns time in seconds to pass |to| from |from|. |secondsToFrom| is time from the route start
+  // to |from|. It's used to take into account time-dependent speeds.
+  virtual double CalculateETA(Segment const & from, Segment const & to, double secondsToFrom) = 0;
   virtual double CalculateETAWithoutPenalty(Segment const & segment) = 0;
 
   /// \returns transitions for mwm with id |numMwmId|.
@@ -10,6 +10,7 @@
 #include "base/math.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <sstream>
 
 using namespace routing;
@@ -28,6 +29,37 @@ InOutCitySpeedKMpH Max(InOutCitySpeedKMpH const & lhs, InOutCitySpeedKMpH const
   return {Pick<max>(lhs.m_inCity, rhs.m_inCity), Pick<max>(lhs.m_outCity, rhs.m_outCity)};
 }
 
+template <typename WeightAndETA>
+void PrintWeightAndETA(WeightAndETA const & value, ostringstream & oss)
+{
+  oss << value.m_weight << " " << value.m_eta << " ";
+}
+
+template <typename InOutCity>
+void PrintInOutCity(InOutCity const & value, ostringstream & oss)
+{
+  PrintWeightAndETA(value.m_inCity, oss);
+  PrintWeightAndETA(value.m_outCity, oss);
+}
+
+// Prints the values of |m| sorted by the keys.
+template <typename Map, typename PrintValue>
+void PrintSorted(Map const & m, PrintValue && printValue, ostringstream & oss)
+{
+  vector<typename Map::key_type> keys;
+  keys.reserve(m.size());
+  for (auto const & item : m)
+    keys.push_back(item.first);
+  sort(keys.begin(), keys.end());
+
+  for (auto const & key : keys)
+  {
+    oss << static_cast<uint64_t>(key) << ": ";
+    printValue(m.at(key));
+    oss << "; ";
+  }
+}
+
 HighwayType GetHighwayTypeKey(HighwayType type)
 {
   switch (type)
@@ -122,6 +154,45 @@ HighwayType VehicleModel::GetHighwayType(FeatureType & f) const
   return *ret;
 }
 
+string VehicleModel::GetParamsDescription() const
+{
+  ostringstream oss;
+  oss.precision(numeric_limits<double>::max_digits10);
+
+  oss << "Road types: ";
+  PrintSorted(m_roadTypes, [&oss](RoadType const & roadType) {
+    oss << static_cast<uint64_t>(roadType.GetHighwayType()) << " "
+        << roadType.IsPassThroughAllowed();
+  }, oss);
+
+  oss << "Surfaces: ";
+  for (auto const & surface : m_surfaceFactors)
+  {
+    oss << surface.m_type << ": ";
+    PrintWeightAndETA(surface.m_factor, oss);
+  }
+
+  oss << "Additional road types: ";
+  for (auto const & addRoadType : m_addRoadTypes)
+  {
+    oss << addRoadType.m_type << ": ";
+    PrintInOutCity(addRoadType.m_speed, oss);
+  }
+
+  oss << "Oneway: " << m_onewayType << " Max speed: ";
+  PrintInOutCity(m_maxModelSpeed, oss);
+  oss << "Offroad speed: ";
+  PrintWeightAndETA(GetOffroadSpeed(), oss);
+
+  oss << "Highway speeds: ";
+  PrintSorted(m_highwayBasedInfo.m_speeds,
+              [&oss](InOutCitySpeedKMpH const & speed) { PrintInOutCity(speed, oss); }, oss);
+  oss << "Highway factors: ";
+  PrintSorted(m_highwayBasedInfo.m_factors,
+              [&oss](InOutCityFactor const & factor) { PrintInOutCity(factor, oss); }, oss);
+  return oss.str();
+}
+
 double VehicleModel::GetMaxWeightSpeed() const
 {
   return max(m_maxModelSpeed.m_inCity.m_weight, m_maxModelSpeed.m_outCity.m_weight);
@@ -309,6 +309,10 @@ public:
     return false;
   }
 
+  /// \returns a text with the road types, the speeds and the factors of the model. It changes
+  /// when any of them changes, e.g. the generator caches data computed with the model by it.
+  std::string GetParamsDescription() const;
+
   bool EqualsForTests(VehicleModel const & rhs) const
   {
     return (m_roadTypes == rhs.m_roadTypes) && (m_addRoadTypes == rhs.m_addRoadTypes) &&
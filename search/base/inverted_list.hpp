@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <vector>
 
 namespace search_base
@@ -35,6 +36,29 @@ public:
     return true;
   }
 
+  // Adds sorted unique |ids| by a single merge. Adding of many ids one by one is quadratic
+  // when they go in random order.
+  void Add(std::vector<Id> const & ids)
+  {
+    ASSERT(std::is_sorted(ids.begin(), ids.end()), ());
+    std::vector<Id> merged;
+    merged.reserve(m_ids.size() + ids.size());
+    std::set_union(m_ids.begin(), m_ids.end(), ids.begin(), ids.end(),
+                   std::back_inserter(merged));
+    m_ids.swap(merged);
+  }
+
+  // Erases sorted unique |ids| by a single pass.
+  void Erase(std::vector<Id> const & ids)
+  {
+    ASSERT(std::is_sorted(ids.begin(), ids.end()), ());
+    std::vector<Id> rest;
+    rest.reserve(m_ids.size());
+    std::set_difference(m_ids.begin(), m_ids.end(), ids.begin(), ids.end(),
+                        std::back_inserter(rest));
+    m_ids.swap(rest);
+  }
+
   template <typename ToDo>
   void ForEach(ToDo && toDo) const
   {
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -39,6 +40,23 @@ public:
     ForEachToken(id, doc, [&](Token const & token) { m_trie.Erase(token, id); });
   }
 
+  // Adds many docs at once. Every posting list is changed only once, so it's much faster
+  // than adding of the docs one by one when there are thousands of them.
+  template <typename Doc>
+  void Add(std::vector<std::pair<Id, Doc>> const & docs)
+  {
+    for (auto const & tokenIds : GroupByTokens(docs))
+      m_trie.Add(tokenIds.first, tokenIds.second);
+  }
+
+  // Erases many docs at once, see Add().
+  template <typename Doc>
+  void Erase(std::vector<std::pair<Id, Doc>> const & docs)
+  {
+    for (auto const & tokenIds : GroupByTokens(docs))
+      m_trie.Erase(tokenIds.first, tokenIds.second);
+  }
+
   Iterator GetRootIterator() const { return Iterator(m_trie.GetRootIterator()); }
 
   std::vector<Id> GetAllIds() const
@@ -84,6 +102,21 @@ private:
     });
   }
 
+  // Returns sorted unique ids of |docs| for every token of them.
+  template <typename Doc>
+  std::map<Token, std::vector<Id>> GroupByTokens(std::vector<std::pair<Id, Doc>> const & docs)
+  {
+    std::map<Token, std::vector<Id>> tokenIds;
+    for (auto const & idDoc : docs)
+    {
+      ForEachToken(idDoc.first, idDoc.second,
+                   [&](Token const & token) { tokenIds[token].push_back(idDoc.first); });
+    }
+    for (auto & tokenIdsPair : tokenIds)
+      base::SortUnique(tokenIdsPair.second);
+    return tokenIds;
+  }
+
   template <typename Fn>
   static std::vector<Id> WithIds(Fn && fn)
   {
@@ -0,0 +1,147 @@
+#include "search/batch_search.hpp"
+
+#include "search/engine.hpp"
+#include "search/result.hpp"
+
+#include "storage/country_info_getter.hpp"
+
+#include "base/assert.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+namespace search
+{
+BatchSearch::BatchSearch(Engine & engine, storage::CountryInfoGetter const & infoGetter,
+                         Params const & params)
+  : m_engine(engine), m_infoGetter(infoGetter), m_params(params)
+{
+  CHECK_GREATER(m_params.m_windowSize, 0, ());
+  CHECK_GREATER(m_params.m_maxQueriesInFlight, 0, ());
+}
+
+void BatchSearch::Run(Source const & source, OnResults const & onResults)
+{
+  CHECK(source, ());
+  CHECK(onResults, ());
+
+  size_t index = 0;
+  bool hasMore = true;
+  while (hasMore)
+  {
+    {
+      unique_lock<mutex> lock(m_mu);
+      m_cv.wait(lock, [this]() {
+        return m_cancelled || m_queriesInFlight == 0 ||
+               m_queriesInFlight + m_params.m_windowSize <= m_params.m_maxQueriesInFlight;
+      });
+      if (m_cancelled)
+        break;
+    }
+
+    vector<SearchParams> window;
+    window.reserve(m_params.m_windowSize);
+    while (window.size() < m_params.m_windowSize)
+    {
+      SearchParams params;
+      if (!source(params))
+      {
+        hasMore = false;
+        break;
+      }
+
+      auto const i = index++;
+      params.m_onResults = [this, &onResults, i](Results const & results) {
+        // Intermediate results are not interesting for geocoding.
+        if (!results.IsEndMarker())
+          return;
+        onResults(i, results);
+        OnQueryDone();
+      };
+      window.push_back(move(params));
+    }
+
+    if (!window.empty())
+      Post(move(window));
+  }
+
+  unique_lock<mutex> lock(m_mu);
+  m_cv.wait(lock, [this]() { return m_queriesInFlight == 0; });
+}
+
+void BatchSearch::Cancel()
+{
+  lock_guard<mutex> lock(m_mu);
+  m_cancelled = true;
+  for (auto const & handle : m_handles)
+  {
+    if (auto h = handle.lock())
+      h->Cancel();
+  }
+  m_handles.clear();
+  m_cv.notify_all();
+}
+
+void BatchSearch::Post(vector<SearchParams> && window)
+{
+  // Queries are grouped by the regions where the user is or looks at.
+  vector<storage::CountryId> regions;
+  regions.reserve(window.size());
+  for (auto const & params : window)
+  {
+    auto const center = params.m_position ? *params.m_position : params.m_viewport.Center();
+    regions.push_back(m_infoGetter.GetRegionCountryId(center));
+  }
+
+  // Groups keep the order of the source.
+  vector<size_t> order(window.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  stable_sort(order.begin(), order.end(),
+              [&regions](size_t lhs, size_t rhs) { return regions[lhs] < regions[rhs]; });
+
+  {
+    lock_guard<mutex> lock(m_mu);
+    m_queriesInFlight += window.size();
+  }
+
+  for (size_t begin = 0; begin < order.size();)
+  {
+    size_t end = begin + 1;
+    while (end < order.size() && regions[order[end]] == regions[order[begin]])
+      ++end;
+
+    vector<SearchParams> group;
+    group.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i)
+      group.push_back(move(window[order[i]]));
+    begin = end;
+
+    auto handle = m_engine.SearchBatch(move(group));
+
+    lock_guard<mutex> lock(m_mu);
+    base::EraseIf(m_handles, [](weak_ptr<ProcessorHandle> const & h) { return h.expired(); });
+    if (m_cancelled)
+    {
+      if (auto h = handle.lock())
+        h->Cancel();
+    }
+    else
+    {
+      m_handles.push_back(move(handle));
+    }
+  }
+}
+
+void BatchSearch::OnQueryDone()
+{
+  lock_guard<mutex> lock(m_mu);
+  CHECK_GREATER(m_queriesInFlight, 0, ());
+  --m_queriesInFlight;
+  m_cv.notify_all();
+}
+}  // namespace search
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "search/search_params.hpp"
+
+#include "base/macros.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace storage
+{
+class CountryInfoGetter;
+}
+
+namespace search
+{
+class Engine;
+class ProcessorHandle;
+class Results;
+
+// Runs a large number of queries, e.g. the rows of an address list for offline geocoding,
+// on an Engine. The queries are read from a source by windows, the queries of a window are
+// grouped by the regions of their viewports and every group is posted as one batch, so the
+// queries of a region reuse the localities, pivot rects and streets cached by the geocoder
+// for the previous ones. The engine processes different groups on its threads in parallel.
+//
+// The source is not read further while too many queries are in flight, so the memory
+// does not depend on the number of queries.
+//
+// *NOTE* Run() and Cancel() may be called from different threads.
+class BatchSearch
+{
+public:
+  struct Params
+  {
+    // Number of queries which are read from the source and grouped at once.
+    size_t m_windowSize = 1024;
+    // Max number of queries which are posted to the engine and are not processed yet.
+    size_t m_maxQueriesInFlight = 4096;
+  };
+
+  // Fills |params| with the next query. Returns false when there are no more queries.
+  // |m_onResults| of the query is ignored.
+  using Source = std::function<bool(SearchParams & params)>;
+  // Receives the final results of the query with the index |index| in the source. It is
+  // called from the threads of the engine, not in the order of the source.
+  using OnResults = std::function<void(size_t index, Results const & results)>;
+
+  BatchSearch(Engine & engine, storage::CountryInfoGetter const & infoGetter,
+              Params const & params);
+
+  // Blocks until all queries of |source| are processed or the search is cancelled.
+  void Run(Source const & source, OnResults const & onResults);
+
+  // Stops reading of the source and cancels the queries in flight. Their results are
+  // passed to the callback with the cancelled end markers.
+  void Cancel();
+
+private:
+  void Post(std::vector<SearchParams> && window);
+  void OnQueryDone();
+
+  Engine & m_engine;
+  storage::CountryInfoGetter const & m_infoGetter;
+  Params const m_params;
+
+  std::mutex m_mu;
+  std::condition_variable m_cv;
+  size_t m_queriesInFlight = 0;
+  bool m_cancelled = false;
+  std::vector<std::weak_ptr<ProcessorHandle>> m_handles;
+
+  DISALLOW_COPY_AND_MOVE(BatchSearch);
+};
+}  // namespace search
@@ -8,12 +8,14 @@
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 #include "base/dfa_helpers.hpp"
+#include "base/executor.hpp"
 #include "base/levenshtein_dfa.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
 #include <algorithm>
 #include <cstddef>
+#include <future>
 
 using namespace std;
 
@@ -102,32 +104,66 @@ void Processor::EnableIndexingOfBookmarkGroup(GroupId const & groupId, bool enab
   if (wasIndexable == nowIndexable)
     return;
 
-  for (auto const & id : m_bookmarksInGroup[groupId])
-  {
-    if (nowIndexable)
-      AddToIndex(id);
-    else
-      EraseFromIndex(id);
-  }
+  auto const & ids = m_bookmarksInGroup[groupId];
+  vector<Id> const groupIds(ids.begin(), ids.end());
+  if (nowIndexable)
+    AddToIndex(groupIds);
+  else
+    EraseFromIndex(groupIds);
 }
 
 void Processor::Add(Id const & id, Doc const & doc)
 {
   ASSERT_EQUAL(m_docs.count(id), 0, ());
 
-  DocVec::Builder builder;
-  doc.ForEachNameToken(
-      [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
+  m_docs[id] = MakeDocVec(doc);
+}
 
-  if (m_indexDescriptions)
+void Processor::Add(vector<pair<Id, Doc>> const & marks)
+{
+  // Normalization of the names and descriptions takes most of the time, the docs are
+  // independent of each other.
+  vector<DocVec> docVecs(marks.size());
+  auto const makeDocVecs = [this, &marks, &docVecs](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      docVecs[i] = MakeDocVec(marks[i].second);
+  };
+
+  size_t constexpr kMinMarksPerTask = 256;
+  auto & executor = base::Executor::Instance();
+  size_t const tasksCount =
+      min(executor.GetThreadsCount(), max<size_t>(marks.size() / kMinMarksPerTask, 1));
+  if (tasksCount <= 1 || executor.IsWorkerThread())
   {
-    doc.ForEachDescriptionToken(
-        [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
+    makeDocVecs(0, marks.size());
   }
+  else
+  {
+    vector<future<void>> tasks;
+    size_t const step = (marks.size() + tasksCount - 1) / tasksCount;
+    for (size_t begin = 0; begin < marks.size(); begin += step)
+    {
+      auto const end = min(begin + step, marks.size());
+      auto task = executor.Submit(base::Executor::Priority::Search, makeDocVecs, begin, end);
+      if (task.valid())
+        tasks.push_back(move(task));
+      else
+        makeDocVecs(begin, end);
+    }
 
-  DocVec const docVec(builder);
+    // All the tasks must be finished before |docVecs| goes away, even when one of them throws.
+    for (auto & task : tasks)
+      task.wait();
+    for (auto & task : tasks)
+      task.get();
+  }
 
-  m_docs[id] = docVec;
+  m_docs.reserve(m_docs.size() + marks.size());
+  for (size_t i = 0; i < marks.size(); ++i)
+  {
+    ASSERT_EQUAL(m_docs.count(marks[i].first), 0, ());
+    m_docs[marks[i].first] = move(docVecs[i]);
+  }
 }
 
 void Processor::AddToIndex(Id const & id)
@@ -137,6 +173,20 @@ void Processor::AddToIndex(Id const & id)
   m_index.Add(id, DocVecWrapper(m_docs[id]));
 }
 
+void Processor::AddToIndex(vector<Id> const & ids)
+{
+  vector<pair<Id, DocVecWrapper>> docs;
+  docs.reserve(ids.size());
+  for (auto const & id : ids)
+  {
+    auto const it = m_docs.find(id);
+    ASSERT(it != m_docs.end(), (id));
+    if (it != m_docs.end())
+      docs.emplace_back(id, DocVecWrapper(it->second));
+  }
+  m_index.Add(docs);
+}
+
 void Processor::Update(Id const & id, Doc const & doc)
 {
   auto group = kInvalidGroupId;
@@ -173,43 +223,81 @@ void Processor::EraseFromIndex(Id const & id)
   m_index.Erase(id, DocVecWrapper(docVec));
 }
 
+void Processor::EraseFromIndex(vector<Id> const & ids)
+{
+  vector<pair<Id, DocVecWrapper>> docs;
+  docs.reserve(ids.size());
+  for (auto const & id : ids)
+  {
+    auto const it = m_docs.find(id);
+    ASSERT(it != m_docs.end(), (id));
+    if (it != m_docs.end())
+      docs.emplace_back(id, DocVecWrapper(it->second));
+  }
+  m_index.Erase(docs);
+}
+
 void Processor::AttachToGroup(Id const & id, GroupId const & group)
 {
-  auto const it = m_idToGroup.find(id);
-  if (it != m_idToGroup.end())
+  AttachToGroup(vector<Id>{id}, group);
+}
+
+void Processor::AttachToGroup(vector<Id> const & ids, GroupId const & group)
+{
+  auto & bookmarksInGroup = m_bookmarksInGroup[group];
+  for (auto const & id : ids)
   {
-    LOG(LWARNING, ("Tried to attach bookmark", id, "to group", group,
-                   "but it already belongs to group", it->second));
+    auto const it = m_idToGroup.find(id);
+    if (it != m_idToGroup.end())
+    {
+      LOG(LWARNING, ("Tried to attach bookmark", id, "to group", group,
+                     "but it already belongs to group", it->second));
+    }
+
+    m_idToGroup[id] = group;
+    bookmarksInGroup.insert(id);
   }
 
-  m_idToGroup[id] = group;
-  m_bookmarksInGroup[group].insert(id);
   if (m_indexableGroups.count(group) > 0)
-    AddToIndex(id);
+    AddToIndex(ids);
 }
 
 void Processor::DetachFromGroup(Id const & id, GroupId const & group)
 {
-  auto const it = m_idToGroup.find(id);
-  if (it == m_idToGroup.end())
-  {
-    LOG(LWARNING, ("Tried to detach bookmark", id, "from group", group,
-                   "but it does not belong to any group"));
-    return;
-  }
+  DetachFromGroup(vector<Id>{id}, group);
+}
 
-  if (it->second != group)
+void Processor::DetachFromGroup(vector<Id> const & ids, GroupId const & group)
+{
+  vector<Id> detached;
+  detached.reserve(ids.size());
+  for (auto const & id : ids)
   {
-    LOG(LWARNING, ("Tried to detach bookmark", id, "from group", group,
-                   "but it only belongs to group", it->second));
-    return;
+    auto const it = m_idToGroup.find(id);
+    if (it == m_idToGroup.end())
+    {
+      LOG(LWARNING, ("Tried to detach bookmark", id, "from group", group,
+                     "but it does not belong to any group"));
+      continue;
+    }
+
+    if (it->second != group)
+    {
+      LOG(LWARNING, ("Tried to detach bookmark", id, "from group", group,
+                     "but it only belongs to group", it->second));
+      continue;
+    }
+
+    m_idToGroup.erase(it);
+    m_bookmarksInGroup[group].erase(id);
+    detached.push_back(id);
   }
 
-  m_idToGroup.erase(it);
-  m_bookmarksInGroup[group].erase(id);
+  if (detached.empty())
+    return;
 
   if (m_indexableGroups.count(group) > 0)
-    EraseFromIndex(id);
+    EraseFromIndex(detached);
 
   auto const groupIt = m_bookmarksInGroup.find(group);
   CHECK(groupIt != m_bookmarksInGroup.end(), (group, m_bookmarksInGroup));
@@ -279,6 +367,21 @@ uint64_t Processor::GetNumDocs(strings::UniString const & token, bool isPrefix)
       m_index.GetNumDocs(StringUtf8Multilang::kDefaultCode, token, isPrefix));
 }
 
+DocVec Processor::MakeDocVec(Doc const & doc) const
+{
+  DocVec::Builder builder;
+  doc.ForEachNameToken(
+      [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
+
+  if (m_indexDescriptions)
+  {
+    doc.ForEachDescriptionToken(
+        [&](int8_t /* lang */, strings::UniString const & token) { builder.Add(token); });
+  }
+
+  return DocVec(builder);
+}
+
 QueryVec Processor::GetQueryVec(IdfMap & idfs, QueryParams const & params) const
 {
   QueryVec::Builder builder;
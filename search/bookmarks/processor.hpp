@@ -57,17 +57,25 @@ public:
 
   // Adds a bookmark to Processor but does not index it.
   void Add(Id const & id, Doc const & doc);
+  // Same as above but for many bookmarks at once, e.g. on loading of the imported KMLs.
+  // The docs are built in parallel.
+  void Add(std::vector<std::pair<Id, Doc>> const & marks);
   // Indexes an already added bookmark.
   void AddToIndex(Id const & id);
+  // Indexes already added bookmarks. Every posting list of the index is changed only once.
+  void AddToIndex(std::vector<Id> const & ids);
   // Updates a bookmark with a new |doc|. Re-indexes if the bookmarks
   // is already attached to an indexable group.
   void Update(Id const & id, Doc const & doc);
 
   void Erase(Id const & id);
   void EraseFromIndex(Id const & id);
+  void EraseFromIndex(std::vector<Id> const & ids);
 
   void AttachToGroup(Id const & id, GroupId const & group);
+  void AttachToGroup(std::vector<Id> const & ids, GroupId const & group);
   void DetachFromGroup(Id const & id, GroupId const & group);
+  void DetachFromGroup(std::vector<Id> const & ids, GroupId const & group);
 
   void Search(Params const & params) const;
 
@@ -93,6 +101,8 @@ private:
 
   QueryVec GetQueryVec(IdfMap & idfs, QueryParams const & params) const;
 
+  DocVec MakeDocVec(Doc const & doc) const;
+
   Emitter & m_emitter;
   base::Cancellable const & m_cancellable;
 
@@ -31,6 +31,14 @@ CBV CategoriesCache::Get(MwmContext const & context)
   return cbv;
 }
 
+uint64_t CategoriesCache::GetMemorySize() const
+{
+  uint64_t size = 0;
+  for (auto const & entry : m_cache)
+    size += entry.second.GetMemorySize();
+  return size;
+}
+
 CBV CategoriesCache::Load(MwmContext const & context) const
 {
   ASSERT(context.m_handle.IsAlive(), ());
@@ -6,9 +6,11 @@
 #include "indexer/mwm_set.hpp"
 
 #include "base/cancellable.hpp"
+#include "base/stl_helpers.hpp"
 
 #include <cstdint>
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace search
@@ -38,6 +40,16 @@ public:
 
   inline void Clear() { m_cache.clear(); }
 
+  // Drops the features of the mwms for which |pred| returns true.
+  template <typename Pred>
+  void ClearIf(Pred && pred)
+  {
+    base::EraseKeysIf(m_cache, std::forward<Pred>(pred));
+  }
+
+  // Approximate size of the cached features in bytes.
+  uint64_t GetMemorySize() const;
+
 private:
   CBV Load(MwmContext const & context) const;
 
@@ -0,0 +1,204 @@
+#include "search/category_cells_table.hpp"
+
+#include "indexer/cell_id.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <string>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+using Converter = CellIdConverter<mercator::Bounds, RectId>;
+
+m2::RectD GetCellRect(int64_t cell)
+{
+  double minX, minY, maxX, maxY;
+  Converter::GetCellBounds(RectId::FromInt64(cell, RectId::DEPTH_LEVELS), minX, minY, maxX, maxY);
+  return m2::RectD(minX, minY, maxX, maxY);
+}
+}  // namespace
+
+// CategoryCellsTable ------------------------------------------------------------------------------
+// static
+unique_ptr<CategoryCellsTable> CategoryCellsTable::Load(FilesContainerR const & cont)
+{
+  if (!cont.IsExist(CATEGORY_CELLS_FILE_TAG))
+    return {};
+
+  try
+  {
+    auto reader = cont.GetReader(CATEGORY_CELLS_FILE_TAG);
+    return Load(reader.GetPtr()->CreateSubReader(0, reader.Size()));
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read", CATEGORY_CELLS_FILE_TAG, "section of", cont.GetFileName(), ":",
+                   e.Msg()));
+  }
+  return {};
+}
+
+// static
+unique_ptr<CategoryCellsTable> CategoryCellsTable::Load(unique_ptr<Reader> reader)
+{
+  CHECK(reader, ());
+  NonOwningReaderSource source(*reader);
+
+  auto const version = static_cast<Version>(ReadPrimitiveFromSource<uint8_t>(source));
+  if (version > Version::Latest)
+  {
+    LOG(LWARNING, ("Unknown category cells table version:", static_cast<int>(version)));
+    return {};
+  }
+
+  auto table = make_unique<CategoryCellsTable>();
+  table->m_cellsDepth = ReadPrimitiveFromSource<uint8_t>(source);
+  auto const numTypes = ReadPrimitiveFromSource<uint32_t>(source);
+  table->m_index.reserve(numTypes);
+  for (uint32_t i = 0; i < numTypes; ++i)
+  {
+    auto const type = ReadPrimitiveFromSource<uint32_t>(source);
+    auto const offset = ReadPrimitiveFromSource<uint32_t>(source);
+    table->m_index.emplace_back(type, offset);
+  }
+  table->m_dataOffset = source.Pos();
+  table->m_reader = move(reader);
+  return table;
+}
+
+bool CategoryCellsTable::HasType(uint32_t type) const
+{
+  return binary_search(m_index.begin(), m_index.end(), make_pair(type, uint32_t{0}),
+                       [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+}
+
+vector<uint32_t> CategoryCellsTable::GetFeatures(uint32_t type, m2::RectD const & rect) const
+{
+  vector<uint32_t> features;
+  auto const it = lower_bound(m_index.begin(), m_index.end(), type,
+                              [](auto const & entry, uint32_t type) { return entry.first < type; });
+  if (it == m_index.end() || it->first != type)
+    return features;
+
+  auto const typeOffset = m_dataOffset + it->second;
+  NonOwningReaderSource source(*m_reader);
+  source.SetPosition(typeOffset);
+  auto const numCells = ReadPrimitiveFromSource<uint32_t>(source);
+
+  vector<uint32_t> offsets;
+  for (uint32_t i = 0; i < numCells; ++i)
+  {
+    auto const cell = ReadPrimitiveFromSource<int64_t>(source);
+    auto const offset = ReadPrimitiveFromSource<uint32_t>(source);
+    if (GetCellRect(cell).IsIntersect(rect))
+      offsets.push_back(offset);
+  }
+
+  for (auto const offset : offsets)
+  {
+    source.SetPosition(typeOffset + offset);
+    auto const count = ReadVarUint<uint32_t>(source);
+    uint32_t id = 0;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      id += ReadVarUint<uint32_t>(source);
+      features.push_back(id);
+    }
+  }
+
+  // A feature is in a single cell of a type, so the ids of the cells only need to be merged.
+  sort(features.begin(), features.end());
+  return features;
+}
+
+// CategoryCellsTableBuilder -----------------------------------------------------------------------
+CategoryCellsTableBuilder::CategoryCellsTableBuilder(uint8_t cellsDepth) : m_cellsDepth(cellsDepth)
+{
+  CHECK_GREATER(m_cellsDepth, 0, ());
+  CHECK_LESS_OR_EQUAL(m_cellsDepth, RectId::DEPTH_LEVELS, ());
+}
+
+void CategoryCellsTableBuilder::Put(uint32_t type, m2::PointD const & center, uint32_t featureId)
+{
+  auto const cell = Converter::ToCellId(center.x, center.y).AncestorAtLevel(m_cellsDepth - 1);
+  auto & features = m_features[type][cell.ToInt64(RectId::DEPTH_LEVELS)];
+  if (features.empty() || features.back() != featureId)
+    features.push_back(featureId);
+}
+
+void CategoryCellsTableBuilder::Freeze(Writer & writer) const
+{
+  vector<string> data;
+  data.reserve(m_features.size());
+  for (auto const & entry : m_features)
+  {
+    auto const & cells = entry.second;
+
+    string features;
+    MemWriter<string> featuresWriter(features);
+    vector<uint32_t> offsets;
+    offsets.reserve(cells.size());
+    auto const headerSize = base::checked_cast<uint32_t>(
+        sizeof(uint32_t) + cells.size() * (sizeof(int64_t) + sizeof(uint32_t)));
+    for (auto const & cell : cells)
+    {
+      auto ids = cell.second;
+      sort(ids.begin(), ids.end());
+      ids.erase(unique(ids.begin(), ids.end()), ids.end());
+
+      offsets.push_back(headerSize + base::checked_cast<uint32_t>(features.size()));
+      WriteVarUint(featuresWriter, base::checked_cast<uint32_t>(ids.size()));
+      uint32_t prev = 0;
+      for (auto const id : ids)
+      {
+        WriteVarUint(featuresWriter, id - prev);
+        prev = id;
+      }
+    }
+
+    string buffer;
+    MemWriter<string> dataWriter(buffer);
+    WriteToSink(dataWriter, base::checked_cast<uint32_t>(cells.size()));
+    size_t i = 0;
+    for (auto const & cell : cells)
+    {
+      WriteToSink(dataWriter, cell.first);
+      WriteToSink(dataWriter, offsets[i++]);
+    }
+    CHECK_EQUAL(buffer.size(), headerSize, ());
+    dataWriter.Write(features.data(), features.size());
+    data.push_back(move(buffer));
+  }
+
+  WriteToSink(writer, static_cast<uint8_t>(CategoryCellsTable::Version::Latest));
+  WriteToSink(writer, m_cellsDepth);
+  WriteToSink(writer, base::checked_cast<uint32_t>(m_features.size()));
+  size_t i = 0;
+  uint64_t offset = 0;
+  for (auto const & entry : m_features)
+  {
+    WriteToSink(writer, entry.first);
+    WriteToSink(writer, base::checked_cast<uint32_t>(offset));
+    offset += data[i++].size();
+  }
+  for (auto const & buffer : data)
+    writer.Write(buffer.data(), buffer.size());
+}
+}  // namespace search
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class FilesContainerR;
+class Reader;
+class Writer;
+
+namespace search
+{
+// Features of every category type of an mwm grouped by the cells of a fixed level of the
+// geometry index which contain their centers. The types are the ones the search index has
+// the category tokens for. A viewport category search reads the ids of the cells which
+// intersect the viewport instead of retrieving all the features of a type from the search
+// index and throwing away almost all of them by the viewport.
+//
+// Section format:
+//   u8 version
+//   u8 cells depth
+//   u32 number of types
+//   (u32 type, u32 offset of the cells of the type from the end of the index)...
+//   cells of the types
+// where the cells of a type are
+//   u32 number of cells
+//   (u64 cell, u32 offset of the features of the cell from the beginning of the type)...
+//   (varuint number of features, varuint first id, varuint deltas of the next ids...)...
+//
+// *NOTE* This class is not thread-safe.
+class CategoryCellsTable
+{
+public:
+  enum class Version : uint8_t
+  {
+    V0 = 0,
+    Latest = V0
+  };
+
+  // Returns nullptr if the mwm does not have the section.
+  static std::unique_ptr<CategoryCellsTable> Load(FilesContainerR const & cont);
+  static std::unique_ptr<CategoryCellsTable> Load(std::unique_ptr<Reader> reader);
+
+  bool HasType(uint32_t type) const;
+
+  // Returns sorted ids of the features of |type| from the cells which intersect |rect|.
+  // Features of the cells on the border of |rect| may lie outside of it.
+  std::vector<uint32_t> GetFeatures(uint32_t type, m2::RectD const & rect) const;
+
+  uint8_t GetCellsDepth() const { return m_cellsDepth; }
+
+private:
+  std::unique_ptr<Reader> m_reader;
+  uint8_t m_cellsDepth = 0;
+  // Types and offsets of their cells from |m_dataOffset|, sorted by types.
+  std::vector<std::pair<uint32_t, uint32_t>> m_index;
+  uint64_t m_dataOffset = 0;
+};
+
+class CategoryCellsTableBuilder
+{
+public:
+  // Cells of this depth are about 2.5km wide at the equator, a city viewport covers
+  // tens of them.
+  static uint8_t constexpr kDefaultCellsDepth = 15;
+
+  explicit CategoryCellsTableBuilder(uint8_t cellsDepth = kDefaultCellsDepth);
+
+  void Put(uint32_t type, m2::PointD const & center, uint32_t featureId);
+
+  void Freeze(Writer & writer) const;
+
+private:
+  uint8_t const m_cellsDepth;
+  // Type -> cell -> features.
+  std::map<uint32_t, std::map<int64_t, std::vector<uint32_t>>> m_features;
+
+  DISALLOW_COPY_AND_MOVE(CategoryCellsTableBuilder);
+};
+}  // namespace search
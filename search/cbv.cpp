@@ -75,6 +75,22 @@ uint64_t CBV::PopCount() const
   return m_p->PopCount();
 }
 
+uint64_t CBV::GetMemorySize() const
+{
+  if (IsFull() || IsEmpty())
+    return 0;
+
+  using coding::CompressedBitVector;
+  switch (m_p->GetStorageStrategy())
+  {
+  case CompressedBitVector::StorageStrategy::Dense:
+    return static_cast<coding::DenseCBV const &>(*m_p).NumBitGroups() * sizeof(uint64_t);
+  case CompressedBitVector::StorageStrategy::Sparse:
+    return m_p->PopCount() * sizeof(uint64_t);
+  }
+  UNREACHABLE();
+}
+
 CBV CBV::Union(CBV const & rhs) const
 {
   if (IsFull() || rhs.IsEmpty())
@@ -112,6 +128,13 @@ CBV CBV::Take(uint64_t n) const
   return CBV(m_p->LeaveFirstSetNBits(n));
 }
 
+CBV CBV::Clone() const
+{
+  if (IsEmpty() || IsFull())
+    return CBV(IsFull());
+  return CBV(m_p->Clone());
+}
+
 uint64_t CBV::Hash() const
 {
   if (IsEmpty())
@@ -37,6 +37,10 @@ public:
   bool HasBit(uint64_t id) const;
   uint64_t PopCount() const;
 
+  // Approximate size of the bit vector in bytes. The vectors shared by several CBVs are
+  // counted for every one of them.
+  uint64_t GetMemorySize() const;
+
   template <typename Fn>
   void ForEach(Fn && fn) const
   {
@@ -51,6 +55,11 @@ public:
   // Takes first set |n| bits.
   CBV Take(uint64_t n) const;
 
+  // Returns a deep copy that doesn't share the underlying bit vector
+  // with |*this|. Reference counting is not thread-safe, so a copy is
+  // needed to pass a CBV to another thread while keeping the original.
+  CBV Clone() const;
+
   uint64_t Hash() const;
 
 private:
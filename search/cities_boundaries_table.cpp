@@ -29,6 +29,17 @@ bool CitiesBoundariesTable::Boundaries::HasPoint(m2::PointD const & p) const
                 [&](CityBoundary const & b) { return b.HasPoint(p, m_eps); });
 }
 
+void CitiesBoundariesTable::Boundaries::HasPoints(vector<m2::PointD> const & points,
+                                                  vector<bool> & inside) const
+{
+  auto rect = m_limitRect;
+  rect.Inflate(m_eps, m_eps);
+
+  inside.assign(points.size(), false);
+  for (size_t i = 0; i < points.size(); ++i)
+    inside[i] = rect.IsPointInside(points[i]) && HasPoint(points[i]);
+}
+
 // CitiesBoundariesTable ---------------------------------------------------------------------------
 bool CitiesBoundariesTable::Load()
 {
@@ -80,6 +91,7 @@ bool CitiesBoundariesTable::Load()
 
   m_mwmId = context.GetId();
   m_table.clear();
+  m_tree.Clear();
   m_eps = precision;
   size_t boundary = 0;
   localities.ForEach([&](uint64_t fid) {
@@ -88,6 +100,15 @@ bool CitiesBoundariesTable::Load()
     ++boundary;
   });
   ASSERT_EQUAL(boundary, all.size(), ());
+
+  for (auto const & kv : m_table)
+  {
+    auto rect = Boundaries::CalcLimitRect(kv.second);
+    if (!rect.IsValid())
+      continue;
+    rect.Inflate(m_eps, m_eps);
+    m_tree.Add(IndexEntry{kv.first, &kv.second}, rect);
+  }
   return true;
 }
 
@@ -107,6 +128,14 @@ bool CitiesBoundariesTable::Get(uint32_t fid, Boundaries & bs) const
   return true;
 }
 
+void CitiesBoundariesTable::GetCitiesWithPoints(vector<m2::PointD> const & points,
+                                                vector<vector<uint32_t>> & cities) const
+{
+  cities.assign(points.size(), {});
+  for (size_t i = 0; i < points.size(); ++i)
+    ForEachCityWithPoint(points[i], [&](uint32_t fid) { cities[i].push_back(fid); });
+}
+
 void GetCityBoundariesInRectForTesting(CitiesBoundariesTable const & table, m2::RectD const & rect,
                                        vector<uint32_t> & featureIds)
 {
@@ -5,7 +5,9 @@
 
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
+#include "geometry/tree4d.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <sstream>
 #include <string>
@@ -30,12 +32,12 @@ public:
     Boundaries() = default;
 
     Boundaries(std::vector<indexer::CityBoundary> const & boundaries, double eps)
-      : m_boundaries(boundaries), m_eps(eps)
+      : m_boundaries(boundaries), m_eps(eps), m_limitRect(CalcLimitRect(m_boundaries))
     {
     }
 
     Boundaries(std::vector<indexer::CityBoundary> && boundaries, double eps)
-      : m_boundaries(std::move(boundaries)), m_eps(eps)
+      : m_boundaries(std::move(boundaries)), m_eps(eps), m_limitRect(CalcLimitRect(m_boundaries))
     {
     }
 
@@ -43,10 +45,15 @@ public:
     // |*this|.
     bool HasPoint(m2::PointD const & p) const;
 
-    m2::RectD GetLimitRect() const
+    // Sets |inside[i]| to HasPoint(|points[i]|) for all the points.
+    void HasPoints(std::vector<m2::PointD> const & points, std::vector<bool> & inside) const;
+
+    m2::RectD const & GetLimitRect() const { return m_limitRect; }
+
+    static m2::RectD CalcLimitRect(std::vector<indexer::CityBoundary> const & boundaries)
     {
       m2::RectD rect;
-      for (auto const & boundary : m_boundaries)
+      for (auto const & boundary : boundaries)
       {
         rect.Add(boundary.m_bbox.Min());
         rect.Add(boundary.m_bbox.Max());
@@ -69,6 +76,9 @@ public:
   private:
     std::vector<indexer::CityBoundary> m_boundaries;
     double m_eps = 0.0;
+    // Union of the bounding boxes of |m_boundaries|, the points outside of it are rejected
+    // without checking the boundaries.
+    m2::RectD m_limitRect;
   };
 
   explicit CitiesBoundariesTable(DataSource const & dataSource) : m_dataSource(dataSource) {}
@@ -83,10 +93,39 @@ public:
 
   size_t GetSize() const { return m_table.size(); }
 
+  /// \brief Calls |fn| with the ids of the features whose boundaries contain |p|. Only the
+  /// boundaries which bounding boxes contain |p| are checked.
+  template <typename Fn>
+  void ForEachCityWithPoint(m2::PointD const & p, Fn && fn) const
+  {
+    m_tree.ForEachInRect(m2::RectD(p, p), [&](IndexEntry const & entry) {
+      auto const & boundaries = *entry.m_boundaries;
+      if (std::any_of(boundaries.begin(), boundaries.end(),
+                      [&](indexer::CityBoundary const & b) { return b.HasPoint(p, m_eps); }))
+      {
+        fn(entry.m_fid);
+      }
+    });
+  }
+
+  /// \brief Fills |cities| with the ids of the features whose boundaries contain |points[i]|
+  /// for every point.
+  void GetCitiesWithPoints(std::vector<m2::PointD> const & points,
+                           std::vector<std::vector<uint32_t>> & cities) const;
+
 private:
+  struct IndexEntry
+  {
+    uint32_t m_fid = 0;
+    // Points to a value of |m_table|.
+    std::vector<indexer::CityBoundary> const * m_boundaries = nullptr;
+  };
+
   DataSource const & m_dataSource;
   MwmSet::MwmId m_mwmId;
   std::unordered_map<uint32_t, std::vector<indexer::CityBoundary>> m_table;
+  // Features from |m_table| by the limit rects of their boundaries inflated by |m_eps|.
+  m4::Tree<IndexEntry> m_tree;
   double m_eps = 0.0;
 };
 
@@ -0,0 +1,200 @@
+#include "search/completions_table.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+strings::UniString ReadString(NonOwningReaderSource & source)
+{
+  string s;
+  rw::Read(source, s);
+  return strings::MakeUniString(s);
+}
+
+void WriteString(Writer & writer, strings::UniString const & s)
+{
+  rw::Write(writer, strings::ToUtf8(s));
+}
+}  // namespace
+
+// CompletionsTable --------------------------------------------------------------------------------
+// static
+unique_ptr<CompletionsTable> CompletionsTable::Load(FilesContainerR const & cont)
+{
+  if (!cont.IsExist(COMPLETIONS_FILE_TAG))
+    return {};
+
+  try
+  {
+    auto reader = cont.GetReader(COMPLETIONS_FILE_TAG);
+    return Load(reader.GetPtr()->CreateSubReader(0, reader.Size()));
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read", COMPLETIONS_FILE_TAG, "section of", cont.GetFileName(), ":",
+                   e.Msg()));
+  }
+  return {};
+}
+
+// static
+unique_ptr<CompletionsTable> CompletionsTable::Load(unique_ptr<Reader> reader)
+{
+  CHECK(reader, ());
+  NonOwningReaderSource source(*reader);
+
+  auto const version = static_cast<Version>(ReadPrimitiveFromSource<uint8_t>(source));
+  if (version > Version::Latest)
+  {
+    LOG(LWARNING, ("Unknown completions table version:", static_cast<int>(version)));
+    return {};
+  }
+
+  auto table = make_unique<CompletionsTable>();
+  table->m_maxPrefixLength = ReadPrimitiveFromSource<uint8_t>(source);
+  auto const numPrefixes = ReadVarUint<uint64_t>(source);
+  table->m_index.reserve(numPrefixes);
+  uint64_t offset = 0;
+  for (uint64_t i = 0; i < numPrefixes; ++i)
+  {
+    auto prefix = ReadString(source);
+    offset += ReadVarUint<uint64_t>(source);
+    table->m_index.emplace_back(move(prefix), offset);
+  }
+  table->m_dataOffset = source.Pos();
+  table->m_reader = move(reader);
+  return table;
+}
+
+vector<CompletionsTable::Completion> CompletionsTable::Get(strings::UniString const & prefix) const
+{
+  vector<Completion> completions;
+  if (prefix.empty())
+    return completions;
+
+  strings::UniString const key(prefix.begin(),
+                               prefix.begin() + min<size_t>(prefix.size(), m_maxPrefixLength));
+  auto const it = lower_bound(m_index.begin(), m_index.end(), key,
+                              [](auto const & entry, auto const & key) { return entry.first < key; });
+  if (it == m_index.end() || it->first != key)
+    return completions;
+
+  NonOwningReaderSource source(*m_reader);
+  source.SetPosition(m_dataOffset + it->second);
+  auto const count = ReadVarUint<uint32_t>(source);
+  completions.reserve(count);
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    Completion completion;
+    completion.m_word = ReadString(source);
+    completion.m_weight = ReadVarUint<uint32_t>(source);
+    if (key.size() == prefix.size() || strings::StartsWith(completion.m_word, prefix))
+      completions.push_back(move(completion));
+  }
+  return completions;
+}
+
+// CompletionsTableBuilder -------------------------------------------------------------------------
+CompletionsTableBuilder::CompletionsTableBuilder(uint8_t maxPrefixLength, size_t maxCompletions)
+  : m_maxPrefixLength(maxPrefixLength), m_maxCompletions(maxCompletions)
+{
+  CHECK_GREATER(m_maxPrefixLength, 0, ());
+  CHECK_GREATER(m_maxCompletions, 0, ());
+}
+
+void CompletionsTableBuilder::Put(strings::UniString const & word, uint32_t weight)
+{
+  if (!word.empty())
+    m_weights[word] += weight;
+}
+
+void CompletionsTableBuilder::Freeze(Writer & writer) const
+{
+  using Candidate = pair<uint64_t, strings::UniString const *>;
+  // Heavier words go first, words of the same weight are ordered alphabetically.
+  auto const heavier = [](Candidate const & lhs, Candidate const & rhs) {
+    if (lhs.first != rhs.first)
+      return lhs.first > rhs.first;
+    return *lhs.second < *rhs.second;
+  };
+
+  map<strings::UniString, vector<Candidate>> candidates;
+  for (auto const & [word, weight] : m_weights)
+  {
+    auto const maxLength = min<size_t>(word.size(), m_maxPrefixLength);
+    for (size_t length = 1; length <= maxLength; ++length)
+    {
+      auto & top = candidates[strings::UniString(word.begin(), word.begin() + length)];
+      top.emplace_back(weight, &word);
+      // Keeps the vectors small without sorting them on every word.
+      if (top.size() >= 2 * m_maxCompletions)
+      {
+        nth_element(top.begin(), top.begin() + m_maxCompletions, top.end(), heavier);
+        top.resize(m_maxCompletions);
+      }
+    }
+  }
+
+  vector<string> data;
+  data.reserve(candidates.size());
+  for (auto & [prefix, top] : candidates)
+  {
+    sort(top.begin(), top.end(), heavier);
+    if (top.size() > m_maxCompletions)
+      top.resize(m_maxCompletions);
+
+    string buffer;
+    MemWriter<string> dataWriter(buffer);
+    WriteVarUint(dataWriter, base::checked_cast<uint32_t>(top.size()));
+    for (auto const & [weight, word] : top)
+    {
+      WriteString(dataWriter, *word);
+      WriteVarUint(dataWriter, static_cast<uint32_t>(
+                                   min<uint64_t>(weight, numeric_limits<uint32_t>::max())));
+    }
+    data.push_back(move(buffer));
+  }
+
+  WriteToSink(writer, static_cast<uint8_t>(CompletionsTable::Version::Latest));
+  WriteToSink(writer, m_maxPrefixLength);
+  WriteVarUint(writer, static_cast<uint64_t>(candidates.size()));
+  size_t i = 0;
+  uint64_t prevOffset = 0;
+  uint64_t offset = 0;
+  for (auto const & entry : candidates)
+  {
+    WriteString(writer, entry.first);
+    WriteVarUint(writer, offset - prevOffset);
+    prevOffset = offset;
+    offset += data[i++].size();
+  }
+  for (auto const & buffer : data)
+    writer.Write(buffer.data(), buffer.size());
+}
+
+string DebugPrint(CompletionsTable::Completion const & completion)
+{
+  ostringstream os;
+  os << "Completion [ " << strings::ToUtf8(completion.m_word) << ", " << completion.m_weight << " ]";
+  return os.str();
+}
+}  // namespace search
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "base/macros.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class FilesContainerR;
+class Reader;
+class Writer;
+
+namespace search
+{
+// The most frequent words of the names of the features of an mwm for every short prefix.
+// They are shown as instant suggestions while the first letters of a query are typed, before
+// the full search gets its results. The words are normalized in the same way as the search
+// index keys.
+//
+// Only the index of the prefixes is kept in memory, the completions are read on demand.
+//
+// *NOTE* This class is not thread-safe.
+class CompletionsTable
+{
+public:
+  struct Completion
+  {
+    Completion() = default;
+    Completion(strings::UniString const & word, uint32_t weight) : m_word(word), m_weight(weight)
+    {
+    }
+
+    bool operator==(Completion const & rhs) const
+    {
+      return m_word == rhs.m_word && m_weight == rhs.m_weight;
+    }
+
+    strings::UniString m_word;
+    uint32_t m_weight = 0;
+  };
+
+  enum class Version : uint8_t
+  {
+    V0 = 0,
+    Latest = V0
+  };
+
+  // Returns nullptr if the mwm does not have the section.
+  static std::unique_ptr<CompletionsTable> Load(FilesContainerR const & cont);
+  static std::unique_ptr<CompletionsTable> Load(std::unique_ptr<Reader> reader);
+
+  // Returns completions of |prefix| in the order of decreasing weight. Prefixes longer than
+  // the prefixes of the table are looked up by their beginnings, so only the completions of
+  // the beginning which still match |prefix| are returned for them.
+  std::vector<Completion> Get(strings::UniString const & prefix) const;
+
+  uint8_t GetMaxPrefixLength() const { return m_maxPrefixLength; }
+
+private:
+  std::unique_ptr<Reader> m_reader;
+  uint8_t m_maxPrefixLength = 0;
+  // Prefixes and offsets of their completions from |m_dataOffset|, sorted by prefixes.
+  std::vector<std::pair<strings::UniString, uint64_t>> m_index;
+  uint64_t m_dataOffset = 0;
+};
+
+class CompletionsTableBuilder
+{
+public:
+  static uint8_t constexpr kDefaultMaxPrefixLength = 3;
+  static size_t constexpr kDefaultMaxCompletions = 8;
+
+  explicit CompletionsTableBuilder(uint8_t maxPrefixLength = kDefaultMaxPrefixLength,
+                                   size_t maxCompletions = kDefaultMaxCompletions);
+
+  // Adds |weight| to the weight of |word|. |word| must be normalized.
+  void Put(strings::UniString const & word, uint32_t weight);
+
+  // Keeps at most |maxCompletions| heaviest words for every prefix which is not longer than
+  // |maxPrefixLength|.
+  void Freeze(Writer & writer) const;
+
+private:
+  uint8_t const m_maxPrefixLength;
+  size_t const m_maxCompletions;
+  std::map<strings::UniString, uint64_t> m_weights;
+
+  DISALLOW_COPY_AND_MOVE(CompletionsTableBuilder);
+};
+
+std::string DebugPrint(CompletionsTable::Completion const & completion);
+}  // namespace search
@@ -3,6 +3,7 @@
 #include "indexer/cuisines.hpp"
 #include "indexer/feature.hpp"
 #include "indexer/feature_meta.hpp"
+#include "indexer/feature_types_table.hpp"
 #include "indexer/ftypes_matcher.hpp"
 
 #include "platform/mwm_traits.hpp"
@@ -28,6 +29,16 @@ Description::Description(FeatureType & ft)
   });
 }
 
+Description::Description(vector<uint32_t> const & types)
+{
+  auto const & checker = ftypes::IsCuisineChecker::Instance();
+  for (auto const t : types)
+  {
+    if (checker(t))
+      m_types.push_back(t);
+  }
+}
+
 CuisineFilter::ScopedFilter::ScopedFilter(MwmSet::MwmId const & mwmId,
                                           Descriptions const & descriptions,
                                           vector<uint32_t> const & types)
@@ -82,6 +93,19 @@ CuisineFilter::Descriptions const & CuisineFilter::GetDescriptions(MwmContext co
 
   auto const food = m_food.Get(context);
   auto & descriptions = m_descriptions[mwmId];
+
+  // Types are read without decoding of the features when the mwm has the types table.
+  if (auto typesTable = indexer::FeatureTypesTable::Load(value.m_cont))
+  {
+    vector<uint32_t> types;
+    food.ForEach([&descriptions, &typesTable, &types](uint64_t bit) {
+      auto const id = base::asserted_cast<uint32_t>(bit);
+      if (typesTable->Get(id, types))
+        descriptions.emplace_back(id, Description(types));
+    });
+    return descriptions;
+  }
+
   food.ForEach([&descriptions, &context](uint64_t bit) {
     auto const id = base::asserted_cast<uint32_t>(bit);
     auto ft = context.GetFeature(id);
@@ -5,6 +5,8 @@
 
 #include "indexer/mwm_set.hpp"
 
+#include "base/stl_helpers.hpp"
+
 #include <map>
 #include <memory>
 #include <utility>
@@ -20,6 +22,7 @@ struct Description
 {
   Description() = default;
   Description(FeatureType & ft);
+  explicit Description(std::vector<uint32_t> const & types);
 
   std::vector<uint32_t> m_types;
 };
@@ -50,6 +53,13 @@ public:
 
   void ClearCaches();
 
+  // Drops the descriptions of the mwms for which |pred| returns true.
+  template <typename Pred>
+  void ClearCachesIf(Pred && pred)
+  {
+    base::EraseKeysIf(m_descriptions, std::forward<Pred>(pred));
+  }
+
 private:
   Descriptions const & GetDescriptions(MwmContext const & context);
 
@@ -0,0 +1,90 @@
+#include "search/downloader_name_index.hpp"
+
+#include "indexer/search_string_utils.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+strings::UniString Join(vector<strings::UniString>::const_iterator begin,
+                        vector<strings::UniString>::const_iterator end)
+{
+  strings::UniString result;
+  for (auto it = begin; it != end; ++it)
+  {
+    if (!result.empty())
+      result.push_back(' ');
+    result.append(it->begin(), it->end());
+  }
+  return result;
+}
+}  // namespace
+
+void DownloaderNameIndex::Clear()
+{
+  m_names.clear();
+  m_keys.clear();
+}
+
+void DownloaderNameIndex::Add(storage::CountryId const & countryId, string const & name)
+{
+  vector<strings::UniString> tokens;
+  NormalizeAndTokenizeString(name, tokens);
+  if (tokens.empty())
+    return;
+
+  auto const nameIdx = static_cast<uint32_t>(m_names.size());
+  m_names.push_back({countryId, name});
+  for (auto it = tokens.cbegin(); it != tokens.cend(); ++it)
+    m_keys.push_back({Join(it, tokens.cend()), nameIdx, it == tokens.cbegin()});
+}
+
+void DownloaderNameIndex::Build() { sort(m_keys.begin(), m_keys.end()); }
+
+void DownloaderNameIndex::Search(string const & query, size_t maxCount,
+                                 vector<storage::DownloaderSearchResult> & results) const
+{
+  ASSERT(is_sorted(m_keys.cbegin(), m_keys.cend()), ());
+
+  vector<strings::UniString> tokens;
+  NormalizeAndTokenizeString(query, tokens);
+  if (tokens.empty() || maxCount == 0)
+    return;
+
+  Key prefix;
+  prefix.m_key = Join(tokens.cbegin(), tokens.cend());
+
+  vector<Key const *> matched;
+  for (auto it = lower_bound(m_keys.cbegin(), m_keys.cend(), prefix);
+       it != m_keys.cend() && strings::StartsWith(it->m_key, prefix.m_key); ++it)
+  {
+    matched.push_back(&*it);
+  }
+
+  // The names starting with the query go first, shorter names go first.
+  stable_sort(matched.begin(), matched.end(), [](Key const * lhs, Key const * rhs) {
+    if (lhs->m_isNameStart != rhs->m_isNameStart)
+      return lhs->m_isNameStart;
+    return lhs->m_key.size() < rhs->m_key.size();
+  });
+
+  // Nodes of disputed territories may have several parents and may be added several times.
+  unordered_set<storage::CountryId> countryIds;
+  for (auto const * key : matched)
+  {
+    if (countryIds.size() == maxCount)
+      break;
+
+    auto const & name = m_names[key->m_nameIdx];
+    if (countryIds.insert(name.m_countryId).second)
+      results.emplace_back(name.m_countryId, name.m_name);
+  }
+}
+}  // namespace search
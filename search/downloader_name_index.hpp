@@ -0,0 +1,56 @@
+#pragma once
+
+#include "storage/downloader_search_params.hpp"
+#include "storage/storage_defines.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace search
+{
+// Prefix index over the localized names of the countries and the regions. It's used to give
+// the search results in downloader instantly, before the search over the map features.
+//
+// *NOTE* the class is NOT thread safe.
+class DownloaderNameIndex
+{
+public:
+  void Clear();
+
+  void Add(storage::CountryId const & countryId, std::string const & name);
+  // Should be called after all the names are added and before Search().
+  void Build();
+
+  bool IsEmpty() const { return m_names.empty(); }
+
+  // Appends to |results| no more than |maxCount| nodes whose names have a word starting with
+  // |query|. The nodes whose names start with |query| go first.
+  void Search(std::string const & query, size_t maxCount,
+              std::vector<storage::DownloaderSearchResult> & results) const;
+
+private:
+  struct Name
+  {
+    storage::CountryId m_countryId;
+    std::string m_name;
+  };
+
+  // Normalized suffix of a name which starts at a word.
+  struct Key
+  {
+    bool operator<(Key const & rhs) const { return m_key < rhs.m_key; }
+
+    strings::UniString m_key;
+    uint32_t m_nameIdx = 0;
+    bool m_isNameStart = false;
+  };
+
+  std::vector<Name> m_names;
+  // Sorted by |m_key|.
+  std::vector<Key> m_keys;
+};
+}  // namespace search
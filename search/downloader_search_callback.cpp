@@ -59,10 +59,18 @@ DownloaderSearchCallback::DownloaderSearchCallback(Delegate & delegate,
 {
 }
 
+void DownloaderSearchCallback::SetNamesResults(
+    std::vector<storage::DownloaderSearchResult> const & namesResults)
+{
+  m_namesResults = namesResults;
+}
+
 void DownloaderSearchCallback::operator()(search::Results const & results)
 {
   storage::DownloaderSearchResults downloaderSearchResults;
-  std::set<storage::DownloaderSearchResult> uniqueResults;
+  downloaderSearchResults.m_results = m_namesResults;
+  std::set<storage::DownloaderSearchResult> uniqueResults(m_namesResults.cbegin(),
+                                                          m_namesResults.cend());
 
   for (auto const & result : results)
   {
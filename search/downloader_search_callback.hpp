@@ -3,6 +3,7 @@
 #include "storage/downloader_search_params.hpp"
 
 #include <functional>
+#include <vector>
 
 class DataSource;
 
@@ -35,6 +36,10 @@ public:
                            storage::Storage const & storage,
                            storage::DownloaderSearchParams params);
 
+  // Sets the results found by the names of the countries and the regions. They go before
+  // the results of the search.
+  void SetNamesResults(std::vector<storage::DownloaderSearchResult> const & namesResults);
+
   void operator()(search::Results const & results);
 
 private:
@@ -43,5 +48,6 @@ private:
   storage::CountryInfoGetter const & m_infoGetter;
   storage::Storage const & m_storage;
   storage::DownloaderSearchParams m_params;
+  std::vector<storage::DownloaderSearchResult> m_namesResults;
 };
 }  // namespace search
@@ -8,6 +8,12 @@ namespace search
 {
 uint8_t DummyRankTable::Get(uint64_t /* i */) const { return 0; }
 
+void DummyRankTable::GetBatch(std::vector<uint32_t> const & ids,
+                              std::vector<uint8_t> & ranks) const
+{
+  ranks.assign(ids.size(), 0);
+}
+
 uint64_t DummyRankTable::Size() const
 {
   NOTIMPLEMENTED();
@@ -3,6 +3,7 @@
 #include "indexer/rank_table.hpp"
 
 #include <cstdint>
+#include <vector>
 
 namespace search
 {
@@ -14,6 +15,7 @@ class DummyRankTable : public RankTable
 public:
   // RankTable overrides:
   uint8_t Get(uint64_t i) const override;
+  void GetBatch(std::vector<uint32_t> const & ids, std::vector<uint8_t> & ranks) const override;
   uint64_t Size() const override;
   Version GetVersion() const override;
   void Serialize(Writer & /* writer */, bool /* preserveHostEndianness */) override;
@@ -7,6 +7,7 @@
 #include "indexer/categories_holder.hpp"
 #include "indexer/search_string_utils.hpp"
 
+#include "base/profiler.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/timer.hpp"
@@ -75,10 +76,13 @@ void ProcessorHandle::Detach()
 }
 
 // Engine::Params ----------------------------------------------------------------------------------
-Engine::Params::Params() : m_locale("en"), m_numThreads(1) {}
+Engine::Params::Params()
+  : m_locale("en"), m_numThreads(1), m_numRetrievalThreads(0), m_retrievalCacheSize(0)
+{
+}
 
 Engine::Params::Params(string const & locale, size_t numThreads)
-  : m_locale(locale), m_numThreads(numThreads)
+  : m_locale(locale), m_numThreads(numThreads), m_numRetrievalThreads(0), m_retrievalCacheSize(0)
 {
 }
 
@@ -91,10 +95,20 @@ Engine::Engine(DataSource & dataSource, CategoriesHolder const & categories,
   categories.ForEachName(bind<void>(ref(doInit), placeholders::_1));
   doInit.GetSuggests(m_suggests);
 
+  if (params.m_numRetrievalThreads != 0)
+  {
+    m_retrievalPool = make_unique<base::thread_pool::computational::ThreadPool>(
+        params.m_numRetrievalThreads);
+  }
+
+  if (params.m_retrievalCacheSize != 0)
+    m_retrievalCache = make_unique<RetrievalCache>(params.m_retrievalCacheSize);
+
   m_contexts.resize(params.m_numThreads);
   for (size_t i = 0; i < params.m_numThreads; ++i)
   {
-    auto processor = make_unique<Processor>(dataSource, categories, m_suggests, infoGetter);
+    auto processor = make_unique<Processor>(dataSource, categories, m_suggests, infoGetter,
+                                            m_retrievalPool.get(), m_retrievalCache.get());
     processor->SetPreferredLocale(params.m_locale);
     m_contexts[i].m_processor = move(processor);
   }
@@ -130,6 +144,16 @@ weak_ptr<ProcessorHandle> Engine::Search(SearchParams const & params)
   return handle;
 }
 
+weak_ptr<ProcessorHandle> Engine::SearchBatch(vector<SearchParams> queries)
+{
+  shared_ptr<ProcessorHandle> handle(new ProcessorHandle());
+  PostMessage(Message::TYPE_TASK, [this, queries = move(queries), handle](Processor & processor)
+              {
+                DoSearchBatch(queries, handle, processor);
+              });
+  return handle;
+}
+
 void Engine::SetLocale(string const & locale)
 {
   PostMessage(Message::TYPE_BROADCAST,
@@ -140,9 +164,16 @@ size_t Engine::GetNumThreads() const { return m_threads.size(); }
 
 void Engine::ClearCaches()
 {
+  if (m_retrievalCache)
+    m_retrievalCache->Clear();
   PostMessage(Message::TYPE_BROADCAST, [](Processor & processor) { processor.ClearCaches(); });
 }
 
+void Engine::OnMwmsChanged()
+{
+  PostMessage(Message::TYPE_BROADCAST, [](Processor & processor) { processor.OnMwmsChanged(); });
+}
+
 void Engine::CacheWorldLocalities()
 {
   PostMessage(Message::TYPE_BROADCAST,
@@ -218,6 +249,7 @@ void Engine::OnBookmarksDetachedFromGroup(bookmarks::GroupId const & groupId,
 
 void Engine::MainLoop(Context & context)
 {
+  base::profiler::SetThreadName("SearchEngine");
   while (true)
   {
     bool hasBroadcast = false;
@@ -297,4 +329,24 @@ void Engine::DoSearch(SearchParams const & params, shared_ptr<ProcessorHandle> h
 
   processor.Search(params);
 }
+
+void Engine::DoSearchBatch(vector<SearchParams> const & queries,
+                           shared_ptr<ProcessorHandle> handle, Processor & processor)
+{
+  LOG(LINFO, ("Batch search started. Queries:", queries.size()));
+  base::Timer timer;
+  SCOPE_GUARD(printDuration, [&timer]() {
+    LOG(LINFO, ("Batch search ended. Time:", timer.ElapsedSeconds(), "seconds."));
+  });
+
+  for (auto const & params : queries)
+  {
+    // Reset() drops the cancel signal of the previous query, Attach() restores it when
+    // the whole batch is cancelled.
+    processor.Reset();
+    handle->Attach(processor);
+    SCOPE_GUARD(detach, [&handle] { handle->Detach(); });
+    processor.Search(params);
+  }
+}
 }  // namespace search
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "search/bookmarks/processor.hpp"
+#include "search/retrieval_cache.hpp"
 #include "search/search_params.hpp"
 #include "search/suggest.hpp"
 
@@ -8,6 +9,7 @@
 
 #include "base/macros.hpp"
 #include "base/thread.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <condition_variable>
 #include <cstddef>
@@ -83,6 +85,18 @@ public:
     // to process queries. Use this field wisely as large values may
     // negatively affect performance due to false sharing.
     size_t m_numThreads;
+
+    // When non-zero, SearchEngine creates a pool of this many threads
+    // shared by all processors. The pool is used to retrieve posting
+    // lists of query tokens from several mwms in parallel, which
+    // reduces latency of everywhere-search over many mwms. Results
+    // are the same as with the single-threaded retrieval.
+    size_t m_numRetrievalThreads;
+
+    // When non-zero, SearchEngine keeps posting lists of this many
+    // (mwm, query token) pairs across queries. The cache is shared
+    // by all processors.
+    size_t m_retrievalCacheSize;
   };
 
   // Doesn't take ownership of dataSource and categories.
@@ -93,6 +107,13 @@ public:
   // Posts search request to the queue and returns its handle.
   std::weak_ptr<ProcessorHandle> Search(SearchParams const & params);
 
+  // Posts |queries| to the queue as a single request. The queries are processed one by one
+  // by the same processor, so they share the caches of its geocoder, which is faster than
+  // separate requests when the queries are close to each other. Cancelling the returned
+  // handle cancels all queries of the batch which are not processed yet, their |m_onResults|
+  // are still called with cancelled end markers.
+  std::weak_ptr<ProcessorHandle> SearchBatch(std::vector<SearchParams> queries);
+
   // Sets default locale on all query processors.
   void SetLocale(std::string const & locale);
 
@@ -102,6 +123,10 @@ public:
   // Posts request to clear caches to the queue.
   void ClearCaches();
 
+  // Posts request to drop the caches which are stale after registration or deregistration of
+  // mwms. Unlike ClearCaches() it keeps the caches of the mwms which are still registered.
+  void OnMwmsChanged();
+
   // Posts requests to load and cache localities from World.mwm.
   void CacheWorldLocalities();
 
@@ -171,6 +196,8 @@ private:
 
   void DoSearch(SearchParams const & params, std::shared_ptr<ProcessorHandle> handle,
                 Processor & processor);
+  void DoSearchBatch(std::vector<SearchParams> const & queries,
+                     std::shared_ptr<ProcessorHandle> handle, Processor & processor);
 
   std::vector<Suggest> m_suggests;
 
@@ -179,6 +206,11 @@ private:
   std::condition_variable m_cv;
 
   std::queue<Message> m_messages;
+
+  // Must outlive processors in |m_contexts|.
+  std::unique_ptr<base::thread_pool::computational::ThreadPool> m_retrievalPool;
+  std::unique_ptr<RetrievalCache> m_retrievalCache;
+
   std::vector<Context> m_contexts;
   std::vector<threads::SimpleThread> m_threads;
 };
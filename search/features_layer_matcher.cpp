@@ -39,6 +39,18 @@ void FeaturesLayerMatcher::SetContext(MwmContext * context)
 
   m_context = context;
   m_loader.SetContext(context);
+
+  m_streetHouses.reset();
+  auto const & mwmId = context->GetId();
+  auto const & editor = osm::Editor::Instance();
+  bool hasEdits = false;
+  for (auto const status : {FeatureStatus::Deleted, FeatureStatus::Obsolete,
+                            FeatureStatus::Modified, FeatureStatus::Created})
+  {
+    hasEdits = hasEdits || !editor.GetFeaturesByStatus(mwmId, status).empty();
+  }
+  if (!hasEdits)
+    m_streetHouses = StreetToHousesTable::Load(context->m_value);
 }
 
 void FeaturesLayerMatcher::SetPostcodes(CBV const * postcodes)
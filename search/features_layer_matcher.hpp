@@ -10,6 +10,7 @@
 #include "search/projection_on_street.hpp"
 #include "search/reverse_geocoder.hpp"
 #include "search/stats_cache.hpp"
+#include "search/street_to_houses_table.hpp"
 #include "search/street_vicinity_loader.hpp"
 
 #include "indexer/feature.hpp"
@@ -117,6 +118,11 @@ public:
 
   void OnQueryFinished();
 
+  // Returns id of a street feature corresponding to a |houseId|/|houseFeature|, or
+  // kInvalidId if there're not such street.
+  uint32_t GetMatchingStreet(uint32_t houseId);
+  uint32_t GetMatchingStreet(FeatureType & houseFeature);
+
 private:
   void BailIfCancelled() { ::search::BailIfCancelled(m_cancellable); }
 
@@ -334,6 +340,12 @@ private:
     std::vector<house_numbers::Token> queryParse;
     ParseQuery(child.m_subQuery, child.m_lastTokenIsPrefix, queryParse);
 
+    if (m_streetHouses)
+    {
+      MatchBuildingsWithStreetsByTable(child, parent, queryParse, fn);
+      return;
+    }
+
     uint32_t numFilterInvocations = 0;
     auto houseNumberFilter = [&](uint32_t houseId, uint32_t streetId,
                                  std::unique_ptr<FeatureType> & feature, bool & loaded) -> bool {
@@ -403,6 +415,63 @@ private:
     }
   }
 
+  // Same as the matching of the houses from the vicinities of the streets, but the houses of
+  // the streets and their house numbers are taken from the precomputed table.
+  template <typename Fn>
+  void MatchBuildingsWithStreetsByTable(FeaturesLayer const & child, FeaturesLayer const & parent,
+                                        std::vector<house_numbers::Token> const & queryParse,
+                                        Fn && fn)
+  {
+    ASSERT(m_streetHouses, ());
+    auto const & buildings = *child.m_sortedFeatures;
+    auto const & streets = *parent.m_sortedFeatures;
+
+    auto const houseNumberMatches = [&](uint32_t streetId,
+                                        StreetToHousesTable::House const & house) {
+      if (!child.m_hasDelayedFeatures || queryParse.empty())
+        return false;
+      if (m_postcodes && !m_postcodes->HasBit(house.m_id) && !m_postcodes->HasBit(streetId))
+        return false;
+      return house.m_key == queryParse[0] &&
+             house_numbers::HouseNumbersMatch(house.m_houseNumber, queryParse);
+    };
+
+    std::vector<uint32_t> matched;
+    for (uint32_t streetId : streets)
+    {
+      BailIfCancelled();
+
+      // Without the buildings from the child layer only the houses with the key of the query
+      // can match, they are found by the key.
+      if (buildings.empty())
+      {
+        if (queryParse.empty())
+          continue;
+        m_streetHouses->ForEachHouse(
+            streetId, queryParse[0], [&](StreetToHousesTable::House const & house) {
+              if (houseNumberMatches(streetId, house))
+                fn(house.m_id, streetId);
+            });
+        continue;
+      }
+
+      matched.clear();
+      for (auto const & house : m_streetHouses->Get(streetId))
+      {
+        if (std::binary_search(buildings.begin(), buildings.end(), house.m_id) ||
+            houseNumberMatches(streetId, house))
+        {
+          matched.push_back(house.m_id);
+        }
+      }
+
+      // A house is stored once for every key of its house number.
+      base::SortUnique(matched);
+      for (uint32_t houseId : matched)
+        fn(houseId, streetId);
+    }
+  }
+
   template <typename Fn>
   void MatchChildWithSuburbs(FeaturesLayer const & child, FeaturesLayer const & parent, Fn && fn)
   {
@@ -415,11 +484,6 @@ private:
       fn(feature, suburb);
   }
 
-  // Returns id of a street feature corresponding to a |houseId|/|houseFeature|, or
-  // kInvalidId if there're not such street.
-  uint32_t GetMatchingStreet(uint32_t houseId);
-  uint32_t GetMatchingStreet(FeatureType & houseFeature);
-
   using Street = ReverseGeocoder::Street;
   using Streets = std::vector<Street>;
 
@@ -441,6 +505,10 @@ private:
 
   CBV const * m_postcodes;
 
+  // Houses of the streets of the current mwm. It's not used when the mwm has edited features,
+  // because the table does not know about the edits.
+  std::unique_ptr<StreetToHousesTable> m_streetHouses;
+
   ReverseGeocoder m_reverseGeocoder;
 
   // Cache of streets in a feature's vicinity. All lists in the cache
@@ -1,5 +1,6 @@
 #include "search/geocoder.hpp"
 
+#include "search/category_cells_table.hpp"
 #include "search/cbv.hpp"
 #include "search/dummy_rank_table.hpp"
 #include "search/features_filter.hpp"
@@ -38,12 +39,16 @@
 #include "base/logging.hpp"
 #include "base/macros.hpp"
 #include "base/pprof.hpp"
+#include "base/profiler.hpp"
 #include "base/random.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <future>
 #include <iterator>
 #include <random>
 #include <sstream>
@@ -291,6 +296,93 @@ unique_ptr<MwmContext> GetWorldContext(DataSource const & dataSource)
   return {};
 }
 
+// Retrieves posting lists of the query tokens for a sequence of mwms on a thread pool,
+// ahead of the sequential geocoding loop. Idle pool workers pick up the next mwm from the
+// sequence, and at most |maxInFlight| mwms are retrieved in advance, so only a little
+// work is wasted when geocoding stops early.
+class RetrievalPrefetcher
+{
+public:
+  using Features = vector<Retrieval::ExtendedFeatures>;
+  using Fn = function<Features(MwmSet::MwmId const & id)>;
+
+  RetrievalPrefetcher(base::thread_pool::computational::ThreadPool & pool,
+                      vector<MwmSet::MwmId> && ids, size_t maxInFlight, Fn && fn)
+    : m_pool(pool), m_ids(move(ids)), m_maxInFlight(max<size_t>(maxInFlight, 1)), m_fn(move(fn))
+  {
+    m_results.resize(m_ids.size());
+    Refill();
+  }
+
+  ~RetrievalPrefetcher()
+  {
+    m_stopped = true;
+    for (size_t i = m_next; i < m_submitted; ++i)
+    {
+      if (m_results[i].valid())
+        m_results[i].wait();
+    }
+  }
+
+  // Returns posting lists for |id|. Mwms must be requested in the order they were
+  // passed to the constructor, though some of them may be skipped. Returns std::nullopt
+  // when |id| is unknown or its posting lists were not retrieved. Rethrows exceptions
+  // (e.g. CancelException) thrown during retrieval.
+  optional<Features> Get(MwmSet::MwmId const & id)
+  {
+    while (m_next < m_ids.size() && m_ids[m_next] != id)
+    {
+      Wait(m_next++);
+      Refill();
+    }
+
+    if (m_next == m_ids.size())
+      return {};
+
+    auto result = Wait(m_next++);
+    Refill();
+    return result;
+  }
+
+private:
+  void Refill()
+  {
+    while (m_submitted < m_ids.size() && m_submitted < m_next + m_maxInFlight)
+    {
+      auto const & id = m_ids[m_submitted];
+      m_results[m_submitted] = m_pool.Submit([this, id]() -> Features {
+        if (m_stopped)
+          return {};
+        return m_fn(id);
+      });
+      ++m_submitted;
+    }
+  }
+
+  optional<Features> Wait(size_t i)
+  {
+    auto & result = m_results[i];
+    // An invalid future means that the pool is stopped and the task was dropped.
+    if (!result.valid())
+      return {};
+
+    auto features = result.get();
+    if (features.empty())
+      return {};
+    return features;
+  }
+
+  base::thread_pool::computational::ThreadPool & m_pool;
+  vector<MwmSet::MwmId> const m_ids;
+  size_t const m_maxInFlight;
+  Fn const m_fn;
+
+  vector<future<Features>> m_results;
+  size_t m_next = 0;
+  size_t m_submitted = 0;
+  atomic<bool> m_stopped{false};
+};
+
 #define TRACE(branch)                                      \
   m_resultTracer.CallMethod(ResultTracer::Branch::branch); \
   SCOPE_GUARD(tracerGuard, [&] { m_resultTracer.LeaveMethod(ResultTracer::Branch::branch); });
@@ -322,11 +414,19 @@ void Geocoder::LocalitiesCaches::Clear()
   m_villages.Clear();
 }
 
+uint64_t Geocoder::LocalitiesCaches::GetMemorySize() const
+{
+  return m_countries.GetMemorySize() + m_states.GetMemorySize() +
+         m_citiesTownsOrVillages.GetMemorySize() + m_villages.GetMemorySize();
+}
+
 // Geocoder::Geocoder ------------------------------------------------------------------------------
 Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
                    CategoriesHolder const & categories,
                    CitiesBoundariesTable const & citiesBoundaries, PreRanker & preRanker,
-                   LocalitiesCaches & localitiesCaches, base::Cancellable const & cancellable)
+                   LocalitiesCaches & localitiesCaches, base::Cancellable const & cancellable,
+                   base::thread_pool::computational::ThreadPool * retrievalPool,
+                   RetrievalCache * retrievalCache)
   : m_dataSource(dataSource)
   , m_infoGetter(infoGetter)
   , m_categories(categories)
@@ -338,6 +438,8 @@ Geocoder::Geocoder(DataSource const & dataSource, storage::CountryInfoGetter con
   , m_hotelsFilter(m_hotelsCache)
   , m_cuisineFilter(m_foodCache)
   , m_cancellable(cancellable)
+  , m_retrievalPool(retrievalPool)
+  , m_retrievalCache(retrievalCache)
   , m_citiesBoundaries(citiesBoundaries)
   , m_pivotRectsCache(kPivotRectsCacheSize, m_cancellable, kMaxViewportRadiusM)
   , m_postcodesRectsCache(kPostcodesRectsCacheSize, m_cancellable, kMaxPostcodeRadiusM)
@@ -449,6 +551,31 @@ void Geocoder::ClearCaches()
   m_postcodes.Clear();
 }
 
+void Geocoder::ClearCaches(function<bool(MwmSet::MwmId const &)> const & pred)
+{
+  m_pivotRectsCache.ClearIf(pred);
+  m_postcodesRectsCache.ClearIf(pred);
+  m_suburbsRectsCache.ClearIf(pred);
+  m_localityRectsCache.ClearIf(pred);
+
+  base::EraseKeysIf(m_matchersCache, pred);
+  m_streetsCache.ClearIf(pred);
+  m_suburbsCache.ClearIf(pred);
+  m_hotelsCache.ClearIf(pred);
+  m_foodCache.ClearIf(pred);
+  m_hotelsFilter.ClearCachesIf(pred);
+  m_cuisineFilter.ClearCachesIf(pred);
+  m_postcodePointsCache.ClearIf(pred);
+}
+
+uint64_t Geocoder::GetCachesMemorySize() const
+{
+  return m_pivotRectsCache.GetMemorySize() + m_postcodesRectsCache.GetMemorySize() +
+         m_suburbsRectsCache.GetMemorySize() + m_localityRectsCache.GetMemorySize() +
+         m_streetsCache.GetMemorySize() + m_suburbsCache.GetMemorySize() +
+         m_hotelsCache.GetMemorySize() + m_foodCache.GetMemorySize();
+}
+
 void Geocoder::SetParamsForCategorialSearch(Params const & params)
 {
   m_params = params;
@@ -527,6 +654,8 @@ Geocoder::ExtendedMwmInfos Geocoder::OrderCountries(bool inViewport,
 
 void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> const & infos, bool inViewport)
 {
+  PROFILER_SCOPE("Geocoder::GoImpl");
+  QueryStats::ScopedPhase phase(m_params.m_stats.get(), QueryStats::Phase::Geocoding);
   // base::PProf pprof("/tmp/geocoder.prof");
 
   // Tries to find world and fill localities table.
@@ -568,6 +697,28 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> const & infos, bool inViewport
   // found.
   auto const infosWithType = OrderCountries(inViewport, infos);
 
+  unique_ptr<RetrievalPrefetcher> prefetcher;
+  if (m_retrievalPool)
+  {
+    vector<MwmSet::MwmId> ids;
+    ids.reserve(infosWithType.m_infos.size());
+    for (auto const & info : infosWithType.m_infos)
+      ids.emplace_back(info.m_info);
+
+    // Each worker retrieves from its own handle, because mwm values are not thread-safe.
+    prefetcher = make_unique<RetrievalPrefetcher>(
+        *m_retrievalPool, move(ids), 2 * m_retrievalPool->Size() /* maxInFlight */,
+        [this](MwmSet::MwmId const & id) -> RetrievalPrefetcher::Features {
+          auto handle = m_dataSource.GetMwmHandleById(id);
+          if (!handle.IsAlive())
+            return {};
+          auto const & value = *handle.GetValue();
+          if (!value.HasSearchIndex() || !value.HasGeometryIndex())
+            return {};
+          return RetrieveTokensFeatures(MwmContext(move(handle)));
+        });
+  }
+
   // MatchAroundPivot() should always be matched in mwms
   // intersecting with position and viewport.
   auto processCountry = [&](unique_ptr<MwmContext> context, bool updatePreranker) {
@@ -593,7 +744,13 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> const & infos, bool inViewport
     m_matcher->SetContext(m_context.get());
 
     BaseContext ctx;
-    InitBaseContext(ctx);
+    optional<RetrievalPrefetcher::Features> features;
+    if (prefetcher)
+    {
+      QueryStats::ScopedPhase phase(m_params.m_stats.get(), QueryStats::Phase::Retrieval);
+      features = prefetcher->Get(m_context->GetId());
+    }
+    InitBaseContext(ctx, features ? &*features : nullptr);
 
     if (inViewport)
     {
@@ -630,6 +787,8 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> const & infos, bool inViewport
 
     if (updatePreranker)
       m_preRanker.UpdateResults(false /* lastUpdate */);
+    else
+      m_preRanker.UpdateFirstResult();
 
     if (m_preRanker.IsFull())
       return base::ControlFlow::Break;
@@ -641,30 +800,109 @@ void Geocoder::GoImpl(vector<shared_ptr<MwmInfo>> const & infos, bool inViewport
   ForEachCountry(infosWithType, processCountry);
 }
 
-void Geocoder::InitBaseContext(BaseContext & ctx)
+vector<Retrieval::ExtendedFeatures> Geocoder::RetrieveTokensFeatures(
+    MwmContext const & context) const
 {
-  Retrieval retrieval(*m_context, m_cancellable);
+  Retrieval retrieval(context, m_cancellable);
 
-  ctx.m_tokens.assign(m_params.GetNumTokens(), BaseContext::TOKEN_TYPE_COUNT);
-  ctx.m_numTokens = m_params.GetNumTokens();
-  ctx.m_features.resize(ctx.m_numTokens);
-  for (size_t i = 0; i < ctx.m_features.size(); ++i)
+  vector<Retrieval::ExtendedFeatures> features(m_params.GetNumTokens());
+
+  // The viewport features are not cached, the cache keys of the categories ignore the viewport.
+  if (m_params.IsCategorialRequest() && m_params.m_mode == Mode::Viewport)
   {
+    if (auto const cbv = RetrieveCategoriesInViewport(context))
+    {
+      for (auto & tokenFeatures : features)
+        tokenFeatures = Retrieval::ExtendedFeatures(*cbv);
+      return features;
+    }
+  }
+
+  for (size_t i = 0; i < features.size(); ++i)
+  {
+    string cacheKey;
+    if (m_retrievalCache)
+    {
+      if (m_params.IsCategorialRequest())
+      {
+        cacheKey = RetrievalCache::MakeCategoriesKey(m_params.m_preferredTypes);
+      }
+      else
+      {
+        cacheKey = RetrievalCache::MakeTokenKey(m_params.GetToken(i), m_params.IsPrefixToken(i),
+                                                m_params.GetTypeIndices(i), m_params.GetLangs());
+      }
+
+      if (m_retrievalCache->Get(context.GetId(), cacheKey, features[i]))
+        continue;
+    }
+
     if (m_params.IsCategorialRequest())
     {
       // Implementation-wise, the simplest way to match a feature by
       // its category bypassing the matching by name is by using a CategoriesCache.
       CategoriesCache cache(m_params.m_preferredTypes, m_cancellable);
-      ctx.m_features[i] = Retrieval::ExtendedFeatures(cache.Get(*m_context));
+      features[i] = Retrieval::ExtendedFeatures(cache.Get(context));
     }
     else if (m_params.IsPrefixToken(i))
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
+      features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
     }
     else
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
+      features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
     }
+
+    if (m_retrievalCache)
+      m_retrievalCache->Put(context.GetId(), cacheKey, features[i]);
+  }
+  return features;
+}
+
+optional<CBV> Geocoder::RetrieveCategoriesInViewport(MwmContext const & context) const
+{
+  // The table is not kept between the calls because the retrieval threads call it concurrently.
+  auto const table = CategoryCellsTable::Load(context.m_value.m_cont);
+  if (!table)
+    return {};
+
+  auto const & c = classif();
+  vector<uint64_t> ids;
+  // The preferred types are usually truncated, the table has their descendants.
+  for (auto const type : m_params.m_preferredTypes)
+  {
+    c.ForEachInSubtree(
+        [&](uint32_t descendantType) {
+          if (!table->HasType(descendantType))
+            return;
+          for (auto const id : table->GetFeatures(descendantType, m_params.m_pivot))
+            ids.push_back(id);
+        },
+        type);
+  }
+  base::SortUnique(ids);
+  return CBV(coding::CompressedBitVectorBuilder::FromBitPositions(move(ids)));
+}
+
+void Geocoder::InitBaseContext(BaseContext & ctx, vector<Retrieval::ExtendedFeatures> * features)
+{
+  ctx.m_tokens.assign(m_params.GetNumTokens(), BaseContext::TOKEN_TYPE_COUNT);
+  ctx.m_numTokens = m_params.GetNumTokens();
+  if (features)
+  {
+    ASSERT_EQUAL(features->size(), ctx.m_numTokens, ());
+    ctx.m_features = move(*features);
+  }
+  else
+  {
+    QueryStats::ScopedPhase phase(m_params.m_stats.get(), QueryStats::Phase::Retrieval);
+    ctx.m_features = RetrieveTokensFeatures(*m_context);
+  }
+
+  if (m_params.m_stats)
+  {
+    for (auto const & tokenFeatures : ctx.m_features)
+      m_params.m_stats->AddRetrievedFeatures(tokenFeatures.m_features.PopCount());
   }
 
   ctx.m_hotelsFilter = m_hotelsFilter.MakeScopedFilter(*m_context, m_params.m_hotelsFilter);
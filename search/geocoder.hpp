@@ -19,7 +19,10 @@
 #include "search/postcode_points.hpp"
 #include "search/pre_ranking_info.hpp"
 #include "search/query_params.hpp"
+#include "search/query_stats.hpp"
 #include "search/ranking_utils.hpp"
+#include "search/retrieval.hpp"
+#include "search/retrieval_cache.hpp"
 #include "search/streets_matcher.hpp"
 #include "search/token_range.hpp"
 #include "search/tracer.hpp"
@@ -41,6 +44,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <map>
 #include <memory>
@@ -52,6 +56,17 @@ class CategoriesHolder;
 class DataSource;
 class MwmValue;
 
+namespace base
+{
+namespace thread_pool
+{
+namespace computational
+{
+class ThreadPool;
+}  // namespace computational
+}  // namespace thread_pool
+}  // namespace base
+
 namespace storage
 {
 class CountryInfoGetter;
@@ -92,6 +107,7 @@ public:
     std::vector<uint32_t> m_cuisineTypes;
     std::vector<uint32_t> m_preferredTypes;
     std::shared_ptr<Tracer> m_tracer;
+    std::shared_ptr<QueryStats> m_stats;
     double m_streetSearchRadiusM = 0.0;
     double m_villageSearchRadiusM = 0.0;
     int m_scale = scales::GetUpperScale();
@@ -102,16 +118,34 @@ public:
     LocalitiesCaches(base::Cancellable const & cancellable);
     void Clear();
 
+    template <typename Pred>
+    void ClearIf(Pred && pred)
+    {
+      m_countries.ClearIf(pred);
+      m_states.ClearIf(pred);
+      m_citiesTownsOrVillages.ClearIf(pred);
+      m_villages.ClearIf(pred);
+    }
+
+    uint64_t GetMemorySize() const;
+
     CountriesCache m_countries;
     StatesCache m_states;
     CitiesTownsOrVillagesCache m_citiesTownsOrVillages;
     VillagesCache m_villages;
   };
 
+  // When |retrievalPool| is not null, posting lists of the query tokens are retrieved
+  // from several mwms in parallel ahead of the geocoding loop. The geocoding loop itself
+  // stays sequential, so the results are the same as without the pool.
+  // When |retrievalCache| is not null, posting lists of the query tokens are looked up
+  // there before walking the search index, and retrieved posting lists are stored there.
   Geocoder(DataSource const & dataSource, storage::CountryInfoGetter const & infoGetter,
            CategoriesHolder const & categories, CitiesBoundariesTable const & citiesBoundaries,
            PreRanker & preRanker, LocalitiesCaches & localitiesCaches,
-           base::Cancellable const & cancellable);
+           base::Cancellable const & cancellable,
+           base::thread_pool::computational::ThreadPool * retrievalPool = nullptr,
+           RetrievalCache * retrievalCache = nullptr);
   ~Geocoder();
 
   // Sets search query params.
@@ -138,6 +172,13 @@ public:
   void CacheWorldLocalities();
   void ClearCaches();
 
+  // Drops the caches of the mwms for which |pred| returns true. The caches of the other mwms
+  // are kept across the queries.
+  void ClearCaches(std::function<bool(MwmSet::MwmId const &)> const & pred);
+
+  // Approximate size of the features cached by the geocoder in bytes.
+  uint64_t GetCachesMemorySize() const;
+
 private:
   enum class RectId
   {
@@ -197,9 +238,21 @@ private:
 
   QueryParams::Token const & GetTokens(size_t i) const;
 
+  // Retrieves posting lists corresponding to features in |context| for each token.
+  // Touches only immutable state of the geocoder, so it may be called concurrently
+  // for different mwms.
+  std::vector<Retrieval::ExtendedFeatures> RetrieveTokensFeatures(
+      MwmContext const & context) const;
+
+  // Retrieves the features of the categorial request from the cells of the category cells
+  // table of |context| which intersect the viewport. Returns nullopt when the mwm has no table.
+  std::optional<CBV> RetrieveCategoriesInViewport(MwmContext const & context) const;
+
   // Creates a cache of posting lists corresponding to features in m_context
-  // for each token and saves it to m_addressFeatures.
-  void InitBaseContext(BaseContext & ctx);
+  // for each token and saves it to m_addressFeatures. When |features| is not null,
+  // it must contain already retrieved posting lists for m_context.
+  void InitBaseContext(BaseContext & ctx,
+                       std::vector<Retrieval::ExtendedFeatures> * features = nullptr);
 
   void InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer);
 
@@ -326,6 +379,12 @@ private:
 
   base::Cancellable const & m_cancellable;
 
+  // Not owned, may be null.
+  base::thread_pool::computational::ThreadPool * m_retrievalPool;
+
+  // Not owned, may be null.
+  RetrievalCache * m_retrievalCache;
+
   // Geocoder params.
   Params m_params;
 
@@ -17,6 +17,17 @@ GeometryCache::GeometryCache(size_t maxNumEntries, base::Cancellable const & can
   CHECK_GREATER(m_maxNumEntries, 0, ());
 }
 
+uint64_t GeometryCache::GetMemorySize() const
+{
+  uint64_t size = 0;
+  for (auto const & entries : m_entries)
+  {
+    for (auto const & entry : entries.second)
+      size += entry.m_cbv.GetMemorySize();
+  }
+  return size;
+}
+
 void GeometryCache::InitEntry(MwmContext const & context, m2::RectD const & rect, int scale,
                               Entry & entry)
 {
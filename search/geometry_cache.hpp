@@ -7,6 +7,7 @@
 #include "geometry/rect2d.hpp"
 
 #include "base/assert.hpp"
+#include "base/stl_helpers.hpp"
 
 #include <algorithm>
 #include <cstdint>
@@ -38,6 +39,16 @@ public:
 
   inline void Clear() { m_entries.clear(); }
 
+  // Drops the entries of the mwms for which |pred| returns true.
+  template <typename Pred>
+  void ClearIf(Pred && pred)
+  {
+    base::EraseKeysIf(m_entries, std::forward<Pred>(pred));
+  }
+
+  // Approximate size of the cached features in bytes.
+  uint64_t GetMemorySize() const;
+
 protected:
   struct Entry
   {
@@ -27,21 +27,13 @@ void Description::FromFeature(FeatureType & ft)
   m_rating = Rating::kDefault;
   m_priceRate = PriceRate::kDefault;
 
-  string const rating = ft.GetMetadata(feature::Metadata::FMD_RATING);
-  if (!rating.empty())
-  {
-    float r;
-    if (strings::to_float(rating, r))
-      m_rating = r;
-  }
-
-  string const priceRate = ft.GetMetadata(feature::Metadata::FMD_PRICE_RATE);
-  if (!priceRate.empty())
-  {
-    int pr;
-    if (strings::to_int(priceRate, pr))
-      m_priceRate = pr;
-  }
+  float rating;
+  if (ft.GetMetadata(feature::Metadata::FMD_RATING, rating))
+    m_rating = rating;
+
+  int priceRate;
+  if (ft.GetMetadata(feature::Metadata::FMD_PRICE_RATE, priceRate))
+    m_priceRate = priceRate;
 
   m_types = ftypes::IsHotelChecker::Instance().GetHotelTypesMask(ft);
 }
@@ -7,6 +7,8 @@
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/mwm_set.hpp"
 
+#include "base/stl_helpers.hpp"
+
 #include <map>
 #include <memory>
 #include <sstream>
@@ -412,6 +414,13 @@ public:
 
   void ClearCaches();
 
+  // Drops the descriptions of the mwms for which |pred| returns true.
+  template <typename Pred>
+  void ClearCachesIf(Pred && pred)
+  {
+    base::EraseKeysIf(m_descriptions, std::forward<Pred>(pred));
+  }
+
 private:
   Descriptions const & GetDescriptions(MwmContext const & context);
 
@@ -245,7 +245,7 @@ void FillDetails(FeatureType & ft, Result::Details & details)
     // In else case value us osm::Unknown, it's set in preview's constructor.
   }
 
-  if (strings::to_int(ft.GetMetadata(feature::Metadata::FMD_STARS), details.m_stars))
+  if (ft.GetMetadata(feature::Metadata::FMD_STARS, details.m_stars))
     details.m_stars = base::Clamp(details.m_stars, 0, 5);
   else
     details.m_stars = 0;
@@ -256,16 +256,12 @@ void FillDetails(FeatureType & ft, Result::Details & details)
 
   if (isSponsoredHotel)
   {
-    auto const r = ft.GetMetadata(feature::Metadata::FMD_RATING);
-    if (!r.empty())
-    {
-      float raw;
-      if (strings::to_float(r.c_str(), raw))
-        details.m_hotelRating = raw;
-    }
+    float raw;
+    if (ft.GetMetadata(feature::Metadata::FMD_RATING, raw))
+      details.m_hotelRating = raw;
 
     int pricing;
-    if (!strings::to_int(ft.GetMetadata(feature::Metadata::FMD_PRICE_RATE), pricing))
+    if (!ft.GetMetadata(feature::Metadata::FMD_PRICE_RATE, pricing))
       pricing = 0;
     string pricingStr;
     CHECK_GREATER_OR_EQUAL(pricing, 0, ("Pricing must be positive!"));
@@ -118,13 +118,10 @@ private:
     CHECK_GREATER_OR_EQUAL(m_value.GetHeader().GetFormat(), version::Format::v5,
                            ("Old maps should not be registered."));
     CheckUniqueIndexes checkUnique;
-    for (auto const & i : intervals)
-      m_index.ForEachInIntervalAndScale(i.first, i.second, scale,
-          [&](uint64_t /* key */, uint32_t value)
-          {
-            if (checkUnique(value))
-              fn(value);
-          });
+    m_index.ForEachInIntervalsAndScale(intervals, scale, [&](uint64_t /* key */, uint32_t value) {
+      if (checkUnique(value))
+        fn(value);
+    });
   }
 
   FeaturesVector m_vector;
@@ -20,6 +20,11 @@ using namespace std;
 
 namespace search
 {
+namespace
+{
+size_t constexpr kMaxCachedPostcodes = 1000;
+}  // namespace
+
 void PostcodePoints::Header::Read(Reader & reader)
 {
   NonOwningReaderSource source(reader);
@@ -61,8 +66,8 @@ PostcodePoints::PostcodePoints(MwmValue const & value)
   m_radius = kPostcodeRadiusMultiplier * 0.5 * sqrt(area / count);
 }
 
-void PostcodePoints::Get(strings::UniString const & postcode, bool recursive,
-                         vector<m2::PointD> & points) const
+void PostcodePoints::Load(strings::UniString const & postcode, bool recursive,
+                          vector<m2::PointD> & points) const
 {
   if (!m_root || !m_points || !m_trieSubReader || !m_pointsSubReader || postcode.empty())
     return;
@@ -105,15 +110,39 @@ void PostcodePoints::Get(strings::UniString const & postcode, bool recursive,
     CHECK(m_points->Get(indexes[i], points[i]), ());
 }
 
-void PostcodePoints::Get(strings::UniString const & postcode, vector<m2::PointD> & points) const
+void PostcodePoints::Load(strings::UniString const & postcode, vector<m2::PointD> & points) const
 {
   points.clear();
-  Get(postcode, false /* recursive */, points);
+  Load(postcode, false /* recursive */, points);
   if (!points.empty())
     return;
 
   auto static const space = strings::MakeUniString(" ");
-  Get(postcode + space, true /* recursive */, points);
+  Load(postcode + space, true /* recursive */, points);
+}
+
+void PostcodePoints::Get(strings::UniString const & postcode, vector<m2::PointD> & points) const
+{
+  auto const it = m_cache.find(postcode);
+  if (it != m_cache.end())
+  {
+    points = it->second;
+    return;
+  }
+
+  Load(postcode, points);
+
+  if (m_cache.size() >= kMaxCachedPostcodes)
+    m_cache.clear();
+  m_cache.emplace(postcode, points);
+}
+
+void PostcodePoints::Get(vector<strings::UniString> const & postcodes,
+                         vector<vector<m2::PointD>> & points) const
+{
+  points.resize(postcodes.size());
+  for (size_t i = 0; i < postcodes.size(); ++i)
+    Get(postcodes[i], points[i]);
 }
 
 PostcodePoints & PostcodePointsCache::Get(MwmContext const & context)
@@ -10,12 +10,15 @@
 #include "coding/reader.hpp"
 #include "coding/write_to_sink.hpp"
 
+#include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
 
 #include "geometry/point2d.hpp"
 
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace search
@@ -54,12 +57,18 @@ public:
 
   PostcodePoints(MwmValue const & value);
 
+  // The results are cached, so the same postcode is looked up in the trie only once.
+  // The method is not thread-safe.
   void Get(strings::UniString const & postcode, std::vector<m2::PointD> & points) const;
+  // Sets |points[i]| to the points of |postcodes[i]|.
+  void Get(std::vector<strings::UniString> const & postcodes,
+           std::vector<std::vector<m2::PointD>> & points) const;
   double GetRadius() const { return m_radius; }
 
 private:
-  void Get(strings::UniString const & postcode, bool recursive,
-           std::vector<m2::PointD> & points) const;
+  void Load(strings::UniString const & postcode, std::vector<m2::PointD> & points) const;
+  void Load(strings::UniString const & postcode, bool recursive,
+            std::vector<m2::PointD> & points) const;
 
   Header m_header;
   std::unique_ptr<CentersTable> m_points;
@@ -67,6 +76,7 @@ private:
   std::unique_ptr<Reader> m_trieSubReader;
   std::unique_ptr<Reader> m_pointsSubReader;
   double m_radius = 0.0;
+  mutable std::map<strings::UniString, std::vector<m2::PointD>> m_cache;
 };
 
 class PostcodePointsCache
@@ -75,6 +85,12 @@ public:
   PostcodePoints & Get(MwmContext const & context);
   void Clear() { m_entries.clear(); }
 
+  template <typename Pred>
+  void ClearIf(Pred && pred)
+  {
+    base::EraseKeysIf(m_entries, std::forward<Pred>(pred));
+  }
+
 private:
   std::map<MwmSet::MwmId, std::unique_ptr<PostcodePoints>> m_entries;
 };
@@ -16,7 +16,9 @@
 
 #include "geometry/mercator.hpp"
 #include "geometry/nearby_points_sweeper.hpp"
+#include "geometry/points_batch.hpp"
 
+#include "base/profiler.hpp"
 #include "base/random.hpp"
 #include "base/stl_helpers.hpp"
 
@@ -68,6 +70,7 @@ void PreRanker::Init(Params const & params)
 {
   m_numSentResults = 0;
   m_haveFullyMatchedResult = false;
+  m_firstResultSent = false;
   m_results.clear();
   m_relaxedResults.clear();
   m_params = params;
@@ -88,8 +91,19 @@ void PreRanker::FillMissingFieldsInPreResults()
   unique_ptr<RankTable> ratings = make_unique<DummyRankTable>();
   unique_ptr<LazyCentersTable> centers;
   bool pivotFeaturesInitialized = false;
-
-  ForEach([&](PreRankerResult & r) {
+  // Distances to the centers from the centers tables are computed in one batch.
+  vector<PreRankerResult *> withCenters;
+  m2::PointsBatch centersBatch;
+  // Ranks are read in one batch for every run of consecutive results from the same mwm.
+  vector<uint32_t> batchIds;
+  vector<uint8_t> batchRanks;
+  vector<uint8_t> batchPopularity;
+  vector<uint8_t> batchRatings;
+  size_t batchBegin = 0;
+
+  for (size_t i = 0; i < m_results.size(); ++i)
+  {
+    auto & r = m_results[i];
     FeatureID const & id = r.GetId();
     if (id.m_mwmId != mwmId)
     {
@@ -111,17 +125,27 @@ void PreRanker::FillMissingFieldsInPreResults()
         popularityRanks = make_unique<DummyRankTable>();
       if (!ratings)
         ratings = make_unique<DummyRankTable>();
+
+      batchIds.clear();
+      for (size_t j = i; j < m_results.size() && m_results[j].GetId().m_mwmId == mwmId; ++j)
+        batchIds.push_back(m_results[j].GetId().m_index);
+      ranks->GetBatch(batchIds, batchRanks);
+      popularityRanks->GetBatch(batchIds, batchPopularity);
+      ratings->GetBatch(batchIds, batchRatings);
+      batchBegin = i;
     }
 
-    r.SetRank(ranks->Get(id.m_index));
-    r.SetPopularity(popularityRanks->Get(id.m_index));
-    r.SetRating(ugc::UGC::UnpackRating(ratings->Get(id.m_index)));
+    auto const k = i - batchBegin;
+    r.SetRank(batchRanks[k]);
+    r.SetPopularity(batchPopularity[k]);
+    r.SetRating(ugc::UGC::UnpackRating(batchRatings[k]));
 
     m2::PointD center;
     if (centers && centers->Get(id.m_index, center))
     {
-      r.SetDistanceToPivot(mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, center));
       r.SetCenter(center);
+      withCenters.push_back(&r);
+      centersBatch.Add(center);
     }
     else
     {
@@ -144,11 +168,17 @@ void PreRanker::FillMissingFieldsInPreResults()
         r.SetDistanceToPivot(m_pivotFeatures.GetDistanceToFeatureMeters(id));
       }
     }
-  });
+  }
+
+  vector<double> distances;
+  mercator::DistancesOnEarth(m_params.m_accuratePivotCenter, centersBatch, distances);
+  for (size_t i = 0; i < withCenters.size(); ++i)
+    withCenters[i]->SetDistanceToPivot(distances[i]);
 }
 
 void PreRanker::Filter(bool viewportSearch)
 {
+  PROFILER_SCOPE("PreRanker::Filter");
   struct LessFeatureID
   {
     inline bool operator()(PreRankerResult const & lhs, PreRankerResult const & rhs) const
@@ -229,8 +259,7 @@ void PreRanker::Filter(bool viewportSearch)
   {
     if (!m_params.m_categorialRequest)
     {
-      nth_element(m_results.begin(), m_results.begin() + numResults, m_results.end(),
-                  &PreRankerResult::LessRankAndPopularity);
+      SelectTopByRankAndPopularity(numResults);
       filtered.insert(m_results.begin(), m_results.begin() + numResults);
       nth_element(m_results.begin(), m_results.begin() + numResults, m_results.end(),
                   &PreRankerResult::LessByExactMatch);
@@ -254,20 +283,50 @@ void PreRanker::Filter(bool viewportSearch)
   m_results.assign(filtered.begin(), filtered.end());
 }
 
+void PreRanker::SelectTopByRankAndPopularity(size_t k)
+{
+  if (k == 0 || k >= m_results.size())
+    return;
+
+  vector<uint8_t> ranks;
+  ranks.reserve(m_results.size());
+  for (auto const & result : m_results)
+    ranks.push_back(result.GetInfo().m_rank);
+  auto const threshold = GetTopRankThreshold(ranks, k);
+
+  // Results with ranks greater than |threshold| are among the top ones anyway, so only
+  // the results with rank |threshold| are compared by popularity and distance.
+  auto const above = partition(m_results.begin(), m_results.end(), [&](auto const & result) {
+    return result.GetInfo().m_rank > threshold;
+  });
+  auto const boundary = partition(above, m_results.end(), [&](auto const & result) {
+    return result.GetInfo().m_rank == threshold;
+  });
+  nth_element(above, m_results.begin() + k, boundary, &PreRankerResult::LessRankAndPopularity);
+}
+
 void PreRanker::UpdateResults(bool lastUpdate)
 {
-  FilterRelaxedResults(lastUpdate);
-  FillMissingFieldsInPreResults();
-  Filter(m_params.m_viewportSearch);
-  m_numSentResults += m_results.size();
-  m_ranker.AddPreRankerResults(move(m_results));
-  m_results.clear();
+  SendResults(lastUpdate);
   m_ranker.UpdateResults(lastUpdate);
 
   if (lastUpdate && !m_currEmit.empty())
     m_currEmit.swap(m_prevEmit);
 }
 
+void PreRanker::UpdateFirstResult()
+{
+  if (!m_params.m_streamResults || m_params.m_viewportSearch || m_firstResultSent ||
+      !m_haveFullyMatchedResult)
+  {
+    return;
+  }
+
+  m_firstResultSent = true;
+  SendResults(false /* lastUpdate */);
+  m_ranker.UpdateFirstResult();
+}
+
 void PreRanker::ClearCaches()
 {
   m_pivotFeatures.Clear();
@@ -293,6 +352,17 @@ void PreRanker::FilterForViewportSearch()
   CHECK_LESS_OR_EQUAL(m_results.size(), BatchSize(), ());
 }
 
+void PreRanker::SendResults(bool lastUpdate)
+{
+  QueryStats::ScopedPhase phase(m_params.m_stats.get(), QueryStats::Phase::PreRanking);
+  FilterRelaxedResults(lastUpdate);
+  FillMissingFieldsInPreResults();
+  Filter(m_params.m_viewportSearch);
+  m_numSentResults += m_results.size();
+  m_ranker.AddPreRankerResults(move(m_results));
+  m_results.clear();
+}
+
 void PreRanker::FilterRelaxedResults(bool lastUpdate)
 {
   if (lastUpdate)
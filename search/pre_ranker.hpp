@@ -57,8 +57,11 @@ public:
 
     bool m_viewportSearch = false;
     bool m_categorialRequest = false;
+    bool m_streamResults = false;
 
     size_t m_numQueryTokens = 0;
+
+    std::shared_ptr<QueryStats> m_stats;
   };
 
   PreRanker(DataSource const & dataSource, Ranker & ranker);
@@ -89,6 +92,11 @@ public:
   // Use |lastUpdate| to indicate that no more results will be added.
   void UpdateResults(bool lastUpdate);
 
+  // When results are streamed, emits the best result found so far if there is a fully matched
+  // one and nothing has been emitted yet. It's called after the mwms around the pivot, before
+  // the batch of them is complete.
+  void UpdateFirstResult();
+
   size_t Size() const { return m_results.size() + m_relaxedResults.size(); }
   size_t BatchSize() const
   {
@@ -110,8 +118,15 @@ public:
 private:
   void FilterForViewportSearch();
 
+  // Moves the |k| best results by PreRankerResult::LessRankAndPopularity to the front of
+  // |m_results|. Only the results with the rank of the k-th best one are compared.
+  void SelectTopByRankAndPopularity(size_t k);
+
   void FilterRelaxedResults(bool lastUpdate);
 
+  // Moves the results to the ranker.
+  void SendResults(bool lastUpdate);
+
   DataSource const & m_dataSource;
   Ranker & m_ranker;
   std::vector<PreRankerResult> m_results;
@@ -124,6 +139,9 @@ private:
   // True iff there is at least one result with all tokens used (not relaxed).
   bool m_haveFullyMatchedResult = false;
 
+  // True iff the first result has been sent in the streaming mode.
+  bool m_firstResultSent = false;
+
   // Cache of nested rects used to estimate distance from a feature to the pivot.
   NestedRectsCache m_pivotFeatures;
 
@@ -55,6 +55,7 @@
 #include "base/buffer_vector.hpp"
 #include "base/logging.hpp"
 #include "base/macros.hpp"
+#include "base/profiler.hpp"
 #include "base/scope_guard.hpp"
 #include "base/stl_helpers.hpp"
 #include "base/string_utils.hpp"
@@ -234,7 +235,9 @@ bool EatVersion(string & s, uint32_t & version)
 
 Processor::Processor(DataSource const & dataSource, CategoriesHolder const & categories,
                      vector<Suggest> const & suggests,
-                     storage::CountryInfoGetter const & infoGetter)
+                     storage::CountryInfoGetter const & infoGetter,
+                     base::thread_pool::computational::ThreadPool * retrievalPool,
+                     RetrievalCache * retrievalCache)
   : m_categories(categories)
   , m_infoGetter(infoGetter)
   , m_dataSource(dataSource)
@@ -245,7 +248,8 @@ Processor::Processor(DataSource const & dataSource, CategoriesHolder const & cat
              suggests, m_localitiesCaches.m_villages, static_cast<base::Cancellable const &>(*this))
   , m_preRanker(m_dataSource, m_ranker)
   , m_geocoder(m_dataSource, infoGetter, categories, m_citiesBoundaries, m_preRanker,
-               m_localitiesCaches, static_cast<base::Cancellable const &>(*this))
+               m_localitiesCaches, static_cast<base::Cancellable const &>(*this), retrievalPool,
+               retrievalCache)
   , m_bookmarksProcessor(m_emitter, static_cast<base::Cancellable const &>(*this))
 {
   // Current and input langs are to be set later.
@@ -456,8 +460,7 @@ void Processor::ResetBookmarks()
 
 void Processor::OnBookmarksCreated(vector<pair<bookmarks::Id, bookmarks::Doc>> const & marks)
 {
-  for (auto const & idDoc : marks)
-    m_bookmarksProcessor.Add(idDoc.first /* id */, idDoc.second /* doc */);
+  m_bookmarksProcessor.Add(marks);
 }
 
 void Processor::OnBookmarksUpdated(vector<pair<bookmarks::Id, bookmarks::Doc>> const & marks)
@@ -475,15 +478,13 @@ void Processor::OnBookmarksDeleted(vector<bookmarks::Id> const & marks)
 void Processor::OnBookmarksAttachedToGroup(bookmarks::GroupId const & groupId,
                                            vector<bookmarks::Id> const & marks)
 {
-  for (auto const & id : marks)
-    m_bookmarksProcessor.AttachToGroup(id, groupId);
+  m_bookmarksProcessor.AttachToGroup(marks, groupId);
 }
 
 void Processor::OnBookmarksDetachedFromGroup(bookmarks::GroupId const & groupId,
                                              vector<bookmarks::Id> const & marks)
 {
-  for (auto const & id : marks)
-    m_bookmarksProcessor.DetachFromGroup(id, groupId);
+  m_bookmarksProcessor.DetachFromGroup(marks, groupId);
 }
 
 void Processor::Reset()
@@ -615,6 +616,7 @@ void Processor::ForEachCategoryTypeFuzzy(StringSliceBase const & slice, ToDo &&
 
 void Processor::Search(SearchParams const & params)
 {
+  PROFILER_SCOPE("Processor::Search");
   SetDeadline(chrono::steady_clock::now() + params.m_timeout);
 
   InitEmitter(params);
@@ -644,7 +646,10 @@ void Processor::Search(SearchParams const & params)
 
   SetInputLocale(params.m_inputLocale);
 
-  SetQuery(params.m_query);
+  {
+    QueryStats::ScopedPhase phase(params.m_stats.get(), QueryStats::Phase::Tokenization);
+    SetQuery(params.m_query);
+  }
   SetViewport(viewport);
 
   // Used to store the earliest available cancellation status:
@@ -677,7 +682,10 @@ void Processor::Search(SearchParams const & params)
       else
       {
         if (m_tokens.empty())
+        {
           m_ranker.SuggestStrings();
+          m_ranker.SuggestCompletions();
+        }
         m_geocoder.GoEverywhere();
       }
     }
@@ -706,6 +714,8 @@ void Processor::Search(SearchParams const & params)
   // todo(@m) Send the fact of cancelling by timeout to stats?
   if (!viewportSearch && cancellationStatus != Cancellable::Status::CancelCalled)
     SendStatistics(params, viewport, m_emitter.GetResults());
+
+  TrimCaches();
 }
 
 void Processor::SearchDebug()
@@ -897,6 +907,7 @@ void Processor::InitGeocoder(Geocoder::Params & geocoderParams, SearchParams con
   geocoderParams.m_cuisineTypes = m_cuisineTypes;
   geocoderParams.m_preferredTypes = m_preferredTypes;
   geocoderParams.m_tracer = searchParams.m_tracer;
+  geocoderParams.m_stats = searchParams.m_stats;
   geocoderParams.m_streetSearchRadiusM = searchParams.m_streetSearchRadiusM;
   geocoderParams.m_villageSearchRadiusM = searchParams.m_villageSearchRadiusM;
 
@@ -923,7 +934,9 @@ void Processor::InitPreRanker(Geocoder::Params const & geocoderParams,
   params.m_limit = max(SearchParams::kPreResultsCount, searchParams.m_maxNumResults);
   params.m_viewportSearch = viewportSearch;
   params.m_categorialRequest = geocoderParams.IsCategorialRequest();
+  params.m_streamResults = searchParams.m_streamResults;
   params.m_numQueryTokens = geocoderParams.GetNumTokens();
+  params.m_stats = searchParams.m_stats;
 
   m_preRanker.Init(params);
 }
@@ -945,6 +958,7 @@ void Processor::InitRanker(Geocoder::Params const & geocoderParams,
   params.m_suggestsEnabled = searchParams.m_suggestsEnabled;
   params.m_needAddress = searchParams.m_needAddress;
   params.m_needHighlighting = searchParams.m_needHighlighting && !geocoderParams.IsCategorialRequest();
+  params.m_streamResults = searchParams.m_streamResults;
   params.m_query = m_query;
   params.m_tokens = m_tokens;
   params.m_prefix = m_prefix;
@@ -971,6 +985,40 @@ void Processor::ClearCaches()
   m_viewport.MakeEmpty();
 }
 
+void Processor::OnMwmsChanged()
+{
+  auto const isStale = [](MwmSet::MwmId const & id) { return !id.IsAlive(); };
+  m_geocoder.ClearCaches(isStale);
+  m_localitiesCaches.ClearIf(isStale);
+  // Localities of the ranker are loaded from all mwms at once.
+  m_preRanker.ClearCaches();
+  m_ranker.ClearCaches();
+  m_viewport.MakeEmpty();
+}
+
+void Processor::TrimCaches()
+{
+  auto const getSize = [this]() {
+    return m_geocoder.GetCachesMemorySize() + m_localitiesCaches.GetMemorySize();
+  };
+  if (getSize() <= kMaxCachesMemorySize)
+    return;
+
+  // The caches of the mwms around the viewport are the most likely to be needed by the next
+  // queries of the user.
+  auto const isFar = [this](MwmSet::MwmId const & id) {
+    return !id.IsAlive() || !m_viewport.IsValid() ||
+           !id.GetInfo()->m_bordersRect.IsIntersect(m_viewport);
+  };
+  m_geocoder.ClearCaches(isFar);
+  m_localitiesCaches.ClearIf(isFar);
+  if (getSize() <= kMaxCachesMemorySize)
+    return;
+
+  m_geocoder.ClearCaches();
+  m_localitiesCaches.Clear();
+}
+
 void Processor::EmitFeatureIfExists(vector<shared_ptr<MwmInfo>> const & infos,
                                     storage::CountryId const & mwmName, optional<uint32_t> version,
                                     uint32_t fid)
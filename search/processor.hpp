@@ -62,8 +62,15 @@ public:
   // Maximum result candidates count for each viewport/criteria.
   static size_t const kPreResultsCount;
 
+  // The caches of features are kept across the queries while their approximate size is below
+  // this limit, see TrimCaches().
+  static uint64_t constexpr kMaxCachesMemorySize = 32 * 1024 * 1024;
+
+  // |retrievalPool| and |retrievalCache| are passed to the geocoder, see Geocoder::Geocoder().
   Processor(DataSource const & dataSource, CategoriesHolder const & categories,
-            std::vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter);
+            std::vector<Suggest> const & suggests, storage::CountryInfoGetter const & infoGetter,
+            base::thread_pool::computational::ThreadPool * retrievalPool = nullptr,
+            RetrievalCache * retrievalCache = nullptr);
 
   void SetViewport(m2::RectD const & viewport);
   void SetPreferredLocale(std::string const & locale);
@@ -95,6 +102,9 @@ public:
   void InitEmitter(SearchParams const & searchParams);
 
   void ClearCaches();
+  // Drops the caches of the deregistered mwms and the caches which depend on the whole set of
+  // mwms. The caches of the other mwms are kept.
+  void OnMwmsChanged();
   void CacheWorldLocalities();
   void LoadCitiesBoundaries();
   void LoadCountriesTree();
@@ -140,6 +150,10 @@ protected:
 
   m2::RectD const & GetViewport() const;
 
+  // Drops the caches of the mwms which are far from the viewport, or all caches, when the
+  // caches of features take more than kMaxCachesMemorySize.
+  void TrimCaches();
+
   void EmitFeatureIfExists(std::vector<std::shared_ptr<MwmInfo>> const & infos,
                            storage::CountryId const & mwmName, std::optional<uint32_t> version,
                            uint32_t fid);
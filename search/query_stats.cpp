@@ -0,0 +1,50 @@
+#include "search/query_stats.hpp"
+
+#include "base/assert.hpp"
+
+using namespace std;
+
+namespace search
+{
+QueryStats::ScopedPhase::ScopedPhase(QueryStats * stats, Phase phase)
+  : m_stats(stats), m_phase(phase)
+{
+  if (!m_stats)
+    return;
+
+  CHECK_LESS(m_phase, Phase::Count, ());
+  m_start = Clock::now();
+  m_outerNested = m_stats->m_nested;
+  m_stats->m_nested = {};
+}
+
+QueryStats::ScopedPhase::~ScopedPhase()
+{
+  if (!m_stats)
+    return;
+
+  auto const total = Clock::now() - m_start;
+  m_stats->m_times[static_cast<size_t>(m_phase)] += total - m_stats->m_nested;
+  m_stats->m_nested = m_outerNested + total;
+}
+
+QueryStats::Clock::duration QueryStats::GetTime(Phase phase) const
+{
+  CHECK_LESS(phase, Phase::Count, ());
+  return m_times[static_cast<size_t>(phase)];
+}
+
+string DebugPrint(QueryStats::Phase phase)
+{
+  switch (phase)
+  {
+  case QueryStats::Phase::Tokenization: return "Tokenization";
+  case QueryStats::Phase::Retrieval: return "Retrieval";
+  case QueryStats::Phase::Geocoding: return "Geocoding";
+  case QueryStats::Phase::PreRanking: return "PreRanking";
+  case QueryStats::Phase::Ranking: return "Ranking";
+  case QueryStats::Phase::Count: return "Count";
+  }
+  UNREACHABLE();
+}
+}  // namespace search
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "base/macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace search
+{
+// Time spent by a search query in its phases and the amount of work done by it. It's filled
+// when it's set in SearchParams, search_quality_tool uses it to find latency regressions.
+//
+// *NOTE* Phases must be timed on the thread which processes the query. The counters may be
+// updated from any thread.
+class QueryStats
+{
+public:
+  enum class Phase
+  {
+    Tokenization,
+    // Retrieval of the features of the query tokens from the search index.
+    Retrieval,
+    // Matching of the retrieved features with each other.
+    Geocoding,
+    PreRanking,
+    Ranking,
+
+    Count
+  };
+
+  using Clock = std::chrono::steady_clock;
+
+  // Adds the time of the scope to |phase|. The time of the phases nested into the scope is
+  // not counted for |phase|, so the times of all phases sum up to the time of the query.
+  // Does nothing when |stats| is null.
+  class ScopedPhase
+  {
+  public:
+    ScopedPhase(QueryStats * stats, Phase phase);
+    ~ScopedPhase();
+
+  private:
+    QueryStats * const m_stats;
+    Phase const m_phase;
+    Clock::time_point m_start;
+    Clock::duration m_outerNested{};
+
+    DISALLOW_COPY_AND_MOVE(ScopedPhase);
+  };
+
+  Clock::duration GetTime(Phase phase) const;
+
+  void AddRetrievedFeatures(uint64_t count) { m_retrievedFeatures += count; }
+  void AddLoadedFeatures(uint64_t count) { m_loadedFeatures += count; }
+
+  // Total number of the features in the retrieved CBVs of all tokens in all mwms.
+  uint64_t GetRetrievedFeatures() const { return m_retrievedFeatures; }
+  // Number of the features loaded from mwms to make the results.
+  uint64_t GetLoadedFeatures() const { return m_loadedFeatures; }
+
+private:
+  static size_t constexpr kPhasesCount = static_cast<size_t>(Phase::Count);
+
+  std::array<Clock::duration, kPhasesCount> m_times{};
+  // Time of the phases nested into the current one.
+  Clock::duration m_nested{};
+
+  std::atomic<uint64_t> m_retrievedFeatures{0};
+  std::atomic<uint64_t> m_loadedFeatures{0};
+};
+
+std::string DebugPrint(QueryStats::Phase phase);
+}  // namespace search
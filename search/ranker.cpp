@@ -14,6 +14,7 @@
 #include "indexer/brands_holder.hpp"
 #include "indexer/data_source.hpp"
 #include "indexer/feature_algo.hpp"
+#include "indexer/feature_centers_cache.hpp"
 #include "indexer/feature_data.hpp"
 #include "indexer/feature_utils.hpp"
 #include "indexer/ftypes_matcher.hpp"
@@ -21,11 +22,16 @@
 
 #include "coding/string_utf8_multilang.hpp"
 
+#include "base/executor.hpp"
 #include "base/logging.hpp"
+#include "base/profiler.hpp"
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <future>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <optional>
 
 using namespace std;
@@ -369,6 +375,8 @@ private:
     auto ft = m_loader->GetFeatureByIndex(id.m_index);
     if (ft)
       ft->SetID(id);
+    if (m_params.m_stats)
+      m_params.m_stats->AddLoadedFeatures(1);
     return ft;
   }
 
@@ -380,7 +388,7 @@ private:
     if (!ft)
       return ft;
 
-    center = feature::GetCenter(*ft);
+    center = FeatureCentersCache::Instance().GetCenter(*ft);
     m_ranker.GetBestMatchName(*ft, name);
 
     // Insert exact address (street and house number) instead of empty result name.
@@ -683,8 +691,66 @@ void Ranker::SuggestStrings()
     MatchForSuggestions(m_params.m_prefix, locale, prologue);
 }
 
+void Ranker::SuggestCompletions()
+{
+  if (m_params.m_prefix.empty() || !m_params.m_suggestsEnabled)
+    return;
+
+  // Completions are ranked by their weights summed over the mwms.
+  map<strings::UniString, uint64_t> weights;
+  vector<shared_ptr<MwmInfo>> infos;
+  m_dataSource.GetMwmsInfo(infos);
+  for (auto const & info : infos)
+  {
+    if (info->GetType() != MwmInfo::WORLD && !info->m_bordersRect.IsPointInside(m_params.m_pivot))
+      continue;
+
+    auto const * table = GetCompletionsTable(MwmSet::MwmId(info));
+    if (!table)
+      continue;
+
+    for (auto const & completion : table->Get(m_params.m_prefix))
+      weights[completion.m_word] += completion.m_weight;
+  }
+
+  vector<pair<uint64_t, strings::UniString const *>> completions;
+  for (auto const & [word, weight] : weights)
+  {
+    // Do not suggest the word which is already typed.
+    if (word != m_params.m_prefix)
+      completions.emplace_back(weight, &word);
+  }
+
+  size_t const count = min(completions.size(), CompletionsTableBuilder::kDefaultMaxCompletions);
+  partial_sort(completions.begin(), completions.begin() + count, completions.end(),
+               [](auto const & lhs, auto const & rhs) { return lhs.first > rhs.first; });
+
+  string const prologue = DropLastToken(m_params.m_query);
+  for (size_t i = 0; i < count; ++i)
+  {
+    string const utf8Str = strings::ToUtf8(*completions[i].second);
+    Result r(utf8Str, prologue + utf8Str + " ");
+    HighlightResult(m_params.m_tokens, m_params.m_prefix, r);
+    m_emitter.AddResult(move(r));
+  }
+  m_emitter.Emit();
+}
+
 void Ranker::UpdateResults(bool lastUpdate)
 {
+  PROFILER_SCOPE("Ranker::UpdateResults");
+  EmitResults(lastUpdate, m_params.m_batchSize);
+}
+
+void Ranker::UpdateFirstResult()
+{
+  PROFILER_SCOPE("Ranker::UpdateFirstResult");
+  EmitResults(false /* lastUpdate */, 1 /* maxNewResults */);
+}
+
+void Ranker::EmitResults(bool lastUpdate, size_t maxNewResults)
+{
+  QueryStats::ScopedPhase phase(m_geocoderParams.m_stats.get(), QueryStats::Phase::Ranking);
   if (!lastUpdate)
     BailIfCancelled();
 
@@ -710,10 +776,14 @@ void Ranker::UpdateResults(bool lastUpdate)
 
   // Emit feature results.
   size_t count = m_emitter.GetResults().GetCount();
+  size_t const prevCount = count;
   size_t i = 0;
   for (; i < m_tentativeResults.size(); ++i)
   {
-    if (!lastUpdate && count >= m_params.m_batchSize && !m_params.m_viewportSearch &&
+    // In the streaming mode every update emits its best results, otherwise the results after
+    // the first batch wait for the last update.
+    size_t const newResults = m_params.m_streamResults ? count - prevCount : count;
+    if (!lastUpdate && newResults >= maxNewResults && !m_params.m_viewportSearch &&
         !m_params.m_categorialRequest)
     {
       break;
@@ -746,7 +816,11 @@ void Ranker::UpdateResults(bool lastUpdate)
     {
       LOG(LDEBUG, (rankerResult));
       if (m_emitter.AddResult(move(result)))
+      {
         ++count;
+        if (m_params.m_streamResults)
+          m_emitter.Emit();
+      }
     }
   }
   m_tentativeResults.erase(m_tentativeResults.begin(), m_tentativeResults.begin() + i);
@@ -759,7 +833,11 @@ void Ranker::UpdateResults(bool lastUpdate)
   }
 }
 
-void Ranker::ClearCaches() { m_localities.ClearCache(); }
+void Ranker::ClearCaches()
+{
+  m_localities.ClearCache();
+  m_completionsTables.clear();
+}
 
 void Ranker::SetLocale(string const & locale)
 {
@@ -770,10 +848,63 @@ void Ranker::LoadCountriesTree() { m_regionInfoGetter.LoadCountriesTree(); }
 
 void Ranker::MakeRankerResults()
 {
-  RankerResultMaker maker(*this, m_dataSource, m_infoGetter, m_reverseGeocoder, m_geocoderParams);
-  for (auto const & r : m_preRankerResults)
+  // Features of one mwm are loaded by one task, so every task opens only its own mwms. The order
+  // of the results within an mwm is kept.
+  vector<size_t> order(m_preRankerResults.size());
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+    return m_preRankerResults[lhs].GetId().m_mwmId < m_preRankerResults[rhs].GetId().m_mwmId;
+  });
+
+  vector<optional<RankerResult>> results(m_preRankerResults.size());
+  auto const makeResults = [this, &order, &results](size_t begin, size_t end) {
+    RankerResultMaker maker(*this, m_dataSource, m_infoGetter, m_reverseGeocoder,
+                            m_geocoderParams);
+    for (size_t i = begin; i < end; ++i)
+      results[order[i]] = maker(m_preRankerResults[order[i]]);
+  };
+
+  // Small batches are not worth the hop to the executor.
+  size_t constexpr kMinResultsPerTask = 16;
+  auto & executor = base::Executor::Instance();
+  size_t const tasksCount =
+      min(executor.GetThreadsCount(), max<size_t>(order.size() / kMinResultsPerTask, 1));
+  if (tasksCount <= 1 || executor.IsWorkerThread())
+  {
+    makeResults(0, order.size());
+  }
+  else
+  {
+    vector<future<void>> tasks;
+    size_t const step = (order.size() + tasksCount - 1) / tasksCount;
+    size_t begin = 0;
+    while (begin < order.size())
+    {
+      // Tasks are cut at the borders of mwms.
+      size_t end = min(begin + step, order.size());
+      auto const & mwmId = m_preRankerResults[order[end - 1]].GetId().m_mwmId;
+      while (end < order.size() && m_preRankerResults[order[end]].GetId().m_mwmId == mwmId)
+        ++end;
+
+      auto task = executor.Submit(base::Executor::Priority::Search, makeResults, begin, end);
+      if (task.valid())
+        tasks.push_back(move(task));
+      else
+        makeResults(begin, end);
+      begin = end;
+    }
+
+    // All the tasks must be finished before |results| goes away, even when one of them throws.
+    for (auto & task : tasks)
+      task.wait();
+    for (auto & task : tasks)
+      task.get();
+  }
+
+  // Results are filtered in the order of the pre-ranker, so the output does not depend on
+  // the scheduling of the tasks.
+  for (auto & p : results)
   {
-    auto p = maker(r);
     if (!p)
       continue;
 
@@ -785,7 +916,7 @@ void Ranker::MakeRankerResults()
 
     if (!ResultExists(*p, m_tentativeResults, m_params.m_minDistanceBetweenResultsM))
       m_tentativeResults.push_back(move(*p));
-  };
+  }
 
   m_preRankerResults.clear();
 }
@@ -859,6 +990,28 @@ void Ranker::MatchForSuggestions(strings::UniString const & token, int8_t locale
   }
 }
 
+CompletionsTable const * Ranker::GetCompletionsTable(MwmSet::MwmId const & id)
+{
+  // Drops the tables of the deregistered mwms, they hold the files open.
+  for (auto it = m_completionsTables.begin(); it != m_completionsTables.end();)
+  {
+    if (it->first.IsAlive())
+      ++it;
+    else
+      it = m_completionsTables.erase(it);
+  }
+
+  auto const it = m_completionsTables.find(id);
+  if (it != m_completionsTables.end())
+    return it->second.get();
+
+  unique_ptr<CompletionsTable> table;
+  auto handle = m_dataSource.GetMwmHandleById(id);
+  if (auto const * value = handle.GetValue())
+    table = CompletionsTable::Load(value->m_cont);
+  return m_completionsTables.emplace(id, move(table)).first->second.get();
+}
+
 void Ranker::ProcessSuggestions(vector<RankerResult> & vec) const
 {
   if (m_params.m_prefix.empty() || !m_params.m_suggestsEnabled)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "search/cancel_exception.hpp"
+#include "search/completions_table.hpp"
 #include "search/emitter.hpp"
 #include "search/geocoder.hpp"
 #include "search/intermediate_result.hpp"
@@ -16,6 +17,7 @@
 
 #include "indexer/categories_holder.hpp"
 #include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
 
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
@@ -26,6 +28,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -58,6 +62,8 @@ public:
     bool m_needHighlighting = false;
     bool m_viewportSearch = false;
     bool m_categorialRequest = false;
+    // Emit every result as soon as it's made, see SearchParams::m_streamResults.
+    bool m_streamResults = false;
 
     std::string m_query;
     QueryTokens m_tokens;
@@ -100,6 +106,10 @@ public:
 
   void SuggestStrings();
 
+  // Emits the most frequent words of the mwms around the pivot which start with the prefix.
+  // It is cheap, so the suggestions are shown at once while the full search is running.
+  void SuggestCompletions();
+
   virtual void AddPreRankerResults(std::vector<PreRankerResult> && preRankerResults)
   {
     std::move(preRankerResults.begin(), preRankerResults.end(),
@@ -108,6 +118,9 @@ public:
 
   virtual void UpdateResults(bool lastUpdate);
 
+  // Emits only the best of the results added so far, the others are kept for the next updates.
+  void UpdateFirstResult();
+
   void ClearCaches();
 
   void BailIfCancelled() { ::search::BailIfCancelled(m_cancellable); }
@@ -121,10 +134,14 @@ private:
 
   void MakeRankerResults();
 
+  // Ranks the added results and emits at most |maxNewResults| of them unless it's the last update.
+  void EmitResults(bool lastUpdate, size_t maxNewResults);
+
   void GetBestMatchName(FeatureType & f, std::string & name) const;
   void MatchForSuggestions(strings::UniString const & token, int8_t locale,
                            std::string const & prolog);
   void ProcessSuggestions(std::vector<RankerResult> & vec) const;
+  CompletionsTable const * GetCompletionsTable(MwmSet::MwmId const & id);
 
   std::string GetLocalizedRegionInfoForResult(RankerResult const & result) const;
 
@@ -143,6 +160,10 @@ private:
   CategoriesHolder const & m_categories;
   std::vector<Suggest> const & m_suggests;
 
+  // Completions tables live as long as the search session, so the tables are not read anew
+  // on every keystroke. Mwms without the section are cached as nullptr.
+  std::map<MwmSet::MwmId, std::unique_ptr<CompletionsTable>> m_completionsTables;
+
   std::vector<PreRankerResult> m_preRankerResults;
   std::vector<RankerResult> m_tentativeResults;
 };
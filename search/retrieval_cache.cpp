@@ -0,0 +1,149 @@
+#include "search/retrieval_cache.hpp"
+
+#include "base/assert.hpp"
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+char constexpr kSep = '\x1';
+
+void AppendString(strings::UniString const & s, string & key)
+{
+  key += strings::ToUtf8(s);
+  key += kSep;
+}
+
+template <typename Ints>
+void AppendInts(Ints const & ints, string & key)
+{
+  for (auto const i : ints)
+  {
+    key += strings::to_string(i);
+    key += ',';
+  }
+  key += kSep;
+}
+
+bool AreEqual(CBV const & lhs, CBV const & rhs)
+{
+  if (lhs.IsFull() || rhs.IsFull())
+    return lhs.IsFull() == rhs.IsFull();
+  // Hashes are cheap to compare and filter out most of unequal pairs.
+  if (lhs.PopCount() != rhs.PopCount() || lhs.Hash() != rhs.Hash())
+    return false;
+  return lhs.Intersect(rhs).PopCount() == lhs.PopCount();
+}
+
+// Features and exact matching features are often the same bit
+// vector. In this case only one copy is stored.
+RetrievalCache::Features Clone(RetrievalCache::Features const & features)
+{
+  RetrievalCache::Features result;
+  result.m_features = features.m_features.Clone();
+  if (AreEqual(features.m_features, features.m_exactMatchingFeatures))
+  {
+    result.m_exactMatchingFeatures = result.m_features;
+  }
+  else
+  {
+    result.m_exactMatchingFeatures = features.m_exactMatchingFeatures.Clone();
+  }
+  return result;
+}
+}  // namespace
+
+RetrievalCache::RetrievalCache(size_t maxNumEntries) : m_cache(maxNumEntries) {}
+
+// static
+string RetrievalCache::MakeTokenKey(QueryParams::Token const & token, bool isPrefix,
+                                    QueryParams::TypeIndices const & types,
+                                    QueryParams::Langs const & langs)
+{
+  string key = isPrefix ? "p" : "f";
+  key += kSep;
+
+  vector<uint64_t> sortedLangs(langs.begin(), langs.end());
+  sort(sortedLangs.begin(), sortedLangs.end());
+  AppendInts(sortedLangs, key);
+
+  auto sortedTypes = types;
+  sort(sortedTypes.begin(), sortedTypes.end());
+  AppendInts(sortedTypes, key);
+
+  // The order of synonyms matters neither for the retrieval nor here,
+  // but the original token allows misprints while synonyms don't.
+  token.ForOriginalAndSynonyms([&key](strings::UniString const & s) { AppendString(s, key); });
+  return key;
+}
+
+// static
+string RetrievalCache::MakeCategoriesKey(vector<uint32_t> const & types)
+{
+  string key = "c";
+  key += kSep;
+
+  auto sortedTypes = types;
+  sort(sortedTypes.begin(), sortedTypes.end());
+  AppendInts(sortedTypes, key);
+  return key;
+}
+
+bool RetrievalCache::Get(MwmSet::MwmId const & id, string const & key, Features & features)
+{
+  lock_guard<mutex> lock(m_mu);
+
+  bool found = false;
+  auto & entry = m_cache.Find(MakeKey(id, key), found);
+  // An entry with a different id was left by an mwm with the same
+  // name, which is already deregistered or updated.
+  if (!found || entry.m_id != id)
+  {
+    ++m_stats.m_misses;
+    return false;
+  }
+
+  ++m_stats.m_hits;
+  features = Clone(entry.m_features);
+  return true;
+}
+
+void RetrievalCache::Put(MwmSet::MwmId const & id, string const & key, Features const & features)
+{
+  ASSERT(id.IsAlive(), ());
+
+  auto clone = Clone(features);
+
+  lock_guard<mutex> lock(m_mu);
+  bool found = false;
+  auto & entry = m_cache.Find(MakeKey(id, key), found);
+  entry.m_id = id;
+  entry.m_features = move(clone);
+}
+
+void RetrievalCache::Clear()
+{
+  lock_guard<mutex> lock(m_mu);
+  m_cache.Clear();
+  m_stats = {};
+}
+
+RetrievalCache::Stats RetrievalCache::GetStats() const
+{
+  lock_guard<mutex> lock(m_mu);
+  return m_stats;
+}
+
+// static
+string RetrievalCache::MakeKey(MwmSet::MwmId const & id, string const & key)
+{
+  auto const & info = id.GetInfo();
+  CHECK(info, ());
+  return info->GetCountryName() + kSep + strings::to_string(info->GetVersion()) + kSep + key;
+}
+}  // namespace search
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "search/query_params.hpp"
+#include "search/retrieval.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "base/lru_cache.hpp"
+#include "base/macros.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace search
+{
+// A cross-query cache of features retrieved from the search index for
+// single query tokens. Frequent tokens (e.g. "street", "cafe" or
+// category synonyms) are retrieved once per mwm instead of walking the
+// search trie on every query.
+//
+// Entries are bound to MwmIds, so an entry becomes stale as soon as
+// the mwm is re-registered, e.g. after the mwm is updated to a newer
+// version.
+//
+// *NOTE* This class is thread-safe. Features are deep-copied on the
+// way in and out, because CBV reference counting is not thread-safe.
+class RetrievalCache
+{
+public:
+  using Features = Retrieval::ExtendedFeatures;
+
+  struct Stats
+  {
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+  };
+
+  // |maxNumEntries| is the maximum number of (mwm, token) pairs in the cache.
+  explicit RetrievalCache(size_t maxNumEntries);
+
+  // Makes a key for features matching to |token| as a full or a
+  // prefix token, in |langs| or in categories from |types|.
+  static std::string MakeTokenKey(QueryParams::Token const & token, bool isPrefix,
+                                  QueryParams::TypeIndices const & types,
+                                  QueryParams::Langs const & langs);
+
+  // Makes a key for features of a categorial request on |types|.
+  static std::string MakeCategoriesKey(std::vector<uint32_t> const & types);
+
+  // Returns true and sets |features| when features for |key| are
+  // cached for |id|.
+  bool Get(MwmSet::MwmId const & id, std::string const & key, Features & features);
+
+  void Put(MwmSet::MwmId const & id, std::string const & key, Features const & features);
+
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  struct Entry
+  {
+    MwmSet::MwmId m_id;
+    Features m_features;
+  };
+
+  static std::string MakeKey(MwmSet::MwmId const & id, std::string const & key);
+
+  LruCache<std::string, Entry> m_cache;
+  Stats m_stats;
+  mutable std::mutex m_mu;
+
+  DISALLOW_COPY_AND_MOVE(RetrievalCache);
+};
+}  // namespace search
@@ -17,11 +17,17 @@
 #include "indexer/search_string_utils.hpp"
 
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <functional>
+#include <future>
 #include <limits>
+#include <map>
+#include <tuple>
 
 using namespace std;
 
@@ -238,6 +244,130 @@ void ReverseGeocoder::GetNearbyAddress(m2::PointD const & center, double maxDist
   }
 }
 
+vector<ReverseGeocoder::Address> ReverseGeocoder::GetNearbyAddresses(
+    vector<m2::PointD> const & centers, double maxDistanceM, size_t threadsCount) const
+{
+  vector<Address> addresses(centers.size());
+  if (centers.empty())
+    return addresses;
+
+  // Points of the same cell are processed together. Cells are ordered by rows, so neighbouring
+  // cells and therefore the same mwms are processed one after another.
+  double const cellSize = mercator::MetersToMercator(2 * maxDistanceM);
+  auto const getCell = [&](m2::PointD const & p) {
+    return make_pair(static_cast<int64_t>(floor(p.y / cellSize)),
+                     static_cast<int64_t>(floor(p.x / cellSize)));
+  };
+
+  vector<size_t> indices(centers.size());
+  for (size_t i = 0; i < indices.size(); ++i)
+    indices[i] = i;
+  sort(indices.begin(), indices.end(), [&](size_t lhs, size_t rhs) {
+    return make_tuple(getCell(centers[lhs]), lhs) < make_tuple(getCell(centers[rhs]), rhs);
+  });
+
+  // Groups are [groupBegins[i], groupBegins[i + 1]) ranges of |indices|.
+  vector<size_t> groupBegins = {0};
+  for (size_t i = 1; i < indices.size(); ++i)
+  {
+    if (getCell(centers[indices[i - 1]]) != getCell(centers[indices[i]]))
+      groupBegins.push_back(i);
+  }
+  groupBegins.push_back(indices.size());
+  size_t const groupsCount = groupBegins.size() - 1;
+
+  atomic<size_t> nextGroup(0);
+  auto const processGroups = [&]() {
+    for (size_t group = nextGroup++; group < groupsCount; group = nextGroup++)
+    {
+      GetNearbyAddresses(centers, indices, groupBegins[group], groupBegins[group + 1],
+                         maxDistanceM, addresses);
+    }
+  };
+
+  threadsCount = min(threadsCount, groupsCount);
+  if (threadsCount <= 1)
+  {
+    processGroups();
+    return addresses;
+  }
+
+  base::thread_pool::computational::ThreadPool pool(threadsCount);
+  vector<future<void>> results;
+  results.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; ++i)
+    results.push_back(pool.Submit(processGroups));
+  for (auto & result : results)
+    result.get();
+
+  return addresses;
+}
+
+void ReverseGeocoder::GetNearbyAddresses(vector<m2::PointD> const & centers,
+                                         vector<size_t> const & indices, size_t beg, size_t end,
+                                         double maxDistanceM, vector<Address> & addresses) const
+{
+  ASSERT_LESS(beg, end, ());
+
+  m2::RectD rect;
+  for (size_t i = beg; i < end; ++i)
+    rect.Add(GetLookupRect(centers[indices[i]], maxDistanceM));
+
+  // Buildings are read once for all the points of the group.
+  vector<vector<Building>> buildings(end - beg);
+  m_dataSource.ForEachInRect(
+      [&](FeatureType & ft) {
+        if (ft.GetHouseNumber().empty())
+          return;
+
+        auto const building = FromFeature(ft, 0.0 /* distMeters */);
+        for (size_t i = beg; i < end; ++i)
+        {
+          auto const distance = feature::GetMinDistanceMeters(ft, centers[indices[i]]);
+          if (distance <= maxDistanceM)
+          {
+            buildings[i - beg].push_back(building);
+            buildings[i - beg].back().m_distanceMeters = distance;
+          }
+        }
+      },
+      rect, kQueryScale);
+
+  HouseTable table(m_dataSource);
+  // Street of the building does not depend on the point, so it is matched once per building.
+  map<FeatureID, optional<Street>> streets;
+  for (size_t i = beg; i < end; ++i)
+  {
+    auto & nearby = buildings[i - beg];
+    sort(nearby.begin(), nearby.end(), base::LessBy(&Building::m_distanceMeters));
+
+    auto & addr = addresses[indices[i]];
+    size_t triesCount = 0;
+    for (auto const & b : nearby)
+    {
+      auto it = streets.find(b.m_id);
+      if (it == streets.end())
+      {
+        Address buildingAddr;
+        optional<Street> street;
+        if (GetNearbyAddress(table, b, false /* ignoreEdits */, buildingAddr))
+          street = buildingAddr.m_street;
+        it = streets.emplace(b.m_id, move(street)).first;
+      }
+
+      if (it->second)
+      {
+        addr.m_building = b;
+        addr.m_street = *it->second;
+        break;
+      }
+
+      if (++triesCount == kMaxNumTriesToApproxAddress)
+        break;
+    }
+  }
+}
+
 bool ReverseGeocoder::GetExactAddress(FeatureType & ft, Address & addr) const
 {
   if (ft.GetHouseNumber().empty())
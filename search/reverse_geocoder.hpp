@@ -143,6 +143,12 @@ public:
   /// @return The nearest exact address where building is at most |maxDistanceM| far from |center|,
   /// has house number and valid street match.
   void GetNearbyAddress(m2::PointD const & center, double maxDistanceM, Address & addr) const;
+  /// Batch version of GetNearbyAddress(). Points are grouped by cells of the lookup radius size,
+  /// so buildings around neighbouring points are read once per cell and streets are matched once
+  /// per building. Groups are processed on |threadsCount| threads.
+  /// @return Addresses in the order of |centers|.
+  std::vector<Address> GetNearbyAddresses(std::vector<m2::PointD> const & centers,
+                                          double maxDistanceM, size_t threadsCount) const;
   /// @param addr (out) the exact address of a feature.
   /// @returns false if  can't extruct address or ft have no house number.
   bool GetExactAddress(FeatureType & ft, Address & addr) const;
@@ -182,6 +188,11 @@ private:
   void GetNearbyBuildings(m2::PointD const & center, double maxDistanceM,
                           std::vector<Building> & buildings) const;
 
+  /// Fills |addresses| for |centers[indices[i]]| for i in [beg, end).
+  void GetNearbyAddresses(std::vector<m2::PointD> const & centers,
+                          std::vector<size_t> const & indices, size_t beg, size_t end,
+                          double maxDistanceM, std::vector<Address> & addresses) const;
+
   static Building FromFeature(FeatureType & ft, double distMeters);
 };
 
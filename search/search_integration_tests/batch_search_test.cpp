@@ -0,0 +1,81 @@
+#include "testing/testing.hpp"
+
+#include "search/batch_search.hpp"
+#include "search/search_tests_support/helpers.hpp"
+#include "search/search_tests_support/test_results_matching.hpp"
+
+#include "generator/generator_tests_support/test_feature.hpp"
+#include "generator/generator_tests_support/test_mwm_builder.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace generator::tests_support;
+using namespace search::tests_support;
+using namespace search;
+using namespace std;
+
+namespace
+{
+class BatchSearchTest : public SearchTest
+{
+public:
+  BatchSearchTest() : SearchTest(Engine::Params("en", 2 /* numThreads */)) {}
+};
+
+UNIT_CLASS_TEST(BatchSearchTest, Smoke)
+{
+  TestCafe greenCafe(m2::PointD(0.001, 0.001), "Green cafe", "en");
+  TestCafe redCafe(m2::PointD(0.002, 0.002), "Red cafe", "en");
+  TestPOI blueHouse(m2::PointD(0.003, 0.003), "Blue house", "en");
+
+  auto const countryId = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(greenCafe);
+    builder.Add(redCafe);
+    builder.Add(blueHouse);
+  });
+
+  vector<string> const queries = {"green cafe", "red cafe", "blue house", "green cafe",
+                                  "red cafe"};
+  vector<Rules> const expected = {
+      {ExactMatch(countryId, greenCafe)}, {ExactMatch(countryId, redCafe)},
+      {ExactMatch(countryId, blueHouse)}, {ExactMatch(countryId, greenCafe)},
+      {ExactMatch(countryId, redCafe)}};
+
+  BatchSearch::Params batchParams;
+  // Several windows with a small number of queries in flight.
+  batchParams.m_windowSize = 2;
+  batchParams.m_maxQueriesInFlight = 3;
+  BatchSearch batch(m_engine.GetEngine(), m_engine.GetCountryInfoGetter(), batchParams);
+
+  size_t next = 0;
+  auto const source = [&](SearchParams & params) {
+    if (next == queries.size())
+      return false;
+    params.m_query = queries[next++];
+    params.m_inputLocale = "en";
+    params.m_viewport = m2::RectD(m2::PointD(-1, -1), m2::PointD(1, 1));
+    params.m_mode = Mode::Everywhere;
+    return true;
+  };
+
+  mutex mu;
+  vector<vector<search::Result>> results(queries.size());
+  vector<size_t> calls(queries.size());
+  batch.Run(source, [&](size_t index, Results const & rs) {
+    lock_guard<mutex> lock(mu);
+    TEST_LESS(index, queries.size(), ());
+    TEST(rs.IsEndedNormal(), ());
+    ++calls[index];
+    results[index].assign(rs.begin(), rs.end());
+  });
+
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    TEST_EQUAL(calls[i], 1, (queries[i]));
+    TEST(ResultsMatch(results[i], expected[i]), (queries[i]));
+  }
+}
+}  // namespace
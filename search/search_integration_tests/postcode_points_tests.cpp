@@ -103,6 +103,18 @@ UNIT_CLASS_TEST(PostcodePointsTest, Smoke)
     TEST(base::AlmostEqualAbs(points[2], mercator::FromLatLon(3.0, 3.0), kMwmPointAccuracy),
          ());
   }
+  {
+    vector<vector<m2::PointD>> points;
+    p.Get({NormalizeAndSimplifyString("aa11 1bb"), NormalizeAndSimplifyString("bb11"),
+           NormalizeAndSimplifyString("aa11 1bb")},
+          points);
+    TEST_EQUAL(points.size(), 3, ());
+    TEST_EQUAL(points[0].size(), 1, ());
+    TEST(base::AlmostEqualAbs(points[0][0], mercator::FromLatLon(2.0, 2.0), kMwmPointAccuracy),
+         ());
+    TEST(points[1].empty(), ());
+    TEST_EQUAL(points[2], points[0], ());
+  }
 }
 
 UNIT_CLASS_TEST(PostcodePointsTest, SearchPostcode)
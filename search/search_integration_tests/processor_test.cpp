@@ -147,6 +147,34 @@ class ProcessorTest : public SearchTest
 {
 };
 
+class ParallelRetrievalTest : public SearchTest
+{
+public:
+  ParallelRetrievalTest() : SearchTest(MakeParams()) {}
+
+private:
+  static Engine::Params MakeParams()
+  {
+    Engine::Params params;
+    params.m_numRetrievalThreads = 3;
+    return params;
+  }
+};
+
+class RetrievalCacheTest : public SearchTest
+{
+public:
+  RetrievalCacheTest() : SearchTest(MakeParams()) {}
+
+private:
+  static Engine::Params MakeParams()
+  {
+    Engine::Params params;
+    params.m_retrievalCacheSize = 2;
+    return params;
+  }
+};
+
 UNIT_CLASS_TEST(ProcessorTest, Smoke)
 {
   string const countryName = "Wonderland";
@@ -1352,6 +1380,14 @@ UNIT_CLASS_TEST(ProcessorTest, CityBoundaryLoad)
 
   TEST(!boundaries.HasPoint(m2::PointD(0.6, 0.6)), ());
   TEST(!boundaries.HasPoint(m2::PointD(-1, 0.5)), ());
+
+  vector<bool> inside;
+  boundaries.HasPoints({m2::PointD(0.25, 0.25), m2::PointD(0.6, 0.6)}, inside);
+  TEST_EQUAL(inside, vector<bool>({true, false}), ());
+
+  vector<vector<uint32_t>> cities;
+  table.GetCitiesWithPoints({m2::PointD(0.25, 0.25), m2::PointD(-1, 0.5)}, cities);
+  TEST_EQUAL(cities, vector<vector<uint32_t>>({{0}, {}}), ());
 }
 
 UNIT_CLASS_TEST(ProcessorTest, CityBoundarySmoke)
@@ -3153,5 +3189,109 @@ UNIT_CLASS_TEST(ProcessorTest, TestRankingInfo_MultipleOldNames)
   checkResult("Ленинград", "Санкт-Петербург (Ленинград)");
   checkResult("Петроград", "Санкт-Петербург (Петроград)");
 }
+
+UNIT_CLASS_TEST(ParallelRetrievalTest, ManyMwms)
+{
+  TestCity wonderlandCity(m2::PointD(0, 0), "Wonderland city", "en", 100 /* rank */);
+  BuildWorld([&](TestMwmBuilder & builder) { builder.Add(wonderlandCity); });
+
+  vector<string> const names = {"alpha", "beta", "gamma", "delta", "epsilon", "zeta"};
+  vector<TestPOI> pois;
+  vector<MwmSet::MwmId> ids;
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    double const x = static_cast<double>(i) * 2.0;
+    pois.emplace_back(m2::PointD(x, x), "Pirate " + names[i], "en");
+    ids.push_back(BuildCountry("Country " + names[i],
+                               [&](TestMwmBuilder & builder) { builder.Add(pois.back()); }));
+  }
+
+  SetViewport(m2::RectD(m2::PointD(-1.0, -1.0), m2::PointD(11.0, 11.0)));
+  {
+    Rules rules;
+    for (size_t i = 0; i < ids.size(); ++i)
+      rules.push_back(ExactMatch(ids[i], pois[i]));
+    TEST(ResultsMatch("pirate ", rules), ());
+  }
+  {
+    Rules rules = {ExactMatch(ids[3], pois[3])};
+    TEST(ResultsMatch("pirate delta", rules), ());
+  }
+}
+
+UNIT_CLASS_TEST(RetrievalCacheTest, RepeatedQueries)
+{
+  TestCafe cafe(m2::PointD(0, 0));
+  TestPOI redCafe(m2::PointD(0.001, 0.001), "Red cafe", "en");
+  TestPOI redHouse(m2::PointD(0.002, 0.002), "Red house", "en");
+
+  auto const countryId = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(cafe);
+    builder.Add(redCafe);
+    builder.Add(redHouse);
+  });
+
+  SetViewport(m2::RectD(m2::PointD(-1.0, -1.0), m2::PointD(1.0, 1.0)));
+
+  // Queries share tokens and the cache is small, so the same results
+  // must be returned both from the cache and after eviction.
+  for (size_t i = 0; i < 3; ++i)
+  {
+    {
+      Rules rules = {ExactMatch(countryId, redCafe), ExactMatch(countryId, redHouse)};
+      TEST(ResultsMatch("red ", rules), (i));
+    }
+    {
+      Rules rules = {ExactMatch(countryId, redCafe)};
+      TEST(ResultsMatch("red cafe", rules), (i));
+    }
+    {
+      Rules rules = {ExactMatch(countryId, redCafe), ExactMatch(countryId, redHouse)};
+      TEST(ResultsMatch("red", rules), (i));
+    }
+  }
+
+  // Re-registering the mwm invalidates the cached features.
+  DeregisterMap("Wonderland");
+  TestPOI redCar(m2::PointD(0.003, 0.003), "Red car", "en");
+  auto const newCountryId = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(redCar);
+  });
+  {
+    Rules rules = {ExactMatch(newCountryId, redCar)};
+    TEST(ResultsMatch("red ", rules), ());
+  }
+}
+
+UNIT_CLASS_TEST(ProcessorTest, StreamResults)
+{
+  string const countryName = "Wonderland";
+
+  TestCafe cafe1(m2::PointD(0.001, 0.001), "Green cafe", "en");
+  TestCafe cafe2(m2::PointD(0.002, 0.002), "Green cafe", "en");
+  TestPOI house(m2::PointD(0.003, 0.003), "Green house", "en");
+
+  auto const countryId = BuildCountry(countryName, [&](TestMwmBuilder & builder) {
+    builder.Add(cafe1);
+    builder.Add(cafe2);
+    builder.Add(house);
+  });
+
+  SetViewport(m2::RectD(m2::PointD(-1, -1), m2::PointD(1, 1)));
+
+  SearchParams params;
+  params.m_query = "green ";
+  params.m_inputLocale = "en";
+  params.m_viewport = m2::RectD(m2::PointD(-1, -1), m2::PointD(1, 1));
+  params.m_mode = Mode::Everywhere;
+  params.m_streamResults = true;
+
+  // Streamed results must be the same as the results of the batched search.
+  TestSearchRequest request(m_engine, params);
+  request.Run();
+  Rules rules = {ExactMatch(countryId, cafe1), ExactMatch(countryId, cafe2),
+                 ExactMatch(countryId, house)};
+  TEST(ResultsMatch(request.Results(), rules), ());
+}
 }  // namespace
 }  // namespace search
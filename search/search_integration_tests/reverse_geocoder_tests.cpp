@@ -0,0 +1,65 @@
+#include "testing/testing.hpp"
+
+#include "search/reverse_geocoder.hpp"
+#include "search/search_tests_support/helpers.hpp"
+
+#include "generator/generator_tests_support/test_feature.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <vector>
+
+using namespace generator::tests_support;
+using namespace search::tests_support;
+using namespace search;
+using namespace std;
+
+namespace
+{
+class ReverseGeocoderTest : public SearchTest
+{
+};
+
+UNIT_CLASS_TEST(ReverseGeocoderTest, NearbyAddresses)
+{
+  TestStreet mainStreet({m2::PointD(0.0, 0.0), m2::PointD(0.0, 0.01)}, "Main street", "en");
+  TestStreet sideStreet({m2::PointD(0.02, 0.0), m2::PointD(0.02, 0.01)}, "Side street", "en");
+  TestBuilding building1(m2::PointD(0.0005, 0.001), "", "1", mainStreet.GetName("en"), "en");
+  TestBuilding building3(m2::PointD(0.0005, 0.005), "", "3", mainStreet.GetName("en"), "en");
+  TestBuilding building7(m2::PointD(0.0195, 0.005), "", "7", sideStreet.GetName("en"), "en");
+
+  BuildCountry("Wonderland", [&](TestMwmBuilder & builder) {
+    builder.Add(mainStreet);
+    builder.Add(sideStreet);
+    builder.Add(building1);
+    builder.Add(building3);
+    builder.Add(building7);
+  });
+
+  vector<m2::PointD> const centers = {
+      m2::PointD(0.0006, 0.0051), m2::PointD(0.0004, 0.001), m2::PointD(0.0196, 0.0049),
+      m2::PointD(0.0006, 0.0011), m2::PointD(1.0, 1.0)};
+  double constexpr kMaxDistanceM = 100.0;
+
+  ReverseGeocoder const coder(m_dataSource);
+  for (size_t threadsCount : {1, 4})
+  {
+    auto const addresses = coder.GetNearbyAddresses(centers, kMaxDistanceM, threadsCount);
+    TEST_EQUAL(addresses.size(), centers.size(), ());
+
+    for (size_t i = 0; i < centers.size(); ++i)
+    {
+      ReverseGeocoder::Address expected;
+      coder.GetNearbyAddress(centers[i], kMaxDistanceM, expected);
+      TEST_EQUAL(addresses[i].GetHouseNumber(), expected.GetHouseNumber(), (i, threadsCount));
+      TEST_EQUAL(addresses[i].GetStreetName(), expected.GetStreetName(), (i, threadsCount));
+    }
+
+    TEST_EQUAL(addresses[0].GetHouseNumber(), "3", ());
+    TEST_EQUAL(addresses[1].GetHouseNumber(), "1", ());
+    TEST_EQUAL(addresses[2].GetHouseNumber(), "7", ());
+    TEST_EQUAL(addresses[2].GetStreetName(), "Side street", ());
+    TEST(!addresses[4].IsValid(), ());
+  }
+}
+}  // namespace
@@ -17,6 +17,7 @@
 
 namespace search
 {
+class QueryStats;
 class Results;
 class Tracer;
 
@@ -92,6 +93,13 @@ struct SearchParams
   // Needed to highlight matching parts of search result names.
   bool m_needHighlighting = false;
 
+  // Streaming mode for everywhere search. |m_onResults| is called for every new result as
+  // soon as it is ranked instead of once per batch, and the best result of the mwms around
+  // the pivot is emitted before the other mwms are processed. Results are still only appended,
+  // so a client which wants them in the order of relevance should sort them by their ranking
+  // info itself, stably, to keep the already shown ones in place.
+  bool m_streamResults = false;
+
   std::shared_ptr<hotels_filter::Rule> m_hotelsFilter;
 
   bookmarks::GroupId m_bookmarksGroupId = bookmarks::kInvalidGroupId;
@@ -100,6 +108,9 @@ struct SearchParams
   std::chrono::steady_clock::duration m_timeout = kDefaultTimeout;
 
   std::shared_ptr<Tracer> m_tracer;
+
+  // When set, it's filled with the time of the phases of the search and with its counters.
+  std::shared_ptr<QueryStats> m_stats;
 };
 
 std::string DebugPrint(SearchParams const & params);
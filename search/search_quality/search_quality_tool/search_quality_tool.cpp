@@ -1,8 +1,10 @@
 #include "search/search_quality/helpers.hpp"
+#include "search/search_quality/helpers_json.hpp"
 
 #include "search/search_tests_support/test_search_engine.hpp"
 #include "search/search_tests_support/test_search_request.hpp"
 
+#include "search/query_stats.hpp"
 #include "search/ranking_info.hpp"
 #include "search/result.hpp"
 #include "search/search_params.hpp"
@@ -37,6 +39,7 @@
 #include "defines.hpp"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <cstdio>
@@ -44,6 +47,7 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <map>
 #include <numeric>
 #include <sstream>
@@ -70,6 +74,14 @@ DEFINE_int32(top, 1, "Number of top results to show for every query");
 DEFINE_string(viewport, "", "Viewport to use when searching (default, moscow, london, zurich)");
 DEFINE_string(check_completeness, "", "Path to the file with completeness data");
 DEFINE_string(ranking_csv_file, "", "File ranking info will be exported to");
+DEFINE_string(latency_report, "",
+              "Runs the queries in parallel on --num_threads threads and writes the JSON report "
+              "with their latencies, times of the search phases and counters to this file");
+DEFINE_string(latency_baseline, "",
+              "JSON latency report of a previous run. The tool fails when the latency "
+              "percentiles of this run are worse than in the baseline");
+DEFINE_double(max_latency_regression, 0.2,
+              "Max allowed relative growth of the latency percentiles over the baseline");
 
 string const kDefaultQueriesPathSuffix =
     "/../search/search_quality/search_quality_tool/queries.txt";
@@ -367,6 +379,164 @@ void RunRequests(TestSearchEngine & engine, m2::RectD const & viewport, string q
        << " (std. dev. " << stdDevTime << "s)" << endl;
 }
 
+struct LatencyPercentiles
+{
+  double m_p50 = 0;
+  double m_p95 = 0;
+  double m_p99 = 0;
+  double m_max = 0;
+};
+
+// Nearest-rank percentiles.
+LatencyPercentiles CalcPercentiles(vector<double> values)
+{
+  LatencyPercentiles res;
+  if (values.empty())
+    return res;
+
+  sort(values.begin(), values.end());
+  auto const percentile = [&values](double p) {
+    auto const rank = static_cast<size_t>(ceil(p * static_cast<double>(values.size())));
+    return values[min(max<size_t>(rank, 1), values.size()) - 1];
+  };
+  res.m_p50 = percentile(0.5);
+  res.m_p95 = percentile(0.95);
+  res.m_p99 = percentile(0.99);
+  res.m_max = values.back();
+  return res;
+}
+
+base::JSONPtr ToJSON(LatencyPercentiles const & percentiles)
+{
+  auto root = base::NewJSONObject();
+  ToJSONObject(*root, "p50", percentiles.m_p50);
+  ToJSONObject(*root, "p95", percentiles.m_p95);
+  ToJSONObject(*root, "p99", percentiles.m_p99);
+  ToJSONObject(*root, "max", percentiles.m_max);
+  return root;
+}
+
+double ToMs(steady_clock::duration d) { return duration<double, milli>(d).count(); }
+
+// Returns false when any of the latency percentiles of |report| is worse than in |baseline| by
+// more than |maxRegression|.
+bool CheckLatencyRegression(json_t * report, string const & baselinePath, double maxRegression)
+{
+  string baselineStr;
+  {
+    ifstream stream(baselinePath);
+    CHECK(stream.is_open(), ("Can't open", baselinePath));
+    baselineStr.assign(istreambuf_iterator<char>(stream), istreambuf_iterator<char>());
+  }
+  base::Json const baseline(baselineStr);
+
+  auto * current = base::GetJSONObligatoryField(report, "latency_ms");
+  auto * previous = base::GetJSONObligatoryField(baseline.get(), "latency_ms");
+
+  bool ok = true;
+  for (auto const * field : {"p50", "p95", "p99"})
+  {
+    double currentMs = 0;
+    double previousMs = 0;
+    FromJSONObject(current, field, currentMs);
+    FromJSONObject(previous, field, previousMs);
+    if (currentMs > previousMs * (1.0 + maxRegression))
+    {
+      LOG(LERROR, ("Latency regression,", field, "is", currentMs, "ms, baseline is", previousMs,
+                   "ms."));
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+// Replays the queries in parallel and reports per-query latencies and the times of the search
+// phases. Returns the exit code of the tool.
+int RunLatencyBenchmark(TestSearchEngine & engine, m2::RectD const & viewport, string queriesPath,
+                        string const & locale, string const & reportPath,
+                        string const & baselinePath, double maxRegression)
+{
+  vector<string> queries;
+  {
+    if (queriesPath.empty())
+      queriesPath = base::JoinPath(GetPlatform().WritableDir(), kDefaultQueriesPathSuffix);
+    ReadStringsFromFile(queriesPath, queries);
+  }
+
+  vector<unique_ptr<TestSearchRequest>> requests;
+  vector<shared_ptr<QueryStats>> stats;
+  for (auto const & query : queries)
+  {
+    requests.emplace_back(make_unique<TestSearchRequest>(engine, MakePrefixFree(query), locale,
+                                                         Mode::Everywhere, viewport));
+    stats.emplace_back(make_shared<QueryStats>());
+    requests.back()->SetStats(stats.back());
+  }
+
+  // Requests are queued at once and the engine processes them on all its threads. Response
+  // time is measured from the start of the processing, so the time in the queue is not counted.
+  for (auto & request : requests)
+    request->Start();
+  for (auto & request : requests)
+    request->Wait();
+
+  size_t constexpr kPhasesCount = static_cast<size_t>(QueryStats::Phase::Count);
+  vector<double> latencies;
+  array<vector<double>, kPhasesCount> phaseTimes;
+  auto perQuery = base::NewJSONArray();
+  for (size_t i = 0; i < requests.size(); ++i)
+  {
+    auto const latency = ToMs(requests[i]->ResponseTime());
+    latencies.push_back(latency);
+
+    auto query = base::NewJSONObject();
+    ToJSONObject(*query, "query", queries[i]);
+    ToJSONObject(*query, "latency_ms", latency);
+    auto phases = base::NewJSONObject();
+    for (size_t p = 0; p < kPhasesCount; ++p)
+    {
+      auto const phase = static_cast<QueryStats::Phase>(p);
+      auto const time = ToMs(stats[i]->GetTime(phase));
+      phaseTimes[p].push_back(time);
+      ToJSONObject(*phases, DebugPrint(phase), time);
+    }
+    ToJSONObject(*query, "phases_ms", move(phases));
+    ToJSONObject(*query, "retrieved_features", stats[i]->GetRetrievedFeatures());
+    ToJSONObject(*query, "loaded_features", stats[i]->GetLoadedFeatures());
+    ToJSONArray(*perQuery, query);
+  }
+
+  auto report = base::NewJSONObject();
+  ToJSONObject(*report, "queries", queries.size());
+  ToJSONObject(*report, "threads", engine.GetEngine().GetNumThreads());
+  ToJSONObject(*report, "latency_ms", ToJSON(CalcPercentiles(latencies)));
+  auto phases = base::NewJSONObject();
+  for (size_t p = 0; p < kPhasesCount; ++p)
+  {
+    ToJSONObject(*phases, DebugPrint(static_cast<QueryStats::Phase>(p)),
+                 ToJSON(CalcPercentiles(phaseTimes[p])));
+  }
+  ToJSONObject(*report, "phases_ms", move(phases));
+  ToJSONObject(*report, "per_query", move(perQuery));
+
+  if (!reportPath.empty())
+  {
+    ofstream stream(reportPath);
+    CHECK(stream.is_open(), ("Can't open", reportPath));
+    stream << base::DumpToString(report, JSON_INDENT(2)) << endl;
+  }
+
+  auto const percentiles = CalcPercentiles(latencies);
+  cout << fixed << setprecision(3);
+  cout << "Queries: " << queries.size() << endl;
+  cout << "Latency p50: " << percentiles.m_p50 << "ms, p95: " << percentiles.m_p95
+       << "ms, p99: " << percentiles.m_p99 << "ms, max: " << percentiles.m_max << "ms" << endl;
+
+  if (!baselinePath.empty() && !CheckLatencyRegression(report.get(), baselinePath, maxRegression))
+    return 1;
+  return 0;
+}
+
 int main(int argc, char * argv[])
 {
   platform::tests_support::ChangeMaxNumberOfOpenFiles(kMaxOpenFiles);
@@ -399,6 +569,13 @@ int main(int argc, char * argv[])
     return 0;
   }
 
+  if (!FLAGS_latency_report.empty() || !FLAGS_latency_baseline.empty())
+  {
+    return RunLatencyBenchmark(*engine, viewport, FLAGS_queries_path, FLAGS_locale,
+                               FLAGS_latency_report, FLAGS_latency_baseline,
+                               FLAGS_max_latency_regression);
+  }
+
   RunRequests(*engine, viewport, FLAGS_queries_path, FLAGS_locale, FLAGS_ranking_csv_file,
               static_cast<size_t>(FLAGS_top));
   return 0;
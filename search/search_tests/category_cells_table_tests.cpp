@@ -0,0 +1,82 @@
+#include "testing/testing.hpp"
+
+#include "search/category_cells_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+unique_ptr<CategoryCellsTable> Build(CategoryCellsTableBuilder const & builder, string & buffer)
+{
+  buffer.clear();
+  {
+    MemWriter<string> writer(buffer);
+    builder.Freeze(writer);
+  }
+  auto table = CategoryCellsTable::Load(make_unique<MemReader>(buffer.data(), buffer.size()));
+  TEST(table, ());
+  return table;
+}
+
+UNIT_TEST(CategoryCellsTable_Smoke)
+{
+  uint32_t const kCafe = 1;
+  uint32_t const kBank = 2;
+
+  auto const moscow = mercator::FromLatLon(55.7558, 37.6173);
+  auto const moscowNear = mercator::FromLatLon(55.7560, 37.6180);
+  auto const london = mercator::FromLatLon(51.5074, -0.1278);
+
+  CategoryCellsTableBuilder builder;
+  builder.Put(kCafe, moscow, 10);
+  builder.Put(kCafe, moscowNear, 3);
+  builder.Put(kCafe, london, 7);
+  builder.Put(kBank, moscow, 10);
+  // Repeated ids of the same cell are stored once.
+  builder.Put(kBank, moscow, 10);
+
+  string buffer;
+  auto const table = Build(builder, buffer);
+  TEST_EQUAL(table->GetCellsDepth(), CategoryCellsTableBuilder::kDefaultCellsDepth, ());
+  TEST(table->HasType(kCafe), ());
+  TEST(table->HasType(kBank), ());
+  TEST(!table->HasType(3), ());
+
+  auto const moscowRect = mercator::RectByCenterXYAndSizeInMeters(moscow, 1000 /* size */);
+  TEST_EQUAL(table->GetFeatures(kCafe, moscowRect), vector<uint32_t>({3, 10}), ());
+  TEST_EQUAL(table->GetFeatures(kBank, moscowRect), vector<uint32_t>({10}), ());
+  TEST(table->GetFeatures(3, moscowRect).empty(), ());
+
+  auto const londonRect = mercator::RectByCenterXYAndSizeInMeters(london, 1000 /* size */);
+  TEST_EQUAL(table->GetFeatures(kCafe, londonRect), vector<uint32_t>({7}), ());
+  TEST(table->GetFeatures(kBank, londonRect).empty(), ());
+
+  m2::RectD europe(mercator::FromLatLon(50.0, -1.0), mercator::FromLatLon(56.0, 38.0));
+  TEST_EQUAL(table->GetFeatures(kCafe, europe), vector<uint32_t>({3, 7, 10}), ());
+
+  m2::RectD ocean(mercator::FromLatLon(-10.0, -30.0), mercator::FromLatLon(-5.0, -20.0));
+  TEST(table->GetFeatures(kCafe, ocean).empty(), ());
+}
+
+UNIT_TEST(CategoryCellsTable_Empty)
+{
+  CategoryCellsTableBuilder builder;
+  string buffer;
+  auto const table = Build(builder, buffer);
+  TEST(!table->HasType(1), ());
+  TEST(table->GetFeatures(1, mercator::Bounds::FullRect()).empty(), ());
+}
+}  // namespace
@@ -0,0 +1,84 @@
+#include "testing/testing.hpp"
+
+#include "search/completions_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+using Completion = CompletionsTable::Completion;
+
+strings::UniString MakeUni(string const & s) { return strings::MakeUniString(s); }
+
+unique_ptr<CompletionsTable> Build(CompletionsTableBuilder const & builder, string & buffer)
+{
+  buffer.clear();
+  {
+    MemWriter<string> writer(buffer);
+    builder.Freeze(writer);
+  }
+  auto table = CompletionsTable::Load(make_unique<MemReader>(buffer.data(), buffer.size()));
+  TEST(table, ());
+  return table;
+}
+
+UNIT_TEST(CompletionsTable_Smoke)
+{
+  CompletionsTableBuilder builder(2 /* maxPrefixLength */, 3 /* maxCompletions */);
+  builder.Put(MakeUni("moscow"), 10);
+  builder.Put(MakeUni("mosque"), 3);
+  builder.Put(MakeUni("mall"), 5);
+  builder.Put(MakeUni("market"), 5);
+  builder.Put(MakeUni("museum"), 1);
+  // Weights of the same word are summed up.
+  builder.Put(MakeUni("museum"), 1);
+
+  string buffer;
+  auto const table = Build(builder, buffer);
+  TEST_EQUAL(table->GetMaxPrefixLength(), 2, ());
+
+  // Only the heaviest words are kept, the words of the same weight go alphabetically.
+  {
+    vector<Completion> const expected = {
+        {MakeUni("moscow"), 10}, {MakeUni("mall"), 5}, {MakeUni("market"), 5}};
+    TEST_EQUAL(table->Get(MakeUni("m")), expected, ());
+  }
+  {
+    vector<Completion> const expected = {{MakeUni("moscow"), 10}, {MakeUni("mosque"), 3}};
+    TEST_EQUAL(table->Get(MakeUni("mo")), expected, ());
+  }
+
+  // Longer prefixes are filtered out of the completions of their beginnings.
+  {
+    vector<Completion> const expected = {{MakeUni("mosque"), 3}};
+    TEST_EQUAL(table->Get(MakeUni("mosq")), expected, ());
+  }
+  {
+    vector<Completion> const expected = {{MakeUni("museum"), 2}};
+    TEST_EQUAL(table->Get(MakeUni("mu")), expected, ());
+  }
+
+  TEST(table->Get(MakeUni("")).empty(), ());
+  TEST(table->Get(MakeUni("x")).empty(), ());
+  TEST(table->Get(MakeUni("mz")).empty(), ());
+}
+
+UNIT_TEST(CompletionsTable_Empty)
+{
+  CompletionsTableBuilder builder;
+  string buffer;
+  auto const table = Build(builder, buffer);
+  TEST(table->Get(MakeUni("a")).empty(), ());
+}
+}  // namespace
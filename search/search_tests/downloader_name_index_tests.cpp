@@ -0,0 +1,60 @@
+#include "testing/testing.hpp"
+
+#include "search/downloader_name_index.hpp"
+
+#include "storage/downloader_search_params.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+vector<string> Search(DownloaderNameIndex const & index, string const & query,
+                      size_t maxCount = 10)
+{
+  vector<storage::DownloaderSearchResult> results;
+  index.Search(query, maxCount, results);
+
+  vector<string> countryIds;
+  for (auto const & r : results)
+    countryIds.push_back(r.m_countryId);
+  return countryIds;
+}
+
+UNIT_TEST(DownloaderNameIndex_Smoke)
+{
+  DownloaderNameIndex index;
+  TEST(index.IsEmpty(), ());
+
+  index.Add("Bosnia and Herzegovina", "Bosnia and Herzegovina");
+  index.Add("USA_New York", "New York");
+  index.Add("Netherlands", "Nederland");
+  index.Add("Belarus", "Беларусь");
+  // Disputed territories are in the tree twice.
+  index.Add("Crimea", "Crimea");
+  index.Add("Crimea", "Crimea");
+  index.Build();
+  TEST(!index.IsEmpty(), ());
+
+  TEST_EQUAL(Search(index, "bosnia"), vector<string>({"Bosnia and Herzegovina"}), ());
+  TEST_EQUAL(Search(index, "Herz"), vector<string>({"Bosnia and Herzegovina"}), ());
+  TEST_EQUAL(Search(index, "and herz"), vector<string>({"Bosnia and Herzegovina"}), ());
+  TEST_EQUAL(Search(index, "new york"), vector<string>({"USA_New York"}), ());
+  TEST_EQUAL(Search(index, "БЕЛ"), vector<string>({"Belarus"}), ());
+  TEST_EQUAL(Search(index, "crimea"), vector<string>({"Crimea"}), ());
+  TEST(Search(index, "york new").empty(), ());
+  TEST(Search(index, "erland").empty(), ());
+  TEST(Search(index, "  ").empty(), ());
+
+  // The names starting with the query go first.
+  TEST_EQUAL(Search(index, "n"), vector<string>({"USA_New York", "Netherlands"}), ());
+  TEST_EQUAL(Search(index, "n", 1 /* maxCount */), vector<string>({"USA_New York"}), ());
+
+  index.Clear();
+  TEST(index.IsEmpty(), ());
+  TEST(Search(index, "bosnia").empty(), ());
+}
+}  // namespace
@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <iterator>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace search_base;
@@ -110,4 +111,34 @@ UNIT_CLASS_TEST(MemSearchIndexTest, Smoke)
   Erase(kHamlet, hamlet);
   TEST_EQUAL(StrictQuery("question", "en"), vector<Id>{}, ());
 }
+
+UNIT_CLASS_TEST(MemSearchIndexTest, AddEraseMany)
+{
+  vector<pair<Id, Doc>> docs;
+  for (Id id = 100; id > 0; --id)
+    docs.emplace_back(id, Doc(id % 2 == 0 ? "green cafe" : "red cafe", "en"));
+  m_index.Add(docs);
+
+  // Ids were added in the decreasing order and must be sorted in the posting lists.
+  auto const all = StrictQuery("cafe", "en");
+  TEST_EQUAL(all.size(), 100, ());
+  TEST(is_sorted(all.begin(), all.end()), ());
+  TEST_EQUAL(StrictQuery("green", "en").size(), 50, ());
+
+  vector<pair<Id, Doc>> const green = {{Id{2}, Doc("green cafe", "en")},
+                                       {Id{4}, Doc("green cafe", "en")}};
+  m_index.Erase(green);
+  TEST_EQUAL(StrictQuery("green", "en").size(), 48, ());
+  TEST_EQUAL(StrictQuery("cafe", "en").size(), 98, ());
+
+  // Single and bulk changes may be mixed.
+  Erase(1, Doc("red cafe", "en"));
+  Add(1000, Doc("green house", "en"));
+  TEST_EQUAL(StrictQuery("red", "en").size(), 49, ());
+  TEST_EQUAL(StrictQuery("green", "en").size(), 49, ());
+
+  m_index.Erase(docs);
+  TEST_EQUAL(StrictQuery("cafe", "en"), vector<Id>{}, ());
+  TEST_EQUAL(StrictQuery("green", "en"), vector<Id>({1000}), ());
+}
 }  // namespace
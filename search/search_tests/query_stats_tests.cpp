@@ -0,0 +1,68 @@
+#include "testing/testing.hpp"
+
+#include "search/query_stats.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace search;
+using namespace std::chrono;
+using namespace std;
+
+namespace
+{
+using Phase = QueryStats::Phase;
+
+void Sleep() { this_thread::sleep_for(milliseconds(10)); }
+
+UNIT_TEST(QueryStats_NestedPhases)
+{
+  QueryStats stats;
+  auto const start = steady_clock::now();
+  {
+    QueryStats::ScopedPhase geocoding(&stats, Phase::Geocoding);
+    Sleep();
+    {
+      QueryStats::ScopedPhase retrieval(&stats, Phase::Retrieval);
+      Sleep();
+    }
+    {
+      QueryStats::ScopedPhase preRanking(&stats, Phase::PreRanking);
+      Sleep();
+      QueryStats::ScopedPhase ranking(&stats, Phase::Ranking);
+      Sleep();
+    }
+  }
+  auto const total = steady_clock::now() - start;
+
+  steady_clock::duration sum{};
+  for (auto const phase : {Phase::Geocoding, Phase::Retrieval, Phase::PreRanking, Phase::Ranking})
+  {
+    TEST(stats.GetTime(phase) >= milliseconds(10), (phase));
+    sum += stats.GetTime(phase);
+  }
+  TEST(stats.GetTime(Phase::Tokenization) == steady_clock::duration::zero(), ());
+  // Nested phases are not counted twice.
+  TEST(sum <= total, ());
+
+  // Phases are accumulated.
+  {
+    QueryStats::ScopedPhase retrieval(&stats, Phase::Retrieval);
+    Sleep();
+  }
+  TEST(stats.GetTime(Phase::Retrieval) >= milliseconds(20), ());
+}
+
+UNIT_TEST(QueryStats_Counters)
+{
+  QueryStats stats;
+  stats.AddRetrievedFeatures(10);
+  stats.AddRetrievedFeatures(5);
+  stats.AddLoadedFeatures(3);
+  TEST_EQUAL(stats.GetRetrievedFeatures(), 15, ());
+  TEST_EQUAL(stats.GetLoadedFeatures(), 3, ());
+
+  // Null stats are allowed.
+  QueryStats::ScopedPhase phase(nullptr, Phase::Ranking);
+}
+}  // namespace
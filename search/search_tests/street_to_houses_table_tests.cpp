@@ -0,0 +1,75 @@
+#include "testing/testing.hpp"
+
+#include "search/house_numbers_matcher.hpp"
+#include "search/street_to_houses_table.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace search;
+using namespace std;
+
+namespace
+{
+strings::UniString MakeUni(string const & s) { return strings::MakeUniString(s); }
+
+house_numbers::Token MakeKey(string const & query)
+{
+  vector<house_numbers::Token> parse;
+  house_numbers::ParseQuery(MakeUni(query), false /* queryIsPrefix */, parse);
+  TEST(!parse.empty(), (query));
+  return move(parse.front());
+}
+
+vector<uint32_t> GetHouses(StreetToHousesTable const & table, uint32_t streetId,
+                           string const & query)
+{
+  vector<uint32_t> houses;
+  table.ForEachHouse(streetId, MakeKey(query), [&](StreetToHousesTable::House const & house) {
+    houses.push_back(house.m_id);
+  });
+  return houses;
+}
+
+UNIT_TEST(StreetToHousesTable_Smoke)
+{
+  StreetToHousesTableBuilder builder;
+  builder.Put(10 /* streetId */, 1 /* houseId */, MakeUni("12"));
+  builder.Put(10 /* streetId */, 2 /* houseId */, MakeUni("12a"));
+  builder.Put(10 /* streetId */, 3 /* houseId */, MakeUni("14"));
+  builder.Put(10 /* streetId */, 4 /* houseId */, MakeUni("14;16"));
+  builder.Put(5 /* streetId */, 5 /* houseId */, MakeUni("12"));
+
+  string buffer;
+  {
+    MemWriter<string> writer(buffer);
+    builder.Freeze(writer);
+  }
+  auto const table = StreetToHousesTable::Load(make_unique<MemReader>(buffer.data(), buffer.size()));
+  TEST(table, ());
+
+  TEST_EQUAL(GetHouses(*table, 10, "12"), vector<uint32_t>({1, 2}), ());
+  TEST_EQUAL(GetHouses(*table, 10, "14"), vector<uint32_t>({3, 4}), ());
+  TEST_EQUAL(GetHouses(*table, 10, "16"), vector<uint32_t>({4}), ());
+  TEST_EQUAL(GetHouses(*table, 10, "18"), vector<uint32_t>(), ());
+  TEST_EQUAL(GetHouses(*table, 5, "12"), vector<uint32_t>({5}), ());
+  TEST_EQUAL(GetHouses(*table, 7, "12"), vector<uint32_t>(), ());
+
+  // The house with two house numbers is stored once for every number.
+  auto const houses = table->Get(10);
+  TEST_EQUAL(houses.size(), 5, ());
+  for (auto const & house : houses)
+  {
+    if (house.m_id == 4)
+      TEST_EQUAL(house.m_houseNumber, MakeUni("14;16"), ());
+  }
+  TEST(table->Get(11).empty(), ());
+}
+}  // namespace
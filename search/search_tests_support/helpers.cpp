@@ -11,9 +11,11 @@ using namespace std;
 
 namespace search
 {
-SearchTest::SearchTest()
+SearchTest::SearchTest() : SearchTest(Engine::Params{}) {}
+
+SearchTest::SearchTest(Engine::Params const & params)
   : m_scopedLog(LDEBUG)
-  , m_engine(m_dataSource, make_unique<storage::CountryInfoGetterForTesting>(), Engine::Params{})
+  , m_engine(m_dataSource, make_unique<storage::CountryInfoGetterForTesting>(), params)
 {
   SetViewport(mercator::Bounds::FullRect());
 }
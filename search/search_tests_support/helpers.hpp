@@ -23,6 +23,7 @@ public:
   using Rules = std::vector<Rule>;
 
   SearchTest();
+  explicit SearchTest(Engine::Params const & params);
   ~SearchTest() override = default;
 
   // Registers country in internal records. Note that physical country
@@ -30,6 +30,8 @@ public:
 
   storage::CountryInfoGetter & GetCountryInfoGetter() { return *m_infoGetter; }
 
+  search::Engine & GetEngine() { return m_engine; }
+
 private:
   std::unique_ptr<storage::CountryInfoGetter> m_infoGetter;
   search::Engine m_engine;
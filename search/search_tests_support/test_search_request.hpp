@@ -9,6 +9,7 @@
 
 #include <chrono>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -45,6 +46,10 @@ public:
   std::chrono::steady_clock::duration ResponseTime() const;
   std::vector<search::Result> const & Results() const;
 
+  // Collects the times of the phases and the counters of the query into |stats|.
+  // Call it before Start().
+  void SetStats(std::shared_ptr<QueryStats> const & stats) { m_params.m_stats = stats; }
+
 protected:
   TestSearchRequest(TestSearchEngine & engine, std::string const & query,
                     std::string const & locale, Mode mode, m2::RectD const & viewport,
@@ -0,0 +1,191 @@
+#include "search/street_to_houses_table.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/read_write_utils.hpp"
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include "defines.hpp"
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+
+using namespace std;
+
+namespace search
+{
+namespace
+{
+// Size of an entry of the index of the streets.
+uint64_t constexpr kIndexEntrySize = 2 * sizeof(uint32_t);
+
+bool Less(StreetToHousesTable::House const & lhs, StreetToHousesTable::House const & rhs)
+{
+  return tie(lhs.m_key, lhs.m_id) < tie(rhs.m_key, rhs.m_id);
+}
+}  // namespace
+
+// StreetToHousesTable -----------------------------------------------------------------------------
+// static
+unique_ptr<StreetToHousesTable> StreetToHousesTable::Load(MwmValue const & value)
+{
+  if (!value.m_cont.IsExist(STREET_HOUSES_FILE_TAG))
+    return {};
+
+  try
+  {
+    auto reader = value.m_cont.GetReader(STREET_HOUSES_FILE_TAG);
+    return Load(reader.GetPtr()->CreateSubReader(0, reader.Size()));
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LWARNING, ("Can't read", STREET_HOUSES_FILE_TAG, "section of", value.m_cont.GetFileName(),
+                   ":", e.Msg()));
+  }
+  return {};
+}
+
+// static
+unique_ptr<StreetToHousesTable> StreetToHousesTable::Load(unique_ptr<Reader> reader)
+{
+  CHECK(reader, ());
+  NonOwningReaderSource source(*reader);
+
+  auto const version = static_cast<Version>(ReadPrimitiveFromSource<uint8_t>(source));
+  if (version > Version::Latest)
+  {
+    LOG(LWARNING, ("Unknown street to houses table version:", static_cast<int>(version)));
+    return {};
+  }
+
+  auto table = make_unique<StreetToHousesTable>();
+  table->m_numStreets = ReadPrimitiveFromSource<uint32_t>(source);
+  table->m_indexOffset = source.Pos();
+  table->m_dataOffset = table->m_indexOffset + kIndexEntrySize * table->m_numStreets;
+  if (table->m_dataOffset > reader->Size())
+  {
+    LOG(LWARNING, ("Corrupted street to houses table."));
+    return {};
+  }
+  table->m_reader = move(reader);
+  return table;
+}
+
+vector<StreetToHousesTable::House> StreetToHousesTable::Get(uint32_t streetId) const
+{
+  vector<House> houses;
+
+  // Binary search over the index, it's read by entries without loading of the whole index.
+  uint32_t lo = 0;
+  uint32_t hi = m_numStreets;
+  while (lo < hi)
+  {
+    uint32_t const mid = lo + (hi - lo) / 2;
+    auto const id = ReadPrimitiveFromPos<uint32_t>(*m_reader, m_indexOffset + kIndexEntrySize * mid);
+    if (id < streetId)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  auto const entry = m_indexOffset + kIndexEntrySize * lo;
+  if (lo == m_numStreets || ReadPrimitiveFromPos<uint32_t>(*m_reader, entry) != streetId)
+    return houses;
+
+  auto const offset = ReadPrimitiveFromPos<uint32_t>(*m_reader, entry + sizeof(uint32_t));
+  NonOwningReaderSource source(*m_reader);
+  source.SetPosition(m_dataOffset + offset);
+
+  auto const count = ReadVarUint<uint32_t>(source);
+  houses.resize(count);
+  string s;
+  for (auto & house : houses)
+  {
+    house.m_key.m_type =
+        static_cast<house_numbers::Token::Type>(ReadPrimitiveFromSource<uint8_t>(source));
+    rw::Read(source, s);
+    house.m_key.m_value = strings::MakeUniString(s);
+    house.m_id = ReadVarUint<uint32_t>(source);
+    rw::Read(source, s);
+    house.m_houseNumber = strings::MakeUniString(s);
+  }
+  return houses;
+}
+
+// StreetToHousesTableBuilder ----------------------------------------------------------------------
+void StreetToHousesTableBuilder::Put(uint32_t streetId, uint32_t houseId,
+                                     strings::UniString const & houseNumber)
+{
+  vector<vector<house_numbers::Token>> parses;
+  house_numbers::ParseHouseNumber(houseNumber, parses);
+
+  auto & houses = m_streets[streetId];
+  auto const begin = houses.size();
+  for (auto & parse : parses)
+  {
+    if (parse.empty())
+      continue;
+
+    StreetToHousesTable::House house;
+    house.m_key = move(parse.front());
+    house.m_id = houseId;
+    house.m_houseNumber = houseNumber;
+
+    auto const it = find_if(houses.begin() + begin, houses.end(), [&house](auto const & h) {
+      return h.m_key == house.m_key;
+    });
+    if (it == houses.end())
+      houses.push_back(move(house));
+  }
+}
+
+void StreetToHousesTableBuilder::Freeze(Writer & writer) const
+{
+  vector<string> data;
+  data.reserve(m_streets.size());
+  vector<StreetToHousesTable::House const *> houses;
+  for (auto const & entry : m_streets)
+  {
+    houses.clear();
+    for (auto const & house : entry.second)
+      houses.push_back(&house);
+    sort(houses.begin(), houses.end(), [](auto const * lhs, auto const * rhs) {
+      return Less(*lhs, *rhs);
+    });
+
+    string buffer;
+    MemWriter<string> dataWriter(buffer);
+    WriteVarUint(dataWriter, base::checked_cast<uint32_t>(houses.size()));
+    for (auto const * house : houses)
+    {
+      WriteToSink(dataWriter, static_cast<uint8_t>(house->m_key.m_type));
+      rw::Write(dataWriter, strings::ToUtf8(house->m_key.m_value));
+      WriteVarUint(dataWriter, house->m_id);
+      rw::Write(dataWriter, strings::ToUtf8(house->m_houseNumber));
+    }
+    data.push_back(move(buffer));
+  }
+
+  WriteToSink(writer, static_cast<uint8_t>(StreetToHousesTable::Version::Latest));
+  WriteToSink(writer, base::checked_cast<uint32_t>(m_streets.size()));
+  uint64_t offset = 0;
+  size_t i = 0;
+  for (auto const & entry : m_streets)
+  {
+    WriteToSink(writer, entry.first);
+    WriteToSink(writer, base::checked_cast<uint32_t>(offset));
+    offset += data[i++].size();
+  }
+  for (auto const & buffer : data)
+    writer.Write(buffer.data(), buffer.size());
+}
+}  // namespace search
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "search/house_numbers_matcher.hpp"
+
+#include "base/string_utils.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+class MwmValue;
+class Reader;
+class Writer;
+
+namespace search
+{
+// Houses of every street of an mwm. A house belongs to the street which is returned for it by
+// FeaturesLayerMatcher, i.e. to the street of its address or, when the house has no address
+// street, to the nearest street. The houses of a street are sorted by the first tokens of
+// the parses of their house numbers, the token a house number and a query must share
+// to match, see house_numbers::HouseNumbersMatch(). So the houses with a given number are
+// found without loading of the features and the geometry.
+//
+// Section format:
+//   u8 version
+//   u32 number of streets
+//   (u32 street id, u32 offset of the houses of the street from the end of the index)...
+//   houses of the streets
+// where the houses of a street are
+//   varuint number of houses
+//   (u8 key type, string key value, varuint house id, string house number)...
+class StreetToHousesTable
+{
+public:
+  enum class Version : uint8_t
+  {
+    V0 = 0,
+    Latest = V0
+  };
+
+  struct House
+  {
+    house_numbers::Token m_key;
+    uint32_t m_id = 0;
+    strings::UniString m_houseNumber;
+  };
+
+  // Returns nullptr if the mwm does not have the section.
+  static std::unique_ptr<StreetToHousesTable> Load(MwmValue const & value);
+  static std::unique_ptr<StreetToHousesTable> Load(std::unique_ptr<Reader> reader);
+
+  // Returns the houses of |streetId| sorted by their keys.
+  std::vector<House> Get(uint32_t streetId) const;
+
+  // Calls |fn| for the houses of |streetId| which have |key|.
+  template <typename Fn>
+  void ForEachHouse(uint32_t streetId, house_numbers::Token const & key, Fn && fn) const
+  {
+    auto const houses = Get(streetId);
+    auto const range =
+        std::equal_range(houses.begin(), houses.end(), key, [](auto const & lhs, auto const & rhs) {
+          return GetKey(lhs) < GetKey(rhs);
+        });
+    for (auto it = range.first; it != range.second; ++it)
+      fn(*it);
+  }
+
+private:
+  static house_numbers::Token const & GetKey(house_numbers::Token const & key) { return key; }
+  static house_numbers::Token const & GetKey(House const & house) { return house.m_key; }
+
+  std::unique_ptr<Reader> m_reader;
+  uint32_t m_numStreets = 0;
+  uint64_t m_indexOffset = 0;
+  uint64_t m_dataOffset = 0;
+};
+
+class StreetToHousesTableBuilder
+{
+public:
+  // Adds the house to the street. The house is stored once per every distinct first token of
+  // the parses of |houseNumber|.
+  void Put(uint32_t streetId, uint32_t houseId, strings::UniString const & houseNumber);
+
+  void Freeze(Writer & writer) const;
+
+private:
+  std::map<uint32_t, std::vector<StreetToHousesTable::House>> m_streets;
+};
+}  // namespace search
@@ -25,7 +25,7 @@ namespace storage
 {
 namespace
 {
-size_t const kInvalidId = std::numeric_limits<size_t>::max();
+size_t constexpr kInvalidId = std::numeric_limits<size_t>::max();
 }  // namespace
 
 // CountryInfoGetterBase ---------------------------------------------------------------------------
@@ -221,6 +221,15 @@ void CountryInfoReader::LoadRegionsFromDisk(size_t id, std::vector<m2::RegionD>
   }
 }
 
+void CountryInfoReader::BuildRegionsIndex(uint32_t gridSize)
+{
+  std::vector<std::vector<m2::RegionD>> regions(m_countries.size());
+  for (size_t id = 0; id < m_countries.size(); ++id)
+    LoadRegionsFromDisk(id, regions[id]);
+
+  m_regionsIndex = std::make_unique<CountryRegionsIndex>(std::move(regions), gridSize);
+}
+
 CountryInfoReader::CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countryR)
   : m_reader(polyR), m_cache(3 /* logCacheSize */)
 
@@ -245,10 +254,22 @@ void CountryInfoReader::ClearCachesImpl() const
   m_cache.Reset();
 }
 
+CountryInfoGetterBase::RegionId CountryInfoReader::FindFirstCountry(m2::PointD const & pt) const
+{
+  if (!m_regionsIndex)
+    return CountryInfoGetter::FindFirstCountry(pt);
+
+  static_assert(CountryRegionsIndex::kInvalidId == kInvalidId, "");
+  return m_regionsIndex->FindFirst(pt);
+}
+
 template <typename Fn>
 std::result_of_t<Fn(std::vector<m2::RegionD>)> CountryInfoReader::WithRegion(size_t id,
                                                                              Fn && fn) const
 {
+  if (m_regionsIndex)
+    return fn(m_regionsIndex->GetRegions(id));
+
   std::lock_guard<std::mutex> lock(m_cacheMutex);
 
   bool isFound = false;
@@ -265,6 +286,9 @@ bool CountryInfoReader::BelongsToRegion(m2::PointD const & pt, size_t id) const
   if (!m_countries[id].m_rect.IsPointInside(pt))
     return false;
 
+  if (m_regionsIndex)
+    return m_regionsIndex->Contains(id, pt);
+
   auto contains = [&pt](std::vector<m2::RegionD> const & regions) {
     for (auto const & region : regions)
     {
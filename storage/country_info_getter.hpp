@@ -2,6 +2,7 @@
 
 #include "storage/country.hpp"
 #include "storage/country_decl.hpp"
+#include "storage/country_regions_index.hpp"
 #include "storage/storage_defines.hpp"
 
 #include "platform/platform.hpp"
@@ -51,7 +52,7 @@ public:
 
 protected:
   // Returns identifier of the first country containing |pt| or |kInvalidId| if there is none.
-  RegionId FindFirstCountry(m2::PointD const & pt) const;
+  virtual RegionId FindFirstCountry(m2::PointD const & pt) const;
 
   // Returns true when |pt| belongs to the country identified by |id|.
   virtual bool BelongsToRegion(m2::PointD const & pt, size_t id) const = 0;
@@ -142,9 +143,18 @@ public:
   // Loads all regions for country number |id| from |m_reader|.
   void LoadRegionsFromDisk(size_t id, std::vector<m2::RegionD> & regions) const;
 
+  // Loads the regions of all countries into memory and builds CountryRegionsIndex over them.
+  // After that point and rect queries neither read the disk nor lock the regions cache.
+  // Takes much memory, so it's intended for servers. Must be called before the reader
+  // is shared between threads.
+  void BuildRegionsIndex(uint32_t gridSize = CountryRegionsIndex::kDefaultGridSize);
+
 protected:
   CountryInfoReader(ModelReaderPtr polyR, ModelReaderPtr countryR);
 
+  // CountryInfoGetterBase overrides:
+  RegionId FindFirstCountry(m2::PointD const & pt) const override;
+
   // CountryInfoGetter overrides:
   void ClearCachesImpl() const override;
   bool BelongsToRegion(m2::PointD const & pt, size_t id) const override;
@@ -157,6 +167,8 @@ protected:
   FilesContainerR m_reader;
   mutable base::Cache<uint32_t, std::vector<m2::RegionD>> m_cache;
   mutable std::mutex m_cacheMutex;
+
+  std::unique_ptr<CountryRegionsIndex> m_regionsIndex;
 };
 
 // This class allows users to get info about very simply rectangular
@@ -0,0 +1,200 @@
+#include "storage/country_regions_index.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace storage
+{
+namespace
+{
+// Border cells are found with this margin, so the points which m2::RegionD::Contains()
+// treats as lying on the border never get into a cell marked as inside or outside.
+double constexpr kBorderEps = 1e-7;
+}  // namespace
+
+CountryRegionsIndex::CountryRegionsIndex(std::vector<std::vector<m2::RegionD>> && regions,
+                                         uint32_t gridSize)
+  : m_regions(std::move(regions)), m_gridSize(gridSize)
+{
+  CHECK_GREATER(m_gridSize, 0, ());
+  CHECK_LESS_OR_EQUAL(m_gridSize, 1 << 15, ());
+  CHECK_LESS(m_regions.size(), std::numeric_limits<uint32_t>::max() >> 1, ());
+
+  for (auto const & countryRegions : m_regions)
+  {
+    for (auto const & region : countryRegions)
+      m_rect.Add(region.GetRect());
+  }
+
+  m_offsets.assign(static_cast<size_t>(m_gridSize) * m_gridSize + 1, 0);
+  if (!m_rect.IsValid())
+    return;
+
+  m_rect.Inflate(kBorderEps, kBorderEps);
+  m_cellWidth = m_rect.SizeX() / m_gridSize;
+  m_cellHeight = m_rect.SizeY() / m_gridSize;
+
+  // Cell number in the high half and the entry in the low half, so the sorted vector
+  // is ordered by cells and then by country ids.
+  std::vector<uint64_t> entries;
+  for (uint32_t id = 0; id < m_regions.size(); ++id)
+    AddCountry(id, entries);
+  std::sort(entries.begin(), entries.end());
+
+  m_entries.reserve(entries.size());
+  for (auto const e : entries)
+  {
+    ++m_offsets[(e >> 32) + 1];
+    m_entries.push_back(static_cast<uint32_t>(e));
+  }
+  for (size_t i = 1; i < m_offsets.size(); ++i)
+    m_offsets[i] += m_offsets[i - 1];
+}
+
+void CountryRegionsIndex::AddCountry(uint32_t id, std::vector<uint64_t> & entries) const
+{
+  auto const & countryRegions = m_regions[id];
+
+  m2::RectD rect;
+  for (auto const & region : countryRegions)
+    rect.Add(region.GetRect());
+  if (!rect.IsValid())
+    return;
+
+  uint32_t const minX = GetCellX(rect.minX() - kBorderEps);
+  uint32_t const maxX = GetCellX(rect.maxX() + kBorderEps);
+  uint32_t const minY = GetCellY(rect.minY() - kBorderEps);
+  uint32_t const maxY = GetCellY(rect.maxY() + kBorderEps);
+  uint32_t const width = maxX - minX + 1;
+  uint32_t const height = maxY - minY + 1;
+
+  // Marks the cells crossed by the edges. Every edge is cut into pieces not longer than a cell,
+  // and all the cells touched by the bounding rect of a piece are marked.
+  std::vector<bool> border(static_cast<size_t>(width) * height, false);
+  double const step = std::min(m_cellWidth, m_cellHeight);
+  auto const markPiece = [&](m2::PointD const & p1, m2::PointD const & p2) {
+    uint32_t const x1 = GetCellX(std::min(p1.x, p2.x) - kBorderEps);
+    uint32_t const x2 = GetCellX(std::max(p1.x, p2.x) + kBorderEps);
+    uint32_t const y1 = GetCellY(std::min(p1.y, p2.y) - kBorderEps);
+    uint32_t const y2 = GetCellY(std::max(p1.y, p2.y) + kBorderEps);
+    for (uint32_t y = y1; y <= y2; ++y)
+    {
+      for (uint32_t x = x1; x <= x2; ++x)
+        border[static_cast<size_t>(y - minY) * width + (x - minX)] = true;
+    }
+  };
+
+  for (auto const & region : countryRegions)
+  {
+    auto const & points = region.Data();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      auto const & p1 = points[i];
+      auto const & p2 = points[i + 1 == points.size() ? 0 : i + 1];
+      auto const pieces = std::max(1.0, std::ceil(p1.Length(p2) / step));
+      m2::PointD prev = p1;
+      for (double j = 1; j <= pieces; ++j)
+      {
+        m2::PointD const curr = j == pieces ? p2 : p1 + (p2 - p1) * (j / pieces);
+        markPiece(prev, curr);
+        prev = curr;
+      }
+    }
+  }
+
+  // All the cells of a row between two border cells are either inside or outside of the
+  // country together, so only one point of such a run is checked.
+  for (uint32_t y = minY; y <= maxY; ++y)
+  {
+    uint32_t x = minX;
+    while (x <= maxX)
+    {
+      uint64_t const rowStart = static_cast<uint64_t>(y) * m_gridSize;
+      uint64_t const entry = static_cast<uint64_t>(id) << 1;
+      if (border[static_cast<size_t>(y - minY) * width + (x - minX)])
+      {
+        entries.push_back(((rowStart + x) << 32) | entry);
+        ++x;
+        continue;
+      }
+
+      uint32_t end = x + 1;
+      while (end <= maxX && !border[static_cast<size_t>(y - minY) * width + (end - minX)])
+        ++end;
+
+      m2::PointD const center(m_rect.minX() + (x + 0.5) * m_cellWidth,
+                              m_rect.minY() + (y + 0.5) * m_cellHeight);
+      if (ContainsExact(id, center))
+      {
+        for (; x < end; ++x)
+          entries.push_back(((rowStart + x) << 32) | entry | kInsideBit);
+      }
+      x = end;
+    }
+  }
+}
+
+CountryRegionsIndex::RegionId CountryRegionsIndex::FindFirst(m2::PointD const & pt) const
+{
+  uint32_t const cell = GetCell(pt);
+  if (cell == kInvalidCell)
+    return kInvalidId;
+
+  for (uint32_t i = m_offsets[cell]; i < m_offsets[cell + 1]; ++i)
+  {
+    uint32_t const entry = m_entries[i];
+    RegionId const id = entry >> 1;
+    if ((entry & kInsideBit) != 0 || ContainsExact(id, pt))
+      return id;
+  }
+  return kInvalidId;
+}
+
+bool CountryRegionsIndex::Contains(RegionId id, m2::PointD const & pt) const
+{
+  uint32_t const cell = GetCell(pt);
+  if (cell == kInvalidCell)
+    return false;
+
+  for (uint32_t i = m_offsets[cell]; i < m_offsets[cell + 1]; ++i)
+  {
+    uint32_t const entry = m_entries[i];
+    if ((entry >> 1) == id)
+      return (entry & kInsideBit) != 0 || ContainsExact(id, pt);
+  }
+  return false;
+}
+
+bool CountryRegionsIndex::ContainsExact(RegionId id, m2::PointD const & pt) const
+{
+  for (auto const & region : m_regions[id])
+  {
+    if (region.Contains(pt))
+      return true;
+  }
+  return false;
+}
+
+uint32_t CountryRegionsIndex::GetCell(m2::PointD const & pt) const
+{
+  if (m_entries.empty() || !m_rect.IsPointInside(pt))
+    return kInvalidCell;
+  return GetCellY(pt.y) * m_gridSize + GetCellX(pt.x);
+}
+
+uint32_t CountryRegionsIndex::GetCellX(double x) const
+{
+  auto const cell = std::floor((x - m_rect.minX()) / m_cellWidth);
+  return static_cast<uint32_t>(base::Clamp(cell, 0.0, static_cast<double>(m_gridSize - 1)));
+}
+
+uint32_t CountryRegionsIndex::GetCellY(double y) const
+{
+  auto const cell = std::floor((y - m_rect.minY()) / m_cellHeight);
+  return static_cast<uint32_t>(base::Clamp(cell, 0.0, static_cast<double>(m_gridSize - 1)));
+}
+}  // namespace storage
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace storage
+{
+// In-memory uniform grid over the polygons of all countries. Every cell of the grid keeps
+// the countries it touches, and every such country is marked as either covering the cell
+// completely or crossing it by its border. Only the border cells need the exact polygon test,
+// so most point queries are answered by a single cell lookup.
+// The index is immutable after construction, so it may be queried from several threads
+// without any locks.
+class CountryRegionsIndex
+{
+public:
+  using RegionId = size_t;
+
+  static RegionId constexpr kInvalidId = std::numeric_limits<RegionId>::max();
+  static uint32_t constexpr kDefaultGridSize = 1024;
+
+  // |regions[id]| are the polygons of the country |id|. The grid has |gridSize| x |gridSize|
+  // cells and covers the bounding rect of all polygons.
+  explicit CountryRegionsIndex(std::vector<std::vector<m2::RegionD>> && regions,
+                               uint32_t gridSize = kDefaultGridSize);
+
+  // Returns the smallest id of a country containing |pt| or |kInvalidId| if there is none.
+  RegionId FindFirst(m2::PointD const & pt) const;
+
+  // Returns true when |pt| belongs to the country |id|.
+  bool Contains(RegionId id, m2::PointD const & pt) const;
+
+  std::vector<m2::RegionD> const & GetRegions(RegionId id) const { return m_regions[id]; }
+  size_t GetCountriesCount() const { return m_regions.size(); }
+
+private:
+  // The lowest bit of an entry is set when the country covers the whole cell,
+  // the rest of the bits hold the country id.
+  static uint32_t constexpr kInsideBit = 1;
+
+  void AddCountry(uint32_t id, std::vector<uint64_t> & entries) const;
+
+  bool ContainsExact(RegionId id, m2::PointD const & pt) const;
+
+  // Returns the cell of |pt| or |kInvalidCell| when |pt| is outside of the grid.
+  uint32_t GetCell(m2::PointD const & pt) const;
+  uint32_t GetCellX(double x) const;
+  uint32_t GetCellY(double y) const;
+
+  static uint32_t constexpr kInvalidCell = std::numeric_limits<uint32_t>::max();
+
+  std::vector<std::vector<m2::RegionD>> m_regions;
+
+  m2::RectD m_rect;
+  uint32_t m_gridSize = 0;
+  double m_cellWidth = 0.0;
+  double m_cellHeight = 0.0;
+
+  // Entries of the cell |c| are m_entries[m_offsets[c]] ... m_entries[m_offsets[c + 1] - 1],
+  // ordered by the country id.
+  std::vector<uint32_t> m_offsets;
+  std::vector<uint32_t> m_entries;
+};
+}  // namespace storage
@@ -83,7 +83,7 @@ public:
       countryFile.SetSha1(mapSha1);
       country.SetFile(countryFile);
     }
-    return &m_countries.AddAtDepth(depth, country);
+    return &m_countries.AddAtDepth(depth, move(country));
   }
 
   void InsertOldMwmMapping(CountryId const & newId, CountryId const & oldId) override
@@ -171,13 +171,13 @@ public:
 
 // CountryTree::Node -------------------------------------------------------------------------------
 
-CountryTree::Node * CountryTree::Node::AddAtDepth(size_t level, Country const & value)
+CountryTree::Node * CountryTree::Node::AddAtDepth(size_t level, Country value)
 {
   Node * node = this;
   while (--level > 0 && !node->m_children.empty())
     node = node->m_children.back().get();
   ASSERT_EQUAL(level, 0, ());
-  return node->Add(value);
+  return node->Add(move(value));
 }
 
 CountryTree::Node const & CountryTree::Node::Parent() const
@@ -253,9 +253,9 @@ void CountryTree::Node::ForEachAncestorExceptForTheRoot(
   m_parent->ForEachAncestorExceptForTheRoot(f);
 }
 
-CountryTree::Node * CountryTree::Node::Add(Country const & value)
+CountryTree::Node * CountryTree::Node::Add(Country value)
 {
-  m_children.emplace_back(std::make_unique<Node>(value, this));
+  m_children.emplace_back(std::make_unique<Node>(move(value), this));
   return m_children.back().get();
 }
 
@@ -273,22 +273,22 @@ CountryTree::Node & CountryTree::GetRoot()
   return *m_countryTree;
 }
 
-Country & CountryTree::AddAtDepth(size_t level, Country const & value)
+Country & CountryTree::AddAtDepth(size_t level, Country value)
 {
   Node * added = nullptr;
   if (level == 0)
   {
     ASSERT(IsEmpty(), ());
-    m_countryTree = std::make_unique<Node>(value, nullptr);  // Creating the root node.
+    m_countryTree = std::make_unique<Node>(move(value), nullptr);  // Creating the root node.
     added = m_countryTree.get();
   }
   else
   {
-    added = m_countryTree->AddAtDepth(level, value);
+    added = m_countryTree->AddAtDepth(level, move(value));
   }
 
   ASSERT(added, ());
-  m_countryTreeMap.insert(make_pair(value.Name(), added));
+  m_countryTreeMap.insert(make_pair(added->Value().Name(), added));
   return added->Value();
 }
 
@@ -401,12 +401,11 @@ MwmSubtreeAttrs LoadGroupImpl(size_t depth, json_t * node, CountryId const & par
   return make_pair(mwmCounter, mwmSize);
 }
 
-bool LoadCountriesImpl(string const & jsonBuffer, StoreInterface & store)
+bool LoadCountriesImpl(json_t * root, StoreInterface & store)
 {
   try
   {
-    base::Json root(jsonBuffer.c_str());
-    LoadGroupImpl(0 /* depth */, root.get(), kInvalidCountryId, store);
+    LoadGroupImpl(0 /* depth */, root, kInvalidCountryId, store);
     return true;
   }
   catch (base::Json::Exception const & e)
@@ -433,7 +432,7 @@ int64_t LoadCountriesFromBuffer(string const & jsonBuffer, CountryTree & countri
 
     StoreCountries store(countries, affiliations, countryNameSynonyms, mwmTopCityGeoIds,
                          mwmTopCountryGeoIds);
-    if (!LoadCountriesImpl(jsonBuffer, store))
+    if (!LoadCountriesImpl(root.get(), store))
       return -1;
   }
   catch (base::Json::Exception const & e)
@@ -466,7 +465,7 @@ void LoadCountryFile2CountryInfo(string const & jsonBuffer, map<string, CountryI
     FromJSONObjectOptionalField(root.get(), "v", version);
 
     StoreFile2Info store(id2info);
-    LoadCountriesImpl(jsonBuffer, store);
+    LoadCountriesImpl(root.get(), store);
   }
   catch (base::Json::Exception const & e)
   {
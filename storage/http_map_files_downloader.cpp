@@ -146,15 +146,18 @@ void HttpMapFilesDownloader::OnMapFileDownloaded(QueuedCountry const & queuedCou
 
   m_queue.PopFront();
 
-  queuedCountry.OnDownloadFinished(request.GetStatus());
-
+  auto const status = request.GetStatus();
+  auto const sha1Base64 = request.GetSha1Base64();
   m_request.reset();
 
-  if (!m_queue.IsEmpty())
-  {
+  // The next file is being downloaded while the finished one is checked and registered.
+  bool const hasNext = !m_queue.IsEmpty();
+  if (hasNext)
     Download();
-  }
-  else
+
+  queuedCountry.OnDownloadFinished(status, sha1Base64);
+
+  if (!hasNext && m_queue.IsEmpty())
   {
     for (auto const subscriber : m_subscribers)
       subscriber->OnFinishDownloading();
@@ -97,10 +97,11 @@ void QueuedCountry::OnDownloadProgress(downloader::Progress const & progress) co
     m_subscriber->OnDownloadProgress(*this, progress);
 }
 
-void QueuedCountry::OnDownloadFinished(downloader::DownloadStatus status) const
+void QueuedCountry::OnDownloadFinished(downloader::DownloadStatus status,
+                                       std::string const & sha1Base64) const
 {
   if (m_subscriber != nullptr)
-    m_subscriber->OnDownloadFinished(*this, status);
+    m_subscriber->OnDownloadFinished(*this, status, sha1Base64);
 }
 
 bool QueuedCountry::operator==(CountryId const & countryId) const
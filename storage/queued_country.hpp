@@ -31,7 +31,9 @@ public:
     virtual void OnCountryInQueue(QueuedCountry const & queuedCountry) = 0;
     virtual void OnStartDownloading(QueuedCountry const & queuedCountry) = 0;
     virtual void OnDownloadProgress(QueuedCountry const & queuedCountry, downloader::Progress const & progress) = 0;
-    virtual void OnDownloadFinished(QueuedCountry const & queuedCountry, downloader::DownloadStatus status) = 0;
+    virtual void OnDownloadFinished(QueuedCountry const & queuedCountry,
+                                    downloader::DownloadStatus status,
+                                    std::string const & sha1Base64) = 0;
   };
 
   QueuedCountry(platform::CountryFile const & countryFile, CountryId const & m_countryId,
@@ -53,7 +55,9 @@ public:
   void OnCountryInQueue() const;
   void OnStartDownloading() const;
   void OnDownloadProgress(downloader::Progress const & progress) const;
-  void OnDownloadFinished(downloader::DownloadStatus status) const;
+  // |sha1Base64| is the hash of the downloaded file when the downloader calculates it on the fly.
+  void OnDownloadFinished(downloader::DownloadStatus status,
+                          std::string const & sha1Base64 = {}) const;
 
   bool operator==(CountryId const & countryId) const;
 
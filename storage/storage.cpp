@@ -66,7 +66,10 @@ CountryTree::Node const & LeafNodeFromCountryId(CountryTree const & root,
   return *node;
 }
 
-bool ValidateIntegrity(LocalFilePtr mapLocalFile, string const & countryId, string const & source)
+// |sha1Base64| is the hash calculated while the map was being downloaded, when it's empty
+// the hash is calculated here.
+bool ValidateIntegrity(LocalFilePtr mapLocalFile, string const & countryId, string const & source,
+                       string const & sha1Base64)
 {
   int64_t const version = mapLocalFile->GetVersion();
 
@@ -74,8 +77,11 @@ bool ValidateIntegrity(LocalFilePtr mapLocalFile, string const & countryId, stri
   if (version < kMinSupportedVersion)
     return true;
 
-  if (mapLocalFile->ValidateIntegrity())
+  if (sha1Base64.empty() ? mapLocalFile->ValidateIntegrity()
+                         : sha1Base64 == mapLocalFile->GetCountryFile().GetSha1())
+  {
     return true;
+  }
 
   alohalytics::LogEvent("$MapIntegrityFailure",
                         alohalytics::TStringMap({{"mwm", countryId},
@@ -542,13 +548,13 @@ void Storage::DownloadCountry(CountryId const & countryId, MapFileType type)
   // country.
   if (!PreparePlaceForCountryFiles(GetCurrentDataVersion(), m_dataDir, countryFile))
   {
-    OnMapDownloadFinished(countryId, DownloadStatus::Failed, type);
+    OnMapDownloadFinished(countryId, DownloadStatus::Failed, type, string() /* sha1Base64 */);
     return;
   }
 
   if (IsFileDownloaded(GetFileDownloadPath(countryId, type), type))
   {
-    OnMapDownloadFinished(countryId, DownloadStatus::Completed, type);
+    OnMapDownloadFinished(countryId, DownloadStatus::Completed, type, string() /* sha1Base64 */);
     return;
   }
 
@@ -731,16 +737,21 @@ void Storage::OnDownloadProgress(QueuedCountry const & queuedCountry, Progress c
   ReportProgressForHierarchy(queuedCountry.GetCountryId(), progress);
 }
 
-void Storage::OnDownloadFinished(QueuedCountry const & queuedCountry, DownloadStatus status)
+void Storage::OnDownloadFinished(QueuedCountry const & queuedCountry, DownloadStatus status,
+                                 string const & sha1Base64)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
   m_downloadingCountries.erase(queuedCountry.GetCountryId());
 
-  OnMapDownloadFinished(queuedCountry.GetCountryId(), status, queuedCountry.GetFileType());
+  // The hash of a diff file is not the hash of the map it's applied to.
+  auto const type = queuedCountry.GetFileType();
+  OnMapDownloadFinished(queuedCountry.GetCountryId(), status, type,
+                        type == MapFileType::Map ? sha1Base64 : string());
 }
 
-void Storage::RegisterDownloadedFiles(CountryId const & countryId, MapFileType type)
+void Storage::RegisterDownloadedFiles(CountryId const & countryId, MapFileType type,
+                                      string const & sha1Base64)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
 
@@ -793,7 +804,8 @@ void Storage::RegisterDownloadedFiles(CountryId const & countryId, MapFileType t
   }
 
   static string const kSourceKey = "map";
-  if (m_integrityValidationEnabled && !ValidateIntegrity(localFile, countryId, kSourceKey))
+  if (m_integrityValidationEnabled &&
+      !ValidateIntegrity(localFile, countryId, kSourceKey, sha1Base64))
   {
     base::DeleteFileX(localFile->GetPath(MapFileType::Map));
     fn(false /* isSuccess */);
@@ -805,7 +817,7 @@ void Storage::RegisterDownloadedFiles(CountryId const & countryId, MapFileType t
 }
 
 void Storage::OnMapDownloadFinished(CountryId const & countryId, DownloadStatus status,
-                                    MapFileType type)
+                                    MapFileType type, string const & sha1Base64)
 {
   CHECK_THREAD_CHECKER(m_threadChecker, ());
   ASSERT(m_didDownload != nullptr, ("Storage::Init wasn't called"));
@@ -825,7 +837,7 @@ void Storage::OnMapDownloadFinished(CountryId const & countryId, DownloadStatus
   }
 
   m_justDownloaded.insert(countryId);
-  RegisterDownloadedFiles(countryId, type);
+  RegisterDownloadedFiles(countryId, type, sha1Base64);
 }
 
 CountryId Storage::FindCountryIdByFile(string const & name) const
@@ -1275,7 +1287,8 @@ void Storage::ApplyDiff(CountryId const & countryId, function<void(bool isSucces
         CHECK_THREAD_CHECKER(m_threadChecker, ());
         static string const kSourceKey = "diff";
         if (result == DiffApplicationResult::Ok && m_integrityValidationEnabled &&
-            !ValidateIntegrity(diffFile, diffFile->GetCountryName(), kSourceKey))
+            !ValidateIntegrity(diffFile, diffFile->GetCountryName(), kSourceKey,
+                               string() /* sha1Base64 */))
         {
           GetPlatform().RunTask(Platform::Thread::File,
             [path = diffFile->GetPath(MapFileType::Map)] { base::DeleteFileX(path); });
@@ -266,18 +266,20 @@ private:
   void OnStartDownloading(QueuedCountry const & queuedCountry) override;
   /// Called on the main thread by MapFilesDownloader when
   /// downloading of a map file succeeds/fails.
-  void OnDownloadFinished(QueuedCountry const & queuedCountry,
-                          downloader::DownloadStatus status) override;
+  /// |sha1Base64| is the hash of the file calculated while downloading or an empty string.
+  void OnDownloadFinished(QueuedCountry const & queuedCountry, downloader::DownloadStatus status,
+                          std::string const & sha1Base64) override;
 
   /// Periodically called on the main thread by MapFilesDownloader
   /// during the downloading process.
   void OnDownloadProgress(QueuedCountry const & queuedCountry,
                           downloader::Progress const & progress) override;
 
-  void RegisterDownloadedFiles(CountryId const & countryId, MapFileType type);
+  void RegisterDownloadedFiles(CountryId const & countryId, MapFileType type,
+                               std::string const & sha1Base64);
 
   void OnMapDownloadFinished(CountryId const & countryId, downloader::DownloadStatus status,
-                             MapFileType type);
+                             MapFileType type, std::string const & sha1Base64);
 
 public:
   ThreadChecker const & GetThreadChecker() const {return m_threadChecker;}
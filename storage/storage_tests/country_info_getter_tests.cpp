@@ -229,6 +229,88 @@ UNIT_TEST(CountryInfoGetter_RegionRects)
   }
 }
 
+UNIT_TEST(CountryRegionsIndex_Smoke)
+{
+  auto const makeRegion = [](vector<m2::PointD> && points) { return m2::RegionD(move(points)); };
+
+  vector<vector<m2::RegionD>> regions(4);
+  // A triangle.
+  regions[0].push_back(makeRegion({{0.0, 0.0}, {10.0, 0.0}, {0.0, 10.0}}));
+  // Two squares, the second one overlaps the triangle.
+  regions[1].push_back(makeRegion({{20.0, 0.0}, {30.0, 0.0}, {30.0, 10.0}, {20.0, 10.0}}));
+  regions[1].push_back(makeRegion({{2.0, 2.0}, {6.0, 2.0}, {6.0, 6.0}, {2.0, 6.0}}));
+  // regions[2] is empty.
+  // A concave polygon around the first square.
+  regions[3].push_back(makeRegion(
+      {{15.0, -5.0}, {35.0, -5.0}, {35.0, 15.0}, {15.0, 15.0}, {15.0, 5.0}, {25.0, 5.0},
+       {25.0, 4.0}, {15.0, 4.0}}));
+
+  auto const brute = regions;
+  auto const findFirst = [&brute](m2::PointD const & pt) {
+    for (size_t id = 0; id < brute.size(); ++id)
+    {
+      for (auto const & region : brute[id])
+      {
+        if (region.Contains(pt))
+          return id;
+      }
+    }
+    return CountryRegionsIndex::kInvalidId;
+  };
+
+  CountryRegionsIndex const index(move(regions), 16 /* gridSize */);
+  TEST_EQUAL(index.GetCountriesCount(), 4, ());
+
+  TEST_EQUAL(index.FindFirst({1.0, 1.0}), 0, ());
+  TEST_EQUAL(index.FindFirst({3.0, 3.0}), 0, ());
+  TEST(index.Contains(1, {3.0, 3.0}), ());
+  TEST_EQUAL(index.FindFirst({7.0, 7.0}), CountryRegionsIndex::kInvalidId, ());
+  TEST_EQUAL(index.FindFirst({21.0, 4.5}), 1, ());
+  TEST_EQUAL(index.FindFirst({16.0, 4.5}), CountryRegionsIndex::kInvalidId, ());
+  TEST_EQUAL(index.FindFirst({16.0, 6.0}), 3, ());
+  TEST_EQUAL(index.FindFirst({100.0, 100.0}), CountryRegionsIndex::kInvalidId, ());
+
+  mt19937 rng(0);
+  uniform_real_distribution<double> distr(-10.0, 40.0);
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    m2::PointD const pt(distr(rng), distr(rng));
+    TEST_EQUAL(index.FindFirst(pt), findFirst(pt), (pt));
+    for (size_t id = 0; id < brute.size(); ++id)
+    {
+      bool expected = false;
+      for (auto const & region : brute[id])
+        expected = expected || region.Contains(pt);
+      TEST_EQUAL(index.Contains(id, pt), expected, (pt, id));
+    }
+  }
+}
+
+UNIT_TEST(CountryInfoGetter_RegionsIndex)
+{
+  auto reader = CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  CHECK(reader != nullptr, ());
+  auto indexedReader = CountryInfoReader::CreateCountryInfoReader(GetPlatform());
+  CHECK(indexedReader != nullptr, ());
+  indexedReader->BuildRegionsIndex();
+
+  mt19937 rng(0);
+  auto const & countries = reader->GetCountries();
+  uniform_int_distribution<size_t> countryDistr(0, countries.size() - 1);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    auto const & rect = countries[countryDistr(rng)].m_rect;
+    uniform_real_distribution<double> xDistr(rect.minX(), rect.maxX());
+    uniform_real_distribution<double> yDistr(rect.minY(), rect.maxY());
+    m2::PointD const pt(xDistr(rng), yDistr(rng));
+    TEST_EQUAL(reader->GetRegionCountryId(pt), indexedReader->GetRegionCountryId(pt), (pt));
+  }
+
+  CountryInfo info;
+  indexedReader->GetRegionInfo(mercator::FromLatLon(53.9022651, 27.5618818), info);
+  TEST_EQUAL(info.m_name, "Belarus, Minsk Region", ());
+}
+
 // This is a test for consistency between data/countries.txt and data/packed_polygons.bin.
 UNIT_TEST(CountryInfoGetter_Countries_And_Polygons)
 {
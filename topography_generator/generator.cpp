@@ -14,7 +14,12 @@
 #include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -74,19 +79,99 @@ bool LoadTileProfiles(std::string const & fileName, std::set<std::string> & prof
   return true;
 }
 
+// LRU cache of SRTM tiles shared between the threads. Neighbouring tiles are processed by
+// different threads at about the same time, so a tile is loaded once for its neighbours.
+// Tiles evicted from the cache are freed when the last thread using them releases them.
+class SrtmTilesCache
+{
+public:
+  SrtmTilesCache(std::string const & srtmDir, size_t maxTilesCount)
+    : m_srtmDir(srtmDir), m_maxTilesCount(std::max(maxTilesCount, size_t{1}))
+  {}
+
+  using TileKey = std::pair<int32_t, int32_t>;
+
+  static TileKey GetKey(ms::LatLon const & pos)
+  {
+    return {static_cast<int32_t>(std::floor(pos.m_lat)),
+            static_cast<int32_t>(std::floor(pos.m_lon))};
+  }
+
+  std::shared_ptr<generator::SrtmTile const> GetTile(ms::LatLon const & pos)
+  {
+    auto const key = GetKey(pos);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto const it = m_tiles.find(key);
+      if (it != m_tiles.end())
+      {
+        m_lru.splice(m_lru.begin(), m_lru, it->second.m_lruIt);
+        return it->second.m_tile;
+      }
+    }
+
+    // Load the tile without the lock. Two threads may load the same tile concurrently,
+    // the second one just uses the already cached copy.
+    auto tile = std::make_shared<generator::SrtmTile>();
+    try
+    {
+      tile->Init(m_srtmDir, pos);
+    }
+    catch (RootException const & e)
+    {
+      LOG(LINFO, ("Can't init SRTM tile:", generator::SrtmTile::GetBase(pos), "reason:", e.Msg()));
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_tiles.find(key);
+    if (it != m_tiles.end())
+      return it->second.m_tile;
+
+    m_lru.push_front(key);
+    m_tiles.emplace(key, Entry{tile, m_lru.begin()});
+    if (m_tiles.size() > m_maxTilesCount)
+    {
+      m_tiles.erase(m_lru.back());
+      m_lru.pop_back();
+    }
+    return tile;
+  }
+
+private:
+  struct Entry
+  {
+    std::shared_ptr<generator::SrtmTile const> m_tile;
+    std::list<TileKey>::iterator m_lruIt;
+  };
+
+  std::string const m_srtmDir;
+  size_t const m_maxTilesCount;
+  std::mutex m_mutex;
+  // The most recently used tiles are in the front.
+  std::list<TileKey> m_lru;
+  std::map<TileKey, Entry> m_tiles;
+};
+
 class SrtmProvider : public ValuesProvider<Altitude>
 {
 public:
-  explicit SrtmProvider(std::string const & srtmDir):
-    m_srtmManager(srtmDir)
+  explicit SrtmProvider(SrtmTilesCache & tilesCache):
+    m_tilesCache(tilesCache)
   {}
 
   void SetPrefferedTile(ms::LatLon const & pos)
   {
-    m_preferredTile = &m_srtmManager.GetTile(pos);
+    m_preferredTile = &GetTile(pos);
     m_leftBottomOfPreferredTile = {std::floor(pos.m_lat), std::floor(pos.m_lon)};
   }
 
+  // Releases tiles used by the provider, they are held only while an isolines tile is processed.
+  void ReleaseTiles()
+  {
+    m_preferredTile = nullptr;
+    m_tiles.clear();
+  }
+
   Altitude GetValue(ms::LatLon const & pos) override
   {
     auto const alt = GetValueImpl(pos);
@@ -126,7 +211,16 @@ private:
       }
     }
 
-    return m_srtmManager.GetHeight(pos);
+    return GetTile(pos).GetHeight(pos);
+  }
+
+  generator::SrtmTile const & GetTile(ms::LatLon const & pos)
+  {
+    auto const key = SrtmTilesCache::GetKey(pos);
+    auto it = m_tiles.find(key);
+    if (it == m_tiles.end())
+      it = m_tiles.emplace(key, m_tilesCache.GetTile(pos)).first;
+    return *it->second;
   }
 
   Altitude GetMedianValue(ms::LatLon const & pos)
@@ -165,7 +259,8 @@ private:
     return kernel[kernel.size() / 2];
   }
 
-  generator::SrtmTileManager m_srtmManager;
+  SrtmTilesCache & m_tilesCache;
+  std::map<SrtmTilesCache::TileKey, std::shared_ptr<generator::SrtmTile const>> m_tiles;
   generator::SrtmTile const * m_preferredTile = nullptr;
   ms::LatLon m_leftBottomOfPreferredTile;
 };
@@ -236,52 +331,29 @@ private:
   IsOnBorderFn m_isOnBorderFn;
 };
 
+// Generates isolines for the tiles given one by one. One task is used per thread to reuse
+// its buffers between the tiles.
 class TileIsolinesTask
 {
 public:
-  TileIsolinesTask(int left, int bottom, int right, int top, std::string const & srtmDir,
+  TileIsolinesTask(std::string const & srtmDir, SrtmTilesCache & tilesCache,
                    TileIsolinesParams const * params, bool forceRegenerate)
     : m_strmDir(srtmDir)
-    , m_srtmProvider(srtmDir)
+    , m_srtmProvider(tilesCache)
     , m_params(params)
     , m_forceRegenerate(forceRegenerate)
   {
     CHECK(params != nullptr, ());
-    Init(left, bottom, right, top);
   }
 
-  TileIsolinesTask(int left, int bottom, int right, int top, std::string const & srtmDir,
+  TileIsolinesTask(std::string const & srtmDir, SrtmTilesCache & tilesCache,
                    TileIsolinesProfileParams const * profileParams, bool forceRegenerate)
     : m_strmDir(srtmDir)
-    , m_srtmProvider(srtmDir)
+    , m_srtmProvider(tilesCache)
     , m_profileParams(profileParams)
     , m_forceRegenerate(forceRegenerate)
   {
     CHECK(profileParams != nullptr, ());
-    Init(left, bottom, right, top);
-  }
-
-  void Do()
-  {
-    for (int lat = m_bottom; lat <= m_top; ++lat)
-    {
-      for (int lon = m_left; lon <= m_right; ++lon)
-        ProcessTile(lat, lon);
-    }
-  }
-
-private:
-  void Init(int left, int bottom, int right, int top)
-  {
-    CHECK(right >= -179 && right <= 180, (right));
-    CHECK(left >= -180 && left <= 179, (left));
-    CHECK(top >= -89 && top <= 90, (top));
-    CHECK(bottom >= -90 && bottom <= 89, (bottom));
-
-    m_left = left;
-    m_bottom = bottom;
-    m_right = right;
-    m_top = top;
   }
 
   void ProcessTile(int lat, int lon)
@@ -325,8 +397,11 @@ private:
     {
       ProcessTile(lat, lon, tileName, "none", *m_params);
     }
+    m_srtmProvider.ReleaseTiles();
   }
 
+private:
+
   void ProcessTile(int lat, int lon, std::string const & tileName, std::string const & profileName,
                    TileIsolinesParams const & params)
   {
@@ -346,12 +421,9 @@ private:
     if (!params.m_filters.empty() && (lat >= kAsterTilesLatTop || lat < kAsterTilesLatBottom))
     {
       // Filter tiles converted from ASTER, cause they are noisy enough.
-      std::vector<Altitude> filteredValues = FilterTile(params.m_filters,
-                                                        ms::LatLon(lat, lon),
-                                                        kArcSecondsInDegree,
-                                                        kArcSecondsInDegree + 1,
-                                                        m_srtmProvider);
-      RawAltitudesTile filteredProvider(filteredValues, lon, lat);
+      FilterTile(params.m_filters, ms::LatLon(lat, lon), kArcSecondsInDegree,
+                 kArcSecondsInDegree + 1, m_srtmProvider, m_filterBuffers, m_filteredValues);
+      RawAltitudesTile filteredProvider(m_filteredValues, lon, lat);
       GenerateSeamlessContours(lat, lon, params, filteredProvider, contours);
     }
     else
@@ -410,60 +482,50 @@ private:
     squares.GenerateContours(contours);
   }
 
-  int m_left;
-  int m_bottom;
-  int m_right;
-  int m_top;
   std::string m_strmDir;
   SrtmProvider m_srtmProvider;
+  FilterTileBuffers<Altitude> m_filterBuffers;
+  std::vector<Altitude> m_filteredValues;
   TileIsolinesParams const * m_params = nullptr;
   TileIsolinesProfileParams const * m_profileParams = nullptr;
   bool m_forceRegenerate;
   std::string m_debugId;
 };
 
+// Tiles are taken by the threads one by one from the common queue, so slow tiles don't hold up
+// the others. The queue is in rows order to let the threads process neighbouring tiles together
+// and share them in |tilesCache|, which holds up to |maxCachedTilesPerThread| tiles per thread.
 template <typename ParamsType>
 void RunGenerateIsolinesTasks(int left, int bottom, int right, int top,
                               std::string const & srtmPath, ParamsType const & params,
                               size_t threadsCount, size_t maxCachedTilesPerThread,
                               bool forceRegenerate)
 {
-  std::vector<std::unique_ptr<TileIsolinesTask>> tasks;
-
   CHECK_GREATER(right, left, ());
   CHECK_GREATER(top, bottom, ());
+  CHECK(right >= -179 && right <= 180, (right));
+  CHECK(left >= -180 && left <= 179, (left));
+  CHECK(top >= -89 && top <= 90, (top));
+  CHECK(bottom >= -90 && bottom <= 89, (bottom));
 
-  int tilesRowPerTask = top - bottom;
-  int tilesColPerTask = right - left;
+  auto const tilesColsCount = static_cast<size_t>(right - left);
+  auto const tilesCount = static_cast<size_t>(top - bottom) * tilesColsCount;
+  threadsCount = std::max(size_t{1}, std::min(threadsCount, tilesCount));
 
-  if (tilesRowPerTask * tilesColPerTask <= threadsCount)
-  {
-    tilesRowPerTask = 1;
-    tilesColPerTask = 1;
-  }
-  else
-  {
-    while (tilesRowPerTask * tilesColPerTask > maxCachedTilesPerThread)
-    {
-      if (tilesRowPerTask > tilesColPerTask)
-        tilesRowPerTask = (tilesRowPerTask + 1) / 2;
-      else
-        tilesColPerTask = (tilesColPerTask + 1) / 2;
-    }
-  }
+  SrtmTilesCache tilesCache(srtmPath, threadsCount * maxCachedTilesPerThread);
+  std::atomic<size_t> nextTile(0);
 
   base::thread_pool::computational::ThreadPool threadPool(threadsCount);
-
-  for (int lat = bottom; lat < top; lat += tilesRowPerTask)
+  for (size_t i = 0; i < threadsCount; ++i)
   {
-    int const topLat = std::min(lat + tilesRowPerTask - 1, top - 1);
-    for (int lon = left; lon < right; lon += tilesColPerTask)
-    {
-      int const rightLon = std::min(lon + tilesColPerTask - 1, right - 1);
-      auto task = std::make_unique<TileIsolinesTask>(lon, lat, rightLon, topLat, srtmPath, &params,
-                                                     forceRegenerate);
-      threadPool.SubmitWork([task = std::move(task)](){ task->Do(); });
-    }
+    threadPool.SubmitWork([&]() {
+      TileIsolinesTask task(srtmPath, tilesCache, &params, forceRegenerate);
+      for (auto tile = nextTile++; tile < tilesCount; tile = nextTile++)
+      {
+        task.ProcessTile(bottom + static_cast<int>(tile / tilesColsCount),
+                         left + static_cast<int>(tile % tilesColsCount));
+      }
+    });
   }
 }
 }  // namespace
@@ -625,6 +687,8 @@ void Generator::PackIsolinesForCountry(storage::CountryId const & countryId,
                    params.m_alitudesStepFactor, isolines);
       if (params.m_simplificationZoom > 0)
         SimplifyContours(params.m_simplificationZoom, isolines);
+      if (params.m_splittingZoom > 0)
+        SplitContoursByCells(params.m_splittingZoom, isolines);
 
       countryIsolines.m_minValue = std::min(isolines.m_minValue, countryIsolines.m_minValue);
       countryIsolines.m_maxValue = std::max(isolines.m_maxValue, countryIsolines.m_maxValue);
@@ -41,6 +41,7 @@ struct IsolinesPackingParams
 {
   size_t m_maxIsolineLength = 1000;
   int m_simplificationZoom = 17; // Value == 0 disables simplification.
+  int m_splittingZoom = 12; // Value == 0 disables splitting of isolines by cells.
   size_t m_alitudesStepFactor = 1;
   std::string m_isolinesTilesPath;
   std::string m_outputDir;
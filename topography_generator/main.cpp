@@ -39,6 +39,8 @@ DEFINE_string(isolines_path, "",
               "Custom isolines packing mode. Path to the directory with isolines tiles.");
 DEFINE_uint64(max_length, 1000, "Custom isolines packing mode. Isolines max length.");
 DEFINE_uint64(alt_step_factor, 1, "Custom isolines packing mode. Altitude step factor.");
+DEFINE_uint64(split_zoom, 12, "Custom isolines packing mode. Isolines are split on the borders "
+                              "of the tiles of this zoom. Value 0 disables splitting.");
 
 // Options for custom isolines generating mode.
 DEFINE_int32(left, 0, "Custom isolines generating mode. Left longitude of tiles rect [-180, 179].");
@@ -175,6 +177,7 @@ int main(int argc, char ** argv)
     params.m_simplificationZoom = static_cast<int>(FLAGS_simpl_zoom);
     params.m_maxIsolineLength = FLAGS_max_length;
     params.m_alitudesStepFactor = FLAGS_alt_step_factor;
+    params.m_splittingZoom = static_cast<int>(FLAGS_split_zoom);
     params.m_isolinesTilesPath = FLAGS_isolines_path;
 
     generator.InitCountryInfoGetter(FLAGS_data_dir);
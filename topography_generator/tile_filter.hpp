@@ -61,20 +61,30 @@ private:
 template <typename ValueType>
 using FiltersSequence = std::vector<std::unique_ptr<FilterInterface<ValueType>>>;
 
+// Buffers for the extended tile values. They are kept between the tiles processed by one thread
+// to avoid two big allocations per tile.
 template <typename ValueType>
-std::vector<ValueType> FilterTile(FiltersSequence<ValueType> const & filters,
-                                  ms::LatLon const & leftBottom,
-                                  size_t stepsInDegree, size_t tileSize,
-                                  ValuesProvider<ValueType> & valuesProvider)
+struct FilterTileBuffers
+{
+  std::vector<ValueType> m_extTileValues;
+  std::vector<ValueType> m_extTileValues2;
+};
+
+template <typename ValueType>
+void FilterTile(FiltersSequence<ValueType> const & filters, ms::LatLon const & leftBottom,
+                size_t stepsInDegree, size_t tileSize,
+                ValuesProvider<ValueType> & valuesProvider,
+                FilterTileBuffers<ValueType> & buffers, std::vector<ValueType> & result)
 {
   size_t combinedOffset = 0;
   for (auto const & filter : filters)
     combinedOffset += filter->GetKernelRadius();
 
-  std::vector<ValueType> extTileValues;
+  auto & extTileValues = buffers.m_extTileValues;
+  auto & extTileValues2 = buffers.m_extTileValues2;
   GetExtendedTile(leftBottom, stepsInDegree, tileSize, combinedOffset, valuesProvider, extTileValues);
 
-  std::vector<ValueType> extTileValues2(extTileValues.size());
+  extTileValues2.resize(extTileValues.size());
 
   size_t const extTileSize = tileSize + 2 * combinedOffset;
   CHECK_EQUAL(extTileSize * extTileSize, extTileValues.size(), ());
@@ -87,7 +97,7 @@ std::vector<ValueType> FilterTile(FiltersSequence<ValueType> const & filters,
     extTileValues.swap(extTileValues2);
   }
 
-  std::vector<ValueType> result(tileSize * tileSize);
+  result.resize(tileSize * tileSize);
   for (size_t i = combinedOffset; i < extTileSize - combinedOffset; ++i)
   {
     for (size_t j = combinedOffset; j < extTileSize - combinedOffset; ++j)
@@ -96,6 +106,17 @@ std::vector<ValueType> FilterTile(FiltersSequence<ValueType> const & filters,
       result[dstIndex] = extTileValues[i * extTileSize + j];
     }
   }
+}
+
+template <typename ValueType>
+std::vector<ValueType> FilterTile(FiltersSequence<ValueType> const & filters,
+                                  ms::LatLon const & leftBottom,
+                                  size_t stepsInDegree, size_t tileSize,
+                                  ValuesProvider<ValueType> & valuesProvider)
+{
+  FilterTileBuffers<ValueType> buffers;
+  std::vector<ValueType> result;
+  FilterTile(filters, leftBottom, stepsInDegree, tileSize, valuesProvider, buffers, result);
   return result;
 }
 }  // namespace topography_generator
@@ -2,9 +2,12 @@
 
 #include "generator/feature_helpers.hpp"
 
+#include "geometry/mercator.hpp"
 #include "geometry/point2d.hpp"
 #include "geometry/region2d.hpp"
 
+#include <cmath>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -94,5 +97,42 @@ void SimplifyContours(int simplificationZoom, Contours<ValueType> & contours)
     }
   }
 }
+// Splits contours on the borders of the cells of the 2^zoom x 2^zoom grid over the mercator
+// bounds. Every piece lies in one cell except its last segment which crosses the border, so
+// the isoline features built from the pieces are indexed in few cells and reading a tile touches
+// only the geometry near it.
+template <typename ValueType>
+void SplitContoursByCells(int zoom, Contours<ValueType> & contours)
+{
+  double const cellSize = mercator::Bounds::kRangeX / (1 << zoom);
+  auto const getCell = [cellSize](m2::PointD const & pt) {
+    return std::make_pair(static_cast<int>(std::floor((pt.x - mercator::Bounds::kMinX) / cellSize)),
+                          static_cast<int>(std::floor((pt.y - mercator::Bounds::kMinY) / cellSize)));
+  };
+
+  for (auto & levelContours : contours.m_contours)
+  {
+    std::vector<Contour> levelSplitContours;
+    for (auto const & contour : levelContours.second)
+    {
+      Contour piece;
+      auto cell = getCell(contour.front());
+      for (auto const & pt : contour)
+      {
+        piece.push_back(pt);
+        auto const ptCell = getCell(pt);
+        if (ptCell == cell)
+          continue;
+
+        levelSplitContours.emplace_back(std::move(piece));
+        piece = {pt};
+        cell = ptCell;
+      }
+      if (piece.size() > 1)
+        levelSplitContours.emplace_back(std::move(piece));
+    }
+    levelContours.second = std::move(levelSplitContours);
+  }
+}
 }  // namespace topography_generator
 
@@ -35,45 +35,57 @@ public:
   template <typename Sink>
   void Serialize(MwmToMatchedTracks const & mwmToMatchedTracks, Sink & sink)
   {
-    WriteSize(sink, mwmToMatchedTracks.size());
+    SerializeMwmsCount(mwmToMatchedTracks.size(), sink);
 
     for (auto const & mwmIt : mwmToMatchedTracks)
-    {
-      rw::Write(sink, m_numMwmIds->GetFile(mwmIt.first).GetName());
+      SerializeMwm(mwmIt.first, mwmIt.second, sink);
+  }
 
-      UserToMatchedTracks const & userToMatchedTracks = mwmIt.second;
-      CHECK(!userToMatchedTracks.empty(), ());
-      WriteSize(sink, userToMatchedTracks.size());
+  // Serialize() is SerializeMwmsCount() followed by SerializeMwm() for every mwm, so the tracks
+  // of an mwm may be serialized and freed as soon as they are matched.
+  template <typename Sink>
+  void SerializeMwmsCount(size_t count, Sink & sink)
+  {
+    WriteSize(sink, count);
+  }
 
-      for (auto const & userIt : userToMatchedTracks)
-      {
-        rw::Write(sink, userIt.first);
+  template <typename Sink>
+  void SerializeMwm(routing::NumMwmId mwmId, UserToMatchedTracks const & userToMatchedTracks,
+                    Sink & sink)
+  {
+    rw::Write(sink, m_numMwmIds->GetFile(mwmId).GetName());
 
-        std::vector<MatchedTrack> const & tracks = userIt.second;
-        CHECK(!tracks.empty(), ());
-        WriteSize(sink, tracks.size());
+    CHECK(!userToMatchedTracks.empty(), ());
+    WriteSize(sink, userToMatchedTracks.size());
 
-        for (MatchedTrack const & track : tracks)
-        {
-          CHECK(!track.empty(), ());
-          WriteSize(sink, track.size());
+    for (auto const & userIt : userToMatchedTracks)
+    {
+      rw::Write(sink, userIt.first);
 
-          std::vector<DataPoint> dataPoints;
-          dataPoints.reserve(track.size());
-          for (MatchedTrackPoint const & point : track)
-          {
-            Serialize(point.GetSegment(), sink);
-            dataPoints.emplace_back(point.GetDataPoint());
-          }
+      std::vector<MatchedTrack> const & tracks = userIt.second;
+      CHECK(!tracks.empty(), ());
+      WriteSize(sink, tracks.size());
 
-          std::vector<uint8_t> buffer;
-          MemWriter<decltype(buffer)> memWriter(buffer);
-          coding::TrafficGPSEncoder::SerializeDataPoints(coding::TrafficGPSEncoder::kLatestVersion,
-                                                         memWriter, dataPoints);
+      for (MatchedTrack const & track : tracks)
+      {
+        CHECK(!track.empty(), ());
+        WriteSize(sink, track.size());
 
-          WriteSize(sink, buffer.size());
-          sink.Write(buffer.data(), buffer.size());
+        std::vector<DataPoint> dataPoints;
+        dataPoints.reserve(track.size());
+        for (MatchedTrackPoint const & point : track)
+        {
+          Serialize(point.GetSegment(), sink);
+          dataPoints.emplace_back(point.GetDataPoint());
         }
+
+        std::vector<uint8_t> buffer;
+        MemWriter<decltype(buffer)> memWriter(buffer);
+        coding::TrafficGPSEncoder::SerializeDataPoints(coding::TrafficGPSEncoder::kLatestVersion,
+                                                       memWriter, dataPoints);
+
+        WriteSize(sink, buffer.size());
+        sink.Write(buffer.data(), buffer.size());
       }
     }
   }
@@ -20,13 +20,16 @@
 #include "base/assert.hpp"
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
+#include "base/lru_cache.hpp"
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 using namespace routing;
 using namespace std;
@@ -35,10 +38,40 @@ using namespace track_analyzing;
 
 namespace
 {
-using Iter = typename vector<string>::iterator;
+// Matchers keep the road graphs of their mwms. Building a graph takes longer than matching the
+// tracks of the mwm from a log, and the logs of a day visit mostly the same mwms, so a thread
+// keeps the matchers of the recent mwms for its next logs.
+size_t constexpr kMaxCachedMatchers = 16;
 
-void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
-                 NumMwmIds const & numMwmIds, MwmToMatchedTracks & mwmToMatchedTracks)
+// *NOTE* This class is not thread-safe, as well as the matchers and the storage.
+class MatcherCache
+{
+public:
+  MatcherCache(Storage const & storage, NumMwmIds const & numMwmIds)
+    : m_storage(storage), m_numMwmIds(numMwmIds), m_matchers(kMaxCachedMatchers)
+  {
+  }
+
+  TrackMatcher & Get(NumMwmId mwmId)
+  {
+    bool found = false;
+    auto & matcher = m_matchers.Find(mwmId, found);
+    if (!matcher)
+      matcher = make_unique<TrackMatcher>(m_storage, mwmId, m_numMwmIds.GetFile(mwmId));
+    return *matcher;
+  }
+
+private:
+  Storage const & m_storage;
+  NumMwmIds const & m_numMwmIds;
+  LruCache<NumMwmId, unique_ptr<TrackMatcher>> m_matchers;
+};
+
+// Matches the tracks mwm by mwm and writes them to |writer|. The matched tracks of an mwm are
+// serialized right away, so only the serialized tracks of the log are kept in memory.
+void MatchTracks(MwmToTracks const & mwmToTracks, NumMwmIds const & numMwmIds,
+                 MatcherCache & matchers, MwmToMatchedTracksSerializer & serializer,
+                 FileWriter & writer)
 {
   base::Timer timer;
 
@@ -46,13 +79,19 @@ void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & stora
   uint64_t pointsCount = 0;
   uint64_t nonMatchedPointsCount = 0;
 
-  auto processMwm = [&](string const & mwmName, UserToTrack const & userToTrack) {
-    auto const countryFile = platform::CountryFile(mwmName);
-    auto const mwmId = numMwmIds.GetId(countryFile);
-    TrackMatcher matcher(storage, mwmId, countryFile);
-
-    auto & userToMatchedTracks = mwmToMatchedTracks[mwmId];
+  size_t mwmsCount = 0;
+  vector<uint8_t> buffer;
+  MemWriter<vector<uint8_t>> bufferWriter(buffer);
 
+  auto processMwm = [&](string const & mwmName, UserToTrack const & userToTrack) {
+    auto const mwmId = numMwmIds.GetId(platform::CountryFile(mwmName));
+    TrackMatcher & matcher = matchers.Get(mwmId);
+    // The matcher may be reused, its counters are cumulative.
+    auto const prevTracksCount = matcher.GetTracksCount();
+    auto const prevPointsCount = matcher.GetPointsCount();
+    auto const prevNonMatchedPointsCount = matcher.GetNonMatchedPointsCount();
+
+    UserToMatchedTracks userToMatchedTracks;
     for (auto const & it : userToTrack)
     {
       string const & user = it.first;
@@ -71,20 +110,29 @@ void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & stora
         userToMatchedTracks.erase(user);
     }
 
-    if (userToMatchedTracks.empty())
-      mwmToMatchedTracks.erase(mwmId);
+    if (!userToMatchedTracks.empty())
+    {
+      serializer.SerializeMwm(mwmId, userToMatchedTracks, bufferWriter);
+      ++mwmsCount;
+    }
 
-    tracksCount += matcher.GetTracksCount();
-    pointsCount += matcher.GetPointsCount();
-    nonMatchedPointsCount += matcher.GetNonMatchedPointsCount();
+    auto const mwmTracksCount = matcher.GetTracksCount() - prevTracksCount;
+    auto const mwmPointsCount = matcher.GetPointsCount() - prevPointsCount;
+    auto const mwmNonMatchedPointsCount =
+        matcher.GetNonMatchedPointsCount() - prevNonMatchedPointsCount;
+    tracksCount += mwmTracksCount;
+    pointsCount += mwmPointsCount;
+    nonMatchedPointsCount += mwmNonMatchedPointsCount;
 
-    LOG(LINFO, (numMwmIds.GetFile(mwmId).GetName(), ", users:", userToTrack.size(), ", tracks:",
-                matcher.GetTracksCount(), ", points:", matcher.GetPointsCount(),
-                ", non matched points:", matcher.GetNonMatchedPointsCount()));
+    LOG(LINFO, (mwmName, ", users:", userToTrack.size(), ", tracks:", mwmTracksCount,
+                ", points:", mwmPointsCount, ", non matched points:", mwmNonMatchedPointsCount));
   };
 
   ForTracksSortedByMwmName(mwmToTracks, numMwmIds, processMwm);
 
+  serializer.SerializeMwmsCount(mwmsCount, writer);
+  writer.Write(buffer.data(), buffer.size());
+
   LOG(LINFO,
       ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, tracks:", tracksCount,
        ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount));
@@ -94,18 +142,16 @@ void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & stora
 namespace track_analyzing
 {
 void CmdMatch(string const & logFile, string const & trackFile,
-              shared_ptr<NumMwmIds> const & numMwmIds, Storage const & storage, Stats & stats)
+              shared_ptr<NumMwmIds> const & numMwmIds, Storage const & storage,
+              MatcherCache & matchers, Stats & stats)
 {
   MwmToTracks mwmToTracks;
   ParseTracks(logFile, numMwmIds, mwmToTracks);
   stats.AddTracksStats(mwmToTracks, *numMwmIds, storage);
 
-  MwmToMatchedTracks mwmToMatchedTracks;
-  MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks);
-
   FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
   MwmToMatchedTracksSerializer serializer(numMwmIds);
-  serializer.Serialize(mwmToMatchedTracks, writer);
+  MatchTracks(mwmToTracks, *numMwmIds, matchers, serializer, writer);
   LOG(LINFO, ("Matched tracks were saved to", trackFile));
 }
 
@@ -115,21 +161,26 @@ void CmdMatch(string const & logFile, string const & trackFile, string const & i
   Storage storage;
   storage.RegisterAllLocalMaps(false /* enableDiffs */);
   shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
+  MatcherCache matchers(storage, *numMwmIds);
 
   Stats stats;
-  CmdMatch(logFile, trackFile, numMwmIds, storage, stats);
+  CmdMatch(logFile, trackFile, numMwmIds, storage, matchers, stats);
   stats.SaveMwmDistributionToCsv(inputDistribution);
   stats.Log();
 }
 
-void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
+// Unpacks and matches the files of |files| while there are files nobody has taken yet, so the
+// threads stay busy until the end however different the sizes of the files are.
+void UnzipAndMatch(Platform::FilesList const & files, atomic<size_t> & nextFile,
+                   string const & trackExt, Stats & stats)
 {
   Storage storage;
   storage.RegisterAllLocalMaps(false /* enableDiffs */);
   shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
-  for (auto it = begin; it != end; ++it)
+  MatcherCache matchers(storage, *numMwmIds);
+  for (size_t i = nextFile++; i < files.size(); i = nextFile++)
   {
-    auto & file = *it;
+    auto file = files[i];
     string data;
     try
     {
@@ -146,6 +197,7 @@ void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
     Inflate inflate(Inflate::Format::GZip);
     string track;
     inflate(data.data(), data.size(), back_inserter(track));
+    data.clear();
     base::GetNameWithoutExt(file);
     try
     {
@@ -158,7 +210,7 @@ void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
       continue;
     }
 
-    CmdMatch(file, file + trackExt, numMwmIds, storage, stats);
+    CmdMatch(file, file + trackExt, numMwmIds, storage, matchers, stats);
     FileWriter::DeleteFileX(file);
   }
 }
@@ -201,18 +253,16 @@ void CmdMatchDir(string const & logDir, string const & trackExt, string const &
   CHECK_GREATER(hardwareConcurrency, 0, ("No available threads."));
   LOG(LINFO, ("Number of available threads =", hardwareConcurrency));
   auto const threadsCount = min(size, hardwareConcurrency);
-  auto const blockSize = size / threadsCount;
   vector<thread> threads(threadsCount - 1);
   vector<Stats> stats(threadsCount);
-  auto begin = filesList.begin();
+  atomic<size_t> nextFile(0);
   for (size_t i = 0; i < threadsCount - 1; ++i)
   {
-    auto end = begin + blockSize;
-    threads[i] = thread(UnzipAndMatch, begin, end, trackExt, ref(stats[i]));
-    begin = end;
+    threads[i] = thread(UnzipAndMatch, cref(filesList), ref(nextFile), cref(trackExt),
+                        ref(stats[i]));
   }
 
-  UnzipAndMatch(begin, filesList.end(), trackExt, ref(stats[threadsCount - 1]));
+  UnzipAndMatch(filesList, nextFile, trackExt, stats[threadsCount - 1]);
   for (auto & t : threads)
     t.join();
 
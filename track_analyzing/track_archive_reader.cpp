@@ -10,11 +10,15 @@
 #include "coding/zlib.hpp"
 
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
 
+#include <algorithm>
 #include <exception>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <optional>
+#include <thread>
 #include <vector>
 
 #include "3party/boost/boost/algorithm/string/classification.hpp"
@@ -38,6 +42,9 @@ const string kTmpArchiveFileNameTemplate("-tmp-track-archive.zip");
 constexpr size_t kTrackRecordSize = 5;
 constexpr size_t kTrackRecordUserIdIndex = 0;
 constexpr size_t kTrackRecordDataIndex = 4;
+// Records are parsed in parallel by chunks of this size. A record is an archive of a trip
+// which takes milliseconds to unpack, so the chunks are small to balance the threads.
+constexpr size_t kRecordsChunkSize = 64;
 
 namespace details
 {
@@ -300,20 +307,45 @@ void TrackArchiveReader::ParseUserTracksFromFile(string const & logFile,
   inflate(archiveData.data(), archiveData.size(), back_inserter(logData));
 
   // Parse log
-  TemporaryFile tmpArchiveFile("" /* empty prefix */, kTmpArchiveFileNameTemplate);
-  stringstream logParser;
-  logParser << logData;
+  vector<string> records;
+  {
+    stringstream logParser;
+    logParser << logData;
+    logData.clear();
+    for (string line; getline(logParser, line);)
+      records.push_back(move(line));
+  }
 
-  size_t linesCount = 0;
-  size_t errorsCount = 0;
-  for (string line; getline(logParser, line); ++linesCount)
+  // Records are independent, so they are unpacked in parallel and the tracks are merged in the
+  // order of the records afterwards.
+  vector<optional<details::UserTrackInfo>> tracks(records.size());
   {
-    optional<details::UserTrackInfo> data = details::ParseLogRecord(line, tmpArchiveFile);
+    size_t const threadsCount = max<size_t>(
+        1, min<size_t>(thread::hardware_concurrency(),
+                       (records.size() + kRecordsChunkSize - 1) / kRecordsChunkSize));
+    base::thread_pool::computational::ThreadPool pool(threadsCount);
+    vector<future<void>> chunks;
+    for (size_t begin = 0; begin < records.size(); begin += kRecordsChunkSize)
+    {
+      size_t const end = min(begin + kRecordsChunkSize, records.size());
+      chunks.push_back(pool.Submit([&records, &tracks, begin, end]() {
+        TemporaryFile tmpArchiveFile("" /* empty prefix */, kTmpArchiveFileNameTemplate);
+        for (size_t i = begin; i < end; ++i)
+          tracks[i] = details::ParseLogRecord(records[i], tmpArchiveFile);
+      }));
+    }
+    for (auto & chunk : chunks)
+      chunk.get();
+  }
 
+  size_t errorsCount = 0;
+  for (auto & data : tracks)
+  {
     if (data)
     {
       Track & track = userToTrack[data->m_userId];
       track.insert(track.end(), data->m_track.cbegin(), data->m_track.cend());
+      data.reset();
     }
     else
     {
@@ -321,7 +353,7 @@ void TrackArchiveReader::ParseUserTracksFromFile(string const & logFile,
     }
   }
 
-  LOG(LINFO, ("Process", linesCount, "log records"));
+  LOG(LINFO, ("Process", records.size(), "log records"));
   if (errorsCount == 0)
     LOG(LINFO, ("All records are parsed successfully"));
   else
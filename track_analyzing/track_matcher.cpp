@@ -1,7 +1,5 @@
 #include "track_analyzing/track_matcher.hpp"
 
-#include "track_analyzing/exceptions.hpp"
-
 #include "routing/city_roads.hpp"
 #include "routing/index_graph_loader.hpp"
 #include "routing/maxspeeds.hpp"
@@ -10,10 +8,10 @@
 
 #include "indexer/scales.hpp"
 
+#include "geometry/distance_on_sphere.hpp"
+#include "geometry/mercator.hpp"
 #include "geometry/parametrized_segment.hpp"
 
-#include "base/stl_helpers.hpp"
-
 using namespace routing;
 using namespace std;
 using namespace track_analyzing;
@@ -22,33 +20,6 @@ namespace
 {
 // Matching range in meters.
 double constexpr kMatchingRange = 20.0;
-
-// Mercator distance from segment to point in meters.
-double DistanceToSegment(m2::PointD const & segmentBegin, m2::PointD const & segmentEnd,
-                         m2::PointD const & point)
-{
-  m2::ParametrizedSegment<m2::PointD> const segment(segmentBegin, segmentEnd);
-  m2::PointD const projectionPoint = segment.ClosestPointTo(point);
-  return mercator::DistanceOnEarth(point, projectionPoint);
-}
-
-double DistanceToSegment(Segment const & segment, m2::PointD const & point, IndexGraph & indexGraph)
-{
-  return DistanceToSegment(
-      mercator::FromLatLon(indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(false))),
-      mercator::FromLatLon(indexGraph.GetGeometry().GetPoint(segment.GetRoadPoint(true))), point);
-}
-
-bool EdgesContain(vector<SegmentEdge> const & edges, Segment const & segment)
-{
-  for (auto const & edge : edges)
-  {
-    if (edge.GetTarget() == segment)
-      return true;
-  }
-
-  return false;
-}
 }  // namespace
 
 namespace track_analyzing
@@ -74,72 +45,72 @@ TrackMatcher::TrackMatcher(storage::Storage const & storage, NumMwmId mwmId,
         nullptr /* dataSource */, nullptr /* numMvmIds */));
 
   DeserializeIndexGraph(*handle.GetValue(), VehicleType::Car, *m_graph);
+
+  m_matcherGraph = make_unique<MatcherGraph>(m_dataSource, *m_graph, *m_vehicleModel, m_mwmId);
+  HmmMapMatcher::Params params;
+  params.m_candidatesRadiusM = kMatchingRange;
+  m_matcher = make_unique<HmmMapMatcher>(*m_matcherGraph, params);
 }
 
 void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTrack> & matchedTracks)
 {
   m_pointsCount += track.size();
 
-  vector<Step> steps;
-  steps.reserve(track.size());
-  for (auto const & routePoint : track)
-    steps.emplace_back(routePoint);
-
-  for (size_t trackBegin = 0; trackBegin < steps.size();)
-  {
-    for (; trackBegin < steps.size(); ++trackBegin)
-    {
-      steps[trackBegin].FillCandidatesWithNearbySegments(m_dataSource, *m_graph, *m_vehicleModel,
-                                                         m_mwmId);
-      if (steps[trackBegin].HasCandidates())
-        break;
-
-      ++m_nonMatchedPointsCount;
-    }
+  vector<m2::PointD> points;
+  points.reserve(track.size());
+  for (auto const & dataPoint : track)
+    points.push_back(mercator::FromLatLon(dataPoint.m_latLon));
 
-    if (trackBegin >= steps.size())
-      break;
-
-    size_t trackEnd = trackBegin;
-    for (; trackEnd < steps.size() - 1; ++trackEnd)
-    {
-      Step & nextStep = steps[trackEnd + 1];
-      Step const & prevStep = steps[trackEnd];
-      nextStep.FillCandidates(prevStep, *m_graph);
-      if (!nextStep.HasCandidates())
-        break;
-    }
-
-    steps[trackEnd].ChooseNearestSegment();
-
-    for (size_t i = trackEnd; i > trackBegin; --i)
-      steps[i - 1].ChooseSegment(steps[i], *m_graph);
+  vector<HmmMapMatcher::MatchedPiece> pieces;
+  m_matcher->Match(points, pieces);
 
+  uint64_t matchedPointsCount = 0;
+  for (auto const & piece : pieces)
+  {
     ++m_tracksCount;
 
+    // Segments which connect the states of consecutive points are passed with the data point
+    // of the former one, so the matched track is contiguous.
     matchedTracks.push_back({});
     MatchedTrack & matchedTrack = matchedTracks.back();
-    for (size_t i = trackBegin; i <= trackEnd; ++i)
+    matchedTrack.reserve(piece.size());
+    for (size_t i = 0; i < piece.size(); ++i)
     {
-      Step const & step = steps[i];
-      matchedTrack.emplace_back(step.GetDataPoint(), step.GetSegment());
+      auto const & [pointIdx, segment] = piece[i];
+      if (i == 0 || piece[i - 1].first != pointIdx)
+        ++matchedPointsCount;
+      matchedTrack.emplace_back(track[pointIdx], segment);
     }
-
-    trackBegin = trackEnd + 1;
   }
+
+  m_nonMatchedPointsCount += track.size() - matchedPointsCount;
 }
 
-// TrackMatcher::Step ------------------------------------------------------------------------------
-TrackMatcher::Step::Step(DataPoint const & dataPoint)
-  : m_dataPoint(dataPoint), m_point(mercator::FromLatLon(dataPoint.m_latLon))
+// TrackMatcher::MatcherGraph ----------------------------------------------------------------------
+TrackMatcher::MatcherGraph::MatcherGraph(DataSource const & dataSource, IndexGraph & graph,
+                                         VehicleModelInterface const & vehicleModel,
+                                         NumMwmId mwmId)
+  : m_dataSource(dataSource), m_graph(graph), m_vehicleModel(vehicleModel), m_mwmId(mwmId)
 {
 }
 
-void TrackMatcher::Step::FillCandidatesWithNearbySegments(
-    DataSource const & dataSource, IndexGraph const & graph,
-    VehicleModelInterface const & vehicleModel, NumMwmId mwmId)
+void TrackMatcher::MatcherGraph::GetCandidates(m2::PointD const & point, double radiusM,
+                                               vector<HmmMapMatcher::Candidate> & candidates)
 {
-  dataSource.ForEachInRect(
+  auto const addCandidate = [&](Segment const & segment) {
+    if (m_graph.GetAccessType(segment) != RoadAccess::Type::Yes)
+      return;
+
+    m2::PointD const begin = GetPoint(segment, false /* front */);
+    m2::PointD const end = GetPoint(segment, true /* front */);
+    m2::ParametrizedSegment<m2::PointD> const parametrized(begin, end);
+    m2::PointD const projection = parametrized.ClosestPointTo(point);
+    double const distanceM = mercator::DistanceOnEarth(point, projection);
+    if (distanceM < radiusM)
+      candidates.emplace_back(segment, distanceM, mercator::DistanceOnEarth(begin, projection));
+  };
+
+  m_dataSource.ForEachInRect(
       [&](FeatureType & ft) {
         if (!ft.GetID().IsValid())
           return;
@@ -147,107 +118,50 @@ void TrackMatcher::Step::FillCandidatesWithNearbySegments(
         if (ft.GetID().m_mwmId.GetInfo()->GetType() != MwmInfo::COUNTRY)
           return;
 
-        if (!vehicleModel.IsRoad(ft))
+        if (!m_vehicleModel.IsRoad(ft))
           return;
 
         ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
 
+        bool const oneWay = m_vehicleModel.IsOneWay(ft);
         for (size_t segIdx = 0; segIdx + 1 < ft.GetPointsCount(); ++segIdx)
         {
-          double const distance =
-              DistanceToSegment(ft.GetPoint(segIdx), ft.GetPoint(segIdx + 1), m_point);
-          if (distance < kMatchingRange)
-          {
-            AddCandidate(Segment(mwmId, ft.GetID().m_index, static_cast<uint32_t>(segIdx),
-                                 true /* forward */),
-                         distance, graph);
-
-            if (!vehicleModel.IsOneWay(ft))
-            {
-              AddCandidate(Segment(mwmId, ft.GetID().m_index, static_cast<uint32_t>(segIdx),
-                                   false /* forward */),
-                           distance, graph);
-            }
-          }
+          m2::ParametrizedSegment<m2::PointD> const segment(ft.GetPoint(segIdx),
+                                                            ft.GetPoint(segIdx + 1));
+          if (mercator::DistanceOnEarth(point, segment.ClosestPointTo(point)) >= radiusM)
+            continue;
+
+          auto const featureId = ft.GetID().m_index;
+          auto const segmentIdx = static_cast<uint32_t>(segIdx);
+          addCandidate(Segment(m_mwmId, featureId, segmentIdx, true /* forward */));
+          if (!oneWay)
+            addCandidate(Segment(m_mwmId, featureId, segmentIdx, false /* forward */));
         }
       },
-      mercator::RectByCenterXYAndSizeInMeters(m_point, kMatchingRange),
-      scales::GetUpperScale());
-}
-
-void TrackMatcher::Step::FillCandidates(Step const & previousStep, IndexGraph & graph)
-{
-  vector<SegmentEdge> edges;
-
-  for (Candidate const & candidate : previousStep.m_candidates)
-  {
-    Segment const & segment = candidate.GetSegment();
-    m_candidates.emplace_back(segment, DistanceToSegment(segment, m_point, graph));
-
-    edges.clear();
-    graph.GetEdgeList(segment, true /* isOutgoing */, true /* useRoutingOptions */, edges);
-
-    for (SegmentEdge const & edge : edges)
-    {
-      Segment const & target = edge.GetTarget();
-      if (!segment.IsInverse(target))
-        m_candidates.emplace_back(target, DistanceToSegment(target, m_point, graph));
-    }
-  }
-
-  base::SortUnique(m_candidates);
-
-  m_candidates.erase(remove_if(m_candidates.begin(), m_candidates.end(),
-                               [&](Candidate const & candidate) {
-                                 return candidate.GetDistance() > kMatchingRange;
-                               }),
-                     m_candidates.end());
+      mercator::RectByCenterXYAndSizeInMeters(point, radiusM), scales::GetUpperScale());
 }
 
-void TrackMatcher::Step::ChooseSegment(Step const & nextStep, IndexGraph & indexGraph)
+void TrackMatcher::MatcherGraph::GetOutgoingSegments(Segment const & segment,
+                                                     vector<Segment> & segments)
 {
-  CHECK(!m_candidates.empty(), ());
-
-  double minDistance = numeric_limits<double>::max();
-
-  vector<SegmentEdge> edges;
-  indexGraph.GetEdgeList(nextStep.m_segment, false /* isOutgoing */, true /* useRoutingOptions */,
-                         edges);
-  edges.emplace_back(nextStep.m_segment, GetAStarWeightZero<RouteWeight>());
-
-  for (Candidate const & candidate : m_candidates)
+  m_edges.clear();
+  m_graph.GetEdgeList(segment, true /* isOutgoing */, true /* useRoutingOptions */, m_edges);
+  for (auto const & edge : m_edges)
   {
-    if (candidate.GetDistance() < minDistance && EdgesContain(edges, candidate.GetSegment()))
-    {
-      minDistance = candidate.GetDistance();
-      m_segment = candidate.GetSegment();
-    }
+    Segment const & target = edge.GetTarget();
+    if (!segment.IsInverse(target))
+      segments.push_back(target);
   }
-
-  if (minDistance == numeric_limits<double>::max())
-    MYTHROW(MessageException, ("Can't find previous step for", nextStep.m_segment));
 }
 
-void TrackMatcher::Step::ChooseNearestSegment()
+double TrackMatcher::MatcherGraph::GetLengthM(Segment const & segment)
 {
-  CHECK(!m_candidates.empty(), ());
-
-  double minDistance = numeric_limits<double>::max();
-
-  for (Candidate const & candidate : m_candidates)
-  {
-    if (candidate.GetDistance() < minDistance)
-    {
-      minDistance = candidate.GetDistance();
-      m_segment = candidate.GetSegment();
-    }
-  }
+  return ms::DistanceOnEarth(m_graph.GetPoint(segment, false /* front */),
+                             m_graph.GetPoint(segment, true /* front */));
 }
 
-void TrackMatcher::Step::AddCandidate(Segment const & segment, double distance,
-                                      IndexGraph const & graph)
+m2::PointD TrackMatcher::MatcherGraph::GetPoint(Segment const & segment, bool front)
 {
-  if (graph.GetAccessType(segment) == RoadAccess::Type::Yes)
-    m_candidates.emplace_back(segment, distance);
+  return mercator::FromLatLon(m_graph.GetPoint(segment, front));
 }
 }  // namespace track_analyzing
@@ -2,6 +2,7 @@
 
 #include "track_analyzing/track.hpp"
 
+#include "routing/hmm_map_matcher.hpp"
 #include "routing/index_graph.hpp"
 #include "routing/segment.hpp"
 
@@ -32,53 +33,36 @@ public:
   uint64_t GetNonMatchedPointsCount() const { return m_nonMatchedPointsCount; }
 
 private:
-  class Candidate final
+  // Roads of the mwm for HmmMapMatcher. Segments with access restrictions aren't matched.
+  class MatcherGraph final : public routing::HmmMapMatcher::Graph
   {
   public:
-    Candidate(routing::Segment segment, double distance) : m_segment(segment), m_distance(distance)
-    {
-    }
+    MatcherGraph(DataSource const & dataSource, routing::IndexGraph & graph,
+                 routing::VehicleModelInterface const & vehicleModel, routing::NumMwmId mwmId);
 
-    routing::Segment const & GetSegment() const { return m_segment; }
-    double GetDistance() const { return m_distance; }
-    bool operator==(Candidate const & candidate) const { return m_segment == candidate.m_segment; }
-    bool operator<(Candidate const & candidate) const { return m_segment < candidate.m_segment; }
+    // routing::HmmMapMatcher::Graph overrides:
+    void GetCandidates(m2::PointD const & point, double radiusM,
+                       std::vector<routing::HmmMapMatcher::Candidate> & candidates) override;
+    void GetOutgoingSegments(routing::Segment const & segment,
+                             std::vector<routing::Segment> & segments) override;
+    double GetLengthM(routing::Segment const & segment) override;
 
   private:
-    routing::Segment m_segment;
-    double m_distance;
-  };
-
-  class Step final
-  {
-  public:
-    explicit Step(DataPoint const & dataPoint);
-
-    DataPoint const & GetDataPoint() const { return m_dataPoint; }
-    routing::Segment const & GetSegment() const { return m_segment; }
-    bool HasCandidates() const { return !m_candidates.empty(); }
-    void FillCandidatesWithNearbySegments(DataSource const & dataSource,
-                                          routing::IndexGraph const & graph,
-                                          routing::VehicleModelInterface const & vehicleModel,
-                                          routing::NumMwmId mwmId);
-    void FillCandidates(Step const & previousStep, routing::IndexGraph & graph);
-    void ChooseSegment(Step const & nextStep, routing::IndexGraph & indexGraph);
-    void ChooseNearestSegment();
-
-  private:
-    void AddCandidate(routing::Segment const & segment, double distance,
-                      routing::IndexGraph const & graph);
+    m2::PointD GetPoint(routing::Segment const & segment, bool front);
 
-    DataPoint m_dataPoint;
-    m2::PointD m_point;
-    routing::Segment m_segment;
-    std::vector<Candidate> m_candidates;
+    DataSource const & m_dataSource;
+    routing::IndexGraph & m_graph;
+    routing::VehicleModelInterface const & m_vehicleModel;
+    routing::NumMwmId const m_mwmId;
+    std::vector<routing::SegmentEdge> m_edges;
   };
 
   routing::NumMwmId const m_mwmId;
   FrozenDataSource m_dataSource;
   std::shared_ptr<routing::VehicleModelInterface> m_vehicleModel;
   std::unique_ptr<routing::IndexGraph> m_graph;
+  std::unique_ptr<MatcherGraph> m_matcherGraph;
+  std::unique_ptr<routing::HmmMapMatcher> m_matcher;
   uint64_t m_tracksCount = 0;
   uint64_t m_pointsCount = 0;
   uint64_t m_nonMatchedPointsCount = 0;
@@ -32,6 +32,7 @@ bool Connection::Reconnect()
 
   alohalytics::Stats::Instance().LogEvent("TrafficTrack_reconnect");
   m_socket->Close();
+  m_streamState = {};
 
   if (!m_socket->Open(m_host, m_port))
     return false;
@@ -62,7 +63,14 @@ bool Connection::Send(boost::circular_buffer<DataPoint> const & points)
   if (!m_socket)
     return false;
 
-  auto packet = Protocol::CreateDataPacket(points, tracking::Protocol::PacketType::CurrentData);
-  return m_socket->Write(packet.data(), static_cast<uint32_t>(packet.size()));
+  // The state is kept intact if the points are not sent, they are sent again after a reconnect.
+  auto state = m_streamState;
+  auto packet =
+      Protocol::CreateDataPacket(points, tracking::Protocol::PacketType::CurrentData, state);
+  if (!m_socket->Write(packet.data(), static_cast<uint32_t>(packet.size())))
+    return false;
+
+  m_streamState = state;
+  return true;
 }
 }  // namespace tracking
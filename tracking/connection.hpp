@@ -39,5 +39,8 @@ private:
   std::unique_ptr<platform::Socket> m_socket;
   std::string const m_host;
   uint16_t const m_port;
+  // The points of a connection are sent as a single stream, the state is reset by the auth
+  // packet of a reconnect on both sides.
+  coding::TrafficGPSEncoder::StreamState m_streamState;
 };
 }  // namespace tracking
@@ -15,7 +15,8 @@ namespace
 {
 template <typename Container>
 vector<uint8_t> CreateDataPacketImpl(Container const & points,
-                                     tracking::Protocol::PacketType const type)
+                                     tracking::Protocol::PacketType const type,
+                                     tracking::Protocol::StreamState & state)
 {
   vector<uint8_t> buffer;
   MemWriter<decltype(buffer)> writer(buffer);
@@ -25,13 +26,17 @@ vector<uint8_t> CreateDataPacketImpl(Container const & points,
   {
   case tracking::Protocol::PacketType::DataV0: version = 0; break;
   case tracking::Protocol::PacketType::DataV1: version = 1; break;
+  case tracking::Protocol::PacketType::DataV2: version = 2; break;
   case tracking::Protocol::PacketType::Error:
   case tracking::Protocol::PacketType::AuthV0:
     LOG(LERROR, ("Can't create a non-DATA packet as a DATA packet. PacketType =", type));
     return {};
   }
 
-  tracking::Protocol::Encoder::SerializeDataPoints(version, writer, points);
+  if (version == 2)
+    tracking::Protocol::Encoder::SerializeDataPointsV2(writer, points, state);
+  else
+    tracking::Protocol::Encoder::SerializeDataPoints(version, writer, points);
 
   auto packet = tracking::Protocol::CreateHeader(type, static_cast<uint32_t>(buffer.size()));
   packet.insert(packet.end(), begin(buffer), end(buffer));
@@ -69,13 +74,29 @@ vector<uint8_t> Protocol::CreateAuthPacket(string const & clientId)
 //  static
 vector<uint8_t> Protocol::CreateDataPacket(DataElementsCirc const & points, PacketType type)
 {
-  return CreateDataPacketImpl(points, type);
+  StreamState state;
+  return CreateDataPacketImpl(points, type, state);
 }
 
 //  static
 vector<uint8_t> Protocol::CreateDataPacket(DataElementsVec const & points, PacketType type)
 {
-  return CreateDataPacketImpl(points, type);
+  StreamState state;
+  return CreateDataPacketImpl(points, type, state);
+}
+
+//  static
+vector<uint8_t> Protocol::CreateDataPacket(DataElementsCirc const & points, PacketType type,
+                                           StreamState & state)
+{
+  return CreateDataPacketImpl(points, type, state);
+}
+
+//  static
+vector<uint8_t> Protocol::CreateDataPacket(DataElementsVec const & points, PacketType type,
+                                           StreamState & state)
+{
+  return CreateDataPacketImpl(points, type, state);
 }
 
 //  static
@@ -102,6 +123,7 @@ string Protocol::DecodeAuthPacket(Protocol::PacketType type, vector<uint8_t> con
   case Protocol::PacketType::Error:
   case Protocol::PacketType::DataV0:
   case Protocol::PacketType::DataV1:
+  case Protocol::PacketType::DataV2:
     LOG(LERROR, ("Error decoding AUTH packet. PacketType =", type));
     break;
   }
@@ -110,6 +132,14 @@ string Protocol::DecodeAuthPacket(Protocol::PacketType type, vector<uint8_t> con
 
 //  static
 Protocol::DataElementsVec Protocol::DecodeDataPacket(PacketType type, vector<uint8_t> const & data)
+{
+  StreamState state;
+  return DecodeDataPacket(type, data, state);
+}
+
+//  static
+Protocol::DataElementsVec Protocol::DecodeDataPacket(PacketType type, vector<uint8_t> const & data,
+                                                     StreamState & state)
 {
   DataElementsVec points;
   MemReaderWithExceptions memReader(data.data(), data.size());
@@ -124,6 +154,13 @@ Protocol::DataElementsVec Protocol::DecodeDataPacket(PacketType type, vector<uin
     case Protocol::PacketType::DataV1:
       Encoder::DeserializeDataPoints(1 /* version */, src, points);
       break;
+    case Protocol::PacketType::DataV2:
+      if (!Encoder::DeserializeDataPointsV2(src, points, state))
+      {
+        LOG(LWARNING, ("DATA packet continues an unknown stream."));
+        return {};
+      }
+      break;
     case Protocol::PacketType::Error:
     case Protocol::PacketType::AuthV0:
       LOG(LERROR, ("Error decoding DATA packet. PacketType =", type));
@@ -138,6 +175,46 @@ Protocol::DataElementsVec Protocol::DecodeDataPacket(PacketType type, vector<uin
   }
 }
 
+//  static
+Protocol::DataElementsVec Protocol::DecodeDataPackets(vector<uint8_t> const & stream)
+{
+  DataElementsVec points;
+  StreamState state;
+  size_t const kHeaderSize = sizeof(uint32_t);
+  size_t pos = 0;
+  while (pos + kHeaderSize <= stream.size())
+  {
+    vector<uint8_t> const header(stream.begin() + pos, stream.begin() + pos + kHeaderSize);
+    auto const [type, size] = DecodeHeader(header);
+    pos += kHeaderSize;
+    if (size > stream.size() - pos)
+    {
+      LOG(LWARNING, ("Truncated packet. PacketType =", type, "size =", size));
+      break;
+    }
+
+    vector<uint8_t> const payload(stream.begin() + pos, stream.begin() + pos + size);
+    pos += size;
+
+    switch (type)
+    {
+    case PacketType::AuthV0: state = StreamState(); break;
+    case PacketType::DataV0:
+    case PacketType::DataV1:
+    case PacketType::DataV2:
+    {
+      auto const packetPoints = DecodeDataPacket(type, payload, state);
+      points.insert(points.end(), packetPoints.begin(), packetPoints.end());
+      break;
+    }
+    case PacketType::Error:
+      LOG(LWARNING, ("Malformed packet stream at", pos - size - kHeaderSize));
+      return points;
+    }
+  }
+  return points;
+}
+
 //  static
 void Protocol::InitHeader(vector<uint8_t> & packet, PacketType type, uint32_t payloadSize)
 {
@@ -161,6 +238,7 @@ string DebugPrint(Protocol::PacketType type)
   case Protocol::PacketType::AuthV0: return "AuthV0";
   case Protocol::PacketType::DataV0: return "DataV0";
   case Protocol::PacketType::DataV1: return "DataV1";
+  case Protocol::PacketType::DataV2: return "DataV2";
   }
   stringstream ss;
   ss << "Unknown(" << static_cast<uint32_t>(type) << ")";
@@ -26,6 +26,7 @@ public:
   using Encoder = coding::TrafficGPSEncoder;
   using DataElementsCirc = boost::circular_buffer<Encoder::DataPoint>;
   using DataElementsVec = std::vector<Encoder::DataPoint>;
+  using StreamState = Encoder::StreamState;
 
   static uint8_t const kOk[4];
   static uint8_t const kFail[4];
@@ -36,8 +37,13 @@ public:
     AuthV0 = 0x81,
     DataV0 = 0x82,
     DataV1 = 0x92,
+    // The points of a packet are delta-encoded against the last point of the previous
+    // DataV2 packet of the connection, see TrafficGPSEncoder::StreamState.
+    DataV2 = 0xA2,
 
     CurrentAuth = AuthV0,
+    // AuthV0 doesn't negotiate the version of the data packets, so DataV2 may be sent only
+    // when all the servers are able to decode it.
     CurrentData = DataV1
   };
 
@@ -45,10 +51,22 @@ public:
   static std::vector<uint8_t> CreateAuthPacket(std::string const & clientId);
   static std::vector<uint8_t> CreateDataPacket(DataElementsCirc const & points, PacketType type);
   static std::vector<uint8_t> CreateDataPacket(DataElementsVec const & points, PacketType type);
+  // Creates a packet which continues the stream of |state| and updates |state|. |state| is
+  // used for DataV2 packets only.
+  static std::vector<uint8_t> CreateDataPacket(DataElementsCirc const & points, PacketType type,
+                                               StreamState & state);
+  static std::vector<uint8_t> CreateDataPacket(DataElementsVec const & points, PacketType type,
+                                               StreamState & state);
 
   static std::pair<PacketType, size_t> DecodeHeader(std::vector<uint8_t> const & data);
   static std::string DecodeAuthPacket(PacketType type, std::vector<uint8_t> const & data);
   static DataElementsVec DecodeDataPacket(PacketType type, std::vector<uint8_t> const & data);
+  static DataElementsVec DecodeDataPacket(PacketType type, std::vector<uint8_t> const & data,
+                                          StreamState & state);
+  // Decodes all the points of |stream|, which is the data received from a client over one
+  // or several connections: a sequence of packets with headers. An auth packet starts a new
+  // stream of DataV2 packets. Decoding stops at the first malformed or truncated packet.
+  static DataElementsVec DecodeDataPackets(std::vector<uint8_t> const & stream);
 
 private:
   static void InitHeader(std::vector<uint8_t> & packet, PacketType type, uint32_t payloadSize);
@@ -42,6 +42,7 @@ BOOST_PYTHON_MODULE(pytracking)
       .value("AuthV0", Protocol::PacketType::AuthV0)
       .value("DataV0", Protocol::PacketType::DataV0)
       .value("DataV1", Protocol::PacketType::DataV1)
+      .value("DataV2", Protocol::PacketType::DataV2)
       .value("CurrentAuth", Protocol::PacketType::CurrentAuth)
       .value("CurrentData", Protocol::PacketType::CurrentData);
 
@@ -51,6 +52,9 @@ BOOST_PYTHON_MODULE(pytracking)
   std::vector<uint8_t> (*CreateDataPacket2)(Protocol::DataElementsVec const &,
                                             tracking::Protocol::PacketType) =
       &Protocol::CreateDataPacket;
+  Protocol::DataElementsVec (*DecodeDataPacket1)(tracking::Protocol::PacketType,
+                                                 std::vector<uint8_t> const &) =
+      &Protocol::DecodeDataPacket;
 
   class_<Protocol>("Protocol")
       .def("CreateAuthPacket", &Protocol::CreateAuthPacket)
@@ -62,6 +66,8 @@ BOOST_PYTHON_MODULE(pytracking)
       .staticmethod("CreateHeader")
       .def("DecodeHeader", &Protocol::DecodeHeader)
       .staticmethod("DecodeHeader")
-      .def("DecodeDataPacket", &Protocol::DecodeDataPacket)
-      .staticmethod("DecodeDataPacket");
+      .def("DecodeDataPacket", DecodeDataPacket1)
+      .staticmethod("DecodeDataPacket")
+      .def("DecodeDataPackets", &Protocol::DecodeDataPackets)
+      .staticmethod("DecodeDataPackets");
 }
@@ -11,6 +11,7 @@
 
 #include "std/target_os.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
@@ -22,6 +23,16 @@ double constexpr kRequiredHorizontalAccuracy = 10.0;
 double constexpr kMinDelaySeconds = 1.0;
 double constexpr kReconnectDelaySeconds = 40.0;
 double constexpr kNotChargingEventPeriod = 5 * 60.0;
+double constexpr kConditionsCheckPeriod = 60.0;
+// The push delay grows up to this factor when pushes are less useful or more expensive.
+double constexpr kMaxPushDelayFactor = 4.0;
+// A vehicle which is slower than this is stuck in a traffic jam or parked, its points are
+// close to each other and may wait.
+double constexpr kSlowSpeedMps = 3.0;
+uint8_t constexpr kLowBatteryLevel = 20;
+// The points are pushed without waiting for the delay when so many of them are collected,
+// that is about a minute of driving.
+size_t constexpr kFlushPointsCount = 60;
 
 static_assert(kMinDelaySeconds != 0, "");
 } // namespace
@@ -33,13 +44,15 @@ const char Reporter::kEnableTrackingKey[] = "StatisticsEnabled";
 // static
 milliseconds const Reporter::kPushDelayMs = milliseconds(20000);
 
-// Set m_points size to be enough to keep all points even if one reconnect attempt failed.
+// Set m_points size to be enough to keep all points of the longest push delay even if one
+// reconnect attempt failed.
 Reporter::Reporter(unique_ptr<platform::Socket> socket, string const & host, uint16_t port,
                    milliseconds pushDelay)
   : m_allowSendingPoints(true)
   , m_realtimeSender(move(socket), host, port, false)
   , m_pushDelay(pushDelay)
-  , m_points(ceil(duration_cast<seconds>(pushDelay).count() + kReconnectDelaySeconds) / kMinDelaySeconds)
+  , m_points(ceil(duration_cast<seconds>(pushDelay).count() * kMaxPushDelayFactor +
+                  kReconnectDelaySeconds) / kMinDelaySeconds)
   , m_thread([this] { Run(); })
 {
 }
@@ -77,10 +90,22 @@ void Reporter::AddLocation(location::GpsInfo const & info, traffic::SpeedGroup t
     return;
   }
 
+  double const currentTime = base::Timer::LocalTime();
+  if (currentTime >= m_lastConditionsCheck + kConditionsCheckPeriod)
+  {
+    m_connectionType = Platform::ConnectionStatus();
+    m_batteryLevel = Platform::GetBatteryLevel();
+    m_lastConditionsCheck = currentTime;
+  }
+
   m_lastGpsTime = info.m_timestamp;
+  m_lastSpeedMps = info.HasSpeed() ? info.m_speedMpS : -1.0;
   m_input.push_back(
       DataPoint(info.m_timestamp, ms::LatLon(info.m_latitude, info.m_longitude),
                 static_cast<std::underlying_type<traffic::SpeedGroup>::type>(traffic)));
+
+  if (m_input.size() >= kFlushPointsCount)
+    m_cv.notify_one();
 }
 
 void Reporter::Run()
@@ -109,14 +134,38 @@ void Reporter::Run()
     }
     lock.lock();
 
+    auto const pushDelay = GetPushDelay();
     auto const passedMs = duration_cast<milliseconds>(steady_clock::now() - startTime);
-    if (passedMs < m_pushDelay)
-      m_cv.wait_for(lock, m_pushDelay - passedMs, [this]{return m_isFinished;});
+    if (passedMs < pushDelay)
+    {
+      m_cv.wait_for(lock, pushDelay - passedMs,
+                    [this] { return m_isFinished || m_input.size() >= kFlushPointsCount; });
+    }
   }
 
   LOG(LINFO, ("Tracking Reporter finished"));
 }
 
+milliseconds Reporter::GetPushDelay() const
+{
+  double factor = 1.0;
+  if (m_lastSpeedMps >= 0.0 && m_lastSpeedMps < kSlowSpeedMps)
+    factor *= 2.0;
+
+  switch (m_connectionType)
+  {
+  case Platform::EConnectionType::CONNECTION_NONE: factor = kMaxPushDelayFactor; break;
+  case Platform::EConnectionType::CONNECTION_WWAN: factor *= 2.0; break;
+  case Platform::EConnectionType::CONNECTION_WIFI: break;
+  }
+
+  if (m_batteryLevel < kLowBatteryLevel)
+    factor *= 2.0;
+
+  factor = min(factor, kMaxPushDelayFactor);
+  return duration_cast<milliseconds>(m_pushDelay * factor);
+}
+
 bool Reporter::SendPoints()
 {
   if (!m_allowSendingPoints)
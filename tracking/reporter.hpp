@@ -4,6 +4,8 @@
 
 #include "traffic/speed_groups.hpp"
 
+#include "platform/platform.hpp"
+
 #include "base/thread.hpp"
 
 #include <atomic>
@@ -36,6 +38,9 @@ public:
   static std::chrono::milliseconds const kPushDelayMs;
   static const char kEnableTrackingKey[];
 
+  // |pushDelay| is the delay between the pushes of a moving device on wifi, the points are
+  // pushed up to several times less often when the device barely moves, is on a cellular
+  // network or is low on battery, and sooner when a lot of them are collected.
   Reporter(std::unique_ptr<platform::Socket> socket, std::string const & host, uint16_t port,
            std::chrono::milliseconds pushDelay);
   ~Reporter();
@@ -49,6 +54,8 @@ public:
 private:
   void Run();
   bool SendPoints();
+  // Must be called with |m_mutex| locked.
+  std::chrono::milliseconds GetPushDelay() const;
 
   std::atomic<bool> m_allowSendingPoints;
   Connection m_realtimeSender;
@@ -64,6 +71,13 @@ private:
   // Last collected points, sends periodically to server.
   boost::circular_buffer<DataPoint> m_points;
   double m_lastGpsTime = 0.0;
+  // Conditions of the push delay. The platform is queried in AddLocation() because it may
+  // be accessible from the thread of the locations only.
+  // Negative if unknown.
+  double m_lastSpeedMps = -1.0;
+  double m_lastConditionsCheck = 0.0;
+  Platform::EConnectionType m_connectionType = Platform::EConnectionType::CONNECTION_WIFI;
+  uint8_t m_batteryLevel = 100;
   bool m_isFinished = false;
   std::mutex m_mutex;
   std::condition_variable m_cv;
@@ -58,12 +58,14 @@ extern "C" int LLVMFuzzerTestOneInput(uint8_t const * data, size_t size)
 
   Protocol::DecodeHeader(dataVec);
   for (auto const type : {Protocol::PacketType::Error, Protocol::PacketType::AuthV0,
-                          Protocol::PacketType::DataV0, Protocol::PacketType::DataV1})
+                          Protocol::PacketType::DataV0, Protocol::PacketType::DataV1,
+                          Protocol::PacketType::DataV2})
   {
     Protocol::CreateDataPacket(dataElementsVec, type);
     Protocol::CreateDataPacket(dataElementsCirc, type);
     Protocol::DecodeAuthPacket(type, dataVec);
     Protocol::DecodeDataPacket(type, dataVec);
   }
+  Protocol::DecodeDataPackets(dataVec);
   return 0;
 }
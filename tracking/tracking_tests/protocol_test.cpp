@@ -121,6 +121,7 @@ UNIT_TEST(Protocol_DecodeDataPacket)
 
   DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV0);
   DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV1);
+  DecodeDataPacketVersionTest(points, Protocol::PacketType::DataV2);
 }
 
 UNIT_TEST(Protocol_DecodeWrongDataPacket)
@@ -132,7 +133,8 @@ UNIT_TEST(Protocol_DecodeWrongDataPacket)
       vector<uint8_t>{0x0, 0x0, 0x23, 0xFF},
       vector<uint8_t>{0xFF, 0x1, 0x23, 0xFF, 0x1, 0x0, 0x27, 0x63, 0x32, 0x9, 0xFF},
   };
-  for (auto const packetType : {Protocol::PacketType::DataV0, Protocol::PacketType::DataV1})
+  for (auto const packetType : {Protocol::PacketType::DataV0, Protocol::PacketType::DataV1,
+                                Protocol::PacketType::DataV2})
   {
     for (auto const & payload : payloads)
     {
@@ -141,3 +143,68 @@ UNIT_TEST(Protocol_DecodeWrongDataPacket)
     }
   }
 }
+
+UNIT_TEST(Protocol_DataV2Stream)
+{
+  using Container = Protocol::DataElementsVec;
+
+  Container first;
+  first.push_back(Container::value_type(100, ms::LatLon(55.75, 37.61), 1));
+  first.push_back(Container::value_type(101, ms::LatLon(55.7501, 37.6102), 2));
+  Container second;
+  second.push_back(Container::value_type(103, ms::LatLon(55.7503, 37.6105), 3));
+  second.push_back(Container::value_type(104, ms::LatLon(55.7502, 37.6104), 3));
+
+  Protocol::StreamState writerState;
+  auto const firstPacket =
+      Protocol::CreateDataPacket(first, Protocol::PacketType::DataV2, writerState);
+  auto const secondPacket =
+      Protocol::CreateDataPacket(second, Protocol::PacketType::DataV2, writerState);
+
+  // The points of the second packet are delta-encoded against the first packet, a move of
+  // tens of meters takes 6 bytes including the timestamp and the traffic.
+  TEST_LESS_OR_EQUAL(secondPacket.size(), sizeof(uint32_t /* header */) + 1 + 2 * 6, ());
+  auto const standalone = Protocol::CreateDataPacket(second, Protocol::PacketType::DataV1);
+  TEST_LESS(secondPacket.size(), standalone.size(), ());
+
+  auto const payload = [](vector<uint8_t> const & packet) {
+    return vector<uint8_t>(begin(packet) + sizeof(uint32_t /* header */), end(packet));
+  };
+
+  // The second packet can't be decoded without the first one.
+  TEST(Protocol::DecodeDataPacket(Protocol::PacketType::DataV2, payload(secondPacket)).empty(), ());
+
+  Protocol::StreamState readerState;
+  auto result = Protocol::DecodeDataPacket(Protocol::PacketType::DataV2, payload(firstPacket),
+                                           readerState);
+  auto const secondResult = Protocol::DecodeDataPacket(Protocol::PacketType::DataV2,
+                                                       payload(secondPacket), readerState);
+  result.insert(result.end(), secondResult.begin(), secondResult.end());
+
+  Container expected = first;
+  expected.insert(expected.end(), second.begin(), second.end());
+  TEST_EQUAL(result.size(), expected.size(), ());
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    TEST_EQUAL(result[i].m_timestamp, expected[i].m_timestamp, ());
+    TEST_EQUAL(result[i].m_traffic, expected[i].m_traffic, ());
+    TEST(base::AlmostEqualAbs(result[i].m_latLon.m_lat, expected[i].m_latLon.m_lat, 1e-6), ());
+    TEST(base::AlmostEqualAbs(result[i].m_latLon.m_lon, expected[i].m_latLon.m_lon, 1e-6), ());
+  }
+
+  // A server reads the whole conversation of a client: an auth packet resets the stream.
+  vector<uint8_t> stream;
+  for (auto const & packet : {Protocol::CreateAuthPacket("ABC"), firstPacket, secondPacket,
+                              Protocol::CreateAuthPacket("ABC"), firstPacket})
+  {
+    stream.insert(stream.end(), packet.begin(), packet.end());
+  }
+  auto const bulk = Protocol::DecodeDataPackets(stream);
+  TEST_EQUAL(bulk.size(), expected.size() + first.size(), ());
+  for (size_t i = 0; i < expected.size(); ++i)
+    TEST(bulk[i] == result[i], (i));
+
+  // A truncated packet is dropped.
+  stream.pop_back();
+  TEST_EQUAL(Protocol::DecodeDataPackets(stream).size(), expected.size(), ());
+}
@@ -25,8 +25,9 @@ using namespace platform::tests_support;
 
 namespace
 {
-void TransferLocation(Reporter & reporter, TestSocket & testSocket, double timestamp,
-                      double latidute, double longtitude)
+void TransferLocation(Reporter & reporter, TestSocket & testSocket,
+                      Protocol::StreamState & state, double timestamp, double latidute,
+                      double longtitude)
 {
   location::GpsInfo gpsInfo;
   gpsInfo.m_timestamp = timestamp;
@@ -55,6 +56,7 @@ void TransferLocation(Reporter & reporter, TestSocket & testSocket, double times
     case Packet::Error:
     case Packet::DataV0:
     case Packet::DataV1:
+    case Packet::DataV2:
     {
       readSize = 0;
       break;
@@ -63,12 +65,10 @@ void TransferLocation(Reporter & reporter, TestSocket & testSocket, double times
   } while (readSize);
 
   TEST(!buffer.empty(), ());
-  vector<coding::TrafficGPSEncoder::DataPoint> points;
-  MemReader memReader(buffer.data(), buffer.size());
-  ReaderSource<MemReader> src(memReader);
-  src.Skip(sizeof(uint32_t /* header */));
-  coding::TrafficGPSEncoder::DeserializeDataPoints(coding::TrafficGPSEncoder::kLatestVersion, src,
-                                                   points);
+  auto const header = Protocol::DecodeHeader(buffer);
+  TEST_EQUAL(header.first, Protocol::PacketType::CurrentData, ());
+  vector<uint8_t> const payload(buffer.begin() + sizeof(uint32_t /* header */), buffer.end());
+  auto const points = Protocol::DecodeDataPacket(header.first, payload, state);
 
   TEST_EQUAL(points.size(), 1, ());
   auto const & point = points[0];
@@ -100,7 +100,9 @@ UNIT_TEST(Reporter_TransferLocations)
   TestSocket & testSocket = *socket.get();
 
   Reporter reporter(move(socket), "localhost", 0, milliseconds(10) /* pushDelay */);
-  TransferLocation(reporter, testSocket, 1.0, 2.0, 3.0);
-  TransferLocation(reporter, testSocket, 4.0, 5.0, 6.0);
-  TransferLocation(reporter, testSocket, 7.0, 8.0, 9.0);
+  // The packets of the connection make a single stream.
+  Protocol::StreamState state;
+  TransferLocation(reporter, testSocket, state, 1.0, 2.0, 3.0);
+  TransferLocation(reporter, testSocket, state, 4.0, 5.0, 6.0);
+  TransferLocation(reporter, testSocket, state, 7.0, 8.0, 9.0);
 }
@@ -71,7 +71,7 @@ traffic::TrafficInfo::Coloring TransformToSpeedGroups(SegmentMapping const & seg
     bool const vz = base::AlmostEqualAbs(v, 0.0, kEps);
     if (uz && vz)
     {
-      result[kv.first] = traffic::SpeedGroup::TempBlock;
+      result.Append(kv.first, traffic::SpeedGroup::TempBlock);
     }
     else if (vz)
     {
@@ -82,7 +82,7 @@ traffic::TrafficInfo::Coloring TransformToSpeedGroups(SegmentMapping const & seg
     {
       double p = 100.0 * u / v;
       p = base::Clamp(p, 0.0, 100.0);
-      result[kv.first] = traffic::GetSpeedGroupByPercentage(p);
+      result.Append(kv.first, traffic::GetSpeedGroupByPercentage(p));
     }
   }
   return result;
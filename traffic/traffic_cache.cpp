@@ -8,12 +8,14 @@ void TrafficCache::Set(MwmSet::MwmId const & mwmId, shared_ptr<TrafficInfo::Colo
 {
   lock_guard<mutex> guard(mutex);
   m_trafficColoring[mwmId] = coloring;
+  ++m_version;
 }
 
 void TrafficCache::Remove(MwmSet::MwmId const & mwmId)
 {
   lock_guard<mutex> guard(mutex);
   m_trafficColoring.erase(mwmId);
+  ++m_version;
 }
 
 void TrafficCache::CopyTraffic(AllMwmTrafficInfo & trafficColoring) const
@@ -26,5 +28,6 @@ void TrafficCache::Clear()
 {
   lock_guard<mutex> guard(mutex);
   m_trafficColoring.clear();
+  ++m_version;
 }
 }  // namespace traffic
@@ -4,6 +4,8 @@
 
 #include "indexer/mwm_set.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -20,6 +22,9 @@ public:
 
   virtual void CopyTraffic(AllMwmTrafficInfo & trafficColoring) const;
 
+  /// \returns a number which is changed every time the traffic is changed.
+  uint64_t GetVersion() const { return m_version; }
+
 protected:
   void Set(MwmSet::MwmId const & mwmId, std::shared_ptr<TrafficInfo::Coloring const> coloring);
   void Remove(MwmSet::MwmId const & mwmId);
@@ -28,5 +33,6 @@ protected:
 private:
   std::mutex m_mutex;
   AllMwmTrafficInfo m_trafficColoring;
+  std::atomic<uint64_t> m_version{0};
 };
 }  // namespace traffic
@@ -25,8 +25,10 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "defines.hpp"
 #include "private.h"
@@ -65,6 +67,22 @@ bool ReadRemoteFile(string const & url, vector<uint8_t> & contents, int & errorC
   return true;
 }
 
+// Returns the values of |keys| from |coloring|, the values of the other keys are unknown.
+// |coloring| goes in the order of the keys.
+void GetValues(vector<TrafficInfo::RoadSegmentId> const & keys,
+               TrafficInfo::Coloring const & coloring, vector<SpeedGroup> & values)
+{
+  values.assign(keys.size(), SpeedGroup::Unknown);
+  auto it = coloring.cbegin();
+  for (size_t i = 0; i < keys.size() && it != coloring.cend(); ++i)
+  {
+    while (it != coloring.cend() && it->first < keys[i])
+      ++it;
+    if (it != coloring.cend() && it->first == keys[i])
+      values[i] = it->second;
+  }
+}
+
 string MakeRemoteURL(string const & name, uint64_t version)
 {
   if (string(TRAFFIC_DATA_BASE_URL).empty())
@@ -79,6 +97,11 @@ string MakeRemoteURL(string const & name, uint64_t version)
 }
 
 char const kETag[] = "etag";
+// The client sends this header when it can apply a delta to the values of the sent ETag.
+char const kAcceptDelta[] = "X-Traffic-Accept-Delta";
+// Runs of changed values which are separated by at most this number of unchanged values are
+// merged, a run header takes more space than a few values.
+size_t constexpr kMaxDeltaGap = 4;
 }  // namespace
 
 // TrafficInfo::RoadSegmentId -----------------------------------------------------------------
@@ -89,11 +112,41 @@ TrafficInfo::RoadSegmentId::RoadSegmentId(uint32_t fid, uint16_t idx, uint8_t di
 {
 }
 
+// TrafficInfo::Coloring ---------------------------------------------------------------------------
+TrafficInfo::Coloring::Coloring(initializer_list<value_type> pairs) : m_pairs(pairs)
+{
+  stable_sort(m_pairs.begin(), m_pairs.end(),
+              [](value_type const & lhs, value_type const & rhs) { return lhs.first < rhs.first; });
+  m_pairs.erase(unique(m_pairs.begin(), m_pairs.end(),
+                       [](value_type const & lhs, value_type const & rhs) {
+                         return lhs.first == rhs.first;
+                       }),
+                m_pairs.end());
+}
+
+void TrafficInfo::Coloring::Append(RoadSegmentId const & id, SpeedGroup speedGroup)
+{
+  CHECK(m_pairs.empty() || m_pairs.back().first < id, (m_pairs.back().first, id));
+  m_pairs.emplace_back(id, speedGroup);
+}
+
+TrafficInfo::Coloring::const_iterator TrafficInfo::Coloring::find(RoadSegmentId const & id) const
+{
+  auto const it = lower_bound(m_pairs.cbegin(), m_pairs.cend(), id,
+                              [](value_type const & lhs, RoadSegmentId const & rhs) {
+                                return lhs.first < rhs;
+                              });
+  if (it == m_pairs.cend() || !(it->first == id))
+    return m_pairs.cend();
+  return it;
+}
+
 // TrafficInfo --------------------------------------------------------------------------------
 
 // static
 uint8_t const TrafficInfo::kLatestKeysVersion = 0;
 uint8_t const TrafficInfo::kLatestValuesVersion = 0;
+uint8_t const TrafficInfo::kDeltaValuesVersion = 1;
 
 TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion)
   : m_mwmId(mwmId)
@@ -146,7 +199,7 @@ TrafficInfo::TrafficInfo(MwmSet::MwmId const & mwmId, int64_t currentDataVersion
 TrafficInfo TrafficInfo::BuildForTesting(Coloring && coloring)
 {
   TrafficInfo info;
-  info.m_coloring = move(coloring);
+  info.m_coloring = make_shared<Coloring const>(move(coloring));
   return info;
 }
 
@@ -172,10 +225,15 @@ bool TrafficInfo::ReceiveTrafficData(string & etag)
   return false;
 }
 
+void TrafficInfo::SetLastColoring(shared_ptr<Coloring const> coloring)
+{
+  m_lastColoring = move(coloring);
+}
+
 SpeedGroup TrafficInfo::GetSpeedGroup(RoadSegmentId const & id) const
 {
-  auto const it = m_coloring.find(id);
-  if (it == m_coloring.cend())
+  auto const it = m_coloring->find(id);
+  if (it == m_coloring->cend())
     return SpeedGroup::Unknown;
   return it->second;
 }
@@ -207,6 +265,7 @@ void TrafficInfo::CombineColorings(vector<TrafficInfo::RoadSegmentId> const & ke
                                    TrafficInfo::Coloring & result)
 {
   result.clear();
+  result.reserve(keys.size());
   size_t numKnown = 0;
   size_t numUnknown = 0;
   size_t numUnexpectedKeys = knownColors.size();
@@ -215,12 +274,12 @@ void TrafficInfo::CombineColorings(vector<TrafficInfo::RoadSegmentId> const & ke
     auto it = knownColors.find(key);
     if (it == knownColors.end())
     {
-      result[key] = SpeedGroup::Unknown;
+      result.Append(key, SpeedGroup::Unknown);
       ++numUnknown;
     }
     else
     {
-      result[key] = it->second;
+      result.Append(key, it->second);
       ASSERT_GREATER(numUnexpectedKeys, 0, ());
       --numUnexpectedKeys;
       ++numKnown;
@@ -369,6 +428,58 @@ void TrafficInfo::SerializeTrafficValues(vector<SpeedGroup> const & values,
   deflate(buf.data(), buf.size(), back_inserter(result));
 }
 
+// static
+void TrafficInfo::SerializeTrafficValuesDelta(vector<SpeedGroup> const & lastValues,
+                                              vector<SpeedGroup> const & values,
+                                              vector<uint8_t> & result)
+{
+  CHECK_EQUAL(lastValues.size(), values.size(), ());
+
+  // Half-open ranges of the changed values.
+  vector<pair<size_t, size_t>> runs;
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    if (values[i] == lastValues[i])
+      continue;
+
+    if (!runs.empty() && i - runs.back().second <= kMaxDeltaGap)
+      runs.back().second = i + 1;
+    else
+      runs.emplace_back(i, i + 1);
+  }
+
+  vector<uint8_t> buf;
+  MemWriter<vector<uint8_t>> memWriter(buf);
+  WriteToSink(memWriter, kDeltaValuesVersion);
+  WriteVarUint(memWriter, values.size());
+  WriteVarUint(memWriter, runs.size());
+  size_t prevEnd = 0;
+  for (auto const & run : runs)
+  {
+    WriteVarUint(memWriter, run.first - prevEnd);
+    WriteVarUint(memWriter, run.second - run.first);
+    prevEnd = run.second;
+  }
+  {
+    BitWriter<decltype(memWriter)> bitWriter(memWriter);
+    auto const numSpeedGroups = static_cast<uint8_t>(SpeedGroup::Count);
+    for (auto const & run : runs)
+    {
+      for (size_t i = run.first; i < run.second; ++i)
+      {
+        uint8_t const u = static_cast<uint8_t>(values[i]);
+        CHECK_LESS(u, numSpeedGroups, ());
+        bitWriter.Write(u, 3);
+      }
+    }
+  }
+
+  using Deflate = coding::ZLib::Deflate;
+  Deflate deflate(Deflate::Format::ZLib, Deflate::Level::BestCompression);
+
+  deflate(buf.data(), buf.size(), back_inserter(result));
+}
+
 // static
 void TrafficInfo::DeserializeTrafficValues(vector<uint8_t> const & data,
                                            vector<SpeedGroup> & result)
@@ -384,6 +495,37 @@ void TrafficInfo::DeserializeTrafficValues(vector<uint8_t> const & data,
   ReaderSource<decltype(memReader)> src(memReader);
 
   auto const version = ReadPrimitiveFromSource<uint8_t>(src);
+  if (version == kDeltaValuesVersion)
+  {
+    auto const n = ReadVarUint<uint32_t>(src);
+    if (n != result.size())
+    {
+      MYTHROW(Reader::ReadException,
+              ("Traffic values delta is for", n, "values, but there are", result.size()));
+    }
+
+    auto const numRuns = ReadVarUint<uint32_t>(src);
+    vector<pair<size_t, size_t>> runs;
+    size_t prevEnd = 0;
+    for (uint32_t i = 0; i < numRuns; ++i)
+    {
+      size_t const begin = prevEnd + ReadVarUint<uint32_t>(src);
+      size_t const end = begin + ReadVarUint<uint32_t>(src);
+      if (end > result.size())
+        MYTHROW(Reader::ReadException, ("Traffic values delta run is out of range:", begin, end));
+      runs.emplace_back(begin, end);
+      prevEnd = end;
+    }
+
+    BitReader<decltype(src)> bitReader(src);
+    for (auto const & run : runs)
+    {
+      for (size_t i = run.first; i < run.second; ++i)
+        result[i] = static_cast<SpeedGroup>(bitReader.Read(3));
+    }
+    return;
+  }
+
   CHECK_EQUAL(version, kLatestValuesVersion, ("Unsupported version of traffic keys."));
 
   auto const n = ReadVarUint<uint32_t>(src);
@@ -456,6 +598,9 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
   request.LoadHeaders(true);
   request.SetRawHeader("User-Agent", GetPlatform().GetAppUserAgent());
   request.SetRawHeader("If-None-Match", etag);
+  bool const acceptDelta = m_lastColoring && !etag.empty() && !m_keys.empty();
+  if (acceptDelta)
+    request.SetRawHeader(kAcceptDelta, "1");
 
   if (!request.RunHttpRequest() || request.ErrorCode() != 200)
     return ProcessFailure(request, version);
@@ -463,6 +608,9 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
   {
     string const & response = request.ServerResponse();
     vector<uint8_t> contents(response.cbegin(), response.cend());
+    // A delta is applied to the last values, the full values replace them.
+    if (acceptDelta)
+      GetValues(m_keys, *m_lastColoring, values);
     DeserializeTrafficValues(contents, values);
   }
   catch (Reader::Exception const & e)
@@ -490,7 +638,7 @@ TrafficInfo::ServerDataStatus TrafficInfo::ReceiveTrafficValues(string & etag, v
 
 bool TrafficInfo::UpdateTrafficData(vector<SpeedGroup> const & values)
 {
-  m_coloring.clear();
+  m_coloring = make_shared<Coloring const>();
 
   if (m_keys.size() != values.size())
   {
@@ -505,11 +653,14 @@ bool TrafficInfo::UpdateTrafficData(vector<SpeedGroup> const & values)
     return false;
   }
 
+  Coloring coloring;
+  coloring.reserve(m_keys.size() - count(values.cbegin(), values.cend(), SpeedGroup::Unknown));
   for (size_t i = 0; i < m_keys.size(); ++i)
   {
     if (values[i] != SpeedGroup::Unknown)
-      m_coloring.emplace(m_keys[i], values[i]);
+      coloring.Append(m_keys[i], values[i]);
   }
+  m_coloring = make_shared<Coloring const>(move(coloring));
 
   return true;
 }
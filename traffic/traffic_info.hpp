@@ -4,8 +4,12 @@
 
 #include "indexer/mwm_set.hpp"
 
+#include <cstddef>
 #include <cstdint>
-#include <map>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace platform
@@ -22,6 +26,7 @@ class TrafficInfo
 public:
   static uint8_t const kLatestKeysVersion;
   static uint8_t const kLatestValuesVersion;
+  static uint8_t const kDeltaValuesVersion;
 
   enum class Availability
   {
@@ -71,8 +76,36 @@ public:
     uint8_t m_dir : 1;
   };
 
-  // todo(@m) unordered_map?
-  using Coloring = std::map<RoadSegmentId, SpeedGroup>;
+  // The mapping from road segments to speed groups. The pairs are kept in a flat array sorted
+  // by the segments, i.e. in the order of the traffic keys, so the lookups are binary searches
+  // over contiguous memory and a coloring of an mwm takes 12 bytes per segment.
+  class Coloring
+  {
+  public:
+    using value_type = std::pair<RoadSegmentId, SpeedGroup>;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    Coloring() = default;
+    // The pairs may go in any order, only the first of the pairs with equal segments is kept.
+    Coloring(std::initializer_list<value_type> pairs);
+
+    // |id| must be greater than the segments which are already added.
+    void Append(RoadSegmentId const & id, SpeedGroup speedGroup);
+
+    const_iterator find(RoadSegmentId const & id) const;
+
+    const_iterator begin() const { return m_pairs.cbegin(); }
+    const_iterator end() const { return m_pairs.cend(); }
+    const_iterator cbegin() const { return m_pairs.cbegin(); }
+    const_iterator cend() const { return m_pairs.cend(); }
+    size_t size() const { return m_pairs.size(); }
+    bool empty() const { return m_pairs.empty(); }
+    void clear() { m_pairs.clear(); }
+    void reserve(size_t n) { m_pairs.reserve(n); }
+
+  private:
+    std::vector<value_type> m_pairs;
+  };
 
   TrafficInfo() = default;
 
@@ -89,12 +122,19 @@ public:
   // *NOTE* This method must not be called on the UI thread.
   bool ReceiveTrafficData(std::string & etag);
 
+  // Sets the coloring received with the ETag which is passed to ReceiveTrafficData(). The server
+  // may send only the values which have changed since then and they are applied to |coloring|.
+  void SetLastColoring(std::shared_ptr<Coloring const> coloring);
+
   // Returns the latest known speed group by a feature segment's id
   // or SpeedGroup::Unknown if there is no information about the segment.
   SpeedGroup GetSpeedGroup(RoadSegmentId const & id) const;
 
   MwmSet::MwmId const & GetMwmId() const { return m_mwmId; }
-  Coloring const & GetColoring() const { return m_coloring; }
+  Coloring const & GetColoring() const { return *m_coloring; }
+  // The coloring is immutable, an update of the traffic data replaces it with a new one. So the
+  // router and the renderer share it instead of copying and see either the old or the new data.
+  std::shared_ptr<Coloring const> GetSharedColoring() const { return m_coloring; }
   Availability GetAvailability() const { return m_availability; }
 
   // Extracts RoadSegmentIds from mwm and stores them in a sorted order.
@@ -116,6 +156,13 @@ public:
 
   static void SerializeTrafficValues(std::vector<SpeedGroup> const & values, std::vector<uint8_t> & result);
 
+  // Serializes only the runs of |values| which differ from |lastValues|.
+  static void SerializeTrafficValuesDelta(std::vector<SpeedGroup> const & lastValues,
+                                          std::vector<SpeedGroup> const & values,
+                                          std::vector<uint8_t> & result);
+
+  // If |data| is a delta, |result| must contain the last values and it is patched in place.
+  // Throws Reader::Exception if a delta doesn't match |result|.
   static void DeserializeTrafficValues(std::vector<uint8_t> const & data, std::vector<SpeedGroup> & result);
 
 private:
@@ -128,6 +175,7 @@ private:
   };
 
   friend void UnitTest_TrafficInfo_UpdateTrafficData();
+  friend void UnitTest_TrafficInfo_SharedColoring();
 
   // todo(@m) A temporary method. Remove it once the keys are added
   // to the generator and the data is regenerated.
@@ -144,7 +192,7 @@ private:
   ServerDataStatus ProcessFailure(platform::HttpClient const & request, int64_t const mwmVersion);
 
   // The mapping from feature segments to speed groups (see speed_groups.hpp).
-  Coloring m_coloring;
+  std::shared_ptr<Coloring const> m_coloring = std::make_shared<Coloring const>();
 
   // The keys of the coloring map. The values are downloaded periodically
   // and combined with the keys to form m_coloring.
@@ -152,6 +200,9 @@ private:
   // keys are saved in.
   std::vector<RoadSegmentId> m_keys;
 
+  // The coloring the server sends deltas to, see SetLastColoring().
+  std::shared_ptr<Coloring const> m_lastColoring;
+
   MwmSet::MwmId m_mwmId;
   Availability m_availability = Availability::Unknown;
   int64_t m_currentDataVersion = 0;
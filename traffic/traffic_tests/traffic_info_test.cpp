@@ -3,6 +3,8 @@
 #include "traffic/speed_groups.hpp"
 #include "traffic/traffic_info.hpp"
 
+#include "coding/reader.hpp"
+
 #include "platform/local_country_file.hpp"
 #include "platform/platform_tests_support/writable_dir_changer.hpp"
 
@@ -115,6 +117,47 @@ UNIT_TEST(TrafficInfo_Serialization)
   }
 }
 
+UNIT_TEST(TrafficInfo_ValuesDelta)
+{
+  vector<SpeedGroup> lastValues(100, SpeedGroup::G5);
+  lastValues[50] = SpeedGroup::Unknown;
+
+  vector<SpeedGroup> values = lastValues;
+  values[0] = SpeedGroup::G0;
+  values[10] = SpeedGroup::G1;
+  values[12] = SpeedGroup::TempBlock;
+  values[50] = SpeedGroup::G3;
+  values[99] = SpeedGroup::Unknown;
+
+  vector<uint8_t> buf;
+  TrafficInfo::SerializeTrafficValuesDelta(lastValues, values, buf);
+
+  vector<uint8_t> fullBuf;
+  TrafficInfo::SerializeTrafficValues(values, fullBuf);
+  TEST_LESS(buf.size(), fullBuf.size(), ());
+
+  auto result = lastValues;
+  TrafficInfo::DeserializeTrafficValues(buf, result);
+  TEST_EQUAL(result, values, ());
+
+  // A full update replaces the values.
+  TrafficInfo::DeserializeTrafficValues(fullBuf, result);
+  TEST_EQUAL(result, values, ());
+
+  // A delta for another number of values.
+  vector<SpeedGroup> other(10, SpeedGroup::G1);
+  bool thrown = false;
+  try
+  {
+    TrafficInfo::DeserializeTrafficValues(buf, other);
+  }
+  catch (Reader::Exception const &)
+  {
+    thrown = true;
+  }
+  TEST(thrown, ());
+}
+
 UNIT_TEST(TrafficInfo_UpdateTrafficData)
 {
   vector<TrafficInfo::RoadSegmentId> const keys = {
@@ -142,4 +185,34 @@ UNIT_TEST(TrafficInfo_UpdateTrafficData)
   for (size_t i = 0; i < keys.size(); ++i)
     TEST_EQUAL(info.GetSpeedGroup(keys[i]), values2[i], ());
 }
+
+UNIT_TEST(TrafficInfo_SharedColoring)
+{
+  TrafficInfo::Coloring const coloring = {
+      {TrafficInfo::RoadSegmentId(5, 0, 1), SpeedGroup::G2},
+      {TrafficInfo::RoadSegmentId(1, 0, 0), SpeedGroup::G1},
+      {TrafficInfo::RoadSegmentId(5, 0, 0), SpeedGroup::G3},
+  };
+  TEST_EQUAL(coloring.size(), 3, ());
+  TEST(is_sorted(coloring.begin(), coloring.end()), ());
+  TEST(coloring.find(TrafficInfo::RoadSegmentId(1, 0, 1)) == coloring.cend(), ());
+  auto const it = coloring.find(TrafficInfo::RoadSegmentId(5, 0, 1));
+  TEST(it != coloring.cend(), ());
+  TEST_EQUAL(it->second, SpeedGroup::G2, ());
+
+  vector<TrafficInfo::RoadSegmentId> const keys = {
+      TrafficInfo::RoadSegmentId(0, 0, 0), TrafficInfo::RoadSegmentId(1, 0, 0)};
+
+  TrafficInfo info;
+  info.SetTrafficKeysForTesting(keys);
+  TEST(info.UpdateTrafficData({SpeedGroup::G1, SpeedGroup::Unknown}), ());
+  auto const shared = info.GetSharedColoring();
+  TEST_EQUAL(shared->size(), 1, ());
+
+  // An update replaces the coloring, the shared one stays the same.
+  TEST(info.UpdateTrafficData({SpeedGroup::G4, SpeedGroup::G5}), ());
+  TEST_EQUAL(info.GetColoring().size(), 2, ());
+  TEST_EQUAL(shared->size(), 1, ());
+  TEST_EQUAL(shared->find(keys[0])->second, SpeedGroup::G1, ());
+}
 }  // namespace traffic
@@ -0,0 +1,172 @@
+#include "testing/testing.hpp"
+
+#include "transit/transit_timetable.hpp"
+
+#include "coding/writer.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace transit;
+
+namespace
+{
+using Leg = Raptor::Leg;
+
+TimeSec constexpr kMinute = 60;
+
+// Stops 0 - 1 - 2 - 3 are served by the slow line 0 with a trip every 10 minutes, the line stops
+// for 5 minutes between the stops. Line 1 goes 0 - 4 and line 2 goes 5 - 3, both take 2 minutes
+// between the stops. There is a 3 minutes footpath from 4 to 5 which makes the 0 - 4 - 5 - 3
+// journey faster but with two trips. Line 1 does not run on day 1.
+void BuildTimetable(Timetable & timetable)
+{
+  TimetableBuilder builder(6 /* stopsCount */, 2 /* daysCount */);
+  auto const everyDay = builder.AddService({0, 1});
+  auto const firstDay = builder.AddService({0});
+
+  auto const slow = builder.AddRoute({0, 1, 2, 3});
+  for (TimeSec start = 0; start < 60 * kMinute; start += 10 * kMinute)
+  {
+    builder.AddTrip(slow, everyDay,
+                    {{start, start},
+                     {start + 5 * kMinute, start + 5 * kMinute},
+                     {start + 10 * kMinute, start + 10 * kMinute},
+                     {start + 15 * kMinute, start + 15 * kMinute}});
+  }
+
+  auto const first = builder.AddRoute({0, 4});
+  for (TimeSec start = 0; start < 60 * kMinute; start += 20 * kMinute)
+  {
+    builder.AddTrip(first, firstDay,
+                    {{start, start}, {start + 2 * kMinute, start + 2 * kMinute}});
+  }
+
+  auto const second = builder.AddRoute({5, 3});
+  for (TimeSec start = 0; start < 60 * kMinute; start += 5 * kMinute)
+  {
+    builder.AddTrip(second, everyDay,
+                    {{start, start + kMinute}, {start + 3 * kMinute, start + 3 * kMinute}});
+  }
+
+  builder.AddTransfer(4, 5, 3 * kMinute);
+  builder.Build(timetable);
+}
+
+void TestParetoJourneys(Timetable const & timetable)
+{
+  Raptor raptor(timetable);
+  std::vector<Raptor::Journey> journeys;
+  raptor.FindJourneys(0 /* from */, 0 /* day */, 0 /* departure */, 3 /* to */, journeys);
+
+  TEST_EQUAL(journeys.size(), 2, ());
+
+  // One trip with the slow line.
+  TEST_EQUAL(journeys[0].m_tripsCount, 1, ());
+  TEST_EQUAL(journeys[0].m_arrival, 15 * kMinute, ());
+  TEST_EQUAL(journeys[0].m_legs.size(), 1, ());
+  TEST(journeys[0].m_legs[0].m_type == Leg::Type::Trip, ());
+  TEST_EQUAL(journeys[0].m_legs[0].m_from, 0, ());
+  TEST_EQUAL(journeys[0].m_legs[0].m_to, 3, ());
+
+  // Line 1 arrives to 4 at 2:00, the footpath comes to 5 at 5:00, the trip of line 2 starting at
+  // 5:00 departs at 6:00 and arrives to 3 at 8:00.
+  TEST_EQUAL(journeys[1].m_tripsCount, 2, ());
+  TEST_EQUAL(journeys[1].m_arrival, 8 * kMinute, ());
+  auto const & legs = journeys[1].m_legs;
+  TEST_EQUAL(legs.size(), 3, ());
+  TEST(legs[0].m_type == Leg::Type::Trip, ());
+  TEST_EQUAL(legs[0].m_route, 1, ());
+  TEST_EQUAL(legs[0].m_arrival, 2 * kMinute, ());
+  TEST(legs[1].m_type == Leg::Type::Transfer, ());
+  TEST_EQUAL(legs[1].m_from, 4, ());
+  TEST_EQUAL(legs[1].m_to, 5, ());
+  TEST(legs[2].m_type == Leg::Type::Trip, ());
+  TEST_EQUAL(legs[2].m_route, 2, ());
+  TEST_EQUAL(legs[2].m_trip, 1, ());
+  TEST_EQUAL(legs[2].m_departure, 6 * kMinute, ());
+}
+
+UNIT_TEST(Raptor_ParetoJourneys)
+{
+  Timetable timetable;
+  BuildTimetable(timetable);
+  TestParetoJourneys(timetable);
+}
+
+UNIT_TEST(Raptor_DepartureTime)
+{
+  Timetable timetable;
+  BuildTimetable(timetable);
+  Raptor raptor(timetable);
+  std::vector<Raptor::Journey> journeys;
+
+  // The next trip of line 1 is at 20:00, so the slow line departing at 10:00 is the fastest.
+  raptor.FindJourneys(0 /* from */, 0 /* day */, 1 /* departure */, 3 /* to */, journeys);
+  TEST_EQUAL(journeys.size(), 1, ());
+  TEST_EQUAL(journeys[0].m_tripsCount, 1, ());
+  TEST_EQUAL(journeys[0].m_arrival, 25 * kMinute, ());
+  TEST_EQUAL(journeys[0].m_legs[0].m_trip, 1, ());
+
+  // No trips after the end of the service.
+  raptor.FindJourneys(0 /* from */, 0 /* day */, 60 * kMinute, 3 /* to */, journeys);
+  TEST(journeys.empty(), ());
+}
+
+UNIT_TEST(Raptor_ServiceDays)
+{
+  Timetable timetable;
+  BuildTimetable(timetable);
+  TEST(timetable.IsTripActive(1 /* route */, 0 /* trip */, 0 /* day */), ());
+  TEST(!timetable.IsTripActive(1 /* route */, 0 /* trip */, 1 /* day */), ());
+  TEST(!timetable.IsTripActive(0 /* route */, 0 /* trip */, 2 /* day */), ());
+
+  // Line 1 does not run on day 1, so the only journey is with the slow line.
+  Raptor raptor(timetable);
+  std::vector<Raptor::Journey> journeys;
+  raptor.FindJourneys(0 /* from */, 1 /* day */, 0 /* departure */, 3 /* to */, journeys);
+  TEST_EQUAL(journeys.size(), 1, ());
+  TEST_EQUAL(journeys[0].m_arrival, 15 * kMinute, ());
+  TEST_EQUAL(journeys[0].m_legs[0].m_route, 0, ());
+}
+
+UNIT_TEST(Raptor_Footpath)
+{
+  Timetable timetable;
+  BuildTimetable(timetable);
+  Raptor raptor(timetable);
+  std::vector<Raptor::Journey> journeys;
+
+  raptor.FindJourneys(4 /* from */, 0 /* day */, 0 /* departure */, 5 /* to */, journeys);
+  TEST_EQUAL(journeys.size(), 1, ());
+  TEST_EQUAL(journeys[0].m_tripsCount, 0, ());
+  TEST_EQUAL(journeys[0].m_arrival, 3 * kMinute, ());
+}
+
+UNIT_TEST(Timetable_Map)
+{
+  Timetable timetable;
+  BuildTimetable(timetable);
+  std::vector<uint8_t> buffer;
+  {
+    MemWriter<decltype(buffer)> writer(buffer);
+    timetable.Serialize(writer);
+  }
+
+  // The mapped timetable reads the stop times right from |buffer|.
+  Timetable mapped;
+  mapped.Map(buffer.data());
+
+  TEST_EQUAL(mapped.GetStopsCount(), timetable.GetStopsCount(), ());
+  TEST_EQUAL(mapped.GetDaysCount(), timetable.GetDaysCount(), ());
+  TEST_EQUAL(mapped.GetRoutesCount(), timetable.GetRoutesCount(), ());
+  for (Timetable::RouteIdx route = 0; route < timetable.GetRoutesCount(); ++route)
+  {
+    TEST_EQUAL(mapped.GetTripsCount(route), timetable.GetTripsCount(route), (route));
+    auto const last = timetable.GetTripsCount(route) - 1;
+    TEST_EQUAL(mapped.GetStopTime(route, last, 1).m_arrival,
+               timetable.GetStopTime(route, last, 1).m_arrival, (route));
+  }
+  TestParetoJourneys(mapped);
+}
+}  // namespace
@@ -0,0 +1,371 @@
+#include "transit/transit_timetable.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+uint32_t constexpr kNotQueued = std::numeric_limits<uint32_t>::max();
+}  // namespace
+
+namespace transit
+{
+// TimetableBuilder --------------------------------------------------------------------------------
+TimetableBuilder::TimetableBuilder(uint32_t stopsCount, uint32_t daysCount)
+  : m_stopsCount(stopsCount), m_daysCount(daysCount)
+{
+}
+
+TimetableBuilder::ServiceIdx TimetableBuilder::AddService(std::vector<DayIdx> const & days)
+{
+  CHECK_LESS(m_servicesCount, std::numeric_limits<ServiceIdx>::max(), ());
+
+  auto const words = (m_daysCount + 63) / 64;
+  m_serviceDays.resize(m_serviceDays.size() + words, 0);
+  auto * bitmap = m_serviceDays.data() + m_servicesCount * words;
+  for (auto const day : days)
+  {
+    CHECK_LESS(day, m_daysCount, ());
+    bitmap[day / 64] |= uint64_t{1} << (day % 64);
+  }
+  return static_cast<ServiceIdx>(m_servicesCount++);
+}
+
+TimetableBuilder::RouteIdx TimetableBuilder::AddRoute(std::vector<StopIdx> const & stops)
+{
+  CHECK_GREATER_OR_EQUAL(stops.size(), 2, ());
+
+  Timetable::Route route;
+  route.m_stopsOffset = static_cast<uint32_t>(m_routeStops.size());
+  route.m_stopsCount = static_cast<uint32_t>(stops.size());
+  route.m_tripsOffset = static_cast<uint32_t>(m_tripStarts.size());
+  route.m_timesOffset = static_cast<uint32_t>(m_timeOffsets.size());
+  for (auto const stop : stops)
+  {
+    CHECK_LESS(stop, m_stopsCount, ());
+    m_routeStops.push_back(stop);
+  }
+
+  m_routes.push_back(route);
+  return static_cast<RouteIdx>(m_routes.size() - 1);
+}
+
+void TimetableBuilder::AddTrip(RouteIdx routeIdx, ServiceIdx service,
+                               std::vector<StopTime> const & times)
+{
+  CHECK_EQUAL(routeIdx + 1, m_routes.size(), ("Trips must be added to the last added route."));
+  CHECK_LESS(service, m_servicesCount, ());
+
+  auto & route = m_routes[routeIdx];
+  CHECK_EQUAL(times.size(), route.m_stopsCount, ());
+  auto const start = times.front().m_arrival;
+  for (size_t i = 0; i < times.size(); ++i)
+  {
+    CHECK_LESS_OR_EQUAL(times[i].m_arrival, times[i].m_departure, (i));
+    CHECK_LESS_OR_EQUAL(times[i].m_departure - start, std::numeric_limits<uint16_t>::max(), (i));
+    if (i != 0)
+      CHECK_LESS_OR_EQUAL(times[i - 1].m_departure, times[i].m_arrival, (i));
+    // The planner finds trips by binary search, so departures of the trips must be ordered
+    // at every stop.
+    if (route.m_tripsCount != 0)
+    {
+      auto const prevStart = m_tripStarts.back();
+      auto const prevIdx = m_timeOffsets.size() - 2 * (route.m_stopsCount - i);
+      CHECK_LESS_OR_EQUAL(prevStart + m_timeOffsets[prevIdx], times[i].m_arrival, (i));
+      CHECK_LESS_OR_EQUAL(prevStart + m_timeOffsets[prevIdx + 1], times[i].m_departure, (i));
+    }
+  }
+
+  m_tripStarts.push_back(start);
+  m_tripServices.push_back(service);
+  for (auto const & time : times)
+  {
+    m_timeOffsets.push_back(static_cast<uint16_t>(time.m_arrival - start));
+    m_timeOffsets.push_back(static_cast<uint16_t>(time.m_departure - start));
+  }
+  ++route.m_tripsCount;
+}
+
+void TimetableBuilder::AddTransfer(StopIdx from, StopIdx to, TimeSec duration)
+{
+  CHECK_LESS(from, m_stopsCount, ());
+  CHECK_LESS(to, m_stopsCount, ());
+  m_transfers.emplace_back(from, Timetable::Transfer(to, duration));
+}
+
+void TimetableBuilder::Build(Timetable & timetable)
+{
+  std::vector<uint32_t> stopRoutesOffsets(m_stopsCount + 1, 0);
+  for (auto const stop : m_routeStops)
+    ++stopRoutesOffsets[stop + 1];
+  for (size_t i = 1; i < stopRoutesOffsets.size(); ++i)
+    stopRoutesOffsets[i] += stopRoutesOffsets[i - 1];
+
+  std::vector<Timetable::RouteStop> stopRoutes(m_routeStops.size());
+  std::vector<uint32_t> next(stopRoutesOffsets.cbegin(), stopRoutesOffsets.cend() - 1);
+  for (RouteIdx routeIdx = 0; routeIdx < m_routes.size(); ++routeIdx)
+  {
+    auto const & route = m_routes[routeIdx];
+    for (uint32_t position = 0; position < route.m_stopsCount; ++position)
+    {
+      auto & routeStop = stopRoutes[next[m_routeStops[route.m_stopsOffset + position]]++];
+      routeStop.m_route = routeIdx;
+      routeStop.m_position = position;
+    }
+  }
+
+  std::stable_sort(m_transfers.begin(), m_transfers.end(),
+                   [](auto const & lhs, auto const & rhs) { return lhs.first < rhs.first; });
+  std::vector<uint32_t> transfersOffsets(m_stopsCount + 1, 0);
+  std::vector<Timetable::Transfer> transfers;
+  transfers.reserve(m_transfers.size());
+  for (auto const & transfer : m_transfers)
+  {
+    ++transfersOffsets[transfer.first + 1];
+    transfers.push_back(transfer.second);
+  }
+  for (size_t i = 1; i < transfersOffsets.size(); ++i)
+    transfersOffsets[i] += transfersOffsets[i - 1];
+
+  timetable.m_version = Timetable::Version::Latest;
+  timetable.m_stopsCount = m_stopsCount;
+  timetable.m_daysCount = m_daysCount;
+  timetable.m_routes.steal(m_routes);
+  timetable.m_routeStops.steal(m_routeStops);
+  timetable.m_tripStarts.steal(m_tripStarts);
+  timetable.m_tripServices.steal(m_tripServices);
+  timetable.m_timeOffsets.steal(m_timeOffsets);
+  timetable.m_serviceDays.steal(m_serviceDays);
+  timetable.m_stopRoutesOffsets.steal(stopRoutesOffsets);
+  timetable.m_stopRoutes.steal(stopRoutes);
+  timetable.m_transfersOffsets.steal(transfersOffsets);
+  timetable.m_transfers.steal(transfers);
+  m_transfers.clear();
+}
+
+// Raptor ------------------------------------------------------------------------------------------
+Raptor::Raptor(Timetable const & timetable, uint32_t maxTrips)
+  : m_timetable(timetable), m_maxTrips(maxTrips)
+{
+  CHECK_GREATER(m_maxTrips, 0, ());
+}
+
+void Raptor::FindJourneys(Timetable::StopIdx from, Timetable::DayIdx day, TimeSec departure,
+                          Timetable::StopIdx to, std::vector<Journey> & journeys)
+{
+  CHECK_LESS(from, m_timetable.GetStopsCount(), ());
+  CHECK_LESS(to, m_timetable.GetStopsCount(), ());
+
+  journeys.clear();
+  m_day = day;
+  Init(from, departure);
+  RelaxTransfers(0 /* round */);
+  if (m_arrivals[0][to] != kInvalidTimeSec)
+  {
+    journeys.emplace_back();
+    MakeJourney(0 /* round */, from, to, journeys.back());
+  }
+
+  for (uint32_t round = 1; round <= m_maxTrips && !m_markedStops.empty(); ++round)
+  {
+    m_arrivals[round] = m_arrivals[round - 1];
+    m_labels[round] = m_labels[round - 1];
+
+    ScanRoutes(round, to);
+    RelaxTransfers(round);
+
+    if (m_arrivals[round][to] < m_arrivals[round - 1][to])
+    {
+      journeys.emplace_back();
+      MakeJourney(round, from, to, journeys.back());
+    }
+  }
+}
+
+void Raptor::Init(Timetable::StopIdx from, TimeSec departure)
+{
+  auto const stopsCount = m_timetable.GetStopsCount();
+  m_arrivals.resize(m_maxTrips + 1);
+  m_labels.resize(m_maxTrips + 1);
+  m_arrivals[0].assign(stopsCount, kInvalidTimeSec);
+  m_labels[0].assign(stopsCount, Label());
+  m_best.assign(stopsCount, kInvalidTimeSec);
+  m_marked.assign(stopsCount, false);
+  m_markedStops.clear();
+  m_routesToScan.assign(m_timetable.GetRoutesCount(), kNotQueued);
+  m_queuedRoutes.clear();
+
+  m_arrivals[0][from] = departure;
+  m_best[from] = departure;
+  m_labels[0][from].m_from = from;
+  m_labels[0][from].m_departure = departure;
+  m_marked[from] = true;
+  m_markedStops.push_back(from);
+}
+
+void Raptor::ScanRoutes(uint32_t round, Timetable::StopIdx to)
+{
+  auto const & timetable = m_timetable;
+  auto const & prevArrivals = m_arrivals[round - 1];
+  auto & arrivals = m_arrivals[round];
+  auto & labels = m_labels[round];
+
+  // Every route is scanned once from the first of its stops improved in the previous round.
+  for (auto const stop : m_markedStops)
+  {
+    m_marked[stop] = false;
+    for (auto i = timetable.m_stopRoutesOffsets[stop];
+         i < timetable.m_stopRoutesOffsets[stop + 1]; ++i)
+    {
+      auto const & routeStop = timetable.m_stopRoutes[i];
+      auto & position = m_routesToScan[routeStop.m_route];
+      if (position == kNotQueued)
+        m_queuedRoutes.push_back(routeStop.m_route);
+      position = std::min(position, routeStop.m_position);
+    }
+  }
+  m_markedStops.clear();
+
+  for (auto const routeIdx : m_queuedRoutes)
+  {
+    auto const & route = timetable.m_routes[routeIdx];
+    auto const * stops = &timetable.m_routeStops[route.m_stopsOffset];
+    uint32_t trip = route.m_tripsCount;
+    Timetable::StopIdx boardingStop = 0;
+    TimeSec boardingTime = 0;
+
+    for (auto position = m_routesToScan[routeIdx]; position < route.m_stopsCount; ++position)
+    {
+      auto const stop = stops[position];
+      if (trip != route.m_tripsCount)
+      {
+        auto const arrival = timetable.GetStopTime(route, trip, position).m_arrival;
+        // Arrivals later than the best known arrival to the target are useless.
+        if (arrival < std::min(m_best[stop], m_best[to]))
+        {
+          arrivals[stop] = arrival;
+          m_best[stop] = arrival;
+          auto & label = labels[stop];
+          label.m_type = Leg::Type::Trip;
+          label.m_route = routeIdx;
+          label.m_trip = trip;
+          label.m_from = boardingStop;
+          label.m_departure = boardingTime;
+          if (!m_marked[stop])
+          {
+            m_marked[stop] = true;
+            m_markedStops.push_back(stop);
+          }
+        }
+      }
+
+      // An earlier trip may be caught at the stop.
+      auto const prevArrival = prevArrivals[stop];
+      if (prevArrival == kInvalidTimeSec)
+        continue;
+      if (trip != route.m_tripsCount &&
+          prevArrival > timetable.GetStopTime(route, trip, position).m_departure)
+      {
+        continue;
+      }
+
+      auto const earliest = FindTrip(route, position, prevArrival);
+      if (earliest < trip)
+      {
+        trip = earliest;
+        boardingStop = stop;
+        boardingTime = timetable.GetStopTime(route, trip, position).m_departure;
+      }
+    }
+    m_routesToScan[routeIdx] = kNotQueued;
+  }
+  m_queuedRoutes.clear();
+}
+
+void Raptor::RelaxTransfers(uint32_t round)
+{
+  auto const & timetable = m_timetable;
+  auto & arrivals = m_arrivals[round];
+  auto & labels = m_labels[round];
+
+  // Only the stops improved by trips are the sources of footpaths, footpaths are transitively
+  // closed.
+  auto const count = m_markedStops.size();
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto const from = m_markedStops[i];
+    if (labels[from].m_type != Leg::Type::Trip)
+      continue;
+
+    for (auto j = timetable.m_transfersOffsets[from]; j < timetable.m_transfersOffsets[from + 1];
+         ++j)
+    {
+      auto const & transfer = timetable.m_transfers[j];
+      auto const arrival = arrivals[from] + transfer.m_duration;
+      if (arrival >= m_best[transfer.m_to])
+        continue;
+
+      arrivals[transfer.m_to] = arrival;
+      m_best[transfer.m_to] = arrival;
+      auto & label = labels[transfer.m_to];
+      label.m_type = Leg::Type::Transfer;
+      label.m_from = from;
+      label.m_departure = arrivals[from];
+      if (!m_marked[transfer.m_to])
+      {
+        m_marked[transfer.m_to] = true;
+        m_markedStops.push_back(transfer.m_to);
+      }
+    }
+  }
+}
+
+uint32_t Raptor::FindTrip(Timetable::Route const & route, uint32_t position, TimeSec time) const
+{
+  uint32_t lo = 0;
+  uint32_t hi = route.m_tripsCount;
+  while (lo < hi)
+  {
+    auto const mid = lo + (hi - lo) / 2;
+    if (m_timetable.GetStopTime(route, mid, position).m_departure < time)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  while (lo < route.m_tripsCount && !m_timetable.IsTripActive(route, lo, m_day))
+    ++lo;
+  return lo;
+}
+
+void Raptor::MakeJourney(uint32_t round, Timetable::StopIdx from, Timetable::StopIdx to,
+                         Journey & journey) const
+{
+  journey.m_arrival = m_arrivals[round][to];
+  journey.m_tripsCount = 0;
+  journey.m_legs.clear();
+
+  auto stop = to;
+  while (stop != from)
+  {
+    auto const & label = m_labels[round][stop];
+    Leg leg;
+    leg.m_type = label.m_type;
+    leg.m_from = label.m_from;
+    leg.m_to = stop;
+    leg.m_departure = label.m_departure;
+    leg.m_arrival = m_arrivals[round][stop];
+    if (label.m_type == Leg::Type::Trip)
+    {
+      CHECK_GREATER(round, 0, ());
+      leg.m_route = label.m_route;
+      leg.m_trip = label.m_trip;
+      ++journey.m_tripsCount;
+      --round;
+    }
+    journey.m_legs.push_back(leg);
+    stop = label.m_from;
+  }
+  std::reverse(journey.m_legs.begin(), journey.m_legs.end());
+}
+}  // namespace transit
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "coding/succinct_mapper.hpp"
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Compact timetable of transit services and a round-based (RAPTOR) journey planner over it
+// (D. Delling, T. Pajor, R. F. Werneck, "Round-Based Public Transit Routing", 2012).
+namespace transit
+{
+// Seconds since the start of the service day.
+using TimeSec = uint32_t;
+TimeSec constexpr kInvalidTimeSec = std::numeric_limits<TimeSec>::max();
+
+// Trips are grouped into routes: sequences of stops visited by all the trips of a route. The
+// timetable is stored as a set of flat arrays which are mapped from the section as is, so it
+// is queried without deserialization:
+// * start times of the trips, route by route;
+// * stop times of the trips as 16-bit offsets from the starts of the trips, trip by trip;
+// * services of the trips and a bitmap of service days for every service;
+// * routes and footpaths by stops.
+// The section must be read on the platform with the same endianness as it was written on.
+class Timetable
+{
+public:
+  using StopIdx = uint32_t;
+  using RouteIdx = uint32_t;
+  using ServiceIdx = uint16_t;
+  // Days are counted from the first day of the calendar of the timetable.
+  using DayIdx = uint32_t;
+
+  enum class Version : uint32_t
+  {
+    V0 = 0,
+    Latest = V0
+  };
+
+  struct StopTime
+  {
+    StopTime() = default;
+    StopTime(TimeSec arrival, TimeSec departure) : m_arrival(arrival), m_departure(departure) {}
+
+    TimeSec m_arrival = 0;
+    TimeSec m_departure = 0;
+  };
+
+  struct Transfer
+  {
+    Transfer() = default;
+    Transfer(StopIdx to, TimeSec duration) : m_to(to), m_duration(duration) {}
+
+    StopIdx m_to = 0;
+    TimeSec m_duration = 0;
+  };
+
+  Timetable() = default;
+
+  /// \brief Maps the timetable from |data| which must be 8-bytes aligned and must outlive
+  /// the timetable.
+  void Map(uint8_t const * data) { coding::Map(*this, data, "Timetable"); }
+
+  template <typename Writer>
+  void Serialize(Writer & writer)
+  {
+    coding::Freeze(*this, writer, "Timetable");
+  }
+
+  uint32_t GetStopsCount() const { return m_stopsCount; }
+  uint32_t GetDaysCount() const { return m_daysCount; }
+  uint32_t GetRoutesCount() const { return static_cast<uint32_t>(m_routes.size()); }
+  uint32_t GetTripsCount(RouteIdx route) const { return m_routes[route].m_tripsCount; }
+
+  StopTime GetStopTime(RouteIdx route, uint32_t trip, uint32_t position) const
+  {
+    return GetStopTime(m_routes[route], trip, position);
+  }
+
+  bool IsTripActive(RouteIdx route, uint32_t trip, DayIdx day) const
+  {
+    return IsTripActive(m_routes[route], trip, day);
+  }
+
+  template <typename Visitor>
+  void map(Visitor & visitor)
+  {
+    visitor(m_version, "version");
+    visitor(m_stopsCount, "stopsCount");
+    visitor(m_daysCount, "daysCount");
+    visitor(m_routes, "routes");
+    visitor(m_routeStops, "routeStops");
+    visitor(m_tripStarts, "tripStarts");
+    visitor(m_tripServices, "tripServices");
+    visitor(m_timeOffsets, "timeOffsets");
+    visitor(m_serviceDays, "serviceDays");
+    visitor(m_stopRoutesOffsets, "stopRoutesOffsets");
+    visitor(m_stopRoutes, "stopRoutes");
+    visitor(m_transfersOffsets, "transfersOffsets");
+    visitor(m_transfers, "transfers");
+  }
+
+private:
+  friend class Raptor;
+  friend class TimetableBuilder;
+
+  struct Route
+  {
+    uint32_t m_stopsOffset = 0;
+    uint32_t m_stopsCount = 0;
+    // Index of the first trip of the route in the trips arrays.
+    uint32_t m_tripsOffset = 0;
+    uint32_t m_tripsCount = 0;
+    // Index of the first stop time offset of the route.
+    uint32_t m_timesOffset = 0;
+  };
+
+  // Route and the position of a stop in it.
+  struct RouteStop
+  {
+    RouteIdx m_route = 0;
+    uint32_t m_position = 0;
+  };
+
+  StopTime GetStopTime(Route const & route, uint32_t trip, uint32_t position) const
+  {
+    auto const start = m_tripStarts[route.m_tripsOffset + trip];
+    auto const i = route.m_timesOffset + 2 * (trip * route.m_stopsCount + position);
+    return StopTime(start + m_timeOffsets[i], start + m_timeOffsets[i + 1]);
+  }
+
+  bool IsTripActive(Route const & route, uint32_t trip, DayIdx day) const
+  {
+    if (day >= m_daysCount)
+      return false;
+    auto const words = GetServiceWordsCount();
+    auto const service = m_tripServices[route.m_tripsOffset + trip];
+    return ((m_serviceDays[service * words + day / 64] >> (day % 64)) & 1) != 0;
+  }
+
+  uint32_t GetServiceWordsCount() const { return (m_daysCount + 63) / 64; }
+
+  Version m_version = Version::Latest;
+  uint32_t m_stopsCount = 0;
+  uint32_t m_daysCount = 0;
+
+  succinct::mapper::mappable_vector<Route> m_routes;
+  succinct::mapper::mappable_vector<StopIdx> m_routeStops;
+  succinct::mapper::mappable_vector<TimeSec> m_tripStarts;
+  succinct::mapper::mappable_vector<ServiceIdx> m_tripServices;
+  // Arrival and departure offsets from the start of the trip for every stop of every trip.
+  succinct::mapper::mappable_vector<uint16_t> m_timeOffsets;
+  succinct::mapper::mappable_vector<uint64_t> m_serviceDays;
+
+  // Routes and footpaths by stops: the items of stop |s| are in [offsets[s], offsets[s + 1]).
+  succinct::mapper::mappable_vector<uint32_t> m_stopRoutesOffsets;
+  succinct::mapper::mappable_vector<RouteStop> m_stopRoutes;
+  succinct::mapper::mappable_vector<uint32_t> m_transfersOffsets;
+  succinct::mapper::mappable_vector<Transfer> m_transfers;
+
+  DISALLOW_COPY_AND_MOVE(Timetable);
+};
+
+class TimetableBuilder
+{
+public:
+  using StopIdx = Timetable::StopIdx;
+  using RouteIdx = Timetable::RouteIdx;
+  using ServiceIdx = Timetable::ServiceIdx;
+  using DayIdx = Timetable::DayIdx;
+  using StopTime = Timetable::StopTime;
+
+  TimetableBuilder(uint32_t stopsCount, uint32_t daysCount);
+
+  /// \brief Adds a service running on |days| and returns its index.
+  ServiceIdx AddService(std::vector<DayIdx> const & days);
+  /// \brief Adds a route visiting |stops| and returns its index.
+  RouteIdx AddRoute(std::vector<StopIdx> const & stops);
+  /// \brief Adds a trip of |service| to the last added |route|. |times| are the stop times at
+  /// the stops of the route. Trips must be added in the order of departure and must not overtake
+  /// each other. A trip must be shorter than 18 hours.
+  void AddTrip(RouteIdx route, ServiceIdx service, std::vector<StopTime> const & times);
+  /// \brief Adds a footpath from |from| to |to| which takes |duration|. Footpaths are not
+  /// chained by the planner, so they must be transitively closed.
+  void AddTransfer(StopIdx from, StopIdx to, TimeSec duration);
+
+  /// \brief Builds the indices of routes and footpaths by stops and moves all the data to
+  /// |timetable|. The builder must not be used after that.
+  void Build(Timetable & timetable);
+
+private:
+  uint32_t m_stopsCount;
+  uint32_t m_daysCount;
+  uint32_t m_servicesCount = 0;
+  std::vector<Timetable::Route> m_routes;
+  std::vector<StopIdx> m_routeStops;
+  std::vector<TimeSec> m_tripStarts;
+  std::vector<ServiceIdx> m_tripServices;
+  std::vector<uint16_t> m_timeOffsets;
+  std::vector<uint64_t> m_serviceDays;
+  std::vector<std::pair<StopIdx, Timetable::Transfer>> m_transfers;
+};
+
+/// \brief Finds the journeys with the earliest arrival for every number of trips, i.e. the
+/// Pareto set of (arrival time, number of trips) journeys. Round k of the algorithm finds the
+/// earliest arrivals with at most k trips by scanning every route which is reachable from the
+/// stops improved in round k - 1 once.
+/// \note This class reuses its memory between the queries and is not thread-safe.
+class Raptor
+{
+public:
+  struct Leg
+  {
+    enum class Type
+    {
+      Trip,
+      Transfer
+    };
+
+    Type m_type = Type::Trip;
+    // Route and trip indices for Type::Trip legs.
+    Timetable::RouteIdx m_route = 0;
+    uint32_t m_trip = 0;
+    Timetable::StopIdx m_from = 0;
+    Timetable::StopIdx m_to = 0;
+    TimeSec m_departure = 0;
+    TimeSec m_arrival = 0;
+  };
+
+  struct Journey
+  {
+    TimeSec m_arrival = kInvalidTimeSec;
+    uint32_t m_tripsCount = 0;
+    std::vector<Leg> m_legs;
+  };
+
+  explicit Raptor(Timetable const & timetable, uint32_t maxTrips = 8);
+
+  /// \brief Fills |journeys| with the Pareto set of the journeys from |from| departing on |day|
+  /// not earlier than |departure| to |to|, ordered by the number of trips. Only the trips
+  /// running on |day| are used.
+  void FindJourneys(Timetable::StopIdx from, Timetable::DayIdx day, TimeSec departure,
+                    Timetable::StopIdx to, std::vector<Journey> & journeys);
+
+private:
+  struct Label
+  {
+    Leg::Type m_type = Leg::Type::Trip;
+    Timetable::RouteIdx m_route = 0;
+    uint32_t m_trip = 0;
+    // Boarding stop of a trip or the source stop of a footpath.
+    Timetable::StopIdx m_from = 0;
+    TimeSec m_departure = 0;
+  };
+
+  void Init(Timetable::StopIdx from, TimeSec departure);
+  void ScanRoutes(uint32_t round, Timetable::StopIdx to);
+  void RelaxTransfers(uint32_t round);
+  // Returns the first trip of |route| running on |m_day| and departing from |position| not
+  // earlier than |time| or the trips count if there is no such trip.
+  uint32_t FindTrip(Timetable::Route const & route, uint32_t position, TimeSec time) const;
+  void MakeJourney(uint32_t round, Timetable::StopIdx from, Timetable::StopIdx to,
+                   Journey & journey) const;
+
+  Timetable const & m_timetable;
+  uint32_t const m_maxTrips;
+  Timetable::DayIdx m_day = 0;
+
+  // Earliest arrivals and the last legs to the stops by rounds.
+  std::vector<std::vector<TimeSec>> m_arrivals;
+  std::vector<std::vector<Label>> m_labels;
+  std::vector<TimeSec> m_best;
+  std::vector<bool> m_marked;
+  std::vector<Timetable::StopIdx> m_markedStops;
+  // Earliest position to scan from for the routes to scan in the current round.
+  std::vector<uint32_t> m_routesToScan;
+  std::vector<Timetable::RouteIdx> m_queuedRoutes;
+};
+}  // namespace transit
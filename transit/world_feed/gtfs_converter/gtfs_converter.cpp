@@ -9,8 +9,17 @@
 #include "base/assert.hpp"
 #include "base/file_name_utils.hpp"
 #include "base/logging.hpp"
+#include "base/thread_pool_computational.hpp"
 #include "base/timer.hpp"
 
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "3party/gflags/src/gflags/gflags.h"
 
 DEFINE_string(
@@ -27,6 +36,9 @@ DEFINE_string(start_feed, "", "Optional. Feed directory from which the process c
 DEFINE_string(stop_feed, "", "Optional. Feed directory on which to stop the process");
 DEFINE_bool(generate_trivial_shapes, false,
             "Optional. Generate trivial shapes for trips without shapes.");
+DEFINE_uint64(threads_count, 0, "Optional. Count of threads for reading feeds and projecting "
+                                "stops to shapes. If count equals zero, count of threads is set "
+                                "automatically.");
 
 // Finds subdirectories with feeds.
 Platform::FilesList GetGtfsFeedsInDirectory(std::string const & path)
@@ -165,11 +177,55 @@ FeedStatus ReadFeed(gtfs::Feed & feed)
   return FeedStatus::OK;
 }
 
+// Feed which is read from the disk in the thread pool.
+struct FeedTask
+{
+  explicit FeedTask(std::string const & path) : m_path(path) {}
+
+  std::string m_path;
+  std::unique_ptr<gtfs::Feed> m_feed;
+  std::future<FeedStatus> m_status;
+  double m_readSeconds = 0.0;
+};
+
+// Time spent on the stages of the feed conversion.
+struct FeedProfile
+{
+  std::string m_path;
+  double m_readSeconds = 0.0;
+  double m_convertSeconds = 0.0;
+  double m_saveSeconds = 0.0;
+
+  double GetTotalSeconds() const { return m_readSeconds + m_convertSeconds + m_saveSeconds; }
+};
+
+void LogSlowestFeeds(std::vector<FeedProfile> & profiles)
+{
+  size_t constexpr kSlowestFeedsCount = 10;
+  size_t const count = std::min(kSlowestFeedsCount, profiles.size());
+  std::partial_sort(profiles.begin(), profiles.begin() + count, profiles.end(),
+                    [](FeedProfile const & lhs, FeedProfile const & rhs) {
+                      return lhs.GetTotalSeconds() > rhs.GetTotalSeconds();
+                    });
+
+  LOG(LINFO, ("Slowest feeds:"));
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto const & profile = profiles[i];
+    LOG(LINFO, (profile.m_path, "read", profile.m_readSeconds, "s, convert",
+                profile.m_convertSeconds, "s, save", profile.m_saveSeconds, "s"));
+  }
+}
+
 // Reads GTFS feeds from directories in |FLAGS_path_gtfs_feeds|. Converts each feed to the WorldFeed
 // object and saves to the |FLAGS_path_json| path in the new transit line-by-line json format.
+// Parsing of the GTFS files takes most of the time, so up to |threadsCount| next feeds are read
+// in the thread pool while the current one is converted. Feeds are converted and saved strictly
+// in the order of |gtfsFeeds|: |generator| assigns ids in the order of requests and the ids must
+// be the same between re-runs.
 bool ConvertFeeds(transit::IdGenerator & generator, transit::IdGenerator & generatorEdges,
                   transit::ColorPicker & colorPicker,
-                  feature::CountriesFilesAffiliation & mwmMatcher)
+                  feature::CountriesFilesAffiliation & mwmMatcher, size_t threadsCount)
 {
   auto const gtfsFeeds = GetGtfsFeedsInDirectory(FLAGS_path_gtfs_feeds);
 
@@ -180,6 +236,7 @@ bool ConvertFeeds(transit::IdGenerator & generator, transit::IdGenerator & gener
   }
 
   std::vector<std::string> invalidFeeds;
+  std::vector<FeedProfile> profiles;
 
   size_t feedsWithNoShapesCount = 0;
   size_t feedsNotDumpedCount = 0;
@@ -187,10 +244,11 @@ bool ConvertFeeds(transit::IdGenerator & generator, transit::IdGenerator & gener
   size_t feedsTotal = gtfsFeeds.size();
   bool pass = true;
 
+  // Indexes of the feeds to handle in |gtfsFeeds|.
+  std::vector<size_t> feedIds;
   for (size_t i = 0; i < gtfsFeeds.size(); ++i)
   {
-    base::Timer feedTimer;
-    auto feedPath = gtfsFeeds[i];
+    auto const & feedPath = gtfsFeeds[i];
 
     if (SkipFeed(feedPath, pass))
     {
@@ -199,48 +257,86 @@ bool ConvertFeeds(transit::IdGenerator & generator, transit::IdGenerator & gener
       continue;
     }
 
-    bool stop = StopOnFeed(feedPath);
-    if (stop)
+    feedIds.push_back(i);
+
+    if (StopOnFeed(feedPath))
+    {
       feedsTotal -= (gtfsFeeds.size() - i - 1);
+      break;
+    }
+  }
+
+  // Tasks are declared before the pool to outlive it.
+  std::deque<FeedTask> tasks;
+  base::thread_pool::computational::ThreadPool pool(threadsCount);
+  size_t nextFeed = 0;
+
+  auto const submitReading = [&]() {
+    auto & task = tasks.emplace_back(gtfsFeeds[feedIds[nextFeed++]]);
+    ExtendPath(task.m_path);
+    task.m_feed = std::make_unique<gtfs::Feed>(task.m_path);
+    task.m_status = pool.Submit([&task]() {
+      base::Timer timer;
+      auto const status = ReadFeed(*task.m_feed);
+      task.m_readSeconds = timer.ElapsedSeconds();
+      return status;
+    });
+  };
+
+  for (auto const i : feedIds)
+  {
+    // At most |threadsCount| feeds are kept in memory besides the converted one.
+    while (nextFeed < feedIds.size() && tasks.size() <= threadsCount)
+      submitReading();
 
-    ExtendPath(feedPath);
-    LOG(LINFO, ("Handling feed", feedPath));
+    auto & task = tasks.front();
+    auto const status = task.m_status.get();
+    LOG(LINFO, ("Handling feed", task.m_path));
 
-    gtfs::Feed feed(feedPath);
+    FeedProfile profile;
+    profile.m_path = task.m_path;
+    profile.m_readSeconds = task.m_readSeconds;
 
-    if (auto const res = ReadFeed(feed); res != FeedStatus::OK)
+    if (status == FeedStatus::OK)
     {
-      if (res == FeedStatus::NO_SHAPES)
-        feedsWithNoShapesCount++;
+      base::Timer timer;
+      transit::WorldFeed globalFeed(generator, generatorEdges, colorPicker, mwmMatcher);
+      bool const converted =
+          globalFeed.SetFeed(std::move(*task.m_feed), FLAGS_generate_trivial_shapes, threadsCount);
+      profile.m_convertSeconds = timer.ElapsedSeconds();
+
+      if (converted)
+      {
+        timer.Reset();
+        bool const saved = globalFeed.Save(FLAGS_path_json, i == 0 /* overwrite */);
+        profile.m_saveSeconds = timer.ElapsedSeconds();
+
+        if (saved)
+          ++feedsDumped;
+        else
+          ++feedsNotDumpedCount;
+
+        LOG(LINFO, ("Merged:", saved ? "yes" : "no"));
+      }
       else
-        invalidFeeds.push_back(feedPath);
-
-      if (stop)
-        break;
-      continue;
+      {
+        LOG(LINFO, ("Error transforming feed for json representation."));
+        ++feedsNotDumpedCount;
+      }
     }
-
-    transit::WorldFeed globalFeed(generator, generatorEdges, colorPicker, mwmMatcher);
-
-    if (!globalFeed.SetFeed(std::move(feed), FLAGS_generate_trivial_shapes))
+    else if (status == FeedStatus::NO_SHAPES)
     {
-      LOG(LINFO, ("Error transforming feed for json representation."));
-      ++feedsNotDumpedCount;
-      if (stop)
-        break;
-      continue;
+      ++feedsWithNoShapesCount;
     }
-
-    bool const saved = globalFeed.Save(FLAGS_path_json, i == 0 /* overwrite */);
-    if (saved)
-      ++feedsDumped;
     else
-      ++feedsNotDumpedCount;
-
-    LOG(LINFO, ("Merged:", saved ? "yes" : "no", "time", feedTimer.ElapsedSeconds(), "s"));
+    {
+      invalidFeeds.push_back(task.m_path);
+    }
 
-    if (stop)
-      break;
+    LOG(LINFO, ("Time: read", profile.m_readSeconds, "s, convert", profile.m_convertSeconds,
+                "s, save", profile.m_saveSeconds, "s"));
+    profiles.push_back(std::move(profile));
+    tasks.pop_front();
   }
 
   LOG(LINFO, ("Corrupted feeds paths:", invalidFeeds));
@@ -248,6 +344,7 @@ bool ConvertFeeds(transit::IdGenerator & generator, transit::IdGenerator & gener
   LOG(LINFO, ("Feeds with no shapes:", feedsWithNoShapesCount, "/", feedsTotal));
   LOG(LINFO, ("Feeds parsed but not dumped:", feedsNotDumpedCount, "/", feedsTotal));
   LOG(LINFO, ("Total dumped feeds:", feedsDumped, "/", feedsTotal));
+  LogSlowestFeeds(profiles);
 
   return true;
 }
@@ -309,10 +406,14 @@ int main(int argc, char ** argv)
   feature::CountriesFilesAffiliation mwmMatcher(GetPlatform().ResourcesDir(),
                                                 false /* haveBordersForWholeWorld */);
 
+  size_t const threadsCount = FLAGS_threads_count != 0
+                                  ? static_cast<size_t>(FLAGS_threads_count)
+                                  : std::max(GetPlatform().CpuCores(), 1U);
+
   // We convert GTFS feeds to the json format suitable for generator_tool and save it to the
   // corresponding directory.
   if (!FLAGS_path_gtfs_feeds.empty() &&
-      !ConvertFeeds(generator, generatorEdges, colorPicker, mwmMatcher))
+      !ConvertFeeds(generator, generatorEdges, colorPicker, mwmMatcher, threadsCount))
     return EXIT_FAILURE;
 
   // We mixin data in our "old transit" (in fact subway-only) json format to the resulting files
@@ -12,9 +12,11 @@
 #include "base/logging.hpp"
 #include "base/newtype.hpp"
 #include "base/stl_helpers.hpp"
+#include "base/thread_pool_computational.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <future>
 #include <iosfwd>
 #include <limits>
 #include <memory>
@@ -959,7 +961,7 @@ void WorldFeed::FillLinesSchedule()
 }
 
 std::optional<Direction> WorldFeed::ProjectStopsToShape(
-    ShapesIter & itShape, StopsOnLines const & stopsOnLines,
+    ShapesIter & itShape, StopsOnLines const & stopsOnLines, IdSet const & shapeLineIds,
     std::unordered_map<TransitId, std::vector<size_t>> & stopsToIndexes)
 {
   IdList const & stopIds = stopsOnLines.m_stopSeq;
@@ -987,7 +989,7 @@ std::optional<Direction> WorldFeed::ProjectStopsToShape(
 
         LOG(LWARNING,
             ("Error projecting stops to the shape. GTFS trip id",
-             m_lines.m_data[lineId].m_gtfsTripId, "shapeId", shapeId, "stopId", stopId, "i", i,
+             m_lines.m_data.at(lineId).m_gtfsTripId, "shapeId", shapeId, "stopId", stopId, "i", i,
              "previous index on shape", prevIdx, "trips count", stopsOnLines.m_lines.size()));
         return false;
       }
@@ -1005,9 +1007,9 @@ std::optional<Direction> WorldFeed::ProjectStopsToShape(
           }
         }
 
-        for (auto const & lineId : m_shapes.m_data[shapeId].m_lineIds)
+        for (auto const & lineId : shapeLineIds)
         {
-          auto & line = m_lines.m_data[lineId];
+          auto & line = m_lines.m_data.at(lineId);
 
           if (line.m_shapeLink.m_startIndex >= curIdx)
             ++line.m_shapeLink.m_startIndex;
@@ -1068,45 +1070,102 @@ std::unordered_map<TransitId, std::vector<StopsOnLines>> WorldFeed::GetStopsForS
   return stopsOnShapes;
 }
 
-std::pair<size_t, size_t> WorldFeed::ModifyShapes()
+void WorldFeed::ProjectStopsToShapes(ShapeProjection & projection)
+{
+  auto itShape = m_shapes.m_data.find(projection.m_shapeId);
+  CHECK(itShape != m_shapes.m_data.end(), (projection.m_shapeId));
+
+  // Lines which are linked to the shape. Only their links are shifted when points are inserted
+  // into the shape.
+  IdSet lineIds;
+  for (auto const & stopsOnLines : *projection.m_stopsLists)
+    lineIds.insert(stopsOnLines.m_lines.begin(), stopsOnLines.m_lines.end());
+
+  for (auto & stopsOnLines : *projection.m_stopsLists)
+  {
+    if (stopsOnLines.m_stopSeq.size() < 2)
+    {
+      TransitId const lineId = *stopsOnLines.m_lines.begin();
+      LOG(LWARNING, ("Error in stops count. Lines count:", stopsOnLines.m_stopSeq.size(),
+                     "GTFS trip id:", m_lines.m_data.at(lineId).m_gtfsTripId));
+      stopsOnLines.m_isValid = false;
+      ++projection.m_invalidCount;
+    }
+    else if (auto const direction = ProjectStopsToShape(itShape, stopsOnLines, lineIds,
+                                                        projection.m_stopToShapeIndex))
+    {
+      stopsOnLines.m_direction = *direction;
+      ++projection.m_validCount;
+    }
+    else
+    {
+      stopsOnLines.m_isValid = false;
+      ++projection.m_invalidCount;
+    }
+
+    if (projection.m_invalidCount > kMaxInvalidShapesCount)
+      return;
+  }
+}
+
+std::pair<size_t, size_t> WorldFeed::ModifyShapes(size_t threadsCount)
 {
   auto stopsOnShapes = GetStopsForShapeMatching();
   size_t invalidStopSequences = 0;
   size_t validStopSequences = 0;
 
+  std::vector<ShapeProjection> projections;
+  projections.reserve(stopsOnShapes.size());
   for (auto & [shapeId, stopsLists] : stopsOnShapes)
   {
     CHECK(!stopsLists.empty(), (shapeId));
+    projections.emplace_back(shapeId, stopsLists);
+  }
 
-    auto itShape = m_shapes.m_data.find(shapeId);
-    CHECK(itShape != m_shapes.m_data.end(), (shapeId));
+  // Every shape is projected independently: it touches only its own points and the lines linked
+  // to it, so the shapes are split between the threads. The containers of the feed are not
+  // resized until all the projections are done.
+  if (threadsCount > 1 && projections.size() > 1)
+  {
+    base::thread_pool::computational::ThreadPool pool(threadsCount);
+    std::vector<std::future<void>> tasks;
+    size_t const chunkSize = (projections.size() + threadsCount - 1) / threadsCount;
+    for (size_t chunkBeg = 0; chunkBeg < projections.size(); chunkBeg += chunkSize)
+    {
+      size_t const chunkEnd = std::min(chunkBeg + chunkSize, projections.size());
+      tasks.push_back(pool.Submit([this, &projections, chunkBeg, chunkEnd]() {
+        for (size_t i = chunkBeg; i < chunkEnd; ++i)
+          ProjectStopsToShapes(projections[i]);
+      }));
+    }
+    for (auto & task : tasks)
+      task.get();
+  }
+  else
+  {
+    size_t invalidCount = 0;
+    for (auto & projection : projections)
+    {
+      ProjectStopsToShapes(projection);
+      invalidCount += projection.m_invalidCount;
+      if (invalidCount > kMaxInvalidShapesCount)
+        break;
+    }
+  }
 
-    std::unordered_map<TransitId, std::vector<size_t>> stopToShapeIndex;
+  for (auto const & projection : projections)
+  {
+    invalidStopSequences += projection.m_invalidCount;
+    validStopSequences += projection.m_validCount;
+  }
 
-    for (auto & stopsOnLines : stopsLists)
-    {
-      if (stopsOnLines.m_stopSeq.size() < 2)
-      {
-        TransitId const lineId = *stopsOnLines.m_lines.begin();
-        LOG(LWARNING, ("Error in stops count. Lines count:", stopsOnLines.m_stopSeq.size(),
-                       "GTFS trip id:", m_lines.m_data[lineId].m_gtfsTripId));
-        stopsOnLines.m_isValid = false;
-        ++invalidStopSequences;
-      }
-      else if (auto const direction = ProjectStopsToShape(itShape, stopsOnLines, stopToShapeIndex))
-      {
-        stopsOnLines.m_direction = *direction;
-        ++validStopSequences;
-      }
-      else
-      {
-        stopsOnLines.m_isValid = false;
-        ++invalidStopSequences;
-      }
+  if (invalidStopSequences > kMaxInvalidShapesCount)
+    return {invalidStopSequences, validStopSequences};
 
-      if (invalidStopSequences > kMaxInvalidShapesCount)
-        return {invalidStopSequences, validStopSequences};
-    }
+  for (auto & projection : projections)
+  {
+    auto & stopsLists = *projection.m_stopsLists;
+    auto const & stopToShapeIndex = projection.m_stopToShapeIndex;
 
     for (auto & stopsOnLines : stopsLists)
     {
@@ -1460,7 +1519,7 @@ bool WorldFeed::UpdateEdgeWeights()
   return true;
 }
 
-bool WorldFeed::SetFeed(gtfs::Feed && feed, bool generateTrivialShapes)
+bool WorldFeed::SetFeed(gtfs::Feed && feed, bool generateTrivialShapes, size_t threadsCount)
 {
   m_feed = std::move(feed);
   m_gtfsIdToHash.resize(FieldIdx::IdxCount);
@@ -1507,7 +1566,7 @@ bool WorldFeed::SetFeed(gtfs::Feed && feed, bool generateTrivialShapes)
   }
   LOG(LINFO, ("Filled stop timetables and road graph edges."));
 
-  auto const [badShapesCount, goodShapesCount] = ModifyShapes();
+  auto const [badShapesCount, goodShapesCount] = ModifyShapes(threadsCount);
   LOG(LINFO, ("Modified shapes."));
 
   if (badShapesCount > kMaxInvalidShapesCount || (goodShapesCount == 0 && badShapesCount > 0))
@@ -284,8 +284,9 @@ class WorldFeed
 public:
   WorldFeed(IdGenerator & generator, IdGenerator & generatorEdges, ColorPicker & colorPicker,
             feature::CountriesFilesAffiliation & mwmMatcher);
-  // Transforms GTFS feed into the global feed.
-  bool SetFeed(gtfs::Feed && feed, bool generateTrivialShapes);
+  // Transforms GTFS feed into the global feed. Stops are projected to the shapes in
+  // |threadsCount| threads.
+  bool SetFeed(gtfs::Feed && feed, bool generateTrivialShapes, size_t threadsCount = 1);
 
   // Dumps global feed to |world_feed_path|.
   bool Save(std::string const & worldFeedDir, bool overwrite);
@@ -331,9 +332,27 @@ private:
 
   std::unordered_map<TransitId, std::vector<StopsOnLines>> GetStopsForShapeMatching();
 
+  // Stop sequences linked to the shape and the results of their projection to it.
+  struct ShapeProjection
+  {
+    ShapeProjection(TransitId shapeId, std::vector<StopsOnLines> & stopsLists)
+      : m_shapeId(shapeId), m_stopsLists(&stopsLists)
+    {
+    }
+
+    TransitId m_shapeId;
+    std::vector<StopsOnLines> * m_stopsLists;
+    std::unordered_map<TransitId, std::vector<size_t>> m_stopToShapeIndex;
+    size_t m_invalidCount = 0;
+    size_t m_validCount = 0;
+  };
+
+  // Projects all the stop sequences of |projection| to its shape. Modifies only the shape and the
+  // lines linked to it, so different shapes may be projected concurrently.
+  void ProjectStopsToShapes(ShapeProjection & projection);
   // Adds stops projections to shapes. Updates corresponding links to shapes. Returns number of
   // invalid and valid shapes.
-  std::pair<size_t, size_t> ModifyShapes();
+  std::pair<size_t, size_t> ModifyShapes(size_t threadsCount);
   // Fills transfers based on GTFS transfers.
   void FillTransfers();
   // Fills gates based on GTFS stops.
@@ -342,7 +361,7 @@ private:
   bool UpdateEdgeWeights();
 
   std::optional<Direction> ProjectStopsToShape(
-      ShapesIter & itShape, StopsOnLines const & stopsOnLines,
+      ShapesIter & itShape, StopsOnLines const & stopsOnLines, IdSet const & shapeLineIds,
       std::unordered_map<TransitId, std::vector<size_t>> & stopsToIndexes);
 
   // Splits data into regions.
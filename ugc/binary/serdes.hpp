@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <iterator>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -181,30 +182,40 @@ public:
     return false;
   }
 
+  // Returns true when there is UGC for the feature with |index|. Only the index of the section
+  // is looked up, the UGC is not decoded.
   template <typename R>
-  bool DeserializeV0(R & reader, FeatureIndex index, UGC & ugc)
+  bool HasUGC(R & reader, FeatureIndex index)
   {
-    InitializeIfNeeded(reader);
+    NonOwningReaderSource source(reader);
+    auto const v = ReadPrimitiveFromSource<Version>(source);
 
-    UGCOffset offset = 0;
+    auto subReader = reader.CreateSubReader(source.Pos(), source.Size());
+
+    switch (v)
     {
-      ReaderPtr<Reader> idsSubReader(CreateFeatureIndexesSubReader(reader));
-      DDVector<FeatureIndex, ReaderPtr<Reader>> ids(idsSubReader);
-      auto const it = std::lower_bound(ids.begin(), ids.end(), index);
-      if (it == ids.end() || *it != index)
-        return false;
+    case Version::V0:
+      InitializeIfNeeded(*subReader);
+      return FindUGCOffset(index).has_value();
+    default: ASSERT(false, ("Cannot deserialize ugc for version", v));
+    }
 
-      auto const d = static_cast<uint32_t>(std::distance(ids.begin(), it));
+    return false;
+  }
 
-      ReaderPtr<Reader> ofsSubReader(CreateUGCOffsetsSubReader(reader));
-      DDVector<UGCOffset, ReaderPtr<Reader>> ofs(ofsSubReader);
-      offset = ofs[d];
-    }
+  template <typename R>
+  bool DeserializeV0(R & reader, FeatureIndex index, UGC & ugc)
+  {
+    InitializeIfNeeded(reader);
+
+    auto const offset = FindUGCOffset(index);
+    if (!offset)
+      return false;
 
     {
       auto ugcSubReader = CreateUGCSubReader(reader);
       NonOwningReaderSource source(*ugcSubReader);
-      source.Skip(offset);
+      source.Skip(*offset);
 
       auto textsSubReader = CreateTextsSubReader(reader);
       DeserializerVisitorV0<NonOwningReaderSource> des(source, m_keys, *textsSubReader, m_texts);
@@ -240,6 +251,27 @@ private:
     }
 
     m_initialized = true;
+
+    // The index of the features is loaded once, so a lookup does not read the section.
+    {
+      ReaderPtr<Reader> idsSubReader(CreateFeatureIndexesSubReader(reader));
+      DDVector<FeatureIndex, ReaderPtr<Reader>> ids(idsSubReader);
+      m_featureIndexes.assign(ids.begin(), ids.end());
+
+      ReaderPtr<Reader> ofsSubReader(CreateUGCOffsetsSubReader(reader));
+      DDVector<UGCOffset, ReaderPtr<Reader>> ofs(ofsSubReader);
+      m_ugcOffsets.assign(ofs.begin(), ofs.end());
+    }
+  }
+
+  std::optional<UGCOffset> FindUGCOffset(FeatureIndex index) const
+  {
+    ASSERT(m_initialized, ());
+
+    auto const it = std::lower_bound(m_featureIndexes.begin(), m_featureIndexes.end(), index);
+    if (it == m_featureIndexes.end() || *it != index)
+      return {};
+    return m_ugcOffsets[static_cast<size_t>(std::distance(m_featureIndexes.begin(), it))];
   }
 
   template <typename Source>
@@ -317,6 +349,9 @@ private:
   HeaderV0 m_header;
   std::vector<TranslationKey> m_keys;
   coding::BlockedTextStorageReader m_texts;
+  // Sorted indexes of the features with UGC and offsets of their UGC.
+  std::vector<FeatureIndex> m_featureIndexes;
+  std::vector<UGCOffset> m_ugcOffsets;
 
   bool m_initialized = false;
 };
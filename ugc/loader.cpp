@@ -9,19 +9,19 @@ namespace ugc
 {
 Loader::Loader(DataSource const & dataSource) : m_dataSource(dataSource) {}
 
-UGC Loader::GetUGC(FeatureID const & featureId)
+template <typename Fn>
+bool Loader::WithDeserializer(FeatureID const & featureId, Fn && fn)
 {
   auto const handle = m_dataSource.GetMwmHandleById(featureId.m_mwmId);
 
   if (!handle.IsAlive())
-    return {};
+    return false;
 
   auto const & value = *handle.GetValue();
 
   if (!value.m_cont.IsExist(UGC_FILE_TAG))
-    return {};
+    return false;
 
-  UGC ugc;
   EntryPtr entry;
   {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -40,9 +40,27 @@ UGC Loader::GetUGC(FeatureID const & featureId)
   {
     std::lock_guard<std::mutex> lock(entry->m_mutex);
     auto readerPtr = value.m_cont.GetReader(UGC_FILE_TAG);
-    entry->m_deserializer.Deserialize(*readerPtr.GetPtr(), featureId.m_index, ugc);
+    fn(entry->m_deserializer, *readerPtr.GetPtr());
   }
 
+  return true;
+}
+
+UGC Loader::GetUGC(FeatureID const & featureId)
+{
+  UGC ugc;
+  WithDeserializer(featureId, [&](binary::UGCDeserializer & deserializer, Reader & reader) {
+    deserializer.Deserialize(reader, featureId.m_index, ugc);
+  });
   return ugc;
 }
+
+bool Loader::HasUGC(FeatureID const & featureId)
+{
+  bool result = false;
+  WithDeserializer(featureId, [&](binary::UGCDeserializer & deserializer, Reader & reader) {
+    result = deserializer.HasUGC(reader, featureId.m_index);
+  });
+  return result;
+}
 }  // namespace ugc
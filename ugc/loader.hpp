@@ -20,6 +20,8 @@ class Loader
 public:
   Loader(DataSource const & dataSource);
   UGC GetUGC(FeatureID const & featureId);
+  // Checks the index of the ugc section only, it is much cheaper than GetUGC().
+  bool HasUGC(FeatureID const & featureId);
 
 private:
   struct Entry
@@ -30,6 +32,11 @@ private:
 
   using EntryPtr = std::shared_ptr<Entry>;
 
+  // Calls |fn| with the deserializer of the mwm of |featureId| and the reader of its ugc section
+  // under the lock of the entry. Returns false when there is no ugc section.
+  template <typename Fn>
+  bool WithDeserializer(FeatureID const & featureId, Fn && fn);
+
   DataSource const & m_dataSource;
   std::map<MwmSet::MwmId, EntryPtr> m_deserializers;
   std::mutex m_mutex;
@@ -102,5 +102,15 @@ UNIT_TEST(BinarySerDes_Smoke)
     TEST(des.Deserialize(reader, 12345 /* index */, ugc), ());
     TEST_EQUAL(ugc, expectedUGC2, ());
   }
+
+  {
+    MemReader reader(buffer.data(), buffer.size());
+
+    UGCDeserializer hasDes;
+    TEST(!hasDes.HasUGC(reader, 0 /* index */), ());
+    TEST(hasDes.HasUGC(reader, 12345 /* index */), ());
+    TEST(hasDes.HasUGC(reader, 31337 /* index */), ());
+    TEST(!hasDes.HasUGC(reader, 31338 /* index */), ());
+  }
 }
 }  // namespace